@@ -0,0 +1,39 @@
+#.rst:
+# FindBenchmark
+# -------------
+# Finds the google benchmark library
+#
+# This will define the following variables::
+#
+# BENCHMARK_FOUND - system has google benchmark
+# BENCHMARK_INCLUDE_DIRS - the google benchmark include directory
+# BENCHMARK_LIBRARIES - the google benchmark libraries
+#
+# and the following imported targets::
+#
+#   Benchmark::Benchmark   - The google benchmark library
+
+find_package(Threads REQUIRED)
+
+find_path(BENCHMARK_INCLUDE_DIR NAMES benchmark/benchmark.h)
+
+find_library(BENCHMARK_LIBRARY NAMES benchmark libbenchmark)
+
+include(FindPackageHandleStandardArgs)
+find_package_handle_standard_args(Benchmark
+                                  REQUIRED_VARS BENCHMARK_LIBRARY BENCHMARK_INCLUDE_DIR)
+
+if(BENCHMARK_FOUND)
+  set(BENCHMARK_LIBRARIES ${BENCHMARK_LIBRARY} ${CMAKE_THREAD_LIBS_INIT})
+  set(BENCHMARK_INCLUDE_DIRS ${BENCHMARK_INCLUDE_DIR})
+
+  if(NOT TARGET Benchmark::Benchmark)
+    add_library(Benchmark::Benchmark UNKNOWN IMPORTED)
+    set_target_properties(Benchmark::Benchmark PROPERTIES
+                                               IMPORTED_LOCATION "${BENCHMARK_LIBRARY}"
+                                               INTERFACE_INCLUDE_DIRECTORIES "${BENCHMARK_INCLUDE_DIR}"
+                                               INTERFACE_LINK_LIBRARIES "${CMAKE_THREAD_LIBS_INIT}")
+  endif()
+endif()
+
+mark_as_advanced(BENCHMARK_INCLUDE_DIR BENCHMARK_LIBRARY)
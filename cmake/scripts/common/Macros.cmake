@@ -111,6 +111,14 @@ function(core_add_test_library name)
   endforeach()
 endfunction()
 
+# Add sources to the list of the benchmark target
+function(core_add_bench_library name)
+  foreach(src IN LISTS SOURCES HEADERS)
+    get_filename_component(src_path "${src}" ABSOLUTE)
+    set(bench_sources "${src_path}" ${bench_sources} CACHE STRING "" FORCE)
+  endforeach()
+endfunction()
+
 # Add an addon callback library
 # Arguments:
 #   name name of the library to add
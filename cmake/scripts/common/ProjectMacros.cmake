@@ -4,10 +4,15 @@
 # Arguments:
 #   input  input directory to pack
 #   output ouput xbt file
+# Optional:
+#   XBT_TEXTURE_FORMAT  dxt or etc2 to store the images compressed for the GPU
 # On return:
 #   xbt is added to ${XBT_FILES}
 function(pack_xbt input output)
   file(GLOB_RECURSE MEDIA_FILES ${input}/*)
+  if(XBT_TEXTURE_FORMAT)
+    set(texformat -texformat ${XBT_TEXTURE_FORMAT})
+  endif()
   get_filename_component(dir ${output} DIRECTORY)
   add_custom_command(OUTPUT  ${output}
                      COMMAND ${CMAKE_COMMAND} -E make_directory ${dir}
@@ -15,6 +20,8 @@ function(pack_xbt input output)
                      ARGS    -input ${input}
                              -output ${output}
                              -dupecheck
+                             -atlas
+                             ${texformat}
                      DEPENDS ${MEDIA_FILES})
   list(APPEND XBT_FILES ${output})
   set(XBT_FILES ${XBT_FILES} PARENT_SCOPE)
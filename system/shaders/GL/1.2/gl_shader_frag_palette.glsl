@@ -0,0 +1,21 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#version 120
+
+uniform sampler2D m_samp0;
+uniform sampler2D m_samp1;
+varying vec4 m_cord0;
+
+// SM_TEXTURE_PALETTE shader
+// m_samp0 holds the palette indices, m_samp1 the 256 colors of the palette
+void main ()
+{
+  float index = texture2D(m_samp0, m_cord0.xy).r;
+  gl_FragColor.rgba = texture2D(m_samp1, vec2((index * 255.0 + 0.5) / 256.0, 0.5)).rgba;
+}
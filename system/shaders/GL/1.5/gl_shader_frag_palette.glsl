@@ -0,0 +1,18 @@
+#version 150
+
+uniform sampler2D m_samp0;
+uniform sampler2D m_samp1;
+in vec4 m_cord0;
+out vec4 fragColor;
+
+// SM_TEXTURE_PALETTE shader
+// m_samp0 holds the palette indices, m_samp1 the 256 colors of the palette
+void main ()
+{
+  float index = texture(m_samp0, m_cord0.xy).r;
+  fragColor.rgba = texture(m_samp1, vec2((index * 255.0 + 0.5) / 256.0, 0.5)).rgba;
+#if defined(KODI_LIMITED_RANGE)
+  fragColor.rgb *= (235.0-16.0) / 255.0;
+  fragColor.rgb += 16.0 / 255.0;
+#endif
+}
@@ -40,6 +40,71 @@ vec2 stretch(vec2 pos)
 #endif
 }
 
+#if defined(XBMC_DEINT_EDI)
+uniform float m_bob;
+
+// Bob with edge directed interpolation of the lines missing from the field,
+// the spatial check of yadif: of three directions through the missing pixel
+// the one with the most similar pixels above and below is interpolated.
+float fetchY(vec2 pos, float dx)
+{
+#if(XBMC_texture_rectangle)
+  return texture(m_sampY, vec2(pos.x + dx, pos.y)).r;
+#else
+  return texture(m_sampY, vec2(pos.x + dx * m_step.x, pos.y * m_step.y)).r;
+#endif
+}
+
+float sampleY(vec2 pos)
+{
+  // full frames are sampled as they are
+  if (m_bob < 0.5)
+    return texture(m_sampY, pos).r;
+
+#if(XBMC_texture_rectangle)
+  float row = pos.y - 0.5;
+#else
+  float row = pos.y / m_step.y - 0.5;
+#endif
+  float f = fract(row);
+  vec2 above = vec2(pos.x, floor(row) + 0.5);
+  vec2 below = vec2(pos.x, above.y + 1.0);
+
+  float c[5];
+  float e[5];
+  for (int i = 0; i < 5; i++)
+  {
+    c[i] = fetchY(above, float(i - 2));
+    e[i] = fetchY(below, float(i - 2));
+  }
+
+  float score = abs(c[1] - e[1]) + abs(c[2] - e[2]) + abs(c[3] - e[3]);
+  float mid = (c[2] + e[2]) * 0.5;
+
+  float scoreL = abs(c[0] - e[2]) + abs(c[1] - e[3]) + abs(c[2] - e[4]);
+  if (scoreL < score)
+  {
+    score = scoreL;
+    mid = (c[1] + e[3]) * 0.5;
+  }
+
+  float scoreR = abs(c[2] - e[0]) + abs(c[3] - e[1]) + abs(c[4] - e[2]);
+  if (scoreR < score)
+    mid = (c[3] + e[1]) * 0.5;
+
+  // the field lines themselves are kept, the missing line lies halfway
+  if (f < 0.5)
+    return mix(c[2], mid, f * 2.0);
+  else
+    return mix(mid, e[2], f * 2.0 - 1.0);
+}
+#else
+float sampleY(vec2 pos)
+{
+  return texture(m_sampY, pos).r;
+}
+#endif
+
 vec4 process()
 {
   vec4 rgb;
@@ -47,14 +112,14 @@ vec4 process()
 
 #if defined(XBMC_YV12)
 
-  yuv.rgba = vec4( texture(m_sampY, stretch(m_cordY)).r
+  yuv.rgba = vec4( sampleY(stretch(m_cordY))
                  , texture(m_sampU, stretch(m_cordU)).r
                  , texture(m_sampV, stretch(m_cordV)).r
                  , 1.0 );
 
 #elif defined(XBMC_NV12)
 
-  yuv.rgba = vec4( texture(m_sampY, stretch(m_cordY)).r
+  yuv.rgba = vec4( sampleY(stretch(m_cordY))
                  , texture(m_sampU, stretch(m_cordU)).rg
                  , 1.0 );
 
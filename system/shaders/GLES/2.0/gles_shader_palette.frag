@@ -0,0 +1,30 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#version 100
+
+precision mediump float;
+uniform sampler2D m_samp0;
+uniform sampler2D m_samp1;
+varying vec4 m_cord0;
+
+// m_samp0 holds the palette indices, m_samp1 the 256 colors of the palette
+void main ()
+{
+  vec4 rgb;
+  float index = texture2D(m_samp0, m_cord0.xy).a;
+
+  rgb = texture2D(m_samp1, vec2((index * 255.0 + 0.5) / 256.0, 0.5));
+
+#if defined(KODI_LIMITED_RANGE)
+  rgb.rgb *= (235.0 - 16.0) / 255.0;
+  rgb.rgb += 16.0 / 255.0;
+#endif
+
+  gl_FragColor = rgb;
+}
@@ -61,6 +61,7 @@
 #define PT_BLOB         0x08
 #define PT_LOG          0x09
 #define PT_ACTION       0x0A
+#define PT_BATCH        0x0B
 #define PT_DEBUG        0xFF
 
 #define ICON_NONE       0x00
@@ -282,6 +283,8 @@ protected:
 
   virtual void ConstructPayload()
   { }
+
+  friend class CPacketBATCH;
 };
 
 class CPacketHELO : public CPacket
@@ -727,6 +730,52 @@ public:
   virtual ~CPacketACTION() = default;
 };
 
+class CPacketBATCH : public CPacket
+{
+    /************************************************************************/
+    /* Payload format                                                       */
+    /* %i - number of packets                                               */
+    /* for each packet:                                                     */
+    /*   %i - packet type (PT_BUTTON, PT_MOUSE or PT_ACTION only)           */
+    /*   %i - payload size                                                  */
+    /*   raw - payload of that packet type                                  */
+    /************************************************************************/
+private:
+  unsigned short    m_Count;
+  std::vector<char> m_Packets;
+public:
+  CPacketBATCH()
+  {
+    m_PacketType = PT_BATCH;
+    m_Count = 0;
+  }
+
+  void Add(CPacket &Packet)
+  {
+    if (Packet.m_Payload.empty())
+      Packet.ConstructPayload();
+
+    m_Packets.push_back((Packet.m_PacketType & 0xff00) >> 8);
+    m_Packets.push_back( Packet.m_PacketType & 0x00ff);
+    m_Packets.push_back((Packet.m_Payload.size() & 0xff00) >> 8);
+    m_Packets.push_back( Packet.m_Payload.size() & 0x00ff);
+    m_Packets.insert(m_Packets.end(), Packet.m_Payload.begin(), Packet.m_Payload.end());
+    m_Count++;
+    m_Payload.clear();
+  }
+
+  virtual void ConstructPayload()
+  {
+    m_Payload.clear();
+
+    m_Payload.push_back((m_Count & 0xff00) >> 8);
+    m_Payload.push_back( m_Count & 0x00ff);
+    m_Payload.insert(m_Payload.end(), m_Packets.begin(), m_Packets.end());
+  }
+
+  virtual ~CPacketBATCH() = default;
+};
+
 class CXBMCClient
 {
 private:
@@ -811,6 +860,14 @@ public:
     log.Send(m_Socket, m_Addr, m_UID);
   }
 
+  void SendBATCH(CPacketBATCH &Batch)
+  {
+    if (m_Socket < 0)
+      return;
+
+    Batch.Send(m_Socket, m_Addr, m_UID);
+  }
+
   void SendACTION(const char *ActionMessage, int ActionType = ACTION_EXECBUILTIN)
   {
     if (m_Socket < 0)
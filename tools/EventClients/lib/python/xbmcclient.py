@@ -64,6 +64,7 @@ PT_NOTIFICATION  = 0x07
 PT_BLOB          = 0x08
 PT_LOG           = 0x09
 PT_ACTION        = 0x0A
+PT_BATCH         = 0x0B
 PT_DEBUG         = 0xFF
 
 ICON_NONE = 0x00
@@ -464,6 +465,25 @@ class PacketACTION (Packet):
         self.append_payload( chr (actiontype) )
         self.append_payload( format_string(actionmessage) )
 
+class PacketBATCH (Packet):
+    """A BATCH packet
+
+    A BATCH packet carries several BUTTON, MOUSE or ACTION packets that XBMC
+    handles in order, as if they were sent one by one.
+    """
+    def __init__(self, packets=[]):
+        """
+        Keyword arguments:
+        packets -- the packets to send at once
+        """
+        Packet.__init__(self)
+        self.packettype = PT_BATCH
+        self.append_payload( format_uint16(len(packets)) )
+        for packet in packets:
+            self.append_payload( format_uint16(packet.packettype) )
+            self.append_payload( format_uint16(len(packet.payload)) )
+            self.append_payload( packet.payload )
+
 ######################################################################
 # XBMC Client Class
 ######################################################################
@@ -630,6 +650,14 @@ class XBMCClient:
         packet = PacketACTION(actionmessage, actiontype)
         packet.send(self.sock, self.addr, self.uid)
 
+    def send_batch(self, packets=[]):
+        """
+        Keyword arguments:
+        packets -- the BUTTON, MOUSE or ACTION packets to send at once
+        """
+        packet = PacketBATCH(packets)
+        packet.send(self.sock, self.addr, self.uid)
+
     def _get_icon_type(self, icon_file):
         if icon_file:
             if icon_file.lower()[-3:] == "png":
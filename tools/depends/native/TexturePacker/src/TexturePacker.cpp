@@ -27,10 +27,12 @@
 #include <inttypes.h>
 #define platform_stricmp strcasecmp
 #endif
+#include <algorithm>
 #include <cerrno>
 #include <dirent.h>
 #include <map>
 
+#include "guilib/TextureCompressor.h"
 #include "guilib/XBTF.h"
 #include "guilib/XBTFReader.h"
 
@@ -48,6 +50,12 @@
 #include <sys/stat.h>
 
 #define FLAGS_USE_LZO     1
+#define FLAGS_DXT         2
+#define FLAGS_ETC2        4
+
+// images that are extended by a pixel on every side on their atlas page, so that filtering at
+// their edges doesn't pick up their neighbours
+#define ATLAS_PADDING     1
 
 #define DIR_SEPARATOR "/"
 
@@ -206,11 +214,160 @@ CXBTFFrame createXBTFFrame(RGBAImage &image, CXBTFWriter& writer, double maxMSE,
 
   CXBTFFrame frame;
   format = XB_FMT_A8R8G8B8;
+  if (flags & FLAGS_DXT)
+    format = hasAlpha ? XB_FMT_DXT5 : XB_FMT_DXT1;
+  else if (flags & FLAGS_ETC2)
+    format = hasAlpha ? XB_FMT_ETC2_RGBA8 : XB_FMT_ETC2_RGB8;
+
+  if (format != XB_FMT_A8R8G8B8)
+  {
+    std::vector<unsigned char> compressed(CTextureCompressor::GetSize(width, height, format));
+    if (CTextureCompressor::Compress(argb, width, height, image.pitch, format, compressed.data()))
+      return appendContent(writer, width, height, compressed.data(), compressed.size(), format, hasAlpha, flags);
+    format = XB_FMT_A8R8G8B8;
+  }
+
   frame = appendContent(writer, width, height, argb, (width * height * 4), format, hasAlpha, flags);
 
   return frame;
 }
 
+struct AtlasImage
+{
+  size_t file;
+  unsigned int width;
+  unsigned int height;
+  bool hasAlpha;
+  std::vector<unsigned char> pixels;
+  unsigned int page;
+  unsigned int x; //!< of the padded area
+  unsigned int y;
+};
+
+struct AtlasShelf
+{
+  unsigned int y;
+  unsigned int height;
+  unsigned int nextX;
+};
+
+struct AtlasPage
+{
+  std::vector<AtlasShelf> shelves;
+  unsigned int height = 0;
+};
+
+// shelves of images of about the same height, the tallest images placed first
+void PackAtlas(std::vector<AtlasImage>& images, unsigned int pageSize, std::vector<AtlasPage>& pages)
+{
+  std::vector<AtlasImage*> sorted;
+  for (AtlasImage& image : images)
+    sorted.push_back(&image);
+  std::stable_sort(sorted.begin(), sorted.end(), [](const AtlasImage* a, const AtlasImage* b) {
+    return a->height > b->height;
+  });
+
+  for (AtlasImage* image : sorted)
+  {
+    const unsigned int width = image->width + 2 * ATLAS_PADDING;
+    const unsigned int height = image->height + 2 * ATLAS_PADDING;
+
+    bool placed = false;
+    for (size_t p = 0; p < pages.size() && !placed; ++p)
+    {
+      AtlasPage& page = pages[p];
+      for (AtlasShelf& shelf : page.shelves)
+      {
+        if (height <= shelf.height && shelf.nextX + width <= pageSize)
+        {
+          image->page = p;
+          image->x = shelf.nextX;
+          image->y = shelf.y;
+          shelf.nextX += width;
+          placed = true;
+          break;
+        }
+      }
+      if (!placed && page.height + height <= pageSize)
+      {
+        page.shelves.push_back({page.height, height, width});
+        image->page = p;
+        image->x = 0;
+        image->y = page.height;
+        page.height += height;
+        placed = true;
+      }
+    }
+
+    if (!placed)
+    {
+      pages.emplace_back();
+      pages.back().shelves.push_back({0, height, width});
+      pages.back().height = height;
+      image->page = pages.size() - 1;
+      image->x = 0;
+      image->y = 0;
+    }
+  }
+}
+
+// copy an image onto its page and repeat its outer pixels into the padding
+void CopyToAtlasPage(const AtlasImage& image, unsigned char* page, unsigned int pageWidth)
+{
+  const unsigned int pagePitch = pageWidth * 4;
+  const unsigned int pitch = image.width * 4;
+  for (unsigned int row = 0; row < image.height + 2 * ATLAS_PADDING; ++row)
+  {
+    unsigned int srcRow = row < ATLAS_PADDING ? 0 : std::min(row - ATLAS_PADDING, image.height - 1);
+    const unsigned char* src = image.pixels.data() + srcRow * pitch;
+    unsigned char* dst = page + (image.y + row) * pagePitch + image.x * 4;
+
+    for (unsigned int i = 0; i < ATLAS_PADDING; ++i)
+      memcpy(dst + i * 4, src, 4);
+    memcpy(dst + ATLAS_PADDING * 4, src, pitch);
+    for (unsigned int i = 0; i < ATLAS_PADDING; ++i)
+      memcpy(dst + ATLAS_PADDING * 4 + pitch + i * 4, src + pitch - 4, 4);
+  }
+}
+
+void AppendAtlasPages(CXBTFWriter& writer, std::vector<CXBTFFile>& files, std::vector<AtlasImage>& images,
+                      unsigned int pageSize, unsigned int flags)
+{
+  std::vector<AtlasPage> pages;
+  PackAtlas(images, pageSize, pages);
+
+  for (size_t p = 0; p < pages.size(); ++p)
+  {
+    const unsigned int pageHeight = pages[p].height;
+    std::vector<unsigned char> data(pageSize * pageHeight * 4, 0);
+    for (const AtlasImage& image : images)
+    {
+      if (image.page == p)
+        CopyToAtlasPage(image, data.data(), pageSize);
+    }
+
+    const uint64_t offset = writer.GetContentSize();
+    CXBTFFrame pageFrame = appendContent(writer, pageSize, pageHeight, data.data(), data.size(), XB_FMT_A8R8G8B8, true, flags);
+    printf("atlas page %4zu                                %dx%d @ %" PRIu64 " bytes\n", p, pageSize, pageHeight,
+      pageFrame.GetPackedSize());
+
+    for (const AtlasImage& image : images)
+    {
+      if (image.page != p)
+        continue;
+
+      CXBTFFrame frame = pageFrame;
+      frame.SetWidth(image.width);
+      frame.SetHeight(image.height);
+      frame.SetFormat(image.hasAlpha ? XB_FMT_A8R8G8B8 : XB_FMT_A8R8G8B8 | XB_FMT_OPAQUE);
+      frame.SetOffset(offset);
+      frame.SetAtlas(image.x + ATLAS_PADDING, image.y + ATLAS_PADDING, pageSize, pageHeight);
+      files[image.file].GetFrames().push_back(frame);
+      writer.UpdateFile(files[image.file]);
+    }
+  }
+}
+
 void Usage()
 {
   puts("Usage:");
@@ -218,6 +375,10 @@ void Usage()
   puts("  -input <dir>     Input directory. Default: current dir");
   puts("  -output <dir>    Output directory/filename. Default: Textures.xbt");
   puts("  -dupecheck       Enable duplicate file detection. Reduces output file size. Default: off");
+  puts("  -texformat <f>   Store the images compressed as dxt (desktops) or etc2 (GLES 3), lossy. Default: off");
+  puts("  -atlas           Pack small images into shared atlas pages (XBTF version 3). Default: off");
+  puts("  -atlaspage <n>   Width and maximum height of the atlas pages. Default: 1024");
+  puts("  -atlasimage <n>  Largest width and height of an image put on an atlas page. Default: 128");
 }
 
 static bool checkDupe(struct MD5Context* ctx,
@@ -247,7 +408,8 @@ static bool checkDupe(struct MD5Context* ctx,
   return false;
 }
 
-int createBundle(const std::string& InputDir, const std::string& OutputFile, double maxMSE, unsigned int flags, bool dupecheck)
+int createBundle(const std::string& InputDir, const std::string& OutputFile, double maxMSE, unsigned int flags, bool dupecheck,
+                 unsigned int atlasPage, unsigned int atlasImage)
 {
   CXBTFWriter writer(OutputFile);
   if (!writer.Create())
@@ -268,6 +430,11 @@ int createBundle(const std::string& InputDir, const std::string& OutputFile, dou
       dupes[i] = i;
   }
 
+  // the pages are appended after all other images, the dupes of their images are filled in then
+  std::vector<AtlasImage> atlasImages;
+  std::vector<size_t> atlasDupes;
+  std::vector<bool> inAtlas(files.size(), false);
+
   for (size_t i = 0; i < files.size(); i++)
   {
     struct MD5Context ctx;
@@ -303,9 +470,34 @@ int createBundle(const std::string& InputDir, const std::string& OutputFile, dou
       if (checkDupe(&ctx,hashes,dupes,i))
       {
         printf("****  duplicate of %s\n", files[dupes[i]].GetPath().c_str());
-        file.GetFrames().insert(file.GetFrames().end(),
-                                files[dupes[i]].GetFrames().begin(),
-                                files[dupes[i]].GetFrames().end());
+        if (inAtlas[dupes[i]])
+          atlasDupes.push_back(i);
+        else
+          file.GetFrames().insert(file.GetFrames().end(),
+                                  files[dupes[i]].GetFrames().begin(),
+                                  files[dupes[i]].GetFrames().end());
+        skip = true;
+      }
+    }
+
+    if (!skip && atlasPage > 0 && frames.frameList.size() == 1)
+    {
+      const RGBAImage& image = frames.frameList[0].rgbaImage;
+      if (image.width > 0 && image.height > 0 &&
+          static_cast<unsigned int>(image.width) <= atlasImage && static_cast<unsigned int>(image.height) <= atlasImage)
+      {
+        AtlasImage atlas;
+        atlas.file = i;
+        atlas.width = image.width;
+        atlas.height = image.height;
+        atlas.pixels.resize(image.width * image.height * 4);
+        for (int row = 0; row < image.height; ++row)
+          memcpy(atlas.pixels.data() + row * image.width * 4, image.pixels + row * image.pitch, image.width * 4);
+        atlas.hasAlpha = HasAlpha(atlas.pixels.data(), image.width, image.height);
+        atlasImages.push_back(std::move(atlas));
+        inAtlas[i] = true;
+
+        printf("    atlas image (%d,%d)\n", image.width, image.height);
         skip = true;
       }
     }
@@ -328,6 +520,17 @@ int createBundle(const std::string& InputDir, const std::string& OutputFile, dou
     writer.UpdateFile(file);
   }
 
+  if (!atlasImages.empty())
+  {
+    AppendAtlasPages(writer, files, atlasImages, atlasPage, flags);
+
+    for (size_t i : atlasDupes)
+    {
+      files[i].GetFrames() = files[dupes[i]].GetFrames();
+      writer.UpdateFile(files[i]);
+    }
+  }
+
   if (!writer.UpdateHeader(dupes))
   {
     fprintf(stderr, "Error writing header to file\n");
@@ -350,6 +553,9 @@ int main(int argc, char* argv[])
   bool valid = false;
   unsigned int flags = 0;
   bool dupecheck = false;
+  bool atlas = false;
+  unsigned int atlasPage = 1024;
+  unsigned int atlasImage = 128;
   CmdLineArgs args(argc, (const char**)argv);
 
   // setup some defaults, lzo packing,
@@ -380,6 +586,28 @@ int main(int argc, char* argv[])
     {
       dupecheck = true;
     }
+    else if (!strcmp(args[i], "-texformat") && i + 1 < args.size())
+    {
+      ++i;
+      if (!platform_stricmp(args[i], "dxt"))
+        flags |= FLAGS_DXT;
+      else if (!platform_stricmp(args[i], "etc2"))
+        flags |= FLAGS_ETC2;
+      else
+        fprintf(stderr, "Unrecognized texture format: %s\n", args[i]);
+    }
+    else if (!strcmp(args[i], "-atlas"))
+    {
+      atlas = true;
+    }
+    else if (!strcmp(args[i], "-atlaspage") && i + 1 < args.size())
+    {
+      atlasPage = strtoul(args[++i], NULL, 10);
+    }
+    else if (!strcmp(args[i], "-atlasimage") && i + 1 < args.size())
+    {
+      atlasImage = strtoul(args[++i], NULL, 10);
+    }
     else if (!platform_stricmp(args[i], "-output") || !platform_stricmp(args[i], "-o"))
     {
       OutputFilename = args[++i];
@@ -407,6 +635,9 @@ int main(int argc, char* argv[])
 
   double maxMSE = 1.5;    // HQ only please
   DecoderManager::InstantiateDecoders();
-  createBundle(InputDir, OutputFilename, maxMSE, flags, dupecheck);
+  // an image has to fit onto a page including its padding
+  if (!atlas || atlasImage + 2 * ATLAS_PADDING > atlasPage)
+    atlasPage = 0;
+  createBundle(InputDir, OutputFilename, maxMSE, flags, dupecheck, atlasPage, atlasImage);
   DecoderManager::FreeDecoders();
 }
@@ -105,11 +105,22 @@ bool CXBTFWriter::UpdateHeader(const std::vector<unsigned int>& dupes)
   if (m_file == nullptr)
     return false;
 
+  // older readers can still read bundles without atlas pages
+  m_version = XBTF_VERSION;
+  for (const auto& file : m_files)
+  {
+    for (const auto& frame : file.second.GetFrames())
+    {
+      if (frame.IsInAtlas())
+        m_version = XBTF_VERSION_ATLAS;
+    }
+  }
+
   uint64_t headerSize = GetHeaderSize();
   uint64_t offset = headerSize;
 
   WRITE_STR(XBTF_MAGIC.c_str(), 4, m_file);
-  WRITE_STR(XBTF_VERSION.c_str(), 1, m_file);
+  WRITE_STR(m_version.c_str(), 1, m_file);
 
   auto files = GetFiles();
   WRITE_U32(files.size(), m_file);
@@ -134,7 +145,9 @@ bool CXBTFWriter::UpdateHeader(const std::vector<unsigned int>& dupes)
     for (size_t j = 0; j < frames.size(); j++)
     {
       CXBTFFrame& frame = frames[j];
-      if (dupes[i] != i)
+      if (frame.IsInAtlas())
+        frame.SetOffset(headerSize + frame.GetOffset());
+      else if (dupes[i] != i)
         frame.SetOffset(files[dupes[i]].GetFrames()[j].GetOffset());
       else
       {
@@ -149,6 +162,14 @@ bool CXBTFWriter::UpdateHeader(const std::vector<unsigned int>& dupes)
       WRITE_U64(frame.GetUnpackedSize(), m_file);
       WRITE_U32(frame.GetDuration(), m_file);
       WRITE_U64(frame.GetOffset(), m_file);
+
+      if (m_version == XBTF_VERSION_ATLAS)
+      {
+        WRITE_U32(frame.GetAtlasX(), m_file);
+        WRITE_U32(frame.GetAtlasY(), m_file);
+        WRITE_U32(frame.GetAtlasWidth(), m_file);
+        WRITE_U32(frame.GetAtlasHeight(), m_file);
+      }
     }
   }
 
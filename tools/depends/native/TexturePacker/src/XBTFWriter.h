@@ -35,6 +35,13 @@ public:
   bool Create();
   bool Close();
   bool AppendContent(unsigned char const* data, size_t length);
+  size_t GetContentSize() const { return m_size; }
+
+  /*!
+   \brief Write the header of the files
+   Frames on atlas pages keep the offset of the page data within the appended content, every other
+   frame is assumed to follow the one before it.
+   */
   bool UpdateHeader(const std::vector<unsigned int>& dupes);
 
 private:
@@ -8,6 +8,7 @@
 
 #include "network/EventServer.h"
 #include "network/Network.h"
+#include "threads/LockStats.h"
 #include "threads/SystemClock.h"
 #include "Application.h"
 #include "AppParamParser.h"
@@ -34,6 +35,8 @@
 #include "music/MusicLibraryQueue.h"
 #include "guilib/GUIControlProfiler.h"
 #include "utils/LangCodeExpander.h"
+#include "utils/MemoryPressure.h"
+#include "utils/Metrics.h"
 #include "GUIInfoManager.h"
 #include "playlists/PlayListFactory.h"
 #include "guilib/GUIFontManager.h"
@@ -162,6 +165,7 @@
 
 #include "storage/MediaManager.h"
 #include "utils/SaveFileStateJob.h"
+#include "utils/StartupTimeline.h"
 #include "utils/AlarmClock.h"
 #include "utils/StringUtils.h"
 #include "DatabaseManager.h"
@@ -217,6 +221,9 @@ using KODI::MESSAGING::HELPERS::DialogResponse;
 
 #define MAX_FFWD_SPEED 5
 
+// seconds without input after which the gui is updated at the idle frame rate
+#define GUI_IDLE_DELAY 10
+
 CApplication::CApplication(void)
 :
 #ifdef HAS_DVD_DRIVE
@@ -357,6 +364,8 @@ void CApplication::Preflight()
 
 bool CApplication::Create(const CAppParamParser &params)
 {
+  CStartupTimeline::CPhase phase("CApplication::Create");
+
   // Grab a handle to our thread to be used later in identifying the render thread.
   m_threadID = CThread::GetCurrentThreadId();
 
@@ -532,6 +541,7 @@ bool CApplication::Create(const CAppParamParser &params)
   // set avutil callback
   av_log_set_callback(ff_avutil_log);
 
+  phase.Step("settings");
   CLog::Log(LOGINFO, "loading settings");
   if (!m_pSettingsComponent->Load())
     return false;
@@ -557,21 +567,27 @@ bool CApplication::Create(const CAppParamParser &params)
   m_pAppPort = std::make_shared<CAppInboundProtocol>(*this);
   CServiceBroker::RegisterAppPort(m_pAppPort);
 
+  phase.Step("window system");
   m_pWinSystem = CWinSystemBase::CreateWinSystem();
   CServiceBroker::RegisterWinSystem(m_pWinSystem.get());
 
+  phase.Step("services");
   if (!m_ServiceManager->InitStageTwo(params, m_pSettingsComponent->GetProfileManager()->GetProfileUserDataFolder()))
   {
     return false;
   }
 
+  phase.Step("audio engine");
   m_pActiveAE.reset(new ActiveAE::CActiveAE());
   m_pActiveAE->Start();
   CServiceBroker::RegisterAE(m_pActiveAE.get());
+  UpdateMusicZone();
 
   // restore AE's previous volume state
   SetHardwareVolume(m_volumeLevel);
   CServiceBroker::GetActiveAE()->SetMute(m_muted);
+  if (m_pMusicAE)
+    m_pMusicAE->SetMute(m_muted);
 
   // initialize m_replayGainSettings
   m_replayGainSettings.iType = settings->GetInt(CSettings::SETTING_MUSICPLAYER_REPLAYGAINTYPE);
@@ -580,6 +596,7 @@ bool CApplication::Create(const CAppParamParser &params)
   m_replayGainSettings.bAvoidClipping = settings->GetBool(CSettings::SETTING_MUSICPLAYER_REPLAYGAINAVOIDCLIPPING);
 
   // load the keyboard layouts
+  phase.Step("keyboard layouts");
   if (!CKeyboardLayoutManager::GetInstance().Load())
   {
     CLog::Log(LOGFATAL, "CApplication::Create: Unable to load keyboard layouts");
@@ -594,6 +611,7 @@ bool CApplication::Create(const CAppParamParser &params)
 
   CUtil::InitRandomSeed();
 
+  phase.Step("media manager");
   g_mediaManager.Initialize();
 
   m_lastRenderTime = XbmcThreads::SystemClockMillis();
@@ -602,6 +620,8 @@ bool CApplication::Create(const CAppParamParser &params)
 
 bool CApplication::CreateGUI()
 {
+  CStartupTimeline::CPhase phase("CApplication::CreateGUI");
+
   m_frameMoveGuard.lock();
 
   m_renderGUI = true;
@@ -714,7 +734,10 @@ bool CApplication::Initialize()
   cdio_loglevel_default = CDIO_LOG_ERROR;
 #endif
 
+  CStartupTimeline::CPhase phase("CApplication::Initialize");
+
   // load the language and its translated strings
+  phase.Step("language");
   if (!LoadLanguage(false))
     return false;
 
@@ -725,8 +748,11 @@ bool CApplication::Initialize()
     StringUtils::Format(g_localizeStrings.Get(178).c_str(), g_sysinfo.GetAppName().c_str()),
     "special://xbmc/media/icon256x256.png", EventLevel::Basic)));
 
+  phase.Step("network");
   m_ServiceManager->GetNetwork().WaitForNet();
 
+  phase.Step("databases");
+
   // initialize (and update as needed) our databases
   CDatabaseManager &databaseManager = m_ServiceManager->GetDatabaseManager();
 
@@ -750,6 +776,7 @@ bool CApplication::Initialize()
   }
   CServiceBroker::GetRenderSystem()->ShowSplash("");
 
+  phase.Step("start services");
   StartServices();
 
   // GUI depends on seek handler
@@ -765,6 +792,7 @@ bool CApplication::Initialize()
 
     m_confirmSkinChange = false;
 
+    phase.Step("addon migration");
     std::vector<std::string> incompatibleAddons;
     event.Reset();
     std::atomic<bool> isMigratingAddons(false);
@@ -789,6 +817,7 @@ bool CApplication::Initialize()
     m_incompatibleAddons = incompatibleAddons;
     m_confirmSkinChange = true;
 
+    phase.Step("skin");
     std::string defaultSkin = std::static_pointer_cast<const CSettingString>(settings->GetSetting(CSettings::SETTING_LOOKANDFEEL_SKIN))->GetDefault();
     if (!LoadSkin(settings->GetString(CSettings::SETTING_LOOKANDFEEL_SKIN)))
     {
@@ -837,6 +866,7 @@ bool CApplication::Initialize()
     uiInitializationFinished = true;
   }
 
+  phase.Step("services");
   CJSONRPC::Initialize();
 
   if (!m_ServiceManager->InitStageThree(profileManager))
@@ -844,6 +874,7 @@ bool CApplication::Initialize()
     CLog::Log(LOGERROR, "Application - Init3 failed");
   }
 
+  phase.Step("cleanup");
   g_sysinfo.Refresh();
 
   CLog::Log(LOGINFO, "removing tempfiles");
@@ -855,6 +886,7 @@ bool CApplication::Initialize()
     SetLoggingIn(false);
   }
 
+  phase.Step("addon services");
   m_slowTimer.StartZero();
 
   // register action listeners
@@ -942,6 +974,7 @@ void CApplication::StartServices()
 
 void CApplication::StopServices()
 {
+  m_networkServicesDeferred = false;
   m_ServiceManager->GetNetwork().NetworkMessage(CNetwork::SERVICES_DOWN, 0);
 
 #if !defined(TARGET_WINDOWS) && defined(HAS_DVD_DRIVE)
@@ -1038,6 +1071,11 @@ void CApplication::OnSettingChanged(std::shared_ptr<const CSetting> setting)
   {
     CApplicationMessenger::GetInstance().PostMsg(TMSG_MEDIA_RESTART);
   }
+  else if (settingId == CSettings::SETTING_AUDIOOUTPUT_AUDIODEVICE ||
+           settingId == CSettings::SETTING_AUDIOOUTPUT_MUSICDEVICE)
+  {
+    UpdateMusicZone();
+  }
   else if (StringUtils::EqualsNoCase(settingId, CSettings::SETTING_MUSICPLAYER_REPLAYGAINTYPE))
     m_replayGainSettings.iType = std::static_pointer_cast<const CSettingInt>(setting)->GetValue();
   else if (StringUtils::EqualsNoCase(settingId, CSettings::SETTING_MUSICPLAYER_REPLAYGAINPREAMP))
@@ -1275,6 +1313,8 @@ bool CApplication::LoadSkin(const std::string& skinID)
 
   g_localizeStrings.LoadSkinStrings(langPath, settings->GetString(CSettings::SETTING_LOCALE_LANGUAGE));
 
+  g_fontManager.PrewarmFonts();
+
 
   int64_t start;
   start = CurrentHostCounter();
@@ -1508,6 +1548,11 @@ void CApplication::Render()
   if(!CServiceBroker::GetRenderSystem()->BeginRender())
     return;
 
+  // the flip is left out, it waits for the vblank
+  static CMetrics::Histogram* renderTime =
+      CMetrics::RegisterHistogram("kodi_gui_render_time", "Time to render a frame of the GUI and the video layer");
+  const auto renderStart = std::chrono::steady_clock::now();
+
   // render gui layer
   if (m_renderGUI && !m_skipGuiRender)
   {
@@ -1537,6 +1582,7 @@ void CApplication::Render()
   CServiceBroker::GetGUI()->GetWindowManager().RenderEx();
 
   CServiceBroker::GetRenderSystem()->EndRender();
+  renderTime->ObserveSince(renderStart);
 
   // reset our info cache - we do this at the end of Render so that it is
   // fresh for the next process(), or after a windowclose animation (where process()
@@ -2090,7 +2136,11 @@ void CApplication::OnApplicationMessage(ThreadMessage* pMsg)
   break;
 
   case TMSG_NETWORKMESSAGE:
-    m_ServiceManager->GetNetwork().NetworkMessage((CNetwork::EMESSAGE)pMsg->param1, pMsg->param2);
+    // the network servers aren't needed for the home screen, they are
+    // started in the background once it is up
+    m_networkServicesDeferred = pMsg->param1 == CNetwork::SERVICES_UP && m_bInitializing;
+    if (!m_networkServicesDeferred)
+      m_ServiceManager->GetNetwork().NetworkMessage((CNetwork::EMESSAGE)pMsg->param1, pMsg->param2);
     break;
 
   case TMSG_SETLANGUAGE:
@@ -2368,19 +2418,24 @@ void CApplication::FrameMove(bool processEvents, bool processGUI)
   if (processGUI && m_renderGUI)
   {
     m_skipGuiRender = false;
-#if defined(TARGET_RASPBERRY_PI)
     int fps = 0;
 
     // This code reduces rendering fps of the GUI layer when playing videos in fullscreen mode
-    // it makes only sense on architectures with multiple layers
+    // it makes only sense on architectures with multiple layers, the others don't have the setting
     if (CServiceBroker::GetWinSystem()->GetGfxContext().IsFullScreenVideo() && !m_appPlayer.IsPausedPlayback() && m_appPlayer.IsRenderingVideoLayer())
       fps = CServiceBroker::GetSettingsComponent()->GetSettings()->GetInt(CSettings::SETTING_VIDEOPLAYER_LIMITGUIUPDATE);
+    // Without input only clocks, fading labels and the like change the GUI,
+    // which don't need the full frame rate. Screensaver add-ons and players
+    // rendering to the GUI layer still do.
+    else if (!m_appPlayer.IsPlaying() && GlobalIdleTime() >= GUI_IDLE_DELAY &&
+             (!m_screensaverActive || m_screensaverIdInUse == "screensaver.xbmc.builtin.dim" ||
+              m_screensaverIdInUse == "screensaver.xbmc.builtin.black"))
+      fps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiIdleFps;
 
     unsigned int now = XbmcThreads::SystemClockMillis();
     unsigned int frameTime = now - m_lastRenderTime;
     if (fps > 0 && frameTime * fps < 1000)
       m_skipGuiRender = true;
-#endif
 
     if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiSmartRedraw && m_guiRefreshTimer.IsTimePast())
     {
@@ -2614,6 +2669,12 @@ void CApplication::Stop(int exitCode)
       gui->GetAudioManager().DeInitialize();
 
     // shutdown the AudioEngine
+    CServiceBroker::UnregisterMusicAE();
+    if (m_pMusicAE)
+    {
+      m_pMusicAE->Shutdown();
+      m_pMusicAE.reset();
+    }
     CServiceBroker::UnregisterAE();
     m_pActiveAE->Shutdown();
     m_pActiveAE.reset();
@@ -3752,6 +3813,18 @@ bool CApplication::OnMessage(CGUIMessage& message)
         ShowAppMigrationMessage();
 
         m_bInitializing = false;
+
+        CStartupTimeline::Log();
+
+        // services are started once the home screen is usable
+        CServiceBroker::GetServiceAddons().OnUIReady();
+        if (m_networkServicesDeferred)
+        {
+          m_networkServicesDeferred = false;
+          CJobManager::GetInstance().Submit([this]() {
+            m_ServiceManager->GetNetwork().NetworkMessage(CNetwork::SERVICES_UP, 0);
+          }, CJob::PRIORITY_LOW);
+        }
       }
       else if (message.GetParam1() == GUI_MSG_UPDATE_ITEM && message.GetItem())
       {
@@ -3823,7 +3896,8 @@ bool CApplication::OnMessage(CGUIMessage& message)
       // and if so, we check whether our current player wants the file
       int iNext = CServiceBroker::GetPlaylistPlayer().GetNextSong();
       CPlayList& playlist = CServiceBroker::GetPlaylistPlayer().GetPlaylist(CServiceBroker::GetPlaylistPlayer().GetCurrentPlaylist());
-      if (iNext < 0 || iNext >= playlist.size())
+      if (iNext < 0 || iNext >= playlist.size() ||
+          (m_stackHelper.IsPlayingRegularStack() && m_stackHelper.HasNextStackPartFileItem()))
       {
         m_appPlayer.OnNothingToQueueNotify();
         return true; // nothing to do
@@ -3858,6 +3932,13 @@ bool CApplication::OnMessage(CGUIMessage& message)
       }
 #endif
 
+      // video players only open the file ahead, the playlist moves on once playback has ended
+      if (m_appPlayer.IsPlayingVideo())
+      {
+        m_appPlayer.QueueNextFile(file);
+        return true;
+      }
+
       // ok - send the file to the player, if it accepts it
       if (m_appPlayer.QueueNextFile(file))
       {
@@ -4079,6 +4160,10 @@ void CApplication::ProcessSlow()
 {
   CServiceBroker::GetPowerManager().ProcessEvents();
 
+  XbmcThreads::CLockStats::Log();
+
+  CMemoryPressureManager::GetInstance().Process();
+
 #if defined(TARGET_DARWIN_OSX)
   // There is an issue on OS X that several system services ask the cursor to become visible
   // during their startup routines.  Given that we can't control this, we hack it in by
@@ -4312,6 +4397,8 @@ void CApplication::Mute()
   IAE* ae = CServiceBroker::GetActiveAE();
   if (ae)
     ae->SetMute(true);
+  if (m_pMusicAE)
+    m_pMusicAE->SetMute(true);
   m_muted = true;
   VolumeChanged();
 }
@@ -4324,6 +4411,8 @@ void CApplication::UnMute()
   IAE* ae = CServiceBroker::GetActiveAE();
   if (ae)
     ae->SetMute(false);
+  if (m_pMusicAE)
+    m_pMusicAE->SetMute(false);
   m_muted = false;
   VolumeChanged();
 }
@@ -4347,6 +4436,36 @@ void CApplication::SetHardwareVolume(float hardwareVolume)
   IAE* ae = CServiceBroker::GetActiveAE();
   if (ae)
     ae->SetVolume(hardwareVolume);
+  if (m_pMusicAE)
+    m_pMusicAE->SetVolume(hardwareVolume);
+}
+
+void CApplication::UpdateMusicZone()
+{
+  const std::shared_ptr<CSettings> settings = CServiceBroker::GetSettingsComponent()->GetSettings();
+  const std::string device = settings->GetString(CSettings::SETTING_AUDIOOUTPUT_MUSICDEVICE);
+
+  // two sinks can't open the same device, music simply stays on the main output then
+  if (device.empty() ||
+      StringUtils::EqualsNoCase(device, settings->GetString(CSettings::SETTING_AUDIOOUTPUT_AUDIODEVICE)))
+  {
+    // the engine keeps running for the streams that are still on it, new ones go to the main one
+    CServiceBroker::UnregisterMusicAE();
+    return;
+  }
+
+  if (!m_pMusicAE)
+  {
+    CLog::Log(LOGNOTICE, "CApplication::UpdateMusicZone - playing music on %s", device.c_str());
+    m_pMusicAE.reset(new ActiveAE::CActiveAE(true));
+    m_pMusicAE->Start();
+    m_pMusicAE->SetVolume(m_volumeLevel);
+    m_pMusicAE->SetMute(m_muted);
+  }
+  else
+    m_pMusicAE->OnSettingsChange();
+
+  CServiceBroker::RegisterMusicAE(m_pMusicAE.get());
 }
 
 float CApplication::GetVolume(bool percentage /* = true */) const
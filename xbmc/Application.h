@@ -376,11 +376,17 @@ protected:
    */
   bool NotifyActionListeners(const CAction &action) const;
 
+  /*!
+   \brief Start the engine of the music output device or point music back to the main engine
+   */
+  void UpdateMusicZone();
+
   std::shared_ptr<ANNOUNCEMENT::CAnnouncementManager> m_pAnnouncementManager;
   std::unique_ptr<CSettingsComponent> m_pSettingsComponent;
   std::unique_ptr<CGUIComponent> m_pGUI;
   std::unique_ptr<CWinSystemBase> m_pWinSystem;
   std::unique_ptr<ActiveAE::CActiveAE> m_pActiveAE;
+  std::unique_ptr<ActiveAE::CActiveAE> m_pMusicAE; ///< engine of audiooutput.musicdevice, see UpdateMusicZone()
   std::shared_ptr<CAppInboundProtocol> m_pAppPort;
   std::deque<XBMC_Event> m_portEvents;
   CCriticalSection m_portSection;
@@ -432,6 +438,7 @@ protected:
   std::string m_prevMedia;
   std::thread::id m_threadID;       // application thread ID.  Used in applicationMessenger to know where we are firing a thread with delay from.
   bool m_bInitializing = true;
+  bool m_networkServicesDeferred = false;
   bool m_bPlatformDirectories = true;
 
   int m_nextPlaylistItem = -1;
@@ -87,7 +87,7 @@ void CBackgroundInfoLoader::Run()
   }
 }
 
-void CBackgroundInfoLoader::Load(CFileItemList& items)
+void CBackgroundInfoLoader::Load(CFileItemList& items, int startItem /* = 0 */)
 {
   StopThread();
 
@@ -96,8 +96,12 @@ void CBackgroundInfoLoader::Load(CFileItemList& items)
 
   CSingleLock lock(m_lock);
 
+  if (startItem < 0 || startItem >= items.Size())
+    startItem = 0;
+
+  // start at the given item and wrap around to the ones before it
   for (int nItem=0; nItem < items.Size(); nItem++)
-    m_vecItems.push_back(items[nItem]);
+    m_vecItems.push_back(items[(startItem + nItem) % items.Size()]);
 
   m_pVecItems = &items;
   m_bStop = false;
@@ -32,7 +32,14 @@ public:
   CBackgroundInfoLoader();
   ~CBackgroundInfoLoader() override;
 
-  void Load(CFileItemList& items);
+  /*!
+   * \brief Load the items in the background
+   *
+   * \param items The items to load
+   * \param startItem The item to load first, usually the selected one, so
+   *                  the items on screen are loaded before the rest
+   */
+  void Load(CFileItemList& items, int startItem = 0);
   bool IsLoading();
   void Run() override;
   void SetObserver(IBackgroundLoaderObserver* pObserver);
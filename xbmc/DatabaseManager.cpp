@@ -11,17 +11,47 @@
 #include "ServiceBroker.h"
 #include "TextureDatabase.h"
 #include "addons/AddonDatabase.h"
+#include "games/GameDatabase.h"
 #include "music/MusicDatabase.h"
 #include "pvr/PVRDatabase.h"
 #include "pvr/epg/EpgDatabase.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
+#include "threads/SingleLock.h"
+#include "utils/JobManager.h"
 #include "utils/log.h"
 #include "video/VideoDatabase.h"
 #include "view/ViewDatabase.h"
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 using namespace PVR;
 
+namespace
+{
+using DatabaseList = std::vector<std::pair<std::shared_ptr<CDatabase>, DatabaseSettings>>;
+
+DatabaseList CreateDatabases()
+{
+  const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+
+  // NOTE: Order here is important. In particular, CTextureDatabase has to be updated
+  //       before CVideoDatabase.
+  DatabaseList databases;
+  databases.emplace_back(std::make_shared<CAddonDatabase>(), DatabaseSettings());
+  databases.emplace_back(std::make_shared<CViewDatabase>(), DatabaseSettings());
+  databases.emplace_back(std::make_shared<CTextureDatabase>(), DatabaseSettings());
+  databases.emplace_back(std::make_shared<CMusicDatabase>(), advancedSettings->m_databaseMusic);
+  databases.emplace_back(std::make_shared<CVideoDatabase>(), advancedSettings->m_databaseVideo);
+  databases.emplace_back(std::make_shared<CPVRDatabase>(), advancedSettings->m_databaseTV);
+  databases.emplace_back(std::make_shared<CPVREpgDatabase>(), advancedSettings->m_databaseEpg);
+  databases.emplace_back(std::make_shared<KODI::GAME::CGameDatabase>(), DatabaseSettings());
+  return databases;
+}
+}
+
 CDatabaseManager::CDatabaseManager() :
   m_bIsUpgrading(false)
 {
@@ -40,27 +70,68 @@ void CDatabaseManager::Initialize()
 
   CLog::Log(LOGDEBUG, "%s, updating databases...", __FUNCTION__);
 
-  const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
-
-  // NOTE: Order here is important. In particular, CTextureDatabase has to be updated
-  //       before CVideoDatabase.
-  { CAddonDatabase db; UpdateDatabase(db); }
-  { CViewDatabase db; UpdateDatabase(db); }
-  { CTextureDatabase db; UpdateDatabase(db); }
-  { CMusicDatabase db; UpdateDatabase(db, &advancedSettings->m_databaseMusic); }
-  { CVideoDatabase db; UpdateDatabase(db, &advancedSettings->m_databaseVideo); }
-  { CPVRDatabase db; UpdateDatabase(db, &advancedSettings->m_databaseTV); }
-  { CPVREpgDatabase db; UpdateDatabase(db, &advancedSettings->m_databaseEpg); }
+  for (auto& database : CreateDatabases())
+    UpdateDatabase(*database.first, &database.second);
 
   CLog::Log(LOGDEBUG, "%s, updating databases... DONE", __FUNCTION__);
 
   m_bIsUpgrading = false;
 }
 
+void CDatabaseManager::InitializeInBackground()
+{
+  // the location of the databases is looked up now, the caller may hold the profile manager
+  // locked until they are updated
+  DatabaseList databases = CreateDatabases();
+  for (auto& database : databases)
+    database.first->InitSettings(database.second);
+
+  CSingleLock lock(m_section);
+  m_dbStatus.clear();
+  m_updatingInBackground = true;
+  const unsigned int generation = ++m_generation;
+  lock.Leave();
+
+  CJobManager::GetInstance().Submit([this, databases, generation]() {
+    // updates of a profile that was left again meanwhile are dropped, but must not copy or
+    // upgrade a database at the same time as the next one
+    CSingleLock updateLock(m_updateSection);
+    CLog::Log(LOGDEBUG, "CDatabaseManager::InitializeInBackground, updating databases...");
+
+    for (const auto& database : databases)
+    {
+      {
+        CSingleLock lock(m_section);
+        if (generation != m_generation)
+          return;
+      }
+
+      const bool updated = Update(*database.first, database.second);
+
+      CSingleLock lock(m_section);
+      if (generation == m_generation)
+        m_dbStatus[database.first->GetBaseDBName()] = updated ? DB_READY : DB_FAILED;
+      m_statusChanged.notifyAll();
+    }
+
+    CSingleLock lock(m_section);
+    if (generation == m_generation)
+      m_updatingInBackground = false;
+    m_statusChanged.notifyAll();
+    CLog::Log(LOGDEBUG, "CDatabaseManager::InitializeInBackground, updating databases... DONE");
+  }, CJob::PRIORITY_HIGH);
+}
+
 bool CDatabaseManager::CanOpen(const std::string &name)
 {
   CSingleLock lock(m_section);
   std::map<std::string, DB_STATUS>::const_iterator i = m_dbStatus.find(name);
+  while (i == m_dbStatus.end() && m_updatingInBackground)
+  {
+    // wait for InitializeInBackground() to get to it
+    m_statusChanged.wait(lock);
+    i = m_dbStatus.find(name);
+  }
   if (i != m_dbStatus.end())
     return i->second == DB_READY;
   return false; // db isn't even attempted to update yet
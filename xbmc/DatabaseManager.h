@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "threads/Condition.h"
 #include "threads/CriticalSection.h"
 
 #include <atomic>
@@ -38,11 +39,19 @@ public:
    */
   void Initialize();
 
+  /*! \brief Initialize the database manager on a job thread
+   Used when switching profiles. Databases are updated in the same order as by
+   Initialize(), opening one waits until it is updated, so the caller isn't held
+   up by the ones not needed right away.
+   */
+  void InitializeInBackground();
+
   /*! \brief Check whether we can open a database.
 
    Checks whether the database has been updated correctly, if so returns true.
    If the database update failed, returns false immediately.
    If the database update is in progress, returns false.
+   If InitializeInBackground() didn't get to the database yet, waits for it.
 
    \param name the name of the database to check.
    \return true if the database can be opened, false otherwise.
@@ -62,4 +71,8 @@ private:
 
   CCriticalSection            m_section;     ///< Critical section protecting m_dbStatus.
   std::map<std::string, DB_STATUS> m_dbStatus;    ///< Our database status map.
+  XbmcThreads::ConditionVariable m_statusChanged;
+  bool m_updatingInBackground = false;
+  unsigned int m_generation = 0;              ///< Counts InitializeInBackground() calls.
+  CCriticalSection            m_updateSection; ///< Held while updating in the background.
 };
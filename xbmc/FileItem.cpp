@@ -3096,20 +3096,31 @@ std::string CFileItem::FindLocalArt(const std::string &artFile, bool useFolder)
   if (SkipLocalArt())
     return "";
 
+  std::vector<std::string> candidates;
+  GetLocalArtCandidates(artFile, useFolder, candidates);
+  for (const auto& thumb : candidates)
+  {
+    if (CFile::Exists(thumb))
+      return thumb;
+  }
+  return "";
+}
+
+void CFileItem::GetLocalArtCandidates(const std::string &artFile, bool useFolder, std::vector<std::string> &candidates) const
+{
   std::string thumb;
   if (!m_bIsFolder)
   {
     thumb = GetLocalArt(artFile, false);
-    if (!thumb.empty() && CFile::Exists(thumb))
-      return thumb;
+    if (!thumb.empty())
+      candidates.push_back(thumb);
   }
   if ((useFolder || (m_bIsFolder && !IsFileFolder())) && !artFile.empty())
   {
     std::string thumb2 = GetLocalArt(artFile, true);
-    if (!thumb2.empty() && thumb2 != thumb && CFile::Exists(thumb2))
-      return thumb2;
+    if (!thumb2.empty() && thumb2 != thumb)
+      candidates.push_back(thumb2);
   }
-  return "";
 }
 
 std::string CFileItem::GetLocalArt(const std::string &artFile, bool useFolder) const
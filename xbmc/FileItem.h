@@ -402,6 +402,15 @@ public:
    */
   std::string FindLocalArt(const std::string &artFile, bool useFolder) const;
 
+  /*! \brief Assemble the filenames FindLocalArt checks for a particular piece of local artwork,
+             in the order they are checked. No file existence check is performed.
+   \param artFile the art file to search for.
+   \param useFolder whether to look in the folder for the art file.
+   \param candidates [out] the filenames are appended to this.
+   \sa FindLocalArt
+   */
+  void GetLocalArtCandidates(const std::string &artFile, bool useFolder, std::vector<std::string> &candidates) const;
+
   /*! \brief Whether or not to skip searching for local art.
    \return true if local art should be skipped for this item, false otherwise.
    \sa GetLocalArt, FindLocalArt
@@ -29,6 +29,7 @@
 #include "utils/log.h"
 
 #include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <functional>
 #include <iterator>
@@ -67,7 +68,13 @@ int CGUIInfoManager::TranslateString(const std::string &condition)
 {
   // translate $LOCALIZE as required
   std::string strCondition(CGUIInfoLabel::ReplaceLocalize(condition));
-  return TranslateSingleString(strCondition);
+  const int info = TranslateSingleString(strCondition);
+  if (info > 0)
+  {
+    CSingleLock lock(m_labelCacheLock);
+    m_infoNames.emplace(info, strCondition);
+  }
+  return info;
 }
 
 typedef struct
@@ -934,6 +941,22 @@ const infomap player_times[] =   {{ "seektime",         PLAYER_SEEKTIME },
 ///     @skinning_v17 **[New Infolabel]** \link Player_Process_audiobitspersample `Player.Process(audiobitspersample)`\endlink
 ///     <p>
 ///   }
+///   \table_row3{   <b>`Player.Process(videothreading)`</b>,
+///                  \anchor Player_Process_videothreading
+///                  _string_,
+///     @return The threading model of the software video decoder with the number of threads\, e.g. "frame/6".
+///     <p><hr>
+///     @skinning_v19 **[New Infolabel]** \link Player_Process_videothreading `Player.Process(videothreading)`\endlink
+///     <p>
+///   }
+///   \table_row3{   <b>`Player.Process(videolatency)`</b>,
+///                  \anchor Player_Process_videolatency
+///                  _string_,
+///     @return The number of frames the video decoder holds back before output.
+///     <p><hr>
+///     @skinning_v19 **[New Infolabel]** \link Player_Process_videolatency `Player.Process(videolatency)`\endlink
+///     <p>
+///   }
 /// \table_end
 ///
 /// -----------------------------------------------------------------------------
@@ -951,7 +974,9 @@ const infomap player_process[] =
   { "audiodecoder", PLAYER_PROCESS_AUDIODECODER },
   { "audiochannels", PLAYER_PROCESS_AUDIOCHANNELS },
   { "audiosamplerate", PLAYER_PROCESS_AUDIOSAMPLERATE },
-  { "audiobitspersample", PLAYER_PROCESS_AUDIOBITSPERSAMPLE }
+  { "audiobitspersample", PLAYER_PROCESS_AUDIOBITSPERSAMPLE },
+  { "videothreading", PLAYER_PROCESS_VIDEOTHREADING },
+  { "videolatency", PLAYER_PROCESS_VIDEOLATENCY }
 };
 
 /// \page modules__infolabels_boolean_conditions
@@ -1589,6 +1614,9 @@ const infomap weather[] =        {{ "isfetched",        WEATHER_IS_FETCHED },
 ///       - <b>used</b>
 ///       - <b>used.percent</b>
 ///       - <b>total</b>
+///       - <b>texture</b> - memory of the decoded textures of the GUI
+///       - <b>texture.budget</b> - memory the GUI keeps its textures within
+///       - <b>texture.percent</b> - texture memory in percent of the budget
 ///     <p>
 ///   }
 ///   \table_row3{   <b>`System.AddonTitle(id)`</b>,
@@ -6546,6 +6574,15 @@ const infomap playlist[] =       {{ "length",           PLAYLIST_LENGTH },
 ///     @return The provider name of the played channel if available.
 ///     <p>
 ///   }
+///   \table_row3{   <b>`PVR.ChannelZapTime`</b>,
+///                  \anchor PVR_ChannelZapTime
+///                  _string_,
+///     @return The time in milliseconds it took to switch to the playing channel\, from opening
+///     the stream until its first picture was shown.
+///     <p><hr>
+///     @skinning_v19 **[New Infolabel]** \link PVR_ChannelZapTime `PVR.ChannelZapTime`\endlink
+///     <p>
+///   }
 ///   \table_row3{   <b>`PVR.IsTimeShift`</b>,
 ///                  \anchor PVR_IsTimeShift
 ///                  _boolean_,
@@ -6901,6 +6938,7 @@ const infomap pvr[] =            {{ "isrecording",              PVR_IS_RECORDING
                                   { "actstreamservicename",     PVR_ACTUAL_STREAM_SERVICE },
                                   { "actstreammux",             PVR_ACTUAL_STREAM_MUX },
                                   { "actstreamprovidername",    PVR_ACTUAL_STREAM_PROVIDER },
+                                  { "channelzaptime",           PVR_CHANNEL_ZAP_TIME },
                                   { "istimeshift",              PVR_IS_TIMESHIFTING },
                                   { "timeshiftprogress",        PVR_TIMESHIFT_PROGRESS },
                                   { "nowrecordingtitle",        PVR_NOW_RECORDING_TITLE },
@@ -8797,6 +8835,12 @@ int CGUIInfoManager::TranslateSingleString(const std::string &strCondition, bool
             return SYSTEM_USED_MEMORY_PERCENT;
           else if (param == "total")
             return SYSTEM_TOTAL_MEMORY;
+          else if (param == "texture")
+            return SYSTEM_TEXTURE_MEMORY;
+          else if (param == "texture.budget")
+            return SYSTEM_TEXTURE_MEMORY_BUDGET;
+          else if (param == "texture.percent")
+            return SYSTEM_TEXTURE_MEMORY_PERCENT;
         }
         else if (prop.name == "addontitle")
         {
@@ -9304,6 +9348,94 @@ TIME_FORMAT CGUIInfoManager::TranslateTimeFormat(const std::string &format)
 }
 
 std::string CGUIInfoManager::GetLabel(int info, int contextWindow, std::string *fallback) const
+{
+  // several controls and includes often show the same label, evaluate it once per frame
+  const unsigned int refresh = m_refreshCounter;
+  const auto key = std::make_pair(info, contextWindow);
+  {
+    CSingleLock lock(m_labelCacheLock);
+    auto it = m_labelCache.find(key);
+    if (it == m_labelCache.end())
+    {
+      it = m_labelCache.emplace(key, CachedLabel()).first;
+      it->second.cacheable = IsCacheableLabel(info);
+    }
+
+    CachedLabel& cached = it->second;
+    if (!fallback && cached.cacheable && cached.evaluated && cached.refresh == refresh)
+    {
+      cached.hits++;
+      return cached.label;
+    }
+  }
+
+  const auto start = std::chrono::steady_clock::now();
+  std::string label = EvaluateLabel(info, contextWindow, fallback);
+  const auto time = std::chrono::steady_clock::now() - start;
+
+  CSingleLock lock(m_labelCacheLock);
+  auto it = m_labelCache.find(key);
+  if (it != m_labelCache.end())
+  {
+    CachedLabel& cached = it->second;
+    cached.evaluations++;
+    cached.time += std::chrono::duration_cast<std::chrono::microseconds>(time).count();
+    if (!fallback && cached.cacheable)
+    {
+      cached.label = label;
+      cached.refresh = refresh;
+      cached.evaluated = true;
+    }
+  }
+  return label;
+}
+
+bool CGUIInfoManager::IsCacheableLabel(int info) const
+{
+  // the focused list item changes while the windows are processed
+  if (IsListItemInfo(info) || (info >= CONDITIONAL_LABEL_START && info <= CONDITIONAL_LABEL_END))
+    return false;
+
+  if (info >= MULTI_INFO_START && info <= MULTI_INFO_END)
+    return !m_infoProviders.IsVolatile(m_multiInfo[info - MULTI_INFO_START]);
+
+  return !m_infoProviders.IsVolatile(CGUIInfo(info));
+}
+
+std::vector<CGUIInfoManager::LabelStatistics> CGUIInfoManager::GetLabelStatistics(size_t count) const
+{
+  std::vector<LabelStatistics> statistics;
+
+  CSingleLock lock(m_labelCacheLock);
+  // labels shown in several windows are summed up
+  std::map<int, LabelStatistics> labels;
+  for (const auto& it : m_labelCache)
+  {
+    LabelStatistics& label = labels[it.first.first];
+    label.evaluations += it.second.evaluations;
+    label.hits += it.second.hits;
+    label.time += it.second.time;
+  }
+
+  for (auto& it : labels)
+  {
+    const auto name = m_infoNames.find(it.first);
+    if (name == m_infoNames.end())
+      continue;
+
+    it.second.name = name->second;
+    statistics.push_back(it.second);
+  }
+  lock.Leave();
+
+  std::sort(statistics.begin(), statistics.end(),
+            [](const LabelStatistics& a, const LabelStatistics& b) { return a.time > b.time; });
+  if (statistics.size() > count)
+    statistics.resize(count);
+  return statistics;
+}
+
+std::string CGUIInfoManager::EvaluateLabel(int info, int contextWindow, std::string *fallback) const
 {
   if (info >= CONDITIONAL_LABEL_START && info <= CONDITIONAL_LABEL_END)
   {
@@ -9405,6 +9537,28 @@ bool CGUIInfoManager::GetBool(int condition1, int contextWindow, const CGUIListI
   return (condition1 < 0) ? !bReturn : bReturn;
 }
 
+const std::atomic<unsigned int>* CGUIInfoManager::GetInfoVersion(int info) const
+{
+  info = std::abs(info);
+
+  if (info >= MULTI_INFO_START && info <= MULTI_INFO_END)
+    return m_infoProviders.GetVersion(m_multiInfo[info - MULTI_INFO_START]);
+  else if ((info >= LISTITEM_START && info <= LISTITEM_END) ||
+           (info >= CONDITIONAL_LABEL_START && info <= CONDITIONAL_LABEL_END))
+    return nullptr;
+
+  return m_infoProviders.GetVersion(CGUIInfo(info));
+}
+
+bool CGUIInfoManager::IsConstantInfo(int info)
+{
+  info = std::abs(info);
+  if (info >= LISTITEM_START)
+    return false;
+
+  return m_infoProviders.GetSystemInfoProvider().IsConstant(CGUIInfo(info));
+}
+
 bool CGUIInfoManager::GetMultiInfoBool(const CGUIInfo &info, int contextWindow, const CGUIListItem *item)
 {
   bool bReturn = false;
@@ -9677,6 +9831,12 @@ void CGUIInfoManager::Clear()
   CSingleLock lock(m_critInfo);
   m_skinVariableStrings.clear();
 
+  {
+    // the statistics are per skin
+    CSingleLock lock(m_labelCacheLock);
+    m_labelCache.clear();
+  }
+
   /*
     Erase any info bools that are unused. We do this repeatedly as each run
     will remove those bools that are no longer dependencies of other bools
@@ -9716,14 +9876,15 @@ void CGUIInfoManager::UpdateAVInfo()
 int CGUIInfoManager::AddMultiInfo(const CGUIInfo &info)
 {
   // check to see if we have this info already
-  for (unsigned int i = 0; i < m_multiInfo.size(); ++i)
-    if (m_multiInfo[i] == info)
-      return static_cast<int>(i) + MULTI_INFO_START;
+  auto it = m_multiInfoIds.find(info);
+  if (it != m_multiInfoIds.end())
+    return it->second;
   // return the new offset
   m_multiInfo.emplace_back(info);
   int id = static_cast<int>(m_multiInfo.size()) + MULTI_INFO_START - 1;
   if (id > MULTI_INFO_END)
     CLog::Log(LOGERROR, "%s - too many multiinfo bool/labels in this skin", __FUNCTION__);
+  m_multiInfoIds.emplace(info, id);
   return id;
 }
 
@@ -14,10 +14,13 @@
 #include "messaging/IMessageTarget.h"
 #include "threads/CriticalSection.h"
 
+#include <atomic>
 #include <map>
 #include <memory>
 #include <set>
+#include <stdint.h>
 #include <string>
+#include <utility>
 #include <vector>
 
 class CFileItem;
@@ -91,11 +94,26 @@ public:
   int TranslateString(const std::string &strCondition);
   int TranslateSingleString(const std::string &strCondition, bool &listItemDependent);
 
+  /*! \brief Get the value of a label
+   Values are cached until the end of the frame, unless they depend on list items, a
+   provider reports them as volatile or a fallback is requested.
+   */
   std::string GetLabel(int info, int contextWindow = 0, std::string *fallback = nullptr) const;
   std::string GetImage(int info, int contextWindow, std::string *fallback = nullptr);
   bool GetInt(int &value, int info, int contextWindow = 0, const CGUIListItem *item = nullptr) const;
   bool GetBool(int condition, int contextWindow = 0, const CGUIListItem *item = nullptr);
 
+  /*! \brief Get the version of an info value
+   \param info id of info, as returned by TranslateString
+   \return counter that changes whenever the value may have changed, nullptr if the value has to be evaluated every time
+   */
+  const std::atomic<unsigned int>* GetInfoVersion(int info) const;
+
+  /*! \brief Whether an info value is known to never change while running
+   \param info id of info, as returned by TranslateString
+   */
+  bool IsConstantInfo(int info);
+
   std::string GetItemLabel(const CFileItem *item, int contextWindow, int info, std::string *fallback = nullptr) const;
   std::string GetItemImage(const CGUIListItem *item, int contextWindow, int info, std::string *fallback = nullptr) const;
   /*! \brief Get integer value of info.
@@ -142,6 +160,19 @@ public:
    */
   KODI::GUILIB::GUIINFO::CGUIInfoProviders& GetInfoProviders() { return m_infoProviders; }
 
+  struct LabelStatistics
+  {
+    std::string name;
+    uint64_t evaluations = 0;
+    uint64_t hits = 0; //!< requests answered from the cache of the frame
+    uint64_t time = 0; //!< us spent evaluating
+  };
+
+  /*! \brief The labels that took the most time to evaluate since the skin was loaded
+   \param count maximum number of labels to return
+   */
+  std::vector<LabelStatistics> GetLabelStatistics(size_t count) const;
+
 private:
   /*! \brief class for holding information on properties
    */
@@ -184,6 +215,9 @@ private:
 
   std::string GetSkinVariableString(int info, bool preferImage = false, const CGUIListItem *item = nullptr) const;
 
+  std::string EvaluateLabel(int info, int contextWindow, std::string *fallback) const;
+  bool IsCacheableLabel(int info) const;
+
   int AddMultiInfo(const KODI::GUILIB::GUIINFO::CGUIInfo &info);
 
   int ResolveMultiInfo(int info) const;
@@ -194,16 +228,32 @@ private:
 
   // Vector of multiple information mapped to a single integer lookup
   std::vector<KODI::GUILIB::GUIINFO::CGUIInfo> m_multiInfo;
+  std::map<KODI::GUILIB::GUIINFO::CGUIInfo, int> m_multiInfoIds; ///< interned ids of m_multiInfo
 
   // Current playing stuff
   CFileItem* m_currentFile;
 
   typedef std::set<INFO::InfoPtr, bool(*)(const INFO::InfoPtr&, const INFO::InfoPtr&)> INFOBOOLTYPE;
   INFOBOOLTYPE m_bools;
-  unsigned int m_refreshCounter = 0;
+  std::atomic<unsigned int> m_refreshCounter{0};
   std::vector<INFO::CSkinVariableString> m_skinVariableStrings;
 
   CCriticalSection m_critInfo;
 
+  struct CachedLabel
+  {
+    bool cacheable = false;
+    bool evaluated = false;
+    unsigned int refresh = 0; ///< m_refreshCounter the label was evaluated at
+    std::string label;
+    uint64_t evaluations = 0;
+    uint64_t hits = 0;
+    uint64_t time = 0; ///< us
+  };
+
+  mutable CCriticalSection m_labelCacheLock;
+  mutable std::map<std::pair<int, int>, CachedLabel> m_labelCache; ///< by info and context window
+  std::map<int, std::string> m_infoNames; ///< for the statistics
+
   KODI::GUILIB::GUIINFO::CGUIInfoProviders m_infoProviders;
 };
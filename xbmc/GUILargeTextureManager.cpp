@@ -8,8 +8,13 @@
 
 #include "GUILargeTextureManager.h"
 
+#include "ServiceBroker.h"
 #include "TextureCache.h"
+#include "guilib/GUIComponent.h"
+#include "guilib/GUITextureBudget.h"
 #include "guilib/Texture.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
 #include "threads/SystemClock.h"
 #include "utils/JobManager.h"
@@ -17,8 +22,18 @@
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
 
+#include <algorithm>
 #include <cassert>
 
+namespace
+{
+// assumed size of a prefetched image until some of them finished loading
+const size_t DEFAULT_IMAGE_SIZE = 2 * 1024 * 1024;
+
+// bytes uploaded to the GPU per frame, larger images are uploaded over several frames
+const size_t UPLOAD_BYTES_PER_FRAME = 8 * 1024 * 1024;
+}
+
 CImageLoader::CImageLoader(const std::string &path, const bool useCache):
   m_path(path)
 {
@@ -85,6 +100,8 @@ CGUILargeTextureManager::CLargeTexture::~CLargeTexture()
 {
   assert(m_refCount == 0);
   m_texture.Free();
+  if (m_memoryUsage && CServiceBroker::GetGUI())
+    CServiceBroker::GetGUI()->GetTextureBudget().Remove(CGUITextureBudget::POOL_LARGE, m_memoryUsage);
 }
 
 void CGUILargeTextureManager::CLargeTexture::AddRef()
@@ -117,16 +134,46 @@ bool CGUILargeTextureManager::CLargeTexture::DeleteIfRequired(bool deleteImmedia
   return false;
 }
 
+bool CGUILargeTextureManager::CLargeTexture::Upload(size_t &budget)
+{
+  if (m_uploaded || !m_texture.size())
+  {
+    m_uploaded = true;
+    return true;
+  }
+  if (budget == 0)
+    return false;
+
+  CBaseTexture *texture = m_texture.m_textures[0];
+  const size_t uploaded = std::min(budget, static_cast<size_t>(texture->GetPitch()) * texture->GetRows());
+  m_uploaded = texture->LoadToGPUPartially(budget);
+  budget = m_uploaded ? budget - uploaded : 0;
+  return m_uploaded;
+}
+
 void CGUILargeTextureManager::CLargeTexture::SetTexture(CBaseTexture* texture)
 {
   assert(!m_texture.size());
   if (texture)
+  {
+    m_memoryUsage = static_cast<size_t>(texture->GetPitch()) * texture->GetRows();
     m_texture.Set(texture, texture->GetWidth(), texture->GetHeight());
+    if (CServiceBroker::GetGUI())
+      CServiceBroker::GetGUI()->GetTextureBudget().Add(CGUITextureBudget::POOL_LARGE, m_memoryUsage);
+    else
+      m_memoryUsage = 0;
+  }
 }
 
-CGUILargeTextureManager::CGUILargeTextureManager() = default;
+CGUILargeTextureManager::CGUILargeTextureManager()
+{
+  CMemoryPressureManager::GetInstance().Register(this, "large textures", CMemoryPressureManager::PRIORITY_GUI);
+}
 
-CGUILargeTextureManager::~CGUILargeTextureManager() = default;
+CGUILargeTextureManager::~CGUILargeTextureManager()
+{
+  CMemoryPressureManager::GetInstance().Unregister(this);
+}
 
 void CGUILargeTextureManager::CleanupUnusedImages(bool immediately)
 {
@@ -141,6 +188,22 @@ void CGUILargeTextureManager::CleanupUnusedImages(bool immediately)
     else
       ++it;
   }
+
+  // over budget, free the unused images right away, the ones released the longest ago first
+  const CGUITextureBudget &budget = CServiceBroker::GetGUI()->GetTextureBudget();
+  while (budget.IsExceeded())
+  {
+    listIterator oldest = m_allocated.end();
+    for (it = m_allocated.begin(); it != m_allocated.end(); ++it)
+    {
+      if ((*it)->IsUnused() && (oldest == m_allocated.end() || (*it)->GetTimeToDelete() < (*oldest)->GetTimeToDelete()))
+        oldest = it;
+    }
+    if (oldest == m_allocated.end())
+      break;
+    (*oldest)->DeleteIfRequired(true);
+    m_allocated.erase(oldest);
+  }
 }
 
 // if available, increment reference count, and return the image.
@@ -155,6 +218,17 @@ bool CGUILargeTextureManager::GetImage(const std::string &path, CTextureArray &t
     {
       if (firstRequest)
         image->AddRef();
+
+      // the texture is handed out once it's completely on the GPU
+      const unsigned int frameTime = CTimeUtils::GetFrameTime();
+      if (frameTime != m_uploadFrameTime)
+      {
+        m_uploadFrameTime = frameTime;
+        m_uploadBudget = UPLOAD_BYTES_PER_FRAME;
+      }
+      if (!image->Upload(m_uploadBudget))
+        return true;
+
       texture = image->GetTexture();
       return texture.size() > 0;
     }
@@ -193,8 +267,100 @@ void CGUILargeTextureManager::ReleaseImage(const std::string &path, bool immedia
   }
 }
 
+void CGUILargeTextureManager::PrefetchImages(const void *owner, const std::vector<std::string> &paths)
+{
+  CSingleLock lock(m_listSection);
+  std::vector<std::string> &held = m_prefetched[owner];
+
+  // the images of the other owners count against the budget as well
+  const size_t budget = static_cast<size_t>(std::max(CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiArtPrefetchMemory, 0)) * 1024 * 1024;
+  size_t used = 0;
+  for (const auto &prefetched : m_prefetched)
+  {
+    if (prefetched.first != owner)
+    {
+      for (const std::string &path : prefetched.second)
+        used += GetPrefetchSize(path);
+    }
+  }
+
+  // when all textures together are over budget only the images we already have are kept
+  const bool exceeded = CServiceBroker::GetGUI()->GetTextureBudget().IsExceeded();
+
+  std::vector<std::string> wanted;
+  for (const std::string &path : paths)
+  {
+    if (path.empty() || std::find(wanted.begin(), wanted.end(), path) != wanted.end())
+      continue;
+    if (exceeded && std::find(held.begin(), held.end(), path) == held.end())
+      continue;
+    const size_t size = GetPrefetchSize(path);
+    if (used + size > budget)
+      break;
+    used += size;
+    wanted.push_back(path);
+  }
+
+  // reference the new images before releasing the old ones, so that images in both lists stay loaded
+  for (const std::string &path : wanted)
+  {
+    if (std::find(held.begin(), held.end(), path) != held.end())
+      continue;
+    auto image = std::find_if(m_allocated.begin(), m_allocated.end(),
+                              [&path](const CLargeTexture *image) { return image->GetPath() == path; });
+    if (image != m_allocated.end())
+      (*image)->AddRef();
+    else
+      QueueImage(path, true, CJob::PRIORITY_LOW);
+  }
+  for (const std::string &path : held)
+  {
+    if (std::find(wanted.begin(), wanted.end(), path) == wanted.end())
+      ReleaseImage(path);
+  }
+
+  if (wanted.empty())
+    m_prefetched.erase(owner);
+  else
+    held = std::move(wanted);
+}
+
+void CGUILargeTextureManager::CancelPrefetch(const void *owner)
+{
+  PrefetchImages(owner, std::vector<std::string>());
+}
+
+void CGUILargeTextureManager::OnMemoryPressure(MemoryPressure level)
+{
+  if (level == MemoryPressure::CRITICAL)
+  {
+    std::vector<const void*> owners;
+    {
+      CSingleLock lock(m_listSection);
+      for (const auto& prefetched : m_prefetched)
+        owners.push_back(prefetched.first);
+    }
+    for (const void* owner : owners)
+      CancelPrefetch(owner);
+  }
+
+  CleanupUnusedImages(true);
+}
+
+size_t CGUILargeTextureManager::GetPrefetchSize(const std::string &path) const
+{
+  for (const CLargeTexture *image : m_allocated)
+  {
+    if (image->GetPath() == path && image->GetMemoryUsage())
+      return image->GetMemoryUsage();
+  }
+  if (m_prefetchedCount)
+    return m_prefetchedMemory / m_prefetchedCount;
+  return DEFAULT_IMAGE_SIZE;
+}
+
 // queue the image, and start the background loader if necessary
-void CGUILargeTextureManager::QueueImage(const std::string &path, bool useCache)
+void CGUILargeTextureManager::QueueImage(const std::string &path, bool useCache, CJob::PRIORITY priority)
 {
   if (path.empty())
     return;
@@ -206,13 +372,20 @@ void CGUILargeTextureManager::QueueImage(const std::string &path, bool useCache)
     if (image->GetPath() == path)
     {
       image->AddRef();
+      if (priority > image->GetPriority())
+      { // a prefetched image is needed now, don't leave it behind the other low priority jobs
+        CJobManager::GetInstance().CancelJob(it->first);
+        it->first = CJobManager::GetInstance().AddJob(new CImageLoader(path, useCache), this, priority);
+        image->SetPriority(priority);
+      }
       return; // already queued
     }
   }
 
   // queue the item
   CLargeTexture *image = new CLargeTexture(path);
-  unsigned int jobID = CJobManager::GetInstance().AddJob(new CImageLoader(path, useCache), this, CJob::PRIORITY_NORMAL);
+  image->SetPriority(priority);
+  unsigned int jobID = CJobManager::GetInstance().AddJob(new CImageLoader(path, useCache), this, priority);
   m_queued.emplace_back(jobID, image);
 }
 
@@ -228,6 +401,11 @@ void CGUILargeTextureManager::OnJobComplete(unsigned int jobID, bool success, CJ
       CLargeTexture *image = it->second;
       image->SetTexture(loader->m_texture);
       loader->m_texture = NULL; // we want to keep the texture, and jobs are auto-deleted.
+      if (image->GetPriority() == CJob::PRIORITY_LOW && image->GetMemoryUsage())
+      {
+        m_prefetchedMemory += image->GetMemoryUsage();
+        m_prefetchedCount++;
+      }
       m_queued.erase(it);
       m_allocated.push_back(image);
       return;
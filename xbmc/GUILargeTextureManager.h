@@ -11,7 +11,10 @@
 #include "guilib/TextureManager.h"
 #include "threads/CriticalSection.h"
 #include "utils/Job.h"
+#include "utils/MemoryPressure.h"
 
+#include <map>
+#include <string>
 #include <utility>
 #include <vector>
 
@@ -48,7 +51,7 @@ public:
 
  \sa IJobCallback, CGUITexture
  */
-class CGUILargeTextureManager : public IJobCallback
+class CGUILargeTextureManager : public IJobCallback, public IMemoryPressureHandler
 {
 public:
   CGUILargeTextureManager();
@@ -103,6 +106,32 @@ public:
    */
   void CleanupUnusedImages(bool immediately = false);
 
+  /*!
+   \brief Load images before they are needed, e.g. the art of the items a container scrolls towards.
+
+   The images are loaded at low priority and held until they are no longer part of the images of the
+   owner. Images of an earlier call that aren't wanted any longer are released, which cancels their
+   loading if it didn't finish yet. The images of all owners are limited to the memory budget given by
+   the advanced settings, the ones that don't fit any longer are dropped from the end of the list.
+
+   \param owner identifies the caller, e.g. the container.
+   \param paths paths of the images, the ones needed first come first.
+   \sa CancelPrefetch
+   */
+  void PrefetchImages(const void *owner, const std::vector<std::string> &paths);
+
+  /*!
+   \brief Release all images that were prefetched for an owner.
+   \param owner the owner as passed to PrefetchImages.
+   \sa PrefetchImages
+   */
+  void CancelPrefetch(const void *owner);
+
+  /*!
+   \brief Unload the unused images right away, under critical pressure the prefetched ones too
+   */
+  void OnMemoryPressure(MemoryPressure level) override;
+
 private:
   class CLargeTexture
   {
@@ -115,8 +144,20 @@ private:
     bool DeleteIfRequired(bool deleteImmediately = false);
     void SetTexture(CBaseTexture* texture);
 
+    /*!
+     \brief Upload the texture to the GPU, a part at a time if it's large
+     \param budget bytes that may still be uploaded this frame, reduced by the bytes uploaded
+     \return true once the texture is completely on the GPU
+     */
+    bool Upload(size_t &budget);
+
     const std::string &GetPath() const { return m_path; };
     const CTextureArray &GetTexture() const { return m_texture; };
+    size_t GetMemoryUsage() const { return m_memoryUsage; };
+    bool IsUnused() const { return m_refCount == 0; };
+    unsigned int GetTimeToDelete() const { return m_timeToDelete; };
+    CJob::PRIORITY GetPriority() const { return m_priority; };
+    void SetPriority(CJob::PRIORITY priority) { m_priority = priority; };
 
   private:
     static const unsigned int TIME_TO_DELETE = 2000;
@@ -125,15 +166,26 @@ private:
     std::string m_path;
     CTextureArray m_texture;
     unsigned int m_timeToDelete;
+    size_t m_memoryUsage = 0;
+    CJob::PRIORITY m_priority = CJob::PRIORITY_NORMAL;
+    bool m_uploaded = false;
   };
 
-  void QueueImage(const std::string &path, bool useCache = true);
+  void QueueImage(const std::string &path, bool useCache = true, CJob::PRIORITY priority = CJob::PRIORITY_NORMAL);
+  size_t GetPrefetchSize(const std::string &path) const;
 
   std::vector< std::pair<unsigned int, CLargeTexture *> > m_queued;
   std::vector<CLargeTexture *> m_allocated;
   typedef std::vector<CLargeTexture *>::iterator listIterator;
   typedef std::vector< std::pair<unsigned int, CLargeTexture *> >::iterator queueIterator;
 
+  std::map<const void *, std::vector<std::string>> m_prefetched; ///< images held for each prefetch owner
+  size_t m_prefetchedMemory = 0;   ///< memory of the prefetched images that finished loading
+  unsigned int m_prefetchedCount = 0; ///< number of the prefetched images that finished loading
+
+  unsigned int m_uploadFrameTime = 0; ///< frame the upload budget belongs to
+  size_t m_uploadBudget = 0;         ///< bytes that may still be uploaded to the GPU in this frame
+
   CCriticalSection m_listSection;
 };
 
@@ -238,6 +238,22 @@ void CServiceBroker::UnregisterAE()
   m_pActiveAE = nullptr;
 }
 
+IAE* CServiceBroker::m_pMusicAE = nullptr;
+IAE* CServiceBroker::GetMusicAE()
+{
+  if (m_pMusicAE)
+    return m_pMusicAE;
+  return m_pActiveAE;
+}
+void CServiceBroker::RegisterMusicAE(IAE *ae)
+{
+  m_pMusicAE = ae;
+}
+void CServiceBroker::UnregisterMusicAE()
+{
+  m_pMusicAE = nullptr;
+}
+
 // application
 std::shared_ptr<CAppInboundProtocol> CServiceBroker::m_pAppPort;
 std::shared_ptr<CAppInboundProtocol> CServiceBroker::GetAppPort()
@@ -124,6 +124,13 @@ public:
   static void RegisterAE(IAE *ae);
   static void UnregisterAE();
 
+  /*!
+   \brief The engine music plays on, the one of the main output if there's no music zone
+   */
+  static IAE* GetMusicAE();
+  static void RegisterMusicAE(IAE *ae);
+  static void UnregisterMusicAE();
+
   static std::shared_ptr<CAppInboundProtocol> GetAppPort();
   static void RegisterAppPort(std::shared_ptr<CAppInboundProtocol> port);
   static void UnregisterAppPort();
@@ -136,6 +143,7 @@ private:
   static CGUIComponent* m_pGUI;
   static CWinSystemBase* m_pWinSystem;
   static IAE* m_pActiveAE;
+  static IAE* m_pMusicAE;
   static std::shared_ptr<CAppInboundProtocol> m_pAppPort;
   static CSettingsComponent* m_pSettingsComponent;
   static CDecoderFilterManager* m_decoderFilterManager;
@@ -30,6 +30,7 @@
 #include "profiles/ProfileManager.h"
 #include "pvr/PVRManager.h"
 #include "utils/FileExtensionProvider.h"
+#include "utils/StartupTimeline.h"
 #include "utils/log.h"
 #include "weather/WeatherManager.h"
 
@@ -86,6 +87,8 @@ void CServiceManager::DeinitTesting()
 
 bool CServiceManager::InitStageOne()
 {
+  CStartupTimeline::CPhase phase("CServiceManager::InitStageOne");
+
 #ifdef HAS_PYTHON
   m_XBPython.reset(new XBPython());
   CScriptInvocationManager::GetInstance().RegisterLanguageInvocationHandler(m_XBPython.get(), ".py");
@@ -101,12 +104,16 @@ bool CServiceManager::InitStageOne()
 
 bool CServiceManager::InitStageTwo(const CAppParamParser &params, const std::string& profilesUserDataFolder)
 {
+  CStartupTimeline::CPhase phase("CServiceManager::InitStageTwo");
+
   // Initialize the addon database (must be before the addon manager is init'd)
   m_databaseManager.reset(new CDatabaseManager);
 
+  phase.Step("platform");
   m_Platform.reset(CPlatform::CreateInstance());
   m_Platform->Init();
 
+  phase.Step("addon manager");
   m_binaryAddonManager.reset(new ADDON::CBinaryAddonManager()); /* Need to constructed before, GetRunningInstance() of binary CAddonDll need to call them */
   m_addonMgr.reset(new ADDON::CAddonMgr());
   if (!m_addonMgr->Init())
@@ -115,12 +122,14 @@ bool CServiceManager::InitStageTwo(const CAppParamParser &params, const std::str
     return false;
   }
 
+  phase.Step("binary addon manager");
   if (!m_binaryAddonManager->Init())
   {
     CLog::Log(LOGFATAL, "CServiceManager::%s: Unable to initialize CBinaryAddonManager", __FUNCTION__);
     return false;
   }
 
+  phase.Step("addon caches");
   m_repositoryUpdater.reset(new ADDON::CRepositoryUpdater(*m_addonMgr));
 
   m_vfsAddonCache.reset(new ADDON::CVFSAddonCache());
@@ -139,6 +148,7 @@ bool CServiceManager::InitStageTwo(const CAppParamParser &params, const std::str
 
   m_contextMenuManager.reset(new CContextMenuManager(*m_addonMgr));
 
+  phase.Step("input manager");
   m_gameControllerManager.reset(new GAME::CControllerManager);
   m_inputManager.reset(new CInputManager(params));
   m_inputManager->InitializeInputs();
@@ -151,6 +161,7 @@ bool CServiceManager::InitStageTwo(const CAppParamParser &params, const std::str
   m_fileExtensionProvider.reset(new CFileExtensionProvider(*m_addonMgr,
                                                            *m_binaryAddonManager));
 
+  phase.Step("power manager");
   m_powerManager.reset(new CPowerManager());
   m_powerManager->Initialize();
   m_powerManager->SetDefaults();
@@ -164,17 +175,24 @@ bool CServiceManager::InitStageTwo(const CAppParamParser &params, const std::str
 // stage 3 is called after successful initialization of WindowManager
 bool CServiceManager::InitStageThree(const std::shared_ptr<CProfileManager>& profileManager)
 {
+  CStartupTimeline::CPhase phase("CServiceManager::InitStageThree");
+
   // Peripherals depends on strings being loaded before stage 3
+  phase.Step("peripherals");
   m_peripherals->Initialise();
 
+  phase.Step("game services");
   m_gameServices.reset(new GAME::CGameServices(*m_gameControllerManager,
     *m_gameRenderManager,
     *m_peripherals,
     *profileManager));
 
+  phase.Step("context menu manager");
   m_contextMenuManager->Init();
+  phase.Step("PVR manager");
   m_PVRManager->Init();
 
+  phase.Step("player core factory");
   m_playerCoreFactory.reset(new CPlayerCoreFactory(*profileManager));
 
   init_level = 3;
@@ -17,11 +17,13 @@
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
 #include "utils/Crc32.h"
+#include "utils/Digest.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/log.h"
 
 using namespace XFILE;
+using KODI::UTILITY::CDigest;
 
 CTextureCache &CTextureCache::GetInstance()
 {
@@ -40,6 +42,10 @@ void CTextureCache::Initialize()
   CSingleLock lock(m_databaseSection);
   if (!m_database.IsOpen())
     m_database.Open();
+  lock.Leave();
+
+  // share the files of identical images cached before and drop the ones nothing refers to
+  CJobManager::GetInstance().AddJob(new CTextureCompactJob(), nullptr, CJob::PRIORITY_LOW_PAUSABLE);
 }
 
 void CTextureCache::Deinitialize()
@@ -177,7 +183,9 @@ void CTextureCache::ClearCachedImage(const std::string &url, bool deleteSource /
   std::string path = deleteSource ? url : "";
   std::string cachedFile;
   if (ClearCachedTexture(url, cachedFile))
-    path = GetCachedPath(cachedFile);
+    path = !cachedFile.empty() ? GetCachedPath(cachedFile) : "";
+  if (path.empty())
+    return;
   if (CFile::Exists(path))
     CFile::Delete(path);
   path = URIUtils::ReplaceExtension(path, ".dds");
@@ -190,6 +198,8 @@ bool CTextureCache::ClearCachedImage(int id)
   std::string cachedFile;
   if (ClearCachedTexture(id, cachedFile))
   {
+    if (cachedFile.empty()) // still used by other textures
+      return true;
     cachedFile = GetCachedPath(cachedFile);
     if (CFile::Exists(cachedFile))
       CFile::Delete(cachedFile);
@@ -252,6 +262,21 @@ std::string CTextureCache::GetCacheFile(const std::string &url)
   return hash;
 }
 
+std::string CTextureCache::GetContentCacheFile(const std::string &file)
+{
+  auto_buffer buffer;
+  if (CFile().LoadFile(GetCachedPath(file), buffer) <= 0)
+    return "";
+  std::string hash = CDigest::Calculate(CDigest::Type::MD5, buffer.get(), buffer.size());
+  return StringUtils::Format("%c/%s%s", hash[0], hash.c_str(), URIUtils::GetExtension(file).c_str());
+}
+
+bool CTextureCache::IsContentCacheFile(const std::string &file)
+{
+  // named after the crc of the url otherwise, the md5 of the content is longer
+  return URIUtils::ReplaceExtension(URIUtils::GetFileName(file), "").size() == 32;
+}
+
 std::string CTextureCache::GetCachedPath(const std::string &file)
 {
   const std::shared_ptr<CProfileManager> profileManager = CServiceBroker::GetSettingsComponent()->GetProfileManager();
@@ -335,3 +360,65 @@ bool CTextureCache::Export(const std::string &image, const std::string &destinat
   }
   return false;
 }
+
+// concurrent copies to the same host
+#define EXPORT_JOBS_PER_TARGET 4
+
+class CTextureExportQueue::CTargetQueue : public CJobQueue
+{
+public:
+  explicit CTargetQueue(CTextureExportQueue &owner)
+    : CJobQueue(false, EXPORT_JOBS_PER_TARGET, CJob::PRIORITY_LOW),
+      m_owner(owner)
+  {
+  }
+
+  void OnJobComplete(unsigned int jobID, bool success, CJob *job) override
+  {
+    CJobQueue::OnJobComplete(jobID, success, job);
+    // the queue may be destroyed as soon as the owner is told
+    m_owner.OnExportDone();
+  }
+
+private:
+  CTextureExportQueue &m_owner;
+};
+
+CTextureExportQueue::CTextureExportQueue() = default;
+
+CTextureExportQueue::~CTextureExportQueue()
+{
+  Wait();
+}
+
+void CTextureExportQueue::Export(const std::string &image, const std::string &destination, bool overwrite)
+{
+  const CURL url(destination);
+  const std::string target = url.GetProtocol() + "://" + url.GetHostName();
+
+  CSingleLock lock(m_section);
+  std::unique_ptr<CTargetQueue> &queue = m_queues[target];
+  if (!queue)
+    queue.reset(new CTargetQueue(*this));
+
+  m_pending++;
+  queue->Submit([image, destination, overwrite]()
+  {
+    CTextureCache::GetInstance().Export(image, destination, overwrite);
+  });
+}
+
+void CTextureExportQueue::Wait()
+{
+  CSingleLock lock(m_section);
+  while (m_pending > 0)
+    m_done.wait(lock);
+  m_queues.clear();
+}
+
+void CTextureExportQueue::OnExportDone()
+{
+  CSingleLock lock(m_section);
+  m_pending--;
+  m_done.notifyAll();
+}
@@ -9,9 +9,12 @@
 #pragma once
 
 #include "TextureDatabase.h"
+#include "threads/Condition.h"
 #include "threads/Event.h"
 #include "utils/JobManager.h"
 
+#include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -116,6 +119,20 @@ public:
    */
   static std::string GetCacheFile(const std::string &url);
 
+  /*! \brief retrieve the name of a cached file derived from its content
+   Images with the same content get the same name, so they can share a single cached file.
+   \param file name of the cached file, relative to the cache path
+   \return the name for the content of the file including extension, empty if it can't be read
+   \sa IsContentCacheFile
+   */
+  static std::string GetContentCacheFile(const std::string &file);
+
+  /*! \brief check whether a cached file is named after its content
+   \param file name of the cached file, relative to the cache path
+   \sa GetContentCacheFile
+   */
+  static bool IsContentCacheFile(const std::string &file);
+
   /*! \brief retrieve the full path of the given cached file
    \param file name of the file
    \return full path of the cached file
@@ -217,3 +234,34 @@ private:
   CCriticalSection             m_useCountSection;
 };
 
+/*!
+ \brief Exports images with CTextureCache::Export() in the background, e.g. the art of a library export.
+
+ The exports to each host run in a queue of their own, so a slow share doesn't hold up
+ the others and no share is sent more than a few files at once.
+ */
+class CTextureExportQueue
+{
+public:
+  CTextureExportQueue();
+  ~CTextureExportQueue();
+
+  /*! \brief Queue the export of an image, see CTextureCache::Export()
+   */
+  void Export(const std::string &image, const std::string &destination, bool overwrite);
+
+  /*! \brief Wait until all queued exports are done
+   */
+  void Wait();
+
+private:
+  class CTargetQueue;
+
+  void OnExportDone();
+
+  CCriticalSection m_section;
+  XbmcThreads::ConditionVariable m_done;
+  std::map<std::string, std::unique_ptr<CTargetQueue>> m_queues;
+  unsigned int m_pending = 0;
+};
+
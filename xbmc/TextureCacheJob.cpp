@@ -9,6 +9,7 @@
 #include "TextureCacheJob.h"
 #include "ServiceBroker.h"
 #include "TextureCache.h"
+#include "guilib/FFmpegImage.h"
 #include "guilib/Texture.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
@@ -19,6 +20,7 @@
 #include "utils/StringUtils.h"
 #include "video/VideoThumbLoader.h"
 #include "URL.h"
+#include "XBDateTime.h"
 #include "FileItem.h"
 #include "music/MusicThumbLoader.h"
 #include "music/tags/MusicInfoTag.h"
@@ -86,16 +88,27 @@ bool CTextureCacheJob::CacheTexture(CBaseTexture **out_texture)
     m_details.file = m_cachePath + ".jpg";
     if (out_texture)
       *out_texture = LoadImage(CTextureCache::GetCachedPath(m_details.file), width, height, "" /* already flipped */);
+    StoreContentFile();
     CLog::Log(LOGDEBUG, "Fast %s image '%s' to '%s': %p",
               m_oldHash.empty() ? "Caching" : "Recaching", CURL::GetRedacted(image),
               m_details.file, static_cast<void*>(out_texture));
     return true;
   }
 #endif
-  CBaseTexture *texture = LoadImage(image, width, height, additional_info, true);
+  // the decoder can skip the detail the cached image won't have, e.g. decode large jpegs at a reduced size
+  uint32_t decodeWidth = width, decodeHeight = height;
+  CPicture::GetMaxCacheSize(decodeWidth, decodeHeight);
+  CBaseTexture *texture = LoadImage(image, decodeWidth, decodeHeight, additional_info, true);
   if (texture)
   {
-    if (texture->HasAlpha())
+    // block compressed thumbnails are uploaded to the GPU as they are
+    if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageCompression &&
+        CPicture::GetCompressedFormat(texture->HasAlpha()) != XB_FMT_UNKNOWN)
+      m_details.file = m_cachePath + ".dds";
+    // webp keeps the alpha channel, so both kinds of images use it
+    else if (UseWebP())
+      m_details.file = m_cachePath + ".webp";
+    else if (texture->HasAlpha())
       m_details.file = m_cachePath + ".png";
     else
       m_details.file = m_cachePath + ".jpg";
@@ -106,6 +119,7 @@ bool CTextureCacheJob::CacheTexture(CBaseTexture **out_texture)
     {
       m_details.width = width;
       m_details.height = height;
+      StoreContentFile();
       if (out_texture) // caller wants the texture
         *out_texture = texture;
       else
@@ -117,6 +131,24 @@ bool CTextureCacheJob::CacheTexture(CBaseTexture **out_texture)
   return false;
 }
 
+void CTextureCacheJob::StoreContentFile()
+{
+  const std::string file = CTextureCache::GetContentCacheFile(m_details.file);
+  if (file.empty())
+    return;
+
+  // replace an existing copy as well, the compaction job leaves recent files alone until the texture is added
+  const std::string path = CTextureCache::GetCachedPath(m_details.file);
+  const std::string contentPath = CTextureCache::GetCachedPath(file);
+  if (!XFILE::CFile::Rename(path, contentPath))
+  {
+    if (!XFILE::CFile::Exists(contentPath))
+      return;
+    XFILE::CFile::Delete(path);
+  }
+  m_details.file = file;
+}
+
 bool CTextureCacheJob::ResizeTexture(const std::string &url, uint8_t* &result, size_t &result_size)
 {
   result = NULL;
@@ -219,6 +251,17 @@ CBaseTexture *CTextureCacheJob::LoadImage(const std::string &image, unsigned int
   return texture;
 }
 
+bool CTextureCacheJob::UseWebP()
+{
+  if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageCacheFormat != "webp")
+    return false;
+
+  static const bool canEncode = CFFmpegImage::CanEncode("image/webp");
+  if (!canEncode)
+    CLog::Log(LOGDEBUG, "%s - no webp encoder, caching as jpg/png instead", __FUNCTION__);
+  return canEncode;
+}
+
 bool CTextureCacheJob::UpdateableURL(const std::string &url) const
 {
   // we don't constantly check online images
@@ -275,3 +318,73 @@ bool CTextureUseCountJob::DoWork()
   }
   return true;
 }
+
+bool CTextureCompactJob::operator==(const CJob* job) const
+{
+  return strcmp(job->GetType(), GetType()) == 0;
+}
+
+bool CTextureCompactJob::DoWork()
+{
+  CTextureDatabase db;
+  if (!db.Open())
+    return false;
+
+  std::vector<std::string> files;
+  db.GetCachedFiles(files, false);
+
+  unsigned int shared = 0;
+  for (const std::string &file : files)
+  {
+    if (CTextureCache::IsContentCacheFile(file))
+      continue;
+
+    const std::string contentFile = CTextureCache::GetContentCacheFile(file);
+    if (contentFile.empty())
+      continue;
+
+    const std::string path = CTextureCache::GetCachedPath(file);
+    const std::string contentPath = CTextureCache::GetCachedPath(contentFile);
+    if (XFILE::CFile::Exists(contentPath))
+    {
+      XFILE::CFile::Delete(path);
+      shared++;
+    }
+    else if (!XFILE::CFile::Rename(path, contentPath))
+      continue;
+    db.RenameCachedFile(file, contentFile);
+  }
+
+  // files just written may not be in the database yet
+  const CDateTime recent = CDateTime::GetCurrentDateTime() - CDateTimeSpan(0, 1, 0, 0);
+  files.clear();
+  db.GetCachedFiles(files, true);
+
+  unsigned int removed = 0;
+  for (const std::string &file : files)
+  {
+    const std::string path = CTextureCache::GetCachedPath(file);
+    struct __stat64 st;
+    if (XFILE::CFile::Stat(path, &st) == 0 && CDateTime(static_cast<time_t>(st.st_mtime)) > recent)
+      continue;
+    if (!db.RemoveUnusedCachedFile(file))
+      continue;
+    if (XFILE::CFile::Exists(path))
+      XFILE::CFile::Delete(path);
+    removed++;
+  }
+
+  // resized copies made for the webserver are cheap to recreate
+  files.clear();
+  db.RemoveUnusedTransformedImages(CDateTime::GetCurrentDateTime() - CDateTimeSpan(30, 0, 0, 0), files);
+  for (const std::string &file : files)
+  {
+    const std::string path = CTextureCache::GetCachedPath(file);
+    if (XFILE::CFile::Exists(path))
+      XFILE::CFile::Delete(path);
+  }
+
+  CLog::Log(LOGINFO, "CTextureCompactJob::DoWork - %u cached files shared, %u unused ones removed, %u resized copies removed",
+            shared, removed, static_cast<unsigned int>(files.size()));
+  return true;
+}
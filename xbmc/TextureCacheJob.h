@@ -69,10 +69,6 @@ public:
 
   static bool ResizeTexture(const std::string &url, uint8_t* &result, size_t &result_size);
 
-  std::string m_url;
-  std::string m_oldHash;
-  CTextureDetails m_details;
-private:
   /*! \brief retrieve a hash for the given image
    Combines the size, ctime and mtime of the image file into a "unique" hash
    \param url location of the image
@@ -80,6 +76,10 @@ private:
    */
   static std::string GetImageHash(const std::string &url);
 
+  std::string m_url;
+  std::string m_oldHash;
+  CTextureDetails m_details;
+private:
   /*! \brief Check whether a given URL represents an image that can be updated
    We currently don't check http:// and https:// URLs for updates, under the assumption that
    a image URL is much more likely to be static and the actual image at the URL is unlikely
@@ -89,6 +89,9 @@ private:
    */
   bool UpdateableURL(const std::string &url) const;
 
+  /*! \brief Whether images get cached as webp, needs an ffmpeg built with libwebp */
+  static bool UseWebP();
+
   /*! \brief Decode an image URL to the underlying image, width, height and orientation
    \param url wrapped URL of the image
    \param width width derived from URL
@@ -112,6 +115,10 @@ private:
    */
   static CBaseTexture *LoadImage(const std::string &image, unsigned int width, unsigned int height, const std::string &additional_info, bool requirePixels = false);
 
+  /*! \brief Rename the cached file after its content, so identical images share it.
+   */
+  void StoreContentFile();
+
   std::string    m_cachePath;
 };
 
@@ -129,3 +136,19 @@ public:
 private:
   std::vector<CTextureDetails> m_textures;
 };
+
+/*!
+ \ingroup textures
+ \brief Job sharing and cleaning up the files of the texture cache
+
+ Renames the cached files still named after the url of their image after their content, so
+ identical images cached before share a single file, and removes the files no texture uses anymore
+ and the resized copies the webserver made that nobody requested for a month.
+ */
+class CTextureCompactJob : public CJob
+{
+public:
+  const char* GetType() const override { return "texturecompact"; };
+  bool operator==(const CJob *job) const override;
+  bool DoWork() override;
+};
@@ -160,6 +160,12 @@ void CTextureDatabase::CreateTables()
 
   CLog::Log(LOGINFO, "create path table");
   m_pDS->exec("CREATE TABLE path (id integer primary key, url text, type text, texture text)\n");
+
+  CLog::Log(LOGINFO, "create cachedfile table");
+  m_pDS->exec("CREATE TABLE cachedfile (cachedurl text primary key, refcount integer)");
+
+  CLog::Log(LOGINFO, "create transform table");
+  m_pDS->exec("CREATE TABLE transform (id integer primary key, url text, width integer, height integer, scaling text, cachedurl text, imagehash text, lastusetime text)");
 }
 
 void CTextureDatabase::CreateAnalytics()
@@ -168,11 +174,21 @@ void CTextureDatabase::CreateAnalytics()
   m_pDS->exec("CREATE INDEX idxTexture ON texture(url)");
   m_pDS->exec("CREATE INDEX idxSize ON sizes(idtexture, size)");
   m_pDS->exec("CREATE INDEX idxSize2 ON sizes(idtexture, width, height)");
+  m_pDS->exec("CREATE INDEX idxTransform ON transform(url, width, height, scaling)");
   //! @todo Should the path index be a covering index? (we need only retrieve texture)
   m_pDS->exec("CREATE INDEX idxPath ON path(url, type)");
 
   CLog::Log(LOGINFO, "%s creating triggers", __FUNCTION__);
-  m_pDS->exec("CREATE TRIGGER textureDelete AFTER delete ON texture FOR EACH ROW BEGIN delete from sizes where sizes.idtexture=old.id; END");
+  m_pDS->exec("CREATE TRIGGER textureDelete AFTER delete ON texture FOR EACH ROW BEGIN delete from sizes where sizes.idtexture=old.id; "
+              "update cachedfile set refcount=refcount-1 where cachedurl=old.cachedurl; END");
+  // textures with the same content share the cached file, it's only removed with the last of them
+  m_pDS->exec("CREATE TRIGGER textureInsert AFTER insert ON texture FOR EACH ROW BEGIN "
+              "insert or ignore into cachedfile (cachedurl, refcount) values (new.cachedurl, 0); "
+              "update cachedfile set refcount=refcount+1 where cachedurl=new.cachedurl; END");
+  m_pDS->exec("CREATE TRIGGER textureUpdate AFTER update of cachedurl ON texture FOR EACH ROW BEGIN "
+              "update cachedfile set refcount=refcount-1 where cachedurl=old.cachedurl; "
+              "insert or ignore into cachedfile (cachedurl, refcount) values (new.cachedurl, 0); "
+              "update cachedfile set refcount=refcount+1 where cachedurl=new.cachedurl; END");
 }
 
 void CTextureDatabase::UpdateTables(int version)
@@ -228,6 +244,13 @@ void CTextureDatabase::UpdateTables(int version)
     m_pDS->exec("CREATE TABLE texture (id integer primary key, url text, cachedurl text, imagehash text, lasthashcheck text)");
     m_pDS->exec("CREATE TABLE sizes (idtexture integer, size integer, width integer, height integer, usecount integer, lastusetime text)");
   }
+  if (version < 14)
+  { // reference count the cached files, textures with the same content share them
+    m_pDS->exec("CREATE TABLE cachedfile (cachedurl text primary key, refcount integer)");
+    m_pDS->exec("INSERT INTO cachedfile (cachedurl, refcount) SELECT cachedurl, COUNT(*) FROM texture GROUP BY cachedurl");
+  }
+  if (version < 15)
+    m_pDS->exec("CREATE TABLE transform (id integer primary key, url text, width integer, height integer, scaling text, cachedurl text, imagehash text, lastusetime text)");
 }
 
 bool CTextureDatabase::IncrementUseCount(const CTextureDetails &details)
@@ -377,6 +400,9 @@ bool CTextureDatabase::ClearCachedTexture(int id, std::string &cacheFile)
       // remove it
       sql = PrepareSQL("delete from texture where id=%u", id);
       m_pDS->exec(sql);
+      // the file stays as long as other textures share it
+      if (!RemoveUnusedCachedFile(cacheFile))
+        cacheFile.clear();
       return true;
     }
     m_pDS->close();
@@ -388,6 +414,167 @@ bool CTextureDatabase::ClearCachedTexture(int id, std::string &cacheFile)
   return false;
 }
 
+bool CTextureDatabase::RenameCachedFile(const std::string &cacheFile, const std::string &newCacheFile)
+{
+  // the triggers move the references over
+  if (!ExecuteQuery(PrepareSQL("UPDATE texture SET cachedurl='%s' WHERE cachedurl='%s'", newCacheFile.c_str(), cacheFile.c_str())))
+    return false;
+  return ExecuteQuery(PrepareSQL("DELETE FROM cachedfile WHERE cachedurl='%s' AND refcount<=0", cacheFile.c_str()));
+}
+
+bool CTextureDatabase::GetCachedFiles(std::vector<std::string> &cacheFiles, bool unusedOnly)
+{
+  try
+  {
+    if (!m_pDB)
+      return false;
+    if (!m_pDS)
+      return false;
+
+    std::string sql = "SELECT cachedurl FROM cachedfile";
+    if (unusedOnly)
+      sql += " WHERE refcount<=0";
+    if (!m_pDS->query(sql))
+      return false;
+
+    while (!m_pDS->eof())
+    {
+      cacheFiles.push_back(m_pDS->fv(0).get_asString());
+      m_pDS->next();
+    }
+    m_pDS->close();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s, failed", __FUNCTION__);
+  }
+  return false;
+}
+
+bool CTextureDatabase::RemoveUnusedCachedFile(const std::string &cacheFile)
+{
+  try
+  {
+    if (!m_pDB)
+      return false;
+    if (!m_pDS)
+      return false;
+
+    std::string sql = PrepareSQL("SELECT refcount FROM cachedfile WHERE cachedurl='%s'", cacheFile.c_str());
+    m_pDS->query(sql);
+    // files of textures cached before the reference counting aren't tracked
+    const bool unused = m_pDS->eof() || m_pDS->fv(0).get_asInt() <= 0;
+    m_pDS->close();
+    if (!unused)
+      return false;
+
+    sql = PrepareSQL("DELETE FROM cachedfile WHERE cachedurl='%s'", cacheFile.c_str());
+    m_pDS->exec(sql);
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s, failed on file '%s'", __FUNCTION__, cacheFile.c_str());
+  }
+  return false;
+}
+
+bool CTextureDatabase::GetTransformedImage(const std::string &url, unsigned int width, unsigned int height, const std::string &scaling,
+                                           std::string &cacheFile, std::string &hash)
+{
+  try
+  {
+    if (!m_pDB)
+      return false;
+    if (!m_pDS)
+      return false;
+
+    std::string sql = PrepareSQL("SELECT id, cachedurl, imagehash FROM transform WHERE url='%s' AND width=%u AND height=%u AND scaling='%s'",
+                                 url.c_str(), width, height, scaling.c_str());
+    m_pDS->query(sql);
+    if (m_pDS->eof())
+    {
+      m_pDS->close();
+      return false;
+    }
+
+    const int id = m_pDS->fv(0).get_asInt();
+    cacheFile = m_pDS->fv(1).get_asString();
+    hash = m_pDS->fv(2).get_asString();
+    m_pDS->close();
+
+    // keeps the copy from being removed as unused
+    sql = PrepareSQL("UPDATE transform SET lastusetime='%s' WHERE id=%u", CDateTime::GetCurrentDateTime().GetAsDBDateTime().c_str(), id);
+    m_pDS->exec(sql);
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s, failed on url '%s'", __FUNCTION__, url.c_str());
+  }
+  return false;
+}
+
+bool CTextureDatabase::AddTransformedImage(const std::string &url, unsigned int width, unsigned int height, const std::string &scaling,
+                                           const std::string &cacheFile, const std::string &hash)
+{
+  try
+  {
+    if (!m_pDB)
+      return false;
+    if (!m_pDS)
+      return false;
+
+    std::string sql = PrepareSQL("DELETE FROM transform WHERE url='%s' AND width=%u AND height=%u AND scaling='%s'",
+                                 url.c_str(), width, height, scaling.c_str());
+    m_pDS->exec(sql);
+
+    sql = PrepareSQL("INSERT INTO transform (id, url, width, height, scaling, cachedurl, imagehash, lastusetime) VALUES(NULL, '%s', %u, %u, '%s', '%s', '%s', '%s')",
+                     url.c_str(), width, height, scaling.c_str(), cacheFile.c_str(), hash.c_str(),
+                     CDateTime::GetCurrentDateTime().GetAsDBDateTime().c_str());
+    m_pDS->exec(sql);
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s, failed on url '%s'", __FUNCTION__, url.c_str());
+  }
+  return false;
+}
+
+bool CTextureDatabase::RemoveUnusedTransformedImages(const CDateTime &lastUsed, std::vector<std::string> &cacheFiles)
+{
+  try
+  {
+    if (!m_pDB)
+      return false;
+    if (!m_pDS)
+      return false;
+
+    const std::string date = lastUsed.GetAsDBDateTime();
+    std::string sql = PrepareSQL("SELECT cachedurl FROM transform WHERE lastusetime<'%s'", date.c_str());
+    if (!m_pDS->query(sql))
+      return false;
+
+    while (!m_pDS->eof())
+    {
+      cacheFiles.push_back(m_pDS->fv(0).get_asString());
+      m_pDS->next();
+    }
+    m_pDS->close();
+
+    sql = PrepareSQL("DELETE FROM transform WHERE lastusetime<'%s'", date.c_str());
+    m_pDS->exec(sql);
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s, failed", __FUNCTION__);
+  }
+  return false;
+}
+
 bool CTextureDatabase::InvalidateCachedTexture(const std::string &url)
 {
   std::string date = (CDateTime::GetCurrentDateTime() - CDateTimeSpan(2, 0, 0, 0)).GetAsDBDateTime();
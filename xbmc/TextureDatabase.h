@@ -15,6 +15,7 @@
 #include <string>
 #include <vector>
 
+class CDateTime;
 class CVariant;
 
 class CTextureRule : public CDatabaseQueryRule
@@ -65,10 +66,57 @@ public:
   bool GetCachedTexture(const std::string &originalURL, CTextureDetails &details);
   bool AddCachedTexture(const std::string &originalURL, const CTextureDetails &details);
   bool SetCachedTextureValid(const std::string &originalURL, bool updateable);
+
+  /*! \brief Remove a texture from the database
+   \param cacheFile set to the cached file to delete, empty if other textures still share it
+   \return true if the texture was removed
+   */
   bool ClearCachedTexture(const std::string &originalURL, std::string &cacheFile);
   bool ClearCachedTexture(int textureID, std::string &cacheFile);
   bool IncrementUseCount(const CTextureDetails &details);
 
+  /*! \brief Point all textures using a cached file to another one
+   \param cacheFile the cached file the textures use
+   \param newCacheFile the cached file they should use instead
+   */
+  bool RenameCachedFile(const std::string &cacheFile, const std::string &newCacheFile);
+
+  /*! \brief Get the cached files known to the database
+   \param cacheFiles filled with the files, relative to the thumbnails folder
+   \param unusedOnly only get the files no texture refers to anymore
+   */
+  bool GetCachedFiles(std::vector<std::string> &cacheFiles, bool unusedOnly);
+
+  /*! \brief Forget a cached file if no texture refers to it anymore
+   \param cacheFile the cached file
+   \return true if the file is unused and may be deleted
+   */
+  bool RemoveUnusedCachedFile(const std::string &cacheFile);
+
+  /*! \brief Get a resized copy of an image made for the webserver
+   \param url the source image
+   \param width the requested width, 0 if none
+   \param height the requested height, 0 if none
+   \param scaling the requested scaling algorithm, empty for the default
+   \param cacheFile filled with the resized image, relative to the thumbnails folder
+   \param hash filled with the hash of the source image the copy was made from
+   \return true if there's a copy
+   */
+  bool GetTransformedImage(const std::string &url, unsigned int width, unsigned int height, const std::string &scaling,
+                           std::string &cacheFile, std::string &hash);
+
+  /*! \brief Add or replace a resized copy of an image made for the webserver
+   \sa GetTransformedImage
+   */
+  bool AddTransformedImage(const std::string &url, unsigned int width, unsigned int height, const std::string &scaling,
+                           const std::string &cacheFile, const std::string &hash);
+
+  /*! \brief Forget the resized copies that haven't been requested for a while
+   \param lastUsed copies requested before this get removed
+   \param cacheFiles filled with the files of the removed copies
+   */
+  bool RemoveUnusedTransformedImages(const CDateTime &lastUsed, std::vector<std::string> &cacheFiles);
+
   /*! \brief Invalidate a previously cached texture
    Invalidates the texture hash, and sets the texture update time to the current time so that
    next texture load it will be re-cached.
@@ -120,6 +168,6 @@ protected:
   void CreateTables() override;
   void CreateAnalytics() override;
   void UpdateTables(int version) override;
-  int GetSchemaVersion() const override { return 13; };
+  int GetSchemaVersion() const override { return 15; };
   const char *GetBaseDBName() const override { return "Textures"; };
 };
@@ -0,0 +1,277 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "TexturePrecacheJob.h"
+
+#include "ServiceBroker.h"
+#include "TextureCache.h"
+#include "URL.h"
+#include "dialogs/GUIDialogExtendedProgressBar.h"
+#include "guilib/GUIComponent.h"
+#include "guilib/GUIWindowManager.h"
+#include "guilib/LocalizeStrings.h"
+#include "interfaces/AnnouncementManager.h"
+#include "music/MusicDatabase.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/JobManager.h"
+#include "utils/StringUtils.h"
+#include "utils/Variant.h"
+#include "utils/log.h"
+#include "video/VideoDatabase.h"
+
+#include <algorithm>
+#include <deque>
+#include <map>
+#include <set>
+#include <string.h>
+#include <vector>
+
+namespace
+{
+const unsigned int PROGRESS_INTERVAL = 1000;
+
+CCriticalSection statusSection;
+CTexturePrecacheJob::SStatus status;
+}
+
+struct CTexturePrecacheJob::SState
+{
+  int hostConnections = 1;
+
+  CCriticalSection section;
+  std::map<std::string, std::deque<std::string>> pending; ///< urls by host
+  std::map<std::string, int> active;                       ///< workers by host
+  unsigned int total = 0;
+  unsigned int done = 0;
+  unsigned int failed = 0;
+  int workers = 0;
+  bool cancelled = false;
+  CEvent changed;
+};
+
+CTexturePrecacheJob::CTexturePrecacheJob(bool video, bool music)
+  : m_video(video), m_music(music)
+{
+}
+
+CTexturePrecacheJob::~CTexturePrecacheJob()
+{
+  CSingleLock lock(statusSection);
+  status.running = false;
+}
+
+bool CTexturePrecacheJob::operator==(const CJob* job) const
+{
+  return strcmp(job->GetType(), GetType()) == 0;
+}
+
+bool CTexturePrecacheJob::Start(bool video, bool music, bool showProgress)
+{
+  {
+    CSingleLock lock(statusSection);
+    if (status.running)
+      return false;
+    status = SStatus();
+    status.running = true;
+  }
+
+  CTexturePrecacheJob *job = new CTexturePrecacheJob(video, music);
+  if (showProgress)
+  {
+    CGUIDialogExtendedProgressBar *dialog = CServiceBroker::GetGUI()->GetWindowManager().GetWindow<CGUIDialogExtendedProgressBar>(WINDOW_DIALOG_EXT_PROGRESS);
+    if (dialog)
+      job->SetProgressIndicators(dialog->GetHandle(g_localizeStrings.Get(39117)), nullptr);
+  }
+  CJobManager::GetInstance().AddJob(job, nullptr, CJob::PRIORITY_LOW);
+  return true;
+}
+
+CTexturePrecacheJob::SStatus CTexturePrecacheJob::GetStatus()
+{
+  CSingleLock lock(statusSection);
+  return status;
+}
+
+bool CTexturePrecacheJob::DoWork()
+{
+  std::shared_ptr<SState> state = std::make_shared<SState>();
+  const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  state->hostConnections = advancedSettings->m_imagePrecacheHostConnections;
+
+  CollectURLs(*state);
+
+  const int workers = std::min(advancedSettings->m_imagePrecacheThreads, static_cast<int>(state->total));
+  CLog::Log(LOGINFO, "CTexturePrecacheJob::DoWork - caching %u images from %u hosts with %i workers",
+            state->total, static_cast<unsigned int>(state->pending.size()), std::max(workers, 0));
+  {
+    CSingleLock lock(statusSection);
+    status.total = state->total;
+  }
+  Announce("OnArtworkPrecacheProgress");
+
+  state->workers = std::max(workers, 0);
+  for (int i = 0; i < workers; ++i)
+    CJobManager::GetInstance().Submit([state]() { Process(state); }, CJob::PRIORITY_LOW);
+
+  unsigned int lastAnnounce = XbmcThreads::SystemClockMillis();
+  while (true)
+  {
+    state->changed.WaitMSec(PROGRESS_INTERVAL);
+
+    unsigned int done, failed;
+    bool finished;
+    {
+      CSingleLock lock(state->section);
+      done = state->done;
+      failed = state->failed;
+      finished = state->workers == 0;
+    }
+
+    {
+      CSingleLock lock(statusSection);
+      status.done = done;
+      status.failed = failed;
+    }
+
+    if (!finished && ShouldCancel(done, state->total))
+    {
+      CSingleLock lock(state->section);
+      state->cancelled = true;
+      for (auto &host : state->pending)
+        host.second.clear();
+    }
+    SetText(StringUtils::Format("%u / %u", done, state->total));
+
+    if (finished)
+      break;
+
+    if (XbmcThreads::SystemClockMillis() - lastAnnounce >= PROGRESS_INTERVAL)
+    {
+      Announce("OnArtworkPrecacheProgress");
+      lastAnnounce = XbmcThreads::SystemClockMillis();
+    }
+  }
+
+  CLog::Log(LOGINFO, "CTexturePrecacheJob::DoWork - cached %u of %u images, %u failed%s", state->done - state->failed,
+            state->total, state->failed, state->cancelled ? ", cancelled" : "");
+  Announce("OnArtworkPrecacheFinished");
+
+  return !state->cancelled;
+}
+
+void CTexturePrecacheJob::CollectURLs(SState &state) const
+{
+  std::vector<std::string> urls;
+  if (m_video)
+  {
+    CVideoDatabase db;
+    if (db.Open())
+    {
+      db.GetArtURLs(urls);
+      db.Close();
+    }
+  }
+  if (m_music)
+  {
+    CMusicDatabase db;
+    if (db.Open())
+    {
+      db.GetArtURLs(urls);
+      db.Close();
+    }
+  }
+
+  // the libraries share a lot of art, e.g. the thumbs of artists and music videos
+  std::set<std::string> unique;
+  for (const std::string &url : urls)
+  {
+    if (url.empty() || !unique.insert(url).second)
+      continue;
+    if (CTextureCache::GetInstance().HasCachedImage(url))
+      continue;
+    state.pending[CURL(url).GetHostName()].push_back(url);
+    state.total++;
+  }
+}
+
+void CTexturePrecacheJob::Process(std::shared_ptr<SState> state)
+{
+  while (true)
+  {
+    std::string host, url;
+    {
+      CSingleLock lock(state->section);
+      if (state->cancelled)
+        break;
+
+      // the host with the fewest workers that may take one more
+      auto next = state->pending.end();
+      bool pending = false;
+      for (auto it = state->pending.begin(); it != state->pending.end(); ++it)
+      {
+        if (it->second.empty())
+          continue;
+        pending = true;
+        const int active = state->active[it->first];
+        if (active < state->hostConnections && (next == state->pending.end() || active < state->active[next->first]))
+          next = it;
+      }
+      if (!pending)
+        break;
+
+      if (next != state->pending.end())
+      {
+        host = next->first;
+        url = next->second.front();
+        next->second.pop_front();
+        state->active[host]++;
+      }
+    }
+
+    if (url.empty())
+    { // all hosts with images left are busy
+      state->changed.WaitMSec(100);
+      continue;
+    }
+
+    CTextureDetails details;
+    const bool success = CTextureCache::GetInstance().CacheImage(url, details);
+    if (!success)
+      CLog::Log(LOGDEBUG, "CTexturePrecacheJob::Process - unable to cache %s", CURL::GetRedacted(url).c_str());
+
+    {
+      CSingleLock lock(state->section);
+      state->active[host]--;
+      state->done++;
+      if (!success)
+        state->failed++;
+    }
+    state->changed.Set();
+  }
+
+  {
+    CSingleLock lock(state->section);
+    state->workers--;
+  }
+  state->changed.Set();
+}
+
+void CTexturePrecacheJob::Announce(const char *message) const
+{
+  SStatus current = GetStatus();
+  CVariant data(CVariant::VariantTypeObject);
+  data["total"] = current.total;
+  data["done"] = current.done;
+  data["failed"] = current.failed;
+  CServiceBroker::GetAnnouncementManager()->Announce(ANNOUNCEMENT::System, "xbmc", message, data);
+}
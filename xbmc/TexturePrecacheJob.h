@@ -0,0 +1,65 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "utils/ProgressJob.h"
+
+#include <memory>
+#include <string>
+
+/*!
+ \ingroup textures
+ \brief Job caching the art of the whole library ahead of time.
+
+ Collects the urls of the art tables of the video and music databases, skips the ones already in
+ the texture cache and caches the rest with several workers at once. The workers fetch at most
+ <imageprecachehostconnections> images from the same host at once, <imageprecachethreads> in total.
+ Progress is shown in the extended progress bar if requested, and announced as
+ System.OnArtworkPrecacheProgress / System.OnArtworkPrecacheFinished.
+ */
+class CTexturePrecacheJob : public CProgressJob
+{
+public:
+  struct SStatus
+  {
+    bool running = false;
+    unsigned int total = 0;   ///< images that need caching
+    unsigned int done = 0;    ///< images processed so far, including the failed ones
+    unsigned int failed = 0;
+  };
+
+  CTexturePrecacheJob(bool video, bool music);
+  ~CTexturePrecacheJob() override;
+
+  const char *GetType() const override { return "TexturePrecacheJob"; }
+  bool operator==(const CJob* job) const override;
+  bool DoWork() override;
+
+  /*!
+   \brief Start caching the art of the library in the background
+   \param video cache the art of the video library
+   \param music cache the art of the music library
+   \param showProgress show the progress in the extended progress bar
+   \return false if the art is already being cached
+   */
+  static bool Start(bool video, bool music, bool showProgress);
+
+  /*! \brief Get the progress of the running or the last precache job */
+  static SStatus GetStatus();
+
+private:
+  struct SState;
+
+  void CollectURLs(SState &state) const;
+  static void Process(std::shared_ptr<SState> state);
+  void Announce(const char *message) const;
+
+  bool m_video;
+  bool m_music;
+};
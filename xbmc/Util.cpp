@@ -1884,7 +1884,8 @@ void CUtil::GetItemsToScan(const std::string& videoPath,
 void CUtil::ScanPathsForAssociatedItems(const std::string& videoName,
                                         const CFileItemList& items,
                                         const std::vector<std::string>& item_exts,
-                                        std::vector<std::string>& associatedFiles)
+                                        std::vector<std::string>& associatedFiles,
+                                        bool probeUnmatchedArchives /* = true */)
 {
   for (const auto &pItem : items)
   {
@@ -1909,7 +1910,7 @@ void CUtil::ScanPathsForAssociatedItems(const std::string& videoName,
         CLog::Log(LOGINFO, "%s: found associated file %s\n", __FUNCTION__, CURL::GetRedacted(pItem->GetPath()).c_str());
       }
     }
-    else
+    else if (probeUnmatchedArchives)
     {
       if (URIUtils::IsRAR(pItem->GetPath()) || URIUtils::IsZIP(pItem->GetPath()))
         CUtil::ScanArchiveForAssociatedItems(pItem->GetPath(), videoName, item_exts, associatedFiles);
@@ -2010,29 +2011,24 @@ void CUtil::ScanForExternalSubtitles(const std::string& strMovie, std::vector<st
     CMediaSettings::GetInstance().SetAdditionalSubtitleDirectoryChecked(1);
   }
 
-  std::vector<std::string> strLookInPaths;
+  std::vector<std::string> exts = StringUtils::Split(subtitleExtensions, '|');
+  exts.erase(std::remove(exts.begin(), exts.end(), ".zip"), exts.end());
+  exts.erase(std::remove(exts.begin(), exts.end(), ".rar"), exts.end());
+
+  ScanPathsForAssociatedItems(strSubtitle, items, exts, vecSubtitles);
+
   // this is last because we dont want to check any common subdirs or cd-dirs in the alternate <subtitles> dir.
+  // it usually holds the subtitles of a whole library, so only archives named after the video are opened
   if (CMediaSettings::GetInstance().GetAdditionalSubtitleDirectoryChecked() == 1)
   {
     std::string strPath2 = customPath;
     URIUtils::AddSlashAtEnd(strPath2);
-    strLookInPaths.push_back(strPath2);
-  }
 
-  int flags = DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_NO_FILE_INFO;
-  for (const std::string& path : strLookInPaths)
-  {
     CFileItemList moreItems;
-    CDirectory::GetDirectory(path, moreItems, subtitleExtensions, flags);
-    items.Append(moreItems);
+    CDirectory::GetDirectory(strPath2, moreItems, subtitleExtensions, DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_NO_FILE_INFO);
+    ScanPathsForAssociatedItems(strSubtitle, moreItems, exts, vecSubtitles, false);
   }
 
-  std::vector<std::string> exts = StringUtils::Split(subtitleExtensions, '|');
-  exts.erase(std::remove(exts.begin(), exts.end(), ".zip"), exts.end());
-  exts.erase(std::remove(exts.begin(), exts.end(), ".rar"), exts.end());
-
-  ScanPathsForAssociatedItems(strSubtitle, items, exts, vecSubtitles);
-
   size_t iSize = vecSubtitles.size();
   for (size_t i = 0; i < iSize; i++)
   {
@@ -226,11 +226,13 @@ private:
     *   \param[in]  items A List of FileItems to scan for associated files.
     *   \param[in]  item_exts A vector of extensions specifying the associated files.
     *   \param[out] associatedFiles A vector containing the full paths of all found associated files.
+    *   \param[in]  probeUnmatchedArchives Whether archives not named after the video are searched as well.
     */
     static void ScanPathsForAssociatedItems(const std::string& videoName,
                                             const CFileItemList& items,
                                             const std::vector<std::string>& item_exts,
-                                            std::vector<std::string>& associatedFiles);
+                                            std::vector<std::string>& associatedFiles,
+                                            bool probeUnmatchedArchives = true);
 
     /** \brief Searches in an archive for associated files of a given video.
     *   \param[in]  strArchivePath The full path of the archive.
@@ -22,6 +22,7 @@
 
 #include <algorithm>
 #include <iterator>
+#include <map>
 #include <utility>
 
 using namespace ADDON;
@@ -695,21 +696,66 @@ bool CAddonDatabase::UpdateRepositoryContent(const std::string& repository, cons
     if (!m_pDS)
       return false;
 
-    DeleteRepository(repository);
+    m_pDB->start_transaction();
 
     int idRepo = SetLastChecked(repository, version, CDateTime::GetCurrentDateTime().GetAsDBDateTime());
     if (idRepo < 0)
+    {
+      RollbackTransaction();
       return false;
+    }
     assert(idRepo > 0);
 
-    m_pDB->start_transaction();
+    // an update of a repository usually changes a few of its add-ons, the
+    // rows of those listed unchanged are kept
+    struct Row
+    {
+      int id;
+      std::string metadata;
+      std::string name;
+      std::string summary;
+      std::string description;
+      std::string news;
+    };
+    std::multimap<std::string, Row> existing;
+    m_pDS->query(PrepareSQL("SELECT addons.id, addonID, version, metadata, name, summary, description, news "
+                            "FROM addons JOIN addonlinkrepo ON addons.id=addonlinkrepo.idAddon "
+                            "WHERE addonlinkrepo.idRepo=%i", idRepo));
+    while (!m_pDS->eof())
+    {
+      Row row{m_pDS->fv(0).get_asInt(), m_pDS->fv(3).get_asString(), m_pDS->fv(4).get_asString(),
+              m_pDS->fv(5).get_asString(), m_pDS->fv(6).get_asString(), m_pDS->fv(7).get_asString()};
+      existing.emplace(m_pDS->fv(1).get_asString() + " " + m_pDS->fv(2).get_asString(), std::move(row));
+      m_pDS->next();
+    }
+    m_pDS->close();
+
     m_pDS->exec(PrepareSQL("UPDATE repo SET checksum='%s' WHERE id='%d'", checksum.c_str(), idRepo));
+
+    size_t added = 0;
     for (const auto& addon : addons)
     {
+      std::string metadata = SerializeMetadata(*addon);
+      auto rows = existing.equal_range(addon->ID() + " " + addon->Version().asString());
+      auto unchanged = std::find_if(rows.first, rows.second,
+                                    [&](const std::pair<const std::string, Row>& row)
+                                    {
+                                      return row.second.metadata == metadata &&
+                                             row.second.name == addon->Name() &&
+                                             row.second.summary == addon->Summary() &&
+                                             row.second.description == addon->Description() &&
+                                             row.second.news == addon->ChangeLog();
+                                    });
+      if (unchanged != rows.second)
+      {
+        existing.erase(unchanged);
+        continue;
+      }
+
       m_pDS->exec(PrepareSQL(
           "INSERT INTO addons (id, metadata, addonID, version, name, summary, description, news) "
           "VALUES (NULL, '%s', '%s', '%s', '%s','%s', '%s','%s')",
-          SerializeMetadata(*addon).c_str(),
+          metadata.c_str(),
           addon->ID().c_str(),
           addon->Version().asString().c_str(),
           addon->Name().c_str(),
@@ -726,9 +772,18 @@ bool CAddonDatabase::UpdateRepositoryContent(const std::string& repository, cons
       }
 
       m_pDS->exec(PrepareSQL("INSERT INTO addonlinkrepo (idRepo, idAddon) VALUES (%i, %i)", idRepo, idAddon));
+      added++;
+    }
+
+    for (const auto& row : existing)
+    {
+      m_pDS->exec(PrepareSQL("DELETE FROM addons WHERE id=%i", row.second.id));
+      m_pDS->exec(PrepareSQL("DELETE FROM addonlinkrepo WHERE idAddon=%i", row.second.id));
     }
 
     m_pDB->commit_transaction();
+    CLog::Log(LOGDEBUG, "%s repo '%s': %zu add-ons added, %zu removed", __FUNCTION__,
+              repository.c_str(), added, existing.size());
     return true;
   }
   catch (...)
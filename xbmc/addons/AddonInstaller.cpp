@@ -35,6 +35,9 @@
 #include "utils/StringUtils.h"
 #include "dialogs/GUIDialogExtendedProgressBar.h"
 #include "URL.h"
+#ifdef HAS_PYTHON
+#include "interfaces/python/PythonCompileInvoker.h"
+#endif
 #ifdef TARGET_POSIX
 #include "platform/posix/XTimeUtils.h"
 #endif
@@ -644,6 +647,18 @@ bool CAddonInstallJob::DoWork()
 
   ADDON::OnPostInstall(m_addon, m_isUpdate, IsModal());
 
+#ifdef HAS_PYTHON
+  // compile python addons now instead of on their first run
+  for (const auto& dependency : m_addon->GetDependencies())
+  {
+    if (dependency.id == "xbmc.python")
+    {
+      CPythonCompileInvoker::CompileAddon(m_addon);
+      break;
+    }
+  }
+#endif
+
   {
     CAddonDatabase database;
     database.Open();
@@ -19,6 +19,7 @@
 #include "filesystem/SpecialProtocol.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
+#include "utils/XMLElementReader.h"
 #include "utils/XMLUtils.h"
 #include "utils/log.h"
 
@@ -101,7 +102,7 @@ void CAddonMgr::UnregisterAddonMgrCallback(TYPE type)
 
 bool CAddonMgr::Init()
 {
-  CSingleLock lock(m_critSection);
+  CExclusiveLock lock(m_critSection);
 
   if (!LoadManifest(m_systemAddons, m_optionalAddons))
   {
@@ -133,6 +134,21 @@ void CAddonMgr::DeInit()
   m_database.Close();
 }
 
+bool CAddonMgr::ReInitDatabase()
+{
+  CExclusiveLock lock(m_critSection);
+
+  m_database.Close();
+  if (!m_database.Open())
+  {
+    CLog::Log(LOGFATAL, "ADDONS: Failed to open database");
+    return false;
+  }
+
+  SyncWithDatabase();
+  return true;
+}
+
 bool CAddonMgr::HasAddons(const TYPE &type)
 {
   VECADDONS addons;
@@ -147,13 +163,13 @@ bool CAddonMgr::HasInstalledAddons(const TYPE &type)
 
 void CAddonMgr::AddToUpdateableAddons(AddonPtr &pAddon)
 {
-  CSingleLock lock(m_critSection);
+  CExclusiveLock lock(m_critSection);
   m_updateableAddons.push_back(pAddon);
 }
 
 void CAddonMgr::RemoveFromUpdateableAddons(AddonPtr &pAddon)
 {
-  CSingleLock lock(m_critSection);
+  CExclusiveLock lock(m_critSection);
   VECADDONS::iterator it = std::find(m_updateableAddons.begin(), m_updateableAddons.end(), pAddon);
 
   if(it != m_updateableAddons.end())
@@ -178,7 +194,7 @@ struct AddonIdFinder
 
 bool CAddonMgr::ReloadSettings(const std::string &id)
 {
-  CSingleLock lock(m_critSection);
+  CExclusiveLock lock(m_critSection);
   VECADDONS::iterator it = std::find_if(m_updateableAddons.begin(), m_updateableAddons.end(), AddonIdFinder(id));
 
   if( it != m_updateableAddons.end())
@@ -190,7 +206,7 @@ bool CAddonMgr::ReloadSettings(const std::string &id)
 
 VECADDONS CAddonMgr::GetAvailableUpdates()
 {
-  CSingleLock lock(m_critSection);
+  CExclusiveLock lock(m_critSection);
   auto start = XbmcThreads::SystemClockMillis();
 
   VECADDONS updates;
@@ -265,7 +281,7 @@ bool CAddonMgr::GetInstallableAddons(VECADDONS& addons)
 
 bool CAddonMgr::GetInstallableAddons(VECADDONS& addons, const TYPE &type)
 {
-  CSingleLock lock(m_critSection);
+  CExclusiveLock lock(m_critSection);
 
   // get all addons
   if (!m_database.GetRepositoryContent(addons))
@@ -295,7 +311,7 @@ bool CAddonMgr::FindInstallableById(const std::string& addonId, AddonPtr& result
 {
   VECADDONS versions;
   {
-    CSingleLock lock(m_critSection);
+    CExclusiveLock lock(m_critSection);
     if (!m_database.FindByAddonId(addonId, versions) || versions.empty())
       return false;
   }
@@ -307,7 +323,7 @@ bool CAddonMgr::FindInstallableById(const std::string& addonId, AddonPtr& result
 
 bool CAddonMgr::GetInstalledBinaryAddons(BINARY_ADDON_LIST& binaryAddonList)
 {
-  CSingleLock lock(m_critSection);
+  CSharedLock lock(m_critSection);
 
   for (auto addon : m_installedAddons)
   {
@@ -323,7 +339,7 @@ bool CAddonMgr::GetInstalledBinaryAddon(const std::string& addonId, BINARY_ADDON
 {
   bool ret = false;
 
-  CSingleLock lock(m_critSection);
+  CSharedLock lock(m_critSection);
 
   AddonInfoPtr addon = GetAddonInfo(addonId);
   if (addon)
@@ -337,22 +353,15 @@ bool CAddonMgr::GetInstalledBinaryAddon(const std::string& addonId, BINARY_ADDON
 
 bool CAddonMgr::GetAddonsInternal(const TYPE &type, VECADDONS &addons, bool enabledOnly)
 {
-  CSingleLock lock(m_critSection);
+  const std::shared_ptr<const AddonIndex> index = GetIndex();
+  const auto& byType = enabledOnly ? index->enabled : index->installed;
+  auto addonInfos = byType.find(type);
+  if (addonInfos == byType.end())
+    return addons.size() > 0;
 
-  for (const auto& addonInfo : m_installedAddons)
+  for (const auto& addonInfo : addonInfos->second)
   {
-    if (type != ADDON_UNKNOWN && !addonInfo.second->IsType(type))
-      continue;
-
-    if (enabledOnly && IsAddonDisabled(addonInfo.second->ID()))
-      continue;
-
-    //FIXME: hack for skipping special dependency addons (xbmc.python etc.).
-    //Will break if any extension point is added to them
-    if (addonInfo.second->MainType() == ADDON_UNKNOWN)
-      continue;
-
-    AddonPtr addon = CAddonBuilder::Generate(addonInfo.second, type);
+    AddonPtr addon = CAddonBuilder::Generate(addonInfo, type);
     if (addon)
     {
       // if the addon has a running instance, grab that
@@ -365,9 +374,41 @@ bool CAddonMgr::GetAddonsInternal(const TYPE &type, VECADDONS &addons, bool enab
   return addons.size() > 0;
 }
 
+void CAddonMgr::UpdateIndex()
+{
+  auto index = std::make_shared<AddonIndex>();
+  for (const auto& addonInfo : m_installedAddons)
+  {
+    //FIXME: hack for skipping special dependency addons (xbmc.python etc.).
+    //Will break if any extension point is added to them
+    if (addonInfo.second->MainType() == ADDON_UNKNOWN)
+      continue;
+
+    const bool enabled = m_disabled.find(addonInfo.first) == m_disabled.end();
+    for (int i = ADDON_UNKNOWN; i < ADDON_MAX; ++i)
+    {
+      const TYPE type = static_cast<TYPE>(i);
+      if (type != ADDON_UNKNOWN && !addonInfo.second->IsType(type))
+        continue;
+
+      index->installed[type].push_back(addonInfo.second);
+      if (enabled)
+        index->enabled[type].push_back(addonInfo.second);
+    }
+  }
+
+  m_index = std::move(index);
+}
+
+std::shared_ptr<const CAddonMgr::AddonIndex> CAddonMgr::GetIndex() const
+{
+  CSharedLock lock(m_critSection);
+  return m_index;
+}
+
 bool CAddonMgr::GetAddon(const std::string &str, AddonPtr &addon, const TYPE &type/*=ADDON_UNKNOWN*/, bool enabledOnly /*= true*/)
 {
-  CSingleLock lock(m_critSection);
+  CSharedLock lock(m_critSection);
 
   AddonInfoPtr addonInfo = GetAddonInfo(str, type);
   if (addonInfo)
@@ -403,22 +444,27 @@ bool CAddonMgr::FindAddons()
   FindAddons(installedAddons, "special://xbmc/addons");
   FindAddons(installedAddons, "special://home/addons");
 
+  CExclusiveLock lock(m_critSection);
+
+  m_installedAddons = std::move(installedAddons);
+  SyncWithDatabase();
+
+  return true;
+}
+
+void CAddonMgr::SyncWithDatabase()
+{
   std::set<std::string> installed;
-  for (const auto& addon : installedAddons)
+  for (const auto& addon : m_installedAddons)
     installed.insert(addon.second->ID());
 
-  CSingleLock lock(m_critSection);
-
-  // Sync with db
   m_database.SyncInstalled(installed, m_systemAddons, m_optionalAddons);
-  for (const auto& addon : installedAddons)
+  for (const auto& addon : m_installedAddons)
   {
     m_database.GetInstallData(addon.second);
     CLog::Log(LOGNOTICE, "CAddonMgr::{}: {} v{} installed", __FUNCTION__, addon.second->ID(), addon.second->Version().asString());
   }
 
-  m_installedAddons = std::move(installedAddons);
-
   // Reload caches
   std::set<std::string> tmp;
   m_database.GetDisabled(tmp);
@@ -428,17 +474,18 @@ bool CAddonMgr::FindAddons()
   m_database.GetBlacklisted(tmp);
   m_updateBlacklist = std::move(tmp);
 
-  return true;
+  UpdateIndex();
 }
 
 bool CAddonMgr::UnloadAddon(const std::string& addonId)
 {
-  CSingleLock lock(m_critSection);
+  CExclusiveLock lock(m_critSection);
 
   if (!IsAddonInstalled(addonId))
     return true;
 
   m_installedAddons.erase(addonId);
+  UpdateIndex();
   CLog::Log(LOGDEBUG, "CAddonMgr: %s unloaded", addonId.c_str());
 
   lock.Leave();
@@ -449,7 +496,7 @@ bool CAddonMgr::UnloadAddon(const std::string& addonId)
 
 bool CAddonMgr::LoadAddon(const std::string& addonId)
 {
-  CSingleLock lock(m_critSection);
+  CExclusiveLock lock(m_critSection);
 
   AddonPtr addon;
   if (GetAddon(addonId, addon, ADDON_UNKNOWN, false))
@@ -487,15 +534,16 @@ bool CAddonMgr::LoadAddon(const std::string& addonId)
 
 void CAddonMgr::OnPostUnInstall(const std::string& id)
 {
-  CSingleLock lock(m_critSection);
+  CExclusiveLock lock(m_critSection);
   m_disabled.erase(id);
   m_updateBlacklist.erase(id);
+  UpdateIndex();
   m_events.Publish(AddonEvents::UnInstalled(id));
 }
 
 bool CAddonMgr::RemoveFromUpdateBlacklist(const std::string& id)
 {
-  CSingleLock lock(m_critSection);
+  CExclusiveLock lock(m_critSection);
   if (!IsBlacklisted(id))
     return true;
   return m_database.RemoveAddonFromBlacklist(id) && m_updateBlacklist.erase(id) > 0;
@@ -503,7 +551,7 @@ bool CAddonMgr::RemoveFromUpdateBlacklist(const std::string& id)
 
 bool CAddonMgr::AddToUpdateBlacklist(const std::string& id)
 {
-  CSingleLock lock(m_critSection);
+  CExclusiveLock lock(m_critSection);
   if (IsBlacklisted(id))
     return true;
   return m_database.BlacklistAddon(id) && m_updateBlacklist.insert(id).second;
@@ -511,7 +559,7 @@ bool CAddonMgr::AddToUpdateBlacklist(const std::string& id)
 
 bool CAddonMgr::IsBlacklisted(const std::string& id) const
 {
-  CSingleLock lock(m_critSection);
+  CSharedLock lock(m_critSection);
   return m_updateBlacklist.find(id) != m_updateBlacklist.end();
 }
 
@@ -520,7 +568,7 @@ void CAddonMgr::UpdateLastUsed(const std::string& id)
   auto time = CDateTime::GetCurrentDateTime();
   CJobManager::GetInstance().Submit([this, id, time](){
     {
-      CSingleLock lock(m_critSection);
+      CExclusiveLock lock(m_critSection);
       m_database.SetLastUsed(id, time);
       auto addonInfo = GetAddonInfo(id);
       if (addonInfo)
@@ -549,7 +597,7 @@ static void ResolveDependencies(const std::string& addonId, std::vector<std::str
 
 bool CAddonMgr::DisableAddon(const std::string& id)
 {
-  CSingleLock lock(m_critSection);
+  CExclusiveLock lock(m_critSection);
   if (!CanAddonBeDisabled(id))
     return false;
   if (m_disabled.find(id) != m_disabled.end())
@@ -558,6 +606,7 @@ bool CAddonMgr::DisableAddon(const std::string& id)
     return false;
   if (!m_disabled.insert(id).second)
     return false;
+  UpdateIndex();
 
   //success
   CLog::Log(LOGDEBUG, "CAddonMgr: %s disabled", id.c_str());
@@ -573,7 +622,7 @@ bool CAddonMgr::DisableAddon(const std::string& id)
 
 bool CAddonMgr::EnableSingle(const std::string& id)
 {
-  CSingleLock lock(m_critSection);
+  CExclusiveLock lock(m_critSection);
 
   if (m_disabled.find(id) == m_disabled.end())
     return true; //already enabled
@@ -592,6 +641,7 @@ bool CAddonMgr::EnableSingle(const std::string& id)
   if (!m_database.DisableAddon(id, false))
     return false;
   m_disabled.erase(id);
+  UpdateIndex();
 
   CServiceBroker::GetEventLog().Add(EventPtr(new CAddonManagementEvent(addon, 24064)));
 
@@ -618,7 +668,7 @@ bool CAddonMgr::EnableAddon(const std::string& id)
 
 bool CAddonMgr::IsAddonDisabled(const std::string& ID)
 {
-  CSingleLock lock(m_critSection);
+  CSharedLock lock(m_critSection);
   return m_disabled.find(ID) != m_disabled.end();
 }
 
@@ -627,7 +677,7 @@ bool CAddonMgr::CanAddonBeDisabled(const std::string& ID)
   if (ID.empty())
     return false;
 
-  CSingleLock lock(m_critSection);
+  CSharedLock lock(m_critSection);
   if (IsSystemAddon(ID))
     return false;
 
@@ -667,7 +717,7 @@ bool CAddonMgr::CanUninstall(const AddonPtr& addon)
 
 bool CAddonMgr::IsSystemAddon(const std::string& id)
 {
-  CSingleLock lock(m_critSection);
+  CSharedLock lock(m_critSection);
   return std::find(m_systemAddons.begin(), m_systemAddons.end(), id) != m_systemAddons.end();
 }
 
@@ -682,6 +732,39 @@ bool CAddonMgr::LoadAddonDescription(const std::string &directory, AddonPtr &add
 
 bool CAddonMgr::AddonsFromRepoXML(const CRepository::DirInfo& repo, const std::string& xml, VECADDONS& addons)
 {
+  // the index of a big repository is several MB, its addon elements are
+  // parsed one at a time instead of building the document of all of them
+  CXMLElementReader reader(xml);
+  if (reader.GetRootName() == "addons")
+  {
+    VECADDONS parsed;
+    bool valid = true;
+    while (reader.Next())
+    {
+      if (reader.GetName() != "addon")
+        continue;
+
+      TiXmlElement* element = reader.Parse();
+      if (element == nullptr)
+      {
+        valid = false;
+        break;
+      }
+
+      auto addonInfo = CAddonInfoBuilder::Generate(element, repo);
+      auto addon = CAddonBuilder::Generate(addonInfo, ADDON_UNKNOWN);
+      if (addon)
+        parsed.push_back(std::move(addon));
+    }
+
+    if (valid && reader.IsValid())
+    {
+      addons.insert(addons.end(), parsed.begin(), parsed.end());
+      return true;
+    }
+    CLog::Log(LOGDEBUG, "CAddonMgr::{}: addons.xml can't be split, parsing it as a whole", __FUNCTION__);
+  }
+
   CXBMCTinyXML doc;
   if (!doc.Parse(xml))
   {
@@ -778,21 +861,17 @@ std::vector<DependencyInfo> CAddonMgr::GetDepsRecursive(const std::string& id)
 
 bool CAddonMgr::GetAddonInfos(AddonInfos& addonInfos, TYPE type)
 {
-  CSingleLock lock(m_critSection);
-
-  bool forUnknown = type == ADDON_UNKNOWN;
-  for (auto& info : m_installedAddons)
-  {
-    if (info.second->MainType() != ADDON_UNKNOWN && (forUnknown || info.second->IsType(type)))
-      addonInfos.push_back(info.second);
-  }
+  const std::shared_ptr<const AddonIndex> index = GetIndex();
+  auto infos = index->installed.find(type);
+  if (infos != index->installed.end())
+    addonInfos.insert(addonInfos.end(), infos->second.begin(), infos->second.end());
 
   return !addonInfos.empty();
 }
 
 const AddonInfoPtr CAddonMgr::GetAddonInfo(const std::string& id, TYPE type /*= ADDON_UNKNOWN*/)
 {
-  CSingleLock lock(m_critSection);
+  CSharedLock lock(m_critSection);
 
   auto addon = m_installedAddons.find(id);
   if (addon != m_installedAddons.end())
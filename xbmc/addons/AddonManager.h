@@ -12,6 +12,7 @@
 #include "AddonDatabase.h"
 #include "Repository.h"
 #include "threads/CriticalSection.h"
+#include "threads/SharedSection.h"
 #include "utils/EventStream.h"
 
 namespace ADDON
@@ -55,6 +56,12 @@ namespace ADDON
   {
   public:
     bool ReInit() { DeInit(); return Init(); }
+
+    /*! \brief Reopen the database of the profile just loaded
+     The add-on folders are shared by all profiles, the add-ons found in them
+     are kept and only their state in the database is read again.
+     */
+    bool ReInitDatabase();
     bool Init();
     void DeInit();
 
@@ -243,21 +250,41 @@ namespace ADDON
 
     VECADDONS m_updateableAddons;
 
+    /*!
+     * Installed add-ons by type, an add-on is listed under its main type and
+     * every type it provides, ADDON_UNKNOWN lists all of them. Add-ons without
+     * a type (xbmc.python etc.) are left out. The index is rebuilt on changes
+     * and swapped, queries keep using the one they got.
+     */
+    struct AddonIndex
+    {
+      std::map<TYPE, AddonInfos> installed;
+      std::map<TYPE, AddonInfos> enabled;
+    };
+
     bool GetAddonsInternal(const TYPE &type, VECADDONS &addons, bool enabledOnly);
     bool EnableSingle(const std::string& id);
 
+    /*! \brief Rebuild the index, must be called with the exclusive lock held */
+    void UpdateIndex();
+    std::shared_ptr<const AddonIndex> GetIndex() const;
+
     void FindAddons(ADDON_INFO_LIST& addonmap, const std::string& path);
 
+    /*! \brief Sync the installed add-ons with the database and read their state from it */
+    void SyncWithDatabase();
+
     std::set<std::string> m_disabled;
     std::set<std::string> m_updateBlacklist;
     static std::map<TYPE, IAddonMgrCallback*> m_managers;
-    mutable CCriticalSection m_critSection;
+    mutable CSharedSection m_critSection{"CAddonMgr"};
     CAddonDatabase m_database;
     CEventSource<AddonEvent> m_events;
     CBlockingEventSource<AddonEvent> m_unloadEvents;
     std::set<std::string> m_systemAddons;
     std::set<std::string> m_optionalAddons;
     ADDON_INFO_LIST m_installedAddons;
+    std::shared_ptr<const AddonIndex> m_index = std::make_shared<AddonIndex>();
   };
 
 }; /* namespace ADDON */
@@ -145,6 +145,8 @@ void CPVRClient::ResetProperties(int iClientId /* = PVR_INVALID_CLIENT_ID */)
   m_struct.toKodi.ConnectionStateChange = cb_connection_state_change;
   m_struct.toKodi.EpgEventStateChange = cb_epg_event_state_change;
   m_struct.toKodi.GetCodecByName = cb_get_codec_by_name;
+  m_struct.toKodi.TransferEpgEntryChange = cb_transfer_epg_entry_change;
+  m_struct.toKodi.TransferEpgEntries = cb_transfer_epg_entries;
 }
 
 ADDON_STATUS CPVRClient::Create(int iClientId)
@@ -613,6 +615,30 @@ PVR_ERROR CPVRClient::GetEPGForChannel(int iChannelUid, CPVREpg* epg, time_t sta
   }, m_clientCapabilities.SupportsEPG());
 }
 
+PVR_ERROR CPVRClient::GetEPGChangesForChannel(int iChannelUid, CPVREpg* epg, time_t start, time_t end, std::string& strToken)
+{
+  return DoAddonCall(__FUNCTION__, [this, iChannelUid, epg, start, end, &strToken](const AddonInstance* addon) {
+
+    ADDON_HANDLE_STRUCT handle = {0};
+    handle.callerAddress  = this;
+    handle.dataAddress    = epg;
+
+    int iPVRTimeCorrection = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iPVRTimeCorrection;
+
+    char token[PVR_ADDON_EPG_CHANGES_TOKEN_LENGTH] = {0};
+    strncpy(token, strToken.c_str(), sizeof(token) - 1);
+
+    PVR_ERROR error = addon->GetEPGChangesForChannel(&handle,
+                                                     iChannelUid,
+                                                     start ? start - iPVRTimeCorrection : 0,
+                                                     end ? end - iPVRTimeCorrection : 0,
+                                                     token);
+    token[sizeof(token) - 1] = '\0';
+    strToken = error == PVR_ERROR_NO_ERROR ? token : "";
+    return error;
+  }, m_clientCapabilities.SupportsEPGChanges());
+}
+
 PVR_ERROR CPVRClient::SetEPGTimeFrame(int iDays)
 {
   return DoAddonCall(__FUNCTION__, [iDays](const AddonInstance* addon) {
@@ -1518,6 +1544,46 @@ void CPVRClient::cb_transfer_epg_entry(void* kodiInstance, const ADDON_HANDLE ha
   kodiEpg->UpdateEntry(epgentry, client->GetID());
 }
 
+void CPVRClient::cb_transfer_epg_entries(void* kodiInstance, const ADDON_HANDLE handle, const EPG_TAG* entries, unsigned int iCount)
+{
+  if (!handle)
+  {
+    CLog::LogF(LOGERROR, "Invalid handler data");
+    return;
+  }
+
+  CPVRClient* client = static_cast<CPVRClient*>(kodiInstance);
+  CPVREpg* kodiEpg = static_cast<CPVREpg *>(handle->dataAddress);
+  if ((!entries && iCount > 0) || !client || !kodiEpg)
+  {
+    CLog::LogF(LOGERROR, "Invalid handler data");
+    return;
+  }
+
+  /* transfer these entries to the epg */
+  kodiEpg->UpdateEntries(entries, iCount, client->GetID());
+}
+
+void CPVRClient::cb_transfer_epg_entry_change(void* kodiInstance, const ADDON_HANDLE handle, const EPG_TAG* epgentry, EPG_EVENT_STATE newState)
+{
+  if (!handle)
+  {
+    CLog::LogF(LOGERROR, "Invalid handler data");
+    return;
+  }
+
+  CPVRClient* client = static_cast<CPVRClient*>(kodiInstance);
+  CPVREpg* kodiEpg = static_cast<CPVREpg *>(handle->dataAddress);
+  if (!epgentry || !client || !kodiEpg)
+  {
+    CLog::LogF(LOGERROR, "Invalid handler data");
+    return;
+  }
+
+  /* transfer this change to the epg */
+  kodiEpg->UpdateEntry(epgentry, client->GetID(), newState);
+}
+
 void CPVRClient::cb_transfer_channel_entry(void* kodiInstance, const ADDON_HANDLE handle, const PVR_CHANNEL* channel)
 {
   if (!handle)
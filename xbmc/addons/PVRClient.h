@@ -111,6 +111,12 @@ namespace PVR
      */
     bool SupportsAsyncEPGTransfer() const { return m_addonCapabilities && m_addonCapabilities->bSupportsAsyncEPGTransfer; }
 
+    /*!
+     * @brief Check whether this add-on can transfer only the epg events changed since an earlier transfer.
+     * @return True if supported, false otherwise.
+     */
+    bool SupportsEPGChanges() const { return m_addonCapabilities && m_addonCapabilities->bSupportsEPGChanges; }
+
     /////////////////////////////////////////////////////////////////////////////////
     //
     // Timers
@@ -413,6 +419,17 @@ namespace PVR
      */
     PVR_ERROR GetEPGForChannel(int iChannelUid, CPVREpg* epg, time_t start, time_t end);
 
+    /*!
+     * @brief Request the EPG events of a channel changed since an earlier request from the client.
+     * @param iChannelUid The UID of the channel to get the changes for.
+     * @param epg The table to write the changes to.
+     * @param start The start time to use.
+     * @param end The end time to use.
+     * @param strToken The token of the earlier request, empty to get all events. Set to the token of this request.
+     * @return PVR_ERROR_NO_ERROR if the changes have been fetched successfully.
+     */
+    PVR_ERROR GetEPGChangesForChannel(int iChannelUid, CPVREpg* epg, time_t start, time_t end, std::string& strToken);
+
     /*!
      * Tell the client the time frame to use when notifying epg events back to Kodi. The client might push epg events asynchronously
      * to Kodi using the callback function EpgEventStateChange. To be able to only push events that are actually of interest for Kodi,
@@ -996,6 +1013,24 @@ namespace PVR
      */
     static void cb_transfer_epg_entry(void* kodiInstance, const ADDON_HANDLE handle, const EPG_TAG* entry);
 
+    /*!
+     * @brief Transfer a changed EPG tag from the add-on to Kodi
+     * @param kodiInstance Pointer to Kodi's CPVRClient class
+     * @param handle The handle parameter that Kodi used when requesting the EPG changes
+     * @param entry The entry to transfer to Kodi
+     * @param newState The change of the entry
+     */
+    static void cb_transfer_epg_entry_change(void* kodiInstance, const ADDON_HANDLE handle, const EPG_TAG* entry, EPG_EVENT_STATE newState);
+
+    /*!
+     * @brief Transfer an array of EPG tags from the add-on to Kodi
+     * @param kodiInstance Pointer to Kodi's CPVRClient class
+     * @param handle The handle parameter that Kodi used when requesting the EPG data
+     * @param entries The entries to transfer to Kodi
+     * @param iCount The number of entries
+     */
+    static void cb_transfer_epg_entries(void* kodiInstance, const ADDON_HANDLE handle, const EPG_TAG* entries, unsigned int iCount);
+
     /*!
      * @brief Transfer a channel entry from the add-on to Kodi
      * @param kodiInstance Pointer to Kodi's CPVRClient class
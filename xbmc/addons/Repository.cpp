@@ -28,9 +28,10 @@
 #include "utils/XBMCTinyXML.h"
 #include "utils/log.h"
 
+#include <cstring>
 #include <iterator>
-#include <tuple>
 #include <utility>
+#include <vector>
 
 using namespace XFILE;
 using namespace ADDON;
@@ -38,6 +39,8 @@ using namespace KODI::MESSAGING;
 using KODI::UTILITY::CDigest;
 using KODI::UTILITY::TypedDigest;
 
+#define VALIDATOR_ETAG "etag:"
+#define VALIDATOR_DATE "date:"
 
 CRepository::ResolveResult CRepository::ResolvePathAndHash(const AddonPtr& addon) const
 {
@@ -155,24 +158,41 @@ bool CRepository::FetchChecksum(const std::string& url, std::string& checksum) n
   return true;
 }
 
-bool CRepository::FetchIndex(const DirInfo& repo, std::string const& digest, VECADDONS& addons) noexcept
+CRepository::FetchStatus CRepository::FetchIndex(const DirInfo& repo, std::string const& digest,
+                                                 std::string& validator, VECADDONS& addons) noexcept
 {
   XFILE::CCurlFile http;
+  if (StringUtils::StartsWith(validator, VALIDATOR_ETAG))
+    http.SetRequestHeader("If-None-Match", validator.substr(strlen(VALIDATOR_ETAG)));
+  else if (StringUtils::StartsWith(validator, VALIDATOR_DATE))
+    http.SetRequestHeader("If-Modified-Since", validator.substr(strlen(VALIDATOR_DATE)));
 
   std::string response;
   if (!http.Get(repo.info, response))
   {
     CLog::Log(LOGERROR, "CRepository: failed to read %s", repo.info.c_str());
-    return false;
+    return STATUS_ERROR;
   }
 
+  std::vector<std::string> status = StringUtils::Split(http.GetHttpHeader().GetProtoLine(), " ");
+  if (!validator.empty() && status.size() > 1 && status[1] == "304")
+    return STATUS_NOT_MODIFIED;
+
+  validator.clear();
+  std::string etag = http.GetHttpHeader().GetValue("etag");
+  std::string date = http.GetHttpHeader().GetValue("last-modified");
+  if (!etag.empty())
+    validator = VALIDATOR_ETAG + etag;
+  else if (!date.empty())
+    validator = VALIDATOR_DATE + date;
+
   if (repo.checksumType != CDigest::Type::INVALID)
   {
     std::string actualDigest = CDigest::Calculate(repo.checksumType, response);
     if (!StringUtils::EqualsNoCase(digest, actualDigest))
     {
       CLog::Log(LOGERROR, "CRepository: {} index has wrong digest {}, expected: {}", repo.info, actualDigest, digest);
-      return false;
+      return STATUS_ERROR;
     }
   }
 
@@ -184,44 +204,77 @@ bool CRepository::FetchIndex(const DirInfo& repo, std::string const& digest, VEC
     if (!CZipFile::DecompressGzip(response, buffer))
     {
       CLog::Log(LOGERROR, "CRepository: failed to decompress gzip from '%s'", repo.info.c_str());
-      return false;
+      return STATUS_ERROR;
     }
     response = std::move(buffer);
   }
 
-  return CServiceBroker::GetAddonMgr().AddonsFromRepoXML(repo, response, addons);
+  if (!CServiceBroker::GetAddonMgr().AddonsFromRepoXML(repo, response, addons))
+    return STATUS_ERROR;
+  return STATUS_OK;
 }
 
 CRepository::FetchStatus CRepository::FetchIfChanged(const std::string& oldChecksum,
     std::string& checksum, VECADDONS& addons) const
 {
-  checksum = "";
-  std::vector<std::tuple<DirInfo const&, std::string>> dirChecksums;
-  for (const auto& dir : m_dirs)
+  // the checksum of a directory is the content of its checksum file or, if
+  // it has none, the validator of its index for a conditional request
+  std::vector<std::string> oldParts = StringUtils::Split(oldChecksum, "\n");
+  if (oldParts.size() != m_dirs.size())
+    oldParts.assign(m_dirs.size(), "");
+
+  std::vector<std::string> parts(m_dirs.size());
+  std::vector<VECADDONS> dirAddons(m_dirs.size());
+  std::vector<bool> fetched(m_dirs.size(), false);
+  bool changed = false;
+  for (size_t i = 0; i < m_dirs.size(); ++i)
   {
+    const DirInfo& dir = m_dirs[i];
     if (!dir.checksum.empty())
     {
-      std::string part;
-      if (!FetchChecksum(dir.checksum, part))
+      if (!FetchChecksum(dir.checksum, parts[i]))
       {
         CLog::Log(LOGERROR, "CRepository: failed read '%s'", dir.checksum.c_str());
         return STATUS_ERROR;
       }
-      dirChecksums.emplace_back(dir, part);
-      checksum += part;
+      if (parts[i].empty() || parts[i] != oldParts[i])
+        changed = true;
+    }
+    else
+    {
+      parts[i] = oldParts[i];
+      FetchStatus status = FetchIndex(dir, "", parts[i], dirAddons[i]);
+      if (status == STATUS_ERROR)
+        return STATUS_ERROR;
+      if (status == STATUS_OK)
+      {
+        fetched[i] = true;
+        changed = true;
+      }
     }
   }
 
-  if (oldChecksum == checksum && !oldChecksum.empty())
+  checksum = StringUtils::Join(parts, "\n");
+  if (!changed)
     return STATUS_NOT_MODIFIED;
 
-  for (const auto& dirTuple : dirChecksums)
+  // the content of the repository is replaced as a whole, so unchanged
+  // directories are needed as well
+  for (size_t i = 0; i < m_dirs.size(); ++i)
   {
-    VECADDONS tmp;
-    if (!FetchIndex(std::get<0>(dirTuple), std::get<1>(dirTuple), tmp))
-      return STATUS_ERROR;
-    addons.insert(addons.end(), tmp.begin(), tmp.end());
+    if (!fetched[i])
+    {
+      std::string digest = m_dirs[i].checksum.empty() ? "" : parts[i];
+      std::string validator;
+      if (FetchIndex(m_dirs[i], digest, validator, dirAddons[i]) != STATUS_OK)
+        return STATUS_ERROR;
+      if (m_dirs[i].checksum.empty())
+        parts[i] = validator;
+    }
+    addons.insert(addons.end(), dirAddons[i].begin(), dirAddons[i].end());
   }
+
+  checksum = StringUtils::Join(parts, "\n");
   return STATUS_OK;
 }
 
@@ -54,7 +54,14 @@ namespace ADDON
 
   private:
     static bool FetchChecksum(const std::string& url, std::string& checksum) noexcept;
-    static bool FetchIndex(const DirInfo& repo, std::string const& digest, VECADDONS& addons) noexcept;
+    /*!
+     \brief Fetch and parse the index of a repository directory.
+     \param validator the ETag or date of the index when it was fetched last,
+                      the index is only returned if it changed since. Set to
+                      the one of the fetched index.
+     */
+    static FetchStatus FetchIndex(const DirInfo& repo, std::string const& digest,
+                                  std::string& validator, VECADDONS& addons) noexcept;
 
     static DirInfo ParseDirConfiguration(const CAddonExtensions& configuration);
 
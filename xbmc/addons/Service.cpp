@@ -9,9 +9,19 @@
 
 #include "AddonManager.h"
 #include "interfaces/generic/ScriptInvocationManager.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/JobManager.h"
 #include "utils/StringUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
+
+// services that may initialize their interpreters at the same time
+#define SERVICE_START_CONCURRENCY 2
+// a service that didn't get to run its script by then no longer holds back others
+#define SERVICE_START_TIMEOUT_MS 10000
+#define SERVICE_START_POLL_MS 100
 
 namespace ADDON
 {
@@ -24,6 +34,13 @@ CServiceAddonManager::CServiceAddonManager(CAddonMgr& addonMgr) :
 CServiceAddonManager::~CServiceAddonManager()
 {
   m_addonMgr.Events().Unsubscribe(this);
+
+  {
+    CSingleLock lock(m_criticalSection);
+    m_pending.clear();
+  }
+  m_pendingEvent.Set();
+  m_dispatchDone.Wait();
 }
 
 void CServiceAddonManager::OnEvent(const ADDON::AddonEvent& event)
@@ -48,13 +65,150 @@ void CServiceAddonManager::Start()
 {
   m_addonMgr.Events().Subscribe(this, &CServiceAddonManager::OnEvent);
   VECADDONS addons;
-  if (m_addonMgr.GetAddons(addons, ADDON_SERVICE))
+  if (!m_addonMgr.GetAddons(addons, ADDON_SERVICE))
+    return;
+
+  CSingleLock lock(m_criticalSection);
+  for (const auto& addon : addons)
+  {
+    if (m_services.find(addon->ID()) != m_services.end() ||
+        std::find_if(m_pending.begin(), m_pending.end(),
+                     [&addon](const PendingService& pending)
+                     {
+                       return pending.addon->ID() == addon->ID();
+                     }) != m_pending.end())
+      continue;
+
+    PendingService pending{addon, {}, 0, 0};
+    for (const auto& dependency : addon->GetDependencies())
+      pending.dependencies.push_back(dependency.id);
+
+    const AddonInfoPtr info = m_addonMgr.GetAddonInfo(addon->ID(), ADDON_SERVICE);
+    const CAddonType* type = info ? info->Type(ADDON_SERVICE) : nullptr;
+    if (type)
+    {
+      pending.delay = std::max(type->GetValue("@delay").asInteger(), 0) * 1000;
+      pending.priority = type->GetValue("@priority").asInteger();
+    }
+    m_pending.push_back(std::move(pending));
+  }
+
+  if (m_uiReady)
+    StartPending();
+}
+
+void CServiceAddonManager::OnUIReady()
+{
+  CSingleLock lock(m_criticalSection);
+  if (m_uiReady)
+    return;
+
+  m_uiReady = true;
+  m_uiReadyTime = XbmcThreads::SystemClockMillis();
+  StartPending();
+}
+
+void CServiceAddonManager::StartPending()
+{
+  if (m_pending.empty())
+    return;
+
+  if (m_dispatching)
+  {
+    m_pendingEvent.Set();
+    return;
+  }
+
+  m_dispatching = true;
+  m_dispatchDone.Reset();
+  CJobManager::GetInstance().Submit([this]() { Dispatch(); });
+}
+
+void CServiceAddonManager::Dispatch()
+{
+  CSingleLock lock(m_criticalSection);
+  while (!m_pending.empty())
   {
-    for (const auto& addon : addons)
+    const unsigned int now = XbmcThreads::SystemClockMillis();
+
+    // a service counts as started once its script runs
+    for (auto it = m_starting.begin(); it != m_starting.end();)
     {
-      Start(addon);
+      auto service = m_services.find(it->first);
+      if (service == m_services.end() ||
+          CScriptInvocationManager::GetInstance().GetState(service->second) >= InvokerStateRunning ||
+          now - it->second >= SERVICE_START_TIMEOUT_MS)
+        it = m_starting.erase(it);
+      else
+        ++it;
     }
+
+    auto isWaiting = [this](const std::string& id)
+    {
+      return m_starting.find(id) != m_starting.end() ||
+             std::find_if(m_pending.begin(), m_pending.end(),
+                          [&id](const PendingService& pending)
+                          {
+                            return pending.addon->ID() == id;
+                          }) != m_pending.end();
+    };
+
+    std::vector<PendingService> ready;
+    bool delayed = false;
+    for (const auto& pending : m_pending)
+    {
+      if (now - m_uiReadyTime < pending.delay)
+      {
+        delayed = true;
+        continue;
+      }
+      if (std::none_of(pending.dependencies.begin(), pending.dependencies.end(), isWaiting))
+        ready.push_back(pending);
+    }
+
+    // services depending on each other would never start
+    if (ready.empty() && m_starting.empty() && !delayed)
+    {
+      CLog::Log(LOGWARNING, "CServiceAddonManager: circular dependencies between services, starting them anyway");
+      for (const auto& pending : m_pending)
+      {
+        if (now - m_uiReadyTime >= pending.delay)
+          ready.push_back(pending);
+      }
+    }
+
+    std::stable_sort(ready.begin(), ready.end(),
+                     [](const PendingService& lhs, const PendingService& rhs)
+                     {
+                       return lhs.priority > rhs.priority;
+                     });
+
+    for (const auto& service : ready)
+    {
+      if (m_starting.size() >= SERVICE_START_CONCURRENCY)
+        break;
+
+      const std::string id = service.addon->ID();
+      m_pending.erase(std::remove_if(m_pending.begin(), m_pending.end(),
+                                     [&id](const PendingService& pending)
+                                     {
+                                       return pending.addon->ID() == id;
+                                     }),
+                      m_pending.end());
+      if (StartService(service.addon))
+        m_starting[id] = now;
+    }
+
+    if (m_pending.empty())
+      break;
+
+    CSingleExit exit(m_criticalSection);
+    m_pendingEvent.WaitMSec(SERVICE_START_POLL_MS);
   }
+
+  m_starting.clear();
+  m_dispatching = false;
+  m_dispatchDone.Set();
 }
 
 void CServiceAddonManager::Start(const std::string& addonId)
@@ -69,10 +223,21 @@ void CServiceAddonManager::Start(const std::string& addonId)
 void CServiceAddonManager::Start(const AddonPtr& addon)
 {
   CSingleLock lock(m_criticalSection);
+  m_pending.erase(std::remove_if(m_pending.begin(), m_pending.end(),
+                                 [&addon](const PendingService& pending)
+                                 {
+                                   return pending.addon->ID() == addon->ID();
+                                 }),
+                  m_pending.end());
+  StartService(addon);
+}
+
+bool CServiceAddonManager::StartService(const AddonPtr& addon)
+{
   if (m_services.find(addon->ID()) != m_services.end())
   {
     CLog::Log(LOGDEBUG, "CServiceAddonManager: %s already started.", addon->ID().c_str());
-    return;
+    return false;
   }
 
   if (StringUtils::EndsWith(addon->LibPath(), ".py"))
@@ -82,16 +247,20 @@ void CServiceAddonManager::Start(const AddonPtr& addon)
     if (handle == -1)
     {
       CLog::Log(LOGERROR, "CServiceAddonManager: %s failed to start", addon->ID().c_str());
-      return;
+      return false;
     }
     m_services[addon->ID()] = handle;
+    return true;
   }
+  return false;
 }
 
 void CServiceAddonManager::Stop()
 {
   m_addonMgr.Events().Unsubscribe(this);
   CSingleLock lock(m_criticalSection);
+  m_pending.clear();
+  m_pendingEvent.Set();
   for (const auto& service : m_services)
   {
     Stop(service);
@@ -102,6 +271,12 @@ void CServiceAddonManager::Stop()
 void CServiceAddonManager::Stop(const std::string& addonId)
 {
   CSingleLock lock(m_criticalSection);
+  m_pending.erase(std::remove_if(m_pending.begin(), m_pending.end(),
+                                 [&addonId](const PendingService& pending)
+                                 {
+                                   return pending.addon->ID() == addonId;
+                                 }),
+                  m_pending.end());
   auto it = m_services.find(addonId);
   if (it != m_services.end())
   {
@@ -11,6 +11,11 @@
 #include "Addon.h"
 #include "AddonEvents.h"
 #include "threads/CriticalSection.h"
+#include "threads/Event.h"
+
+#include <map>
+#include <string>
+#include <vector>
 
 namespace ADDON
 {
@@ -28,9 +33,19 @@ namespace ADDON
 
     /**
      * Start all services.
+     *
+     * Services are started in the background once the UI is ready, a few at
+     * a time. A service waits for the services it depends on and for the
+     * "delay" (seconds) of its xbmc.service extension, services with a
+     * higher "priority" are started first.
      */
     void Start();
 
+    /**
+     * Called when the UI got ready, releases the services queued by Start().
+     */
+    void OnUIReady();
+
     /**
      * Start service by add-on id.
      */
@@ -52,9 +67,30 @@ namespace ADDON
 
     void Stop(std::map<std::string, int>::value_type service);
 
+    struct PendingService
+    {
+      AddonPtr addon;
+      std::vector<std::string> dependencies;
+      unsigned int delay;
+      int priority;
+    };
+
+    bool StartService(const AddonPtr& addon);
+    void StartPending();
+    void Dispatch();
+
     CAddonMgr& m_addonMgr;
     CCriticalSection m_criticalSection;
     /** add-on id -> script id */
     std::map<std::string, int> m_services;
+    /** services waiting for the UI, their dependencies or their delay */
+    std::vector<PendingService> m_pending;
+    /** started services that didn't get to run their script yet */
+    std::map<std::string, unsigned int> m_starting;
+    bool m_uiReady = false;
+    unsigned int m_uiReadyTime = 0;
+    bool m_dispatching = false;
+    CEvent m_pendingEvent;
+    CEvent m_dispatchDone{true, true};
   };
 }
@@ -8,6 +8,7 @@
 
 #include "Skin.h"
 #include "AddonManager.h"
+#include "GUIInfoManager.h"
 #include "ServiceBroker.h"
 #include "Util.h"
 #include "dialogs/GUIDialogKaiToast.h"
@@ -45,6 +46,17 @@ using KODI::MESSAGING::HELPERS::DialogResponse;
 
 std::shared_ptr<ADDON::CSkinInfo> g_SkinInfo;
 
+namespace
+{
+// conditions on skin settings are only evaluated again once a setting changed
+void NotifySettingsChanged()
+{
+  CGUIComponent* gui = CServiceBroker::GetGUI();
+  if (gui)
+    gui->GetInfoManager().GetInfoProviders().GetSkinInfoProvider().OnSettingsChanged();
+}
+}
+
 namespace ADDON
 {
 
@@ -585,6 +597,7 @@ void CSkinInfo::SetString(int setting, const std::string &label)
   {
     it->second->value = label;
     m_settingsUpdateHandler->TriggerSave();
+    NotifySettingsChanged();
     return;
   }
 
@@ -629,6 +642,7 @@ void CSkinInfo::SetBool(int setting, bool set)
   {
     it->second->value = set;
     m_settingsUpdateHandler->TriggerSave();
+    NotifySettingsChanged();
     return;
   }
 
@@ -645,6 +659,7 @@ void CSkinInfo::Reset(const std::string &setting)
     {
       it.second->value.clear();
       m_settingsUpdateHandler->TriggerSave();
+      NotifySettingsChanged();
       return;
     }
   }
@@ -656,6 +671,7 @@ void CSkinInfo::Reset(const std::string &setting)
     {
       it.second->value = false;
       m_settingsUpdateHandler->TriggerSave();
+      NotifySettingsChanged();
       return;
     }
   }
@@ -671,6 +687,7 @@ void CSkinInfo::Reset()
     it.second->value.clear();
 
   m_settingsUpdateHandler->TriggerSave();
+  NotifySettingsChanged();
 }
 
 std::set<CSkinSettingPtr> CSkinInfo::ParseSettings(const TiXmlElement* rootElement)
@@ -749,6 +766,7 @@ bool CSkinInfo::SettingsFromXML(const CXBMCTinyXML &doc, bool loadDefaults /* =
       CLog::Log(LOGWARNING, "CSkinInfo: ignoring setting of unknown type \"%s\"", setting->GetType().c_str());
   }
 
+  NotifySettingsChanged();
   return true;
 }
 
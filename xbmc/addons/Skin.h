@@ -152,6 +152,9 @@ public:
 
   void ResolveIncludes(TiXmlElement *node, std::map<INFO::InfoPtr, bool>* xmlIncludeConditions = NULL);
 
+  /*! \brief Changes whenever one of the loaded include files changed, see CGUIIncludes::GetSignature */
+  const std::string& GetIncludesSignature() const { return m_includes.GetSignature(); }
+
   float GetEffectsSlowdown() const { return m_effectsSlowDown; };
 
   const std::vector<CStartupWindow> &GetStartupWindows() const { return m_startupWindows; };
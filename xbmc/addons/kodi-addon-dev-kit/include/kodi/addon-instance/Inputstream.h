@@ -375,6 +375,11 @@ extern "C"
     const char*(__cdecl* get_chapter_name)(const AddonInstance_InputStream* instance, int ch);
     int64_t(__cdecl* get_chapter_pos)(const AddonInstance_InputStream* instance, int ch);
     bool(__cdecl* seek_chapter)(const AddonInstance_InputStream* instance, int ch);
+
+    // IDemux, batched
+    int(__cdecl* demux_read_packets)(const AddonInstance_InputStream* instance,
+                                     DemuxPacket** packets,
+                                     int max_packets);
   } KodiToAddonFuncTable_InputStream;
 
   typedef struct AddonInstance_InputStream /* internal */
@@ -489,6 +494,27 @@ public:
      */
   virtual DemuxPacket* DemuxRead() { return nullptr; }
 
+  /*!
+     * Read the next packets from the demultiplexer.
+     * @param packets Array to put the packets into
+     * @param maxPackets The size of the array
+     * @return The number of packets put into the array, 0 if an error occured.
+     *         An empty or stream change packet as returned by DemuxRead()
+     *         must be the last one of the array.
+     * @remarks Optional, saves a call per packet for high bitrate streams.
+     *          Should block for the first packet at most and add only those
+     *          already buffered after it. The default implementation returns
+     *          the packet of DemuxRead().
+     */
+  virtual int DemuxReadPackets(DemuxPacket** packets, int maxPackets)
+  {
+    if (maxPackets <= 0)
+      return 0;
+
+    packets[0] = DemuxRead();
+    return packets[0] ? 1 : 0;
+  }
+
   /*!
      * Notify the InputStream addon/demuxer that Kodi wishes to seek the stream by time
      * Demuxer is required to set stream to an IDR frame
@@ -715,6 +741,10 @@ private:
       m_instanceData->toAddon.get_chapter_pos = ADDON_GetChapterPos;
       m_instanceData->toAddon.seek_chapter = ADDON_SeekChapter;
     }
+
+    int minBatchVersion[3] = { 2, 1, 0 };
+    if (compareVersion(api, minBatchVersion) >= 0)
+      m_instanceData->toAddon.demux_read_packets = ADDON_DemuxReadPackets;
   }
 
   inline static bool ADDON_Open(const AddonInstance_InputStream* instance, INPUTSTREAM* props)
@@ -778,6 +808,13 @@ private:
     return instance->toAddon.addonInstance->DemuxRead();
   }
 
+  inline static int ADDON_DemuxReadPackets(const AddonInstance_InputStream* instance,
+                                           DemuxPacket** packets,
+                                           int max_packets)
+  {
+    return instance->toAddon.addonInstance->DemuxReadPackets(packets, max_packets);
+  }
+
   inline static bool ADDON_DemuxSeekTime(const AddonInstance_InputStream* instance,
                                          double time,
                                          bool backwards,
@@ -64,6 +64,29 @@ public:
     return m_Callbacks->toKodi.TransferEpgEntry(m_Callbacks->toKodi.kodiInstance, handle, entry);
   }
 
+  /*!
+   * @brief Transfer an array of EPG tags from the add-on to Kodi in one call
+   * @param handle The handle parameter that Kodi used when requesting the EPG data
+   * @param entries The entries to transfer to Kodi
+   * @param count The number of entries
+   * @remarks Cheaper than calling TransferEpgEntry() for each tag of large guides
+   */
+  void TransferEpgEntries(const ADDON_HANDLE handle, const EPG_TAG* entries, unsigned int count)
+  {
+    return m_Callbacks->toKodi.TransferEpgEntries(m_Callbacks->toKodi.kodiInstance, handle, entries, count);
+  }
+
+  /*!
+   * @brief Transfer a changed EPG event from the add-on to Kodi
+   * @param handle The handle parameter that Kodi used when requesting the EPG changes
+   * @param entry The entry to transfer to Kodi. For EPG_EVENT_DELETED, it is sufficient to fill EPG_TAG.iUniqueBroadcastId
+   * @param newState The change of the entry
+   */
+  void TransferEpgEntryChange(const ADDON_HANDLE handle, const EPG_TAG* entry, EPG_EVENT_STATE newState)
+  {
+    return m_Callbacks->toKodi.TransferEpgEntryChange(m_Callbacks->toKodi.kodiInstance, handle, entry, newState);
+  }
+
   /*!
    * @brief Transfer a channel entry from the add-on to XBMC
    * @param handle The handle parameter that XBMC used when requesting the channel list
@@ -87,6 +87,24 @@ extern "C"
    */
   PVR_ERROR GetEPGForChannel(ADDON_HANDLE handle, int iChannelUid, time_t iStart, time_t iEnd);
 
+  /*!
+   * Request the EPG events of a channel that changed since an earlier call.
+   * The changes must be transferred using the callback function TransferEpgEntryChange.
+   * @param handle Handle to pass to the callback method.
+   * @param iChannelUid The UID of the channel to get the changes for.
+   * @param iStart Get events after this time (UTC).
+   * @param iEnd Get events before this time (UTC).
+   * @param [in,out] strToken The token returned by the previous call for this channel, empty for the first call.
+   *        Set to the token of this transfer, at most PVR_ADDON_EPG_CHANGES_TOKEN_LENGTH characters including the terminating zero.
+   * @return PVR_ERROR_NO_ERROR if the changes have been fetched successfully.
+   * @remarks Required if bSupportsEPGChanges is set to true.
+   *          For an empty or unknown token all events of the time frame must be transferred as EPG_EVENT_CREATED.
+   *          Otherwise only the events created, updated or deleted since the token was handed out are transferred,
+   *          plus the events that moved into the time frame since then.
+   *          Return PVR_ERROR_NOT_IMPLEMENTED if this add-on won't provide this function.
+   */
+  PVR_ERROR GetEPGChangesForChannel(ADDON_HANDLE handle, int iChannelUid, time_t iStart, time_t iEnd, char* strToken);
+
   /*
    * Check if the given EPG tag can be recorded.
    * @param tag the epg tag to check.
@@ -705,6 +723,7 @@ extern "C"
     pClient->toAddon.MenuHook                       = CallMenuHook;
 
     pClient->toAddon.GetEPGForChannel               = GetEPGForChannel;
+    pClient->toAddon.GetEPGChangesForChannel        = GetEPGChangesForChannel;
     pClient->toAddon.IsEPGTagRecordable             = IsEPGTagRecordable;
     pClient->toAddon.IsEPGTagPlayable               = IsEPGTagPlayable;
     pClient->toAddon.GetEPGTagEdl                   = GetEPGTagEdl;
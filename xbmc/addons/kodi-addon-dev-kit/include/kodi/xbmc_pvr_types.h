@@ -59,6 +59,7 @@ struct DemuxPacket;
 #define PVR_ADDON_ATTRIBUTE_DESC_LENGTH       128
 #define PVR_ADDON_ATTRIBUTE_VALUES_ARRAY_SIZE 512
 #define PVR_ADDON_DESCRAMBLE_INFO_STRING_LENGTH 64
+#define PVR_ADDON_EPG_CHANGES_TOKEN_LENGTH    128
 
 #define XBMC_INVALID_CODEC_ID   0
 #define XBMC_INVALID_CODEC      { XBMC_CODEC_TYPE_UNKNOWN, XBMC_INVALID_CODEC_ID }
@@ -312,6 +313,7 @@ extern "C" {
     bool bSupportsRecordingsLifetimeChange; /*!< @brief true if the backend supports changing lifetime for recordings. */
     bool bSupportsDescrambleInfo;       /*!< @brief true if the backend supports descramble information for playing channels. */
     bool bSupportsAsyncEPGTransfer;     /*!< @brief true if this addon-on supports asynchronous transfer of epg events to Kodi using the callback function EpgEventStateChange. */
+    bool bSupportsEPGChanges;           /*!< @brief true if this add-on can transfer only the epg events changed since an earlier transfer, see GetEPGChangesForChannel. */
 
     unsigned int iRecordingsLifetimesSize; /*!< @brief (required) Count of possible values for PVR_RECORDING.iLifetime. 0 means lifetime is not supported for recordings or no own value definition wanted, but to use Kodi defaults of 1..365. */
     PVR_ATTRIBUTE_INT_VALUE recordingsLifetimeValues[PVR_ADDON_ATTRIBUTE_VALUES_ARRAY_SIZE]; /*!< @brief (optional) Array containing the possible values for PVR_RECORDING.iLifetime. Must be filled if iLifetimesSize > 0 */
@@ -625,6 +627,9 @@ extern "C" {
     void (*EpgEventStateChange)(void* kodiInstance, EPG_TAG* tag, EPG_EVENT_STATE newState);
 
     xbmc_codec_t (*GetCodecByName)(const void* kodiInstance, const char* strCodecName);
+
+    void (*TransferEpgEntryChange)(void* kodiInstance, const ADDON_HANDLE handle, const EPG_TAG *epgentry, EPG_EVENT_STATE newState);
+    void (*TransferEpgEntries)(void* kodiInstance, const ADDON_HANDLE handle, const EPG_TAG *epgentries, unsigned int iCount);
   } AddonToKodiFuncTable_PVR;
 
   /*!
@@ -707,6 +712,7 @@ extern "C" {
     void (__cdecl* OnPowerSavingDeactivated)(void);
     PVR_ERROR (__cdecl* GetStreamTimes)(PVR_STREAM_TIMES*);
     PVR_ERROR (__cdecl* GetStreamReadChunkSize)(int*);
+    PVR_ERROR (__cdecl* GetEPGChangesForChannel)(ADDON_HANDLE, int, time_t, time_t, char*);
   } KodiToAddonFuncTable_PVR;
 
   typedef struct AddonInstance_PVR
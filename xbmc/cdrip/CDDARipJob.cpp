@@ -27,6 +27,12 @@
 #include "storage/MediaManager.h"
 #include "addons/AddonManager.h"
 #include "addons/AudioEncoder.h"
+#include "threads/Condition.h"
+#include "threads/SingleLock.h"
+#include "threads/Thread.h"
+
+#include <deque>
+#include <vector>
 
 #if defined(TARGET_WINDOWS)
 #include "platform/win32/CharsetConverter.h"
@@ -36,6 +42,105 @@ using namespace ADDON;
 using namespace MUSIC_INFO;
 using namespace XFILE;
 
+// audio read ahead of the encoder, enough for most tracks, so the drive can
+// move on to the next track while the encoder catches up
+#define RIP_READAHEAD_SIZE (64 * 1024 * 1024)
+#define RIP_CHUNK_SIZE     (64 * 1024)
+
+namespace
+{
+
+// concurrent jobs only encode at the same time, the drive reads one track after the other
+CCriticalSection driveSection;
+
+} // unnamed namespace
+
+class CCDDARipJob::CReadAhead : public CThread
+{
+public:
+  explicit CReadAhead(CFile& file)
+    : CThread("CDDARipReadAhead"), m_file(file), m_length(file.GetLength())
+  {
+  }
+
+  ~CReadAhead() override { StopThread(); }
+
+  //! \brief Take the next chunk read from the drive
+  //! \return false once the track is read or reading failed
+  bool Get(std::vector<uint8_t>& chunk)
+  {
+    CSingleLock lock(m_section);
+    while (m_chunks.empty())
+    {
+      if (m_done)
+        return false;
+      m_available.wait(lock, 100);
+    }
+
+    chunk = std::move(m_chunks.front());
+    m_chunks.pop_front();
+    m_buffered -= chunk.size();
+    m_consumed += chunk.size();
+    m_space.notifyAll();
+    return true;
+  }
+
+  bool IsComplete() const
+  {
+    CSingleLock lock(m_section);
+    return m_done && m_complete;
+  }
+
+  int GetPercent() const
+  {
+    CSingleLock lock(m_section);
+    return m_length > 0 ? static_cast<int>(m_consumed * 100 / m_length) : 0;
+  }
+
+protected:
+  void Process() override
+  {
+    CSingleLock drive(driveSection);
+    while (!m_bStop)
+    {
+      std::vector<uint8_t> chunk(RIP_CHUNK_SIZE);
+      const ssize_t read = m_file.Read(chunk.data(), chunk.size());
+
+      CSingleLock lock(m_section);
+      if (read <= 0)
+      {
+        m_complete = m_file.GetPosition() == m_length;
+        break;
+      }
+
+      chunk.resize(read);
+      while (m_buffered > 0 && m_buffered + chunk.size() > RIP_READAHEAD_SIZE && !m_bStop)
+        m_space.wait(lock, 100);
+
+      m_buffered += chunk.size();
+      m_chunks.push_back(std::move(chunk));
+      m_available.notifyAll();
+    }
+
+    CSingleLock lock(m_section);
+    m_done = true;
+    m_available.notifyAll();
+  }
+
+private:
+  CFile& m_file;
+  const int64_t m_length;
+
+  mutable CCriticalSection m_section;
+  XbmcThreads::ConditionVariable m_available;
+  XbmcThreads::ConditionVariable m_space;
+  std::deque<std::vector<uint8_t>> m_chunks;
+  size_t m_buffered = 0;
+  int64_t m_consumed = 0;
+  bool m_done = false;
+  bool m_complete = false;
+};
+
 CCDDARipJob::CCDDARipJob(const std::string& input,
                          const std::string& output,
                          const CMusicInfoTag& tag,
@@ -70,10 +175,13 @@ bool CCDDARipJob::DoWork()
   // init ripper
   CFile reader;
   CEncoder* encoder = nullptr;
-  if (!reader.Open(m_input,READ_CACHED) || !(encoder=SetupEncoder(reader)))
   {
-    CLog::Log(LOGERROR, "Error: CCDDARipper::Init failed");
-    return false;
+    CSingleLock drive(driveSection);
+    if (!reader.Open(m_input,READ_CACHED) || !(encoder=SetupEncoder(reader)))
+    {
+      CLog::Log(LOGERROR, "Error: CCDDARipper::Init failed");
+      return false;
+    }
   }
 
   // setup the progress dialog
@@ -87,12 +195,15 @@ bool CCDDARipJob::DoWork()
                                             m_tag.GetTitle().c_str());
   handle->SetText(strLine0);
 
-  // start ripping
+  // start ripping, the drive is read in the background while encoding
+  CReadAhead readAhead(reader);
+  readAhead.Create();
+
   int percent=0;
   int oldpercent=0;
   bool cancelled(false);
   int result;
-  while (!cancelled && (result=RipChunk(reader, encoder, percent)) == 0)
+  while (!cancelled && (result=RipChunk(readAhead, encoder, percent)) == 0)
   {
     cancelled = ShouldCancel(percent,100);
     if (percent > oldpercent)
@@ -103,6 +214,7 @@ bool CCDDARipJob::DoWork()
   }
 
   // close encoder ripper
+  readAhead.StopThread();
   encoder->CloseEncode();
   delete encoder;
   reader.Close();
@@ -145,27 +257,21 @@ bool CCDDARipJob::DoWork()
   return !cancelled && result == 2;
 }
 
-int CCDDARipJob::RipChunk(CFile& reader, CEncoder* encoder, int& percent)
+int CCDDARipJob::RipChunk(CReadAhead& reader, CEncoder* encoder, int& percent)
 {
   percent = 0;
 
-  uint8_t stream[1024];
+  std::vector<uint8_t> stream;
 
-  // get data
-  int result = reader.Read(stream, 1024);
-
-  // return if rip is done or on some kind of error
-  if (result <= 0)
-    return 1;
+  // get data, return if rip is done or on some kind of error
+  if (!reader.Get(stream))
+    return reader.IsComplete() ? 2 : 1;
 
   // encode data
-  int encres=encoder->Encode(result, stream);
+  int encres=encoder->Encode(static_cast<int>(stream.size()), stream.data());
 
   // Get progress indication
-  percent = static_cast<int>(reader.GetPosition()*100/reader.GetLength());
-
-  if (reader.GetPosition() == reader.GetLength())
-    return 2;
+  percent = reader.GetPercent();
 
   return -(1-encres);
 }
@@ -42,6 +42,8 @@ public:
   bool DoWork() override;
   std::string GetOutput() const { return m_output; }
 protected:
+  class CReadAhead;
+
   //! \brief Setup the audio encoder
   CEncoder* SetupEncoder(XFILE::CFile& reader);
 
@@ -49,14 +51,14 @@ protected:
   std::string SetupTempFile();
 
   //! \brief Rip a chunk of audio
-  //! \param reader The input reader
+  //! \param reader The audio read ahead of the encoder
   //! \param encoder The audio encoder
   //! \param percent The percentage completed on return
   //! \return 0 (CDDARIP_OK) if everything went okay, or
   //!         a positive error code from the reader, or
   //!         -1 if the encoder failed
   //! \sa CCDDARipper::GetData, CEncoder::Encode
-  int RipChunk(XFILE::CFile& reader, CEncoder* encoder, int& percent);
+  int RipChunk(CReadAhead& reader, CEncoder* encoder, int& percent);
 
   unsigned int m_rate; //< The sample rate of the input file
   unsigned int m_channels; //< The number of channels in input file
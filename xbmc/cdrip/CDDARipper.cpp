@@ -46,7 +46,7 @@ CCDDARipper& CCDDARipper::GetInstance()
 }
 
 CCDDARipper::CCDDARipper()
-  : CJobQueue(false, 1) //enforce fifo and non-parallel processing
+  : CJobQueue(false, 2) //enforce fifo, a track is encoded while the next one is read
 {
 }
 
@@ -284,7 +284,7 @@ void CCDDARipper::OnJobComplete(unsigned int jobID, bool success, CJob* job)
 {
   if (success)
   {
-    if(CJobQueue::QueueEmpty())
+    if(CJobQueue::QueueEmpty() && CJobQueue::ProcessingCount() == 1)
     {
       std::string dir = URIUtils::GetDirectory(static_cast<CCDDARipJob*>(job)->GetOutput());
       bool unimportant;
@@ -7,11 +7,12 @@
  */
 
 #include "AEResampleFactory.h"
+#include "ServiceBroker.h"
 #include "cores/AudioEngine/Engines/ActiveAE/ActiveAEResampleFFMPEG.h"
-#if defined(TARGET_RASPBERRY_PI)
-  #include "ServiceBroker.h"
-  #include "settings/Settings.h"
+#include "cores/AudioEngine/Engines/ActiveAE/ActiveAEResamplePolyphase.h"
+#include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#if defined(TARGET_RASPBERRY_PI)
   #include "cores/AudioEngine/Engines/ActiveAE/ActiveAEResamplePi.h"
 #endif
 
@@ -20,10 +21,16 @@ namespace ActiveAE
 
 IAEResample *CAEResampleFactory::Create(uint32_t flags /* = 0 */)
 {
+  if (!(flags & AERESAMPLEFACTORY_QUICK_RESAMPLE))
+  {
+    int quality = CServiceBroker::GetSettingsComponent()->GetSettings()->GetInt(CSettings::SETTING_AUDIOOUTPUT_PROCESSQUALITY);
 #if defined(TARGET_RASPBERRY_PI)
-  if (!(flags & AERESAMPLEFACTORY_QUICK_RESAMPLE) && CServiceBroker::GetSettingsComponent()->GetSettings()->GetInt(CSettings::SETTING_AUDIOOUTPUT_PROCESSQUALITY) == AE_QUALITY_GPU)
-    return new CActiveAEResamplePi();
+    if (quality == AE_QUALITY_GPU)
+      return new CActiveAEResamplePi();
 #endif
+    if (quality == AE_QUALITY_POLYPHASE)
+      return new CActiveAEResamplePolyphase();
+  }
   return new CActiveAEResampleFFMPEG();
 }
 
@@ -21,10 +21,14 @@ using namespace ActiveAE;
 #include "cores/AudioEngine/AEResampleFactory.h"
 #include "cores/AudioEngine/Encoders/AEEncoderFFmpeg.h"
 
+#include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "windowing/WinSystem.h"
 #include "utils/log.h"
+#include "utils/Tracer.h"
+
+#include <algorithm>
 
 #define MAX_CACHE_LEVEL 0.4   // total cache time of stream in seconds
 #define MAX_WATER_LEVEL 0.2   // buffered time after stream stages in seconds
@@ -246,8 +250,8 @@ AEAudioFormat CEngineStats::GetCurrentSinkFormat()
   return m_sinkFormat;
 }
 
-CActiveAE::CActiveAE() :
-  CThread("ActiveAE"),
+CActiveAE::CActiveAE(bool musicZone /* = false */) :
+  CThread(musicZone ? "ActiveAEMusic" : "ActiveAE"),
   m_controlPort("OutputControlPort", &m_inMsgEvent, &m_outMsgEvent),
   m_dataPort("OutputDataPort", &m_inMsgEvent, &m_outMsgEvent),
   m_sink(&m_outMsgEvent)
@@ -267,10 +271,14 @@ CActiveAE::CActiveAE() :
   m_vizInitialized = false;
   m_sinkHasVolume = false;
   m_aeGUISoundForce = false;
+  m_bypassMixing = false;
+  m_musicZone = musicZone;
   m_stats.Reset(44100, true);
   m_streamIdGen = 0;
 
-  m_settingsHandler.reset(new CActiveAESettings(*this));
+  // the settings and their option fillers belong to the engine of the main output
+  if (!m_musicZone)
+    m_settingsHandler.reset(new CActiveAESettings(*this));
 }
 
 CActiveAE::~CActiveAE()
@@ -697,6 +705,7 @@ void CActiveAE::StateMachine(int signal, Protocol *port, Message *msg)
           fade->stream->m_fadingBase = fade->from;
           fade->stream->m_fadingTarget = fade->target;
           fade->stream->m_fadingTime = fade->millis;
+          fade->stream->m_fadingPower = fade->constantPower;
           fade->stream->m_fadingSamples = -1;
           return;
         case CActiveAEControlProtocol::STOPSOUND:
@@ -1135,6 +1144,7 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
   m_sinkRequestFormat = inputFormat;
   ApplySettingsToFormat(m_sinkRequestFormat, m_settings, (int*)&m_mode);
   m_extKeepConfig = 0;
+  m_bypassMixing = false;
 
   std::string device = (m_sinkRequestFormat.m_dataFormat == AE_FMT_RAW) ? m_settings.passthroughdevice : m_settings.device;
   std::string driver;
@@ -1269,6 +1279,16 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
 
       sinkInputFormat = m_sinkFormat;
     }
+    // a single stream that is already in the format of the sink is neither converted
+    // to float nor mixed, the samples go to the sink untouched
+    else if (CanBypassMixing())
+    {
+      CLog::Log(LOGDEBUG, "ActiveAE::%s - bypassing mix stage for %s", __FUNCTION__,
+                CAEUtil::DataFormatToStr(m_sinkFormat.m_dataFormat));
+      outputFormat = m_sinkFormat;
+      sinkInputFormat = m_sinkFormat;
+      m_bypassMixing = true;
+    }
     else
     {
       outputFormat = m_sinkFormat;
@@ -1311,7 +1331,8 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
         // if input format does not follow ffmpeg channel mask, we may need to remap channels
         (*it)->InitRemapper();
       }
-      if (initSink && (*it)->m_processingBuffers)
+      if ((*it)->m_processingBuffers &&
+          (initSink || !CompareFormat((*it)->m_processingBuffers->m_outputFormat, outputFormat)))
       {
         (*it)->m_processingBuffers->Flush();
         m_discardBufferPools.push_back((*it)->m_processingBuffers->GetResampleBuffers());
@@ -1383,6 +1404,8 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
   {
     m_sinkBuffers = new CActiveAEBufferPoolResample(sinkInputFormat, m_sinkFormat, m_settings.resampleQuality);
     m_sinkBuffers->Create(MAX_WATER_LEVEL*1000, true, false);
+    if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioRealtime)
+      m_sinkBuffers->LockMemory();
   }
 
   // reset gui sounds
@@ -1392,10 +1415,13 @@ void CActiveAE::Configure(AEAudioFormat *desiredFmt)
        (m_settings.guisoundmode == AE_SOUND_IDLE && m_streams.empty()) ||
        m_aeGUISoundForce)
     {
+      // convert all of them now so that navigating the gui doesn't
+      // convert sounds in MixSounds while the sink waits for data
       std::vector<CActiveAESound*>::iterator it;
       for (it = m_sounds.begin(); it != m_sounds.end(); ++it)
       {
         (*it)->SetConverted(false);
+        ResampleSound(*it);
       }
     }
     m_sounds_playing.clear();
@@ -1434,6 +1460,7 @@ CActiveAEStream* CActiveAE::CreateStream(MsgStreamNew *streamMsg)
   stream->m_inputBuffers = NULL; // create in Configure when we know the sink format
   stream->m_processingBuffers = NULL; // create in Configure when we know the sink format
   stream->m_fadingSamples = 0;
+  stream->m_fadingPower = false;
   stream->m_started = false;
   stream->m_resampleMode = 0;
   stream->m_syncState = CAESyncInfo::AESyncState::SYNC_OFF;
@@ -1846,8 +1873,14 @@ void CActiveAE::UnconfigureSink()
 
 bool CActiveAE::RunStages()
 {
+  TRACE_SCOPE("ActiveAE::RunStages");
+
   bool busy = false;
 
+  // leave the bypass as soon as the samples need to be touched
+  if (m_bypassMixing && !CanBypassMixing())
+    Configure();
+
   // serve input streams
   std::list<CActiveAEStream*>::iterator it;
   for (it = m_streams.begin(); it != m_streams.end(); ++it)
@@ -2006,6 +2039,13 @@ bool CActiveAE::RunStages()
             int nb_loops = 1;
             float fadingStep = 0.0f;
 
+            // samples are not float, nothing to scale
+            if (m_bypassMixing)
+            {
+              busy = true;
+              continue;
+            }
+
             // fading
             if ((*it)->m_fadingSamples == -1)
             {
@@ -2038,6 +2078,7 @@ bool CActiveAE::RunStages()
               nb_loops = out->pkt->nb_samples;
             }
 
+            m_frameGains.resize(nb_loops);
             for(int i=0; i<nb_loops; i++)
             {
               if ((*it)->m_fadingSamples > 0)
@@ -2054,23 +2095,15 @@ bool CActiveAE::RunStages()
               }
 
               // volume for stream
-              float volume = (*it)->m_volume * (*it)->m_rgain;
-              if(nb_loops > 1)
-                volume *= (*it)->m_limiter.Run((float**)out->pkt->data, out->pkt->config.channels, i*nb_floats, out->pkt->planes > 1);
-
-              for(int j=0; j<out->pkt->planes; j++)
-              {
-#if defined(HAVE_SSE) && defined(__SSE__)
-                CAEUtil::SSEMulArray((float*)out->pkt->data[j]+i*nb_floats, volume, nb_floats);
-#else
-                float* fbuffer = (float*) out->pkt->data[j]+i*nb_floats;
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  fbuffer[k] *= volume;
-                }
-#endif
-              }
+              m_frameGains[i] = FadeGain(**it) * (*it)->m_rgain;
             }
+
+            // the limiter looks at each frame before it gets scaled
+            if(nb_loops > 1)
+              (*it)->m_limiter.RunFrames((float**)out->pkt->data, out->pkt->config.channels, nb_loops, out->pkt->planes > 1, m_frameGains.data());
+
+            for(int j=0; j<out->pkt->planes; j++)
+              CAEUtil::MulFrames((float*)out->pkt->data[j], m_frameGains.data(), nb_loops, nb_floats);
           }
           else
           {
@@ -2105,6 +2138,7 @@ bool CActiveAE::RunStages()
               nb_loops = out->pkt->nb_samples;
             }
 
+            m_frameGains.resize(nb_loops);
             for(int i=0; i<nb_loops; i++)
             {
               if ((*it)->m_fadingSamples > 0)
@@ -2121,33 +2155,20 @@ bool CActiveAE::RunStages()
               }
 
               // volume for stream
-              float volume = (*it)->m_volume * (*it)->m_rgain;
-              if(nb_loops > 1)
-                volume *= (*it)->m_limiter.Run((float**)mix->pkt->data, mix->pkt->config.channels, i*nb_floats, mix->pkt->planes > 1);
+              m_frameGains[i] = FadeGain(**it) * (*it)->m_rgain;
+            }
 
-              for(int j=0; j<out->pkt->planes && j<mix->pkt->planes; j++)
-              {
-                float *dst = (float*)out->pkt->data[j]+i*nb_floats;
-                float *src = (float*)mix->pkt->data[j]+i*nb_floats;
-#if defined(HAVE_SSE) && defined(__SSE__)
-                CAEUtil::SSEMulAddArray(dst, src, volume, nb_floats);
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  if (fabs(dst[k]) > 1.0f)
-                  {
-                    needClamp = true;
-                    break;
-                  }
-                }
-#else
-                for (int k = 0; k < nb_floats; ++k)
-                {
-                  dst[k] += src[k] * volume;
-                  if (fabs(dst[k]) > 1.0f)
-                    needClamp = true;
-                }
-#endif
-              }
+            // the limiter looks at each frame before it gets scaled
+            if(nb_loops > 1)
+              (*it)->m_limiter.RunFrames((float**)mix->pkt->data, mix->pkt->config.channels, nb_loops, mix->pkt->planes > 1, m_frameGains.data());
+
+            for(int j=0; j<out->pkt->planes && j<mix->pkt->planes; j++)
+            {
+              float *dst = (float*)out->pkt->data[j];
+              float *src = (float*)mix->pkt->data[j];
+              CAEUtil::MulAddFrames(dst, src, m_frameGains.data(), nb_loops, nb_floats);
+              if (!needClamp)
+                needClamp = CAEUtil::NeedsClamp(dst, nb_loops * nb_floats);
             }
             mix->Return();
           }
@@ -2209,8 +2230,16 @@ bool CActiveAE::RunStages()
               else
               {
                 unsigned int samples = static_cast<unsigned int>(buf->pkt->nb_samples);
+                const float *data = reinterpret_cast<float*>(buf->pkt->data[0]);
+                m_vizBlock++;
                 for (auto& it : m_audioCallback)
-                  it->OnAudioData((float*)(buf->pkt->data[0]), samples);
+                {
+                  unsigned int bins = it->GetSpectrumBins();
+                  if (bins)
+                    it->OnAudioData(data, samples, GetVizSpectrum(data, samples, bins), bins * 2);
+                  else
+                    it->OnAudioData(data, samples, nullptr, 0);
+                }
                 buf->Return();
                 m_vizBuffers->m_outputSamples.pop_front();
               }
@@ -2506,47 +2535,121 @@ void CActiveAE::MixSounds(CSoundPacket &dstSample)
   if (m_sounds_playing.empty())
     return;
 
-  float volume;
-  float *out;
-  float *sample_buffer;
   int max_samples = dstSample.nb_samples;
+  int nb_floats = max_samples * dstSample.config.channels / dstSample.planes;
+
+  // sounds covering the whole packet are mixed in a single pass below,
+  // plays of the same sound at the same position share one source
+  m_soundMix.clear();
 
   std::list<SoundState>::iterator it;
   for (it = m_sounds_playing.begin(); it != m_sounds_playing.end(); )
   {
     if (!it->sound->IsConverted())
       ResampleSound(it->sound);
-    int available_samples = it->sound->GetSound(false)->nb_samples - it->samples_played;
-    int mix_samples = std::min(max_samples, available_samples);
-    int start = it->samples_played *
-                av_get_bytes_per_sample(it->sound->GetSound(false)->config.fmt) *
-                it->sound->GetSound(false)->config.channels /
-                it->sound->GetSound(false)->planes;
+    CSoundPacket *sound = it->sound->GetSound(false);
+    if (!sound)
+    {
+      it = m_sounds_playing.erase(it);
+      continue;
+    }
 
-    for(int j=0; j<dstSample.planes; j++)
+    int available_samples = sound->nb_samples - it->samples_played;
+    int mix_samples = std::min(max_samples, available_samples);
+    int start = it->samples_played * sound->bytes_per_sample *
+                sound->config.channels / sound->planes;
+    float volume = it->sound->GetVolume();
+
+    if (mix_samples == max_samples)
+    {
+      auto mix = std::find_if(m_soundMix.begin(), m_soundMix.end(),
+                              [sound, start](const SoundMix &m)
+                              {
+                                return m.sound == sound && m.start == start;
+                              });
+      if (mix != m_soundMix.end())
+        mix->volume += volume;
+      else
+        m_soundMix.push_back({sound, start, volume});
+    }
+    else
     {
-      volume = it->sound->GetVolume();
-      out = (float*)dstSample.data[j];
-      sample_buffer = (float*)(it->sound->GetSound(false)->data[j]+start);
-      int nb_floats = mix_samples * dstSample.config.channels / dstSample.planes;
-#if defined(HAVE_SSE) && defined(__SSE__)
-      CAEUtil::SSEMulAddArray(out, sample_buffer, volume, nb_floats);
-#else
-      for (int k = 0; k < nb_floats; ++k)
-        *out++ += *sample_buffer++ * volume;
-#endif
+      // tail of a sound, mix on its own
+      for (int j = 0; j < dstSample.planes; j++)
+      {
+        float *out = reinterpret_cast<float*>(dstSample.data[j]);
+        float *sample_buffer = reinterpret_cast<float*>(sound->data[j] + start);
+        CAEUtil::MulAddArray(out, sample_buffer,
+                             volume, mix_samples * dstSample.config.channels / dstSample.planes);
+      }
     }
 
     it->samples_played += mix_samples;
 
     // no more frames, so remove it from the list
-    if (it->samples_played >= it->sound->GetSound(false)->nb_samples)
+    if (it->samples_played >= sound->nb_samples)
     {
       it = m_sounds_playing.erase(it);
       continue;
     }
     ++it;
   }
+
+  if (m_soundMix.empty())
+    return;
+
+  m_soundMixGains.clear();
+  for (auto &mix : m_soundMix)
+    m_soundMixGains.push_back(mix.volume);
+
+  for (int j = 0; j < dstSample.planes; j++)
+  {
+    m_soundMixSources.clear();
+    for (auto &mix : m_soundMix)
+      m_soundMixSources.push_back(reinterpret_cast<float*>(mix.sound->data[j] + mix.start));
+
+    float *out = reinterpret_cast<float*>(dstSample.data[j]);
+    CAEUtil::MulAddArrays(out, m_soundMixSources.data(), m_soundMixGains.data(),
+                          m_soundMix.size(), nb_floats);
+  }
+}
+
+/**
+ * volume of a stream at its current position of a fade, constant power
+ * fades move along a quarter sine so that sin^2 + cos^2 of two streams
+ * crossfading over the same time add up to one
+ */
+float CActiveAE::FadeGain(const CActiveAEStream &stream)
+{
+  if (stream.m_fadingPower && stream.m_fadingSamples > 0)
+    return sinf(std::max(0.0f, std::min(1.0f, stream.m_volume)) * static_cast<float>(M_PI_2));
+  return stream.m_volume;
+}
+
+/**
+ * spectrum of a stereo viz block, transformed once per block for all
+ * callbacks asking for the same number of bins
+ */
+const float *CActiveAE::GetVizSpectrum(const float *data, unsigned int frames, unsigned int bins)
+{
+  VizSpectrum &spectrum = m_vizSpectra[bins];
+  if (!spectrum.transform)
+  {
+    spectrum.transform.reset(new RFFT(bins * 2, false));
+    spectrum.input.resize(bins * 4);
+    spectrum.output.resize(bins * 2);
+  }
+  else if (spectrum.block == m_vizBlock)
+    return spectrum.output.data();
+
+  // the transform takes bins * 2 frames, pad a short block with silence
+  unsigned int floats = std::min(frames, bins * 2) * 2;
+  std::copy(data, data + floats, spectrum.input.begin());
+  std::fill(spectrum.input.begin() + floats, spectrum.input.end(), 0.0f);
+  spectrum.transform->calc(spectrum.input.data(), spectrum.output.data());
+  spectrum.block = m_vizBlock;
+
+  return spectrum.output.data();
 }
 
 void CActiveAE::Deamplify(CSoundPacket &dstSample)
@@ -2559,13 +2662,7 @@ void CActiveAE::Deamplify(CSoundPacket &dstSample)
     for(int j=0; j<dstSample.planes; j++)
     {
       float* buffer = reinterpret_cast<float*>(dstSample.data[j]);
-#if defined(HAVE_SSE) && defined(__SSE__)
-      CAEUtil::SSEMulArray(buffer, volume, nb_floats);
-#else
-      float *fbuffer = buffer;
-      for (int i = 0; i < nb_floats; i++)
-        *fbuffer++ *= volume;
-#endif
+      CAEUtil::MulArray(buffer, volume, nb_floats);
     }
   }
 }
@@ -2603,6 +2700,15 @@ void CActiveAE::LoadSettings()
   m_settings.atempoThreshold = settings->GetInt(CSettings::SETTING_AUDIOOUTPUT_ATEMPOTHRESHOLD) / 100.0;
   m_settings.streamNoise = settings->GetBool(CSettings::SETTING_AUDIOOUTPUT_STREAMNOISE);
   m_settings.silenceTimeout = settings->GetInt(CSettings::SETTING_AUDIOOUTPUT_STREAMSILENCE) * 60000;
+
+  // the music zone only plays pcm on its own device
+  if (m_musicZone)
+  {
+    m_settings.device = settings->GetString(CSettings::SETTING_AUDIOOUTPUT_MUSICDEVICE);
+    m_settings.channels = (m_sink.GetDeviceType(m_settings.device) == AE_DEVTYPE_IEC958) ? AE_CH_LAYOUT_2_0 : settings->GetInt(CSettings::SETTING_AUDIOOUTPUT_CHANNELS);
+    m_settings.passthrough = false;
+    m_settings.guisoundmode = AE_SOUND_OFF;
+  }
 }
 
 void CActiveAE::Start()
@@ -2698,7 +2804,8 @@ bool CActiveAE::HasHDAudioChannelCount()
 
 bool CActiveAE::SupportsQualityLevel(enum AEQuality level)
 {
-  if (level == AE_QUALITY_LOW || level == AE_QUALITY_MID || level == AE_QUALITY_HIGH)
+  if (level == AE_QUALITY_LOW || level == AE_QUALITY_MID || level == AE_QUALITY_HIGH ||
+      level == AE_QUALITY_POLYPHASE)
     return true;
 #if defined(TARGET_RASPBERRY_PI)
   if (level == AE_QUALITY_GPU)
@@ -2933,6 +3040,67 @@ bool CActiveAE::CompareFormat(AEAudioFormat &lhs, AEAudioFormat &rhs)
     return true;
 }
 
+/**
+ * a single stream that needs neither conversion nor scaling can be passed
+ * to the sink as it is, which saves the float mix buffer and keeps the samples
+ * bit exact
+ */
+bool CActiveAE::CanBypassMixing()
+{
+  if (m_mode != MODE_PCM || m_streams.size() != 1)
+    return false;
+
+  // gui sounds and software volume are mixed in float
+  if (!m_sounds_playing.empty() || m_aeGUISoundForce ||
+      m_settings.guisoundmode == AE_SOUND_ALWAYS ||
+      m_muted || (!m_sinkHasVolume && m_volumeScaled < 1.0))
+    return false;
+
+  CActiveAEStream *stream = m_streams.front();
+  if (stream->m_forceResampler ||
+      stream->m_volume != 1.0f || stream->m_rgain != 1.0f || stream->m_amplify != 1.0f ||
+      stream->m_fadingSamples != 0)
+    return false;
+
+  // only integer formats whose silence is zero, float sinks rely on the limiter
+  AEAudioFormat &format = stream->m_format;
+  switch (format.m_dataFormat)
+  {
+  case AE_FMT_S16BE:
+  case AE_FMT_S16LE:
+  case AE_FMT_S16NE:
+  case AE_FMT_S32BE:
+  case AE_FMT_S32LE:
+  case AE_FMT_S32NE:
+  case AE_FMT_S24BE4:
+  case AE_FMT_S24LE4:
+  case AE_FMT_S24NE4:
+  case AE_FMT_S24NE4MSB:
+  case AE_FMT_S24BE3:
+  case AE_FMT_S24LE3:
+  case AE_FMT_S24NE3:
+  case AE_FMT_S16NEP:
+  case AE_FMT_S32NEP:
+  case AE_FMT_S24NE4P:
+  case AE_FMT_S24NE4MSBP:
+  case AE_FMT_S24NE3P:
+    break;
+  default:
+    return false;
+  }
+
+  if (!CompareFormat(format, m_sinkFormat) ||
+      m_sinkFormat.m_channelLayout.Count() > m_sinkRequestFormat.m_channelLayout.Count())
+    return false;
+
+  // the stream remapper and the sink stage expect ffmpeg channel order
+  uint64_t avlayout = CAEUtil::GetAVChannelLayout(format.m_channelLayout);
+  if (CAEUtil::GetAEChannelLayout(avlayout) != format.m_channelLayout)
+    return false;
+
+  return true;
+}
+
 //-----------------------------------------------------------------------------
 // GUI Sounds
 //-----------------------------------------------------------------------------
@@ -3370,13 +3538,14 @@ void CActiveAE::SetStreamFFmpegInfo(CActiveAEStream *stream, int profile, enum A
   m_controlPort.SendOutMessage(CActiveAEControlProtocol::STREAMFFMPEGINFO, &msg, sizeof(MsgStreamFFmpegInfo));
 }
 
-void CActiveAE::SetStreamFade(CActiveAEStream *stream, float from, float target, unsigned int millis)
+void CActiveAE::SetStreamFade(CActiveAEStream *stream, float from, float target, unsigned int millis, bool constantPower)
 {
   MsgStreamFade msg;
   msg.stream = stream;
   msg.from = from;
   msg.target = target;
   msg.millis = millis;
+  msg.constantPower = constantPower;
   m_controlPort.SendOutMessage(CActiveAEControlProtocol::STREAMFADE,
                                      &msg, sizeof(MsgStreamFade));
 }
@@ -9,6 +9,8 @@
 #pragma once
 
 #include <list>
+#include <map>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -20,6 +22,7 @@
 #include "cores/AudioEngine/Engines/ActiveAE/ActiveAEBuffer.h"
 
 #include "guilib/DispResource.h"
+#include "utils/rfft.h"
 #include <queue>
 
 // ffmpeg
@@ -160,6 +163,7 @@ struct MsgStreamFade
   float from;
   float target;
   unsigned int millis;
+  bool constantPower;
 };
 
 struct MsgStreamFFmpegInfo
@@ -223,7 +227,12 @@ protected:
   friend class CActiveAEBufferPoolResample;
 
 public:
-  CActiveAE();
+  /*!
+   \brief Create an audio engine
+   \param musicZone a secondary engine for music on audiooutput.musicdevice, no passthrough,
+   no gui sounds and it doesn't handle the audio settings
+   */
+  explicit CActiveAE(bool musicZone = false);
   ~CActiveAE() override;
   void Start() override;
   void Shutdown() override;
@@ -281,7 +290,7 @@ protected:
   void SetStreamResampleRatio(CActiveAEStream *stream, double ratio);
   void SetStreamResampleMode(CActiveAEStream *stream, int mode);
   void SetStreamFFmpegInfo(CActiveAEStream *stream, int profile, enum AVMatrixEncoding matrix_encoding, enum AVAudioServiceType audio_service_type);
-  void SetStreamFade(CActiveAEStream *stream, float from, float target, unsigned int millis);
+  void SetStreamFade(CActiveAEStream *stream, float from, float target, unsigned int millis, bool constantPower);
 
 protected:
   void Process() override;
@@ -313,8 +322,11 @@ protected:
   bool ResampleSound(CActiveAESound *sound);
   void MixSounds(CSoundPacket &dstSample);
   void Deamplify(CSoundPacket &dstSample);
+  static float FadeGain(const CActiveAEStream &stream);
+  const float *GetVizSpectrum(const float *data, unsigned int frames, unsigned int bins);
 
   bool CompareFormat(AEAudioFormat &lhs, AEAudioFormat &rhs);
+  bool CanBypassMixing();
 
   CEvent m_inMsgEvent;
   CEvent m_outMsgEvent;
@@ -362,6 +374,10 @@ protected:
   std::list<CActiveAEBufferPool*> m_discardBufferPools;
   unsigned int m_streamIdGen;
 
+  std::vector<float> m_frameGains; ///< gain of each frame of a stream being mixed
+  bool m_bypassMixing; ///< a single stream goes to the sink in its own format, see CanBypassMixing()
+  bool m_musicZone;
+
   // gui sounds
   struct SoundState
   {
@@ -370,6 +386,15 @@ protected:
   };
   std::list<SoundState> m_sounds_playing;
   std::vector<CActiveAESound*> m_sounds;
+  struct SoundMix
+  {
+    CSoundPacket *sound;
+    int start;
+    float volume;
+  };
+  std::vector<SoundMix> m_soundMix; ///< sounds mixed together in one pass by MixSounds
+  std::vector<const float*> m_soundMixSources;
+  std::vector<float> m_soundMixGains;
 
   float m_volume; // volume on a 0..1 scale corresponding to a proportion along the dB scale
   float m_volumeScaled; // multiplier to scale samples in order to achieve the volume specified in m_volume
@@ -379,6 +404,15 @@ protected:
   // viz
   std::vector<IAudioCallback*> m_audioCallback;
   bool m_vizInitialized;
+  struct VizSpectrum
+  {
+    std::unique_ptr<RFFT> transform;
+    std::vector<float> input;
+    std::vector<float> output;
+    unsigned int block = 0;
+  };
+  std::map<unsigned int, VizSpectrum> m_vizSpectra; ///< by bins per channel
+  unsigned int m_vizBlock = 0;
   CCriticalSection m_vizLock;
 
   // polled via the interface
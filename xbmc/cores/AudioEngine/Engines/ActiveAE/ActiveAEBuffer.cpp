@@ -12,6 +12,14 @@
 #include "ActiveAEFilter.h"
 #include "cores/AudioEngine/AEResampleFactory.h"
 #include "cores/AudioEngine/Utils/AEUtil.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cstring>
+#if defined(TARGET_POSIX)
+#include <errno.h>
+#include <sys/mman.h>
+#endif
 
 using namespace ActiveAE;
 
@@ -61,26 +69,73 @@ CActiveAEBufferPool::CActiveAEBufferPool(const AEAudioFormat& format)
 
 CActiveAEBufferPool::~CActiveAEBufferPool()
 {
+  if (!m_allSamples.empty())
+    CLog::Log(LOGDEBUG, LOGAUDIO, "CActiveAEBufferPool - %s, %d Hz: %u buffers, %u max in use, %u underruns",
+              CAEUtil::DataFormatToStr(m_format.m_dataFormat), m_format.m_sampleRate,
+              static_cast<unsigned int>(m_allSamples.size()), m_highWater, m_underruns);
+
   CSampleBuffer *buffer;
   while(!m_allSamples.empty())
   {
     buffer = m_allSamples.front();
     m_allSamples.pop_front();
+#if defined(TARGET_POSIX)
+    if (m_locked)
+    {
+      for (int i = 0; i < buffer->pkt->planes; i++)
+        munlock(buffer->pkt->data[i], buffer->pkt->linesize);
+    }
+#endif
     delete buffer;
   }
 }
 
+/**
+ * fault in all pages of the pool up front and keep them in memory, a thread
+ * feeding the audio device must not wait for the kernel to page them in
+ */
+void CActiveAEBufferPool::LockMemory()
+{
+  for (CSampleBuffer *buffer : m_allSamples)
+  {
+    for (int i = 0; i < buffer->pkt->planes; i++)
+      memset(buffer->pkt->data[i], 0, buffer->pkt->linesize);
+  }
+
+#if defined(TARGET_POSIX)
+  // whatever got locked before a failure is unlocked with the pool
+  m_locked = true;
+  for (CSampleBuffer *buffer : m_allSamples)
+  {
+    for (int i = 0; i < buffer->pkt->planes; i++)
+    {
+      if (mlock(buffer->pkt->data[i], buffer->pkt->linesize) != 0)
+      {
+        CLog::Log(LOGWARNING, "CActiveAEBufferPool::LockMemory - mlock failed: %s", strerror(errno));
+        return;
+      }
+    }
+  }
+#endif
+}
+
 CSampleBuffer* CActiveAEBufferPool::GetFreeBuffer()
 {
   CSampleBuffer* buf = NULL;
 
   if (!m_freeSamples.empty())
   {
-    buf = m_freeSamples.front();
-    m_freeSamples.pop_front();
+    buf = m_freeSamples.back();
+    m_freeSamples.pop_back();
     buf->refCount = 1;
     buf->centerMixLevel = M_SQRT1_2;
+
+    unsigned int used = m_allSamples.size() - m_freeSamples.size();
+    if (used > m_highWater)
+      m_highWater = used;
   }
+  else
+    m_underruns++;
   return buf;
 }
 
@@ -102,14 +157,19 @@ bool CActiveAEBufferPool::Create(unsigned int totaltime)
   config.sample_rate = m_format.m_sampleRate;
   config.channel_layout = CAEUtil::GetAVChannelLayout(m_format.m_channelLayout);
 
-  unsigned int time = 0;
-  unsigned int buffertime = (m_format.m_frames*1000) / m_format.m_sampleRate;
+  // number of periods needed to cover totaltime, the period of a sink can be
+  // well below a millisecond so don't round it to whole milliseconds
+  double buffertime = static_cast<double>(m_format.m_frames) * 1000 / m_format.m_sampleRate;
   if (m_format.m_dataFormat == AE_FMT_RAW)
   {
     buffertime = m_format.m_streamInfo.GetDuration();
   }
-  unsigned int n = 0;
-  while (time < totaltime || n < 5)
+  unsigned int count = 5;
+  if (buffertime > 0)
+    count = std::max(count, static_cast<unsigned int>(std::ceil(totaltime / buffertime)));
+
+  m_freeSamples.reserve(count);
+  for (unsigned int n = 0; n < count; n++)
   {
     buffer = new CSampleBuffer();
     buffer->pool = this;
@@ -117,8 +177,6 @@ bool CActiveAEBufferPool::Create(unsigned int totaltime)
 
     m_allSamples.push_back(buffer);
     m_freeSamples.push_back(buffer);
-    time += buffertime;
-    n++;
   }
 
   return true;
@@ -13,6 +13,7 @@
 #include <cmath>
 #include <deque>
 #include <memory>
+#include <vector>
 
 extern "C" {
 #include <libavutil/avutil.h>
@@ -65,9 +66,13 @@ public:
   virtual bool Create(unsigned int totaltime);
   CSampleBuffer *GetFreeBuffer();
   void ReturnBuffer(CSampleBuffer *buffer);
+  void LockMemory();
   AEAudioFormat m_format;
   std::deque<CSampleBuffer*> m_allSamples;
-  std::deque<CSampleBuffer*> m_freeSamples;
+  std::vector<CSampleBuffer*> m_freeSamples; // used as a stack, recently returned buffers are still in cache
+  unsigned int m_underruns = 0; // number of requests while no buffer was free
+  unsigned int m_highWater = 0; // max number of buffers in use at the same time
+  bool m_locked = false;
 };
 
 class IAEResample;
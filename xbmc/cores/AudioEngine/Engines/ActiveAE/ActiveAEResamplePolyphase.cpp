@@ -0,0 +1,278 @@
+/*
+ *  Copyright (C) 2010-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ActiveAEResamplePolyphase.h"
+
+#include "ActiveAEResampleFFMPEG.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cmath>
+
+extern "C" {
+#include <libavutil/mathematics.h>
+}
+
+using namespace ActiveAE;
+
+namespace
+{
+// filters between two input samples, the phases in between are interpolated
+constexpr int PHASES = 256;
+constexpr int PHASE_BITS = 8;
+constexpr int TAPS = 32;
+constexpr int HALF_TAPS = TAPS / 2;
+constexpr int FRAC_BITS = 32;
+constexpr double KAISER_BETA = 8.0;
+
+double BesselI0(double x)
+{
+  double sum = 1.0;
+  double term = 1.0;
+  for (int k = 1; k < 32; k++)
+  {
+    term *= (x / (2.0 * k)) * (x / (2.0 * k));
+    sum += term;
+    if (term < sum * 1e-12)
+      break;
+  }
+  return sum;
+}
+}
+
+CActiveAEResamplePolyphase::CActiveAEResamplePolyphase()
+{
+  m_position = 0;
+  m_planar = true;
+  m_channels = 0;
+  m_src_rate = m_dst_rate = 0;
+  m_src_channels = 0;
+  m_src_fmt = AV_SAMPLE_FMT_NONE;
+}
+
+CActiveAEResamplePolyphase::~CActiveAEResamplePolyphase() = default;
+
+bool CActiveAEResamplePolyphase::Init(SampleConfig dstConfig, SampleConfig srcConfig, bool upmix, bool normalize, double centerMix,
+                                      CAEChannelInfo *remapLayout, AEQuality quality, bool force_resample)
+{
+  m_fallback.reset();
+  m_convert.reset();
+
+  m_src_rate = srcConfig.sample_rate;
+  m_dst_rate = dstConfig.sample_rate;
+  m_src_channels = srcConfig.channels;
+  m_src_fmt = srcConfig.fmt;
+
+  // nothing to filter or output the filter doesn't write, ffmpeg does it all
+  if ((dstConfig.fmt != AV_SAMPLE_FMT_FLT && dstConfig.fmt != AV_SAMPLE_FMT_FLTP) ||
+      (m_src_rate == m_dst_rate && !force_resample))
+  {
+    m_fallback.reset(new CActiveAEResampleFFMPEG());
+    return m_fallback->Init(dstConfig, srcConfig, upmix, normalize, centerMix, remapLayout, AE_QUALITY_MID, force_resample);
+  }
+
+  m_planar = dstConfig.fmt == AV_SAMPLE_FMT_FLTP;
+  m_channels = dstConfig.channels;
+
+  if (srcConfig.fmt != AV_SAMPLE_FMT_FLTP || srcConfig.channels != dstConfig.channels ||
+      srcConfig.channel_layout != dstConfig.channel_layout || remapLayout)
+  {
+    SampleConfig convertConfig = dstConfig;
+    convertConfig.fmt = AV_SAMPLE_FMT_FLTP;
+    convertConfig.sample_rate = srcConfig.sample_rate;
+    convertConfig.bits_per_sample = 32;
+    convertConfig.dither_bits = 0;
+    m_convert.reset(new CActiveAEResampleFFMPEG());
+    if (!m_convert->Init(convertConfig, srcConfig, upmix, normalize, centerMix, remapLayout, AE_QUALITY_MID, false))
+      return false;
+    m_convertPlanes.assign(m_channels, std::vector<float>());
+  }
+
+  m_history.assign(m_channels, std::vector<float>(HALF_TAPS - 1, 0.0f));
+  m_position = static_cast<uint64_t>(HALF_TAPS - 1) << FRAC_BITS;
+  CreateFilters();
+
+  CLog::Log(LOGDEBUG, "CActiveAEResamplePolyphase::Init - %d channels from %d to %d Hz%s",
+            m_channels, m_src_rate, m_dst_rate, m_convert ? ", converting input" : "");
+  return true;
+}
+
+void CActiveAEResamplePolyphase::CreateFilters()
+{
+  // windowed sinc, below the nyquist frequency of the lower of both rates
+  const double cutoff = 0.97 * std::min(1.0, static_cast<double>(m_dst_rate) / m_src_rate);
+  const double i0Beta = BesselI0(KAISER_BETA);
+
+  m_filters.resize((PHASES + 1) * TAPS);
+  m_coeffs.resize(TAPS);
+  for (int phase = 0; phase <= PHASES; phase++)
+  {
+    float *filter = &m_filters[phase * TAPS];
+    double sum = 0.0;
+    for (int k = 0; k < TAPS; k++)
+    {
+      const double t = k - HALF_TAPS + 1 - static_cast<double>(phase) / PHASES;
+      const double x = M_PI * cutoff * t;
+      const double sinc = t == 0.0 ? 1.0 : std::sin(x) / x;
+      const double w = t / HALF_TAPS;
+      const double window = BesselI0(KAISER_BETA * std::sqrt(std::max(0.0, 1.0 - w * w))) / i0Beta;
+      filter[k] = static_cast<float>(sinc * window);
+      sum += filter[k];
+    }
+    // unity gain for every phase, no ripple of the dc level
+    for (int k = 0; k < TAPS; k++)
+      filter[k] = static_cast<float>(filter[k] / sum);
+  }
+}
+
+void CActiveAEResamplePolyphase::AddInput(float **planes, int samples)
+{
+  for (int ch = 0; ch < m_channels; ch++)
+    m_history[ch].insert(m_history[ch].end(), planes[ch], planes[ch] + samples);
+}
+
+int CActiveAEResamplePolyphase::Filter(uint8_t **dst_buffer, int dst_samples, double ratio, int end)
+{
+  const int length = static_cast<int>(m_history[0].size());
+  const uint64_t step = static_cast<uint64_t>(std::llround(static_cast<double>(m_src_rate) /
+                                                           (m_dst_rate * ratio) * (1LL << FRAC_BITS)));
+
+  int out = 0;
+  while (out < dst_samples)
+  {
+    const int index = static_cast<int>(m_position >> FRAC_BITS);
+    if (index >= end || index + HALF_TAPS >= length)
+      break;
+
+    // interpolate the filter of this phase once, all channels use it
+    const uint32_t frac = static_cast<uint32_t>(m_position);
+    const int phase = frac >> (FRAC_BITS - PHASE_BITS);
+    const float weight = (frac & ((1u << (FRAC_BITS - PHASE_BITS)) - 1)) *
+                         (1.0f / (1u << (FRAC_BITS - PHASE_BITS)));
+    const float *a = &m_filters[phase * TAPS];
+    const float *b = a + TAPS;
+    for (int k = 0; k < TAPS; k++)
+      m_coeffs[k] = a[k] + weight * (b[k] - a[k]);
+
+    const int first = index - HALF_TAPS + 1;
+    for (int ch = 0; ch < m_channels; ch++)
+    {
+      const float *src = &m_history[ch][first];
+      float sum = 0.0f;
+      for (int k = 0; k < TAPS; k++)
+        sum += src[k] * m_coeffs[k];
+
+      if (m_planar)
+        reinterpret_cast<float*>(dst_buffer[ch])[out] = sum;
+      else
+        reinterpret_cast<float*>(dst_buffer[0])[out * m_channels + ch] = sum;
+    }
+
+    m_position += step;
+    out++;
+  }
+  return out;
+}
+
+int CActiveAEResamplePolyphase::Resample(uint8_t **dst_buffer, int dst_samples, uint8_t **src_buffer, int src_samples, double ratio)
+{
+  if (m_fallback)
+    return m_fallback->Resample(dst_buffer, dst_samples, src_buffer, src_samples, ratio);
+
+  if (src_buffer && src_samples > 0)
+  {
+    if (m_convert)
+    {
+      uint8_t *planes[AE_CH_MAX];
+      for (int ch = 0; ch < m_channels; ch++)
+      {
+        if (m_convertPlanes[ch].size() < static_cast<size_t>(src_samples))
+          m_convertPlanes[ch].resize(src_samples);
+        planes[ch] = reinterpret_cast<uint8_t*>(m_convertPlanes[ch].data());
+      }
+      int converted = m_convert->Resample(planes, src_samples, src_buffer, src_samples, 1.0);
+      if (converted < 0)
+        return -1;
+      AddInput(reinterpret_cast<float**>(planes), converted);
+    }
+    else
+      AddInput(reinterpret_cast<float**>(src_buffer), src_samples);
+  }
+
+  const int length = static_cast<int>(m_history[0].size());
+  int out = Filter(dst_buffer, dst_samples, ratio, length);
+
+  // no more input, let the tail of the input run through the filter against silence
+  if (!src_samples && out < dst_samples && static_cast<int>(m_position >> FRAC_BITS) < length)
+  {
+    for (auto &history : m_history)
+      history.resize(length + HALF_TAPS, 0.0f);
+
+    uint8_t *planes[AE_CH_MAX];
+    for (int ch = 0; ch < m_channels; ch++)
+    {
+      if (m_planar)
+        planes[ch] = dst_buffer[ch] + out * sizeof(float);
+      else
+        planes[ch] = dst_buffer[0] + out * m_channels * sizeof(float);
+    }
+    out += Filter(planes, dst_samples - out, ratio, length);
+
+    for (auto &history : m_history)
+      history.resize(length);
+  }
+
+  // keep what the filter of the next output sample needs
+  const int used = std::min(static_cast<int>(m_position >> FRAC_BITS) - (HALF_TAPS - 1), length);
+  if (used > 0)
+  {
+    for (auto &history : m_history)
+      history.erase(history.begin(), history.begin() + used);
+    m_position -= static_cast<uint64_t>(used) << FRAC_BITS;
+  }
+
+  return out;
+}
+
+int64_t CActiveAEResamplePolyphase::GetDelay(int64_t base)
+{
+  if (m_fallback)
+    return m_fallback->GetDelay(base);
+
+  const double buffered = static_cast<double>(m_history[0].size()) -
+                          static_cast<double>(m_position) / (1LL << FRAC_BITS);
+  if (buffered <= 0.0)
+    return 0;
+  return static_cast<int64_t>(std::ceil(buffered * base / m_src_rate));
+}
+
+int CActiveAEResamplePolyphase::GetBufferedSamples()
+{
+  if (m_fallback)
+    return m_fallback->GetBufferedSamples();
+
+  return static_cast<int>(GetDelay(m_dst_rate));
+}
+
+int CActiveAEResamplePolyphase::CalcDstSampleCount(int src_samples, int dst_rate, int src_rate)
+{
+  return av_rescale_rnd(src_samples, dst_rate, src_rate, AV_ROUND_UP);
+}
+
+int CActiveAEResamplePolyphase::GetSrcBufferSize(int samples)
+{
+  return av_samples_get_buffer_size(NULL, m_src_channels, samples, m_src_fmt, 1);
+}
+
+int CActiveAEResamplePolyphase::GetDstBufferSize(int samples)
+{
+  if (m_fallback)
+    return m_fallback->GetDstBufferSize(samples);
+
+  return samples * m_channels * sizeof(float);
+}
@@ -0,0 +1,65 @@
+/*
+ *  Copyright (C) 2010-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "cores/AudioEngine/Interfaces/AEResample.h"
+
+#include <memory>
+#include <vector>
+
+namespace ActiveAE
+{
+
+class CActiveAEResampleFFMPEG;
+
+/*!
+ \brief Resampler with a fixed polyphase filter bank for float output
+
+ The filter bank is computed once in Init(), the phase of every output sample is interpolated
+ between the two nearest filters. A different ratio only changes the step of the fixed point
+ phase accumulator, so the constant small corrections of sync playback to display cost nothing
+ extra. Sample format and channel conversion are left to ffmpeg at the source rate, for output
+ that isn't float the whole job is.
+ */
+class CActiveAEResamplePolyphase : public IAEResample
+{
+public:
+  const char *GetName() override { return "ActiveAEResamplePolyphase"; }
+  CActiveAEResamplePolyphase();
+  ~CActiveAEResamplePolyphase() override;
+  bool Init(SampleConfig dstConfig, SampleConfig srcConfig, bool upmix, bool normalize, double centerMix,
+            CAEChannelInfo *remapLayout, AEQuality quality, bool force_resample) override;
+  int Resample(uint8_t **dst_buffer, int dst_samples, uint8_t **src_buffer, int src_samples, double ratio) override;
+  int64_t GetDelay(int64_t base) override;
+  int GetBufferedSamples() override;
+  bool WantsNewSamples(int samples) override { return GetBufferedSamples() <= samples * 2; }
+  int CalcDstSampleCount(int src_samples, int dst_rate, int src_rate) override;
+  int GetSrcBufferSize(int samples) override;
+  int GetDstBufferSize(int samples) override;
+
+protected:
+  void CreateFilters();
+  void AddInput(float **planes, int samples);
+  int Filter(uint8_t **dst_buffer, int dst_samples, double ratio, int end);
+
+  std::unique_ptr<CActiveAEResampleFFMPEG> m_fallback; ///< does everything for output that isn't float
+  std::unique_ptr<CActiveAEResampleFFMPEG> m_convert; ///< converts the input to planar float at the source rate
+  std::vector<std::vector<float>> m_convertPlanes;
+  std::vector<std::vector<float>> m_history; ///< input not fully used yet, one vector per channel
+  std::vector<float> m_filters; ///< PHASES + 1 filters of TAPS coefficients
+  std::vector<float> m_coeffs; ///< filter of the current output sample
+  uint64_t m_position; ///< of the next output sample in m_history, 32.32 fixed point
+  bool m_planar;
+  int m_channels;
+  int m_src_rate, m_dst_rate;
+  int m_src_channels;
+  AVSampleFormat m_src_fmt;
+};
+
+}
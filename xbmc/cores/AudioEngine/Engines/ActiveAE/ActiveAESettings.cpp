@@ -57,6 +57,7 @@ CActiveAESettings::CActiveAESettings(CActiveAE &ae) : m_audioEngine(ae)
   settings->GetSettingsManager()->RegisterSettingOptionsFiller("aequalitylevels", SettingOptionsAudioQualityLevelsFiller);
   settings->GetSettingsManager()->RegisterSettingOptionsFiller("audiodevices", SettingOptionsAudioDevicesFiller);
   settings->GetSettingsManager()->RegisterSettingOptionsFiller("audiodevicespassthrough", SettingOptionsAudioDevicesPassthroughFiller);
+  settings->GetSettingsManager()->RegisterSettingOptionsFiller("audiodevicesmusic", SettingOptionsAudioDevicesMusicFiller);
   settings->GetSettingsManager()->RegisterSettingOptionsFiller("audiostreamsilence", SettingOptionsAudioStreamsilenceFiller);
 }
 
@@ -68,6 +69,7 @@ CActiveAESettings::~CActiveAESettings()
   settings->GetSettingsManager()->UnregisterSettingOptionsFiller("aequalitylevels");
   settings->GetSettingsManager()->UnregisterSettingOptionsFiller("audiodevices");
   settings->GetSettingsManager()->UnregisterSettingOptionsFiller("audiodevicespassthrough");
+  settings->GetSettingsManager()->UnregisterSettingOptionsFiller("audiodevicesmusic");
   settings->GetSettingsManager()->UnregisterSettingOptionsFiller("audiostreamsilence");
   settings->GetSettingsManager()->UnregisterCallback(this);
   m_instance = nullptr;
@@ -93,6 +95,17 @@ void CActiveAESettings::SettingOptionsAudioDevicesPassthroughFiller(SettingConst
   SettingOptionsAudioDevicesFillerGeneral(setting, list, current, true);
 }
 
+void CActiveAESettings::SettingOptionsAudioDevicesMusicFiller(SettingConstPtr setting,
+                                                              std::vector<StringSettingOption> &list,
+                                                              std::string &current, void *data)
+{
+  // empty value plays music on the audio output device
+  list.emplace_back(g_localizeStrings.Get(39120), "");
+  SettingOptionsAudioDevicesFillerGeneral(setting, list, current, false);
+  if (std::static_pointer_cast<const CSettingString>(setting)->GetValue().empty())
+    current.clear();
+}
+
 void CActiveAESettings::SettingOptionsAudioQualityLevelsFiller(SettingConstPtr setting,
                                                                std::vector<IntegerSettingOption> &list,
                                                                int &current, void *data)
@@ -109,6 +122,8 @@ void CActiveAESettings::SettingOptionsAudioQualityLevelsFiller(SettingConstPtr s
     list.emplace_back(g_localizeStrings.Get(13509), AE_QUALITY_REALLYHIGH);
   if (m_instance->m_audioEngine.SupportsQualityLevel(AE_QUALITY_GPU))
     list.emplace_back(g_localizeStrings.Get(38010), AE_QUALITY_GPU);
+  if (m_instance->m_audioEngine.SupportsQualityLevel(AE_QUALITY_POLYPHASE))
+    list.emplace_back(g_localizeStrings.Get(39121), AE_QUALITY_POLYPHASE);
 }
 
 void CActiveAESettings::SettingOptionsAudioStreamsilenceFiller(SettingConstPtr setting,
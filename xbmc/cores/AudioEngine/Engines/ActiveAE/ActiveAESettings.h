@@ -39,6 +39,9 @@ public:
   static void SettingOptionsAudioDevicesPassthroughFiller(std::shared_ptr<const CSetting> setting,
                                                           std::vector<StringSettingOption> &list,
                                                           std::string &current, void *data);
+  static void SettingOptionsAudioDevicesMusicFiller(std::shared_ptr<const CSetting> setting,
+                                                    std::vector<StringSettingOption> &list,
+                                                    std::string &current, void *data);
   static void SettingOptionsAudioQualityLevelsFiller(std::shared_ptr<const CSetting> setting,
                                                      std::vector<IntegerSettingOption> &list, int &current, void *data);
   static void SettingOptionsAudioStreamsilenceFiller(std::shared_ptr<const CSetting> setting,
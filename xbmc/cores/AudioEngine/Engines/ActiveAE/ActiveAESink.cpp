@@ -9,12 +9,17 @@
 #include "ActiveAESink.h"
 
 #include "ActiveAE.h"
+#include "ServiceBroker.h"
 #include "cores/AudioEngine/AEResampleFactory.h"
 #include "cores/AudioEngine/Utils/AEBitstreamPacker.h"
 #include "cores/AudioEngine/Utils/AEStreamInfo.h"
 #include "cores/AudioEngine/Utils/AEUtil.h"
+#include "cores/DataCacheCore.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "utils/EndianSwap.h"
 #include "utils/MemUtils.h"
+#include "utils/TimeUtils.h"
 #include "utils/log.h"
 
 #include <algorithm>
@@ -597,6 +602,9 @@ void CActiveAESink::Process()
   m_bStateMachineSelfTrigger = false;
   m_extAppFocused = true;
 
+  if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioRealtime)
+    SetCurrentThreadRealtime();
+
   while (!m_bStop)
   {
     gotMsg = false;
@@ -892,6 +900,19 @@ unsigned int CActiveAESink::OutputSamples(CSampleBuffer* samples)
   uint8_t* p_mergebuffer = NULL;
   AEDelayStatus status;
 
+  // while playing the device must never run out of samples, even if it's silence
+  if ((m_state == S_TOP_CONFIGURED_PLAY || m_state == S_TOP_CONFIGURED_SILENCE) && m_lastDelay.tick)
+  {
+    double elapsed = static_cast<double>(CurrentHostCounter() - m_lastDelay.tick) / CurrentHostFrequency();
+    if (elapsed > m_lastDelay.delay)
+    {
+      CServiceBroker::GetDataCacheCore().AddAudioXRun();
+      CLog::Log(LOGDEBUG, LOGAUDIO, "CActiveAESink::OutputSamples - underrun of %d ms",
+                static_cast<int>((elapsed - m_lastDelay.delay) * 1000));
+    }
+  }
+  m_lastDelay = AEDelayStatus();
+
   if (m_requestedFormat.m_dataFormat == AE_FMT_RAW)
   {
     bool skipSwap = false;
@@ -980,6 +1001,7 @@ unsigned int CActiveAESink::OutputSamples(CSampleBuffer* samples)
       {
         m_sink->AddPause(samples->pkt->pause_burst_ms);
         m_sink->GetDelay(status);
+        m_lastDelay = status;
         m_stats->UpdateSinkDelay(status, samples->pool ? 1 : 0);
         return status.delay * 1000;
       }
@@ -1024,6 +1046,7 @@ unsigned int CActiveAESink::OutputSamples(CSampleBuffer* samples)
     frames -= written;
 
     m_sink->GetDelay(status);
+    m_lastDelay = status;
 
     if (m_requestedFormat.m_dataFormat != AE_FMT_RAW)
       m_stats->UpdateSinkDelay(status, samples->pool ? written : 0);
@@ -140,6 +140,7 @@ protected:
   CAEBitstreamPacker *m_packer;
   bool m_needIecPack;
   bool m_streamNoise;
+  AEDelayStatus m_lastDelay; // delay of the device after the last write, to detect underruns
 };
 
 }
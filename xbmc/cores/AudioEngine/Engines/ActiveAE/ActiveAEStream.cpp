@@ -529,13 +529,13 @@ void CActiveAEStream::SetFFmpegInfo(int profile, enum AVMatrixEncoding matrix_en
   m_activeAE->SetStreamFFmpegInfo(this, profile, matrix_encoding, audio_service_type);
 }
 
-void CActiveAEStream::FadeVolume(float from, float target, unsigned int time)
+void CActiveAEStream::FadeVolume(float from, float target, unsigned int time, bool constantPower)
 {
   if (time == 0 || (m_format.m_dataFormat == AE_FMT_RAW))
     return;
 
   m_streamFading = true;
-  m_activeAE->SetStreamFade(this, from, target, time);
+  m_activeAE->SetStreamFade(this, from, target, time, constantPower);
 }
 
 bool CActiveAEStream::IsFading()
@@ -585,6 +585,7 @@ void CActiveAEStream::RegisterSlave(IAEStream *slave)
 CActiveAEStreamBuffers::CActiveAEStreamBuffers(const AEAudioFormat& inputFormat, const AEAudioFormat& outputFormat, AEQuality quality)
 {
   m_inputFormat = inputFormat;
+  m_outputFormat = outputFormat;
   m_resampleBuffers = new CActiveAEBufferPoolResample(inputFormat, outputFormat, quality);
   m_atempoBuffers = new CActiveAEBufferPoolAtempo(outputFormat);
 }
@@ -115,6 +115,7 @@ public:
   CActiveAEBufferPool *GetAtempoBuffers();
 
   AEAudioFormat m_inputFormat;
+  AEAudioFormat m_outputFormat;
   std::deque<CSampleBuffer*> m_outputSamples;
   std::deque<CSampleBuffer*> m_inputSamples;
 
@@ -179,7 +180,7 @@ public:
   void SetResampleMode(int mode) override;
   void RegisterAudioCallback(IAudioCallback* pCallback) override;
   void UnRegisterAudioCallback() override;
-  void FadeVolume(float from, float to, unsigned int time) override;
+  void FadeVolume(float from, float to, unsigned int time, bool constantPower = false) override;
   bool IsFading() override;
   void RegisterSlave(IAEStream *stream) override;
 
@@ -230,6 +231,7 @@ protected:
   float m_fadingBase;
   float m_fadingTarget;
   int m_fadingTime;
+  bool m_fadingPower;
   int m_profile;
   int m_resampleMode;
   double m_resampleIntegral;
@@ -54,6 +54,7 @@ enum AEQuality
   AE_QUALITY_REALLYHIGH = 100, /* Uncompromised optional quality level,
                                usually with unmeasurable and unnoticeable improvement */
   AE_QUALITY_GPU        = 101, /* GPU acceleration */
+  AE_QUALITY_POLYPHASE  = 102, /* Fixed polyphase filter, cheap ratio changes for sync to display */
 };
 
 struct SampleConfig
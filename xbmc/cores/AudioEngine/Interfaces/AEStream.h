@@ -254,9 +254,11 @@ public:
     * @param from The volume level to fade from (0.0f-1.0f) - See notes
     * @param target The volume level to fade to (0.0f-1.0f)
     * @param time The amount of time in milliseconds for the fade to occur
+    * @param constantPower Follow a sine curve instead of a linear one, so that a stream fading in
+    *        from 0.0f and one fading out to 0.0f over the same time keep a constant total power
     * @note The from parameter does not set the streams volume, it is only used to calculate the fade time properly
     */
-  virtual void FadeVolume(float from, float target, unsigned int time) {} /* FIXME: once all the engines have these new methods */
+  virtual void FadeVolume(float from, float target, unsigned int time, bool constantPower = false) {} /* FIXME: once all the engines have these new methods */
 
   /**
    * Returns if a fade is still running
@@ -18,6 +18,17 @@ public:
   IAudioCallback() = default;
   virtual ~IAudioCallback() = default;
   virtual void OnInitialize(int iChannels, int iSamplesPerSec, int iBitsPerSample) = 0;
-  virtual void OnAudioData(const float* pAudioData, unsigned int iAudioDataLength) = 0;
+  /*!
+   \brief Audio data for visualization
+   \param pSpectrum magnitudes of the bins asked for by GetSpectrumBins(), interleaved by channel, nullptr if none
+   \param iSpectrumLength number of floats in pSpectrum
+   */
+  virtual void OnAudioData(const float* pAudioData, unsigned int iAudioDataLength, const float* pSpectrum, unsigned int iSpectrumLength) = 0;
+
+  /*!
+   \brief Bins per channel of the spectrum passed to OnAudioData, 0 for none
+   The engine transforms each block once for all callbacks asking for the same number of bins.
+   */
+  virtual unsigned int GetSpectrumBins() { return 0; }
 };
 
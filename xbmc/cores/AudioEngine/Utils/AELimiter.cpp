@@ -73,3 +73,10 @@ float CAELimiter::Run(float* frame[AE_CH_MAX], int channels, int offset /*= 0*/,
   return attenuation * m_amplify;
 }
 
+
+void CAELimiter::RunFrames(float* frame[AE_CH_MAX], int channels, int frames, bool planar, float* gains)
+{
+  const int stride = planar ? 1 : channels;
+  for (int i = 0; i < frames; i++)
+    gains[i] *= Run(frame, channels, i * stride, planar);
+}
@@ -40,4 +40,10 @@ class CAELimiter
     }
 
     float Run(float* frame[AE_CH_MAX], int channels, int offset = 0, bool planar = false);
+
+    /*!
+     \brief Run the limiter over consecutive frames
+     \param gains one gain per frame, multiplied by the gain of the limiter
+     */
+    void RunFrames(float* frame[AE_CH_MAX], int channels, int frames, bool planar, float* gains);
 };
@@ -12,13 +12,34 @@
 #include "AEUtil.h"
 #include "utils/log.h"
 #include "utils/TimeUtils.h"
+#if defined(HAS_NEON) && !defined(__LP64__)
+#include "utils/CPUInfo.h"
+#endif
 
 #include <cassert>
 
+#if defined(HAS_NEON)
+#include <arm_neon.h>
+#endif
+
 extern "C" {
 #include <libavutil/channel_layout.h>
 }
 
+namespace
+{
+#if defined(HAS_NEON)
+inline bool HasNeon()
+{
+#if defined(__LP64__)
+  return true;
+#else
+  return (g_cpuInfo.GetCPUFeatures() & CPU_FEATURE_NEON) == CPU_FEATURE_NEON;
+#endif
+}
+#endif
+}
+
 /* declare the rng seed and initialize it */
 unsigned int CAEUtil::m_seed = (unsigned int)(CurrentHostCounter() / 1000.0f);
 #if defined(HAVE_SSE2) && defined(__SSE2__)
@@ -358,12 +379,36 @@ inline float CAEUtil::SoftClamp(const float x)
 void CAEUtil::ClampArray(float *data, uint32_t count)
 {
 #if !defined(HAVE_SSE) || !defined(__SSE__)
-  for (uint32_t i = 0; i < count; ++i)
+  uint32_t i = 0;
+#if defined(HAS_NEON)
+  if (HasNeon())
+  {
+    const float32x4_t c1 = vdupq_n_f32(27.0f);
+    const float32x4_t c2 = vdupq_n_f32(27.0f + 9.0f);
+    const float32x4_t lo = vdupq_n_f32(-3.0f);
+    const float32x4_t hi = vdupq_n_f32(3.0f);
+    for (; i + 4 <= count; i += 4)
+    {
+      /* tanh approx clamp, limited to +-3 like SoftClamp */
+      float32x4_t dt = vminq_f32(vmaxq_f32(vld1q_f32(data + i), lo), hi);
+      float32x4_t tmp = vmulq_f32(dt, dt);
+      float32x4_t den = vaddq_f32(c2, tmp);
+      /* two newton steps make the reciprocal estimate exact to float precision */
+      float32x4_t rcp = vrecpeq_f32(den);
+      rcp = vmulq_f32(vrecpsq_f32(den, rcp), rcp);
+      rcp = vmulq_f32(vrecpsq_f32(den, rcp), rcp);
+      vst1q_f32(data + i, vmulq_f32(vmulq_f32(dt, vaddq_f32(c1, tmp)), rcp));
+    }
+  }
+#endif
+  for (; i < count; ++i)
     data[i] = SoftClamp(data[i]);
 
 #else
   const __m128 c1 = _mm_set_ps1(27.0f);
   const __m128 c2 = _mm_set_ps1(27.0f + 9.0f);
+  const __m128 lo = _mm_set_ps1(-3.0f);
+  const __m128 hi = _mm_set_ps1(3.0f);
 
   /* work around invalid alignment */
   while (((uintptr_t)data & 0xF) && count > 0)
@@ -376,8 +421,8 @@ void CAEUtil::ClampArray(float *data, uint32_t count)
   uint32_t even = count & ~0x3;
   for (uint32_t i = 0; i < even; i+=4, data+=4)
   {
-    /* tanh approx clamp */
-    __m128 dt = _mm_load_ps(data);
+    /* tanh approx clamp, limited to +-3 like SoftClamp */
+    __m128 dt = _mm_min_ps(_mm_max_ps(_mm_load_ps(data), lo), hi);
     __m128 tmp     = _mm_mul_ps(dt, dt);
     *(__m128*)data = _mm_div_ps(
       _mm_mul_ps(
@@ -401,7 +446,7 @@ void CAEUtil::ClampArray(float *data, uint32_t count)
       if (odd == 2)
       {
         /* tanh approx clamp */
-        dt  = _mm_setr_ps(data[0], data[1], 0, 0);
+        dt  = _mm_min_ps(_mm_max_ps(_mm_setr_ps(data[0], data[1], 0, 0), lo), hi);
         tmp = _mm_mul_ps(dt, dt);
         out = _mm_div_ps(
           _mm_mul_ps(
@@ -417,7 +462,7 @@ void CAEUtil::ClampArray(float *data, uint32_t count)
       else
       {
         /* tanh approx clamp */
-        dt  = _mm_setr_ps(data[0], data[1], data[2], 0);
+        dt  = _mm_min_ps(_mm_max_ps(_mm_setr_ps(data[0], data[1], data[2], 0), lo), hi);
         tmp = _mm_mul_ps(dt, dt);
         out = _mm_div_ps(
           _mm_mul_ps(
@@ -436,6 +481,218 @@ void CAEUtil::ClampArray(float *data, uint32_t count)
 #endif
 }
 
+void CAEUtil::MulArray(float *data, const float mul, uint32_t count)
+{
+#if defined(HAVE_SSE) && defined(__SSE__)
+  SSEMulArray(data, mul, count);
+#else
+  uint32_t i = 0;
+#if defined(HAS_NEON)
+  if (HasNeon())
+  {
+    const float32x4_t m = vdupq_n_f32(mul);
+    for (; i + 4 <= count; i += 4)
+      vst1q_f32(data + i, vmulq_f32(vld1q_f32(data + i), m));
+  }
+#endif
+  for (; i < count; ++i)
+    data[i] *= mul;
+#endif
+}
+
+void CAEUtil::MulAddArray(float *data, const float *add, const float mul, uint32_t count)
+{
+#if defined(HAVE_SSE) && defined(__SSE__)
+  SSEMulAddArray(data, const_cast<float*>(add), mul, count);
+#else
+  uint32_t i = 0;
+#if defined(HAS_NEON)
+  if (HasNeon())
+  {
+    const float32x4_t m = vdupq_n_f32(mul);
+    for (; i + 4 <= count; i += 4)
+      vst1q_f32(data + i, vmlaq_f32(vld1q_f32(data + i), vld1q_f32(add + i), m));
+  }
+#endif
+  for (; i < count; ++i)
+    data[i] += add[i] * mul;
+#endif
+}
+
+void CAEUtil::MulFrames(float *data, const float *gains, uint32_t frames, uint32_t channels)
+{
+  if (frames == 1)
+  {
+    MulArray(data, gains[0], channels);
+    return;
+  }
+
+#if defined(HAS_NEON)
+  const bool neon = HasNeon();
+#endif
+  uint32_t i = 0;
+  if (channels == 1)
+  {
+    /* a plane of planar samples, one gain per sample */
+#if defined(HAVE_SSE) && defined(__SSE__)
+    for (; i + 4 <= frames; i += 4)
+      _mm_storeu_ps(data + i, _mm_mul_ps(_mm_loadu_ps(data + i), _mm_loadu_ps(gains + i)));
+#elif defined(HAS_NEON)
+    if (neon)
+    {
+      for (; i + 4 <= frames; i += 4)
+        vst1q_f32(data + i, vmulq_f32(vld1q_f32(data + i), vld1q_f32(gains + i)));
+    }
+#endif
+    for (; i < frames; ++i)
+      data[i] *= gains[i];
+    return;
+  }
+
+  for (; i < frames; ++i, data += channels)
+  {
+    const float gain = gains[i];
+    uint32_t c = 0;
+#if defined(HAVE_SSE) && defined(__SSE__)
+    const __m128 g = _mm_set_ps1(gain);
+    for (; c + 4 <= channels; c += 4)
+      _mm_storeu_ps(data + c, _mm_mul_ps(_mm_loadu_ps(data + c), g));
+#elif defined(HAS_NEON)
+    if (neon)
+    {
+      const float32x4_t g = vdupq_n_f32(gain);
+      for (; c + 4 <= channels; c += 4)
+        vst1q_f32(data + c, vmulq_f32(vld1q_f32(data + c), g));
+    }
+#endif
+    for (; c < channels; ++c)
+      data[c] *= gain;
+  }
+}
+
+void CAEUtil::MulAddFrames(float *data, const float *add, const float *gains, uint32_t frames, uint32_t channels)
+{
+  if (frames == 1)
+  {
+    MulAddArray(data, add, gains[0], channels);
+    return;
+  }
+
+#if defined(HAS_NEON)
+  const bool neon = HasNeon();
+#endif
+  uint32_t i = 0;
+  if (channels == 1)
+  {
+    /* a plane of planar samples, one gain per sample */
+#if defined(HAVE_SSE) && defined(__SSE__)
+    for (; i + 4 <= frames; i += 4)
+      _mm_storeu_ps(data + i, _mm_add_ps(_mm_loadu_ps(data + i), _mm_mul_ps(_mm_loadu_ps(add + i), _mm_loadu_ps(gains + i))));
+#elif defined(HAS_NEON)
+    if (neon)
+    {
+      for (; i + 4 <= frames; i += 4)
+        vst1q_f32(data + i, vmlaq_f32(vld1q_f32(data + i), vld1q_f32(add + i), vld1q_f32(gains + i)));
+    }
+#endif
+    for (; i < frames; ++i)
+      data[i] += add[i] * gains[i];
+    return;
+  }
+
+  for (; i < frames; ++i, data += channels, add += channels)
+  {
+    const float gain = gains[i];
+    uint32_t c = 0;
+#if defined(HAVE_SSE) && defined(__SSE__)
+    const __m128 g = _mm_set_ps1(gain);
+    for (; c + 4 <= channels; c += 4)
+      _mm_storeu_ps(data + c, _mm_add_ps(_mm_loadu_ps(data + c), _mm_mul_ps(_mm_loadu_ps(add + c), g)));
+#elif defined(HAS_NEON)
+    if (neon)
+    {
+      const float32x4_t g = vdupq_n_f32(gain);
+      for (; c + 4 <= channels; c += 4)
+        vst1q_f32(data + c, vmlaq_f32(vld1q_f32(data + c), vld1q_f32(add + c), g));
+    }
+#endif
+    for (; c < channels; ++c)
+      data[c] += add[c] * gain;
+  }
+}
+
+void CAEUtil::MulAddArrays(float *data, const float* const *adds, const float *muls, uint32_t sources, uint32_t count)
+{
+  if (sources == 1)
+  {
+    MulAddArray(data, adds[0], muls[0], count);
+    return;
+  }
+
+  uint32_t i = 0;
+#if defined(HAVE_SSE) && defined(__SSE__)
+  for (; i + 4 <= count; i += 4)
+  {
+    __m128 sum = _mm_loadu_ps(data + i);
+    for (uint32_t s = 0; s < sources; ++s)
+      sum = _mm_add_ps(sum, _mm_mul_ps(_mm_loadu_ps(adds[s] + i), _mm_set_ps1(muls[s])));
+    _mm_storeu_ps(data + i, sum);
+  }
+#elif defined(HAS_NEON)
+  if (HasNeon())
+  {
+    for (; i + 4 <= count; i += 4)
+    {
+      float32x4_t sum = vld1q_f32(data + i);
+      for (uint32_t s = 0; s < sources; ++s)
+        sum = vmlaq_n_f32(sum, vld1q_f32(adds[s] + i), muls[s]);
+      vst1q_f32(data + i, sum);
+    }
+  }
+#endif
+  for (; i < count; ++i)
+  {
+    float sum = data[i];
+    for (uint32_t s = 0; s < sources; ++s)
+      sum += adds[s][i] * muls[s];
+    data[i] = sum;
+  }
+}
+
+bool CAEUtil::NeedsClamp(const float *data, uint32_t count)
+{
+  uint32_t i = 0;
+#if defined(HAVE_SSE) && defined(__SSE__)
+  const __m128 hi = _mm_set_ps1(1.0f);
+  const __m128 lo = _mm_set_ps1(-1.0f);
+  __m128 outside = _mm_setzero_ps();
+  for (; i + 4 <= count; i += 4)
+  {
+    const __m128 dt = _mm_loadu_ps(data + i);
+    outside = _mm_or_ps(outside, _mm_or_ps(_mm_cmpgt_ps(dt, hi), _mm_cmplt_ps(dt, lo)));
+  }
+  if (_mm_movemask_ps(outside))
+    return true;
+#elif defined(HAS_NEON)
+  if (HasNeon())
+  {
+    const float32x4_t one = vdupq_n_f32(1.0f);
+    uint32x4_t outside = vdupq_n_u32(0);
+    for (; i + 4 <= count; i += 4)
+      outside = vorrq_u32(outside, vcagtq_f32(vld1q_f32(data + i), one));
+    const uint32x2_t any = vorr_u32(vget_low_u32(outside), vget_high_u32(outside));
+    if (vget_lane_u32(any, 0) | vget_lane_u32(any, 1))
+      return true;
+  }
+#endif
+  for (; i < count; ++i)
+  {
+    if (fabs(data[i]) > 1.0f)
+      return true;
+  }
+  return false;
+}
+
 bool CAEUtil::S16NeedsByteSwap(AEDataFormat in, AEDataFormat out)
 {
   const AEDataFormat nativeFormat =
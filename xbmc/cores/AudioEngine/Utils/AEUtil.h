@@ -186,6 +186,33 @@ public:
   #endif
   static void ClampArray(float *data, uint32_t count);
 
+  /*! \brief data[i] *= mul, uses SSE or NEON if available */
+  static void MulArray(float *data, const float mul, uint32_t count);
+
+  /*! \brief data[i] += add[i] * mul, uses SSE or NEON if available */
+  static void MulAddArray(float *data, const float *add, const float mul, uint32_t count);
+
+  /*! \brief Scale each frame of the samples by its own gain
+   \param data the samples, frames * channels of them
+   \param gains one gain per frame
+   \param channels the samples per frame, 1 for a plane of planar samples
+   */
+  static void MulFrames(float *data, const float *gains, uint32_t frames, uint32_t channels);
+
+  /*! \brief Add the samples, each frame of them scaled by its own gain
+   \sa MulFrames
+   */
+  static void MulAddFrames(float *data, const float *add, const float *gains, uint32_t frames, uint32_t channels);
+
+  /*! \brief data[i] += adds[s][i] * muls[s] for all sources in a single pass over data
+   \param adds the sources, each of them count samples
+   \param muls one gain per source
+   */
+  static void MulAddArrays(float *data, const float* const *adds, const float *muls, uint32_t sources, uint32_t count);
+
+  /*! \brief Whether any of the samples is outside of [-1, 1] */
+  static bool NeedsClamp(const float *data, uint32_t count);
+
   static bool S16NeedsByteSwap(AEDataFormat in, AEDataFormat out);
 
   static uint64_t GetAVChannelLayout(const CAEChannelInfo &info);
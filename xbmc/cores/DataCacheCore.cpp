@@ -12,6 +12,8 @@
 #include "cores/Cut.h"
 #include "threads/SingleLock.h"
 
+constexpr std::array<int, 7> SRenderTelemetryInfo::TIME_BOUNDS;
+
 CDataCacheCore::CDataCacheCore() :
   m_playerVideoInfo {},
   m_playerAudioInfo {},
@@ -37,6 +39,7 @@ void CDataCacheCore::Reset()
     m_stateInfo.m_speed = 1.0;
     m_stateInfo.m_tempo = 1.0;
     m_stateInfo.m_stateSeeking = false;
+    m_stateInfo.m_startupTime = 0;
     m_stateInfo.m_renderGuiLayer = false;
     m_stateInfo.m_renderVideoLayer = false;
     m_playerStateChanged = false;
@@ -48,6 +51,12 @@ void CDataCacheCore::Reset()
     m_contentInfo.m_chapters.clear();
     m_contentInfo.m_cutList.clear();
   }
+
+  {
+    CSingleLock lock(m_renderSection);
+
+    m_renderInfo.m_telemetry = SRenderTelemetryInfo();
+  }
 }
 
 bool CDataCacheCore::HasAVInfoChanges()
@@ -187,6 +196,36 @@ float CDataCacheCore::GetVideoDAR()
   return m_playerVideoInfo.dar;
 }
 
+void CDataCacheCore::SetVideoDecoderThreading(std::string mode, int threads, int latency)
+{
+  CSingleLock lock(m_videoPlayerSection);
+
+  m_playerVideoInfo.threadingMode = mode;
+  m_playerVideoInfo.decoderThreads = threads;
+  m_playerVideoInfo.decoderLatency = latency;
+}
+
+std::string CDataCacheCore::GetVideoDecoderThreadingMode()
+{
+  CSingleLock lock(m_videoPlayerSection);
+
+  return m_playerVideoInfo.threadingMode;
+}
+
+int CDataCacheCore::GetVideoDecoderThreads()
+{
+  CSingleLock lock(m_videoPlayerSection);
+
+  return m_playerVideoInfo.decoderThreads;
+}
+
+int CDataCacheCore::GetVideoDecoderLatency()
+{
+  CSingleLock lock(m_videoPlayerSection);
+
+  return m_playerVideoInfo.decoderLatency;
+}
+
 // player audio info
 void CDataCacheCore::SetAudioDecoderName(std::string name)
 {
@@ -244,6 +283,16 @@ int CDataCacheCore::GetAudioBitsPerSample()
   return m_playerAudioInfo.bitsPerSample;
 }
 
+void CDataCacheCore::AddAudioXRun()
+{
+  m_audioXRuns++;
+}
+
+uint64_t CDataCacheCore::GetAudioXRuns() const
+{
+  return m_audioXRuns;
+}
+
 void CDataCacheCore::SetCutList(const std::vector<EDL::Cut>& cutList)
 {
   CSingleLock lock(m_contentSection);
@@ -268,6 +317,20 @@ std::vector<std::pair<std::string, int64_t>> CDataCacheCore::GetChapters() const
   return m_contentInfo.m_chapters;
 }
 
+void CDataCacheCore::SetDemuxPacketPoolInfo(const SDemuxPacketPoolInfo& info)
+{
+  CSingleLock lock(m_demuxerSection);
+
+  m_demuxPacketPoolInfo = info;
+}
+
+SDemuxPacketPoolInfo CDataCacheCore::GetDemuxPacketPoolInfo()
+{
+  CSingleLock lock(m_demuxerSection);
+
+  return m_demuxPacketPoolInfo;
+}
+
 void CDataCacheCore::SetRenderClockSync(bool enable)
 {
   CSingleLock lock(m_renderSection);
@@ -282,6 +345,20 @@ bool CDataCacheCore::IsRenderClockSync()
   return m_renderInfo.m_isClockSync;
 }
 
+void CDataCacheCore::SetRenderTelemetryInfo(const SRenderTelemetryInfo& info)
+{
+  CSingleLock lock(m_renderSection);
+
+  m_renderInfo.m_telemetry = info;
+}
+
+SRenderTelemetryInfo CDataCacheCore::GetRenderTelemetryInfo()
+{
+  CSingleLock lock(m_renderSection);
+
+  return m_renderInfo.m_telemetry;
+}
+
 // player states
 void CDataCacheCore::SetStateSeeking(bool active)
 {
@@ -298,6 +375,20 @@ bool CDataCacheCore::IsSeeking()
   return m_stateInfo.m_stateSeeking;
 }
 
+void CDataCacheCore::SetStartupTime(int ms)
+{
+  CSingleLock lock(m_stateSection);
+
+  m_stateInfo.m_startupTime = ms;
+}
+
+int CDataCacheCore::GetStartupTime()
+{
+  CSingleLock lock(m_stateSection);
+
+  return m_stateInfo.m_startupTime;
+}
+
 void CDataCacheCore::SetSpeed(float tempo, float speed)
 {
   CSingleLock lock(m_stateSection);
@@ -10,6 +10,7 @@
 
 #include "threads/CriticalSection.h"
 
+#include <array>
 #include <atomic>
 #include <string>
 #include <vector>
@@ -19,6 +20,32 @@ namespace EDL
   struct Cut;
 }
 
+struct SDemuxPacketPoolInfo
+{
+  uint64_t allocations = 0;
+  uint64_t hits = 0;
+  uint64_t cachedBytes = 0;
+  uint64_t usedBytes = 0;
+};
+
+struct SRenderTelemetryInfo
+{
+  //! upper bounds of the time histogram bins in ms, the last bin takes everything above
+  static constexpr std::array<int, 7> TIME_BOUNDS = {{1, 2, 4, 8, 16, 32, 64}};
+  using Histogram = std::array<uint64_t, TIME_BOUNDS.size() + 1>;
+
+  uint64_t frames = 0; //!< frames that made it to the screen
+  uint64_t skipped = 0; //!< frames dropped from the queue because they were late
+  uint64_t missedVsyncs = 0; //!< vblanks missed while those frames were shown
+  Histogram uploadTime = {}; //!< from handing the picture to the renderer until it is queued
+  Histogram queueTime = {}; //!< from queued until picked for presentation
+  Histogram presentTime = {}; //!< from picked until the first render of the frame
+  std::array<uint64_t, 8> queueDepth = {}; //!< frames left in the queue when one was picked
+  double uploadTimeTotal = 0.0; //!< sum over all frames, in ms
+  double queueTimeTotal = 0.0;
+  double presentTimeTotal = 0.0;
+};
+
 class CDataCacheCore
 {
 public:
@@ -48,6 +75,10 @@ public:
   float GetVideoFps();
   void SetVideoDAR(float dar);
   float GetVideoDAR();
+  void SetVideoDecoderThreading(std::string mode, int threads, int latency);
+  std::string GetVideoDecoderThreadingMode();
+  int GetVideoDecoderThreads();
+  int GetVideoDecoderLatency();
 
   // player audio info
   void SetAudioDecoderName(std::string name);
@@ -59,19 +90,40 @@ public:
   void SetAudioBitsPerSample(int bitsPerSample);
   int GetAudioBitsPerSample();
 
+  // audio output info
+  /*!
+   * \brief Count a buffer underrun of the audio output
+   */
+  void AddAudioXRun();
+  /*!
+   * \brief Number of times the audio output ran dry since startup
+   */
+  uint64_t GetAudioXRuns() const;
+
   // content info
   void SetCutList(const std::vector<EDL::Cut>& cutList);
   std::vector<EDL::Cut> GetCutList() const;
   void SetChapters(const std::vector<std::pair<std::string, int64_t>>& chapters);
   std::vector<std::pair<std::string, int64_t>> GetChapters() const;
 
+  // demuxer info
+  void SetDemuxPacketPoolInfo(const SDemuxPacketPoolInfo& info);
+  SDemuxPacketPoolInfo GetDemuxPacketPoolInfo();
+
   // render info
   void SetRenderClockSync(bool enabled);
   bool IsRenderClockSync();
+  void SetRenderTelemetryInfo(const SRenderTelemetryInfo& info);
+  SRenderTelemetryInfo GetRenderTelemetryInfo();
 
   // player states
   void SetStateSeeking(bool active);
   bool IsSeeking();
+  void SetStartupTime(int ms);
+  /*!
+   * \brief Time in ms from opening the item until the first picture was shown, e.g. the zap time of a channel
+   */
+  int GetStartupTime();
   void SetSpeed(float tempo, float speed);
   float GetSpeed();
   float GetTempo();
@@ -141,6 +193,9 @@ protected:
     int height;
     float fps;
     float dar;
+    std::string threadingMode;
+    int decoderThreads;
+    int decoderLatency; // frames held back by the decoder
   } m_playerVideoInfo;
 
   CCriticalSection m_audioPlayerSection;
@@ -152,6 +207,8 @@ protected:
     int bitsPerSample;
   } m_playerAudioInfo;
 
+  std::atomic<uint64_t> m_audioXRuns{0};
+
   mutable CCriticalSection m_contentSection;
   struct SContentInfo
   {
@@ -159,10 +216,14 @@ protected:
     std::vector<std::pair<std::string, int64_t>> m_chapters; // name and position for chapters
   } m_contentInfo;
 
+  CCriticalSection m_demuxerSection;
+  SDemuxPacketPoolInfo m_demuxPacketPoolInfo;
+
   CCriticalSection m_renderSection;
   struct SRenderInfo
   {
     bool m_isClockSync;
+    SRenderTelemetryInfo m_telemetry;
   } m_renderInfo;
 
   CCriticalSection m_stateSection;
@@ -175,6 +236,7 @@ protected:
     float m_tempo;
     float m_speed;
     bool m_frameAdvance;
+    int m_startupTime;
   } m_stateInfo;
 
   struct STimeInfo
@@ -23,7 +23,6 @@
 #include "cores/RetroPlayer/playback/ReversiblePlayback.h"
 #include "cores/RetroPlayer/process/RPProcessInfo.h"
 #include "cores/RetroPlayer/rendering/RPRenderManager.h"
-#include "cores/RetroPlayer/savestates/ISavestate.h"
 #include "cores/RetroPlayer/savestates/SavestateDatabase.h"
 #include "cores/RetroPlayer/streams/RPStreamManager.h"
 #include "dialogs/GUIDialogYesNo.h"
@@ -41,6 +40,8 @@
 #include "input/actions/ActionIDs.h"
 #include "messaging/ApplicationMessenger.h"
 #include "settings/MediaSettings.h"
+#include "settings/Settings.h"
+#include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
 #include "utils/JobManager.h"
 #include "utils/MathUtils.h"
@@ -48,10 +49,14 @@
 #include "utils/log.h"
 #include "windowing/WinSystem.h"
 
+#include <cmath>
+
 using namespace KODI;
 using namespace GAME;
 using namespace RETRO;
 
+#define MAX_DISPLAY_RATE_DEVIATION  0.02 // Audio is resampled by up to 2% to match the display
+
 CRetroPlayer::CRetroPlayer(IPlayerCallback& callback) :
   IPlayer(callback),
   m_gameServices(CServiceBroker::GetGameServices())
@@ -147,14 +152,14 @@ bool CRetroPlayer::OpenFile(const CFileItem& file, const CPlayerOptions& options
   {
     CSavestateDatabase savestateDb;
 
-    std::unique_ptr<ISavestate> save = savestateDb.CreateSavestate();
-    if (savestateDb.GetSavestate(fileCopy.GetPath(), *save))
+    SavestateInfo saveInfo;
+    if (savestateDb.GetSavestateInfo(fileCopy.GetPath(), saveInfo))
     {
       // Check if game client is the same
-      if (save->GameClientID() != m_gameClient->ID())
+      if (saveInfo.gameClientId != m_gameClient->ID())
       {
         ADDON::AddonPtr addon;
-        if (CServiceBroker::GetAddonMgr().GetAddon(save->GameClientID(), addon))
+        if (CServiceBroker::GetAddonMgr().GetAddon(saveInfo.gameClientId, addon))
         {
           // Warn the user that continuing with a different game client will
           // overwrite the save
@@ -214,6 +219,9 @@ bool CRetroPlayer::CloseFile(bool reopen /* = false */)
       CLog::Log(LOGDEBUG, "RetroPlayer[SAVE]: Saved state to %s", CURL::GetRedacted(savePath).c_str());
     else
       CLog::Log(LOGDEBUG, "RetroPlayer[SAVE]: Failed to save state at close");
+
+    // Don't leave the final save to a job that may not run before exiting
+    CSavestateDatabase::FlushSavestates();
   }
 
   m_playback.reset();
@@ -540,7 +548,8 @@ void CRetroPlayer::SetSpeedInternal(double speed)
 
 void CRetroPlayer::OnSpeedChange(double newSpeed)
 {
-  m_streamManager->EnableAudio(newSpeed == 1.0);
+  // Fast-forward keeps the audio of the frames it presents
+  m_streamManager->EnableAudio(newSpeed >= 1.0);
   m_input->SetSpeed(newSpeed);
   m_renderManager->SetSpeed(newSpeed);
   m_processInfo->SetSpeed(static_cast<float>(newSpeed));
@@ -551,7 +560,9 @@ void CRetroPlayer::CreatePlayback(bool bRestoreState)
   if (m_gameClient->RequiresGameLoop())
   {
     m_playback->Deinitialize();
-    m_playback.reset(new CReversiblePlayback(m_gameClient.get(), m_gameClient->GetFrameRate(), m_gameClient->GetSerializeSize()));
+    const double fps = GetPlaybackFrameRate();
+    m_streamManager->SetPlaybackRatio(fps / m_gameClient->GetFrameRate());
+    m_playback.reset(new CReversiblePlayback(m_gameClient.get(), fps, m_gameClient->GetSerializeSize()));
   }
   else
     ResetPlayback();
@@ -571,6 +582,25 @@ void CRetroPlayer::CreatePlayback(bool bRestoreState)
   m_playback->Initialize();
 }
 
+double CRetroPlayer::GetPlaybackFrameRate() const
+{
+  const double gameFps = m_gameClient->GetFrameRate();
+
+  if (gameFps > 0.0 &&
+      CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_VIDEOPLAYER_USEDISPLAYASCLOCK))
+  {
+    const double displayFps = CServiceBroker::GetWinSystem()->GetGfxContext().GetFPS();
+    if (displayFps > 0.0 && std::abs(displayFps / gameFps - 1.0) <= MAX_DISPLAY_RATE_DEVIATION)
+    {
+      CLog::Log(LOGDEBUG, "RetroPlayer[PLAYER]: Running game at display rate of %.3f fps (game rate %.3f fps)",
+                displayFps, gameFps);
+      return displayFps;
+    }
+  }
+
+  return gameFps;
+}
+
 void CRetroPlayer::ResetPlayback()
 {
   // Called from the constructor, m_playback might not be initialized
@@ -92,6 +92,14 @@ namespace RETRO
     void CreatePlayback(bool bRestoreState);
     void ResetPlayback();
 
+    /*!
+     * \brief Get the rate to run the game loop at
+     *
+     * When syncing to the display, a game whose frame rate is close to the
+     * refresh rate runs at the refresh rate.
+     */
+    double GetPlaybackFrameRate() const;
+
     /*!
      * \brief Opens the OSD
      */
@@ -8,12 +8,14 @@
 
 #include "RenderBufferOpenGL.h"
 
+#include "ServiceBroker.h"
 #include "cores/RetroPlayer/rendering/RenderContext.h"
+#include "rendering/RenderSystem.h"
+#include "utils/log.h"
 
 using namespace KODI;
 using namespace RETRO;
 
-
 CRenderBufferOpenGL::CRenderBufferOpenGL(GLuint pixeltype,
                                          GLuint internalformat,
                                          GLuint pixelformat,
@@ -27,9 +29,20 @@ CRenderBufferOpenGL::CRenderBufferOpenGL(GLuint pixeltype,
 
 CRenderBufferOpenGL::~CRenderBufferOpenGL()
 {
+  DeletePixelBuffer();
   DeleteTexture();
 }
 
+uint8_t *CRenderBufferOpenGL::GetMemory()
+{
+  // After the first upload, frames are written straight into the mapped
+  // pixel buffer object
+  if (m_pboMemory != nullptr)
+    return m_pboMemory;
+
+  return CRenderBufferSysMem::GetMemory();
+}
+
 void CRenderBufferOpenGL::CreateTexture()
 {
   glGenTextures(1, &m_textureId);
@@ -59,16 +72,76 @@ bool CRenderBufferOpenGL::UploadTexture()
 
   glPixelStorei(GL_UNPACK_ROW_LENGTH, stride / m_bpp);
 
-  //! @todo This is subject to change:
-  //! We want to use PBO's instead of glTexSubImage2D!
-  //! This code has been borrowed from OpenGL ES in order
-  //! to remove GL dependencies on GLES.
-  glTexSubImage2D(m_textureTarget, 0, 0, 0, m_width, m_height, m_pixelformat, m_pixeltype, m_data.data());
+  if (m_pboMemory != nullptr)
+  {
+    // The texture is filled from the pixel buffer object by the GPU
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pboId);
+    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    m_pboMemory = nullptr;
+
+    glTexSubImage2D(m_textureTarget, 0, 0, 0, m_width, m_height, m_pixelformat, m_pixeltype, nullptr);
+    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+  }
+  else
+  {
+    glTexSubImage2D(m_textureTarget, 0, 0, 0, m_width, m_height, m_pixelformat, m_pixeltype, m_data.data());
+  }
+
   glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
 
+  MapPixelBuffer();
+
   return true;
 }
 
+void CRenderBufferOpenGL::MapPixelBuffer()
+{
+  if (m_bPboFailed)
+    return;
+
+  if (m_pboId == 0)
+  {
+    if (!CServiceBroker::GetRenderSystem()->IsExtSupported("GL_ARB_pixel_buffer_object"))
+    {
+      m_bPboFailed = true;
+      return;
+    }
+
+    glGenBuffers(1, &m_pboId);
+  }
+
+  // Reallocating the storage orphans the one still being uploaded from, so
+  // the mapping doesn't wait for the GPU
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pboId);
+  glBufferData(GL_PIXEL_UNPACK_BUFFER, m_data.size(), nullptr, GL_STREAM_DRAW);
+  m_pboMemory = static_cast<uint8_t*>(glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY));
+  glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+  if (m_pboMemory == nullptr)
+  {
+    CLog::Log(LOGWARNING, "RetroPlayer[RENDER]: Failed to map pixel buffer object, using system memory");
+    DeletePixelBuffer();
+    m_bPboFailed = true;
+  }
+}
+
+void CRenderBufferOpenGL::DeletePixelBuffer()
+{
+  if (m_pboId != 0)
+  {
+    if (m_pboMemory != nullptr)
+    {
+      glBindBuffer(GL_PIXEL_UNPACK_BUFFER, m_pboId);
+      glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+      glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+    }
+    glDeleteBuffers(1, &m_pboId);
+  }
+
+  m_pboId = 0;
+  m_pboMemory = nullptr;
+}
+
 void CRenderBufferOpenGL::DeleteTexture()
 {
   if (glIsTexture(m_textureId))
@@ -27,6 +27,8 @@ namespace RETRO
                         GLuint bpp);
     ~CRenderBufferOpenGL() override;
 
+    // implementation of IRenderBuffer via CRenderBufferSysMem
+    uint8_t *GetMemory() override;
     bool UploadTexture() override;
     GLuint TextureID() const { return m_textureId; }
 
@@ -40,8 +42,15 @@ namespace RETRO
     const GLenum m_textureTarget = GL_TEXTURE_2D; //! @todo
     GLuint m_textureId = 0;
 
+    // Pixel buffer object the next frame is written to
+    GLuint m_pboId = 0;
+    uint8_t *m_pboMemory = nullptr;
+    bool m_bPboFailed = false;
+
     void CreateTexture();
     void DeleteTexture();
+    void MapPixelBuffer();
+    void DeletePixelBuffer();
   };
 }
 }
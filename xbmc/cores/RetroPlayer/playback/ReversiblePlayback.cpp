@@ -25,6 +25,8 @@ using namespace KODI;
 using namespace RETRO;
 
 #define REWIND_FACTOR  0.25  // Rewind at 25% of gameplay speed
+#define REWIND_MAX_BUFFER_SIZE  (512 * 1024 * 1024)  // Memory the rewind buffer may use
+#define REWIND_KEYFRAME_INTERVAL_SEC  10  // Full copy of the state every 10 seconds
 
 CReversiblePlayback::CReversiblePlayback(GAME::CGameClient* gameClient, double fps, size_t serializeSize) :
   m_gameClient(gameClient),
@@ -38,6 +40,7 @@ CReversiblePlayback::CReversiblePlayback(GAME::CGameClient* gameClient, double f
   m_cacheTimeMs(0)
 {
   UpdateMemoryStream();
+  UpdateRunAhead();
 
   GAME::CGameSettings &gameSettings = CServiceBroker::GetGameServices().GameSettings();
   gameSettings.RegisterObserver(this);
@@ -198,7 +201,75 @@ bool CReversiblePlayback::LoadSavestate(const std::string& path)
 
 void CReversiblePlayback::FrameEvent()
 {
+  const double speedFactor = m_gameLoop.GetSpeed();
+  if (speedFactor > 1.0)
+  {
+    FastForward(speedFactor);
+    return;
+  }
+
+  {
+    CSingleLock lock(m_mutex);
+    if (m_runAheadFrames > 0)
+    {
+      RunAhead();
+      return;
+    }
+  }
+
+  m_gameClient->RunFrame();
+
+  AddFrame();
+}
+
+void CReversiblePlayback::RunAhead()
+{
+  // The real frame produces the audio, its video would be a frame behind
+  m_gameClient->SetStreamsMuted(false, true);
+  m_gameClient->RunFrame();
+  AddFrame();
+
+  // Keep the state of the real frame, the rewind buffer already has it
+  const uint8_t* state = nullptr;
+  if (m_memoryStream && m_memoryStream->CurrentFrame() != nullptr)
+  {
+    state = m_memoryStream->CurrentFrame();
+  }
+  else if (m_gameClient->Serialize(m_runAheadState.data(), m_runAheadState.size()))
+  {
+    state = m_runAheadState.data();
+  }
+
+  if (state != nullptr)
+  {
+    // Only the video of the last frame ahead is shown, the input of the real
+    // frame applies to all of them
+    for (unsigned int i = 1; i <= m_runAheadFrames; i++)
+    {
+      m_gameClient->SetStreamsMuted(true, i < m_runAheadFrames);
+      m_gameClient->RunFrame();
+    }
+
+    m_gameClient->Deserialize(state, m_gameClient->SerializeSize());
+  }
+
+  m_gameClient->SetStreamsMuted(false, false);
+}
+
+void CReversiblePlayback::FastForward(double speedFactor)
+{
+  // Only present one frame per frame period at normal speed, so rendering and
+  // mixing don't limit the speed. The audio of the presented frames plays at
+  // normal rate, which decimates the audio of the skipped ones.
+  m_fastForwardPosition += 1.0 / speedFactor;
+
+  const bool bPresent = (m_fastForwardPosition >= 1.0);
+  if (bPresent)
+    m_fastForwardPosition -= 1.0;
+
+  m_gameClient->SetStreamsMuted(!bPresent, !bPresent);
   m_gameClient->RunFrame();
+  m_gameClient->SetStreamsMuted(false, false);
 
   AddFrame();
 }
@@ -274,12 +345,30 @@ void CReversiblePlayback::Notify(const Observable &obs, const ObservableMessage
   {
   case ObservableMessageSettingsChanged:
     UpdateMemoryStream();
+    UpdateRunAhead();
     break;
   default:
     break;
   }
 }
 
+void CReversiblePlayback::UpdateRunAhead()
+{
+  CSingleLock lock(m_mutex);
+
+  GAME::CGameSettings &gameSettings = CServiceBroker::GetGameServices().GameSettings();
+
+  // Running ahead restores the state after every frame
+  m_runAheadFrames = 0;
+  if (m_gameClient->SerializeSize() > 0)
+    m_runAheadFrames = gameSettings.RunAheadFrames();
+
+  if (m_runAheadFrames > 0)
+    m_runAheadState.resize(m_gameClient->SerializeSize());
+  else
+    m_runAheadState.clear();
+}
+
 void CReversiblePlayback::UpdateMemoryStream()
 {
   CSingleLock lock(m_mutex);
@@ -301,7 +390,8 @@ void CReversiblePlayback::UpdateMemoryStream()
 
     if (!m_memoryStream)
     {
-      m_memoryStream.reset(new CDeltaPairMemoryStream);
+      const uint64_t keyframeInterval = MathUtils::round_int(REWIND_KEYFRAME_INTERVAL_SEC * m_gameLoop.FPS());
+      m_memoryStream.reset(new CDeltaPairMemoryStream(REWIND_MAX_BUFFER_SIZE, keyframeInterval));
       m_memoryStream->Init(m_gameClient->SerializeSize(), frameCount);
     }
 
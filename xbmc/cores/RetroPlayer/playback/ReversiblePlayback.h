@@ -16,6 +16,7 @@
 #include <memory>
 #include <stddef.h>
 #include <stdint.h>
+#include <vector>
 
 namespace KODI
 {
@@ -62,10 +63,13 @@ namespace RETRO
 
   private:
     void AddFrame();
+    void RunAhead();
+    void FastForward(double speedFactor);
     void RewindFrames(uint64_t frames);
     void AdvanceFrames(uint64_t frames);
     void UpdatePlaybackStats();
     void UpdateMemoryStream();
+    void UpdateRunAhead();
 
     // Construction parameter
     GAME::CGameClient* const m_gameClient;
@@ -75,6 +79,13 @@ namespace RETRO
     std::unique_ptr<IMemoryStream> m_memoryStream;
     CCriticalSection m_mutex;
 
+    // Run-ahead functionality
+    unsigned int m_runAheadFrames = 0;
+    std::vector<uint8_t> m_runAheadState;
+
+    // Fast-forward functionality
+    double m_fastForwardPosition = 0.0;
+
     // Savestate functionality
     std::unique_ptr<CSavestateDatabase> m_savestateDatabase;
 
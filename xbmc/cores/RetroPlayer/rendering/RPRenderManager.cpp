@@ -94,7 +94,10 @@ bool CRPRenderManager::Configure(AVPixelFormat format, unsigned int nominalWidth
 bool CRPRenderManager::GetVideoBuffer(unsigned int width, unsigned int height, AVPixelFormat &format, uint8_t *&data, size_t &size)
 {
   for (IRenderBuffer *buffer : m_pendingBuffers)
+  {
+    buffer->ReleaseMemory();
     buffer->Release();
+  }
   m_pendingBuffers.clear();
 
   if (m_bFlush || m_state != RENDER_STATE::CONFIGURED)
@@ -123,6 +126,20 @@ bool CRPRenderManager::GetVideoBuffer(unsigned int width, unsigned int height, A
   data = renderBuffer->GetMemory();
   size = renderBuffer->GetFrameSize();
 
+  // Game clients write rows without padding, buffers with a larger stride
+  // get the frame copied instead
+  const size_t frameSize = CRenderTranslator::TranslateWidthToBytes(width, format) * height;
+  if (data == nullptr || size != frameSize)
+  {
+    for (IRenderBuffer *buffer : m_pendingBuffers)
+    {
+      buffer->ReleaseMemory();
+      buffer->Release();
+    }
+    m_pendingBuffers.clear();
+    return false;
+  }
+
   return true;
 }
 
@@ -171,15 +188,6 @@ void CRPRenderManager::AddFrame(const uint8_t* data, size_t size, unsigned int w
   {
     CSingleLock lock(m_bufferMutex);
 
-    // Set render buffers
-    for (auto renderBuffer : m_renderBuffers)
-      renderBuffer->Release();
-    m_renderBuffers = std::move(renderBuffers);
-
-    // Apply rotation to render buffers
-    for (auto renderBuffer : m_renderBuffers)
-      renderBuffer->SetRotation(orientationDegCCW);
-
     // Cache frame if it arrived after being paused
     if (m_speed == 0.0)
     {
@@ -207,6 +215,20 @@ void CRPRenderManager::AddFrame(const uint8_t* data, size_t size, unsigned int w
         m_cachedHeight = height;
       }
     }
+
+    // Zero-copy frames may still be mapped, they are complete now that the
+    // frame has been cached
+    for (auto renderBuffer : renderBuffers)
+      renderBuffer->ReleaseMemory();
+
+    // Set render buffers
+    for (auto renderBuffer : m_renderBuffers)
+      renderBuffer->Release();
+    m_renderBuffers = std::move(renderBuffers);
+
+    // Apply rotation to render buffers
+    for (auto renderBuffer : m_renderBuffers)
+      renderBuffer->SetRotation(orientationDegCCW);
   }
 }
 
@@ -8,15 +8,297 @@
 
 #include "SavestateDatabase.h"
 
+#include "FileItem.h"
 #include "SavestateFlatBuffer.h"
 #include "SavestateUtils.h"
 #include "URL.h"
 #include "filesystem/File.h"
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+#include "utils/JobManager.h"
+#include "utils/auto_buffer.h"
 #include "utils/log.h"
 
+#include <cstring>
+#include <map>
+#include <zlib.h>
+
 using namespace KODI;
 using namespace RETRO;
 
+namespace
+{
+  /*!
+   * \brief Compressed savestates start with this tag, followed by the 64-bit
+   *        size of the uncompressed FlatBuffer and the zlib stream
+   */
+  const char COMPRESSED_MAGIC[4] = { 'K', 'S', 'Z', '1' };
+  const size_t COMPRESSED_HEADER_SIZE = sizeof(COMPRESSED_MAGIC) + sizeof(uint64_t);
+
+  using SavestateData = std::shared_ptr<const std::vector<uint8_t>>;
+
+  // Savestates that haven't been written yet, by path
+  CCriticalSection pendingSection;
+  std::map<std::string, SavestateData> pendingSavestates;
+
+  // Serializes the writes of the savestate files
+  CCriticalSection writeSection;
+
+  /*!
+   * \brief The metadata of all savestates is kept in one small file, so
+   *        listing savestates doesn't read and decompress each of them
+   */
+  const char *INDEX_PATH = "special://masterprofile/Savestates.idx";
+  const char INDEX_MAGIC[4] = { 'K', 'S', 'I', '1' };
+
+  struct IndexEntry
+  {
+    SavestateInfo info;
+
+    // Size and modification time of the savestate file, the entry is
+    // outdated if the file changed behind our back
+    int64_t size = 0;
+    int64_t mtime = 0;
+  };
+
+  CCriticalSection indexSection;
+  std::map<std::string, IndexEntry> savestateIndex;
+  bool bIndexLoaded = false;
+
+  template<typename T>
+  void WriteValue(std::string &out, const T &value)
+  {
+    out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+  }
+
+  void WriteString(std::string &out, const std::string &value)
+  {
+    WriteValue(out, static_cast<uint32_t>(value.size()));
+    out.append(value);
+  }
+
+  class CIndexReader
+  {
+  public:
+    CIndexReader(const char *data, size_t size) : m_pos(data), m_end(data + size) { }
+
+    bool AtEnd() const { return m_pos == m_end; }
+
+    template<typename T>
+    bool Read(T &value)
+    {
+      if (static_cast<size_t>(m_end - m_pos) < sizeof(value))
+        return false;
+      std::memcpy(&value, m_pos, sizeof(value));
+      m_pos += sizeof(value);
+      return true;
+    }
+
+    bool ReadString(std::string &value)
+    {
+      uint32_t length;
+      if (!Read(length) || static_cast<size_t>(m_end - m_pos) < length)
+        return false;
+      value.assign(m_pos, length);
+      m_pos += length;
+      return true;
+    }
+
+  private:
+    const char *m_pos;
+    const char *m_end;
+  };
+
+  bool StatSavestate(const std::string &savestatePath, int64_t &size, int64_t &mtime)
+  {
+    struct __stat64 buffer;
+    if (XFILE::CFile::Stat(savestatePath, &buffer) != 0)
+      return false;
+
+    size = buffer.st_size;
+    mtime = buffer.st_mtime;
+    return true;
+  }
+
+  SavestateInfo GetInfo(const ISavestate &save)
+  {
+    SavestateInfo info;
+    info.type = save.Type();
+    info.label = save.Label();
+    info.created = save.Created();
+    info.gameFileName = save.GameFileName();
+    info.timestampFrames = save.TimestampFrames();
+    info.timestampWallClock = save.TimestampWallClock();
+    info.gameClientId = save.GameClientID();
+    info.gameClientVersion = save.GameClientVersion();
+    return info;
+  }
+
+  // Must be called with indexSection held
+  void LoadIndex()
+  {
+    if (bIndexLoaded)
+      return;
+    bIndexLoaded = true;
+
+    if (!XFILE::CFile::Exists(INDEX_PATH))
+      return;
+
+    XUTILS::auto_buffer buffer;
+    XFILE::CFile file;
+    if (file.LoadFile(INDEX_PATH, buffer) <= 0)
+      return;
+
+    CIndexReader reader(buffer.get(), buffer.size());
+    char magic[4];
+    if (!reader.Read(magic) || std::memcmp(magic, INDEX_MAGIC, sizeof(magic)) != 0)
+      return;
+
+    while (!reader.AtEnd())
+    {
+      std::string path;
+      std::string created;
+      uint8_t type;
+      IndexEntry entry;
+      if (!reader.ReadString(path) || !reader.Read(type) || !reader.ReadString(entry.info.label) ||
+          !reader.ReadString(created) || !reader.ReadString(entry.info.gameFileName) ||
+          !reader.Read(entry.info.timestampFrames) || !reader.Read(entry.info.timestampWallClock) ||
+          !reader.ReadString(entry.info.gameClientId) || !reader.ReadString(entry.info.gameClientVersion) ||
+          !reader.Read(entry.size) || !reader.Read(entry.mtime))
+      {
+        CLog::Log(LOGERROR, "Savestate index is truncated, ignoring it");
+        savestateIndex.clear();
+        return;
+      }
+      entry.info.type = static_cast<SAVE_TYPE>(type);
+      entry.info.created.SetFromDBDateTime(created);
+      savestateIndex[path] = std::move(entry);
+    }
+  }
+
+  // Must be called with indexSection held
+  void SaveIndex()
+  {
+    std::string data(INDEX_MAGIC, sizeof(INDEX_MAGIC));
+    for (const auto &it : savestateIndex)
+    {
+      const IndexEntry &entry = it.second;
+
+      // Pending savestates are indexed once they are written
+      if (entry.size == 0)
+        continue;
+
+      WriteString(data, it.first);
+      WriteValue(data, static_cast<uint8_t>(entry.info.type));
+      WriteString(data, entry.info.label);
+      WriteString(data, entry.info.created.GetAsDBDateTime());
+      WriteString(data, entry.info.gameFileName);
+      WriteValue(data, entry.info.timestampFrames);
+      WriteValue(data, entry.info.timestampWallClock);
+      WriteString(data, entry.info.gameClientId);
+      WriteString(data, entry.info.gameClientVersion);
+      WriteValue(data, entry.size);
+      WriteValue(data, entry.mtime);
+    }
+
+    XFILE::CFile file;
+    if (!file.OpenForWrite(INDEX_PATH, true) ||
+        file.Write(data.c_str(), data.size()) != static_cast<ssize_t>(data.size()))
+      CLog::Log(LOGERROR, "Failed to write savestate index");
+  }
+
+  void UpdateIndex(const std::string &savestatePath)
+  {
+    int64_t size = 0;
+    int64_t mtime = 0;
+    const bool bExists = StatSavestate(savestatePath, size, mtime);
+
+    CSingleLock lock(indexSection);
+    LoadIndex();
+
+    auto it = savestateIndex.find(savestatePath);
+    if (it == savestateIndex.end())
+      return;
+
+    if (bExists)
+    {
+      it->second.size = size;
+      it->second.mtime = mtime;
+    }
+    else
+      savestateIndex.erase(it);
+
+    SaveIndex();
+  }
+
+  bool IsPending(const std::string &savestatePath, const SavestateData &data)
+  {
+    CSingleLock lock(pendingSection);
+    auto it = pendingSavestates.find(savestatePath);
+    return it != pendingSavestates.end() && it->second == data;
+  }
+
+  void WriteSavestate(const std::string &savestatePath, const SavestateData &data)
+  {
+    CSingleLock writeLock(writeSection);
+
+    // A newer savestate for the path supersedes this one
+    if (!IsPending(savestatePath, data))
+      return;
+
+    uLongf compressedSize = compressBound(static_cast<uLong>(data->size()));
+    std::vector<uint8_t> compressed(COMPRESSED_HEADER_SIZE + compressedSize);
+
+    const uint64_t size = data->size();
+    std::memcpy(compressed.data(), COMPRESSED_MAGIC, sizeof(COMPRESSED_MAGIC));
+    std::memcpy(compressed.data() + sizeof(COMPRESSED_MAGIC), &size, sizeof(size));
+
+    if (compress2(compressed.data() + COMPRESSED_HEADER_SIZE, &compressedSize,
+                  data->data(), static_cast<uLong>(data->size()), Z_BEST_SPEED) == Z_OK)
+    {
+      compressed.resize(COMPRESSED_HEADER_SIZE + compressedSize);
+
+      XFILE::CFile file;
+      if (file.OpenForWrite(savestatePath))
+      {
+        const ssize_t written = file.Write(compressed.data(), compressed.size());
+        if (written == static_cast<ssize_t>(compressed.size()))
+          CLog::Log(LOGDEBUG, "Wrote savestate of %u bytes (%u compressed)", data->size(), compressed.size());
+        else
+          CLog::Log(LOGERROR, "Failed to write savestate %s", CURL::GetRedacted(savestatePath).c_str());
+      }
+      else
+        CLog::Log(LOGERROR, "Failed to open savestate for writing");
+    }
+    else
+      CLog::Log(LOGERROR, "Failed to compress savestate");
+
+    UpdateIndex(savestatePath);
+
+    CSingleLock lock(pendingSection);
+    auto it = pendingSavestates.find(savestatePath);
+    if (it != pendingSavestates.end() && it->second == data)
+      pendingSavestates.erase(it);
+  }
+
+  bool Decompress(std::vector<uint8_t> &savestateData)
+  {
+    uint64_t size;
+    std::memcpy(&size, savestateData.data() + sizeof(COMPRESSED_MAGIC), sizeof(size));
+
+    std::vector<uint8_t> uncompressed(static_cast<size_t>(size));
+    uLongf uncompressedSize = static_cast<uLongf>(size);
+    if (uncompress(uncompressed.data(), &uncompressedSize,
+                   savestateData.data() + COMPRESSED_HEADER_SIZE,
+                   static_cast<uLong>(savestateData.size() - COMPRESSED_HEADER_SIZE)) != Z_OK ||
+        uncompressedSize != size)
+      return false;
+
+    savestateData = std::move(uncompressed);
+    return true;
+  }
+}
+
 CSavestateDatabase::CSavestateDatabase() = default;
 
 std::unique_ptr<ISavestate> CSavestateDatabase::CreateSavestate()
@@ -40,23 +322,48 @@ bool CSavestateDatabase::AddSavestate(const std::string &gamePath, const ISavest
   size_t size = 0;
   if (save.Serialize(data, size))
   {
-    XFILE::CFile file;
-    if (file.OpenForWrite(savestatePath))
+    // Compressing and writing happens in the background, the copy outlives
+    // the caller's savestate
+    SavestateData savestateData = std::make_shared<const std::vector<uint8_t>>(data, data + size);
+
     {
-      const ssize_t written = file.Write(data, size);
-      if (written == static_cast<ssize_t>(size))
-      {
-        CLog::Log(LOGDEBUG, "Wrote savestate of %u bytes", size);
-        bSuccess = true;
-      }
+      CSingleLock lock(pendingSection);
+      pendingSavestates[savestatePath] = savestateData;
     }
-    else
-      CLog::Log(LOGERROR, "Failed to open savestate for writing");
+
+    {
+      CSingleLock lock(indexSection);
+      LoadIndex();
+
+      IndexEntry &entry = savestateIndex[savestatePath];
+      entry.info = GetInfo(save);
+      entry.size = 0;
+      entry.mtime = 0;
+    }
+
+    CJobManager::GetInstance().Submit([savestatePath, savestateData]()
+      {
+        WriteSavestate(savestatePath, savestateData);
+      });
+
+    bSuccess = true;
   }
 
   return bSuccess;
 }
 
+void CSavestateDatabase::FlushSavestates()
+{
+  std::map<std::string, SavestateData> savestates;
+  {
+    CSingleLock lock(pendingSection);
+    savestates = pendingSavestates;
+  }
+
+  for (const auto &it : savestates)
+    WriteSavestate(it.first, it.second);
+}
+
 bool CSavestateDatabase::GetSavestate(const std::string& gamePath, ISavestate& save)
 {
   bool bSuccess = false;
@@ -67,6 +374,16 @@ bool CSavestateDatabase::GetSavestate(const std::string& gamePath, ISavestate& s
 
   std::vector<uint8_t> savestateData;
 
+  {
+    CSingleLock lock(pendingSection);
+    auto it = pendingSavestates.find(savestatePath);
+    if (it != pendingSavestates.end())
+      savestateData = *it->second;
+  }
+
+  if (!savestateData.empty())
+    return save.Deserialize(std::move(savestateData));
+
   XFILE::CFile savestateFile;
   if (savestateFile.Open(savestatePath, XFILE::READ_TRUNCATED))
   {
@@ -90,16 +407,88 @@ bool CSavestateDatabase::GetSavestate(const std::string& gamePath, ISavestate& s
   else
     CLog::Log(LOGERROR, "Failed to open savestate file %s", CURL::GetRedacted(savestatePath).c_str());
 
+  // Savestates written before compression was introduced are plain FlatBuffers
+  if (savestateData.size() >= COMPRESSED_HEADER_SIZE &&
+      std::memcmp(savestateData.data(), COMPRESSED_MAGIC, sizeof(COMPRESSED_MAGIC)) == 0)
+  {
+    if (!Decompress(savestateData))
+    {
+      CLog::Log(LOGERROR, "Failed to decompress savestate %s", CURL::GetRedacted(savestatePath).c_str());
+      savestateData.clear();
+    }
+  }
+
   if (!savestateData.empty())
     bSuccess = save.Deserialize(std::move(savestateData));
 
   return bSuccess;
 }
 
+bool CSavestateDatabase::GetSavestateInfo(const std::string& gamePath, SavestateInfo& info)
+{
+  const std::string savestatePath = CSavestateUtils::MakePath(gamePath);
+
+  bool bPending;
+  {
+    CSingleLock lock(pendingSection);
+    bPending = pendingSavestates.find(savestatePath) != pendingSavestates.end();
+  }
+
+  int64_t size = 0;
+  int64_t mtime = 0;
+  if (!bPending && !StatSavestate(savestatePath, size, mtime))
+    return false;
+
+  {
+    CSingleLock lock(indexSection);
+    LoadIndex();
+
+    auto it = savestateIndex.find(savestatePath);
+    if (it != savestateIndex.end() &&
+        (bPending || (it->second.size == size && it->second.mtime == mtime)))
+    {
+      info = it->second.info;
+      return true;
+    }
+  }
+
+  // Not indexed yet, e.g. saved by an older version
+  std::unique_ptr<ISavestate> save = CreateSavestate();
+  if (!GetSavestate(gamePath, *save))
+    return false;
+
+  info = GetInfo(*save);
+
+  if (!bPending)
+  {
+    CSingleLock lock(indexSection);
+    IndexEntry &entry = savestateIndex[savestatePath];
+    entry.info = info;
+    entry.size = size;
+    entry.mtime = mtime;
+    SaveIndex();
+  }
+
+  return true;
+}
+
 bool CSavestateDatabase::GetSavestatesNav(CFileItemList& items, const std::string& gamePath, const std::string& gameClient /* = "" */)
 {
-  //! @todo
-  return false;
+  SavestateInfo info;
+  if (!GetSavestateInfo(gamePath, info))
+    return false;
+
+  if (!gameClient.empty() && info.gameClientId != gameClient)
+    return true;
+
+  CFileItemPtr item(new CFileItem(CSavestateUtils::MakePath(gamePath), false));
+  item->SetLabel(info.label);
+  item->SetLabel2(info.created.GetAsLocalizedDateTime());
+  item->m_dateTime = info.created;
+  item->SetProperty("savestate.gameclient", info.gameClientId);
+  items.Add(std::move(item));
+
+  return true;
 }
 
 bool CSavestateDatabase::RenameSavestate(const std::string& path, const std::string& label)
@@ -110,12 +499,35 @@ bool CSavestateDatabase::RenameSavestate(const std::string& path, const std::str
 
 bool CSavestateDatabase::DeleteSavestate(const std::string& path)
 {
-  //! @todo
-  return false;
+  CSingleLock writeLock(writeSection);
+
+  {
+    CSingleLock lock(pendingSection);
+    pendingSavestates.erase(path);
+  }
+
+  if (XFILE::CFile::Exists(path) && !XFILE::CFile::Delete(path))
+  {
+    CLog::Log(LOGERROR, "Failed to delete savestate %s", CURL::GetRedacted(path).c_str());
+    return false;
+  }
+
+  CSingleLock lock(indexSection);
+  LoadIndex();
+  if (savestateIndex.erase(path) > 0)
+    SaveIndex();
+
+  return true;
 }
 
 bool CSavestateDatabase::ClearSavestatesOfGame(const std::string& gamePath, const std::string& gameClient /* = "" */)
 {
-  //! @todo
-  return false;
+  SavestateInfo info;
+  if (!GetSavestateInfo(gamePath, info))
+    return true;
+
+  if (!gameClient.empty() && info.gameClientId != gameClient)
+    return true;
+
+  return DeleteSavestate(CSavestateUtils::MakePath(gamePath));
 }
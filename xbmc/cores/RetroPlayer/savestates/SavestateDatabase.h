@@ -8,7 +8,11 @@
 
 #pragma once
 
+#include "SavestateTypes.h"
+#include "XBDateTime.h"
+
 #include <memory>
+#include <stdint.h>
 #include <string>
 
 class CFileItemList;
@@ -19,6 +23,21 @@ namespace RETRO
 {
   class ISavestate;
 
+  /*!
+   * \brief Metadata of a savestate, without the memory of the game
+   */
+  struct SavestateInfo
+  {
+    SAVE_TYPE type = SAVE_TYPE::UNKNOWN;
+    std::string label;
+    CDateTime created;
+    std::string gameFileName;
+    uint64_t timestampFrames = 0;
+    double timestampWallClock = 0.0;
+    std::string gameClientId;
+    std::string gameClientVersion;
+  };
+
   class CSavestateDatabase
   {
   public:
@@ -27,10 +46,29 @@ namespace RETRO
 
     std::unique_ptr<ISavestate> CreateSavestate();
 
+    /*!
+     * \brief Save a savestate in the background
+     *
+     * The savestate is compressed and written by a job, until then it is
+     * returned by GetSavestate() from memory.
+     */
     bool AddSavestate(const std::string &gamePath, const ISavestate& save);
 
+    /*!
+     * \brief Write the savestates that are still pending on the calling thread
+     */
+    static void FlushSavestates();
+
     bool GetSavestate(const std::string& gamePath, ISavestate& save);
 
+    /*!
+     * \brief Get the metadata of a savestate
+     *
+     * The metadata is kept in an index when the savestate is saved, so the
+     * savestate file is only read if the index is missing or outdated.
+     */
+    bool GetSavestateInfo(const std::string& gamePath, SavestateInfo& info);
+
     bool GetSavestatesNav(CFileItemList& items, const std::string& gamePath, const std::string& gameClient = "");
 
     bool RenameSavestate(const std::string& path, const std::string& label);
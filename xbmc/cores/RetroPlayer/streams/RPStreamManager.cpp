@@ -27,6 +27,14 @@ void CRPStreamManager::EnableAudio(bool bEnable)
     m_audioStream->Enable(bEnable);
 }
 
+void CRPStreamManager::SetPlaybackRatio(double ratio)
+{
+  m_playbackRatio = ratio;
+
+  if (m_audioStream != nullptr)
+    m_audioStream->SetPlaybackRatio(ratio);
+}
+
 StreamPtr CRPStreamManager::CreateStream(StreamType streamType)
 {
   switch (streamType)
@@ -35,6 +43,7 @@ StreamPtr CRPStreamManager::CreateStream(StreamType streamType)
   {
     // Save pointer to audio stream
     m_audioStream = new CRetroPlayerAudio(m_processInfo);
+    m_audioStream->SetPlaybackRatio(m_playbackRatio);
 
     return StreamPtr(m_audioStream);
   }
@@ -26,6 +26,11 @@ namespace RETRO
 
     void EnableAudio(bool bEnable);
 
+    /*!
+     * \brief Set the ratio of the game loop rate to the game's frame rate
+     */
+    void SetPlaybackRatio(double ratio);
+
     // Implementation of IStreamManager
     StreamPtr CreateStream(StreamType streamType) override;
     void CloseStream(StreamPtr stream) override;
@@ -37,6 +42,7 @@ namespace RETRO
 
     // Stream parameters
     CRetroPlayerAudio* m_audioStream = nullptr;
+    double m_playbackRatio = 1.0;
   };
 }
 }
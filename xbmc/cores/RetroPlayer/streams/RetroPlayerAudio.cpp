@@ -12,6 +12,7 @@
 #include "cores/AudioEngine/Interfaces/AE.h"
 #include "cores/AudioEngine/Interfaces/AEStream.h"
 #include "cores/AudioEngine/Utils/AEChannelInfo.h"
+#include "cores/AudioEngine/Utils/AEStreamData.h"
 #include "cores/AudioEngine/Utils/AEUtil.h"
 #include "cores/RetroPlayer/audio/AudioTranslator.h"
 #include "cores/RetroPlayer/process/RPProcessInfo.h"
@@ -23,6 +24,11 @@ using namespace KODI;
 using namespace RETRO;
 
 const double MAX_DELAY = 0.3; // seconds
+const double TARGET_DELAY = 0.1; // seconds
+
+// Largest correction of the resample ratio to keep the delay at its target,
+// small enough not to be heard as a change of pitch
+const double MAX_RATE_CORRECTION = 0.005;
 
 CRetroPlayerAudio::CRetroPlayerAudio(CRPProcessInfo& processInfo) :
   m_processInfo(processInfo),
@@ -90,7 +96,8 @@ bool CRetroPlayerAudio::OpenStream(const StreamProperties& properties)
   audioFormat.m_dataFormat = pcmFormat;
   audioFormat.m_sampleRate = iSampleRate;
   audioFormat.m_channelLayout = channelLayout;
-  m_pAudioStream = audioEngine->MakeStream(audioFormat);
+  // Resample to follow the game loop and keep the delay steady
+  m_pAudioStream = audioEngine->MakeStream(audioFormat, AESTREAM_FORCE_RESAMPLE);
 
   if (m_pAudioStream == nullptr)
   {
@@ -124,12 +131,29 @@ void CRetroPlayerAudio::AddStreamData(const StreamPacket &packet)
         m_pAudioStream->Flush();
         CLog::Log(LOGDEBUG, "RetroPlayer[AUDIO]: Audio delay (%0.2f ms) is too high - flushing", delaySecs * 1000);
       }
+      else
+        UpdateResampleRatio(delaySecs);
 
       m_pAudioStream->AddData(&audioPacket.data, 0, frameCount, nullptr);
     }
   }
 }
 
+void CRetroPlayerAudio::UpdateResampleRatio(double delaySecs)
+{
+  // Dynamic rate control: the game produces audio at its frame rate times the
+  // playback ratio. Stretching the audio by the inverse keeps it in real time,
+  // and a correction proportional to the distance from the target delay
+  // compensates for drift between the game loop and the audio clock.
+  double correction = (TARGET_DELAY - delaySecs) / TARGET_DELAY * MAX_RATE_CORRECTION;
+  if (correction > MAX_RATE_CORRECTION)
+    correction = MAX_RATE_CORRECTION;
+  else if (correction < -MAX_RATE_CORRECTION)
+    correction = -MAX_RATE_CORRECTION;
+
+  m_pAudioStream->SetResampleRatio((1.0 + correction) / m_playbackRatio);
+}
+
 void CRetroPlayerAudio::CloseStream()
 {
   if (m_pAudioStream)
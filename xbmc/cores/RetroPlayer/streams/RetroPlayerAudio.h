@@ -54,6 +54,12 @@ namespace RETRO
 
     void Enable(bool bEnabled) { m_bAudioEnabled = bEnabled; }
 
+    /*!
+     * \brief Set the ratio of the game loop rate to the game's frame rate,
+     *        audio is resampled by the inverse to play in real time
+     */
+    void SetPlaybackRatio(double ratio) { m_playbackRatio = ratio; }
+
     // implementation of IRetroPlayerStream
     bool OpenStream(const StreamProperties& properties) override;
     bool GetStreamBuffer(unsigned int width, unsigned int height, StreamBuffer& buffer) override { return false; }
@@ -61,9 +67,12 @@ namespace RETRO
     void CloseStream() override;
 
   private:
+    void UpdateResampleRatio(double delaySecs);
+
     CRPProcessInfo& m_processInfo;
     IAEStream* m_pAudioStream;
     bool m_bAudioEnabled;
+    double m_playbackRatio = 1.0;
   };
 }
 }
@@ -10,14 +10,25 @@
 
 #include "utils/log.h"
 
+#include <algorithm>
+#include <cstring>
+
 using namespace KODI;
 using namespace RETRO;
 
+CDeltaPairMemoryStream::CDeltaPairMemoryStream(uint64_t maxBufferSize /* = 0 */, uint64_t keyframeInterval /* = 0 */) :
+  m_maxBufferSize(maxBufferSize),
+  m_keyframeInterval(keyframeInterval)
+{
+}
+
 void CDeltaPairMemoryStream::Reset()
 {
   CLinearMemoryStream::Reset();
 
   m_rewindBuffer.clear();
+  m_bufferSize = 0;
+  m_framesSinceKeyframe = 0;
 }
 
 void CDeltaPairMemoryStream::SubmitFrameInternal()
@@ -31,16 +42,44 @@ void CDeltaPairMemoryStream::SubmitFrameInternal()
   uint32_t* currentFrame = m_currentFrame.get();
   uint32_t* nextFrame = m_nextFrame.get();
 
-  for (size_t i = 0; i < m_paddedFrameSize; i++)
+  // The buffers hold m_paddedFrameSize words, only the state's words matter
+  const size_t frameWords = m_paddedFrameSize / sizeof(uint32_t);
+
+  if (m_keyframeInterval > 0 && ++m_framesSinceKeyframe >= m_keyframeInterval)
+  {
+    // Rewinding to this frame restores the copy, no deltas needed
+    frame.keyframe.assign(currentFrame, currentFrame + frameWords);
+    m_framesSinceKeyframe = 0;
+  }
+  else
   {
-    uint32_t xor_val = currentFrame[i] ^ nextFrame[i];
-    if (xor_val)
+    size_t i = 0;
+    while (i < frameWords)
     {
-      DeltaPair pair = { i, xor_val };
-      frame.buffer.push_back(pair);
+      // Skip the unchanged words, most of the state
+      while (i < frameWords && currentFrame[i] == nextFrame[i])
+        i++;
+      if (i == frameWords)
+        break;
+
+      const size_t start = i;
+      while (i < frameWords && currentFrame[i] != nextFrame[i])
+        i++;
+
+      frame.runs.push_back({ start, i - start });
+      const size_t offset = frame.deltas.size();
+      frame.deltas.resize(offset + i - start);
+      uint32_t* deltas = frame.deltas.data() + offset;
+      for (size_t j = start; j < i; j++)
+        deltas[j - start] = currentFrame[j] ^ nextFrame[j];
     }
+
+    frame.runs.shrink_to_fit();
+    frame.deltas.shrink_to_fit();
   }
 
+  m_bufferSize += frame.MemorySize();
+
   // Delta is generated, bring the new frame forward (m_nextFrame is now disposable)
   std::swap(m_currentFrame, m_nextFrame);
 
@@ -48,6 +87,9 @@ void CDeltaPairMemoryStream::SubmitFrameInternal()
 
   if (PastFramesAvailable() + 1 > MaxFrameCount())
     CullPastFrames(1);
+
+  while (m_maxBufferSize > 0 && m_bufferSize > m_maxBufferSize && m_rewindBuffer.size() > 1)
+    CullPastFrames(1);
 }
 
 uint64_t CDeltaPairMemoryStream::PastFramesAvailable() const
@@ -57,32 +99,58 @@ uint64_t CDeltaPairMemoryStream::PastFramesAvailable() const
 
 uint64_t CDeltaPairMemoryStream::RewindFrames(uint64_t frameCount)
 {
-  uint64_t rewound;
-
-  for (rewound = 0; rewound < frameCount; rewound++)
+  const uint64_t rewound = std::min(frameCount, PastFramesAvailable());
+  if (rewound == 0)
+    return 0;
+
+  // Start from the keyframe closest to the target, if any, instead of the
+  // current frame
+  const size_t target = m_rewindBuffer.size() - static_cast<size_t>(rewound);
+  size_t start = m_rewindBuffer.size();
+  for (size_t i = target; i < m_rewindBuffer.size(); i++)
   {
-    if (m_rewindBuffer.empty())
+    if (!m_rewindBuffer[i].keyframe.empty())
+    {
+      start = i + 1;
       break;
+    }
+  }
 
-    const MemoryFrame& frame = m_rewindBuffer.back();
-    const DeltaPair* buffer = frame.buffer.data();
-
-    size_t bufferSize = frame.buffer.size();
-
-    // buffer pointer redirection violates data-dependency requirements...
-    // no vectorization for us :(
-    for (size_t i = 0; i < bufferSize; i++)
-      m_currentFrame[buffer[i].pos] ^= buffer[i].delta;
+  for (size_t i = start; i-- > target; )
+    ApplyFrame(m_rewindBuffer[i]);
 
-    // Restore frame history
-    m_currentFrameHistory = frame.frameHistoryCount;
+  // Restore frame history
+  m_currentFrameHistory = m_rewindBuffer[target].frameHistoryCount;
 
+  while (m_rewindBuffer.size() > target)
+  {
+    m_bufferSize -= m_rewindBuffer.back().MemorySize();
     m_rewindBuffer.pop_back();
   }
 
   return rewound;
 }
 
+void CDeltaPairMemoryStream::ApplyFrame(const MemoryFrame& frame)
+{
+  uint32_t* currentFrame = m_currentFrame.get();
+
+  if (!frame.keyframe.empty())
+  {
+    std::memcpy(currentFrame, frame.keyframe.data(), frame.keyframe.size() * sizeof(uint32_t));
+    return;
+  }
+
+  const uint32_t* deltas = frame.deltas.data();
+  for (const DeltaRun& run : frame.runs)
+  {
+    uint32_t* words = currentFrame + run.pos;
+    for (size_t i = 0; i < run.length; i++)
+      words[i] ^= deltas[i];
+    deltas += run.length;
+  }
+}
+
 void CDeltaPairMemoryStream::CullPastFrames(uint64_t frameCount)
 {
   for (uint64_t removedCount = 0; removedCount < frameCount; removedCount++)
@@ -92,6 +160,7 @@ void CDeltaPairMemoryStream::CullPastFrames(uint64_t frameCount)
       CLog::Log(LOGDEBUG, "CDeltaPairMemoryStream: Tried to cull %d frames too many. Check your math!", frameCount - removedCount);
       break;
     }
+    m_bufferSize -= m_rewindBuffer.front().MemorySize();
     m_rewindBuffer.pop_front();
   }
 }
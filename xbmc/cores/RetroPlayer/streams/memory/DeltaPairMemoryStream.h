@@ -23,7 +23,11 @@ namespace RETRO
   class CDeltaPairMemoryStream : public CLinearMemoryStream
   {
   public:
-    CDeltaPairMemoryStream() = default;
+    /*!
+     * \param maxBufferSize Bytes the past frames may use, 0 for no limit
+     * \param keyframeInterval Frames between full copies of the state, 0 for none
+     */
+    CDeltaPairMemoryStream(uint64_t maxBufferSize = 0, uint64_t keyframeInterval = 0);
 
     virtual ~CDeltaPairMemoryStream() = default;
 
@@ -44,24 +48,45 @@ namespace RETRO
      * of original save state size depending on the system. The algorithm runs
      * on 32 bits at a time for speed.
      *
+     * Changed words are stored as runs: the position and length of the run
+     * followed by its XOR values. Changes in save states are clustered, so a
+     * run costs far less than a position per word, and applying a run is a
+     * contiguous loop the compiler can vectorize.
+     *
+     * Every keyframe interval a frame holds a full copy of the state instead,
+     * bounding the deltas applied when rewinding far.
+     *
      * Use std::deque here to achieve amortized O(1) on pop/push to front and
      * back.
      */
-    struct DeltaPair
+    struct DeltaRun
     {
       size_t pos;
-      uint32_t delta;
+      size_t length;
     };
 
-    using DeltaPairVector = std::vector<DeltaPair>;
-
     struct MemoryFrame
     {
-      DeltaPairVector buffer;
+      std::vector<DeltaRun> runs;
+      std::vector<uint32_t> deltas;
+      std::vector<uint32_t> keyframe;
       uint64_t frameHistoryCount;
+
+      size_t MemorySize() const
+      {
+        return runs.size() * sizeof(DeltaRun) + (deltas.size() + keyframe.size()) * sizeof(uint32_t);
+      }
     };
 
+    void ApplyFrame(const MemoryFrame& frame);
+
     std::deque<MemoryFrame> m_rewindBuffer;
+
+  private:
+    const uint64_t m_maxBufferSize;
+    const uint64_t m_keyframeInterval;
+    uint64_t m_bufferSize = 0;
+    uint64_t m_framesSinceKeyframe = 0;
   };
 }
 }
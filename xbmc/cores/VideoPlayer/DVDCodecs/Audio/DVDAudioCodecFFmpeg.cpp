@@ -150,6 +150,8 @@ bool CDVDAudioCodecFFmpeg::AddData(const DemuxPacket &packet)
   avpkt.pts = (packet.pts == DVD_NOPTS_VALUE) ? AV_NOPTS_VALUE : static_cast<int64_t>(packet.pts / DVD_TIME_BASE * AV_TIME_BASE);
   avpkt.side_data = static_cast<AVPacketSideData*>(packet.pSideData);
   avpkt.side_data_elems = packet.iSideDataElems;
+  // a reference counted packet is referenced by avcodec_send_packet instead of copied
+  avpkt.buf = static_cast<AVBufferRef*>(packet.pBufferRef);
 
   int ret = avcodec_send_packet(m_pCodecContext, &avpkt);
 
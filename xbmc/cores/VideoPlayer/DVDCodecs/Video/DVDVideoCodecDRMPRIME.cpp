@@ -10,14 +10,20 @@
 
 #include "ServiceBroker.h"
 #include "cores/VideoPlayer/DVDCodecs/DVDFactoryCodec.h"
+#include "cores/VideoPlayer/Process/gbm/VideoBufferDMA.h"
 #include "cores/VideoPlayer/Process/gbm/VideoBufferDRMPRIME.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "settings/lib/Setting.h"
 #include "threads/SingleLock.h"
+#include "utils/CPUInfo.h"
+#include "utils/GBMBufferObject.h"
 #include "utils/log.h"
 #include "windowing/gbm/WinSystemGbm.h"
 
+#include <algorithm>
+#include <gbm.h>
+
 extern "C" {
 #include <libavcodec/avcodec.h>
 #include <libavutil/pixdesc.h>
@@ -70,6 +76,21 @@ static const AVCodecHWConfig* FindHWConfig(const AVCodec* codec)
   return nullptr;
 }
 
+// software decoders need to support direct rendering to decode into dma-bufs
+static const AVCodec* FindSoftwareDecoder(CDVDStreamInfo& hints)
+{
+  const AVCodec* codec = avcodec_find_decoder(hints.codec);
+  if (!codec || !(codec->capabilities & AV_CODEC_CAP_DR1))
+    return nullptr;
+
+  // the planes of a frame share one 8 bit buffer object
+  CGBMBufferObject bo(GBM_FORMAT_R8);
+  if (!bo.CreateBufferObject(64, 64))
+    return nullptr;
+
+  return codec;
+}
+
 static const AVCodec* FindDecoder(CDVDStreamInfo& hints)
 {
   const AVCodec* codec = nullptr;
@@ -92,11 +113,13 @@ static const AVCodec* FindDecoder(CDVDStreamInfo& hints)
 
 enum AVPixelFormat CDVDVideoCodecDRMPRIME::GetFormat(struct AVCodecContext* avctx, const enum AVPixelFormat* fmt)
 {
+  CDVDVideoCodecDRMPRIME* ctx = static_cast<CDVDVideoCodecDRMPRIME*>(avctx->opaque);
+
   for (int n = 0; fmt[n] != AV_PIX_FMT_NONE; n++)
   {
-    if (fmt[n] == AV_PIX_FMT_DRM_PRIME)
+    if (fmt[n] == AV_PIX_FMT_DRM_PRIME ||
+        (ctx->m_dmaBufferPool && CVideoBufferDMA::IsSupportedFormat(fmt[n])))
     {
-      CDVDVideoCodecDRMPRIME* ctx = static_cast<CDVDVideoCodecDRMPRIME*>(avctx->opaque);
       ctx->UpdateProcessInfo(avctx, fmt[n]);
       return fmt[n];
     }
@@ -105,13 +128,47 @@ enum AVPixelFormat CDVDVideoCodecDRMPRIME::GetFormat(struct AVCodecContext* avct
   return AV_PIX_FMT_NONE;
 }
 
+int CDVDVideoCodecDRMPRIME::GetBuffer(struct AVCodecContext* avctx, AVFrame* frame, int flags)
+{
+  CDVDVideoCodecDRMPRIME* ctx = static_cast<CDVDVideoCodecDRMPRIME*>(avctx->opaque);
+
+  // frames of other formats can't be imported and are rejected by GetPicture
+  if (!CVideoBufferDMA::IsSupportedFormat(frame->format))
+    return avcodec_default_get_buffer2(avctx, frame, flags);
+
+  CVideoBufferDMA* buffer = static_cast<CVideoBufferDMA*>(ctx->m_dmaBufferPool->Get());
+  if (buffer->Alloc(avctx, frame))
+  {
+    frame->buf[0] = av_buffer_create(frame->data[0], 0, ReleaseBuffer, buffer, 0);
+    if (frame->buf[0])
+    {
+      frame->extended_data = frame->data;
+      return 0;
+    }
+  }
+
+  buffer->Release();
+  return AVERROR(ENOMEM);
+}
+
+void CDVDVideoCodecDRMPRIME::ReleaseBuffer(void* opaque, uint8_t* data)
+{
+  static_cast<CVideoBufferDMA*>(opaque)->Release();
+}
+
 bool CDVDVideoCodecDRMPRIME::Open(CDVDStreamInfo& hints, CDVDCodecOptions& options)
 {
   const AVCodec* pCodec = FindDecoder(hints);
   if (!pCodec)
   {
-    CLog::Log(LOGDEBUG, "CDVDVideoCodecDRMPRIME::%s - unable to find decoder for codec %d", __FUNCTION__, hints.codec);
-    return false;
+    // decode in software, but straight into buffers the renderer can import
+    pCodec = FindSoftwareDecoder(hints);
+    if (!pCodec)
+    {
+      CLog::Log(LOGDEBUG, "CDVDVideoCodecDRMPRIME::%s - unable to find decoder for codec %d", __FUNCTION__, hints.codec);
+      return false;
+    }
+    m_dmaBufferPool = std::make_shared<CVideoBufferPoolDMA>();
   }
 
   CLog::Log(LOGNOTICE, "CDVDVideoCodecDRMPRIME::%s - using decoder %s", __FUNCTION__, pCodec->long_name ? pCodec->long_name : pCodec->name);
@@ -134,9 +191,15 @@ bool CDVDVideoCodecDRMPRIME::Open(CDVDStreamInfo& hints, CDVDCodecOptions& optio
     }
   }
 
-  m_pCodecContext->pix_fmt = AV_PIX_FMT_DRM_PRIME;
+  m_pCodecContext->pix_fmt = m_dmaBufferPool ? AV_PIX_FMT_NONE : AV_PIX_FMT_DRM_PRIME;
   m_pCodecContext->opaque = static_cast<void*>(this);
   m_pCodecContext->get_format = GetFormat;
+  if (m_dmaBufferPool)
+  {
+    // get_buffer2 is not thread safe, frame threads leave it to the decoder thread
+    m_pCodecContext->get_buffer2 = GetBuffer;
+    m_pCodecContext->thread_count = std::max(1, std::min(g_cpuInfo.getCPUCount() * 3 / 2, 16));
+  }
   m_pCodecContext->codec_tag = hints.codec_tag;
   m_pCodecContext->coded_width = hints.width;
   m_pCodecContext->coded_height = hints.height;
@@ -293,6 +356,15 @@ CDVDVideoCodec::VCReturn CDVDVideoCodecDRMPRIME::GetPicture(VideoPicture* pVideo
     buffer->SetRef(m_pFrame);
     pVideoPicture->videoBuffer = buffer;
   }
+  else if (m_dmaBufferPool && CVideoBufferDMA::IsSupportedFormat(m_pFrame->format))
+  {
+    // the buffer stays acquired by the picture after the decoder drops the frame
+    CVideoBufferDMA* buffer = static_cast<CVideoBufferDMA*>(av_buffer_get_opaque(m_pFrame->buf[0]));
+    buffer->SetPictureParams(m_pFrame);
+    buffer->Acquire();
+    pVideoPicture->videoBuffer = buffer;
+    av_frame_unref(m_pFrame);
+  }
 
   if (!pVideoPicture->videoBuffer)
   {
@@ -21,6 +21,9 @@
 #include "utils/log.h"
 #include "cores/VideoPlayer/VideoRenderers/RenderManager.h"
 #include "utils/StringUtils.h"
+#include <algorithm>
+#include <cmath>
+#include <cstring>
 #include <memory>
 
 extern "C" {
@@ -40,6 +43,12 @@ extern "C" {
 #define RINT lrint
 #endif
 
+// software decoding sheds the loop filter step by step while the render
+// queue runs dry for this long, and restores it after it stayed filled
+#define DEGRADE_UP_SECONDS    0.25
+#define DEGRADE_DOWN_SECONDS  3.0
+#define DEGRADE_MAX_LEVEL     2
+
 enum DecoderState
 {
   STATE_NONE,
@@ -300,6 +309,8 @@ enum AVPixelFormat CDVDVideoCodecFFmpeg::GetFormat(struct AVCodecContext * avctx
   return avcodec_default_get_format(avctx, fmt);
 }
 
+std::atomic<int> CDVDVideoCodecFFmpeg::m_threadedDecoders(0);
+
 CDVDVideoCodecFFmpeg::CDVDVideoCodecFFmpeg(CProcessInfo &processInfo)
 : CDVDVideoCodec(processInfo), m_postProc(processInfo)
 {
@@ -364,17 +375,16 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
     }
     else
     {
-      int num_threads = g_cpuInfo.getCPUCount() * 3 / 2;
-      num_threads = std::max(1, std::min(num_threads, 16));
-      m_pCodecContext->thread_count = num_threads;
-      m_pCodecContext->thread_safe_callbacks = 1;
+      SetupThreading(pCodec);
       m_decoderState = STATE_SW_MULTI;
-      CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg - open frame threaded with %d threads", num_threads);
     }
   }
   else
     m_decoderState = STATE_SW_SINGLE;
 
+  if (m_decoderState != STATE_SW_MULTI)
+    m_processInfo.SetVideoDecoderThreading("none", 0, 0);
+
   // if we don't do this, then some codecs seem to fail.
   m_pCodecContext->coded_height = hints.height;
   m_pCodecContext->coded_width = hints.width;
@@ -395,6 +405,17 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
     m_pCodecContext->skip_loop_filter = static_cast<AVDiscard>(iSkipLoopFilter);
   }
 
+  // AV1 film grain synthesis costs as much as a good part of the decode
+  if (hints.codec == AV_CODEC_ID_AV1 &&
+      !CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoApplyFilmGrain)
+  {
+#if defined(AV_CODEC_EXPORT_DATA_FILM_GRAIN)
+    m_pCodecContext->export_side_data |= AV_CODEC_EXPORT_DATA_FILM_GRAIN;
+#endif
+    av_opt_set_int(m_pCodecContext, "filmgrain", 0, AV_OPT_SEARCH_CHILDREN);
+    CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg::Open() AV1 film grain disabled");
+  }
+
   // set any special options
   for(std::vector<CDVDCodecOption>::iterator it = options.m_keys.begin(); it != options.m_keys.end(); ++it)
   {
@@ -438,12 +459,135 @@ bool CDVDVideoCodecFFmpeg::Open(CDVDStreamInfo &hints, CDVDCodecOptions &options
   m_processInfo.SetVideoPixelFormat(pixFmtName ? pixFmtName : "");
 
   m_dropCtrl.Reset(true);
+  m_degradeLevel = 0;
+  m_degradePressure = 0;
+  m_degradeCalm = 0;
   m_eof = false;
   return true;
 }
 
+// parameter sets in the stream itself override those of Annex B extradata
+static bool IsAnnexB(const CDVDStreamInfo &hints)
+{
+  const uint8_t *data = static_cast<const uint8_t*>(hints.extradata);
+  if (hints.extrasize >= 3 && data[0] == 0 && data[1] == 0 && data[2] == 1)
+    return true;
+  if (hints.extrasize >= 4 && data[0] == 0 && data[1] == 0 && data[2] == 0 && data[3] == 1)
+    return true;
+  return false;
+}
+
+bool CDVDVideoCodecFFmpeg::Reconfigure(CDVDStreamInfo &hints)
+{
+  if (!m_pCodecContext || hints.cryptoSession)
+    return false;
+
+  // ffmpeg follows resolution changes of the same format itself, hardware
+  // decoders are reinitialized through get_format when they need to
+  if (hints.codec != m_hints.codec ||
+      hints.codec_tag != m_hints.codec_tag ||
+      hints.profile != m_hints.profile ||
+      hints.bitsperpixel != m_hints.bitsperpixel ||
+      hints.stereo_mode != m_hints.stereo_mode ||
+      (hints.codecOptions & CODEC_FORCE_SOFTWARE) != (m_hints.codecOptions & CODEC_FORCE_SOFTWARE) ||
+      hints.width > m_hints.width ||
+      hints.height > m_hints.height)
+    return false;
+
+  if (!IsAnnexB(hints) || !IsAnnexB(m_hints))
+  {
+    if (hints.extrasize != m_hints.extrasize)
+      return false;
+    if (hints.extrasize && memcmp(hints.extradata, m_hints.extradata, hints.extrasize) != 0)
+      return false;
+  }
+
+  CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg::Reconfigure - continuing with %s", m_name.c_str());
+
+  Reset();
+
+  // the decoder stays configured for the largest size and its options
+  const int width = m_hints.width;
+  const int height = m_hints.height;
+  const int codecOptions = m_hints.codecOptions;
+  m_hints = hints;
+  m_hints.width = width;
+  m_hints.height = height;
+  m_hints.codecOptions = codecOptions;
+  m_iOrientation = hints.orientation;
+  return true;
+}
+
+void CDVDVideoCodecFFmpeg::SetupThreading(const AVCodec* codec)
+{
+  const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+
+  // several software decoders open at the same time (e.g. while recordings are being
+  // transcoded for a client) split the budget instead of each grabbing all cores
+  int budget = advancedSettings->m_videoDecoderThreads;
+  if (budget == 0)
+    budget = g_cpuInfo.getCPUCount() * 3 / 2;
+
+  if (!m_threadBudgetTaken)
+  {
+    m_threadedDecoders++;
+    m_threadBudgetTaken = true;
+  }
+  int numThreads = budget / std::max(1, m_threadedDecoders.load());
+  numThreads = std::max(1, std::min(numThreads, 16));
+
+  // frame threading delays the output by one frame per thread, live tv prefers slice
+  // threading as far as the codec supports it
+  const std::vector<std::string>& sliceCodecs = advancedSettings->m_videoSliceThreadedCodecs;
+  bool slice = std::find(sliceCodecs.begin(), sliceCodecs.end(), codec->name) != sliceCodecs.end();
+  if (advancedSettings->m_videoLowLatencyLiveDecode && m_processInfo.IsRealtimeStream())
+    slice = true;
+
+  if (slice && !(codec->capabilities & AV_CODEC_CAP_SLICE_THREADS))
+    slice = false;
+  else if (!slice && !(codec->capabilities & AV_CODEC_CAP_FRAME_THREADS) &&
+           (codec->capabilities & AV_CODEC_CAP_SLICE_THREADS))
+    slice = true;
+
+  m_pCodecContext->thread_count = numThreads;
+  m_pCodecContext->thread_type = slice ? FF_THREAD_SLICE : FF_THREAD_FRAME;
+  m_pCodecContext->thread_safe_callbacks = 1;
+
+  int latency = slice ? 0 : numThreads - 1;
+
+  // libdav1d runs its own pool of frame and tile threads, its frame threads
+  // delay the output like ffmpeg's. Tiles only help on streams that have
+  // several, so the budget goes to frame threads unless latency matters.
+  if (strcmp(codec->name, "libdav1d") == 0)
+  {
+    int tileThreads = std::max(1, static_cast<int>(std::sqrt(numThreads)));
+    int frameThreads = (numThreads + tileThreads - 1) / tileThreads;
+    if (advancedSettings->m_videoLowLatencyLiveDecode && m_processInfo.IsRealtimeStream())
+    {
+      tileThreads = std::min(numThreads, 64);
+      frameThreads = 1;
+    }
+    av_opt_set_int(m_pCodecContext, "tilethreads", tileThreads, AV_OPT_SEARCH_CHILDREN);
+    av_opt_set_int(m_pCodecContext, "framethreads", frameThreads, AV_OPT_SEARCH_CHILDREN);
+    av_opt_set_int(m_pCodecContext, "max_frame_delay", frameThreads, AV_OPT_SEARCH_CHILDREN);
+
+    slice = frameThreads == 1;
+    latency = frameThreads - 1;
+  }
+  m_processInfo.SetVideoDecoderThreading(slice ? "slice" : "frame", numThreads, latency);
+
+  CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg - open %s threaded with %d threads, latency %d frames",
+            slice ? "slice" : "frame", numThreads, latency);
+}
+
 void CDVDVideoCodecFFmpeg::Dispose()
 {
+  if (m_threadBudgetTaken)
+  {
+    m_threadedDecoders--;
+    m_threadBudgetTaken = false;
+  }
+
   av_frame_free(&m_pFrame);
   av_frame_free(&m_pDecodedFrame);
   av_frame_free(&m_pFilterFrame);
@@ -564,6 +708,8 @@ bool CDVDVideoCodecFFmpeg::AddData(const DemuxPacket &packet)
   avpkt.pts = (packet.pts == DVD_NOPTS_VALUE) ? AV_NOPTS_VALUE : static_cast<int64_t>(packet.pts / DVD_TIME_BASE * AV_TIME_BASE);
   avpkt.side_data = static_cast<AVPacketSideData*>(packet.pSideData);
   avpkt.side_data_elems = packet.iSideDataElems;
+  // a reference counted packet is referenced by avcodec_send_packet instead of copied
+  avpkt.buf = static_cast<AVBufferRef*>(packet.pBufferRef);
 
   int ret = avcodec_send_packet(m_pCodecContext, &avpkt);
 
@@ -887,6 +1033,8 @@ void CDVDVideoCodecFFmpeg::Reset()
   m_filters = "";
   FilterClose();
   m_dropCtrl.Reset(false);
+  m_degradePressure = 0;
+  m_degradeCalm = 0;
 }
 
 void CDVDVideoCodecFFmpeg::Reopen()
@@ -1257,10 +1405,48 @@ bool CDVDVideoCodecFFmpeg::GetCodecStats(double &pts, int &droppedFrames, int &s
   return true;
 }
 
+void CDVDVideoCodecFFmpeg::UpdateDegradation(int flags)
+{
+  if (!m_started || (flags & (DVD_CODEC_CTRL_DRAIN | DVD_CODEC_CTRL_NO_POSTPROC)))
+    return;
+
+  double frameDuration = DVD_TIME_BASE / 25;
+  if (m_dropCtrl.m_state == CDropControl::VALID && m_dropCtrl.m_diffPTS > 0)
+    frameDuration = m_dropCtrl.m_diffPTS;
+  const int upFrames = std::max(1, static_cast<int>(DEGRADE_UP_SECONDS * DVD_TIME_BASE / frameDuration));
+  const int downFrames = std::max(1, static_cast<int>(DEGRADE_DOWN_SECONDS * DVD_TIME_BASE / frameDuration));
+
+  // the player hurries when the render queue is about to run dry and
+  // drops when pictures are late, both mean decoding can't keep up
+  if (flags & (DVD_CODEC_CTRL_HURRY | DVD_CODEC_CTRL_DROP_ANY))
+  {
+    m_degradeCalm = 0;
+    if (++m_degradePressure >= upFrames && m_degradeLevel < DEGRADE_MAX_LEVEL)
+    {
+      m_degradeLevel++;
+      m_degradePressure = 0;
+      CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg::UpdateDegradation - decoder can't keep up, level %d", m_degradeLevel);
+    }
+  }
+  else
+  {
+    m_degradePressure = 0;
+    if (++m_degradeCalm >= downFrames && m_degradeLevel > 0)
+    {
+      m_degradeLevel--;
+      m_degradeCalm = 0;
+      CLog::Log(LOGDEBUG, "CDVDVideoCodecFFmpeg::UpdateDegradation - decoder recovered, level %d", m_degradeLevel);
+    }
+  }
+}
+
 void CDVDVideoCodecFFmpeg::SetCodecControl(int flags)
 {
   m_codecControlFlags = flags;
 
+  if (m_pCodecContext && !m_pHardware)
+    UpdateDegradation(flags);
+
   if (m_pCodecContext)
   {
     bool bDrop = (flags & DVD_CODEC_CTRL_DROP_ANY) != 0;
@@ -1280,9 +1466,19 @@ void CDVDVideoCodecFFmpeg::SetCodecControl(int flags)
     }
     else
     {
+      AVDiscard skipLoopFilter = AVDISCARD_DEFAULT;
+      if (m_degradeLevel == 1)
+        skipLoopFilter = AVDISCARD_NONREF;
+      else if (m_degradeLevel >= 2)
+        skipLoopFilter = AVDISCARD_ALL;
+
+      int iSkipLoopFilter = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iSkipLoopFilter;
+      if (iSkipLoopFilter > skipLoopFilter)
+        skipLoopFilter = static_cast<AVDiscard>(iSkipLoopFilter);
+
       m_pCodecContext->skip_frame = AVDISCARD_DEFAULT;
       m_pCodecContext->skip_idct = AVDISCARD_DEFAULT;
-      m_pCodecContext->skip_loop_filter = AVDISCARD_DEFAULT;
+      m_pCodecContext->skip_loop_filter = skipLoopFilter;
     }
   }
 
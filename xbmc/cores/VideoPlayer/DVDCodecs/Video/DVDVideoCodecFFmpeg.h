@@ -12,6 +12,7 @@
 #include "cores/VideoPlayer/DVDStreamInfo.h"
 #include "DVDVideoCodec.h"
 #include "DVDVideoPPFFmpeg.h"
+#include <atomic>
 #include <string>
 #include <vector>
 
@@ -32,6 +33,7 @@ public:
   explicit CDVDVideoCodecFFmpeg(CProcessInfo &processInfo);
   ~CDVDVideoCodecFFmpeg() override;
   bool Open(CDVDStreamInfo &hints, CDVDCodecOptions &options) override;
+  bool Reconfigure(CDVDStreamInfo &hints) override;
   bool AddData(const DemuxPacket &packet) override;
   void Reset() override;
   void Reopen() override;
@@ -54,6 +56,8 @@ protected:
   CDVDVideoCodec::VCReturn FilterProcess(AVFrame* frame);
   void SetFilters();
   void UpdateName();
+  void SetupThreading(const AVCodec* codec);
+  void UpdateDegradation(int flags);
   bool SetPictureParams(VideoPicture* pVideoPicture);
 
   bool HasHardware() { return m_pHardware != nullptr; };
@@ -83,6 +87,8 @@ protected:
 
   std::string m_name;
   int m_decoderState;
+  bool m_threadBudgetTaken = false;
+  static std::atomic<int> m_threadedDecoders; // software decoders sharing the thread budget
   IHardwareDecoder *m_pHardware = nullptr;
   int m_iLastKeyframe = 0;
   double m_dts = DVD_NOPTS_VALUE;
@@ -94,6 +100,9 @@ protected:
   int m_droppedFrames = 0;
   bool m_requestSkipDeint = false;
   int m_codecControlFlags = 0;
+  int m_degradeLevel = 0; // steps of loop filter skipping while the renderer runs dry
+  int m_degradePressure = 0;
+  int m_degradeCalm = 0;
   bool m_interlaced = false;
   double m_DAR = 1.0;
   CDVDStreamInfo m_hints;
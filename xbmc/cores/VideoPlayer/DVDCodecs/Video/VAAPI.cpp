@@ -58,6 +58,44 @@ const std::string SETTING_VIDEOPLAYER_USEVAAPIVP8 = "videoplayer.usevaapivp8";
 const std::string SETTING_VIDEOPLAYER_USEVAAPIVP9 = "videoplayer.usevaapivp9";
 const std::string SETTING_VIDEOPLAYER_PREFERVAAPIRENDER = "videoplayer.prefervaapirender";
 
+// HEVC spec A.4.2: the DPB of a level holds more pictures the smaller they
+// are compared to the largest picture size of that level
+static uint32_t GetHevcMaxDpbSize(AVCodecContext *avctx)
+{
+  int64_t maxLumaPs;
+  if (avctx->level <= 0)
+    return 16;
+  else if (avctx->level <= 30)
+    maxLumaPs = 36864;
+  else if (avctx->level <= 60)
+    maxLumaPs = 122880;
+  else if (avctx->level <= 63)
+    maxLumaPs = 245760;
+  else if (avctx->level <= 90)
+    maxLumaPs = 552960;
+  else if (avctx->level <= 93)
+    maxLumaPs = 983040;
+  else if (avctx->level <= 123)
+    maxLumaPs = 2228224;
+  else if (avctx->level <= 156)
+    maxLumaPs = 8912896;
+  else
+    maxLumaPs = 35651584;
+
+  const int64_t picSize = static_cast<int64_t>(avctx->coded_width) * avctx->coded_height;
+  if (picSize <= (maxLumaPs >> 2))
+    return 16;
+  else if (picSize <= (maxLumaPs >> 1))
+    return 12;
+  else if (picSize <= ((3 * maxLumaPs) >> 2))
+    return 8;
+  else if (picSize <= maxLumaPs)
+    return 6;
+
+  // the stream doesn't fit its level, don't trust it
+  return 16;
+}
+
 void VAAPI::VaErrorCallback(void *user_context, const char *message)
 {
   CLog::Log(LOGERROR, "libva error: {}", message);
@@ -666,7 +704,7 @@ bool CDecoder::Open(AVCodecContext* avctx, AVCodecContext* mainctx, const enum A
       m_vaapiConfig.maxReferences = 5;
   }
   else if (avctx->codec_id == AV_CODEC_ID_HEVC)
-    m_vaapiConfig.maxReferences = 16;
+    m_vaapiConfig.maxReferences = GetHevcMaxDpbSize(avctx);
   else if (avctx->codec_id == AV_CODEC_ID_VP9)
     m_vaapiConfig.maxReferences = 8;
   else
@@ -676,6 +714,9 @@ bool CDecoder::Open(AVCodecContext* avctx, AVCodecContext* mainctx, const enum A
   // make ffmpeg require more buffers
   m_vaapiConfig.maxReferences += 6;
 
+  CLog::Log(LOGDEBUG, LOGVIDEO, "VAAPI - allocating %u surfaces for level %d", m_vaapiConfig.maxReferences,
+            avctx->level);
+
   if (!ConfigVAAPI())
   {
     return false;
@@ -8,6 +8,7 @@
 
 #include "DVDDemuxFFmpeg.h"
 
+#include <algorithm>
 #include <sstream>
 #include <utility>
 
@@ -15,8 +16,11 @@
 #include "cores/FFmpeg.h"
 #include "cores/VideoPlayer/Interface/Addon/TimingConstants.h" // for DVD_TIME_BASE
 #include "DVDDemuxUtils.h"
+#include "DemuxKeyframeIndex.h"
+#include "DemuxStreamInfoCache.h"
 #include "DVDInputStreams/DVDInputStream.h"
 #include "DVDInputStreams/DVDInputStreamFFmpeg.h"
+#include "DVDInputStreams/InputStreamPVRChannel.h"
 #include "ServiceBroker.h"
 #include "filesystem/CurlFile.h"
 #include "filesystem/Directory.h"
@@ -74,6 +78,13 @@ static const struct StereoModeConversionMap WmvToInternalStereoModeMap[] =
 
 #define FF_MAX_EXTRADATA_SIZE ((1 << 28) - AV_INPUT_BUFFER_PADDING_SIZE)
 
+// read size of the io context, live streams are read in small chunks to hand out data as soon as
+// it arrives, files in bigger ones and network files by about 100 ms of their bit rate
+#define FFMPEG_LIVE_BUFFER_SIZE 4096
+#define FFMPEG_FILE_BUFFER_SIZE 32768
+#define FFMPEG_NETWORK_BUFFER_SIZE 65536
+#define FFMPEG_MAX_BUFFER_SIZE (256 * 1024)
+
 std::string CDemuxStreamAudioFFmpeg::GetStreamName()
 {
   if (!m_stream)
@@ -182,6 +193,7 @@ CDVDDemuxFFmpeg::CDVDDemuxFFmpeg() : CDVDDemux()
   m_streaminfo = true; /* set to true if we want to look for streams before playback */
   m_checkvideo = false;
   m_dtsAtDisplayTime = DVD_NOPTS_VALUE;
+  m_zeroCopy = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoZeroCopyDemux;
 }
 
 CDVDDemuxFFmpeg::~CDVDDemuxFFmpeg()
@@ -190,6 +202,17 @@ CDVDDemuxFFmpeg::~CDVDDemuxFFmpeg()
   ff_flush_avutil_log_buffers();
 }
 
+DemuxPacket* CDVDDemuxFFmpeg::AllocatePacket(AVPacket& pkt)
+{
+  if (m_zeroCopy)
+  {
+    DemuxPacket* packet = CDVDDemuxUtils::AllocateDemuxPacketRef(&pkt);
+    if (packet)
+      return packet;
+  }
+  return CDVDDemuxUtils::AllocateDemuxPacket(pkt.size);
+}
+
 bool CDVDDemuxFFmpeg::Aborted()
 {
   if (m_timeout.IsTimePast())
@@ -220,6 +243,28 @@ bool CDVDDemuxFFmpeg::Open(std::shared_ptr<CDVDInputStream> pInput, bool streami
   m_pInput = pInput;
   strFile = m_pInput->GetFileName();
 
+  // a channel tuned before starts with the stream parameters seen back then instead of
+  // analysing the stream again
+  m_streamInfoKey.clear();
+  if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bPVRFastZap)
+  {
+    std::shared_ptr<CInputStreamPVRChannel> channel = std::dynamic_pointer_cast<CInputStreamPVRChannel>(m_pInput);
+    if (channel)
+      m_streamInfoKey = channel->GetStreamInfoKey();
+
+    if (!m_streamInfoKey.empty() && CDemuxStreamInfoCache::GetInstance().Contains(m_streamInfoKey))
+    {
+      CLog::Log(LOGDEBUG, "CDVDDemuxFFmpeg::Open - using stream parameters of %s", m_streamInfoKey.c_str());
+      m_streaminfo = false;
+    }
+  }
+
+  // a file played before is opened with what was learned about it back then, file info doesn't
+  // guess the frame rates and would remember them as unknown
+  if (m_streamInfoKey.empty() && !fileinfo && m_pInput->IsStreamType(DVDSTREAM_TYPE_FILE) &&
+      !m_pInput->IsRealtime() && m_pInput->GetLength() > 0)
+    m_streamInfoKey = StringUtils::Format("file:%lld:%s", static_cast<long long>(m_pInput->GetLength()), strFile.c_str());
+
   if (m_pInput->GetContent().length() > 0)
   {
     std::string content = m_pInput->GetContent();
@@ -298,7 +343,19 @@ bool CDVDDemuxFFmpeg::Open(std::shared_ptr<CDVDInputStream> pInput, bool streami
     {
       seekable = false;
     }
-    int bufferSize = 4096;
+    int bufferSize = FFMPEG_LIVE_BUFFER_SIZE;
+    if (seekable && m_pInput->IsStreamType(DVDSTREAM_TYPE_FILE) && !m_pInput->IsRealtime())
+    {
+      bufferSize = FFMPEG_FILE_BUFFER_SIZE;
+      if (URIUtils::IsRemote(strFile))
+      {
+        int64_t bitRate = 0;
+        if (!m_streamInfoKey.empty())
+          bitRate = CDemuxStreamInfoCache::GetInstance().GetBitRate(m_streamInfoKey);
+        bufferSize = static_cast<int>(std::min<int64_t>(
+            std::max<int64_t>(bitRate / 8 / 10, FFMPEG_NETWORK_BUFFER_SIZE), FFMPEG_MAX_BUFFER_SIZE));
+      }
+    }
     int blockSize = m_pInput->GetBlockSize();
 
     if (blockSize > 1 && seekable) // non seakable input streams are not supposed to set block size
@@ -481,12 +538,31 @@ bool CDVDDemuxFFmpeg::Open(std::shared_ptr<CDVDInputStream> pInput, bool streami
   m_bAVI = strcmp(m_pFormatContext->iformat->name, "avi") == 0;
   m_bSup = strcmp(m_pFormatContext->iformat->name, "sup") == 0;
 
-  if (m_streaminfo)
+  // matroska and mp4 headers describe all streams, what only the stream info analysis finds out,
+  // like the frame rates, is known from the last playback of the file
+  bool skipStreamInfo = false;
+  if (m_streaminfo && !m_streamInfoKey.empty() && m_pInput->IsStreamType(DVDSTREAM_TYPE_FILE) &&
+      (m_bMatroska || strcmp(m_pFormatContext->iformat->name, "mov,mp4,m4a,3gp,3g2,mj2") == 0) &&
+      m_pFormatContext->nb_streams > 0 &&
+      CDemuxStreamInfoCache::GetInstance().Covers(m_streamInfoKey, m_pFormatContext))
+  {
+    CLog::Log(LOGDEBUG, "%s - using stream parameters of the last playback", __FUNCTION__);
+    skipStreamInfo = true;
+    CDemuxStreamInfoCache::GetInstance().ApplyTimings(m_streamInfoKey, m_pFormatContext);
+    for (unsigned int i = 0; i < m_pFormatContext->nb_streams; i++)
+      CDemuxStreamInfoCache::GetInstance().Apply(m_streamInfoKey, m_pFormatContext->streams[i]);
+  }
+
+  if (m_streaminfo && !skipStreamInfo)
   {
     /* to speed up dvd switches, only analyse very short */
     if (m_pInput->IsStreamType(DVDSTREAM_TYPE_DVD))
       av_opt_set_int(m_pFormatContext, "analyzeduration", 500000, 0);
 
+    // file info doesn't need the frame rate, guessing it takes reading a lot of frames
+    if (fileinfo)
+      av_opt_set_int(m_pFormatContext, "fpsprobesize", 0, 0);
+
     CLog::Log(LOGDEBUG, "%s - avformat_find_stream_info starting", __FUNCTION__);
     int iErr = avformat_find_stream_info(m_pFormatContext, NULL);
     if (iErr < 0)
@@ -517,7 +593,7 @@ bool CDVDDemuxFFmpeg::Open(std::shared_ptr<CDVDInputStream> pInput, bool streami
       ResetVideoStreams();
     }
   }
-  else
+  else if (!m_streaminfo)
   {
     m_program = 0;
     m_checkvideo = true;
@@ -607,6 +683,19 @@ bool CDVDDemuxFFmpeg::Open(std::shared_ptr<CDVDInputStream> pInput, bool streami
     m_pFormatContext->duration = duration;
   }
 
+  // files of these formats have no index, they are seeked by bisecting them, so the
+  // keyframes seen when they were played before are used instead
+  if (!m_keyframeIndex && m_pInput->IsStreamType(DVDSTREAM_TYPE_FILE) && !m_pInput->IsRealtime() &&
+      m_pInput->GetLength() > 0 && m_pFormatContext->iformat &&
+      !(m_pFormatContext->iformat->flags & AVFMT_NO_BYTE_SEEK) &&
+      (strcmp(m_pFormatContext->iformat->name, "mpegts") == 0 ||
+       strcmp(m_pFormatContext->iformat->name, "mpeg") == 0 || m_bAVI))
+  {
+    m_keyframeIndexPath = m_pInput->GetFileName();
+    m_keyframeIndex.reset(new CDemuxKeyframeIndex(m_pInput->GetLength()));
+    m_keyframeIndex->Load(m_keyframeIndexPath);
+  }
+
   // seems to be a bug in ffmpeg, hls jumps back to start after a couple of seconds
   // this cures the issue
   if (m_pFormatContext->iformat && strcmp(m_pFormatContext->iformat->name, "hls,applehttp") == 0)
@@ -622,6 +711,15 @@ void CDVDDemuxFFmpeg::Dispose()
   m_pkt.result = -1;
   av_packet_unref(&m_pkt.pkt);
 
+  if (m_pFormatContext && !m_streamInfoKey.empty())
+    CDemuxStreamInfoCache::GetInstance().Store(m_streamInfoKey, m_pFormatContext);
+
+  if (m_keyframeIndex)
+  {
+    m_keyframeIndex->Save(m_keyframeIndexPath);
+    m_keyframeIndex.reset();
+  }
+
   if (m_pFormatContext)
   {
     if (m_ioContext && m_pFormatContext->pb && m_pFormatContext->pb != m_ioContext)
@@ -1007,7 +1105,7 @@ DemuxPacket* CDVDDemuxFFmpeg::Read()
           {
             if (m_pkt.pkt.stream_index == (int)m_pFormatContext->programs[m_program]->stream_index[i])
             {
-              pPacket = CDVDDemuxUtils::AllocateDemuxPacket(m_pkt.pkt.size);
+              pPacket = AllocatePacket(m_pkt.pkt);
               break;
             }
           }
@@ -1016,7 +1114,7 @@ DemuxPacket* CDVDDemuxFFmpeg::Read()
             bReturnEmpty = true;
         }
         else
-          pPacket = CDVDDemuxUtils::AllocateDemuxPacket(m_pkt.pkt.size);
+          pPacket = AllocatePacket(m_pkt.pkt);
       }
       else
         bReturnEmpty = true;
@@ -1030,11 +1128,10 @@ DemuxPacket* CDVDDemuxFFmpeg::Read()
           m_pkt.pkt.pts = AV_NOPTS_VALUE;
         }
 
-        // copy contents into our own packet
+        // copy contents into our own packet, unless it references the ffmpeg buffer
         pPacket->iSize = m_pkt.pkt.size;
 
-        // maybe we can avoid a memcpy here by detecting where pkt.destruct is pointing too?
-        if (m_pkt.pkt.data)
+        if (!pPacket->pBufferRef && m_pkt.pkt.data)
           memcpy(pPacket->pData, m_pkt.pkt.data, pPacket->iSize);
 
         pPacket->pts = ConvertTimestamp(m_pkt.pkt.pts, stream->time_base.den, stream->time_base.num);
@@ -1066,6 +1163,10 @@ DemuxPacket* CDVDDemuxFFmpeg::Read()
         if (pPacket->dts != DVD_NOPTS_VALUE && (pPacket->dts > m_currentPts || m_currentPts == DVD_NOPTS_VALUE))
           m_currentPts = pPacket->dts;
 
+        if (m_keyframeIndex && (m_pkt.pkt.flags & AV_PKT_FLAG_KEY) && m_pkt.pkt.pos >= 0 &&
+            pPacket->dts != DVD_NOPTS_VALUE && stream->codecpar->codec_type == AVMEDIA_TYPE_VIDEO)
+          m_keyframeIndex->Add(DVD_TIME_TO_MSEC(pPacket->dts), m_pkt.pkt.pos);
+
         // store internal id until we know the continuous id presented to player
         // the stream might not have been created yet
         pPacket->iStreamId = m_pkt.pkt.stream_index;
@@ -1194,10 +1295,21 @@ bool CDVDDemuxFFmpeg::SeekTime(double time, bool backwards, double* startpts)
   else if (m_pFormatContext->start_time != (int64_t)AV_NOPTS_VALUE && !ismp3 && !m_bSup)
     seek_pts += m_pFormatContext->start_time;
 
-  int ret;
+  int64_t keyframePos = -1;
+  if (m_keyframeIndex && !m_keyframeIndex->Find(time, keyframePos))
+    keyframePos = -1;
+
+  int ret = -1;
   {
     CSingleLock lock(m_critSection);
-    ret = av_seek_frame(m_pFormatContext, m_seekStream, seek_pts, backwards ? AVSEEK_FLAG_BACKWARD : 0);
+    bool onKeyframe = false;
+    if (keyframePos >= 0)
+    {
+      ret = av_seek_frame(m_pFormatContext, -1, keyframePos, AVSEEK_FLAG_BYTE);
+      onKeyframe = (ret >= 0);
+    }
+    if (ret < 0)
+      ret = av_seek_frame(m_pFormatContext, m_seekStream, seek_pts, backwards ? AVSEEK_FLAG_BACKWARD : 0);
 
     if (ret < 0)
     {
@@ -1225,7 +1337,7 @@ bool CDVDDemuxFFmpeg::SeekTime(double time, bool backwards, double* startpts)
 
     if (ret >= 0)
     {
-      if (m_pFormatContext->iformat->read_seek)
+      if (m_pFormatContext->iformat->read_seek || onKeyframe)
         m_seekToKeyFrame = true;
 
       UpdateCurrentPTS();
@@ -1469,6 +1581,9 @@ CDemuxStream* CDVDDemuxFFmpeg::AddStream(int streamIdx)
   AVStream* pStream = m_pFormatContext->streams[streamIdx];
   if (pStream && pStream->discard != AVDISCARD_ALL)
   {
+    if (!m_streamInfoKey.empty())
+      CDemuxStreamInfoCache::GetInstance().Apply(m_streamInfoKey, pStream);
+
     // Video (mp4) from GoPro cameras can have a 'meta' track used for a file repair containing
     // 'fdsc' data, this is also called the SOS track.
     if (pStream->codecpar->codec_tag == MKTAG('f','d','s','c'))
@@ -2154,6 +2269,10 @@ bool CDVDDemuxFFmpeg::IsVideoReady()
       st = m_pFormatContext->streams[idx];
       if (st->codecpar->codec_type == AVMEDIA_TYPE_VIDEO)
       {
+        // the sequence headers of the last tune let us start before the next keyframe
+        if (!st->codecpar->extradata && !m_streamInfoKey.empty())
+          CDemuxStreamInfoCache::GetInstance().Apply(m_streamInfoKey, st);
+
         if (st->codecpar->extradata)
         {
           if (!m_startTime)
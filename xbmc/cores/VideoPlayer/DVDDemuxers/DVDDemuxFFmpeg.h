@@ -19,6 +19,7 @@ extern "C" {
 #include <libavformat/avformat.h>
 }
 
+class CDemuxKeyframeIndex;
 class CDVDDemuxFFmpeg;
 class CURL;
 
@@ -117,6 +118,7 @@ protected:
   void CreateStreams(unsigned int program = UINT_MAX);
   void DisposeStreams();
   void ParsePacket(AVPacket* pkt);
+  DemuxPacket* AllocatePacket(AVPacket& pkt);
   bool IsVideoReady();
   void ResetVideoStreams();
   AVDictionary* GetFFMpegOptionsFromInput();
@@ -165,5 +167,9 @@ protected:
   double m_dtsAtDisplayTime;
   bool m_seekToKeyFrame = false;
   double m_startTime = 0;
+  bool m_zeroCopy = false; // hand out references to the ffmpeg packet buffers instead of copies
+  std::string m_streamInfoKey; // key of the stream parameters remembered for fast channel switches
+  std::unique_ptr<CDemuxKeyframeIndex> m_keyframeIndex; // for formats seeked by bisection
+  std::string m_keyframeIndexPath;
 };
 
@@ -7,6 +7,7 @@
  */
 
 #include "DVDDemuxUtils.h"
+#include "DemuxPacketPool.h"
 #include "cores/VideoPlayer/Interface/Addon/DemuxCrypto.h"
 #include "utils/log.h"
 #include "utils/MemUtils.h"
@@ -19,8 +20,13 @@ void CDVDDemuxUtils::FreeDemuxPacket(DemuxPacket* pPacket)
 {
   if (pPacket)
   {
-    if (pPacket->pData)
-      KODI::MEMORY::AlignedFree(pPacket->pData);
+    if (pPacket->pBufferRef)
+    {
+      AVBufferRef* buffer = static_cast<AVBufferRef*>(pPacket->pBufferRef);
+      av_buffer_unref(&buffer);
+    }
+    else if (pPacket->pData)
+      CDemuxPacketPool::GetInstance().FreeData(pPacket->pData);
     if (pPacket->iSideDataElems)
     {
       AVPacket avPkt;
@@ -29,13 +35,13 @@ void CDVDDemuxUtils::FreeDemuxPacket(DemuxPacket* pPacket)
       avPkt.side_data_elems = pPacket->iSideDataElems;
       av_packet_free_side_data(&avPkt);
     }
-    delete pPacket;
+    CDemuxPacketPool::GetInstance().FreePacket(pPacket);
   }
 }
 
 DemuxPacket* CDVDDemuxUtils::AllocateDemuxPacket(int iDataSize)
 {
-  DemuxPacket* pPacket = new DemuxPacket();
+  DemuxPacket* pPacket = CDemuxPacketPool::GetInstance().AllocatePacket();
 
   if (iDataSize > 0)
   {
@@ -48,7 +54,7 @@ DemuxPacket* CDVDDemuxUtils::AllocateDemuxPacket(int iDataSize)
      * Note, if the first 23 bits of the additional bytes are not 0 then damaged
      * MPEG bitstreams could cause overread and segfault
      */
-    pPacket->pData = static_cast<uint8_t*>(KODI::MEMORY::AlignedMalloc(iDataSize + AV_INPUT_BUFFER_PADDING_SIZE, 16));
+    pPacket->pData = CDemuxPacketPool::GetInstance().AllocateData(iDataSize, AV_INPUT_BUFFER_PADDING_SIZE);
     if (!pPacket->pData)
     {
       FreeDemuxPacket(pPacket);
@@ -70,6 +76,26 @@ DemuxPacket* CDVDDemuxUtils::AllocateDemuxPacket(unsigned int iDataSize, unsigne
   return ret;
 }
 
+DemuxPacket* CDVDDemuxUtils::AllocateDemuxPacketRef(AVPacket* src)
+{
+  // only reference buffers that carry the padding the decoders rely on
+  AVBufferRef* buffer = src->buf;
+  if (!buffer || !src->data || src->size <= 0 ||
+      src->data < buffer->data ||
+      src->data + src->size + AV_INPUT_BUFFER_PADDING_SIZE > buffer->data + buffer->size)
+    return nullptr;
+
+  AVBufferRef* ref = av_buffer_ref(buffer);
+  if (!ref)
+    return nullptr;
+
+  DemuxPacket* pPacket = CDemuxPacketPool::GetInstance().AllocatePacket();
+  pPacket->pBufferRef = ref;
+  pPacket->pData = src->data;
+  pPacket->iSize = src->size;
+  return pPacket;
+}
+
 void CDVDDemuxUtils::StoreSideData(DemuxPacket *pkt, AVPacket *src)
 {
   AVPacket avPkt;
@@ -78,3 +104,17 @@ void CDVDDemuxUtils::StoreSideData(DemuxPacket *pkt, AVPacket *src)
   pkt->pSideData = avPkt.side_data;
   pkt->iSideDataElems = avPkt.side_data_elems;
 }
+
+void CDVDDemuxUtils::TrimDemuxPacketPool()
+{
+  CDemuxPacketPool::GetInstance().Trim();
+}
+
+void CDVDDemuxUtils::GetDemuxPacketPoolInfo(SDemuxPacketPoolInfo& info)
+{
+  CDemuxPacketPool::Stats stats = CDemuxPacketPool::GetInstance().GetStats();
+  info.allocations = stats.allocations;
+  info.hits = stats.hits;
+  info.cachedBytes = stats.cachedBytes;
+  info.usedBytes = stats.usedBytes;
+}
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "cores/DataCacheCore.h"
 #include "cores/VideoPlayer/Interface/Addon/DemuxPacket.h"
 extern "C" {
 #include <libavcodec/avcodec.h>
@@ -19,6 +20,18 @@ public:
   static void FreeDemuxPacket(DemuxPacket* pPacket);
   static DemuxPacket* AllocateDemuxPacket(int iDataSize = 0);
   static DemuxPacket* AllocateDemuxPacket(unsigned int iDataSize, unsigned int encryptedSubsampleCount);
+
+  /*!
+   * \brief Create a packet that references the payload of src instead of copying it
+   * \return the packet or nullptr if src is not reference counted or lacks padding
+   */
+  static DemuxPacket* AllocateDemuxPacketRef(AVPacket* src);
   static void StoreSideData(DemuxPacket *pkt, AVPacket *src);
+
+  /*!
+   * \brief Packets are recycled through a pool, release the memory it holds
+   */
+  static void TrimDemuxPacketPool();
+  static void GetDemuxPacketPoolInfo(SDemuxPacketPoolInfo& info);
 };
 
@@ -0,0 +1,124 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DemuxKeyframeIndex.h"
+
+#include "utils/JobManager.h"
+#include "utils/StringUtils.h"
+#include "video/VideoDatabase.h"
+
+#include <cstdlib>
+#include <iterator>
+
+// a keyframe closer than this to one already noted is skipped
+#define KEYFRAME_INDEX_SPACING_MS 1000
+// seeking further than this from the last noted keyframe would decode too much
+#define KEYFRAME_INDEX_MAX_GAP_MS 10000
+// an index with fewer keyframes isn't worth a database write
+#define KEYFRAME_INDEX_MIN_ENTRIES 10
+
+CDemuxKeyframeIndex::CDemuxKeyframeIndex(int64_t fileSize)
+  : m_fileSize(fileSize)
+{
+}
+
+void CDemuxKeyframeIndex::Add(double time, int64_t pos)
+{
+  if (time < 0 || pos < 0)
+    return;
+
+  const int ms = static_cast<int>(time);
+  auto next = m_keyframes.lower_bound(ms);
+  if (next != m_keyframes.end() && next->first - ms < KEYFRAME_INDEX_SPACING_MS)
+    return;
+  if (next != m_keyframes.begin() && ms - std::prev(next)->first < KEYFRAME_INDEX_SPACING_MS)
+    return;
+
+  m_keyframes.emplace_hint(next, ms, pos);
+  m_modified = true;
+}
+
+bool CDemuxKeyframeIndex::Find(double time, int64_t& pos) const
+{
+  auto keyframe = m_keyframes.upper_bound(static_cast<int>(time));
+  if (keyframe == m_keyframes.begin())
+    return false;
+
+  --keyframe;
+  if (time - keyframe->first > KEYFRAME_INDEX_MAX_GAP_MS)
+    return false;
+
+  pos = keyframe->second;
+  return true;
+}
+
+void CDemuxKeyframeIndex::Load(const std::string& path)
+{
+  CVideoDatabase db;
+  if (!db.Open())
+    return;
+
+  std::string data;
+  if (db.GetKeyframeIndex(path, data))
+    Deserialize(data);
+  db.Close();
+}
+
+void CDemuxKeyframeIndex::Save(const std::string& path)
+{
+  if (!m_modified || m_keyframes.size() < KEYFRAME_INDEX_MIN_ENTRIES)
+    return;
+
+  m_modified = false;
+  const std::string data = Serialize();
+  CJobManager::GetInstance().Submit([path, data]()
+  {
+    CVideoDatabase db;
+    if (db.Open())
+    {
+      db.SetKeyframeIndex(path, data);
+      db.Close();
+    }
+  });
+}
+
+std::string CDemuxKeyframeIndex::Serialize() const
+{
+  // <file size>;<time>:<pos>,<time>:<pos>,...
+  std::string data = StringUtils::Format("%lld;", static_cast<long long>(m_fileSize));
+  for (const auto& keyframe : m_keyframes)
+    data += StringUtils::Format("%d:%lld,", keyframe.first, static_cast<long long>(keyframe.second));
+  return data;
+}
+
+bool CDemuxKeyframeIndex::Deserialize(const std::string& data)
+{
+  const char* cur = data.c_str();
+  char* end;
+  if (std::strtoll(cur, &end, 10) != m_fileSize || *end != ';')
+    return false;
+
+  std::map<int, int64_t> keyframes;
+  cur = end + 1;
+  while (*cur)
+  {
+    const long time = std::strtol(cur, &end, 10);
+    if (end == cur || *end != ':')
+      return false;
+    cur = end + 1;
+    const long long pos = std::strtoll(cur, &end, 10);
+    if (end == cur || *end != ',')
+      return false;
+    cur = end + 1;
+    keyframes.emplace(static_cast<int>(time), static_cast<int64_t>(pos));
+  }
+
+  m_keyframes = std::move(keyframes);
+  m_modified = false;
+  return true;
+}
@@ -0,0 +1,73 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <string>
+
+/*!
+ * \brief Byte positions of the video keyframes of a file seen while demuxing it.
+ *
+ * Formats without an index, like MPEG-TS recordings or AVIs without idx1, are seeked by
+ * bisecting the file, which takes several reads per seek over the network. The demuxer notes
+ * where the keyframes it reads start and seeks straight to the closest one instead. The index
+ * is kept in the video database, so it speeds up every later playback of the file as well as
+ * the thumbnail and chapter extraction.
+ */
+class CDemuxKeyframeIndex
+{
+public:
+  /*!
+   * \param fileSize Size of the file, an index stored for another size is not used
+   */
+  explicit CDemuxKeyframeIndex(int64_t fileSize);
+
+  /*!
+   * \brief Note a keyframe
+   * \param time Time of the keyframe in ms
+   * \param pos Byte position of the packet of the keyframe
+   */
+  void Add(double time, int64_t pos);
+
+  /*!
+   * \brief Find the last keyframe up to the given time
+   *
+   * Parts of the file which have not been demuxed yet are not covered, so a keyframe is only
+   * returned if it is close enough to the given time.
+   *
+   * \param time Time to seek to in ms
+   * \param pos [out] Byte position of the keyframe
+   * \return true if a keyframe was found
+   */
+  bool Find(double time, int64_t& pos) const;
+
+  /*!
+   * \brief Whether keyframes were added since the index was loaded or saved
+   */
+  bool IsModified() const { return m_modified; }
+
+  /*!
+   * \brief Load the index stored for the given file
+   */
+  void Load(const std::string& path);
+
+  /*!
+   * \brief Store the index of the given file in the background if it was modified
+   */
+  void Save(const std::string& path);
+
+  std::string Serialize() const;
+  bool Deserialize(const std::string& data);
+
+private:
+  int64_t m_fileSize;
+  std::map<int, int64_t> m_keyframes; // time in ms -> byte position
+  bool m_modified = false;
+};
@@ -13,6 +13,8 @@
 #include "DVDInputStreams/DVDInputStream.h"
 #include "Util.h"
 #include "cores/VideoPlayer/Interface/Addon/TimingConstants.h"
+#include "threads/SingleLock.h"
+#include "utils/JobManager.h"
 #include "utils/log.h"
 
 
@@ -31,6 +33,13 @@ void CDemuxMultiSource::Abort()
 
 void CDemuxMultiSource::Dispose()
 {
+  {
+    CSingleLock lock(m_pending->section);
+    m_pending->disposed = true;
+    m_pending->ready.clear();
+    m_pending->hasReady = false;
+  }
+
   while (!m_demuxerQueue.empty())
   {
     m_demuxerQueue.pop();
@@ -119,7 +128,7 @@ bool CDemuxMultiSource::Open(std::shared_ptr<CDVDInputStream> pInput)
   if (!pInput)
     return false;
 
-  m_pInput = std::dynamic_pointer_cast<InputStreamMultiStreams>(pInput);
+  m_pInput = std::dynamic_pointer_cast<CInputStreamMultiSource>(pInput);
 
   if (!m_pInput)
     return false;
@@ -134,17 +143,71 @@ bool CDemuxMultiSource::Open(std::shared_ptr<CDVDInputStream> pInput)
     }
     else
     {
-      SetMissingStreamDetails(demuxer);
-
-      m_demuxerMap[demuxer->GetDemuxerId()] = demuxer;
-      m_DemuxerToInputStreamMap[demuxer] = *iter;
-      m_demuxerQueue.push(std::make_pair(-1.0, demuxer));
+      AddDemuxer(demuxer, *iter, -1.0);
       ++iter;
     }
   }
   return !m_demuxerMap.empty();
 }
 
+void CDemuxMultiSource::AddDemuxer(DemuxPtr demuxer, InputStreamPtr input, double readTime)
+{
+  SetMissingStreamDetails(demuxer);
+
+  m_demuxerMap[demuxer->GetDemuxerId()] = demuxer;
+  m_DemuxerToInputStreamMap[demuxer] = input;
+  m_demuxerQueue.push(std::make_pair(readTime, demuxer));
+}
+
+void CDemuxMultiSource::OpenSources()
+{
+  std::shared_ptr<SPendingDemuxers> pending = m_pending;
+  for (auto& input : m_pInput->GetOpenedSources())
+  {
+    CJobManager::GetInstance().Submit([pending, input]()
+    {
+      DemuxPtr demuxer = DemuxPtr(CDVDFactoryDemuxer::CreateDemuxer(input));
+      if (!demuxer)
+        return;
+
+      CSingleLock lock(pending->section);
+      if (pending->disposed)
+        return;
+      pending->ready.emplace_back(demuxer, input);
+      pending->hasReady = true;
+    }, CJob::PRIORITY_HIGH);
+  }
+}
+
+bool CDemuxMultiSource::AttachSources()
+{
+  if (!m_pending->hasReady)
+    return false;
+
+  std::vector<std::pair<DemuxPtr, InputStreamPtr>> ready;
+  {
+    CSingleLock lock(m_pending->section);
+    ready.swap(m_pending->ready);
+    m_pending->hasReady = false;
+  }
+
+  for (auto& source : ready)
+  {
+    DemuxPtr demuxer = source.first;
+    double readTime = -1.0;
+    if (m_readTime != DVD_NOPTS_VALUE && m_readTime > 0)
+    {
+      if (demuxer->SeekTime(DVD_TIME_TO_MSEC(m_readTime)))
+        readTime = m_readTime;
+    }
+
+    CLog::Log(LOGDEBUG, "%s - Adding demuxer for file %s", __FUNCTION__,
+              CURL::GetRedacted(demuxer->GetFileName()).c_str());
+    AddDemuxer(demuxer, source.second, readTime);
+  }
+  return true;
+}
+
 bool CDemuxMultiSource::Reset()
 {
   bool ret = true;
@@ -158,6 +221,16 @@ bool CDemuxMultiSource::Reset()
 
 DemuxPacket* CDemuxMultiSource::Read()
 {
+  OpenSources();
+  if (AttachSources())
+  {
+    // let the player pick up the streams of the new sources
+    DemuxPacket* packet = CDVDDemuxUtils::AllocateDemuxPacket(0);
+    packet->iStreamId = DMX_SPECIALID_STREAMCHANGE;
+    packet->demuxerId = m_demuxerId;
+    return packet;
+  }
+
   if (m_demuxerQueue.empty())
     return NULL;
 
@@ -176,6 +249,8 @@ DemuxPacket* CDemuxMultiSource::Read()
     else
       readTime = packet->pts;
     m_demuxerQueue.push(std::make_pair(readTime, currentDemuxer));
+    if (readTime != DVD_NOPTS_VALUE)
+      m_readTime = readTime;
   }
   else
   {
@@ -213,6 +288,7 @@ bool CDemuxMultiSource::SeekTime(double time, bool backwards, double* startpts)
     }
   }
   m_demuxerQueue = demuxerQueue;
+  m_readTime = DVD_MSEC_TO_TIME(time);
   return ret;
 }
 
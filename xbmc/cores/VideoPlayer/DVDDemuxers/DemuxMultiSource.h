@@ -10,8 +10,12 @@
 
 #include "DVDDemux.h"
 #include "DVDInputStreams/InputStreamMultiSource.h"
+#include "cores/VideoPlayer/Interface/Addon/TimingConstants.h"
+#include "threads/CriticalSection.h"
 
+#include <atomic>
 #include <map>
+#include <memory>
 #include <queue>
 #include <string>
 #include <utility>
@@ -56,9 +60,32 @@ protected:
 private:
   void Dispose();
   void SetMissingStreamDetails(DemuxPtr demuxer);
+  void AddDemuxer(DemuxPtr demuxer, InputStreamPtr input, double readTime);
 
-  std::shared_ptr<InputStreamMultiStreams> m_pInput = NULL;
+  /*!
+   \brief Create demuxers for sources the input stream opened meanwhile, in the background
+   */
+  void OpenSources();
+
+  /*!
+   \brief Add the demuxers created meanwhile, positioned where playback is
+   \return true if any was added
+   */
+  bool AttachSources();
+
+  // shared with the jobs creating the demuxers, they may outlive us
+  struct SPendingDemuxers
+  {
+    CCriticalSection section;
+    std::vector<std::pair<DemuxPtr, InputStreamPtr>> ready;
+    std::atomic<bool> hasReady{false};
+    bool disposed = false;
+  };
+
+  std::shared_ptr<CInputStreamMultiSource> m_pInput = NULL;
   std::map<DemuxPtr, InputStreamPtr> m_DemuxerToInputStreamMap;
   DemuxQueue m_demuxerQueue;
   std::map<int64_t, DemuxPtr> m_demuxerMap;
+  std::shared_ptr<SPendingDemuxers> m_pending = std::make_shared<SPendingDemuxers>();
+  double m_readTime = DVD_NOPTS_VALUE; // dts of the last packet read
 };
@@ -0,0 +1,176 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DemuxPacketPool.h"
+
+#include "cores/VideoPlayer/Interface/Addon/DemuxPacket.h"
+#include "threads/SingleLock.h"
+#include "utils/MemUtils.h"
+
+namespace
+{
+// stored in front of every payload buffer, keeps the payload 16 byte aligned
+struct BufferHeader
+{
+  uint32_t sizeClass;
+  uint32_t reserved;
+  uint64_t bytes;
+};
+static_assert(sizeof(BufferHeader) == 16, "payload alignment depends on the header size");
+
+BufferHeader* GetHeader(uint8_t* data)
+{
+  return reinterpret_cast<BufferHeader*>(data - sizeof(BufferHeader));
+}
+}
+
+CDemuxPacketPool& CDemuxPacketPool::GetInstance()
+{
+  static CDemuxPacketPool pool;
+  return pool;
+}
+
+CDemuxPacketPool::~CDemuxPacketPool()
+{
+  Trim();
+}
+
+unsigned int CDemuxPacketPool::GetSizeClass(size_t size)
+{
+  for (unsigned int sizeClass = 0; sizeClass < NUM_CLASSES; sizeClass++)
+  {
+    if (size <= (static_cast<size_t>(1) << (sizeClass + MIN_CLASS_SHIFT)))
+      return sizeClass;
+  }
+  return NO_CLASS;
+}
+
+DemuxPacket* CDemuxPacketPool::AllocatePacket()
+{
+  {
+    CSingleLock lock(m_section);
+    if (!m_freePackets.empty())
+    {
+      DemuxPacket* packet = m_freePackets.back();
+      m_freePackets.pop_back();
+      return packet;
+    }
+  }
+  return new DemuxPacket();
+}
+
+void CDemuxPacketPool::FreePacket(DemuxPacket* packet)
+{
+  // reset outside of the lock, this drops the crypto info
+  *packet = DemuxPacket();
+
+  {
+    CSingleLock lock(m_section);
+    if (m_freePackets.size() < MAX_CACHED_PACKETS)
+    {
+      m_freePackets.push_back(packet);
+      return;
+    }
+  }
+  delete packet;
+}
+
+uint8_t* CDemuxPacketPool::AllocateData(size_t size, size_t padding)
+{
+  const unsigned int sizeClass = GetSizeClass(size + padding);
+  const uint64_t bytes = sizeClass == NO_CLASS ? size + padding
+                                                : static_cast<uint64_t>(1) << (sizeClass + MIN_CLASS_SHIFT);
+
+  m_allocations++;
+  m_usedBytes += bytes;
+
+  if (sizeClass != NO_CLASS)
+  {
+    CSingleLock lock(m_section);
+    std::vector<uint8_t*>& buffers = m_freeBuffers[sizeClass];
+    if (!buffers.empty())
+    {
+      uint8_t* data = buffers.back();
+      buffers.pop_back();
+      m_cachedBytes -= bytes;
+      m_hits++;
+      return data;
+    }
+  }
+
+  uint8_t* block = static_cast<uint8_t*>(KODI::MEMORY::AlignedMalloc(sizeof(BufferHeader) + bytes, 16));
+  if (!block)
+  {
+    m_usedBytes -= bytes;
+    return nullptr;
+  }
+
+  uint8_t* data = block + sizeof(BufferHeader);
+  BufferHeader* header = GetHeader(data);
+  header->sizeClass = sizeClass;
+  header->reserved = 0;
+  header->bytes = bytes;
+  return data;
+}
+
+void CDemuxPacketPool::FreeData(uint8_t* data)
+{
+  if (!data)
+    return;
+
+  BufferHeader* header = GetHeader(data);
+  m_usedBytes -= header->bytes;
+
+  if (header->sizeClass != NO_CLASS)
+  {
+    CSingleLock lock(m_section);
+    if (m_cachedBytes + header->bytes <= MAX_CACHED_BYTES)
+    {
+      m_freeBuffers[header->sizeClass].push_back(data);
+      m_cachedBytes += header->bytes;
+      return;
+    }
+  }
+
+  KODI::MEMORY::AlignedFree(header);
+}
+
+void CDemuxPacketPool::Trim()
+{
+  std::array<std::vector<uint8_t*>, NUM_CLASSES> buffers;
+  std::vector<DemuxPacket*> packets;
+
+  {
+    CSingleLock lock(m_section);
+    buffers.swap(m_freeBuffers);
+    packets.swap(m_freePackets);
+    m_cachedBytes = 0;
+  }
+
+  for (auto& sizeClass : buffers)
+  {
+    for (uint8_t* data : sizeClass)
+      KODI::MEMORY::AlignedFree(GetHeader(data));
+  }
+
+  for (DemuxPacket* packet : packets)
+    delete packet;
+}
+
+CDemuxPacketPool::Stats CDemuxPacketPool::GetStats() const
+{
+  Stats stats;
+  stats.allocations = m_allocations;
+  stats.hits = m_hits;
+  stats.usedBytes = m_usedBytes;
+  {
+    CSingleLock lock(m_section);
+    stats.cachedBytes = m_cachedBytes;
+  }
+  return stats;
+}
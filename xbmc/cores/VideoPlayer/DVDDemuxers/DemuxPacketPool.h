@@ -0,0 +1,77 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+struct DemuxPacket;
+
+/*!
+ * \brief Recycles demux packets and their payload buffers.
+ *
+ * Payload buffers are kept in power of two size classes. A buffer that is returned goes back
+ * into the free list of its class, so a stream with similar sized packets stops hitting the
+ * heap after a few seconds. The amount of memory held in the free lists is bounded.
+ */
+class CDemuxPacketPool
+{
+public:
+  struct Stats
+  {
+    uint64_t allocations = 0; //!< number of payload buffers handed out
+    uint64_t hits = 0; //!< number of those that were served from the free lists
+    uint64_t cachedBytes = 0; //!< bytes currently held in the free lists
+    uint64_t usedBytes = 0; //!< bytes currently handed out
+  };
+
+  static CDemuxPacketPool& GetInstance();
+
+  DemuxPacket* AllocatePacket();
+  void FreePacket(DemuxPacket* packet);
+
+  /*!
+   * \brief Get a payload buffer of at least size bytes plus the given amount of padding
+   * \return the buffer, 16 byte aligned, or nullptr if out of memory
+   */
+  uint8_t* AllocateData(size_t size, size_t padding);
+  void FreeData(uint8_t* data);
+
+  /*!
+   * \brief Release all cached buffers, e.g. on end of playback
+   */
+  void Trim();
+
+  Stats GetStats() const;
+
+private:
+  CDemuxPacketPool() = default;
+  ~CDemuxPacketPool();
+
+  static constexpr unsigned int MIN_CLASS_SHIFT = 8; // 256 bytes
+  static constexpr unsigned int NUM_CLASSES = 16; // up to 8 MiB
+  static constexpr unsigned int NO_CLASS = 0xFF;
+  static constexpr uint64_t MAX_CACHED_BYTES = 32 * 1024 * 1024;
+  static constexpr size_t MAX_CACHED_PACKETS = 2048;
+
+  static unsigned int GetSizeClass(size_t size);
+
+  mutable CCriticalSection m_section;
+  std::array<std::vector<uint8_t*>, NUM_CLASSES> m_freeBuffers;
+  std::vector<DemuxPacket*> m_freePackets;
+  uint64_t m_cachedBytes = 0;
+
+  std::atomic<uint64_t> m_allocations{0};
+  std::atomic<uint64_t> m_hits{0};
+  std::atomic<uint64_t> m_usedBytes{0};
+};
@@ -0,0 +1,201 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DemuxStreamInfoCache.h"
+
+#include "threads/SingleLock.h"
+
+#include <algorithm>
+#include <cstring>
+
+CDemuxStreamInfoCache& CDemuxStreamInfoCache::GetInstance()
+{
+  static CDemuxStreamInfoCache cache;
+  return cache;
+}
+
+std::list<CDemuxStreamInfoCache::Entry>::const_iterator CDemuxStreamInfoCache::Find(const std::string& key) const
+{
+  return std::find_if(m_entries.begin(), m_entries.end(),
+                      [&key](const Entry& entry) { return entry.key == key; });
+}
+
+bool CDemuxStreamInfoCache::Contains(const std::string& key) const
+{
+  CSingleLock lock(m_section);
+  return Find(key) != m_entries.end();
+}
+
+bool CDemuxStreamInfoCache::Covers(const std::string& key, const AVFormatContext* context) const
+{
+  CSingleLock lock(m_section);
+  auto entry = Find(key);
+  if (entry == m_entries.end())
+    return false;
+
+  for (unsigned int i = 0; i < context->nb_streams; i++)
+  {
+    const AVStream* stream = context->streams[i];
+    const AVCodecParameters* codecpar = stream->codecpar;
+    if (codecpar->codec_type != AVMEDIA_TYPE_VIDEO && codecpar->codec_type != AVMEDIA_TYPE_AUDIO)
+      continue;
+
+    if (std::none_of(entry->streams.begin(), entry->streams.end(),
+                     [stream, codecpar](const StreamParams& params)
+                     {
+                       return params.id == stream->id && params.codec == codecpar->codec_id &&
+                              params.type == codecpar->codec_type;
+                     }))
+      return false;
+  }
+  return true;
+}
+
+int64_t CDemuxStreamInfoCache::GetBitRate(const std::string& key) const
+{
+  CSingleLock lock(m_section);
+  auto entry = Find(key);
+  return entry != m_entries.end() ? entry->bitRate : 0;
+}
+
+void CDemuxStreamInfoCache::Store(const std::string& key, const AVFormatContext* context)
+{
+  std::vector<StreamParams> streams;
+  for (unsigned int i = 0; i < context->nb_streams; i++)
+  {
+    const AVCodecParameters* codecpar = context->streams[i]->codecpar;
+
+    // only what a decoder can be opened with
+    if (codecpar->codec_type == AVMEDIA_TYPE_VIDEO &&
+        (!codecpar->extradata || codecpar->width <= 0 || codecpar->height <= 0))
+      continue;
+    if (codecpar->codec_type == AVMEDIA_TYPE_AUDIO &&
+        (codecpar->sample_rate <= 0 || codecpar->channels <= 0))
+      continue;
+    if (codecpar->codec_type != AVMEDIA_TYPE_VIDEO && codecpar->codec_type != AVMEDIA_TYPE_AUDIO)
+      continue;
+
+    StreamParams params;
+    params.id = context->streams[i]->id;
+    params.type = codecpar->codec_type;
+    params.codec = codecpar->codec_id;
+    if (codecpar->extradata)
+      params.extradata.assign(codecpar->extradata, codecpar->extradata + codecpar->extradata_size);
+    params.width = codecpar->width;
+    params.height = codecpar->height;
+    params.format = codecpar->format;
+    params.sampleRate = codecpar->sample_rate;
+    params.channels = codecpar->channels;
+    params.channelLayout = codecpar->channel_layout;
+    params.profile = codecpar->profile;
+    params.level = codecpar->level;
+    params.bitsPerRawSample = codecpar->bits_per_raw_sample;
+    params.avgFrameRate = context->streams[i]->avg_frame_rate;
+    params.rFrameRate = context->streams[i]->r_frame_rate;
+    streams.push_back(std::move(params));
+  }
+
+  if (streams.empty())
+    return;
+
+  CSingleLock lock(m_section);
+  m_entries.remove_if([&key](const Entry& entry) { return entry.key == key; });
+  m_entries.push_front({key, context->bit_rate, context->start_time, context->duration, std::move(streams)});
+  if (m_entries.size() > MAX_ENTRIES)
+    m_entries.pop_back();
+}
+
+void CDemuxStreamInfoCache::ApplyTimings(const std::string& key, AVFormatContext* context) const
+{
+  CSingleLock lock(m_section);
+  auto entry = Find(key);
+  if (entry == m_entries.end())
+    return;
+
+  if (context->start_time == AV_NOPTS_VALUE)
+    context->start_time = entry->startTime;
+  if (context->duration == AV_NOPTS_VALUE)
+    context->duration = entry->duration;
+  if (context->bit_rate <= 0)
+    context->bit_rate = entry->bitRate;
+}
+
+bool CDemuxStreamInfoCache::Apply(const std::string& key, AVStream* stream) const
+{
+  AVCodecParameters* codecpar = stream->codecpar;
+
+  CSingleLock lock(m_section);
+  auto entry = Find(key);
+  if (entry == m_entries.end())
+    return false;
+
+  for (const StreamParams& params : entry->streams)
+  {
+    // a changed service layout or codec invalidates what we know about the stream
+    if (params.id != stream->id || params.codec != codecpar->codec_id || params.type != codecpar->codec_type)
+      continue;
+
+    bool updated = false;
+    if (!codecpar->extradata && !params.extradata.empty())
+    {
+      codecpar->extradata = static_cast<uint8_t*>(av_mallocz(params.extradata.size() + AV_INPUT_BUFFER_PADDING_SIZE));
+      if (codecpar->extradata)
+      {
+        memcpy(codecpar->extradata, params.extradata.data(), params.extradata.size());
+        codecpar->extradata_size = static_cast<int>(params.extradata.size());
+        updated = true;
+      }
+    }
+    if (codecpar->format < 0)
+    {
+      codecpar->format = params.format;
+      updated = true;
+    }
+    if (params.type == AVMEDIA_TYPE_VIDEO && codecpar->width <= 0 && codecpar->height <= 0)
+    {
+      codecpar->width = params.width;
+      codecpar->height = params.height;
+      updated = true;
+    }
+    if (params.type == AVMEDIA_TYPE_AUDIO && codecpar->sample_rate <= 0)
+    {
+      codecpar->sample_rate = params.sampleRate;
+      updated = true;
+    }
+    if (params.type == AVMEDIA_TYPE_AUDIO && codecpar->channels <= 0)
+    {
+      codecpar->channels = params.channels;
+      codecpar->channel_layout = params.channelLayout;
+      updated = true;
+    }
+    if (codecpar->profile == FF_PROFILE_UNKNOWN && params.profile != FF_PROFILE_UNKNOWN)
+    {
+      codecpar->profile = params.profile;
+      codecpar->level = params.level;
+      updated = true;
+    }
+    if (codecpar->bits_per_raw_sample <= 0 && params.bitsPerRawSample > 0)
+    {
+      codecpar->bits_per_raw_sample = params.bitsPerRawSample;
+      updated = true;
+    }
+    if (stream->avg_frame_rate.num == 0 && params.avgFrameRate.num != 0)
+    {
+      stream->avg_frame_rate = params.avgFrameRate;
+      updated = true;
+    }
+    if (stream->r_frame_rate.num == 0 && params.rFrameRate.num != 0)
+    {
+      stream->r_frame_rate = params.rFrameRate;
+      updated = true;
+    }
+    return updated;
+  }
+
+  return false;
+}
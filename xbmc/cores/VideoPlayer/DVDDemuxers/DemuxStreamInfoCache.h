@@ -0,0 +1,105 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <cstdint>
+#include <list>
+#include <string>
+#include <utility>
+#include <vector>
+
+extern "C" {
+#include <libavformat/avformat.h>
+}
+
+/*!
+ * \brief Remembers the codec parameters of the streams of a source.
+ *
+ * Probing a live tv stream means waiting for the stream info analysis and for the next video
+ * keyframe to carry the sequence headers. When a channel is tuned again, the parameters seen on
+ * the previous tune are filled into the new streams instead, so the demuxer can hand them out
+ * right away. Entries are keyed by a caller defined string, e.g. the pvr channel.
+ *
+ * Files are remembered the same way: their frame rates, profiles and the bit rate of the whole
+ * file let a file opened again skip the stream info analysis if its container describes the
+ * streams already.
+ */
+class CDemuxStreamInfoCache
+{
+public:
+  static CDemuxStreamInfoCache& GetInstance();
+
+  bool Contains(const std::string& key) const;
+
+  /*!
+   * \brief Whether parameters are stored for every audio and video stream of the context
+   */
+  bool Covers(const std::string& key, const AVFormatContext* context) const;
+
+  /*!
+   * \brief Bit rate of the whole source when it was stored, 0 if unknown
+   */
+  int64_t GetBitRate(const std::string& key) const;
+
+  /*!
+   * \brief Store the parameters of all streams that are fully known
+   */
+  void Store(const std::string& key, const AVFormatContext* context);
+
+  /*!
+   * \brief Fill in the start time, duration and bit rate if the context is still missing them
+   */
+  void ApplyTimings(const std::string& key, AVFormatContext* context) const;
+
+  /*!
+   * \brief Fill in parameters the given stream is still missing
+   * \return true if the stream was updated
+   */
+  bool Apply(const std::string& key, AVStream* stream) const;
+
+private:
+  CDemuxStreamInfoCache() = default;
+
+  static constexpr size_t MAX_ENTRIES = 256;
+
+  struct StreamParams
+  {
+    int id;
+    AVMediaType type;
+    AVCodecID codec;
+    std::vector<uint8_t> extradata;
+    int width;
+    int height;
+    int format;
+    int sampleRate;
+    int channels;
+    uint64_t channelLayout;
+    int profile;
+    int level;
+    int bitsPerRawSample;
+    AVRational avgFrameRate;
+    AVRational rFrameRate;
+  };
+
+  struct Entry
+  {
+    std::string key;
+    int64_t bitRate;
+    int64_t startTime;
+    int64_t duration;
+    std::vector<StreamParams> streams;
+  };
+
+  std::list<Entry>::const_iterator Find(const std::string& key) const;
+
+  mutable CCriticalSection m_section;
+  std::list<Entry> m_entries; // most recently stored first
+};
@@ -10,6 +10,7 @@
 #include <limits>
 
 #include "filesystem/BlurayCallback.h"
+#include "filesystem/BlurayDirectory.h"
 #include "DVDInputStreamBluray.h"
 #include "IVideoPlayer.h"
 #include "DVDCodecs/Overlay/DVDOverlay.h"
@@ -94,26 +95,26 @@ bool CDVDInputStreamBluray::IsEOF()
   return false;
 }
 
-BLURAY_TITLE_INFO* CDVDInputStreamBluray::GetTitleLongest()
+BLURAY_TITLE_INFO* CDVDInputStreamBluray::GetTitleLongest(const std::string& root)
 {
-  int titles = bd_get_titles(m_bd, TITLES_RELEVANT, 0);
+  // the titles of discs played or browsed before come from the video database
+  std::vector<XFILE::CBlurayDirectory::SBlurayTitle> titles;
+  XFILE::CBlurayDirectory::GetRelevantTitles(m_bd, root, titles);
 
-  BLURAY_TITLE_INFO *s = nullptr;
-  for(int i=0; i < titles; i++)
+  const XFILE::CBlurayDirectory::SBlurayTitle* longest = nullptr;
+  for (const auto& title : titles)
   {
-    BLURAY_TITLE_INFO *t = bd_get_title_info(m_bd, i, 0);
-    if(!t)
-    {
-      CLog::Log(LOGDEBUG, "get_main_title - unable to get title %d", i);
-      continue;
-    }
-    if(!s || s->duration < t->duration)
-      std::swap(s, t);
+    if (!longest || longest->duration < title.duration)
+      longest = &title;
+  }
 
-    if(t)
-      bd_free_title_info(t);
+  if (!longest)
+  {
+    CLog::Log(LOGDEBUG, "get_main_title - no relevant titles found");
+    return nullptr;
   }
-  return s;
+
+  return bd_get_playlist_info(m_bd, longest->playlist, 0);
 }
 
 BLURAY_TITLE_INFO* CDVDInputStreamBluray::GetTitleFile(const std::string& filename)
@@ -285,7 +286,7 @@ bool CDVDInputStreamBluray::Open()
   else if (mode == BD_PLAYBACK_MAIN_TITLE)
   {
     m_navmode = false;
-    m_titleInfo = GetTitleLongest();
+    m_titleInfo = GetTitleLongest(root.empty() ? m_item.GetPath() : root);
   }
   else
   {
@@ -300,7 +301,7 @@ bool CDVDInputStreamBluray::Open()
     }
 
     if(!m_navmode)
-      m_titleInfo = GetTitleLongest();
+      m_titleInfo = GetTitleLongest(root.empty() ? m_item.GetPath() : root);
   }
 
   if (m_navmode)
@@ -116,7 +116,7 @@ public:
   void OverlayCallbackARGB(const struct bd_argb_overlay_s * const);
 #endif
 
-  BLURAY_TITLE_INFO* GetTitleLongest();
+  BLURAY_TITLE_INFO* GetTitleLongest(const std::string& root);
   BLURAY_TITLE_INFO* GetTitleFile(const std::string& name);
 
   void ProcessEvent();
@@ -90,6 +90,16 @@ bool CDVDInputStreamFile::Open()
     return false;
   }
 
+  // uncached local media can be read through a memory mapped window, the protocols that
+  // don't support it simply ignore the request
+  if ((flags & READ_NO_CACHE) && (flags & READ_AUDIO_VIDEO) &&
+      CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_cacheMemoryMapLocal)
+  {
+    bool enable = true;
+    if (m_pFile->IoControl(IOCTRL_SET_MMAP, &enable) == 1)
+      CLog::Log(LOGDEBUG, "CDVDInputStreamFile::Open - using memory mapped reads");
+  }
+
   if (m_pFile->GetImplementation() && (content.empty() || content == "application/octet-stream"))
     m_content = m_pFile->GetImplementation()->GetProperty(XFILE::FILE_PROPERTY_CONTENT_TYPE);
 
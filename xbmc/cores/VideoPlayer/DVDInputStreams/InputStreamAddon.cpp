@@ -19,6 +19,11 @@
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 
+#include <algorithm>
+
+// packets fetched per call from add-ons supporting batched demux reads
+#define INPUTSTREAM_DEMUX_BATCH_SIZE 32
+
 CInputStreamProvider::CInputStreamProvider(ADDON::BinaryAddonBasePtr addonBase, kodi::addon::IAddonInstance* parentInstance)
   : m_addonBase(addonBase)
   , m_parentInstance(parentInstance)
@@ -157,6 +162,7 @@ bool CInputStreamAddon::Open()
 
 void CInputStreamAddon::Close()
 {
+  DropDemuxPackets();
   if (m_struct.toAddon.close)
     m_struct.toAddon.close(&m_struct);
   DestroyInstance();
@@ -277,6 +283,8 @@ bool CInputStreamAddon::PosTime(int ms)
   if (!m_struct.toAddon.pos_time)
     return false;
 
+  DropDemuxPackets();
+
   return m_struct.toAddon.pos_time(&m_struct, ms);
 }
 
@@ -299,6 +307,23 @@ bool CInputStreamAddon::OpenDemux()
 
 DemuxPacket* CInputStreamAddon::ReadDemux()
 {
+  if (m_struct.toAddon.demux_read_packets)
+  {
+    if (m_demuxPackets.empty())
+    {
+      DemuxPacket* packets[INPUTSTREAM_DEMUX_BATCH_SIZE];
+      const int count = m_struct.toAddon.demux_read_packets(&m_struct, packets, INPUTSTREAM_DEMUX_BATCH_SIZE);
+      if (count <= 0)
+        return nullptr;
+
+      m_demuxPackets.assign(packets, packets + std::min(count, INPUTSTREAM_DEMUX_BATCH_SIZE));
+    }
+
+    DemuxPacket* packet = m_demuxPackets.front();
+    m_demuxPackets.pop_front();
+    return packet;
+  }
+
   if (!m_struct.toAddon.demux_read)
     return nullptr;
 
@@ -472,6 +497,8 @@ bool CInputStreamAddon::SeekTime(double time, bool backward, double* startpts)
   if (!m_struct.toAddon.demux_seek_time)
     return false;
 
+  DropDemuxPackets();
+
   if ((m_caps.m_mask & INPUTSTREAM_CAPABILITIES::SUPPORTS_IPOSTIME) != 0)
   {
     if (!PosTime(static_cast<int>(time)))
@@ -495,6 +522,7 @@ void CInputStreamAddon::AbortDemux()
 
 void CInputStreamAddon::FlushDemux()
 {
+  DropDemuxPackets();
   if (m_struct.toAddon.demux_flush)
     m_struct.toAddon.demux_flush(&m_struct);
 }
@@ -559,12 +587,20 @@ int64_t CInputStreamAddon::GetChapterPos(int ch)
 
 bool CInputStreamAddon::SeekChapter(int ch)
 {
+  DropDemuxPackets();
   if (m_struct.toAddon.seek_chapter)
     return m_struct.toAddon.seek_chapter(&m_struct, ch);
 
   return false;
 }
 
+void CInputStreamAddon::DropDemuxPackets()
+{
+  for (DemuxPacket* packet : m_demuxPackets)
+    CDVDDemuxUtils::FreeDemuxPacket(packet);
+  m_demuxPackets.clear();
+}
+
 int CInputStreamAddon::ConvertVideoCodecProfile(STREAMCODEC_PROFILE profile)
 {
   switch (profile)
@@ -14,6 +14,7 @@
 #include "addons/binary-addons/AddonInstanceHandler.h"
 #include "addons/kodi-addon-dev-kit/include/kodi/addon-instance/Inputstream.h"
 
+#include <deque>
 #include <memory>
 #include <vector>
 
@@ -98,6 +99,9 @@ public:
 protected:
   static int ConvertVideoCodecProfile(STREAMCODEC_PROFILE profile);
 
+  /*! \brief Free the packets read ahead by the batched demux read */
+  void DropDemuxPackets();
+
   IVideoPlayer* m_player;
 
 private:
@@ -107,6 +111,7 @@ private:
   int m_streamCount = 0;
 
   AddonInstance_InputStream m_struct;
+  std::deque<DemuxPacket*> m_demuxPackets;
   std::shared_ptr<CInputStreamProvider> m_subAddonProvider;
 
   /*!
@@ -10,16 +10,20 @@
 
 #include "DVDFactoryInputStream.h"
 #include "filesystem/File.h"
+#include "threads/SingleLock.h"
+#include "utils/JobManager.h"
 #include "utils/StringUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <map>
 
 using namespace XFILE;
 
 CInputStreamMultiSource::CInputStreamMultiSource(IVideoPlayer* pPlayer, const CFileItem& fileitem, const std::vector<std::string>& filenames) : InputStreamMultiStreams(DVDSTREAM_TYPE_MULTIFILES, fileitem),
   m_pPlayer(pPlayer),
-  m_filenames(filenames)
+  m_filenames(filenames),
+  m_pending(std::make_shared<SPendingSources>())
 {
 }
 
@@ -30,13 +34,24 @@ CInputStreamMultiSource::~CInputStreamMultiSource()
 
 void CInputStreamMultiSource::Abort()
 {
+  CSingleLock lock(m_pending->section);
   for (auto iter : m_InputStreams)
     iter->Abort();
+  for (auto iter : m_pending->opening)
+    iter->Abort();
 }
 
 void CInputStreamMultiSource::Close()
 {
-  m_InputStreams.clear();
+  {
+    CSingleLock lock(m_pending->section);
+    m_pending->closed = true;
+    for (auto iter : m_pending->opening)
+      iter->Abort();
+    m_pending->ready.clear();
+    m_pending->hasReady = false;
+    m_InputStreams.clear();
+  }
   CDVDInputStream::Close();
 }
 
@@ -103,6 +118,10 @@ bool CInputStreamMultiSource::Open()
   if (!m_pPlayer || m_filenames.empty())
     return false;
 
+  // external audio tracks and subtitles are opened concurrently, playback starts with the
+  // first file and they are added as they become available
+  std::shared_ptr<SPendingSources> pending = m_pending;
+  InputStreamPtr primary;
   for (unsigned int i = 0; i < m_filenames.size(); i++)
   {
     CFileItem fileitem = CFileItem(m_filenames[i], false);
@@ -114,16 +133,64 @@ bool CInputStreamMultiSource::Open()
       continue;
     }
 
-    if (!inputstream->Open())
+    if (i == 0)
     {
-      CLog::Log(LOGERROR, "CDVDPlayer::OpenInputStream - error opening file [%s]", m_filenames[i].c_str());
+      primary = inputstream;
       continue;
     }
-    m_InputStreams.push_back(inputstream);
+
+    CSingleLock lock(pending->section);
+    pending->opening.push_back(inputstream);
+    const std::string filename = m_filenames[i];
+    CJobManager::GetInstance().Submit([pending, inputstream, filename]()
+    {
+      const bool opened = inputstream->Open();
+      if (!opened)
+        CLog::Log(LOGERROR, "CDVDPlayer::OpenInputStream - error opening file [%s]", filename.c_str());
+
+      CSingleLock lock(pending->section);
+      pending->opening.erase(std::find(pending->opening.begin(), pending->opening.end(), inputstream));
+      if (opened && !pending->closed)
+      {
+        pending->ready.push_back(inputstream);
+        pending->hasReady = true;
+      }
+      pending->opened.notifyAll();
+    }, CJob::PRIORITY_HIGH);
   }
+
+  if (primary && primary->Open())
+  {
+    m_InputStreams.push_back(primary);
+    return true;
+  }
+
+  if (primary)
+    CLog::Log(LOGERROR, "CDVDPlayer::OpenInputStream - error opening file [%s]", m_filenames[0].c_str());
+
+  // play whatever else can be opened
+  CSingleLock lock(pending->section);
+  while (!pending->opening.empty())
+    pending->opened.wait(lock);
+  lock.Leave();
+
+  GetOpenedSources();
   return !m_InputStreams.empty();
 }
 
+std::vector<InputStreamPtr> CInputStreamMultiSource::GetOpenedSources()
+{
+  std::vector<InputStreamPtr> sources;
+  if (!m_pending->hasReady)
+    return sources;
+
+  CSingleLock lock(m_pending->section);
+  sources.swap(m_pending->ready);
+  m_pending->hasReady = false;
+  m_InputStreams.insert(m_InputStreams.end(), sources.begin(), sources.end());
+  return sources;
+}
+
 int CInputStreamMultiSource::Read(uint8_t* buf, int buf_size)
 {
   return -1;
@@ -10,7 +10,11 @@
 
 #include "DVDInputStream.h"
 #include "InputStreamMultiStreams.h"
+#include "threads/Condition.h"
+#include "threads/CriticalSection.h"
 
+#include <atomic>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -37,7 +41,29 @@ public:
   int64_t Seek(int64_t offset, int whence) override;
   void SetReadRate(unsigned rate) override;
 
+  /*!
+   \brief Take the sources that finished opening since the last call
+
+   Only the first file is opened by Open(), the others are opened in the
+   background. Sources returned here are added to the open streams.
+   */
+  std::vector<InputStreamPtr> GetOpenedSources();
+
 protected:
   IVideoPlayer* m_pPlayer;
   std::vector<std::string> m_filenames;
+
+private:
+  // shared with the jobs opening the sources, they may outlive us
+  struct SPendingSources
+  {
+    CCriticalSection section;
+    XbmcThreads::ConditionVariable opened;
+    std::vector<InputStreamPtr> opening;
+    std::vector<InputStreamPtr> ready;
+    std::atomic<bool> hasReady{false};
+    bool closed = false;
+  };
+
+  std::shared_ptr<SPendingSources> m_pending;
 };
@@ -8,10 +8,15 @@
 
 #include "InputStreamPVRChannel.h"
 
+#include "PVRTimeshiftBuffer.h"
 #include "ServiceBroker.h"
 #include "addons/PVRClient.h"
 #include "pvr/PVRManager.h"
+#include "pvr/channels/PVRChannel.h"
 #include "pvr/channels/PVRChannelGroupsContainer.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "utils/StringUtils.h"
 #include "utils/log.h"
 
 using namespace PVR;
@@ -35,6 +40,45 @@ CDVDInputStream::IDemux* CInputStreamPVRChannel::GetIDemux()
   return CInputStreamPVRBase::GetIDemux();
 }
 
+bool CInputStreamPVRChannel::GetTimes(Times &times)
+{
+  if (m_timeshiftBuffer)
+    return m_timeshiftBuffer->GetTimes(times);
+
+  return CInputStreamPVRBase::GetTimes(times);
+}
+
+void CInputStreamPVRChannel::Pause(bool bPaused)
+{
+  // the live stream goes on into the buffer
+  if (!m_timeshiftBuffer)
+    CInputStreamPVRBase::Pause(bPaused);
+}
+
+void CInputStreamPVRChannel::Abort()
+{
+  if (m_timeshiftBuffer)
+    m_timeshiftBuffer->Abort();
+}
+
+CDVDInputStream::IPosTime* CInputStreamPVRChannel::GetIPosTime()
+{
+  if (m_timeshiftBuffer)
+    return this;
+
+  return nullptr;
+}
+
+bool CInputStreamPVRChannel::PosTime(int ms)
+{
+  if (m_timeshiftBuffer && m_timeshiftBuffer->SeekTime(ms))
+  {
+    m_eof = false;
+    return true;
+  }
+  return false;
+}
+
 bool CInputStreamPVRChannel::OpenPVRStream()
 {
   std::shared_ptr<CPVRChannel> channel = m_item.GetPVRChannelInfoTag();
@@ -47,6 +91,17 @@ bool CInputStreamPVRChannel::OpenPVRStream()
   if (channel && m_client && (m_client->OpenLiveStream(channel) == PVR_ERROR_NO_ERROR))
   {
     m_bDemuxActive = m_client->GetClientCapabilities().HandlesDemuxing();
+    m_streamInfoKey = StringUtils::Format("pvr://%d/%d", channel->ClientID(), channel->UniqueID());
+
+    const int iBufferSize = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iPVRTimeshiftBufferSize;
+    bool bCanPause = false;
+    m_client->CanPauseStream(bCanPause);
+    if (iBufferSize > 0 && !m_bDemuxActive && !bCanPause)
+    {
+      m_timeshiftBuffer.reset(new CPVRTimeshiftBuffer(m_client, static_cast<int64_t>(iBufferSize) * 1024 * 1024));
+      if (!m_timeshiftBuffer->Open())
+        m_timeshiftBuffer.reset();
+    }
     CLog::Log(LOGDEBUG, "CInputStreamPVRChannel - %s - opened channel stream %s", __FUNCTION__, m_item.GetPath().c_str());
     return true;
   }
@@ -55,15 +110,22 @@ bool CInputStreamPVRChannel::OpenPVRStream()
 
 void CInputStreamPVRChannel::ClosePVRStream()
 {
+  // stop reading the live stream before it's closed
+  m_timeshiftBuffer.reset();
+
   if (m_client && (m_client->CloseLiveStream() == PVR_ERROR_NO_ERROR))
   {
     m_bDemuxActive = false;
+    m_streamInfoKey.clear();
     CLog::Log(LOGDEBUG, "CInputStreamPVRChannel - %s - closed channel stream %s", __FUNCTION__, m_item.GetPath().c_str());
   }
 }
 
 int CInputStreamPVRChannel::ReadPVRStream(uint8_t* buf, int buf_size)
 {
+  if (m_timeshiftBuffer)
+    return m_timeshiftBuffer->Read(buf, buf_size);
+
   int ret = -1;
 
   if (m_client)
@@ -74,6 +136,9 @@ int CInputStreamPVRChannel::ReadPVRStream(uint8_t* buf, int buf_size)
 
 int64_t CInputStreamPVRChannel::SeekPVRStream(int64_t offset, int whence)
 {
+  if (m_timeshiftBuffer)
+    return m_timeshiftBuffer->Seek(offset, whence);
+
   int64_t ret = -1;
 
   if (m_client)
@@ -84,6 +149,10 @@ int64_t CInputStreamPVRChannel::SeekPVRStream(int64_t offset, int whence)
 
 int64_t CInputStreamPVRChannel::GetPVRStreamLength()
 {
+  // the buffer keeps growing, report a live stream
+  if (m_timeshiftBuffer)
+    return -1;
+
   int64_t ret = -1;
 
   if (m_client)
@@ -102,6 +171,9 @@ CDVDInputStream::ENextStream CInputStreamPVRChannel::NextPVRStream()
 
 bool CInputStreamPVRChannel::CanPausePVRStream()
 {
+  if (m_timeshiftBuffer)
+    return true;
+
   bool ret = false;
 
   if (m_client)
@@ -112,6 +184,9 @@ bool CInputStreamPVRChannel::CanPausePVRStream()
 
 bool CInputStreamPVRChannel::CanSeekPVRStream()
 {
+  if (m_timeshiftBuffer)
+    return true;
+
   bool ret = false;
 
   if (m_client)
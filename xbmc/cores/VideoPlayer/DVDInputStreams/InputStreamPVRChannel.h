@@ -10,7 +10,14 @@
 
 #include "InputStreamPVRBase.h"
 
-class CInputStreamPVRChannel : public CInputStreamPVRBase
+#include <memory>
+#include <string>
+
+class CPVRTimeshiftBuffer;
+
+class CInputStreamPVRChannel
+  : public CInputStreamPVRBase
+  , public CDVDInputStream::IPosTime
 {
 public:
   CInputStreamPVRChannel(IVideoPlayer* pPlayer, const CFileItem& fileitem);
@@ -18,6 +25,18 @@ public:
 
   CDVDInputStream::IDemux* GetIDemux() override;
 
+  bool GetTimes(Times &times) override;
+  void Pause(bool bPaused) override;
+  void Abort() override;
+
+  CDVDInputStream::IPosTime* GetIPosTime() override;
+  bool PosTime(int ms) override;
+
+  /*!
+   * \brief Key identifying the tuned channel across tunes, empty if not open
+   */
+  std::string GetStreamInfoKey() const { return m_streamInfoKey; }
+
 protected:
   bool OpenPVRStream() override;
   void ClosePVRStream() override;
@@ -30,4 +49,6 @@ protected:
 
 private:
   bool m_bDemuxActive;
+  std::string m_streamInfoKey;
+  std::unique_ptr<CPVRTimeshiftBuffer> m_timeshiftBuffer; /*!< set while the core buffers a client without timeshift */
 };
@@ -0,0 +1,303 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "PVRTimeshiftBuffer.h"
+
+#include "Util.h"
+#include "addons/PVRClient.h"
+#include "cores/VideoPlayer/Interface/Addon/TimingConstants.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+#include <vector>
+
+#define TS_PACKET_SIZE 188
+#define TS_SYNC_BYTE 0x47
+
+#define TIMESHIFT_READ_CHUNK_SIZE (TS_PACKET_SIZE * 348)
+#define TIMESHIFT_READ_TIMEOUT_MS 10000
+// audio streams flag every frame as random access point, those close to an indexed one are skipped
+#define TIMESHIFT_INDEX_MIN_INTERVAL_MS 500
+// streams that don't flag random access points at all get an entry at the next unit start
+#define TIMESHIFT_INDEX_MAX_INTERVAL_MS 2000
+
+using namespace XFILE;
+
+CPVRTimeshiftBuffer::CPVRTimeshiftBuffer(const std::shared_ptr<PVR::CPVRClient>& client, int64_t iMaxSize)
+  : CThread("PVRTimeshift"),
+    m_client(client),
+    m_iMaxSize(iMaxSize - iMaxSize % TS_PACKET_SIZE)
+{
+}
+
+CPVRTimeshiftBuffer::~CPVRTimeshiftBuffer()
+{
+  Close();
+}
+
+bool CPVRTimeshiftBuffer::Open()
+{
+  Close();
+
+  m_strFilename = CUtil::GetNextFilename("special://temp/timeshift%03d.ts", 999);
+  if (m_strFilename.empty() || m_iMaxSize <= 0)
+  {
+    CLog::Log(LOGERROR, "CPVRTimeshiftBuffer::Open - unable to create a timeshift buffer");
+    return false;
+  }
+
+  if (!m_fileWrite.OpenForWrite(m_strFilename, true) || !m_fileRead.Open(m_strFilename))
+  {
+    CLog::Log(LOGERROR, "CPVRTimeshiftBuffer::Open - unable to open %s", m_strFilename.c_str());
+    Close();
+    return false;
+  }
+
+  m_iStartPosition = 0;
+  m_iWritePosition = 0;
+  m_iReadPosition = 0;
+  m_index.clear();
+  m_bEndOfInput = false;
+  m_bAbort = false;
+  m_iPacketFill = 0;
+  m_startTime = time(nullptr);
+  m_iStartTicks = XbmcThreads::SystemClockMillis();
+
+  Create();
+
+  CLog::Log(LOGDEBUG, "CPVRTimeshiftBuffer::Open - buffering %" PRId64 " MB in %s", m_iMaxSize / (1024 * 1024), m_strFilename.c_str());
+  return true;
+}
+
+void CPVRTimeshiftBuffer::Close()
+{
+  StopThread();
+
+  m_fileWrite.Close();
+  m_fileRead.Close();
+
+  if (!m_strFilename.empty())
+  {
+    CFile::Delete(m_strFilename);
+    m_strFilename.clear();
+  }
+}
+
+void CPVRTimeshiftBuffer::Abort()
+{
+  CSingleLock lock(m_critSection);
+  m_bAbort = true;
+  m_dataAvailable.Set();
+}
+
+int64_t CPVRTimeshiftBuffer::ElapsedMs() const
+{
+  return XbmcThreads::SystemClockMillis() - m_iStartTicks;
+}
+
+void CPVRTimeshiftBuffer::Process()
+{
+  std::vector<uint8_t> buffer(TIMESHIFT_READ_CHUNK_SIZE);
+
+  while (!m_bStop)
+  {
+    int iRead = -1;
+    if (m_client->ReadLiveStream(buffer.data(), buffer.size(), iRead) != PVR_ERROR_NO_ERROR || iRead <= 0)
+      break;
+
+    // only this thread moves the write position
+    const int64_t iPosition = m_iWritePosition;
+    if (!WriteToRing(buffer.data(), iRead))
+      break;
+
+    IndexPackets(buffer.data(), iRead, iPosition);
+    m_dataAvailable.Set();
+  }
+
+  CSingleLock lock(m_critSection);
+  m_bEndOfInput = true;
+  m_dataAvailable.Set();
+}
+
+bool CPVRTimeshiftBuffer::WriteToRing(const uint8_t* buf, int size)
+{
+  CSingleLock lock(m_critSection);
+
+  // drop what gets overwritten first, a reader there continues at the oldest keyframe
+  const int64_t iWriteEnd = m_iWritePosition + size;
+  if (iWriteEnd - m_iStartPosition > m_iMaxSize)
+  {
+    m_iStartPosition = iWriteEnd - m_iMaxSize;
+    while (!m_index.empty() && m_index.front().iPosition < m_iStartPosition)
+      m_index.pop_front();
+
+    if (m_iReadPosition < m_iStartPosition)
+      m_iReadPosition = m_index.empty() ? m_iStartPosition : m_index.front().iPosition;
+  }
+
+  while (size > 0)
+  {
+    const int64_t iOffset = m_iWritePosition % m_iMaxSize;
+    const int iChunk = static_cast<int>(std::min<int64_t>(size, m_iMaxSize - iOffset));
+    if (m_fileWrite.Seek(iOffset, SEEK_SET) != iOffset ||
+        m_fileWrite.Write(buf, iChunk) != iChunk)
+    {
+      CLog::Log(LOGERROR, "CPVRTimeshiftBuffer::WriteToRing - unable to write to %s", m_strFilename.c_str());
+      return false;
+    }
+    m_iWritePosition += iChunk;
+    buf += iChunk;
+    size -= iChunk;
+  }
+
+  return true;
+}
+
+void CPVRTimeshiftBuffer::IndexPackets(const uint8_t* buf, int size, int64_t iPosition)
+{
+  int i = 0;
+  while (i < size)
+  {
+    const uint8_t* packet = nullptr;
+    if (m_iPacketFill == 0)
+    {
+      // resync on the next sync byte
+      if (buf[i] != TS_SYNC_BYTE)
+      {
+        ++i;
+        continue;
+      }
+
+      m_iPacketPosition = iPosition + i;
+      if (size - i >= TS_PACKET_SIZE)
+      {
+        packet = buf + i;
+        i += TS_PACKET_SIZE;
+      }
+    }
+
+    if (!packet)
+    {
+      const int iCopy = std::min(TS_PACKET_SIZE - m_iPacketFill, size - i);
+      memcpy(m_packet + m_iPacketFill, buf + i, iCopy);
+      m_iPacketFill += iCopy;
+      i += iCopy;
+      if (m_iPacketFill < TS_PACKET_SIZE)
+        break;
+
+      packet = m_packet;
+      m_iPacketFill = 0;
+    }
+
+    const bool bUnitStart = (packet[1] & 0x40) != 0;
+    if (!bUnitStart)
+      continue;
+
+    const bool bRandomAccess = (packet[3] & 0x20) && packet[4] > 0 && (packet[5] & 0x40);
+    const int64_t iTimeMs = ElapsedMs();
+
+    CSingleLock lock(m_critSection);
+    const int64_t iSinceLast = m_index.empty() ? TIMESHIFT_INDEX_MAX_INTERVAL_MS : iTimeMs - m_index.back().iTimeMs;
+    if ((bRandomAccess && iSinceLast >= TIMESHIFT_INDEX_MIN_INTERVAL_MS) ||
+        iSinceLast >= TIMESHIFT_INDEX_MAX_INTERVAL_MS)
+    {
+      if (m_iPacketPosition >= m_iStartPosition)
+        m_index.push_back({m_iPacketPosition, iTimeMs});
+    }
+  }
+}
+
+int CPVRTimeshiftBuffer::Read(uint8_t* buf, int buf_size)
+{
+  XbmcThreads::EndTime timeout(TIMESHIFT_READ_TIMEOUT_MS);
+  CSingleLock lock(m_critSection);
+  while (m_iReadPosition >= m_iWritePosition)
+  {
+    if (m_bEndOfInput)
+      return 0;
+    if (m_bAbort)
+      return -1;
+
+    CSingleExit exit(m_critSection);
+    if (!m_dataAvailable.WaitMSec(timeout.MillisLeft()))
+    {
+      CLog::Log(LOGERROR, "CPVRTimeshiftBuffer::Read - no data from the live stream");
+      return -1;
+    }
+  }
+
+  const int64_t iOffset = m_iReadPosition % m_iMaxSize;
+  const int iChunk = static_cast<int>(std::min<int64_t>({static_cast<int64_t>(buf_size),
+                                                         m_iWritePosition - m_iReadPosition,
+                                                         m_iMaxSize - iOffset}));
+  if (m_fileRead.Seek(iOffset, SEEK_SET) != iOffset)
+    return -1;
+
+  const ssize_t iRead = m_fileRead.Read(buf, iChunk);
+  if (iRead < 0)
+  {
+    CLog::Log(LOGERROR, "CPVRTimeshiftBuffer::Read - unable to read from %s", m_strFilename.c_str());
+    return -1;
+  }
+
+  m_iReadPosition += iRead;
+  return static_cast<int>(iRead);
+}
+
+int64_t CPVRTimeshiftBuffer::Seek(int64_t offset, int whence)
+{
+  CSingleLock lock(m_critSection);
+
+  int64_t iTarget;
+  if (whence == SEEK_SET)
+    iTarget = offset;
+  else if (whence == SEEK_CUR)
+    iTarget = m_iReadPosition + offset;
+  else
+    return -1;
+
+  if (iTarget < m_iStartPosition || iTarget > m_iWritePosition)
+    return -1;
+
+  m_iReadPosition = iTarget;
+  return iTarget;
+}
+
+bool CPVRTimeshiftBuffer::SeekTime(int iTimeMs)
+{
+  CSingleLock lock(m_critSection);
+
+  if (m_index.empty())
+    return false;
+
+  auto it = std::upper_bound(m_index.begin(), m_index.end(), static_cast<int64_t>(iTimeMs),
+                             [](int64_t iTime, const IndexEntry& entry)
+                             {
+                               return iTime < entry.iTimeMs;
+                             });
+  if (it != m_index.begin())
+    --it;
+
+  m_iReadPosition = it->iPosition;
+  return true;
+}
+
+bool CPVRTimeshiftBuffer::GetTimes(CDVDInputStream::ITimes::Times& times)
+{
+  CSingleLock lock(m_critSection);
+
+  times.startTime = m_startTime;
+  times.ptsStart = 0;
+  times.ptsBegin = m_index.empty() ? 0 : DVD_MSEC_TO_TIME(m_index.front().iTimeMs);
+  times.ptsEnd = DVD_MSEC_TO_TIME(ElapsedMs());
+  return true;
+}
@@ -0,0 +1,103 @@
+/*
+ *  Copyright (C) 2012-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "DVDInputStream.h"
+#include "filesystem/File.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/Thread.h"
+
+#include <deque>
+#include <memory>
+#include <stdint.h>
+#include <string>
+#include <time.h>
+
+namespace PVR
+{
+  class CPVRClient;
+}
+
+/*!
+ \brief Timeshift for the live streams of PVR clients that can't pause or seek them.
+
+ A thread reads the transport stream of the client into a ring file on disk
+ of a fixed size, the oldest data is overwritten. While writing, the random
+ access points of the stream are indexed with the time they arrived, so time
+ seeks within the ring jump to a keyframe without scanning the stream.
+ */
+class CPVRTimeshiftBuffer : private CThread
+{
+public:
+  /*!
+   \param client the client with the opened live stream
+   \param iMaxSize the size of the ring in bytes
+   */
+  CPVRTimeshiftBuffer(const std::shared_ptr<PVR::CPVRClient>& client, int64_t iMaxSize);
+  ~CPVRTimeshiftBuffer() override;
+
+  /*! \brief Create the ring file and start buffering the live stream */
+  bool Open();
+  void Close();
+
+  /*!
+   \brief Read from the ring, waits for the live stream if there is no data yet.
+   \return the bytes read, 0 at the end of the live stream, -1 on errors
+   */
+  int Read(uint8_t* buf, int buf_size);
+
+  /*! \brief Seek to a byte position within the ring, SEEK_END isn't supported */
+  int64_t Seek(int64_t offset, int whence);
+
+  /*!
+   \brief Seek to the last keyframe at or before a time.
+   \param iTimeMs milliseconds since the buffer was opened
+   */
+  bool SeekTime(int iTimeMs);
+
+  bool GetTimes(CDVDInputStream::ITimes::Times& times);
+
+  void Abort();
+
+private:
+  struct IndexEntry
+  {
+    int64_t iPosition;
+    int64_t iTimeMs;
+  };
+
+  void Process() override;
+
+  int64_t ElapsedMs() const;
+  bool WriteToRing(const uint8_t* buf, int size);
+  void IndexPackets(const uint8_t* buf, int size, int64_t iPosition);
+
+  std::shared_ptr<PVR::CPVRClient> m_client;
+  const int64_t m_iMaxSize;
+  std::string m_strFilename;
+  XFILE::CFile m_fileWrite;
+  XFILE::CFile m_fileRead;
+  time_t m_startTime = 0;
+  unsigned int m_iStartTicks = 0;
+
+  CCriticalSection m_critSection;
+  CEvent m_dataAvailable;
+  int64_t m_iStartPosition = 0; // oldest byte still in the ring
+  int64_t m_iWritePosition = 0;
+  int64_t m_iReadPosition = 0;
+  std::deque<IndexEntry> m_index;
+  bool m_bEndOfInput = false;
+  bool m_bAbort = false;
+
+  // only touched by the buffer thread
+  uint8_t m_packet[188];
+  int m_iPacketFill = 0;
+  int64_t m_iPacketPosition = 0;
+};
@@ -11,9 +11,28 @@
 #include "cores/VideoPlayer/Interface/Addon/DemuxPacket.h"
 #include "cores/VideoPlayer/Interface/Addon/TimingConstants.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #include "utils/log.h"
 
 #include <math.h>
+#include <thread>
+
+namespace
+{
+// number of pending messages the lock-free ring can hold before the producer has to wait
+constexpr size_t RING_CAPACITY = 16384;
+
+int GetPacketSize(CDVDMsg* msg)
+{
+  if (msg->IsType(CDVDMsg::DEMUXER_PACKET))
+  {
+    DemuxPacket* packet = static_cast<CDVDMsgDemuxerPacket*>(msg)->GetPacket();
+    if (packet)
+      return packet->iSize;
+  }
+  return 0;
+}
+}
 
 CDVDMessageQueue::CDVDMessageQueue(const std::string &owner) : m_hEvent(true), m_owner(owner)
 {
@@ -43,10 +62,40 @@ void CDVDMessageQueue::Init()
   m_drain = false;
 }
 
+void CDVDMessageQueue::SetLockFreePackets(bool enable)
+{
+  CSingleLock lock(m_section);
+
+  if (m_bInitialized)
+  {
+    CLog::Log(LOGWARNING, "CDVDMessageQueue(%s)::SetLockFreePackets - queue already initialized", m_owner.c_str());
+    return;
+  }
+
+  if (enable && !m_ring)
+    m_ring.reset(new XbmcThreads::CSPSCQueue<CDVDMsg*>(RING_CAPACITY));
+  else if (!enable)
+    m_ring.reset();
+}
+
 void CDVDMessageQueue::Flush(CDVDMsg::Message type)
 {
   CSingleLock lock(m_section);
 
+  if (m_ring)
+  {
+    int removed = FlushRing(type);
+
+    if (type == CDVDMsg::DEMUXER_PACKET || type == CDVDMsg::NONE)
+    {
+      // the producer may be accounting for a packet right now, so only take off what was removed
+      m_iDataSize -= removed;
+      m_TimeBack = DVD_NOPTS_VALUE;
+      m_TimeFront = DVD_NOPTS_VALUE;
+    }
+    return;
+  }
+
   m_messages.remove_if([type](const DVDMessageListItem &item){
     return type == CDVDMsg::NONE || item.message->IsType(type);
   });
@@ -94,8 +143,45 @@ MsgQueueReturnCode CDVDMessageQueue::PutBack(CDVDMsg* pMsg, int priority)
   return Put(pMsg, priority, false);
 }
 
+int CDVDMessageQueue::FlushRing(CDVDMsg::Message type)
+{
+  int removed = 0;
+
+  m_messages.remove_if([type, &removed](const DVDMessageListItem &item){
+    if (type == CDVDMsg::NONE || item.message->IsType(type))
+    {
+      if (item.priority == 0)
+        removed += GetPacketSize(item.message);
+      return true;
+    }
+    return false;
+  });
+
+  m_prioMessages.remove_if([type](const DVDMessageListItem &item){
+    return type == CDVDMsg::NONE || item.message->IsType(type);
+  });
+
+  // drain what is in the ring right now. kept messages are older than anything that is pushed
+  // from here on and newer than the ones put back, so they go in front of the put back ones
+  size_t count = m_ring->Size();
+  CDVDMsg* msg;
+  while (count-- > 0 && m_ring->Pop(msg))
+  {
+    if (type == CDVDMsg::NONE || msg->IsType(type))
+      removed += GetPacketSize(msg);
+    else
+      m_messages.emplace_front(msg, 0);
+    msg->Release();
+  }
+
+  return removed;
+}
+
 MsgQueueReturnCode CDVDMessageQueue::Put(CDVDMsg* pMsg, int priority, bool front)
 {
+  if (m_ring && priority == 0 && front)
+    return PutRing(pMsg);
+
   CSingleLock lock(m_section);
 
   if (!m_bInitialized)
@@ -124,7 +210,7 @@ MsgQueueReturnCode CDVDMessageQueue::Put(CDVDMsg* pMsg, int priority, bool front
   }
   else
   {
-    if (m_messages.empty())
+    if (m_messages.empty() && !m_ring)
     {
       m_iDataSize = 0;
       m_TimeBack = DVD_NOPTS_VALUE;
@@ -158,6 +244,67 @@ MsgQueueReturnCode CDVDMessageQueue::Put(CDVDMsg* pMsg, int priority, bool front
   return MSGQ_OK;
 }
 
+MsgQueueReturnCode CDVDMessageQueue::PutRing(CDVDMsg* pMsg)
+{
+  if (!pMsg)
+  {
+    CLog::Log(LOGFATAL, "CDVDMessageQueue(%s)::Put MSGQ_INVALID_MSG", m_owner.c_str());
+    return MSGQ_INVALID_MSG;
+  }
+  if (!m_bInitialized)
+  {
+    CLog::Log(LOGWARNING, "CDVDMessageQueue(%s)::Put MSGQ_NOT_INITIALIZED", m_owner.c_str());
+    pMsg->Release();
+    return MSGQ_NOT_INITIALIZED;
+  }
+
+  // the demuxer thread is the only producer in practice, this just keeps an odd message
+  // sent from another thread from corrupting the ring
+  while (m_producerBusy.exchange(true, std::memory_order_acquire))
+    std::this_thread::yield();
+
+  // account before publishing, the consumer may pop the packet right away
+  int size = 0;
+  if (pMsg->IsType(CDVDMsg::DEMUXER_PACKET))
+  {
+    DemuxPacket* packet = static_cast<CDVDMsgDemuxerPacket*>(pMsg)->GetPacket();
+    if (packet)
+    {
+      size = packet->iSize;
+      m_iDataSize += size;
+
+      if (packet->dts != DVD_NOPTS_VALUE)
+        m_TimeFront = packet->dts;
+      else if (packet->pts != DVD_NOPTS_VALUE)
+        m_TimeFront = packet->pts;
+
+      if (m_TimeBack == DVD_NOPTS_VALUE)
+        m_TimeBack = m_TimeFront.load();
+    }
+  }
+
+  while (!m_ring->Push(pMsg))
+  {
+    // ring is full, wait for the consumer to catch up
+    if (m_bAbortRequest || !m_bInitialized)
+    {
+      m_iDataSize -= size;
+      m_producerBusy.store(false, std::memory_order_release);
+      pMsg->Release();
+      return MSGQ_ABORT;
+    }
+    XbmcThreads::ThreadSleep(1);
+  }
+
+  m_producerBusy.store(false, std::memory_order_release);
+
+  // only signal when the consumer is actually waiting for data
+  if (m_consumerWaiting)
+    m_hEvent.Set();
+
+  return MSGQ_OK;
+}
+
 MsgQueueReturnCode CDVDMessageQueue::Get(CDVDMsg** pMsg, unsigned int iTimeoutInMilliSeconds, int &priority)
 {
   CSingleLock lock(m_section);
@@ -196,6 +343,14 @@ MsgQueueReturnCode CDVDMessageQueue::Get(CDVDMsg** pMsg, unsigned int iTimeoutIn
       ret = MSGQ_OK;
       break;
     }
+    else if (m_ring && &msgs == &m_messages && m_ring->Pop(*pMsg))
+    {
+      priority = 0;
+      m_iDataSize -= GetPacketSize(*pMsg);
+      UpdateTimeBack();
+      ret = MSGQ_OK;
+      break;
+    }
     else if (!iTimeoutInMilliSeconds)
     {
       ret = MSGQ_TIMEOUT;
@@ -204,10 +359,23 @@ MsgQueueReturnCode CDVDMessageQueue::Get(CDVDMsg** pMsg, unsigned int iTimeoutIn
     else
     {
       m_hEvent.Reset();
+
+      if (m_ring && &msgs == &m_messages)
+      {
+        // announce the wait before checking the ring a last time, so the producer can't miss it
+        m_consumerWaiting = true;
+        if (!m_ring->Empty())
+        {
+          m_consumerWaiting = false;
+          continue;
+        }
+      }
       lock.Leave();
 
       // wait for a new message
-      if (!m_hEvent.WaitMSec(iTimeoutInMilliSeconds))
+      bool signaled = m_hEvent.WaitMSec(iTimeoutInMilliSeconds);
+      m_consumerWaiting = false;
+      if (!signaled)
         return MSGQ_TIMEOUT;
 
       lock.Enter();
@@ -236,7 +404,7 @@ void CDVDMessageQueue::UpdateTimeFront()
           m_TimeFront = packet->pts;
 
         if (m_TimeBack == DVD_NOPTS_VALUE)
-          m_TimeBack = m_TimeFront;
+          m_TimeBack = m_TimeFront.load();
       }
     }
   }
@@ -244,12 +412,18 @@ void CDVDMessageQueue::UpdateTimeFront()
 
 void CDVDMessageQueue::UpdateTimeBack()
 {
+  // the next message to be returned by Get
+  CDVDMsg* message = nullptr;
   if (!m_messages.empty())
+    message = m_messages.back().message;
+  else if (m_ring && !m_ring->Empty())
+    message = m_ring->Front();
+
+  if (message)
   {
-    auto &item = m_messages.back();
-    if (item.message->IsType(CDVDMsg::DEMUXER_PACKET))
+    if (message->IsType(CDVDMsg::DEMUXER_PACKET))
     {
-      DemuxPacket* packet = static_cast<CDVDMsgDemuxerPacket*>(item.message)->GetPacket();
+      DemuxPacket* packet = static_cast<CDVDMsgDemuxerPacket*>(message)->GetPacket();
       if (packet)
       {
         if (packet->dts != DVD_NOPTS_VALUE)
@@ -258,7 +432,7 @@ void CDVDMessageQueue::UpdateTimeBack()
           m_TimeBack = packet->pts;
 
         if (m_TimeFront == DVD_NOPTS_VALUE)
-          m_TimeFront = m_TimeBack;
+          m_TimeFront = m_TimeBack.load();
       }
     }
   }
@@ -282,6 +456,15 @@ unsigned CDVDMessageQueue::GetPacketCount(CDVDMsg::Message type)
     if(item.message->IsType(type))
       count++;
   }
+  if (m_ring)
+  {
+    size_t size = m_ring->Size();
+    for (size_t i = 0; i < size; i++)
+    {
+      if (m_ring->At(i)->IsType(type))
+        count++;
+    }
+  }
 
   return count;
 }
@@ -307,8 +490,16 @@ void CDVDMessageQueue::WaitUntilEmpty()
 
 int CDVDMessageQueue::GetLevel() const
 {
+  // the accounting is atomic, in lock-free mode the producer must not contend with the consumer
+  if (m_ring)
+    return CalcLevel();
+
   CSingleLock lock(m_section);
+  return CalcLevel();
+}
 
+int CDVDMessageQueue::CalcLevel() const
+{
   if (m_iDataSize > m_iMaxDataSize)
     return 100;
   if (m_iDataSize == 0)
@@ -333,6 +524,9 @@ int CDVDMessageQueue::GetLevel() const
 
 int CDVDMessageQueue::GetTimeSize() const
 {
+  if (m_ring)
+    return IsDataBased() ? 0 : (int)((m_TimeFront - m_TimeBack) / DVD_TIME_BASE);
+
   CSingleLock lock(m_section);
 
   if (IsDataBased())
@@ -11,10 +11,12 @@
 #include "DVDMessage.h"
 #include "threads/CriticalSection.h"
 #include "threads/Event.h"
+#include "threads/SPSCQueue.h"
 
 #include <algorithm>
 #include <atomic>
 #include <list>
+#include <memory>
 #include <string>
 
 struct DVDMessageListItem
@@ -97,22 +99,35 @@ public:
   bool IsInited() const { return m_bInitialized; }
   bool IsDataBased() const;
 
+  /*!
+   * \brief Route normal (priority 0) messages through a lock-free ring.
+   *
+   * Put() with priority 0 no longer takes the queue lock, which removes the mutex handoff
+   * between the demuxer and the decoder thread for every packet. Control messages sent with
+   * a priority keep using the locked priority lane. Must be called before Init().
+   */
+  void SetLockFreePackets(bool enable);
+  bool IsLockFreePackets() const { return m_ring != nullptr; }
+
 private:
 
   MsgQueueReturnCode Put(CDVDMsg* pMsg, int priority, bool front);
+  MsgQueueReturnCode PutRing(CDVDMsg* pMsg);
   void UpdateTimeFront();
   void UpdateTimeBack();
+  int CalcLevel() const;
+  int FlushRing(CDVDMsg::Message type);
 
   CEvent m_hEvent;
   mutable CCriticalSection m_section;
 
   std::atomic<bool> m_bAbortRequest;
-  bool m_bInitialized;
+  std::atomic<bool> m_bInitialized;
   bool m_drain = false;
 
-  int m_iDataSize;
-  double m_TimeFront;
-  double m_TimeBack;
+  std::atomic<int> m_iDataSize;
+  std::atomic<double> m_TimeFront;
+  std::atomic<double> m_TimeBack;
   double m_TimeSize;
 
   int m_iMaxDataSize;
@@ -120,5 +135,11 @@ private:
 
   std::list<DVDMessageListItem> m_messages;
   std::list<DVDMessageListItem> m_prioMessages;
+
+  // lock-free mode: priority 0 messages travel through the ring, m_messages only holds
+  // messages that were put back by the consumer. The ring is popped with m_section held.
+  std::unique_ptr<XbmcThreads::CSPSCQueue<CDVDMsg*>> m_ring;
+  std::atomic<bool> m_producerBusy{false};
+  std::atomic<bool> m_consumerWaiting{false};
 };
 
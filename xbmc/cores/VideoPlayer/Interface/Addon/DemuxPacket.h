@@ -38,4 +38,6 @@ typedef struct DemuxPacket
   bool recoveryPoint = false;
 
   std::shared_ptr<DemuxCryptoInfo> cryptoInfo;
+
+  void *pBufferRef = nullptr; // AVBufferRef owning pData if the payload was not copied from the demuxer
 } DemuxPacket;
@@ -71,6 +71,9 @@ void CProcessInfo::ResetVideoCodecInfo()
   m_videoHeight = 0;
   m_videoFPS = 0.0;
   m_videoDAR = 0.0;
+  m_videoThreadingMode = "none";
+  m_videoDecoderThreads = 0;
+  m_videoDecoderLatency = 0;
   m_videoIsInterlaced = false;
   m_deintMethods.clear();
   m_deintMethods.push_back(EINTERLACEMETHOD::VS_INTERLACEMETHOD_NONE);
@@ -85,6 +88,7 @@ void CProcessInfo::ResetVideoCodecInfo()
     m_dataCache->SetVideoDimensions(m_videoWidth, m_videoHeight);
     m_dataCache->SetVideoFps(m_videoFPS);
     m_dataCache->SetVideoDAR(m_videoDAR);
+    m_dataCache->SetVideoDecoderThreading(m_videoThreadingMode, m_videoDecoderThreads, m_videoDecoderLatency);
     m_dataCache->SetStateSeeking(m_stateSeeking);
     m_dataCache->SetVideoStereoMode(m_videoStereoMode);
   }
@@ -219,6 +223,32 @@ float CProcessInfo::GetVideoDAR()
   return m_videoDAR;
 }
 
+void CProcessInfo::SetVideoDecoderThreading(const std::string &mode, int threads, int latency)
+{
+  CSingleLock lock(m_videoCodecSection);
+
+  m_videoThreadingMode = mode;
+  m_videoDecoderThreads = threads;
+  m_videoDecoderLatency = latency;
+
+  if (m_dataCache)
+    m_dataCache->SetVideoDecoderThreading(m_videoThreadingMode, m_videoDecoderThreads, m_videoDecoderLatency);
+}
+
+std::string CProcessInfo::GetVideoDecoderThreadingMode()
+{
+  CSingleLock lock(m_videoCodecSection);
+
+  return m_videoThreadingMode;
+}
+
+int CProcessInfo::GetVideoDecoderLatency()
+{
+  CSingleLock lock(m_videoCodecSection);
+
+  return m_videoDecoderLatency;
+}
+
 void CProcessInfo::SetVideoInterlaced(bool interlaced)
 {
   CSingleLock lock(m_videoCodecSection);
@@ -494,6 +524,26 @@ bool CProcessInfo::IsRealtimeStream()
   return m_realTimeStream;
 }
 
+void CProcessInfo::SetStateFastStart(bool state)
+{
+  CSingleLock lock(m_stateSection);
+
+  m_fastStart = state;
+}
+
+bool CProcessInfo::IsFastStart()
+{
+  CSingleLock lock(m_stateSection);
+
+  return m_fastStart;
+}
+
+void CProcessInfo::SetStartupTime(int ms)
+{
+  if (m_dataCache)
+    m_dataCache->SetStartupTime(ms);
+}
+
 void CProcessInfo::SetSpeed(float speed)
 {
   CSingleLock lock(m_stateSection);
@@ -48,6 +48,9 @@ public:
   float GetVideoFps();
   void SetVideoDAR(float dar);
   float GetVideoDAR();
+  void SetVideoDecoderThreading(const std::string &mode, int threads, int latency);
+  std::string GetVideoDecoderThreadingMode();
+  int GetVideoDecoderLatency();
   void SetVideoInterlaced(bool interlaced);
   bool GetVideoInterlaced();
   virtual EINTERLACEMETHOD GetFallbackDeintMethod();
@@ -85,6 +88,9 @@ public:
   bool IsSeeking();
   void SetStateRealtime(bool state);
   bool IsRealtimeStream();
+  void SetStateFastStart(bool state);
+  bool IsFastStart();
+  void SetStartupTime(int ms);
   void SetSpeed(float speed);
   void SetNewSpeed(float speed);
   float GetNewSpeed();
@@ -126,6 +132,9 @@ protected:
   int m_videoHeight;
   float m_videoFPS;
   float m_videoDAR;
+  std::string m_videoThreadingMode;
+  int m_videoDecoderThreads;
+  int m_videoDecoderLatency;
   bool m_videoIsInterlaced;
   std::list<EINTERLACEMETHOD> m_deintMethods;
   EINTERLACEMETHOD m_deintMethodDefault;
@@ -164,6 +173,7 @@ protected:
   int64_t m_timeMax;
   int64_t m_timeMin;
   bool m_realTimeStream;
+  bool m_fastStart = false;
 
   // settings
   CCriticalSection m_settingsSection;
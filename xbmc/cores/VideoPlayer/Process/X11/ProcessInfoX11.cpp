@@ -35,6 +35,7 @@ void CProcessInfoX11::SetSwDeinterlacingMethods()
   }
   // add bob and blend deinterlacer for osx
   methods.push_back(EINTERLACEMETHOD::VS_INTERLACEMETHOD_RENDER_BOB);
+  methods.push_back(EINTERLACEMETHOD::VS_INTERLACEMETHOD_RENDER_BOB_EDI);
   methods.push_back(EINTERLACEMETHOD::VS_INTERLACEMETHOD_RENDER_BLEND);
 
   // update with the new methods list
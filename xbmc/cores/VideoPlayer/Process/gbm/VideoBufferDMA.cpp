@@ -0,0 +1,173 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "VideoBufferDMA.h"
+
+#include "threads/SingleLock.h"
+#include "utils/GBMBufferObject.h"
+#include "utils/log.h"
+
+#include <drm_fourcc.h>
+#include <gbm.h>
+
+// chroma planes are half the luma stride, so both stay aligned for SIMD
+#define DMA_STRIDE_ALIGN 128
+
+CVideoBufferDMA::CVideoBufferDMA(IVideoBufferPool& pool, int id)
+  : IVideoBufferDRMPRIME(id)
+{
+  m_pixFormat = AV_PIX_FMT_DRM_PRIME;
+}
+
+CVideoBufferDMA::~CVideoBufferDMA() = default;
+
+bool CVideoBufferDMA::IsSupportedFormat(int format)
+{
+  return format == AV_PIX_FMT_YUV420P ||
+         format == AV_PIX_FMT_YUVJ420P ||
+         format == AV_PIX_FMT_NV12;
+}
+
+bool CVideoBufferDMA::Alloc(AVCodecContext* avctx, AVFrame* frame)
+{
+  int width = frame->width;
+  int height = frame->height;
+  int linesizeAlign[AV_NUM_DATA_POINTERS];
+  avcodec_align_dimensions2(avctx, &width, &height, linesizeAlign);
+  width = (width + DMA_STRIDE_ALIGN - 1) & ~(DMA_STRIDE_ALIGN - 1);
+  height = (height + 1) & ~1;
+
+  // all planes share a single buffer of 8 bit lines as wide as the luma plane
+  if (!m_bo || m_format != frame->format || m_boWidth != width || m_boHeight != height)
+  {
+    m_bo.reset(new CGBMBufferObject(GBM_FORMAT_R8));
+    m_map = nullptr;
+    if (!m_bo->CreateBufferObject(width, height + height / 2))
+    {
+      CLog::Log(LOGERROR, "CVideoBufferDMA::%s - failed to create a %dx%d buffer object", __FUNCTION__, width, height);
+      m_bo.reset();
+      return false;
+    }
+
+    // decoders read back their reference frames
+    m_map = m_bo->GetMemoryReadWrite();
+    if (!m_map)
+    {
+      CLog::Log(LOGERROR, "CVideoBufferDMA::%s - failed to map buffer object", __FUNCTION__);
+      m_bo.reset();
+      return false;
+    }
+
+    m_format = frame->format;
+    m_boWidth = width;
+    m_boHeight = height;
+  }
+
+  const int pitch = m_bo->GetStride();
+  const int lumaSize = pitch * height;
+
+  m_descriptor = {};
+  m_descriptor.nb_objects = 1;
+  m_descriptor.objects[0].fd = m_bo->GetFd();
+  m_descriptor.objects[0].size = lumaSize + lumaSize / 2;
+  m_descriptor.objects[0].format_modifier = DRM_FORMAT_MOD_LINEAR;
+  m_descriptor.nb_layers = 1;
+
+  AVDRMLayerDescriptor* layer = &m_descriptor.layers[0];
+  layer->planes[0].object_index = 0;
+  layer->planes[0].offset = 0;
+  layer->planes[0].pitch = pitch;
+
+  frame->data[0] = m_map;
+  frame->linesize[0] = pitch;
+
+  if (frame->format == AV_PIX_FMT_NV12)
+  {
+    layer->format = DRM_FORMAT_NV12;
+    layer->nb_planes = 2;
+    layer->planes[1].object_index = 0;
+    layer->planes[1].offset = lumaSize;
+    layer->planes[1].pitch = pitch;
+
+    frame->data[1] = m_map + lumaSize;
+    frame->linesize[1] = pitch;
+  }
+  else
+  {
+    layer->format = DRM_FORMAT_YUV420;
+    layer->nb_planes = 3;
+    for (int i = 1; i < 3; i++)
+    {
+      layer->planes[i].object_index = 0;
+      layer->planes[i].offset = lumaSize + (i - 1) * lumaSize / 4;
+      layer->planes[i].pitch = pitch / 2;
+
+      frame->data[i] = m_map + layer->planes[i].offset;
+      frame->linesize[i] = pitch / 2;
+    }
+  }
+
+  return true;
+}
+
+void CVideoBufferDMA::SetPictureParams(const AVFrame* frame)
+{
+  m_width = frame->width;
+  m_height = frame->height;
+  m_colorEncoding = IVideoBufferDRMPRIME::GetColorEncoding(frame);
+  m_colorRange = IVideoBufferDRMPRIME::GetColorRange(frame);
+}
+
+CVideoBufferPoolDMA::~CVideoBufferPoolDMA()
+{
+  for (auto buf : m_all)
+    delete buf;
+}
+
+CVideoBuffer* CVideoBufferPoolDMA::Get()
+{
+  CSingleLock lock(m_critSection);
+
+  CVideoBufferDMA* buf = nullptr;
+  if (!m_free.empty())
+  {
+    int idx = m_free.front();
+    m_free.pop_front();
+    m_used.push_back(idx);
+    buf = m_all[idx];
+  }
+  else
+  {
+    int id = m_all.size();
+    buf = new CVideoBufferDMA(*this, id);
+    m_all.push_back(buf);
+    m_used.push_back(id);
+  }
+
+  buf->Acquire(GetPtr());
+  return buf;
+}
+
+void CVideoBufferPoolDMA::Return(int id)
+{
+  CSingleLock lock(m_critSection);
+
+  // the buffer object is kept for the next frame of the same size
+  auto it = m_used.begin();
+  while (it != m_used.end())
+  {
+    if (*it == id)
+    {
+      m_used.erase(it);
+      break;
+    }
+    else
+      ++it;
+  }
+  m_free.push_back(id);
+}
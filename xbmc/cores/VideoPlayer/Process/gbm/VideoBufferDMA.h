@@ -0,0 +1,80 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "cores/VideoPlayer/Process/gbm/VideoBufferDRMPRIME.h"
+#include "threads/CriticalSection.h"
+
+#include <deque>
+#include <memory>
+#include <vector>
+
+extern "C"
+{
+#include <libavcodec/avcodec.h>
+}
+
+class CGBMBufferObject;
+
+/*!
+ * \brief A DMA-BUF backed frame that software decoders write to directly
+ *
+ * The buffer is handed to FFmpeg through get_buffer2, so the decoded frame
+ * can be scanned out or imported as an EGLImage without a copy.
+ */
+class CVideoBufferDMA : public IVideoBufferDRMPRIME
+{
+public:
+  CVideoBufferDMA(IVideoBufferPool& pool, int id);
+  ~CVideoBufferDMA() override;
+
+  /*!
+   * \brief Map the buffer as the planes of a frame to be decoded
+   */
+  bool Alloc(AVCodecContext* avctx, AVFrame* frame);
+  void SetPictureParams(const AVFrame* frame);
+
+  AVDRMFrameDescriptor* GetDescriptor() const override
+  {
+    return const_cast<AVDRMFrameDescriptor*>(&m_descriptor);
+  }
+  uint32_t GetWidth() const override { return m_width; }
+  uint32_t GetHeight() const override { return m_height; }
+  int GetColorEncoding() const override { return m_colorEncoding; }
+  int GetColorRange() const override { return m_colorRange; }
+
+  static bool IsSupportedFormat(int format);
+
+private:
+  std::unique_ptr<CGBMBufferObject> m_bo;
+  uint8_t* m_map = nullptr;
+  int m_format = AV_PIX_FMT_NONE;
+  int m_boWidth = 0;
+  int m_boHeight = 0;
+
+  AVDRMFrameDescriptor m_descriptor = {};
+  uint32_t m_width = 0;
+  uint32_t m_height = 0;
+  int m_colorEncoding = DRM_COLOR_YCBCR_BT709;
+  int m_colorRange = DRM_COLOR_YCBCR_LIMITED_RANGE;
+};
+
+class CVideoBufferPoolDMA : public IVideoBufferPool
+{
+public:
+  ~CVideoBufferPoolDMA() override;
+  void Return(int id) override;
+  CVideoBuffer* Get() override;
+
+protected:
+  CCriticalSection m_critSection;
+  std::vector<CVideoBufferDMA*> m_all;
+  std::deque<int> m_used;
+  std::deque<int> m_free;
+};
@@ -43,9 +43,9 @@ void CVideoBufferDRMPRIME::Unref()
   av_frame_unref(m_pFrame);
 }
 
-int CVideoBufferDRMPRIME::GetColorEncoding() const
+int IVideoBufferDRMPRIME::GetColorEncoding(const AVFrame* frame)
 {
-  switch (m_pFrame->colorspace)
+  switch (frame->colorspace)
   {
   case AVCOL_SPC_BT2020_CL:
   case AVCOL_SPC_BT2020_NCL:
@@ -59,16 +59,16 @@ int CVideoBufferDRMPRIME::GetColorEncoding() const
   case AVCOL_SPC_RESERVED:
   case AVCOL_SPC_UNSPECIFIED:
   default:
-    if (m_pFrame->width > 1024 || m_pFrame->height >= 600)
+    if (frame->width > 1024 || frame->height >= 600)
       return DRM_COLOR_YCBCR_BT709;
     else
       return DRM_COLOR_YCBCR_BT601;
   }
 }
 
-int CVideoBufferDRMPRIME::GetColorRange() const
+int IVideoBufferDRMPRIME::GetColorRange(const AVFrame* frame)
 {
-  switch (m_pFrame->color_range)
+  switch (frame->color_range)
   {
   case AVCOL_RANGE_JPEG:
     return DRM_COLOR_YCBCR_FULL_RANGE;
@@ -78,6 +78,16 @@ int CVideoBufferDRMPRIME::GetColorRange() const
   }
 }
 
+int CVideoBufferDRMPRIME::GetColorEncoding() const
+{
+  return IVideoBufferDRMPRIME::GetColorEncoding(m_pFrame);
+}
+
+int CVideoBufferDRMPRIME::GetColorRange() const
+{
+  return IVideoBufferDRMPRIME::GetColorRange(m_pFrame);
+}
+
 bool CVideoBufferDRMPRIME::IsValid() const
 {
   AVDRMFrameDescriptor* descriptor = GetDescriptor();
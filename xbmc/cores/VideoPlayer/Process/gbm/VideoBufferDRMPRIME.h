@@ -62,6 +62,9 @@ public:
 
 protected:
   explicit IVideoBufferDRMPRIME(int id);
+
+  static int GetColorEncoding(const AVFrame* frame);
+  static int GetColorRange(const AVFrame* frame);
 };
 
 class CVideoBufferDRMPRIME : public IVideoBufferDRMPRIME
@@ -59,6 +59,7 @@
 #include "dialogs/GUIDialogKaiToast.h"
 #include "utils/JobManager.h"
 #include "utils/StringUtils.h"
+#include "utils/Tracer.h"
 #include "video/Bookmark.h"
 #include "video/VideoInfoTag.h"
 #include "Util.h"
@@ -727,6 +728,13 @@ bool CVideoPlayer::CloseFile(bool reopen)
   return true;
 }
 
+bool CVideoPlayer::QueueNextFile(const CFileItem& file)
+{
+  // the playlist player still starts the item once this one has ended, it just finds it opened
+  m_preOpen.Prepare(file);
+  return true;
+}
+
 bool CVideoPlayer::IsPlaying() const
 {
   return !m_bStop;
@@ -759,49 +767,45 @@ bool CVideoPlayer::OpenInputStream()
     m_item.SetPath(g_mediaManager.TranslateDevicePath(""));
   }
 
-  m_pInputStream = CDVDFactoryInputStream::CreateInputStream(this, m_item, true);
-  if (m_pInputStream == nullptr)
+  if (m_preOpen.Take(m_item, m_pInputStream, m_pPreparedDemuxer))
   {
-    CLog::Log(LOGERROR, "CVideoPlayer::OpenInputStream - unable to create input stream for [%s]", CURL::GetRedacted(m_item.GetPath()).c_str());
-    return false;
+    CLog::Log(LOGNOTICE, "CVideoPlayer::OpenInputStream - using the input stream opened ahead");
   }
-
-  if (!m_pInputStream->Open())
+  else
   {
-    CLog::Log(LOGERROR, "CVideoPlayer::OpenInputStream - error opening [%s]", CURL::GetRedacted(m_item.GetPath()).c_str());
-    return false;
+    m_pInputStream = CDVDFactoryInputStream::CreateInputStream(this, m_item, true);
+    if (m_pInputStream == nullptr)
+    {
+      CLog::Log(LOGERROR, "CVideoPlayer::OpenInputStream - unable to create input stream for [%s]", CURL::GetRedacted(m_item.GetPath()).c_str());
+      return false;
+    }
+
+    if (!m_pInputStream->Open())
+    {
+      CLog::Log(LOGERROR, "CVideoPlayer::OpenInputStream - error opening [%s]", CURL::GetRedacted(m_item.GetPath()).c_str());
+      return false;
+    }
   }
 
   // find any available external subtitles for non dvd files
+  m_subtitleScan.reset();
   if (!m_pInputStream->IsStreamType(DVDSTREAM_TYPE_DVD) &&
       !m_pInputStream->IsStreamType(DVDSTREAM_TYPE_PVRMANAGER))
   {
-    // find any available external subtitles
+    // listing the folders of network sources may take seconds, so playback
+    // starts right away and the subtitles found are added later on
     std::vector<std::string> filenames;
-    CUtil::ScanForExternalSubtitles(m_item.GetDynPath(), filenames);
+    if (URIUtils::IsRemote(m_item.GetDynPath()))
+      StartExternalSubtitleScan();
+    else
+      CUtil::ScanForExternalSubtitles(m_item.GetDynPath(), filenames);
 
     // load any subtitles from file item
     std::string key("subtitle:1");
     for (unsigned s = 1; m_item.HasProperty(key); key = StringUtils::Format("subtitle:%u", ++s))
       filenames.push_back(m_item.GetProperty(key).asString());
 
-    for (unsigned int i=0;i<filenames.size();i++)
-    {
-      // if vobsub subtitle:
-      if (URIUtils::HasExtension(filenames[i], ".idx"))
-      {
-        std::string strSubFile;
-        if (CUtil::FindVobSubPair( filenames, filenames[i], strSubFile))
-          AddSubtitleFile(filenames[i], strSubFile);
-      }
-      else
-      {
-        if (!CUtil::IsVobSub(filenames, filenames[i] ))
-        {
-          AddSubtitleFile(filenames[i]);
-        }
-      }
-    } // end loop over all subtitle files
+    AddExternalSubtitles(filenames);
   }
 
   m_clock.Reset();
@@ -816,8 +820,12 @@ bool CVideoPlayer::OpenDemuxStream()
 
   CLog::Log(LOGNOTICE, "Creating Demuxer");
 
+  // probed already while the previous item was playing
+  m_pDemuxer = m_pPreparedDemuxer;
+  m_pPreparedDemuxer = nullptr;
+
   int attempts = 10;
-  while (!m_bStop && attempts-- > 0)
+  while (!m_pDemuxer && !m_bStop && attempts-- > 0)
   {
     m_pDemuxer = CDVDFactoryDemuxer::CreateDemuxer(m_pInputStream);
     if(!m_pDemuxer && m_pInputStream->IsStreamType(DVDSTREAM_TYPE_PVRMANAGER))
@@ -844,7 +852,11 @@ bool CVideoPlayer::OpenDemuxStream()
   m_pDemuxer->GetPrograms(m_programs);
   UpdateContent();
   m_demuxerSpeed = DVD_PLAYSPEED_NORMAL;
-  m_processInfo->SetStateRealtime(false);
+  // known before the codecs are opened, the video decoder picks its threading model from it
+  m_processInfo->SetStateRealtime(m_pInputStream->IsRealtime());
+  m_processInfo->SetStateFastStart(CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bPVRFastZap &&
+                                   m_pInputStream->IsStreamType(DVDSTREAM_TYPE_PVRMANAGER) &&
+                                   m_pInputStream->IsRealtime());
 
   int64_t len = m_pInputStream->GetLength();
   int64_t tim = m_pDemuxer->GetStreamLength();
@@ -915,33 +927,7 @@ void CVideoPlayer::OpenDefaultStreams(bool reset)
     m_processInfo->ResetAudioCodecInfo();
   }
 
-  // enable  or disable subtitles
-  bool visible = m_processInfo->GetVideoSettings().m_SubtitleOn;
-
-  // open subtitle stream
-  SelectionStream as = m_SelectionStreams.Get(STREAM_AUDIO, GetAudioStream());
-  PredicateSubtitlePriority psp(as.language,
-                                m_processInfo->GetVideoSettings().m_SubtitleStream,
-                                m_processInfo->GetVideoSettings().m_SubtitleOn);
-  valid = false;
-  CloseStream(m_CurrentSubtitle, false);
-  for (const auto &stream : m_SelectionStreams.Get(STREAM_SUBTITLE, psp))
-  {
-    if (OpenStream(m_CurrentSubtitle, stream.demuxerId, stream.id, stream.source))
-    {
-      valid = true;
-      if(!psp.relevant(stream))
-        visible = false;
-      else if(stream.flags & StreamFlags::FLAG_FORCED)
-        visible = true;
-      break;
-    }
-  }
-  if(!valid)
-    CloseStream(m_CurrentSubtitle, false);
-
-  if (!std::dynamic_pointer_cast<CDVDInputStreamNavigator>(m_pInputStream) || m_playerOptions.state.empty())
-    SetSubtitleVisibleInternal(visible); // only set subtitle visibility if state not stored by dvd navigator, because navigator will restore it (if visible)
+  OpenDefaultSubtitleStream();
 
   // open teletext stream
   valid   = false;
@@ -989,6 +975,101 @@ void CVideoPlayer::OpenDefaultStreams(bool reset)
   }
 }
 
+void CVideoPlayer::OpenDefaultSubtitleStream()
+{
+  // enable  or disable subtitles
+  bool visible = m_processInfo->GetVideoSettings().m_SubtitleOn;
+
+  // open subtitle stream
+  SelectionStream as = m_SelectionStreams.Get(STREAM_AUDIO, GetAudioStream());
+  PredicateSubtitlePriority psp(as.language,
+                                m_processInfo->GetVideoSettings().m_SubtitleStream,
+                                m_processInfo->GetVideoSettings().m_SubtitleOn);
+  bool valid = false;
+  CloseStream(m_CurrentSubtitle, false);
+  for (const auto &stream : m_SelectionStreams.Get(STREAM_SUBTITLE, psp))
+  {
+    if (OpenStream(m_CurrentSubtitle, stream.demuxerId, stream.id, stream.source))
+    {
+      valid = true;
+      if(!psp.relevant(stream))
+        visible = false;
+      else if(stream.flags & StreamFlags::FLAG_FORCED)
+        visible = true;
+      break;
+    }
+  }
+  if(!valid)
+    CloseStream(m_CurrentSubtitle, false);
+
+  if (!std::dynamic_pointer_cast<CDVDInputStreamNavigator>(m_pInputStream) || m_playerOptions.state.empty())
+    SetSubtitleVisibleInternal(visible); // only set subtitle visibility if state not stored by dvd navigator, because navigator will restore it (if visible)
+}
+
+void CVideoPlayer::AddExternalSubtitles(const std::vector<std::string>& filenames)
+{
+  for (unsigned int i=0;i<filenames.size();i++)
+  {
+    // if vobsub subtitle:
+    if (URIUtils::HasExtension(filenames[i], ".idx"))
+    {
+      std::string strSubFile;
+      if (CUtil::FindVobSubPair( filenames, filenames[i], strSubFile))
+        AddSubtitleFile(filenames[i], strSubFile);
+    }
+    else
+    {
+      if (!CUtil::IsVobSub(filenames, filenames[i] ))
+      {
+        AddSubtitleFile(filenames[i]);
+      }
+    }
+  } // end loop over all subtitle files
+}
+
+void CVideoPlayer::StartExternalSubtitleScan()
+{
+  // the job owns a reference as well, a scan that outlives the file is dropped with it
+  std::shared_ptr<SSubtitleScan> scan = std::make_shared<SSubtitleScan>();
+  m_subtitleScan = scan;
+
+  const std::string path = m_item.GetDynPath();
+  CJobManager::GetInstance().Submit([scan, path]() {
+    std::vector<std::string> filenames;
+    CUtil::ScanForExternalSubtitles(path, filenames);
+
+    CSingleLock lock(scan->section);
+    scan->filenames = std::move(filenames);
+    scan->done = true;
+  }, CJob::PRIORITY_HIGH);
+}
+
+void CVideoPlayer::CheckExternalSubtitles()
+{
+  if (!m_subtitleScan)
+    return;
+
+  std::vector<std::string> filenames;
+  {
+    CSingleLock lock(m_subtitleScan->section);
+    if (!m_subtitleScan->done)
+      return;
+    filenames.swap(m_subtitleScan->filenames);
+  }
+  m_subtitleScan.reset();
+
+  if (filenames.empty())
+    return;
+
+  CLog::Log(LOGDEBUG, "CVideoPlayer::CheckExternalSubtitles - adding %u external subtitles",
+            static_cast<unsigned int>(filenames.size()));
+  AddExternalSubtitles(filenames);
+
+  // the default subtitle is picked again as if the subtitles had been known at start
+  if (m_dvd.iSelectedSPUStream < 0)
+    OpenDefaultSubtitleStream();
+}
+
 bool CVideoPlayer::ReadPacket(DemuxPacket*& packet, CDemuxStream*& stream)
 {
 
@@ -1194,6 +1275,10 @@ void CVideoPlayer::Prepare()
   m_offset_pts = 0;
   m_CurrentAudio.lastdts = DVD_NOPTS_VALUE;
   m_CurrentVideo.lastdts = DVD_NOPTS_VALUE;
+  m_startupStart = XbmcThreads::SystemClockMillis();
+  m_startupReported = false;
+  m_processInfo->SetStartupTime(0);
+  m_preOpenRequested = false;
 
   IPlayerCallback *cb = &m_callback;
   CFileItem fileItem = m_item;
@@ -1318,6 +1403,8 @@ void CVideoPlayer::Process()
       continue;
     }
 
+    TRACE_SCOPE("VideoPlayer::Process");
+
     // check if in a cut or commercial break that should be automatically skipped
     CheckAutoSceneSkip();
 
@@ -1363,6 +1450,9 @@ void CVideoPlayer::Process()
 
     // handle eventual seeks due to playspeed
     HandlePlaySpeed();
+    UpdateStartupTime();
+    CheckPreOpenNext();
+    CheckExternalSubtitles();
 
     // update player state
     UpdatePlayState(200);
@@ -1906,6 +1996,11 @@ void CVideoPlayer::HandlePlaySpeed()
     bool video = m_CurrentVideo.id < 0 || (m_CurrentVideo.syncState == IDVDStreamPlayer::SYNC_WAITSYNC) ||
                  (m_CurrentVideo.packets == 0 && m_CurrentAudio.packets > threshold) ||
                  (!m_VideoPlayerAudio->AcceptsData() && m_processInfo->GetLevelVQ() < 10);
+
+    // fast channel switch: start with audio, video joins with its first keyframe
+    if (m_processInfo->IsFastStart() && m_CurrentAudio.syncState == IDVDStreamPlayer::SYNC_WAITSYNC &&
+        m_CurrentVideo.syncState == IDVDStreamPlayer::SYNC_STARTING)
+      video = true;
     bool audio = m_CurrentAudio.id < 0 || (m_CurrentAudio.syncState == IDVDStreamPlayer::SYNC_WAITSYNC) ||
                  (m_CurrentAudio.packets == 0 && m_CurrentVideo.packets > threshold) ||
                  (!m_VideoPlayerVideo->AcceptsData() && m_VideoPlayerAudio->GetLevel() < 10);
@@ -2389,6 +2484,9 @@ void CVideoPlayer::OnExit()
   // set event to inform openfile something went wrong in case openfile is still waiting for this event
   SetCaching(CACHESTATE_DONE);
 
+  // subtitles still being searched for are of no use anymore
+  m_subtitleScan.reset();
+
   // close each stream
   if (!m_bAbortRequest)
     CLog::Log(LOGNOTICE, "VideoPlayer: eof, waiting for queues to empty");
@@ -2428,8 +2526,13 @@ void CVideoPlayer::OnExit()
     cb->OnPlayerCloseFile(fileItem, bookmark);
   });
 
+  // the item opened ahead is of no use if playback was stopped
+  if (m_bCloseRequest)
+    m_preOpen.Reset();
+
   // destroy objects
   SAFE_DELETE(m_pDemuxer);
+  SAFE_DELETE(m_pPreparedDemuxer);
   m_pSubtitleDemuxer.reset();
   m_subtitleDemuxerMap.clear();
   SAFE_DELETE(m_pCCDemuxer);
@@ -2442,6 +2545,9 @@ void CVideoPlayer::OnExit()
 
   m_messenger.End();
 
+  // all packets of this playback are gone, don't keep their buffers around
+  CDVDDemuxUtils::TrimDemuxPacketPool();
+
   CFFmpegLog::ClearLogLevel();
   m_bStop = true;
 
@@ -4333,6 +4439,39 @@ bool CVideoPlayer::OnAction(const CAction &action)
   return false;
 }
 
+void CVideoPlayer::UpdateStartupTime()
+{
+  if (m_startupReported || !m_State.streamsReady)
+    return;
+
+  // done when the first picture is on screen, or with audio only once the streams are synced
+  if (m_CurrentVideo.id >= 0 && m_VideoPlayerVideo->GetCurrentPts() == DVD_NOPTS_VALUE)
+    return;
+
+  const int startupTime = static_cast<int>(XbmcThreads::SystemClockMillis() - m_startupStart);
+  m_processInfo->SetStartupTime(startupTime);
+  m_startupReported = true;
+
+  CLog::Log(LOGDEBUG, "CVideoPlayer::UpdateStartupTime - started in %d ms", startupTime);
+}
+
+void CVideoPlayer::CheckPreOpenNext()
+{
+  if (m_preOpenRequested || !m_State.streamsReady || !m_HasVideo)
+    return;
+
+  const unsigned int seconds = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoPreOpenNextSeconds;
+  if (seconds == 0 || !m_pInputStream || m_pInputStream->IsRealtime() || IsInMenuInternal())
+    return;
+
+  if (m_State.timeMax <= 0 || m_State.timeMax - m_State.time > seconds * 1000.0)
+    return;
+
+  // the playlist player hands the next item to QueueNextFile
+  m_preOpenRequested = true;
+  m_callback.OnQueueNextItem();
+}
+
 bool CVideoPlayer::IsInMenuInternal() const
 {
   std::shared_ptr<CDVDInputStream::IMenus> pStream = std::dynamic_pointer_cast<CDVDInputStream::IMenus>(m_pInputStream);
@@ -4550,6 +4689,14 @@ void CVideoPlayer::UpdatePlayState(double timeout)
     }
     CServiceBroker::GetDataCacheCore().SetChapters(state.chapters);
 
+    SDemuxPacketPoolInfo poolInfo;
+    CDVDDemuxUtils::GetDemuxPacketPoolInfo(poolInfo);
+    CServiceBroker::GetDataCacheCore().SetDemuxPacketPoolInfo(poolInfo);
+
+    SRenderTelemetryInfo telemetry;
+    m_renderManager.GetTelemetry(telemetry);
+    CServiceBroker::GetDataCacheCore().SetRenderTelemetryInfo(telemetry);
+
     state.time = m_clock.GetClock(false) * 1000 / DVD_TIME_BASE;
     state.timeMax = m_pDemuxer->GetStreamLength();
   }
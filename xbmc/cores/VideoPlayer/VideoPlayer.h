@@ -13,6 +13,7 @@
 #include "Edl.h"
 #include "FileItem.h"
 #include "IVideoPlayer.h"
+#include "VideoPlayerPreOpen.h"
 #include "VideoPlayerRadioRDS.h"
 #include "VideoPlayerSubtitle.h"
 #include "VideoPlayerTeletext.h"
@@ -241,6 +242,7 @@ public:
   ~CVideoPlayer() override;
   bool OpenFile(const CFileItem& file, const CPlayerOptions &options) override;
   bool CloseFile(bool reopen = false) override;
+  bool QueueNextFile(const CFileItem& file) override;
   bool IsPlaying() const override;
   void Pause() override;
   bool HasVideo() const override;
@@ -404,6 +406,11 @@ protected:
 
   void HandleMessages();
   void HandlePlaySpeed();
+  void UpdateStartupTime();
+  void CheckPreOpenNext();
+  void StartExternalSubtitleScan();
+  void CheckExternalSubtitles();
+  void AddExternalSubtitles(const std::vector<std::string>& filenames);
   bool IsInMenuInternal() const;
   void SynchronizeDemuxer();
   void CheckAutoSceneSkip();
@@ -425,6 +432,7 @@ protected:
   bool OpenDemuxStream();
   void CloseDemuxer();
   void OpenDefaultStreams(bool reset = true);
+  void OpenDefaultSubtitleStream();
 
   void UpdatePlayState(double timeout);
   void GetGeneralInfo(std::string& strVideoInfo);
@@ -497,6 +505,7 @@ protected:
 
   std::shared_ptr<CDVDInputStream> m_pInputStream;
   CDVDDemux* m_pDemuxer;
+  CDVDDemux* m_pPreparedDemuxer = nullptr;
   std::shared_ptr<CDVDDemux> m_pSubtitleDemuxer;
   std::unordered_map<int64_t, std::shared_ptr<CDVDDemux>> m_subtitleDemuxerMap;
   CDVDDemuxCC* m_pCCDemuxer;
@@ -528,6 +537,19 @@ protected:
   SPlayerState m_State;
   mutable CCriticalSection m_StateSection;
   XbmcThreads::EndTime m_syncTimer;
+  unsigned int m_startupStart = 0;
+  bool m_startupReported = false;
+
+  CVideoPlayerPreOpen m_preOpen;
+  bool m_preOpenRequested = false;
+
+  struct SSubtitleScan
+  {
+    CCriticalSection section;
+    bool done = false;
+    std::vector<std::string> filenames;
+  };
+  std::shared_ptr<SSubtitleScan> m_subtitleScan;
 
   CEdl m_Edl;
   bool m_SkipCommercials;
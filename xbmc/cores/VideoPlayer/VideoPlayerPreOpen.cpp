@@ -0,0 +1,174 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "VideoPlayerPreOpen.h"
+
+#include "DVDDemuxers/DVDDemux.h"
+#include "DVDDemuxers/DVDFactoryDemuxer.h"
+#include "DVDInputStreams/DVDFactoryInputStream.h"
+#include "DVDInputStreams/DVDInputStream.h"
+#include "FileItem.h"
+#include "URL.h"
+#include "threads/Event.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/JobManager.h"
+#include "utils/log.h"
+
+namespace
+{
+// the player would have opened by itself in that time
+constexpr unsigned int TAKE_TIMEOUT_MS = 10000;
+}
+
+struct CVideoPlayerPreOpen::SState
+{
+  explicit SState(const CFileItem& fileItem) : item(fileItem), done(true) {}
+
+  ~SState()
+  {
+    delete demuxer;
+  }
+
+  const CFileItem item;
+  CCriticalSection section;
+  CEvent done;
+  bool aborted = false;
+  bool success = false;
+  std::shared_ptr<CDVDInputStream> inputStream;
+  CDVDDemux* demuxer = nullptr;
+};
+
+CVideoPlayerPreOpen::~CVideoPlayerPreOpen()
+{
+  Reset();
+}
+
+void CVideoPlayerPreOpen::Prepare(const CFileItem& item)
+{
+  Reset();
+
+  CLog::Log(LOGDEBUG, "CVideoPlayerPreOpen::Prepare - opening %s", CURL::GetRedacted(item.GetDynPath()).c_str());
+
+  std::shared_ptr<SState> state = std::make_shared<SState>(item);
+  {
+    CSingleLock lock(m_section);
+    m_state = state;
+  }
+  CJobManager::GetInstance().Submit([state]() { Process(state); }, CJob::PRIORITY_LOW);
+}
+
+void CVideoPlayerPreOpen::Process(std::shared_ptr<SState> state)
+{
+  const unsigned int start = XbmcThreads::SystemClockMillis();
+
+  std::shared_ptr<CDVDInputStream> inputStream =
+    CDVDFactoryInputStream::CreateInputStream(nullptr, state->item, true);
+  if (!inputStream || !(inputStream->IsStreamType(DVDSTREAM_TYPE_FILE) ||
+                        inputStream->IsStreamType(DVDSTREAM_TYPE_FFMPEG)))
+  {
+    CLog::Log(LOGDEBUG, "CVideoPlayerPreOpen::Process - input stream can't be opened ahead");
+    state->done.Set();
+    return;
+  }
+
+  {
+    CSingleLock lock(state->section);
+    if (state->aborted)
+    {
+      state->done.Set();
+      return;
+    }
+    // published before the open so that Reset() can abort it
+    state->inputStream = inputStream;
+  }
+
+  CDVDDemux* demuxer = nullptr;
+  if (inputStream->Open())
+    demuxer = CDVDFactoryDemuxer::CreateDemuxer(inputStream);
+  inputStream.reset();
+
+  {
+    CSingleLock lock(state->section);
+    state->demuxer = demuxer;
+    state->success = demuxer != nullptr && !state->aborted;
+  }
+
+  if (state->success)
+    CLog::Log(LOGDEBUG, "CVideoPlayerPreOpen::Process - prepared %s in %u ms",
+              CURL::GetRedacted(state->item.GetDynPath()).c_str(),
+              XbmcThreads::SystemClockMillis() - start);
+  else
+    CLog::Log(LOGDEBUG, "CVideoPlayerPreOpen::Process - failed to prepare %s",
+              CURL::GetRedacted(state->item.GetDynPath()).c_str());
+
+  state->done.Set();
+}
+
+bool CVideoPlayerPreOpen::Take(const CFileItem& item,
+                               std::shared_ptr<CDVDInputStream>& inputStream,
+                               CDVDDemux*& demuxer)
+{
+  std::shared_ptr<SState> state;
+  {
+    CSingleLock lock(m_section);
+    state.swap(m_state);
+  }
+
+  if (!state)
+    return false;
+
+  if (state->item.GetDynPath() != item.GetDynPath())
+  {
+    Abort(state);
+    return false;
+  }
+
+  if (!state->done.WaitMSec(TAKE_TIMEOUT_MS))
+  {
+    CLog::Log(LOGDEBUG, "CVideoPlayerPreOpen::Take - open ahead still running, giving up");
+    Abort(state);
+    return false;
+  }
+
+  CSingleLock lock(state->section);
+  if (!state->success)
+    return false;
+
+  inputStream = std::move(state->inputStream);
+  demuxer = state->demuxer;
+  state->demuxer = nullptr;
+  return true;
+}
+
+void CVideoPlayerPreOpen::Reset()
+{
+  std::shared_ptr<SState> state;
+  {
+    CSingleLock lock(m_section);
+    state.swap(m_state);
+  }
+
+  if (state)
+    Abort(state);
+}
+
+bool CVideoPlayerPreOpen::IsPending() const
+{
+  CSingleLock lock(m_section);
+  return m_state != nullptr;
+}
+
+void CVideoPlayerPreOpen::Abort(const std::shared_ptr<SState>& state)
+{
+  // the job owns a reference as well, whatever it opens is released with the last one
+  CSingleLock lock(state->section);
+  state->aborted = true;
+  if (state->inputStream)
+    state->inputStream->Abort();
+}
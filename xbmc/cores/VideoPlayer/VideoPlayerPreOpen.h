@@ -0,0 +1,63 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <memory>
+#include <string>
+
+class CDVDDemux;
+class CDVDInputStream;
+class CFileItem;
+
+/*!
+ * \brief Opens the next playlist item while the current one is still playing.
+ *
+ * The input stream is opened and the demuxer probes the streams on a job thread, which also
+ * fills the file cache for buffered sources. When the player moves on to the same item it takes
+ * over both objects instead of opening them again. Only plain files and ffmpeg streams are
+ * prepared, everything that needs the player to open (discs, addons, pvr) is skipped.
+ */
+class CVideoPlayerPreOpen
+{
+public:
+  CVideoPlayerPreOpen() = default;
+  ~CVideoPlayerPreOpen();
+
+  /*!
+   * \brief Start opening the item in the background, anything prepared before is dropped
+   */
+  void Prepare(const CFileItem& item);
+
+  /*!
+   * \brief Hand out the prepared objects if they belong to the item
+   *
+   * Waits for an open that is still running, the prepared objects are handed out only once.
+   * The caller owns the returned demuxer. Anything prepared for a different item is dropped.
+   * \return true if input stream and demuxer were taken over
+   */
+  bool Take(const CFileItem& item, std::shared_ptr<CDVDInputStream>& inputStream, CDVDDemux*& demuxer);
+
+  /*!
+   * \brief Abort a running open and drop everything prepared
+   */
+  void Reset();
+
+  bool IsPending() const;
+
+private:
+  struct SState;
+
+  static void Process(std::shared_ptr<SState> state);
+  static void Abort(const std::shared_ptr<SState>& state);
+
+  mutable CCriticalSection m_section;
+  std::shared_ptr<SState> m_state;
+};
@@ -12,8 +12,16 @@
 #include "cores/VideoPlayer/Interface/Addon/DemuxPacket.h"
 #include "cores/VideoPlayer/Interface/Addon/TimingConstants.h"
 #include "threads/SingleLock.h"
+#include "utils/StringUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+// channels whose pages are kept when switching away from them
+#define TELETEXT_CACHED_CHANNELS 4
+
 const uint8_t rev_lut[32] =
 {
   0x00,0x08,0x04,0x0c, /*  upper nibble */
@@ -78,6 +86,29 @@ signed int CDVDTeletextTools::deh24(unsigned char *p)
 }
 
 
+struct CDVDTeletextData::SChannelPages
+{
+  ~SChannelPages()
+  {
+    for (const auto& page : pages)
+      FreePage(page.second);
+    for (TextExtData_t* ext : p29)
+      FreeExtData(ext);
+  }
+
+  std::string stationId;
+  std::vector<std::pair<int, TextCachedPage_t*>> pages; // page << 8 | subpage
+  TextExtData_t* p29[9] = {};
+  unsigned char subPageTable[0x900];
+  unsigned char basicTop[0x900];
+  short flofPages[0x900][FLOFSIZE];
+  char adipTable[0x900][13];
+  int adipPgMax;
+  int adipPg[10];
+  bool btTok;
+  TextSubtitle_t subtitlePages[8];
+};
+
 CDVDTeletextData::CDVDTeletextData(CProcessInfo &processInfo)
 : CThread("DVDTeletextData")
 , IDVDStreamPlayer(processInfo)
@@ -137,54 +168,55 @@ void CDVDTeletextData::CloseStream(bool bWaitForBuffers)
 }
 
 
+void CDVDTeletextData::FreePage(TextCachedPage_t* page)
+{
+  if (!page)
+    return;
+
+  TextPageinfo_t *p = &(page->pageinfo);
+  if (p->p24)
+    free(p->p24);
+
+  FreeExtData(p->ext);
+  delete page;
+}
+
+void CDVDTeletextData::FreeExtData(TextExtData_t* ext)
+{
+  if (!ext)
+    return;
+
+  if (ext->p27)
+    free(ext->p27);
+
+  for (unsigned char* const d26 : ext->p26)
+  {
+    if (d26)
+      free(d26);
+  }
+  free(ext);
+}
+
 void CDVDTeletextData::ResetTeletextCache()
 {
   CSingleLock lock(m_critSection);
 
+  ParkChannel();
+
   /* Reset Data structures */
   for (auto& pages : m_TXTCache->astCachetable)
   {
     for (TextCachedPage_t*& page : pages)
     {
-      if (page)
-      {
-        TextPageinfo_t *p = &(page->pageinfo);
-        if (p->p24)
-          free(p->p24);
-
-        if (p->ext)
-        {
-          if (p->ext->p27)
-            free(p->ext->p27);
-
-          for (unsigned char* const d26 : p->ext->p26)
-          {
-            if (d26)
-              free(d26);
-          }
-          free(p->ext);
-        }
-        delete page;
-        page = 0;
-      }
+      FreePage(page);
+      page = 0;
     }
   }
 
   for (int i = 0; i < 9; i++)
   {
-    if (m_TXTCache->astP29[i])
-    {
-      if (m_TXTCache->astP29[i]->p27)
-        free(m_TXTCache->astP29[i]->p27);
-
-      for (unsigned char* const d26 : m_TXTCache->astP29[i]->p26)
-      {
-        if (d26)
-          free(d26);
-      }
-      free(m_TXTCache->astP29[i]);
-      m_TXTCache->astP29[i] = 0;
-    }
+    FreeExtData(m_TXTCache->astP29[i]);
+    m_TXTCache->astP29[i] = 0;
     m_TXTCache->CurrentPage[i]    = -1;
     m_TXTCache->CurrentSubPage[i] = -1;
   }
@@ -213,6 +245,119 @@ void CDVDTeletextData::ResetTeletextCache()
     m_TXTCache->SubPage = 0;
 }
 
+void CDVDTeletextData::ParkChannel()
+{
+  std::string stationId = m_TXTCache->line30;
+  StringUtils::Trim(stationId);
+  if (stationId.empty() || m_TXTCache->CachedPages == 0)
+    return;
+
+  std::unique_ptr<SChannelPages> channel(new SChannelPages);
+  channel->stationId = m_TXTCache->line30;
+
+  for (int p = 0; p < 0x900; p++)
+  {
+    for (int sp = 0; sp < 0x80; sp++)
+    {
+      TextCachedPage_t*& page = m_TXTCache->astCachetable[p][sp];
+      if (page)
+      {
+        channel->pages.emplace_back(p << 8 | sp, page);
+        page = 0;
+      }
+    }
+  }
+
+  for (int i = 0; i < 9; i++)
+  {
+    channel->p29[i] = m_TXTCache->astP29[i];
+    m_TXTCache->astP29[i] = 0;
+  }
+
+  memcpy(channel->subPageTable, m_TXTCache->SubPageTable, sizeof(channel->subPageTable));
+  memcpy(channel->basicTop, m_TXTCache->BasicTop, sizeof(channel->basicTop));
+  memcpy(channel->flofPages, m_TXTCache->FlofPages, sizeof(channel->flofPages));
+  memcpy(channel->adipTable, m_TXTCache->ADIPTable, sizeof(channel->adipTable));
+  channel->adipPgMax = m_TXTCache->ADIP_PgMax;
+  memcpy(channel->adipPg, m_TXTCache->ADIP_Pg, sizeof(channel->adipPg));
+  channel->btTok = m_TXTCache->BTTok;
+  memcpy(channel->subtitlePages, m_TXTCache->SubtitlePages, sizeof(channel->subtitlePages));
+
+  m_channels.remove_if([&channel](const std::unique_ptr<SChannelPages>& parked)
+                       { return parked->stationId == channel->stationId; });
+  m_channels.push_front(std::move(channel));
+  if (m_channels.size() > TELETEXT_CACHED_CHANNELS)
+    m_channels.pop_back();
+}
+
+void CDVDTeletextData::RestoreChannel()
+{
+  auto it = std::find_if(m_channels.begin(), m_channels.end(),
+                         [this](const std::unique_ptr<SChannelPages>& parked)
+                         { return parked->stationId == m_TXTCache->line30; });
+  if (it == m_channels.end())
+    return;
+
+  std::unique_ptr<SChannelPages> channel = std::move(*it);
+  m_channels.erase(it);
+
+  CSingleLock lock(m_critSection);
+
+  // pages received since the channel was tuned again are newer than the parked ones
+  for (auto& parked : channel->pages)
+  {
+    const int p = parked.first >> 8;
+    TextCachedPage_t*& page = m_TXTCache->astCachetable[p][parked.first & 0xff];
+    if (page)
+      continue;
+
+    page = parked.second;
+    parked.second = 0;
+    m_TXTCache->CachedPages++;
+    if (m_TXTCache->SubPageTable[p] == 0xff)
+      m_TXTCache->SubPageTable[p] = channel->subPageTable[p];
+  }
+
+  for (int i = 0; i < 9; i++)
+  {
+    if (!m_TXTCache->astP29[i])
+      std::swap(m_TXTCache->astP29[i], channel->p29[i]);
+  }
+
+  for (int p = 0; p < 0x900; p++)
+  {
+    if (!m_TXTCache->BasicTop[p])
+      m_TXTCache->BasicTop[p] = channel->basicTop[p];
+    if (std::all_of(m_TXTCache->FlofPages[p], m_TXTCache->FlofPages[p] + FLOFSIZE, [](short link) { return !link; }))
+      memcpy(m_TXTCache->FlofPages[p], channel->flofPages[p], sizeof(m_TXTCache->FlofPages[p]));
+    if (!m_TXTCache->ADIPTable[p][0])
+      memcpy(m_TXTCache->ADIPTable[p], channel->adipTable[p], sizeof(m_TXTCache->ADIPTable[p]));
+  }
+
+  if (m_TXTCache->ADIP_PgMax < 0)
+  {
+    m_TXTCache->ADIP_PgMax = channel->adipPgMax;
+    memcpy(m_TXTCache->ADIP_Pg, channel->adipPg, sizeof(m_TXTCache->ADIP_Pg));
+  }
+  m_TXTCache->BTTok |= channel->btTok;
+
+  for (const TextSubtitle_t& subtitle : channel->subtitlePages)
+  {
+    TextSubtitle_t* end = m_TXTCache->SubtitlePages + 8;
+    if (!subtitle.page || std::any_of(m_TXTCache->SubtitlePages, end, [&subtitle](const TextSubtitle_t& live)
+                                      { return live.page == subtitle.page; }))
+      continue;
+
+    TextSubtitle_t* slot = std::find_if(m_TXTCache->SubtitlePages, end, [](const TextSubtitle_t& live) { return !live.page; });
+    if (slot != end)
+      *slot = subtitle;
+  }
+
+  m_TXTCache->PageUpdate = true;
+  CLog::Log(LOGDEBUG, "CDVDTeletextData: restored %d pages of %s", m_TXTCache->CachedPages,
+            m_TXTCache->line30.c_str());
+}
+
 void CDVDTeletextData::Process()
 {
   int             b1, b2, b3, b4;
@@ -245,8 +390,8 @@ void CDVDTeletextData::Process()
 
     if (pMsg->IsType(CDVDMsg::DEMUXER_PACKET))
     {
-      CSingleLock lock(m_critSection);
-
+      // the rows are decoded without holding the lock, only copying a page to or from the
+      // cache takes it, so the renderer can load pages while a packet is being decoded
       DemuxPacket* pPacket = static_cast<CDVDMsgDemuxerPacket*>(pMsg)->GetPacket();
       uint8_t *Datai       = pPacket->pData;
       int rows             = (pPacket->iSize - 1) / 46;
@@ -604,9 +749,14 @@ void CDVDTeletextData::Process()
               }
               else if (packet_number == 30)
               {
+                const bool tuned = m_TXTCache->line30.empty();
                 m_TXTCache->line30 = "";
                 for (int i=26-4; i <= 45-4; i++) /* station ID */
                   m_TXTCache->line30.append(1, deparity[vtxt_row[i]]);
+
+                /* first station ID since the cache was reset, reuse the pages of a channel we left */
+                if (tuned)
+                  RestoreChannel();
               }
             }
 
@@ -13,6 +13,9 @@
 #include "threads/Thread.h"
 #include "video/TeletextDefines.h"
 
+#include <list>
+#include <memory>
+
 class CDVDStreamInfo;
 
 class CDVDTeletextData : public CThread, public IDVDStreamPlayer
@@ -42,7 +45,13 @@ protected:
   void Process() override;
 
 private:
+  struct SChannelPages;
+
   void ResetTeletextCache();
+  void ParkChannel();
+  void RestoreChannel();
+  static void FreePage(TextCachedPage_t* page);
+  static void FreeExtData(TextExtData_t* ext);
   void Decode_p2829(unsigned char *vtxt_row, TextExtData_t **ptExtData);
   void SavePage(int p, int sp, unsigned char* buffer);
   void ErasePage(int magazine);
@@ -52,5 +61,8 @@ private:
   std::shared_ptr<TextCacheStruct_t> m_TXTCache = std::make_shared<TextCacheStruct_t>();
   CCriticalSection m_critSection;
   CDVDMessageQueue m_messageQueue;
+
+  // pages of recently left channels by station ID, the most recent first
+  std::list<std::unique_ptr<SChannelPages>> m_channels;
 };
 
@@ -18,6 +18,7 @@
 #include "settings/SettingsComponent.h"
 #include "utils/MathUtils.h"
 #include "utils/log.h"
+#include "utils/Tracer.h"
 #include "windowing/GraphicContext.h"
 #include "windowing/WinSystem.h"
 
@@ -69,6 +70,7 @@ CVideoPlayerVideo::CVideoPlayerVideo(CDVDClock* pClock
   m_fForcedAspectRatio = 0;
   m_messageQueue.SetMaxDataSize(40 * 1024 * 1024);
   m_messageQueue.SetMaxTimeSize(8.0);
+  m_messageQueue.SetLockFreePackets(CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoLockFreePacketQueue);
 
   m_iDroppedFrames = 0;
   m_fFrameRate = 25;
@@ -126,10 +128,16 @@ bool CVideoPlayerVideo::OpenStream(CDVDStreamInfo hint)
     {
       hint.codecOptions |= CODEC_ALLOW_FALLBACK;
     }
-    CDVDVideoCodec* codec = CDVDFactoryCodec::CreateVideoCodec(hint, m_processInfo);
-    if (!codec)
+    // a running codec may reconfigure itself for the new stream on the video
+    // thread, which is much cheaper than opening a new hardware decoder
+    CDVDVideoCodec* codec = nullptr;
+    if (!m_pVideoCodec)
     {
-      CLog::Log(LOGINFO, "CVideoPlayerVideo::OpenStream - could not open video codec");
+      codec = CDVDFactoryCodec::CreateVideoCodec(hint, m_processInfo);
+      if (!codec)
+      {
+        CLog::Log(LOGINFO, "CVideoPlayerVideo::OpenStream - could not open video codec");
+      }
     }
     SendMessage(new CDVDMsgVideoCodecChange(hint, codec), 0);
   }
@@ -193,6 +201,8 @@ void CVideoPlayerVideo::OpenStream(CDVDStreamInfo &hint, CDVDVideoCodec* codec)
   if (m_pVideoCodec && m_pVideoCodec->Reconfigure(hint))
   {
     // reuse old decoder
+    CLog::Log(LOGDEBUG, "CVideoPlayerVideo::OpenStream - reusing %s", m_pVideoCodec->GetName());
+    delete codec;
     codec = m_pVideoCodec;
   }
   else if (m_pVideoCodec)
@@ -219,6 +229,7 @@ void CVideoPlayerVideo::OpenStream(CDVDStreamInfo &hint, CDVDVideoCodec* codec)
   m_rewindStalled = false;
   m_packets.clear();
   m_syncState = IDVDStreamPlayer::SYNC_STARTING;
+  m_forceFirstPicture = false;
   m_renderManager.ShowVideo(false);
 }
 
@@ -409,6 +420,10 @@ void CVideoPlayerVideo::Process()
     {
       pts = static_cast<CDVDMsgDouble*>(pMsg)->m_value;
 
+      // on a fast channel switch audio started without us
+      if (m_syncState == IDVDStreamPlayer::SYNC_STARTING && m_processInfo.IsFastStart())
+        m_forceFirstPicture = true;
+
       m_syncState = IDVDStreamPlayer::SYNC_INSYNC;
       m_droppingStats.Reset();
       m_rewindStalled = false;
@@ -433,6 +448,7 @@ void CVideoPlayerVideo::Process()
       m_packets.clear();
       m_droppingStats.Reset();
       m_syncState = IDVDStreamPlayer::SYNC_STARTING;
+      m_forceFirstPicture = false;
       m_renderManager.ShowVideo(false);
       m_rewindStalled = false;
     }
@@ -460,6 +476,7 @@ void CVideoPlayerVideo::Process()
       if (sync)
       {
         m_syncState = IDVDStreamPlayer::SYNC_STARTING;
+        m_forceFirstPicture = false;
         m_renderManager.ShowVideo(false);
       }
 
@@ -559,7 +576,12 @@ void CVideoPlayerVideo::Process()
         codecControl |= DVD_CODEC_CTRL_ROTATE;
       m_pVideoCodec->SetCodecControl(codecControl);
 
-      if (m_pVideoCodec->AddData(*pPacket))
+      bool added;
+      {
+        TRACE_SCOPE("VideoPlayerVideo::AddData");
+        added = m_pVideoCodec->AddData(*pPacket);
+      }
+      if (added)
       {
         // buffer packets so we can recover should decoder flush for some reason
         if (m_pVideoCodec->GetConvergeCount() > 0)
@@ -591,6 +613,8 @@ void CVideoPlayerVideo::Process()
 
 bool CVideoPlayerVideo::ProcessDecoderOutput(double &frametime, double &pts)
 {
+  TRACE_SCOPE("VideoPlayerVideo::ProcessDecoderOutput");
+
   CDVDVideoCodec::VCReturn decoderState = m_pVideoCodec->GetPicture(&m_picture);
 
   if (decoderState == CDVDVideoCodec::VC_BUFFER)
@@ -921,11 +945,13 @@ CVideoPlayerVideo::EOutputState CVideoPlayerVideo::OutputPicture(const VideoPict
   if (!m_processInfo.Supports(deintMethod))
     deintMethod = m_processInfo.GetDeinterlacingMethodDefault();
 
-  if (!m_renderManager.AddVideoPicture(*pPicture, m_bAbortOutput, deintMethod, (m_syncState == ESyncState::SYNC_STARTING)))
+  const bool wait = m_syncState == ESyncState::SYNC_STARTING || m_forceFirstPicture;
+  if (!m_renderManager.AddVideoPicture(*pPicture, m_bAbortOutput, deintMethod, wait))
   {
     m_droppingStats.AddOutputDropGain(pPicture->pts, 1);
     return OUTPUT_DROPPED;
   }
+  m_forceFirstPicture = false;
 
   return OUTPUT_NORMAL;
 }
@@ -938,6 +964,8 @@ std::string CVideoPlayerVideo::GetPlayerInfo()
   s << ", fr:"     << std::fixed << std::setprecision(3) << m_fFrameRate;
   s << ", drop:" << m_iDroppedFrames;
   s << ", skip:" << m_renderManager.GetSkippedFrames();
+  s << ", thr:" << m_processInfo.GetVideoDecoderThreadingMode();
+  s << ", lat:" << m_processInfo.GetVideoDecoderLatency();
 
   int pc = m_ptsTracker.GetPatternLength();
   if (pc > 0)
@@ -124,6 +124,7 @@ protected:
   std::atomic_bool m_rewindStalled;
   bool m_paused;
   IDVDStreamPlayer::ESyncState m_syncState;
+  bool m_forceFirstPicture = false; // synced before the first picture, show it without waiting for the clock
   std::atomic_bool m_bAbortOutput;
 
   BitstreamStats m_videoStats;
@@ -13,14 +13,76 @@
 #include "filesystem/File.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+#include "utils/StringUtils.h"
 #include "utils/TimeUtils.h"
 #include "utils/log.h"
 
+#include <list>
 #include <math.h>
+#include <string.h>
 #include <vector>
 
 using namespace XFILE;
 
+// sampled CLUTs are shared by all renderers, the default 64^3 RGB one is 1.5 MiB
+#define CLUT_CACHE_MAX_BYTES (32 * 1024 * 1024)
+
+struct CachedClut
+{
+  std::string key;
+  std::vector<uint16_t> data;
+};
+
+static CCriticalSection clutCacheSection;
+static std::list<CachedClut> clutCache; // most recently used first
+
+static bool GetCachedClut(const std::string &key, uint16_t *clutData, size_t size)
+{
+  CSingleLock lock(clutCacheSection);
+  for (auto it = clutCache.begin(); it != clutCache.end(); ++it)
+  {
+    if (it->key == key && it->data.size() == size)
+    {
+      memcpy(clutData, it->data.data(), size * sizeof(uint16_t));
+      clutCache.splice(clutCache.begin(), clutCache, it);
+      return true;
+    }
+  }
+  return false;
+}
+
+static void AddCachedClut(const std::string &key, const uint16_t *clutData, size_t size)
+{
+  if (size * sizeof(uint16_t) > CLUT_CACHE_MAX_BYTES)
+    return;
+
+  CSingleLock lock(clutCacheSection);
+  clutCache.push_front({ key, std::vector<uint16_t>(clutData, clutData + size) });
+
+  size_t bytes = 0;
+  for (auto it = clutCache.begin(); it != clutCache.end(); ++it)
+  {
+    bytes += it->data.size() * sizeof(uint16_t);
+    if (bytes > CLUT_CACHE_MAX_BYTES)
+    {
+      clutCache.erase(it, clutCache.end());
+      break;
+    }
+  }
+}
+
+// a file rewritten in place (e.g. a new calibration) gets a new key
+static std::string GetFileCacheKey(const std::string &fileName)
+{
+  struct __stat64 st;
+  if (CFile::Stat(fileName, &st) != 0)
+    return fileName;
+  return StringUtils::Format("%s@%lld/%lld", fileName.c_str(),
+                             static_cast<long long>(st.st_mtime), static_cast<long long>(st.st_size));
+}
+
 CColorManager::CColorManager()
 {
   m_curVideoPrimaries = CMS_PRIMARIES_AUTO;
@@ -157,13 +219,22 @@ bool CColorManager::GetVideo3dLut(int videoFlags, int *cmsToken, CMS_DATA_FORMAT
   const std::shared_ptr<CSettings> settings = CServiceBroker::GetSettingsComponent()->GetSettings();
   CMS_PRIMARIES videoPrimaries = videoFlagsToPrimaries(videoFlags);
   CLog::Log(LOGDEBUG, "ColorManager: video primaries: %d\n", (int)videoPrimaries);
+  const size_t clutSamples = static_cast<size_t>(clutSize) * clutSize * clutSize * (format == CMS_DATA_FMT_RGBA ? 4 : 3);
+  std::string cacheKey;
   switch (settings->GetInt("videoscreen.cmsmode"))
   {
   case CMS_MODE_3DLUT:
     CLog::Log(LOGDEBUG, "ColorManager: CMS_MODE_3DLUT\n");
     m_cur3dlutFile = settings->GetString("videoscreen.cms3dlut");
-    if (!Load3dLut(m_cur3dlutFile, format, clutSize, clutData))
-      return false;
+    cacheKey = StringUtils::Format("3dlut|%s|%d|%d", GetFileCacheKey(m_cur3dlutFile).c_str(), format, clutSize);
+    if (GetCachedClut(cacheKey, clutData, clutSamples))
+      CLog::Log(LOGDEBUG, "ColorManager: using cached 3D LUT\n");
+    else
+    {
+      if (!Load3dLut(m_cur3dlutFile, format, clutSize, clutData))
+        return false;
+      AddCachedClut(cacheKey, clutData, clutSamples);
+    }
     m_curCmsMode = CMS_MODE_3DLUT;
     break;
 
@@ -187,6 +258,7 @@ bool CColorManager::GetVideo3dLut(int videoFlags, int *cmsToken, CMS_DATA_FORMAT
           CLog::Log(LOGDEBUG, "ColorManager: black point: %f\n", m_blackPoint.Y);
         }
         m_curIccProfile = settings->GetString("videoscreen.displayprofile");
+        m_curIccProfileKey = GetFileCacheKey(m_curIccProfile);
       }
       // create gamma curve
       cmsToneCurve* gammaCurve;
@@ -202,6 +274,19 @@ bool CColorManager::GetVideo3dLut(int videoFlags, int *cmsToken, CMS_DATA_FORMAT
       if (m_curIccPrimaries == CMS_PRIMARIES_AUTO)
         m_curIccPrimaries = videoPrimaries;
       CLog::Log(LOGDEBUG, "ColorManager: source profile primaries: %d\n", (int)m_curIccPrimaries);
+
+      // sampling the transform is what takes long, reuse the result of an earlier file
+      cacheKey = StringUtils::Format("icc|%s|%d|%d|%d|%d|%d|%d", m_curIccProfileKey.c_str(),
+                                     m_m_curIccGammaMode, m_curIccGamma, m_curIccWhitePoint, m_curIccPrimaries,
+                                     format, clutSize);
+      if (GetCachedClut(cacheKey, clutData, clutSamples))
+      {
+        CLog::Log(LOGDEBUG, "ColorManager: using cached 3D LUT\n");
+        cmsFreeToneCurve(gammaCurve);
+        m_curCmsMode = CMS_MODE_PROFILE;
+        break;
+      }
+
       cmsHPROFILE sourceProfile = CreateSourceProfile(m_curIccPrimaries, gammaCurve, m_curIccWhitePoint);
 
       // link profiles
@@ -212,7 +297,10 @@ bool CColorManager::GetVideo3dLut(int videoFlags, int *cmsToken, CMS_DATA_FORMAT
 
       // sample the transformation
       if (deviceLink)
+      {
         Create3dLut(deviceLink, format, clutSize, clutData);
+        AddCachedClut(cacheKey, clutData, clutSamples);
+      }
 
       // free gamma curve, source profile and transformation
       if (deviceLink)
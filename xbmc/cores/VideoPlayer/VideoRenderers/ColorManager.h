@@ -76,6 +76,9 @@ public:
 
   /*!
    \brief Get a 3D LUT for video color correction
+
+   CLUTs are cached for the lifetime of the application, so files with the
+   same primaries and settings don't sample the display profile again.
    \param primaries video primaries (see CONF_FLAGS_COLPRI)
    \param cmsToken pointer to a color manager configuration token
    \param format of CLUT data
@@ -158,6 +161,7 @@ private:
   // keep current display profile loaded here
   cmsHPROFILE m_hProfile;
   cmsCIEXYZ   m_blackPoint = { 0, 0, 0 };
+  std::string m_curIccProfileKey; // identifies the loaded profile in the CLUT cache
 
   // display parameters (gamma, input/output offset, primaries, whitepoint, intent?)
   CMS_WHITEPOINT m_curIccWhitePoint;
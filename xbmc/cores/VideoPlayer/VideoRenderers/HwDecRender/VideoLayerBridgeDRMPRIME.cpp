@@ -21,6 +21,8 @@ CVideoLayerBridgeDRMPRIME::CVideoLayerBridgeDRMPRIME(std::shared_ptr<CDRMUtils>
 
 CVideoLayerBridgeDRMPRIME::~CVideoLayerBridgeDRMPRIME()
 {
+  m_DRM->WaitForFlip();
+
   Release(m_prev_buffer);
   Release(m_buffer);
 }
@@ -145,6 +147,9 @@ void CVideoLayerBridgeDRMPRIME::Configure(IVideoBufferDRMPRIME* buffer)
 
 void CVideoLayerBridgeDRMPRIME::SetVideoPlane(IVideoBufferDRMPRIME* buffer, const CRect& destRect)
 {
+  // the previous frame may still be on screen until the last commit is presented
+  m_DRM->WaitForFlip();
+
   if (!Map(buffer))
   {
     Unmap(buffer);
@@ -169,6 +174,8 @@ void CVideoLayerBridgeDRMPRIME::UpdateVideoPlane()
   if (!m_buffer || !m_buffer->m_fb_id)
     return;
 
+  m_DRM->WaitForFlip();
+
   // release the buffer that is no longer presented on screen
   Release(m_prev_buffer);
   m_prev_buffer = nullptr;
@@ -49,6 +49,10 @@
 //! is a multiple of 128 and deinterlacing is on
 #define PBO_OFFSET 16
 
+//! pbos with immutable storage stay mapped for their whole lifetime, so the decoder
+//! thread can fill them while the render thread only issues the texture uploads
+#define PBO_STORAGE_FLAGS (GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT)
+
 #define BUFFER_OFFSET(i) ((char *)NULL + (i))
 
 using namespace Shaders;
@@ -94,8 +98,11 @@ CLinuxRendererGL::CPictureBuffer::CPictureBuffer()
   memset(&fields, 0, sizeof(fields));
   memset(&image , 0, sizeof(image));
   memset(&pbo   , 0, sizeof(pbo));
+  memset(&mapped, 0, sizeof(mapped));
+  fence = nullptr;
   videoBuffer = nullptr;
   loaded = false;
+  copied = false;
 }
 
 CLinuxRendererGL::CPictureBuffer::~CPictureBuffer() = default;
@@ -289,6 +296,10 @@ void CLinuxRendererGL::AddVideoPicture(const VideoPicture &picture, int index)
   buf.lightMetadata = picture.lightMetadata;
   if (picture.hasLightMetadata && picture.lightMetadata.MaxCLL)
     buf.hasLightMetadata = picture.hasLightMetadata;
+
+  // copy on the decoder thread if the pbos are mapped persistently
+  CSingleLock lock(m_pboSection);
+  buf.copied = CopyToPbo(buf);
 }
 
 void CLinuxRendererGL::ReleaseBuffer(int idx)
@@ -301,6 +312,25 @@ void CLinuxRendererGL::ReleaseBuffer(int idx)
   }
 }
 
+bool CLinuxRendererGL::NeedBuffer(int idx)
+{
+  // the pbos of the buffer must not be written while the gpu still reads them
+  CPictureBuffer &buf = m_buffers[idx];
+  if (buf.fence)
+  {
+    GLint state;
+    GLsizei length;
+    glGetSynciv(buf.fence, GL_SYNC_STATUS, 1, &length, &state);
+    if (state != GL_SIGNALED)
+      return true;
+
+    glDeleteSync(buf.fence);
+    buf.fence = nullptr;
+  }
+
+  return false;
+}
+
 void CLinuxRendererGL::GetPlaneTextureSize(CYuvPlane& plane)
 {
   /* texture is assumed to be bound */
@@ -923,7 +953,8 @@ void CLinuxRendererGL::LoadShaders(int field)
     {
       m_pYUVShader = new YUV2RGBProgressiveShader(m_textureTarget == GL_TEXTURE_RECTANGLE, shaderFormat,
                                                   m_nonLinStretch && m_renderQuality == RQ_SINGLEPASS,
-                                                  AVColorPrimaries::AVCOL_PRI_BT709, m_srcPrimaries, m_toneMap, out);
+                                                  AVColorPrimaries::AVCOL_PRI_BT709, m_srcPrimaries, m_toneMap, out,
+                                                  m_bobEdi);
 
       if (!m_cmsOn)
         m_pYUVShader->SetConvertFullColorRange(m_fullRange);
@@ -946,9 +977,17 @@ void CLinuxRendererGL::LoadShaders(int field)
   {
     CLog::Log(LOGNOTICE, "GL: Using GL_ARB_pixel_buffer_object");
     m_pboUsed = true;
+#if defined(GL_MAP_PERSISTENT_BIT)
+    m_pboPersistent = CServiceBroker::GetRenderSystem()->IsExtSupported("GL_ARB_buffer_storage");
+    if (m_pboPersistent)
+      CLog::Log(LOGNOTICE, "GL: Using GL_ARB_buffer_storage");
+#endif
   }
   else
+  {
     m_pboUsed = false;
+    m_pboPersistent = false;
+  }
 }
 
 void CLinuxRendererGL::UnInit()
@@ -985,6 +1024,15 @@ bool CLinuxRendererGL::Render(unsigned int flags, int renderBuffer)
   else
     m_currentField = FIELD_FULL;
 
+  // edge directed bob is done by the YUV shader, which only needs to be
+  // rebuilt when the method changes and not for every field
+  bool bobEdi = m_videoSettings.m_InterlaceMethod == VS_INTERLACEMETHOD_RENDER_BOB_EDI;
+  if (bobEdi != m_bobEdi)
+  {
+    m_bobEdi = bobEdi;
+    m_reloadShaders = true;
+  }
+
   // call texture load function
   if (!UploadTexture(renderBuffer))
   {
@@ -1085,6 +1133,7 @@ void CLinuxRendererGL::RenderSinglePass(int index, int field)
     m_pYUVShader->SetField(1);
   else if(field == FIELD_BOT)
     m_pYUVShader->SetField(0);
+  m_pYUVShader->SetBob(field != FIELD_FULL);
 
   m_pYUVShader->SetMatrices(glMatrixProject.Get(), glMatrixModview.Get());
   m_pYUVShader->Enable();
@@ -1274,6 +1323,7 @@ void CLinuxRendererGL::RenderToFBO(int index, int field, bool weave /*= false*/)
     m_pYUVShader->SetField(1);
   else if (field == FIELD_BOT)
     m_pYUVShader->SetField(0);
+  m_pYUVShader->SetBob(field != FIELD_FULL);
 
   VerifyGLState();
 
@@ -1739,6 +1789,10 @@ GLint CLinuxRendererGL::GetInternalFormat(GLint format, int bpp)
 
 bool CLinuxRendererGL::CreateTexture(int index)
 {
+  CSingleLock lock(m_pboSection);
+
+  memset(m_buffers[index].mapped, 0, sizeof(m_buffers[index].mapped));
+
   if (m_format == AV_PIX_FMT_NV12)
     return CreateNV12Texture(index);
   else if (m_format == AV_PIX_FMT_YUYV422 ||
@@ -1750,8 +1804,18 @@ bool CLinuxRendererGL::CreateTexture(int index)
 
 void CLinuxRendererGL::DeleteTexture(int index)
 {
+  CSingleLock lock(m_pboSection);
+
   CPictureBuffer& buf = m_buffers[index];
   buf.loaded = false;
+  buf.copied = false;
+  memset(buf.mapped, 0, sizeof(buf.mapped));
+
+  if (buf.fence)
+  {
+    glDeleteSync(buf.fence);
+    buf.fence = nullptr;
+  }
 
   if (m_format == AV_PIX_FMT_NV12)
     DeleteNV12Texture(index);
@@ -1773,35 +1837,37 @@ bool CLinuxRendererGL::UploadTexture(int index)
   {
     ret = false;
 
-    YuvImage &dst = m_buffers[index].image;
-    YuvImage src;
-    m_buffers[index].videoBuffer->GetPlanes(src.plane);
-    m_buffers[index].videoBuffer->GetStrides(src.stride);
+    CPictureBuffer &buf = m_buffers[index];
 
-    UnBindPbo(m_buffers[index]);
+    if (buf.mapped[0])
+    {
+      if (!buf.copied)
+        CopyToPbo(buf);
+    }
+    else
+    {
+      UnBindPbo(buf);
+      CopyVideoBuffer(buf, buf.image);
+      BindPbo(buf);
+    }
 
     if (m_format == AV_PIX_FMT_NV12)
-    {
-      CVideoBuffer::CopyNV12Picture(&dst, &src);
-      BindPbo(m_buffers[index]);
       ret = UploadNV12Texture(index);
-    }
     else if (m_format == AV_PIX_FMT_YUYV422 ||
              m_format == AV_PIX_FMT_UYVY422)
-    {
-      CVideoBuffer::CopyYUV422PackedPicture(&dst, &src);
-      BindPbo(m_buffers[index]);
       ret = UploadYUV422PackedTexture(index);
-    }
     else
-    {
-      CVideoBuffer::CopyPicture(&dst, &src);
-      BindPbo(m_buffers[index]);
       ret = UploadYV12Texture(index);
+
+    if (buf.mapped[0])
+    {
+      if (buf.fence)
+        glDeleteSync(buf.fence);
+      buf.fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
     }
 
     if (ret)
-      m_buffers[index].loaded = true;
+      buf.loaded = true;
   }
 
   if (ret)
@@ -1872,8 +1938,7 @@ bool CLinuxRendererGL::CreateYV12Texture(int index)
     for (int i = 0; i < 3; i++)
     {
       glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo[i]);
-      glBufferData(GL_PIXEL_UNPACK_BUFFER, im.planesize[i] + PBO_OFFSET, 0, GL_STREAM_DRAW);
-      void* pboPtr = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
+      void* pboPtr = AllocPbo(im.planesize[i] + PBO_OFFSET);
       if (pboPtr)
       {
         im.plane[i] = (uint8_t*) pboPtr + PBO_OFFSET;
@@ -1899,6 +1964,9 @@ bool CLinuxRendererGL::CreateYV12Texture(int index)
     }
 
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (pboSetup && m_pboPersistent)
+      BindPbo(buf);
   }
 
   if (!pboSetup)
@@ -2178,8 +2246,7 @@ bool CLinuxRendererGL::CreateNV12Texture(int index)
     for (int i = 0; i < 2; i++)
     {
       glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo[i]);
-      glBufferData(GL_PIXEL_UNPACK_BUFFER, im.planesize[i] + PBO_OFFSET, 0, GL_STREAM_DRAW);
-      void* pboPtr = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
+      void* pboPtr = AllocPbo(im.planesize[i] + PBO_OFFSET);
       if (pboPtr)
       {
         im.plane[i] = (uint8_t*)pboPtr + PBO_OFFSET;
@@ -2205,6 +2272,9 @@ bool CLinuxRendererGL::CreateNV12Texture(int index)
     }
 
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (pboSetup && m_pboPersistent)
+      BindPbo(buf);
   }
 
   if (!pboSetup)
@@ -2444,8 +2514,7 @@ bool CLinuxRendererGL::CreateYUV422PackedTexture(int index)
     glGenBuffers(1, pbo);
 
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, pbo[0]);
-    glBufferData(GL_PIXEL_UNPACK_BUFFER, im.planesize[0] + PBO_OFFSET, 0, GL_STREAM_DRAW);
-    void* pboPtr = glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
+    void* pboPtr = AllocPbo(im.planesize[0] + PBO_OFFSET);
     if (pboPtr)
     {
       im.plane[0] = (uint8_t*)pboPtr + PBO_OFFSET;
@@ -2466,6 +2535,9 @@ bool CLinuxRendererGL::CreateYUV422PackedTexture(int index)
     }
 
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+
+    if (pboSetup && m_pboPersistent)
+      BindPbo(buf);
   }
 
   if (!pboSetup)
@@ -2621,10 +2693,16 @@ void CLinuxRendererGL::BindPbo(CPictureBuffer& buff)
   {
     if(!buff.pbo[plane] || buff.image.plane[plane] == (uint8_t*)PBO_OFFSET)
       continue;
-    pbo = true;
 
-    glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buff.pbo[plane]);
-    glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    // persistent mappings are only remembered, they stay valid during the upload
+    if (m_pboPersistent)
+      buff.mapped[plane] = buff.image.plane[plane];
+    else
+    {
+      pbo = true;
+      glBindBuffer(GL_PIXEL_UNPACK_BUFFER, buff.pbo[plane]);
+      glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER);
+    }
     buff.image.plane[plane] = (uint8_t*)PBO_OFFSET;
   }
   if (pbo)
@@ -2648,6 +2726,49 @@ void CLinuxRendererGL::UnBindPbo(CPictureBuffer& buff)
     glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
 }
 
+void* CLinuxRendererGL::AllocPbo(GLsizeiptr size)
+{
+  /* pbo is assumed to be bound */
+#if defined(GL_MAP_PERSISTENT_BIT)
+  if (m_pboPersistent)
+  {
+    glBufferStorage(GL_PIXEL_UNPACK_BUFFER, size, NULL, PBO_STORAGE_FLAGS);
+    return glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, PBO_STORAGE_FLAGS);
+  }
+#endif
+
+  glBufferData(GL_PIXEL_UNPACK_BUFFER, size, NULL, GL_STREAM_DRAW);
+  return glMapBuffer(GL_PIXEL_UNPACK_BUFFER, GL_WRITE_ONLY);
+}
+
+void CLinuxRendererGL::CopyVideoBuffer(CPictureBuffer& buff, YuvImage& dst)
+{
+  YuvImage src;
+  buff.videoBuffer->GetPlanes(src.plane);
+  buff.videoBuffer->GetStrides(src.stride);
+
+  if (m_format == AV_PIX_FMT_NV12)
+    CVideoBuffer::CopyNV12Picture(&dst, &src);
+  else if (m_format == AV_PIX_FMT_YUYV422 ||
+           m_format == AV_PIX_FMT_UYVY422)
+    CVideoBuffer::CopyYUV422PackedPicture(&dst, &src);
+  else
+    CVideoBuffer::CopyPicture(&dst, &src);
+}
+
+bool CLinuxRendererGL::CopyToPbo(CPictureBuffer& buff)
+{
+  if (!buff.mapped[0] || !buff.videoBuffer)
+    return false;
+
+  YuvImage dst = buff.image;
+  for (int plane = 0; plane < YuvImage::MAX_PLANES; plane++)
+    dst.plane[plane] = buff.mapped[plane];
+
+  CopyVideoBuffer(buff, dst);
+  return true;
+}
+
 CRenderInfo CLinuxRendererGL::GetRenderInfo()
 {
   CRenderInfo info;
@@ -20,6 +20,7 @@
 #include "windowing/GraphicContext.h"
 #include "BaseRenderer.h"
 #include "ColorManager.h"
+#include "threads/CriticalSection.h"
 #include "threads/Event.h"
 #include "VideoShaders/ShaderFormats.h"
 #include "utils/Geometry.h"
@@ -81,6 +82,7 @@ public:
   bool Flush(bool saveBuffers) override;
   void SetBufferSize(int numBuffers) override { m_NumYV12Buffers = numBuffers; }
   void ReleaseBuffer(int idx) override;
+  bool NeedBuffer(int idx) override;
   void RenderUpdate(int index, int index2, bool clear, unsigned int flags, unsigned int alpha) override;
   void Update() override;
   bool RenderCapture(CRenderCapture* capture) override;
@@ -136,6 +138,9 @@ protected:
 
   void BindPbo(CPictureBuffer& buff);
   void UnBindPbo(CPictureBuffer& buff);
+  void* AllocPbo(GLsizeiptr size);
+  void CopyVideoBuffer(CPictureBuffer& buff, YuvImage& dst);
+  bool CopyToPbo(CPictureBuffer& buff);
   void LoadPlane(CYuvPlane& plane, int type,
                  unsigned width,  unsigned height,
                  int stride, int bpp, void* data);
@@ -190,9 +195,12 @@ protected:
     CYuvPlane fields[MAX_FIELDS][YuvImage::MAX_PLANES];
     YuvImage image;
     GLuint pbo[3]; // one pbo for 3 planes
+    uint8_t *mapped[3]; // persistent mapping of the pbos, written by the decoder thread
+    GLsync fence; // signaled when the gpu is done reading the pbos
 
     CVideoBuffer *videoBuffer;
     bool loaded;
+    bool copied; // planes were copied to the pbos by AddVideoPicture
 
     AVColorPrimaries m_srcPrimaries;
     AVColorSpace m_srcColSpace;
@@ -219,9 +227,12 @@ protected:
   bool m_fullRange;
   AVColorPrimaries m_srcPrimaries;
   bool m_toneMap = false;
+  bool m_bobEdi = false;
   float m_clearColour = 0.0f;
   bool m_pboSupported = true;
   bool m_pboUsed = false;
+  bool m_pboPersistent = false;
+  CCriticalSection m_pboSection;
   bool m_nonLinStretch = false;
   bool m_nonLinStretchGui = false;
   float m_pixelRatio = 0.0f;
@@ -97,6 +97,9 @@ void CRenderer::Flush()
     Release(buffer);
 
   ReleaseCache();
+#if defined(HAS_GL) || defined(HAS_GLES)
+  m_glyphAtlas.reset();
+#endif
 
   g_fontManager.Unload(m_font);
   g_fontManager.Unload(m_fontBorder);
@@ -150,6 +153,15 @@ void CRenderer::Render(int idx)
 {
   CSingleLock lock(m_section);
 
+#if defined(HAS_GL) || defined(HAS_GLES)
+  // Make room for new glyphs before any overlay of this frame uses the atlas
+  if (m_glyphAtlas && m_glyphAtlas->IsFull())
+  {
+    ReleaseCache();
+    m_glyphAtlas->Reset();
+  }
+#endif
+
   std::vector<COverlay*> render;
   std::vector<SElement>& list = m_buffers[idx];
   for(std::vector<SElement>::iterator it = list.begin(); it != list.end(); ++it)
@@ -401,7 +413,9 @@ COverlay* CRenderer::Convert(CDVDOverlaySSA* o, double pts)
 
   COverlay *overlay = NULL;
 #if defined(HAS_GL) || defined(HAS_GLES)
-  overlay = new COverlayGlyphGL(images, targetWidth, targetHeight);
+  if (!m_glyphAtlas)
+    m_glyphAtlas.reset(new CGlyphAtlasGL());
+  overlay = new COverlayGlyphGL(images, targetWidth, targetHeight, *m_glyphAtlas);
 #elif defined(HAS_DX)
   overlay = new COverlayQuadsDX(images, targetWidth, targetHeight);
 #endif
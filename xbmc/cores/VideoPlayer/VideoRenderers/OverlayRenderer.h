@@ -13,6 +13,7 @@
 #include "threads/CriticalSection.h"
 
 #include <map>
+#include <memory>
 #include <vector>
 
 class CDVDOverlay;
@@ -22,6 +23,8 @@ class CDVDOverlaySSA;
 
 namespace OVERLAY {
 
+  class CGlyphAtlasGL;
+
   struct SRenderState
   {
     float x;
@@ -105,6 +108,9 @@ namespace OVERLAY {
     CRect m_rv, m_rs, m_rd;
     std::string m_font, m_fontBorder;
     std::string m_stereomode;
+#if defined(HAS_GL) || defined(HAS_GLES)
+    std::unique_ptr<CGlyphAtlasGL> m_glyphAtlas;
+#endif
   };
 
   extern const std::string SETTING_SUBTITLES_OPACITY;
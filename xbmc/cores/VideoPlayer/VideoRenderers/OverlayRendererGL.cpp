@@ -28,6 +28,10 @@
 #include "utils/log.h"
 #include "utils/GLUtils.h"
 
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
 #if HAS_GLES >= 2
 // GLES2.0 cant do CLAMP, but can do CLAMP_TO_EDGE.
 #define GL_CLAMP	GL_CLAMP_TO_EDGE
@@ -35,6 +39,9 @@
 
 #define USE_PREMULTIPLIED_ALPHA 1
 
+// Size of the glyph atlas of ASS subtitles, limited by the maximum texture size
+#define GLYPH_ATLAS_SIZE 1024
+
 #define BUFFER_OFFSET(i) ((char *)NULL + (i))
 
 using namespace OVERLAY;
@@ -162,10 +169,18 @@ static void LoadTexture(GLenum target
 COverlayTextureGL::COverlayTextureGL(CDVDOverlayImage* o)
 {
   m_texture = 0;
+  m_paletteTexture = 0;
 
   uint32_t* rgba;
   int stride;
-  if(o->palette)
+  if(o->palette && LoadPalette(o))
+  {
+    // the palette is looked up by the shader, upload the indices as they are
+    m_pma  = !!USE_PREMULTIPLIED_ALPHA;
+    rgba   = nullptr;
+    stride = o->linesize;
+  }
+  else if(o->palette)
   {
     m_pma  = !!USE_PREMULTIPLIED_ALPHA;
     rgba   = convert_rgba(o, m_pma);
@@ -178,7 +193,7 @@ COverlayTextureGL::COverlayTextureGL(CDVDOverlayImage* o)
     stride = o->linesize;
   }
 
-  if(!rgba)
+  if(!rgba && !m_paletteTexture)
   {
     CLog::Log(LOGERROR, "COverlayTextureGL::COverlayTextureGL - failed to convert overlay to rgb");
     return;
@@ -187,20 +202,35 @@ COverlayTextureGL::COverlayTextureGL(CDVDOverlayImage* o)
   glGenTextures(1, &m_texture);
   glBindTexture(GL_TEXTURE_2D, m_texture);
 
+  // indices can't be interpolated
+  GLint filter = m_paletteTexture ? GL_NEAREST : GL_LINEAR;
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
 
-  LoadTexture(GL_TEXTURE_2D
-            , o->width
-            , o->height
-            , stride
-            , &m_u, &m_v
-            , false
-            , rgba);
-  if(reinterpret_cast<uint8_t*>(rgba) != o->data)
-    free(rgba);
+  if(m_paletteTexture)
+  {
+    LoadTexture(GL_TEXTURE_2D
+              , o->width
+              , o->height
+              , stride
+              , &m_u, &m_v
+              , true
+              , o->data);
+  }
+  else
+  {
+    LoadTexture(GL_TEXTURE_2D
+              , o->width
+              , o->height
+              , stride
+              , &m_u, &m_v
+              , false
+              , rgba);
+    if(reinterpret_cast<uint8_t*>(rgba) != o->data)
+      free(rgba);
+  }
 
   glBindTexture(GL_TEXTURE_2D, 0);
 
@@ -234,6 +264,7 @@ COverlayTextureGL::COverlayTextureGL(CDVDOverlayImage* o)
 COverlayTextureGL::COverlayTextureGL(CDVDOverlaySpu* o)
 {
   m_texture = 0;
+  m_paletteTexture = 0;
 
   int min_x, max_x, min_y, max_y;
   uint32_t* rgba = convert_rgba(o, USE_PREMULTIPLIED_ALPHA
@@ -274,9 +305,104 @@ COverlayTextureGL::COverlayTextureGL(CDVDOverlaySpu* o)
   m_pma    = !!USE_PREMULTIPLIED_ALPHA;
 }
 
+CGlyphAtlasGL::CGlyphAtlasGL()
+{
+  GLint maxSize = 0;
+  glGetIntegerv(GL_MAX_TEXTURE_SIZE, &maxSize);
+  m_size = std::min(static_cast<int>(maxSize), GLYPH_ATLAS_SIZE);
+
+  glGenTextures(1, &m_texture);
+  Reset();
+}
+
+CGlyphAtlasGL::~CGlyphAtlasGL()
+{
+  glDeleteTextures(1, &m_texture);
+}
+
+void CGlyphAtlasGL::Reset()
+{
+  m_glyphs.clear();
+  m_rowX = 0;
+  m_rowY = 0;
+  m_rowHeight = 0;
+  m_bFull = false;
+
+  // Bitmaps are filtered linearly, the gaps between them must stay empty
+  std::vector<uint8_t> empty(m_size * m_size);
+
+  glBindTexture(GL_TEXTURE_2D, m_texture);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+#ifdef HAS_GLES
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_ALPHA, m_size, m_size, 0, GL_ALPHA, GL_UNSIGNED_BYTE, empty.data());
+#else
+  glTexImage2D(GL_TEXTURE_2D, 0, GL_RED, m_size, m_size, 0, GL_RED, GL_UNSIGNED_BYTE, empty.data());
+#endif
+  glBindTexture(GL_TEXTURE_2D, 0);
+}
+
+bool CGlyphAtlasGL::Add(const ASS_Image* image, int& u, int& v)
+{
+  // FNV-1a over the bitmap, the color is part of the vertices
+  uint32_t hash = 2166136261u;
+  for (int y = 0; y < image->h; y++)
+  {
+    const unsigned char* row = image->bitmap + image->stride * y;
+    for (int x = 0; x < image->w; x++)
+      hash = (hash ^ row[x]) * 16777619u;
+  }
+
+  const GlyphKey key{ hash, image->w, image->h };
+  auto it = m_glyphs.find(key);
+  if (it != m_glyphs.end())
+  {
+    u = it->second.first;
+    v = it->second.second;
+    return true;
+  }
+
+  // Start a new row if the bitmap doesn't fit in the current one
+  if (m_rowX + image->w + 1 > m_size)
+  {
+    m_rowY += m_rowHeight + 1;
+    m_rowX = 0;
+    m_rowHeight = 0;
+  }
+  if (image->w + 1 > m_size || m_rowY + image->h + 1 > m_size)
+  {
+    m_bFull = true;
+    return false;
+  }
+
+  u = m_rowX;
+  v = m_rowY;
+
+  glBindTexture(GL_TEXTURE_2D, m_texture);
+  glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+#ifdef HAS_GLES
+  // OpenGL ES does not support strided texture input
+  std::vector<uint8_t> pixels(image->w * image->h);
+  for (int y = 0; y < image->h; y++)
+    memcpy(pixels.data() + image->w * y, image->bitmap + image->stride * y, image->w);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, u, v, image->w, image->h, GL_ALPHA, GL_UNSIGNED_BYTE, pixels.data());
+#else
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, image->stride);
+  glTexSubImage2D(GL_TEXTURE_2D, 0, u, v, image->w, image->h, GL_RED, GL_UNSIGNED_BYTE, image->bitmap);
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  m_rowX += image->w + 1;
+  m_rowHeight = std::max(m_rowHeight, image->h);
+
+  m_glyphs[key] = std::make_pair(u, v);
+  return true;
+}
+
 COverlayGlyphGL::COverlayGlyphGL(ASS_Image* images, int width, int height)
 {
   m_vertex = NULL;
+  m_count  = 0;
   m_width  = 1.0;
   m_height = 1.0;
   m_align  = ALIGN_VIDEO;
@@ -284,7 +410,74 @@ COverlayGlyphGL::COverlayGlyphGL(ASS_Image* images, int width, int height)
   m_x      = 0.0f;
   m_y      = 0.0f;
   m_texture = 0;
+  m_ownsTexture = true;
+
+  CreateTexture(images, width, height);
+}
+
+COverlayGlyphGL::COverlayGlyphGL(ASS_Image* images, int width, int height, CGlyphAtlasGL& atlas)
+{
+  m_vertex = NULL;
+  m_count  = 0;
+  m_width  = 1.0;
+  m_height = 1.0;
+  m_align  = ALIGN_VIDEO;
+  m_pos    = POSITION_RELATIVE;
+  m_x      = 0.0f;
+  m_y      = 0.0f;
+  m_texture = 0;
+  m_ownsTexture = true;
 
+  SQuads quads;
+  for (ASS_Image* img = images; img; img = img->next)
+  {
+    // fully transparent or width or height is 0 -> not displayed
+    if ((img->color & 0xff) == 0xff || img->w == 0 || img->h == 0)
+      continue;
+    quads.count++;
+  }
+
+  if (quads.count == 0)
+    return;
+
+  quads.quad = static_cast<SQuad*>(calloc(quads.count, sizeof(SQuad)));
+  quads.size_x = atlas.Size();
+  quads.size_y = atlas.Size();
+
+  SQuad* v = quads.quad;
+  for (ASS_Image* img = images; img; img = img->next)
+  {
+    if ((img->color & 0xff) == 0xff || img->w == 0 || img->h == 0)
+      continue;
+
+    if (!atlas.Add(img, v->u, v->v))
+    {
+      CreateTexture(images, width, height);
+      return;
+    }
+
+    unsigned int color = img->color;
+    v->a = 255 - (color & 0xff);
+    v->r = (color >> 24) & 0xff;
+    v->g = (color >> 16) & 0xff;
+    v->b = (color >> 8) & 0xff;
+    v->x = img->dst_x;
+    v->y = img->dst_y;
+    v->w = img->w;
+    v->h = img->h;
+    v++;
+  }
+
+  m_texture = atlas.Texture();
+  m_ownsTexture = false;
+  m_u = 1.0f;
+  m_v = 1.0f;
+
+  CreateVertices(quads, width, height);
+}
+
+void COverlayGlyphGL::CreateTexture(ASS_Image* images, int width, int height)
+{
   SQuads quads;
   if(!convert_quad(images, quads, width))
     return;
@@ -300,7 +493,13 @@ COverlayGlyphGL::COverlayGlyphGL(ASS_Image* images, int width, int height)
             , true
             , quads.data);
 
+  glBindTexture(GL_TEXTURE_2D, 0);
+
+  CreateVertices(quads, width, height);
+}
 
+void COverlayGlyphGL::CreateVertices(const SQuads& quads, int width, int height)
+{
   float scale_u = m_u / quads.size_x;
   float scale_v = m_v / quads.size_y;
 
@@ -352,13 +551,12 @@ COverlayGlyphGL::COverlayGlyphGL(ASS_Image* images, int width, int height)
     vs += 1;
     vt += 4;
   }
-
-  glBindTexture(GL_TEXTURE_2D, 0);
 }
 
 COverlayGlyphGL::~COverlayGlyphGL()
 {
-  glDeleteTextures(1, &m_texture);
+  if (m_ownsTexture)
+    glDeleteTextures(1, &m_texture);
   free(m_vertex);
 }
 
@@ -479,22 +677,62 @@ void COverlayGlyphGL::Render(SRenderState& state)
 COverlayTextureGL::~COverlayTextureGL()
 {
   glDeleteTextures(1, &m_texture);
+  if (m_paletteTexture)
+    glDeleteTextures(1, &m_paletteTexture);
+}
+
+bool COverlayTextureGL::LoadPalette(CDVDOverlayImage* o)
+{
+#if defined(HAS_GL)
+  CRenderSystemGL* renderSystem = dynamic_cast<CRenderSystemGL*>(CServiceBroker::GetRenderSystem());
+  if (!renderSystem || !renderSystem->IsShaderValid(SM_TEXTURE_PALETTE))
+    return false;
+#else
+  CRenderSystemGLES* renderSystem = dynamic_cast<CRenderSystemGLES*>(CServiceBroker::GetRenderSystem());
+  if (!renderSystem || !renderSystem->IsGUIShaderValid(SM_TEXTURE_PALETTE))
+    return false;
+#endif
+
+  uint32_t palette[256];
+  convert_palette(o, !!USE_PREMULTIPLIED_ALPHA, palette);
+
+  glGenTextures(1, &m_paletteTexture);
+  glBindTexture(GL_TEXTURE_2D, m_paletteTexture);
+
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+
+  GLfloat u, v;
+  LoadTexture(GL_TEXTURE_2D, 256, 1, 256 * sizeof(palette[0]), &u, &v, false, palette);
+
+  glBindTexture(GL_TEXTURE_2D, 0);
+  return true;
 }
 
 void COverlayTextureGL::Render(SRenderState& state)
 {
   glEnable(GL_BLEND);
 
+  if(m_paletteTexture)
+  {
+    glActiveTexture(GL_TEXTURE1);
+    glBindTexture(GL_TEXTURE_2D, m_paletteTexture);
+    glActiveTexture(GL_TEXTURE0);
+  }
+
   glBindTexture(GL_TEXTURE_2D, m_texture);
   if(m_pma)
     glBlendFunc(GL_ONE, GL_ONE_MINUS_SRC_ALPHA);
   else
     glBlendFunc(GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA);
 
+  GLint filter = m_paletteTexture ? GL_NEAREST : GL_LINEAR;
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, filter);
+  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, filter);
 
   DRAWRECT rd;
   if (m_pos == POSITION_RELATIVE)
@@ -517,7 +755,9 @@ void COverlayTextureGL::Render(SRenderState& state)
 
   int glslMajor, glslMinor;
   renderSystem->GetGLSLVersion(glslMajor, glslMinor);
-  if (glslMajor >= 2 || (glslMajor == 1 && glslMinor >= 50))
+  if (m_paletteTexture)
+    renderSystem->EnableShader(SM_TEXTURE_PALETTE);
+  else if (glslMajor >= 2 || (glslMajor == 1 && glslMinor >= 50))
     renderSystem->EnableShader(SM_TEXTURE_LIM);
   else
     renderSystem->EnableShader(SM_TEXTURE);
@@ -591,7 +831,7 @@ void COverlayTextureGL::Render(SRenderState& state)
 
 #else
   CRenderSystemGLES* renderSystem = dynamic_cast<CRenderSystemGLES*>(CServiceBroker::GetRenderSystem());
-  renderSystem->EnableGUIShader(SM_TEXTURE);
+  renderSystem->EnableGUIShader(m_paletteTexture ? SM_TEXTURE_PALETTE : SM_TEXTURE);
   GLint posLoc = renderSystem->GUIShaderGetPos();
   GLint colLoc = renderSystem->GUIShaderGetCol();
   GLint tex0Loc = renderSystem->GUIShaderGetCoord0();
@@ -13,6 +13,9 @@
 
 #include "system_gl.h"
 
+#include <map>
+#include <stdint.h>
+
 class CDVDOverlay;
 class CDVDOverlayImage;
 class CDVDOverlaySpu;
@@ -21,6 +24,8 @@ typedef struct ass_image ASS_Image;
 
 namespace OVERLAY {
 
+  struct SQuads;
+
   class COverlayTextureGL : public COverlay
   {
   public:
@@ -30,17 +35,86 @@ namespace OVERLAY {
 
     void Render(SRenderState& state) override;
 
+    bool LoadPalette(CDVDOverlayImage* o);
+
     GLuint m_texture;
+    GLuint m_paletteTexture; /*< 256x1 colors if m_texture holds palette indices */
     float  m_u;
     float  m_v;
     bool   m_pma; /*< is alpha in texture premultiplied in the values */
   };
 
+  /*!
+   * \brief Texture with the glyph bitmaps of ASS subtitles
+   *
+   * The atlas is shared by the glyph overlays, so a bitmap is only uploaded
+   * the first time it is rendered, not every time libass reports a change.
+   * Bitmaps are packed in rows and only dropped all at once by Reset().
+   */
+  class CGlyphAtlasGL
+  {
+  public:
+    CGlyphAtlasGL();
+    ~CGlyphAtlasGL();
+
+    /*!
+     * \brief Get the position of the bitmap of an image, uploading it if it
+     *        isn't in the atlas yet
+     *
+     * \return false if there is no room left for the bitmap
+     */
+    bool Add(const ASS_Image* image, int& u, int& v);
+
+    /*!
+     * \brief True if a bitmap didn't fit since the last reset
+     */
+    bool IsFull() const { return m_bFull; }
+
+    /*!
+     * \brief Drop all bitmaps, overlays using the atlas become invalid
+     */
+    void Reset();
+
+    GLuint Texture() const { return m_texture; }
+    int Size() const { return m_size; }
+
+  private:
+    struct GlyphKey
+    {
+      uint32_t hash;
+      int w;
+      int h;
+
+      bool operator<(const GlyphKey& other) const
+      {
+        if (hash != other.hash)
+          return hash < other.hash;
+        if (w != other.w)
+          return w < other.w;
+        return h < other.h;
+      }
+    };
+
+    GLuint m_texture = 0;
+    int m_size = 0;
+    int m_rowX = 0;
+    int m_rowY = 0;
+    int m_rowHeight = 0;
+    bool m_bFull = false;
+    std::map<GlyphKey, std::pair<int, int>> m_glyphs;
+  };
+
   class COverlayGlyphGL : public COverlay
   {
   public:
    COverlayGlyphGL(ASS_Image* images, int width, int height);
 
+   /*!
+    * \brief Create the overlay from the bitmaps in the glyph atlas, falls back
+    *        to a texture of its own if the atlas is full
+    */
+   COverlayGlyphGL(ASS_Image* images, int width, int height, CGlyphAtlasGL& atlas);
+
    ~COverlayGlyphGL() override;
 
    void Render(SRenderState& state) override;
@@ -58,6 +132,11 @@ namespace OVERLAY {
    GLuint m_texture;
    float  m_u;
    float  m_v;
+   bool   m_ownsTexture; /*< false if m_texture is the glyph atlas */
+
+  private:
+   void CreateTexture(ASS_Image* images, int width, int height);
+   void CreateVertices(const SQuads& quads, int width, int height);
   };
 
 }
@@ -43,14 +43,8 @@ static uint32_t build_rgba(int yuv[3], int alpha, bool mergealpha)
 }
 #undef clamp
 
-uint32_t* convert_rgba(CDVDOverlayImage* o, bool mergealpha)
+void convert_palette(CDVDOverlayImage* o, bool mergealpha, uint32_t palette[256])
 {
-  uint32_t* rgba = (uint32_t*)malloc(o->width * o->height * sizeof(uint32_t));
-
-  if(!rgba)
-    return NULL;
-
-  uint32_t palette[256];
   memset(palette, 0, 256 * sizeof(palette[0]));
   for(int i = 0; i < o->palette_colors; i++)
     palette[i] = build_rgba((o->palette[i] >> PIXEL_ASHIFT) & 0xff
@@ -58,6 +52,17 @@ uint32_t* convert_rgba(CDVDOverlayImage* o, bool mergealpha)
                           , (o->palette[i] >> PIXEL_GSHIFT) & 0xff
                           , (o->palette[i] >> PIXEL_BSHIFT) & 0xff
                           , mergealpha);
+}
+
+uint32_t* convert_rgba(CDVDOverlayImage* o, bool mergealpha)
+{
+  uint32_t* rgba = (uint32_t*)malloc(o->width * o->height * sizeof(uint32_t));
+
+  if(!rgba)
+    return NULL;
+
+  uint32_t palette[256];
+  convert_palette(o, mergealpha, palette);
 
   for(int row = 0; row < o->height; row++)
     for(int col = 0; col < o->width; col++)
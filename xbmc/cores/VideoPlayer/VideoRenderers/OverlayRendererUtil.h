@@ -48,6 +48,7 @@ namespace OVERLAY {
     SQuad*   quad;
   };
 
+  void      convert_palette(CDVDOverlayImage* o, bool mergealpha, uint32_t palette[256]);
   uint32_t* convert_rgba(CDVDOverlayImage* o, bool mergealpha);
   uint32_t* convert_rgba(CDVDOverlaySpu*   o, bool mergealpha
                        , int& min_x, int& max_x
@@ -15,6 +15,7 @@
 #include "threads/SingleLock.h"
 #include "utils/log.h"
 #include "utils/StringUtils.h"
+#include "utils/Tracer.h"
 #include "windowing/WinSystem.h"
 
 #include "Application.h"
@@ -35,6 +36,8 @@
 #include "../VideoPlayer/DVDClock.h"
 #include "../VideoPlayer/DVDCodecs/Video/DVDVideoCodec.h"
 
+#include <cinttypes>
+
 using namespace KODI::MESSAGING;
 
 void CRenderManager::CClockSync::Reset()
@@ -226,6 +229,8 @@ bool CRenderManager::Configure()
     m_renderedOverlay = false;
     m_renderDebug = false;
     m_clockSync.Reset();
+    m_telemetry.Reset();
+    m_missedVblanks = -1;
     m_dvdClock.SetVsyncAdjust(0);
     m_overlays.SetStereoMode(m_stereomode);
 
@@ -377,6 +382,8 @@ void CRenderManager::PreInit()
   m_QueueSkip   = 0;
   m_presentstep = PRESENT_IDLE;
   m_bRenderGUI = true;
+  m_telemetry.Reset();
+  m_missedVblanks = -1;
 
   m_initEvent.Set();
 }
@@ -688,6 +695,8 @@ RESOLUTION CRenderManager::GetResolution()
 
 void CRenderManager::Render(bool clear, DWORD flags, DWORD alpha, bool gui)
 {
+  TRACE_SCOPE("RenderManager::Render");
+
   CSingleExit exitLock(CServiceBroker::GetWinSystem()->GetGfxContext());
 
   {
@@ -739,6 +748,15 @@ void CRenderManager::Render(bool clear, DWORD flags, DWORD alpha, bool gui)
                                      clockspeed * 100);
       }
 
+      SRenderTelemetryInfo telemetry = CServiceBroker::GetDataCacheCore().GetRenderTelemetryInfo();
+      if (telemetry.frames > 0)
+      {
+        vsync += StringUtils::Format(" queue:%.1fms present:%.1fms skip:%" PRIu64,
+                                     telemetry.queueTimeTotal / telemetry.frames,
+                                     telemetry.presentTimeTotal / telemetry.frames,
+                                     telemetry.skipped);
+      }
+
       m_debugRenderer.SetInfo(audio, video, player, vsync);
       m_debugRenderer.Render(src, dst, view);
 
@@ -752,6 +770,9 @@ void CRenderManager::Render(bool clear, DWORD flags, DWORD alpha, bool gui)
 
   { CSingleLock lock(m_presentlock);
 
+    if (m_presentstep == PRESENT_FRAME && !m.presented)
+      UpdateTelemetry();
+
     if (m_presentstep == PRESENT_FRAME)
     {
       if (m.presentmethod == PRESENT_METHOD_BOB)
@@ -908,6 +929,7 @@ bool CRenderManager::AddVideoPicture(const VideoPicture& picture, volatile std::
     return false;
 
   int index = m_free.front();
+  const double decoded = m_dvdClock.GetAbsoluteClock(false);
 
   {
     CSingleLock lock(m_datalock);
@@ -945,7 +967,8 @@ bool CRenderManager::AddVideoPicture(const VideoPicture& picture, volatile std::
     {
       if (deintMethod == VS_INTERLACEMETHOD_RENDER_BLEND)
         presentmethod = PRESENT_METHOD_BLEND;
-      else if (deintMethod == VS_INTERLACEMETHOD_RENDER_BOB)
+      else if (deintMethod == VS_INTERLACEMETHOD_RENDER_BOB ||
+               deintMethod == VS_INTERLACEMETHOD_RENDER_BOB_EDI)
         presentmethod = PRESENT_METHOD_BOB;
       else
       {
@@ -962,6 +985,10 @@ bool CRenderManager::AddVideoPicture(const VideoPicture& picture, volatile std::
   m.presentfield = displayField;
   m.presentmethod = presentmethod;
   m.pts = picture.pts;
+  m.timing = CRenderTelemetry::SFrame();
+  m.timing.decoded = decoded;
+  m.timing.queued = m_dvdClock.GetAbsoluteClock(false);
+  m.presented = false;
   m_queued.push_back(m_free.front());
   m_free.pop_front();
   m_playerPort->UpdateRenderBuffers(m_queued.size(), m_discard.size(), m_free.size());
@@ -1076,6 +1103,8 @@ int CRenderManager::WaitForBuffer(volatile std::atomic_bool&bStop, int timeout)
 
 void CRenderManager::PrepareNextRender()
 {
+  TRACE_SCOPE("RenderManager::PrepareNextRender");
+
   if (m_queued.empty())
   {
     CLog::Log(LOGERROR, "CRenderManager::PrepareNextRender - asked to prepare with nothing available");
@@ -1155,6 +1184,7 @@ void CRenderManager::PrepareNextRender()
       {
         m_discard.push_back(m_presentsourcePast);
         m_QueueSkip++;
+        m_telemetry.AddSkipped();
       }
       m_presentsourcePast = m_queued.front();
       m_queued.pop_front();
@@ -1170,6 +1200,8 @@ void CRenderManager::PrepareNextRender()
     m_discard.push_back(m_presentsource);
     m_presentsource = idx;
     m_queued.pop_front();
+    m_Queue[idx].timing.flipped = m_dvdClock.GetAbsoluteClock(false);
+    m_Queue[idx].timing.queueDepth = m_queued.size();
     m_presentpts = m_Queue[idx].pts - m_displayLatency;
     m_presentevent.notifyAll();
 
@@ -1182,6 +1214,8 @@ void CRenderManager::PrepareNextRender()
     m_presentsourcePast = m_presentsource;
     m_presentsource = m_queued.front();
     m_queued.pop_front();
+    m_Queue[m_presentsource].timing.flipped = m_dvdClock.GetAbsoluteClock(false);
+    m_Queue[m_presentsource].timing.queueDepth = m_queued.size();
     m_presentpts = m_Queue[m_presentsource].pts - m_displayLatency - frametime / 2;
     m_presentevent.notifyAll();
   }
@@ -1212,6 +1246,24 @@ bool CRenderManager::GetStats(int &lateframes, double &pts, int &queued, int &di
   return true;
 }
 
+void CRenderManager::UpdateTelemetry()
+{
+  SPresent& m = m_Queue[m_presentsource];
+  m.presented = true;
+  m.timing.presented = m_dvdClock.GetAbsoluteClock(false);
+
+  double refreshrate, clockspeed;
+  int missedvblanks;
+  if (m_dvdClock.GetClockInfo(missedvblanks, clockspeed, refreshrate))
+  {
+    if (m_missedVblanks >= 0 && missedvblanks >= m_missedVblanks)
+      m.timing.missedVsyncs = missedvblanks - m_missedVblanks;
+    m_missedVblanks = missedvblanks;
+  }
+
+  m_telemetry.AddFrame(m.timing);
+}
+
 void CRenderManager::CheckEnableClockSync()
 {
   // refresh rate can be a multiple of video fps
@@ -10,6 +10,7 @@
 
 #include "DVDClock.h"
 #include "DebugRenderer.h"
+#include "RenderTelemetry.h"
 #include "cores/VideoPlayer/VideoRenderers/BaseRenderer.h"
 #include "cores/VideoPlayer/VideoRenderers/OverlayRenderer.h"
 #include "cores/VideoSettings.h"
@@ -104,6 +105,12 @@ public:
    */
   bool GetStats(int &lateframes, double &pts, int &queued, int &discard);
 
+  /**
+   * Timing of the frames going through the render queue since the stream was configured.
+   * Must only be called from the player thread.
+   */
+  void GetTelemetry(SRenderTelemetryInfo& info) { m_telemetry.Collect(info); }
+
   /**
    * Video player call this on flush in oder to discard any queued frames
    */
@@ -131,6 +138,7 @@ protected:
 
   void UpdateLatencyTweak();
   void CheckEnableClockSync();
+  void UpdateTelemetry();
 
   CBaseRenderer *m_pRenderer = nullptr;
   OVERLAY::CRenderer m_overlays;
@@ -185,6 +193,8 @@ protected:
     double         pts;
     EFIELDSYNC     presentfield;
     EPRESENTMETHOD presentmethod;
+    CRenderTelemetry::SFrame timing;
+    bool presented;
   } m_Queue[NUM_BUFFERS];
 
   std::deque<int> m_free;
@@ -224,6 +234,9 @@ protected:
   };
   CClockSync m_clockSync;
 
+  CRenderTelemetry m_telemetry;
+  int m_missedVblanks = -1;
+
   void RenderCapture(CRenderCapture* capture);
   void RemoveCaptures();
   CCriticalSection m_captCritSect;
@@ -0,0 +1,83 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "RenderTelemetry.h"
+
+#include "cores/VideoPlayer/Interface/Addon/TimingConstants.h"
+
+#include <algorithm>
+
+namespace
+{
+// about two seconds of frames at high frame rates, the player drains the ring several times per second
+constexpr size_t RING_SIZE = 128;
+
+double ToMs(double from, double to)
+{
+  if (from == 0.0 || to < from)
+    return 0.0;
+  return (to - from) * 1000.0 / DVD_TIME_BASE;
+}
+}
+
+CRenderTelemetry::CRenderTelemetry() : m_frames(RING_SIZE)
+{
+}
+
+void CRenderTelemetry::AddFrame(const SFrame& frame)
+{
+  if (!m_frames.Push(frame))
+    m_lost++;
+}
+
+void CRenderTelemetry::AddToHistogram(SRenderTelemetryInfo::Histogram& histogram, double ms)
+{
+  size_t bin = 0;
+  while (bin < SRenderTelemetryInfo::TIME_BOUNDS.size() && ms >= SRenderTelemetryInfo::TIME_BOUNDS[bin])
+    bin++;
+  histogram[bin]++;
+}
+
+void CRenderTelemetry::Collect(SRenderTelemetryInfo& info)
+{
+  SFrame frame;
+
+  if (m_resetRequested.exchange(false))
+  {
+    while (m_frames.Pop(frame))
+      ;
+    m_info = SRenderTelemetryInfo();
+    m_skipped = 0;
+    m_lost = 0;
+  }
+
+  while (m_frames.Pop(frame))
+  {
+    const double upload = ToMs(frame.decoded, frame.queued);
+    const double queue = ToMs(frame.queued, frame.flipped);
+    const double present = ToMs(frame.flipped, frame.presented);
+
+    AddToHistogram(m_info.uploadTime, upload);
+    AddToHistogram(m_info.queueTime, queue);
+    AddToHistogram(m_info.presentTime, present);
+    m_info.uploadTimeTotal += upload;
+    m_info.queueTimeTotal += queue;
+    m_info.presentTimeTotal += present;
+
+    const size_t depth = std::min<size_t>(std::max(frame.queueDepth, 0), m_info.queueDepth.size() - 1);
+    m_info.queueDepth[depth]++;
+    m_info.missedVsyncs += frame.missedVsyncs;
+    m_info.frames++;
+  }
+
+  // frames that didn't fit into the ring still went to the screen
+  m_info.frames += m_lost.exchange(0);
+  m_info.skipped = m_skipped;
+
+  info = m_info;
+}
@@ -0,0 +1,62 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "cores/DataCacheCore.h"
+#include "threads/SPSCQueue.h"
+
+#include <atomic>
+
+/*!
+ * \brief Timing of the frames going through the render queue.
+ *
+ * The render thread pushes one record per presented frame into a lock-free ring, the player
+ * thread drains it from time to time and folds the records into histograms. Neither side
+ * waits for the other, records that don't fit into the ring are counted as lost.
+ */
+class CRenderTelemetry
+{
+public:
+  //! timestamps in dvd clock units, taken from the absolute clock
+  struct SFrame
+  {
+    double decoded = 0.0; //!< picture handed to the render manager
+    double queued = 0.0; //!< picture added to the render queue
+    double flipped = 0.0; //!< picked for presentation
+    double presented = 0.0; //!< rendered for the first time
+    int queueDepth = 0; //!< frames left in the queue when it was picked
+    int missedVsyncs = 0; //!< vblanks missed since the previous frame
+  };
+
+  CRenderTelemetry();
+
+  // render thread
+  void AddFrame(const SFrame& frame);
+  void AddSkipped(int count = 1) { m_skipped += count; }
+
+  /*!
+   * \brief Drop everything gathered so far, e.g. on a new stream. Can be called from any thread.
+   */
+  void Reset() { m_resetRequested = true; }
+
+  /*!
+   * \brief Fold the pending records into the totals and return them, player thread only.
+   */
+  void Collect(SRenderTelemetryInfo& info);
+
+private:
+  static void AddToHistogram(SRenderTelemetryInfo::Histogram& histogram, double ms);
+
+  XbmcThreads::CSPSCQueue<SFrame> m_frames;
+  std::atomic<uint64_t> m_skipped{0};
+  std::atomic<uint64_t> m_lost{0};
+  std::atomic<bool> m_resetRequested{false};
+
+  SRenderTelemetryInfo m_info;
+};
@@ -114,6 +114,7 @@ void BaseYUV2RGBGLSLShader::OnCompiledAndLinked()
   m_hYuvMat = glGetUniformLocation(ProgramHandle(), "m_yuvmat");
   m_hStretch = glGetUniformLocation(ProgramHandle(), "m_stretch");
   m_hStep = glGetUniformLocation(ProgramHandle(), "m_step");
+  m_hBob = glGetUniformLocation(ProgramHandle(), "m_bob");
   m_hVertex = glGetAttribLocation(ProgramHandle(), "m_attrpos");
   m_hYcoord = glGetAttribLocation(ProgramHandle(), "m_attrcordY");
   m_hUcoord = glGetAttribLocation(ProgramHandle(), "m_attrcordU");
@@ -140,6 +141,7 @@ bool BaseYUV2RGBGLSLShader::OnEnabled()
   glUniform1i(m_hVTex, 2);
   glUniform1f(m_hStretch, m_stretch);
   glUniform2f(m_hStep, 1.0 / m_width, 1.0 / m_height);
+  glUniform1f(m_hBob, m_bob ? 1.0f : 0.0f);
 
   GLfloat yuvMat[4][4];
   m_pConvMatrix->SetParams(m_contrast, m_black, !m_convertFullRange);
@@ -220,15 +222,21 @@ void BaseYUV2RGBGLSLShader::SetDisplayMetadata(bool hasDisplayMetadata, AVMaster
 
 //////////////////////////////////////////////////////////////////////
 // YUV2RGBProgressiveShader - YUV2RGB with no deinterlacing
-// Use for weave deinterlacing / progressive
+// Use for weave deinterlacing / progressive, or bob with edge directed
+// interpolation of the missing lines when rendering a single field
 //////////////////////////////////////////////////////////////////////
 
 YUV2RGBProgressiveShader::YUV2RGBProgressiveShader(bool rect, EShaderFormat format, bool stretch,
                                                    AVColorPrimaries dstPrimaries, AVColorPrimaries srcPrimaries,
                                                    bool toneMap,
-                                                   std::shared_ptr<GLSLOutput> output)
+                                                   std::shared_ptr<GLSLOutput> output,
+                                                   bool bobEdi)
   : BaseYUV2RGBGLSLShader(rect, format, stretch, dstPrimaries, srcPrimaries, toneMap, output)
 {
+  // the luma of packed formats is interpolated by hand already
+  if (bobEdi && (m_format != SHADER_YUY2 && m_format != SHADER_UYVY))
+    m_defines += "#define XBMC_DEINT_EDI\n";
+
   PixelShader()->LoadSource("gl_yuv2rgb_basic.glsl", m_defines);
   PixelShader()->AppendSource("gl_output.glsl");
 
@@ -35,6 +35,7 @@ public:
   virtual ~BaseYUV2RGBGLSLShader();
 
   void SetField(int field) { m_field  = field; }
+  void SetBob(bool bob) { m_bob = bob; }
   void SetWidth(int w) { m_width  = w; }
   void SetHeight(int h) { m_height = h; }
 
@@ -68,6 +69,7 @@ protected:
   int m_width;
   int m_height;
   int m_field;
+  bool m_bob = false;
   bool m_hasDisplayMetadata = false;
   AVMasteringDisplayMetadata m_displayMetadata;
   bool m_hasLightMetadata = false;
@@ -95,6 +97,7 @@ protected:
   GLint m_hYuvMat = -1;
   GLint m_hStretch = -1;
   GLint m_hStep = -1;
+  GLint m_hBob = -1;
   GLint m_hGammaSrc = -1;
   GLint m_hGammaDstInv = -1;
   GLint m_hPrimMat = -1;
@@ -119,7 +122,8 @@ public:
                            bool stretch,
                            AVColorPrimaries dstPrimaries, AVColorPrimaries srcPrimaries,
                            bool toneMap,
-                           std::shared_ptr<GLSLOutput> output);
+                           std::shared_ptr<GLSLOutput> output,
+                           bool bobEdi = false);
 };
 
 class YUV2RGBFilterShader4 : public BaseYUV2RGBGLSLShader
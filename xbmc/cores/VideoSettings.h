@@ -35,6 +35,7 @@ enum EINTERLACEMETHOD
   VS_INTERLACEMETHOD_MMAL_BOB = 27,
   VS_INTERLACEMETHOD_MMAL_BOB_HALF = 28,
   VS_INTERLACEMETHOD_DXVA_AUTO = 32,
+  VS_INTERLACEMETHOD_RENDER_BOB_EDI = 33,
   VS_INTERLACEMETHOD_MAX // do not use and keep as last enum value.
 };
 
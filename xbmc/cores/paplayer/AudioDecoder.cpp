@@ -10,6 +10,7 @@
 
 #include "Application.h"
 #include "CodecFactory.h"
+#include "DecodeCacheCodec.h"
 #include "FileItem.h"
 #include "ServiceBroker.h"
 #include "music/tags/MusicInfoTag.h"
@@ -78,6 +79,8 @@ bool CAudioDecoder::Create(const CFileItem &file, int64_t seekOffset)
 
   // create our codec
   m_codec=CodecFactory::CreateCodecDemux(file, filecache * 1024);
+  if (m_codec && CDecodeCacheCodec::IsEnabled(file))
+    m_codec = new CDecodeCacheCodec(m_codec);
 
   if (!m_codec || !m_codec->Init(file, filecache * 1024))
   {
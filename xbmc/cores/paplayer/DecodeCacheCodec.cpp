@@ -0,0 +1,303 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "DecodeCacheCodec.h"
+
+#include "FileItem.h"
+#include "ServiceBroker.h"
+#include "filesystem/Directory.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "utils/Crc32.h"
+#include "utils/StringUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+#include <vector>
+
+#define DECODE_CACHE_PATH "special://temp/decodecache/"
+#define DECODE_CACHE_VERSION 1
+
+using namespace XFILE;
+
+namespace
+{
+
+struct DecodeCacheHeader
+{
+  char magic[4];
+  uint32_t version;
+  uint32_t sampleRate;
+  uint32_t dataFormat;
+  uint32_t channels;
+  uint32_t bitsPerSample;
+};
+
+DecodeCacheHeader MakeHeader(const ICodec &codec)
+{
+  DecodeCacheHeader header;
+  memcpy(header.magic, "KPCM", 4);
+  header.version = DECODE_CACHE_VERSION;
+  header.sampleRate = codec.m_format.m_sampleRate;
+  header.dataFormat = codec.m_format.m_dataFormat;
+  header.channels = codec.m_format.m_channelLayout.Count();
+  header.bitsPerSample = codec.m_bitsPerSample;
+  return header;
+}
+
+} // namespace
+
+CDecodeCacheCodec::CDecodeCacheCodec(ICodec *codec) : m_codec(codec)
+{
+}
+
+CDecodeCacheCodec::~CDecodeCacheCodec()
+{
+  AbortStore();
+}
+
+bool CDecodeCacheCodec::IsEnabled(const CFileItem &file)
+{
+  if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioDecodeCacheSize <= 0)
+    return false;
+
+  // cue sheet tracks are never decoded from start to end
+  return !file.IsInternetStream() && !file.m_lStartOffset && !file.m_lEndOffset;
+}
+
+std::string CDecodeCacheCodec::GetCacheFile(const CFileItem &file)
+{
+  // a changed file gets a new key, its old entry ages out of the cache
+  struct __stat64 st;
+  if (CFile::Stat(file.GetDynPath(), &st) != 0)
+    return "";
+
+  std::string key = StringUtils::Format("%s|%" PRId64 "|%" PRId64, file.GetDynPath().c_str(),
+                                        static_cast<int64_t>(st.st_size),
+                                        static_cast<int64_t>(st.st_mtime));
+  return StringUtils::Format(DECODE_CACHE_PATH "%08x.pcm", Crc32::ComputeFromLowerCase(key));
+}
+
+bool CDecodeCacheCodec::Init(const CFileItem &file, unsigned int filecache)
+{
+  if (!m_codec->Init(file, filecache))
+    return false;
+
+  m_TotalTime = m_codec->m_TotalTime;
+  m_bitRate = m_codec->m_bitRate;
+  m_bitsPerSample = m_codec->m_bitsPerSample;
+  m_bitsPerCodedSample = m_codec->m_bitsPerCodedSample;
+  m_CodecName = m_codec->m_CodecName;
+  m_tag = m_codec->m_tag;
+  m_format = m_codec->m_format;
+
+  if (m_format.m_dataFormat == AE_FMT_RAW)
+    return true;
+
+  m_frameSize = (m_bitsPerSample >> 3) * m_format.m_channelLayout.Count();
+  if (!m_frameSize)
+    return true;
+
+  m_cacheFile = GetCacheFile(file);
+  if (m_cacheFile.empty())
+    return true;
+
+  if (!OpenCached(m_cacheFile))
+    StartStore(m_cacheFile);
+
+  return true;
+}
+
+bool CDecodeCacheCodec::OpenCached(const std::string &cacheFile)
+{
+  if (!CFile::Exists(cacheFile) || !m_cachedFile.Open(cacheFile))
+    return false;
+
+  DecodeCacheHeader header;
+  DecodeCacheHeader expected = MakeHeader(*m_codec);
+  if (m_cachedFile.Read(&header, sizeof(header)) != static_cast<ssize_t>(sizeof(header)) ||
+      memcmp(&header, &expected, sizeof(header)) != 0)
+  {
+    CLog::Log(LOGDEBUG, "CDecodeCacheCodec::OpenCached - %s doesn't match the decoder", cacheFile.c_str());
+    m_cachedFile.Close();
+    return false;
+  }
+
+  CLog::Log(LOGDEBUG, "CDecodeCacheCodec::OpenCached - playing from %s", cacheFile.c_str());
+  m_cached = true;
+  return true;
+}
+
+bool CDecodeCacheCodec::StartStore(const std::string &cacheFile)
+{
+  if (!CDirectory::Exists(DECODE_CACHE_PATH) && !CDirectory::Create(DECODE_CACHE_PATH))
+    return false;
+
+  // unique per decoder, the same file may be decoded twice at a time when crossfading
+  m_storeTmpFile = StringUtils::Format("%s.%p.tmp", cacheFile.c_str(), static_cast<void*>(this));
+  if (!m_storeFile.OpenForWrite(m_storeTmpFile, true))
+    return false;
+
+  DecodeCacheHeader header = MakeHeader(*m_codec);
+  if (m_storeFile.Write(&header, sizeof(header)) != static_cast<ssize_t>(sizeof(header)))
+  {
+    AbortStore();
+    return false;
+  }
+
+  m_storing = true;
+  return true;
+}
+
+void CDecodeCacheCodec::FinishStore()
+{
+  if (!m_storing)
+    return;
+
+  m_storeFile.Close();
+  m_storing = false;
+
+  if (!CFile::Rename(m_storeTmpFile, m_cacheFile))
+  {
+    CFile::Delete(m_storeTmpFile);
+    return;
+  }
+
+  CLog::Log(LOGDEBUG, "CDecodeCacheCodec::FinishStore - stored %s", m_cacheFile.c_str());
+  Trim();
+}
+
+void CDecodeCacheCodec::AbortStore()
+{
+  if (!m_storing)
+    return;
+
+  m_storeFile.Close();
+  CFile::Delete(m_storeTmpFile);
+  m_storing = false;
+}
+
+void CDecodeCacheCodec::Trim()
+{
+  int64_t maxSize = static_cast<int64_t>(CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioDecodeCacheSize) * 1024 * 1024;
+
+  CFileItemList items;
+  if (!CDirectory::GetDirectory(DECODE_CACHE_PATH, items, ".pcm", DIR_FLAG_NO_FILE_DIRS))
+    return;
+
+  struct CacheEntry
+  {
+    std::string path;
+    int64_t size;
+    int64_t used;
+  };
+  std::vector<CacheEntry> entries;
+  int64_t total = 0;
+  for (const auto& item : items)
+  {
+    struct __stat64 st;
+    if (item->m_bIsFolder || CFile::Stat(item->GetPath(), &st) != 0)
+      continue;
+
+    // reading a file updates its access time, unless the volume is mounted noatime
+    entries.push_back({item->GetPath(), static_cast<int64_t>(st.st_size),
+                       static_cast<int64_t>(std::max(st.st_atime, st.st_mtime))});
+    total += st.st_size;
+  }
+
+  if (total <= maxSize)
+    return;
+
+  std::sort(entries.begin(), entries.end(), [](const CacheEntry &a, const CacheEntry &b)
+  {
+    return a.used < b.used;
+  });
+
+  for (const auto& entry : entries)
+  {
+    if (total <= maxSize)
+      break;
+    if (CFile::Delete(entry.path))
+      total -= entry.size;
+  }
+}
+
+bool CDecodeCacheCodec::Seek(int64_t iSeekTime)
+{
+  if (m_cached)
+  {
+    int64_t frame = iSeekTime * m_format.m_sampleRate / 1000;
+    int64_t pos = sizeof(DecodeCacheHeader) + frame * m_frameSize;
+    pos = std::min(pos, m_cachedFile.GetLength());
+    return m_cachedFile.Seek(pos) == pos;
+  }
+
+  // what follows a seek doesn't complete the cache file
+  AbortStore();
+  return m_codec->Seek(iSeekTime);
+}
+
+int CDecodeCacheCodec::ReadPCM(unsigned char *pBuffer, int size, int *actualsize)
+{
+  if (m_cached)
+  {
+    size -= size % m_frameSize;
+    ssize_t read = m_cachedFile.Read(pBuffer, size);
+    if (read < 0)
+      return READ_ERROR;
+
+    *actualsize = static_cast<int>(read);
+    return read ? READ_SUCCESS : READ_EOF;
+  }
+
+  int ret = m_codec->ReadPCM(pBuffer, size, actualsize);
+
+  if (m_storing)
+  {
+    if (ret == READ_ERROR ||
+        (*actualsize && m_storeFile.Write(pBuffer, *actualsize) != *actualsize))
+      AbortStore();
+    else if (ret == READ_EOF)
+      FinishStore();
+  }
+
+  return ret;
+}
+
+int CDecodeCacheCodec::ReadRaw(uint8_t **pBuffer, int *bufferSize)
+{
+  return m_codec->ReadRaw(pBuffer, bufferSize);
+}
+
+bool CDecodeCacheCodec::CanInit()
+{
+  return m_codec->CanInit();
+}
+
+bool CDecodeCacheCodec::CanSeek()
+{
+  return m_cached || m_codec->CanSeek();
+}
+
+void CDecodeCacheCodec::SetTotalTime(int64_t totaltime)
+{
+  m_codec->SetTotalTime(totaltime);
+  m_TotalTime = m_codec->m_TotalTime;
+}
+
+bool CDecodeCacheCodec::IsCaching() const
+{
+  return !m_cached && m_codec->IsCaching();
+}
+
+int CDecodeCacheCodec::GetCacheLevel() const
+{
+  return m_cached ? -1 : m_codec->GetCacheLevel();
+}
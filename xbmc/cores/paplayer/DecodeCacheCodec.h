@@ -0,0 +1,63 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "CachingCodec.h"
+
+#include <memory>
+#include <string>
+
+/*!
+ \brief Keeps the decoded PCM of a file on disk, so playing it again
+ doesn't decode it again.
+
+ The wrapped codec is always initialized, it provides tag, format and
+ times. PCM is served from the cache file if there is one matching the
+ format, otherwise the wrapped codec decodes and its output is written
+ to the cache. A cache file is only kept when a file was decoded from
+ start to end without seeking. The cache directory is bounded by
+ advancedsettings <audio><decodecachesize> in MB, least recently used
+ files are removed first.
+ */
+class CDecodeCacheCodec : public CachingCodec
+{
+public:
+  explicit CDecodeCacheCodec(ICodec *codec);
+  ~CDecodeCacheCodec() override;
+
+  bool Init(const CFileItem &file, unsigned int filecache) override;
+  bool Seek(int64_t iSeekTime) override;
+  int ReadPCM(unsigned char *pBuffer, int size, int *actualsize) override;
+  int ReadRaw(uint8_t **pBuffer, int *bufferSize) override;
+  bool CanInit() override;
+  bool CanSeek() override;
+  void SetTotalTime(int64_t totaltime) override;
+  bool IsCaching() const override;
+  int GetCacheLevel() const override;
+
+  /*! \brief Whether decoded PCM of the file should go through the cache */
+  static bool IsEnabled(const CFileItem &file);
+
+private:
+  static std::string GetCacheFile(const CFileItem &file);
+  static void Trim();
+  bool OpenCached(const std::string &cacheFile);
+  bool StartStore(const std::string &cacheFile);
+  void FinishStore();
+  void AbortStore();
+
+  std::unique_ptr<ICodec> m_codec;
+  XFILE::CFile m_cachedFile;
+  XFILE::CFile m_storeFile;
+  std::string m_cacheFile;
+  std::string m_storeTmpFile;
+  bool m_cached = false;
+  bool m_storing = false;
+  unsigned int m_frameSize = 0;
+};
@@ -140,7 +140,7 @@ void PAPlayer::SoftStop(bool wait/* = false */, bool close/* = true */)
     lock.Enter();
 
     /* be sure they have faded out */
-    while(wait && !CServiceBroker::GetActiveAE()->IsSuspended() && !timer.IsTimePast())
+    while(wait && !CServiceBroker::GetMusicAE()->IsSuspended() && !timer.IsTimePast())
     {
       wait = false;
       for(StreamList::iterator itt = m_streams.begin(); itt != m_streams.end(); ++itt)
@@ -182,7 +182,7 @@ void PAPlayer::CloseAllStreams(bool fade/* = true */)
       if (si->m_stream)
       {
         CloseFileCB(*si);
-        CServiceBroker::GetActiveAE()->FreeStream(si->m_stream, true);
+        si->m_engine->FreeStream(si->m_stream, true);
         si->m_stream = NULL;
       }
 
@@ -198,7 +198,7 @@ void PAPlayer::CloseAllStreams(bool fade/* = true */)
       if (si->m_stream)
       {
         CloseFileCB(*si);
-        CServiceBroker::GetActiveAE()->FreeStream(si->m_stream, true);
+        si->m_engine->FreeStream(si->m_stream, true);
         si->m_stream = nullptr;
       }
 
@@ -374,6 +374,7 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn)
   else
     si->m_seekFrame = -1;
   si->m_stream = NULL;
+  si->m_engine = nullptr;
   si->m_volume = (fadeIn && m_upcomingCrossfadeMS) ? 0.0f : 1.0f;
   si->m_fadeOutTriggered = false;
   si->m_isSlaved = false;
@@ -450,7 +451,8 @@ inline bool PAPlayer::PrepareStream(StreamInfo *si)
 
   /* get a paused stream */
   AEAudioFormat format = si->m_audioFormat;
-  si->m_stream = CServiceBroker::GetActiveAE()->MakeStream(
+  si->m_engine = CServiceBroker::GetMusicAE();
+  si->m_stream = si->m_engine->MakeStream(
     format,
     AESTREAM_PAUSED
   );
@@ -474,8 +476,9 @@ inline bool PAPlayer::PrepareStream(StreamInfo *si)
     // Clipping protection (when enabled in AE) by audio limiting, applied just where needed
     si->m_stream->SetAmplification(gain);
 
-  /* if its not the first stream and crossfade is not enabled */
-  if (m_currentStream && m_currentStream != si && !m_upcomingCrossfadeMS)
+  /* if its not the first stream and crossfade is not enabled, slaves must be on the same engine */
+  if (m_currentStream && m_currentStream != si && !m_upcomingCrossfadeMS &&
+      m_currentStream->m_engine == si->m_engine)
   {
     /* slave the stream for gapless */
     si->m_isSlaved = true;
@@ -501,6 +504,19 @@ inline bool PAPlayer::PrepareStream(StreamInfo *si)
     CThread::Sleep(1);
   }
 
+  /* a queued stream has time until the transition, decode its first seconds
+   * ahead so that starting it doesn't depend on the source being fast enough */
+  if (m_currentStream && m_currentStream != si)
+  {
+    while (si->m_decoder.GetStatus() == STATUS_QUEUING && !m_bStop)
+    {
+      if (si->m_decoder.ReadSamples(PACKET_SIZE) == RET_ERROR)
+        break;
+
+      CThread::Sleep(1);
+    }
+  }
+
   CLog::Log(LOGINFO, "PAPlayer::PrepareStream - Ready");
 
   return true;
@@ -509,7 +525,7 @@ inline bool PAPlayer::PrepareStream(StreamInfo *si)
 bool PAPlayer::CloseFile(bool reopen)
 {
   if (reopen)
-    CServiceBroker::GetActiveAE()->KeepConfiguration(3000);
+    CServiceBroker::GetMusicAE()->KeepConfiguration(3000);
 
   if (!m_isPaused)
     SoftStop(true, true);
@@ -598,7 +614,7 @@ inline void PAPlayer::ProcessStreams(double &freeBufferTime)
     {
       itt = m_finishing.erase(itt);
       CloseFileCB(*si);
-      CServiceBroker::GetActiveAE()->FreeStream(si->m_stream, true);
+      si->m_engine->FreeStream(si->m_stream, true);
       delete si;
       CLog::Log(LOGDEBUG, "PAPlayer::ProcessStreams - Stream Freed");
     }
@@ -690,7 +706,7 @@ inline void PAPlayer::ProcessStreams(double &freeBufferTime)
       {
         if (m_upcomingCrossfadeMS)
         {
-          si->m_stream->FadeVolume(1.0f, 0.0f, m_upcomingCrossfadeMS);
+          si->m_stream->FadeVolume(1.0f, 0.0f, m_upcomingCrossfadeMS, true);
           si->m_fadeOutTriggered = true;
         }
         m_currentStream = NULL;
@@ -713,7 +729,7 @@ inline bool PAPlayer::ProcessStream(StreamInfo *si, double &freeBufferTime)
     si->m_stream->RegisterAudioCallback(m_audioCallback);
     if (!si->m_isSlaved)
       si->m_stream->Resume();
-    si->m_stream->FadeVolume(0.0f, 1.0f, m_upcomingCrossfadeMS);
+    si->m_stream->FadeVolume(0.0f, 1.0f, m_upcomingCrossfadeMS, true);
     if (m_signalStarted)
       m_callback.OnPlayBackStarted(si->m_fileItem);
     m_signalStarted = true;
@@ -20,6 +20,7 @@
 #include <list>
 #include <vector>
 
+class IAE;
 class IAEStream;
 class CFileItem;
 class CProcessInfo;
@@ -102,6 +103,7 @@ private:
     int m_seekFrame;                     /* the exact position to seek too, -1 for none */
 
     IAEStream* m_stream;                 /* the playback stream */
+    IAE* m_engine;                       /* the engine the stream was made on */
     float m_volume;                      /* the initial volume level to set the stream to on creation */
 
     bool m_isSlaved;                     /* true if the stream has been slaved to another */
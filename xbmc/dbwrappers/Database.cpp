@@ -11,6 +11,7 @@
 #include "filesystem/SpecialProtocol.h"
 #include "profiles/ProfileManager.h"
 #include "settings/SettingsComponent.h"
+#include "threads/SystemClock.h"
 #include "utils/log.h"
 #include "utils/SortUtils.h"
 #include "utils/StringUtils.h"
@@ -221,6 +222,13 @@ CDatabase::CDatabase() :
   m_sqlite = true;
   m_bMultiWrite = false;
   m_multipleExecute = false;
+  m_writeBatch = false;
+  m_batchTransaction = false;
+  m_batchSavepoints = 0;
+  m_batchItems = 0;
+  m_batchMaxItems = 0;
+  m_batchMaxMs = 0;
+  m_batchStart = 0;
 }
 
 CDatabase::~CDatabase(void)
@@ -294,6 +302,26 @@ std::string CDatabase::GetSingleValue(const std::string &query)
   return GetSingleValue(query, m_pDS);
 }
 
+std::string CDatabase::GetSingleValue(const std::string &query, const dbiplus::sql_params &params)
+{
+  std::string ret;
+  try
+  {
+    if (!m_pDB || !m_pDS)
+      return ret;
+
+    if (m_pDS->query(query, params) && m_pDS->num_rows() > 0)
+      ret = m_pDS->fv(0).get_asString();
+
+    m_pDS->close();
+  }
+  catch(...)
+  {
+    CLog::Log(LOGERROR, "%s - failed on query '%s'", __FUNCTION__, query.c_str());
+  }
+  return ret;
+}
+
 bool CDatabase::DeleteValues(const std::string &strTable, const Filter &filter /* = Filter() */)
 {
   std::string strQuery;
@@ -352,6 +380,46 @@ bool CDatabase::ExecuteQuery(const std::string &strQuery)
   return bReturn;
 }
 
+bool CDatabase::ExecuteQuery(const std::string &strQuery, const dbiplus::sql_params &params)
+{
+  if (m_multipleExecute)
+  {
+    if (nullptr == m_pDB)
+      return false;
+    m_multipleQueries.push_back(m_pDB->bind(strQuery, params));
+    return true;
+  }
+
+  bool bReturn = false;
+
+  try
+  {
+    if (nullptr == m_pDB)
+      return bReturn;
+    if (nullptr == m_pDS)
+      return bReturn;
+    m_pDS->exec(strQuery, params);
+    bReturn = true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s - failed to execute query '%s'",
+        __FUNCTION__, strQuery.c_str());
+  }
+
+  return bReturn;
+}
+
+bool CDatabase::ExecuteBatchMarker(const std::string &strQuery)
+{
+  if (m_writeBatch)
+  {
+    m_batchMarkers.push_back(strQuery);
+    return true;
+  }
+  return ExecuteQuery(strQuery);
+}
+
 bool CDatabase::ResultQuery(const std::string &strQuery)
 {
   bool bReturn = false;
@@ -604,6 +672,7 @@ void CDatabase::Close()
 
   if (nullptr == m_pDB)
     return;
+  CommitWriteBatch();
   if (nullptr != m_pDS)
     m_pDS->close();
   m_pDB->disconnect();
@@ -659,8 +728,22 @@ void CDatabase::BeginTransaction()
 {
   try
   {
-    if (nullptr != m_pDB)
-      m_pDB->start_transaction();
+    if (nullptr == m_pDB)
+      return;
+
+    if (m_writeBatch && nullptr != m_pDS)
+    {
+      if (!m_batchTransaction)
+      {
+        m_pDB->start_transaction();
+        m_batchTransaction = true;
+        m_batchStart = XbmcThreads::SystemClockMillis();
+      }
+      m_pDS->exec(PrepareSQL("SAVEPOINT batch%u", m_batchSavepoints++));
+      return;
+    }
+
+    m_pDB->start_transaction();
   }
   catch (...)
   {
@@ -672,8 +755,18 @@ bool CDatabase::CommitTransaction()
 {
   try
   {
-    if (nullptr != m_pDB)
-      m_pDB->commit_transaction();
+    if (nullptr == m_pDB)
+      return true;
+
+    if (m_writeBatch)
+    {
+      // the batch commits by itself, a commit without savepoint belongs to none of its items
+      if (m_batchSavepoints > 0)
+        m_pDS->exec(PrepareSQL("RELEASE SAVEPOINT batch%u", --m_batchSavepoints));
+      return true;
+    }
+
+    m_pDB->commit_transaction();
   }
   catch (...)
   {
@@ -687,8 +780,21 @@ void CDatabase::RollbackTransaction()
 {
   try
   {
-    if (nullptr != m_pDB)
-      m_pDB->rollback_transaction();
+    if (nullptr == m_pDB)
+      return;
+
+    if (m_writeBatch)
+    {
+      if (m_batchSavepoints > 0)
+      {
+        m_batchSavepoints--;
+        m_pDS->exec(PrepareSQL("ROLLBACK TO SAVEPOINT batch%u", m_batchSavepoints));
+        m_pDS->exec(PrepareSQL("RELEASE SAVEPOINT batch%u", m_batchSavepoints));
+      }
+      return;
+    }
+
+    m_pDB->rollback_transaction();
   }
   catch (...)
   {
@@ -696,6 +802,74 @@ void CDatabase::RollbackTransaction()
   }
 }
 
+void CDatabase::BeginWriteBatch(unsigned int maxItems, unsigned int maxMs)
+{
+  if (m_writeBatch || maxItems == 0 || nullptr == m_pDB)
+    return;
+
+  m_writeBatch = true;
+  m_batchTransaction = false;
+  m_batchSavepoints = 0;
+  m_batchItems = 0;
+  m_batchMaxItems = maxItems;
+  m_batchMaxMs = maxMs;
+  m_batchMarkers.clear();
+}
+
+void CDatabase::EndWriteBatchItem()
+{
+  if (!m_writeBatch)
+    return;
+
+  m_batchItems++;
+  if (m_batchItems >= m_batchMaxItems ||
+      (m_batchTransaction && XbmcThreads::SystemClockMillis() - m_batchStart >= m_batchMaxMs))
+    FlushWriteBatch();
+}
+
+bool CDatabase::CommitWriteBatch()
+{
+  if (!m_writeBatch)
+    return true;
+
+  bool bReturn = FlushWriteBatch();
+  m_writeBatch = false;
+  return bReturn;
+}
+
+bool CDatabase::FlushWriteBatch()
+{
+  bool bReturn = true;
+
+  // the markers go last, then the transaction holds everything they cover
+  for (const auto& marker : m_batchMarkers)
+    bReturn &= ExecuteQuery(marker);
+  m_batchMarkers.clear();
+
+  if (m_batchTransaction)
+  {
+    m_batchTransaction = false;
+    if (m_batchSavepoints > 0)
+      CLog::Log(LOGWARNING, "%s - %u savepoints left open", __FUNCTION__, m_batchSavepoints);
+    m_batchSavepoints = 0;
+
+    try
+    {
+      if (nullptr != m_pDB)
+        m_pDB->commit_transaction();
+    }
+    catch (...)
+    {
+      CLog::Log(LOGERROR, "%s - failed to commit %u items", __FUNCTION__, m_batchItems);
+      bReturn = false;
+    }
+  }
+
+  CLog::Log(LOGDEBUG, LOGDATABASE, "%s - committed %u items", __FUNCTION__, m_batchItems);
+  m_batchItems = 0;
+  return bReturn;
+}
+
 bool CDatabase::CreateDatabase()
 {
   BeginTransaction();
@@ -725,6 +899,84 @@ void CDatabase::UpdateVersionNumber()
   m_pDS->exec(strSQL);
 }
 
+int CDatabase::GetChanges(int since, unsigned int limit, std::vector<ChangeLogEntry> &changes)
+{
+  changes.clear();
+  if (nullptr == m_pDB || nullptr == m_pDS)
+    return -1;
+
+  try
+  {
+    // read before the changes, anything logged in between is returned again next time
+    int revision = static_cast<int>(strtol(GetSingleValue("SELECT MAX(idChange) FROM changelog", m_pDS).c_str(), nullptr, 10));
+
+    std::string sql = PrepareSQL("SELECT idChange, media_type, media_id, action FROM changelog WHERE idChange > %i ORDER BY idChange", since);
+    if (limit > 0)
+      sql += PrepareSQL(" LIMIT %u", limit);
+    if (!m_pDS->query(sql))
+      return -1;
+
+    while (!m_pDS->eof())
+    {
+      ChangeLogEntry change;
+      change.revision = m_pDS->fv(0).get_asInt();
+      change.mediaType = m_pDS->fv(1).get_asString();
+      change.mediaId = m_pDS->fv(2).get_asInt();
+      change.action = m_pDS->fv(3).get_asString();
+      changes.push_back(change);
+      m_pDS->next();
+    }
+    m_pDS->close();
+
+    if (!changes.empty() && (changes.size() == limit || changes.back().revision > revision))
+      revision = changes.back().revision;
+    return revision;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed for revision %i", __FUNCTION__, since);
+  }
+  return -1;
+}
+
+int CDatabase::GetChangeRevision()
+{
+  if (nullptr == m_pDB || nullptr == m_pDS)
+    return -1;
+
+  try
+  {
+    if (!m_pDS->query("SELECT MAX(idChange) FROM changelog"))
+      return -1;
+
+    int revision = 0;
+    if (!m_pDS->eof())
+      revision = m_pDS->fv(0).get_asInt();
+    m_pDS->close();
+    return revision;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed", __FUNCTION__);
+  }
+  return -1;
+}
+
+void CDatabase::CreateChangeLogTable()
+{
+  CLog::Log(LOGINFO, "create changelog table");
+  m_pDS->exec("CREATE TABLE changelog (idChange INTEGER PRIMARY KEY, media_id INTEGER, media_type TEXT, action TEXT)");
+}
+
+std::string CDatabase::GetChangeLogSQL(const std::string &mediaType, const std::string &ids, const std::string &action) const
+{
+  // the row with the highest id is never deleted, sqlite would hand out its id again
+  return "DELETE FROM changelog WHERE media_type='" + mediaType + "' AND media_id IN (" + ids + ") "
+         "AND idChange < (SELECT latest FROM (SELECT MAX(idChange) AS latest FROM changelog) AS lastchange); "
+         "INSERT INTO changelog (media_id, media_type, action) "
+         "SELECT media_id, '" + mediaType + "', '" + action + "' FROM (" + ids + ") AS ids; ";
+}
+
 bool CDatabase::BuildSQL(const std::string &strQuery, const Filter &filter, std::string &strSQL)
 {
   strSQL = strQuery;
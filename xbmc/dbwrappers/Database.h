@@ -8,15 +8,17 @@
 
 #pragma once
 
+#include <memory>
+#include <string>
+#include <vector>
+
 namespace dbiplus {
   class Database;
   class Dataset;
+  class field_value;
+  typedef std::vector<field_value> sql_params;
 }
 
-#include <memory>
-#include <string>
-#include <vector>
-
 class DatabaseSettings; // forward
 class CDbUrl;
 class CProfileManager;
@@ -92,6 +94,14 @@ public:
   };
 
 
+  struct ChangeLogEntry
+  {
+    int revision;
+    std::string mediaType;
+    int mediaId;
+    std::string action; /*!< "update" or "remove" */
+  };
+
   CDatabase();
   virtual ~CDatabase(void);
   bool IsOpen();
@@ -104,6 +114,31 @@ public:
   void BeginTransaction();
   virtual bool CommitTransaction();
   void RollbackTransaction();
+
+  /*!
+   * @brief Group the writes of many items into a few large transactions, e.g. during a scan.
+   *        The transaction is opened with the first BeginTransaction() that follows and is
+   *        committed by EndWriteBatchItem() once enough items were written or enough time
+   *        passed. Transactions started meanwhile become savepoints inside it, so a failing
+   *        item is still rolled back on its own.
+   * @param maxItems Commit after this many items, 0 disables batching.
+   * @param maxMs Commit once the transaction is open for this long.
+   * @sa EndWriteBatchItem, CommitWriteBatch, ExecuteBatchMarker
+   */
+  void BeginWriteBatch(unsigned int maxItems, unsigned int maxMs);
+
+  /*!
+   * @brief Mark the end of an item of a write batch, commits the batch when it is due.
+   */
+  void EndWriteBatchItem();
+
+  /*!
+   * @brief Commit the pending writes and end the write batch.
+   * @return True if everything was written successfully or there was no batch, false otherwise.
+   */
+  virtual bool CommitWriteBatch();
+
+  bool IsWriteBatchActive() const { return m_writeBatch; }
   void CopyDB(const std::string& latestDb);
   void DropAnalytics();
 
@@ -128,6 +163,13 @@ public:
    */
   std::string GetSingleValue(const std::string &query, std::unique_ptr<dbiplus::Dataset> &ds);
 
+  /*! \brief Get a single value from a query with bound values.
+   \param query the query with one '?' placeholder per value.
+   \param params the values for the placeholders, in order.
+   \return the value from the query, empty on failure.
+   */
+  std::string GetSingleValue(const std::string &query, const dbiplus::sql_params &params);
+
   /*!
    * @brief Delete values from a table.
    * @param strTable The table to delete the values from.
@@ -146,6 +188,28 @@ public:
    */
   bool ExecuteQuery(const std::string &strQuery);
 
+  /*!
+   * @brief Execute a query that does not return any result, with its '?'
+   *        placeholders bound to the values. The compiled statement is kept
+   *        by the connection, so running the same query again only binds the
+   *        new values. Queued like ExecuteQuery() after BeginMultipleExecute().
+   * @param strQuery The query to execute, a single statement.
+   * @param params The values for the placeholders, in order.
+   * @return True if the query was executed successfully, false otherwise.
+   */
+  bool ExecuteQuery(const std::string &strQuery, const dbiplus::sql_params &params);
+
+  /*!
+   * @brief Execute a query that marks the writes before it as complete, like
+   *        the hash of a scanned path. During a write batch it is deferred up
+   *        to the commit of the batch and runs in the same transaction, so the
+   *        marker is never stored without the writes it covers.
+   * @param strQuery The query to execute.
+   * @return True if the query was executed or queued successfully, false otherwise.
+   * @sa BeginWriteBatch
+   */
+  bool ExecuteBatchMarker(const std::string &strQuery);
+
   /*!
    * @brief Execute a query that returns a result.
    * @remarks Call m_pDS->close(); to clean up the dataset when done.
@@ -187,6 +251,24 @@ public:
    */
   bool CommitInsertQueries();
 
+  /*!
+   * @brief Get the items that were added, changed or removed after the given revision.
+   *        The changelog table is maintained by triggers of the child classes, so writes
+   *        of other clients of a shared database are included.
+   * @param since The revision returned by the previous call, 0 for everything.
+   * @param limit Return at most this many changes, 0 for no limit.
+   * @param changes [out] The changes, oldest first.
+   * @return The revision to pass with the next call, -1 on error. A revision lower than
+   *         since means the library was recreated and has to be pulled completely.
+   */
+  int GetChanges(int since, unsigned int limit, std::vector<ChangeLogEntry> &changes);
+
+  /*!
+   * @brief Get the latest revision of the changelog without reading the changes.
+   * @return The revision, -1 on error.
+   */
+  int GetChangeRevision();
+
   virtual bool GetFilter(CDbUrl &dbUrl, Filter &filter, SortDescription &sorting) { return true; }
   virtual bool BuildSQL(const std::string &strBaseDir, const std::string &strQuery, Filter &filter, std::string &strSQL, CDbUrl &dbUrl);
   virtual bool BuildSQL(const std::string &strBaseDir, const std::string &strQuery, Filter &filter, std::string &strSQL, CDbUrl &dbUrl, SortDescription &sorting);
@@ -234,6 +316,18 @@ protected:
 
   bool BuildSQL(const std::string &strQuery, const Filter &filter, std::string &strSQL);
 
+  /*! \brief Create the changelog table read by GetChanges().
+   */
+  void CreateChangeLogTable();
+
+  /*! \brief Statements for the body of a trigger that logs a change of some items.
+   Only the latest change of an item is kept.
+   \param mediaType the media type of the items.
+   \param ids a SELECT returning the ids of the items in a column named media_id.
+   \param action "update" or "remove".
+   */
+  std::string GetChangeLogSQL(const std::string &mediaType, const std::string &ids, const std::string &action) const;
+
   bool m_sqlite; ///< \brief whether we use sqlite (defaults to true)
 
   std::unique_ptr<dbiplus::Database> m_pDB;
@@ -253,4 +347,15 @@ private:
 
   bool m_multipleExecute;
   std::vector<std::string> m_multipleQueries;
+
+  bool FlushWriteBatch();
+
+  bool m_writeBatch; /*!< True between BeginWriteBatch() and CommitWriteBatch() */
+  bool m_batchTransaction; /*!< True if the transaction of the batch is open */
+  unsigned int m_batchSavepoints;
+  unsigned int m_batchItems;
+  unsigned int m_batchMaxItems;
+  unsigned int m_batchMaxMs;
+  unsigned int m_batchStart;
+  std::vector<std::string> m_batchMarkers;
 };
@@ -68,6 +68,56 @@ std::string Database::prepare(const char *format, ...)
   return result;
 }
 
+std::string Database::bind(const std::string &sql, const sql_params &params)
+{
+  std::string result;
+  result.reserve(sql.size());
+
+  size_t param = 0;
+  char quote = 0;
+  for (const char c : sql)
+  {
+    if (quote)
+    {
+      if (c == quote)
+        quote = 0;
+    }
+    else if (c == '\'' || c == '"' || c == '`')
+      quote = c;
+    else if (c == '?' && param < params.size())
+    {
+      result += bind_value(params[param++]);
+      continue;
+    }
+    result += c;
+  }
+
+  return result;
+}
+
+std::string Database::bind_value(const field_value &value)
+{
+  if (value.get_isNull())
+    return "NULL";
+
+  switch (value.get_fType())
+  {
+  case ft_Boolean:
+  case ft_Short:
+  case ft_UShort:
+  case ft_Int:
+  case ft_UInt:
+  case ft_Int64:
+    return std::to_string(value.get_asInt64());
+  case ft_Float:
+  case ft_Double:
+  case ft_LongDouble:
+    return prepare("%.17g", value.get_asDouble());
+  default:
+    return prepare("'%s'", value.get_asString().c_str());
+  }
+}
+
 //************* Dataset implementation ***************
 
 Dataset::Dataset():
@@ -403,6 +453,14 @@ const sql_record* Dataset::get_sql_record()
   return result.records[frecno];
 }
 
+int Dataset::exec(const std::string &sql, const sql_params &params) {
+  return exec(db->bind(sql, params));
+}
+
+bool Dataset::query(const std::string &sql, const sql_params &params) {
+  return query(db->bind(sql, params));
+}
+
 const field_value Dataset::f_old(const char *f_name) {
   if (ds_state != dsInactive)
     for (int unsigned i=0; i < fields_object->size(); i++)
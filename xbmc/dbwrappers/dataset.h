@@ -148,8 +148,19 @@ public:
    */
   virtual std::string vprepare(const char *format, va_list args) = 0;
 
+  /*! \brief Replace the '?' placeholders of a statement by the values, quoted and escaped like prepare() does.
+   Used where a statement can't be run with bound values.
+   \param sql - statement with one '?' per value, placeholders inside quotes are left alone
+   \param params - values in the order of the placeholders
+   \return the statement with the values filled in.
+   */
+  std::string bind(const std::string &sql, const sql_params &params);
+
   virtual bool in_transaction() {return false;};
 
+private:
+  std::string bind_value(const field_value &value);
+
 };
 
 
@@ -290,9 +301,18 @@ public:
 /* func. executes a query without results to return */
   virtual int  exec (const std::string &sql) = 0;
   virtual int  exec() = 0;
+/* as exec/query, but the '?' placeholders of a single statement are bound to the values.
+   Backends that support it keep the compiled statement for the next call with the same
+   sql, the others fill the values into the sql text */
+  virtual int  exec(const std::string &sql, const sql_params &params);
+  virtual bool query(const std::string &sql, const sql_params &params);
   virtual const void* getExecRes()=0;
 /* as open, but with our query exec Sql */
   virtual bool query(const std::string &sql) = 0;
+/* as query, but the rows are read one by one while the dataset moves forward.
+   Only eof(), next() and the field accessors can be used, num_rows() returns the
+   rows read so far. Backends without cursors read everything as query does */
+  virtual bool query_forward(const std::string &sql) { return query(sql); }
 /* Close SQL Query*/
   virtual void close();
 /* This function looks for field Field_name with value equal Field_value
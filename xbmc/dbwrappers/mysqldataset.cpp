@@ -12,6 +12,7 @@
 #include <algorithm>
 
 #include "utils/log.h"
+#include "utils/Metrics.h"
 #include "network/WakeOnAccess.h"
 #include "Util.h"
 #include "utils/StringUtils.h"
@@ -30,8 +31,21 @@
 #define MYSQL_OK          0
 #define ER_BAD_DB_ERROR   1049
 
+namespace
+{
+CMetrics::Histogram* QueryTime()
+{
+  static CMetrics::Histogram* histogram = CMetrics::RegisterHistogram(
+      "kodi_database_query_time", "Time to run a database statement, including reading the rows of a query");
+  return histogram;
+}
+}
+
 namespace dbiplus {
 
+// enough for the statements a scan runs over and over again
+static const size_t MAX_CACHED_STATEMENTS = 32;
+
 //************* MysqlDatabase implementation ***************
 
 MysqlDatabase::MysqlDatabase() {
@@ -258,6 +272,7 @@ int MysqlDatabase::connect(bool create_new) {
 }
 
 void MysqlDatabase::disconnect(void) {
+  close_statements();
   if (conn != NULL)
   {
     mysql_close(conn);
@@ -461,6 +476,48 @@ int MysqlDatabase::query_with_reconnect(const char* query) {
   return result;
 }
 
+MYSQL_STMT *MysqlDatabase::acquire_statement(const std::string &sql) {
+  for (auto it = statements.begin(); it != statements.end(); ++it)
+  {
+    if (it->first == sql)
+    {
+      MYSQL_STMT *stmt = it->second;
+      statements.erase(it);
+      return stmt;
+    }
+  }
+
+  if (!active)
+    return NULL;
+
+  MYSQL_STMT *stmt = mysql_stmt_init(conn);
+  if (!stmt)
+    return NULL;
+
+  if (mysql_stmt_prepare(stmt, sql.c_str(), sql.size()) != 0)
+  {
+    CLog::Log(LOGDEBUG, "MysqlDatabase::acquire_statement - unable to prepare '%s': %s", sql.c_str(), mysql_stmt_error(stmt));
+    mysql_stmt_close(stmt);
+    return NULL;
+  }
+  return stmt;
+}
+
+void MysqlDatabase::release_statement(const std::string &sql, MYSQL_STMT *stmt) {
+  statements.emplace_front(sql, stmt);
+  if (statements.size() > MAX_CACHED_STATEMENTS)
+  {
+    mysql_stmt_close(statements.back().second);
+    statements.pop_back();
+  }
+}
+
+void MysqlDatabase::close_statements() {
+  for (const auto &statement : statements)
+    mysql_stmt_close(statement.second);
+  statements.clear();
+}
+
 long MysqlDatabase::nextid(const char* sname) {
   CLog::Log(LOGDEBUG,"MysqlDatabase::nextid for %s",sname);
   if (!active) return DB_UNEXPECTED_RESULT;
@@ -1499,6 +1556,7 @@ static size_t ci_find(const std::string& where, const std::string& what)
 
 int MysqlDataset::exec(const std::string &sql) {
   if (!handle()) throw DbErrors("No Database Connection");
+  CMetrics::CScopedTimer timer(QueryTime());
   std::string qry = sql;
   int res = 0;
   exec_res.clear();
@@ -1539,6 +1597,88 @@ int MysqlDataset::exec(const std::string &sql) {
   }
 }
 
+int MysqlDataset::exec(const std::string &sql, const sql_params &params) {
+  if (!handle()) throw DbErrors("No Database Connection");
+  exec_res.clear();
+
+  // anything that isn't plain data manipulation needs the rewrites of the text path
+  MysqlDatabase *database = static_cast<MysqlDatabase*>(db);
+  MYSQL_STMT *stmt = NULL;
+  if (StringUtils::StartsWithNoCase(sql, "insert") || StringUtils::StartsWithNoCase(sql, "update") ||
+      StringUtils::StartsWithNoCase(sql, "delete") || StringUtils::StartsWithNoCase(sql, "replace"))
+    stmt = database->acquire_statement(sql);
+  if (!stmt)
+    return exec(db->bind(sql, params));
+
+  CMetrics::CScopedTimer timer(QueryTime());
+  if (mysql_stmt_param_count(stmt) != params.size())
+  {
+    database->release_statement(sql, stmt);
+    throw DbErrors("Wrong number of values for '%s'", sql.c_str());
+  }
+
+  // the binds point into these, so they have to stay around until the statement ran
+  std::vector<MYSQL_BIND> binds(params.size());
+  std::vector<long long> numbers(params.size());
+  std::vector<double> reals(params.size());
+  std::vector<std::string> strings(params.size());
+  std::vector<unsigned long> lengths(params.size());
+  for (size_t i = 0; i < params.size(); i++)
+  {
+    const field_value &value = params[i];
+    MYSQL_BIND &bind = binds[i];
+    if (value.get_isNull())
+    {
+      bind.buffer_type = MYSQL_TYPE_NULL;
+      continue;
+    }
+    switch (value.get_fType())
+    {
+    case ft_Boolean:
+    case ft_Short:
+    case ft_UShort:
+    case ft_Int:
+    case ft_UInt:
+    case ft_Int64:
+      numbers[i] = value.get_asInt64();
+      bind.buffer_type = MYSQL_TYPE_LONGLONG;
+      bind.buffer = &numbers[i];
+      break;
+    case ft_Float:
+    case ft_Double:
+    case ft_LongDouble:
+      reals[i] = value.get_asDouble();
+      bind.buffer_type = MYSQL_TYPE_DOUBLE;
+      bind.buffer = &reals[i];
+      break;
+    default:
+      strings[i] = value.get_asString();
+      lengths[i] = strings[i].size();
+      bind.buffer_type = MYSQL_TYPE_STRING;
+      bind.buffer = const_cast<char*>(strings[i].data());
+      bind.buffer_length = lengths[i];
+      bind.length = &lengths[i];
+      break;
+    }
+  }
+
+  if ((!binds.empty() && mysql_stmt_bind_param(stmt, binds.data()) != 0) || mysql_stmt_execute(stmt) != 0)
+  {
+    const int err = mysql_stmt_errno(stmt);
+    mysql_stmt_close(stmt);
+
+    // the text path takes care of reconnecting
+    if (err == CR_SERVER_GONE_ERROR || err == CR_SERVER_LOST)
+      return exec(db->bind(sql, params));
+
+    db->setErr(err, sql.c_str());
+    throw DbErrors(db->getErrorMsg());
+  }
+
+  database->release_statement(sql, stmt);
+  return MYSQL_OK;
+}
+
 int MysqlDataset::exec() {
    return exec(sql);
 }
@@ -1557,6 +1697,7 @@ bool MysqlDataset::query(const std::string &query) {
 
   close();
 
+  CMetrics::CScopedTimer timer(QueryTime());
   size_t loc;
 
   // mysql doesn't understand CAST(foo as integer) => change to CAST(foo as signed integer)
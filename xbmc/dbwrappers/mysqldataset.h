@@ -8,7 +8,9 @@
 
 #pragma once
 
+#include <list>
 #include <stdio.h>
+#include <utility>
 #include "dataset.h"
 #ifdef HAS_MYSQL
 #include <mysql/mysql.h>
@@ -78,7 +80,18 @@ public:
   int query_with_reconnect(const char* query);
   void configure_connection();
 
+/* prepared statements, cached per connection and keyed by their sql.
+   acquire_statement() hands out a statement for exclusive use, NULL if it can't
+   be prepared. release_statement() puts it back into the cache */
+  MYSQL_STMT *acquire_statement(const std::string &sql);
+  void release_statement(const std::string &sql, MYSQL_STMT *stmt);
+
 private:
+  void close_statements();
+
+/* most recently used first */
+  std::list<std::pair<std::string, MYSQL_STMT*> > statements;
+
 
   typedef struct StrAccum StrAccum;
 
@@ -138,9 +151,13 @@ or insert() operations default = false) */
 /* func. executes a query without results to return */
   int  exec () override;
   int  exec (const std::string &sql) override;
+  int  exec (const std::string &sql, const sql_params &params) override;
   const void* getExecRes() override;
 /* as open, but with our query exec Sql */
   bool query(const std::string &query) override;
+/* results of prepared statements would need to be bound column by column,
+   queries with values go through the text protocol */
+  using Dataset::query;
 /* func. closes a query */
   void close(void) override;
 /* Cancel changes, made in insert or edit states of dataset */
@@ -197,6 +197,7 @@ struct field {
 
 typedef std::vector<field> Fields;
 typedef std::vector<field_value> sql_record;
+typedef std::vector<field_value> sql_params; // values for the '?' placeholders of a statement
 typedef std::vector<field_prop> record_prop;
 typedef std::vector<sql_record*> query_data;
 typedef field_value variant;
@@ -17,6 +17,7 @@
 
 #include "sqlitedataset.h"
 #include "utils/log.h"
+#include "utils/Metrics.h"
 #include "utils/URIUtils.h"
 
 #ifdef TARGET_POSIX
@@ -156,6 +157,13 @@ const std::map<int, const char*> g_SqliteErrorStrings =
 #endif
 };
 #undef X
+
+CMetrics::Histogram* QueryTime()
+{
+  static CMetrics::Histogram* histogram = CMetrics::RegisterHistogram(
+      "kodi_database_query_time", "Time to run a database statement, including reading the rows of a query");
+  return histogram;
+}
 }
 
 namespace dbiplus {
@@ -203,6 +211,79 @@ static int busy_callback(void*, int busyCount)
   return 1;
 }
 
+// enough for the queries a database runs over and over again
+static const size_t MAX_CACHED_STATEMENTS = 32;
+
+static int bind_params(sqlite3_stmt *stmt, const sql_params &params)
+{
+  for (size_t i = 0; i < params.size(); i++)
+  {
+    const field_value &value = params[i];
+    const int index = static_cast<int>(i) + 1;
+    int rc;
+    if (value.get_isNull())
+      rc = sqlite3_bind_null(stmt, index);
+    else
+    {
+      switch (value.get_fType())
+      {
+      case ft_Boolean:
+      case ft_Short:
+      case ft_UShort:
+      case ft_Int:
+      case ft_UInt:
+      case ft_Int64:
+        rc = sqlite3_bind_int64(stmt, index, value.get_asInt64());
+        break;
+      case ft_Float:
+      case ft_Double:
+      case ft_LongDouble:
+        rc = sqlite3_bind_double(stmt, index, value.get_asDouble());
+        break;
+      default:
+      {
+        const std::string str = value.get_asString();
+        rc = sqlite3_bind_text(stmt, index, str.c_str(), str.size(), SQLITE_TRANSIENT);
+        break;
+      }
+      }
+    }
+    if (rc != SQLITE_OK)
+      return rc;
+  }
+  return SQLITE_OK;
+}
+
+static void read_row(sqlite3_stmt *stmt, sql_record &row)
+{
+  const unsigned int numColumns = sqlite3_column_count(stmt);
+  row.resize(numColumns);
+  for (unsigned int i = 0; i < numColumns; i++)
+  {
+    field_value &v = row.at(i);
+    switch (sqlite3_column_type(stmt, i))
+    {
+    case SQLITE_INTEGER:
+      v.set_asInt64(sqlite3_column_int64(stmt, i));
+      break;
+    case SQLITE_FLOAT:
+      v.set_asDouble(sqlite3_column_double(stmt, i));
+      break;
+    case SQLITE_TEXT:
+      v.set_asString((const char *)sqlite3_column_text(stmt, i));
+      break;
+    case SQLITE_BLOB:
+      v.set_asString((const char *)sqlite3_column_text(stmt, i));
+      break;
+    case SQLITE_NULL:
+    default:
+      v.set_asString("");
+      v.set_isNull();
+      break;
+    }
+  }
+}
+
 //************* SqliteDatabase implementation ***************
 
 SqliteDatabase::SqliteDatabase() {
@@ -352,10 +433,55 @@ bool SqliteDatabase::exists(void)
 
 void SqliteDatabase::disconnect(void) {
   if (active == false) return;
-  sqlite3_close(conn);
+  finalize_statements();
+  // statements still held by a dataset keep the connection around until they are finalized
+  sqlite3_close_v2(conn);
   active = false;
 }
 
+sqlite3_stmt *SqliteDatabase::acquire_statement(const std::string &sql) {
+  for (auto it = statements.begin(); it != statements.end(); ++it)
+  {
+    if (it->first == sql)
+    {
+      sqlite3_stmt *stmt = it->second;
+      statements.erase(it);
+      return stmt;
+    }
+  }
+
+  sqlite3_stmt *stmt = NULL;
+  if (setErr(sqlite3_prepare_v2(conn, sql.c_str(), -1, &stmt, NULL), sql.c_str()) != SQLITE_OK)
+    return NULL;
+  return stmt;
+}
+
+int SqliteDatabase::release_statement(sqlite3_stmt *stmt) {
+  const int rc = sqlite3_reset(stmt);
+  sqlite3_clear_bindings(stmt);
+
+  // statements of a previous connection or in a bad state aren't worth keeping
+  if (!active || rc != SQLITE_OK || sqlite3_db_handle(stmt) != conn)
+  {
+    sqlite3_finalize(stmt);
+    return rc;
+  }
+
+  statements.emplace_front(sqlite3_sql(stmt), stmt);
+  if (statements.size() > MAX_CACHED_STATEMENTS)
+  {
+    sqlite3_finalize(statements.back().second);
+    statements.pop_back();
+  }
+  return rc;
+}
+
+void SqliteDatabase::finalize_statements() {
+  for (const auto &statement : statements)
+    sqlite3_finalize(statement.second);
+  statements.clear();
+}
+
 int SqliteDatabase::create() {
   return connect(true);
 }
@@ -580,6 +706,9 @@ SqliteDataset::SqliteDataset():Dataset() {
   db = NULL;
   errmsg = NULL;
   autorefresh = false;
+  cursor = NULL;
+  forward_only = false;
+  rows_fetched = 0;
 }
 
 
@@ -588,9 +717,14 @@ SqliteDataset::SqliteDataset(SqliteDatabase *newDb):Dataset(newDb) {
   db = newDb;
   errmsg = NULL;
   autorefresh = false;
+  cursor = NULL;
+  forward_only = false;
+  rows_fetched = 0;
 }
 
  SqliteDataset::~SqliteDataset(){
+   // the database may be gone already, so don't hand the statement back
+   if (cursor) sqlite3_finalize(cursor);
    if (errmsg) sqlite3_free(errmsg);
  }
 
@@ -717,6 +851,7 @@ bool SqliteDataset::dropIndex(const char *table, const char *index)
 
 int SqliteDataset::exec(const std::string &sql) {
   if (!handle()) throw DbErrors("No Database Connection");
+  CMetrics::CScopedTimer timer(QueryTime());
   std::string qry = sql;
   int res;
   exec_res.clear();
@@ -770,6 +905,32 @@ int SqliteDataset::exec(const std::string &sql) {
     }
 }
 
+int SqliteDataset::exec(const std::string &sql, const sql_params &params) {
+  if (!handle()) throw DbErrors("No Database Connection");
+  CMetrics::CScopedTimer timer(QueryTime());
+  exec_res.clear();
+
+  SqliteDatabase *database = static_cast<SqliteDatabase*>(db);
+  sqlite3_stmt *stmt = database->acquire_statement(sql);
+  if (!stmt)
+    throw DbErrors("%s", db->getErrorMsg());
+
+  int rc = bind_params(stmt, params);
+  if (rc == SQLITE_OK)
+  {
+    while (sqlite3_step(stmt) == SQLITE_ROW)
+      ;
+    // reports the error of the last step, if any
+    rc = database->release_statement(stmt);
+  }
+  else
+    database->release_statement(stmt);
+
+  if (db->setErr(rc, sql.c_str()) != SQLITE_OK)
+    throw DbErrors("%s", db->getErrorMsg());
+  return rc;
+}
+
 int SqliteDataset::exec() {
   return exec(sql);
 }
@@ -780,6 +941,18 @@ const void* SqliteDataset::getExecRes() {
 
 
 bool SqliteDataset::query(const std::string &query) {
+  return run_query(query, sql_params(), false);
+}
+
+bool SqliteDataset::query(const std::string &query, const sql_params &params) {
+  return run_query(query, params, false);
+}
+
+bool SqliteDataset::query_forward(const std::string &query) {
+  return run_query(query, sql_params(), true);
+}
+
+bool SqliteDataset::run_query(const std::string &query, const sql_params &params, bool forward) {
     if(!handle()) throw DbErrors("No Database Connection");
     std::string qry = query;
     int fs = qry.find("select");
@@ -789,48 +962,46 @@ bool SqliteDataset::query(const std::string &query) {
 
   close();
 
-  sqlite3_stmt *stmt = NULL;
-  if (db->setErr(sqlite3_prepare_v2(handle(),query.c_str(),-1,&stmt, NULL),query.c_str()) != SQLITE_OK)
+  // forward queries are timed until their first row
+  CMetrics::CScopedTimer timer(QueryTime());
+  sqlite3_stmt *stmt = static_cast<SqliteDatabase*>(db)->acquire_statement(query);
+  if (!stmt)
     throw DbErrors("%s", db->getErrorMsg());
 
+  const int rc = bind_params(stmt, params);
+  if (rc != SQLITE_OK)
+  {
+    static_cast<SqliteDatabase*>(db)->release_statement(stmt);
+    db->setErr(rc, query.c_str());
+    throw DbErrors("%s", db->getErrorMsg());
+  }
+
   // column headers
   const unsigned int numColumns = sqlite3_column_count(stmt);
   result.record_header.resize(numColumns);
   for (unsigned int i = 0; i < numColumns; i++)
     result.record_header[i].name = sqlite3_column_name(stmt, i);
 
+  if (forward)
+  {
+    // rows are read as the dataset moves, the statement stays with us until then
+    cursor = stmt;
+    forward_only = true;
+    active = true;
+    ds_state = dsSelect;
+    fbof = true;
+    fetch_row();
+    return true;
+  }
+
   // returned rows
   while (sqlite3_step(stmt) == SQLITE_ROW)
   { // have a row of data
     sql_record *res = new sql_record;
-    res->resize(numColumns);
-    for (unsigned int i = 0; i < numColumns; i++)
-    {
-      field_value &v = res->at(i);
-      switch (sqlite3_column_type(stmt, i))
-      {
-      case SQLITE_INTEGER:
-        v.set_asInt64(sqlite3_column_int64(stmt, i));
-        break;
-      case SQLITE_FLOAT:
-        v.set_asDouble(sqlite3_column_double(stmt, i));
-        break;
-      case SQLITE_TEXT:
-        v.set_asString((const char *)sqlite3_column_text(stmt, i));
-        break;
-      case SQLITE_BLOB:
-        v.set_asString((const char *)sqlite3_column_text(stmt, i));
-        break;
-      case SQLITE_NULL:
-      default:
-        v.set_asString("");
-        v.set_isNull();
-        break;
-      }
-    }
+    read_row(stmt, *res);
     result.records.push_back(res);
   }
-  if (db->setErr(sqlite3_finalize(stmt),query.c_str()) == SQLITE_OK)
+  if (db->setErr(static_cast<SqliteDatabase*>(db)->release_statement(stmt),query.c_str()) == SQLITE_OK)
   {
     active = true;
     ds_state = dsSelect;
@@ -843,6 +1014,36 @@ bool SqliteDataset::query(const std::string &query) {
   }
 }
 
+void SqliteDataset::fetch_row() {
+  if (!cursor)
+  {
+    feof = true;
+    return;
+  }
+
+  if (sqlite3_step(cursor) == SQLITE_ROW)
+  {
+    // the single record is reused for every row
+    if (result.records.empty())
+      result.records.push_back(NULL);
+    if (!result.records[0])
+      result.records[0] = new sql_record;
+    read_row(cursor, *result.records[0]);
+    rows_fetched++;
+    frecno = 0;
+    feof = false;
+    fill_fields();
+    return;
+  }
+
+  feof = true;
+  const std::string sql = sqlite3_sql(cursor);
+  sqlite3_stmt *stmt = cursor;
+  cursor = NULL;
+  if (db->setErr(static_cast<SqliteDatabase*>(db)->release_statement(stmt), sql.c_str()) != SQLITE_OK)
+    throw DbErrors("%s", db->getErrorMsg());
+}
+
 void SqliteDataset::open(const std::string &sql) {
   set_select_sql(sql);
   open();
@@ -859,6 +1060,13 @@ void SqliteDataset::open() {
 
 
 void SqliteDataset::close() {
+  if (cursor)
+  {
+    static_cast<SqliteDatabase*>(db)->release_statement(cursor);
+    cursor = NULL;
+  }
+  forward_only = false;
+  rows_fetched = 0;
   Dataset::close();
   result.clear();
   edit_object->clear();
@@ -879,6 +1087,8 @@ void SqliteDataset::cancel() {
 
 
 int SqliteDataset::num_rows() {
+  if (forward_only)
+    return rows_fetched;
   return result.records.size();
 }
 
@@ -894,21 +1104,34 @@ bool SqliteDataset::bof() {
 
 
 void SqliteDataset::first() {
+  // a cursor can't go back, it already sits on the first row after the query
+  if (forward_only)
+    return;
   Dataset::first();
   this->fill_fields();
 }
 
 void SqliteDataset::last() {
+  if (forward_only)
+    throw DbErrors("last() is not supported by forward only queries");
   Dataset::last();
   fill_fields();
 }
 
 void SqliteDataset::prev(void) {
+  if (forward_only)
+    throw DbErrors("prev() is not supported by forward only queries");
   Dataset::prev();
   fill_fields();
 }
 
 void SqliteDataset::next(void) {
+  if (forward_only)
+  {
+    fbof = false;
+    fetch_row();
+    return;
+  }
   Dataset::next();
   if (!eof())
       fill_fields();
@@ -928,6 +1151,8 @@ void SqliteDataset::free_row(void)
 }
 
 bool SqliteDataset::seek(int pos) {
+  if (forward_only)
+    return false;
   if (ds_state == dsSelect) {
     Dataset::seek(pos);
     fill_fields();
@@ -14,7 +14,9 @@
 
 #include "dataset.h"
 
+#include <list>
 #include <stdio.h>
+#include <utility>
 
 #include <sqlite3.h>
 
@@ -82,6 +84,18 @@ public:
 
   bool in_transaction() override {return _in_transaction;};
 
+/* prepared statements, cached per connection and keyed by their sql.
+   acquire_statement() hands out a statement for exclusive use, NULL on error.
+   release_statement() resets it and puts it back into the cache, returns the
+   result of the last step as sqlite3_reset() reports it */
+  sqlite3_stmt *acquire_statement(const std::string &sql);
+  int release_statement(sqlite3_stmt *stmt);
+
+private:
+  void finalize_statements();
+
+/* most recently used first */
+  std::list<std::pair<std::string, sqlite3_stmt*> > statements;
 };
 
 
@@ -113,6 +127,16 @@ protected:
 /* Changing field values during dataset navigation */
   virtual void free_row();  // free the memory allocated for the current row
 
+/* runs a select, either reading all rows or keeping the statement as a cursor */
+  bool run_query(const std::string &query, const sql_params &params, bool forward);
+/* steps the cursor and reads the next row into the single record */
+  void fetch_row();
+
+/* statement of a forward only query, NULL once all rows are read */
+  sqlite3_stmt *cursor;
+  bool forward_only;
+  int rows_fetched;
+
 public:
 /* constructor */
   SqliteDataset();
@@ -131,9 +155,12 @@ or insert() operations default = false) */
 /* func. executes a query without results to return */
   int  exec () override;
   int  exec (const std::string &sql) override;
+  int  exec (const std::string &sql, const sql_params &params) override;
   const void* getExecRes() override;
 /* as open, but with our query exec Sql */
   bool query(const std::string &query) override;
+  bool query(const std::string &query, const sql_params &params) override;
+  bool query_forward(const std::string &query) override;
 /* func. closes a query */
   void close(void) override;
 /* Cancel changes, made in insert or edit states of dataset */
@@ -18,11 +18,14 @@
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/log.h"
+#include "video/VideoDatabase.h"
 #include "video/VideoInfoTag.h"
 
+#include <algorithm>
 #include <array>
 #include <cassert>
 #include <climits>
+#include <inttypes.h>
 #include <stdlib.h>
 #include <string>
 
@@ -36,6 +39,42 @@ namespace XFILE
 
 #define MAIN_TITLE_LENGTH_PERCENT 70 /** Minimum length of main titles, based on longest title */
 
+namespace
+{
+
+CBlurayDirectory::SBlurayTitle ToBlurayTitle(const BLURAY_TITLE_INFO* info)
+{
+  CBlurayDirectory::SBlurayTitle title;
+  title.playlist = info->playlist;
+  title.duration = info->duration;
+  title.chapters = info->chapter_count;
+  for (unsigned int i = 0; i < info->clip_count; ++i)
+    title.size += info->clips[i].pkt_count * 192;
+  return title;
+}
+
+std::string GetDiscId(BLURAY* bd, const std::string& root)
+{
+  const BLURAY_DISC_INFO* disc_info = bd_get_disc_info(bd);
+  if (!disc_info || !disc_info->bluray_detected)
+    return "";
+
+  // discs without AACS have no disc id, they are known by the path they are opened from
+  for (uint8_t b : disc_info->disc_id)
+  {
+    if (b != 0)
+    {
+      std::string id;
+      for (uint8_t c : disc_info->disc_id)
+        id += StringUtils::Format("%02x", c);
+      return id;
+    }
+  }
+  return root;
+}
+
+} // unnamed namespace
+
 CBlurayDirectory::~CBlurayDirectory()
 {
   Dispose();
@@ -109,34 +148,32 @@ std::string CBlurayDirectory::GetDiscInfoString(DiscInfo info)
   return "";
 }
 
-CFileItemPtr CBlurayDirectory::GetTitle(const BLURAY_TITLE_INFO* title, const std::string& label)
+CFileItemPtr CBlurayDirectory::GetTitle(const SBlurayTitle& title, const std::string& label)
 {
   std::string buf;
   std::string chap;
   CFileItemPtr item(new CFileItem("", false));
   CURL path(m_url);
-  buf = StringUtils::Format("BDMV/PLAYLIST/%05d.mpls", title->playlist);
+  buf = StringUtils::Format("BDMV/PLAYLIST/%05d.mpls", title.playlist);
   path.SetFileName(buf);
   item->SetPath(path.Get());
-  int duration = (int)(title->duration / 90000);
+  int duration = (int)(title.duration / 90000);
   item->GetVideoInfoTag()->SetDuration(duration);
-  item->GetVideoInfoTag()->m_iTrack = title->playlist;
-  buf = StringUtils::Format(label.c_str(), title->playlist);
+  item->GetVideoInfoTag()->m_iTrack = title.playlist;
+  buf = StringUtils::Format(label.c_str(), title.playlist);
   item->m_strTitle = buf;
   item->SetLabel(buf);
-  chap = StringUtils::Format(g_localizeStrings.Get(25007).c_str(), title->chapter_count, StringUtils::SecondsToTimeString(duration).c_str());
+  chap = StringUtils::Format(g_localizeStrings.Get(25007).c_str(), title.chapters, StringUtils::SecondsToTimeString(duration).c_str());
   item->SetLabel2(chap);
-  item->m_dwSize = 0;
+  item->m_dwSize = title.size;
   item->SetArt("icon", "DefaultVideo.png");
-  for(unsigned int i = 0; i < title->clip_count; ++i)
-    item->m_dwSize += title->clips[i].pkt_count * 192;
 
   return item;
 }
 
 void CBlurayDirectory::GetTitles(bool main, CFileItemList &items)
 {
-  std::vector<BLURAY_TITLE_INFO*> titleList;
+  std::vector<SBlurayTitle> titleList;
   uint64_t minDuration = 0;
 
   // Searching for a user provided list of playlists.
@@ -145,37 +182,75 @@ void CBlurayDirectory::GetTitles(bool main, CFileItemList &items)
 
   if (!main || titleList.empty())
   {
-    uint32_t numTitles = bd_get_titles(m_bd, TITLES_RELEVANT, 0);
+    GetRelevantTitles(m_bd, m_url.GetHostName(), titleList);
 
-    for (uint32_t i = 0; i < numTitles; i++)
+    if (main)
     {
-      BLURAY_TITLE_INFO* t = bd_get_title_info(m_bd, i, 0);
-
-      if (!t)
-      {
-        CLog::Log(LOGDEBUG, "CBlurayDirectory - unable to get title %d", i);
-        continue;
-      }
-
-      if (main && t->duration > minDuration)
-          minDuration = t->duration;
-
-      titleList.emplace_back(t);
+      for (const auto& title : titleList)
+        minDuration = std::max(minDuration, title.duration);
     }
   }
 
   minDuration = minDuration * MAIN_TITLE_LENGTH_PERCENT / 100;
 
-  for (auto& title : titleList)
+  for (const auto& title : titleList)
   {
-    if (title->duration < minDuration)
+    if (title.duration < minDuration)
       continue;
 
     items.Add(GetTitle(title, main ? g_localizeStrings.Get(25004) /* Main Title */ : g_localizeStrings.Get(25005) /* Title */));
-    bd_free_title_info(title);
   }
 }
 
+void CBlurayDirectory::GetRelevantTitles(BLURAY* bd, const std::string& root, std::vector<SBlurayTitle>& titles)
+{
+  const std::string discId = GetDiscId(bd, root);
+
+  CVideoDatabase db;
+  const bool dbOpen = !discId.empty() && db.Open();
+
+  // playlist,duration,chapters,size;...
+  std::string serialized;
+  if (dbOpen && db.GetBlurayTitles(discId, serialized))
+  {
+    for (const auto& entry : StringUtils::Split(serialized, ";"))
+    {
+      std::vector<std::string> fields = StringUtils::Split(entry, ",");
+      if (fields.size() != 4)
+        continue;
+
+      SBlurayTitle title;
+      title.playlist = strtoul(fields[0].c_str(), nullptr, 10);
+      title.duration = strtoull(fields[1].c_str(), nullptr, 10);
+      title.chapters = strtoul(fields[2].c_str(), nullptr, 10);
+      title.size = strtoull(fields[3].c_str(), nullptr, 10);
+      titles.push_back(title);
+    }
+    return;
+  }
+
+  const uint32_t numTitles = bd_get_titles(bd, TITLES_RELEVANT, 0);
+  std::vector<std::string> entries;
+  for (uint32_t i = 0; i < numTitles; i++)
+  {
+    BLURAY_TITLE_INFO* t = bd_get_title_info(bd, i, 0);
+    if (!t)
+    {
+      CLog::Log(LOGDEBUG, "CBlurayDirectory - unable to get title %d", i);
+      continue;
+    }
+
+    const SBlurayTitle title = ToBlurayTitle(t);
+    bd_free_title_info(t);
+
+    titles.push_back(title);
+    entries.push_back(StringUtils::Format("%u,%" PRIu64",%u,%" PRIu64, title.playlist, title.duration, title.chapters, title.size));
+  }
+
+  if (dbOpen && !entries.empty())
+    db.SetBlurayTitles(discId, StringUtils::Join(entries, ";"));
+}
+
 void CBlurayDirectory::GetRoot(CFileItemList &items)
 {
     GetTitles(true, items);
@@ -285,11 +360,11 @@ std::string CBlurayDirectory::HexToString(const uint8_t *buf, int count)
   return std::string(std::begin(tmp), std::end(tmp));
 }
 
-std::vector<BLURAY_TITLE_INFO*> CBlurayDirectory::GetUserPlaylists()
+std::vector<CBlurayDirectory::SBlurayTitle> CBlurayDirectory::GetUserPlaylists()
 {
   std::string root = m_url.GetHostName();
   std::string discInfPath = URIUtils::AddFileToFolder(root, "disc.inf");
-  std::vector<BLURAY_TITLE_INFO*> userTitles;
+  std::vector<SBlurayTitle> userTitles;
   CFile file;
   char buffer[1025];
 
@@ -322,7 +397,10 @@ std::vector<BLURAY_TITLE_INFO*> CBlurayDirectory::GetUserPlaylists()
 
             BLURAY_TITLE_INFO* t = bd_get_playlist_info(m_bd, static_cast<uint32_t>(plNum), 0);
             if (t)
-              userTitles.emplace_back(t);
+            {
+              userTitles.emplace_back(ToBlurayTitle(t));
+              bd_free_title_info(t);
+            }
           }
 
           if (static_cast<int64_t>(pos) + static_cast<int64_t>(len) > INT_MAX)
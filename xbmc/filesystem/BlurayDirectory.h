@@ -12,6 +12,10 @@
 #include "FileItem.h"
 #include "URL.h"
 
+#include <stdint.h>
+#include <string>
+#include <vector>
+
 typedef struct bluray BLURAY;
 typedef struct bd_title_info BLURAY_TITLE_INFO;
 
@@ -29,6 +33,29 @@ public:
   std::string GetBlurayTitle();
   std::string GetBlurayID();
 
+  /*!
+   \brief A playlist libbluray considers a relevant title of the disc
+   */
+  struct SBlurayTitle
+  {
+    uint32_t playlist = 0;
+    uint64_t duration = 0; ///< in 90 kHz ticks
+    uint32_t chapters = 0;
+    uint64_t size = 0;
+  };
+
+  /*!
+   \brief Get the relevant titles of an opened disc, in the order of libbluray
+
+   Finding them makes libbluray parse every playlist of the disc, which takes
+   seconds for some UHD discs. The titles are kept in the video database per
+   disc, so only the first opening of a disc pays for it.
+   \param bd the opened disc
+   \param root the path the disc was opened from, it identifies discs without AACS
+   \param titles [out] the titles
+   */
+  static void GetRelevantTitles(BLURAY* bd, const std::string& root, std::vector<SBlurayTitle>& titles);
+
 private:
   enum class DiscInfo
   {
@@ -40,8 +67,8 @@ private:
   std::string  GetDiscInfoString(DiscInfo info);
   void         GetRoot  (CFileItemList &items);
   void         GetTitles(bool main, CFileItemList &items);
-  std::vector<BLURAY_TITLE_INFO*> GetUserPlaylists();
-  CFileItemPtr GetTitle(const BLURAY_TITLE_INFO* title, const std::string& label);
+  std::vector<SBlurayTitle> GetUserPlaylists();
+  CFileItemPtr GetTitle(const SBlurayTitle& title, const std::string& label);
   CURL         GetUnderlyingCURL(const CURL& url);
   std::string  HexToString(const uint8_t * buf, int count);
   CURL          m_url;
@@ -16,7 +16,10 @@
 
 using namespace XFILE;
 
-CCircularCache::CCircularCache(size_t front, size_t back)
+// windows smaller than this are not worth retaining
+#define MIN_RETAIN_SIZE (256 * 1024)
+
+CCircularCache::CCircularCache(size_t front, size_t back, size_t retain)
  : CCacheStrategy()
  , m_beg(0)
  , m_end(0)
@@ -24,6 +27,8 @@ CCircularCache::CCircularCache(size_t front, size_t back)
  , m_buf(NULL)
  , m_size(front + back)
  , m_size_back(back)
+ , m_size_retain(retain)
+ , m_retainedBytes(0)
 #ifdef TARGET_WINDOWS
  , m_handle(NULL)
 #endif
@@ -50,11 +55,16 @@ int CCircularCache::Open()
   m_beg = 0;
   m_end = 0;
   m_cur = 0;
+  if (m_size_retain > 0)
+    CMemoryPressureManager::GetInstance().Register(this, "file cache", CMemoryPressureManager::PRIORITY_CACHE);
   return CACHE_RC_OK;
 }
 
 void CCircularCache::Close()
 {
+  // waits for a running OnMemoryPressure()
+  CMemoryPressureManager::GetInstance().Unregister(this);
+
 #ifdef TARGET_WINDOWS
   if (m_buf != NULL)
     UnmapViewOfFile(m_buf);
@@ -65,6 +75,8 @@ void CCircularCache::Close()
   delete[] m_buf;
 #endif
   m_buf = NULL;
+  m_retained.clear();
+  m_retainedBytes = 0;
 }
 
 size_t CCircularCache::GetMaxWriteSize(const size_t& iRequestSize)
@@ -226,17 +238,45 @@ int64_t CCircularCache::Seek(int64_t pos)
     return pos;
   }
 
+  // NOTE: a retained range is swapped in by Reset(), once the source has been repositioned
   return CACHE_RC_ERROR;
 }
 
 bool CCircularCache::Reset(int64_t pos, bool clearAnyway)
 {
   CSingleLock lock(m_sync);
-  if (!clearAnyway && IsCachedPosition(pos))
+  if (!clearAnyway && pos >= m_beg && pos <= m_end)
   {
     m_cur = pos;
     return false;
   }
+
+  if (!clearAnyway)
+  {
+    // take the range out first so that retaining the current window can't evict it
+    std::list<RetainedRange> target;
+    auto it = FindRetained(pos);
+    if (it != m_retained.end())
+    {
+      m_retainedBytes -= it->data.size();
+      target.splice(target.begin(), m_retained, it);
+    }
+
+    RetainWindow();
+
+    if (!target.empty())
+    {
+      RestoreRange(target.front());
+      m_cur = pos;
+      return false;
+    }
+  }
+  else
+  {
+    m_retained.clear();
+    m_retainedBytes = 0;
+  }
+
   m_end = pos;
   m_beg = pos;
   m_cur = pos;
@@ -246,8 +286,14 @@ bool CCircularCache::Reset(int64_t pos, bool clearAnyway)
 
 int64_t CCircularCache::CachedDataEndPosIfSeekTo(int64_t iFilePosition)
 {
-  if (IsCachedPosition(iFilePosition))
+  CSingleLock lock(m_sync);
+  if (iFilePosition >= m_beg && iFilePosition <= m_end)
     return m_end;
+
+  auto it = FindRetained(iFilePosition);
+  if (it != m_retained.end())
+    return it->End();
+
   return iFilePosition;
 }
 
@@ -263,6 +309,89 @@ bool CCircularCache::IsCachedPosition(int64_t iFilePosition)
 
 CCacheStrategy *CCircularCache::CreateNew()
 {
-  return new CCircularCache(m_size - m_size_back, m_size_back);
+  return new CCircularCache(m_size - m_size_back, m_size_back, m_size_retain);
+}
+
+void CCircularCache::OnMemoryPressure(MemoryPressure level)
+{
+  CSingleLock lock(m_sync);
+  m_retained.clear();
+  m_retainedBytes = 0;
+}
+
+/**
+ * Copies the current window out of the ring buffer so that a later
+ * seek into it can be served from memory. The least recently used
+ * ranges are dropped when the retain budget is exceeded.
+ */
+void CCircularCache::RetainWindow()
+{
+  const size_t len = (size_t)(m_end - m_beg);
+  if (m_buf == NULL || m_size_retain == 0 || len < MIN_RETAIN_SIZE)
+    return;
+
+  // ranges covered by the window are superseded by it
+  for (auto it = m_retained.begin(); it != m_retained.end();)
+  {
+    if (it->start >= m_beg && it->End() <= m_end)
+    {
+      m_retainedBytes -= it->data.size();
+      it = m_retained.erase(it);
+    }
+    else
+      ++it;
+  }
+
+  // keep the most recent part of the window if it exceeds the budget on its own
+  const size_t keep = std::min(len, m_size_retain);
+  while (!m_retained.empty() && m_retainedBytes + keep > m_size_retain)
+  {
+    m_retainedBytes -= m_retained.back().data.size();
+    m_retained.pop_back();
+  }
+
+  RetainedRange range;
+  range.start = m_end - keep;
+  range.data.resize(keep);
+
+  size_t pos = range.start % m_size;
+  size_t first = std::min(keep, m_size - pos);
+  memcpy(range.data.data(), m_buf + pos, first);
+  if (first < keep)
+    memcpy(range.data.data() + first, m_buf, keep - first);
+
+  m_retainedBytes += keep;
+  m_retained.push_front(std::move(range));
+}
+
+/**
+ * Makes a retained range the current window. The caller has to retain
+ * the current window first if it wants to keep it.
+ */
+void CCircularCache::RestoreRange(const RetainedRange& range)
+{
+  // a range never exceeds the ring, it was copied out of it
+  const size_t len = range.data.size();
+  size_t pos = range.start % m_size;
+  size_t first = std::min(len, m_size - pos);
+  memcpy(m_buf + pos, range.data.data(), first);
+  if (first < len)
+    memcpy(m_buf, range.data.data() + first, len - first);
+
+  m_beg = range.start;
+  m_end = range.End();
+  m_cur = m_beg;
+
+  m_written.Set();
+}
+
+std::list<CCircularCache::RetainedRange>::iterator CCircularCache::FindRetained(int64_t iFilePosition)
+{
+  for (auto it = m_retained.begin(); it != m_retained.end(); ++it)
+  {
+    if (iFilePosition >= it->start && iFilePosition < it->End())
+      return it;
+  }
+  return m_retained.end();
 }
 
@@ -11,13 +11,20 @@
 #include "CacheStrategy.h"
 #include "threads/CriticalSection.h"
 #include "threads/Event.h"
+#include "utils/MemoryPressure.h"
+
+#include <list>
+#include <vector>
 
 namespace XFILE {
 
-class CCircularCache : public CCacheStrategy
+class CCircularCache : public CCacheStrategy, public IMemoryPressureHandler
 {
 public:
-    CCircularCache(size_t front, size_t back);
+    /*!
+     * \param retain bytes that may be kept in ranges retained from earlier windows, 0 disables
+     */
+    CCircularCache(size_t front, size_t back, size_t retain = 0);
     ~CCircularCache() override;
 
     int Open() override;
@@ -36,7 +43,23 @@ public:
     bool IsCachedPosition(int64_t iFilePosition) override;
 
     CCacheStrategy *CreateNew() override;
+
+    /*!
+     * \brief Drop the retained ranges, the window being played from is kept
+     */
+    void OnMemoryPressure(MemoryPressure level) override;
 protected:
+    struct RetainedRange
+    {
+      int64_t start;
+      std::vector<uint8_t> data;
+      int64_t End() const { return start + static_cast<int64_t>(data.size()); }
+    };
+
+    void RetainWindow();
+    void RestoreRange(const RetainedRange& range);
+    std::list<RetainedRange>::iterator FindRetained(int64_t iFilePosition);
+
     int64_t           m_beg;       /**< index in file (not buffer) of beginning of valid data */
     int64_t           m_end;       /**< index in file (not buffer) of end of valid data */
     int64_t           m_cur;       /**< current reading index in file */
@@ -45,6 +68,9 @@ protected:
     size_t            m_size_back; /**< guaranteed size of back buffer (actual size can be smaller, or larger if front buffer doesn't need it) */
     CCriticalSection  m_sync;
     CEvent            m_written;
+    size_t            m_size_retain; /**< maximum bytes held in m_retained */
+    size_t            m_retainedBytes;
+    std::list<RetainedRange> m_retained; /**< earlier windows, most recently used first */
 #ifdef TARGET_WINDOWS
     HANDLE            m_handle;
 #endif
@@ -10,6 +10,7 @@
 #include "ServiceBroker.h"
 #include "Util.h"
 #include "URL.h"
+#include "network/DNSNameCache.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
@@ -30,6 +31,7 @@
 #include "platform/posix/ConvUtils.h"
 #endif
 
+#include "CurlReactor.h"
 #include "DllLibCurl.h"
 #include "ShoutcastFile.h"
 #include "utils/CharsetConverter.h"
@@ -100,6 +102,17 @@ extern "C" size_t write_callback(char *buffer,
   return state->WriteCallback(buffer, size, nitems);
 }
 
+/* used by async requests, they collect the whole response */
+extern "C" size_t async_write_callback(char *buffer,
+               size_t size,
+               size_t nitems,
+               void *userp)
+{
+  std::string *data = static_cast<std::string*>(userp);
+  data->append(buffer, size * nitems);
+  return size * nitems;
+}
+
 extern "C" size_t read_callback(char *buffer,
                size_t size,
                size_t nitems,
@@ -255,6 +268,7 @@ CCurlFile::CReadState::CReadState()
   m_bRetry = true;
   m_curlHeaderList = NULL;
   m_curlAliasList = NULL;
+  m_curlResolveList = NULL;
 }
 
 CCurlFile::CReadState::~CReadState()
@@ -388,6 +402,10 @@ void CCurlFile::CReadState::Disconnect()
   if( m_curlAliasList )
     g_curlInterface.slist_free_all(m_curlAliasList);
   m_curlAliasList = NULL;
+
+  if( m_curlResolveList )
+    g_curlInterface.slist_free_all(m_curlResolveList);
+  m_curlResolveList = NULL;
 }
 
 
@@ -460,6 +478,9 @@ void CCurlFile::SetCommonOptions(CReadState* state, bool failOnError /* = true *
 
   g_curlInterface.easy_setopt(h, CURLOPT_DEBUGFUNCTION, debug_callback);
 
+  // reuse dns entries and TLS sessions of other handles, easy_reset() keeps the share
+  g_curlInterface.easy_setopt(h, CURLOPT_SHARE, g_curlInterface.GetShare());
+
   if( CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_logLevel >= LOG_LEVEL_DEBUG )
     g_curlInterface.easy_setopt(h, CURLOPT_VERBOSE, CURL_ON);
   else
@@ -521,8 +542,29 @@ void CCurlFile::SetCommonOptions(CReadState* state, bool failOnError /* = true *
   if (!m_verifyPeer)
     g_curlInterface.easy_setopt(h, CURLOPT_SSL_VERIFYPEER, 0);
 
-  g_curlInterface.easy_setopt(m_state->m_easyHandle, CURLOPT_URL, m_url.c_str());
-  g_curlInterface.easy_setopt(m_state->m_easyHandle, CURLOPT_TRANSFERTEXT, CURL_OFF);
+  g_curlInterface.easy_setopt(h, CURLOPT_URL, m_url.c_str());
+  g_curlInterface.easy_setopt(h, CURLOPT_TRANSFERTEXT, CURL_OFF);
+
+  // hosts of advancedsettings.xml and names resolved by kodi already
+  if (state->m_curlResolveList)
+  {
+    g_curlInterface.slist_free_all(state->m_curlResolveList);
+    state->m_curlResolveList = NULL;
+  }
+  CURL url(m_url);
+  std::string ipAddress;
+  if (CDNSNameCache::GetCached(url.GetHostName(), ipAddress))
+  {
+    int port = url.GetPort();
+    if (!url.HasPort())
+      port = url.IsProtocol("https") ? 443 : url.IsProtocol("http") ? 80 : 0;
+    if (port > 0)
+    {
+      const std::string resolve = StringUtils::Format("%s:%d:%s", url.GetHostName().c_str(), port, ipAddress.c_str());
+      state->m_curlResolveList = g_curlInterface.slist_append(state->m_curlResolveList, resolve.c_str());
+    }
+  }
+  g_curlInterface.easy_setopt(h, CURLOPT_RESOLVE, state->m_curlResolveList);
 
   // setup POST data if it is set (and it may be empty)
   if (m_postdataset)
@@ -630,6 +672,8 @@ void CCurlFile::SetCommonOptions(CReadState* state, bool failOnError /* = true *
 
   // enable HTTP2 support. default: CURL_HTTP_VERSION_1_1. Curl >= 7.62.0 defaults to CURL_HTTP_VERSION_2TLS
   g_curlInterface.easy_setopt(h, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2_0);
+  // wait for a connection being set up to the same server to multiplex on it instead of opening another one
+  g_curlInterface.easy_setopt(h, CURLOPT_PIPEWAIT, CURL_ON);
 
 }
 
@@ -936,6 +980,65 @@ bool CCurlFile::Download(const std::string& strURL, const std::string& strFileNa
   return written == static_cast<ssize_t>(strData.size());
 }
 
+namespace
+{
+class CAsyncRequest : public CCurlReactor::ITransfer
+{
+public:
+  CAsyncRequest(CCurlFile::CReadState* state, CCurlFile::AsyncCallback callback)
+    : m_state(state), m_callback(std::move(callback))
+  {
+    g_curlInterface.easy_setopt(m_state->m_easyHandle, CURLOPT_WRITEDATA, &m_data);
+    g_curlInterface.easy_setopt(m_state->m_easyHandle, CURLOPT_WRITEFUNCTION, async_write_callback);
+  }
+
+  ~CAsyncRequest() override { delete m_state; }
+
+  CURL_HANDLE* GetHandle() const override { return m_state->m_easyHandle; }
+
+  void OnDone(int result) override
+  {
+    long response = -1;
+    g_curlInterface.easy_getinfo(m_state->m_easyHandle, CURLINFO_RESPONSE_CODE, &response);
+    if (result != CURLE_OK)
+      CLog::Log(LOGERROR, "CCurlFile::GetAsync - request failed with code %li: %s", response,
+                g_curlInterface.easy_strerror(static_cast<CURLcode>(result)));
+    m_callback(result == CURLE_OK, response, m_data);
+  }
+
+private:
+  CCurlFile::CReadState* m_state;
+  CCurlFile::AsyncCallback m_callback;
+  std::string m_data;
+};
+} // namespace
+
+unsigned int CCurlFile::GetAsync(const std::string& strURL, AsyncCallback callback)
+{
+  m_postdata = "";
+  m_postdataset = false;
+
+  CURL url(strURL);
+  ParseAndCorrectUrl(url);
+
+  CLog::Log(LOGDEBUG, "CCurlFile::GetAsync - %s", CURL::GetRedacted(m_url).c_str());
+
+  // the request gets its own state, this object stays usable
+  CReadState* state = new CReadState();
+  g_curlInterface.easy_acquire(url.GetProtocol().c_str(), url.GetHostName().c_str(),
+                               &state->m_easyHandle, NULL);
+  SetCommonOptions(state);
+  SetRequestHeaders(state);
+
+  std::unique_ptr<CAsyncRequest> request(new CAsyncRequest(state, std::move(callback)));
+  return CCurlReactor::GetInstance().Add(std::move(request));
+}
+
+void CCurlFile::CancelAsync(unsigned int id)
+{
+  CCurlReactor::GetInstance().Cancel(id);
+}
+
 // Detect whether we are "online" or not! Very simple and dirty!
 bool CCurlFile::IsInternet()
 {
@@ -1027,6 +1130,8 @@ bool CCurlFile::Open(const CURL& url)
     return false;
   }
 
+  CDNSNameCache::SetAlive(url2.GetHostName());
+
   SetCorrectHeaders(m_state);
 
   // since we can't know the stream size up front if we're gzipped/deflated
@@ -12,6 +12,7 @@
 #include "utils/HttpHeader.h"
 #include "utils/RingBuffer.h"
 
+#include <functional>
 #include <map>
 #include <string>
 
@@ -57,6 +58,19 @@ namespace XFILE
       bool Get(const std::string& strURL, std::string& strHTML);
       bool ReadData(std::string& strHTML);
       bool Download(const std::string& strURL, const std::string& strFileName, unsigned int* pdwSize = NULL);
+
+      typedef std::function<void(bool success, long response, const std::string& data)> AsyncCallback;
+      /*!
+       \brief Get a url without blocking the calling thread.
+       The request is made with the options set on this object, which can be
+       reused or destroyed once this returns. The callback is called once the
+       transfer is done, on the curl reactor thread that serves all async
+       requests, so it should hand off anything lengthy, e.g. to the job manager.
+       \return an id for CancelAsync(), 0 on failure
+       */
+      unsigned int GetAsync(const std::string& strURL, AsyncCallback callback);
+      /*! \brief Cancel a request of GetAsync(), its callback won't be called anymore */
+      static void CancelAsync(unsigned int id);
       bool IsInternet();
       void Cancel();
       void Reset();
@@ -121,6 +135,7 @@ namespace XFILE
 
           curl_slist* m_curlHeaderList;
           curl_slist* m_curlAliasList;
+          curl_slist* m_curlResolveList;
 
           size_t ReadCallback(char *buffer, size_t size, size_t nitems);
           size_t WriteCallback(char *buffer, size_t size, size_t nitems);
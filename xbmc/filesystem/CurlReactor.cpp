@@ -0,0 +1,155 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "CurlReactor.h"
+
+#include "DllLibCurl.h"
+#include "threads/SingleLock.h"
+#include "utils/log.h"
+
+#include <algorithm>
+
+using namespace XFILE;
+using namespace XCURL;
+
+// new and cancelled transfers don't interrupt curl's wait, so it's kept short
+#define REACTOR_WAIT_MS 50
+
+CCurlReactor& CCurlReactor::GetInstance()
+{
+  static CCurlReactor reactor;
+  return reactor;
+}
+
+CCurlReactor::CCurlReactor() : CThread("CurlReactor")
+{
+}
+
+CCurlReactor::~CCurlReactor()
+{
+  StopThread();
+}
+
+unsigned int CCurlReactor::Add(std::unique_ptr<ITransfer> transfer)
+{
+  if (!transfer || !transfer->GetHandle())
+    return 0;
+
+  CSingleLock lock(m_section);
+
+  // ensure 0 (invalid transfer) is never hit
+  m_counter++;
+  if (m_counter == 0)
+    m_counter++;
+
+  m_pending.emplace_back(m_counter, std::move(transfer));
+  m_added.Set();
+
+  if (!IsRunning())
+    Create();
+
+  return m_counter;
+}
+
+void CCurlReactor::Cancel(unsigned int id)
+{
+  CSingleLock lock(m_section);
+
+  auto it = std::find_if(m_pending.begin(), m_pending.end(),
+                         [id](const std::pair<unsigned int, std::unique_ptr<ITransfer>>& pending)
+                         {
+                           return pending.first == id;
+                         });
+  if (it != m_pending.end())
+    m_pending.erase(it);
+  else
+    m_cancelled.push_back(id);
+}
+
+void CCurlReactor::Process()
+{
+  m_multi = g_curlInterface.multi_init();
+
+  while (!m_bStop)
+  {
+    {
+      CSingleLock lock(m_section);
+
+      for (auto& pending : m_pending)
+      {
+        if (g_curlInterface.multi_add_handle(m_multi, pending.second->GetHandle()) != CURLM_OK)
+        {
+          CLog::Log(LOGERROR, "CCurlReactor::Process - unable to start transfer %u", pending.first);
+          pending.second->OnDone(CURLE_FAILED_INIT);
+          continue;
+        }
+        m_transfers.insert(std::move(pending));
+      }
+      m_pending.clear();
+
+      for (unsigned int id : m_cancelled)
+      {
+        auto it = m_transfers.find(id);
+        if (it == m_transfers.end())
+          continue; // done already
+        g_curlInterface.multi_remove_handle(m_multi, it->second->GetHandle());
+        m_transfers.erase(it);
+      }
+      m_cancelled.clear();
+    }
+
+    if (m_transfers.empty())
+    {
+      AbortableWait(m_added);
+      continue;
+    }
+
+    int running = 0;
+    g_curlInterface.multi_perform(m_multi, &running);
+
+    // the message is invalid once its handle got removed
+    std::vector<std::pair<CURL_HANDLE*, CURLcode>> done;
+    int left = 0;
+    while (CURLMsg* msg = g_curlInterface.multi_info_read(m_multi, &left))
+    {
+      if (msg->msg == CURLMSG_DONE)
+        done.emplace_back(msg->easy_handle, msg->data.result);
+    }
+
+    if (!done.empty())
+    {
+      CSingleLock lock(m_section);
+
+      for (const auto& result : done)
+      {
+        auto it = std::find_if(m_transfers.begin(), m_transfers.end(),
+                               [&result](const std::pair<const unsigned int, std::unique_ptr<ITransfer>>& transfer)
+                               {
+                                 return transfer.second->GetHandle() == result.first;
+                               });
+        if (it == m_transfers.end())
+          continue;
+
+        g_curlInterface.multi_remove_handle(m_multi, result.first);
+        if (std::find(m_cancelled.begin(), m_cancelled.end(), it->first) == m_cancelled.end())
+          it->second->OnDone(result.second);
+        m_transfers.erase(it);
+      }
+    }
+
+    if (running)
+      g_curlInterface.multi_wait(m_multi, REACTOR_WAIT_MS, NULL);
+  }
+
+  for (const auto& transfer : m_transfers)
+    g_curlInterface.multi_remove_handle(m_multi, transfer.second->GetHandle());
+  m_transfers.clear();
+
+  g_curlInterface.multi_cleanup(m_multi);
+  m_multi = nullptr;
+}
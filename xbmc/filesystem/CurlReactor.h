@@ -0,0 +1,77 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/Thread.h"
+
+#include <map>
+#include <memory>
+#include <utility>
+#include <vector>
+
+typedef void CURL_HANDLE;
+typedef void CURLM;
+
+namespace XFILE
+{
+  /*!
+   \brief Drives the curl transfers of many callers on a single thread.
+
+   Transfers added here share one curl multi handle, so any number of
+   outstanding requests wait on one thread instead of blocking a thread
+   each. The thread is started with the first transfer.
+   */
+  class CCurlReactor : private CThread
+  {
+  public:
+    class ITransfer
+    {
+    public:
+      virtual ~ITransfer() = default;
+      /*! \brief The configured easy handle, the reactor only adds it to its multi handle */
+      virtual CURL_HANDLE* GetHandle() const = 0;
+      /*! \brief Called on the reactor thread when the transfer is done
+       \param result the CURLcode of the transfer
+       */
+      virtual void OnDone(int result) = 0;
+    };
+
+    static CCurlReactor& GetInstance();
+
+    /*!
+     \brief Start a transfer, the reactor owns it from now on.
+     \return an id to cancel the transfer with, 0 if it couldn't be started
+     */
+    unsigned int Add(std::unique_ptr<ITransfer> transfer);
+
+    /*!
+     \brief Drop a transfer. Once this returns, OnDone() of the transfer
+     isn't running and won't be called anymore.
+     */
+    void Cancel(unsigned int id);
+
+  private:
+    CCurlReactor();
+    ~CCurlReactor() override;
+
+    void Process() override;
+
+    CCriticalSection m_section;
+    CEvent m_added;
+    std::vector<std::pair<unsigned int, std::unique_ptr<ITransfer>>> m_pending;
+    std::vector<unsigned int> m_cancelled;
+    unsigned int m_counter = 0;
+
+    // only touched by the reactor thread
+    CURLM* m_multi = nullptr;
+    std::map<unsigned int, std::unique_ptr<ITransfer>> m_transfers;
+  };
+}
@@ -13,11 +13,13 @@
 #include "DirectoryFactory.h"
 #include "FileDirectoryFactory.h"
 #include "FileItem.h"
+#include "GUIUserMessages.h"
 #include "PasswordManager.h"
 #include "ServiceBroker.h"
 #include "URL.h"
 #include "commons/Exception.h"
 #include "dialogs/GUIDialogBusy.h"
+#include "guilib/GUIComponent.h"
 #include "guilib/GUIWindowManager.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
@@ -111,6 +113,40 @@ public:
 };
 
 
+/*!
+ \brief Lists a folder whose saved listing was returned, and refreshes the views of
+ the folder if the listing changed
+ */
+class CRevalidateDirectoryJob : public CJob
+{
+public:
+  CRevalidateDirectoryJob(const CURL& url, const CDirectory::CHints& hints, uint32_t fingerprint)
+    : m_url(url), m_hints(hints), m_fingerprint(fingerprint)
+  {
+    m_hints.flags &= ~DIR_FLAG_ALLOW_PROMPT;
+  }
+
+  bool DoWork() override
+  {
+    CFileItemList items;
+    if (!CDirectory::GetDirectory(m_url, items, m_hints))
+      return false;
+
+    if (CDirectoryCache::GetFingerprint(items) != m_fingerprint)
+    {
+      CGUIMessage msg(GUI_MSG_NOTIFY_ALL, 0, 0, GUI_MSG_UPDATE_PATH);
+      msg.SetStringParam(m_url.Get());
+      CServiceBroker::GetGUI()->GetWindowManager().SendThreadMessage(msg);
+    }
+    return true;
+  }
+
+private:
+  CURL m_url;
+  CDirectory::CHints m_hints;
+  uint32_t m_fingerprint;
+};
+
 CDirectory::CDirectory() = default;
 
 CDirectory::~CDirectory() = default;
@@ -164,9 +200,14 @@ bool CDirectory::GetDirectory(const CURL& url, std::shared_ptr<IDirectory> pDire
     if (!pDirectory)
       return false;
 
+    const bool allowStale = (hints.flags & DIR_FLAG_ALLOW_STALE) && CDirectoryCache::CanSaveDirectory(realURL);
+    bool revalidate = false;
+
     // check our cache for this path
     if (g_directoryCache.GetDirectory(realURL.Get(), items, (hints.flags & DIR_FLAG_READ_CACHE) == DIR_FLAG_READ_CACHE))
       items.SetURL(url);
+    else if (allowStale && g_directoryCache.GetSavedDirectory(realURL.Get(), items, revalidate))
+      items.SetURL(url);
     else
     {
       // need to clear the cache (in case the directory fetch fails)
@@ -249,6 +290,9 @@ bool CDirectory::GetDirectory(const CURL& url, std::shared_ptr<IDirectory> pDire
       // cache the directory, if necessary
       if (!(hints.flags & DIR_FLAG_BYPASS_CACHE))
         g_directoryCache.SetDirectory(realURL.Get(), items, pDirectory->GetCacheType(url));
+
+      if (allowStale)
+        g_directoryCache.SaveDirectory(realURL.Get(), items);
     }
 
     // now filter for allowed files
@@ -296,6 +340,11 @@ bool CDirectory::GetDirectory(const CURL& url, std::shared_ptr<IDirectory> pDire
       }
     }
 
+    // list the folder again, the job compares the listings as they are returned
+    if (revalidate)
+      CJobManager::GetInstance().AddJob(new CRevalidateDirectoryJob(url, hints, CDirectoryCache::GetFingerprint(items)),
+                                        nullptr, CJob::PRIORITY_LOW);
+
     return true;
   }
   XBMCCOMMONS_HANDLE_UNCHECKED
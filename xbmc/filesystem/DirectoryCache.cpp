@@ -9,25 +9,36 @@
 #include "DirectoryCache.h"
 
 #include "Directory.h"
+#include "File.h"
 #include "FileItem.h"
 #include "URL.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/Archive.h"
+#include "utils/Crc32.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/log.h"
 
 #include <algorithm>
-#include <climits>
+#include <ctime>
 
 // Maximum number of directories to keep in our cache
 #define MAX_CACHED_DIRS 50
+// Maximum number of items of all cached directories, the big ones take most of the memory
+#define MAX_CACHED_ITEMS 50000
+
+// Saved listings of network folders, kept over restarts
+#define SAVED_DIRS_PATH "special://profile/dircache/"
+#define MAX_SAVED_DIRS 1000
+// A saved listing isn't revalidated when the folder was listed this recently
+#define SAVED_DIR_FRESH_MS 10000
 
 using namespace XFILE;
 
 CDirectoryCache::CDir::CDir(DIR_CACHE_TYPE cacheType)
 {
   m_cacheType = cacheType;
-  m_lastAccess = 0;
   m_Items = new CFileItemList;
   m_Items->SetIgnoreURLOptions(true);
   m_Items->SetFastLookup(true);
@@ -38,21 +49,19 @@ CDirectoryCache::CDir::~CDir()
   delete m_Items;
 }
 
-void CDirectoryCache::CDir::SetLastAccess(unsigned int &accessCounter)
-{
-  m_lastAccess = accessCounter++;
-}
-
 CDirectoryCache::CDirectoryCache(void)
 {
-  m_accessCounter = 0;
 #ifdef _DEBUG
   m_cacheHits = 0;
   m_cacheMisses = 0;
 #endif
+  CMemoryPressureManager::GetInstance().Register(this, "directory cache", CMemoryPressureManager::PRIORITY_CACHE);
 }
 
-CDirectoryCache::~CDirectoryCache(void) = default;
+CDirectoryCache::~CDirectoryCache(void)
+{
+  CMemoryPressureManager::GetInstance().Unregister(this);
+}
 
 bool CDirectoryCache::GetDirectory(const std::string& strPath, CFileItemList &items, bool retrieveAll)
 {
@@ -70,7 +79,7 @@ bool CDirectoryCache::GetDirectory(const std::string& strPath, CFileItemList &it
        (dir->m_cacheType == XFILE::DIR_CACHE_ONCE && retrieveAll))
     {
       items.Copy(*dir->m_Items);
-      dir->SetLastAccess(m_accessCounter);
+      SetLastAccess(dir);
 #ifdef _DEBUG
       m_cacheHits+=items.Size();
 #endif
@@ -104,11 +113,16 @@ void CDirectoryCache::SetDirectory(const std::string& strPath, const CFileItemLi
 
   ClearDirectory(storedPath);
 
-  CheckIfFull();
+  if (cacheType != DIR_CACHE_ALWAYS)
+    CheckIfFull(items.Size());
 
   CDir* dir = new CDir(cacheType);
   dir->m_Items->Copy(items);
-  dir->SetLastAccess(m_accessCounter);
+  if (cacheType != DIR_CACHE_ALWAYS)
+  {
+    dir->m_lruPos = m_lru.insert(m_lru.begin(), storedPath);
+    m_lruItems += dir->m_Items->Size();
+  }
   m_cache.insert(std::pair<std::string, CDir*>(storedPath, dir));
 }
 
@@ -116,8 +130,24 @@ void CDirectoryCache::ClearFile(const std::string& strFile)
 {
   // Get rid of any URL options, else the compare may be wrong
   std::string strFile2 = CURL(strFile).GetWithoutOptions();
+  std::string strPath = URIUtils::GetDirectory(strFile2);
+
+  ClearDirectory(strPath);
 
-  ClearDirectory(URIUtils::GetDirectory(strFile2));
+  // the folder was changed from here, its saved listing is outdated
+  URIUtils::RemoveSlashAtEnd(strPath);
+  bool saved = false;
+  {
+    CSingleLock lock(m_cs);
+    auto it = m_saved.find(strPath);
+    if (it != m_saved.end())
+    {
+      saved = true;
+      m_saved.erase(it);
+    }
+  }
+  if (saved)
+    CFile::Delete(GetSavedPath(strPath));
 }
 
 void CDirectoryCache::ClearDirectory(const std::string& strPath)
@@ -164,7 +194,9 @@ void CDirectoryCache::AddFile(const std::string& strFile)
     CDir *dir = i->second;
     CFileItemPtr item(new CFileItem(strFile, false));
     dir->m_Items->Add(item);
-    dir->SetLastAccess(m_accessCounter);
+    if (dir->m_cacheType != DIR_CACHE_ALWAYS)
+      m_lruItems++;
+    SetLastAccess(dir);
   }
 }
 
@@ -184,7 +216,7 @@ bool CDirectoryCache::FileExists(const std::string& strFile, bool& bInCache)
   {
     bInCache = true;
     CDir *dir = i->second;
-    dir->SetLastAccess(m_accessCounter);
+    SetLastAccess(dir);
 #ifdef _DEBUG
     m_cacheHits++;
 #endif
@@ -206,6 +238,26 @@ void CDirectoryCache::Clear()
     Delete(i++);
 }
 
+void CDirectoryCache::OnMemoryPressure(MemoryPressure level)
+{
+  if (level == MemoryPressure::CRITICAL)
+  {
+    Clear();
+    return;
+  }
+
+  CSingleLock lock (m_cs);
+
+  iCache i = m_cache.begin();
+  while (i != m_cache.end())
+  {
+    if (i->second->m_cacheType != DIR_CACHE_ALWAYS)
+      Delete(i++);
+    else
+      i++;
+  }
+}
+
 void CDirectoryCache::InitCache(std::set<std::string>& dirs)
 {
   for (const std::string& strDir : dirs)
@@ -228,50 +280,189 @@ void CDirectoryCache::ClearCache(std::set<std::string>& dirs)
   }
 }
 
-void CDirectoryCache::CheckIfFull()
+void CDirectoryCache::CheckIfFull(int newItems)
 {
   CSingleLock lock (m_cs);
 
-  // find the last accessed folder, and remove if the number of cached folders is too many
-  iCache lastAccessed = m_cache.end();
-  unsigned int numCached = 0;
-  for (iCache i = m_cache.begin(); i != m_cache.end(); i++)
+  // remove the least recently used folders while there are too many of them, or
+  // too many items. Folders that are always cached aren't in m_lru
+  while (!m_lru.empty() &&
+         (m_lru.size() >= MAX_CACHED_DIRS || m_lruItems + newItems > MAX_CACHED_ITEMS))
   {
-    // ensure dirs that are always cached aren't cleared
-    if (i->second->m_cacheType != DIR_CACHE_ALWAYS)
-    {
-      if (lastAccessed == m_cache.end() || i->second->GetLastAccess() < lastAccessed->second->GetLastAccess())
-        lastAccessed = i;
-      numCached++;
-    }
+    iCache i = m_cache.find(m_lru.back());
+    if (i == m_cache.end())
+      m_lru.pop_back();
+    else
+      Delete(i);
   }
-  if (lastAccessed != m_cache.end() && numCached >= MAX_CACHED_DIRS)
-    Delete(lastAccessed);
+}
+
+void CDirectoryCache::SetLastAccess(CDir* dir)
+{
+  if (dir->m_cacheType != DIR_CACHE_ALWAYS)
+    m_lru.splice(m_lru.begin(), m_lru, dir->m_lruPos);
 }
 
 void CDirectoryCache::Delete(iCache it)
 {
   CDir* dir = it->second;
+  if (dir->m_cacheType != DIR_CACHE_ALWAYS)
+  {
+    m_lruItems -= std::min(m_lruItems, static_cast<unsigned int>(dir->m_Items->Size()));
+    m_lru.erase(dir->m_lruPos);
+  }
   delete dir;
   m_cache.erase(it);
 }
 
+bool CDirectoryCache::CanSaveDirectory(const CURL& url)
+{
+  return url.IsProtocol("smb") || url.IsProtocol("nfs") || url.IsProtocol("upnp") ||
+         url.IsProtocol("ftp") || url.IsProtocol("ftps") || url.IsProtocol("sftp") ||
+         url.IsProtocol("dav") || url.IsProtocol("davs");
+}
+
+bool CDirectoryCache::GetSavedDirectory(const std::string& strPath, CFileItemList &items, bool& revalidate)
+{
+  std::string storedPath = CURL(strPath).GetWithoutOptions();
+  URIUtils::RemoveSlashAtEnd(storedPath);
+
+  {
+    CSingleLock lock(m_cs);
+    auto it = m_saved.find(storedPath);
+    if (it != m_saved.end() && it->second.revalidating)
+      return false;
+  }
+
+  CFileItemList saved;
+  CFile file;
+  if (!file.Open(GetSavedPath(storedPath)))
+    return false;
+
+  try
+  {
+    CArchive ar(&file, CArchive::load);
+    ar >> saved;
+  }
+  catch (const std::out_of_range&)
+  {
+    CLog::Log(LOGERROR, "%s - corrupt listing of %s", __FUNCTION__, CURL::GetRedacted(storedPath).c_str());
+    return false;
+  }
+
+  CSingleLock lock(m_cs);
+  SavedDir& dir = m_saved[storedPath];
+  if (dir.revalidating)
+    return false;
+
+  revalidate = !dir.fetchedThisSession ||
+               XbmcThreads::SystemClockMillis() - dir.fetched > SAVED_DIR_FRESH_MS;
+  if (revalidate)
+  {
+    // until the folder is listed again, visits list it as usual
+    dir.fingerprint = GetFingerprint(saved);
+    dir.revalidating = true;
+  }
+
+  items.Assign(saved);
+  items.SetPath(strPath);
+  return true;
+}
+
+bool CDirectoryCache::SaveDirectory(const std::string& strPath, CFileItemList &items)
+{
+  std::string storedPath = CURL(strPath).GetWithoutOptions();
+  URIUtils::RemoveSlashAtEnd(storedPath);
+
+  const uint32_t fingerprint = GetFingerprint(items);
+  bool changed;
+  bool prune;
+  {
+    CSingleLock lock(m_cs);
+    auto it = m_saved.find(storedPath);
+    changed = it == m_saved.end() || it->second.fingerprint != fingerprint;
+
+    SavedDir& dir = m_saved[storedPath];
+    dir.fingerprint = fingerprint;
+    dir.fetched = XbmcThreads::SystemClockMillis();
+    dir.fetchedThisSession = true;
+    dir.revalidating = false;
+
+    prune = changed && !m_savedPruned;
+    m_savedPruned = true;
+  }
+
+  if (!changed)
+    return false;
+
+  if (prune)
+    PruneSavedDirectories();
+
+  CFile file;
+  if (file.OpenForWrite(GetSavedPath(storedPath), true))
+  {
+    CArchive ar(&file, CArchive::store);
+    ar << items;
+  }
+  return true;
+}
+
+uint32_t CDirectoryCache::GetFingerprint(const CFileItemList &items)
+{
+  Crc32 crc;
+  crc.Reset();
+  for (const auto& item : items)
+  {
+    const std::string& path = item->GetPath();
+    crc.Compute(path.c_str(), path.size() + 1);
+
+    time_t date = 0;
+    if (item->m_dateTime.IsValid())
+      item->m_dateTime.GetAsTime(date);
+    const int64_t values[] = { item->m_bIsFolder, item->m_dwSize, static_cast<int64_t>(date) };
+    crc.Compute(reinterpret_cast<const char*>(values), sizeof(values));
+  }
+  return crc;
+}
+
+void CDirectoryCache::PruneSavedDirectories()
+{
+  if (!CDirectory::Exists(SAVED_DIRS_PATH))
+  {
+    CDirectory::Create(SAVED_DIRS_PATH);
+    return;
+  }
+
+  // drop the listings of the folders that weren't visited for the longest time
+  CFileItemList saved;
+  CDirectory::GetDirectory(SAVED_DIRS_PATH, saved, ".fi", DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_BYPASS_CACHE);
+  if (saved.Size() <= MAX_SAVED_DIRS)
+    return;
+
+  saved.Sort(SortByDate, SortOrderAscending);
+  for (int i = 0; i < saved.Size() - MAX_SAVED_DIRS; i++)
+    CFile::Delete(saved[i]->GetPath());
+}
+
+std::string CDirectoryCache::GetSavedPath(const std::string& strPath)
+{
+  return StringUtils::Format(SAVED_DIRS_PATH "%08x.fi", Crc32::ComputeFromLowerCase(strPath));
+}
+
 #ifdef _DEBUG
 void CDirectoryCache::PrintStats() const
 {
   CSingleLock lock (m_cs);
   CLog::Log(LOGDEBUG, "%s - total of %u cache hits, and %u cache misses", __FUNCTION__, m_cacheHits, m_cacheMisses);
-  // run through and find the oldest and the number of items cached
-  unsigned int oldest = UINT_MAX;
+  // run through and find the number of items cached
   unsigned int numItems = 0;
   unsigned int numDirs = 0;
   for (ciCache i = m_cache.begin(); i != m_cache.end(); i++)
   {
     CDir *dir = i->second;
-    oldest = std::min(oldest, dir->GetLastAccess());
     numItems += dir->m_Items->Size();
     numDirs++;
   }
-  CLog::Log(LOGDEBUG, "%s - %u folders cached, with %u items total.  Oldest is %u, current is %u", __FUNCTION__, numDirs, numItems, oldest, m_accessCounter);
+  CLog::Log(LOGDEBUG, "%s - %u folders cached, with %u items total.  %u folders with %u items may be removed", __FUNCTION__, numDirs, numItems, static_cast<unsigned int>(m_lru.size()), m_lruItems);
 }
 #endif
@@ -10,15 +10,20 @@
 
 #include "IDirectory.h"
 #include "threads/CriticalSection.h"
+#include "utils/MemoryPressure.h"
 
+#include <list>
 #include <map>
 #include <set>
+#include <stdint.h>
+#include <string>
 
 class CFileItem;
+class CURL;
 
 namespace XFILE
 {
-  class CDirectoryCache
+  class CDirectoryCache : public IMemoryPressureHandler
   {
     class CDir
     {
@@ -26,15 +31,20 @@ namespace XFILE
       explicit CDir(DIR_CACHE_TYPE cacheType);
       virtual ~CDir();
 
-      void SetLastAccess(unsigned int &accessCounter);
-      unsigned int GetLastAccess() const { return m_lastAccess; };
-
       CFileItemList* m_Items;
       DIR_CACHE_TYPE m_cacheType;
+      std::list<std::string>::iterator m_lruPos; ///< position in m_lru, unless always cached
     private:
       CDir(const CDir&) = delete;
       CDir& operator=(const CDir&) = delete;
-      unsigned int m_lastAccess;
+    };
+
+    struct SavedDir
+    {
+      uint32_t fingerprint = 0;
+      unsigned int fetched = 0; ///< when it was listed, if fetchedThisSession
+      bool fetchedThisSession = false;
+      bool revalidating = false;
     };
   public:
     CDirectoryCache(void);
@@ -45,15 +55,41 @@ namespace XFILE
     void ClearFile(const std::string& strFile);
     void ClearSubPaths(const std::string& strPath);
     void Clear();
+
+    /*! \brief Drop the listings only cached for speed, under critical pressure all of them */
+    void OnMemoryPressure(MemoryPressure level) override;
     void AddFile(const std::string& strFile);
     bool FileExists(const std::string& strPath, bool& bInCache);
+
+    /*!
+     \brief Whether the listings of a folder are saved to disk, true for network filesystems
+     */
+    static bool CanSaveDirectory(const CURL& url);
+    /*!
+     \brief Get the listing of a folder that was saved on an earlier visit, maybe in an earlier session
+     \param revalidate set to whether the folder should be listed again, false if it was listed just now
+     \return false if no listing was saved, or if it is being listed again after it was returned before
+     */
+    bool GetSavedDirectory(const std::string& strPath, CFileItemList &items, bool& revalidate);
+    /*!
+     \brief Save the listing of a folder to disk for GetSavedDirectory()
+     \return true if it differs from the listing saved before
+     */
+    bool SaveDirectory(const std::string& strPath, CFileItemList &items);
+    /*!
+     \brief Identifies the paths, sizes and dates of the items, to tell whether a listing changed
+     */
+    static uint32_t GetFingerprint(const CFileItemList &items);
 #ifdef _DEBUG
     void PrintStats() const;
 #endif
   protected:
     void InitCache(std::set<std::string>& dirs);
     void ClearCache(std::set<std::string>& dirs);
-    void CheckIfFull();
+    void CheckIfFull(int newItems);
+    void SetLastAccess(CDir* dir);
+    void PruneSavedDirectories();
+    static std::string GetSavedPath(const std::string& strPath);
 
     std::map<std::string, CDir*> m_cache;
     typedef std::map<std::string, CDir*>::iterator iCache;
@@ -62,7 +98,11 @@ namespace XFILE
 
     mutable CCriticalSection m_cs;
 
-    unsigned int m_accessCounter;
+    std::list<std::string> m_lru; ///< folders that aren't always cached, most recently used first
+    unsigned int m_lruItems = 0; ///< number of items of the folders in m_lru
+
+    std::map<std::string, SavedDir> m_saved;
+    bool m_savedPruned = false;
 
 #ifdef _DEBUG
     unsigned int m_cacheHits;
@@ -20,6 +20,7 @@
 #include "FavouritesDirectory.h"
 #include "LibraryDirectory.h"
 #include "EventsDirectory.h"
+#include "GameDatabaseDirectory.h"
 #include "AddonsDirectory.h"
 #include "SourcesDirectory.h"
 #include "FTPDirectory.h"
@@ -144,6 +145,7 @@ IDirectory* CDirectoryFactory::Create(const CURL& url)
 #endif
   if (url.IsProtocol("resource")) return new CResourceDirectory();
   if (url.IsProtocol("events")) return new CEventsDirectory();
+  if (url.IsProtocol("gamedb")) return new CGameDatabaseDirectory();
 #ifdef TARGET_WINDOWS_STORE
   if (CWinLibraryDirectory::IsValid(url)) return new CWinLibraryDirectory();
 #endif
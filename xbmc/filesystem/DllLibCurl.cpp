@@ -58,7 +58,11 @@ CURL_HANDLE* DllLibCurl::easy_duphandle(CURL_HANDLE* handle)
 
 CURLM* DllLibCurl::multi_init()
 {
-  return curl_multi_init();
+  CURLM* multi = curl_multi_init();
+  // transfers to the same http/2 server share one connection
+  if (multi)
+    curl_multi_setopt(multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+  return multi;
 }
 
 CURLMcode DllLibCurl::multi_add_handle(CURLM* multi_handle, CURL_HANDLE* easy_handle)
@@ -87,6 +91,11 @@ CURLMcode DllLibCurl::multi_timeout(CURLM* multi_handle, long* timeout)
   return curl_multi_timeout(multi_handle, timeout);
 }
 
+CURLMcode DllLibCurl::multi_wait(CURLM* multi_handle, int timeout_ms, int* numfds)
+{
+  return curl_multi_wait(multi_handle, NULL, 0, timeout_ms, numfds);
+}
+
 CURLMsg* DllLibCurl::multi_info_read(CURLM* multi_handle, int* msgs_in_queue)
 {
   return curl_multi_info_read(multi_handle, msgs_in_queue);
@@ -130,14 +139,51 @@ DllLibCurlGlobal::DllLibCurlGlobal()
   {
     CLog::Log(LOGERROR, "Error initializing libcurl");
   }
+
+  // without it every session resolves and negotiates TLS on its own. connections aren't
+  // shared, libcurl doesn't support using a shared connection cache from several threads
+  m_share = curl_share_init();
+  if (m_share)
+  {
+    curl_share_setopt(m_share, CURLSHOPT_LOCKFUNC, share_lock);
+    curl_share_setopt(m_share, CURLSHOPT_UNLOCKFUNC, share_unlock);
+    curl_share_setopt(m_share, CURLSHOPT_USERDATA, this);
+    curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+    curl_share_setopt(m_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+  }
 }
 
 DllLibCurlGlobal::~DllLibCurlGlobal()
 {
+  // the share can only be cleaned up once no handle uses it anymore
+  for (const auto& session : m_sessions)
+  {
+    if (session.m_multi && session.m_easy)
+      multi_remove_handle(session.m_multi, session.m_easy);
+    if (session.m_easy)
+      easy_cleanup(session.m_easy);
+    if (session.m_multi)
+      multi_cleanup(session.m_multi);
+  }
+  m_sessions.clear();
+
+  if (m_share)
+    curl_share_cleanup(m_share);
+
   // close libcurl
   curl_global_cleanup();
 }
 
+void DllLibCurlGlobal::share_lock(CURL_HANDLE* handle, curl_lock_data data, curl_lock_access access, void* userptr)
+{
+  static_cast<DllLibCurlGlobal*>(userptr)->m_shareSections[data].lock();
+}
+
+void DllLibCurlGlobal::share_unlock(CURL_HANDLE* handle, curl_lock_data data, void* userptr)
+{
+  static_cast<DllLibCurlGlobal*>(userptr)->m_shareSections[data].unlock();
+}
+
 void DllLibCurlGlobal::CheckIdle()
 {
   CSingleLock lock(m_critSection);
@@ -55,6 +55,7 @@ public:
                         fd_set* exc_fd_set,
                         int* max_fd);
   CURLMcode multi_timeout(CURLM* multi_handle, long* timeout);
+  CURLMcode multi_wait(CURLM* multi_handle, int timeout_ms, int* numfds);
   CURLMsg* multi_info_read(CURLM* multi_handle, int* msgs_in_queue);
   CURLMcode multi_cleanup(CURLM* handle);
   curl_slist* slist_append(curl_slist* list, const char* to_append);
@@ -77,6 +78,9 @@ public:
   CURL_HANDLE* easy_duphandle(CURL_HANDLE* easy_handle) override;
   void CheckIdle();
 
+  /*! \brief DNS entries and TLS sessions shared by all handles */
+  CURLSH* GetShare() const { return m_share; }
+
   /* overloaded load and unload with reference counter */
 
   /* structure holding a session info */
@@ -94,6 +98,13 @@ public:
 
   VEC_CURLSESSIONS m_sessions;
   CCriticalSection m_critSection;
+
+private:
+  static void share_lock(CURL_HANDLE* handle, curl_lock_data data, curl_lock_access access, void* userptr);
+  static void share_unlock(CURL_HANDLE* handle, curl_lock_data data, void* userptr);
+
+  CURLSH* m_share = nullptr;
+  CCriticalSection m_shareSections[CURL_LOCK_DATA_LAST];
 };
 } // namespace XCURL
 
@@ -15,10 +15,14 @@
 #include "DirectoryCache.h"
 #include "FileCache.h"
 #include "FileFactory.h"
+#include "FileItem.h"
 #include "IFile.h"
 #include "PasswordManager.h"
 #include "Util.h"
 #include "commons/Exception.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/SingleLock.h"
 #include "utils/BitstreamStats.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
@@ -26,8 +30,38 @@
 
 #include "system.h"
 
+#include <map>
+#include <memory>
+
 using namespace XFILE;
 
+// A folder is listed to check its files when at least this many of them are checked at once
+#define EXISTS_BATCH_MIN_FILES 2
+
+namespace
+{
+/*!
+ \brief A Stat of a remote file in progress, other threads stat-ing the same file wait for its result
+ */
+struct SPendingStat
+{
+  CEvent done{true};
+  struct __stat64 buffer = {};
+  int result = -1;
+};
+
+CCriticalSection pendingStatsSection;
+std::map<std::string, std::shared_ptr<SPendingStat>> pendingStats;
+
+int DoStat(const CURL& file, struct __stat64* buffer);
+
+bool CanListForExists(const std::string& strPath)
+{
+  return URIUtils::IsSmb(strPath) || URIUtils::IsNfs(strPath) ||
+         URIUtils::IsFTP(strPath) || URIUtils::IsDAV(strPath);
+}
+}
+
 //////////////////////////////////////////////////////////////////////
 // Construction/Destruction
 //////////////////////////////////////////////////////////////////////
@@ -510,11 +544,80 @@ int CFile::Stat(const std::string& strFileName, struct __stat64* buffer)
   return Stat(pathToUrl, buffer);
 }
 
+std::vector<bool> CFile::ExistsBatch(const std::vector<std::string>& files, bool bUseCache /* = true */)
+{
+  std::vector<bool> exists(files.size(), false);
+
+  std::map<std::string, std::vector<size_t>> folders;
+  for (size_t i = 0; i < files.size(); i++)
+    folders[URIUtils::GetDirectory(files[i])].push_back(i);
+
+  int flags = DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_NO_FILE_INFO;
+  if (!bUseCache)
+    flags |= DIR_FLAG_BYPASS_CACHE;
+
+  for (const auto& folder : folders)
+  {
+    CFileItemList items;
+    if (folder.second.size() >= EXISTS_BATCH_MIN_FILES && CanListForExists(folder.first) &&
+        CDirectory::GetDirectory(folder.first, items, "", flags))
+    {
+      items.SetFastLookup(true);
+      for (size_t i : folder.second)
+        exists[i] = !URIUtils::HasSlashAtEnd(files[i]) && items.Contains(files[i]);
+      continue;
+    }
+
+    for (size_t i : folder.second)
+      exists[i] = Exists(files[i], bUseCache);
+  }
+
+  return exists;
+}
+
 int CFile::Stat(const CURL& file, struct __stat64* buffer)
 {
   if (!buffer)
     return -1;
 
+  if (!URIUtils::IsRemote(file.Get()))
+    return DoStat(file, buffer);
+
+  // identical requests of several threads, like the scanner and the thumb
+  // loaders, share a single round-trip
+  std::shared_ptr<SPendingStat> pending;
+  bool owner = false;
+  {
+    CSingleLock lock(pendingStatsSection);
+    std::shared_ptr<SPendingStat>& entry = pendingStats[file.Get()];
+    if (!entry)
+    {
+      entry = std::make_shared<SPendingStat>();
+      owner = true;
+    }
+    pending = entry;
+  }
+
+  if (owner)
+  {
+    pending->result = DoStat(file, &pending->buffer);
+    {
+      CSingleLock lock(pendingStatsSection);
+      pendingStats.erase(file.Get());
+    }
+    pending->done.Set();
+  }
+  else
+    pending->done.Wait();
+
+  *buffer = pending->buffer;
+  return pending->result;
+}
+
+namespace
+{
+int DoStat(const CURL& file, struct __stat64* buffer)
+{
   CURL url(URIUtils::SubstitutePath(file));
   CURL authUrl = url;
   if (CPasswordManager::GetInstance().IsURLSupported(authUrl) && authUrl.GetUserName().empty())
@@ -564,11 +667,12 @@ int CFile::Stat(const CURL& file, struct __stat64* buffer)
   }
   catch(...)
   {
-    CLog::Log(LOGERROR, "%s - Unhandled exception", __FUNCTION__);
+    CLog::Log(LOGERROR, "CFile::Stat - Unhandled exception");
   }
-  CLog::Log(LOGERROR, "%s - Error statting %s", __FUNCTION__, file.GetRedacted().c_str());
+  CLog::Log(LOGERROR, "CFile::Stat - Error statting %s", file.GetRedacted().c_str());
   return -1;
 }
+}
 
 ssize_t CFile::Read(void *lpBuf, size_t uiBufSize)
 {
@@ -141,6 +141,15 @@ public:
   // string interface
   static bool Exists(const std::string& strFileName, bool bUseCache = true);
   /**
+  * Checks which of a list of files exist. The files of a folder on a network
+  * filesystem are checked with a single listing of the folder, which is kept
+  * in the directory cache for later checks.
+  * @param files       paths of the files to check
+  * @param bUseCache   whether listings and results of the directory cache may be used
+  * @return whether each of the files exists, in the order of files
+  */
+  static std::vector<bool> ExistsBatch(const std::vector<std::string>& files, bool bUseCache = true);
+  /**
   * Fills struct __stat64 with information about file specified by filename
   * For st_mode function will set correctly _S_IFDIR (directory) flag and may set
   * _S_IREAD (read permission), _S_IWRITE (write permission) flags if such
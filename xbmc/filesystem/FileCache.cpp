@@ -14,7 +14,9 @@
 #include "ServiceBroker.h"
 
 #include "CircularCache.h"
+#include "SegmentedReader.h"
 #include "threads/SingleLock.h"
+#include "utils/URIUtils.h"
 #include "utils/log.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
@@ -161,14 +163,17 @@ bool CFileCache::Open(const CURL& url)
 
       size_t back = cacheSize / 4;
       size_t front = cacheSize - back;
+      size_t retain = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_cacheRetainSize;
 
       if (m_flags & READ_MULTI_STREAM)
       {
         // READ_MULTI_STREAM requires double buffering, so use half the amount of memory for each buffer
         front /= 2;
         back /= 2;
+        // the double cache swaps between two windows itself, retained ranges would confuse it
+        retain = 0;
       }
-      m_pCache = std::unique_ptr<CCircularCache>(new CCircularCache(front, back)); // C++14 - Replace with std::make_unique
+      m_pCache = std::unique_ptr<CCircularCache>(new CCircularCache(front, back, retain)); // C++14 - Replace with std::make_unique
       m_forwardCacheSize = front;
     }
 
@@ -179,6 +184,18 @@ bool CFileCache::Open(const CURL& url)
     }
   }
 
+  // fetch seekable http sources through several parallel range requests if configured
+  const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  if (advancedSettings->m_cacheSegmentConcurrency > 1 && m_seekPossible > 0 && m_fileSize > 0 &&
+      URIUtils::IsHTTP(m_sourcePath))
+  {
+    CLog::Log(LOGDEBUG, "CFileCache::Open - using %u parallel segments of %u bytes",
+              advancedSettings->m_cacheSegmentConcurrency, advancedSettings->m_cacheSegmentSize);
+    m_segmentedReader.reset(new CSegmentedReader(m_sourcePath, advancedSettings->m_cacheSegmentSize,
+                                                 advancedSettings->m_cacheSegmentConcurrency));
+    m_segmentedReader->Start(0, m_fileSize);
+  }
+
   // open cache strategy
   if (!m_pCache || m_pCache->Open() != CACHE_RC_OK)
   {
@@ -234,7 +251,12 @@ void CFileCache::Process()
       int64_t cacheMaxPos = m_pCache->CachedDataEndPosIfSeekTo(m_seekPos);
       cacheReachEOF = (cacheMaxPos == m_fileSize);
       bool sourceSeekFailed = false;
-      if (!cacheReachEOF)
+      if (!cacheReachEOF && m_segmentedReader)
+      {
+        m_segmentedReader->Start(cacheMaxPos, m_fileSize);
+        m_nSeekResult = cacheMaxPos;
+      }
+      else if (!cacheReachEOF)
       {
         m_nSeekResult = m_source.Seek(cacheMaxPos, SEEK_SET);
         if (m_nSeekResult != cacheMaxPos)
@@ -296,7 +318,7 @@ void CFileCache::Process()
 
     ssize_t iRead = 0;
     if (!cacheReachEOF)
-      iRead = m_source.Read(buffer.get(), maxWrite);
+      iRead = ReadSource(buffer.get(), maxWrite);
     if (iRead == 0)
     {
       // Check for actual EOF and retry as long as we still have data in our cache
@@ -406,6 +428,14 @@ void CFileCache::Process()
   }
 }
 
+ssize_t CFileCache::ReadSource(char* buffer, size_t size)
+{
+  if (m_segmentedReader)
+    return m_segmentedReader->Read(buffer, size);
+
+  return m_source.Read(buffer, size);
+}
+
 void CFileCache::OnExit()
 {
   m_bStop = true;
@@ -537,6 +567,7 @@ void CFileCache::Close()
   if (m_pCache)
     m_pCache->Close();
 
+  m_segmentedReader.reset();
   m_source.Close();
 }
 
@@ -555,6 +586,9 @@ void CFileCache::StopThread(bool bWait /*= true*/)
   m_bStop = true;
   //Process could be waiting for seekEvent
   m_seekEvent.Set();
+  // or for a segment
+  if (m_segmentedReader)
+    m_segmentedReader->Stop();
   CThread::StopThread(bWait);
 }
 
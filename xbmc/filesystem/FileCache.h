@@ -20,6 +20,8 @@
 namespace XFILE
 {
 
+  class CSegmentedReader;
+
   class CFileCache : public IFile, public CThread
   {
   public:
@@ -55,7 +57,10 @@ namespace XFILE
     }
 
   private:
+    ssize_t ReadSource(char* buffer, size_t size);
+
     std::unique_ptr<CCacheStrategy> m_pCache;
+    std::unique_ptr<CSegmentedReader> m_segmentedReader;
     int m_seekPossible;
     CFile m_source;
     std::string m_sourcePath;
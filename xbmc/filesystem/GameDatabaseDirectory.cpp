@@ -0,0 +1,99 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GameDatabaseDirectory.h"
+
+#include "FileItem.h"
+#include "URL.h"
+#include "games/GameDatabase.h"
+#include "guilib/LocalizeStrings.h"
+#include "utils/URIUtils.h"
+
+#include <string>
+#include <vector>
+
+using namespace KODI;
+using namespace XFILE;
+
+#define NODE_PLATFORMS  "platforms"
+#define NODE_GENRES     "genres"
+#define NODE_TITLES     "titles"
+
+namespace
+{
+  void AddFolder(CFileItemList &items, const std::string &path, const std::string &label)
+  {
+    CFileItemPtr item(new CFileItem(path, true));
+    item->SetLabel(label);
+    item->SetLabelPreformatted(true);
+    items.Add(std::move(item));
+  }
+
+  void AddFolders(CFileItemList &items, const std::string &node, const std::vector<std::string> &labels)
+  {
+    for (const std::string &label : labels)
+      AddFolder(items, "gamedb://" + std::string(node) + "/" + CURL::Encode(label) + "/", label);
+  }
+}
+
+bool CGameDatabaseDirectory::GetDirectory(const CURL& url, CFileItemList &items)
+{
+  const std::string node = url.GetHostName();
+
+  std::string value = url.GetFileName();
+  URIUtils::RemoveSlashAtEnd(value);
+  value = CURL::Decode(value);
+
+  if (node.empty())
+  {
+    AddFolder(items, "gamedb://" NODE_PLATFORMS "/", g_localizeStrings.Get(35262)); // "Platforms"
+    AddFolder(items, "gamedb://" NODE_GENRES "/", g_localizeStrings.Get(135)); // "Genres"
+    AddFolder(items, "gamedb://" NODE_TITLES "/", g_localizeStrings.Get(10024)); // "Titles"
+    return true;
+  }
+
+  GAME::CGameDatabase database;
+  if (!database.Open())
+    return false;
+
+  bool bSuccess = false;
+
+  if (node == NODE_PLATFORMS)
+  {
+    if (value.empty())
+    {
+      std::vector<std::string> platforms;
+      bSuccess = database.GetPlatforms(platforms);
+      AddFolders(items, NODE_PLATFORMS, platforms);
+    }
+    else
+      bSuccess = database.GetGames(items, value, "");
+  }
+  else if (node == NODE_GENRES)
+  {
+    if (value.empty())
+    {
+      std::vector<std::string> genres;
+      bSuccess = database.GetGenres(genres);
+      AddFolders(items, NODE_GENRES, genres);
+    }
+    else
+      bSuccess = database.GetGames(items, "", value);
+  }
+  else if (node == NODE_TITLES)
+  {
+    bSuccess = database.GetGames(items, "", "");
+  }
+
+  database.Close();
+
+  if (bSuccess)
+    items.SetContent("games");
+
+  return bSuccess;
+}
@@ -0,0 +1,32 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "filesystem/IDirectory.h"
+
+namespace XFILE
+{
+  /*!
+   * \brief Browse the game library by platform, genre or title
+   *
+   * gamedb://platforms/<platform>/, gamedb://genres/<genre>/ and
+   * gamedb://titles/ are listed from the game database.
+   */
+  class CGameDatabaseDirectory : public IDirectory
+  {
+  public:
+    CGameDatabaseDirectory() = default;
+    ~CGameDatabaseDirectory() override = default;
+
+    // implementations of IDirectory
+    bool GetDirectory(const CURL& url, CFileItemList& items) override;
+    bool Exists(const CURL& url) override { return true; }
+    bool AllowAll() const override { return true; }
+  };
+}
@@ -61,6 +61,7 @@ typedef enum {
   IOCTRL_CACHE_SETRATE = 4,  /**< unsigned int with speed limit for caching in bytes per second */
   IOCTRL_SET_CACHE     = 8,  /**< CFileCache */
   IOCTRL_SET_RETRY     = 16, /**< Enable/disable retry within the protocol handler (if supported) */
+  IOCTRL_SET_MMAP      = 32, /**< Enable/disable memory mapped reads (if supported) */
 } EIoControl;
 
 enum CURLOPTIONTYPE
@@ -11,6 +11,9 @@
 //////////////////////////////////////////////////////////////////////
 
 #include "NFSFile.h"
+#include "ServiceBroker.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
 #include "utils/log.h"
 #include "utils/StringUtils.h"
@@ -24,8 +27,14 @@
 #ifdef TARGET_WINDOWS
 #include <fcntl.h>
 #include <sys\stat.h>
+#else
+#include <poll.h>
 #endif
 
+#include <algorithm>
+#include <cinttypes>
+#include <vector>
+
 //KEEP_ALIVE_TIMEOUT is decremented every half a second
 //360 * 0.5s == 180s == 3mins
 //so when no read was done for 3mins and files are open
@@ -40,6 +49,9 @@
 #define CONTEXT_NEW      1    //new context created
 #define CONTEXT_CACHED   2    //context cached and therefore already mounted (no new mount needed)
 
+//give up on pipelined reads when the server didn't answer for 30s
+#define PIPELINED_READ_TIMEOUT_MS 30000
+
 #if defined(TARGET_WINDOWS)
 #define S_IRGRP 0
 #define S_IROTH 0
@@ -49,6 +61,60 @@
 
 using namespace XFILE;
 
+namespace
+{
+
+//READ calls of one CNFSFile::ReadPipelined, deleted by the last callback if
+//the read was given up on while calls were still in flight
+struct PipelinedRead
+{
+  struct Call
+  {
+    PipelinedRead* read;
+    char* buffer;
+    size_t size;
+    int result;
+  };
+
+  std::vector<Call> calls;
+  int pending = 0;
+  bool abandoned = false;
+};
+
+void PipelinedReadCallback(int err, struct nfs_context* nfs, void* data, void* private_data)
+{
+  PipelinedRead::Call* call = static_cast<PipelinedRead::Call*>(private_data);
+  PipelinedRead* read = call->read;
+
+  // err is the number of bytes read, or a negative error
+  call->result = err;
+  if (!read->abandoned && err > 0)
+    memcpy(call->buffer, data, std::min(static_cast<size_t>(err), call->size));
+
+  if (--read->pending == 0 && read->abandoned)
+    delete read;
+}
+
+int PollNfsContext(struct nfs_context* nfs, int timeoutMs)
+{
+  struct pollfd pfd;
+  pfd.fd = nfs_get_fd(nfs);
+  pfd.events = static_cast<short>(nfs_which_events(nfs));
+  pfd.revents = 0;
+
+#if defined(TARGET_WINDOWS)
+  int ret = WSAPoll(&pfd, 1, timeoutMs);
+#else
+  int ret = poll(&pfd, 1, timeoutMs);
+#endif
+  if (ret <= 0)
+    return -1;
+
+  return nfs_service(nfs, pfd.revents);
+}
+
+} // unnamed namespace
+
 CNfsConnection::CNfsConnection()
 : m_pNfsContext(NULL)
 , m_exportPath("")
@@ -287,6 +353,7 @@ bool CNfsConnection::Connect(const CURL& url, std::string &relativePath)
         return false;
       }
       CLog::Log(LOGDEBUG,"NFS: Connected to server %s and export %s\n", url.GetHostName().c_str(), exportPath.c_str());
+      CDNSNameCache::SetAlive(url.GetHostName());
     }
     m_exportPath = exportPath;
     m_hostName = url.GetHostName();
@@ -613,7 +680,10 @@ ssize_t CNFSFile::Read(void *lpBuf, size_t uiBufSize)
   if (m_pFileHandle == NULL || m_pNfsContext == NULL )
     return -1;
 
-  numberOfBytesRead = nfs_read(m_pNfsContext, m_pFileHandle, uiBufSize, (char *)lpBuf);
+  if (m_cached && uiBufSize > gNfsConnection.GetMaxReadChunkSize())
+    numberOfBytesRead = ReadPipelined(static_cast<char*>(lpBuf), uiBufSize);
+  else
+    numberOfBytesRead = nfs_read(m_pNfsContext, m_pFileHandle, uiBufSize, (char *)lpBuf);
 
   lock.Leave();//no need to keep the connection lock after that
 
@@ -626,6 +696,76 @@ ssize_t CNFSFile::Read(void *lpBuf, size_t uiBufSize)
   return numberOfBytesRead;
 }
 
+ssize_t CNFSFile::ReadPipelined(char* buffer, size_t size)
+{
+  uint64_t offset = 0;
+  if (nfs_lseek(m_pNfsContext, m_pFileHandle, 0, SEEK_CUR, &offset) < 0)
+    return -1;
+
+  //one READ call per chunk the server allows, all of them in flight at once
+  const size_t chunkSize = static_cast<size_t>(gNfsConnection.GetMaxReadChunkSize());
+  PipelinedRead* read = new PipelinedRead;
+  read->calls.resize((size + chunkSize - 1) / chunkSize);
+
+  bool failed = false;
+  for (size_t i = 0; i < read->calls.size(); i++)
+  {
+    PipelinedRead::Call& call = read->calls[i];
+    call.read = read;
+    call.buffer = buffer + i * chunkSize;
+    call.size = std::min(chunkSize, size - i * chunkSize);
+    call.result = 0;
+
+    if (nfs_pread_async(m_pNfsContext, m_pFileHandle, offset + i * chunkSize, call.size, PipelinedReadCallback, &call) != 0)
+    {
+      CLog::Log(LOGERROR, "%s - Error( pread at %" PRIu64 ", %s )", __FUNCTION__, offset + i * chunkSize, nfs_get_error(m_pNfsContext));
+      failed = true;
+      break;
+    }
+    read->pending++;
+  }
+
+  while (!failed && read->pending > 0)
+  {
+    if (PollNfsContext(m_pNfsContext, PIPELINED_READ_TIMEOUT_MS) < 0)
+    {
+      CLog::Log(LOGERROR, "%s - Error( %s )", __FUNCTION__, nfs_get_error(m_pNfsContext));
+      failed = true;
+    }
+  }
+
+  if (failed)
+  {
+    //calls still in flight complete whenever the context is serviced next
+    read->abandoned = true;
+    if (read->pending == 0)
+      delete read;
+    return -1;
+  }
+
+  //only the data up to the first short read is contiguous
+  ssize_t total = 0;
+  for (const auto& call : read->calls)
+  {
+    if (call.result < 0)
+    {
+      if (total == 0)
+        total = -1;
+      break;
+    }
+    total += call.result;
+    if (static_cast<size_t>(call.result) < call.size)
+      break;
+  }
+  delete read;
+
+  uint64_t position = 0;
+  if (total > 0)
+    nfs_lseek(m_pNfsContext, m_pFileHandle, offset + total, SEEK_SET, &position);
+
+  return total;
+}
+
 int64_t CNFSFile::Seek(int64_t iFilePosition, int iWhence)
 {
   int ret = 0;
@@ -683,6 +823,30 @@ void CNFSFile::Close()
     m_fileSize = 0;
     m_exportPath.clear();
   }
+  m_cached = false;
+}
+
+int CNFSFile::IoControl(EIoControl request, void* param)
+{
+  if (request == IOCTRL_SEEK_POSSIBLE)
+    return 1;
+
+  //the file cache asks for its chunk size right after this
+  if (request == IOCTRL_SET_CACHE)
+  {
+    m_cached = true;
+    return 0;
+  }
+
+  return -1;
+}
+
+int CNFSFile::GetChunkSize()
+{
+  int chunkSize = static_cast<int>(gNfsConnection.GetMaxReadChunkSize());
+  if (m_cached)
+    chunkSize *= CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_nfsReadAheadDepth;
+  return chunkSize;
 }
 
 //this was a bitch!
@@ -120,8 +120,8 @@ namespace XFILE
 
     //implement iocontrol for seek_possible for preventing the stat in File class for
     //getting this info ...
-    int IoControl(EIoControl request, void* param) override{ return request == IOCTRL_SEEK_POSSIBLE ? 1 : -1; };
-    int GetChunkSize() override {return static_cast<int>(gNfsConnection.GetMaxReadChunkSize());}
+    int IoControl(EIoControl request, void* param) override;
+    int GetChunkSize() override;
 
     bool OpenForWrite(const CURL& url, bool bOverWrite = false) override;
     bool Delete(const CURL& url) override;
@@ -133,6 +133,11 @@ namespace XFILE
     struct nfsfh *m_pFileHandle;
     struct nfs_context *m_pNfsContext;//current nfs context
     std::string m_exportPath;
+
+  private:
+    ssize_t ReadPipelined(char* buffer, size_t size);
+
+    bool m_cached = false;//read by a file cache, which asks for the chunks of several READ calls at once
   };
 }
 
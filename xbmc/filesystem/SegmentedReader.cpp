@@ -0,0 +1,210 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "SegmentedReader.h"
+
+#include "File.h"
+#include "threads/SingleLock.h"
+#include "threads/Thread.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cinttypes>
+#include <cstring>
+
+using namespace XFILE;
+
+class CSegmentedReader::CWorker : public CThread
+{
+public:
+  explicit CWorker(CSegmentedReader& reader) : CThread("SegmentedReader"), m_reader(reader) {}
+
+protected:
+  void Process() override
+  {
+    CFile file;
+    if (!file.Open(m_reader.m_path, READ_NO_CACHE | READ_TRUNCATED | READ_CHUNKED))
+    {
+      CLog::Log(LOGERROR, "CSegmentedReader - failed to open source");
+      return;
+    }
+
+    bool retry = false;
+    file.IoControl(IOCTRL_SET_RETRY, &retry);
+
+    while (!m_bStop && !m_reader.m_stop)
+    {
+      int64_t start;
+      size_t size;
+      unsigned int generation;
+      if (!m_reader.ClaimSegment(start, size, generation))
+      {
+        AbortableWait(m_reader.m_workEvent, 100);
+        continue;
+      }
+
+      std::vector<char> data(size);
+      size_t got = 0;
+      bool failed = file.Seek(start, SEEK_SET) != start;
+      while (!failed && got < size && !m_bStop && !m_reader.m_stop)
+      {
+        ssize_t read = file.Read(data.data() + got, size - got);
+        if (read <= 0)
+          failed = true;
+        else
+          got += read;
+      }
+
+      m_reader.CompleteSegment(start, generation, std::move(data), failed || got < size);
+    }
+  }
+
+private:
+  CSegmentedReader& m_reader;
+};
+
+CSegmentedReader::CSegmentedReader(const std::string& path, unsigned int segmentSize, unsigned int concurrency)
+  : m_path(path)
+  , m_segmentSize(std::max(segmentSize, 64u * 1024u))
+  , m_concurrency(std::max(concurrency, 1u))
+  , m_workEvent(true)
+{
+}
+
+CSegmentedReader::~CSegmentedReader()
+{
+  Stop();
+}
+
+void CSegmentedReader::Start(int64_t position, int64_t fileSize)
+{
+  {
+    CSingleLock lock(m_section);
+    m_segments.clear();
+    m_readPos = position;
+    m_nextFetch = position;
+    m_fileSize = fileSize;
+    m_generation++;
+  }
+
+  if (m_workers.empty())
+  {
+    for (unsigned int i = 0; i < m_concurrency; i++)
+    {
+      m_workers.emplace_back(new CWorker(*this));
+      m_workers.back()->Create();
+    }
+  }
+  m_workEvent.Set();
+}
+
+void CSegmentedReader::Stop()
+{
+  m_stop = true;
+  m_workEvent.Set();
+  m_dataEvent.Set();
+  for (auto& worker : m_workers)
+    worker->StopThread(true);
+  m_workers.clear();
+}
+
+bool CSegmentedReader::ClaimSegment(int64_t& start, size_t& size, unsigned int& generation)
+{
+  CSingleLock lock(m_section);
+
+  // keep at most two segments per worker in flight or buffered
+  if (m_nextFetch >= m_fileSize || m_segments.size() >= 2 * m_concurrency)
+  {
+    m_workEvent.Reset();
+    return false;
+  }
+
+  Segment segment;
+  segment.start = m_nextFetch;
+  segment.size = static_cast<size_t>(std::min<int64_t>(m_segmentSize, m_fileSize - m_nextFetch));
+  m_segments.push_back(std::move(segment));
+  m_nextFetch += m_segments.back().size;
+
+  start = m_segments.back().start;
+  size = m_segments.back().size;
+  generation = m_generation;
+  return true;
+}
+
+void CSegmentedReader::CompleteSegment(int64_t start, unsigned int generation, std::vector<char>&& data, bool failed)
+{
+  CSingleLock lock(m_section);
+
+  // dropped by a restart in the meantime
+  if (generation != m_generation)
+    return;
+
+  for (auto& segment : m_segments)
+  {
+    if (segment.start == start)
+    {
+      segment.data = std::move(data);
+      segment.done = true;
+      segment.failed = failed;
+      break;
+    }
+  }
+  m_dataEvent.Set();
+}
+
+ssize_t CSegmentedReader::Read(char* buffer, size_t size)
+{
+  CSingleLock lock(m_section);
+
+  while (!m_stop)
+  {
+    if (m_readPos >= m_fileSize)
+      return 0;
+
+    if (m_segments.empty())
+    {
+      // the workers claim the next segment
+      m_workEvent.Set();
+    }
+    else if (m_segments.front().done)
+    {
+      Segment& segment = m_segments.front();
+      if (segment.failed)
+      {
+        CLog::Log(LOGERROR, "CSegmentedReader - failed to fetch segment at %" PRId64, segment.start);
+        return -1;
+      }
+
+      size_t count = std::min(size, segment.size - segment.consumed);
+      memcpy(buffer, segment.data.data() + segment.consumed, count);
+      segment.consumed += count;
+      m_readPos += count;
+
+      if (segment.consumed == segment.size)
+      {
+        m_segments.pop_front();
+        m_workEvent.Set();
+      }
+      return count;
+    }
+
+    m_dataEvent.Reset();
+    {
+      CSingleExit exit(m_section);
+      m_dataEvent.WaitMSec(100);
+    }
+  }
+
+  return -1;
+}
+
+int64_t CSegmentedReader::GetPosition() const
+{
+  CSingleLock lock(m_section);
+  return m_readPos;
+}
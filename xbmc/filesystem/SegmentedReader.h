@@ -0,0 +1,90 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+
+#include <atomic>
+#include <deque>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <sys/types.h>
+
+namespace XFILE
+{
+
+  /*!
+   * \brief Reads a seekable source through several connections at once.
+   *
+   * The file is split into segments which are fetched by a number of worker threads, each
+   * with its own handle on the source. For http sources every segment becomes a range request,
+   * so a high latency link is no longer capped by the throughput of a single TCP stream.
+   * Read() returns the data in file order.
+   */
+  class CSegmentedReader
+  {
+  public:
+    CSegmentedReader(const std::string& path, unsigned int segmentSize, unsigned int concurrency);
+    ~CSegmentedReader();
+
+    /*!
+     * \brief Start fetching at the given position, dropping everything fetched so far
+     */
+    void Start(int64_t position, int64_t fileSize);
+
+    /*!
+     * \brief Stop all workers, Read() returns an error afterwards
+     */
+    void Stop();
+
+    /*!
+     * \brief Read the next bytes in file order, blocks until data is available
+     * \return number of bytes read, 0 on end of file, -1 on error
+     */
+    ssize_t Read(char* buffer, size_t size);
+
+    int64_t GetPosition() const;
+
+  private:
+    class CWorker;
+
+    struct Segment
+    {
+      int64_t start = 0;
+      size_t size = 0;
+      size_t consumed = 0;
+      bool done = false;
+      bool failed = false;
+      std::vector<char> data;
+    };
+
+    bool ClaimSegment(int64_t& start, size_t& size, unsigned int& generation);
+    void CompleteSegment(int64_t start, unsigned int generation, std::vector<char>&& data, bool failed);
+
+    std::string m_path;
+    unsigned int m_segmentSize;
+    unsigned int m_concurrency;
+
+    mutable CCriticalSection m_section;
+    CEvent m_workEvent;
+    CEvent m_dataEvent;
+    std::deque<Segment> m_segments;
+    int64_t m_readPos = 0;
+    int64_t m_nextFetch = 0;
+    int64_t m_fileSize = 0;
+    unsigned int m_generation = 0;
+    std::atomic<bool> m_stop{false};
+
+    std::vector<std::unique_ptr<CWorker>> m_workers;
+  };
+
+}
@@ -13,16 +13,24 @@
 #include "filesystem/Directory.h"
 #include "filesystem/File.h"
 #include "filesystem/FileDirectoryFactory.h"
+#include "interfaces/AnnouncementManager.h"
 #include "music/MusicDatabase.h"
 #include "playlists/SmartPlayList.h"
+#include "profiles/ProfileManager.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #include "utils/SortUtils.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "video/VideoDatabase.h"
 
+#include <algorithm>
+#include <list>
 #include <math.h>
+#include <memory>
 
 #define PROPERTY_PATH_DB            "path.db"
 #define PROPERTY_SORT_ORDER         "sort.order"
@@ -30,6 +38,40 @@
 #define PROPERTY_GROUP_BY           "group.by"
 #define PROPERTY_GROUP_MIXED        "group.mixed"
 
+// home screen widgets list the same few playlists over and over
+#define CACHE_MAX_LISTINGS          20
+// rules relative to the current date and referenced playlists don't invalidate a listing
+#define CACHE_MAX_AGE_MS            (5 * 60 * 1000)
+
+namespace
+{
+struct SCachedListing
+{
+  std::string key;
+  unsigned int videoChanges;
+  unsigned int audioChanges;
+  unsigned int time;
+  std::shared_ptr<const CFileItemList> items;
+};
+
+CCriticalSection cacheSection;
+std::list<SCachedListing> cachedListings; // most recently used first
+
+std::string GetCacheKey(const CSmartPlaylist& playlist, const CFileItemList& items, const std::string& strBaseDir, bool filter)
+{
+  std::string xsp;
+  if (!playlist.SaveAsJson(xsp, true))
+    return "";
+
+  CSettingsComponent* settingsComponent = CServiceBroker::GetSettingsComponent();
+  return StringUtils::Format("%i|%s|%s|%s|%d|%d|%s",
+                             settingsComponent->GetProfileManager()->GetCurrentProfileId(),
+                             items.GetPath().c_str(), strBaseDir.c_str(), playlist.GetName().c_str(), filter,
+                             settingsComponent->GetSettings()->GetBool(CSettings::SETTING_FILELISTS_IGNORETHEWHENSORTING),
+                             xsp.c_str());
+}
+}
+
 namespace XFILE
 {
   CSmartPlaylistDirectory::CSmartPlaylistDirectory() = default;
@@ -50,6 +92,61 @@ namespace XFILE
   }
 
   bool CSmartPlaylistDirectory::GetDirectory(const CSmartPlaylist &playlist, CFileItemList& items, const std::string &strBaseDir /* = "" */, bool filter /* = false */)
+  {
+    // a random order is meant to be different every time
+    std::string key;
+    if (items.IsEmpty() && playlist.GetOrder() != SortByRandom)
+      key = GetCacheKey(playlist, items, strBaseDir, filter);
+    if (key.empty())
+      return GetDatabaseItems(playlist, items, strBaseDir, filter);
+
+    // a listing is outdated as soon as anything in the libraries changed
+    const std::shared_ptr<ANNOUNCEMENT::CAnnouncementManager> announcementManager = CServiceBroker::GetAnnouncementManager();
+    const unsigned int videoChanges = announcementManager->GetAnnouncementCount(ANNOUNCEMENT::VideoLibrary);
+    const unsigned int audioChanges = announcementManager->GetAnnouncementCount(ANNOUNCEMENT::AudioLibrary);
+    const unsigned int now = XbmcThreads::SystemClockMillis();
+
+    std::shared_ptr<const CFileItemList> cached;
+    {
+      CSingleLock lock(cacheSection);
+      auto it = std::find_if(cachedListings.begin(), cachedListings.end(),
+                             [&key](const SCachedListing& listing) { return listing.key == key; });
+      if (it != cachedListings.end())
+      {
+        if (it->videoChanges == videoChanges && it->audioChanges == audioChanges &&
+            now - it->time < CACHE_MAX_AGE_MS)
+        {
+          cachedListings.splice(cachedListings.begin(), cachedListings, it);
+          cached = it->items;
+        }
+        else
+          cachedListings.erase(it);
+      }
+    }
+
+    if (cached)
+    {
+      items.Copy(*cached);
+      return true;
+    }
+
+    if (!GetDatabaseItems(playlist, items, strBaseDir, filter))
+      return false;
+
+    // the listing handed out is changed by its users, keep a copy of our own
+    std::shared_ptr<CFileItemList> listing(new CFileItemList);
+    listing->Copy(items);
+
+    CSingleLock lock(cacheSection);
+    cachedListings.remove_if([&key](const SCachedListing& listing) { return listing.key == key; });
+    cachedListings.push_front(SCachedListing{key, videoChanges, audioChanges, now, std::move(listing)});
+    if (cachedListings.size() > CACHE_MAX_LISTINGS)
+      cachedListings.pop_back();
+
+    return true;
+  }
+
+  bool CSmartPlaylistDirectory::GetDatabaseItems(const CSmartPlaylist &playlist, CFileItemList& items, const std::string &strBaseDir, bool filter)
   {
     bool success = false, success2 = false;
     std::vector<std::string> virtualFolders;
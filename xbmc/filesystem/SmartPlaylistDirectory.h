@@ -29,5 +29,8 @@ namespace XFILE
     static bool GetDirectory(const CSmartPlaylist &playlist, CFileItemList& items, const std::string &strBaseDir = "", bool filter = false);
 
     static std::string GetPlaylistByName(const std::string& name, const std::string& playlistType);
+
+  private:
+    static bool GetDatabaseItems(const CSmartPlaylist &playlist, CFileItemList& items, const std::string &strBaseDir, bool filter);
   };
 }
@@ -15,6 +15,8 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
 #include "utils/log.h"
 #include "utils/URIUtils.h"
 
@@ -24,6 +26,15 @@
 #include "utils/StringUtils.h"
 #endif
 
+#define MAX_TRANSLATED_FOLDERS 64
+
+namespace
+{
+// translations of the special paths the roots are mapped to, valid until a root is remapped
+CCriticalSection folderSection;
+std::map<std::string, std::string> translatedFolders;
+}
+
 const CProfileManager *CSpecialProtocol::m_profileManager = nullptr;
 
 void CSpecialProtocol::RegisterProfileManager(const CProfileManager &profileManager)
@@ -104,13 +115,11 @@ bool CSpecialProtocol::ComparePath(const std::string &path1, const std::string &
 
 std::string CSpecialProtocol::TranslatePath(const std::string &path)
 {
-  CURL url(path);
   // check for special-protocol, if not, return
-  if (!url.IsProtocol("special"))
-  {
+  if (!URIUtils::IsProtocol(path, "special"))
     return path;
-  }
-  return TranslatePath(url);
+
+  return TranslatePath(CURL(path));
 }
 
 std::string CSpecialProtocol::TranslatePath(const CURL &url)
@@ -132,7 +141,7 @@ std::string CSpecialProtocol::TranslatePath(const CURL &url)
 
   std::string FullFileName = url.GetFileName();
 
-  std::string translatedPath;
+  std::string basePath;
   std::string FileName;
   std::string RootDir;
 
@@ -149,29 +158,30 @@ std::string CSpecialProtocol::TranslatePath(const CURL &url)
     RootDir = FullFileName;
 
   if (RootDir == "subtitles")
-    translatedPath = URIUtils::AddFileToFolder(CServiceBroker::GetSettingsComponent()->GetSettings()->GetString(CSettings::SETTING_SUBTITLES_CUSTOMPATH), FileName);
+    basePath = CServiceBroker::GetSettingsComponent()->GetSettings()->GetString(CSettings::SETTING_SUBTITLES_CUSTOMPATH);
   else if (RootDir == "userdata" && m_profileManager)
-    translatedPath = URIUtils::AddFileToFolder(m_profileManager->GetUserDataFolder(), FileName);
+    basePath = m_profileManager->GetUserDataFolder();
   else if (RootDir == "database" && m_profileManager)
-    translatedPath = URIUtils::AddFileToFolder(m_profileManager->GetDatabaseFolder(), FileName);
+    basePath = m_profileManager->GetDatabaseFolder();
   else if (RootDir == "thumbnails" && m_profileManager)
-    translatedPath = URIUtils::AddFileToFolder(m_profileManager->GetThumbnailsFolder(), FileName);
+    basePath = m_profileManager->GetThumbnailsFolder();
   else if (RootDir == "recordings" || RootDir == "cdrips")
-    translatedPath = URIUtils::AddFileToFolder(CServiceBroker::GetSettingsComponent()->GetSettings()->GetString(CSettings::SETTING_AUDIOCDS_RECORDINGPATH), FileName);
+    basePath = CServiceBroker::GetSettingsComponent()->GetSettings()->GetString(CSettings::SETTING_AUDIOCDS_RECORDINGPATH);
   else if (RootDir == "screenshots")
-    translatedPath = URIUtils::AddFileToFolder(CServiceBroker::GetSettingsComponent()->GetSettings()->GetString(CSettings::SETTING_DEBUG_SCREENSHOTPATH), FileName);
+    basePath = CServiceBroker::GetSettingsComponent()->GetSettings()->GetString(CSettings::SETTING_DEBUG_SCREENSHOTPATH);
   else if (RootDir == "musicartistsinfo")
-    translatedPath = URIUtils::AddFileToFolder(CServiceBroker::GetSettingsComponent()->GetSettings()->GetString(CSettings::SETTING_MUSICLIBRARY_ARTISTSFOLDER), FileName);
+    basePath = CServiceBroker::GetSettingsComponent()->GetSettings()->GetString(CSettings::SETTING_MUSICLIBRARY_ARTISTSFOLDER);
   else if (RootDir == "musicplaylists")
-    translatedPath = URIUtils::AddFileToFolder(CUtil::MusicPlaylistsLocation(), FileName);
+    basePath = CUtil::MusicPlaylistsLocation();
   else if (RootDir == "videoplaylists")
-    translatedPath = URIUtils::AddFileToFolder(CUtil::VideoPlaylistsLocation(), FileName);
+    basePath = CUtil::VideoPlaylistsLocation();
   else if (RootDir == "skin")
   {
     auto winSystem = CServiceBroker::GetWinSystem();
     // windowing may not have been initialized yet
-    if (winSystem)
-      translatedPath = URIUtils::AddFileToFolder(winSystem->GetGfxContext().GetMediaDir(), FileName);
+    if (!winSystem)
+      return "";
+    basePath = winSystem->GetGfxContext().GetMediaDir();
   }
   // from here on, we have our "real" special paths
   else if (RootDir == "xbmc" ||
@@ -187,21 +197,38 @@ std::string CSpecialProtocol::TranslatePath(const CURL &url)
            RootDir == "frameworks" ||
            RootDir == "logpath")
   {
-    std::string basePath = GetPath(RootDir);
-    if (!basePath.empty())
-      translatedPath = URIUtils::AddFileToFolder(basePath, FileName);
-    else
-      translatedPath.clear();
+    basePath = GetPath(RootDir);
+    if (basePath.empty())
+      return "";
   }
+  else
+    return "";
 
-  // check if we need to recurse in
-  if (URIUtils::IsSpecial(translatedPath))
-  { // we need to recurse in, as there may be multiple translations required
-    return TranslatePath(translatedPath);
-  }
+  // the folders of most roots are special paths themselves, e.g. special://masterprofile/Database
+  if (URIUtils::IsSpecial(basePath))
+    basePath = TranslateFolder(basePath);
 
   // Validate the final path, just in case
-  return CUtil::ValidatePath(translatedPath);
+  return CUtil::ValidatePath(URIUtils::AddFileToFolder(basePath, FileName));
+}
+
+std::string CSpecialProtocol::TranslateFolder(const std::string &folder)
+{
+  {
+    CSingleLock lock(folderSection);
+    auto it = translatedFolders.find(folder);
+    if (it != translatedFolders.end())
+      return it->second;
+  }
+
+  std::string translated = TranslatePath(folder);
+
+  CSingleLock lock(folderSection);
+  // the folders come from a handful of settings, only a changing setting adds more of them
+  if (translatedFolders.size() >= MAX_TRANSLATED_FOLDERS)
+    translatedFolders.clear();
+  translatedFolders[folder] = translated;
+  return translated;
 }
 
 std::string CSpecialProtocol::TranslatePathConvertCase(const std::string& path)
@@ -289,6 +316,9 @@ void CSpecialProtocol::LogPaths()
 void CSpecialProtocol::SetPath(const std::string &key, const std::string &path)
 {
   m_pathMap[key] = path;
+
+  CSingleLock lock(folderSection);
+  translatedFolders.clear();
 }
 
 std::string CSpecialProtocol::GetPath(const std::string &key)
@@ -72,6 +72,7 @@ private:
 
   static void SetPath(const std::string &key, const std::string &path);
   static std::string GetPath(const std::string &key);
+  static std::string TranslateFolder(const std::string &folder);
 
   static std::map<std::string, std::string> m_pathMap;
 };
@@ -58,7 +58,7 @@ bool CXbtFile::Open(const CURL& url)
   {
     m_frameStartPositions.push_back(frameStartPosition);
 
-    frameStartPosition += frame.GetUnpackedSize();
+    frameStartPosition += frame.GetImageSize();
   }
 
   m_frameIndex = 0;
@@ -182,7 +182,7 @@ ssize_t CXbtFile::Read(void* lpBuf, size_t uiBufSize)
     }
 
     // determine how many bytes we need to copy from the current frame
-    uint64_t remainingBytesInFrame = frame.GetUnpackedSize() - m_positionWithinFrame;
+    uint64_t remainingBytesInFrame = frame.GetImageSize() - m_positionWithinFrame;
     size_t bytesToCopy = remaining;
     if (remainingBytesInFrame <= SIZE_MAX)
       bytesToCopy = std::min(remaining, static_cast<size_t>(remainingBytesInFrame));
@@ -194,7 +194,7 @@ ssize_t CXbtFile::Read(void* lpBuf, size_t uiBufSize)
     remaining -= bytesToCopy;
 
     // check if we need to go to the next frame and there is a next frame
-    if (m_positionWithinFrame >= frame.GetUnpackedSize() && m_frameIndex < frames.size() - 1)
+    if (m_positionWithinFrame >= frame.GetImageSize() && m_frameIndex < frames.size() - 1)
     {
       m_positionWithinFrame = 0;
       m_frameIndex += 1;
@@ -262,7 +262,7 @@ int64_t CXbtFile::Seek(int64_t iFilePosition, int iWhence)
 
     int64_t remainingBytesToSeek = newPosition - m_positionTotal;
     // check if the new position is within the current frame
-    uint64_t remainingBytesInFrame = frame.GetUnpackedSize() - m_positionWithinFrame;
+    uint64_t remainingBytesInFrame = frame.GetImageSize() - m_positionWithinFrame;
     if (static_cast<uint64_t>(remainingBytesToSeek) < remainingBytesInFrame)
     {
       m_positionWithinFrame += remainingBytesToSeek;
@@ -11,9 +11,13 @@
 #include "URL.h"
 #include "guilib/XBTF.h"
 #include "guilib/XBTFReader.h"
+#include "threads/SystemClock.h"
 
 #include <utility>
 
+// Textures are looked up by the hundreds, the XBT file is checked for modifications at most this often
+#define MODIFICATION_CHECK_INTERVAL_MS 1000
+
 namespace XFILE
 {
 
@@ -94,9 +98,16 @@ CXbtManager::XBTFReaders::const_iterator CXbtManager::ProcessFile(const CURL& pa
   auto it = GetReader(filePath);
   if (it != m_readers.end())
   {
+    const unsigned int now = XbmcThreads::SystemClockMillis();
+    if (now - it->second.lastCheck < MODIFICATION_CHECK_INTERVAL_MS)
+      return it;
+
     // check if the XBT file has been modified
     if (it->second.reader->GetLastModificationTimestamp() <= it->second.lastModification)
+    {
+      it->second.lastCheck = now;
       return it;
+    }
 
     // the XBT file has been modified so close and remove it from the cache
     // it will be re-opened by the following logic
@@ -110,7 +121,8 @@ CXbtManager::XBTFReaders::const_iterator CXbtManager::ProcessFile(const CURL& pa
 
   XBTFReader xbtfReader = {
     reader,
-    reader->GetLastModificationTimestamp()
+    reader->GetLastModificationTimestamp(),
+    XbmcThreads::SystemClockMillis()
   };
   std::pair<XBTFReaders::iterator, bool> result = m_readers.insert(std::make_pair(filePath, xbtfReader));
   return result.first;
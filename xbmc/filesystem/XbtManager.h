@@ -43,6 +43,7 @@ private:
   {
     CXBTFReaderPtr reader;
     time_t lastModification;
+    unsigned int lastCheck;
   };
   using XBTFReaders = std::map<std::string, XBTFReader>;
 
@@ -154,12 +154,14 @@ bool CZeroconfDirectory::GetDirectory(const CURL& url, CFileItemList &items)
   if(path.empty())
   {
     std::vector<CZeroconfBrowser::ZeroconfService> found_services = CZeroconfBrowser::GetInstance()->GetFoundServices();
+    std::vector<CZeroconfBrowser::ZeroconfService> listed_services;
     for (auto& it : found_services)
     {
       //only use discovered services we can connect to through directory
       std::string tmp;
       if (GetXBMCProtocol(it.GetType(), tmp))
       {
+        listed_services.push_back(it);
         CFileItemPtr item(new CFileItem("", true));
         CURL url;
         url.SetProtocol("zeroconf");
@@ -176,6 +178,8 @@ bool CZeroconfDirectory::GetDirectory(const CURL& url, CFileItemList &items)
         items.Add(item);
       }
     }
+    //resolve them meanwhile, so opening one doesn't wait for it
+    CZeroconfBrowser::GetInstance()->PrefetchServices(listed_services);
     return true;
   }
   else
@@ -72,6 +72,26 @@ bool CZipFile::Open(const CURL&url)
     CLog::Log(LOGERROR,"FileZip: unable to open zip file %s!",url.GetHostName().c_str());
     return false;
   }
+
+  // the extra field of the local header may differ from the central one, so
+  // the compressed data is located from the local header just before it
+  char header[LHDR_SIZE];
+  SZipEntry local;
+  if (mFile.Seek(mZipItem.lhdrOffset,SEEK_SET) != mZipItem.lhdrOffset ||
+      mFile.Read(header, LHDR_SIZE) != LHDR_SIZE)
+  {
+    CLog::Log(LOGERROR,"FileZip: unable to read local header of %s!",url.GetFileName().c_str());
+    return false;
+  }
+  CZipManager::readHeader(header, local);
+  if (local.header != ZIP_LOCAL_HEADER)
+  {
+    CLog::Log(LOGERROR,"FileZip: broken local header of %s!",url.GetFileName().c_str());
+    return false;
+  }
+  mZipItem.elength = local.elength;
+  mZipItem.offset = mZipItem.lhdrOffset + LHDR_SIZE + local.flength + local.elength;
+
   mFile.Seek(mZipItem.offset,SEEK_SET);
   return InitDecompress();
 }
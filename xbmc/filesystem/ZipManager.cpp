@@ -11,21 +11,43 @@
 #include <algorithm>
 #include <utility>
 
+#include "Directory.h"
 #include "File.h"
+#include "FileItem.h"
 #include "URL.h"
 #if defined(TARGET_POSIX)
 #include "PlatformDefs.h"
 #endif
 #include "utils/CharsetConverter.h"
+#include "utils/Crc32.h"
 #include "utils/EndianSwap.h"
 #include "utils/log.h"
 #include "utils/RegExp.h"
+#include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 
 using namespace XFILE;
 
 static const size_t ZC_FLAG_EFS = 1 << 11; // general purpose bit 11 - zip holds utf-8 filenames
 
+// Central directories of remote zips, keyed by the path of the zip
+#define ZIP_INDEX_PATH "special://temp/zipindex/"
+#define ZIP_MAX_INDEXES 500
+// Bump when SZipEntry changes
+#define ZIP_INDEX_VERSION 1
+
+namespace
+{
+struct SZipIndexHeader
+{
+  uint32_t version = ZIP_INDEX_VERSION;
+  uint32_t pathLength = 0;
+  uint32_t count = 0;
+  int64_t size = 0;
+  int64_t date = 0;
+};
+}
+
 CZipManager::CZipManager() = default;
 
 CZipManager::~CZipManager() = default;
@@ -56,6 +78,25 @@ bool CZipManager::GetZipList(const CURL& url, std::vector<SZipEntry>& items)
     mZipDate.erase(it2);
   }
 
+  // the central directory of a remote zip is kept on disk, so it is read once per change of the zip
+  const bool bRemote = URIUtils::IsRemote(strFile);
+  if (!bRemote || !loadIndex(strFile, m_StatData.st_size, m_StatData.st_mtime, items))
+  {
+    if (!readCentralDirectory(strFile, items))
+      return false;
+
+    if (bRemote)
+      saveIndex(strFile, m_StatData.st_size, m_StatData.st_mtime, items);
+  }
+
+  // push date for update detection
+  mZipDate.insert(make_pair(strFile,m_StatData.st_mtime));
+  mZipMap.insert(make_pair(strFile,items));
+  return true;
+}
+
+bool CZipManager::readCentralDirectory(const std::string& strFile, std::vector<SZipEntry>& items)
+{
   CFile mFile;
   if (!mFile.Open(strFile))
   {
@@ -69,119 +110,81 @@ bool CZipManager::GetZipList(const CURL& url, std::vector<SZipEntry>& items)
                                  Endian_SwapLE32(hdr) != ZIP_SPLIT_ARCHIVE_HEADER))
   {
     CLog::Log(LOGDEBUG,"ZipManager: not a zip file!");
-    mFile.Close();
     return false;
   }
 
   if (Endian_SwapLE32(hdr) == ZIP_SPLIT_ARCHIVE_HEADER)
     CLog::LogF(LOGWARNING, "ZIP split archive header found. Trying to process as a single archive..");
 
-  // push date for update detection
-  mZipDate.insert(make_pair(strFile,m_StatData.st_mtime));
-
-
-  // Look for end of central directory record
-  // Zipfile comment may be up to 65535 bytes
-  // End of central directory record is 22 bytes (ECDREC_SIZE)
-  // -> need to check the last 65557 bytes
   int64_t fileSize = mFile.GetLength();
-  // Don't need to look in the last 18 bytes (ECDREC_SIZE-4)
-  // But as we need to do overlapping between blocks (3 bytes),
-  // we start the search at ECDREC_SIZE-1 from the end of file
-  if (fileSize < ECDREC_SIZE - 1)
+  if (fileSize < ECDREC_SIZE)
   {
     CLog::Log(LOGERROR, "ZipManager: Invalid zip file length: %" PRId64"", fileSize);
     return false;
   }
-  int searchSize = (int) std::min(static_cast<int64_t>(65557), fileSize-ECDREC_SIZE+1);
-  int blockSize = (int) std::min(1024, searchSize);
-  int nbBlock = searchSize / blockSize;
-  int extraBlockSize = searchSize % blockSize;
-  // Signature is on 4 bytes
-  // It could be between 2 blocks, so we need to read 3 extra bytes
-  auto_buffer buffer(blockSize + 3);
-  bool found = false;
-
-  // Loop through blocks starting at the end of the file (minus ECDREC_SIZE-1)
-  for (int nb=1; !found && (nb <= nbBlock); nb++)
-  {
-    mFile.Seek(fileSize-ECDREC_SIZE+1-(blockSize*nb),SEEK_SET);
-    if (mFile.Read(buffer.get(), blockSize + 3) != blockSize + 3)
-      return false;
-    for (int i=blockSize-1; !found && (i >= 0); i--)
-    {
-      if ( Endian_SwapLE32(*((unsigned int*)(buffer.get()+i))) == ZIP_END_CENTRAL_HEADER )
-      {
-        // Set current position to start of end of central directory
-        mFile.Seek(fileSize-ECDREC_SIZE+1-(blockSize*nb)+i,SEEK_SET);
-        found = true;
-      }
-    }
-  }
 
-  // If not found, look in the last block left...
-  if ( !found && (extraBlockSize > 0) )
+  // Read the end of central directory record along with the longest zipfile
+  // comment that may follow it in a single request
+  const size_t tailSize = static_cast<size_t>(std::min(static_cast<int64_t>(ECDREC_SIZE + ECDREC_MAX_COMMENT), fileSize));
+  const int64_t tailOffset = fileSize - tailSize;
+  auto_buffer tail(tailSize);
+  if (mFile.Seek(tailOffset, SEEK_SET) != tailOffset ||
+      mFile.Read(tail.get(), tailSize) != static_cast<ssize_t>(tailSize))
+    return false;
+
+  // Look for the record from the end, it is at least ECDREC_SIZE bytes long
+  const char* ecdrec = nullptr;
+  for (size_t i = tailSize - ECDREC_SIZE + 1; !ecdrec && i-- > 0;)
   {
-    mFile.Seek(fileSize-ECDREC_SIZE+1-searchSize,SEEK_SET);
-    if (mFile.Read(buffer.get(), extraBlockSize + 3) != extraBlockSize + 3)
-      return false;
-    for (int i=extraBlockSize-1; !found && (i >= 0); i--)
-    {
-      if ( Endian_SwapLE32(*((unsigned int*)(buffer.get()+i))) == ZIP_END_CENTRAL_HEADER )
-      {
-        // Set current position to start of end of central directory
-        mFile.Seek(fileSize-ECDREC_SIZE+1-searchSize+i,SEEK_SET);
-        found = true;
-      }
-    }
+    if (Endian_SwapLE32(*((const unsigned int*)(tail.get() + i))) == ZIP_END_CENTRAL_HEADER)
+      ecdrec = tail.get() + i;
   }
 
-  buffer.clear();
-
-  if ( !found )
+  if (!ecdrec)
   {
     CLog::Log(LOGDEBUG,"ZipManager: broken file %s!",strFile.c_str());
-    mFile.Close();
     return false;
   }
 
-  unsigned int cdirOffset, cdirSize;
-  // Get size of the central directory
-  mFile.Seek(12,SEEK_CUR);
-  if (mFile.Read(&cdirSize, 4) != 4)
-    return false;
-  cdirSize = Endian_SwapLE32(cdirSize);
-  // Get Offset of start of central directory with respect to the starting disk number
-  if (mFile.Read(&cdirOffset, 4) != 4)
+  // Size of the central directory and offset of its start with respect to the starting disk number
+  const unsigned int cdirSize = Endian_SwapLE32(*((const unsigned int*)(ecdrec + 12)));
+  const unsigned int cdirOffset = Endian_SwapLE32(*((const unsigned int*)(ecdrec + 16)));
+  if (static_cast<int64_t>(cdirOffset) + cdirSize > fileSize)
+  {
+    CLog::Log(LOGDEBUG,"ZipManager: broken file %s!",strFile.c_str());
     return false;
-  cdirOffset = Endian_SwapLE32(cdirOffset);
+  }
 
-  // Go to the start of central directory
-  mFile.Seek(cdirOffset,SEEK_SET);
+  // The central directory of small zips was read along with the tail
+  auto_buffer buffer;
+  const char* cdir;
+  if (cdirOffset >= tailOffset)
+    cdir = tail.get() + (cdirOffset - tailOffset);
+  else
+  {
+    buffer.allocate(cdirSize);
+    if (mFile.Seek(cdirOffset, SEEK_SET) != cdirOffset ||
+        mFile.Read(buffer.get(), cdirSize) != static_cast<ssize_t>(cdirSize))
+      return false;
+    cdir = buffer.get();
+  }
 
   CRegExp pathTraversal;
   pathTraversal.RegComp(PATH_TRAVERSAL);
 
-  char temp[CHDR_SIZE];
-  while (mFile.GetPosition() < cdirOffset + cdirSize)
+  size_t pos = 0;
+  while (pos + CHDR_SIZE <= cdirSize)
   {
     SZipEntry ze;
-    if (mFile.Read(temp, CHDR_SIZE) != CHDR_SIZE)
-      return false;
-    readCHeader(temp, ze);
-    if (ze.header != ZIP_CENTRAL_HEADER)
+    readCHeader(cdir + pos, ze);
+    if (ze.header != ZIP_CENTRAL_HEADER || pos + CHDR_SIZE + ze.flength > cdirSize)
     {
       CLog::Log(LOGDEBUG,"ZipManager: broken file %s!",strFile.c_str());
-      mFile.Close();
       return false;
     }
 
     // Get the filename just after the central file header
-    auto_buffer bufName(ze.flength);
-    if (mFile.Read(bufName.get(), ze.flength) != ze.flength)
-      return false;
-    std::string strName(bufName.get(), bufName.size());
-    bufName.clear();
+    std::string strName(cdir + pos + CHDR_SIZE, ze.flength);
     if ((ze.flags & ZC_FLAG_EFS) == 0)
     {
       std::string tmp(strName);
@@ -191,29 +194,14 @@ bool CZipManager::GetZipList(const CURL& url, std::vector<SZipEntry>& items)
     strncpy(ze.name, strName.c_str(), strName.size() > 254 ? 254 : strName.size());
 
     // Jump after central file header extra field and file comment
-    mFile.Seek(ze.eclength + ze.clength,SEEK_CUR);
+    pos += CHDR_SIZE + ze.flength + ze.eclength + ze.clength;
 
+    // The local file header extra field length differs from the central one, so the
+    // offset of the compressed data is only known once CZipFile reads the local header
     if (pathTraversal.RegFind(strName) < 0)
       items.push_back(ze);
   }
 
-  /* go through list and figure out file header lengths */
-  for (auto& ze : items)
-  {
-    // Go to the local file header to get the extra field length
-    // !! local header extra field length != central file header extra field length !!
-    mFile.Seek(ze.lhdrOffset+28,SEEK_SET);
-    if (mFile.Read(&(ze.elength), 2) != 2)
-      return false;
-    ze.elength = Endian_SwapLE16(ze.elength);
-
-    // Compressed data offset = local header offset + size of local header + filename length + local file header extra field length
-    ze.offset = ze.lhdrOffset + LHDR_SIZE + ze.flength + ze.elength;
-
-  }
-
-  mZipMap.insert(make_pair(strFile,items));
-  mFile.Close();
   return true;
 }
 
@@ -222,20 +210,18 @@ bool CZipManager::GetZipEntry(const CURL& url, SZipEntry& item)
   std::string strFile = url.GetHostName();
 
   std::map<std::string, std::vector<SZipEntry> >::iterator it = mZipMap.find(strFile);
-  std::vector<SZipEntry> items;
   if (it == mZipMap.end()) // we need to list the zip
   {
-    GetZipList(url,items);
-  }
-  else
-  {
-    items = it->second;
+    std::vector<SZipEntry> items;
+    if (!GetZipList(url, items))
+      return false;
+    it = mZipMap.find(strFile);
   }
 
   std::string strFileName = url.GetFileName();
-  for (const auto& it2 : items)
+  for (const auto& it2 : it->second)
   {
-    if (std::string(it2.name) == strFileName)
+    if (strFileName == it2.name)
     {
       item = it2;
       return true;
@@ -318,4 +304,72 @@ void CZipManager::release(const std::string& strPath)
   }
 }
 
+bool CZipManager::loadIndex(const std::string& strFile, int64_t size, int64_t date, std::vector<SZipEntry>& items)
+{
+  CFile file;
+  if (!file.Open(getIndexPath(strFile)))
+    return false;
+
+  SZipIndexHeader header;
+  if (file.Read(&header, sizeof(header)) != static_cast<ssize_t>(sizeof(header)) ||
+      header.version != ZIP_INDEX_VERSION || header.size != size || header.date != date ||
+      file.GetLength() != static_cast<int64_t>(sizeof(header) + header.pathLength + header.count * sizeof(SZipEntry)))
+    return false;
+
+  // the name of the index is a hash, make sure it belongs to this zip
+  std::string strPath(header.pathLength, '\0');
+  if (file.Read(&strPath[0], header.pathLength) != static_cast<ssize_t>(header.pathLength) || strPath != strFile)
+    return false;
+
+  std::vector<SZipEntry> entries(header.count);
+  const ssize_t entriesSize = header.count * sizeof(SZipEntry);
+  if (file.Read(entries.data(), entriesSize) != entriesSize)
+    return false;
+
+  items.insert(items.end(), entries.begin(), entries.end());
+  return true;
+}
+
+void CZipManager::saveIndex(const std::string& strFile, int64_t size, int64_t date, const std::vector<SZipEntry>& items)
+{
+  if (!mIndexesPruned)
+  {
+    mIndexesPruned = true;
+    if (!CDirectory::Exists(ZIP_INDEX_PATH))
+      CDirectory::Create(ZIP_INDEX_PATH);
+    else
+    {
+      CFileItemList indexes;
+      CDirectory::GetDirectory(ZIP_INDEX_PATH, indexes, ".idx", DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_BYPASS_CACHE);
+      if (indexes.Size() > ZIP_MAX_INDEXES)
+      {
+        indexes.Sort(SortByDate, SortOrderAscending);
+        for (int i = 0; i < indexes.Size() - ZIP_MAX_INDEXES; i++)
+          CFile::Delete(indexes[i]->GetPath());
+      }
+    }
+  }
+
+  SZipIndexHeader header;
+  header.size = size;
+  header.date = date;
+  header.pathLength = static_cast<uint32_t>(strFile.size());
+  header.count = static_cast<uint32_t>(items.size());
+
+  CFile file;
+  if (!file.OpenForWrite(getIndexPath(strFile), true))
+    return;
+
+  if (file.Write(&header, sizeof(header)) != static_cast<ssize_t>(sizeof(header)) ||
+      file.Write(strFile.c_str(), strFile.size()) != static_cast<ssize_t>(strFile.size()) ||
+      file.Write(items.data(), items.size() * sizeof(SZipEntry)) != static_cast<ssize_t>(items.size() * sizeof(SZipEntry)))
+  {
+    file.Close();
+    CFile::Delete(getIndexPath(strFile));
+  }
+}
 
+std::string CZipManager::getIndexPath(const std::string& strFile)
+{
+  return StringUtils::Format(ZIP_INDEX_PATH "%08x.idx", Crc32::ComputeFromLowerCase(strFile));
+}
@@ -17,6 +17,8 @@
 #define LHDR_SIZE 30
 #define CHDR_SIZE 46
 #define ECDREC_SIZE 22
+// The end of central directory record is followed by a comment of up to 65535 bytes
+#define ECDREC_MAX_COMMENT 65535
 
 #include <string>
 #include <vector>
@@ -41,7 +43,7 @@ struct SZipEntry {
   unsigned short eclength = 0; // extra field length (central file header)
   unsigned short clength = 0; // file comment length (central file header)
   unsigned int lhdrOffset = 0; // Relative offset of local header
-  int64_t offset = 0;         // offset in file to compressed data
+  int64_t offset = 0;         // offset in file to compressed data, set once the local header is read
   char name[255];
 
   SZipEntry()
@@ -64,8 +66,14 @@ public:
   static void readHeader(const char* buffer, SZipEntry& info);
   static void readCHeader(const char* buffer, SZipEntry& info);
 private:
+  bool readCentralDirectory(const std::string& strFile, std::vector<SZipEntry>& items);
+  bool loadIndex(const std::string& strFile, int64_t size, int64_t date, std::vector<SZipEntry>& items);
+  void saveIndex(const std::string& strFile, int64_t size, int64_t date, const std::vector<SZipEntry>& items);
+  static std::string getIndexPath(const std::string& strFile);
+
   std::map<std::string,std::vector<SZipEntry> > mZipMap;
   std::map<std::string,int64_t> mZipDate;
+  bool mIndexesPruned = false;
 };
 
 extern CZipManager g_ZipManager;
@@ -0,0 +1,77 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/CircularCache.h"
+
+#include <vector>
+
+#include <gtest/gtest.h>
+
+using namespace XFILE;
+
+namespace
+{
+const size_t WINDOW = 1024 * 1024;
+
+void Fill(CCircularCache& cache, int64_t start, size_t len)
+{
+  std::vector<char> data(len);
+  for (size_t i = 0; i < len; i++)
+    data[i] = static_cast<char>((start + i) % 251);
+
+  size_t written = 0;
+  while (written < len)
+  {
+    int ret = cache.WriteToCache(data.data() + written, len - written);
+    ASSERT_GT(ret, 0);
+    written += ret;
+  }
+}
+}
+
+TEST(TestCircularCache, RetainedRange)
+{
+  CCircularCache cache(WINDOW, WINDOW / 4, 2 * WINDOW);
+  ASSERT_EQ(CACHE_RC_OK, cache.Open());
+
+  Fill(cache, 0, WINDOW);
+
+  // jump away, the first window is retained
+  EXPECT_TRUE(cache.Reset(10 * WINDOW, false));
+  EXPECT_EQ(WINDOW, static_cast<size_t>(cache.CachedDataEndPosIfSeekTo(100)));
+  EXPECT_FALSE(cache.IsCachedPosition(100));
+
+  Fill(cache, 10 * WINDOW, WINDOW / 2);
+
+  // and come back, the data is served from memory
+  EXPECT_FALSE(cache.Reset(100, false));
+  EXPECT_EQ(WINDOW, static_cast<size_t>(cache.CachedDataEndPos()));
+
+  char buf[16];
+  ASSERT_EQ(16, cache.ReadFromCache(buf, sizeof(buf)));
+  for (int i = 0; i < 16; i++)
+    EXPECT_EQ(static_cast<char>((100 + i) % 251), buf[i]);
+
+  // the window we left is retained as well
+  EXPECT_EQ(static_cast<int64_t>(10 * WINDOW + WINDOW / 2), cache.CachedDataEndPosIfSeekTo(10 * WINDOW));
+
+  cache.Close();
+}
+
+TEST(TestCircularCache, NoRetain)
+{
+  CCircularCache cache(WINDOW, WINDOW / 4);
+  ASSERT_EQ(CACHE_RC_OK, cache.Open());
+
+  Fill(cache, 0, WINDOW);
+
+  EXPECT_TRUE(cache.Reset(10 * WINDOW, false));
+  EXPECT_EQ(100, cache.CachedDataEndPosIfSeekTo(100));
+
+  cache.Close();
+}
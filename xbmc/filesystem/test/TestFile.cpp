@@ -11,6 +11,7 @@
 
 #include <errno.h>
 #include <string>
+#include <vector>
 
 #include <gtest/gtest.h>
 
@@ -123,6 +124,21 @@ TEST(TestFile, Exists)
   EXPECT_TRUE(XBMC_DELETETEMPFILE(file));
 }
 
+TEST(TestFile, ExistsBatch)
+{
+  XFILE::CFile *file;
+
+  ASSERT_NE(nullptr, file = XBMC_CREATETEMPFILE(""));
+  file->Close();
+  const std::string path = XBMC_TEMPFILEPATH(file);
+  const std::vector<bool> exists = XFILE::CFile::ExistsBatch({ path + ".missing", path, "" });
+  ASSERT_EQ(3U, exists.size());
+  EXPECT_FALSE(exists[0]);
+  EXPECT_TRUE(exists[1]);
+  EXPECT_FALSE(exists[2]);
+  EXPECT_TRUE(XBMC_DELETETEMPFILE(file));
+}
+
 TEST(TestFile, Stat)
 {
   XFILE::CFile *file;
@@ -0,0 +1,279 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GameDatabase.h"
+
+#include "FileItem.h"
+#include "dbwrappers/dataset.h"
+#include "games/tags/GameInfoTag.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+#include "utils/log.h"
+
+#include <cinttypes>
+
+using namespace KODI;
+using namespace GAME;
+
+bool CGameDatabase::Open()
+{
+  return CDatabase::Open();
+}
+
+void CGameDatabase::CreateTables()
+{
+  CLog::Log(LOGINFO, "create game table");
+  m_pDS->exec("CREATE TABLE game (idGame integer primary key, strPath text, strFileName text, iSize integer, "
+              "strModified text, iCrc integer, strTitle text, strPlatform text, strGameClient text)");
+
+  CLog::Log(LOGINFO, "create genre table");
+  m_pDS->exec("CREATE TABLE genre (idGenre integer primary key, strGenre text)");
+  m_pDS->exec("CREATE TABLE genre_link (idGenre integer, idGame integer)");
+}
+
+void CGameDatabase::CreateAnalytics()
+{
+  CLog::Log(LOGINFO, "%s creating indices", __FUNCTION__);
+  m_pDS->exec("CREATE UNIQUE INDEX idxGame ON game(strPath, strFileName)");
+  m_pDS->exec("CREATE INDEX idxGamePlatform ON game(strPlatform, strTitle)");
+  m_pDS->exec("CREATE INDEX idxGameCrc ON game(iCrc)");
+  m_pDS->exec("CREATE UNIQUE INDEX idxGenre ON genre(strGenre)");
+  m_pDS->exec("CREATE UNIQUE INDEX idxGenreLink ON genre_link(idGenre, idGame)");
+  m_pDS->exec("CREATE INDEX idxGenreLink2 ON genre_link(idGame)");
+
+  CLog::Log(LOGINFO, "%s creating triggers", __FUNCTION__);
+  m_pDS->exec("CREATE TRIGGER gameDelete AFTER delete ON game FOR EACH ROW BEGIN "
+              "delete from genre_link where genre_link.idGame=old.idGame; END");
+}
+
+bool CGameDatabase::GetGameFiles(const std::string &path, std::map<std::string, GameFile> &files)
+{
+  try
+  {
+    if (!m_pDB)
+      return false;
+    if (!m_pDS)
+      return false;
+
+    std::string sql = PrepareSQL("SELECT idGame, strFileName, iSize, strModified FROM game WHERE strPath='%s'", path.c_str());
+    m_pDS->query(sql);
+    while (!m_pDS->eof())
+    {
+      GameFile &file = files[m_pDS->fv(1).get_asString()];
+      file.idGame = m_pDS->fv(0).get_asInt();
+      file.size = m_pDS->fv(2).get_asInt64();
+      file.modified = m_pDS->fv(3).get_asString();
+      m_pDS->next();
+    }
+    m_pDS->close();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s, failed on path '%s'", __FUNCTION__, path.c_str());
+  }
+  return false;
+}
+
+int CGameDatabase::AddGame(const std::string &path, const std::string &fileName, int64_t size,
+                           const std::string &modified, uint32_t crc, const CGameInfoTag &tag)
+{
+  try
+  {
+    if (!m_pDB)
+      return -1;
+    if (!m_pDS)
+      return -1;
+
+    BeginTransaction();
+
+    std::string sql = PrepareSQL("DELETE FROM game WHERE strPath='%s' AND strFileName='%s'", path.c_str(), fileName.c_str());
+    m_pDS->exec(sql);
+
+    sql = PrepareSQL("INSERT INTO game (idGame, strPath, strFileName, iSize, strModified, iCrc, strTitle, strPlatform, strGameClient) "
+                     "VALUES (NULL, '%s', '%s', %" PRId64 ", '%s', %u, '%s', '%s', '%s')",
+                     path.c_str(), fileName.c_str(), size, modified.c_str(), crc,
+                     tag.GetTitle().c_str(), tag.GetPlatform().c_str(), tag.GetGameClient().c_str());
+    m_pDS->exec(sql);
+    const int idGame = static_cast<int>(m_pDS->lastinsertid());
+
+    for (const std::string &genre : tag.GetGenres())
+    {
+      const int idGenre = AddGenre(genre);
+      if (idGenre >= 0)
+        m_pDS->exec(PrepareSQL("INSERT OR IGNORE INTO genre_link (idGenre, idGame) VALUES (%i, %i)", idGenre, idGame));
+    }
+
+    CommitTransaction();
+    return idGame;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s, failed on '%s'", __FUNCTION__, fileName.c_str());
+    RollbackTransaction();
+  }
+  return -1;
+}
+
+int CGameDatabase::AddGenre(const std::string &genre)
+{
+  std::string sql = PrepareSQL("SELECT idGenre FROM genre WHERE strGenre='%s'", genre.c_str());
+  m_pDS->query(sql);
+  if (!m_pDS->eof())
+  {
+    const int idGenre = m_pDS->fv(0).get_asInt();
+    m_pDS->close();
+    return idGenre;
+  }
+  m_pDS->close();
+
+  m_pDS->exec(PrepareSQL("INSERT INTO genre (idGenre, strGenre) VALUES (NULL, '%s')", genre.c_str()));
+  return static_cast<int>(m_pDS->lastinsertid());
+}
+
+bool CGameDatabase::RemoveGame(int idGame)
+{
+  return ExecuteQuery(PrepareSQL("DELETE FROM game WHERE idGame=%i", idGame));
+}
+
+bool CGameDatabase::RemoveGamesNotInPaths(const std::string &root, const std::set<std::string> &paths)
+{
+  try
+  {
+    if (!m_pDB)
+      return false;
+    if (!m_pDS)
+      return false;
+
+    std::vector<std::string> removedPaths;
+
+    std::string sql = PrepareSQL("SELECT DISTINCT strPath FROM game WHERE SUBSTR(strPath,1,%i)='%s'",
+                                 StringUtils::utf8_strlen(root.c_str()), root.c_str());
+    m_pDS->query(sql);
+    while (!m_pDS->eof())
+    {
+      std::string path = m_pDS->fv(0).get_asString();
+      if (paths.find(path) == paths.end())
+        removedPaths.push_back(std::move(path));
+      m_pDS->next();
+    }
+    m_pDS->close();
+
+    for (const std::string &path : removedPaths)
+    {
+      CLog::Log(LOGDEBUG, "%s, removing games of '%s'", __FUNCTION__, path.c_str());
+      m_pDS->exec(PrepareSQL("DELETE FROM game WHERE strPath='%s'", path.c_str()));
+    }
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s, failed on path '%s'", __FUNCTION__, root.c_str());
+  }
+  return false;
+}
+
+bool CGameDatabase::GetPlatforms(std::vector<std::string> &platforms)
+{
+  try
+  {
+    if (!m_pDB)
+      return false;
+    if (!m_pDS)
+      return false;
+
+    m_pDS->query("SELECT DISTINCT strPlatform FROM game WHERE strPlatform<>'' ORDER BY strPlatform");
+    while (!m_pDS->eof())
+    {
+      platforms.push_back(m_pDS->fv(0).get_asString());
+      m_pDS->next();
+    }
+    m_pDS->close();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed", __FUNCTION__);
+  }
+  return false;
+}
+
+bool CGameDatabase::GetGenres(std::vector<std::string> &genres)
+{
+  try
+  {
+    if (!m_pDB)
+      return false;
+    if (!m_pDS)
+      return false;
+
+    m_pDS->query("SELECT strGenre FROM genre WHERE EXISTS (SELECT 1 FROM genre_link WHERE genre_link.idGenre=genre.idGenre) "
+                 "ORDER BY strGenre");
+    while (!m_pDS->eof())
+    {
+      genres.push_back(m_pDS->fv(0).get_asString());
+      m_pDS->next();
+    }
+    m_pDS->close();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed", __FUNCTION__);
+  }
+  return false;
+}
+
+bool CGameDatabase::GetGames(CFileItemList &items, const std::string &platform, const std::string &genre)
+{
+  try
+  {
+    if (!m_pDB)
+      return false;
+    if (!m_pDS)
+      return false;
+
+    std::string sql = "SELECT idGame, strPath, strFileName, iSize, strTitle, strPlatform, strGameClient FROM game";
+    std::vector<std::string> conditions;
+    if (!platform.empty())
+      conditions.push_back(PrepareSQL("strPlatform='%s'", platform.c_str()));
+    if (!genre.empty())
+      conditions.push_back(PrepareSQL("idGame IN (SELECT idGame FROM genre_link JOIN genre ON genre.idGenre=genre_link.idGenre "
+                                      "WHERE strGenre='%s')", genre.c_str()));
+    if (!conditions.empty())
+      sql += " WHERE " + StringUtils::Join(conditions, " AND ");
+    sql += " ORDER BY strTitle";
+
+    m_pDS->query(sql);
+    while (!m_pDS->eof())
+    {
+      const std::string path = URIUtils::AddFileToFolder(m_pDS->fv(1).get_asString(), m_pDS->fv(2).get_asString());
+
+      CFileItemPtr item(new CFileItem(path, false));
+      item->SetLabel(m_pDS->fv(4).get_asString());
+      item->m_dwSize = m_pDS->fv(3).get_asInt64();
+
+      CGameInfoTag *tag = item->GetGameInfoTag();
+      tag->SetURL(path);
+      tag->SetTitle(m_pDS->fv(4).get_asString());
+      tag->SetPlatform(m_pDS->fv(5).get_asString());
+      tag->SetGameClient(m_pDS->fv(6).get_asString());
+      tag->SetLoaded(true);
+
+      items.Add(std::move(item));
+      m_pDS->next();
+    }
+    m_pDS->close();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed", __FUNCTION__);
+  }
+  return false;
+}
@@ -0,0 +1,94 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "dbwrappers/Database.h"
+
+#include <map>
+#include <set>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+class CFileItemList;
+
+namespace KODI
+{
+namespace GAME
+{
+  class CGameInfoTag;
+
+  /*!
+   * \brief A game file as stored in the library
+   */
+  struct GameFile
+  {
+    int idGame = -1;
+    int64_t size = 0;
+    std::string modified;
+  };
+
+  /*!
+   * \brief Library of the games found in the game sources
+   *
+   * Games are identified by the CRC32 of their contents and indexed by
+   * platform and genre, so browsing the library doesn't list directories.
+   */
+  class CGameDatabase : public CDatabase
+  {
+  public:
+    CGameDatabase() = default;
+    ~CGameDatabase() override = default;
+
+    bool Open() override;
+
+    /*!
+     * \brief Get the games of a folder, by file name
+     */
+    bool GetGameFiles(const std::string &path, std::map<std::string, GameFile> &files);
+
+    /*!
+     * \brief Add a game, or replace the game of the same file
+     *
+     * \return The ID of the game, or -1 on error
+     */
+    int AddGame(const std::string &path, const std::string &fileName, int64_t size,
+                const std::string &modified, uint32_t crc, const CGameInfoTag &tag);
+
+    bool RemoveGame(int idGame);
+
+    /*!
+     * \brief Remove the games below a folder that aren't in one of the given
+     *        folders, e.g. because the folder was deleted since the last scan
+     */
+    bool RemoveGamesNotInPaths(const std::string &root, const std::set<std::string> &paths);
+
+    bool GetPlatforms(std::vector<std::string> &platforms);
+    bool GetGenres(std::vector<std::string> &genres);
+
+    /*!
+     * \brief Get the games of a platform and/or a genre
+     *
+     * \param platform The platform, or empty for all platforms
+     * \param genre The genre, or empty for all genres
+     */
+    bool GetGames(CFileItemList &items, const std::string &platform, const std::string &genre);
+
+  protected:
+    void CreateTables() override;
+    void CreateAnalytics() override;
+    void UpdateTables(int version) override { }
+    int GetSchemaVersion() const override { return 1; }
+    const char *GetBaseDBName() const override { return "Games"; }
+
+  private:
+    int AddGenre(const std::string &genre);
+  };
+}
+}
@@ -0,0 +1,263 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GameLibraryScanner.h"
+
+#include "FileItem.h"
+#include "MediaSource.h"
+#include "ServiceBroker.h"
+#include "addons/BinaryAddonCache.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "filesystem/MultiPathDirectory.h"
+#include "games/GameUtils.h"
+#include "games/addons/GameClient.h"
+#include "games/tags/GameInfoTag.h"
+#include "settings/MediaSourceSettings.h"
+#include "threads/SingleLock.h"
+#include "utils/Crc32.h"
+#include "utils/StringUtils.h"
+#include "utils/URIUtils.h"
+#include "utils/log.h"
+
+#include <map>
+#include <vector>
+
+using namespace KODI;
+using namespace GAME;
+using namespace XFILE;
+
+// Commit the library after this many games or this many ms
+#define WRITE_BATCH_SIZE  500
+#define WRITE_BATCH_MS    2000
+
+#define CRC_CHUNK_SIZE    (64 * 1024)
+
+// Game clients that play any file don't add to the scan mask
+#define EXTENSION_WILDCARD  "*"
+
+CGameLibraryScanner::CGameLibraryScanner() :
+  CThread("GameLibraryScanner")
+{
+}
+
+CGameLibraryScanner::~CGameLibraryScanner()
+{
+  Stop();
+}
+
+void CGameLibraryScanner::Start(const std::string &path)
+{
+  CSingleLock lock(m_critSection);
+
+  if (IsRunning())
+    return;
+
+  m_path = path;
+  Create();
+}
+
+void CGameLibraryScanner::Stop()
+{
+  StopThread();
+}
+
+void CGameLibraryScanner::Process()
+{
+  std::vector<std::string> roots;
+
+  {
+    CSingleLock lock(m_critSection);
+    if (!m_path.empty())
+      roots.push_back(m_path);
+  }
+
+  if (roots.empty())
+  {
+    VECSOURCES *sources = CMediaSourceSettings::GetInstance().GetSources("games");
+    if (sources != nullptr)
+    {
+      for (const CMediaSource &source : *sources)
+      {
+        if (URIUtils::IsMultiPath(source.strPath))
+          CMultiPathDirectory::GetPaths(source.strPath, roots);
+        else
+          roots.push_back(source.strPath);
+      }
+    }
+  }
+
+  std::vector<std::string> extensions;
+  for (const std::string &extension : CGameUtils::GetGameExtensions())
+  {
+    if (extension != EXTENSION_WILDCARD)
+      extensions.push_back(extension);
+  }
+  if (roots.empty() || extensions.empty())
+    return;
+
+  const std::string mask = StringUtils::Join(extensions, "|");
+
+  if (!m_database.Open())
+  {
+    CLog::Log(LOGERROR, "GameLibraryScanner: Failed to open the game database");
+    return;
+  }
+
+  CLog::Log(LOGNOTICE, "GameLibraryScanner: Scanning %u folders", static_cast<unsigned int>(roots.size()));
+
+  m_database.BeginWriteBatch(WRITE_BATCH_SIZE, WRITE_BATCH_MS);
+
+  for (std::string &root : roots)
+  {
+    URIUtils::AddSlashAtEnd(root);
+
+    std::set<std::string> scannedPaths;
+    if (!ScanFolder(root, mask, scannedPaths))
+      break;
+
+    // Keep the games of sources that are offline
+    if (scannedPaths.empty())
+      continue;
+
+    // Folders that were not found anymore
+    m_database.RemoveGamesNotInPaths(root, scannedPaths);
+  }
+
+  m_database.CommitWriteBatch();
+  m_database.Close();
+
+  CLog::Log(LOGNOTICE, "GameLibraryScanner: Finished scan%s", m_bStop ? " (aborted)" : "");
+}
+
+bool CGameLibraryScanner::ScanFolder(const std::string &path, const std::string &mask, std::set<std::string> &scannedPaths)
+{
+  if (m_bStop)
+    return false;
+
+  CFileItemList items;
+  if (!CDirectory::GetDirectory(path, items, mask, DIR_FLAG_DEFAULTS))
+    return true;
+
+  scannedPaths.insert(path);
+
+  std::map<std::string, GameFile> knownFiles;
+  m_database.GetGameFiles(path, knownFiles);
+
+  for (const CFileItemPtr &item : items)
+  {
+    if (m_bStop)
+      return false;
+
+    if (item->m_bIsFolder)
+    {
+      std::string folder = item->GetPath();
+      URIUtils::AddSlashAtEnd(folder);
+      if (!ScanFolder(folder, mask, scannedPaths))
+        return false;
+      continue;
+    }
+
+    const std::string fileName = URIUtils::GetFileName(item->GetPath());
+
+    auto it = knownFiles.find(fileName);
+    if (it != knownFiles.end())
+    {
+      const GameFile &file = it->second;
+      const bool bUnchanged = file.size == item->m_dwSize &&
+                              file.modified == item->m_dateTime.GetAsDBDateTime();
+      knownFiles.erase(it);
+      if (bUnchanged)
+        continue;
+    }
+
+    AddGame(path, *item);
+    m_database.EndWriteBatchItem();
+  }
+
+  // Games that were deleted since the last scan
+  for (const auto &it : knownFiles)
+    m_database.RemoveGame(it.second.idGame);
+
+  return true;
+}
+
+bool CGameLibraryScanner::AddGame(const std::string &path, const CFileItem &item)
+{
+  CGameInfoTag tag;
+  FillInTag(item, tag);
+
+  const uint32_t crc = ComputeCrc(item.GetPath());
+
+  CLog::Log(LOGDEBUG, "GameLibraryScanner: Adding %s (platform: %s, crc: %08x)",
+            item.GetPath().c_str(), tag.GetPlatform().c_str(), crc);
+
+  return m_database.AddGame(path, URIUtils::GetFileName(item.GetPath()), item.m_dwSize,
+                            item.m_dateTime.GetAsDBDateTime(), crc, tag) >= 0;
+}
+
+uint32_t CGameLibraryScanner::ComputeCrc(const std::string &path)
+{
+  Crc32 crc;
+  crc.Reset();
+
+  CFile file;
+  if (file.Open(path))
+  {
+    std::vector<char> buffer(CRC_CHUNK_SIZE);
+    ssize_t bytesRead;
+    while ((bytesRead = file.Read(buffer.data(), buffer.size())) > 0)
+      crc.Compute(buffer.data(), static_cast<size_t>(bytesRead));
+  }
+
+  return crc;
+}
+
+void CGameLibraryScanner::FillInTag(const CFileItem &item, CGameInfoTag &tag)
+{
+  // Use the info provided by the VFS or add-on, if any
+  if (item.HasGameInfoTag())
+    tag = *item.GetGameInfoTag();
+
+  if (tag.GetTitle().empty())
+    tag.SetTitle(URIUtils::GetFileName(URIUtils::ReplaceExtension(item.GetPath(), "")));
+
+  if (tag.GetPlatform().empty() || tag.GetGameClient().empty())
+  {
+    std::string extension = URIUtils::GetExtension(item.GetPath());
+    StringUtils::ToLower(extension);
+
+    // A platform is only known for sure if a single game client plays the file
+    ADDON::VECADDONS addons;
+    CServiceBroker::GetBinaryAddonCache().GetInstalledAddons(addons, ADDON::ADDON_GAMEDLL);
+
+    GameClientPtr gameClient;
+    unsigned int gameClientCount = 0;
+    for (const auto &addon : addons)
+    {
+      GameClientPtr gc = std::static_pointer_cast<CGameClient>(addon);
+      if (!gc->SupportsAllExtensions() && gc->IsExtensionValid(extension))
+      {
+        gameClient = std::move(gc);
+        gameClientCount++;
+      }
+    }
+
+    if (gameClientCount == 1)
+    {
+      if (tag.GetPlatform().empty())
+        tag.SetPlatform(gameClient->Name());
+      if (tag.GetGameClient().empty())
+        tag.SetGameClient(gameClient->ID());
+    }
+    else if (tag.GetPlatform().empty() && extension.size() > 1)
+    {
+      tag.SetPlatform(extension.substr(1));
+    }
+  }
+}
@@ -0,0 +1,64 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "GameDatabase.h"
+#include "threads/CriticalSection.h"
+#include "threads/Thread.h"
+
+#include <set>
+#include <stdint.h>
+#include <string>
+
+class CFileItem;
+
+namespace KODI
+{
+namespace GAME
+{
+  /*!
+   * \brief Background scan of the game sources into the game library
+   *
+   * Files whose size and modification time didn't change since the last
+   * scan are skipped, so a rescan only reads new or modified games.
+   */
+  class CGameLibraryScanner : protected CThread
+  {
+  public:
+    CGameLibraryScanner();
+    ~CGameLibraryScanner() override;
+
+    /*!
+     * \brief Start a scan
+     *
+     * \param path The folder to scan, or empty to scan all game sources
+     */
+    void Start(const std::string &path);
+
+    void Stop();
+
+    bool IsScanning() const { return IsRunning(); }
+
+  protected:
+    // implementation of CThread
+    void Process() override;
+
+  private:
+    bool ScanFolder(const std::string &path, const std::string &mask, std::set<std::string> &scannedPaths);
+    bool AddGame(const std::string &path, const CFileItem &item);
+
+    static uint32_t ComputeCrc(const std::string &path);
+    static void FillInTag(const CFileItem &item, CGameInfoTag &tag);
+
+    CGameDatabase m_database;
+    std::string m_path;
+    CCriticalSection m_critSection;
+  };
+}
+}
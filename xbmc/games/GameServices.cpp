@@ -10,6 +10,7 @@
 
 #include "controllers/Controller.h"
 #include "controllers/ControllerManager.h"
+#include "games/GameLibraryScanner.h"
 #include "games/GameSettings.h"
 #include "profiles/ProfileManager.h"
 
@@ -23,7 +24,8 @@ CGameServices::CGameServices(CControllerManager &controllerManager,
   m_controllerManager(controllerManager),
   m_gameRenderManager(renderManager),
   m_profileManager(profileManager),
-  m_gameSettings(new CGameSettings())
+  m_gameSettings(new CGameSettings()),
+  m_gameLibraryScanner(new CGameLibraryScanner())
 {
 }
 
@@ -30,6 +30,7 @@ namespace RETRO
 namespace GAME
 {
   class CControllerManager;
+  class CGameLibraryScanner;
   class CGameSettings;
 
   class CGameServices
@@ -51,6 +52,8 @@ namespace GAME
 
     CGameSettings& GameSettings() { return *m_gameSettings; }
 
+    CGameLibraryScanner& GameLibraryScanner() { return *m_gameLibraryScanner; }
+
     RETRO::CGUIGameRenderManager &GameRenderManager() { return m_gameRenderManager; }
 
   private:
@@ -61,6 +64,7 @@ namespace GAME
 
     // Game services
     std::unique_ptr<CGameSettings> m_gameSettings;
+    std::unique_ptr<CGameLibraryScanner> m_gameLibraryScanner;
   };
 }
 }
@@ -25,6 +25,7 @@ namespace
   const std::string SETTING_GAMES_ENABLEAUTOSAVE = "gamesgeneral.enableautosave";
   const std::string SETTING_GAMES_ENABLEREWIND = "gamesgeneral.enablerewind";
   const std::string SETTING_GAMES_REWINDTIME = "gamesgeneral.rewindtime";
+  const std::string SETTING_GAMES_RUNAHEADFRAMES = "gamesgeneral.runaheadframes";
 }
 
 CGameSettings::CGameSettings()
@@ -34,6 +35,7 @@ CGameSettings::CGameSettings()
   m_settings->RegisterCallback(this, {
     SETTING_GAMES_ENABLEREWIND,
     SETTING_GAMES_REWINDTIME,
+    SETTING_GAMES_RUNAHEADFRAMES,
   });
 }
 
@@ -85,6 +87,13 @@ unsigned int CGameSettings::MaxRewindTimeSec()
   return static_cast<unsigned int>(std::max(rewindTimeSec, 0));
 }
 
+unsigned int CGameSettings::RunAheadFrames()
+{
+  int runAheadFrames = m_settings->GetInt(SETTING_GAMES_RUNAHEADFRAMES);
+
+  return static_cast<unsigned int>(std::max(runAheadFrames, 0));
+}
+
 void CGameSettings::OnSettingChanged(std::shared_ptr<const CSetting> setting)
 {
   if (setting == nullptr)
@@ -93,7 +102,8 @@ void CGameSettings::OnSettingChanged(std::shared_ptr<const CSetting> setting)
   const std::string& settingId = setting->GetId();
 
   if (settingId == SETTING_GAMES_ENABLEREWIND ||
-      settingId == SETTING_GAMES_REWINDTIME)
+      settingId == SETTING_GAMES_REWINDTIME ||
+      settingId == SETTING_GAMES_RUNAHEADFRAMES)
   {
     SetChanged();
     NotifyObservers(ObservableMessageSettingsChanged);
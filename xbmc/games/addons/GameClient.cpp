@@ -450,6 +450,12 @@ void CGameClient::RunFrame()
   }
 }
 
+void CGameClient::SetStreamsMuted(bool bAudioMuted, bool bVideoMuted)
+{
+  m_bAudioMuted = bAudioMuted;
+  m_bVideoMuted = bVideoMuted;
+}
+
 bool CGameClient::Serialize(uint8_t* data, size_t size)
 {
   if (data == nullptr || size == 0)
@@ -554,6 +560,15 @@ void CGameClient::cb_add_stream_data(void* kodiInstance, void *stream, const gam
   if (gameClientStream == nullptr)
     return;
 
+  CGameClient *gameClient = static_cast<CGameClient*>(kodiInstance);
+  if (gameClient != nullptr)
+  {
+    if (packet->type == GAME_STREAM_AUDIO && gameClient->m_bAudioMuted)
+      return;
+    if ((packet->type == GAME_STREAM_VIDEO || packet->type == GAME_STREAM_SW_FRAMEBUFFER) && gameClient->m_bVideoMuted)
+      return;
+  }
+
   gameClientStream->AddData(*packet);
 }
 
@@ -86,6 +86,12 @@ public:
   double GetSampleRate() const { return m_samplerate; }
   void RunFrame();
 
+  /*!
+   * @brief Drop the audio or video the game client outputs, used for
+   *        frames that are run but not presented
+   */
+  void SetStreamsMuted(bool bAudioMuted, bool bVideoMuted);
+
   // Access memory
   size_t SerializeSize() const { return m_serializeSize; }
   bool Serialize(uint8_t* data, size_t size);
@@ -145,6 +151,8 @@ private:
   double                m_framerate = 0.0;     // Video frame rate (fps)
   double                m_samplerate = 0.0;    // Audio sample rate (Hz)
   GAME_REGION           m_region;              // Region of the loaded game
+  std::atomic_bool      m_bAudioMuted{false};  // Drop audio packets, see SetStreamsMuted()
+  std::atomic_bool      m_bVideoMuted{false};  // Drop video packets, see SetStreamsMuted()
 
   // In-game saves
   std::unique_ptr<CGameClientInGameSaves> m_inGameSaves;
@@ -11,7 +11,6 @@
 #include "ServiceBroker.h"
 #include "addons/AddonInstaller.h"
 #include "addons/AddonManager.h"
-#include "cores/RetroPlayer/savestates/ISavestate.h"
 #include "cores/RetroPlayer/savestates/SavestateDatabase.h"
 #include "dialogs/GUIDialogSelect.h"
 #include "filesystem/AddonsDirectory.h"
@@ -39,16 +38,16 @@ std::string CGUIDialogSelectGameClient::ShowAndGetGameClient(const std::string &
 
   // Load savestate
   RETRO::CSavestateDatabase db;
-  std::unique_ptr<RETRO::ISavestate> save = db.CreateSavestate();
+  RETRO::SavestateInfo saveInfo;
 
   CLog::Log(LOGDEBUG, "Select game client dialog: Loading savestate metadata");
-  const bool bLoaded = db.GetSavestate(gamePath, *save);
+  const bool bLoaded = db.GetSavestateInfo(gamePath, saveInfo);
 
   // Get savestate game client
   std::string saveGameClient;
   if (bLoaded)
   {
-    saveGameClient = save->GameClientID();
+    saveGameClient = saveInfo.gameClientId;
     CLog::Log(LOGDEBUG, "Select game client dialog: Auto-selecting %s", saveGameClient.c_str());
   }
 
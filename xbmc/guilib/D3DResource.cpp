@@ -12,6 +12,8 @@
 #include "filesystem/File.h"
 #include "rendering/dx/DeviceResources.h"
 #include "rendering/dx/RenderContext.h"
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
 #include "utils/log.h"
 
 #include <d3dcompiler.h>
@@ -23,6 +25,14 @@ using namespace Microsoft::WRL;
 #pragma comment(lib, "d3dcompiler.lib")
 #endif
 
+namespace
+{
+  // Compiled effects by source and defines, effects created again (players
+  // starting, device recreation) skip the HLSL compiler
+  CCriticalSection effectCacheSection;
+  std::map<std::string, std::string> effectCache;
+}
+
 size_t CD3DHelper::BitsPerPixel(DXGI_FORMAT fmt)
 {
   switch (fmt)
@@ -782,8 +792,37 @@ bool CD3DEffect::CreateEffect()
   //dwShaderFlags |= D3DCOMPILE_SKIP_OPTIMIZATION;
 #endif
 
-  hr = D3DX11CompileEffectFromMemory(m_effectString.c_str(), m_effectString.length(), "", &definemacros[0], this,
-                                     dwShaderFlags, 0, DX::DeviceResources::Get()->GetD3DDevice(), m_effect.ReleaseAndGetAddressOf(), &pError);
+  std::string cacheKey(m_effectString);
+  for (const auto& it : m_defines)
+    cacheKey += "\n#define " + it.first + " " + it.second;
+
+  std::string bytecode;
+  {
+    CSingleLock lock(effectCacheSection);
+    auto it = effectCache.find(cacheKey);
+    if (it != effectCache.end())
+      bytecode = it->second;
+  }
+
+  if (bytecode.empty())
+  {
+    ComPtr<ID3DBlob> pCode;
+    hr = D3DCompile(m_effectString.c_str(), m_effectString.length(), "", &definemacros[0], this,
+                    nullptr, "fx_5_0", dwShaderFlags, 0, pCode.GetAddressOf(), &pError);
+    if (hr == S_OK)
+    {
+      bytecode.assign(static_cast<const char*>(pCode->GetBufferPointer()), pCode->GetBufferSize());
+
+      CSingleLock lock(effectCacheSection);
+      effectCache[cacheKey] = bytecode;
+    }
+  }
+
+  if (!bytecode.empty())
+  {
+    hr = D3DX11CreateEffectFromMemory(bytecode.data(), bytecode.size(), 0,
+                                      DX::DeviceResources::Get()->GetD3DDevice(), m_effect.ReleaseAndGetAddressOf());
+  }
 
   if(hr == S_OK)
     return true;
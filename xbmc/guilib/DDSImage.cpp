@@ -8,6 +8,7 @@
 
 #include "DDSImage.h"
 
+#include "TextureCompressor.h"
 #include "XBTF.h"
 #include "filesystem/File.h"
 #include "utils/log.h"
@@ -16,15 +17,24 @@
 #include <string.h>
 using namespace XFILE;
 
+namespace
+{
+// DXGI_FORMAT_BC7_UNORM and DXGI_FORMAT_BC7_UNORM_SRGB
+constexpr uint32_t DXGI_BC7 = 98;
+constexpr uint32_t DXGI_BC7_SRGB = 99;
+}
+
 CDDSImage::CDDSImage()
 {
   m_data = NULL;
   memset(&m_desc, 0, sizeof(m_desc));
+  memset(&m_dx10, 0, sizeof(m_dx10));
 }
 
 CDDSImage::CDDSImage(unsigned int width, unsigned int height, unsigned int format)
 {
   m_data = NULL;
+  memset(&m_dx10, 0, sizeof(m_dx10));
   Allocate(width, height, format);
 }
 
@@ -57,6 +67,14 @@ unsigned int CDDSImage::GetFormat() const
       return XB_FMT_DXT5;
     if (strncmp((const char *)&m_desc.pixelFormat.fourcc, "ARGB", 4) == 0)
       return XB_FMT_A8R8G8B8;
+    // no official fourcc for the ETC2 formats, only used for Kodi's texture cache
+    if (strncmp((const char *)&m_desc.pixelFormat.fourcc, "ETC2", 4) == 0)
+      return XB_FMT_ETC2_RGB8;
+    if (strncmp((const char *)&m_desc.pixelFormat.fourcc, "ETCA", 4) == 0)
+      return XB_FMT_ETC2_RGBA8;
+    if (strncmp((const char *)&m_desc.pixelFormat.fourcc, "DX10", 4) == 0 &&
+        (m_dx10.dxgiFormat == DXGI_BC7 || m_dx10.dxgiFormat == DXGI_BC7_SRGB))
+      return XB_FMT_BC7;
   }
   return 0;
 }
@@ -84,9 +102,17 @@ bool CDDSImage::ReadFile(const std::string &inputFile)
     return false;
   if (file.Read(&m_desc, sizeof(m_desc)) != sizeof(m_desc))
     return false;
+  if ((m_desc.pixelFormat.flags & DDPF_FOURCC) &&
+      strncmp((const char *)&m_desc.pixelFormat.fourcc, "DX10", 4) == 0 &&
+      file.Read(&m_dx10, sizeof(m_dx10)) != sizeof(m_dx10))
+    return false;
   if (!GetFormat())
     return false;  // not supported
 
+  // the linear size is optional
+  if (!(m_desc.flags & ddsd_linearsize) || !m_desc.linearSize)
+    m_desc.linearSize = GetStorageRequirements(m_desc.width, m_desc.height, GetFormat());
+
   // allocate our data
   m_data = new unsigned char[m_desc.linearSize];
   if (!m_data)
@@ -100,19 +126,40 @@ bool CDDSImage::ReadFile(const std::string &inputFile)
   return true;
 }
 
-unsigned int CDDSImage::GetStorageRequirements(unsigned int width, unsigned int height, unsigned int format)
+bool CDDSImage::WriteFile(const std::string &outputFile) const
 {
-  switch (format)
+  // open the file
+  CFile file;
+  if (!file.OpenForWrite(outputFile, true))
+    return false;
+
+  // write the header
+  if (file.Write("DDS ", 4) != 4 ||
+      file.Write(&m_desc, sizeof(m_desc)) != sizeof(m_desc) ||
+      file.Write(m_data, m_desc.linearSize) != static_cast<ssize_t>(m_desc.linearSize))
+    return false;
+
+  file.Close();
+  return true;
+}
+
+bool CDDSImage::Compress(unsigned int width, unsigned int height, unsigned int pitch, const unsigned char *brga, unsigned int format)
+{
+  if (!CTextureCompressor::CanCompress(format))
+    return false;
+
+  Allocate(width, height, format);
+  if (!CTextureCompressor::Compress(brga, width, height, pitch, format, m_data))
   {
-  case XB_FMT_DXT1:
-    return ((width + 3) / 4) * ((height + 3) / 4) * 8;
-  case XB_FMT_DXT3:
-  case XB_FMT_DXT5:
-    return ((width + 3) / 4) * ((height + 3) / 4) * 16;
-  case XB_FMT_A8R8G8B8:
-  default:
-    return width * height * 4;
+    CLog::Log(LOGERROR, "CDDSImage::Compress - unable to compress an image of %ux%u", width, height);
+    return false;
   }
+  return true;
+}
+
+unsigned int CDDSImage::GetStorageRequirements(unsigned int width, unsigned int height, unsigned int format)
+{
+  return CTextureCompressor::GetSize(width, height, format);
 }
 
 void CDDSImage::Allocate(unsigned int width, unsigned int height, unsigned int format)
@@ -141,6 +188,10 @@ const char *CDDSImage::GetFourCC(unsigned int format)
     return "DXT3";
   case XB_FMT_DXT5:
     return "DXT5";
+  case XB_FMT_ETC2_RGB8:
+    return "ETC2";
+  case XB_FMT_ETC2_RGBA8:
+    return "ETCA";
   case XB_FMT_A8R8G8B8:
   default:
     return "ARGB";
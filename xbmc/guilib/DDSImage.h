@@ -25,6 +25,14 @@ public:
   unsigned char *GetData() const;
 
   bool ReadFile(const std::string &file);
+  bool WriteFile(const std::string &file) const;
+
+  /*!
+   \brief Create a block compressed image
+   \param brga image in XB_FMT_A8R8G8B8 byte order
+   \param format a format CTextureCompressor can encode
+   */
+  bool Compress(unsigned int width, unsigned int height, unsigned int pitch, const unsigned char *brga, unsigned int format);
 
 private:
   void Allocate(unsigned int width, unsigned int height, unsigned int format);
@@ -97,6 +105,17 @@ private:
   } ddsurfacedesc2;
   #pragma pack(pop)
 
+  // extended header of files with the "DX10" fourcc
+  typedef struct
+  {
+    uint32_t dxgiFormat;
+    uint32_t resourceDimension;
+    uint32_t miscFlag;
+    uint32_t arraySize;
+    uint32_t miscFlags2;
+  } ddsheaderdx10;
+
   ddsurfacedesc2 m_desc;
+  ddsheaderdx10 m_dx10;
   unsigned char *m_data;
 };
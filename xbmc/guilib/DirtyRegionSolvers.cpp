@@ -34,6 +34,57 @@ void CFillViewportOnChangeRegionSolver::Solve(const CDirtyRegionList &input, CDi
     output.assign(1,CDirtyRegion(CServiceBroker::GetWinSystem()->GetGfxContext().GetViewWindow()));
 }
 
+namespace
+{
+// each pass renders the whole window tree again, worth about this many pixels of overdraw
+constexpr float MERGE_PASS_COST = 64.0f * 64.0f;
+constexpr size_t MERGE_MAX_PASSES = 8;
+}
+
+void CMergeDirtyRegionSolver::Solve(const CDirtyRegionList &input, CDirtyRegionList &output)
+{
+  CDirtyRegionList regions;
+  for (const CDirtyRegion& region : input)
+  {
+    if (!region.IsEmpty())
+      regions.push_back(region);
+  }
+
+  while (regions.size() > 1)
+  {
+    // the pair that adds the least area when merged
+    size_t bestA = 0, bestB = 0;
+    float bestCost = 0.0f;
+    bool found = false;
+    for (size_t a = 0; a < regions.size(); a++)
+    {
+      for (size_t b = a + 1; b < regions.size(); b++)
+      {
+        CDirtyRegion merged(regions[a]);
+        merged.Union(regions[b]);
+        CRect overlap(regions[a]);
+        overlap.Intersect(regions[b]);
+        const float cost = merged.Area() - regions[a].Area() - regions[b].Area() + overlap.Area();
+        if (!found || cost < bestCost)
+        {
+          bestA = a;
+          bestB = b;
+          bestCost = cost;
+          found = true;
+        }
+      }
+    }
+
+    if (bestCost > MERGE_PASS_COST && regions.size() <= MERGE_MAX_PASSES)
+      break;
+
+    regions[bestA].Union(regions[bestB]);
+    regions.erase(regions.begin() + bestB);
+  }
+
+  output.insert(output.end(), regions.begin(), regions.end());
+}
+
 CGreedyDirtyRegionSolver::CGreedyDirtyRegionSolver()
 {
   m_costNewRegion = 10.0f;
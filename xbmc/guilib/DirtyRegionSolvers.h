@@ -28,6 +28,18 @@ public:
   void Solve(const CDirtyRegionList &input, CDirtyRegionList &output) override;
 };
 
+/*!
+ \brief Merges overlapping regions and regions whose union costs less than an extra render pass.
+
+ Unlike the greedy solver the merging is repeated until no pair is worth merging, so the order the
+ regions were marked in doesn't matter, and the number of passes is limited.
+ */
+class CMergeDirtyRegionSolver : public IDirtyRegionSolver
+{
+public:
+  void Solve(const CDirtyRegionList &input, CDirtyRegionList &output) override;
+};
+
 class CGreedyDirtyRegionSolver : public IDirtyRegionSolver
 {
 public:
@@ -6,9 +6,12 @@
  *  See LICENSES/README.md for more information.
  */
 #include "FFmpegImage.h"
+#include "ServiceBroker.h"
 #include "utils/log.h"
 #include "cores/FFmpeg.h"
 #include "guilib/Texture.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 
 #include <algorithm>
 
@@ -64,6 +67,17 @@ struct ThumbDataManagement
   }
 };
 
+static AVCodecID GetEncoderID(const std::string& mimeType)
+{
+  if (mimeType == "image/jpeg" || mimeType == "image/jpg")
+    return AV_CODEC_ID_MJPEG;
+  else if (mimeType == "image/png")
+    return AV_CODEC_ID_PNG;
+  else if (mimeType == "image/webp")
+    return AV_CODEC_ID_WEBP;
+  return AV_CODEC_ID_NONE;
+}
+
 // valid positions are including 0 (start of buffer)
 // and bufferSize -1 last data point
 static inline size_t Clamp(int64_t newPosition, size_t bufferSize)
@@ -138,8 +152,14 @@ CFFmpegImage::~CFFmpegImage()
 bool CFFmpegImage::LoadImageFromMemory(unsigned char* buffer, unsigned int bufSize,
                                       unsigned int width, unsigned int height)
 {
+  // jpegs much larger than needed are decoded at 1/2, 1/4 or 1/8 of their size by
+  // skipping the high frequencies of the DCT, which is far cheaper than decoding it all
+  unsigned int jpegWidth = 0, jpegHeight = 0;
+  int lowres = 0;
+  if (GetJpegSize(buffer, bufSize, jpegWidth, jpegHeight))
+    lowres = GetJpegLowres(jpegWidth, jpegHeight, width, height);
 
-  if (!Initialize(buffer, bufSize))
+  if (!Initialize(buffer, bufSize, lowres))
   {
     //log
     return false;
@@ -148,10 +168,79 @@ bool CFFmpegImage::LoadImageFromMemory(unsigned char* buffer, unsigned int bufSi
   av_frame_free(&m_pFrame);
   m_pFrame = ExtractFrame();
 
+  if (m_pFrame && lowres > 0)
+  {
+    CLog::Log(LOGDEBUG, "%s - decoded %ux%u jpeg at %ux%u", __FUNCTION__, jpegWidth, jpegHeight, m_width, m_height);
+    m_originalWidth = jpegWidth;
+    m_originalHeight = jpegHeight;
+  }
+
   return !(m_pFrame == nullptr);
 }
 
-bool CFFmpegImage::Initialize(unsigned char* buffer, size_t bufSize)
+bool CFFmpegImage::GetJpegSize(const unsigned char* buffer, size_t bufSize, unsigned int& width, unsigned int& height)
+{
+  if (bufSize < 4 || buffer[0] != 0xFF || buffer[1] != 0xD8)
+    return false;
+
+  size_t pos = 2;
+  while (pos + 4 <= bufSize)
+  {
+    if (buffer[pos] != 0xFF)
+      return false;
+    const unsigned char marker = buffer[pos + 1];
+    if (marker == 0xFF)
+    { // fill byte
+      pos++;
+      continue;
+    }
+    const size_t length = (buffer[pos + 2] << 8) | buffer[pos + 3];
+    if (length < 2)
+      return false;
+
+    // baseline, extended and progressive huffman coded frames, the decoder can't
+    // reduce lossless, arithmetic coded or JPEG-LS frames
+    if (marker == 0xC0 || marker == 0xC1 || marker == 0xC2)
+    {
+      if (pos + 9 > bufSize || buffer[pos + 4] != 8)
+        return false;
+      height = (buffer[pos + 5] << 8) | buffer[pos + 6];
+      width = (buffer[pos + 7] << 8) | buffer[pos + 8];
+      return width > 0 && height > 0;
+    }
+    if ((marker >= 0xC3 && marker <= 0xCF && marker != 0xC4 && marker != 0xC8 && marker != 0xCC) ||
+        marker == 0xDA || marker == 0xF7)
+      return false;
+
+    pos += 2 + length;
+  }
+  return false;
+}
+
+int CFFmpegImage::GetJpegLowres(unsigned int jpegWidth, unsigned int jpegHeight, unsigned int width, unsigned int height)
+{
+  if (!width || !height)
+    return 0;
+
+  // the size the image gets scaled to, keeping the aspect ratio
+  const float scale = std::min(std::min(static_cast<float>(width) / jpegWidth, static_cast<float>(height) / jpegHeight), 1.0f);
+  const unsigned int scaledWidth = static_cast<unsigned int>(jpegWidth * scale + 0.5f);
+  const unsigned int scaledHeight = static_cast<unsigned int>(jpegHeight * scale + 0.5f);
+
+  // the decoded image must not be smaller than that, the mjpeg decoder goes down to 1/8
+  int lowres = 0;
+  while (lowres < 3)
+  {
+    const int next = lowres + 1;
+    if (((jpegWidth + (1 << next) - 1) >> next) < scaledWidth ||
+        ((jpegHeight + (1 << next) - 1) >> next) < scaledHeight)
+      break;
+    lowres = next;
+  }
+  return lowres;
+}
+
+bool CFFmpegImage::Initialize(unsigned char* buffer, size_t bufSize, int lowres /* = 0 */)
 {
   int bufferSize = 4096;
   uint8_t* fbuffer = (uint8_t*)av_malloc(bufferSize + AV_INPUT_BUFFER_PADDING_SIZE);
@@ -249,7 +338,13 @@ bool CFFmpegImage::Initialize(unsigned char* buffer, size_t bufSize)
     return false;
   }
 
-  if (avcodec_open2(m_codec_ctx, codec, NULL) < 0)
+  AVDictionary* options = nullptr;
+  if (lowres > 0 && codec && codec->id == AV_CODEC_ID_MJPEG)
+    av_dict_set_int(&options, "lowres", lowres, 0);
+
+  const int ret = avcodec_open2(m_codec_ctx, codec, &options);
+  av_dict_free(&options);
+  if (ret < 0)
   {
     avformat_close_input(&m_fctx);
     avcodec_free_context(&m_codec_ctx);
@@ -467,9 +562,10 @@ bool CFFmpegImage::DecodeFrame(AVFrame* frame, unsigned int width, unsigned int
   AVPixelFormat pixFormat = ConvertFormats(frame);
 
   // assumption quadratic maximums e.g. 2048x2048
+  // the frame may be smaller than the original image, see LoadImageFromMemory
   float ratio = m_width / (float)m_height;
-  unsigned int nHeight = m_originalHeight;
-  unsigned int nWidth = m_originalWidth;
+  unsigned int nHeight = frame->height;
+  unsigned int nWidth = frame->width;
   if (nHeight > height)
   {
     nHeight = height;
@@ -481,7 +577,7 @@ bool CFFmpegImage::DecodeFrame(AVFrame* frame, unsigned int width, unsigned int
     nHeight = (unsigned int)(nWidth / ratio + 0.5f);
   }
 
-  struct SwsContext* context = sws_getContext(m_originalWidth, m_originalHeight, pixFormat,
+  struct SwsContext* context = sws_getContext(frame->width, frame->height, pixFormat,
     nWidth, nHeight, AV_PIX_FMT_RGB32, SWS_BICUBIC, NULL, NULL, NULL);
 
   if (range == AVCOL_RANGE_JPEG)
@@ -494,7 +590,7 @@ bool CFFmpegImage::DecodeFrame(AVFrame* frame, unsigned int width, unsigned int
     sws_setColorspaceDetails(context, inv_table, srcRange, table, dstRange, brightness, contrast, saturation);
   }
 
-  sws_scale(context, frame->data, frame->linesize, 0, m_originalHeight,
+  sws_scale(context, frame->data, frame->linesize, 0, frame->height,
     pictureRGB->data, pictureRGB->linesize);
   sws_freeContext(context);
 
@@ -546,23 +642,30 @@ bool CFFmpegImage::CreateThumbnailFromSurface(unsigned char* bufferin, unsigned
     return false;
   }
 
-  bool jpg_output = false;
-  if (m_strMimeType == "image/jpeg" || m_strMimeType == "image/jpg")
-    jpg_output = true;
-  else if (m_strMimeType == "image/png")
-    jpg_output = false;
-  else
+  AVCodecID codecId = GetEncoderID(m_strMimeType);
+  if (codecId == AV_CODEC_ID_NONE)
   {
     CLog::Log(LOGERROR, "Output Format is not supported: %s is not supported.", destFile.c_str());
     return false;
   }
+  const bool jpg_output = codecId == AV_CODEC_ID_MJPEG;
+  const bool webp_output = codecId == AV_CODEC_ID_WEBP;
+
+  // libwebp takes the pixels as they are, png needs them in RGBA order and jpeg in full range yuv
+  AVPixelFormat outputFormat = webp_output ? AV_PIX_FMT_RGB32 : AV_PIX_FMT_RGBA;
+  AVPixelFormat scaleFormat = outputFormat;
+  if (jpg_output)
+  {
+    outputFormat = AV_PIX_FMT_YUVJ420P;
+    scaleFormat = AV_PIX_FMT_YUV420P;
+  }
 
   ThumbDataManagement tdm;
 
-  tdm.codec = avcodec_find_encoder(jpg_output ? AV_CODEC_ID_MJPEG : AV_CODEC_ID_PNG);
+  tdm.codec = avcodec_find_encoder(codecId);
   if (!tdm.codec)
   {
-    CLog::Log(LOGERROR, "You are missing a working encoder for format: %s", jpg_output ? "JPEG" : "PNG");
+    CLog::Log(LOGERROR, "You are missing a working encoder for format: %s", m_strMimeType.c_str());
     return false;
   }
 
@@ -577,11 +680,14 @@ bool CFFmpegImage::CreateThumbnailFromSurface(unsigned char* bufferin, unsigned
   tdm.avOutctx->width = width;
   tdm.avOutctx->time_base.num = 1;
   tdm.avOutctx->time_base.den = 1;
-  tdm.avOutctx->pix_fmt = jpg_output ? AV_PIX_FMT_YUVJ420P : AV_PIX_FMT_RGBA;
+  tdm.avOutctx->pix_fmt = outputFormat;
   tdm.avOutctx->flags = AV_CODEC_FLAG_QSCALE;
   tdm.avOutctx->mb_lmin = tdm.avOutctx->qmin * FF_QP2LAMBDA;
   tdm.avOutctx->mb_lmax = tdm.avOutctx->qmax * FF_QP2LAMBDA;
   tdm.avOutctx->global_quality = tdm.avOutctx->qmin * FF_QP2LAMBDA;
+  // libwebp takes the quality (0-100) as qscale
+  if (webp_output)
+    tdm.avOutctx->global_quality = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_imageCacheQuality * FF_QP2LAMBDA;
 
   unsigned int internalBufOutSize = 0;
 
@@ -626,7 +732,7 @@ bool CFFmpegImage::CreateThumbnailFromSurface(unsigned char* bufferin, unsigned
     return false;
   }
 
-  if (av_image_fill_arrays(tdm.frame_temporary->data, tdm.frame_temporary->linesize, tdm.intermediateBuffer, jpg_output ? AV_PIX_FMT_YUV420P : AV_PIX_FMT_RGBA, width, height, 16) < 0)
+  if (av_image_fill_arrays(tdm.frame_temporary->data, tdm.frame_temporary->linesize, tdm.intermediateBuffer, scaleFormat, width, height, 16) < 0)
   {
     CLog::Log(LOGERROR, "Could not fill picture for thumbnail: %s", destFile.c_str());
     CleanupLocalOutputBuffer();
@@ -637,7 +743,7 @@ bool CFFmpegImage::CreateThumbnailFromSurface(unsigned char* bufferin, unsigned
   int srcStride[] = { (int) pitch, 0, 0, 0};
 
   //input size == output size which means only pix_fmt conversion
-  tdm.sws = sws_getContext(width, height, AV_PIX_FMT_RGB32, width, height, jpg_output ? AV_PIX_FMT_YUV420P : AV_PIX_FMT_RGBA, 0, 0, 0, 0);
+  tdm.sws = sws_getContext(width, height, AV_PIX_FMT_RGB32, width, height, scaleFormat, 0, 0, 0, 0);
   if (!tdm.sws)
   {
     CLog::Log(LOGERROR, "Could not setup scaling context for thumbnail: %s", destFile.c_str());
@@ -685,7 +791,7 @@ bool CFFmpegImage::CreateThumbnailFromSurface(unsigned char* bufferin, unsigned
   tdm.frame_input->linesize[1] = tdm.frame_temporary->linesize[1];
   tdm.frame_input->linesize[2] = tdm.frame_temporary->linesize[2];
   // this is deprecated but mjpeg is not yet transitioned
-  tdm.frame_input->format = jpg_output ? AV_PIX_FMT_YUVJ420P : AV_PIX_FMT_RGBA;
+  tdm.frame_input->format = outputFormat;
 
   int got_package = 0;
   AVPacket avpkt;
@@ -722,6 +828,12 @@ bool CFFmpegImage::CreateThumbnailFromSurface(unsigned char* bufferin, unsigned
   return true;
 }
 
+bool CFFmpegImage::CanEncode(const std::string& strMimeType)
+{
+  AVCodecID codecId = GetEncoderID(strMimeType);
+  return codecId != AV_CODEC_ID_NONE && avcodec_find_encoder(codecId) != nullptr;
+}
+
 void CFFmpegImage::ReleaseThumbnailBuffer()
 {
   CleanupLocalOutputBuffer();
@@ -69,12 +69,21 @@ public:
                                   unsigned int &bufferoutSize) override;
   void ReleaseThumbnailBuffer() override;
 
-  bool Initialize(unsigned char* buffer, size_t bufSize);
+  /*! \brief Whether images of the given mime type can be written, e.g. if ffmpeg got built with libwebp */
+  static bool CanEncode(const std::string& strMimeType);
+
+  /*!
+   \brief Open the image for decoding
+   \param lowres decode jpegs at 1/2^lowres of their size, 0 for the full size
+   */
+  bool Initialize(unsigned char* buffer, size_t bufSize, int lowres = 0);
 
   std::shared_ptr<Frame> ReadFrame();
 
 private:
   static void FreeIOCtx(AVIOContext** ioctx);
+  static bool GetJpegSize(const unsigned char* buffer, size_t bufSize, unsigned int& width, unsigned int& height);
+  static int GetJpegLowres(unsigned int jpegWidth, unsigned int jpegHeight, unsigned int width, unsigned int height);
   AVFrame* ExtractFrame();
   bool DecodeFrame(AVFrame* m_pFrame, unsigned int width, unsigned int height, unsigned int pitch, unsigned char * const pixels);
   static int EncodeFFmpegFrame(AVCodecContext *avctx, AVPacket *pkt, int *got_packet, AVFrame *frame);
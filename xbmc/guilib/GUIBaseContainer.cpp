@@ -9,7 +9,9 @@
 #include "GUIBaseContainer.h"
 
 #include "FileItem.h"
+#include "GUIComponent.h"
 #include "GUIInfoManager.h"
+#include "GUILargeTextureManager.h"
 #include "GUIListItemLayout.h"
 #include "GUIMessage.h"
 #include "ServiceBroker.h"
@@ -26,10 +28,13 @@
 #include "utils/XBMCTinyXML.h"
 #include "utils/log.h"
 
+#include <algorithm>
+
 #define HOLD_TIME_START 100
 #define HOLD_TIME_END   3000
 #define SCROLLING_GAP   200U
 #define SCROLLING_THRESHOLD 300U
+#define PREFETCH_PAGES      2
 
 CGUIBaseContainer::CGUIBaseContainer(int parentID, int controlID, float posX, float posY, float width, float height, ORIENTATION orientation, const CScroller& scroller, int preloadItems)
     : IGUIContainer(parentID, controlID, posX, posY, width, height)
@@ -63,6 +68,9 @@ CGUIBaseContainer::~CGUIBaseContainer(void)
   for (auto item : m_items)
     item->FreeMemory();
 
+  if (CServiceBroker::GetGUI())
+    CServiceBroker::GetGUI()->GetLargeTextureManager().CancelPrefetch(this);
+
   delete m_listProvider;
 }
 
@@ -104,6 +112,8 @@ void CGUIBaseContainer::Process(unsigned int currentTime, CDirtyRegionList &dirt
   if ((int)m_items.size() > m_itemsPerPage + cacheBefore + cacheAfter)
     FreeMemory(CorrectOffset(offset - cacheBefore, 0), CorrectOffset(offset + m_itemsPerPage + 1 + cacheAfter, 0));
 
+  UpdatePrefetch(offset);
+
   CPoint origin = CPoint(m_posX, m_posY) + m_renderOffset;
   float pos = (m_orientation == VERTICAL) ? origin.y : origin.x;
   float end = (m_orientation == VERTICAL) ? m_posY + m_height : m_posX + m_width;
@@ -273,21 +283,25 @@ void CGUIBaseContainer::RenderItem(float posX, float posY, CGUIListItem *item, b
 {
   if (!m_focusedLayout || !m_layout) return;
 
-  // set the origin
-  CServiceBroker::GetWinSystem()->GetGfxContext().SetOrigin(posX, posY);
-
+  CGUIListItemLayout* layout = nullptr;
   if (focused)
-  {
-    if (item->GetFocusedLayout())
-      item->GetFocusedLayout()->Render(item, m_parentID);
-  }
+    layout = item->GetFocusedLayout();
+  else if (item->GetFocusedLayout() && item->GetFocusedLayout()->IsAnimating(ANIM_TYPE_UNFOCUS))
+    layout = item->GetFocusedLayout();
   else
-  {
-    if (item->GetFocusedLayout() && item->GetFocusedLayout()->IsAnimating(ANIM_TYPE_UNFOCUS))
-      item->GetFocusedLayout()->Render(item, m_parentID);
-    else if (item->GetLayout())
-      item->GetLayout()->Render(item, m_parentID);
-  }
+    layout = item->GetLayout();
+  if (!layout)
+    return;
+
+  // with dirty regions only the items inside the region that is redrawn need rendering, the
+  // scissors clip away anything the others would draw
+  CRect region(layout->GetRenderRegion());
+  if (region.Intersect(CServiceBroker::GetWinSystem()->GetGfxContext().GetScissors()).IsEmpty())
+    return;
+
+  // set the origin
+  CServiceBroker::GetWinSystem()->GetGfxContext().SetOrigin(posX, posY);
+  layout->Render(item, m_parentID);
   CServiceBroker::GetWinSystem()->GetGfxContext().RestoreOrigin();
 }
 
@@ -871,6 +885,8 @@ void CGUIBaseContainer::FreeResources(bool immediately)
     }
   }
   m_scroller.Stop();
+  CServiceBroker::GetGUI()->GetLargeTextureManager().CancelPrefetch(this);
+  m_prefetchInvalid = true;
 }
 
 void CGUIBaseContainer::UpdateLayout(bool updateAllItems)
@@ -884,6 +900,7 @@ void CGUIBaseContainer::UpdateLayout(bool updateAllItems)
   CalculateLayout();
   SetPageControlRange();
   MarkDirtyRegion();
+  m_prefetchInvalid = true;
 }
 
 void CGUIBaseContainer::SetPageControlRange()
@@ -1145,6 +1162,7 @@ void CGUIBaseContainer::Reset()
   m_items.clear();
   m_lastItem.reset();
   ResetAutoScrolling();
+  m_prefetchInvalid = true;
 }
 
 void CGUIBaseContainer::LoadLayout(TiXmlElement *layout)
@@ -1348,6 +1366,46 @@ int CGUIBaseContainer::GetCurrentPage() const
   return GetOffset() / m_itemsPerPage + 1;
 }
 
+void CGUIBaseContainer::UpdatePrefetch(int offset)
+{
+  if (!m_prefetchInvalid && offset == m_prefetchOffset)
+    return;
+
+  // keep loading ahead in the direction we last moved in until we turn around
+  if (!m_prefetchInvalid && offset != m_prefetchOffset)
+    m_prefetchDirection = (offset > m_prefetchOffset) ? 1 : -1;
+  m_prefetchOffset = offset;
+  m_prefetchInvalid = false;
+
+  CGUILargeTextureManager &largeTextureManager = CServiceBroker::GetGUI()->GetLargeTextureManager();
+  int cacheBefore, cacheAfter;
+  GetCacheOffsets(cacheBefore, cacheAfter);
+  if (!m_layout || (int)m_items.size() <= m_itemsPerPage + cacheBefore + cacheAfter)
+  {
+    largeTextureManager.CancelPrefetch(this);
+    return;
+  }
+
+  // the offset is in rows for panels, find the items per row
+  const int itemsPerUnit = std::max(CorrectOffset(1, 0) - CorrectOffset(0, 0), 1);
+  const int units = PREFETCH_PAGES * m_itemsPerPage;
+  const int start = (m_prefetchDirection > 0) ? offset + m_itemsPerPage + 1 + cacheAfter : offset - cacheBefore - 1;
+
+  // nearest first, the large texture manager drops the ones that don't fit the memory budget
+  std::vector<std::string> images;
+  for (int i = 0; i < units; i++)
+  {
+    const int unit = start + i * m_prefetchDirection;
+    for (int j = 0; j < itemsPerUnit; j++)
+    {
+      const int itemNo = CorrectOffset(unit, j);
+      if (itemNo >= 0 && itemNo < (int)m_items.size())
+        m_layout->GetItemImages(m_items[itemNo].get(), images);
+    }
+  }
+  largeTextureManager.PrefetchImages(this, images);
+}
+
 void CGUIBaseContainer::GetCacheOffsets(int &cacheBefore, int &cacheAfter) const
 {
   if (m_scroller.IsScrollingDown())
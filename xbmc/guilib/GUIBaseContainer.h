@@ -127,6 +127,7 @@ protected:
   int ScrollCorrectionRange() const;
   inline float Size() const;
   void FreeMemory(int keepStart, int keepEnd);
+  void UpdatePrefetch(int offset);
   void GetCurrentLayouts();
   CGUIListItemLayout *GetFocusedLayout() const;
 
@@ -207,6 +208,11 @@ protected:
 
   unsigned int m_lastRenderTime;
 
+  // art of the items we scroll towards, loaded by the large texture manager
+  bool m_prefetchInvalid = true;
+  int m_prefetchOffset = 0;
+  int m_prefetchDirection = 1;
+
 private:
   bool OnContextMenu();
 
@@ -12,6 +12,7 @@
 #include "GUIColorManager.h"
 #include "GUIInfoManager.h"
 #include "GUILargeTextureManager.h"
+#include "GUITextureBudget.h"
 #include "GUIWindowManager.h"
 #include "ServiceBroker.h"
 #include "StereoscopicsManager.h"
@@ -21,6 +22,7 @@
 
 CGUIComponent::CGUIComponent()
 {
+  m_textureBudget.reset(new CGUITextureBudget());
   m_pWindowManager.reset(new CGUIWindowManager());
   m_pTextureManager.reset(new CGUITextureManager());
   m_pLargeTextureManager.reset(new CGUILargeTextureManager());
@@ -69,6 +71,11 @@ CGUILargeTextureManager& CGUIComponent::GetLargeTextureManager()
   return *m_pLargeTextureManager;
 }
 
+CGUITextureBudget& CGUIComponent::GetTextureBudget()
+{
+  return *m_textureBudget;
+}
+
 CStereoscopicsManager &CGUIComponent::GetStereoscopicsManager()
 {
   return *m_stereoscopicsManager;
@@ -14,6 +14,7 @@
 class CGUIWindowManager;
 class CGUITextureManager;
 class CGUILargeTextureManager;
+class CGUITextureBudget;
 class CStereoscopicsManager;
 class CGUIInfoManager;
 class CGUIColorManager;
@@ -30,6 +31,7 @@ public:
   CGUIWindowManager& GetWindowManager();
   CGUITextureManager& GetTextureManager();
   CGUILargeTextureManager& GetLargeTextureManager();
+  CGUITextureBudget& GetTextureBudget();
   CStereoscopicsManager &GetStereoscopicsManager();
   CGUIInfoManager &GetInfoManager();
   CGUIColorManager &GetColorManager();
@@ -39,6 +41,7 @@ public:
 
 protected:
   // members are pointers in order to avoid includes
+  std::unique_ptr<CGUITextureBudget> m_textureBudget; ///< first, it outlives the users of the textures
   std::unique_ptr<CGUIWindowManager> m_pWindowManager;
   std::unique_ptr<CGUITextureManager> m_pTextureManager;
   std::unique_ptr<CGUILargeTextureManager> m_pLargeTextureManager;
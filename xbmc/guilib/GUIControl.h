@@ -20,6 +20,7 @@
 #include "utils/Color.h"
 #include "windowing/GraphicContext.h" // needed by any rendering operation (all controls)
 
+#include <string>
 #include <vector>
 
 class CGUIListItem; // forward
@@ -236,6 +237,8 @@ public:
 
   // push information updates
   virtual void UpdateInfo(const CGUIListItem *item = NULL) {};
+  /*! \brief Add the large images this control would show for an item, used to load them ahead of time */
+  virtual void GetItemImages(const CGUIListItem *item, std::vector<std::string> &images) const {};
   virtual void SetPushUpdates(bool pushUpdates) { m_pushedUpdates = pushUpdates; };
 
   virtual bool IsGroup() const { return false; };
@@ -528,6 +528,12 @@ void CGUIControlGroup::ClearAll()
   SetInvalid();
 }
 
+void CGUIControlGroup::GetItemImages(const CGUIListItem *item, std::vector<std::string> &images) const
+{
+  for (const auto *control : m_children)
+    control->GetItemImages(item, images);
+}
+
 #ifdef _DEBUG
 void CGUIControlGroup::DumpTextureUse()
 {
@@ -67,6 +67,7 @@ public:
   void SaveStates(std::vector<CControlState> &states) override;
 
   bool IsGroup() const override { return true; };
+  void GetItemImages(const CGUIListItem *item, std::vector<std::string> &images) const override;
 
 #ifdef _DEBUG
   void DumpTextureUse() override;
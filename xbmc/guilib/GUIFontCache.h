@@ -202,6 +202,8 @@ struct CVertexBuffer
 #endif
   BufferHandleType bufferHandle = BUFFER_HANDLE_INIT; // this is really a GLuint
   size_t size = 0;
+  /* Fonts that batch their text keep the vertices on the CPU instead of a buffer object */
+  std::shared_ptr<const std::vector<SVertex>> vertices;
   CVertexBuffer() : m_font(NULL) {}
   CVertexBuffer(BufferHandleType bufferHandle, size_t size, const CGUIFontTTFBase *font) : bufferHandle(bufferHandle), size(size), m_font(font) {}
   CVertexBuffer(const CVertexBuffer &other) : bufferHandle(other.bufferHandle), size(other.size), m_font(other.m_font)
@@ -209,7 +211,7 @@ struct CVertexBuffer
     /* In practice, the copy constructor is only called before a vertex buffer
      * has been attached. If this should ever change, we'll need another support
      * function in GUIFontTTFGL/DX to duplicate a buffer, given its handle. */
-    assert(other.bufferHandle == 0);
+    assert(other.bufferHandle == 0 && !other.vertices);
   }
   CVertexBuffer &operator=(CVertexBuffer &other)
   {
@@ -217,6 +219,7 @@ struct CVertexBuffer
     assert(bufferHandle == 0);
     bufferHandle = other.bufferHandle;
     other.bufferHandle = 0;
+    vertices = std::move(other.vertices);
     size = other.size;
     m_font = other.m_font;
     return *this;
@@ -15,10 +15,13 @@
 #include "addons/FontResource.h"
 #include "GUIFontTTF.h"
 #include "GUIFont.h"
+#include "LocalizeStrings.h"
 #include "utils/XMLUtils.h"
 #include "GUIControlFactory.h"
 #include "filesystem/Directory.h"
 #include "filesystem/File.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "settings/lib/Setting.h"
 #include "settings/lib/SettingDefinitions.h"
 #include "utils/log.h"
@@ -32,15 +35,20 @@
 #include "filesystem/SpecialProtocol.h"
 #endif
 
+#include <map>
+#include <set>
+
 using namespace ADDON;
 
 GUIFontManager::GUIFontManager(void)
 {
   m_canReload = true;
+  CMemoryPressureManager::GetInstance().Register(this, "fonts", CMemoryPressureManager::PRIORITY_GUI);
 }
 
 GUIFontManager::~GUIFontManager(void)
 {
+  CMemoryPressureManager::GetInstance().Unregister(this);
   Clear();
 }
 
@@ -240,6 +248,42 @@ void GUIFontManager::ReloadTTFFonts(void)
 
     font->SetFont(pFontFile);
   }
+
+  PrewarmFonts();
+}
+
+void GUIFontManager::PrewarmFonts()
+{
+  const int maxCharacters = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiFontPrewarmCharacters;
+  if (maxCharacters <= 0 || m_vecFonts.empty())
+    return;
+
+  const std::vector<uint32_t> characters = g_localizeStrings.GetCharacters(maxCharacters);
+  if (characters.empty())
+    return;
+
+  // several fonts of the skin share a font file, with a style of their own
+  std::map<CGUIFontTTFBase*, std::set<uint32_t>> styles;
+  for (const CGUIFont* font : m_vecFonts)
+  {
+    if (font->GetFont())
+      styles[font->GetFont()].insert(font->GetStyle() & (FONT_STYLE_BOLD | FONT_STYLE_ITALICS | FONT_STYLE_LIGHT));
+  }
+
+  for (const auto& it : styles)
+  {
+    vecText text;
+    text.reserve(characters.size() * it.second.size());
+    for (uint32_t style : it.second)
+    {
+      for (uint32_t letter : characters)
+        text.push_back((style << 24) | letter);
+    }
+    it.first->Prewarm(text);
+  }
+
+  CLog::Log(LOGDEBUG, "%s - rendering %u characters ahead for %u font files", __FUNCTION__,
+            static_cast<unsigned int>(characters.size()), static_cast<unsigned int>(styles.size()));
 }
 
 void GUIFontManager::Unload(const std::string& strFontName)
@@ -16,6 +16,7 @@
 #include "IMsgTargetCallback.h"
 #include "utils/Color.h"
 #include "utils/GlobalsHandling.h"
+#include "utils/MemoryPressure.h"
 #include "windowing/GraphicContext.h"
 
 #include <utility>
@@ -44,13 +45,14 @@ struct OrigFontInfo
  \ingroup textures
  \brief
  */
-class GUIFontManager : public IMsgTargetCallback
+class GUIFontManager : public IMsgTargetCallback, public IMemoryPressureHandler
 {
 public:
   GUIFontManager(void);
   ~GUIFontManager(void) override;
 
   bool OnMessage(CGUIMessage &message) override;
+  void OnMemoryPressure(MemoryPressure level) override;
 
   void Unload(const std::string& strFontName);
   void LoadFonts(const std::string &fontSet);
@@ -66,6 +68,11 @@ public:
   void Clear();
   void FreeFontFile(CGUIFontTTFBase *pFont);
 
+  /*! \brief Render the characters of the strings in the active language ahead for all fonts
+   \sa CGUIFontTTFBase::Prewarm
+   */
+  void PrewarmFonts();
+
   static void SettingOptionsFontsFiller(std::shared_ptr<const CSetting> setting, std::vector<StringSettingOption> &list, std::string &current, void *data);
 
 protected:
@@ -19,8 +19,13 @@
 #include "windowing/WinSystem.h"
 #include "URL.h"
 #include "filesystem/File.h"
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
 #include "threads/SystemClock.h"
+#include "utils/JobManager.h"
 
+#include <algorithm>
+#include <map>
 #include <math.h>
 #include <memory>
 #include <queue>
@@ -42,6 +47,20 @@
 #define GLYPH_STRENGTH_BOLD 24
 #define GLYPH_STRENGTH_LIGHT -48
 
+namespace
+{
+// glyphs rendered ahead for a font that didn't get drawn yet
+constexpr size_t PREWARM_MAX_BYTES = 2 * 1024 * 1024;
+
+FT_Pos GetBorderStrength(FT_Face face)
+{
+  FT_Pos strength = FT_MulFix( face->units_per_EM, face->size->metrics.y_scale) / 12;
+  if (strength < 128)
+    strength = 128;
+  return strength;
+}
+}
+
 
 class CFreeTypeLibrary
 {
@@ -187,13 +206,18 @@ void CGUIFontTTFBase::RemoveReference()
 }
 
 
+void CGUIFontTTFBase::FlushCache()
+{
+  m_staticCache.Flush();
+  m_dynamicCache.Flush();
+}
+
 void CGUIFontTTFBase::ClearCharacterCache()
 {
-  delete(m_texture);
+  ReleaseCharacterTexture();
 
   DeleteHardwareTexture();
 
-  m_texture = NULL;
   delete[] m_char;
   m_char = new Character[CHAR_CHUNK];
   memset(m_charquick, 0, sizeof(m_charquick));
@@ -207,8 +231,8 @@ void CGUIFontTTFBase::ClearCharacterCache()
 
 void CGUIFontTTFBase::Clear()
 {
-  delete(m_texture);
-  m_texture = NULL;
+  CancelPrewarm();
+  ReleaseCharacterTexture();
   delete[] m_char;
   memset(m_charquick, 0, sizeof(m_charquick));
   m_char = NULL;
@@ -234,6 +258,8 @@ void CGUIFontTTFBase::Clear()
 
 bool CGUIFontTTFBase::Load(const std::string& strFilename, float height, float aspect, float lineSpacing, bool border)
 {
+  CancelPrewarm();
+
   // we now know that this object is unique - only the GUIFont objects are non-unique, so no need
   // for reference tracking these fonts
   m_face = g_freeTypeLibrary.GetFont(strFilename, height, aspect, m_fontFileInMemory);
@@ -268,9 +294,7 @@ bool CGUIFontTTFBase::Load(const std::string& strFilename, float height, float a
      add on the strength of any border - the non-bordered font needs
      aligning with the bordered font by utilising GetTextBaseLine()
      */
-    FT_Pos strength = FT_MulFix( m_face->units_per_EM, m_face->size->metrics.y_scale) / 12;
-    if (strength < 128)
-      strength = 128;
+    FT_Pos strength = GetBorderStrength(m_face);
 
     cellDescender -= strength;
     cellAscender  += strength;
@@ -289,9 +313,10 @@ bool CGUIFontTTFBase::Load(const std::string& strFilename, float height, float a
   m_cellHeight   = cellAscender - cellDescender;
 
   m_height = height;
+  m_aspect = aspect;
+  m_border = border;
 
-  delete(m_texture);
-  m_texture = NULL;
+  ReleaseCharacterTexture();
   delete[] m_char;
   m_char = NULL;
 
@@ -320,6 +345,120 @@ bool CGUIFontTTFBase::Load(const std::string& strFilename, float height, float a
   return true;
 }
 
+struct CGUIFontTTFBase::SPrewarmState
+{
+  std::string filename;
+  float height = 0.0f;
+  float aspect = 1.0f;
+  bool border = false;
+  std::vector<character_t> characters; // as in the character table
+
+  CCriticalSection section;
+  std::map<character_t, SGlyphBitmap> glyphs;
+  bool aborted = false;
+};
+
+void CGUIFontTTFBase::Prewarm(const vecText& characters)
+{
+  if (!m_face)
+    return;
+
+  CancelPrewarm();
+
+  std::shared_ptr<SPrewarmState> state = std::make_shared<SPrewarmState>();
+  state->filename = m_strFilename;
+  state->height = m_height;
+  state->aspect = m_aspect;
+  state->border = m_border;
+  for (character_t chr : characters)
+  {
+    character_t letter = chr & 0xffff;
+    character_t style = (chr & 0x7000000) >> 24;
+    if (letter < 0x20)
+      continue;
+
+    // the character table is sorted by letter and style
+    Character key;
+    key.letterAndStyle = (style << 16) | letter;
+    if (!std::binary_search(m_char, m_char + m_numChars, key,
+                            [](const Character& a, const Character& b) { return a.letterAndStyle < b.letterAndStyle; }))
+      state->characters.push_back(key.letterAndStyle);
+  }
+
+  if (state->characters.empty())
+    return;
+
+  m_prewarm = state;
+  CJobManager::GetInstance().Submit([state]() { PrewarmGlyphs(state); }, CJob::PRIORITY_LOW);
+}
+
+void CGUIFontTTFBase::PrewarmGlyphs(std::shared_ptr<SPrewarmState> state)
+{
+  // FreeType objects must not be shared between threads, use a library of our own
+  CFreeTypeLibrary library;
+  XUTILS::auto_buffer fontFileInMemory;
+  FT_Face face = library.GetFont(state->filename, state->height, state->aspect, fontFileInMemory);
+  if (!face)
+    return;
+
+  FT_Stroker stroker = NULL;
+  if (state->border)
+  {
+    stroker = library.GetStroker();
+    if (stroker)
+      FT_Stroker_Set(stroker, GetBorderStrength(face), FT_STROKER_LINECAP_ROUND, FT_STROKER_LINEJOIN_ROUND, 0);
+  }
+
+  size_t bytes = 0;
+  for (character_t ch : state->characters)
+  {
+    SGlyphBitmap glyph;
+    if (!RenderGlyph(face, stroker, ch & 0xffff, ch >> 16, glyph))
+      continue;
+
+    bytes += glyph.pixels.size();
+
+    CSingleLock lock(state->section);
+    if (state->aborted)
+      break;
+    state->glyphs.insert(std::make_pair(ch, std::move(glyph)));
+    if (bytes > PREWARM_MAX_BYTES)
+      break;
+  }
+
+  if (stroker)
+    CFreeTypeLibrary::ReleaseStroker(stroker);
+  CFreeTypeLibrary::ReleaseFont(face);
+}
+
+bool CGUIFontTTFBase::TakePrewarmedGlyph(character_t letterAndStyle, SGlyphBitmap& glyph)
+{
+  if (!m_prewarm)
+    return false;
+
+  CSingleLock lock(m_prewarm->section);
+  auto it = m_prewarm->glyphs.find(letterAndStyle);
+  if (it == m_prewarm->glyphs.end())
+    return false;
+
+  glyph = std::move(it->second);
+  m_prewarm->glyphs.erase(it);
+  return true;
+}
+
+void CGUIFontTTFBase::CancelPrewarm()
+{
+  if (!m_prewarm)
+    return;
+
+  // the job owns a reference as well, the glyphs are freed with the last one
+  CSingleLock lock(m_prewarm->section);
+  m_prewarm->aborted = true;
+  m_prewarm->glyphs.clear();
+  lock.Leave();
+  m_prewarm.reset();
+}
+
 void CGUIFontTTFBase::Begin()
 {
   if (m_nestedBeginCount == 0 && m_texture != NULL && FirstBegin())
@@ -687,95 +826,42 @@ CGUIFontTTFBase::Character* CGUIFontTTFBase::GetCharacter(character_t chr)
 
 bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *ch)
 {
-  int glyph_index = FT_Get_Char_Index( m_face, letter );
-
-  FT_Glyph glyph = NULL;
-  if (FT_Load_Glyph( m_face, glyph_index, FT_LOAD_TARGET_LIGHT ))
-  {
-    CLog::Log(LOGDEBUG, "%s Failed to load glyph %x", __FUNCTION__, static_cast<uint32_t>(letter));
-    return false;
-  }
-  // make bold if applicable
-  if (style & FONT_STYLE_BOLD)
-    SetGlyphStrength(m_face->glyph, GLYPH_STRENGTH_BOLD);
-  // and italics if applicable
-  if (style & FONT_STYLE_ITALICS)
-    ObliqueGlyph(m_face->glyph);
-  // and light if applicable
-  if (style & FONT_STYLE_LIGHT)
-    SetGlyphStrength(m_face->glyph, GLYPH_STRENGTH_LIGHT);
-  // grab the glyph
-  if (FT_Get_Glyph(m_face->glyph, &glyph))
-  {
-    CLog::Log(LOGDEBUG, "%s Failed to get glyph %x", __FUNCTION__, static_cast<uint32_t>(letter));
+  SGlyphBitmap glyph;
+  if (!TakePrewarmedGlyph((style << 16) | letter, glyph) &&
+      !RenderGlyph(m_face, m_stroker, letter, style, glyph))
     return false;
-  }
-  if (m_stroker)
-    FT_Glyph_StrokeBorder(&glyph, m_stroker, 0, 1);
-  // render the glyph
-  if (FT_Glyph_To_Bitmap(&glyph, FT_RENDER_MODE_NORMAL, NULL, 1))
-  {
-    CLog::Log(LOGDEBUG, "%s Failed to render glyph %x to a bitmap", __FUNCTION__, static_cast<uint32_t>(letter));
-    return false;
-  }
-  FT_BitmapGlyph bitGlyph = (FT_BitmapGlyph)glyph;
-  FT_Bitmap bitmap = bitGlyph->bitmap;
-  bool isEmptyGlyph = (bitmap.width == 0 || bitmap.rows == 0);
+
+  bool isEmptyGlyph = (glyph.width == 0 || glyph.rows == 0);
 
   if (!isEmptyGlyph)
   {
-    if (bitGlyph->left < 0)
-      m_posX += -bitGlyph->left;
+    if (glyph.left < 0)
+      m_posX += -glyph.left;
 
     // check we have enough room for the character.
-    // cast-fest is here to avoid warnings due to freeetype version differences (signedness of width).
-    if (static_cast<int>(m_posX + bitGlyph->left + bitmap.width) > static_cast<int>(m_textureWidth))
+    if (static_cast<int>(m_posX + glyph.left + glyph.width) > static_cast<int>(m_textureWidth))
     { // no space - gotta drop to the next line (which means creating a new texture and copying it across)
-      m_posX = 0;
-      m_posY += GetTextureLineHeight();
-      if (bitGlyph->left < 0)
-        m_posX += -bitGlyph->left;
-
-      if(m_posY + GetTextureLineHeight() >= m_textureHeight)
-      {
-        // create the new larger texture
-        unsigned int newHeight = m_posY + GetTextureLineHeight();
-        // check for max height
-        if (newHeight > m_renderSystem->GetMaxTextureSize())
-        {
-          CLog::Log(LOGDEBUG, "%s: New cache texture is too large (%u > %u pixels long)", __FUNCTION__, newHeight, m_renderSystem->GetMaxTextureSize());
-          FT_Done_Glyph(glyph);
-          return false;
-        }
-
-        CBaseTexture* newTexture = NULL;
-        newTexture = ReallocTexture(newHeight);
-        if(newTexture == NULL)
-        {
-          FT_Done_Glyph(glyph);
-          CLog::Log(LOGDEBUG, "%s: Failed to allocate new texture of height %u", __FUNCTION__, newHeight);
-          return false;
-        }
-        m_texture = newTexture;
-      }
+      if (!AllocateTextureLine())
+        return false;
+      if (glyph.left < 0)
+        m_posX += -glyph.left;
     }
 
     if(m_texture == NULL)
     {
-      FT_Done_Glyph(glyph);
       CLog::Log(LOGDEBUG, "%s: no texture to cache character to", __FUNCTION__);
       return false;
     }
   }
   // set the character in our table
   ch->letterAndStyle = (style << 16) | letter;
-  ch->offsetX = (short)bitGlyph->left;
-  ch->offsetY = (short)m_cellBaseLine - bitGlyph->top;
+  ch->offsetX = (short)glyph.left;
+  ch->offsetY = (short)m_cellBaseLine - glyph.top;
   ch->left = isEmptyGlyph ? 0 : ((float)m_posX + ch->offsetX);
   ch->top = isEmptyGlyph ? 0 : ((float)m_posY + ch->offsetY);
-  ch->right = ch->left + bitmap.width;
-  ch->bottom = ch->top + bitmap.rows;
-  ch->advance = (float)MathUtils::round_int( (float)m_face->glyph->advance.x / 64 );
+  ch->right = ch->left + glyph.width;
+  ch->bottom = ch->top + glyph.rows;
+  ch->advance = glyph.advance;
 
   // we need only render if we actually have some pixels
   if (!isEmptyGlyph)
@@ -783,20 +869,101 @@ bool CGUIFontTTFBase::CacheCharacter(wchar_t letter, uint32_t style, Character *
     // ensure our rect will stay inside the texture (it *should* but we need to be certain)
     unsigned int x1 = std::max(m_posX + ch->offsetX, 0);
     unsigned int y1 = std::max(m_posY + ch->offsetY, 0);
-    unsigned int x2 = std::min(x1 + bitmap.width, m_textureWidth);
-    unsigned int y2 = std::min(y1 + bitmap.rows, m_textureHeight);
-    CopyCharToTexture(bitGlyph, x1, y1, x2, y2);
+    unsigned int x2 = std::min(x1 + glyph.width, m_textureWidth);
+    unsigned int y2 = std::min(y1 + glyph.rows, m_textureHeight);
+    CopyCharToTexture(glyph, x1, y1, x2, y2);
 
     m_posX += spacing_between_characters_in_texture + (unsigned short)std::max(ch->right - ch->left + ch->offsetX, ch->advance);
   }
   m_numChars++;
 
+  return true;
+}
+
+bool CGUIFontTTFBase::RenderGlyph(FT_Face face, FT_Stroker stroker, wchar_t letter, uint32_t style, SGlyphBitmap& glyph)
+{
+  int glyph_index = FT_Get_Char_Index( face, letter );
+
+  FT_Glyph ftGlyph = NULL;
+  if (FT_Load_Glyph( face, glyph_index, FT_LOAD_TARGET_LIGHT ))
+  {
+    CLog::Log(LOGDEBUG, "%s Failed to load glyph %x", __FUNCTION__, static_cast<uint32_t>(letter));
+    return false;
+  }
+  // make bold if applicable
+  if (style & FONT_STYLE_BOLD)
+    SetGlyphStrength(face->glyph, GLYPH_STRENGTH_BOLD);
+  // and italics if applicable
+  if (style & FONT_STYLE_ITALICS)
+    ObliqueGlyph(face->glyph);
+  // and light if applicable
+  if (style & FONT_STYLE_LIGHT)
+    SetGlyphStrength(face->glyph, GLYPH_STRENGTH_LIGHT);
+  // grab the glyph
+  if (FT_Get_Glyph(face->glyph, &ftGlyph))
+  {
+    CLog::Log(LOGDEBUG, "%s Failed to get glyph %x", __FUNCTION__, static_cast<uint32_t>(letter));
+    return false;
+  }
+  if (stroker)
+    FT_Glyph_StrokeBorder(&ftGlyph, stroker, 0, 1);
+  // render the glyph
+  if (FT_Glyph_To_Bitmap(&ftGlyph, FT_RENDER_MODE_NORMAL, NULL, 1))
+  {
+    CLog::Log(LOGDEBUG, "%s Failed to render glyph %x to a bitmap", __FUNCTION__, static_cast<uint32_t>(letter));
+    return false;
+  }
+  FT_BitmapGlyph bitGlyph = (FT_BitmapGlyph)ftGlyph;
+  FT_Bitmap bitmap = bitGlyph->bitmap;
+
+  glyph.left = bitGlyph->left;
+  glyph.top = bitGlyph->top;
+  glyph.width = bitmap.width;
+  glyph.rows = bitmap.rows;
+  glyph.advance = (float)MathUtils::round_int( (float)face->glyph->advance.x / 64 );
+  glyph.pixels.resize(glyph.width * glyph.rows);
+  for (unsigned int y = 0; y < glyph.rows; y++)
+    memcpy(glyph.pixels.data() + y * glyph.width, bitmap.buffer + y * bitmap.pitch, glyph.width);
+
   // free the glyph
-  FT_Done_Glyph(glyph);
+  FT_Done_Glyph(ftGlyph);
+
+  return true;
+}
 
+bool CGUIFontTTFBase::AllocateTextureLine()
+{
+  m_posX = 0;
+  m_posY += GetTextureLineHeight();
+
+  if (m_posY + GetTextureLineHeight() >= m_textureHeight)
+  {
+    // create the new larger texture
+    unsigned int newHeight = m_posY + GetTextureLineHeight();
+    // check for max height
+    if (newHeight > m_renderSystem->GetMaxTextureSize())
+    {
+      CLog::Log(LOGDEBUG, "%s: New cache texture is too large (%u > %u pixels long)", __FUNCTION__, newHeight, m_renderSystem->GetMaxTextureSize());
+      return false;
+    }
+
+    CBaseTexture* newTexture = ReallocTexture(newHeight);
+    if (newTexture == NULL)
+    {
+      CLog::Log(LOGDEBUG, "%s: Failed to allocate new texture of height %u", __FUNCTION__, newHeight);
+      return false;
+    }
+    m_texture = newTexture;
+  }
   return true;
 }
 
+void CGUIFontTTFBase::ReleaseCharacterTexture()
+{
+  delete m_texture;
+  m_texture = NULL;
+}
+
 void CGUIFontTTFBase::RenderCharacter(float posX, float posY, const Character *ch, UTILS::Color color, bool roundX, std::vector<SVertex> &vertices)
 {
   // actual image width isn't same as the character width as that is
@@ -968,8 +1135,8 @@ void CGUIFontTTFBase::SetGlyphStrength(FT_GlyphSlot slot, int glyphStrength)
     return;
 
   /* some reasonable strength */
-  FT_Pos strength = FT_MulFix( m_face->units_per_EM,
-                    m_face->size->metrics.y_scale ) / glyphStrength;
+  FT_Pos strength = FT_MulFix( slot->face->units_per_EM,
+                    slot->face->size->metrics.y_scale ) / glyphStrength;
 
   FT_BBox bbox_before, bbox_after;
   FT_Outline_Get_CBox( &slot->outline, &bbox_before );
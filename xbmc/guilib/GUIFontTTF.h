@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <memory>
 #include <string>
 #include <stdint.h>
 #include <vector>
@@ -85,7 +86,28 @@ public:
 
   const std::string& GetFileName() const { return m_strFileName; };
 
+  /*! \brief Render glyphs in the background before they are needed
+   Characters that aren't cached yet are rendered on a job thread with a FreeType instance of its
+   own, the first draw of such a character then only has to copy it to the texture.
+   \param characters styled characters as drawn by CGUIFont
+   */
+  void Prewarm(const vecText& characters);
+
+  /*! \brief Drop the vertices cached for strings drawn recently, they are rebuilt when drawn again */
+  void FlushCache();
+
 protected:
+  /*! \brief a rendered glyph, rows of 8 bit alpha without padding */
+  struct SGlyphBitmap
+  {
+    int left = 0;
+    int top = 0;
+    unsigned int width = 0;
+    unsigned int rows = 0;
+    float advance = 0.0f;
+    std::vector<unsigned char> pixels;
+  };
+
   struct Character
   {
     short offsetX, offsetY;
@@ -107,6 +129,8 @@ protected:
                             uint32_t alignment, float maxPixelWidth, bool scrolling);
 
   float m_height;
+  float m_aspect = 1.0f;
+  bool m_border = false;
   std::string m_strFilename;
 
   // Stuff for pre-rendering for speed
@@ -116,11 +140,20 @@ protected:
   void ClearCharacterCache();
 
   virtual CBaseTexture* ReallocTexture(unsigned int& newHeight) = 0;
-  virtual bool CopyCharToTexture(FT_BitmapGlyph bitGlyph, unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2) = 0;
+  virtual bool CopyCharToTexture(const SGlyphBitmap& glyph, unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2) = 0;
   virtual void DeleteHardwareTexture() = 0;
 
+  /*! \brief move m_posX/m_posY to the start of a new line in the texture, growing it as needed
+   \return false if there is no more room
+   */
+  virtual bool AllocateTextureLine();
+  /*! \brief drop the texture the characters are rendered to */
+  virtual void ReleaseCharacterTexture();
+
+  static bool RenderGlyph(FT_Face face, FT_Stroker stroker, wchar_t letter, uint32_t style, SGlyphBitmap& glyph);
+
   // modifying glyphs
-  void SetGlyphStrength(FT_GlyphSlot slot, int glyphStrength);
+  static void SetGlyphStrength(FT_GlyphSlot slot, int glyphStrength);
   static void ObliqueGlyph(FT_GlyphSlot slot);
 
   CBaseTexture* m_texture;        // texture that holds our rendered characters (8bit alpha only)
@@ -183,6 +216,14 @@ protected:
   CRenderSystemBase *m_renderSystem = nullptr;
 
 private:
+  struct SPrewarmState;
+
+  bool TakePrewarmedGlyph(character_t letterAndStyle, SGlyphBitmap& glyph);
+  void CancelPrewarm();
+  static void PrewarmGlyphs(std::shared_ptr<SPrewarmState> state);
+
+  std::shared_ptr<SPrewarmState> m_prewarm;
+
   virtual bool FirstBegin() = 0;
   virtual void LastEnd() = 0;
   CGUIFontTTFBase(const CGUIFontTTFBase&) = delete;
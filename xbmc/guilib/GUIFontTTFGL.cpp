@@ -9,11 +9,14 @@
 #include "GUIFont.h"
 #include "GUIFontTTFGL.h"
 #include "GUIFontManager.h"
+#include "GUITexture.h"
 #include "Texture.h"
 #include "TextureManager.h"
 #include "windowing/GraphicContext.h"
 #include "ServiceBroker.h"
 #include "gui3d.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "utils/log.h"
 #include "utils/GLUtils.h"
 #ifdef HAS_GL
@@ -23,7 +26,9 @@
 #endif
 #include "rendering/MatrixGL.h"
 
+#include <algorithm>
 #include <cassert>
+#include <cstring>
 
 // stuff for freetype
 #include <ft2build.h>
@@ -34,77 +39,231 @@
 #define ELEMENT_ARRAY_MAX_CHAR_INDEX (1000)
 #define BUFFER_OFFSET(i) ((char *)NULL + (i))
 
-CGUIFontTTFGL::CGUIFontTTFGL(const std::string& strFileName)
-: CGUIFontTTFBase(strFileName)
+namespace
 {
-  m_updateY1 = 0;
-  m_updateY2 = 0;
-  m_textureStatus = TEXTURE_VOID;
-}
+// width of the texture shared by the fonts, enough for a line of glyphs of the largest skin fonts
+constexpr unsigned int ATLAS_WIDTH = 2048;
 
-CGUIFontTTFGL::~CGUIFontTTFGL(void)
+#ifdef HAS_GL
+typedef CRenderSystemGL CFontRenderSystem;
+#else
+typedef CRenderSystemGLES CFontRenderSystem;
+#endif
+
+void EnableFontShader(CFontRenderSystem* renderSystem)
 {
-  // It's important that all the CGUIFontCacheEntry objects are
-  // destructed before the CGUIFontTTFGL goes out of scope, because
-  // our virtual methods won't be accessible after this point
-  m_dynamicCache.Flush();
-  DeleteHardwareTexture();
+#ifdef HAS_GL
+  renderSystem->EnableShader(SM_FONTS);
+#else
+  renderSystem->EnableGUIShader(SM_FONTS);
+#endif
 }
 
-bool CGUIFontTTFGL::FirstBegin()
+void DisableFontShader(CFontRenderSystem* renderSystem)
 {
-#if defined(HAS_GL)
-  GLenum pixformat = GL_RED;
-  GLenum internalFormat;
-  unsigned int major, minor;
-  CRenderSystemGL* renderSystem = dynamic_cast<CRenderSystemGL*>(CServiceBroker::GetRenderSystem());
-  renderSystem->GetRenderVersion(major, minor);
-  if (major >= 3)
-    internalFormat = GL_R8;
-  else
-    internalFormat = GL_LUMINANCE;
+#ifdef HAS_GL
+  renderSystem->DisableShader();
 #else
-  GLenum pixformat = GL_ALPHA; // deprecated
-  GLenum internalFormat = GL_ALPHA;
+  renderSystem->DisableGUIShader();
 #endif
+}
 
-  if (m_textureStatus == TEXTURE_REALLOCATED)
+bool SameMatrix(const CMatrixGL& a, const CMatrixGL& b)
+{
+  return memcmp(static_cast<const float*>(a), static_cast<const float*>(b), 16 * sizeof(float)) == 0;
+}
+
+// quads of all fonts drawn with the same texture, scissor and matrices
+struct SBatchRun
+{
+  GLuint texture;
+  CRect scissor;
+  CMatrixGL project;
+  CMatrixGL modview;
+  size_t first;
+  size_t count;
+  CRect bounds;
+  bool flat; //!< all vertices at z = 0
+};
+
+std::vector<SVertex> batchVertices;
+std::vector<SBatchRun> batchRuns;
+bool batchFlushing = false;
+GLuint batchVertexBuffer = 0;
+
+void AddBatchRun(GLuint texture, const CRect& scissor, size_t count)
+{
+  const CMatrixGL& project = glMatrixProject.Get();
+  const CMatrixGL& modview = glMatrixModview.Get();
+
+  // kept for the textures queued later, they are drawn first
+  const size_t first = batchVertices.size() / 4 - count;
+  const SVertex& start = batchVertices[first * 4];
+  CRect bounds(start.x, start.y, start.x, start.y);
+  bool flat = true;
+  for (size_t i = first * 4; i < batchVertices.size(); ++i)
   {
-    if (glIsTexture(m_nTexture))
-      CServiceBroker::GetGUI()->GetTextureManager().ReleaseHwTexture(m_nTexture);
-    m_textureStatus = TEXTURE_VOID;
+    const SVertex& vertex = batchVertices[i];
+    bounds.x1 = std::min(bounds.x1, vertex.x);
+    bounds.y1 = std::min(bounds.y1, vertex.y);
+    bounds.x2 = std::max(bounds.x2, vertex.x);
+    bounds.y2 = std::max(bounds.y2, vertex.y);
+    flat &= vertex.z == 0.0f;
   }
 
-  if (m_textureStatus == TEXTURE_VOID)
+  if (!batchRuns.empty())
   {
-    // Have OpenGL generate a texture object handle for us
-    glGenTextures(1, (GLuint*) &m_nTexture);
+    SBatchRun& last = batchRuns.back();
+    if (last.texture == texture && last.scissor == scissor &&
+        SameMatrix(last.project, project) && SameMatrix(last.modview, modview))
+    {
+      last.count += count;
+      last.bounds.x1 = std::min(last.bounds.x1, bounds.x1);
+      last.bounds.y1 = std::min(last.bounds.y1, bounds.y1);
+      last.bounds.x2 = std::max(last.bounds.x2, bounds.x2);
+      last.bounds.y2 = std::max(last.bounds.y2, bounds.y2);
+      last.flat &= flat;
+      return;
+    }
+  }
+  batchRuns.push_back({texture, scissor, project, modview, first, count, bounds, flat});
+}
+}
 
-    // Bind the texture object
-    glBindTexture(GL_TEXTURE_2D, m_nTexture);
+struct CGUIFontTTFGL::SAtlas
+{
+  SAtlas(unsigned int width, bool shared) : width(width), shared(shared) {}
+  ~SAtlas();
 
-    // Set the texture's stretching properties
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  bool AddLine(unsigned int lineHeight, const CGUIFontTTFGL* font, int& posY);
+  bool Grow(unsigned int newHeight, const CGUIFontTTFGL* font);
+  void Upload()
+  {
+    if (texture)
+      UploadTexture(texture, handle, status, updateY1, updateY2);
+  }
 
-    // Set the texture image -- THIS WORKS, so the pixels must be wrong.
-    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, m_texture->GetWidth(), m_texture->GetHeight(), 0,
-        pixformat, GL_UNSIGNED_BYTE, 0);
+  const unsigned int width;
+  const bool shared;
+  unsigned int height = 0;
+  unsigned int nextY = 0; //!< top of the next free line
+  CBaseTexture* texture = nullptr;
+  GLuint handle = 0;
+  TextureStatus status = TEXTURE_VOID;
+  unsigned int updateY1 = 0;
+  unsigned int updateY2 = 0;
+  std::vector<CGUIFontTTFGL*> fonts;
+};
+
+CGUIFontTTFGL::SAtlas::~SAtlas()
+{
+  delete texture;
+  if (status != TEXTURE_VOID && glIsTexture(handle))
+    CServiceBroker::GetGUI()->GetTextureManager().ReleaseHwTexture(handle);
+}
 
-    VerifyGLState();
-    m_textureStatus = TEXTURE_UPDATED;
+bool CGUIFontTTFGL::SAtlas::AddLine(unsigned int lineHeight, const CGUIFontTTFGL* font, int& posY)
+{
+  if (nextY + lineHeight > height && !Grow(nextY + lineHeight, font))
+    return false;
+
+  posY = nextY;
+  nextY += lineHeight;
+  return true;
+}
+
+bool CGUIFontTTFGL::SAtlas::Grow(unsigned int newHeight, const CGUIFontTTFGL* font)
+{
+  newHeight = CBaseTexture::PadPow2(newHeight);
+  if (newHeight > CServiceBroker::GetRenderSystem()->GetMaxTextureSize())
+  {
+    CLog::Log(LOGDEBUG, "%s: font texture is full (%u > %u pixels long)", __FUNCTION__, newHeight,
+              CServiceBroker::GetRenderSystem()->GetMaxTextureSize());
+    return false;
   }
 
-  if (m_textureStatus == TEXTURE_UPDATED)
+  CBaseTexture* newTexture = new CTexture(width, newHeight, XB_FMT_A8);
+  if (newTexture->GetPixels() == NULL)
   {
-    glBindTexture(GL_TEXTURE_2D, m_nTexture);
-    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, m_updateY1, m_texture->GetWidth(), m_updateY2 - m_updateY1, pixformat, GL_UNSIGNED_BYTE,
-        m_texture->GetPixels() + m_updateY1 * m_texture->GetPitch());
+    CLog::Log(LOGERROR, "%s: Error creating new font texture of height %u", __FUNCTION__, newHeight);
+    delete newTexture;
+    return false;
+  }
 
-    m_updateY1 = m_updateY2 = 0;
-    m_textureStatus = TEXTURE_READY;
+  // the texture coordinates of text waiting to be drawn refer to the old height
+  for (CGUIFontTTFGL* other : fonts)
+  {
+    if (other != font && other->m_nestedBeginCount > 0)
+    {
+      other->QueueVertices();
+      other->m_vertex.clear();
+      other->m_vertexTrans.clear();
+    }
+  }
+  FlushBatch();
+
+  memset(newTexture->GetPixels(), 0, newTexture->GetHeight() * newTexture->GetPitch());
+  if (texture)
+  {
+    updateY1 = 0;
+    updateY2 = texture->GetHeight();
+
+    unsigned char* src = texture->GetPixels();
+    unsigned char* dst = newTexture->GetPixels();
+    for (unsigned int y = 0; y < texture->GetHeight(); y++)
+    {
+      memcpy(dst, src, texture->GetPitch());
+      src += texture->GetPitch();
+      dst += newTexture->GetPitch();
+    }
+    delete texture;
+  }
+  texture = newTexture;
+  height = newTexture->GetHeight();
+  status = TEXTURE_REALLOCATED;
+
+  for (CGUIFontTTFGL* other : fonts)
+  {
+    other->m_texture = texture;
+    other->m_textureHeight = height;
+    other->m_textureScaleY = 1.0f / height;
+    other->m_staticCache.Flush();
+    other->m_dynamicCache.Flush();
+  }
+  return true;
+}
+
+CGUIFontTTFGL::CGUIFontTTFGL(const std::string& strFileName)
+: CGUIFontTTFBase(strFileName)
+{
+  m_updateY1 = 0;
+  m_updateY2 = 0;
+  m_textureStatus = TEXTURE_VOID;
+  m_batching = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiFontBatching;
+}
+
+CGUIFontTTFGL::~CGUIFontTTFGL(void)
+{
+  // It's important that all the CGUIFontCacheEntry objects are
+  // destructed before the CGUIFontTTFGL goes out of scope, because
+  // our virtual methods won't be accessible after this point
+  m_dynamicCache.Flush();
+  ReleaseCharacterTexture();
+  DeleteHardwareTexture();
+}
+
+bool CGUIFontTTFGL::FirstBegin()
+{
+  if (m_batching)
+  {
+    // the text is drawn with the batch, only the texture has to be up to date
+    if (m_atlas)
+      m_atlas->Upload();
+    return true;
   }
 
+  UploadTexture(m_texture, m_nTexture, m_textureStatus, m_updateY1, m_updateY2);
+
   // Turn Blending On
   glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
   glEnable(GL_BLEND);
@@ -115,6 +274,15 @@ bool CGUIFontTTFGL::FirstBegin()
 
 void CGUIFontTTFGL::LastEnd()
 {
+  if (m_batching)
+  {
+    QueueVertices();
+    return;
+  }
+
+  // the queued textures lie below the text
+  FlushBatch();
+
 #ifdef HAS_GL
   CRenderSystemGL* renderSystem = dynamic_cast<CRenderSystemGL*>(CServiceBroker::GetRenderSystem());
   renderSystem->EnableShader(SM_FONTS);
@@ -290,6 +458,15 @@ CVertexBuffer CGUIFontTTFGL::CreateVertexBuffer(const std::vector<SVertex> &vert
   assert(vertices.size() % 4 == 0);
   GLuint bufferHandle = 0;
 
+  if (m_batching)
+  {
+    // copied into the batch every frame, a buffer object wouldn't be used
+    CVertexBuffer buffer(bufferHandle, vertices.size() / 4, this);
+    if (!vertices.empty())
+      buffer.vertices = std::make_shared<const std::vector<SVertex>>(vertices);
+    return buffer;
+  }
+
   // Do not create empty buffers, leave buffer as 0, it will be ignored in drawing stage
   if (!vertices.empty())
   {
@@ -316,6 +493,7 @@ void CGUIFontTTFGL::DestroyVertexBuffer(CVertexBuffer &buffer) const
     glDeleteBuffers(1, (GLuint *) &buffer.bufferHandle);
     buffer.bufferHandle = 0;
   }
+  buffer.vertices.reset();
 }
 
 CBaseTexture* CGUIFontTTFGL::ReallocTexture(unsigned int& newHeight)
@@ -361,40 +539,376 @@ CBaseTexture* CGUIFontTTFGL::ReallocTexture(unsigned int& newHeight)
   return newTexture;
 }
 
-bool CGUIFontTTFGL::CopyCharToTexture(FT_BitmapGlyph bitGlyph, unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2)
+bool CGUIFontTTFGL::CopyCharToTexture(const SGlyphBitmap& glyph, unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2)
 {
-  FT_Bitmap bitmap = bitGlyph->bitmap;
-
-  unsigned char* source = bitmap.buffer;
+  const unsigned char* source = glyph.pixels.data();
   unsigned char* target = m_texture->GetPixels() + y1 * m_texture->GetPitch() + x1;
 
   for (unsigned int y = y1; y < y2; y++)
   {
     memcpy(target, source, x2-x1);
-    source += bitmap.width;
+    source += glyph.width;
     target += m_texture->GetPitch();
   }
 
-  switch (m_textureStatus)
+  if (m_atlas)
+    MarkTextureUpdated(m_atlas->status, m_atlas->updateY1, m_atlas->updateY2, y1, y2);
+  else
+    MarkTextureUpdated(m_textureStatus, m_updateY1, m_updateY2, y1, y2);
+
+  return true;
+}
+
+void CGUIFontTTFGL::DeleteHardwareTexture()
+{
+  if (m_textureStatus != TEXTURE_VOID)
+  {
+    if (glIsTexture(m_nTexture))
+      CServiceBroker::GetGUI()->GetTextureManager().ReleaseHwTexture(m_nTexture);
+
+    m_textureStatus = TEXTURE_VOID;
+    m_updateY1 = m_updateY2 = 0;
+  }
+}
+
+bool CGUIFontTTFGL::AllocateTextureLine()
+{
+  if (!m_batching)
+    return CGUIFontTTFBase::AllocateTextureLine();
+
+  if (!m_atlas)
+  {
+    if (m_privateAtlas)
+    {
+      unsigned int width = std::min(ATLAS_WIDTH, m_renderSystem->GetMaxTextureSize());
+      AttachAtlas(std::make_shared<SAtlas>(width, false));
+    }
+    else
+      AttachAtlas(GetSharedAtlas());
+  }
+
+  int posY;
+  if (!m_atlas->AddLine(GetTextureLineHeight(), this, posY))
+  {
+    // once the shared texture is full, continue on one of our own. It gets cleared when that
+    // is full as well, just like the texture of a font that doesn't batch.
+    if (m_atlas->shared)
+    {
+      CLog::Log(LOGDEBUG, "%s: shared font texture is full, moving %s to a texture of its own", __FUNCTION__, m_strFilename.c_str());
+      m_privateAtlas = true;
+    }
+    return false;
+  }
+
+  m_posX = 0;
+  m_posY = posY;
+  return true;
+}
+
+void CGUIFontTTFGL::ReleaseCharacterTexture()
+{
+  if (!m_atlas)
+  {
+    CGUIFontTTFBase::ReleaseCharacterTexture();
+    return;
+  }
+
+  // the lines of a shared texture stay in use until all of its fonts are gone
+  m_atlas->fonts.erase(std::remove(m_atlas->fonts.begin(), m_atlas->fonts.end(), this), m_atlas->fonts.end());
+  m_atlas.reset();
+  m_texture = NULL;
+}
+
+void CGUIFontTTFGL::AttachAtlas(const std::shared_ptr<SAtlas>& atlas)
+{
+  m_atlas = atlas;
+  m_atlas->fonts.push_back(this);
+
+  m_texture = m_atlas->texture;
+  m_textureWidth = m_atlas->width;
+  m_textureScaleX = 1.0f / m_textureWidth;
+  m_textureHeight = m_atlas->height;
+  m_textureScaleY = m_textureHeight ? 1.0f / m_textureHeight : 0.0f;
+}
+
+std::shared_ptr<CGUIFontTTFGL::SAtlas> CGUIFontTTFGL::GetSharedAtlas()
+{
+  std::shared_ptr<SAtlas> atlas = m_sharedAtlas.lock();
+  if (!atlas)
+  {
+    unsigned int width = std::min(ATLAS_WIDTH, CServiceBroker::GetRenderSystem()->GetMaxTextureSize());
+    atlas = std::make_shared<SAtlas>(width, true);
+    m_sharedAtlas = atlas;
+  }
+  return atlas;
+}
+
+void CGUIFontTTFGL::QueueVertices()
+{
+  if (!m_atlas || (m_vertex.empty() && m_vertexTrans.empty()))
+    return;
+
+  // the glyphs may have been added after the last Begin()
+  m_atlas->Upload();
+
+  // the shader provides the factors to map the clip regions to the screen
+  CFontRenderSystem* renderSystem = dynamic_cast<CFontRenderSystem*>(CServiceBroker::GetRenderSystem());
+  EnableFontShader(renderSystem);
+
+  const CRect scissor = CServiceBroker::GetWinSystem()->GetGfxContext().StereoCorrection(CServiceBroker::GetWinSystem()->GetGfxContext().GetScissors());
+
+  if (!m_vertex.empty())
+  {
+    batchVertices.insert(batchVertices.end(), m_vertex.begin(), m_vertex.end());
+    AddBatchRun(m_atlas->handle, scissor, m_vertex.size() / 4);
+  }
+
+  for (const CTranslatedVertices& trans : m_vertexTrans)
+  {
+    const std::shared_ptr<const std::vector<SVertex>>& vertices = trans.vertexBuffer->vertices;
+    if (!vertices || vertices->empty())
+      continue;
+
+    CRect clip = renderSystem->ClipRectToScissorRect(trans.clip);
+    if (!clip.IsEmpty())
+    {
+      clip.Intersect(scissor);
+      if (clip.IsEmpty())
+        continue;
+    }
+    else
+      clip = scissor;
+
+    // translated here rather than by the model view matrix so the text can share a draw call
+    for (SVertex vertex : *vertices)
+    {
+      vertex.x += trans.translateX;
+      vertex.y += trans.translateY;
+      vertex.z += trans.translateZ;
+      batchVertices.push_back(vertex);
+    }
+    AddBatchRun(m_atlas->handle, clip, vertices->size() / 4);
+  }
+
+  DisableFontShader(renderSystem);
+}
+
+bool CGUIFontTTFGL::BatchIntersects(const CRect& bounds, bool flat)
+{
+  const CMatrixGL& project = glMatrixProject.Get();
+  const CMatrixGL& modview = glMatrixModview.Get();
+
+  for (const SBatchRun& run : batchRuns)
+  {
+    if (!flat || !run.flat || !SameMatrix(run.project, project) || !SameMatrix(run.modview, modview))
+      return true;
+    if (run.bounds.x1 < bounds.x2 && bounds.x1 < run.bounds.x2 &&
+        run.bounds.y1 < bounds.y2 && bounds.y1 < run.bounds.y2)
+      return true;
+  }
+  return false;
+}
+
+void CGUIFontTTFGL::FlushBatch()
+{
+  if (batchFlushing)
+    return;
+  batchFlushing = true;
+
+  // the textures were queued before the text or don't overlap it
+  CGUITexture::DrawBatch();
+
+  if (batchRuns.empty())
+  {
+    batchFlushing = false;
+    return;
+  }
+
+  CFontRenderSystem* renderSystem = dynamic_cast<CFontRenderSystem*>(CServiceBroker::GetRenderSystem());
+
+  // the caller may already have set up the texture, blending and scissor for its own drawing
+  GLint activeTexture;
+  GLint boundTexture;
+  GLint scissorBox[4];
+  GLint blendSrcRGB, blendDstRGB, blendSrcAlpha, blendDstAlpha;
+  glGetIntegerv(GL_ACTIVE_TEXTURE, &activeTexture);
+  glActiveTexture(GL_TEXTURE0);
+  glGetIntegerv(GL_TEXTURE_BINDING_2D, &boundTexture);
+  glGetIntegerv(GL_SCISSOR_BOX, scissorBox);
+  glGetIntegerv(GL_BLEND_SRC_RGB, &blendSrcRGB);
+  glGetIntegerv(GL_BLEND_DST_RGB, &blendDstRGB);
+  glGetIntegerv(GL_BLEND_SRC_ALPHA, &blendSrcAlpha);
+  glGetIntegerv(GL_BLEND_DST_ALPHA, &blendDstAlpha);
+  const GLboolean blend = glIsEnabled(GL_BLEND);
+
+  CreateStaticVertexBuffers();
+  if (batchVertexBuffer == 0)
+    glGenBuffers(1, &batchVertexBuffer);
+
+  glBindBuffer(GL_ARRAY_BUFFER, batchVertexBuffer);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(SVertex) * batchVertices.size(), batchVertices.data(), GL_STREAM_DRAW);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, m_elementArrayHandle);
+
+  glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
+  glEnable(GL_BLEND);
+
+  glMatrixProject.Push();
+  glMatrixModview.Push();
+
+  GLint posLoc = -1;
+  GLint colLoc = -1;
+  GLint tex0Loc = -1;
+  const SBatchRun* previous = nullptr;
+  for (const SBatchRun& run : batchRuns)
+  {
+    if (!previous || !SameMatrix(previous->project, run.project) || !SameMatrix(previous->modview, run.modview))
+    {
+      // enabling the shader uploads the matrices the text was queued with
+      glMatrixProject.Get() = run.project;
+      glMatrixModview.Get() = run.modview;
+      EnableFontShader(renderSystem);
+      if (!previous)
+      {
+#ifdef HAS_GL
+        posLoc = renderSystem->ShaderGetPos();
+        colLoc = renderSystem->ShaderGetCol();
+        tex0Loc = renderSystem->ShaderGetCoord0();
+#else
+        posLoc = renderSystem->GUIShaderGetPos();
+        colLoc = renderSystem->GUIShaderGetCol();
+        tex0Loc = renderSystem->GUIShaderGetCoord0();
+#endif
+        glEnableVertexAttribArray(posLoc);
+        glEnableVertexAttribArray(colLoc);
+        glEnableVertexAttribArray(tex0Loc);
+      }
+    }
+    if (!previous || previous->texture != run.texture)
+      glBindTexture(GL_TEXTURE_2D, run.texture);
+    if (!previous || previous->scissor != run.scissor)
+      renderSystem->SetScissors(run.scissor);
+    previous = &run;
+
+    // split into groups of characters no larger than the element array
+    for (size_t character = run.first; character < run.first + run.count; character += ELEMENT_ARRAY_MAX_CHAR_INDEX)
+    {
+      size_t count = std::min<size_t>(run.first + run.count - character, ELEMENT_ARRAY_MAX_CHAR_INDEX);
+
+      glVertexAttribPointer(posLoc,  3, GL_FLOAT,         GL_FALSE, sizeof(SVertex), BUFFER_OFFSET(character*sizeof(SVertex)*4 + offsetof(SVertex, x)));
+      glVertexAttribPointer(colLoc,  4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(SVertex), BUFFER_OFFSET(character*sizeof(SVertex)*4 + offsetof(SVertex, r)));
+      glVertexAttribPointer(tex0Loc, 2, GL_FLOAT,         GL_FALSE, sizeof(SVertex), BUFFER_OFFSET(character*sizeof(SVertex)*4 + offsetof(SVertex, u)));
+
+      glDrawElements(GL_TRIANGLES, 6 * count, GL_UNSIGNED_SHORT, 0);
+    }
+  }
+
+  glDisableVertexAttribArray(posLoc);
+  glDisableVertexAttribArray(colLoc);
+  glDisableVertexAttribArray(tex0Loc);
+  DisableFontShader(renderSystem);
+
+  glMatrixProject.Pop();
+  glMatrixModview.Pop();
+
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+  glScissor(scissorBox[0], scissorBox[1], scissorBox[2], scissorBox[3]);
+  glBlendFuncSeparate(blendSrcRGB, blendDstRGB, blendSrcAlpha, blendDstAlpha);
+  if (!blend)
+    glDisable(GL_BLEND);
+  glBindTexture(GL_TEXTURE_2D, boundTexture);
+  glActiveTexture(activeTexture);
+
+  DiscardBatch();
+}
+
+void CGUIFontTTFGL::DiscardBatch()
+{
+  CGUITexture::DiscardBatch();
+  batchVertices.clear();
+  batchRuns.clear();
+  batchFlushing = false;
+}
+
+void CGUIFontTTFGL::UploadTexture(const CBaseTexture* texture, GLuint& handle, TextureStatus& status,
+                                  unsigned int& updateY1, unsigned int& updateY2)
+{
+#if defined(HAS_GL)
+  GLenum pixformat = GL_RED;
+  GLenum internalFormat;
+  unsigned int major, minor;
+  CRenderSystemGL* renderSystem = dynamic_cast<CRenderSystemGL*>(CServiceBroker::GetRenderSystem());
+  renderSystem->GetRenderVersion(major, minor);
+  if (major >= 3)
+    internalFormat = GL_R8;
+  else
+    internalFormat = GL_LUMINANCE;
+#else
+  GLenum pixformat = GL_ALPHA; // deprecated
+  GLenum internalFormat = GL_ALPHA;
+#endif
+
+  if (status == TEXTURE_REALLOCATED)
+  {
+    if (glIsTexture(handle))
+      CServiceBroker::GetGUI()->GetTextureManager().ReleaseHwTexture(handle);
+    status = TEXTURE_VOID;
+  }
+
+  if (status == TEXTURE_VOID)
+  {
+    // Have OpenGL generate a texture object handle for us
+    glGenTextures(1, &handle);
+
+    // Bind the texture object
+    glBindTexture(GL_TEXTURE_2D, handle);
+
+    // Set the texture's stretching properties
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+
+    // Set the texture image -- THIS WORKS, so the pixels must be wrong.
+    glTexImage2D(GL_TEXTURE_2D, 0, internalFormat, texture->GetWidth(), texture->GetHeight(), 0,
+        pixformat, GL_UNSIGNED_BYTE, 0);
+
+    VerifyGLState();
+    status = TEXTURE_UPDATED;
+  }
+
+  if (status == TEXTURE_UPDATED)
+  {
+    glBindTexture(GL_TEXTURE_2D, handle);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, updateY1, texture->GetWidth(), updateY2 - updateY1, pixformat, GL_UNSIGNED_BYTE,
+        texture->GetPixels() + updateY1 * texture->GetPitch());
+
+    updateY1 = updateY2 = 0;
+    status = TEXTURE_READY;
+  }
+}
+
+void CGUIFontTTFGL::MarkTextureUpdated(TextureStatus& status, unsigned int& updateY1, unsigned int& updateY2,
+                                       unsigned int y1, unsigned int y2)
+{
+  switch (status)
   {
   case TEXTURE_UPDATED:
     {
-      m_updateY1 = std::min(m_updateY1, y1);
-      m_updateY2 = std::max(m_updateY2, y2);
+      updateY1 = std::min(updateY1, y1);
+      updateY2 = std::max(updateY2, y2);
     }
     break;
 
   case TEXTURE_READY:
     {
-      m_updateY1 = y1;
-      m_updateY2 = y2;
-      m_textureStatus = TEXTURE_UPDATED;
+      updateY1 = y1;
+      updateY2 = y2;
+      status = TEXTURE_UPDATED;
     }
     break;
 
   case TEXTURE_REALLOCATED:
     {
-      m_updateY2 = std::max(m_updateY2, y2);
+      updateY2 = std::max(updateY2, y2);
     }
     break;
 
@@ -402,20 +916,6 @@ bool CGUIFontTTFGL::CopyCharToTexture(FT_BitmapGlyph bitGlyph, unsigned int x1,
   default:
     break;
   }
-
-  return true;
-}
-
-void CGUIFontTTFGL::DeleteHardwareTexture()
-{
-  if (m_textureStatus != TEXTURE_VOID)
-  {
-    if (glIsTexture(m_nTexture))
-      CServiceBroker::GetGUI()->GetTextureManager().ReleaseHwTexture(m_nTexture);
-
-    m_textureStatus = TEXTURE_VOID;
-    m_updateY1 = m_updateY2 = 0;
-  }
 }
 
 void CGUIFontTTFGL::CreateStaticVertexBuffers(void)
@@ -447,9 +947,14 @@ void CGUIFontTTFGL::DestroyStaticVertexBuffers(void)
   if (!m_staticVertexBufferCreated)
     return;
   glDeleteBuffers(1, &m_elementArrayHandle);
+  if (batchVertexBuffer != 0)
+    glDeleteBuffers(1, &batchVertexBuffer);
+  batchVertexBuffer = 0;
+  DiscardBatch();
   m_staticVertexBufferCreated = false;
 }
 
 GLuint CGUIFontTTFGL::m_elementArrayHandle;
 bool CGUIFontTTFGL::m_staticVertexBufferCreated;
+std::weak_ptr<CGUIFontTTFGL::SAtlas> CGUIFontTTFGL::m_sharedAtlas;
 
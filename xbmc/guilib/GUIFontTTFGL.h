@@ -10,6 +10,7 @@
 
 #include "GUIFontTTF.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -29,17 +30,31 @@ public:
   static void CreateStaticVertexBuffers(void);
   static void DestroyStaticVertexBuffers(void);
 
+  /*! \brief Draw the textures and the text of all fonts collected since the last flush.
+   Text of fonts that batch is drawn in as few calls as possible at the latest possible time, the
+   render system calls this before anything else is drawn or the render target changes. The queued
+   textures are drawn first, see CGUITexture::DrawBatch().
+   */
+  static void FlushBatch();
+
+  /*! \brief Drop the collected textures and text without drawing them, e.g. when the shaders go away */
+  static void DiscardBatch();
+
+  /*! \brief Whether queued text may overlap the given area, at the current matrices
+   \param flat all vertices of the area are at z = 0
+   */
+  static bool BatchIntersects(const CRect& bounds, bool flat);
+
 protected:
   CBaseTexture* ReallocTexture(unsigned int& newHeight) override;
-  bool CopyCharToTexture(FT_BitmapGlyph bitGlyph, unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2) override;
+  bool CopyCharToTexture(const SGlyphBitmap& glyph, unsigned int x1, unsigned int y1, unsigned int x2, unsigned int y2) override;
   void DeleteHardwareTexture() override;
+  bool AllocateTextureLine() override;
+  void ReleaseCharacterTexture() override;
 
   static GLuint m_elementArrayHandle;
 
 private:
-  unsigned int m_updateY1;
-  unsigned int m_updateY2;
-
   enum TextureStatus
   {
     TEXTURE_VOID = 0,
@@ -48,8 +63,28 @@ private:
     TEXTURE_UPDATED,
   };
 
+  /*! \brief texture the glyphs of one or more fonts are rendered to, shared line by line */
+  struct SAtlas;
+
+  static void UploadTexture(const CBaseTexture* texture, GLuint& handle, TextureStatus& status,
+                            unsigned int& updateY1, unsigned int& updateY2);
+  static void MarkTextureUpdated(TextureStatus& status, unsigned int& updateY1, unsigned int& updateY2,
+                                 unsigned int y1, unsigned int y2);
+  static std::shared_ptr<SAtlas> GetSharedAtlas();
+
+  void AttachAtlas(const std::shared_ptr<SAtlas>& atlas);
+  void QueueVertices();
+
+  unsigned int m_updateY1;
+  unsigned int m_updateY2;
+
   TextureStatus m_textureStatus;
 
+  bool m_batching;
+  bool m_privateAtlas = false; //!< the shared atlas ran full, use a texture of our own
+  std::shared_ptr<SAtlas> m_atlas;
+
   static bool m_staticVertexBufferCreated;
+  static std::weak_ptr<SAtlas> m_sharedAtlas;
 };
 
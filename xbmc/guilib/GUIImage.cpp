@@ -8,7 +8,10 @@
 
 #include "GUIImage.h"
 
+#include "GUIComponent.h"
 #include "GUIMessage.h"
+#include "ServiceBroker.h"
+#include "TextureManager.h"
 #include "utils/log.h"
 
 #include <cassert>
@@ -69,6 +72,17 @@ void CGUIImage::UpdateInfo(const CGUIListItem *item)
     SetFileName(m_info.GetLabel(m_parentID, true, &m_currentFallback));
 }
 
+void CGUIImage::GetItemImages(const CGUIListItem *item, std::vector<std::string> &images) const
+{
+  if (m_info.IsConstant())
+    return;
+
+  // only images going through the large texture manager are worth loading ahead
+  const std::string fileName = m_info.GetItemLabel(item, true);
+  if (!fileName.empty() && !CServiceBroker::GetGUI()->GetTextureManager().CanLoad(fileName))
+    images.push_back(fileName);
+}
+
 void CGUIImage::AllocateOnDemand()
 {
   // if we're hidden, we can free our resources and return
@@ -85,6 +85,7 @@ public:
   float GetTextureHeight() const;
 
   CRect CalcRenderRegion() const override;
+  void GetItemImages(const CGUIListItem *item, std::vector<std::string> &images) const override;
 
 #ifdef _DEBUG
   void DumpTextureUse() override;
@@ -9,6 +9,7 @@
 #include "GUIIncludes.h"
 
 #include "GUIInfoManager.h"
+#include "GUIXMLCache.h"
 #include "addons/Skin.h"
 #include "guilib/GUIComponent.h"
 #include "guilib/guiinfo/GUIInfoLabel.h"
@@ -93,6 +94,7 @@ void CGUIIncludes::Clear()
   m_constants.clear();
   m_skinvariables.clear();
   m_files.clear();
+  m_signature.clear();
   m_expressions.clear();
 }
 
@@ -102,6 +104,10 @@ void CGUIIncludes::Load(const std::string &file)
     return;
   FlattenExpressions();
   FlattenSkinVariableConditions();
+
+  m_signature.clear();
+  for (const auto& loadedFile : m_files)
+    m_signature += loadedFile + ":" + CGUIXMLCache::GetFileSignature(loadedFile) + ";";
 }
 
 bool CGUIIncludes::Load_Internal(const std::string &file)
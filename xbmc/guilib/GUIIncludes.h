@@ -52,6 +52,12 @@ public:
    */
   void Resolve(TiXmlElement *node, std::map<INFO::InfoPtr, bool>* includeConditions = NULL);
 
+  /*!
+   \brief Get the size and modification time of all loaded include files, changes whenever one of
+   them changed since they got loaded.
+   */
+  const std::string& GetSignature() const { return m_signature; }
+
   /*!
    \brief Create a skin variable for the given \code{name} within the given \code{context}.
 
@@ -119,6 +125,7 @@ private:
   std::string ResolveExpressions(const std::string &expression) const;
 
   std::vector<std::string> m_files;
+  std::string m_signature;
   std::map<std::string, std::pair<TiXmlElement, Params>> m_includes;
   std::map<std::string, TiXmlElement> m_defaults;
   std::map<std::string, TiXmlElement> m_skinvariables;
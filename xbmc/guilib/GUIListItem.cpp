@@ -14,6 +14,7 @@
 #include "utils/StringUtils.h"
 #include "utils/Variant.h"
 
+#include <algorithm>
 #include <utility>
 
 bool CGUIListItem::icompare::operator()(const std::string &s1, const std::string &s2) const
@@ -349,12 +350,30 @@ void CGUIListItem::SetInvalid()
   if (m_focusedLayout) m_focusedLayout->SetInvalid();
 }
 
+CGUIListItem::PropertyMap::iterator CGUIListItem::FindProperty(const std::string &strKey)
+{
+  return std::lower_bound(m_mapProperties.begin(), m_mapProperties.end(), strKey,
+    [](const PropertyMap::value_type &property, const std::string &key)
+    {
+      return icompare()(property.first, key);
+    });
+}
+
+CGUIListItem::PropertyMap::const_iterator CGUIListItem::FindProperty(const std::string &strKey) const
+{
+  return std::lower_bound(m_mapProperties.begin(), m_mapProperties.end(), strKey,
+    [](const PropertyMap::value_type &property, const std::string &key)
+    {
+      return icompare()(property.first, key);
+    });
+}
+
 void CGUIListItem::SetProperty(const std::string &strKey, const CVariant &value)
 {
-  PropertyMap::iterator iter = m_mapProperties.find(strKey);
-  if (iter == m_mapProperties.end())
+  PropertyMap::iterator iter = FindProperty(strKey);
+  if (iter == m_mapProperties.end() || icompare()(strKey, iter->first))
   {
-    m_mapProperties.insert(make_pair(strKey, value));
+    m_mapProperties.insert(iter, make_pair(strKey, value));
     SetInvalid();
   }
   else if (iter->second != value)
@@ -366,10 +385,10 @@ void CGUIListItem::SetProperty(const std::string &strKey, const CVariant &value)
 
 const CVariant &CGUIListItem::GetProperty(const std::string &strKey) const
 {
-  PropertyMap::const_iterator iter = m_mapProperties.find(strKey);
+  PropertyMap::const_iterator iter = FindProperty(strKey);
   static CVariant nullVariant = CVariant(CVariant::VariantTypeNull);
 
-  if (iter == m_mapProperties.end())
+  if (iter == m_mapProperties.end() || icompare()(strKey, iter->first))
     return nullVariant;
 
   return iter->second;
@@ -377,8 +396,8 @@ const CVariant &CGUIListItem::GetProperty(const std::string &strKey) const
 
 bool CGUIListItem::HasProperty(const std::string &strKey) const
 {
-  PropertyMap::const_iterator iter = m_mapProperties.find(strKey);
-  if (iter == m_mapProperties.end())
+  PropertyMap::const_iterator iter = FindProperty(strKey);
+  if (iter == m_mapProperties.end() || icompare()(strKey, iter->first))
     return false;
 
   return true;
@@ -386,8 +405,8 @@ bool CGUIListItem::HasProperty(const std::string &strKey) const
 
 void CGUIListItem::ClearProperty(const std::string &strKey)
 {
-  PropertyMap::iterator iter = m_mapProperties.find(strKey);
-  if (iter != m_mapProperties.end())
+  PropertyMap::iterator iter = FindProperty(strKey);
+  if (iter != m_mapProperties.end() && !icompare()(strKey, iter->first))
   {
     m_mapProperties.erase(iter);
     SetInvalid();
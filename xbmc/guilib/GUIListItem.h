@@ -16,6 +16,8 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <utility>
+#include <vector>
 
 //  Forward
 class CGUIListItemLayout;
@@ -188,9 +190,14 @@ protected:
     bool operator()(const std::string &s1, const std::string &s2) const;
   };
 
-  typedef std::map<std::string, CVariant, icompare> PropertyMap;
+  // Items rarely have more than a handful of properties, so they are kept in
+  // a vector sorted by key instead of a map with a node per property
+  typedef std::vector<std::pair<std::string, CVariant>> PropertyMap;
   PropertyMap m_mapProperties;
 private:
+  PropertyMap::iterator FindProperty(const std::string &strKey);
+  PropertyMap::const_iterator FindProperty(const std::string &strKey) const;
+
   std::wstring m_sortLabel;    // text for sorting. Need to be UTF16 for proper sorting
   std::string m_strLabel;      // text of column1
 
@@ -25,6 +25,8 @@ public:
   void Process(CGUIListItem *item, int parentID, unsigned int currentTime, CDirtyRegionList &dirtyregions);
   void Render(CGUIListItem *item, int parentID);
   float Size(ORIENTATION orientation) const;
+  /*! \brief Screen area the item covered when it was last processed */
+  const CRect &GetRenderRegion() const { return m_group.GetRenderRegion(); }
   unsigned int GetFocusedItem() const;
   void SetFocusedItem(unsigned int focus);
   bool IsAnimating(ANIMATION_TYPE animType);
@@ -42,6 +44,7 @@ public:
   void SelectItemFromPoint(const CPoint &point);
   bool MoveLeft();
   bool MoveRight();
+  void GetItemImages(const CGUIListItem *item, std::vector<std::string> &images) const { m_group.GetItemImages(item, images); };
 
 #ifdef _DEBUG
   void DumpTextureUse();
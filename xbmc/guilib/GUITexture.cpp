@@ -226,6 +226,10 @@ void CGUITextureBase::Render(float left, float top, float right, float bottom, f
   int orientation = GetOrientation();
   OrientateTexture(texture, u3, v3, orientation);
 
+  // images packed onto an atlas page start somewhere within the texture
+  if (m_texture.m_texX || m_texture.m_texY)
+    texture += CPoint(m_texture.m_texX * m_texCoordsScaleU, m_texture.m_texY * m_texCoordsScaleV);
+
   if (m_diffuse.size())
   {
     // flip the texture as necessary.  Diffuse just gets flipped according to m_info.orientation.
@@ -234,6 +238,9 @@ void CGUITextureBase::Render(float left, float top, float right, float bottom, f
     diffuse.y1 *= m_diffuseScaleV / v3; diffuse.y2 *= m_diffuseScaleV / v3;
     diffuse += m_diffuseOffset;
     OrientateTexture(diffuse, m_diffuseU, m_diffuseV, m_info.orientation);
+
+    if (m_diffuse.m_texX || m_diffuse.m_texY)
+      diffuse += CPoint(float(m_diffuse.m_texX) / m_diffuse.m_texWidth, float(m_diffuse.m_texY) / m_diffuse.m_texHeight);
   }
 
   float x[4], y[4], z[4];
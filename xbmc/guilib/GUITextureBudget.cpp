@@ -0,0 +1,64 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUITextureBudget.h"
+
+#include "ServiceBroker.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "utils/MemUtils.h"
+
+#include <algorithm>
+
+namespace
+{
+const uint64_t MB = 1024 * 1024;
+const uint64_t MIN_DEFAULT_BUDGET = 64 * MB;
+const uint64_t MAX_DEFAULT_BUDGET = 512 * MB;
+}
+
+CGUITextureBudget::CGUITextureBudget()
+{
+  for (auto& usage : m_usage)
+    usage = 0;
+
+  KODI::MEMORY::MemoryStatus stat;
+  KODI::MEMORY::GetMemoryStatus(&stat);
+  m_defaultBudget = std::min(std::max(stat.totalPhys / 8, MIN_DEFAULT_BUDGET), MAX_DEFAULT_BUDGET);
+}
+
+void CGUITextureBudget::Add(POOL pool, uint64_t bytes)
+{
+  m_usage[pool] += static_cast<int64_t>(bytes);
+}
+
+void CGUITextureBudget::Remove(POOL pool, uint64_t bytes)
+{
+  m_usage[pool] -= static_cast<int64_t>(bytes);
+}
+
+uint64_t CGUITextureBudget::GetUsage() const
+{
+  int64_t usage = 0;
+  for (const auto& pool : m_usage)
+    usage += std::max<int64_t>(pool, 0);
+  return usage;
+}
+
+uint64_t CGUITextureBudget::GetUsage(POOL pool) const
+{
+  return std::max<int64_t>(m_usage[pool], 0);
+}
+
+uint64_t CGUITextureBudget::GetBudget() const
+{
+  const int budget = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiTextureMemory;
+  if (budget > 0)
+    return budget * MB;
+  return m_defaultBudget;
+}
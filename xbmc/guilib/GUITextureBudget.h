@@ -0,0 +1,55 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+
+/*!
+ \ingroup textures
+ \brief Memory used by the decoded textures of the GUI, with a single budget shared by all users.
+
+ The texture manager, the large texture manager and the slideshow report the size of the textures
+ they hold. When the total exceeds the budget the texture managers free the textures nobody uses
+ any longer, least recently released first, instead of waiting for their delay to run out.
+
+ The budget comes from <gui><texturememory> in advancedsettings.xml (in MB). If it isn't set it
+ depends on the physical memory of the device, see GetBudget().
+ */
+class CGUITextureBudget
+{
+public:
+  enum POOL
+  {
+    POOL_SKIN = 0,  ///< textures of the skin, loaded by CGUITextureManager
+    POOL_LARGE,     ///< art loaded in the background by CGUILargeTextureManager
+    POOL_SLIDESHOW, ///< pictures of the slideshow
+    POOL_COUNT
+  };
+
+  CGUITextureBudget();
+
+  void Add(POOL pool, uint64_t bytes);
+  void Remove(POOL pool, uint64_t bytes);
+
+  uint64_t GetUsage() const;
+  uint64_t GetUsage(POOL pool) const;
+
+  /*!
+   \brief Get the budget in bytes
+   Without an advanced setting this is 1/8 of the physical memory, at least 64 and at most 512 MB.
+   */
+  uint64_t GetBudget() const;
+
+  bool IsExceeded() const { return GetUsage() > GetBudget(); }
+
+private:
+  std::atomic<int64_t> m_usage[POOL_COUNT]; ///< signed, textures freed after the GUI went away aren't counted
+  uint64_t m_defaultBudget;
+};
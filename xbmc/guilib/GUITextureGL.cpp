@@ -8,21 +8,83 @@
 
 #include "GUITextureGL.h"
 
+#include "GUIFontTTFGL.h"
 #include "ServiceBroker.h"
 #include "Texture.h"
+#include "rendering/MatrixGL.h"
 #include "rendering/gl/RenderSystemGL.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "utils/GLUtils.h"
 #include "utils/Geometry.h"
 #include "utils/log.h"
+#include "windowing/GraphicContext.h"
 #include "windowing/WinSystem.h"
 
+#include <algorithm>
+#include <cstring>
+
 #define BUFFER_OFFSET(i) ((char *)NULL + (i))
 
+namespace
+{
+// quads per draw call, keeps the indices within GLushort
+constexpr size_t BATCH_MAX_QUADS = 1000;
+// runs a texture is moved past at most to join an earlier run of the same state
+constexpr size_t BATCH_LOOKBACK = 32;
+
+// vertices of a run queued in one go, joined runs are made up of several
+struct SBatchSegment
+{
+  size_t first;
+  size_t count;
+  size_t next;
+};
+
+constexpr size_t NO_SEGMENT = static_cast<size_t>(-1);
+
+std::vector<SBatchSegment> batchSegments;
+std::vector<GLushort> batchIndices;
+
+bool SameMatrix(const CMatrixGL& a, const CMatrixGL& b)
+{
+  return memcmp(static_cast<const float*>(a), static_cast<const float*>(b), 16 * sizeof(float)) == 0;
+}
+
+bool Overlaps(const CRect& a, const CRect& b)
+{
+  return a.x1 < b.x2 && b.x1 < a.x2 && a.y1 < b.y2 && b.y1 < a.y2;
+}
+}
+
+// quads of consecutive or non-overlapping textures drawn with the same state
+struct CGUITextureGL::SBatchRun
+{
+  ESHADERMETHOD shader;
+  GLuint texture;
+  GLuint diffuse;
+  GLubyte col[4];
+  bool blend;
+  CRect scissor;
+  CMatrixGL project;
+  CMatrixGL modview;
+  CRect bounds;
+  bool flat; //!< all vertices at z = 0, bounds can only be compared then
+  size_t head;
+  size_t tail;
+  size_t count;
+  size_t first; //!< of the vertices drawn, set up when the batch is drawn
+};
+
+std::vector<CGUITextureGL::SBatchRun> CGUITextureGL::m_batchRuns;
+std::vector<CGUITextureGL::PackedVertex> CGUITextureGL::m_batchVertices;
+
 CGUITextureGL::CGUITextureGL(float posX, float posY, float width, float height, const CTextureInfo &texture)
 : CGUITextureBase(posX, posY, width, height, texture)
 {
   memset(m_col, 0, sizeof(m_col));
   m_renderSystem = dynamic_cast<CRenderSystemGL*>(CServiceBroker::GetRenderSystem());
+  m_batching = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiTextureBatching;
 }
 
 void CGUITextureGL::Begin(UTILS::Color color)
@@ -32,14 +94,21 @@ void CGUITextureGL::Begin(UTILS::Color color)
   if (m_diffuse.size())
     m_diffuse.m_textures[0]->LoadToGPU();
 
-  texture->BindToUnit(0);
-
   // Setup Colors
   m_col[0] = (GLubyte)GET_R(color);
   m_col[1] = (GLubyte)GET_G(color);
   m_col[2] = (GLubyte)GET_B(color);
   m_col[3] = (GLubyte)GET_A(color);
 
+  m_packedVertices.clear();
+  m_idx.clear();
+
+  // the state is set up when the batch is drawn
+  if (m_batching)
+    return;
+
+  texture->BindToUnit(0);
+
   bool hasAlpha = m_texture.m_textures[m_currentFrame]->HasAlpha() || m_col[3] < 255;
 
   if (m_diffuse.size())
@@ -78,12 +147,16 @@ void CGUITextureGL::Begin(UTILS::Color color)
   {
     glDisable(GL_BLEND);
   }
-  m_packedVertices.clear();
-  m_idx.clear();
 }
 
 void CGUITextureGL::End()
 {
+  if (m_batching)
+  {
+    QueueVertices();
+    return;
+  }
+
   if (m_packedVertices.size())
   {
     GLint posLoc  = m_renderSystem->ShaderGetPos();
@@ -333,3 +406,248 @@ void CGUITextureGL::DrawQuad(const CRect &rect, UTILS::Color color, CBaseTexture
   renderSystem->DisableShader();
 }
 
+
+void CGUITextureGL::QueueVertices()
+{
+  if (m_packedVertices.empty())
+    return;
+
+  CBaseTexture* texture = m_texture.m_textures[m_currentFrame];
+  const bool white = m_col[0] == 255 && m_col[1] == 255 && m_col[2] == 255 && m_col[3] == 255;
+
+  SBatchRun run;
+  run.texture = static_cast<CTexture*>(texture)->GetTextureObject();
+  run.blend = texture->HasAlpha() || m_col[3] < 255;
+  if (m_diffuse.size())
+  {
+    run.shader = white ? SM_MULTI : SM_MULTI_BLENDCOLOR;
+    run.diffuse = static_cast<CTexture*>(m_diffuse.m_textures[0])->GetTextureObject();
+    run.blend |= m_diffuse.m_textures[0]->HasAlpha();
+  }
+  else
+  {
+    run.shader = white ? SM_TEXTURE_NOBLEND : SM_TEXTURE;
+    run.diffuse = 0;
+  }
+  memcpy(run.col, m_col, sizeof(run.col));
+  run.scissor = CServiceBroker::GetWinSystem()->GetGfxContext().StereoCorrection(CServiceBroker::GetWinSystem()->GetGfxContext().GetScissors());
+  run.project = glMatrixProject.Get();
+  run.modview = glMatrixModview.Get();
+
+  run.bounds = CRect(m_packedVertices[0].x, m_packedVertices[0].y, m_packedVertices[0].x, m_packedVertices[0].y);
+  run.flat = true;
+  for (const PackedVertex& vertex : m_packedVertices)
+  {
+    run.bounds.x1 = std::min(run.bounds.x1, vertex.x);
+    run.bounds.y1 = std::min(run.bounds.y1, vertex.y);
+    run.bounds.x2 = std::max(run.bounds.x2, vertex.x);
+    run.bounds.y2 = std::max(run.bounds.y2, vertex.y);
+    run.flat &= vertex.z == 0.0f;
+  }
+
+  // the queued text is drawn after the textures, it must not end up below this one
+  if (CGUIFontTTFGL::BatchIntersects(run.bounds, run.flat))
+    CGUIFontTTFGL::FlushBatch();
+
+  const size_t segment = batchSegments.size();
+  batchSegments.push_back({m_batchVertices.size(), m_packedVertices.size(), NO_SEGMENT});
+  m_batchVertices.insert(m_batchVertices.end(), m_packedVertices.begin(), m_packedVertices.end());
+
+  // join the latest run of the same state, as long as nothing queued after it overlaps this one
+  for (size_t i = m_batchRuns.size(), looked = 0; i > 0 && looked < BATCH_LOOKBACK; --i, ++looked)
+  {
+    SBatchRun& other = m_batchRuns[i - 1];
+    if (!SameMatrix(other.project, run.project) || !SameMatrix(other.modview, run.modview))
+      break;
+
+    if (other.shader == run.shader && other.texture == run.texture && other.diffuse == run.diffuse &&
+        memcmp(other.col, run.col, sizeof(run.col)) == 0 && other.blend == run.blend &&
+        other.scissor == run.scissor)
+    {
+      batchSegments[other.tail].next = segment;
+      other.tail = segment;
+      other.count += m_packedVertices.size();
+      other.bounds.x1 = std::min(other.bounds.x1, run.bounds.x1);
+      other.bounds.y1 = std::min(other.bounds.y1, run.bounds.y1);
+      other.bounds.x2 = std::max(other.bounds.x2, run.bounds.x2);
+      other.bounds.y2 = std::max(other.bounds.y2, run.bounds.y2);
+      other.flat &= run.flat;
+      return;
+    }
+
+    if (!run.flat || !other.flat || Overlaps(other.bounds, run.bounds))
+      break;
+  }
+
+  run.head = run.tail = segment;
+  run.count = m_packedVertices.size();
+  m_batchRuns.push_back(run);
+}
+
+void CGUITextureGL::DrawBatch()
+{
+  if (m_batchRuns.empty())
+    return;
+
+  CRenderSystemGL* renderSystem = dynamic_cast<CRenderSystemGL*>(CServiceBroker::GetRenderSystem());
+
+  // the runs in the order they are drawn, every run a single range
+  static std::vector<PackedVertex> vertices;
+  vertices.clear();
+  size_t maxQuads = 0;
+  for (SBatchRun& run : m_batchRuns)
+  {
+    run.first = vertices.size();
+    maxQuads = std::max(maxQuads, std::min(run.count / 4, BATCH_MAX_QUADS));
+    for (size_t segment = run.head; segment != NO_SEGMENT; segment = batchSegments[segment].next)
+      vertices.insert(vertices.end(), m_batchVertices.begin() + batchSegments[segment].first,
+                      m_batchVertices.begin() + batchSegments[segment].first + batchSegments[segment].count);
+  }
+
+  if (batchIndices.empty())
+  {
+    batchIndices.reserve(BATCH_MAX_QUADS * 6);
+    for (size_t i = 0; i < BATCH_MAX_QUADS * 4; i += 4)
+    {
+      batchIndices.push_back(i+0);
+      batchIndices.push_back(i+1);
+      batchIndices.push_back(i+2);
+      batchIndices.push_back(i+2);
+      batchIndices.push_back(i+3);
+      batchIndices.push_back(i+0);
+    }
+  }
+
+  // the caller may already have set up the texture, blending and scissor for its own drawing
+  GLint activeTexture;
+  GLint boundTexture;
+  GLint scissorBox[4];
+  GLint blendSrcRGB, blendDstRGB, blendSrcAlpha, blendDstAlpha;
+  glGetIntegerv(GL_ACTIVE_TEXTURE, &activeTexture);
+  glActiveTexture(GL_TEXTURE0);
+  glGetIntegerv(GL_TEXTURE_BINDING_2D, &boundTexture);
+  glGetIntegerv(GL_SCISSOR_BOX, scissorBox);
+  glGetIntegerv(GL_BLEND_SRC_RGB, &blendSrcRGB);
+  glGetIntegerv(GL_BLEND_DST_RGB, &blendDstRGB);
+  glGetIntegerv(GL_BLEND_SRC_ALPHA, &blendSrcAlpha);
+  glGetIntegerv(GL_BLEND_DST_ALPHA, &blendDstAlpha);
+  const GLboolean blend = glIsEnabled(GL_BLEND);
+
+  GLuint vertexVBO;
+  GLuint indexVBO;
+
+  glGenBuffers(1, &vertexVBO);
+  glBindBuffer(GL_ARRAY_BUFFER, vertexVBO);
+  glBufferData(GL_ARRAY_BUFFER, sizeof(PackedVertex)*vertices.size(), vertices.data(), GL_STREAM_DRAW);
+
+  glGenBuffers(1, &indexVBO);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, indexVBO);
+  glBufferData(GL_ELEMENT_ARRAY_BUFFER, sizeof(GLushort)*maxQuads*6, batchIndices.data(), GL_STREAM_DRAW);
+
+  glBlendFuncSeparate(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA, GL_ONE_MINUS_DST_ALPHA, GL_ONE);
+
+  glMatrixProject.Push();
+  glMatrixModview.Push();
+
+  GLint posLoc = -1;
+  GLint tex0Loc = -1;
+  GLint tex1Loc = -1;
+  GLint uniColLoc = -1;
+  GLuint diffuse = 0;
+  const SBatchRun* previous = nullptr;
+  for (const SBatchRun& run : m_batchRuns)
+  {
+    const bool shaderChanged = !previous || previous->shader != run.shader ||
+                               !SameMatrix(previous->project, run.project) ||
+                               !SameMatrix(previous->modview, run.modview);
+    if (shaderChanged)
+    {
+      if (previous)
+      {
+        glDisableVertexAttribArray(posLoc);
+        glDisableVertexAttribArray(tex0Loc);
+        if (previous->diffuse)
+          glDisableVertexAttribArray(tex1Loc);
+      }
+
+      // enabling the shader uploads the matrices the texture was queued with
+      glMatrixProject.Get() = run.project;
+      glMatrixModview.Get() = run.modview;
+      renderSystem->EnableShader(run.shader);
+
+      posLoc = renderSystem->ShaderGetPos();
+      tex0Loc = renderSystem->ShaderGetCoord0();
+      tex1Loc = renderSystem->ShaderGetCoord1();
+      uniColLoc = renderSystem->ShaderGetUniCol();
+      glEnableVertexAttribArray(posLoc);
+      glEnableVertexAttribArray(tex0Loc);
+      if (run.diffuse)
+        glEnableVertexAttribArray(tex1Loc);
+    }
+    if (uniColLoc >= 0 && (shaderChanged || memcmp(previous->col, run.col, sizeof(run.col)) != 0))
+      glUniform4f(uniColLoc, (run.col[0] / 255.0f), (run.col[1] / 255.0f), (run.col[2] / 255.0f), (run.col[3] / 255.0f));
+    if (run.diffuse && run.diffuse != diffuse)
+    {
+      glActiveTexture(GL_TEXTURE1);
+      glBindTexture(GL_TEXTURE_2D, run.diffuse);
+      glActiveTexture(GL_TEXTURE0);
+      diffuse = run.diffuse;
+    }
+    if (!previous || previous->texture != run.texture)
+      glBindTexture(GL_TEXTURE_2D, run.texture);
+    if (!previous || previous->blend != run.blend)
+    {
+      if (run.blend)
+        glEnable(GL_BLEND);
+      else
+        glDisable(GL_BLEND);
+    }
+    if (!previous || previous->scissor != run.scissor)
+      renderSystem->SetScissors(run.scissor);
+    previous = &run;
+
+    for (size_t quad = run.first / 4; quad < (run.first + run.count) / 4; quad += BATCH_MAX_QUADS)
+    {
+      const size_t count = std::min<size_t>((run.first + run.count) / 4 - quad, BATCH_MAX_QUADS);
+
+      glVertexAttribPointer(posLoc, 3, GL_FLOAT, 0, sizeof(PackedVertex), BUFFER_OFFSET(quad*4*sizeof(PackedVertex) + offsetof(PackedVertex, x)));
+      glVertexAttribPointer(tex0Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex), BUFFER_OFFSET(quad*4*sizeof(PackedVertex) + offsetof(PackedVertex, u1)));
+      if (run.diffuse)
+        glVertexAttribPointer(tex1Loc, 2, GL_FLOAT, 0, sizeof(PackedVertex), BUFFER_OFFSET(quad*4*sizeof(PackedVertex) + offsetof(PackedVertex, u2)));
+
+      glDrawElements(GL_TRIANGLES, 6 * count, GL_UNSIGNED_SHORT, 0);
+    }
+  }
+
+  glDisableVertexAttribArray(posLoc);
+  glDisableVertexAttribArray(tex0Loc);
+  if (previous->diffuse)
+    glDisableVertexAttribArray(tex1Loc);
+  renderSystem->DisableShader();
+
+  glMatrixProject.Pop();
+  glMatrixModview.Pop();
+
+  glBindBuffer(GL_ARRAY_BUFFER, 0);
+  glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, 0);
+  glDeleteBuffers(1, &vertexVBO);
+  glDeleteBuffers(1, &indexVBO);
+
+  glScissor(scissorBox[0], scissorBox[1], scissorBox[2], scissorBox[3]);
+  glBlendFuncSeparate(blendSrcRGB, blendDstRGB, blendSrcAlpha, blendDstAlpha);
+  if (blend)
+    glEnable(GL_BLEND);
+  else
+    glDisable(GL_BLEND);
+  glBindTexture(GL_TEXTURE_2D, boundTexture);
+  glActiveTexture(activeTexture);
+
+  DiscardBatch();
+}
+
+void CGUITextureGL::DiscardBatch()
+{
+  m_batchRuns.clear();
+  m_batchVertices.clear();
+  batchSegments.clear();
+}
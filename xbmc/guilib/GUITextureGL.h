@@ -11,6 +11,8 @@
 #include "GUITexture.h"
 #include "utils/Color.h"
 
+#include <vector>
+
 #include "system_gl.h"
 
 class CRenderSystemGL;
@@ -21,12 +23,26 @@ public:
   CGUITextureGL(float posX, float posY, float width, float height, const CTextureInfo& texture);
   static void DrawQuad(const CRect &coords, UTILS::Color color, CBaseTexture *texture = NULL, const CRect *texCoords = NULL);
 
+  /*! \brief Draw the textures queued since the last call.
+   Textures with the same texture, shader, colour and blend state are drawn with one call. A texture
+   may join an earlier run of the same state if nothing queued in between overlaps it. Called by
+   CGUIFontTTFGL::FlushBatch() ahead of the queued text, which never lies below a queued texture.
+   */
+  static void DrawBatch();
+
+  /*! \brief Drop the queued textures without drawing them */
+  static void DiscardBatch();
+
 protected:
   void Begin(UTILS::Color color) override;
   void Draw(float *x, float *y, float *z, const CRect &texture, const CRect &diffuse, int orientation) override;
   void End() override;
 
 private:
+  struct SBatchRun;
+
+  void QueueVertices();
+
   GLubyte m_col[4];
 
   struct PackedVertex
@@ -39,5 +55,9 @@ private:
   std::vector<PackedVertex> m_packedVertices;
   std::vector<GLushort> m_idx;
   CRenderSystemGL *m_renderSystem;
+  bool m_batching;
+
+  static std::vector<SBatchRun> m_batchRuns;
+  static std::vector<PackedVertex> m_batchVertices;
 };
 
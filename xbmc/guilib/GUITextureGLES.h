@@ -30,6 +30,16 @@ class CGUITextureGLES : public CGUITextureBase
 public:
   CGUITextureGLES(float posX, float posY, float width, float height, const CTextureInfo& texture);
   static void DrawQuad(const CRect &coords, UTILS::Color color, CBaseTexture *texture = NULL, const CRect *texCoords = NULL);
+
+  /*! \brief Draw the textures queued since the last call.
+   Textures with the same texture, shader, colour and blend state are drawn with one call. A texture
+   may join an earlier run of the same state if nothing queued in between overlaps it. Called by
+   CGUIFontTTFGL::FlushBatch() ahead of the queued text, which never lies below a queued texture.
+   */
+  static void DrawBatch();
+
+  /*! \brief Drop the queued textures without drawing them */
+  static void DiscardBatch();
 protected:
   void Begin(UTILS::Color color);
   void Draw(float *x, float *y, float *z, const CRect &texture, const CRect &diffuse, int orientation);
@@ -40,5 +50,14 @@ protected:
   PackedVertices m_packedVertices;
   std::vector<GLushort> m_idx;
   CRenderSystemGLES *m_renderSystem;
+  bool m_batching;
+
+private:
+  struct SBatchRun;
+
+  void QueueVertices();
+
+  static std::vector<SBatchRun> m_batchRuns;
+  static PackedVertices m_batchVertices;
 };
 
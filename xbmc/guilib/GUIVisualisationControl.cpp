@@ -22,15 +22,25 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #include "utils/URIUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
+
 using namespace ADDON;
 
 #define LABEL_ROW1 10
 #define LABEL_ROW2 11
 #define LABEL_ROW3 12
 
+// buffers kept beyond the sync delay of the vis while the gui is slower than the audio
+#define VIS_MAX_QUEUED_BUFFERS 8
+// a vis taking longer than this per frame for the given number of frames in a row gets unloaded
+#define VIS_STALL_FRAME_MS 200
+#define VIS_STALL_MAX_FRAMES 10
+
 CAudioBuffer::CAudioBuffer(int iSize)
 {
   m_iLen = iSize;
@@ -62,6 +72,21 @@ void CAudioBuffer::Set(const float* psBuffer, int iSize)
     m_pBuffer[i] = 0;
 }
 
+const float* CAudioBuffer::GetSpectrum() const
+{
+  return m_spectrum.data();
+}
+
+int CAudioBuffer::SpectrumSize() const
+{
+  return static_cast<int>(m_spectrum.size());
+}
+
+void CAudioBuffer::SetSpectrum(const float* psSpectrum, int iSize)
+{
+  m_spectrum.assign(psSpectrum, psSpectrum + iSize);
+}
+
 CGUIVisualisationControl::CGUIVisualisationControl(int parentID, int controlID, float posX, float posY, float width, float height)
   : CGUIControl(parentID, controlID, posX, posY, width, height),
     m_callStart(false),
@@ -183,6 +208,7 @@ void CGUIVisualisationControl::Process(unsigned int currentTime, CDirtyRegionLis
       m_updateTrack = false;
     }
 
+    PassAudioData();
     MarkDirtyRegion();
   }
 
@@ -207,14 +233,37 @@ void CGUIVisualisationControl::Render()
      */
     CServiceBroker::GetWinSystem()->GetGfxContext().SetViewPort(m_posX, m_posY, m_width, m_height);
     CServiceBroker::GetWinSystem()->GetGfxContext().CaptureStateBlock();
+    const unsigned int start = XbmcThreads::SystemClockMillis();
     m_instance->Render();
+    const unsigned int renderTime = XbmcThreads::SystemClockMillis() - start;
     CServiceBroker::GetWinSystem()->GetGfxContext().ApplyStateBlock();
     CServiceBroker::GetWinSystem()->GetGfxContext().RestoreViewPort();
+
+    CheckStall(m_audioDataTime + renderTime);
   }
 
   CGUIControl::Render();
 }
 
+void CGUIVisualisationControl::CheckStall(unsigned int addonTime)
+{
+  if (addonTime < VIS_STALL_FRAME_MS)
+  {
+    m_stalledFrames = 0;
+    return;
+  }
+
+  if (++m_stalledFrames < VIS_STALL_MAX_FRAMES)
+    return;
+
+  // keep the gui responsive, the vis is loaded again next time the control is shown
+  CLog::Log(LOGERROR, "CGUIVisualisationControl: %s took %u ms per frame for %u frames, unloading it",
+            m_instance->Name().c_str(), addonTime, m_stalledFrames);
+  DeInitVisualization();
+  m_attemptedLoad = true;
+  m_stalledFrames = 0;
+}
+
 void CGUIVisualisationControl::UpdateVisibility(const CGUIListItem *item/* = nullptr*/)
 {
   // if made invisible, start timer, only free addonptr after
@@ -246,40 +295,65 @@ void CGUIVisualisationControl::OnInitialize(int channels, int samplesPerSec, int
   m_callStart = true;
 }
 
-void CGUIVisualisationControl::OnAudioData(const float* audioData, unsigned int audioDataLength)
+unsigned int CGUIVisualisationControl::GetSpectrumBins()
+{
+  // the engine transforms the data if the vis wants it
+  return m_wantsFreq ? AUDIO_BUFFER_SIZE/4 : 0; // quarter due to stereo and complex-conjugate
+}
+
+void CGUIVisualisationControl::OnAudioData(const float* audioData, unsigned int audioDataLength, const float* spectrum, unsigned int spectrumLength)
 {
   if (!m_instance || !m_alreadyStarted)
     return;
 
-  // Save our audio data in the buffers
+  // Save our audio data in the buffers, the add-on gets them on the gui thread
+  // so a slow vis can't hold up the audio engine
   std::unique_ptr<CAudioBuffer> pBuffer(new CAudioBuffer(audioDataLength));
   pBuffer->Set(audioData, audioDataLength);
-  //m_vecBuffers.push_back(pBuffer.release());
+  if (spectrum)
+    pBuffer->SetSpectrum(spectrum, std::min<unsigned int>(spectrumLength, AUDIO_BUFFER_SIZE/2));
+
+  CSingleLock lock(m_buffersSection);
   m_vecBuffers.emplace_back(std::move(pBuffer));
+  while (m_vecBuffers.size() > m_numBuffers + VIS_MAX_QUEUED_BUFFERS)
+    m_vecBuffers.pop_front();
+}
 
-  if (m_vecBuffers.size() < m_numBuffers)
+void CGUIVisualisationControl::PassAudioData()
+{
+  m_audioDataTime = 0;
+  if (!m_instance || !m_alreadyStarted)
     return;
 
-  std::unique_ptr<CAudioBuffer> ptrAudioBuffer = std::move(m_vecBuffers.front());
-  m_vecBuffers.pop_front();
-
-  // Fourier transform the data if the vis wants it...
-  if (m_wantsFreq)
+  std::list<std::unique_ptr<CAudioBuffer>> buffers;
   {
-    const float *psAudioData = ptrAudioBuffer->Get();
+    CSingleLock lock(m_buffersSection);
+    while (!m_vecBuffers.empty() && m_vecBuffers.size() >= m_numBuffers)
+    {
+      buffers.emplace_back(std::move(m_vecBuffers.front()));
+      m_vecBuffers.pop_front();
+    }
+  }
 
-    if (!m_transform)
-      m_transform.reset(new RFFT(AUDIO_BUFFER_SIZE/2, false)); // half due to stereo
+  const unsigned int start = XbmcThreads::SystemClockMillis();
+  for (const auto& ptrAudioBuffer : buffers)
+  {
+    // pass on the spectrum the engine computed if the vis wants it...
+    if (m_wantsFreq && ptrAudioBuffer->SpectrumSize())
+    {
+      const float *psAudioData = ptrAudioBuffer->Get();
 
-    m_transform->calc(psAudioData, m_freq);
+      memcpy(m_freq, ptrAudioBuffer->GetSpectrum(), ptrAudioBuffer->SpectrumSize() * sizeof(float));
 
-    // Transfer data to our visualisation
-    m_instance->AudioData(psAudioData, ptrAudioBuffer->Size(), m_freq, AUDIO_BUFFER_SIZE/2); // half due to complex-conjugate
-  }
-  else
-  { // Transfer data to our visualisation
-    m_instance->AudioData(ptrAudioBuffer->Get(), ptrAudioBuffer->Size(), nullptr, 0);
+      // Transfer data to our visualisation
+      m_instance->AudioData(psAudioData, ptrAudioBuffer->Size(), m_freq, AUDIO_BUFFER_SIZE/2); // half due to complex-conjugate
+    }
+    else
+    { // Transfer data to our visualisation
+      m_instance->AudioData(ptrAudioBuffer->Get(), ptrAudioBuffer->Size(), nullptr, 0);
+    }
   }
+  m_audioDataTime = XbmcThreads::SystemClockMillis() - start;
 }
 
 void CGUIVisualisationControl::UpdateTrack()
@@ -441,6 +515,7 @@ void CGUIVisualisationControl::CreateBuffers()
   if (m_instance)
     m_instance->GetInfo(&info);
 
+  CSingleLock lock(m_buffersSection);
   m_numBuffers = info.iSyncDelay + 1;
   m_wantsFreq = info.bWantsFreq;
   if (m_numBuffers > MAX_AUDIO_BUFFERS)
@@ -453,13 +528,13 @@ void CGUIVisualisationControl::ClearBuffers()
 {
   m_wantsFreq = false;
   m_numBuffers = 0;
-  m_vecBuffers.clear();
+  {
+    CSingleLock lock(m_buffersSection);
+    m_vecBuffers.clear();
+  }
 
   for (float& freq : m_freq)
   {
     freq = 0.0f;
   }
-
-  if (m_transform)
-    m_transform.reset();
 }
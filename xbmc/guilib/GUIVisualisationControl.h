@@ -11,7 +11,7 @@
 #include "GUIControl.h"
 #include "addons/Visualization.h"
 #include "cores/AudioEngine/Interfaces/IAudioCallback.h"
-#include "utils/rfft.h"
+#include "threads/CriticalSection.h"
 
 #include <list>
 #include <string>
@@ -28,12 +28,16 @@ public:
   const float* Get() const;
   int Size() const;
   void Set(const float* psBuffer, int iSize);
+  const float* GetSpectrum() const;
+  int SpectrumSize() const;
+  void SetSpectrum(const float* psSpectrum, int iSize);
 private:
   CAudioBuffer(const CAudioBuffer&) = delete;
   CAudioBuffer& operator=(const CAudioBuffer&) = delete;
   CAudioBuffer();
   float* m_pBuffer;
   int m_iLen;
+  std::vector<float> m_spectrum;
 };
 
 class CGUIVisualisationControl : public CGUIControl, public IAudioCallback
@@ -45,7 +49,8 @@ public:
 
   // Child functions related to IAudioCallback
   void OnInitialize(int channels, int samplesPerSec, int bitsPerSample) override;
-  void OnAudioData(const float* audioData, unsigned int audioDataLength) override;
+  void OnAudioData(const float* audioData, unsigned int audioDataLength, const float* spectrum, unsigned int spectrumLength) override;
+  unsigned int GetSpectrumBins() override;
 
   // Child functions related to CGUIControl
   void FreeResources(bool immediately = false) override;
@@ -72,18 +77,20 @@ private:
   void DeInitVisualization();
   inline void CreateBuffers();
   inline void ClearBuffers();
+  void PassAudioData();
+  void CheckStall(unsigned int addonTime);
 
   bool m_callStart;
   bool m_alreadyStarted;
   bool m_attemptedLoad;
   bool m_updateTrack;
 
+  CCriticalSection m_buffersSection; /*!< the audio engine queues the buffers, the gui passes them on */
   std::list<std::unique_ptr<CAudioBuffer>> m_vecBuffers;
   unsigned int m_numBuffers; /*!< Number of Audio buffers */
   bool m_wantsFreq;
   float m_freq[AUDIO_BUFFER_SIZE]; /*!< Frequency data */
   std::vector<std::string> m_presets; /*!< cached preset list */
-  std::unique_ptr<RFFT> m_transform;
 
   /* values set from "OnInitialize" IAudioCallback  */
   int m_channels;
@@ -95,5 +102,8 @@ private:
   std::string m_presetsPath; /*!< To add-on sended preset path */
   std::string m_profilePath; /*!< To add-on sended profile path */
 
+  unsigned int m_audioDataTime = 0; /*!< Time spent in the add-on passing the audio data this frame */
+  unsigned int m_stalledFrames = 0; /*!< Consecutive frames the add-on took too long for */
+
   ADDON::CVisualization* m_instance;
 };
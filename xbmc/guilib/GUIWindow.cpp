@@ -16,6 +16,7 @@
 #include "GUIControlProfiler.h"
 #include "GUIInfoManager.h"
 #include "GUIWindowManager.h"
+#include "GUIXMLCache.h"
 #include "ServiceBroker.h"
 #include "addons/Skin.h"
 #include "input/Key.h"
@@ -126,8 +127,17 @@ bool CGUIWindow::Load(const std::string& strFileName, bool bContainsPath)
 bool CGUIWindow::LoadXML(const std::string &strPath, const std::string &strLowerPath)
 {
   // load window xml if we don't have it stored yet
+  bool parsed = false;
   if (!m_windowXMLRootElement)
   {
+    // includes resolved by an earlier run are fine as long as nothing they depend on changed
+    std::unique_ptr<TiXmlElement> cachedRoot = CGUIXMLCache::Load(strPath, m_xmlIncludeConditions);
+    if (cachedRoot)
+    {
+      CLog::Log(LOGDEBUG, "Using cached xml of %s", strPath.c_str());
+      return Load(cachedRoot.get());
+    }
+
     CXBMCTinyXML xmlDoc;
     std::string strPathLower = strPath;
     StringUtils::ToLower(strPathLower);
@@ -147,11 +157,16 @@ bool CGUIWindow::LoadXML(const std::string &strPath, const std::string &strLower
 
     // store XML for further processing if window's load type is LOAD_EVERY_TIME or a reload is needed
     m_windowXMLRootElement = static_cast<TiXmlElement*>(xmlDoc.RootElement()->Clone());
+    parsed = true;
   }
   else
     CLog::Log(LOGDEBUG, "Using already stored xml root node for %s", strPath.c_str());
 
-  return Load(Prepare(m_windowXMLRootElement).get());
+  std::unique_ptr<TiXmlElement> preparedRoot = Prepare(m_windowXMLRootElement);
+  if (preparedRoot && parsed)
+    CGUIXMLCache::Store(strPath, *preparedRoot, m_xmlIncludeConditions);
+
+  return Load(preparedRoot.get());
 }
 
 std::unique_ptr<TiXmlElement> CGUIWindow::Prepare(TiXmlElement *pRootElement)
@@ -0,0 +1,312 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "GUIXMLCache.h"
+
+#include "GUIInfoManager.h"
+#include "ServiceBroker.h"
+#include "addons/Skin.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
+#include "guilib/GUIComponent.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "utils/Digest.h"
+#include "utils/StringUtils.h"
+#include "utils/XBMCTinyXML.h"
+#include "utils/log.h"
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <string.h>
+
+using namespace XFILE;
+using KODI::UTILITY::CDigest;
+
+namespace
+{
+const char CACHE_PATH[] = "special://temp/skincache/";
+const char CACHE_MAGIC[4] = { 'K', 'S', 'X', 'C' };
+const uint32_t CACHE_VERSION = 1;
+
+// limits the recursion on broken files
+const unsigned int MAX_DEPTH = 256;
+
+enum NODE_TYPE : uint8_t
+{
+  NODE_ELEMENT = 0,
+  NODE_TEXT = 1,
+  NODE_CDATA = 2
+};
+
+class CWriter
+{
+public:
+  void PutByte(uint8_t value) { m_data.push_back(static_cast<char>(value)); }
+  void PutUInt(uint32_t value) { m_data.append(reinterpret_cast<const char*>(&value), sizeof(value)); }
+  void PutString(const std::string& value)
+  {
+    PutUInt(static_cast<uint32_t>(value.size()));
+    m_data.append(value);
+  }
+
+  void PutElement(const TiXmlElement& element)
+  {
+    PutString(element.ValueStr());
+
+    uint32_t attributes = 0;
+    for (const TiXmlAttribute* attribute = element.FirstAttribute(); attribute; attribute = attribute->Next())
+      attributes++;
+    PutUInt(attributes);
+    for (const TiXmlAttribute* attribute = element.FirstAttribute(); attribute; attribute = attribute->Next())
+    {
+      PutString(attribute->NameTStr());
+      PutString(attribute->ValueStr());
+    }
+
+    // only elements and text matter to the controls, comments and the like are dropped
+    uint32_t children = 0;
+    for (const TiXmlNode* child = element.FirstChild(); child; child = child->NextSibling())
+    {
+      if (child->Type() == TiXmlNode::TINYXML_ELEMENT || child->Type() == TiXmlNode::TINYXML_TEXT)
+        children++;
+    }
+    PutUInt(children);
+    for (const TiXmlNode* child = element.FirstChild(); child; child = child->NextSibling())
+    {
+      if (child->Type() == TiXmlNode::TINYXML_ELEMENT)
+      {
+        PutByte(NODE_ELEMENT);
+        PutElement(*child->ToElement());
+      }
+      else if (child->Type() == TiXmlNode::TINYXML_TEXT)
+      {
+        PutByte(child->ToText()->CDATA() ? NODE_CDATA : NODE_TEXT);
+        PutString(child->ValueStr());
+      }
+    }
+  }
+
+  const std::string& GetData() const { return m_data; }
+
+private:
+  std::string m_data;
+};
+
+class CReader
+{
+public:
+  CReader(const char* data, size_t size) : m_pos(data), m_end(data + size) {}
+
+  bool GetByte(uint8_t& value)
+  {
+    if (m_pos == m_end)
+      return false;
+    value = static_cast<uint8_t>(*m_pos++);
+    return true;
+  }
+
+  bool GetUInt(uint32_t& value)
+  {
+    if (static_cast<size_t>(m_end - m_pos) < sizeof(value))
+      return false;
+    memcpy(&value, m_pos, sizeof(value));
+    m_pos += sizeof(value);
+    return true;
+  }
+
+  bool GetString(std::string& value)
+  {
+    uint32_t length;
+    if (!GetUInt(length) || static_cast<size_t>(m_end - m_pos) < length)
+      return false;
+    value.assign(m_pos, length);
+    m_pos += length;
+    return true;
+  }
+
+  bool GetElement(TiXmlElement& element, unsigned int depth)
+  {
+    if (depth > MAX_DEPTH)
+      return false;
+
+    std::string name, value;
+    uint32_t attributes;
+    if (!GetString(name) || !GetUInt(attributes))
+      return false;
+    element.SetValue(name);
+    for (uint32_t i = 0; i < attributes; i++)
+    {
+      if (!GetString(name) || !GetString(value))
+        return false;
+      element.SetAttribute(name, value);
+    }
+
+    uint32_t children;
+    if (!GetUInt(children))
+      return false;
+    for (uint32_t i = 0; i < children; i++)
+    {
+      uint8_t type;
+      if (!GetByte(type))
+        return false;
+      if (type == NODE_ELEMENT)
+      {
+        TiXmlElement* child = new TiXmlElement("");
+        element.LinkEndChild(child);
+        if (!GetElement(*child, depth + 1))
+          return false;
+      }
+      else if (type == NODE_TEXT || type == NODE_CDATA)
+      {
+        if (!GetString(value))
+          return false;
+        TiXmlText* text = new TiXmlText(value);
+        text->SetCDATA(type == NODE_CDATA);
+        element.LinkEndChild(text);
+      }
+      else
+        return false;
+    }
+    return true;
+  }
+
+  bool AtEnd() const { return m_pos == m_end; }
+
+private:
+  const char* m_pos;
+  const char* m_end;
+};
+}
+
+std::unique_ptr<TiXmlElement> CGUIXMLCache::Load(const std::string& path, std::map<INFO::InfoPtr, bool>& includeConditions)
+{
+  if (!IsEnabled())
+    return nullptr;
+
+  const std::string signature = GetSignature(path);
+  if (signature.empty())
+    return nullptr;
+
+  auto_buffer buffer;
+  const std::string cacheFile = GetCacheFile(path);
+  if (!CFile::Exists(cacheFile) || CFile().LoadFile(cacheFile, buffer) <= 0)
+    return nullptr;
+
+  CReader reader(buffer.get(), buffer.size());
+  char magic[sizeof(CACHE_MAGIC)];
+  uint32_t version;
+  std::string fileSignature;
+  for (char& c : magic)
+  {
+    uint8_t byte;
+    if (!reader.GetByte(byte))
+      return nullptr;
+    c = static_cast<char>(byte);
+  }
+  if (memcmp(magic, CACHE_MAGIC, sizeof(CACHE_MAGIC)) != 0 || !reader.GetUInt(version) ||
+      version != CACHE_VERSION || !reader.GetString(fileSignature) || fileSignature != signature)
+    return nullptr;
+
+  // the includes were picked by these conditions, they must still have the same values
+  CGUIInfoManager& infoMgr = CServiceBroker::GetGUI()->GetInfoManager();
+  std::map<INFO::InfoPtr, bool> conditions;
+  uint32_t count;
+  if (!reader.GetUInt(count))
+    return nullptr;
+  for (uint32_t i = 0; i < count; i++)
+  {
+    std::string expression;
+    uint8_t value;
+    if (!reader.GetString(expression) || !reader.GetByte(value))
+      return nullptr;
+    INFO::InfoPtr condition = infoMgr.Register(expression);
+    if (!condition || condition->Get() != (value != 0))
+    {
+      CLog::Log(LOGDEBUG, "CGUIXMLCache::Load - include condition %s changed for %s", expression.c_str(), path.c_str());
+      return nullptr;
+    }
+    conditions.insert(std::make_pair(condition, value != 0));
+  }
+
+  std::unique_ptr<TiXmlElement> root(new TiXmlElement(""));
+  if (!reader.GetElement(*root, 0) || !reader.AtEnd())
+  {
+    CLog::Log(LOGWARNING, "CGUIXMLCache::Load - invalid cache file %s for %s", cacheFile.c_str(), path.c_str());
+    return nullptr;
+  }
+
+  includeConditions = std::move(conditions);
+  return root;
+}
+
+void CGUIXMLCache::Store(const std::string& path, const TiXmlElement& root, const std::map<INFO::InfoPtr, bool>& includeConditions)
+{
+  if (!IsEnabled())
+    return;
+
+  const std::string signature = GetSignature(path);
+  if (signature.empty())
+    return;
+
+  CWriter writer;
+  for (char c : CACHE_MAGIC)
+    writer.PutByte(static_cast<uint8_t>(c));
+  writer.PutUInt(CACHE_VERSION);
+  writer.PutString(signature);
+  writer.PutUInt(static_cast<uint32_t>(includeConditions.size()));
+  for (const auto& condition : includeConditions)
+  {
+    writer.PutString(condition.first->GetExpression());
+    writer.PutByte(condition.second ? 1 : 0);
+  }
+  writer.PutElement(root);
+
+  if (!CDirectory::Exists(CACHE_PATH) && !CDirectory::Create(CACHE_PATH))
+    return;
+
+  const std::string cacheFile = GetCacheFile(path);
+  const std::string& data = writer.GetData();
+  CFile file;
+  if (!file.OpenForWrite(cacheFile, true) ||
+      file.Write(data.c_str(), data.size()) != static_cast<ssize_t>(data.size()))
+  {
+    CLog::Log(LOGWARNING, "CGUIXMLCache::Store - unable to write %s", cacheFile.c_str());
+    file.Close();
+    CFile::Delete(cacheFile);
+  }
+}
+
+std::string CGUIXMLCache::GetFileSignature(const std::string& path)
+{
+  struct __stat64 buffer;
+  if (CFile::Stat(path, &buffer) != 0)
+    return "";
+  return StringUtils::Format("%" PRId64 ":%" PRId64, static_cast<int64_t>(buffer.st_size),
+                             static_cast<int64_t>(buffer.st_mtime));
+}
+
+bool CGUIXMLCache::IsEnabled()
+{
+  return g_SkinInfo && CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_guiSkinCache;
+}
+
+std::string CGUIXMLCache::GetCacheFile(const std::string& path)
+{
+  // one entry per window of a skin, a changed file replaces the old entry
+  return CACHE_PATH + CDigest::Calculate(CDigest::Type::MD5, g_SkinInfo->ID() + "|" + path) + ".bin";
+}
+
+std::string CGUIXMLCache::GetSignature(const std::string& path)
+{
+  const std::string window = GetFileSignature(path);
+  if (window.empty())
+    return "";
+  return g_SkinInfo->ID() + "|" + g_SkinInfo->Version().asString() + "|" + window + "|" +
+         g_SkinInfo->GetIncludesSignature();
+}
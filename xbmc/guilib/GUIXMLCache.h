@@ -0,0 +1,56 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "interfaces/info/InfoBool.h"
+
+#include <map>
+#include <memory>
+#include <string>
+
+class TiXmlElement;
+
+/*!
+ \brief Cache of the window xml of the skin after all includes got resolved.
+
+ The resolved trees are kept in a compact binary format in special://temp/skincache/, one file per
+ window. Entries are only used if the skin, its version and the size and modification time of the
+ window file and all include files still match, and if the conditions of the <include> elements
+ that were used to resolve the tree still have the same values.
+ */
+class CGUIXMLCache
+{
+public:
+  /*!
+   \brief Get the resolved xml of a window file
+   \param path the window file
+   \param includeConditions filled with the conditions the includes were resolved with
+   \return the resolved root element, nullptr if there's no valid entry
+   */
+  static std::unique_ptr<TiXmlElement> Load(const std::string& path, std::map<INFO::InfoPtr, bool>& includeConditions);
+
+  /*!
+   \brief Store the resolved xml of a window file
+   \param path the window file
+   \param root the root element after includes got resolved
+   \param includeConditions the conditions the includes were resolved with
+   */
+  static void Store(const std::string& path, const TiXmlElement& root, const std::map<INFO::InfoPtr, bool>& includeConditions);
+
+  /*!
+   \brief Get the size and modification time of a file as a string
+   \return the signature, empty if the file doesn't exist
+   */
+  static std::string GetFileSignature(const std::string& path);
+
+private:
+  static bool IsEnabled();
+  static std::string GetCacheFile(const std::string& path);
+  static std::string GetSignature(const std::string& path);
+};
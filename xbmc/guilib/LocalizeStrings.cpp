@@ -10,14 +10,173 @@
 
 #include "addons/LanguageResource.h"
 #include "filesystem/Directory.h"
+#include "filesystem/File.h"
 #include "filesystem/SpecialProtocol.h"
 #include "threads/SharedSection.h"
 #include "utils/CharsetConverter.h"
+#include "utils/Crc32.h"
 #include "utils/POUtils.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
+#include "utils/auto_buffer.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
+
+#define COMPILED_STRINGS_MAGIC "KPOC"
+#define COMPILED_STRINGS_VERSION 1
+#define COMPILED_STRINGS_FILE "special://temp/strings-%08x.bin"
+
+namespace
+{
+
+struct POEntry
+{
+  uint32_t id;
+  std::string msgid;
+  std::string msgstr;
+};
+
+/*! \brief Layout of a compiled strings file: the header, the entries sorted
+ by id and the NUL terminated strings the entries point into.
+ */
+struct CompiledHeader
+{
+  char magic[4];
+  uint32_t version;
+  int64_t size;
+  int64_t mtime;
+  uint32_t count;
+};
+
+struct CompiledEntry
+{
+  uint32_t id;
+  uint32_t msgid;
+  uint32_t msgstr;
+};
+
+std::string GetCompiledFile(const std::string &filename, bool bSourceLanguage)
+{
+  // the source language only needs the msgids, keep its table separate
+  return StringUtils::Format(COMPILED_STRINGS_FILE,
+                             Crc32::Compute(bSourceLanguage ? filename + "|source" : filename));
+}
+
+bool ReadCompiled(const std::string &compiled, const CompiledHeader &expected, std::vector<POEntry> &entries)
+{
+  if (!XFILE::CFile::Exists(compiled))
+    return false;
+
+  XUTILS::auto_buffer buffer;
+  XFILE::CFile file;
+  if (file.LoadFile(compiled, buffer) < static_cast<ssize_t>(sizeof(CompiledHeader)))
+    return false;
+
+  CompiledHeader header;
+  memcpy(&header, buffer.get(), sizeof(header));
+  if (memcmp(header.magic, expected.magic, sizeof(header.magic)) != 0 ||
+      header.version != expected.version || header.size != expected.size ||
+      header.mtime != expected.mtime)
+    return false;
+
+  const size_t stringsStart = sizeof(CompiledHeader) + header.count * sizeof(CompiledEntry);
+  if (buffer.size() < stringsStart ||
+      (header.count > 0 && buffer.get()[buffer.size() - 1] != '\0'))
+    return false;
+
+  const char *strings = buffer.get() + stringsStart;
+  const size_t stringsSize = buffer.size() - stringsStart;
+  entries.clear();
+  entries.reserve(header.count);
+  for (uint32_t i = 0; i < header.count; i++)
+  {
+    CompiledEntry entry;
+    memcpy(&entry, buffer.get() + sizeof(CompiledHeader) + i * sizeof(CompiledEntry), sizeof(entry));
+    if (entry.msgid >= stringsSize || entry.msgstr >= stringsSize)
+      return false;
+    entries.push_back({entry.id, strings + entry.msgid, strings + entry.msgstr});
+  }
+
+  return true;
+}
+
+void WriteCompiled(const std::string &compiled, const CompiledHeader &header, const std::vector<POEntry> &entries)
+{
+  std::string table(reinterpret_cast<const char*>(&header), sizeof(header));
+  std::string strings;
+  for (const auto& entry : entries)
+  {
+    CompiledEntry compiledEntry;
+    compiledEntry.id = entry.id;
+    compiledEntry.msgid = static_cast<uint32_t>(strings.size());
+    strings.append(entry.msgid.c_str(), entry.msgid.size() + 1);
+    compiledEntry.msgstr = static_cast<uint32_t>(strings.size());
+    strings.append(entry.msgstr.c_str(), entry.msgstr.size() + 1);
+    table.append(reinterpret_cast<const char*>(&compiledEntry), sizeof(compiledEntry));
+  }
+  table.append(strings);
+
+  XFILE::CFile file;
+  if (!file.OpenForWrite(compiled, true) ||
+      file.Write(table.c_str(), table.size()) != static_cast<ssize_t>(table.size()))
+  {
+    CLog::Log(LOGDEBUG, "LocalizeStrings: unable to write %s", compiled.c_str());
+    file.Close();
+    XFILE::CFile::Delete(compiled);
+  }
+}
+
+/*! \brief Reads the id based entries of a strings.po file. The entries are
+ * taken from its compiled table in the temp folder while the file is unchanged,
+ * otherwise the file is parsed and the table written for the next load.
+ */
+bool ReadPO(const std::string &filename, bool bSourceLanguage, std::vector<POEntry> &entries)
+{
+  struct __stat64 st;
+  if (XFILE::CFile::Stat(filename, &st) != 0)
+    return false;
+
+  CompiledHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, COMPILED_STRINGS_MAGIC, sizeof(header.magic));
+  header.version = COMPILED_STRINGS_VERSION;
+  header.size = st.st_size;
+  header.mtime = st.st_mtime;
+
+  const std::string compiled = GetCompiledFile(filename, bSourceLanguage);
+  if (ReadCompiled(compiled, header, entries))
+    return true;
+
+  CPODocument PODoc;
+  if (!PODoc.LoadFile(filename))
+    return false;
+
+  entries.clear();
+  while ((PODoc.GetNextEntry()))
+  {
+    //! @todo implement reading of non-id based (and pluralized) string entries from the PO files.
+    //! These entries would go into a separate memory map, using hash codes for fast look-up.
+    //! With this memory map we can implement using gettext(), ngettext(), pgettext() calls,
+    //! so that we don't have to use new IDs for new strings. Even we can start converting
+    //! the ID based calls to normal gettext calls.
+    if (PODoc.GetEntryType() != ID_FOUND)
+      continue;
+
+    PODoc.ParseEntry(bSourceLanguage);
+    entries.push_back({PODoc.GetEntryID(), PODoc.GetMsgid(),
+                       bSourceLanguage ? std::string() : PODoc.GetMsgstr()});
+  }
+
+  header.count = static_cast<uint32_t>(entries.size());
+  WriteCompiled(compiled, header, entries);
+  return true;
+}
+
+} // namespace
+
 
 /*! \brief Tries to load ids and strings from a strings.po file to the `strings` map.
  * It should only be called from the LoadStr2Mem function to have a fallback.
@@ -31,51 +190,34 @@
 static bool LoadPO(const std::string &filename, std::map<uint32_t, LocStr>& strings,
     std::string &encoding, uint32_t offset = 0 , bool bSourceLanguage = false)
 {
-  CPODocument PODoc;
-  if (!PODoc.LoadFile(filename))
+  std::vector<POEntry> entries;
+  if (!ReadPO(filename, bSourceLanguage, entries))
     return false;
 
   int counter = 0;
 
-  while ((PODoc.GetNextEntry()))
+  for (const auto& entry : entries)
   {
-    uint32_t id;
-    if (PODoc.GetEntryType() == ID_FOUND)
-    {
-      bool bStrInMem = strings.find((id = PODoc.GetEntryID()) + offset) != strings.end();
-      PODoc.ParseEntry(bSourceLanguage);
+    const uint32_t id = entry.id;
+    bool bStrInMem = strings.find(id + offset) != strings.end();
 
-      if (bSourceLanguage && !PODoc.GetMsgid().empty())
-      {
-        if (bStrInMem && (strings[id + offset].strOriginal.empty() ||
-                          PODoc.GetMsgid() == strings[id + offset].strOriginal))
-          continue;
-        else if (bStrInMem)
-          CLog::Log(LOGDEBUG,
-              "POParser: id:%i was recently re-used in the English string file, which is not yet "
-                  "changed in the translated file. Using the English string instead", id);
-        strings[id + offset].strTranslated = PODoc.GetMsgid();
-        counter++;
-      }
-      else if (!bSourceLanguage && !bStrInMem && !PODoc.GetMsgstr().empty())
-      {
-        strings[id + offset].strTranslated = PODoc.GetMsgstr();
-        strings[id + offset].strOriginal = PODoc.GetMsgid();
-        counter++;
-      }
-    }
-    else if (PODoc.GetEntryType() == MSGID_FOUND)
+    if (bSourceLanguage && !entry.msgid.empty())
     {
-      //! @todo implement reading of non-id based string entries from the PO files.
-      //! These entries would go into a separate memory map, using hash codes for fast look-up.
-      //! With this memory map we can implement using gettext(), ngettext(), pgettext() calls,
-      //! so that we don't have to use new IDs for new strings. Even we can start converting
-      //! the ID based calls to normal gettext calls.
+      if (bStrInMem && (strings[id + offset].strOriginal.empty() ||
+                        entry.msgid == strings[id + offset].strOriginal))
+        continue;
+      else if (bStrInMem)
+        CLog::Log(LOGDEBUG,
+            "POParser: id:%i was recently re-used in the English string file, which is not yet "
+                "changed in the translated file. Using the English string instead", id);
+      strings[id + offset].strTranslated = entry.msgid;
+      counter++;
     }
-    else if (PODoc.GetEntryType() == MSGID_PLURAL_FOUND)
+    else if (!bSourceLanguage && !bStrInMem && !entry.msgstr.empty())
     {
-      //! @todo implement reading of non-id based pluralized string entries from the PO files.
-      //! We can store the pluralforms for each language, in the langinfo.xml files.
+      strings[id + offset].strTranslated = entry.msgstr;
+      strings[id + offset].strOriginal = entry.msgid;
+      counter++;
     }
   }
 
@@ -198,6 +340,36 @@ const std::string& CLocalizeStrings::Get(uint32_t dwCode) const
   return i->second.strTranslated;
 }
 
+std::vector<uint32_t> CLocalizeStrings::GetCharacters(size_t maxCharacters) const
+{
+  std::map<uint32_t, unsigned int> usage;
+  {
+    CSharedLock lock(m_stringsMutex);
+    std::u32string text;
+    for (const auto& it : m_strings)
+    {
+      if (!g_charsetConverter.utf8ToUtf32(it.second.strTranslated, text, false))
+        continue;
+      for (char32_t c : text)
+      {
+        if (c >= 0x20 && c < 0x10000)
+          usage[c]++;
+      }
+    }
+  }
+
+  std::vector<std::pair<unsigned int, uint32_t>> sorted;
+  sorted.reserve(usage.size());
+  for (const auto& it : usage)
+    sorted.emplace_back(it.second, it.first);
+  std::sort(sorted.begin(), sorted.end(), std::greater<std::pair<unsigned int, uint32_t>>());
+
+  std::vector<uint32_t> characters;
+  for (size_t i = 0; i < sorted.size() && i < maxCharacters; i++)
+    characters.push_back(sorted[i].second);
+  return characters;
+}
+
 void CLocalizeStrings::Clear()
 {
   CExclusiveLock lock(m_stringsMutex);
@@ -217,30 +389,66 @@ void CLocalizeStrings::Clear(uint32_t start, uint32_t end)
   }
 }
 
-bool CLocalizeStrings::LoadAddonStrings(const std::string& path, const std::string& language, const std::string& addonId)
+void CLocalizeStrings::AddonStrings::Load()
 {
   std::map<uint32_t, LocStr> strings;
-  if (!LoadWithFallback(path, language, strings))
-    return false;
+  LoadWithFallback(path, language, strings);
 
-  CExclusiveLock lock(m_addonStringsMutex);
-  auto it = m_addonStrings.find(addonId);
-  if (it != m_addonStrings.end())
-    m_addonStrings.erase(it);
+  index.reserve(strings.size());
+  for (const auto& it : strings)
+  {
+    index.emplace_back(it.first, static_cast<uint32_t>(data.size()));
+    data.append(it.second.strTranslated.c_str(), it.second.strTranslated.size() + 1);
+  }
+  loaded = true;
+}
+
+std::string CLocalizeStrings::AddonStrings::Get(uint32_t code) const
+{
+  auto it = std::lower_bound(index.begin(), index.end(), std::make_pair(code, 0u));
+  if (it == index.end() || it->first != code)
+    return StringUtils::Empty;
+
+  return data.c_str() + it->second;
+}
 
-  return m_addonStrings.emplace(std::string(addonId), std::move(strings)).second;
+bool CLocalizeStrings::LoadAddonStrings(const std::string& path, const std::string& language, const std::string& addonId)
+{
+  CExclusiveLock lock(m_addonStringsMutex);
+  AddonStrings& strings = m_addonStrings[addonId];
+  strings = AddonStrings();
+  strings.path = path;
+  strings.language = language;
+  return true;
 }
 
 std::string CLocalizeStrings::GetAddonString(const std::string& addonId, uint32_t code)
 {
-  CSharedLock lock(m_addonStringsMutex);
+  AddonStrings strings;
+  {
+    CSharedLock lock(m_addonStringsMutex);
+    auto i = m_addonStrings.find(addonId);
+    if (i == m_addonStrings.end())
+      return StringUtils::Empty;
+
+    if (i->second.loaded)
+      return i->second.Get(code);
+
+    strings.path = i->second.path;
+    strings.language = i->second.language;
+  }
+
+  // first use of the addon's strings, don't block the lookups of other addons while loading
+  strings.Load();
+
+  CExclusiveLock lock(m_addonStringsMutex);
   auto i = m_addonStrings.find(addonId);
   if (i == m_addonStrings.end())
     return StringUtils::Empty;
 
-  auto j = i->second.find(code);
-  if (j == i->second.end())
-    return StringUtils::Empty;
+  // a reload while loading would have reset the entry
+  if (!i->second.loaded && i->second.path == strings.path && i->second.language == strings.language)
+    i->second = std::move(strings);
 
-  return j->second.strTranslated;
+  return i->second.loaded ? i->second.Get(code) : StringUtils::Empty;
 }
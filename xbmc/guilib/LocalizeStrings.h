@@ -19,6 +19,8 @@
 #include <map>
 #include <stdint.h>
 #include <string>
+#include <utility>
+#include <vector>
 
 /*!
  \ingroup strings
@@ -42,9 +44,21 @@ public:
   ~CLocalizeStrings(void) override;
   bool Load(const std::string& strPathName, const std::string& strLanguage);
   bool LoadSkinStrings(const std::string& path, const std::string& language);
+  /*! \brief Register the strings of an addon, they are loaded on first use
+   \param path the language folder of the addon
+   \param language the language to load, English is the fallback
+   \param addonId the addon the strings belong to
+   \return true
+   */
   bool LoadAddonStrings(const std::string& path, const std::string& language, const std::string& addonId);
   void ClearSkinStrings();
   const std::string& Get(uint32_t code) const;
+
+  /*! \brief Get the characters of the loaded strings, most frequent first
+   \param maxCharacters the number of characters to return at most
+   \return unicode code points of the basic multilingual plane
+   */
+  std::vector<uint32_t> GetCharacters(size_t maxCharacters) const;
   std::string GetAddonString(const std::string& addonId, uint32_t code);
   void Clear();
 
@@ -54,8 +68,21 @@ public:
 protected:
   void Clear(uint32_t start, uint32_t end);
 
+  /*! \brief Translated strings of an addon, packed into one buffer */
+  struct AddonStrings
+  {
+    void Load();
+    std::string Get(uint32_t code) const;
+
+    std::string path;
+    std::string language;
+    bool loaded = false;
+    std::vector<std::pair<uint32_t, uint32_t>> index; // sorted ids and their offsets into data
+    std::string data; // NUL terminated strings
+  };
+
   std::map<uint32_t, LocStr> m_strings;
-  std::map<std::string, std::map<uint32_t, LocStr>> m_addonStrings;
+  std::map<std::string, AddonStrings> m_addonStrings;
   typedef std::map<uint32_t, LocStr>::const_iterator ciStrings;
   typedef std::map<uint32_t, LocStr>::iterator       iStrings;
 
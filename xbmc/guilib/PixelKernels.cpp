@@ -0,0 +1,153 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "PixelKernels.h"
+
+#if defined(HAS_NEON) && !defined(__LP64__)
+#include "utils/CPUInfo.h"
+#endif
+
+#include <stdint.h>
+#include <string.h>
+
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(HAS_NEON)
+#include <arm_neon.h>
+#endif
+
+namespace
+{
+inline uint32_t SwapPixel(uint32_t pixel)
+{
+  return (pixel & 0xff00ff00) | ((pixel >> 16) & 0xff) | ((pixel & 0xff) << 16);
+}
+
+inline uint32_t AveragePixels(uint32_t a, uint32_t b, uint32_t c, uint32_t d)
+{
+  // per channel, rounded like the vector paths: avg(avg(a, b), avg(c, d))
+  uint32_t out = 0;
+  for (int shift = 0; shift < 32; shift += 8)
+  {
+    const uint32_t ab = (((a >> shift) & 0xff) + ((b >> shift) & 0xff) + 1) >> 1;
+    const uint32_t cd = (((c >> shift) & 0xff) + ((d >> shift) & 0xff) + 1) >> 1;
+    out |= ((ab + cd + 1) >> 1) << shift;
+  }
+  return out;
+}
+}
+
+bool CPixelKernels::HasNeon()
+{
+#if defined(HAS_NEON) && defined(__LP64__)
+  return true;
+#elif defined(HAS_NEON)
+  return (g_cpuInfo.GetCPUFeatures() & CPU_FEATURE_NEON) == CPU_FEATURE_NEON;
+#else
+  return false;
+#endif
+}
+
+void CPixelKernels::SwapBlueRed(unsigned char* pixels, unsigned int width, unsigned int height, unsigned int pitch)
+{
+  const bool neon = HasNeon();
+  for (unsigned int y = 0; y < height; y++)
+  {
+    unsigned char* row = pixels + y * pitch;
+    unsigned int x = 0;
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+    const __m128i keep = _mm_set1_epi32(0xff00ff00);
+    const __m128i low = _mm_set1_epi32(0x000000ff);
+    for (; x + 4 <= width; x += 4)
+    {
+      __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row + x * 4));
+      __m128i out = _mm_or_si128(_mm_and_si128(p, keep),
+                                 _mm_or_si128(_mm_and_si128(_mm_srli_epi32(p, 16), low),
+                                              _mm_slli_epi32(_mm_and_si128(p, low), 16)));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(row + x * 4), out);
+    }
+#endif
+#if defined(HAS_NEON)
+    if (neon)
+    {
+      for (; x + 16 <= width; x += 16)
+      {
+        uint8x16x4_t p = vld4q_u8(row + x * 4);
+        uint8x16_t blue = p.val[0];
+        p.val[0] = p.val[2];
+        p.val[2] = blue;
+        vst4q_u8(row + x * 4, p);
+      }
+    }
+#endif
+    for (; x < width; x++)
+    {
+      uint32_t pixel;
+      memcpy(&pixel, row + x * 4, sizeof(pixel));
+      pixel = SwapPixel(pixel);
+      memcpy(row + x * 4, &pixel, sizeof(pixel));
+    }
+  }
+  (void)neon;
+}
+
+void CPixelKernels::Halve(const unsigned char* pixels, unsigned int width, unsigned int height, unsigned int pitch,
+                          unsigned char* dest, unsigned int destPitch)
+{
+  const bool neon = HasNeon();
+  const unsigned int destWidth = width / 2;
+  const unsigned int destHeight = height / 2;
+  for (unsigned int y = 0; y < destHeight; y++)
+  {
+    const unsigned char* row0 = pixels + 2 * y * pitch;
+    const unsigned char* row1 = row0 + pitch;
+    unsigned char* out = dest + y * destPitch;
+    unsigned int x = 0;
+#if defined(HAVE_SSE2) && defined(__SSE2__)
+    for (; x + 4 <= destWidth; x += 4)
+    {
+      const __m128 a0 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 8)));
+      const __m128 b0 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 8 + 16)));
+      const __m128 a1 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 8)));
+      const __m128 b1 = _mm_castsi128_ps(_mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 8 + 16)));
+      // split into the even and the odd pixels, then average them
+      const __m128i top = _mm_avg_epu8(_mm_castps_si128(_mm_shuffle_ps(a0, b0, _MM_SHUFFLE(2, 0, 2, 0))),
+                                       _mm_castps_si128(_mm_shuffle_ps(a0, b0, _MM_SHUFFLE(3, 1, 3, 1))));
+      const __m128i bottom = _mm_avg_epu8(_mm_castps_si128(_mm_shuffle_ps(a1, b1, _MM_SHUFFLE(2, 0, 2, 0))),
+                                          _mm_castps_si128(_mm_shuffle_ps(a1, b1, _MM_SHUFFLE(3, 1, 3, 1))));
+      _mm_storeu_si128(reinterpret_cast<__m128i*>(out + x * 4), _mm_avg_epu8(top, bottom));
+    }
+#endif
+#if defined(HAS_NEON)
+    if (neon)
+    {
+      for (; x + 4 <= destWidth; x += 4)
+      {
+        // loads the even pixels into val[0] and the odd ones into val[1]
+        const uint32x4x2_t p0 = vld2q_u32(reinterpret_cast<const uint32_t*>(row0 + x * 8));
+        const uint32x4x2_t p1 = vld2q_u32(reinterpret_cast<const uint32_t*>(row1 + x * 8));
+        const uint8x16_t top = vrhaddq_u8(vreinterpretq_u8_u32(p0.val[0]), vreinterpretq_u8_u32(p0.val[1]));
+        const uint8x16_t bottom = vrhaddq_u8(vreinterpretq_u8_u32(p1.val[0]), vreinterpretq_u8_u32(p1.val[1]));
+        vst1q_u8(out + x * 4, vrhaddq_u8(top, bottom));
+      }
+    }
+#endif
+    for (; x < destWidth; x++)
+    {
+      uint32_t p[4];
+      memcpy(&p[0], row0 + x * 8, sizeof(uint32_t));
+      memcpy(&p[1], row0 + x * 8 + 4, sizeof(uint32_t));
+      memcpy(&p[2], row1 + x * 8, sizeof(uint32_t));
+      memcpy(&p[3], row1 + x * 8 + 4, sizeof(uint32_t));
+      const uint32_t pixel = AveragePixels(p[0], p[1], p[2], p[3]);
+      memcpy(out + x * 4, &pixel, sizeof(pixel));
+    }
+  }
+  (void)neon;
+}
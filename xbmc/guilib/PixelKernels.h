@@ -0,0 +1,35 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+/*!
+ \brief Pixel operations on 32 bit images that are too hot for generic code.
+
+ Uses SSE2 or NEON where the build has it, with a scalar fallback for everything else.
+ */
+class CPixelKernels
+{
+public:
+  /*!
+   \brief Swap the first and third byte of every pixel, i.e. convert between BGRA and RGBA
+   \param width pixels per row
+   */
+  static void SwapBlueRed(unsigned char* pixels, unsigned int width, unsigned int height, unsigned int pitch);
+
+  /*!
+   \brief Halve an image with a 2x2 box filter
+   An odd last row or column of the source is dropped.
+   \param dest buffer of at least height / 2 rows of destPitch bytes
+   */
+  static void Halve(const unsigned char* pixels, unsigned int width, unsigned int height, unsigned int pitch,
+                    unsigned char* dest, unsigned int destPitch);
+
+private:
+  static bool HasNeon();
+};
@@ -11,6 +11,7 @@
 #include "utils/log.h"
 #include "utils/URIUtils.h"
 #include "DDSImage.h"
+#include "PixelKernels.h"
 #include "filesystem/File.h"
 #include "filesystem/ResourceFile.h"
 #include "filesystem/XbtFile.h"
@@ -51,21 +52,21 @@ void CBaseTexture::Allocate(unsigned int width, unsigned int height, unsigned in
   m_textureWidth = m_imageWidth;
   m_textureHeight = m_imageHeight;
 
-  if (m_format & XB_FMT_DXT_MASK)
+  if (m_format & XB_FMT_COMPRESSED_MASK)
   {
     while (GetPitch() < CServiceBroker::GetRenderSystem()->GetMinDXTPitch())
       m_textureWidth += GetBlockSize();
   }
 
-  if (!CServiceBroker::GetRenderSystem()->SupportsNPOT((m_format & XB_FMT_DXT_MASK) != 0))
+  if (!CServiceBroker::GetRenderSystem()->SupportsNPOT((m_format & XB_FMT_COMPRESSED_MASK) != 0))
   {
     m_textureWidth = PadPow2(m_textureWidth);
     m_textureHeight = PadPow2(m_textureHeight);
   }
 
-  if (m_format & XB_FMT_DXT_MASK)
+  if (m_format & XB_FMT_COMPRESSED_MASK)
   {
-    // DXT textures must be a multiple of 4 in width and height
+    // compressed textures are made of 4x4 blocks, so must be a multiple of 4 in width and height
     m_textureWidth = ((m_textureWidth + 3) / 4) * 4;
     m_textureHeight = ((m_textureHeight + 3) / 4) * 4;
   }
@@ -110,8 +111,12 @@ void CBaseTexture::Update(unsigned int width, unsigned int height, unsigned int
   if (pixels == NULL)
     return;
 
-  if (format & XB_FMT_DXT_MASK)
+  // compressed data can only be handed to the GPU as it is
+  if ((format & XB_FMT_COMPRESSED_MASK) && !CServiceBroker::GetRenderSystem()->SupportsTextureFormat(format))
+  {
+    CLog::Log(LOGERROR, "%s - texture format %u isn't supported by the GPU", __FUNCTION__, format & XB_FMT_MASK);
     return;
+  }
 
   Allocate(width, height, format);
 
@@ -223,7 +228,8 @@ bool CBaseTexture::LoadFromFileInternal(const std::string& texturePath, unsigned
     if (image.ReadFile(texturePath))
     {
       Update(image.GetWidth(), image.GetHeight(), 0, image.GetFormat(), image.GetData(), false);
-      return true;
+      // the GPU may not support the format of the image
+      return m_pixels != nullptr;
     }
     return false;
   }
@@ -370,6 +376,11 @@ unsigned int CBaseTexture::PadPow2(unsigned int x)
 bool CBaseTexture::SwapBlueRed(unsigned char *pixels, unsigned int height, unsigned int pitch, unsigned int elements, unsigned int offset)
 {
   if (!pixels) return false;
+  if (elements == 4 && offset == 0)
+  {
+    CPixelKernels::SwapBlueRed(pixels, pitch / 4, height, pitch);
+    return true;
+  }
   unsigned char *dst = pixels;
   for (unsigned int y = 0; y < height; y++)
   {
@@ -385,10 +396,14 @@ unsigned int CBaseTexture::GetPitch(unsigned int width) const
   switch (m_format)
   {
   case XB_FMT_DXT1:
+  case XB_FMT_ETC2_RGB8:
     return ((width + 3) / 4) * 8;
   case XB_FMT_DXT3:
   case XB_FMT_DXT5:
   case XB_FMT_DXT5_YCoCg:
+  case XB_FMT_ETC2_RGBA8:
+  case XB_FMT_BC7:
+  case XB_FMT_ASTC_4x4:
     return ((width + 3) / 4) * 16;
   case XB_FMT_A8:
     return width;
@@ -406,10 +421,13 @@ unsigned int CBaseTexture::GetRows(unsigned int height) const
   switch (m_format)
   {
   case XB_FMT_DXT1:
-    return (height + 3) / 4;
   case XB_FMT_DXT3:
   case XB_FMT_DXT5:
   case XB_FMT_DXT5_YCoCg:
+  case XB_FMT_ETC2_RGB8:
+  case XB_FMT_ETC2_RGBA8:
+  case XB_FMT_BC7:
+  case XB_FMT_ASTC_4x4:
     return (height + 3) / 4;
   default:
     return height;
@@ -421,10 +439,14 @@ unsigned int CBaseTexture::GetBlockSize() const
   switch (m_format)
   {
   case XB_FMT_DXT1:
+  case XB_FMT_ETC2_RGB8:
     return 8;
   case XB_FMT_DXT3:
   case XB_FMT_DXT5:
   case XB_FMT_DXT5_YCoCg:
+  case XB_FMT_ETC2_RGBA8:
+  case XB_FMT_BC7:
+  case XB_FMT_ASTC_4x4:
     return 16;
   case XB_FMT_A8:
     return 1;
@@ -78,6 +78,12 @@ public:
   virtual void CreateTextureObject() = 0;
   virtual void DestroyTextureObject() = 0;
   virtual void LoadToGPU() = 0;
+  /*!
+   \brief Upload the texture a part at a time, so large textures can be spread over several frames
+   \param maxBytes the number of bytes to upload at most, at least one row always gets uploaded
+   \return true once the whole texture is on the GPU
+   */
+  virtual bool LoadToGPUPartially(size_t maxBytes) { LoadToGPU(); return true; }
   virtual void BindToUnit(unsigned int unit) = 0;
 
   unsigned char* GetPixels() const { return m_pixels; }
@@ -55,6 +55,17 @@ bool CTextureBundle::LoadTexture(const std::string& Filename, CBaseTexture** ppT
   return false;
 }
 
+bool CTextureBundle::LoadAtlasTexture(const std::string& Filename, std::shared_ptr<CBaseTexture>& page,
+                                      int& x, int& y, int& width, int& height)
+{
+  if (m_useXBT)
+  {
+    return m_tbXBT.LoadAtlasTexture(Filename, page, x, y, width, height);
+  }
+
+  return false;
+}
+
 int CTextureBundle::LoadAnim(const std::string& Filename, CBaseTexture*** ppTextures,
                               int &width, int &height, int& nLoops, int** ppDelays)
 {
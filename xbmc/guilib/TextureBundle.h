@@ -10,6 +10,7 @@
 
 #include "TextureBundleXBT.h"
 
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -26,6 +27,7 @@ public:
   static std::string Normalize(const std::string &name);
 
   bool LoadTexture(const std::string& Filename, CBaseTexture** ppTexture, int &width, int &height);
+  bool LoadAtlasTexture(const std::string& Filename, std::shared_ptr<CBaseTexture>& page, int& x, int& y, int& width, int& height);
 
   int LoadAnim(const std::string& Filename, CBaseTexture*** ppTextures, int &width, int &height, int& nLoops, int** ppDelays);
   void Close();
@@ -21,6 +21,8 @@
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
 
+#include <cstring>
+
 #include <lzo/lzo1x.h>
 
 #ifdef TARGET_WINDOWS_DESKTOP
@@ -101,6 +103,9 @@ bool CTextureBundleXBT::OpenBundle()
 
   CLog::Log(LOGDEBUG, "%s - Opened bundle %s", __FUNCTION__, m_path.c_str());
 
+  // the offsets of the pages of a changed bundle may match the old ones
+  m_atlasPages.clear();
+
   m_TimeStamp = m_XBTFReader->GetLastModificationTimestamp();
 
   if (lzo_init() != LZO_E_OK)
@@ -171,6 +176,44 @@ bool CTextureBundleXBT::LoadTexture(const std::string& Filename, CBaseTexture**
   return true;
 }
 
+bool CTextureBundleXBT::LoadAtlasTexture(const std::string& Filename, std::shared_ptr<CBaseTexture>& page,
+                                         int& x, int& y, int& width, int& height)
+{
+  std::string name = Normalize(Filename);
+
+  CXBTFFile file;
+  if (!m_XBTFReader->Get(name, file))
+    return false;
+
+  if (file.GetFrames().size() != 1 || !file.GetFrames()[0].IsInAtlas())
+    return false;
+
+  const CXBTFFrame& frame = file.GetFrames()[0];
+  page = m_atlasPages[frame.GetOffset()].lock();
+  if (!page)
+  {
+    CXBTFFrame pageFrame(frame);
+    pageFrame.SetWidth(frame.GetAtlasWidth());
+    pageFrame.SetHeight(frame.GetAtlasHeight());
+    pageFrame.SetFormat(XB_FMT_A8R8G8B8);
+    pageFrame.SetAtlas(0, 0, 0, 0);
+
+    CBaseTexture* texture = nullptr;
+    if (!ConvertFrameToTexture(Filename, pageFrame, &texture))
+      return false;
+
+    page.reset(texture);
+    m_atlasPages[frame.GetOffset()] = page;
+  }
+
+  x = frame.GetAtlasX();
+  y = frame.GetAtlasY();
+  width = frame.GetWidth();
+  height = frame.GetHeight();
+
+  return true;
+}
+
 int CTextureBundleXBT::LoadAnim(const std::string& Filename, CBaseTexture*** ppTextures,
                               int &width, int &height, int& nLoops, int** ppDelays)
 {
@@ -208,6 +251,22 @@ int CTextureBundleXBT::LoadAnim(const std::string& Filename, CBaseTexture*** ppT
 
 bool CTextureBundleXBT::ConvertFrameToTexture(const std::string& name, CXBTFFrame& frame, CBaseTexture** ppTexture)
 {
+  if (frame.IsInAtlas())
+  {
+    // a texture of its own, cut out of the page
+    uint8_t* image = UnpackFrame(*m_XBTFReader, frame);
+    if (image == nullptr)
+    {
+      CLog::Log(LOGERROR, "Error loading texture: %s", name.c_str());
+      return false;
+    }
+
+    *ppTexture = new CTexture();
+    (*ppTexture)->LoadFromMemory(frame.GetWidth(), frame.GetHeight(), 0, frame.GetFormat(), frame.HasAlpha(), image);
+    delete[] image;
+    return true;
+  }
+
   // found texture - allocate the necessary buffers
   unsigned char *buffer = new unsigned char [(size_t)frame.GetPackedSize()];
   if (buffer == NULL)
@@ -275,6 +334,33 @@ std::string CTextureBundleXBT::Normalize(const std::string &name)
 }
 
 uint8_t* CTextureBundleXBT::UnpackFrame(const CXBTFReader& reader, const CXBTFFrame& frame)
+{
+  uint8_t* data = UnpackFrameData(reader, frame);
+  if (data == nullptr || !frame.IsInAtlas())
+    return data;
+
+  if (frame.GetAtlasX() + frame.GetWidth() > frame.GetAtlasWidth() ||
+      frame.GetAtlasY() + frame.GetHeight() > frame.GetAtlasHeight() ||
+      frame.GetUnpackedSize() != static_cast<uint64_t>(frame.GetAtlasWidth()) * frame.GetAtlasHeight() * 4)
+  {
+    CLog::Log(LOGERROR, "CTextureBundleXBT: frame of %ux%u at %u,%u doesn't fit its atlas page of %ux%u",
+              frame.GetWidth(), frame.GetHeight(), frame.GetAtlasX(), frame.GetAtlasY(),
+              frame.GetAtlasWidth(), frame.GetAtlasHeight());
+    delete[] data;
+    return nullptr;
+  }
+
+  const size_t pagePitch = frame.GetAtlasWidth() * 4;
+  const size_t pitch = frame.GetWidth() * 4;
+  uint8_t* image = new uint8_t[static_cast<size_t>(frame.GetImageSize())];
+  for (uint32_t row = 0; row < frame.GetHeight(); ++row)
+    memcpy(image + row * pitch, data + (frame.GetAtlasY() + row) * pagePitch + frame.GetAtlasX() * 4, pitch);
+
+  delete[] data;
+  return image;
+}
+
+uint8_t* CTextureBundleXBT::UnpackFrameData(const CXBTFReader& reader, const CXBTFFrame& frame)
 {
   uint8_t* packedBuffer = new uint8_t[static_cast<size_t>(frame.GetPackedSize())];
   if (packedBuffer == nullptr)
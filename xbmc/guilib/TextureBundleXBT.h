@@ -33,22 +33,37 @@ public:
   bool LoadTexture(const std::string& Filename, CBaseTexture** ppTexture,
                        int &width, int &height);
 
+  /*!
+   \brief Load the atlas page a texture was packed onto.
+   A page is loaded once and shared by the textures on it for as long as any of them is in use.
+   \param x, y position of the texture on the page
+   \return false if the texture isn't on an atlas page or the page fails to load
+   */
+  bool LoadAtlasTexture(const std::string& Filename, std::shared_ptr<CBaseTexture>& page,
+                        int& x, int& y, int& width, int& height);
+
   int LoadAnim(const std::string& Filename, CBaseTexture*** ppTextures,
                 int &width, int &height, int& nLoops, int** ppDelays);
 
+  /*!
+   \brief Unpack the image data of a frame, cropped to the frame if it lies on an atlas page
+   \return the data to be freed with delete[], nullptr on failure
+   */
   static uint8_t* UnpackFrame(const CXBTFReader& reader, const CXBTFFrame& frame);
-  
+
   void CloseBundle();
 
 private:
   bool OpenBundle();
   bool ConvertFrameToTexture(const std::string& name, CXBTFFrame& frame, CBaseTexture** ppTexture);
+  static uint8_t* UnpackFrameData(const CXBTFReader& reader, const CXBTFFrame& frame);
 
   time_t m_TimeStamp;
 
   bool m_themeBundle;
   std::string m_path;
   std::shared_ptr<CXBTFReader> m_XBTFReader;
+  std::map<uint64_t, std::weak_ptr<CBaseTexture>> m_atlasPages; //!< by offset of the page data
 };
 
 
@@ -0,0 +1,529 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "TextureCompressor.h"
+
+#include "TextureFormats.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+namespace
+{
+// intensity modifiers of the ETC colour blocks, the pixel indices select +a, +b, -a and -b
+const int etcModifiers[8][2] = {
+  {2, 8}, {5, 17}, {9, 29}, {13, 42}, {18, 60}, {24, 80}, {33, 106}, {47, 183}};
+
+const int eacModifiers[16][8] = {
+  {-3, -6, -9, -15, 2, 5, 8, 14}, {-3, -7, -10, -13, 2, 6, 9, 12},
+  {-2, -5, -8, -13, 1, 4, 7, 12}, {-2, -4, -6, -13, 1, 3, 5, 12},
+  {-3, -6, -8, -12, 2, 5, 7, 11}, {-3, -7, -9, -11, 2, 6, 8, 10},
+  {-4, -7, -8, -11, 3, 6, 7, 10}, {-3, -5, -8, -11, 2, 4, 7, 10},
+  {-2, -6, -8, -10, 1, 5, 7, 9}, {-2, -5, -8, -10, 1, 4, 7, 9},
+  {-2, -4, -8, -10, 1, 3, 7, 9}, {-2, -5, -7, -10, 1, 4, 6, 9},
+  {-3, -4, -7, -10, 2, 3, 6, 9}, {-1, -2, -3, -10, 0, 1, 2, 9},
+  {-4, -6, -8, -9, 3, 5, 7, 8}, {-3, -5, -7, -9, 2, 4, 6, 8}};
+
+inline int Clamp255(int value)
+{
+  return std::min(std::max(value, 0), 255);
+}
+
+inline int Square(int value)
+{
+  return value * value;
+}
+
+void WriteBigEndian(uint64_t value, unsigned char* dest, int bytes)
+{
+  for (int i = bytes - 1; i >= 0; --i)
+  {
+    dest[i] = value & 0xff;
+    value >>= 8;
+  }
+}
+
+void WriteLittleEndian(uint64_t value, unsigned char* dest, int bytes)
+{
+  for (int i = 0; i < bytes; ++i)
+  {
+    dest[i] = value & 0xff;
+    value >>= 8;
+  }
+}
+
+uint16_t To565(const int bgr[3])
+{
+  const int r = (Clamp255(bgr[2]) * 31 + 127) / 255;
+  const int g = (Clamp255(bgr[1]) * 63 + 127) / 255;
+  const int b = (Clamp255(bgr[0]) * 31 + 127) / 255;
+  return (r << 11) | (g << 5) | b;
+}
+
+void From565(uint16_t color, int bgr[3])
+{
+  const int r = (color >> 11) & 31;
+  const int g = (color >> 5) & 63;
+  const int b = color & 31;
+  bgr[2] = (r << 3) | (r >> 2);
+  bgr[1] = (g << 2) | (g >> 4);
+  bgr[0] = (b << 3) | (b >> 2);
+}
+
+struct SETCSubBlock
+{
+  int pixels[8]; //!< offsets into the 4x4 block, row by row
+  int base[3];
+  int table;
+  int indices[8];
+};
+
+// the sub blocks of a block split into two columns or, flipped, into two rows
+void GetETCSubBlocks(bool flip, SETCSubBlock& first, SETCSubBlock& second)
+{
+  int n1 = 0, n2 = 0;
+  for (int y = 0; y < 4; ++y)
+  {
+    for (int x = 0; x < 4; ++x)
+    {
+      if ((flip ? y : x) < 2)
+        first.pixels[n1++] = y * 4 + x;
+      else
+        second.pixels[n2++] = y * 4 + x;
+    }
+  }
+}
+
+// pick the modifier table with the least error for the base colour of a sub block
+int FitETCSubBlock(const unsigned char* block, SETCSubBlock& sub)
+{
+  int bestError = -1;
+  for (int table = 0; table < 8; ++table)
+  {
+    const int modifiers[4] = {etcModifiers[table][0], etcModifiers[table][1],
+                              -etcModifiers[table][0], -etcModifiers[table][1]};
+    int error = 0;
+    int indices[8];
+    for (int i = 0; i < 8; ++i)
+    {
+      const unsigned char* pixel = block + sub.pixels[i] * 4;
+      int best = -1;
+      for (int m = 0; m < 4; ++m)
+      {
+        int e = 0;
+        for (int c = 0; c < 3; ++c)
+          e += Square(pixel[c] - Clamp255(sub.base[c] + modifiers[m]));
+        if (best < 0 || e < best)
+        {
+          best = e;
+          indices[i] = m;
+        }
+      }
+      error += best;
+    }
+    if (bestError < 0 || error < bestError)
+    {
+      bestError = error;
+      sub.table = table;
+      std::copy(indices, indices + 8, sub.indices);
+    }
+  }
+  return bestError;
+}
+
+void GetAverage(const unsigned char* block, const SETCSubBlock& sub, float average[3])
+{
+  average[0] = average[1] = average[2] = 0.0f;
+  for (int i = 0; i < 8; ++i)
+  {
+    for (int c = 0; c < 3; ++c)
+      average[c] += block[sub.pixels[i] * 4 + c];
+  }
+  for (int c = 0; c < 3; ++c)
+    average[c] /= 8.0f;
+}
+}
+
+bool CTextureCompressor::CanCompress(unsigned int format)
+{
+  switch (format & XB_FMT_MASK)
+  {
+  case XB_FMT_DXT1:
+  case XB_FMT_DXT5:
+  case XB_FMT_ETC2_RGB8:
+  case XB_FMT_ETC2_RGBA8:
+    return true;
+  default:
+    return false;
+  }
+}
+
+unsigned int CTextureCompressor::GetSize(unsigned int width, unsigned int height, unsigned int format)
+{
+  const unsigned int blocks = ((width + 3) / 4) * ((height + 3) / 4);
+  switch (format & XB_FMT_MASK)
+  {
+  case XB_FMT_DXT1:
+  case XB_FMT_ETC2_RGB8:
+    return blocks * 8;
+  case XB_FMT_DXT3:
+  case XB_FMT_DXT5:
+  case XB_FMT_DXT5_YCoCg:
+  case XB_FMT_ETC2_RGBA8:
+  case XB_FMT_BC7:
+  case XB_FMT_ASTC_4x4:
+    return blocks * 16;
+  default:
+    return width * height * 4;
+  }
+}
+
+bool CTextureCompressor::Compress(const unsigned char* pixels, unsigned int width, unsigned int height,
+                                  unsigned int pitch, unsigned int format, unsigned char* dest)
+{
+  format &= XB_FMT_MASK;
+  if (!CanCompress(format) || !pixels || !dest || width == 0 || height == 0)
+    return false;
+
+  unsigned char block[64];
+  for (unsigned int by = 0; by < height; by += 4)
+  {
+    for (unsigned int bx = 0; bx < width; bx += 4)
+    {
+      // blocks at the right and bottom edges repeat the last pixels
+      for (unsigned int y = 0; y < 4; ++y)
+      {
+        const unsigned char* src = pixels + std::min(by + y, height - 1) * pitch;
+        for (unsigned int x = 0; x < 4; ++x)
+          memcpy(block + (y * 4 + x) * 4, src + std::min(bx + x, width - 1) * 4, 4);
+      }
+
+      switch (format)
+      {
+      case XB_FMT_DXT1:
+        CompressDXTColor(block, dest);
+        dest += 8;
+        break;
+      case XB_FMT_DXT5:
+        CompressDXTAlpha(block, dest);
+        CompressDXTColor(block, dest + 8);
+        dest += 16;
+        break;
+      case XB_FMT_ETC2_RGB8:
+        CompressETCColor(block, dest);
+        dest += 8;
+        break;
+      case XB_FMT_ETC2_RGBA8:
+        CompressEACAlpha(block, dest);
+        CompressETCColor(block, dest + 8);
+        dest += 16;
+        break;
+      }
+    }
+  }
+  return true;
+}
+
+void CTextureCompressor::CompressDXTColor(const unsigned char* block, unsigned char* dest)
+{
+  // the end points are the pixels furthest apart along the principal axis of the colours
+  float mean[3] = {};
+  for (int i = 0; i < 16; ++i)
+  {
+    for (int c = 0; c < 3; ++c)
+      mean[c] += block[i * 4 + c];
+  }
+  for (int c = 0; c < 3; ++c)
+    mean[c] /= 16.0f;
+
+  float cov[6] = {};
+  for (int i = 0; i < 16; ++i)
+  {
+    const float d[3] = {block[i * 4] - mean[0], block[i * 4 + 1] - mean[1], block[i * 4 + 2] - mean[2]};
+    cov[0] += d[0] * d[0];
+    cov[1] += d[0] * d[1];
+    cov[2] += d[0] * d[2];
+    cov[3] += d[1] * d[1];
+    cov[4] += d[1] * d[2];
+    cov[5] += d[2] * d[2];
+  }
+
+  float axis[3] = {1.0f, 1.0f, 1.0f};
+  for (int iteration = 0; iteration < 4; ++iteration)
+  {
+    const float next[3] = {cov[0] * axis[0] + cov[1] * axis[1] + cov[2] * axis[2],
+                           cov[1] * axis[0] + cov[3] * axis[1] + cov[4] * axis[2],
+                           cov[2] * axis[0] + cov[4] * axis[1] + cov[5] * axis[2]};
+    const float length = std::max(std::fabs(next[0]), std::max(std::fabs(next[1]), std::fabs(next[2])));
+    if (length == 0.0f)
+      break;
+    for (int c = 0; c < 3; ++c)
+      axis[c] = next[c] / length;
+  }
+
+  int minIndex = 0, maxIndex = 0;
+  float minDot = 0.0f, maxDot = 0.0f;
+  for (int i = 0; i < 16; ++i)
+  {
+    const float dot = block[i * 4] * axis[0] + block[i * 4 + 1] * axis[1] + block[i * 4 + 2] * axis[2];
+    if (i == 0 || dot < minDot)
+    {
+      minDot = dot;
+      minIndex = i;
+    }
+    if (i == 0 || dot > maxDot)
+    {
+      maxDot = dot;
+      maxIndex = i;
+    }
+  }
+
+  const int maxColor[3] = {block[maxIndex * 4], block[maxIndex * 4 + 1], block[maxIndex * 4 + 2]};
+  const int minColor[3] = {block[minIndex * 4], block[minIndex * 4 + 1], block[minIndex * 4 + 2]};
+  uint16_t color0 = To565(maxColor);
+  uint16_t color1 = To565(minColor);
+  // the first colour has to be the larger one, otherwise the block is in 3 colour mode
+  if (color0 < color1)
+    std::swap(color0, color1);
+
+  uint32_t indices = 0;
+  if (color0 != color1)
+  {
+    int palette[4][3];
+    From565(color0, palette[0]);
+    From565(color1, palette[1]);
+    for (int c = 0; c < 3; ++c)
+    {
+      palette[2][c] = (2 * palette[0][c] + palette[1][c]) / 3;
+      palette[3][c] = (palette[0][c] + 2 * palette[1][c]) / 3;
+    }
+
+    for (int i = 0; i < 16; ++i)
+    {
+      int best = -1;
+      uint32_t index = 0;
+      for (int p = 0; p < 4; ++p)
+      {
+        const int e = Square(block[i * 4] - palette[p][0]) + Square(block[i * 4 + 1] - palette[p][1]) +
+                      Square(block[i * 4 + 2] - palette[p][2]);
+        if (best < 0 || e < best)
+        {
+          best = e;
+          index = p;
+        }
+      }
+      indices |= index << (2 * i);
+    }
+  }
+
+  WriteLittleEndian(color0, dest, 2);
+  WriteLittleEndian(color1, dest + 2, 2);
+  WriteLittleEndian(indices, dest + 4, 4);
+}
+
+void CTextureCompressor::CompressDXTAlpha(const unsigned char* block, unsigned char* dest)
+{
+  int alpha0 = 0, alpha1 = 255;
+  for (int i = 0; i < 16; ++i)
+  {
+    alpha0 = std::max<int>(alpha0, block[i * 4 + 3]);
+    alpha1 = std::min<int>(alpha1, block[i * 4 + 3]);
+  }
+
+  uint64_t indices = 0;
+  if (alpha0 != alpha1)
+  {
+    // 8 alpha values as the first is larger than the second
+    int palette[8] = {alpha0, alpha1};
+    for (int p = 2; p < 8; ++p)
+      palette[p] = ((8 - p) * alpha0 + (p - 1) * alpha1) / 7;
+
+    for (int i = 0; i < 16; ++i)
+    {
+      int best = -1;
+      uint64_t index = 0;
+      for (int p = 0; p < 8; ++p)
+      {
+        const int e = std::abs(block[i * 4 + 3] - palette[p]);
+        if (best < 0 || e < best)
+        {
+          best = e;
+          index = p;
+        }
+      }
+      indices |= index << (3 * i);
+    }
+  }
+
+  dest[0] = alpha0;
+  dest[1] = alpha1;
+  WriteLittleEndian(indices, dest + 2, 6);
+}
+
+void CTextureCompressor::CompressETCColor(const unsigned char* block, unsigned char* dest)
+{
+  // try both orientations of the sub blocks, each in differential and in individual mode
+  int bestError = -1;
+  bool bestFlip = false;
+  bool bestDiff = false;
+  int bestColors[2][3] = {};
+  SETCSubBlock best[2];
+
+  for (int flip = 0; flip < 2; ++flip)
+  {
+    SETCSubBlock sub[2];
+    GetETCSubBlocks(flip != 0, sub[0], sub[1]);
+
+    float average[2][3];
+    GetAverage(block, sub[0], average[0]);
+    GetAverage(block, sub[1], average[1]);
+
+    for (int diff = 1; diff >= 0; --diff)
+    {
+      int colors[2][3];
+      for (int s = 0; s < 2; ++s)
+      {
+        for (int c = 0; c < 3; ++c)
+        {
+          if (diff)
+          {
+            colors[s][c] = static_cast<int>(average[s][c] * 31.0f / 255.0f + 0.5f);
+            sub[s].base[c] = (colors[s][c] << 3) | (colors[s][c] >> 2);
+          }
+          else
+          {
+            colors[s][c] = static_cast<int>(average[s][c] * 15.0f / 255.0f + 0.5f);
+            sub[s].base[c] = (colors[s][c] << 4) | colors[s][c];
+          }
+        }
+      }
+
+      if (diff)
+      {
+        // the second colour is stored as a 3 bit delta, a larger one would switch ETC2 to its other modes
+        bool fits = true;
+        for (int c = 0; c < 3; ++c)
+        {
+          const int delta = colors[1][c] - colors[0][c];
+          fits = fits && delta >= -4 && delta <= 3;
+        }
+        if (!fits)
+          continue;
+      }
+
+      const int error = FitETCSubBlock(block, sub[0]) + FitETCSubBlock(block, sub[1]);
+      if (bestError < 0 || error < bestError)
+      {
+        bestError = error;
+        bestFlip = flip != 0;
+        bestDiff = diff != 0;
+        memcpy(bestColors, colors, sizeof(colors));
+        best[0] = sub[0];
+        best[1] = sub[1];
+      }
+    }
+  }
+
+  // colour order in the block is R, G, B
+  uint32_t high = 0;
+  for (int c = 0; c < 3; ++c)
+  {
+    const int shift = 24 - c * 8;
+    const int channel = 2 - c;
+    if (bestDiff)
+      high |= (bestColors[0][channel] << (shift + 3)) |
+              (((bestColors[1][channel] - bestColors[0][channel]) & 7) << shift);
+    else
+      high |= (bestColors[0][channel] << (shift + 4)) | (bestColors[1][channel] << shift);
+  }
+  high |= (best[0].table << 5) | (best[1].table << 2) | (bestDiff ? 2 : 0) | (bestFlip ? 1 : 0);
+
+  // the indices are stored column by column, the most significant bits in the upper half
+  uint32_t low = 0;
+  for (int s = 0; s < 2; ++s)
+  {
+    for (int i = 0; i < 8; ++i)
+    {
+      const int x = best[s].pixels[i] % 4;
+      const int y = best[s].pixels[i] / 4;
+      const int bit = x * 4 + y;
+      const uint32_t index = best[s].indices[i];
+      low |= ((index >> 1) << (16 + bit)) | ((index & 1) << bit);
+    }
+  }
+
+  WriteBigEndian(high, dest, 4);
+  WriteBigEndian(low, dest + 4, 4);
+}
+
+void CTextureCompressor::CompressEACAlpha(const unsigned char* block, unsigned char* dest)
+{
+  int minAlpha = 255, maxAlpha = 0;
+  for (int i = 0; i < 16; ++i)
+  {
+    minAlpha = std::min<int>(minAlpha, block[i * 4 + 3]);
+    maxAlpha = std::max<int>(maxAlpha, block[i * 4 + 3]);
+  }
+
+  // a multiplier of 0 gives the base value for all pixels
+  int bestBase = minAlpha;
+  int bestMultiplier = 0;
+  int bestTable = 0;
+  int bestIndices[16] = {};
+
+  if (minAlpha != maxAlpha)
+  {
+    int bestError = -1;
+    for (int table = 0; table < 16; ++table)
+    {
+      const int* modifiers = eacModifiers[table];
+      const int span = modifiers[7] - modifiers[3];
+      const int multiplier = std::min(std::max((maxAlpha - minAlpha + span / 2) / span, 1), 15);
+
+      for (int m = std::max(multiplier - 1, 1); m <= std::min(multiplier + 1, 15); ++m)
+      {
+        const int base = Clamp255((minAlpha + maxAlpha - (modifiers[7] + modifiers[3]) * m + 1) / 2);
+        int error = 0;
+        int indices[16];
+        for (int i = 0; i < 16 && (bestError < 0 || error < bestError); ++i)
+        {
+          int best = -1;
+          for (int p = 0; p < 8; ++p)
+          {
+            const int e = Square(block[i * 4 + 3] - Clamp255(base + modifiers[p] * m));
+            if (best < 0 || e < best)
+            {
+              best = e;
+              indices[i] = p;
+            }
+          }
+          error += best;
+        }
+        if (bestError < 0 || error < bestError)
+        {
+          bestError = error;
+          bestBase = base;
+          bestMultiplier = m;
+          bestTable = table;
+          std::copy(indices, indices + 16, bestIndices);
+        }
+      }
+    }
+  }
+
+  uint64_t value = (static_cast<uint64_t>(bestBase) << 56) | (static_cast<uint64_t>(bestMultiplier) << 52) |
+                   (static_cast<uint64_t>(bestTable) << 48);
+  for (int y = 0; y < 4; ++y)
+  {
+    for (int x = 0; x < 4; ++x)
+      value |= static_cast<uint64_t>(bestIndices[y * 4 + x]) << (45 - 3 * (x * 4 + y));
+  }
+  WriteBigEndian(value, dest, 8);
+}
@@ -0,0 +1,41 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+/*!
+ \brief Block compression of images into formats the GPU samples directly.
+
+ Fast single pass encoders for DXT1/DXT5 and ETC2 RGB8/RGBA8 (EAC alpha), good enough for
+ thumbnails and skin images. The colour blocks of ETC2 are written in the ETC1 compatible modes.
+ Used by the texture cache and by TexturePacker, so it must not depend on anything else in Kodi.
+ */
+class CTextureCompressor
+{
+public:
+  /*! \brief Whether there is an encoder for a format */
+  static bool CanCompress(unsigned int format);
+
+  /*! \brief Size in bytes of an image of the given format, padded to whole blocks */
+  static unsigned int GetSize(unsigned int width, unsigned int height, unsigned int format);
+
+  /*!
+   \brief Compress an image
+   \param pixels image in XB_FMT_A8R8G8B8 (BGRA) byte order
+   \param dest buffer of GetSize() bytes, blocks go row by row without padding
+   \return false if the format can't be encoded
+   */
+  static bool Compress(const unsigned char* pixels, unsigned int width, unsigned int height,
+                       unsigned int pitch, unsigned int format, unsigned char* dest);
+
+private:
+  static void CompressDXTColor(const unsigned char* block, unsigned char* dest);
+  static void CompressDXTAlpha(const unsigned char* block, unsigned char* dest);
+  static void CompressETCColor(const unsigned char* block, unsigned char* dest);
+  static void CompressEACAlpha(const unsigned char* block, unsigned char* dest);
+};
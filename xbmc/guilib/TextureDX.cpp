@@ -45,6 +45,9 @@ DXGI_FORMAT CDXTexture::GetFormat()
   case XB_FMT_DXT5_YCoCg:
     format = DXGI_FORMAT_BC3_UNORM; // XB_FMT_DXT5 -> DXGI_FORMAT_BC3_UNORM & DXGI_FORMAT_BC3_UNORM_SRGB
     break;
+  case XB_FMT_BC7:
+    format = DXGI_FORMAT_BC7_UNORM;
+    break;
   case XB_FMT_RGB8:
   case XB_FMT_A8R8G8B8:
     format = DXGI_FORMAT_B8G8R8A8_UNORM; // D3DFMT_A8R8G8B8 -> DXGI_FORMAT_B8G8R8A8_UNORM | DXGI_FORMAT_B8G8R8A8_UNORM_SRGB
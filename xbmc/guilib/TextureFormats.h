@@ -19,4 +19,9 @@
 #define XB_FMT_A8         32
 #define XB_FMT_RGBA8      64
 #define XB_FMT_RGB8      128
+#define XB_FMT_ETC2_RGB8 256 // GLES3 core, 8 bytes per 4x4 block
+#define XB_FMT_ETC2_RGBA8 512 // GLES3 core, ETC2 colour with an EAC alpha block
+#define XB_FMT_BC7      1024
+#define XB_FMT_ASTC_4x4 2048
+#define XB_FMT_COMPRESSED_MASK (XB_FMT_DXT_MASK | XB_FMT_ETC2_RGB8 | XB_FMT_ETC2_RGBA8 | XB_FMT_BC7 | XB_FMT_ASTC_4x4)
 #define XB_FMT_OPAQUE  65536
@@ -15,6 +15,59 @@
 #include "utils/MemUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <limits>
+
+// not every set of GL headers has the enums of all compressed formats
+#ifndef GL_COMPRESSED_RGBA_BPTC_UNORM
+#define GL_COMPRESSED_RGBA_BPTC_UNORM 0x8E8C
+#endif
+#ifndef GL_COMPRESSED_RGB8_ETC2
+#define GL_COMPRESSED_RGB8_ETC2 0x9274
+#endif
+#ifndef GL_COMPRESSED_RGBA8_ETC2_EAC
+#define GL_COMPRESSED_RGBA8_ETC2_EAC 0x9278
+#endif
+#ifndef GL_COMPRESSED_RGBA_ASTC_4x4_KHR
+#define GL_COMPRESSED_RGBA_ASTC_4x4_KHR 0x93B0
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT1_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT1_EXT 0x83F1
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT3_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT3_EXT 0x83F2
+#endif
+#ifndef GL_COMPRESSED_RGBA_S3TC_DXT5_EXT
+#define GL_COMPRESSED_RGBA_S3TC_DXT5_EXT 0x83F3
+#endif
+
+namespace
+{
+GLenum GetCompressedFormat(unsigned int format)
+{
+  switch (format)
+  {
+  case XB_FMT_DXT1:
+    return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+  case XB_FMT_DXT3:
+    return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+  case XB_FMT_DXT5:
+  case XB_FMT_DXT5_YCoCg:
+    return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+  case XB_FMT_BC7:
+    return GL_COMPRESSED_RGBA_BPTC_UNORM;
+  case XB_FMT_ETC2_RGB8:
+    return GL_COMPRESSED_RGB8_ETC2;
+  case XB_FMT_ETC2_RGBA8:
+    return GL_COMPRESSED_RGBA8_ETC2_EAC;
+  case XB_FMT_ASTC_4x4:
+    return GL_COMPRESSED_RGBA_ASTC_4x4_KHR;
+  default:
+    return 0;
+  }
+}
+}
+
 /************************************************************************/
 /*    CGLTexture                                                       */
 /************************************************************************/
@@ -44,12 +97,45 @@ void CGLTexture::DestroyTextureObject()
 }
 
 void CGLTexture::LoadToGPU()
+{
+  // a new image always gets uploaded as a whole
+  m_uploadedRows = 0;
+  UploadRows(std::numeric_limits<unsigned int>::max());
+}
+
+bool CGLTexture::LoadToGPUPartially(size_t maxBytes)
+{
+  const unsigned int pitch = m_uploadedRows ? m_uploadPitch : GetPitch();
+  const size_t rows = pitch ? maxBytes / pitch : 0;
+  return UploadRows(static_cast<unsigned int>(std::min<size_t>(std::max<size_t>(rows, 1), std::numeric_limits<unsigned int>::max())));
+}
+
+bool CGLTexture::IsUploadMipmapped() const
+{
+#ifdef HAS_GLES
+  // GLES can't generate the mipmaps of compressed textures
+  return IsMipmapped() && (m_format & XB_FMT_COMPRESSED_MASK) == 0;
+#else
+  return IsMipmapped();
+#endif
+}
+
+bool CGLTexture::UploadRows(unsigned int maxRows)
 {
   if (!m_pixels)
   {
     // nothing to load - probably same image (no change)
-    return;
+    return true;
+  }
+
+  if (m_uploadedRows > 0)
+  {
+    // continue a partial upload
+    glBindTexture(GL_TEXTURE_2D, m_texture);
+    UploadSubImage(maxRows);
+    return m_uploadedRows < m_textureHeight ? false : FinishUpload();
   }
+
   if (m_texture == 0)
   {
     // Have OpenGL generate a texture object handle for us
@@ -62,8 +148,10 @@ void CGLTexture::LoadToGPU()
 
   GLenum filter = (m_scalingMethod == TEXTURE_SCALING::NEAREST ? GL_NEAREST : GL_LINEAR);
 
+  const bool mipmap = IsUploadMipmapped();
+
   // Set the texture's stretching properties
-  if (IsMipmapped())
+  if (mipmap)
   {
     GLenum mipmapFilter = (m_scalingMethod == TEXTURE_SCALING::NEAREST ? GL_LINEAR_MIPMAP_NEAREST : GL_LINEAR_MIPMAP_LINEAR);
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, mipmapFilter);
@@ -84,6 +172,10 @@ void CGLTexture::LoadToGPU()
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
   glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
 
+  // the rows of the pixels keep their length if the texture gets truncated
+  m_uploadPitch = GetPitch();
+  m_uploadRowLength = 0;
+
   unsigned int maxSize = CServiceBroker::GetRenderSystem()->GetMaxTextureSize();
   if (m_textureHeight > maxSize)
   {
@@ -94,7 +186,7 @@ void CGLTexture::LoadToGPU()
   {
     CLog::Log(LOGERROR, "GL: Image width %d too big to fit into single texture unit, truncating to %u", m_textureWidth, maxSize);
 #ifndef HAS_GLES
-    glPixelStorei(GL_UNPACK_ROW_LENGTH, m_textureWidth);
+    m_uploadRowLength = m_textureWidth;
 #endif
     m_textureWidth = maxSize;
   }
@@ -105,16 +197,6 @@ void CGLTexture::LoadToGPU()
 
   switch (m_format)
   {
-  case XB_FMT_DXT1:
-    format = GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
-    break;
-  case XB_FMT_DXT3:
-    format = GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
-    break;
-  case XB_FMT_DXT5:
-  case XB_FMT_DXT5_YCoCg:
-    format = GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
-    break;
   case XB_FMT_RGB8:
     format = GL_RGB;
     numcomponents = GL_RGB;
@@ -124,26 +206,6 @@ void CGLTexture::LoadToGPU()
     break;
   }
 
-  if ((m_format & XB_FMT_DXT_MASK) == 0)
-  {
-    glTexImage2D(GL_TEXTURE_2D, 0, numcomponents,
-                 m_textureWidth, m_textureHeight, 0,
-                 format, GL_UNSIGNED_BYTE, m_pixels);
-  }
-  else
-  {
-    glCompressedTexImage2D(GL_TEXTURE_2D, 0, format,
-                           m_textureWidth, m_textureHeight, 0,
-                           GetPitch() * GetRows(), m_pixels);
-  }
-
-  if (IsMipmapped() && m_isOglVersion3orNewer)
-  {
-    glGenerateMipmap(GL_TEXTURE_2D);
-  }
-
-  glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
-
 #else	// GLES version
 
   // All incoming textures are BGRA, which GLES does not necessarily support.
@@ -155,47 +217,101 @@ void CGLTexture::LoadToGPU()
 #define GL_BGRA_EXT 0x80E1
 #endif
 
-  GLint internalformat;
-  GLenum pixelformat;
+  GLint numcomponents;
+  GLenum format;
 
   switch (m_format)
   {
     default:
     case XB_FMT_RGBA8:
-      internalformat = pixelformat = GL_RGBA;
+      numcomponents = format = GL_RGBA;
       break;
     case XB_FMT_RGB8:
-      internalformat = pixelformat = GL_RGB;
+      numcomponents = format = GL_RGB;
       break;
     case XB_FMT_A8R8G8B8:
       if (CServiceBroker::GetRenderSystem()->IsExtSupported("GL_EXT_texture_format_BGRA8888") ||
           CServiceBroker::GetRenderSystem()->IsExtSupported("GL_IMG_texture_format_BGRA8888"))
       {
-        internalformat = pixelformat = GL_BGRA_EXT;
+        numcomponents = format = GL_BGRA_EXT;
       }
       else if (CServiceBroker::GetRenderSystem()->IsExtSupported("GL_APPLE_texture_format_BGRA8888"))
       {
         // Apple's implementation does not conform to spec. Instead, they require
         // differing format/internalformat, more like GL.
-        internalformat = GL_RGBA;
-        pixelformat = GL_BGRA_EXT;
+        numcomponents = GL_RGBA;
+        format = GL_BGRA_EXT;
       }
       else
       {
         SwapBlueRed(m_pixels, m_textureHeight, GetPitch());
-        internalformat = pixelformat = GL_RGBA;
+        numcomponents = format = GL_RGBA;
       }
       break;
   }
-  glTexImage2D(GL_TEXTURE_2D, 0, internalformat, m_textureWidth, m_textureHeight, 0,
-    pixelformat, GL_UNSIGNED_BYTE, m_pixels);
+#endif
+  m_uploadFormat = format;
 
-  if (IsMipmapped())
+  if ((m_format & XB_FMT_COMPRESSED_MASK) != 0)
   {
-    glGenerateMipmap(GL_TEXTURE_2D);
+    // compressed textures are small, they go up in one piece
+    glCompressedTexImage2D(GL_TEXTURE_2D, 0, GetCompressedFormat(m_format),
+                           m_textureWidth, m_textureHeight, 0,
+                           GetPitch() * GetRows(), m_pixels);
+    m_uploadedRows = m_textureHeight;
   }
+  else if (maxRows >= m_textureHeight)
+  {
+#ifndef HAS_GLES
+    if (m_uploadRowLength)
+      glPixelStorei(GL_UNPACK_ROW_LENGTH, m_uploadRowLength);
+#endif
+    glTexImage2D(GL_TEXTURE_2D, 0, numcomponents,
+                 m_textureWidth, m_textureHeight, 0,
+                 format, GL_UNSIGNED_BYTE, m_pixels);
+#ifndef HAS_GLES
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+    m_uploadedRows = m_textureHeight;
+  }
+  else
+  {
+    // allocate the texture and fill it a few rows at a time
+    glTexImage2D(GL_TEXTURE_2D, 0, numcomponents,
+                 m_textureWidth, m_textureHeight, 0,
+                 format, GL_UNSIGNED_BYTE, nullptr);
+    UploadSubImage(maxRows);
+  }
+
+  return m_uploadedRows < m_textureHeight ? false : FinishUpload();
+}
 
+void CGLTexture::UploadSubImage(unsigned int maxRows)
+{
+  const unsigned int rows = std::min(maxRows, m_textureHeight - m_uploadedRows);
+#ifndef HAS_GLES
+  if (m_uploadRowLength)
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, m_uploadRowLength);
 #endif
+  glTexSubImage2D(GL_TEXTURE_2D, 0, 0, m_uploadedRows, m_textureWidth, rows,
+                  m_uploadFormat, GL_UNSIGNED_BYTE, m_pixels + static_cast<size_t>(m_uploadedRows) * m_uploadPitch);
+#ifndef HAS_GLES
+  glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+#endif
+  m_uploadedRows += rows;
+}
+
+bool CGLTexture::FinishUpload()
+{
+#ifndef HAS_GLES
+  if (IsUploadMipmapped() && m_isOglVersion3orNewer)
+#else
+  if (IsUploadMipmapped())
+#endif
+  {
+    glGenerateMipmap(GL_TEXTURE_2D);
+  }
+
   VerifyGLState();
 
   if (!m_bCacheMemory)
@@ -204,7 +320,9 @@ void CGLTexture::LoadToGPU()
     m_pixels = NULL;
   }
 
+  m_uploadedRows = 0;
   m_loadedToGPU = true;
+  return true;
 }
 
 void CGLTexture::BindToUnit(unsigned int unit)
@@ -24,10 +24,24 @@ public:
   void CreateTextureObject() override;
   void DestroyTextureObject() override;
   void LoadToGPU() override;
+  bool LoadToGPUPartially(size_t maxBytes) override;
   void BindToUnit(unsigned int unit) override;
 
+  GLuint GetTextureObject() const { return m_texture; }
+
 protected:
   GLuint m_texture = 0;
   bool m_isOglVersion3orNewer = false;
+
+private:
+  bool IsUploadMipmapped() const;
+  bool UploadRows(unsigned int maxRows);
+  void UploadSubImage(unsigned int maxRows);
+  bool FinishUpload();
+
+  unsigned int m_uploadedRows = 0; ///< rows of a partial upload that are on the GPU already
+  unsigned int m_uploadPitch = 0;
+  GLint m_uploadRowLength = 0;
+  GLenum m_uploadFormat = 0;
 };
 
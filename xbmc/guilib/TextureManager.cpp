@@ -14,6 +14,9 @@
 #include "filesystem/Directory.h"
 #include "filesystem/File.h"
 #include "windowing/GraphicContext.h"
+#include "GUIComponent.h"
+#include "GUITextureBudget.h"
+#include "ServiceBroker.h"
 #include "Texture.h"
 #include "threads/SingleLock.h"
 #include "threads/SystemClock.h"
@@ -26,11 +29,25 @@
 #include "utils/TimeUtils.h"
 #endif
 #if defined(TARGET_DARWIN_IOS)
-#include "ServiceBroker.h"
 #include "windowing/ios/WinSystemIOS.h" // for g_Windowing in CGUITextureManager::FreeUnusedTextures
 #endif
 #include "FFmpegImage.h"
 
+namespace
+{
+void AddTextureMemory(uint32_t bytes)
+{
+  if (CServiceBroker::GetGUI())
+    CServiceBroker::GetGUI()->GetTextureBudget().Add(CGUITextureBudget::POOL_SKIN, bytes);
+}
+
+void RemoveTextureMemory(uint32_t bytes)
+{
+  if (CServiceBroker::GetGUI())
+    CServiceBroker::GetGUI()->GetTextureBudget().Remove(CGUITextureBudget::POOL_SKIN, bytes);
+}
+}
+
 /************************************************************************/
 /*                                                                      */
 /************************************************************************/
@@ -42,6 +59,8 @@ CTextureArray::CTextureArray(int width, int height, int loops,  bool texCoordsAr
   m_orientation = 0;
   m_texWidth = 0;
   m_texHeight = 0;
+  m_texX = 0;
+  m_texY = 0;
   m_texCoordsArePixels = false;
 }
 
@@ -68,7 +87,10 @@ void CTextureArray::Reset()
   m_orientation = 0;
   m_texWidth = 0;
   m_texHeight = 0;
+  m_texX = 0;
+  m_texY = 0;
   m_texCoordsArePixels = false;
+  m_atlasPage.reset();
 }
 
 void CTextureArray::Add(CBaseTexture *texture, int delay)
@@ -93,12 +115,28 @@ void CTextureArray::Set(CBaseTexture *texture, int width, int height)
   Add(texture, 2);
 }
 
+void CTextureArray::SetAtlas(const std::shared_ptr<CBaseTexture>& page, int x, int y, int width, int height)
+{
+  assert(!m_textures.size());
+  m_width = width;
+  m_height = height;
+  m_orientation = 0;
+  Add(page.get(), 2);
+  m_texX = x;
+  m_texY = y;
+  m_atlasPage = page;
+}
+
 void CTextureArray::Free()
 {
   CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
-  for (unsigned int i = 0; i < m_textures.size(); i++)
+  // a page goes with the last of the textures on it
+  if (!m_atlasPage)
   {
-    delete m_textures[i];
+    for (unsigned int i = 0; i < m_textures.size(); i++)
+    {
+      delete m_textures[i];
+    }
   }
 
   m_textures.clear();
@@ -181,6 +219,8 @@ void CTextureMap::Flush()
 void CTextureMap::FreeTexture()
 {
   m_texture.Free();
+  RemoveTextureMemory(m_memUsage);
+  m_memUsage = 0;
 }
 
 void CTextureMap::SetHeight(int height)
@@ -203,7 +243,20 @@ void CTextureMap::Add(CBaseTexture* texture, int delay)
   m_texture.Add(texture, delay);
 
   if (texture)
-    m_memUsage += sizeof(CTexture) + (texture->GetTextureWidth() * texture->GetTextureHeight() * 4);
+  {
+    const uint32_t memUsage = sizeof(CTexture) + (texture->GetTextureWidth() * texture->GetTextureHeight() * 4);
+    m_memUsage += memUsage;
+    AddTextureMemory(memUsage);
+  }
+}
+
+void CTextureMap::SetAtlas(const std::shared_ptr<CBaseTexture>& page, int x, int y, int width, int height)
+{
+  m_texture.SetAtlas(page, x, y, width, height);
+
+  // the page is shared, only the area of the image is accounted for
+  m_memUsage += width * height * 4;
+  AddTextureMemory(width * height * 4);
 }
 
 /************************************************************************/
@@ -213,10 +266,12 @@ CGUITextureManager::CGUITextureManager(void)
 {
   // we set the theme bundle to be the first bundle (thus prioritizing it)
   m_TexBundle[0].SetThemeBundle(true);
+  CMemoryPressureManager::GetInstance().Register(this, "textures", CMemoryPressureManager::PRIORITY_GUI);
 }
 
 CGUITextureManager::~CGUITextureManager(void)
 {
+  CMemoryPressureManager::GetInstance().Unregister(this);
   Cleanup();
 }
 
@@ -424,6 +479,16 @@ const CTextureArray& CGUITextureManager::Load(const std::string& strTextureName,
   int width = 0, height = 0;
   if (bundle >= 0)
   {
+    std::shared_ptr<CBaseTexture> page;
+    int x = 0, y = 0;
+    if (m_TexBundle[bundle].LoadAtlasTexture(strTextureName, page, x, y, width, height))
+    {
+      CTextureMap* pMap = new CTextureMap(strTextureName, width, height, 0);
+      pMap->SetAtlas(page, x, y, width, height);
+      m_vecTextures.push_back(pMap);
+      return pMap->GetTexture();
+    }
+
     if (!m_TexBundle[bundle].LoadTexture(strTextureName, &pTexture, width, height))
     {
       CLog::Log(LOGERROR, "Texture manager unable to load bundled file: %s", strTextureName.c_str());
@@ -498,6 +563,15 @@ void CGUITextureManager::FreeUnusedTextures(unsigned int timeDelay)
       ++i;
   }
 
+  // over budget, don't wait for the delay. The list is in the order the textures were released in,
+  // so the least recently used ones go first.
+  CGUIComponent *gui = CServiceBroker::GetGUI();
+  while (gui && !m_unusedTextures.empty() && gui->GetTextureBudget().IsExceeded())
+  {
+    delete m_unusedTextures.front().first;
+    m_unusedTextures.pop_front();
+  }
+
 #if defined(HAS_GL) || defined(HAS_GLES)
   for (unsigned int i = 0; i < m_unusedHwTextures.size(); ++i)
   {
@@ -514,6 +588,12 @@ void CGUITextureManager::FreeUnusedTextures(unsigned int timeDelay)
   m_unusedHwTextures.clear();
 }
 
+void CGUITextureManager::OnMemoryPressure(MemoryPressure level)
+{
+  // textures released recently are kept for a while in case they are loaded again, not now
+  FreeUnusedTextures(0);
+}
+
 void CGUITextureManager::ReleaseHwTexture(unsigned int texture)
 {
   CSingleLock lock(CServiceBroker::GetWinSystem()->GetGfxContext());
@@ -11,8 +11,10 @@
 #include "GUIComponent.h"
 #include "TextureBundle.h"
 #include "threads/CriticalSection.h"
+#include "utils/MemoryPressure.h"
 
 #include <list>
+#include <memory>
 #include <utility>
 #include <vector>
 
@@ -31,6 +33,9 @@ public:
 
   void Add(CBaseTexture *texture, int delay);
   void Set(CBaseTexture *texture, int width, int height);
+
+  /*! \brief Use the area of the given size at x, y of an atlas page shared with other textures */
+  void SetAtlas(const std::shared_ptr<CBaseTexture>& page, int x, int y, int width, int height);
   void Free();
   unsigned int size() const;
 
@@ -42,7 +47,10 @@ public:
   int m_loops;
   int m_texWidth;
   int m_texHeight;
+  int m_texX; //!< position of the image within the texture, in pixels
+  int m_texY;
   bool m_texCoordsArePixels;
+  std::shared_ptr<CBaseTexture> m_atlasPage; //!< owns the texture when set, instead of Free()
 };
 
 /*!
@@ -60,6 +68,7 @@ public:
   virtual ~CTextureMap();
 
   void Add(CBaseTexture* texture, int delay);
+  void SetAtlas(const std::shared_ptr<CBaseTexture>& page, int x, int y, int width, int height);
   bool Release();
 
   const std::string& GetName() const;
@@ -86,11 +95,11 @@ protected:
 /************************************************************************/
 /*                                                                      */
 /************************************************************************/
-class CGUITextureManager
+class CGUITextureManager : public IMemoryPressureHandler
 {
 public:
   CGUITextureManager(void);
-  virtual ~CGUITextureManager(void);
+  ~CGUITextureManager(void) override;
 
   bool HasTexture(const std::string &textureName, std::string *path = NULL, int *bundle = NULL, int *size = NULL);
   static bool CanLoad(const std::string &texturePath); ///< Returns true if the texture manager can load this texture
@@ -109,6 +118,8 @@ public:
 
   void FreeUnusedTextures(unsigned int timeDelay = 0); ///< Free textures (called from app thread only)
   void ReleaseHwTexture(unsigned int texture);
+
+  void OnMemoryPressure(MemoryPressure level) override;
 protected:
   std::vector<CTextureMap*> m_vecTextures;
   std::list<std::pair<CTextureMap*, unsigned int> > m_unusedTextures;
@@ -87,6 +87,17 @@ void CPiTexture::LoadToGPU()
   CGLTexture::LoadToGPU();
 }
 
+bool CPiTexture::LoadToGPUPartially(size_t maxBytes)
+{
+  // decoded by the GPU already, there's nothing to spread out
+  if (m_egl_image)
+  {
+    LoadToGPU();
+    return true;
+  }
+  return CGLTexture::LoadToGPUPartially(maxBytes);
+}
+
 void CPiTexture::Update(unsigned int width, unsigned int height, unsigned int pitch, unsigned int format, const unsigned char *pixels, bool loadToGPU)
 {
   if (m_egl_image)
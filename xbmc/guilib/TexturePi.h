@@ -22,6 +22,7 @@ public:
   virtual ~CPiTexture();
   void CreateTextureObject();
   void LoadToGPU();
+  bool LoadToGPUPartially(size_t maxBytes);
   void Update(unsigned int width, unsigned int height, unsigned int pitch, unsigned int format, const unsigned char *pixels, bool loadToGPU);
   void Allocate(unsigned int width, unsigned int height, unsigned int format);
   bool LoadFromFileInternal(const std::string& texturePath, unsigned int maxWidth, unsigned int maxHeight, bool requirePixels, const std::string& strMimeType = "");
@@ -102,6 +102,47 @@ void CXBTFFrame::SetDuration(uint32_t duration)
   m_duration = duration;
 }
 
+void CXBTFFrame::SetAtlas(uint32_t x, uint32_t y, uint32_t pageWidth, uint32_t pageHeight)
+{
+  m_atlasX = x;
+  m_atlasY = y;
+  m_atlasWidth = pageWidth;
+  m_atlasHeight = pageHeight;
+}
+
+bool CXBTFFrame::IsInAtlas() const
+{
+  return m_atlasWidth > 0 && m_atlasHeight > 0;
+}
+
+uint32_t CXBTFFrame::GetAtlasX() const
+{
+  return m_atlasX;
+}
+
+uint32_t CXBTFFrame::GetAtlasY() const
+{
+  return m_atlasY;
+}
+
+uint32_t CXBTFFrame::GetAtlasWidth() const
+{
+  return m_atlasWidth;
+}
+
+uint32_t CXBTFFrame::GetAtlasHeight() const
+{
+  return m_atlasHeight;
+}
+
+uint64_t CXBTFFrame::GetImageSize() const
+{
+  // pages are always stored as ARGB
+  if (IsInAtlas())
+    return static_cast<uint64_t>(m_width) * m_height * 4;
+  return m_unpackedSize;
+}
+
 uint64_t CXBTFFrame::GetHeaderSize() const
 {
   uint64_t result =
@@ -164,7 +205,7 @@ uint64_t CXBTFFile::GetUnpackedSize() const
 {
   uint64_t size = 0;
   for (const auto& frame : m_frames)
-    size += frame.GetUnpackedSize();
+    size += frame.GetImageSize();
 
   return size;
 }
@@ -184,11 +225,15 @@ uint64_t CXBTFFile::GetHeaderSize() const
 
 uint64_t CXBTFBase::GetHeaderSize() const
 {
-  uint64_t result = XBTF_MAGIC.size() + XBTF_VERSION.size() +
+  uint64_t result = XBTF_MAGIC.size() + m_version.size() +
     sizeof(uint32_t) /* number of files */;
 
   for (const auto& file : m_files)
+  {
     result += file.second.GetHeaderSize();
+    if (m_version == XBTF_VERSION_ATLAS)
+      result += file.second.GetFrames().size() * CXBTFFrame::AtlasHeaderSize;
+  }
 
   return result;
 }
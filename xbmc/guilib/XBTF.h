@@ -17,6 +17,7 @@
 
 static const std::string XBTF_MAGIC = "XBTF";
 static const std::string XBTF_VERSION = "2";
+static const std::string XBTF_VERSION_ATLAS = "3"; //!< frames may lie on atlas pages shared with other files
 
 #include "TextureFormats.h"
 
@@ -51,6 +52,24 @@ public:
   bool IsPacked() const;
   bool HasAlpha() const;
 
+  /*!
+   \brief Place the frame on an atlas page.
+   The offset and sizes of the frame then refer to the data of the whole page, which is shared by
+   all frames on it. The frame is the area of its width and height at the given position.
+   */
+  void SetAtlas(uint32_t x, uint32_t y, uint32_t pageWidth, uint32_t pageHeight);
+  bool IsInAtlas() const;
+  uint32_t GetAtlasX() const;
+  uint32_t GetAtlasY() const;
+  uint32_t GetAtlasWidth() const;
+  uint32_t GetAtlasHeight() const;
+
+  //! size of the image data of the frame itself, without the rest of its atlas page
+  uint64_t GetImageSize() const;
+
+  //! size of the atlas fields in the header, they are part of it from XBTF_VERSION_ATLAS on
+  static const uint64_t AtlasHeaderSize = 4 * sizeof(uint32_t);
+
 private:
   uint32_t m_width;
   uint32_t m_height;
@@ -59,6 +78,10 @@ private:
   uint64_t m_unpackedSize;
   uint64_t m_offset;
   uint32_t m_duration;
+  uint32_t m_atlasX = 0;
+  uint32_t m_atlasY = 0;
+  uint32_t m_atlasWidth = 0;
+  uint32_t m_atlasHeight = 0;
 };
 
 class CXBTFFile
@@ -95,6 +118,8 @@ public:
 
   uint64_t GetHeaderSize() const;
 
+  const std::string& GetVersion() const { return m_version; }
+
   bool Exists(const std::string& name) const;
   bool Get(const std::string& name, CXBTFFile& file) const;
   std::vector<CXBTFFile> GetFiles() const;
@@ -105,4 +130,5 @@ protected:
   CXBTFBase() = default;
 
   std::map<std::string, CXBTFFile> m_files;
+  std::string m_version = XBTF_VERSION;
 };
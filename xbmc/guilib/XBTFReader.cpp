@@ -93,7 +93,11 @@ bool CXBTFReader::Open(const std::string& path)
   if (!ReadString(m_file, version, sizeof(version)))
     return false;
 
-  if (strncmp(XBTF_VERSION.c_str(), version, sizeof(version)) != 0)
+  if (strncmp(XBTF_VERSION_ATLAS.c_str(), version, sizeof(version)) == 0)
+    m_version = XBTF_VERSION_ATLAS;
+  else if (strncmp(XBTF_VERSION.c_str(), version, sizeof(version)) == 0)
+    m_version = XBTF_VERSION;
+  else
     return false;
 
   unsigned int nofFiles;
@@ -153,6 +157,17 @@ bool CXBTFReader::Open(const std::string& path)
         return false;
       frame.SetOffset(u64);
 
+      if (m_version == XBTF_VERSION_ATLAS)
+      {
+        uint32_t atlas[4];
+        for (uint32_t& value : atlas)
+        {
+          if (!ReadUInt32(m_file, value))
+            return false;
+        }
+        frame.SetAtlas(atlas[0], atlas[1], atlas[2], atlas[3]);
+      }
+
       xbtfFile.GetFrames().push_back(frame);
     }
 
@@ -182,6 +197,7 @@ void CXBTFReader::Close()
 
   m_path.clear();
   m_files.clear();
+  m_version = XBTF_VERSION;
 }
 
 time_t CXBTFReader::GetLastModificationTimestamp() const
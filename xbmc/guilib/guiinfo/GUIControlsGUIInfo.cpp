@@ -54,6 +54,27 @@ bool CGUIControlsGUIInfo::InitCurrentItem(CFileItem *item)
   return false;
 }
 
+bool CGUIControlsGUIInfo::IsVolatile(const CGUIInfo &info) const
+{
+  // focus, scroll position and labels of controls change while the windows are processed
+  switch (info.m_info)
+  {
+    case CONTAINER_NUM_PAGES:
+    case CONTAINER_CURRENT_PAGE:
+    case CONTAINER_POSITION:
+    case CONTAINER_ROW:
+    case CONTAINER_COLUMN:
+    case CONTAINER_CURRENT_ITEM:
+    case CONTROL_GET_LABEL:
+    case WINDOW_PROPERTY:
+    case SYSTEM_CURRENT_CONTROL:
+    case SYSTEM_CURRENT_CONTROL_ID:
+      return true;
+  }
+
+  return false;
+}
+
 bool CGUIControlsGUIInfo::GetLabel(std::string& value, const CFileItem *item, int contextWindow, const CGUIInfo &info, std::string *fallback) const
 {
   switch (info.m_info)
@@ -10,6 +10,7 @@
 
 #include <stdint.h>
 #include <string>
+#include <tuple>
 
 namespace KODI
 {
@@ -80,6 +81,12 @@ public:
             m_data4 == right.m_data4);
   }
 
+  bool operator <(const CGUIInfo &right) const
+  {
+    return std::tie(m_info, m_data1, m_data2, m_data4, m_data3) <
+           std::tie(right.m_info, right.m_data1, right.m_data2, right.m_data4, right.m_data3);
+  }
+
   uint32_t GetInfoFlag() const;
   uint32_t GetData1() const;
   int GetData2() const { return m_data2; }
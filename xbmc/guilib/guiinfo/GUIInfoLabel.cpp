@@ -49,12 +49,18 @@ const std::string &CGUIInfoLabel::GetLabel(int contextWindow, bool preferImage,
     {
       if (portion.m_info)
       {
+        // skip the lookup while the provider says the value didn't change
+        const unsigned int version = (preferImage || fallback) ? 0 : portion.GetVersion();
+        if (version != 0 && version == portion.m_lastVersion)
+          continue;
+
         std::string infoLabel;
         if (preferImage)
           infoLabel = infoMgr.GetImage(portion.m_info, contextWindow, fallback);
         if (infoLabel.empty())
           infoLabel = infoMgr.GetLabel(portion.m_info, contextWindow, fallback);
         needsUpdate |= portion.NeedsUpdate(infoLabel);
+        portion.m_lastVersion = version;
       }
     }
   }
@@ -80,6 +86,7 @@ const std::string &CGUIInfoLabel::GetItemLabel(const CGUIListItem *item, bool pr
         else
           infoLabel = infoMgr.GetItemLabel(static_cast<const CFileItem *>(item), 0, portion.m_info, fallback);
         needsUpdate |= portion.NeedsUpdate(infoLabel);
+        portion.m_lastVersion = 0;
       }
     }
   }
@@ -291,6 +298,8 @@ CGUIInfoLabel::CInfoPortion::CInfoPortion(int info, const std::string &prefix, c
 {
   m_info = info;
   m_escaped = escaped;
+  if (m_info)
+    m_version = CServiceBroker::GetGUI()->GetInfoManager().GetInfoVersion(m_info);
   // filter our prefix and postfix for comma's
   StringUtils::Replace(m_prefix, "$COMMA", ",");
   StringUtils::Replace(m_postfix, "$COMMA", ",");
@@ -13,6 +13,7 @@
 \brief
 */
 
+#include <atomic>
 #include <functional>
 #include <string>
 #include <vector>
@@ -118,8 +119,12 @@ private:
     CInfoPortion(int info, const std::string &prefix, const std::string &postfix, bool escaped = false);
     bool NeedsUpdate(const std::string &label) const;
     std::string Get() const;
+    /*! \brief version of the info value as published by its provider, 0 if it isn't tracked */
+    unsigned int GetVersion() const { return m_version ? m_version->load() : 0; }
     int m_info;
+    mutable unsigned int m_lastVersion = 0; ///< version of the info value m_label was looked up at
   private:
+    const std::atomic<unsigned int>* m_version = nullptr;
     bool m_escaped;
     mutable std::string m_label;
     std::string m_prefix;
@@ -376,6 +376,9 @@
 #define SYSTEM_USED_MEMORY          647
 #define SYSTEM_FREE_MEMORY          648
 #define SYSTEM_FREE_MEMORY_PERCENT  649
+#define SYSTEM_TEXTURE_MEMORY       650
+#define SYSTEM_TEXTURE_MEMORY_BUDGET 651
+#define SYSTEM_TEXTURE_MEMORY_PERCENT 652
 #define SYSTEM_UPTIME               654
 #define SYSTEM_TOTALUPTIME          655
 #define SYSTEM_CPUFREQUENCY         656
@@ -608,7 +611,8 @@
 #define PVR_TIMESHIFT_PROGRESS_START_TIME (PVR_STRINGS_START + 70)
 #define PVR_TIMESHIFT_PROGRESS_END_TIME   (PVR_STRINGS_START + 71)
 #define PVR_EPG_EVENT_ICON                (PVR_STRINGS_START + 72)
-#define PVR_STRINGS_END                   PVR_EPG_EVENT_ICON
+#define PVR_CHANNEL_ZAP_TIME              (PVR_STRINGS_START + 73)
+#define PVR_STRINGS_END                   PVR_CHANNEL_ZAP_TIME
 
 #define RDS_DATA_START              1400
 #define RDS_HAS_RDS                 (RDS_DATA_START)
@@ -671,6 +675,8 @@
 #define PLAYER_PROCESS_AUDIOCHANNELS (PLAYER_PROCESS + 9)
 #define PLAYER_PROCESS_AUDIOSAMPLERATE (PLAYER_PROCESS + 10)
 #define PLAYER_PROCESS_AUDIOBITSPERSAMPLE (PLAYER_PROCESS + 11)
+#define PLAYER_PROCESS_VIDEOTHREADING (PLAYER_PROCESS + 12)
+#define PLAYER_PROCESS_VIDEOLATENCY (PLAYER_PROCESS + 13)
 
 #define WINDOW_PROPERTY             9993
 #define WINDOW_IS_VISIBLE           9995
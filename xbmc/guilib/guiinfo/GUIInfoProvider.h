@@ -29,6 +29,9 @@ public:
   void UpdateAVInfo(const AudioStreamInfo& audioInfo, const VideoStreamInfo& videoInfo, const SubtitleStreamInfo& subtitleInfo) override
   { m_audioInfo = audioInfo, m_videoInfo = videoInfo, m_subtitleInfo = subtitleInfo; }
 
+  const std::atomic<unsigned int>* GetVersion(const CGUIInfo &info) const override { return nullptr; }
+  bool IsVolatile(const CGUIInfo &info) const override { return false; }
+
 protected:
   VideoStreamInfo m_videoInfo;
   AudioStreamInfo m_audioInfo;
@@ -115,3 +115,24 @@ void CGUIInfoProviders::UpdateAVInfo(const AudioStreamInfo& audioInfo, const Vid
     provider->UpdateAVInfo(audioInfo, videoInfo, subtitleInfo);
   }
 }
+
+const std::atomic<unsigned int>* CGUIInfoProviders::GetVersion(const CGUIInfo &info) const
+{
+  for (const auto& provider : m_providers)
+  {
+    const std::atomic<unsigned int>* version = provider->GetVersion(info);
+    if (version)
+      return version;
+  }
+  return nullptr;
+}
+
+bool CGUIInfoProviders::IsVolatile(const CGUIInfo &info) const
+{
+  for (const auto& provider : m_providers)
+  {
+    if (provider->IsVolatile(info))
+      return true;
+  }
+  return false;
+}
@@ -105,6 +105,20 @@ public:
    */
   void UpdateAVInfo(const AudioStreamInfo& audioInfo, const VideoStreamInfo& videoInfo, const SubtitleStreamInfo& subtitleInfo);
 
+  /*!
+   * @brief Get the version of a GUIInfoManager value from the provider tracking it.
+   * @param info The GUI info (label id + additional data).
+   * @return The version counter, nullptr if none of the providers tracks the value.
+   */
+  const std::atomic<unsigned int>* GetVersion(const CGUIInfo &info) const;
+
+  /*!
+   * @brief Whether any of the providers reports a label as changing while a frame is processed.
+   * @param info The GUI info (label id + additional data).
+   * @return True if the label must not be cached for the frame.
+   */
+  bool IsVolatile(const CGUIInfo &info) const;
+
   /*!
    * @brief Get the player guiinfo provider.
    * @return The player guiinfo provider.
@@ -135,6 +149,12 @@ public:
    */
   CLibraryGUIInfo& GetLibraryInfoProvider() { return m_libraryGUIInfo; }
 
+  /*!
+   * @brief Get the skin guiinfo provider.
+   * @return The skin guiinfo provider.
+   */
+  CSkinGUIInfo& GetSkinInfoProvider() { return m_skinGUIInfo; }
+
 private:
   std::vector<IGUIInfoProvider *> m_providers;
 
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <atomic>
 #include <string>
 
 class CFileItem;
@@ -68,6 +69,20 @@ public:
    */
   virtual bool GetBool(bool& value, const CGUIListItem *item, int contextWindow, const CGUIInfo &info) const = 0;
 
+  /*!
+   * @brief Get the version of a GUIInfoManager value, so callers know when to evaluate it again.
+   * @param info The GUI info (label id + additional data).
+   * @return Counter that changes whenever the value may have changed, nullptr if the provider doesn't track the value.
+   */
+  virtual const std::atomic<unsigned int>* GetVersion(const CGUIInfo &info) const = 0;
+
+  /*!
+   * @brief Whether a GUIInfoManager label may change while a frame is processed, e.g. because controls update it.
+   * @param info The GUI info (label id + additional data).
+   * @return True if the label must be evaluated on every request, false if it may be cached for the frame.
+   */
+  virtual bool IsVolatile(const CGUIInfo &info) const = 0;
+
   /*!
    * @brief Set new audio/video stream info data.
    * @param audioInfo New audio stream info.
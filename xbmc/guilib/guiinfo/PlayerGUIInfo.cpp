@@ -320,6 +320,17 @@ bool CPlayerGUIInfo::GetLabel(std::string& value, const CFileItem *item, int con
     case PLAYER_PROCESS_VIDEOHEIGHT:
       value = StringUtils::FormatNumber(CServiceBroker::GetDataCacheCore().GetVideoHeight());
       return true;
+    case PLAYER_PROCESS_VIDEOTHREADING:
+    {
+      CDataCacheCore& data = CServiceBroker::GetDataCacheCore();
+      value = data.GetVideoDecoderThreadingMode();
+      if (data.GetVideoDecoderThreads() > 0)
+        value += StringUtils::Format("/%d", data.GetVideoDecoderThreads());
+      return true;
+    }
+    case PLAYER_PROCESS_VIDEOLATENCY:
+      value = StringUtils::FormatNumber(CServiceBroker::GetDataCacheCore().GetVideoDecoderLatency());
+      return true;
     case PLAYER_PROCESS_AUDIODECODER:
       value = CServiceBroker::GetDataCacheCore().GetAudioDecoderName();
       return true;
@@ -115,3 +115,16 @@ bool CSkinGUIInfo::GetBool(bool& value, const CGUIListItem *gitem, int contextWi
 
   return false;
 }
+
+const std::atomic<unsigned int>* CSkinGUIInfo::GetVersion(const CGUIInfo &info) const
+{
+  switch (info.m_info)
+  {
+    case SKIN_BOOL:
+    case SKIN_STRING:
+    case SKIN_STRING_IS_EQUAL:
+      return &m_settingsVersion;
+  }
+
+  return nullptr;
+}
@@ -30,6 +30,15 @@ public:
   bool GetLabel(std::string& value, const CFileItem *item, int contextWindow, const CGUIInfo &info, std::string *fallback) const override;
   bool GetInt(int& value, const CGUIListItem *item, int contextWindow, const CGUIInfo &info) const override;
   bool GetBool(bool& value, const CGUIListItem *item, int contextWindow, const CGUIInfo &info) const override;
+  const std::atomic<unsigned int>* GetVersion(const CGUIInfo &info) const override;
+
+  /*!
+   * @brief Called whenever a skin setting changed.
+   */
+  void OnSettingsChanged() { ++m_settingsVersion; }
+
+private:
+  std::atomic<unsigned int> m_settingsVersion{1};
 };
 
 } // namespace GUIINFO
@@ -14,6 +14,7 @@
 #include "addons/BinaryAddonCache.h"
 #include "GUIPassword.h"
 #include "guilib/GUIComponent.h"
+#include "guilib/GUITextureBudget.h"
 #include "guilib/GUIWindowManager.h"
 #include "guilib/LocalizeStrings.h"
 #include "network/Network.h"
@@ -218,6 +219,19 @@ bool CSystemGUIInfo::GetLabel(std::string& value, const CFileItem *item, int con
         value = StringUtils::Format("%uMB", static_cast<unsigned int>(stat.totalPhys / MB));
       return true;
     }
+    case SYSTEM_TEXTURE_MEMORY:
+    case SYSTEM_TEXTURE_MEMORY_BUDGET:
+    case SYSTEM_TEXTURE_MEMORY_PERCENT:
+    {
+      const CGUITextureBudget& budget = CServiceBroker::GetGUI()->GetTextureBudget();
+      if (info.m_info == SYSTEM_TEXTURE_MEMORY)
+        value = StringUtils::Format("%uMB", static_cast<unsigned int>(budget.GetUsage() / MB));
+      else if (info.m_info == SYSTEM_TEXTURE_MEMORY_BUDGET)
+        value = StringUtils::Format("%uMB", static_cast<unsigned int>(budget.GetBudget() / MB));
+      else
+        value = StringUtils::Format("%i%%", static_cast<int>(100.0f * budget.GetUsage() / budget.GetBudget() + 0.5f));
+      return true;
+    }
     case SYSTEM_SCREEN_MODE:
       value = CServiceBroker::GetWinSystem()->GetGfxContext().GetResInfo().strMode;
       return true;
@@ -391,6 +405,12 @@ bool CSystemGUIInfo::GetInt(int& value, const CGUIListItem *gitem, int contextWi
         value = memPercentUsed;
       return true;
     }
+    case SYSTEM_TEXTURE_MEMORY:
+    {
+      const CGUITextureBudget& budget = CServiceBroker::GetGUI()->GetTextureBudget();
+      value = static_cast<int>(100.0f * budget.GetUsage() / budget.GetBudget() + 0.5f);
+      return true;
+    }
     case SYSTEM_FREE_SPACE:
     case SYSTEM_USED_SPACE:
     {
@@ -640,3 +660,26 @@ bool CSystemGUIInfo::GetBool(bool& value, const CGUIListItem *gitem, int context
 
   return false;
 }
+
+const std::atomic<unsigned int>* CSystemGUIInfo::GetVersion(const CGUIInfo &info) const
+{
+  switch (info.m_info)
+  {
+    case SYSTEM_ALWAYS_TRUE:
+    case SYSTEM_ALWAYS_FALSE:
+    case SYSTEM_BUILD_VERSION_SHORT:
+    case SYSTEM_BUILD_VERSION:
+    case SYSTEM_BUILD_DATE:
+    case SYSTEM_PLATFORM_LINUX:
+    case SYSTEM_PLATFORM_WINDOWS:
+    case SYSTEM_PLATFORM_UWP:
+    case SYSTEM_PLATFORM_DARWIN:
+    case SYSTEM_PLATFORM_DARWIN_OSX:
+    case SYSTEM_PLATFORM_DARWIN_IOS:
+    case SYSTEM_PLATFORM_ANDROID:
+    case SYSTEM_PLATFORM_LINUX_RASPBERRY_PI:
+      return &m_constantVersion;
+  }
+
+  return nullptr;
+}
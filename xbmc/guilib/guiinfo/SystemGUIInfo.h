@@ -31,6 +31,12 @@ public:
   bool GetLabel(std::string& value, const CFileItem *item, int contextWindow, const CGUIInfo &info, std::string *fallback) const override;
   bool GetInt(int& value, const CGUIListItem *item, int contextWindow, const CGUIInfo &info) const override;
   bool GetBool(bool& value, const CGUIListItem *item, int contextWindow, const CGUIInfo &info) const override;
+  const std::atomic<unsigned int>* GetVersion(const CGUIInfo &info) const override;
+
+  /*!
+   * @brief Whether a value never changes while running, e.g. the platform conditions.
+   */
+  bool IsConstant(const CGUIInfo &info) const { return GetVersion(info) == &m_constantVersion; }
 
   float GetFPS() const { return m_fps; };
   void UpdateFPS();
@@ -48,6 +54,7 @@ private:
   float m_fps = 0.0;
   unsigned int m_frameCounter = 0;
   unsigned int m_lastFPSTime = 0;
+  std::atomic<unsigned int> m_constantVersion{1}; //!< for the values that never change while running
 };
 
 } // namespace GUIINFO
@@ -169,8 +169,8 @@ bool CInputManager::ProcessEventServer(int windowId, float frameTime)
   if (!es || !es->Running() || es->GetNumberOfClients() == 0)
     return false;
 
-  // process any queued up actions
-  if (es->ExecuteNextAction())
+  // process all queued up actions
+  if (es->ExecuteActions())
   {
     // reset idle timers
     g_application.ResetSystemIdleTimer();
@@ -184,7 +184,7 @@ bool CInputManager::ProcessEventServer(int windowId, float frameTime)
   float fAmount = 0.0;
   bool isJoystick = false;
 
-  // es->ExecuteNextAction() invalidates the ref to the CEventServer instance
+  // es->ExecuteActions() invalidates the ref to the CEventServer instance
   // when the action exits XBMC
   es = CEventServer::GetInstance();
   if (!es || !es->Running() || es->GetNumberOfClients() == 0)
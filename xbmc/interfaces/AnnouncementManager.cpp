@@ -19,12 +19,111 @@
 #include "utils/log.h"
 #include "video/VideoDatabase.h"
 
+#include <algorithm>
+#include <deque>
 #include <stdio.h>
 
 #define LOOKUP_PROPERTY "database-lookup"
 
 using namespace ANNOUNCEMENT;
 
+class CAnnouncementManager::CSubscriber : public CThread
+{
+public:
+  struct Announcement
+  {
+    AnnouncementFlag flag;
+    std::string sender;
+    std::string message;
+    CVariant data;
+  };
+
+  explicit CSubscriber(IAnnouncer *announcer)
+    : CThread("Announcer"), m_announcer(announcer)
+  {
+    Create();
+  }
+
+  ~CSubscriber() override
+  {
+    Stop(true);
+  }
+
+  IAnnouncer* GetAnnouncer() const { return m_announcer; }
+
+  void Push(const std::shared_ptr<const Announcement> &announcement)
+  {
+    CSingleLock lock(m_section);
+
+    if (m_announcer->IsCoalescable(announcement->flag, announcement->message))
+    {
+      auto it = std::find_if(m_queue.begin(), m_queue.end(),
+                             [&announcement](const std::shared_ptr<const Announcement> &queued)
+                             {
+                               return queued->flag == announcement->flag &&
+                                      queued->sender == announcement->sender &&
+                                      queued->message == announcement->message;
+                             });
+      if (it != m_queue.end())
+        m_queue.erase(it);
+    }
+
+    size_t maxQueued = std::max<size_t>(m_announcer->GetMaxQueuedAnnouncements(), 1);
+    while (m_queue.size() >= maxQueued)
+    {
+      CLog::Log(LOGDEBUG, "CAnnouncementManager - Announcer queue full, dropping %s from %s",
+                m_queue.front()->message.c_str(), m_queue.front()->sender.c_str());
+      m_queue.pop_front();
+    }
+
+    m_queue.push_back(announcement);
+    m_queueEvent.Set();
+  }
+
+  /*!
+   \brief Stop calling the announcer. Unless called from within the announcer,
+   it isn't running anymore when this returns.
+   */
+  void Stop(bool wait)
+  {
+    m_bStop = true;
+    m_queueEvent.Set();
+    StopThread(wait && !IsCurrentThread());
+  }
+
+protected:
+  void Process() override
+  {
+    while (!m_bStop)
+    {
+      std::shared_ptr<const Announcement> announcement;
+      {
+        CSingleLock lock(m_section);
+        if (!m_queue.empty())
+        {
+          announcement = m_queue.front();
+          m_queue.pop_front();
+        }
+      }
+
+      if (!announcement)
+      {
+        AbortableWait(m_queueEvent);
+        continue;
+      }
+
+      m_announcer->Announce(announcement->flag, announcement->sender.c_str(),
+                            announcement->message.c_str(), announcement->data);
+    }
+  }
+
+private:
+  IAnnouncer *m_announcer;
+  CCriticalSection m_section;
+  CEvent m_queueEvent;
+  std::deque<std::shared_ptr<const Announcement>> m_queue;
+};
+
 CAnnouncementManager::CAnnouncementManager() : CThread("Announce")
 {
 }
@@ -46,6 +145,7 @@ void CAnnouncementManager::Deinitialize()
   StopThread();
   CSingleLock lock (m_announcersCritSection);
   m_announcers.clear();
+  m_removed.clear();
 }
 
 void CAnnouncementManager::AddAnnouncer(IAnnouncer *listener)
@@ -54,7 +154,7 @@ void CAnnouncementManager::AddAnnouncer(IAnnouncer *listener)
     return;
 
   CSingleLock lock (m_announcersCritSection);
-  m_announcers.push_back(listener);
+  m_announcers.emplace_back(new CSubscriber(listener));
 }
 
 void CAnnouncementManager::RemoveAnnouncer(IAnnouncer *listener)
@@ -62,15 +162,29 @@ void CAnnouncementManager::RemoveAnnouncer(IAnnouncer *listener)
   if (!listener)
     return;
 
-  CSingleLock lock (m_announcersCritSection);
-  for (unsigned int i = 0; i < m_announcers.size(); i++)
+  std::unique_ptr<CSubscriber> subscriber;
   {
-    if (m_announcers[i] == listener)
-    {
-      m_announcers.erase(m_announcers.begin() + i);
+    CSingleLock lock (m_announcersCritSection);
+    auto it = std::find_if(m_announcers.begin(), m_announcers.end(),
+                           [listener](const std::unique_ptr<CSubscriber> &announcer)
+                           {
+                             return announcer->GetAnnouncer() == listener;
+                           });
+    if (it == m_announcers.end())
       return;
-    }
+    subscriber = std::move(*it);
+    m_announcers.erase(it);
+  }
+
+  // an announcer may remove itself while it's called, its thread can't wait for itself
+  if (subscriber->IsCurrentThread())
+  {
+    subscriber->Stop(false);
+    CSingleLock lock (m_announcersCritSection);
+    m_removed.push_back(std::move(subscriber));
   }
+  else
+    subscriber->Stop(true);
 }
 
 void CAnnouncementManager::Announce(AnnouncementFlag flag, const char *sender, const char *message)
@@ -103,34 +217,41 @@ void CAnnouncementManager::Announce(AnnouncementFlag flag, const char *sender, c
 
   {
     CSingleLock lock (m_queueCritSection);
-    m_announcementQueue.push_back(announcement);
+    m_announcementQueue.push_back(std::move(announcement));
+    m_announcementCounts[flag]++;
   }
   m_queueEvent.Set();
 }
 
-void CAnnouncementManager::DoAnnounce(AnnouncementFlag flag, const char *sender, const char *message, const CVariant &data)
+unsigned int CAnnouncementManager::GetAnnouncementCount(AnnouncementFlag flag)
 {
-  CLog::Log(LOGDEBUG, "CAnnouncementManager - Announcement: %s from %s", message, sender);
+  CSingleLock lock (m_queueCritSection);
+  auto it = m_announcementCounts.find(flag);
+  return it != m_announcementCounts.end() ? it->second : 0;
+}
 
-  CSingleLock lock(m_announcersCritSection);
+void CAnnouncementManager::DoAnnounce(AnnouncementFlag flag, const char *sender, const char *message, CVariant &&data)
+{
+  CLog::Log(LOGDEBUG, "CAnnouncementManager - Announcement: %s from %s", message, sender);
 
-  // Make a copy of announcers. They may be removed or even remove themselves during execution of IAnnouncer::Announce()!
+  // one copy shared by all announcers, each gets it on its own thread
+  std::shared_ptr<CSubscriber::Announcement> announcement(new CSubscriber::Announcement{flag, sender, message, std::move(data)});
 
-  std::vector<IAnnouncer *> announcers(m_announcers);
-  for (unsigned int i = 0; i < announcers.size(); i++)
-    announcers[i]->Announce(flag, sender, message, data);
+  CSingleLock lock(m_announcersCritSection);
+  for (const auto &announcer : m_announcers)
+    announcer->Push(announcement);
 }
 
-void CAnnouncementManager::DoAnnounce(AnnouncementFlag flag, const char *sender, const char *message, CFileItemPtr item, const CVariant &data)
+void CAnnouncementManager::DoAnnounce(AnnouncementFlag flag, const char *sender, const char *message, CFileItemPtr item, CVariant &&data)
 {
   if (item == nullptr)
   {
-    DoAnnounce(flag, sender, message, data);
+    DoAnnounce(flag, sender, message, std::move(data));
     return;
   }
 
   // Extract db id of item
-  CVariant object = data.isNull() || data.isObject() ? data : CVariant::VariantTypeObject;
+  CVariant object = data.isNull() || data.isObject() ? std::move(data) : CVariant::VariantTypeObject;
   std::string type;
   int id = 0;
 
@@ -143,7 +264,7 @@ void CAnnouncementManager::DoAnnounce(AnnouncementFlag flag, const char *sender,
     object["item"]["title"] = channel->ChannelName();
     object["item"]["channeltype"] = channel->IsRadio() ? "radio" : "tv";
 
-    if (data.isMember("player") && data["player"].isMember("playerid"))
+    if (object.isMember("player") && object["player"].isMember("playerid"))
       object["player"]["playerid"] = channel->IsRadio() ? PLAYLIST_MUSIC : PLAYLIST_VIDEO;
   }
   else if (item->HasVideoInfoTag() && !item->HasPVRRecordingInfoTag())
@@ -265,7 +386,7 @@ void CAnnouncementManager::DoAnnounce(AnnouncementFlag flag, const char *sender,
   if (id > 0)
     object["item"]["id"] = id;
 
-  DoAnnounce(flag, sender, message, object);
+  DoAnnounce(flag, sender, message, std::move(object));
 }
 
 void CAnnouncementManager::Process()
@@ -277,11 +398,11 @@ void CAnnouncementManager::Process()
     CSingleLock lock (m_queueCritSection);
     if (!m_announcementQueue.empty())
     {
-      auto announcement = m_announcementQueue.front();
+      auto announcement = std::move(m_announcementQueue.front());
       m_announcementQueue.pop_front();
       {
         CSingleExit ex(m_queueCritSection);
-        DoAnnounce(announcement.flag, announcement.sender.c_str(), announcement.message.c_str(), announcement.item, announcement.data);
+        DoAnnounce(announcement.flag, announcement.sender.c_str(), announcement.message.c_str(), announcement.item, std::move(announcement.data));
       }
     }
     else
@@ -16,6 +16,8 @@
 #include "utils/Variant.h"
 
 #include <list>
+#include <map>
+#include <memory>
 #include <vector>
 
 class CVariant;
@@ -41,10 +43,17 @@ namespace ANNOUNCEMENT
     void Announce(AnnouncementFlag flag, const char *sender, const char *message,
         const std::shared_ptr<const CFileItem>& item, const CVariant &data);
 
+    /*!
+     \brief Number of announcements made with the given flag so far
+     Counted when announced rather than when delivered, so caches of library contents can tell
+     they are outdated before any announcer got the news.
+     */
+    unsigned int GetAnnouncementCount(AnnouncementFlag flag);
+
   protected:
     void Process() override;
-    void DoAnnounce(AnnouncementFlag flag, const char *sender, const char *message, CFileItemPtr item, const CVariant &data);
-    void DoAnnounce(AnnouncementFlag flag, const char *sender, const char *message, const CVariant &data);
+    void DoAnnounce(AnnouncementFlag flag, const char *sender, const char *message, CFileItemPtr item, CVariant &&data);
+    void DoAnnounce(AnnouncementFlag flag, const char *sender, const char *message, CVariant &&data);
 
     struct CAnnounceData
     {
@@ -55,14 +64,19 @@ namespace ANNOUNCEMENT
       CVariant data;
     };
     std::list<CAnnounceData> m_announcementQueue;
+    std::map<AnnouncementFlag, unsigned int> m_announcementCounts;
     CEvent m_queueEvent;
 
   private:
     CAnnouncementManager(const CAnnouncementManager&) = delete;
     CAnnouncementManager const& operator=(CAnnouncementManager const&) = delete;
 
+    // queue and thread of a single announcer
+    class CSubscriber;
+
     CCriticalSection m_announcersCritSection;
     CCriticalSection m_queueCritSection;
-    std::vector<IAnnouncer *> m_announcers;
+    std::vector<std::unique_ptr<CSubscriber>> m_announcers;
+    std::vector<std::unique_ptr<CSubscriber>> m_removed; // removed from within their own thread
   };
 }
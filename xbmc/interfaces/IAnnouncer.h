@@ -8,6 +8,9 @@
 
 #pragma once
 
+#include <stddef.h>
+#include <string>
+
 class CVariant;
 namespace ANNOUNCEMENT
 {
@@ -71,5 +74,22 @@ namespace ANNOUNCEMENT
     IAnnouncer() = default;
     virtual ~IAnnouncer() = default;
     virtual void Announce(AnnouncementFlag flag, const char *sender, const char *message, const CVariant &data) = 0;
+
+    /*!
+     \brief Maximum number of announcements waiting for this announcer.
+     Every announcer is called from its own thread, so a slow one doesn't hold
+     up the others. Once its queue is full, the oldest announcements are dropped.
+     */
+    virtual size_t GetMaxQueuedAnnouncements() const { return 256; }
+
+    /*!
+     \brief Whether a newer announcement makes a still queued one with the same
+     flag, sender and message obsolete, e.g. a series of seeks.
+     */
+    virtual bool IsCoalescable(AnnouncementFlag flag, const std::string &message) const
+    {
+      return (flag == Player && message == "OnSeek") ||
+             (flag == Application && message == "OnVolumeChanged");
+    }
   };
 }
@@ -20,6 +20,7 @@
 #include "utils/FileOperationJob.h"
 #include "utils/JSONVariantParser.h"
 #include "utils/StringUtils.h"
+#include "utils/Tracer.h"
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
@@ -120,6 +121,25 @@ static int ToggleDebug(const std::vector<std::string>& params)
   return 0;
 }
 
+/*! \brief Control the tracer.
+ *  \param params The parameters.
+ *  \details params[0] = "start", "stop" or "save".
+ *           params[1] = The file to save to (optional).
+ */
+static int Trace(const std::vector<std::string>& params)
+{
+  if (StringUtils::EqualsNoCase(params[0], "start"))
+    CTracer::Start();
+  else if (StringUtils::EqualsNoCase(params[0], "stop"))
+    CTracer::Stop();
+  else if (StringUtils::EqualsNoCase(params[0], "save"))
+    CTracer::Save(params.size() > 1 ? params[1] : CTracer::DEFAULT_FILE);
+  else
+    CLog::Log(LOGERROR, "Trace called with unknown action %s", params[0].c_str());
+
+  return 0;
+}
+
 /*! \brief Toggle DPMS state.
  *  \param params (ignored)
  */
@@ -182,6 +202,16 @@ static int WakeOnLAN(const std::vector<std::string>& params)
 ///     @param[in] showvolumebar         Add "showVolumeBar" to show volume bar (optional).
 ///   }
 ///   \table_row2_l{
+///     <b>`Trace(action[\,file])`</b>
+///     ,
+///     Records a timeline of player\, GUI and job threads.
+///     @param[in] action                "start" drops the spans recorded so far and
+///                                      starts recording\, "stop" stops it and "save"
+///                                      writes the spans as Chrome trace.
+///     @param[in] file                  File to save to (optional).
+///             @note Defaults to special://temp/kodi.trace.json
+///   }
+///   \table_row2_l{
 ///     <b>`ToggleDebug`</b>
 ///     ,
 ///     Toggles debug mode on/off
@@ -208,6 +238,7 @@ CBuiltins::CommandMap CApplicationBuiltins::GetOperations() const
            {"mute", {"Mute the player", 0, Mute}},
            {"notifyall", {"Notify all connected clients", 2, NotifyAll}},
            {"setvolume", {"Set the current volume", 1, SetVolume}},
+           {"trace", {"Controls the tracer", 1, Trace}},
            {"toggledebug", {"Enables/disables debug mode", 0, ToggleDebug}},
            {"toggledpms", {"Toggle DPMS mode manually", 0, ToggleDPMS}},
            {"wakeonlan", {"Sends the wake-up packet to the broadcast address for the specified MAC address", 1, WakeOnLAN}}
@@ -14,6 +14,8 @@
 #include "ServiceBroker.h"
 #include "dialogs/GUIDialogFileBrowser.h"
 #include "dialogs/GUIDialogYesNo.h"
+#include "games/GameLibraryScanner.h"
+#include "games/GameServices.h"
 #include "guilib/GUIComponent.h"
 #include "guilib/GUIWindowManager.h"
 #include "guilib/LocalizeStrings.h"
@@ -244,7 +246,7 @@ static int ExportLibrary2(const std::vector<std::string>& params)
 
 /*! \brief Update a library.
  *  \param params The parameters.
- *  \details params[0] = "video" or "music".
+ *  \details params[0] = "video", "music" or "games".
  *           params[1] = "true" to suppress dialogs (optional).
  */
 static int UpdateLibrary(const std::vector<std::string>& params)
@@ -266,6 +268,14 @@ static int UpdateLibrary(const std::vector<std::string>& params)
     else
       g_application.StartVideoScan(params.size() > 1 ? params[1] : "", userInitiated);
   }
+  else if (StringUtils::EqualsNoCase(params[0], "games"))
+  {
+    KODI::GAME::CGameLibraryScanner &scanner = CServiceBroker::GetGameServices().GameLibraryScanner();
+    if (scanner.IsScanning())
+      scanner.Stop();
+    else
+      scanner.Start(params.size() > 1 ? params[1] : "");
+  }
 
   return 0;
 }
@@ -329,8 +339,8 @@ static int SearchVideoLibrary(const std::vector<std::string>& params)
 ///   \table_row2_l{
 ///     <b>`updatelibrary([type\, suppressDialogs])`</b>
 ///     ,
-///     Update the selected library (music or video)
-///     @param[in] type                  "video" or "music".
+///     Update the selected library (music\, video or games)
+///     @param[in] type                  "video"\, "music" or "games".
 ///     @param[in] suppressDialogs       Add "true" to suppress dialogs (optional).
 ///   }
 ///   \table_row2_l{
@@ -347,7 +357,7 @@ CBuiltins::CommandMap CLibraryBuiltins::GetOperations() const
           {"cleanlibrary",        {"Clean the video/music library", 1, CleanLibrary}},
           {"exportlibrary",       {"Export the video/music library", 1, ExportLibrary}},
           {"exportlibrary2",      {"Export the video/music library", 1, ExportLibrary2}},
-          {"updatelibrary",       {"Update the selected library (music or video)", 1, UpdateLibrary}},
+          {"updatelibrary",       {"Update the selected library (music, video or games)", 1, UpdateLibrary}},
           {"videolibrary.search", {"Brings up a search dialog which will search the library", 0, SearchVideoLibrary}}
          };
 }
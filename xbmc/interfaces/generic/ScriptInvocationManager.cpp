@@ -17,6 +17,7 @@
 #include "interfaces/generic/ILanguageInvoker.h"
 #include "interfaces/generic/LanguageInvokerThread.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/log.h"
@@ -27,6 +28,11 @@
 
 using namespace XFILE;
 
+// warm interpreters kept at most, each holds the modules its script imported
+#define REUSABLE_INVOKERS_MAX 4
+// idle warm interpreters are released after this time
+#define REUSABLE_INVOKER_IDLE_MS (10 * 60 * 1000)
+
 CScriptInvocationManager::~CScriptInvocationManager()
 {
   Uninitialize();
@@ -58,6 +64,8 @@ void CScriptInvocationManager::Process()
   for (const auto& it : tempList)
     m_scriptPaths.erase(it.script);
 
+  releaseIdleInvokerThreads();
+
   // we can leave the lock now
   lock.Leave();
 
@@ -77,8 +85,8 @@ void CScriptInvocationManager::Uninitialize()
   // execute Process() once more to handle the remaining scripts
   Process();
 
-  // it is safe to relese early, thread must be in m_scripts too
-  m_lastInvokerThread = nullptr;
+  // it is safe to relese early, threads must be in m_scripts too
+  m_reusableThreads.clear();
 
   // make sure all scripts are done
   std::vector<LanguageInvokerThread> tempList;
@@ -184,13 +192,9 @@ int CScriptInvocationManager::GetReusablePluginHandle(const std::string &script)
 {
   CSingleLock lock(m_critSection);
 
-  if (m_lastInvokerThread)
-  {
-    if (m_lastInvokerThread->Reuseable(script))
-      return m_lastPluginHandle;
-    m_lastInvokerThread->Release();
-    m_lastInvokerThread = nullptr;
-  }
+  auto reusable = m_reusableThreads.find(script);
+  if (reusable != m_reusableThreads.end() && reusable->second.thread->Reuseable(script))
+    return reusable->second.pluginHandle;
   return -1;
 }
 
@@ -198,16 +202,12 @@ LanguageInvokerPtr CScriptInvocationManager::GetLanguageInvoker(const std::strin
 {
   CSingleLock lock(m_critSection);
 
-  if (m_lastInvokerThread)
+  auto reusable = m_reusableThreads.find(script);
+  if (reusable != m_reusableThreads.end() && reusable->second.thread->Reuseable(script))
   {
-    if (m_lastInvokerThread->Reuseable(script))
-    {
-      CLog::Log(LOGDEBUG, "%s - Reusing LanguageInvokerThread %d for script %s", __FUNCTION__, m_lastInvokerThread->GetId(), script.c_str());
-      m_lastInvokerThread->GetInvoker()->Reset();
-      return m_lastInvokerThread->GetInvoker();
-    }
-    m_lastInvokerThread->Release();
-    m_lastInvokerThread = nullptr;
+    CLog::Log(LOGDEBUG, "%s - Reusing LanguageInvokerThread %d for script %s", __FUNCTION__, reusable->second.thread->GetId(), script.c_str());
+    reusable->second.thread->GetInvoker()->Reset();
+    return reusable->second.thread->GetInvoker();
   }
 
   std::string extension = URIUtils::GetExtension(script);
@@ -257,40 +257,97 @@ int CScriptInvocationManager::ExecuteAsync(const std::string &script,
 
   CSingleLock lock(m_critSection);
 
-  if (m_lastInvokerThread && m_lastInvokerThread->GetInvoker() == languageInvoker)
+  auto reusable = m_reusableThreads.find(script);
+  if (reusable != m_reusableThreads.end() && reusable->second.thread->GetInvoker() == languageInvoker)
   {
     if (addon != NULL)
-      m_lastInvokerThread->SetAddon(addon);
+      reusable->second.thread->SetAddon(addon);
+    reusable->second.lastUsed = XbmcThreads::SystemClockMillis();
 
-    // After we leave the lock, m_lastInvokerThread can be released -> copy!
-    CLanguageInvokerThreadPtr invokerThread = m_lastInvokerThread;
+    // After we leave the lock, the thread can be released -> copy!
+    CLanguageInvokerThreadPtr invokerThread = reusable->second.thread;
     lock.Leave();
     invokerThread->Execute(script, arguments);
 
     return invokerThread->GetId();
   }
 
-  m_lastInvokerThread = CLanguageInvokerThreadPtr(new CLanguageInvokerThread(languageInvoker, this, reuseable));
-  if (m_lastInvokerThread == NULL)
-    return -1;
+  // a thread only waits for its next run if it's kept for reuse
+  bool keep = reuseable && makeRoomForReusableInvokerThread(script);
+  CLanguageInvokerThreadPtr invokerThread(new CLanguageInvokerThread(languageInvoker, this, keep));
 
   if (addon != NULL)
-    m_lastInvokerThread->SetAddon(addon);
+    invokerThread->SetAddon(addon);
+
+  invokerThread->SetId(m_nextId++);
 
-  m_lastInvokerThread->SetId(m_nextId++);
-  m_lastPluginHandle = pluginHandle;
+  if (keep)
+  {
+    ReusableInvokerThread reusableThread = { invokerThread, pluginHandle, XbmcThreads::SystemClockMillis() };
+    m_reusableThreads.insert(std::make_pair(script, reusableThread));
+  }
 
-  LanguageInvokerThread thread = { m_lastInvokerThread, script, false };
-  m_scripts.insert(std::make_pair(m_lastInvokerThread->GetId(), thread));
-  m_scriptPaths.insert(std::make_pair(script, m_lastInvokerThread->GetId()));
-  // After we leave the lock, m_lastInvokerThread can be released -> copy!
-  CLanguageInvokerThreadPtr invokerThread = m_lastInvokerThread;
+  LanguageInvokerThread thread = { invokerThread, script, false };
+  m_scripts.insert(std::make_pair(invokerThread->GetId(), thread));
+  m_scriptPaths.insert(std::make_pair(script, invokerThread->GetId()));
   lock.Leave();
   invokerThread->Execute(script, arguments);
 
   return invokerThread->GetId();
 }
 
+bool CScriptInvocationManager::makeRoomForReusableInvokerThread(const std::string &script)
+{
+  auto reusable = m_reusableThreads.find(script);
+  if (reusable != m_reusableThreads.end())
+  {
+    // the warm one is still busy, the script runs in a fresh interpreter meanwhile
+    if (reusable->second.thread->GetState() < InvokerStateScriptDone)
+      return false;
+
+    reusable->second.thread->Release();
+    m_reusableThreads.erase(reusable);
+  }
+
+  if (m_reusableThreads.size() >= REUSABLE_INVOKERS_MAX)
+  {
+    // make room by releasing the least recently used idle interpreter
+    auto oldest = m_reusableThreads.end();
+    for (auto it = m_reusableThreads.begin(); it != m_reusableThreads.end(); ++it)
+    {
+      if (it->second.thread->Reuseable(it->first) &&
+          (oldest == m_reusableThreads.end() || it->second.lastUsed < oldest->second.lastUsed))
+        oldest = it;
+    }
+    if (oldest == m_reusableThreads.end())
+      return false;
+
+    CLog::Log(LOGDEBUG, "%s - Releasing LanguageInvokerThread %d of script %s", __FUNCTION__, oldest->second.thread->GetId(), oldest->first.c_str());
+    oldest->second.thread->Release();
+    m_reusableThreads.erase(oldest);
+  }
+
+  return true;
+}
+
+void CScriptInvocationManager::releaseIdleInvokerThreads()
+{
+  unsigned int now = XbmcThreads::SystemClockMillis();
+  for (auto it = m_reusableThreads.begin(); it != m_reusableThreads.end();)
+  {
+    const CLanguageInvokerThreadPtr& thread = it->second.thread;
+    bool failed = thread->GetState() > InvokerStateScriptDone;
+    bool idle = thread->Reuseable(it->first) && now - it->second.lastUsed > REUSABLE_INVOKER_IDLE_MS;
+    if (failed || idle)
+    {
+      thread->Release();
+      it = m_reusableThreads.erase(it);
+    }
+    else
+      ++it;
+  }
+}
+
 int CScriptInvocationManager::ExecuteSync(const std::string &script,
   const ADDON::AddonPtr &addon /* = ADDON::AddonPtr() */,
   const std::vector<std::string> &arguments /* = std::vector<std::string>() */,
@@ -389,6 +446,16 @@ bool CScriptInvocationManager::IsRunning(const std::string& scriptPath) const
   return IsRunning(it->second);
 }
 
+InvokerState CScriptInvocationManager::GetState(int scriptId) const
+{
+  CSingleLock lock(m_critSection);
+  LanguageInvokerThread invokerThread = getInvokerThread(scriptId);
+  if (invokerThread.thread == NULL)
+    return InvokerStateFailed;
+
+  return invokerThread.thread->GetState();
+}
+
 void CScriptInvocationManager::OnExecutionDone(int scriptId)
 {
   if (scriptId < 0)
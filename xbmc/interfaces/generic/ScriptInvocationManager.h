@@ -35,7 +35,11 @@ public:
   LanguageInvokerPtr GetLanguageInvoker(const std::string &script);
 
   /*!
-  * \brief Returns addon_handle if last reusable invoker is ready to use.
+  * \brief Returns addon_handle if a reusable invoker of the script is ready to use.
+  *
+  * \details Invokers of scripts that opt in to reuse are kept warm after they
+  * finished, one per script. The least recently used one is released when
+  * there are too many, idle ones are released after a while.
   */
   int GetReusablePluginHandle(const std::string &script);
 
@@ -118,6 +122,12 @@ public:
   bool IsRunning(int scriptId) const;
   bool IsRunning(const std::string& scriptPath) const;
 
+  /*!
+  * \brief Returns the state of the invoker running the given script,
+  * InvokerStateFailed if there is none.
+  */
+  InvokerState GetState(int scriptId) const;
+
 protected:
   friend class CLanguageInvokerThread;
 
@@ -137,12 +147,20 @@ private:
   typedef std::map<int, LanguageInvokerThread> LanguageInvokerThreadMap;
   typedef std::map<std::string, ILanguageInvocationHandler*> LanguageInvocationHandlerMap;
 
+  struct ReusableInvokerThread
+  {
+    CLanguageInvokerThreadPtr thread;
+    int pluginHandle;
+    unsigned int lastUsed;
+  };
+
   LanguageInvokerThread getInvokerThread(int scriptId) const;
+  bool makeRoomForReusableInvokerThread(const std::string &script);
+  void releaseIdleInvokerThreads();
 
   LanguageInvocationHandlerMap m_invocationHandlers;
   LanguageInvokerThreadMap m_scripts;
-  CLanguageInvokerThreadPtr m_lastInvokerThread;
-  int m_lastPluginHandle;
+  std::map<std::string, ReusableInvokerThread> m_reusableThreads;
 
   std::map<std::string, int> m_scriptPaths;
   int m_nextId = 0;
@@ -12,7 +12,7 @@
 
 namespace INFO
 {
-  InfoBool::InfoBool(const std::string &expression, int context, unsigned int &refreshCounter)
+  InfoBool::InfoBool(const std::string &expression, int context, std::atomic<unsigned int> &refreshCounter)
     : m_value(false),
       m_context(context),
       m_listItemDependent(false),
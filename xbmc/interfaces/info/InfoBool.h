@@ -8,6 +8,10 @@
 
 #pragma once
 
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+
+#include <atomic>
 #include <memory>
 #include <string>
 
@@ -22,27 +26,45 @@ namespace INFO
 class InfoBool
 {
 public:
-  InfoBool(const std::string &expression, int context, unsigned int &refreshCounter);
+  InfoBool(const std::string &expression, int context, std::atomic<unsigned int> &refreshCounter);
   virtual ~InfoBool() = default;
 
   virtual void Initialize() {};
 
   /*! \brief Get the value of this info bool
-   This is called to update (if dirty) and fetch the value of the info bool
+   This is called to update (if dirty) and fetch the value of the info bool. Safe to call from
+   any thread, the cached value is only evaluated once per refresh.
    \param item the item used to evaluate the bool
    */
   inline bool Get(const CGUIListItem *item = NULL)
   {
     if (item && m_listItemDependent)
+    {
+      CSingleLock lock(m_section);
       Update(item);
-    else if (m_refreshCounter != m_parentRefreshCounter || m_refreshCounter == 0)
+      return m_value;
+    }
+
+    const unsigned int version = GetVersion();
+    if (m_refreshCounter != version || version == 0)
     {
-      Update(NULL);
-      m_refreshCounter = m_parentRefreshCounter;
+      CSingleLock lock(m_section);
+      if (m_refreshCounter != version || version == 0)
+      {
+        Update(NULL);
+        m_cachedValue = m_value;
+        m_refreshCounter = version;
+      }
     }
-    return m_value;
+    return m_cachedValue;
   }
 
+  /*! \brief Version of the values this bool depends on
+   The cached value is evaluated again whenever the version changes. Defaults to the refresh
+   counter of the info manager, which changes every frame.
+   */
+  virtual unsigned int GetVersion() const { return m_parentRefreshCounter; }
+
   bool operator==(const InfoBool &right) const
   {
     return (m_context == right.m_context &&
@@ -64,18 +86,25 @@ public:
    */
   virtual void Update(const CGUIListItem *item) {};
 
+  /*! \brief Whether the value is known to never change
+   \param value set to the value if it is constant
+   */
+  virtual bool IsConstant(bool &value) { return false; }
+
   const std::string &GetExpression() const { return m_expression; }
   bool ListItemDependent() const { return m_listItemDependent; }
 protected:
 
-  bool m_value;                ///< current value
+  bool m_value;                ///< current value, only valid while m_section is held
   int m_context;               ///< contextual information to go with the condition
   bool m_listItemDependent;    ///< do not cache if a listitem pointer is given
   std::string  m_expression;   ///< original expression
 
 private:
-  unsigned int m_refreshCounter;
-  unsigned int &m_parentRefreshCounter;
+  CCriticalSection m_section;  ///< serialises evaluation
+  std::atomic<bool> m_cachedValue{false}; ///< value without a list item
+  std::atomic<unsigned int> m_refreshCounter;
+  std::atomic<unsigned int> &m_parentRefreshCounter;
 };
 
 typedef std::shared_ptr<InfoBool> InfoPtr;
@@ -16,12 +16,23 @@
 #include <list>
 #include <memory>
 #include <stack>
+#include <utility>
 
 using namespace INFO;
 
 void InfoSingle::Initialize()
 {
-  m_condition = CServiceBroker::GetGUI()->GetInfoManager().TranslateSingleString(m_expression, m_listItemDependent);
+  CGUIInfoManager& infoMgr = CServiceBroker::GetGUI()->GetInfoManager();
+  m_condition = infoMgr.TranslateSingleString(m_expression, m_listItemDependent);
+  m_version = infoMgr.GetInfoVersion(m_condition);
+  m_constant = !m_listItemDependent && infoMgr.IsConstantInfo(m_condition);
+}
+
+unsigned int InfoSingle::GetVersion() const
+{
+  if (m_version)
+    return *m_version;
+  return InfoBool::GetVersion();
 }
 
 void InfoSingle::Update(const CGUIListItem *item)
@@ -29,41 +40,83 @@ void InfoSingle::Update(const CGUIListItem *item)
   m_value = CServiceBroker::GetGUI()->GetInfoManager().GetBool(m_condition, m_context, item);
 }
 
+bool InfoSingle::IsConstant(bool &value)
+{
+  if (!m_constant)
+    return false;
+  value = Get();
+  return true;
+}
+
 void InfoExpression::Initialize()
 {
   if (!Parse(m_expression))
   {
     CLog::Log(LOGERROR, "Error parsing boolean expression %s", m_expression.c_str());
-    m_expression_tree = std::make_shared<InfoLeaf>(CServiceBroker::GetGUI()->GetInfoManager().Register("false", 0), false);
+    m_leaves.clear();
+    m_leaves.emplace_back(CServiceBroker::GetGUI()->GetInfoManager().Register("false", 0));
+    Compile(std::make_shared<InfoLeaf>(m_leaves.back(), false));
   }
 }
 
+unsigned int InfoExpression::GetVersion() const
+{
+  // the versions only ever grow, so the sum changes whenever one of them does
+  unsigned int version = 0;
+  for (const auto& leaf : m_leaves)
+    version += leaf->GetVersion();
+  return version;
+}
+
 void InfoExpression::Update(const CGUIListItem *item)
 {
-  m_value = m_expression_tree->Evaluate(item);
+  unsigned int target = m_entry;
+  while (target < RESULT_FALSE)
+  {
+    const Instruction &instruction = m_program[target];
+    target = instruction.info->Get(item) ? instruction.onTrue : instruction.onFalse;
+  }
+  m_value = target == RESULT_TRUE;
+}
+
+bool InfoExpression::IsConstant(bool &value)
+{
+  if (m_entry < RESULT_FALSE)
+    return false;
+  value = m_entry == RESULT_TRUE;
+  return true;
 }
 
 /* Expressions are rewritten at parse time into a form which favours the
- * formation of groups of associative nodes. These groups are then reordered at
- * evaluation time such that nodes whose value renders the evaluation of the
- * remainder of the group unnecessary tend to be evaluated first (these are
- * true nodes for OR subexpressions, or false nodes for AND subexpressions).
- * The end effect is to minimise the number of leaf nodes that need to be
- * evaluated in order to determine the value of the expression. The runtime
- * adaptability has the advantage of not being customised for any particular skin.
+ * formation of groups of associative nodes, and then compiled into a flat
+ * program. Every instruction of the program evaluates one leaf and names the
+ * instruction to continue with depending on its value, or the final result.
+ * Evaluation stops as soon as the rest of a group can't change the result
+ * (at a true leaf of an OR group, or a false leaf of an AND group), without
+ * walking the tree. Leaves whose value never changes, like the platform
+ * conditions, are folded into the targets at compile time and aren't
+ * evaluated at all.
  *
  * The modifications to the expression at parse time fall into two groups:
  * 1) Moving logical NOTs so that they are only applied to leaf nodes.
- *    For example, rewriting ![A+B]|C as !A|!B|C allows reordering such that
- *    any of the three leaves can be evaluated first.
+ *    For example, rewriting ![A+B]|C as !A|!B|C, so a NOT only swaps the
+ *    targets of a leaf.
  * 2) Combining adjacent AND or OR operations such that each path from the root
  *    to a leaf encounters a strictly alternating pattern of AND and OR
  *    operations. So [A|B]|[C|D+[[E|F]|G] becomes A|B|C|[D+[E|F|G]].
  */
 
-bool InfoExpression::InfoLeaf::Evaluate(const CGUIListItem *item)
+unsigned int InfoExpression::InfoLeaf::Compile(Program &program, unsigned int onTrue, unsigned int onFalse) const
 {
-  return m_invert ^ m_info->Get(item);
+  if (m_invert)
+    std::swap(onTrue, onFalse);
+
+  bool value;
+  if (m_info->IsConstant(value))
+    return value ? onTrue : onFalse;
+
+  program.push_back({m_info.get(), onTrue, onFalse});
+  return static_cast<unsigned int>(program.size() - 1);
 }
 
 InfoExpression::InfoAssociativeGroup::InfoAssociativeGroup(
@@ -86,27 +139,21 @@ void InfoExpression::InfoAssociativeGroup::Merge(std::shared_ptr<InfoAssociative
   m_children.splice(m_children.end(), other->m_children);
 }
 
-bool InfoExpression::InfoAssociativeGroup::Evaluate(const CGUIListItem *item)
+unsigned int InfoExpression::InfoAssociativeGroup::Compile(Program &program, unsigned int onTrue, unsigned int onFalse) const
 {
-  /* Handle either AND or OR by using the relation
-   * A AND B == !(!A OR !B)
-   * to convert ANDs into ORs
+  /* Compile the children back to front, so each of them knows where to continue.
+   * A child that doesn't decide the result of the group continues with the next
+   * one, the last one decides it in any case.
    */
-  std::list<InfoSubexpressionPtr>::iterator last = m_children.end();
-  std::list<InfoSubexpressionPtr>::iterator it = m_children.begin();
-  bool use_and = (m_type == NODE_AND);
-  bool result = use_and ^ (*it)->Evaluate(item);
-  while (!result && ++it != last)
+  unsigned int next = m_type == NODE_AND ? onTrue : onFalse;
+  for (auto it = m_children.rbegin(); it != m_children.rend(); ++it)
   {
-    result = use_and ^ (*it)->Evaluate(item);
-    if (result)
-    {
-      /* Move this child to the head of the list so we evaluate faster next time */
-      m_children.push_front(*it);
-      m_children.erase(it);
-    }
+    if (m_type == NODE_AND)
+      next = (*it)->Compile(program, next, onFalse);
+    else
+      next = (*it)->Compile(program, onTrue, next);
   }
-  return use_and ^ result;
+  return next;
 }
 
 /* Expressions are parsed using the shunting-yard algorithm. Binary operators
@@ -244,6 +291,7 @@ bool InfoExpression::Parse(const std::string &expression)
         }
         /* Propagate any listItem dependency from the operand to the expression */
         m_listItemDependent |= info->ListItemDependent();
+        m_leaves.emplace_back(info);
         nodes.push(std::make_shared<InfoLeaf>(info, invert));
         /* Reuse operand string for next operand */
         operand.clear();
@@ -295,11 +343,19 @@ bool InfoExpression::Parse(const std::string &expression)
     }
     /* Propagate any listItem dependency from the operand to the expression */
     m_listItemDependent |= info->ListItemDependent();
+    m_leaves.emplace_back(info);
     nodes.push(std::make_shared<InfoLeaf>(info, invert));
   }
   while (!operator_stack.empty())
     OperatorPop(operator_stack, invert, nodes);
 
-  m_expression_tree = nodes.top();
+  Compile(nodes.top());
   return true;
 }
+
+void InfoExpression::Compile(const InfoSubexpressionPtr &expression_tree)
+{
+  m_program.clear();
+  m_entry = expression_tree->Compile(m_program, RESULT_TRUE, RESULT_FALSE);
+  m_program.shrink_to_fit();
+}
@@ -23,13 +23,17 @@ namespace INFO
 class InfoSingle : public InfoBool
 {
 public:
-  InfoSingle(const std::string &expression, int context, unsigned int &refreshCounter)
+  InfoSingle(const std::string &expression, int context, std::atomic<unsigned int> &refreshCounter)
     : InfoBool(expression, context, refreshCounter) {};
   void Initialize() override;
 
   void Update(const CGUIListItem *item) override;
+  unsigned int GetVersion() const override;
+  bool IsConstant(bool &value) override;
 private:
   int m_condition;             ///< actual condition this represents
+  bool m_constant = false;     ///< whether the condition never changes
+  const std::atomic<unsigned int>* m_version = nullptr; ///< version published by the info provider, if any
 };
 
 /*! \brief Class to wrap active boolean expressions
@@ -37,13 +41,15 @@ private:
 class InfoExpression : public InfoBool
 {
 public:
-  InfoExpression(const std::string &expression, int context, unsigned int &refreshCounter)
+  InfoExpression(const std::string &expression, int context, std::atomic<unsigned int> &refreshCounter)
     : InfoBool(expression, context, refreshCounter) {};
   ~InfoExpression() override = default;
 
   void Initialize() override;
 
   void Update(const CGUIListItem *item) override;
+  unsigned int GetVersion() const override;
+  bool IsConstant(bool &value) override;
 private:
   typedef enum
   {
@@ -62,12 +68,29 @@ private:
     NODE_OR,
   } node_type_t;
 
+  // Targets of the compiled program that end the evaluation
+  static const unsigned int RESULT_FALSE = static_cast<unsigned int>(-2);
+  static const unsigned int RESULT_TRUE = static_cast<unsigned int>(-1);
+
+  // One operand of the compiled program, continues at one of the targets depending on its value
+  struct Instruction
+  {
+    InfoBool *info;
+    unsigned int onTrue;
+    unsigned int onFalse;
+  };
+
+  typedef std::vector<Instruction> Program;
+
   // An abstract base class for nodes in the expression tree
   class InfoSubexpression
   {
   public:
     virtual ~InfoSubexpression(void) = default; // so we can destruct derived classes using a pointer to their base class
-    virtual bool Evaluate(const CGUIListItem *item) = 0;
+    /*! \brief Append the instructions of this node to a program
+     \return the target to start the evaluation of this node at
+     */
+    virtual unsigned int Compile(Program &program, unsigned int onTrue, unsigned int onFalse) const = 0;
     virtual node_type_t Type() const=0;
   };
 
@@ -78,7 +101,7 @@ private:
   {
   public:
     InfoLeaf(InfoPtr info, bool invert) : m_info(info), m_invert(invert) {};
-    bool Evaluate(const CGUIListItem *item) override;
+    unsigned int Compile(Program &program, unsigned int onTrue, unsigned int onFalse) const override;
     node_type_t Type() const override { return NODE_LEAF; };
   private:
     InfoPtr m_info;
@@ -92,7 +115,7 @@ private:
     InfoAssociativeGroup(node_type_t type, const InfoSubexpressionPtr &left, const InfoSubexpressionPtr &right);
     void AddChild(const InfoSubexpressionPtr &child);
     void Merge(std::shared_ptr<InfoAssociativeGroup> other);
-    bool Evaluate(const CGUIListItem *item) override;
+    unsigned int Compile(Program &program, unsigned int onTrue, unsigned int onFalse) const override;
     node_type_t Type() const override { return m_type; };
   private:
     node_type_t m_type;
@@ -102,7 +125,10 @@ private:
   static operator_t GetOperator(char ch);
   static void OperatorPop(std::stack<operator_t> &operator_stack, bool &invert, std::stack<InfoSubexpressionPtr> &nodes);
   bool Parse(const std::string &expression);
-  InfoSubexpressionPtr m_expression_tree;
+  void Compile(const InfoSubexpressionPtr &expression_tree);
+  Program m_program;
+  unsigned int m_entry = RESULT_FALSE; ///< target the evaluation starts at
+  std::vector<InfoPtr> m_leaves; ///< operands, the expression depends on their versions
 };
 
 };
@@ -293,7 +293,7 @@ void CAddonsOperations::FillDetails(AddonPtr addon, const CVariant& fields, CVar
   }
 
   if (append)
-    result.append(object);
+    result.append(std::move(object));
   else
-    result = object;
+    result = std::move(object);
 }
@@ -634,6 +634,31 @@ JSONRPC_STATUS JSONRPC::CAudioLibrary::GetSources(const std::string& method, ITr
   return OK;
 }
 
+JSONRPC_STATUS CAudioLibrary::GetChanges(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
+{
+  CMusicDatabase musicdatabase;
+  if (!musicdatabase.Open())
+    return InternalError;
+
+  std::vector<CDatabase::ChangeLogEntry> changes;
+  int revision = musicdatabase.GetChanges((int)parameterObject["since"].asInteger(), (unsigned int)parameterObject["limit"].asUnsignedInteger(), changes);
+  if (revision < 0)
+    return InternalError;
+
+  result["revision"] = revision;
+  result["changes"] = CVariant(CVariant::VariantTypeArray);
+  for (const auto& change : changes)
+  {
+    CVariant entry(CVariant::VariantTypeObject);
+    entry["revision"] = change.revision;
+    entry["type"] = change.mediaType;
+    entry["id"] = change.mediaId;
+    entry["action"] = change.action;
+    result["changes"].push_back(entry);
+  }
+  return OK;
+}
+
 JSONRPC_STATUS CAudioLibrary::SetArtistDetails(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
 {
   int id = (int)parameterObject["artistid"].asInteger();
@@ -90,7 +90,7 @@ JSONRPC_STATUS CFavouritesOperations::GetFavourites(const std::string &method, I
       object["type"] = "unknown";
 
     if (type.empty() || type.compare(object["type"].asString()) == 0)
-      result["favourites"].append(object);
+      result["favourites"].append(std::move(object));
   }
 
   int start, end;
@@ -185,13 +185,13 @@ void CFileItemHandler::FillDetails(const ISerializable *info, const CFileItemPtr
 
   bool fetchedArt = false;
 
-  std::set<std::string> originalFields = fields;
-
-  for (const auto& fieldIt : originalFields)
+  for (auto fieldIt = fields.begin(); fieldIt != fields.end();)
   {
-    if (GetField(fieldIt, serialization, item, result, fetchedArt, thumbLoader) &&
-        result.isMember(fieldIt) && !result[fieldIt].empty())
-      fields.erase(fieldIt);
+    if (GetField(*fieldIt, serialization, item, result, fetchedArt, thumbLoader) &&
+        result.isMember(*fieldIt) && !result[*fieldIt].empty())
+      fieldIt = fields.erase(fieldIt);
+    else
+      ++fieldIt;
   }
 }
 
@@ -384,9 +384,9 @@ void CFileItemHandler::HandleFileItem(const char *ID, bool allowFile, const char
   if (resultname)
   {
     if (append)
-      result[resultname].append(object);
+      result[resultname].append(std::move(object));
     else
-      result[resultname] = object;
+      result[resultname] = std::move(object);
   }
 }
 
@@ -8,6 +8,9 @@
 
 #pragma once
 
+#include <string>
+#include <vector>
+
 namespace JSONRPC
 {
   class IClient
@@ -17,5 +20,12 @@ namespace JSONRPC
     virtual int GetPermissionFlags() = 0;
     virtual int GetAnnouncementFlags() = 0;
     virtual bool SetAnnouncementFlags(int flags) = 0;
+
+    /*!
+     \brief Properties of the active player pushed to the client when they change.
+     \return false if the client can't receive them
+     */
+    virtual bool SetPlayerProperties(const std::vector<std::string>& properties) { return properties.empty(); }
+    virtual std::vector<std::string> GetPlayerProperties() { return std::vector<std::string>(); }
   };
 }
@@ -106,6 +106,7 @@ JsonRpcMethodMap CJSONServiceDescription::m_methodMaps[] = {
   { "AudioLibrary.GetGenres",                       CAudioLibrary::GetGenres },
   { "AudioLibrary.GetRoles",                        CAudioLibrary::GetRoles },
   { "AudioLibrary.GetSources",                      CAudioLibrary::GetSources },
+  { "AudioLibrary.GetChanges",                      CAudioLibrary::GetChanges },
   { "AudioLibrary.SetArtistDetails",                CAudioLibrary::SetArtistDetails },
   { "AudioLibrary.SetAlbumDetails",                 CAudioLibrary::SetAlbumDetails },
   { "AudioLibrary.SetSongDetails",                  CAudioLibrary::SetSongDetails },
@@ -132,6 +133,7 @@ JsonRpcMethodMap CJSONServiceDescription::m_methodMaps[] = {
   { "VideoLibrary.GetRecentlyAddedEpisodes",        CVideoLibrary::GetRecentlyAddedEpisodes },
   { "VideoLibrary.GetRecentlyAddedMusicVideos",     CVideoLibrary::GetRecentlyAddedMusicVideos },
   { "VideoLibrary.GetInProgressTVShows",            CVideoLibrary::GetInProgressTVShows },
+  { "VideoLibrary.GetChanges",                      CVideoLibrary::GetChanges },
   { "VideoLibrary.SetMovieDetails",                 CVideoLibrary::SetMovieDetails },
   { "VideoLibrary.SetMovieSetDetails",              CVideoLibrary::SetMovieSetDetails },
   { "VideoLibrary.SetTVShowDetails",                CVideoLibrary::SetTVShowDetails },
@@ -224,6 +226,8 @@ JsonRpcMethodMap CJSONServiceDescription::m_methodMaps[] = {
 // Textures operations
   { "Textures.GetTextures",                         CTextureOperations::GetTextures },
   { "Textures.RemoveTexture",                       CTextureOperations::RemoveTexture },
+  { "Textures.PrecacheArtwork",                    CTextureOperations::PrecacheArtwork },
+  { "Textures.GetPrecacheStatus",                  CTextureOperations::GetPrecacheStatus },
 
 // Settings operations
   { "Settings.GetSections",                         CSettingsOperations::GetSections },
@@ -235,7 +239,10 @@ JsonRpcMethodMap CJSONServiceDescription::m_methodMaps[] = {
 
 // XBMC operations
   { "XBMC.GetInfoLabels",                           CXBMCOperations::GetInfoLabels },
-  { "XBMC.GetInfoBooleans",                         CXBMCOperations::GetInfoBooleans }
+  { "XBMC.GetInfoBooleans",                         CXBMCOperations::GetInfoBooleans },
+  { "XBMC.GetJobStatistics",                        CXBMCOperations::GetJobStatistics },
+  { "XBMC.SetTracing",                              CXBMCOperations::SetTracing },
+  { "XBMC.SaveTrace",                               CXBMCOperations::SaveTrace }
 };
 
 JSONSchemaTypeDefinition::JSONSchemaTypeDefinition()
@@ -280,7 +280,7 @@ void CPVROperations::FillChannelGroupDetails(const std::shared_ptr<CPVRChannelGr
   object["label"] = channelGroup->GroupName();
 
   if (append)
-    result.append(object);
+    result.append(std::move(object));
   else
   {
     CFileItemList channels;
@@ -293,7 +293,7 @@ void CPVROperations::FillChannelGroupDetails(const std::shared_ptr<CPVRChannelGr
     object["channels"] = CVariant(CVariant::VariantTypeArray);
     HandleFileItemList("channelid", false, "channels", channels, parameterObject["channels"], object, false);
 
-    result = object;
+    result = std::move(object);
   }
 }
 
@@ -18,6 +18,7 @@
 #include "SeekHandler.h"
 #include "Util.h"
 #include "VideoLibrary.h"
+#include "cores/DataCacheCore.h"
 #include "cores/IPlayer.h"
 #include "cores/playercorefactory/PlayerCoreFactory.h"
 #include "guilib/GUIWindowManager.h"
@@ -1859,6 +1860,48 @@ JSONRPC_STATUS CPlayerOperations::GetPropertyValue(PlayerType player, const std:
   }
   else if (property == "live")
     result = IsPVRChannel();
+  else if (property == "rendertelemetry")
+  {
+    switch (player)
+    {
+    case Video:
+    {
+      SRenderTelemetryInfo telemetry = CServiceBroker::GetDataCacheCore().GetRenderTelemetryInfo();
+
+      result = CVariant(CVariant::VariantTypeObject);
+      result["frames"] = telemetry.frames;
+      result["skipped"] = telemetry.skipped;
+      result["missedvsyncs"] = telemetry.missedVsyncs;
+
+      result["timebounds"] = CVariant(CVariant::VariantTypeArray);
+      for (int bound : SRenderTelemetryInfo::TIME_BOUNDS)
+        result["timebounds"].append(bound);
+
+      auto histogram = [&telemetry](const SRenderTelemetryInfo::Histogram& bins, double total)
+      {
+        CVariant value(CVariant::VariantTypeObject);
+        value["average"] = telemetry.frames > 0 ? total / telemetry.frames : 0.0;
+        value["bins"] = CVariant(CVariant::VariantTypeArray);
+        for (uint64_t count : bins)
+          value["bins"].append(count);
+        return value;
+      };
+      result["uploadtime"] = histogram(telemetry.uploadTime, telemetry.uploadTimeTotal);
+      result["queuetime"] = histogram(telemetry.queueTime, telemetry.queueTimeTotal);
+      result["presenttime"] = histogram(telemetry.presentTime, telemetry.presentTimeTotal);
+
+      result["queuedepth"] = CVariant(CVariant::VariantTypeArray);
+      for (uint64_t count : telemetry.queueDepth)
+        result["queuedepth"].append(count);
+      break;
+    }
+    case Audio:
+    case Picture:
+    default:
+      result = CVariant(CVariant::VariantTypeNull);
+      break;
+    }
+  }
   else
     return InvalidParams;
 
@@ -10,6 +10,7 @@
 
 #include "TextureCache.h"
 #include "TextureDatabase.h"
+#include "TexturePrecacheJob.h"
 #include "utils/Variant.h"
 
 using namespace JSONRPC;
@@ -91,3 +92,33 @@ JSONRPC_STATUS CTextureOperations::RemoveTexture(const std::string &method, ITra
 
   return ACK;
 }
+
+JSONRPC_STATUS CTextureOperations::PrecacheArtwork(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
+{
+  bool video = false;
+  bool music = false;
+  const CVariant &libraries = parameterObject["libraries"];
+  for (CVariant::const_iterator_array it = libraries.begin_array(); it != libraries.end_array(); ++it)
+  {
+    if (it->asString() == "video")
+      video = true;
+    else if (it->asString() == "music")
+      music = true;
+  }
+
+  if (!CTexturePrecacheJob::Start(video, music, parameterObject["showdialogs"].asBoolean()))
+    return FailedToExecute;
+
+  return ACK;
+}
+
+JSONRPC_STATUS CTextureOperations::GetPrecacheStatus(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
+{
+  const CTexturePrecacheJob::SStatus status = CTexturePrecacheJob::GetStatus();
+  result["running"] = status.running;
+  result["total"] = status.total;
+  result["done"] = status.done;
+  result["failed"] = status.failed;
+
+  return OK;
+}
@@ -426,6 +426,31 @@ JSONRPC_STATUS CVideoLibrary::GetInProgressTVShows(const std::string &method, IT
   return HandleItems("tvshowid", "tvshows", items, parameterObject, result, false);
 }
 
+JSONRPC_STATUS CVideoLibrary::GetChanges(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
+{
+  CVideoDatabase videodatabase;
+  if (!videodatabase.Open())
+    return InternalError;
+
+  std::vector<CDatabase::ChangeLogEntry> changes;
+  int revision = videodatabase.GetChanges((int)parameterObject["since"].asInteger(), (unsigned int)parameterObject["limit"].asUnsignedInteger(), changes);
+  if (revision < 0)
+    return InternalError;
+
+  result["revision"] = revision;
+  result["changes"] = CVariant(CVariant::VariantTypeArray);
+  for (const auto& change : changes)
+  {
+    CVariant entry(CVariant::VariantTypeObject);
+    entry["revision"] = change.revision;
+    entry["type"] = change.mediaType;
+    entry["id"] = change.mediaId;
+    entry["action"] = change.action;
+    result["changes"].push_back(entry);
+  }
+  return OK;
+}
+
 JSONRPC_STATUS CVideoLibrary::GetGenres(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
 {
   std::string media = parameterObject["type"].asString();
@@ -11,6 +11,8 @@
 #include "ServiceBroker.h"
 #include "messaging/ApplicationMessenger.h"
 #include "powermanagement/PowerManager.h"
+#include "utils/JobManager.h"
+#include "utils/Tracer.h"
 #include "utils/Variant.h"
 
 using namespace JSONRPC;
@@ -85,3 +87,56 @@ JSONRPC_STATUS CXBMCOperations::GetInfoBooleans(const std::string &method, ITran
 
   return OK;
 }
+
+JSONRPC_STATUS CXBMCOperations::GetJobStatistics(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
+{
+  const CJobManager::Statistics statistics = CJobManager::GetInstance().GetStatistics();
+
+  result["workers"] = statistics.workers;
+  result["queued"]["lowpausable"] = statistics.queued[CJob::PRIORITY_LOW_PAUSABLE];
+  result["queued"]["low"] = statistics.queued[CJob::PRIORITY_LOW];
+  result["queued"]["normal"] = statistics.queued[CJob::PRIORITY_NORMAL];
+  result["queued"]["high"] = statistics.queued[CJob::PRIORITY_HIGH];
+  result["queued"]["dedicated"] = statistics.queued[CJob::PRIORITY_DEDICATED];
+
+  result["jobs"] = CVariant(CVariant::VariantTypeArray);
+  for (const auto& it : statistics.jobs)
+  {
+    const CJobManager::JobStats &stats = it.second;
+    uint64_t started = stats.completed + stats.processing;
+
+    CVariant job(CVariant::VariantTypeObject);
+    job["type"] = it.first;
+    job["queued"] = stats.queued;
+    job["processing"] = stats.processing;
+    job["completed"] = stats.completed;
+    job["averagewaittime"] = started ? stats.waitTime / started : 0;
+    job["averageruntime"] = stats.completed ? stats.runTime / stats.completed : 0;
+    result["jobs"].push_back(job);
+  }
+
+  return OK;
+}
+
+JSONRPC_STATUS CXBMCOperations::SetTracing(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
+{
+  if (parameterObject["enabled"].asBoolean())
+    CTracer::Start();
+  else
+    CTracer::Stop();
+
+  return ACK;
+}
+
+JSONRPC_STATUS CXBMCOperations::SaveTrace(const std::string &method, ITransportLayer *transport, IClient *client, const CVariant &parameterObject, CVariant &result)
+{
+  std::string file = parameterObject["file"].asString();
+  if (file.empty())
+    file = CTracer::DEFAULT_FILE;
+
+  if (!CTracer::Save(file))
+    return FailedToExecute;
+
+  result = file;
+  return OK;
+}
@@ -12,12 +12,12 @@ namespace XBMCAddon
   // need a place to put the vtab
   AddonCallback::~AddonCallback() = default;
 
-  void AddonCallback::invokeCallback(Callback* callback)
+  void AddonCallback::invokeCallback(Callback* callback, const String& coalesceKey)
   {
     if (callback)
     {
       if (hasHandler())
-        handler->invokeCallback(callback);
+        handler->invokeCallback(callback, coalesceKey);
       else
         callback->executeCallback();
     }
@@ -38,6 +38,6 @@ namespace XBMCAddon
     ~AddonCallback() override;
 
     inline void setHandler(CallbackHandler* _handler) { handler = _handler; }
-    void invokeCallback(Callback* callback);
+    void invokeCallback(Callback* callback, const String& coalesceKey = emptyString);
   };
 }
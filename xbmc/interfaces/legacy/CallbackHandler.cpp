@@ -9,11 +9,18 @@
 #include "CallbackHandler.h"
 
 #include "AddonUtils.h"
+#include "LanguageHook.h"
 #include "commons/Exception.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #include "utils/log.h"
 
-#include <vector>
+#include <algorithm>
+#include <deque>
+#include <map>
+
+// a callback taking longer than this holds up the other callbacks of its addon
+#define SLOW_CALLBACK_MS 100
 
 namespace XBMCAddon
 {
@@ -22,24 +29,62 @@ namespace XBMCAddon
   public:
     AddonClass::Ref<Callback> cb;
     AddonClass::Ref<RetardedAsyncCallbackHandler> handler;
-    AsyncCallbackMessage(Callback* _cb, RetardedAsyncCallbackHandler* _handler) :
-      cb(_cb), handler(_handler) { XBMC_TRACE; }
+    String coalesceKey;
+    AsyncCallbackMessage(Callback* _cb, RetardedAsyncCallbackHandler* _handler, const String& _coalesceKey) :
+      cb(_cb), handler(_handler), coalesceKey(_coalesceKey) { XBMC_TRACE; }
   };
 
   //********************************************************************
   // This holds the callback messages which will be executed. It doesn't
   //  seem to work correctly with the Ref object so we'll go with Ref*'s
-  typedef std::vector<AddonClass::Ref<AsyncCallbackMessage> > CallbackQueue;
+  typedef std::deque<AddonClass::Ref<AsyncCallbackMessage> > CallbackQueue;
   //********************************************************************
 
+  struct CallbackStats
+  {
+    unsigned int calls = 0;
+    unsigned int slowCalls = 0;
+    uint64_t totalMs = 0;
+  };
+
   static CCriticalSection critSection;
-  static CallbackQueue g_callQueue;
+  static std::map<RetardedAsyncCallbackHandler*, CallbackQueue> g_callQueues;
+  static std::map<String, CallbackStats> g_callStats;
 
-  void RetardedAsyncCallbackHandler::invokeCallback(Callback* cb)
+  static void updateCallbackStats(AddonClass* obj, unsigned int duration)
+  {
+    LanguageHook* languageHook = obj->GetLanguageHook();
+    const String addonId = languageHook ? languageHook->GetAddonId() : emptyString;
+
+    CSingleLock lock(critSection);
+    CallbackStats& stats = g_callStats[addonId];
+    stats.calls++;
+    stats.totalMs += duration;
+    if (duration > SLOW_CALLBACK_MS)
+    {
+      stats.slowCalls++;
+      CLog::Log(LOGWARNING, "Callback of addon '%s' took %u ms (%u of %u callbacks were slow, %llu ms spent in all of them)",
+                addonId.c_str(), duration, stats.slowCalls, stats.calls, static_cast<unsigned long long>(stats.totalMs));
+    }
+  }
+
+  void RetardedAsyncCallbackHandler::invokeCallback(Callback* cb, const String& coalesceKey)
   {
     XBMC_TRACE;
     CSingleLock lock(critSection);
-    g_callQueue.push_back(new AsyncCallbackMessage(cb,this));
+    CallbackQueue& queue = g_callQueues[this];
+    if (!coalesceKey.empty())
+    {
+      // the pending callback carries an outdated state, so it's not worth
+      //  the time of the addon
+      queue.erase(std::remove_if(queue.begin(), queue.end(),
+                                 [&coalesceKey](const AddonClass::Ref<AsyncCallbackMessage>& message)
+                                 {
+                                   return message->coalesceKey == coalesceKey;
+                                 }),
+                  queue.end());
+    }
+    queue.push_back(new AsyncCallbackMessage(cb, this, coalesceKey));
   }
 
   RetardedAsyncCallbackHandler::~RetardedAsyncCallbackHandler()
@@ -47,76 +92,80 @@ namespace XBMCAddon
     XBMC_TRACE;
     CSingleLock lock(critSection);
 
-    // find any messages that might be there because of me ... and remove them
-    CallbackQueue::iterator iter = g_callQueue.begin();
-    while (iter != g_callQueue.end())
-    {
-      if ((*iter)->handler.get() == this) // then this message is because of me
-      {
-        g_callQueue.erase(iter);
-        iter = g_callQueue.begin();
-      }
-      else
-        ++iter;
-    }
+    // remove any messages that might be there because of me
+    g_callQueues.erase(this);
   }
 
   void RetardedAsyncCallbackHandler::makePendingCalls()
   {
     XBMC_TRACE;
     CSingleLock lock(critSection);
-    CallbackQueue::iterator iter = g_callQueue.begin();
-    while (iter != g_callQueue.end())
+    auto queue = g_callQueues.begin();
+    while (queue != g_callQueues.end())
     {
-      AddonClass::Ref<AsyncCallbackMessage> p(*iter);
+      if (queue->second.empty())
+      {
+        queue = g_callQueues.erase(queue);
+        continue;
+      }
 
       // only call when we are in the right thread state
-      if(p->handler->isStateOk(p->cb->getObject()))
+      const AsyncCallbackMessage* front = queue->second.front().get();
+      if (!front->handler->isStateOk(front->cb->getObject()))
       {
-        // remove it from the queue. No matter what we're done with
-        //  this. Even if it doesn't execute for some reason.
-        g_callQueue.erase(iter);
+        ++queue;
+        continue;
+      }
 
-        // we need to release the critSection lock prior to grabbing the
-        //  lock on the object. Not doing so results in deadlocks. We no
-        //  longer are accessing the g_callQueue so it's fine to do this now
-        {
-          XBMCAddonUtils::InvertSingleLockGuard unlock(lock);
+      // remove it from the queue. No matter what we're done with
+      //  this. Even if it doesn't execute for some reason.
+      AddonClass::Ref<AsyncCallbackMessage> p(queue->second.front());
+      queue->second.pop_front();
+      RetardedAsyncCallbackHandler* handler = p->handler.get();
 
-          // make sure the object is not deallocating
+      // we need to release the critSection lock prior to grabbing the
+      //  lock on the object. Not doing so results in deadlocks. We no
+      //  longer are accessing the queues so it's fine to do this now
+      {
+        XBMCAddonUtils::InvertSingleLockGuard unlock(lock);
 
-          // we need to grab the object lock to see if the object of the call
-          //  is deallocating. holding this lock should prevent it from
-          //  deallocating during the execution of this call.
+        // make sure the object is not deallocating
+
+        // we need to grab the object lock to see if the object of the call
+        //  is deallocating. holding this lock should prevent it from
+        //  deallocating during the execution of this call.
 #ifdef ENABLE_XBMC_TRACE_API
-          CLog::Log(LOGDEBUG,"%sNEWADDON executing callback 0x%lx",_tg.getSpaces(),(long)(p->cb.get()));
+        CLog::Log(LOGDEBUG,"%sNEWADDON executing callback 0x%lx",_tg.getSpaces(),(long)(p->cb.get()));
 #endif
-          AddonClass* obj = (p->cb->getObject());
-          AddonClass::Ref<AddonClass> ref(obj);
-          CSingleLock lock2(*obj);
-          if (!p->cb->getObject()->isDeallocating())
+        AddonClass* obj = (p->cb->getObject());
+        AddonClass::Ref<AddonClass> ref(obj);
+        CSingleLock lock2(*obj);
+        if (!p->cb->getObject()->isDeallocating())
+        {
+          const unsigned int start = XbmcThreads::SystemClockMillis();
+          try
+          {
+            // need to make the call
+            p->cb->executeCallback();
+          }
+          catch (XbmcCommons::Exception& e) { e.LogThrowMessage(); }
+          catch (...)
           {
-            try
-            {
-              // need to make the call
-              p->cb->executeCallback();
-            }
-            catch (XbmcCommons::Exception& e) { e.LogThrowMessage(); }
-            catch (...)
-            {
-              CLog::Log(LOGERROR,"Unknown exception while executing callback 0x%lx", (long)(p->cb.get()));
-            }
+            CLog::Log(LOGERROR,"Unknown exception while executing callback 0x%lx", (long)(p->cb.get()));
           }
+          updateCallbackStats(obj, XbmcThreads::SystemClockMillis() - start);
         }
-
-        // since the state of the iterator may have been corrupted by
-        //  the changing state of the list from another thread during
-        //  the releasing fo the lock in the immediately preceeding
-        //  codeblock, we need to reset it before continuing the loop
-        iter = g_callQueue.begin();
       }
-      else // if we're not in the right thread for this callback...
-        ++iter;
+
+      // releasing the message may destroy the handler along with its queue
+      p = nullptr;
+
+      // the queues may have been changed by other threads while the lock
+      //  was released, so look the queue of the handler up again and go on
+      //  with its next callback
+      queue = g_callQueues.find(handler);
+      if (queue == g_callQueues.end())
+        queue = g_callQueues.begin();
     }
   }
 
@@ -124,21 +173,23 @@ namespace XBMCAddon
   {
     XBMC_TRACE;
     CSingleLock lock(critSection);
-    CallbackQueue::iterator iter = g_callQueue.begin();
-    while (iter != g_callQueue.end())
+    for (auto& queue : g_callQueues)
     {
-      AddonClass::Ref<AsyncCallbackMessage> p(*iter);
-
-      if(p->handler->shouldRemoveCallback(p->cb->getObject(),userData))
+      CallbackQueue::iterator iter = queue.second.begin();
+      while (iter != queue.second.end())
       {
+        AddonClass::Ref<AsyncCallbackMessage> p(*iter);
+
+        if(p->handler->shouldRemoveCallback(p->cb->getObject(),userData))
+        {
 #ifdef ENABLE_XBMC_TRACE_API
-        CLog::Log(LOGDEBUG,"%sNEWADDON removing callback 0x%lx for PyThreadState 0x%lx from queue", _tg.getSpaces(),(long)(p->cb.get()) ,(long)userData);
+          CLog::Log(LOGDEBUG,"%sNEWADDON removing callback 0x%lx for PyThreadState 0x%lx from queue", _tg.getSpaces(),(long)(p->cb.get()) ,(long)userData);
 #endif
-        iter = g_callQueue.erase(iter);
+          iter = queue.second.erase(iter);
+        }
+        else
+          ++iter;
       }
-      else
-        ++iter;
     }
   }
 }
-
@@ -24,7 +24,12 @@ namespace XBMCAddon
     inline CallbackHandler() = default;
 
   public:
-    virtual void invokeCallback(Callback* cb) = 0;
+    /**
+     * @param cb The callback to execute
+     * @param coalesceKey Callbacks with the same non-empty key only carry the
+     *  latest state, a pending one is dropped in favour of the new one
+     */
+    virtual void invokeCallback(Callback* cb, const String& coalesceKey) = 0;
   };
 
   /**
@@ -35,6 +40,10 @@ namespace XBMCAddon
    *  messages over to a language controlled thread for eventual
    *  execution.
    *
+   * Every handler has a queue of its own, so a language thread only looks
+   *  at the callbacks of its objects. The time spent in the callbacks is
+   *  measured per addon and slow callbacks are logged.
+   *
    * @todo Allow a cross thread synchronous execution.
    * Fix the stupid means of calling the clearPendingCalls by passing
    *  userData which is specific to the handler/language type.
@@ -47,7 +56,7 @@ namespace XBMCAddon
 
     ~RetardedAsyncCallbackHandler() override;
 
-    void invokeCallback(Callback* cb) override;
+    void invokeCallback(Callback* cb, const String& coalesceKey) override;
     static void makePendingCalls();
     static void clearPendingCalls(void* userData);
 
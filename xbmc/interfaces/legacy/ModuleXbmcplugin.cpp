@@ -9,7 +9,10 @@
 #include "ModuleXbmcplugin.h"
 
 #include "FileItem.h"
+#include "LanguageHook.h"
 #include "filesystem/PluginDirectory.h"
+#include "utils/StringUtils.h"
+#include "utils/log.h"
 
 namespace XBMCAddon
 {
@@ -48,6 +51,59 @@ namespace XBMCAddon
       return XFILE::CPluginDirectory::AddItems(handle, &fitems, totalItems);
     }
 
+    bool addDirectoryItemsFromDicts(int handle, const std::vector<Properties>& items,
+                                    int totalItems)
+    {
+      CFileItemList fitems;
+      {
+        // the items aren't shown yet, so they're all built with a single
+        // release of the interpreter
+        DelayedCallGuard dg;
+        for (const auto& dict : items)
+        {
+          AddonClass::Ref<xbmcgui::ListItem> listItem(new xbmcgui::ListItem(emptyString, emptyString, emptyString,
+                                                                            emptyString, emptyString, true));
+          String infoType = "video";
+          xbmcgui::InfoLabelDict infoLabels;
+          Properties art;
+          Properties properties;
+          for (const auto& it : dict)
+          {
+            const String& key = it.first;
+            if (key == "url")
+              listItem->item->SetPath(it.second);
+            else if (key == "label")
+              listItem->item->SetLabel(it.second);
+            else if (key == "label2")
+              listItem->item->SetLabel2(it.second);
+            else if (key == "isfolder")
+              listItem->item->m_bIsFolder = StringUtils::EqualsNoCase(it.second, "true") || it.second == "1";
+            else if (key == "infotype")
+              infoType = it.second;
+            else if (StringUtils::StartsWith(key, "info."))
+              infoLabels[key.substr(5)].former() = it.second;
+            else if (StringUtils::StartsWith(key, "art."))
+              art[key.substr(4)] = it.second;
+            else if (StringUtils::StartsWith(key, "property."))
+              properties[key.substr(9)] = it.second;
+            else
+              CLog::Log(LOGWARNING, "addDirectoryItemsFromDicts: unknown key '%s'", key.c_str());
+          }
+
+          if (!infoLabels.empty())
+            listItem->setInfo(infoType.c_str(), infoLabels);
+          if (!art.empty())
+            listItem->setArt(art);
+          if (!properties.empty())
+            listItem->setProperties(properties);
+          fitems.Add(listItem->item);
+        }
+      }
+
+      // call the directory class to add our items
+      return XFILE::CPluginDirectory::AddItems(handle, &fitems, totalItems);
+    }
+
     void endOfDirectory(int handle, bool succeeded, bool updateListing,
                         bool cacheToDisc)
     {
@@ -106,6 +106,56 @@ namespace XBMCAddon
                            int totalItems = 0);
 #endif
 
+#ifdef DOXYGEN_SHOULD_USE_THIS
+    ///
+    /// \ingroup python_xbmcplugin
+    /// @brief \python_func{ xbmcplugin.addDirectoryItemsFromDicts(handle, items[, totalItems]) }
+    ///-------------------------------------------------------------------------
+    /// Callback function to pass directory contents back to Kodi as a list of
+    /// dictionaries, without creating a ListItem for each of them.
+    ///
+    /// @param handle               integer - handle the plugin was started
+    ///                             with.
+    /// @param items                List - list of dictionaries describing the
+    ///                             items to add, see the table below.
+    /// @param totalItems           [opt] integer - total number of items
+    ///                             that will be passed.(used for progressbar)
+    /// @return                     Returns a bool for successful completion.
+    ///
+    /// | Key                 | Value                                                   |
+    /// |--------------------:|:--------------------------------------------------------|
+    /// | url                 | string - url of the item
+    /// | label               | string - label of the item
+    /// | label2              | string - second label of the item
+    /// | isfolder            | bool - True=folder / False=not a folder(default)
+    /// | infotype            | string - type of the info labels, see ListItem.setInfo() (default video)
+    /// | info.<label>        | string - info label, see ListItem.setInfo()
+    /// | art.<type>          | string - art of the given type, see ListItem.setArt()
+    /// | property.<key>      | string - property, see ListItem.setProperty()
+    ///
+    /// @remark All the items are built at once, so big listings are passed
+    /// back a lot faster than with ListItem objects. Multiple values of an
+    /// info label are separated by " / ". You may call this more than once to
+    /// add items in chunks.
+    ///
+    ///
+    /// ------------------------------------------------------------------------
+    /// @python_v18 New function added.
+    ///
+    /// **Example:**
+    /// ~~~~~~~~~~~~~{.py}
+    /// ..
+    /// items = [{'url': url, 'label': title, 'isfolder': False, 'info.title': title, 'art.thumb': thumb}]
+    /// if not xbmcplugin.addDirectoryItemsFromDicts(int(sys.argv[1]), items): raise
+    /// ..
+    /// ~~~~~~~~~~~~~
+    ///
+    addDirectoryItemsFromDicts(...);
+#else
+    bool addDirectoryItemsFromDicts(int handle, const std::vector<Properties>& items,
+                                    int totalItems = 0);
+#endif
+
 #ifdef DOXYGEN_SHOULD_USE_THIS
     ///
     /// \ingroup python_xbmcplugin
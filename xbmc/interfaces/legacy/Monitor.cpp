@@ -33,6 +33,18 @@ namespace XBMCAddon
       invokeCallback(new CallbackFunction<Monitor>(this,&Monitor::onAbortRequested));
     }
 
+    void Monitor::OnNotification(const String &sender, const String &method, const String &data)
+    {
+      XBMC_TRACE;
+      // notifications reporting a state are sent in bursts, an addon only
+      // needs to know the latest one
+      String coalesceKey;
+      if (method == "Application.OnVolumeChanged" || method == "Player.OnSeek" ||
+          method == "Player.OnSpeedChanged")
+        coalesceKey = "onNotification." + sender + "." + method;
+      invokeCallback(new CallbackFunction<Monitor,const String,const String,const String>(this,&Monitor::onNotification,sender,method,data), coalesceKey);
+    }
+
     bool Monitor::waitForAbort(double timeout)
     {
       XBMC_TRACE;
@@ -240,13 +240,14 @@ namespace XBMCAddon
     void Player::OnPlayBackSpeedChanged(int speed)
     {
       XBMC_TRACE;
-      invokeCallback(new CallbackFunction<Player,int>(this,&Player::onPlayBackSpeedChanged,speed));
+      invokeCallback(new CallbackFunction<Player,int>(this,&Player::onPlayBackSpeedChanged,speed), "onPlayBackSpeedChanged");
     }
 
     void Player::OnPlayBackSeek(int64_t time, int64_t seekOffset)
     {
       XBMC_TRACE;
-      invokeCallback(new CallbackFunction<Player,int,int>(this,&Player::onPlayBackSeek,static_cast<int>(time),static_cast<int>(seekOffset)));
+      // only the position of the last of several seeks in a row is of interest
+      invokeCallback(new CallbackFunction<Player,int,int>(this,&Player::onPlayBackSeek,static_cast<int>(time),static_cast<int>(seekOffset)), "onPlayBackSeek");
     }
 
     void Player::OnPlayBackSeekChapter(int chapter)
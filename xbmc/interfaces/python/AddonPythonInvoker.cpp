@@ -47,6 +47,93 @@
   "sys.modules['pkg_resources'] = pkg_resources\n" \
   ""
 
+// serves the modules of addons from bytecode compiled into special://temp,
+// which persists where the addon directories are read-only. the cached file
+// is checked against the mtime of the source like python does for its .pyc
+#define RUNSCRIPT_BYTECODE_CACHE \
+  "" \
+  "class xbmcbytecodeloader(object):\n" \
+  "  def __init__(self, cache, source, cfile, package):\n" \
+  "    self.cache, self.source, self.cfile, self.package = cache, source, cfile, package\n" \
+  "  def load_module(self, fullname):\n" \
+  "    c = self.cache\n" \
+  "    code = None\n" \
+  "    if self.cfile:\n" \
+  "      try:\n" \
+  "        with open(self.cfile, 'rb') as f:\n" \
+  "          f.seek(8)\n" \
+  "          code = c.marshal.load(f)\n" \
+  "      except Exception:\n" \
+  "        code = None\n" \
+  "    if code is None:\n" \
+  "      with open(self.source, 'rU') as f:\n" \
+  "        code = compile(f.read() + '\\n', self.source, 'exec')\n" \
+  "    module = c.sys.modules.setdefault(fullname, c.imp.new_module(fullname))\n" \
+  "    module.__file__ = self.source\n" \
+  "    module.__loader__ = self\n" \
+  "    if self.package:\n" \
+  "      module.__path__ = [c.os.path.dirname(self.source)]\n" \
+  "      module.__package__ = fullname\n" \
+  "    else:\n" \
+  "      module.__package__ = fullname.rpartition('.')[0]\n" \
+  "    try:\n" \
+  "      exec code in module.__dict__\n" \
+  "    except:\n" \
+  "      c.sys.modules.pop(fullname, None)\n" \
+  "      raise\n" \
+  "    return c.sys.modules[fullname]\n" \
+  "class xbmcbytecodecache(object):\n" \
+  "  def __init__(self):\n" \
+  "    import hashlib, imp, marshal, os, py_compile, struct\n" \
+  "    self.hashlib, self.imp, self.marshal, self.os, self.py_compile, self.struct, self.sys = hashlib, imp, marshal, os, py_compile, struct, sys\n" \
+  "    self.root = xbmc.translatePath('special://temp/pycache')\n" \
+  "    self.prefixes = (xbmc.translatePath('special://home/addons'), xbmc.translatePath('special://xbmc/addons'))\n" \
+  "  def compile(self, source):\n" \
+  "    os = self.os\n" \
+  "    cfile = os.path.join(self.root, self.hashlib.sha1(source).hexdigest() + '.pyc')\n" \
+  "    try:\n" \
+  "      mtime = int(os.stat(source).st_mtime) & 0xFFFFFFFF\n" \
+  "      with open(cfile, 'rb') as f:\n" \
+  "        if f.read(8) == self.imp.get_magic() + self.struct.pack('<I', mtime):\n" \
+  "          return cfile\n" \
+  "    except (IOError, OSError):\n" \
+  "      pass\n" \
+  "    try:\n" \
+  "      if not os.path.isdir(self.root):\n" \
+  "        os.makedirs(self.root)\n" \
+  "      self.py_compile.compile(source, cfile, source, True)\n" \
+  "      return cfile\n" \
+  "    except Exception:\n" \
+  "      return None\n" \
+  "  def compile_tree(self, path):\n" \
+  "    for root, dirs, files in self.os.walk(path):\n" \
+  "      for name in files:\n" \
+  "        if name.endswith('.py'):\n" \
+  "          self.compile(self.os.path.join(root, name))\n" \
+  "  def find_module(self, fullname, path=None):\n" \
+  "    os = self.os\n" \
+  "    name = fullname.rpartition('.')[2]\n" \
+  "    for entry in (self.sys.path if path is None else path):\n" \
+  "      if not isinstance(entry, str):\n" \
+  "        continue\n" \
+  "      if not entry.startswith(self.prefixes):\n" \
+  "        if os.path.isdir(entry) or os.path.isfile(entry):\n" \
+  "          return None\n" \
+  "        continue\n" \
+  "      base = os.path.join(entry, name)\n" \
+  "      init = os.path.join(base, '__init__.py')\n" \
+  "      if os.path.isfile(init):\n" \
+  "        return xbmcbytecodeloader(self, init, self.compile(init), True)\n" \
+  "      if os.path.isfile(base + '.py'):\n" \
+  "        return xbmcbytecodeloader(self, base + '.py', self.compile(base + '.py'), False)\n" \
+  "      for suffix in ('.so', 'module.so', '.pyd', '.pyc', '.pyo'):\n" \
+  "        if os.path.isfile(base + suffix):\n" \
+  "          return None\n" \
+  "    return None\n" \
+  "xbmcbytecode = xbmcbytecodecache()\n" \
+  "sys.meta_path.append(xbmcbytecode)\n" \
+  ""
+
 #define RUNSCRIPT_POSTSCRIPT \
         "print('-->Python Interpreter Initialized<--')\n" \
         ""
@@ -54,12 +141,12 @@
 #if defined(TARGET_ANDROID)
 
 #define RUNSCRIPT_COMPLIANT \
-  RUNSCRIPT_PREAMBLE RUNSCRIPT_SETUPTOOLS_HACK RUNSCRIPT_POSTSCRIPT
+  RUNSCRIPT_PREAMBLE RUNSCRIPT_SETUPTOOLS_HACK RUNSCRIPT_BYTECODE_CACHE RUNSCRIPT_POSTSCRIPT
 
 #else
 
 #define RUNSCRIPT_COMPLIANT \
-  RUNSCRIPT_PREAMBLE RUNSCRIPT_POSTSCRIPT
+  RUNSCRIPT_PREAMBLE RUNSCRIPT_BYTECODE_CACHE RUNSCRIPT_POSTSCRIPT
 
 #endif
 
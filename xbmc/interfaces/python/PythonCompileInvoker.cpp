@@ -0,0 +1,58 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+// python.h should always be included first before any other includes
+#include "PythonCompileInvoker.h"
+
+#include "filesystem/SpecialProtocol.h"
+#include "interfaces/generic/ScriptInvocationManager.h"
+#include "interfaces/python/XBPython.h"
+#include "utils/URIUtils.h"
+#include "utils/log.h"
+
+#include <Python.h>
+#include <osdefs.h>
+
+// xbmcbytecode is set up by the initialization script of addon invokers
+#define COMPILE_SCRIPT \
+  "xbmcbytecode.compile_tree(xbmcbytecodepath)\n"
+
+CPythonCompileInvoker::CPythonCompileInvoker(ILanguageInvocationHandler *invocationHandler)
+  : CAddonPythonInvoker(invocationHandler)
+{ }
+
+CPythonCompileInvoker::~CPythonCompileInvoker() = default;
+
+void CPythonCompileInvoker::CompileAddon(const ADDON::AddonPtr& addon)
+{
+  if (!addon)
+    return;
+
+  // the invoker needs an existing file to run, addon.xml stands in for the
+  // sources, which aren't executed
+  LanguageInvokerPtr invoker(new CPythonCompileInvoker(&g_pythonParser));
+  std::string manifest = URIUtils::AddFileToFolder(addon->Path(), "addon.xml");
+  if (CScriptInvocationManager::GetInstance().ExecuteAsync(manifest, invoker, addon) < 0)
+    CLog::Log(LOGERROR, "CPythonCompileInvoker: unable to compile %s", addon->ID().c_str());
+}
+
+void CPythonCompileInvoker::executeScript(void *fp, const std::string &script, void *module, void *moduleDict)
+{
+  if (moduleDict == NULL || !m_addon)
+    return;
+
+  PyObject *dict = static_cast<PyObject*>(moduleDict);
+  std::string path = CSpecialProtocol::TranslatePath(m_addon->Path());
+  PyObject *pyPath = PyString_FromString(path.c_str());
+  PyDict_SetItemString(dict, "xbmcbytecodepath", pyPath);
+  Py_DECREF(pyPath);
+
+  CLog::Log(LOGDEBUG, "CPythonInvoker(%d, %s): compiling %s", GetId(), m_sourceFile.c_str(), path.c_str());
+  PyObject *result = PyRun_String(COMPILE_SCRIPT, Py_file_input, dict, dict);
+  Py_XDECREF(result);
+}
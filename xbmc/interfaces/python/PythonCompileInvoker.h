@@ -0,0 +1,31 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "addons/IAddon.h"
+#include "interfaces/python/AddonPythonInvoker.h"
+
+/*!
+ \brief Compiles the python sources of an addon into the bytecode cache.
+
+ Run after an addon got installed or updated, so its first run, e.g. of a
+ service addon after boot, doesn't compile its modules.
+ */
+class CPythonCompileInvoker : public CAddonPythonInvoker
+{
+public:
+  explicit CPythonCompileInvoker(ILanguageInvocationHandler *invocationHandler);
+  ~CPythonCompileInvoker() override;
+
+  /*! \brief Compile the sources of the addon in the background */
+  static void CompileAddon(const ADDON::AddonPtr& addon);
+
+protected:
+  void executeScript(void *fp, const std::string &script, void *module, void *moduleDict) override;
+};
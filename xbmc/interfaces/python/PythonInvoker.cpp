@@ -161,7 +161,8 @@ bool CPythonInvoker::execute(const std::string &script, const std::vector<std::s
 
   // get the global lock
   PyEval_AcquireLock();
-  if (!m_threadState)
+  bool reused = m_threadState != NULL;
+  if (!reused)
   {
     m_threadState = Py_NewInterpreter();
     if (m_threadState == NULL)
@@ -258,6 +259,21 @@ bool CPythonInvoker::execute(const std::string &script, const std::vector<std::s
   PyObject* module = PyImport_AddModule("__main__");
   PyObject* moduleDict = PyModule_GetDict(module);
 
+  if (!reused)
+    m_initialGlobals = PyDict_Copy(moduleDict);
+  else if (m_initialGlobals)
+  {
+    // a reused interpreter keeps the modules imported so far warm, but the
+    // script starts with the globals left by the initialization script and
+    // without the previous abort request
+    PyDict_Clear(moduleDict);
+    PyDict_Update(moduleDict, static_cast<PyObject*>(m_initialGlobals));
+
+    PyObject *m = PyImport_AddModule("xbmc");
+    if (m == NULL || PyObject_SetAttrString(m, "abortRequested", Py_False))
+      CLog::Log(LOGERROR, "CPythonInvoker(%d, %s): failed to reset abortRequested", GetId(), m_sourceFile.c_str());
+  }
+
   // when we are done initing we store thread m_threadState so we can be aborted
   PyThreadState_Swap(NULL);
   PyEval_ReleaseLock();
@@ -499,6 +515,7 @@ bool CPythonInvoker::stop(bool abort)
       // If a dialog entered its doModal(), we need to wake it to see the exception
       pulseGlobalEvent();
       m_threadState = nullptr;
+      m_initialGlobals = nullptr;
     }
     lock.Leave();
     PyEval_ReleaseLock();
@@ -533,6 +550,9 @@ void CPythonInvoker::onExecutionDone()
       PyRun_SimpleString(GC_SCRIPT) == -1)
       CLog::Log(LOGERROR, "CPythonInvoker(%d, %s): failed to run the gc to clean up after running prior to shutting down the Interpreter", GetId(), m_sourceFile.c_str());
 
+    Py_XDECREF(static_cast<PyObject*>(m_initialGlobals));
+    m_initialGlobals = nullptr;
+
     Py_EndInterpreter(m_threadState);
 
     // If we still have objects left around, produce an error message detailing what's been left behind
@@ -569,6 +589,7 @@ void CPythonInvoker::onExecutionFailed()
 
   CSingleLock lock(m_critical);
   m_threadState = NULL;
+  m_initialGlobals = nullptr;
 
   ILanguageInvoker::onExecutionFailed();
 }
@@ -64,6 +64,8 @@ private:
 
   std::string m_pythonPath;
   _ts *m_threadState;
+  // actually a PyObject*, the globals of __main__ after initialization, restored when reused
+  void *m_initialGlobals = nullptr;
   bool m_stop;
   CEvent m_stoppedEvent;
 
@@ -100,6 +100,13 @@ void XBPython::Announce(ANNOUNCEMENT::AnnouncementFlag flag, const char *sender,
      OnDPMSActivated();
   }
 
+  // the data of busy announcements like seeks is only serialized for monitors
+  {
+    CSingleLock lock(m_vecMonitorCallbackList);
+    if (m_vecMonitorCallbackList.empty())
+      return;
+  }
+
   std::string jsonData;
   if (CJSONVariantWriter::Write(data, jsonData, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact))
     OnNotification(sender, std::string(ANNOUNCEMENT::AnnouncementFlagToString(flag)) + "." + std::string(message), jsonData);
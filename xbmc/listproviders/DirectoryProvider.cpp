@@ -26,7 +26,10 @@
 #include "pvr/dialogs/GUIDialogPVRRecordingInfo.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #include "utils/JobManager.h"
 #include "utils/SortUtils.h"
 #include "utils/URIUtils.h"
@@ -37,6 +40,7 @@
 #include "video/dialogs/GUIDialogVideoInfo.h"
 #include "video/windows/GUIWindowVideoBase.h"
 
+#include <map>
 #include <memory>
 #include <utility>
 
@@ -44,6 +48,114 @@ using namespace XFILE;
 using namespace KODI::MESSAGING;
 using namespace PVR;
 
+// the windows of a skin usually show the same few library paths
+#define CACHE_MAX_LISTINGS  30
+// smart playlist rules relative to the current date aren't covered by the announcements
+#define CACHE_MAX_AGE_MS    (5 * 60 * 1000)
+
+namespace
+{
+struct SListing
+{
+  SListing() : fetched(true) {}
+
+  unsigned int videoChanges = 0;
+  unsigned int audioChanges = 0;
+  unsigned int time = 0;
+  bool done = false;
+  bool success = false;
+  CEvent fetched;
+  std::shared_ptr<const CFileItemList> items;
+};
+
+CCriticalSection listingsSection;
+std::map<std::string, std::shared_ptr<SListing>> listings;
+
+bool IsLibraryPath(const std::string &url)
+{
+  return URIUtils::IsProtocol(url, "videodb") ||
+         URIUtils::IsProtocol(url, "musicdb") ||
+         URIUtils::IsProtocol(url, "library") ||
+         URIUtils::HasExtension(url, ".xsp");
+}
+
+/*!
+ \brief Get the items of a path shown by list providers
+
+ Library paths are shared by all providers: a listing stays valid until anything is announced for
+ the libraries, and providers asking for a path that is being fetched wait for that fetch instead
+ of starting their own.
+ */
+bool GetDirectory(const std::string &url, CFileItemList &items)
+{
+  if (!IsLibraryPath(url))
+    return CDirectory::GetDirectory(url, items, "", DIR_FLAG_DEFAULTS);
+
+  const std::shared_ptr<ANNOUNCEMENT::CAnnouncementManager> announcementManager = CServiceBroker::GetAnnouncementManager();
+  const unsigned int videoChanges = announcementManager->GetAnnouncementCount(ANNOUNCEMENT::VideoLibrary);
+  const unsigned int audioChanges = announcementManager->GetAnnouncementCount(ANNOUNCEMENT::AudioLibrary);
+  const unsigned int now = XbmcThreads::SystemClockMillis();
+
+  std::shared_ptr<SListing> listing;
+  bool fetch = false;
+  {
+    CSingleLock lock(listingsSection);
+    auto it = listings.find(url);
+    if (it != listings.end() &&
+        it->second->videoChanges == videoChanges && it->second->audioChanges == audioChanges &&
+        (!it->second->done || (it->second->success && now - it->second->time < CACHE_MAX_AGE_MS)))
+      listing = it->second;
+    else
+    {
+      listing = std::make_shared<SListing>();
+      listing->videoChanges = videoChanges;
+      listing->audioChanges = audioChanges;
+      listing->time = now;
+      listings[url] = listing;
+      fetch = true;
+
+      if (listings.size() > CACHE_MAX_LISTINGS)
+      {
+        auto oldest = listings.end();
+        for (auto entry = listings.begin(); entry != listings.end(); ++entry)
+        {
+          if (entry->second->done && (oldest == listings.end() || now - entry->second->time > now - oldest->second->time))
+            oldest = entry;
+        }
+        if (oldest != listings.end())
+          listings.erase(oldest);
+      }
+    }
+  }
+
+  if (fetch)
+  {
+    std::shared_ptr<CFileItemList> fetchedItems(new CFileItemList);
+    const bool success = CDirectory::GetDirectory(url, *fetchedItems, "", DIR_FLAG_DEFAULTS);
+
+    CSingleLock lock(listingsSection);
+    listing->done = true;
+    listing->success = success;
+    listing->items = std::move(fetchedItems);
+    listing->fetched.Set();
+
+    // the next provider tries again
+    auto it = listings.find(url);
+    if (!success && it != listings.end() && it->second == listing)
+      listings.erase(it);
+  }
+  else
+    listing->fetched.Wait();
+
+  if (!listing->success)
+    return false;
+
+  // the items are changed by the thumb loaders of every provider
+  items.Copy(*listing->items);
+  return true;
+}
+}
+
 class CDirectoryJob : public CJob
 {
 public:
@@ -70,7 +182,7 @@ public:
   bool DoWork() override
   {
     CFileItemList items;
-    if (CDirectory::GetDirectory(m_url, items, "", DIR_FLAG_DEFAULTS))
+    if (GetDirectory(m_url, items))
     {
       // sort the items if necessary
       if (m_sort.sortBy != SortByNone)
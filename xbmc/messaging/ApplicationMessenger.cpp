@@ -11,11 +11,16 @@
 #include "guilib/GUIMessage.h"
 #include "messaging/IMessageTarget.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #include "windowing/GraphicContext.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 
+// time in ms window messages may take per frame, the remaining ones are processed in the next frame
+#define WINDOW_MESSAGES_BUDGET_MS 10
+
 namespace KODI
 {
 namespace MESSAGING
@@ -84,7 +89,7 @@ void CApplicationMessenger::Cleanup()
       pMsg->waitEvent->Set();
 
     delete pMsg;
-    m_vecWindowMessages.pop();
+    m_vecWindowMessages.pop_front();
   }
 }
 
@@ -119,11 +124,15 @@ int CApplicationMessenger::SendMsg(ThreadMessage&& message, bool wait)
     return -1;
 
   ThreadMessage* msg = new ThreadMessage(std::move(message));
+  msg->queued = XbmcThreads::SystemClockMillis();
 
   CSingleLock lock (m_critSection);
 
   if (msg->dwMessage == TMSG_GUI_MESSAGE)
-    m_vecWindowMessages.push(msg);
+  {
+    Coalesce(msg);
+    m_vecWindowMessages.push_back(msg);
+  }
   else
     m_vecMessages.push(msg);
   lock.Leave();  // this releases the lock on the vec of messages and
@@ -205,6 +214,7 @@ void CApplicationMessenger::ProcessMessages()
     ThreadMessage* pMsg = m_vecMessages.front();
     //first remove the message from the queue, else the message could be processed more then once
     m_vecMessages.pop();
+    Dequeued(pMsg);
 
     //Leave here as the message might make another
     //thread call processmessages or sendmessage
@@ -246,12 +256,17 @@ void CApplicationMessenger::ProcessMessage(ThreadMessage *pMsg)
 void CApplicationMessenger::ProcessWindowMessages()
 {
   CSingleLock lock (m_critSection);
+  // only the messages queued up to now and within the budget, so a flood of them
+  // is spread over several frames instead of stalling this one
+  size_t count = m_vecWindowMessages.size();
+  unsigned int start = XbmcThreads::SystemClockMillis();
   //message type is window, process window messages
-  while (!m_vecWindowMessages.empty())
+  while (count-- && !m_vecWindowMessages.empty())
   {
     ThreadMessage* pMsg = m_vecWindowMessages.front();
     //first remove the message from the queue, else the message could be processed more then once
-    m_vecWindowMessages.pop();
+    m_vecWindowMessages.pop_front();
+    Dequeued(pMsg);
 
     // leave here in case we make more thread messages from this one
 
@@ -264,9 +279,64 @@ void CApplicationMessenger::ProcessWindowMessages()
     delete pMsg;
 
     lock.Enter();
+
+    if (XbmcThreads::SystemClockMillis() - start >= WINDOW_MESSAGES_BUDGET_MS)
+      break;
   }
 }
 
+void CApplicationMessenger::Dequeued(const ThreadMessage *pMsg)
+{
+  unsigned int wait = XbmcThreads::SystemClockMillis() - pMsg->queued;
+  m_stats.processed++;
+  m_stats.totalWait += wait;
+  m_stats.maxWait = std::max(m_stats.maxWait, wait);
+}
+
+bool CApplicationMessenger::Coalesce(const ThreadMessage *pMsg)
+{
+  // only posted messages that make windows refresh, an older identical one is redundant
+  const CGUIMessage *message = static_cast<const CGUIMessage*>(pMsg->lpVoid);
+  if (pMsg->waitEvent || !message)
+    return false;
+  if (message->GetMessage() != GUI_MSG_REFRESH_LIST &&
+      message->GetMessage() != GUI_MSG_REFRESH_THUMBS &&
+      message->GetMessage() != GUI_MSG_NOTIFY_ALL)
+    return false;
+  if (message->GetPointer() || message->GetItem() || message->GetNumStringParams())
+    return false;
+
+  for (auto it = m_vecWindowMessages.begin(); it != m_vecWindowMessages.end(); ++it)
+  {
+    const CGUIMessage *queued = static_cast<const CGUIMessage*>((*it)->lpVoid);
+    if ((*it)->waitEvent || !queued || (*it)->param1 != pMsg->param1)
+      continue;
+    if (queued->GetMessage() != message->GetMessage() ||
+        queued->GetSenderId() != message->GetSenderId() ||
+        queued->GetControlId() != message->GetControlId() ||
+        queued->GetParam1() != message->GetParam1() ||
+        queued->GetParam2() != message->GetParam2() ||
+        queued->GetPointer() || queued->GetItem() || queued->GetNumStringParams())
+      continue;
+
+    // the newer one goes to the back, so it still follows everything queued before it
+    delete queued;
+    delete *it;
+    m_vecWindowMessages.erase(it);
+    m_stats.coalesced++;
+    return true;
+  }
+  return false;
+}
+
+CApplicationMessenger::Statistics CApplicationMessenger::GetStatistics() const
+{
+  CSingleLock lock(m_critSection);
+  Statistics stats = m_stats;
+  stats.queued = m_vecMessages.size() + m_vecWindowMessages.size();
+  return stats;
+}
+
 void CApplicationMessenger::SendGUIMessage(const CGUIMessage &message, int windowID, bool waitResult)
 {
   ThreadMessage tMsg(TMSG_GUI_MESSAGE);
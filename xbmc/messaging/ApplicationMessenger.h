@@ -12,6 +12,7 @@
 #include "messaging/ThreadMessage.h"
 #include "threads/Thread.h"
 
+#include <deque>
 #include <map>
 #include <memory>
 #include <queue>
@@ -396,6 +397,20 @@ public:
    */
   void RegisterReceiver(IMessageTarget* target);
 
+  struct Statistics
+  {
+    size_t queued = 0;          //!< messages waiting to be processed
+    uint64_t processed = 0;     //!< messages processed so far
+    uint64_t coalesced = 0;     //!< posted GUI messages dropped for an identical newer one
+    uint64_t totalWait = 0;     //!< ms the processed messages spent in the queues
+    unsigned int maxWait = 0;   //!< ms the longest waiting message spent in a queue
+  };
+
+  /*!
+   * \brief Get the message queue statistics, e.g. to see how long messages wait for the UI thread
+   */
+  Statistics GetStatistics() const;
+
   /*!
    * \brief Set the UI thread id to avoid messenger being dependent on
    * CApplication to determine if marshaling is required
@@ -417,11 +432,14 @@ private:
 
   int SendMsg(ThreadMessage&& msg, bool wait);
   void ProcessMessage(ThreadMessage *pMsg);
+  void Dequeued(const ThreadMessage *pMsg);
+  bool Coalesce(const ThreadMessage *pMsg);
 
   std::queue<ThreadMessage*> m_vecMessages; /*!< queue for regular messages */
-  std::queue<ThreadMessage*> m_vecWindowMessages; /*!< queue for UI messages */
+  std::deque<ThreadMessage*> m_vecWindowMessages; /*!< queue for UI messages */
+  Statistics m_stats;
   std::map<int, IMessageTarget*> m_mapTargets; /*!< a map of registered receivers indexed on the message mask*/
-  CCriticalSection m_critSection;
+  mutable CCriticalSection m_critSection;
   std::thread::id m_guiThreadId;
   bool m_bStop{ false };
 };
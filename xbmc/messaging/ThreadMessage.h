@@ -71,7 +71,8 @@ public:
     strParam(std::move(other.strParam)),
     params(std::move(other.params)),
     waitEvent(std::move(other.waitEvent)),
-    result(std::move(other.result))
+    result(std::move(other.result)),
+    queued(other.queued)
   {
   }
 
@@ -88,6 +89,7 @@ public:
     params = other.params;
     waitEvent = other.waitEvent;
     result = other.result;
+    queued = other.queued;
     return *this;
   }
 
@@ -104,6 +106,7 @@ public:
     params = std::move(other.params);
     waitEvent = std::move(other.waitEvent);
     result = std::move(other.result);
+    queued = other.queued;
     return *this;
   }
 
@@ -131,6 +134,7 @@ public:
 protected:
   std::shared_ptr<CEvent> waitEvent;
   std::shared_ptr<int> result;
+  unsigned int queued = 0; // ms, when the message was queued
 };
 }
 }
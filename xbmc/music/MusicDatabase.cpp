@@ -57,9 +57,12 @@
 #include "utils/Random.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
+#include "utils/XMLElementWriter.h"
 #include "utils/XMLUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <atomic>
 #include <inttypes.h>
 
 using namespace XFILE;
@@ -73,6 +76,9 @@ using KODI::MESSAGING::HELPERS::DialogResponse;
 #define RECENTLY_PLAYED_LIMIT 25
 #define MIN_FULL_SEARCH_LENGTH 3
 
+// bumped on every art write so that art cached by the thumb loaders can be dropped
+static std::atomic<unsigned int> artRevision{0};
+
 #ifdef HAS_DVD_DRIVE
 using namespace CDDB;
 using namespace MEDIA_DETECT;
@@ -100,6 +106,13 @@ static void AnnounceUpdate(const std::string& content, int id, bool added = fals
   CServiceBroker::GetAnnouncementManager()->Announce(ANNOUNCEMENT::AudioLibrary, "xbmc", "OnUpdate", data);
 }
 
+// key of the lookup caches, names are matched case insensitively by the database
+static std::string CacheKey(std::string name)
+{
+  StringUtils::ToLower(name);
+  return name;
+}
+
 CMusicDatabase::CMusicDatabase(void)
 {
   m_translateBlankArtist = true;
@@ -210,6 +223,8 @@ void CMusicDatabase::CreateTables()
   CLog::Log(LOGINFO, "create versiontagscan table");
   m_pDS->exec("CREATE TABLE versiontagscan (idVersion INTEGER, iNeedsScan INTEGER, lastscanned VARCHAR(20))");
   m_pDS->exec(PrepareSQL("INSERT INTO versiontagscan (idVersion, iNeedsScan) values(%i, 0)", GetSchemaVersion()));
+
+  CreateChangeLogTable();
 }
 
 void CMusicDatabase::CreateAnalytics()
@@ -261,28 +276,45 @@ void CMusicDatabase::CreateAnalytics()
 
   m_pDS->exec("CREATE INDEX ix_art ON art(media_id, media_type(20), type(20))");
 
+  m_pDS->exec("CREATE INDEX ix_changelog ON changelog(media_id, media_type(20))");
+
   CLog::Log(LOGINFO, "create triggers");
   m_pDS->exec("CREATE TRIGGER tgrDeleteAlbum AFTER delete ON album FOR EACH ROW BEGIN"
               "  DELETE FROM song WHERE song.idAlbum = old.idAlbum;"
               "  DELETE FROM album_artist WHERE album_artist.idAlbum = old.idAlbum;"
               "  DELETE FROM album_source WHERE album_source.idAlbum = old.idAlbum;"
               "  DELETE FROM art WHERE media_id=old.idAlbum AND media_type='album';"
+              "  " + GetChangeLogSQL(MediaTypeAlbum, "SELECT old.idAlbum AS media_id", "remove") +
               " END");
   m_pDS->exec("CREATE TRIGGER tgrDeleteArtist AFTER delete ON artist FOR EACH ROW BEGIN"
               "  DELETE FROM album_artist WHERE album_artist.idArtist = old.idArtist;"
               "  DELETE FROM song_artist WHERE song_artist.idArtist = old.idArtist;"
               "  DELETE FROM discography WHERE discography.idArtist = old.idArtist;"
               "  DELETE FROM art WHERE media_id=old.idArtist AND media_type='artist';"
+              "  " + GetChangeLogSQL(MediaTypeArtist, "SELECT old.idArtist AS media_id", "remove") +
               " END");
   m_pDS->exec("CREATE TRIGGER tgrDeleteSong AFTER delete ON song FOR EACH ROW BEGIN"
               "  DELETE FROM song_artist WHERE song_artist.idSong = old.idSong;"
               "  DELETE FROM song_genre WHERE song_genre.idSong = old.idSong;"
               "  DELETE FROM art WHERE media_id=old.idSong AND media_type='song';"
+              "  " + GetChangeLogSQL(MediaTypeSong, "SELECT old.idSong AS media_id", "remove") +
               " END");
   m_pDS->exec("CREATE TRIGGER tgrDeleteSource AFTER delete ON source FOR EACH ROW BEGIN"
               "  DELETE FROM source_path WHERE source_path.idSource = old.idSource;"
               "  DELETE FROM album_source WHERE album_source.idSource = old.idSource;"
               " END");
+
+  // remote clients ask for the items changed since their last sync, see GetChanges()
+  const std::pair<const char*, const char*> changeLogTypes[] = {
+    { MediaTypeArtist, "idArtist" }, { MediaTypeAlbum, "idAlbum" }, { MediaTypeSong, "idSong" } };
+  for (const auto& type : changeLogTypes)
+  {
+    const std::string ids = PrepareSQL("SELECT new.%s AS media_id", type.second);
+    m_pDS->exec(PrepareSQL("CREATE TRIGGER tgrChangeLogInsert_%s AFTER insert ON %s FOR EACH ROW BEGIN ", type.first, type.first) +
+                GetChangeLogSQL(type.first, ids, "update") + "END");
+    m_pDS->exec(PrepareSQL("CREATE TRIGGER tgrChangeLogUpdate_%s AFTER update ON %s FOR EACH ROW BEGIN ", type.first, type.first) +
+                GetChangeLogSQL(type.first, ids, "update") + "END");
+  }
   
   // we create views last to ensure all indexes are rolled in
   CreateViews();
@@ -628,6 +660,11 @@ int CMusicDatabase::AddSong(const int idAlbum,
                       iTimesPlayed, iStartOffset, iEndOffset, rating, userrating, votes, strComment.c_str(), strMood.c_str(), replayGain.Get().c_str());
       m_pDS->exec(strSQL);
       idSong = (int)m_pDS->lastinsertid();
+
+      // a new song has no artists yet
+      m_songArtists.idSong = idSong;
+      m_songArtists.complete = true;
+      m_songArtists.artists.clear();
     }
     else
     {
@@ -1171,6 +1208,10 @@ int CMusicDatabase::AddArtist(const std::string& strArtist, const std::string& s
   if (idArtist < 0 || strSortName.empty())
     return idArtist;
 
+  // applying the same sort name again changes nothing
+  if (!m_artistSortCache.insert(std::make_pair(idArtist, strSortName)).second)
+    return idArtist;
+
   /* Artist sort name always taken as the first value provided that is different from name, so only
      update when current sort name is blank. If a new sortname the same as name is provided then
      clear any sortname currently held.
@@ -1208,6 +1249,7 @@ int CMusicDatabase::AddArtist(const std::string& strArtist, const std::string& s
 
   catch (...)
   {
+    m_artistSortCache.erase(std::make_pair(idArtist, strSortName));
     CLog::Log(LOGERROR, "musicdatabase:unable to addartist with sortname (%s)", strSQL.c_str());
   }
 
@@ -1215,6 +1257,24 @@ int CMusicDatabase::AddArtist(const std::string& strArtist, const std::string& s
 }
 
 int CMusicDatabase::AddArtist(const std::string& strArtist, const std::string& strMusicBrainzArtistID, bool bScrapedMBID /* = false*/)
+{
+  // an artist added or matched once resolves to the same id again, artists added by a scraper
+  // are flagged and always go to the database
+  if (bScrapedMBID)
+    return AddArtistToDatabase(strArtist, strMusicBrainzArtistID, true);
+
+  const auto key = std::make_pair(strMusicBrainzArtistID, CacheKey(strArtist));
+  auto it = m_artistCache.find(key);
+  if (it != m_artistCache.end())
+    return it->second;
+
+  int idArtist = AddArtistToDatabase(strArtist, strMusicBrainzArtistID, false);
+  if (idArtist >= 0)
+    m_artistCache.insert(std::make_pair(key, idArtist));
+  return idArtist;
+}
+
+int CMusicDatabase::AddArtistToDatabase(const std::string& strArtist, const std::string& strMusicBrainzArtistID, bool bScrapedMBID)
 {
   std::string strSQL;
   try
@@ -1592,6 +1652,12 @@ int CMusicDatabase::AddRole(const std::string &strRole)
       return -1;
     if (nullptr == m_pDS)
       return -1;
+
+    const std::string key = CacheKey(strRole);
+    auto it = m_roleCache.find(key);
+    if (it != m_roleCache.end())
+      return it->second;
+
     strSQL = PrepareSQL("SELECT idRole FROM role WHERE strRole LIKE '%s'", strRole.c_str());
     m_pDS->query(strSQL);
     if (m_pDS->num_rows() > 0)
@@ -1605,6 +1671,7 @@ int CMusicDatabase::AddRole(const std::string &strRole)
       idRole = static_cast<int>(m_pDS->lastinsertid());
       m_pDS->close();
     }
+    m_roleCache.insert(std::make_pair(key, idRole));
   }
   catch (...)
   {
@@ -1621,6 +1688,14 @@ bool CMusicDatabase::AddSongArtist(int idArtist, int idSong, const std::string&
 
 bool CMusicDatabase::AddSongArtist(int idArtist, int idSong, int idRole, const std::string& strArtist, int iOrder)
 {
+  if (idSong != m_songArtists.idSong)
+  {
+    m_songArtists.idSong = idSong;
+    m_songArtists.complete = false;
+    m_songArtists.artists.clear();
+  }
+  m_songArtists.artists.insert(std::make_pair(CacheKey(strArtist), idArtist));
+
   std::string strSQL;
   strSQL = PrepareSQL("replace into song_artist (idArtist, idSong, idRole, strArtist, iOrder) values(%i,%i,%i,'%s',%i)",
     idArtist, idSong, idRole, strArtist.c_str(), iOrder);
@@ -1643,11 +1718,18 @@ int CMusicDatabase::AddSongContributor(int idSong, const std::string& strRole, c
     int idArtist = -1;
     // Add artist. As we only have name (no MBID) first try to identify artist from song
     // as they may have already been added with a different role (including MBID).
-    strSQL = PrepareSQL("SELECT idArtist FROM song_artist WHERE idSong = %i AND strArtist LIKE '%s' ", idSong, strArtist.c_str());
-    m_pDS->query(strSQL);
-    if (m_pDS->num_rows() > 0)
-      idArtist = m_pDS->fv("idArtist").get_asInt();
-    m_pDS->close();
+    const auto songArtist = m_songArtists.idSong == idSong ?
+        m_songArtists.artists.find(CacheKey(strArtist)) : m_songArtists.artists.end();
+    if (songArtist != m_songArtists.artists.end())
+      idArtist = songArtist->second;
+    else if (m_songArtists.idSong != idSong || !m_songArtists.complete)
+    {
+      strSQL = PrepareSQL("SELECT idArtist FROM song_artist WHERE idSong = %i AND strArtist LIKE '%s' ", idSong, strArtist.c_str());
+      m_pDS->query(strSQL);
+      if (m_pDS->num_rows() > 0)
+        idArtist = m_pDS->fv("idArtist").get_asInt();
+      m_pDS->close();
+    }
 
     if (idArtist < 0)
       idArtist = AddArtist(strArtist, "", strSort);
@@ -1757,6 +1839,9 @@ bool CMusicDatabase::GetRolesByArtist(int idArtist, CFileItem* item)
 
 bool CMusicDatabase::DeleteSongArtistsBySong(int idSong)
 {
+  m_songArtists.idSong = idSong;
+  m_songArtists.complete = true;
+  m_songArtists.artists.clear();
   return ExecuteQuery(PrepareSQL("DELETE FROM song_artist WHERE idSong = %i", idSong));
 }
 
@@ -1787,11 +1872,18 @@ bool CMusicDatabase::AddSongGenres(int idSong, const std::vector<std::string>& g
       return false;
     unsigned int index = 0;
     std::vector<std::string> modgenres = genres;
+    std::string values;
     for (auto &strGenre : modgenres)
     {
       int idGenre = AddGenre(strGenre); // Genre string trimed and matched case insensitively
-      strSQL = PrepareSQL("INSERT INTO song_genre (idGenre, idSong, iOrder) VALUES(%i,%i,%i)",
-        idGenre, idSong, index++);
+      if (!values.empty())
+        values += ",";
+      values += PrepareSQL("(%i,%i,%i)", idGenre, idSong, index++);
+    }
+    // one statement for all genres of the song
+    if (!values.empty())
+    {
+      strSQL = "INSERT INTO song_genre (idGenre, idSong, iOrder) VALUES " + values;
       if (!ExecuteQuery(strSQL))
         return false;
     }
@@ -3012,6 +3104,10 @@ void CMusicDatabase::EmptyCache()
 {
   m_genreCache.erase(m_genreCache.begin(), m_genreCache.end());
   m_pathCache.erase(m_pathCache.begin(), m_pathCache.end());
+  m_roleCache.clear();
+  m_artistCache.clear();
+  m_artistSortCache.clear();
+  m_songArtists = SongArtists();
 }
 
 bool CMusicDatabase::Search(const std::string& search, CFileItemList &items)
@@ -3419,6 +3515,8 @@ bool CMusicDatabase::CleanupOrphanedItems()
   if (nullptr == m_pDS)
     return false;
   SetLibraryLastUpdated();
+  // the ids of removed items must not be reused from the caches
+  EmptyCache();
   if (!CleanupAlbums()) return false;
   if (!CleanupArtists()) return false;
   if (!CleanupGenres()) return false;
@@ -3438,6 +3536,7 @@ int CMusicDatabase::Cleanup(CGUIDialogProgress* progressDialog /*= nullptr*/)
   unsigned int time = XbmcThreads::SystemClockMillis();
   CLog::Log(LOGNOTICE, "%s: Starting musicdatabase cleanup ..", __FUNCTION__);
   CServiceBroker::GetAnnouncementManager()->Announce(ANNOUNCEMENT::AudioLibrary, "xbmc", "OnCleanStarted");
+  EmptyCache();
 
   // first cleanup any songs with invalid paths
   if (progressDialog)
@@ -4779,18 +4878,52 @@ bool CMusicDatabase::GetSongsByWhere(const std::string &baseDir, const Filter &f
     if (!BuildSQL(strSQLExtra, extFilter, strSQLExtra))
       return false;
 
-    // Apply the limiting directly here if there's no special sorting but limiting
+    // sort methods the database can reproduce exactly are ordered and paged by the query,
+    // everything else is sorted in memory further down
+    std::string orderBy;
+    if (sortDescription.sortBy != SortByNone && extFilter.group.empty() &&
+        extFilter.order.empty() && extFilter.limit.empty())
+      orderBy = DatabaseUtils::BuildOrderByClause(sortDescription, MediaTypeSong);
+
+    // Apply the limiting directly here if the rows are returned in their final order
     if (extFilter.limit.empty() &&
-        sortDescription.sortBy == SortByNone &&
+       (sortDescription.sortBy == SortByNone || !orderBy.empty()) &&
        (sortDescription.limitStart > 0 || sortDescription.limitEnd > 0))
     {
       total = (int)strtol(GetSingleValue(PrepareSQL(strSQL, "COUNT(1)") + strSQLExtra, m_pDS).c_str(), NULL, 10);
-      strSQLExtra += DatabaseUtils::BuildLimitClause(sortDescription.limitEnd, sortDescription.limitStart);
+      strSQLExtra += orderBy + DatabaseUtils::BuildLimitClause(sortDescription.limitEnd, sortDescription.limitStart);
     }
+    else
+      strSQLExtra += orderBy;
 
     strSQL = PrepareSQL(strSQL, !filter.fields.empty() && filter.fields.compare("*") != 0 ? filter.fields.c_str() : "songview.*") + strSQLExtra;
 
     CLog::Log(LOGDEBUG, "%s query = %s", __FUNCTION__, strSQL.c_str());
+
+    // if the rows come back in their final order read them one by one instead of holding the
+    // whole result in memory
+    if (sortDescription.sortBy == SortByNone || !orderBy.empty())
+    {
+      if (!m_pDS->query_forward(strSQL))
+        return false;
+
+      int count = 0;
+      while (!m_pDS->eof())
+      {
+        CFileItemPtr item(new CFileItem);
+        GetFileItemFromDataset(m_pDS->get_sql_record(), item.get(), musicUrl);
+        // HACK for sorting by database returned order
+        item->m_iprogramCount = ++count;
+        items.Add(item);
+        m_pDS->next();
+      }
+      m_pDS->close();
+
+      if (count > 0)
+        items.SetProperty("total", std::max(total, count));
+      return true;
+    }
+
     // run query
     if (!m_pDS->query(strSQL))
       return false;
@@ -7491,6 +7624,8 @@ void CMusicDatabase::UpdateTables(int version)
     // and filled as part of scanning anyway so simply force full rescan.
     MigrateSources();
   }
+  if (version < 73)
+    CreateChangeLogTable();
 
   // Set the verion of tag scanning required.
   // Not every schema change requires the tags to be rescanned, set to the highest schema version
@@ -7511,7 +7646,7 @@ void CMusicDatabase::UpdateTables(int version)
 
 int CMusicDatabase::GetSchemaVersion() const
 {
-  return 72;
+  return 73;
 }
 
 int CMusicDatabase::GetMusicNeedsTagScan()
@@ -9057,10 +9192,9 @@ bool CMusicDatabase::SetPathHash(const std::string &path, const std::string &has
     int idPath = AddPath(path);
     if (idPath < 0) return false;
 
+    // marks the path as scanned, a write batch stores it together with the items of the path
     std::string strSQL=PrepareSQL("update path set strHash='%s' where idPath=%ld", hash.c_str(), idPath);
-    m_pDS->exec(strSQL);
-
-    return true;
+    return ExecuteBatchMarker(strSQL);
   }
   catch (...)
   {
@@ -9251,6 +9385,64 @@ bool CMusicDatabase::SetSongUserrating(int idSong, int userrating)
   return false;
 }
 
+bool CMusicDatabase::GetSongsWithoutReplayGain(std::map<int, std::string>& songs)
+{
+  try
+  {
+    if (nullptr == m_pDB)
+      return false;
+    if (nullptr == m_pDS)
+      return false;
+
+    songs.clear();
+
+    std::string sql = "SELECT idSong, strPath, strFileName FROM song "
+                      "JOIN path ON song.idPath = path.idPath "
+                      "WHERE (strReplayGain IS NULL OR strReplayGain = '') "
+                      "AND iStartOffset = 0 AND iEndOffset = 0";
+    if (!m_pDS->query(sql))
+      return false;
+    while (!m_pDS->eof())
+    {
+      songs.insert(std::make_pair(m_pDS->fv("idSong").get_asInt(),
+                                  URIUtils::AddFileToFolder(m_pDS->fv("strPath").get_asString(),
+                                                            m_pDS->fv("strFileName").get_asString())));
+      m_pDS->next();
+    }
+    m_pDS->close();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed", __FUNCTION__);
+  }
+  return false;
+}
+
+bool CMusicDatabase::SetSongReplayGain(int idSong, const ReplayGain& replayGain)
+{
+  try
+  {
+    if (nullptr == m_pDB)
+      return false;
+    if (nullptr == m_pDS)
+      return false;
+
+    std::string strReplayGain = replayGain.Get();
+    if (strReplayGain.empty())
+      strReplayGain = "-1000, -1,-1000, -1";
+
+    std::string sql = PrepareSQL("UPDATE song SET strReplayGain='%s' WHERE idSong = %i", strReplayGain.c_str(), idSong);
+    m_pDS->exec(sql);
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s (%i) failed", __FUNCTION__, idSong);
+  }
+  return false;
+}
+
 bool CMusicDatabase::SetAlbumUserrating(const int idAlbum, int userrating)
 {
   try
@@ -9342,13 +9534,31 @@ int CMusicDatabase::GetSongIDFromPath(const std::string &filePath)
 bool CMusicDatabase::CommitTransaction()
 {
   if (CDatabase::CommitTransaction())
-  { // number of items in the db has likely changed, so reset the infomanager cache
-    CGUIComponent* gui = CServiceBroker::GetGUI();
-    if (gui)
-    {
-      gui->GetInfoManager().GetInfoProviders().GetLibraryInfoProvider().SetLibraryBool(LIBRARY_HAS_MUSIC, GetSongsCount() > 0);
+  {
+    // a write batch refreshes the cache once it commits
+    if (IsWriteBatchActive())
       return true;
-    }
+    return UpdateLibraryHasMusic();
+  }
+  return false;
+}
+
+bool CMusicDatabase::CommitWriteBatch()
+{
+  const bool active = IsWriteBatchActive();
+  if (CDatabase::CommitWriteBatch())
+    return !active || UpdateLibraryHasMusic();
+  return false;
+}
+
+bool CMusicDatabase::UpdateLibraryHasMusic()
+{
+  // number of items in the db has likely changed, so reset the infomanager cache
+  CGUIComponent* gui = CServiceBroker::GetGUI();
+  if (gui)
+  {
+    gui->GetInfoManager().GetInfoProviders().GetLibraryInfoProvider().SetLibraryBool(LIBRARY_HAS_MUSIC, GetSongsCount() > 0);
+    return true;
   }
   return false;
 }
@@ -9659,6 +9869,11 @@ void CMusicDatabase::ExportToXML(const CLibExportSettings& settings,  CGUIDialog
                         settings.m_skipnfo && !settings.m_artwork);
 
   int iFailCount = 0;
+  // the art is copied in the background while the items are written, and the
+  // single file is written one item at a time instead of building it in memory
+  CTextureExportQueue artQueue;
+  CXMLElementWriter xmlWriter;
+  std::string xmlFile;
   try
   {
     if (nullptr == m_pDB)
@@ -9677,8 +9892,12 @@ void CMusicDatabase::ExportToXML(const CLibExportSettings& settings,  CGUIDialog
       pMain = &xmlDoc;
     else if (settings.IsSingleFile())
     {
-      TiXmlElement xmlMainElement("musicdb");
-      pMain = xmlDoc.InsertEndChild(xmlMainElement);
+      xmlFile = URIUtils::AddFileToFolder(strFolder, "kodi_musicdb" + CDateTime::GetCurrentDateTime().GetAsDBDate() + ".xml");
+      if (CFile::Exists(xmlFile))
+        xmlFile = URIUtils::AddFileToFolder(strFolder, "kodi_musicdb" + CDateTime::GetCurrentDateTime().GetAsSaveString() + ".xml");
+      if (!xmlWriter.Open(xmlFile, "musicdb"))
+        return;
+      pMain = xmlWriter.GetRoot();
     }
 
     if (settings.IsItemExported(ELIBEXPORT_ALBUMS) && !artistfoldersonly)
@@ -9717,6 +9936,7 @@ void CMusicDatabase::ExportToXML(const CLibExportSettings& settings,  CGUIDialog
         {
           // Save album to xml, including album path
           album.Save(pMain, "album", strAlbumPath);
+          xmlWriter.Flush();
         }
         else
         { // Separate files and artwork
@@ -9801,7 +10021,7 @@ void CMusicDatabase::ExportToXML(const CLibExportSettings& settings,  CGUIDialog
                     savedArtfile = URIUtils::AddFileToFolder(strPath, "folder");
                   else
                     savedArtfile = URIUtils::AddFileToFolder(strPath, art.first);
-                  CTextureCache::GetInstance().Export(art.second, savedArtfile, settings.m_overwrite);
+                  artQueue.Export(art.second, savedArtfile, settings.m_overwrite);
                 }
               }
             }
@@ -9825,7 +10045,7 @@ void CMusicDatabase::ExportToXML(const CLibExportSettings& settings,  CGUIDialog
     // Export song playback history to single file only
     if (settings.IsSingleFile() && settings.IsItemExported(ELIBEXPORT_SONGS))
     {
-      if (!ExportSongHistory(pMain, progressDialog))
+      if (!ExportSongHistory(xmlWriter, progressDialog))
         return;
     }
 
@@ -9885,6 +10105,7 @@ void CMusicDatabase::ExportToXML(const CLibExportSettings& settings,  CGUIDialog
               XMLUtils::SetString(&additionalNode, i.first.c_str(), i.second);
             pMain->LastChild()->InsertEndChild(additionalNode);
           }
+          xmlWriter.Flush();
         }
         else
         { // Separate files: artist.nfo and artwork in strFolder/<artist name>
@@ -9929,7 +10150,7 @@ void CMusicDatabase::ExportToXML(const CLibExportSettings& settings,  CGUIDialog
                       savedArtfile = URIUtils::AddFileToFolder(strPath, "folder");
                     else
                       savedArtfile = URIUtils::AddFileToFolder(strPath, art.first);
-                    CTextureCache::GetInstance().Export(art.second, savedArtfile, settings.m_overwrite);
+                    artQueue.Export(art.second, savedArtfile, settings.m_overwrite);
                   }
                 }
               }
@@ -9950,12 +10171,12 @@ void CMusicDatabase::ExportToXML(const CLibExportSettings& settings,  CGUIDialog
       }
     }
 
+    artQueue.Wait();
+
     if (settings.IsSingleFile())
     {
-      std::string xmlFile = URIUtils::AddFileToFolder(strFolder, "kodi_musicdb" + CDateTime::GetCurrentDateTime().GetAsDBDate() + ".xml");
-      if (CFile::Exists(xmlFile))
-        xmlFile = URIUtils::AddFileToFolder(strFolder, "kodi_musicdb" + CDateTime::GetCurrentDateTime().GetAsSaveString() + ".xml");
-      xmlDoc.SaveFile(xmlFile);
+      if (!xmlWriter.Close())
+        iFailCount++;
 
       CVariant data;
       data["file"] = xmlFile;
@@ -9977,7 +10198,7 @@ void CMusicDatabase::ExportToXML(const CLibExportSettings& settings,  CGUIDialog
     HELPERS::ShowOKDialogLines(CVariant{20196}, CVariant{StringUtils::Format(g_localizeStrings.Get(15011).c_str(), iFailCount)});
 }
 
-bool CMusicDatabase::ExportSongHistory(TiXmlNode* pNode, CGUIDialogProgress* progressDialog)
+bool CMusicDatabase::ExportSongHistory(CXMLElementWriter& writer, CGUIDialogProgress* progressDialog)
 {
   try
   {
@@ -9997,7 +10218,7 @@ bool CMusicDatabase::ExportSongHistory(TiXmlNode* pNode, CGUIDialogProgress* pro
     while (!m_pDS->eof())
     {
       TiXmlElement songElement("song");
-      TiXmlNode* song = pNode->InsertEndChild(songElement);
+      TiXmlNode* song = writer.GetRoot()->InsertEndChild(songElement);
 
       XMLUtils::SetInt(song, "idsong", m_pDS->fv("idSong").get_asInt());
       XMLUtils::SetString(song, "artistdesc", m_pDS->fv("strArtistDisp").get_asString());
@@ -10019,6 +10240,8 @@ bool CMusicDatabase::ExportSongHistory(TiXmlNode* pNode, CGUIDialogProgress* pro
       if (userrating)
         userrating->ToElement()->SetAttribute("max", 10);
 
+      if ((current % 100) == 0)
+        writer.Flush();
       if ((current % 100) == 0 && progressDialog)
       {
         progressDialog->SetLine(1, CVariant{ m_pDS->fv("strAlbum").get_asString() });
@@ -10571,6 +10794,7 @@ void CMusicDatabase::SetArtForItem(int mediaId, const std::string &mediaType, co
       sql = PrepareSQL("INSERT INTO art(media_id, media_type, type, url) VALUES (%d, '%s', '%s', '%s')", mediaId, mediaType.c_str(), artType.c_str(), url.c_str());
       m_pDS->exec(sql);
     }
+    artRevision++;
   }
   catch (...)
   {
@@ -10689,6 +10913,97 @@ bool CMusicDatabase::GetArtForItem(int songId, int albumId, int artistId, bool b
   return false;
 }
 
+bool CMusicDatabase::GetArtForItems(const MediaType &mediaType, const std::vector<int> &mediaIds, std::map<int, std::vector<ArtForThumbLoader> > &art)
+{
+  std::string strSQL;
+  try
+  {
+    if (nullptr == m_pDB)
+      return false;
+    if (nullptr == m_pDS2)
+      return false; // using dataset 2 as we're likely called in loops on dataset 1
+    if (mediaIds.empty())
+      return true;
+
+    std::string ids;
+    for (int id : mediaIds)
+    {
+      if (!ids.empty())
+        ids += ",";
+      ids += StringUtils::Format("%i", id);
+      art[id];
+    }
+
+    // Same art as GetArtForItem() fetches for each of the items, key_id is the id of the item
+    // the row belongs to
+    strSQL = PrepareSQL(
+      "SELECT media_id as key_id, art_id, media_type, type, '' as prefix, url, 0 as iorder FROM art "
+      "WHERE media_type = '%s' AND media_id IN (%s)",
+      mediaType.c_str(), ids.c_str());
+    if (mediaType == MediaTypeAlbum)
+    {
+      strSQL += PrepareSQL(
+        " UNION SELECT album_artist.idAlbum as key_id, art_id, media_type, type, 'albumartist' as prefix, "
+        "url, album_artist.iOrder as iorder FROM art "
+        "JOIN album_artist ON art.media_id = album_artist.idArtist AND art.media_type ='%s' "
+        "WHERE album_artist.idAlbum IN (%s)",
+        MediaTypeArtist, ids.c_str());
+    }
+    else if (mediaType == MediaTypeSong)
+    {
+      strSQL += PrepareSQL(
+        " UNION SELECT song.idSong as key_id, art_id, media_type, type, '' as prefix, "
+        "url, 0 as iorder FROM art "
+        "JOIN song ON art.media_id = song.idAlbum AND art.media_type ='%s' "
+        "WHERE song.idSong IN (%s)",
+        MediaTypeAlbum, ids.c_str());
+      strSQL += PrepareSQL(
+        " UNION SELECT song.idSong as key_id, art_id, media_type, type, 'albumartist' as prefix, "
+        "url, album_artist.iOrder as iorder FROM art "
+        "JOIN album_artist ON art.media_id = album_artist.idArtist AND art.media_type ='%s' "
+        "JOIN song ON song.idAlbum = album_artist.idAlbum "
+        "WHERE song.idSong IN (%s)",
+        MediaTypeArtist, ids.c_str());
+      strSQL += PrepareSQL(
+        " UNION SELECT song_artist.idSong as key_id, art_id, media_type, type, 'artist' as prefix, "
+        "url, song_artist.iOrder as iorder FROM art "
+        "JOIN song_artist on art.media_id = song_artist.idArtist AND art.media_type = '%s' "
+        "WHERE song_artist.idSong IN (%s) AND song_artist.idRole = %i",
+        MediaTypeArtist, ids.c_str(), ROLE_ARTIST);
+    }
+    else if (mediaType != MediaTypeArtist)
+      return false;
+
+    m_pDS2->query(strSQL);
+    while (!m_pDS2->eof())
+    {
+      ArtForThumbLoader artitem;
+      artitem.artType = m_pDS2->fv("type").get_asString();
+      artitem.mediaType = m_pDS2->fv("media_type").get_asString();
+      artitem.prefix = m_pDS2->fv("prefix").get_asString();
+      artitem.url = m_pDS2->fv("url").get_asString();
+      int iOrder = m_pDS2->fv("iorder").get_asInt();
+      if (iOrder > 0)
+        artitem.prefix += m_pDS2->fv("iorder").get_asString();
+
+      art[m_pDS2->fv("key_id").get_asInt()].emplace_back(artitem);
+      m_pDS2->next();
+    }
+    m_pDS2->close();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s(%s) failed", __FUNCTION__, strSQL.c_str());
+  }
+  return false;
+}
+
+unsigned int CMusicDatabase::GetArtRevision()
+{
+  return artRevision;
+}
+
 bool CMusicDatabase::GetArtForItem(int mediaId, const std::string &mediaType, std::map<std::string, std::string> &art)
 {
   try
@@ -10723,6 +11038,7 @@ std::string CMusicDatabase::GetArtForItem(int mediaId, const std::string &mediaT
 
 bool CMusicDatabase::RemoveArtForItem(int mediaId, const MediaType & mediaType, const std::string & artType)
 {
+  artRevision++;
   return ExecuteQuery(PrepareSQL("DELETE FROM art WHERE media_id=%i AND media_type='%s' AND type='%s'", mediaId, mediaType.c_str(), artType.c_str()));
 }
 
@@ -10735,6 +11051,32 @@ bool CMusicDatabase::RemoveArtForItem(int mediaId, const MediaType & mediaType,
   return result;
 }
 
+bool CMusicDatabase::GetArtURLs(std::vector<std::string> &urls)
+{
+  try
+  {
+    if (nullptr == m_pDB)
+      return false;
+    if (nullptr == m_pDS)
+      return false;
+
+    if (!m_pDS->query("SELECT DISTINCT url FROM art")) return false;
+    urls.reserve(urls.size() + m_pDS->num_rows());
+    while (!m_pDS->eof())
+    {
+      urls.emplace_back(m_pDS->fv(0).get_asString());
+      m_pDS->next();
+    }
+    m_pDS->close();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed", __FUNCTION__);
+  }
+  return false;
+}
+
 bool CMusicDatabase::GetArtTypes(const MediaType &mediaType, std::vector<std::string> &artTypes)
 {
   try
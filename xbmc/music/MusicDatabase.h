@@ -80,6 +80,7 @@ typedef struct {
 
 class CGUIDialogProgress;
 class CFileItemList;
+class CXMLElementWriter;
 
 /*!
  \ingroup music
@@ -105,6 +106,7 @@ public:
 
   bool Open() override;
   bool CommitTransaction() override;
+  bool CommitWriteBatch() override;
   void EmptyCache();
   void Clean();
   int  Cleanup(CGUIDialogProgress* progressDialog = nullptr);
@@ -202,6 +204,17 @@ public:
   bool SetSongUserrating(const std::string &filePath, int userrating);
   bool SetSongUserrating(int idSong, int userrating);
   bool SetSongVotes(const std::string &filePath, int votes);
+  /*!
+   \brief Get the songs that have no replay gain yet, leaving out those of cue sheets
+   \param songs [out] Paths of the files by song id
+   \return true if the query succeeded
+   */
+  bool GetSongsWithoutReplayGain(std::map<int, std::string>& songs);
+  /*!
+   \brief Store the replay gain of a song, one without any gain is stored as
+   measured so it is not returned by GetSongsWithoutReplayGain() again
+   */
+  bool SetSongReplayGain(int idSong, const ReplayGain& replayGain);
   int  GetSongByArtistAndAlbumAndTitle(const std::string& strArtist, const std::string& strAlbum, const std::string& strTitle);
 
   /////////////////////////////////////////////////
@@ -496,7 +509,7 @@ public:
   // XML
   /////////////////////////////////////////////////
   void ExportToXML(const CLibExportSettings& settings, CGUIDialogProgress* progressDialog = nullptr);
-  bool ExportSongHistory(TiXmlNode* pNode, CGUIDialogProgress* progressDialog = nullptr);
+  bool ExportSongHistory(CXMLElementWriter& writer, CGUIDialogProgress* progressDialog = nullptr);
   void ImportFromXML(const std::string& xmlFile, CGUIDialogProgress* progressDialog = nullptr);
   bool ImportSongHistory(const std::string& xmlFile, const int total, CGUIDialogProgress* progressDialog = nullptr);
 
@@ -549,6 +562,22 @@ public:
   */
   bool GetArtForItem(int songId, int albumId, int artistId, bool bPrimaryArtist, std::vector<ArtForThumbLoader> &art);
 
+  /*! \brief Fetch all related art for several database items of the same media type.
+  Fetches with a single query what GetArtForItem() fetches for each of the songs, albums or artists,
+  art for the related album and artists of songs and for the album artists of albums included.
+  \param mediaType the type of media of the items, "song", "album" or "artist".
+  \param mediaIds the ids of the items.
+  \param art [out] the art of each item by id, items without art get an empty vector.
+  \return true if the art was retrieved, false on error.
+  \sa GetArtForItem
+  */
+  bool GetArtForItems(const MediaType &mediaType, const std::vector<int> &mediaIds, std::map<int, std::vector<ArtForThumbLoader> > &art);
+
+  /*! \brief Get a counter that changes whenever art of any item is set or removed in this process.
+  Art edited by other clients of a shared database isn't counted, see GetChangeRevision().
+  */
+  static unsigned int GetArtRevision();
+
   /*! \brief Fetch art for a database item.
    Fetches multiple pieces of art for a database item.
    \param mediaId the id in the media (song/artist/album) table.
@@ -596,6 +625,12 @@ public:
   */
   bool GetArtTypes(const MediaType &mediaType, std::vector<std::string> &artTypes);
 
+  /*! \brief Fetch the distinct urls of all art held in the database.
+  \param urls [out] the urls of the art
+  \return true if the query succeeded, false otherwise.
+  */
+  bool GetArtURLs(std::vector<std::string> &urls);
+
   /*! \brief Fetch the distinct types of available-but-unassigned art held in the
   database for a specific media item.
   \param mediaId the id in the media (artist/album) table.
@@ -630,6 +665,19 @@ void SetLibraryLastUpdated();
 protected:
   std::map<std::string, int> m_genreCache;
   std::map<std::string, int> m_pathCache;
+  std::map<std::string, int> m_roleCache; // lower case role names
+  std::map<std::pair<std::string, std::string>, int> m_artistCache; // MusicBrainz ID and lower case name
+  std::set<std::pair<int, std::string>> m_artistSortCache; // sort names already applied to an artist
+
+  /*! \brief Artists of the song being added, to resolve its contributors without queries.
+   Complete when all of them were added since the song was created or its artists deleted.
+   */
+  struct SongArtists
+  {
+    int idSong = -1;
+    bool complete = false;
+    std::map<std::string, int> artists; // lower case name
+  } m_songArtists;
 
   void CreateTables() override;
   void CreateAnalytics() override;
@@ -645,6 +693,10 @@ private:
 
   void SplitPath(const std::string& strFileNameAndPath, std::string& strPath, std::string& strFileName);
 
+  bool UpdateLibraryHasMusic();
+
+  int AddArtistToDatabase(const std::string& strArtist, const std::string& strMusicBrainzArtistID, bool bScrapedMBID);
+
   CSong GetSongFromDataset();
   CSong GetSongFromDataset(const dbiplus::sql_record* const record, int offset = 0);
   CArtist GetArtistFromDataset(dbiplus::Dataset* pDS, int offset = 0, bool needThumb = true);
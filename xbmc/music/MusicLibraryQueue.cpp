@@ -14,14 +14,18 @@
 #include "dialogs/GUIDialogProgress.h"
 #include "guilib/GUIComponent.h"
 #include "guilib/GUIWindowManager.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "music/jobs/MusicLibraryCleaningJob.h"
 #include "music/jobs/MusicLibraryExportJob.h"
 #include "music/jobs/MusicLibraryImportJob.h"
 #include "music/jobs/MusicLibraryJob.h"
+#include "music/jobs/MusicLibraryLoudnessJob.h"
 #include "music/jobs/MusicLibraryScanningJob.h"
 #include "threads/SingleLock.h"
 #include "utils/Variant.h"
 
+#include <cstring>
 #include <utility>
 
 CMusicLibraryQueue::CMusicLibraryQueue()
@@ -228,6 +232,19 @@ void CMusicLibraryQueue::AddJob(CMusicLibraryJob *job)
     return;
 
   CSingleLock lock(m_critical);
+
+  // measuring the loudness can take hours, it is queued again after the next scan
+  if (strcmp(job->GetType(), "MusicLibraryLoudnessJob") != 0)
+  {
+    MusicLibraryJobMap::const_iterator loudnessJobs = m_jobs.find("MusicLibraryLoudnessJob");
+    if (loudnessJobs != m_jobs.end())
+    {
+      MusicLibraryJobs tmpLoudnessJobs(loudnessJobs->second.begin(), loudnessJobs->second.end());
+      for (const auto& loudnessJob : tmpLoudnessJobs)
+        CancelJob(loudnessJob);
+    }
+  }
+
   if (!CJobQueue::AddJob(job))
     return;
 
@@ -296,6 +313,10 @@ void CMusicLibraryQueue::OnJobComplete(unsigned int jobID, bool success, CJob *j
   {
     if (QueueEmpty())
       Refresh();
+
+    if (strcmp(job->GetType(), "MusicLibraryScanningJob") == 0 &&
+        CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bMusicLibraryAnalyseLoudness)
+      AddJob(new CMusicLibraryLoudnessJob());
   }
 
   {
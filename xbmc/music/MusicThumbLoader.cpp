@@ -15,10 +15,26 @@
 #include "music/tags/MusicInfoTagLoaderFactory.h"
 #include "video/VideoThumbLoader.h"
 
+#include <set>
 #include <utility>
 
 using namespace MUSIC_INFO;
 
+namespace
+{
+// items whose art is fetched with one query, a few screens of a list
+constexpr size_t PREFETCH_ITEMS = 200;
+// the art of large libraries isn't kept around after the list was left
+constexpr size_t MAX_CACHED_ITEMS = 10000;
+
+bool IsLibraryItem(const CMusicInfoTag& tag)
+{
+  return tag.GetDatabaseId() > -1 && (tag.GetType() == MediaTypeSong ||
+                                      tag.GetType() == MediaTypeAlbum ||
+                                      tag.GetType() == MediaTypeArtist);
+}
+}
+
 CMusicThumbLoader::CMusicThumbLoader() : CThumbLoader()
 {
   m_musicDatabase = new CMusicDatabase;
@@ -32,17 +48,64 @@ CMusicThumbLoader::~CMusicThumbLoader()
 void CMusicThumbLoader::OnLoaderStart()
 {
   m_musicDatabase->Open();
-  m_albumArt.clear();
+
+  // art cached by earlier loads is kept as long as no item of the library changed, the
+  // changelog includes the writes of other clients of a shared database
+  const int changeRevision = m_musicDatabase->GetChangeRevision();
+  if (changeRevision < 0 || changeRevision != m_changeRevision || m_artCache.size() > MAX_CACHED_ITEMS)
+    m_artCache.clear();
+  m_changeRevision = changeRevision;
+
+  m_nextPrefetch = 0;
+  PrefetchLibraryArt();
   CThumbLoader::OnLoaderStart();
 }
 
 void CMusicThumbLoader::OnLoaderFinish()
 {
   m_musicDatabase->Close();
-  m_albumArt.clear();
   CThumbLoader::OnLoaderFinish();
 }
 
+void CMusicThumbLoader::DropStaleArt()
+{
+  const unsigned int artRevision = CMusicDatabase::GetArtRevision();
+  if (artRevision != m_artRevision)
+  {
+    m_artCache.clear();
+    m_artRevision = artRevision;
+  }
+}
+
+void CMusicThumbLoader::PrefetchLibraryArt()
+{
+  DropStaleArt();
+
+  std::map<MediaType, std::set<int>> ids;
+  size_t count = 0;
+  for (; m_nextPrefetch < m_vecItems.size() && count < PREFETCH_ITEMS; ++m_nextPrefetch)
+  {
+    const CFileItemPtr& item = m_vecItems[m_nextPrefetch];
+    if (!item->HasMusicInfoTag() || item->GetProperty("libraryartfilled").asBoolean())
+      continue;
+
+    const CMusicInfoTag& tag = *item->GetMusicInfoTag();
+    if (IsLibraryItem(tag) &&
+        m_artCache.find(std::make_pair(tag.GetType(), tag.GetDatabaseId())) == m_artCache.end() &&
+        ids[tag.GetType()].insert(tag.GetDatabaseId()).second)
+      count++;
+  }
+
+  for (const auto& type : ids)
+  {
+    std::map<int, std::vector<ArtForThumbLoader>> art;
+    if (!m_musicDatabase->GetArtForItems(type.first, std::vector<int>(type.second.begin(), type.second.end()), art))
+      continue;
+    for (auto& it : art)
+      m_artCache[std::make_pair(type.first, it.first)] = std::move(it.second);
+  }
+}
+
 bool CMusicThumbLoader::LoadItem(CFileItem* pItem)
 {
   bool result  = LoadItemCached(pItem);
@@ -159,13 +222,25 @@ bool CMusicThumbLoader::FillLibraryArt(CFileItem &item)
   bool artfound(false);
   std::vector<ArtForThumbLoader> art;
   CMusicInfoTag &tag = *item.GetMusicInfoTag();
-  if (tag.GetDatabaseId() > -1 && (tag.GetType() == MediaTypeSong || 
-      tag.GetType() == MediaTypeAlbum || 
-      tag.GetType() == MediaTypeArtist))
+  if (IsLibraryItem(tag))
   {
     // Item in music library, fetch the art
     m_musicDatabase->Open();
-    if (tag.GetType() == MediaTypeSong)
+    DropStaleArt();
+    const std::pair<MediaType, int> key = std::make_pair(tag.GetType(), tag.GetDatabaseId());
+    auto cached = m_artCache.find(key);
+    if (cached == m_artCache.end() && m_nextPrefetch < m_vecItems.size())
+    {
+      PrefetchLibraryArt();
+      cached = m_artCache.find(key);
+    }
+
+    if (cached != m_artCache.end())
+    {
+      art = cached->second;
+      artfound = !art.empty();
+    }
+    else if (tag.GetType() == MediaTypeSong)
       artfound = m_musicDatabase->GetArtForItem(tag.GetDatabaseId(), tag.GetAlbumId(), -1, false, art);
     else if (tag.GetType() == MediaTypeAlbum)
       artfound = m_musicDatabase->GetArtForItem(-1, tag.GetDatabaseId(), -1, false, art);
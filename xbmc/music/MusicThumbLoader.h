@@ -8,12 +8,14 @@
 
 #pragma once
 
+#include "MusicDatabase.h"
 #include "ThumbLoader.h"
 
 #include <map>
+#include <utility>
+#include <vector>
 
 class CFileItem;
-class CMusicDatabase;
 class EmbeddedArt;
 
 class CMusicThumbLoader : public CThumbLoader
@@ -54,7 +56,18 @@ public:
   static bool GetEmbeddedThumb(const std::string &path, EmbeddedArt &art);
 
 protected:
+  /*! \brief Fetch the art of the next library items of the list with one query per media type
+   The art stays cached between loads until the library or any art changes.
+   */
+  void PrefetchLibraryArt();
+
+  /*! \brief Drop the cached art if art was set or removed since it was fetched */
+  void DropStaleArt();
+
   CMusicDatabase *m_musicDatabase;
-  typedef std::map<int, std::map<std::string, std::string> > ArtCache;
-  ArtCache m_albumArt;
+  typedef std::map<std::pair<MediaType, int>, std::vector<ArtForThumbLoader> > ArtCache;
+  ArtCache m_artCache;
+  size_t m_nextPrefetch = 0;
+  unsigned int m_artRevision = 0;
+  int m_changeRevision = -1;
 };
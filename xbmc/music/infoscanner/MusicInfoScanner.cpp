@@ -44,16 +44,23 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/SingleLock.h"
 #include "threads/SystemClock.h"
 #include "utils/Digest.h"
 #include "utils/FileExtensionProvider.h"
+#include "utils/JobManager.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
 
 #include <algorithm>
+#include <memory>
+#include <set>
 #include <utility>
+#include <vector>
 
 using namespace MUSIC_INFO;
 using namespace XFILE;
@@ -62,6 +69,44 @@ using namespace MUSIC_GRABBER;
 using namespace ADDON;
 using KODI::UTILITY::CDigest;
 
+namespace
+{
+// the tags of a folder, loaded by a few jobs and the scanner thread together
+struct STagLoadState
+{
+  STagLoadState() : idle(true, true) {}
+
+  std::vector<std::pair<CFileItemPtr, std::unique_ptr<IMusicInfoTagLoader>>> files;
+  CCriticalSection section;
+  size_t next = 0;
+  int active = 0;
+  bool aborted = false;
+  CEvent idle;
+};
+
+bool LoadNextTag(STagLoadState& state)
+{
+  size_t index;
+  {
+    CSingleLock lock(state.section);
+    if (state.aborted || state.next >= state.files.size())
+      return false;
+    index = state.next++;
+    if (state.active++ == 0)
+      state.idle.Reset();
+  }
+
+  auto& file = state.files[index];
+  file.second->Load(file.first->GetPath(), *file.first->GetMusicInfoTag());
+  file.second.reset();
+
+  CSingleLock lock(state.section);
+  if (--state.active == 0)
+    state.idle.Set();
+  return true;
+}
+}
+
 CMusicInfoScanner::CMusicInfoScanner()
 : m_fileCountReader(this, "MusicFileCounter")
 {
@@ -141,7 +186,14 @@ void CMusicInfoScanner::Process()
 
         // Clear list of albums added by this scan
         m_albumsAdded.clear();
+
+        // write the albums in groups, a path is only marked as scanned together with its
+        // songs. Scraping below runs outside of the batch.
+        const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+        m_musicDatabase.BeginWriteBatch(advancedSettings->m_iMusicLibraryWriteBatchSize,
+                                        advancedSettings->m_iMusicLibraryWriteBatchTime);
         bool scancomplete = DoScan(it);
+        m_musicDatabase.CommitWriteBatch();
         if (scancomplete)
         {
           if (m_albumsAdded.size() > 0)
@@ -261,6 +313,7 @@ void CMusicInfoScanner::Process()
   }
   catch (...)
   {
+    m_musicDatabase.CommitWriteBatch();
     CLog::Log(LOGERROR, "MusicInfoScanner: Exception while scanning.");
   }
   m_musicDatabase.Close();
@@ -555,6 +608,11 @@ CInfoScanner::INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items,
 {
   std::vector<std::string> regexps = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_audioExcludeFromScanRegExps;
 
+  // files whose tags were read ahead, whether they had any or not
+  std::set<const CFileItem*> loadedItems;
+  if (LoadTags(items, regexps, loadedItems) == INFO_CANCELLED)
+    return INFO_CANCELLED;
+
   for (int i = 0; i < items.Size(); ++i)
   {
     if (m_bStop)
@@ -571,7 +629,7 @@ CInfoScanner::INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items,
     m_currentItem++;
 
     CMusicInfoTag& tag = *pItem->GetMusicInfoTag();
-    if (!tag.Loaded())
+    if (!tag.Loaded() && loadedItems.find(pItem.get()) == loadedItems.end())
     {
       std::unique_ptr<IMusicInfoTagLoader> pLoader (CMusicInfoTagLoaderFactory::CreateLoader(*pItem));
       if (nullptr != pLoader)
@@ -600,6 +658,64 @@ CInfoScanner::INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items,
   return INFO_ADDED;
 }
 
+CInfoScanner::INFO_RET CMusicInfoScanner::LoadTags(const CFileItemList& items,
+                                                   const std::vector<std::string>& regexps,
+                                                   std::set<const CFileItem*>& loadedItems)
+{
+  const int threads = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iMusicLibraryTagLoaderThreads;
+  if (threads <= 1)
+    return INFO_ADDED;
+
+  std::shared_ptr<STagLoadState> state = std::make_shared<STagLoadState>();
+  for (int i = 0; i < items.Size(); ++i)
+  {
+    const CFileItemPtr& pItem = items[i];
+    if (pItem->m_bIsFolder || pItem->IsPlayList() || pItem->IsPicture() || pItem->IsLyrics() ||
+        pItem->GetMusicInfoTag()->Loaded())
+      continue;
+
+    // discs and the database don't like to be read from several threads
+    if (pItem->IsCDDA() || pItem->IsMusicDb() || CUtil::ExcludeFileOrFolder(pItem->GetPath(), regexps))
+      continue;
+
+    std::unique_ptr<IMusicInfoTagLoader> loader(CMusicInfoTagLoaderFactory::CreateLoader(*pItem));
+    if (loader)
+      state->files.emplace_back(pItem, std::move(loader));
+  }
+
+  if (state->files.size() < 2)
+    return INFO_ADDED;
+
+  // the scanner thread reads tags as well, jobs that start late find nothing left to do
+  const size_t jobs = std::min(static_cast<size_t>(threads - 1), state->files.size() - 1);
+  for (size_t i = 0; i < jobs; ++i)
+    CJobManager::GetInstance().Submit([state]() { while (LoadNextTag(*state)); }, CJob::PRIORITY_LOW);
+
+  while (!m_bStop && LoadNextTag(*state))
+    ;
+
+  {
+    CSingleLock lock(state->section);
+    state->aborted = true;
+  }
+  while (true)
+  {
+    {
+      CSingleLock lock(state->section);
+      if (state->active == 0)
+        break;
+    }
+    state->idle.WaitMSec(100);
+  }
+
+  if (m_bStop)
+    return INFO_CANCELLED;
+
+  for (const auto& file : state->files)
+    loadedItems.insert(file.first.get());
+  return INFO_ADDED;
+}
+
 static bool SortSongsByTrack(const CSong& song, const CSong& song2)
 {
   return song.iTrack < song2.iTrack;
@@ -912,6 +1028,7 @@ int CMusicInfoScanner::RetrieveMusicInfo(const std::string& strDirectory, CFileI
 
     album.strPath = strDirectory;
     m_musicDatabase.AddAlbum(album, m_idSourcePath);
+    m_musicDatabase.EndWriteBatchItem();
     m_albumsAdded.insert(album.idAlbum);
 
     numAdded += album.songs.size();
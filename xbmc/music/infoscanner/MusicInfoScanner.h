@@ -15,6 +15,10 @@
 #include "threads/IRunnable.h"
 #include "threads/Thread.h"
 
+#include <set>
+#include <string>
+#include <vector>
+
 class CAlbum;
 class CArtist;
 class CGUIDialogProgressBarHandle;
@@ -207,6 +211,15 @@ protected:
    \param scannedItems [in] list to populate with the scannedItems
    */
   INFO_RET ScanTags(const CFileItemList& items, CFileItemList& scannedItems);
+
+  /*! \brief Read the tags of a bunch of FileItems ahead on several threads
+   Only done when more than one tag loader thread is configured. Discs and items from the
+   database are left to ScanTags.
+   \param items [in] list of FileItems to read the tags for
+   \param regexps [in] exclude expressions, matching files are skipped
+   \param loadedItems [out] items that were read, whether they had a tag or not
+   */
+  INFO_RET LoadTags(const CFileItemList& items, const std::vector<std::string>& regexps, std::set<const CFileItem*>& loadedItems);
   int GetPathHash(const CFileItemList &items, std::string &hash);
   void GetAlbumArtwork(long id, const CAlbum &artist);
 
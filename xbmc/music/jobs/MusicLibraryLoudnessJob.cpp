@@ -0,0 +1,200 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "MusicLibraryLoudnessJob.h"
+
+#include "FileItem.h"
+#include "cores/paplayer/CodecFactory.h"
+#include "music/MusicDatabase.h"
+#include "music/tags/LoudnessMeter.h"
+#include "music/tags/ReplayGain.h"
+#include "utils/log.h"
+
+#include <cstring>
+#include <map>
+#include <memory>
+#include <vector>
+
+// ReplayGain 2.0 reference level
+#define REFERENCE_LOUDNESS -18.0
+
+#define READ_SIZE (64 * 1024)
+#define MAX_EMPTY_READS 100
+
+namespace
+{
+
+double GetChannelWeight(AEChannel channel)
+{
+  switch (channel)
+  {
+    case AE_CH_LFE:
+      return 0.0;
+    case AE_CH_BL:
+    case AE_CH_BR:
+    case AE_CH_SL:
+    case AE_CH_SR:
+      return 1.41;
+    default:
+      return 1.0;
+  }
+}
+
+template<typename T>
+void ToFloat(const uint8_t* data, unsigned int count, float offset, float scale, float* dest)
+{
+  const T* src = reinterpret_cast<const T*>(data);
+  for (unsigned int i = 0; i < count; i++)
+    dest[i] = (static_cast<float>(src[i]) - offset) * scale;
+}
+
+bool ConvertToFloat(AEDataFormat format, const uint8_t* data, unsigned int count, float* dest)
+{
+  switch (format)
+  {
+    case AE_FMT_U8:
+      ToFloat<uint8_t>(data, count, 128.0f, 1.0f / 128.0f, dest);
+      return true;
+    case AE_FMT_S16NE:
+      ToFloat<int16_t>(data, count, 0.0f, 1.0f / 32768.0f, dest);
+      return true;
+    case AE_FMT_S32NE:
+      ToFloat<int32_t>(data, count, 0.0f, 1.0f / 2147483648.0f, dest);
+      return true;
+    case AE_FMT_FLOAT:
+      memcpy(dest, data, count * sizeof(float));
+      return true;
+    case AE_FMT_DOUBLE:
+      ToFloat<double>(data, count, 0.0f, 1.0f, dest);
+      return true;
+    default:
+      return false;
+  }
+}
+
+} // unnamed namespace
+
+CMusicLibraryLoudnessJob::CMusicLibraryLoudnessJob()
+  : m_cancelled(false)
+{ }
+
+CMusicLibraryLoudnessJob::~CMusicLibraryLoudnessJob() = default;
+
+bool CMusicLibraryLoudnessJob::Cancel()
+{
+  m_cancelled = true;
+  return true;
+}
+
+bool CMusicLibraryLoudnessJob::IsCancelled() const
+{
+  // the job queue cancels the job without calling Cancel() on shutdown
+  return m_cancelled || ShouldCancel(0, 0);
+}
+
+bool CMusicLibraryLoudnessJob::operator==(const CJob* job) const
+{
+  if (strcmp(job->GetType(), GetType()) != 0)
+    return false;
+
+  const CMusicLibraryLoudnessJob* loudnessJob = dynamic_cast<const CMusicLibraryLoudnessJob*>(job);
+  if (loudnessJob == nullptr)
+    return false;
+
+  return true;
+}
+
+bool CMusicLibraryLoudnessJob::Work(CMusicDatabase &db)
+{
+  std::map<int, std::string> songs;
+  if (!db.GetSongsWithoutReplayGain(songs))
+    return false;
+  if (songs.empty())
+    return true;
+
+  CLog::Log(LOGNOTICE, "%s - measuring the loudness of %u songs", __FUNCTION__, static_cast<unsigned int>(songs.size()));
+
+  unsigned int done = 0;
+  for (const auto& song : songs)
+  {
+    if (IsCancelled())
+      break;
+
+    ReplayGain replayGain;
+    if (!Analyse(song.second, replayGain))
+    {
+      if (IsCancelled())
+        break;
+      CLog::Log(LOGDEBUG, "%s - unable to measure %s", __FUNCTION__, song.second.c_str());
+    }
+
+    // songs that failed are stored without gain so they are not decoded again
+    db.SetSongReplayGain(song.first, replayGain);
+    done++;
+  }
+
+  CLog::Log(LOGNOTICE, "%s - measured %u songs%s", __FUNCTION__, done, done < songs.size() ? " (aborted)" : "");
+  return true;
+}
+
+bool CMusicLibraryLoudnessJob::Analyse(const std::string& path, ReplayGain& replayGain)
+{
+  CFileItem item(path, false);
+  std::unique_ptr<ICodec> codec(CodecFactory::CreateCodecDemux(item, 0));
+  if (!codec || !codec->Init(item, 0))
+    return false;
+
+  const AEAudioFormat& format = codec->m_format;
+  const unsigned int channels = format.m_channelLayout.Count();
+  const unsigned int sampleSize = codec->m_bitsPerSample >> 3;
+  if (channels == 0 || sampleSize == 0 || format.m_sampleRate == 0)
+    return false;
+
+  std::vector<double> weights(channels);
+  for (unsigned int ch = 0; ch < channels; ch++)
+    weights[ch] = GetChannelWeight(format.m_channelLayout[ch]);
+
+  CLoudnessMeter meter(format.m_sampleRate, weights);
+
+  const unsigned int frameSize = sampleSize * channels;
+  std::vector<uint8_t> buffer(READ_SIZE - READ_SIZE % frameSize);
+  std::vector<float> samples(buffer.size() / sampleSize);
+
+  int emptyReads = 0;
+  while (!IsCancelled())
+  {
+    int size = 0;
+    const int ret = codec->ReadPCM(buffer.data(), buffer.size(), &size);
+    if (ret == READ_ERROR)
+      return false;
+
+    const unsigned int frames = size / frameSize;
+    if (frames > 0)
+    {
+      if (!ConvertToFloat(format.m_dataFormat, buffer.data(), frames * channels, samples.data()))
+        return false;
+      meter.Process(samples.data(), frames);
+      emptyReads = 0;
+    }
+    else if (ret == READ_SUCCESS && ++emptyReads > MAX_EMPTY_READS)
+      return false;
+
+    if (ret == READ_EOF)
+    {
+      double loudness;
+      if (!meter.GetIntegratedLoudness(loudness))
+        return false;
+
+      replayGain.SetGain(ReplayGain::TRACK, static_cast<float>(REFERENCE_LOUDNESS - loudness));
+      replayGain.SetPeak(ReplayGain::TRACK, meter.GetTruePeak());
+      return true;
+    }
+  }
+
+  return false;
+}
@@ -0,0 +1,48 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "music/jobs/MusicLibraryJob.h"
+
+#include <atomic>
+#include <string>
+
+class ReplayGain;
+
+/*!
+ \brief Music library job measuring the loudness of the songs without replay gain.
+
+ Each song is decoded and its EBU R128 integrated loudness and true peak are
+ stored as track replay gain, which PAPlayer applies when the song is played
+ from the library.
+ */
+class CMusicLibraryLoudnessJob : public CMusicLibraryJob
+{
+public:
+  CMusicLibraryLoudnessJob();
+  ~CMusicLibraryLoudnessJob() override;
+
+  // specialization of CMusicLibraryJob
+  bool CanBeCancelled() const override { return true; }
+  bool Cancel() override;
+
+  // specialization of CJob
+  const char *GetType() const override { return "MusicLibraryLoudnessJob"; }
+  bool operator==(const CJob* job) const override;
+
+protected:
+  // implementation of CMusicLibraryJob
+  bool Work(CMusicDatabase &db) override;
+
+private:
+  bool IsCancelled() const;
+  bool Analyse(const std::string& path, ReplayGain& replayGain);
+
+  std::atomic<bool> m_cancelled;
+};
@@ -0,0 +1,178 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "LoudnessMeter.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+
+// Blocks of 400 ms overlap by 75%, so they are summed up from 100 ms sub-blocks
+#define SUB_BLOCKS_PER_SECOND 10
+#define SUB_BLOCKS_PER_BLOCK  4
+
+#define ABSOLUTE_GATE_LUFS -70.0
+#define RELATIVE_GATE_LU   -10.0
+
+// Polyphase FIR for the 4x oversampling of the true peak, ITU-R BS.1770-4 Annex 2
+const float TRUE_PEAK_COEFFS[4][12] = {
+  {  0.0017089843750f,  0.0109863281250f, -0.0196533203125f,  0.0332031250000f,
+    -0.0594482421875f,  0.1373291015625f,  0.9721679687500f, -0.1022949218750f,
+     0.0476074218750f, -0.0266113281250f,  0.0148925781250f, -0.0083007812500f },
+  { -0.0291748046875f,  0.0292968750000f, -0.0517578125000f,  0.0891113281250f,
+    -0.1665039062500f,  0.4650878906250f,  0.7797851562500f, -0.2003173828125f,
+     0.1015625000000f, -0.0582275390625f,  0.0330810546875f, -0.0189208984375f },
+  { -0.0189208984375f,  0.0330810546875f, -0.0582275390625f,  0.1015625000000f,
+    -0.2003173828125f,  0.7797851562500f,  0.4650878906250f, -0.1665039062500f,
+     0.0891113281250f, -0.0517578125000f,  0.0292968750000f, -0.0291748046875f },
+  { -0.0083007812500f,  0.0148925781250f, -0.0266113281250f,  0.0476074218750f,
+    -0.1022949218750f,  0.9721679687500f,  0.1373291015625f, -0.0594482421875f,
+     0.0332031250000f, -0.0196533203125f,  0.0109863281250f,  0.0017089843750f }
+};
+
+double EnergyToLoudness(double energy)
+{
+  return -0.691 + 10.0 * std::log10(energy);
+}
+
+double LoudnessToEnergy(double loudness)
+{
+  return std::pow(10.0, (loudness + 0.691) / 10.0);
+}
+
+} // unnamed namespace
+
+CLoudnessMeter::CLoudnessMeter(unsigned int sampleRate, const std::vector<double>& channelWeights)
+  : m_subBlockFrames(std::max(sampleRate / SUB_BLOCKS_PER_SECOND, 1u)),
+    m_weights(channelWeights),
+    m_state(channelWeights.size())
+{
+  // K-weighting: the high shelf of the head and the high pass of the RLB curve,
+  // designed for the sample rate of the track
+  const double pi = 3.14159265358979323846;
+
+  double K = std::tan(pi * 1681.974450955533 / sampleRate);
+  double Q = 0.7071752369554196;
+  const double Vh = std::pow(10.0, 3.999843853973347 / 20.0);
+  const double Vb = std::pow(Vh, 0.4996667741545416);
+  double a0 = 1.0 + K / Q + K * K;
+  m_filter[0].b0 = (Vh + Vb * K / Q + K * K) / a0;
+  m_filter[0].b1 = 2.0 * (K * K - Vh) / a0;
+  m_filter[0].b2 = (Vh - Vb * K / Q + K * K) / a0;
+  m_filter[0].a1 = 2.0 * (K * K - 1.0) / a0;
+  m_filter[0].a2 = (1.0 - K / Q + K * K) / a0;
+
+  K = std::tan(pi * 38.13547087602444 / sampleRate);
+  Q = 0.5003270373238773;
+  a0 = 1.0 + K / Q + K * K;
+  m_filter[1].b0 = 1.0;
+  m_filter[1].b1 = -2.0;
+  m_filter[1].b2 = 1.0;
+  m_filter[1].a1 = 2.0 * (K * K - 1.0) / a0;
+  m_filter[1].a2 = (1.0 - K / Q + K * K) / a0;
+}
+
+void CLoudnessMeter::Process(const float* samples, unsigned int frames)
+{
+  const size_t channels = m_weights.size();
+
+  for (unsigned int frame = 0; frame < frames; frame++)
+  {
+    for (size_t ch = 0; ch < channels; ch++)
+    {
+      const float sample = samples[frame * channels + ch];
+      ChannelState& state = m_state[ch];
+
+      // true peak
+      std::copy_backward(state.history, state.history + 11, state.history + 12);
+      state.history[0] = sample;
+      float peak = std::abs(sample);
+      for (const auto& phase : TRUE_PEAK_COEFFS)
+      {
+        float value = 0.0f;
+        for (int i = 0; i < 12; i++)
+          value += phase[i] * state.history[i];
+        peak = std::max(peak, std::abs(value));
+      }
+      m_peak = std::max(m_peak, peak);
+
+      if (m_weights[ch] == 0.0)
+        continue;
+
+      // K-weighting, transposed direct form II
+      double value = sample;
+      for (int stage = 0; stage < 2; stage++)
+      {
+        const Biquad& f = m_filter[stage];
+        const double out = f.b0 * value + state.z1[stage];
+        state.z1[stage] = f.b1 * value - f.a1 * out + state.z2[stage];
+        state.z2[stage] = f.b2 * value - f.a2 * out;
+        value = out;
+      }
+      m_subBlockSum += m_weights[ch] * value * value;
+    }
+
+    if (++m_subBlockPos == m_subBlockFrames)
+      EndSubBlock();
+  }
+}
+
+void CLoudnessMeter::EndSubBlock()
+{
+  m_subBlocks[m_subBlockCount % SUB_BLOCKS_PER_BLOCK] = m_subBlockSum;
+  m_subBlockCount++;
+  m_subBlockSum = 0.0;
+  m_subBlockPos = 0;
+
+  if (m_subBlockCount < SUB_BLOCKS_PER_BLOCK)
+    return;
+
+  double sum = 0.0;
+  for (double subBlock : m_subBlocks)
+    sum += subBlock;
+  m_blocks.push_back(sum / (SUB_BLOCKS_PER_BLOCK * m_subBlockFrames));
+}
+
+bool CLoudnessMeter::GetIntegratedLoudness(double& loudness) const
+{
+  const double absoluteGate = LoudnessToEnergy(ABSOLUTE_GATE_LUFS);
+
+  double sum = 0.0;
+  size_t count = 0;
+  for (double block : m_blocks)
+  {
+    if (block > absoluteGate)
+    {
+      sum += block;
+      count++;
+    }
+  }
+  if (count == 0)
+    return false;
+
+  const double relativeGate = sum / count * std::pow(10.0, RELATIVE_GATE_LU / 10.0);
+  const double gate = std::max(absoluteGate, relativeGate);
+
+  sum = 0.0;
+  count = 0;
+  for (double block : m_blocks)
+  {
+    if (block > gate)
+    {
+      sum += block;
+      count++;
+    }
+  }
+  if (count == 0)
+    return false;
+
+  loudness = EnergyToLoudness(sum / count);
+  return true;
+}
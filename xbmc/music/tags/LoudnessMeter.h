@@ -0,0 +1,76 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <vector>
+
+/*!
+ * \brief Measures the integrated loudness and true peak of a track as
+ * specified by EBU R128 / ITU-R BS.1770-4
+ *
+ * The samples are K-weighted, the mean square of each channel is summed up
+ * in overlapping blocks of 400 ms and the blocks are gated at -70 LUFS and
+ * at 10 LU below the loudness of the remaining blocks. The peak is taken from
+ * the signal oversampled four times.
+ */
+class CLoudnessMeter
+{
+public:
+  /*!
+   * \param sampleRate Sample rate of the track
+   * \param channelWeights Weight of each channel, 1.0 for the front channels,
+   *        1.41 for the surround channels and 0.0 for the LFE channel
+   */
+  CLoudnessMeter(unsigned int sampleRate, const std::vector<double>& channelWeights);
+
+  /*!
+   * \brief Add interleaved samples, full scale is 1.0
+   */
+  void Process(const float* samples, unsigned int frames);
+
+  /*!
+   * \brief Integrated loudness of the samples added so far
+   *
+   * \param loudness Loudness in LUFS
+   * \return false if no block is louder than the absolute gate
+   */
+  bool GetIntegratedLoudness(double& loudness) const;
+
+  /*!
+   * \brief Highest true peak of the samples added so far, 1.0 is full scale
+   */
+  float GetTruePeak() const { return m_peak; }
+
+private:
+  struct Biquad
+  {
+    double b0, b1, b2, a1, a2;
+  };
+
+  struct ChannelState
+  {
+    double z1[2] = {};
+    double z2[2] = {};
+    float history[12] = {};
+  };
+
+  void EndSubBlock();
+
+  unsigned int m_subBlockFrames;
+  std::vector<double> m_weights;
+  std::vector<ChannelState> m_state;
+  Biquad m_filter[2];
+
+  double m_subBlockSum = 0.0;
+  unsigned int m_subBlockPos = 0;
+  double m_subBlocks[4] = {};
+  unsigned int m_subBlockCount = 0;
+  std::vector<double> m_blocks;
+  float m_peak = 0.0f;
+};
@@ -9,6 +9,7 @@
 
 #include "filesystem/File.h"
 
+#include <algorithm>
 #include <limits.h>
 
 #include <taglib/tiostream.h>
@@ -21,7 +22,7 @@ using namespace MUSIC_INFO;
  * Construct a File object and opens the \a file.  \a file should be a
  * be an XBMC Vfile.
  */
-TagLibVFSStream::TagLibVFSStream(const std::string& strFileName, bool readOnly)
+TagLibVFSStream::TagLibVFSStream(const std::string& strFileName, bool readOnly, unsigned int prefetchSize)
 {
   m_bIsOpen = true;
   if (readOnly)
@@ -36,6 +37,47 @@ TagLibVFSStream::TagLibVFSStream(const std::string& strFileName, bool readOnly)
   }
   m_strFileName = strFileName;
   m_bIsReadOnly = readOnly || !m_bIsOpen;
+
+  if (readOnly && m_bIsOpen && prefetchSize > 0)
+    Prefetch(prefetchSize);
+}
+
+/*!
+ * Reads the head and the tail of the file, falls back to plain reads if
+ * either of them fails.
+ */
+void TagLibVFSStream::Prefetch(unsigned int size)
+{
+  const int64_t fileLength = m_file.GetLength();
+  if (fileLength <= 0)
+    return;
+
+  m_head.resize(static_cast<size_t>(std::min<int64_t>(size, fileLength)));
+  if (m_file.Read(m_head.data(), m_head.size()) != static_cast<ssize_t>(m_head.size()))
+  {
+    m_head.clear();
+    m_file.Seek(0, SEEK_SET);
+    return;
+  }
+
+  const int64_t headLength = static_cast<int64_t>(m_head.size());
+  if (fileLength > headLength)
+  {
+    m_tailStart = std::max(headLength, fileLength - size);
+    m_tail.resize(static_cast<size_t>(fileLength - m_tailStart));
+    if (m_file.Seek(m_tailStart, SEEK_SET) != m_tailStart ||
+        m_file.Read(m_tail.data(), m_tail.size()) != static_cast<ssize_t>(m_tail.size()))
+    {
+      m_head.clear();
+      m_tail.clear();
+      m_file.Seek(0, SEEK_SET);
+      return;
+    }
+  }
+
+  m_length = fileLength;
+  m_position = 0;
+  m_bPrefetched = true;
 }
 
 /*!
@@ -59,6 +101,29 @@ FileName TagLibVFSStream::name() const
  */
 ByteVector TagLibVFSStream::readBlock(TagLib::ulong length)
 {
+  if (m_bPrefetched)
+  {
+    if (m_position >= m_length)
+      return ByteVector();
+
+    const int64_t end = std::min<int64_t>(m_position + length, m_length);
+    const char* data = nullptr;
+    if (end <= static_cast<int64_t>(m_head.size()))
+      data = m_head.data() + m_position;
+    else if (!m_tail.empty() && m_position >= m_tailStart)
+      data = m_tail.data() + (m_position - m_tailStart);
+
+    if (data)
+    {
+      ByteVector byteVector(data, static_cast<TagLib::uint>(end - m_position));
+      m_position = end;
+      return byteVector;
+    }
+
+    // somewhere in the middle, e.g. large embedded art
+    m_file.Seek(m_position, SEEK_SET);
+  }
+
   ByteVector byteVector(static_cast<TagLib::uint>(length));
   ssize_t read = m_file.Read(byteVector.data(), length);
   if (read > 0)
@@ -66,6 +131,9 @@ ByteVector TagLibVFSStream::readBlock(TagLib::ulong length)
   else
     byteVector.clear();
 
+  if (m_bPrefetched && read > 0)
+    m_position += read;
+
   return byteVector;
 }
 
@@ -239,6 +307,23 @@ bool TagLibVFSStream::isOpen() const
  */
 void TagLibVFSStream::seek(long offset, Position p)
 {
+  if (m_bPrefetched)
+  {
+    int64_t position;
+    if (p == Beginning)
+      position = offset;
+    else if (p == Current)
+      position = m_position + offset;
+    else if (p == End)
+      position = m_length + offset;
+    else
+      return; // wrong Position value
+
+    // same as below, never move beyond the file
+    m_position = std::min(std::max<int64_t>(position, 0), m_length);
+    return;
+  }
+
   const long fileLen = length();
   if (m_bIsReadOnly && fileLen > 0)
   {
@@ -297,7 +382,7 @@ void TagLibVFSStream::clear()
  */
 long TagLibVFSStream::tell() const
 {
-  int64_t pos = m_file.GetPosition();
+  int64_t pos = m_bPrefetched ? m_position : m_file.GetPosition();
   if(pos > LONG_MAX)
     return -1;
   else
@@ -309,6 +394,8 @@ long TagLibVFSStream::tell() const
  */
 long TagLibVFSStream::length()
 {
+  if (m_bPrefetched)
+    return (long)m_length;
   return (long)m_file.GetLength();
 }
 
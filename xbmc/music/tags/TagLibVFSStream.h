@@ -10,6 +10,9 @@
 
 #include "filesystem/File.h"
 
+#include <string>
+#include <vector>
+
 #include <taglib/tiostream.h>
 
 namespace MUSIC_INFO
@@ -19,9 +22,12 @@ namespace MUSIC_INFO
   public:
     /*!
      * Construct a File object and opens the \a file.  \a file should be a
-     * be an XBMC Vfile.
+     * be an XBMC Vfile.  A read only stream can fetch the first and the last
+     * \a prefetchSize bytes of the file up front, the tags usually live there
+     * and reading them with two requests beats lots of small reads and seeks
+     * on remote filesystems.
      */
-    TagLibVFSStream(const std::string& strFileName, bool readOnly);
+    TagLibVFSStream(const std::string& strFileName, bool readOnly, unsigned int prefetchSize = 0);
 
     /*!
      * Destroys this ByteVectorStream instance.
@@ -113,10 +119,20 @@ namespace MUSIC_INFO
     static TagLib::uint bufferSize() { return 1024; };
 
   private:
+    void Prefetch(unsigned int size);
+
     std::string   m_strFileName;
     XFILE::CFile  m_file;
     bool          m_bIsReadOnly;
     bool          m_bIsOpen;
+
+    // prefetched head and tail of the file, the position is kept here while they are used
+    bool              m_bPrefetched = false;
+    int64_t           m_position = 0;
+    int64_t           m_length = 0;
+    std::vector<char> m_head;
+    std::vector<char> m_tail;
+    int64_t           m_tailStart = 0;
   };
 }
 
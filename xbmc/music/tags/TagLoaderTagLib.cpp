@@ -1145,7 +1145,11 @@ bool CTagLoaderTagLib::Load(const std::string& strFileName, CMusicInfoTag& tag,
   }
 
   StringUtils::ToLower(strExtension);
-  TagLibVFSStream*           stream = new TagLibVFSStream(strFileName, true);
+  // remote files pay for every read, fetch the parts holding the tags at once
+  unsigned int prefetchSize = 0;
+  if (URIUtils::IsRemote(strFileName))
+    prefetchSize = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iMusicLibraryTagPrefetchSize * 1024;
+  TagLibVFSStream*           stream = new TagLibVFSStream(strFileName, true, prefetchSize);
   if (!stream)
   {
     CLog::Log(LOGERROR, "could not create TagLib VFS stream for: %s", strFileName.c_str());
@@ -0,0 +1,73 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "music/tags/LoudnessMeter.h"
+
+#include <cmath>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+std::vector<float> Sine(unsigned int sampleRate, unsigned int channels, double frequency,
+                        double amplitude, double phase, unsigned int seconds)
+{
+  std::vector<float> samples(sampleRate * channels * seconds);
+  for (unsigned int i = 0; i < sampleRate * seconds; i++)
+  {
+    const float value = static_cast<float>(
+        amplitude * std::sin(2.0 * M_PI * frequency * i / sampleRate + phase));
+    for (unsigned int ch = 0; ch < channels; ch++)
+      samples[i * channels + ch] = value;
+  }
+  return samples;
+}
+}
+
+TEST(TestLoudnessMeter, StereoSine)
+{
+  // EBU Tech 3341: a stereo 1 kHz sine at -23 dBFS measures -23 LUFS
+  for (unsigned int sampleRate : {44100u, 48000u})
+  {
+    CLoudnessMeter meter(sampleRate, {1.0, 1.0});
+    const std::vector<float> samples = Sine(sampleRate, 2, 997.0, std::pow(10.0, -23.0 / 20.0), 0.0, 20);
+    meter.Process(samples.data(), samples.size() / 2);
+
+    double loudness;
+    ASSERT_TRUE(meter.GetIntegratedLoudness(loudness));
+    EXPECT_NEAR(-23.0, loudness, 0.1);
+  }
+}
+
+TEST(TestLoudnessMeter, SilenceIsGated)
+{
+  CLoudnessMeter meter(48000, {1.0, 1.0});
+  const std::vector<float> silence(48000 * 2 * 10);
+  meter.Process(silence.data(), 48000 * 10);
+
+  double loudness;
+  EXPECT_FALSE(meter.GetIntegratedLoudness(loudness));
+
+  const std::vector<float> samples = Sine(48000, 2, 997.0, std::pow(10.0, -23.0 / 20.0), 0.0, 20);
+  meter.Process(samples.data(), samples.size() / 2);
+  meter.Process(silence.data(), 48000 * 10);
+
+  ASSERT_TRUE(meter.GetIntegratedLoudness(loudness));
+  EXPECT_NEAR(-23.0, loudness, 0.1);
+}
+
+TEST(TestLoudnessMeter, TruePeak)
+{
+  // a quarter of the sample rate shifted by 45 degrees never hits its peak on a sample
+  CLoudnessMeter meter(48000, {1.0});
+  const std::vector<float> samples = Sine(48000, 1, 12000.0, 0.5, M_PI / 4.0, 1);
+  meter.Process(samples.data(), samples.size());
+
+  EXPECT_NEAR(0.5f, meter.GetTruePeak(), 0.02f);
+}
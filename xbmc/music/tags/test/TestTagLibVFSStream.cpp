@@ -0,0 +1,101 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/File.h"
+#include "music/tags/TagLibVFSStream.h"
+#include "test/TestUtils.h"
+
+#include <string>
+
+#include <gtest/gtest.h>
+
+using namespace MUSIC_INFO;
+
+namespace
+{
+std::string CreateTestFile(XFILE::CFile*& file)
+{
+  std::string content;
+  for (int i = 0; i < 100; ++i)
+    content += static_cast<char>('a' + i % 26);
+
+  file = XBMC_CREATETEMPFILE("");
+  if (!file)
+    return "";
+  file->Close();
+  const std::string path = XBMC_TEMPFILEPATH(file);
+  if (!file->OpenForWrite(path, true))
+    return "";
+  file->Write(content.c_str(), content.size());
+  file->Close();
+  return path;
+}
+
+std::string Read(TagLibVFSStream& stream, TagLib::ulong length)
+{
+  TagLib::ByteVector data = stream.readBlock(length);
+  return std::string(data.data(), data.size());
+}
+}
+
+TEST(TestTagLibVFSStream, PrefetchedReadsMatchPlainReads)
+{
+  XFILE::CFile* file = nullptr;
+  const std::string path = CreateTestFile(file);
+  ASSERT_FALSE(path.empty());
+
+  {
+    TagLibVFSStream plain(path, true);
+    TagLibVFSStream prefetched(path, true, 16);
+    ASSERT_TRUE(prefetched.isOpen());
+    EXPECT_EQ(plain.length(), prefetched.length());
+
+    // head
+    EXPECT_EQ(Read(plain, 10), Read(prefetched, 10));
+    EXPECT_EQ(plain.tell(), prefetched.tell());
+
+    // across the end of the head into the middle
+    EXPECT_EQ(Read(plain, 20), Read(prefetched, 20));
+    EXPECT_EQ(plain.tell(), prefetched.tell());
+
+    // tail
+    plain.seek(-12, TagLib::IOStream::End);
+    prefetched.seek(-12, TagLib::IOStream::End);
+    EXPECT_EQ(plain.tell(), prefetched.tell());
+    EXPECT_EQ(Read(plain, 8), Read(prefetched, 8));
+
+    // beyond the end
+    EXPECT_EQ(Read(plain, 8), Read(prefetched, 8));
+    EXPECT_TRUE(Read(prefetched, 8).empty());
+
+    prefetched.seek(50);
+    plain.seek(50);
+    EXPECT_EQ(Read(plain, 5), Read(prefetched, 5));
+    prefetched.seek(-5, TagLib::IOStream::Current);
+    plain.seek(-5, TagLib::IOStream::Current);
+    EXPECT_EQ(Read(plain, 5), Read(prefetched, 5));
+  }
+
+  EXPECT_TRUE(XBMC_DELETETEMPFILE(file));
+}
+
+TEST(TestTagLibVFSStream, PrefetchLargerThanFile)
+{
+  XFILE::CFile* file = nullptr;
+  const std::string path = CreateTestFile(file);
+  ASSERT_FALSE(path.empty());
+
+  {
+    TagLibVFSStream prefetched(path, true, 4096);
+    EXPECT_EQ(100, prefetched.length());
+    EXPECT_EQ(100u, Read(prefetched, 200).size());
+    EXPECT_EQ(100, prefetched.tell());
+  }
+
+  EXPECT_TRUE(XBMC_DELETETEMPFILE(file));
+}
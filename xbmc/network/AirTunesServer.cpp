@@ -11,6 +11,7 @@
 
 #include "AirTunesServer.h"
 
+#include <inttypes.h>
 #include <map>
 #include <string>
 #include <utility>
@@ -70,6 +71,8 @@ CCriticalSection CAirTunesServer::m_actionQueueLock;
 std::list<CAction> CAirTunesServer::m_actionQueue;
 CEvent CAirTunesServer::m_processActions;
 int CAirTunesServer::m_sampleRate = 44100;
+int CAirTunesServer::m_maxBufferedBytes = 0;
+uint64_t CAirTunesServer::m_droppedBytes = 0;
 
 unsigned int CAirTunesServer::m_cachedStartTime = 0;
 unsigned int CAirTunesServer::m_cachedEndTime = 0;
@@ -377,6 +380,13 @@ void* CAirTunesServer::AudioOutputFunctions::audio_init(void *cls, int bits, int
   m_streamStarted = true;
   m_sampleRate = samplerate;
 
+  // the sender streams in real time, audio that piles up while the player starts or stalls
+  // would delay everything after it for the rest of the session
+  const int latencyMs = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_airTunesLatencyMs;
+  m_maxBufferedBytes = static_cast<int>(sizeof(header) +
+      static_cast<int64_t>(samplerate) * channels * (bits / 8) * latencyMs / 1000);
+  m_droppedBytes = 0;
+
   CApplicationMessenger::GetInstance().PostMsg(TMSG_MEDIA_PLAY, 0, 0, static_cast<void*>(item));
 
   // Not all airplay streams will provide metadata (e.g. if using mirroring,
@@ -488,7 +498,11 @@ void  CAirTunesServer::AudioOutputFunctions::audio_set_volume(void *cls, void *s
 void  CAirTunesServer::AudioOutputFunctions::audio_process(void *cls, void *session, const void *buffer, int buflen)
 {
   XFILE::CPipeFile *pipe=(XFILE::CPipeFile *)cls;
-  pipe->Write(buffer, buflen);
+  // drop instead of blocking the receiver when the player is behind by more than the target latency
+  if (pipe->GetAvailableRead() + buflen > m_maxBufferedBytes)
+    m_droppedBytes += buflen;
+  else
+    pipe->Write(buffer, buflen);
   
   // in case there are some play times cached that are not yet sent to the player - do it here
   InformPlayerAboutPlayTimes();
@@ -500,6 +514,10 @@ void  CAirTunesServer::AudioOutputFunctions::audio_destroy(void *cls, void *sess
   pipe->SetEof();
   pipe->Close();
 
+  if (m_droppedBytes > 0)
+    CLog::Log(LOGDEBUG, LOGAIRTUNES, "AIRTUNES: dropped %" PRIu64 " bytes of audio the player was too late for",
+              m_droppedBytes);
+
   CAirTunesServer::FreeDACPRemote();
   m_dacp_id.clear();
   m_active_remote_header.clear();
@@ -18,6 +18,7 @@
 #include "threads/Thread.h"
 
 #include <list>
+#include <stdint.h>
 #include <string>
 #include <vector>
 
@@ -79,6 +80,8 @@ private:
   static std::list<CAction> m_actionQueue;
   static CEvent m_processActions;
   static int m_sampleRate;
+  static int m_maxBufferedBytes;
+  static uint64_t m_droppedBytes;
   static unsigned int m_cachedStartTime;
   static unsigned int m_cachedEndTime;
   static unsigned int m_cachedCurrentTime;
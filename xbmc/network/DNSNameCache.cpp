@@ -9,6 +9,8 @@
 #include "DNSNameCache.h"
 
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/JobManager.h"
 #include "utils/StringUtils.h"
 #include "utils/log.h"
 
@@ -16,6 +18,11 @@
 #include <netdb.h>
 #include <netinet/in.h>
 
+// getaddrinfo doesn't tell the ttl of a record
+#define DNS_CACHE_TTL_MS (10 * 60 * 1000)
+// hosts that failed to resolve aren't looked up again for this long
+#define DNS_CACHE_NEGATIVE_TTL_MS (10 * 1000)
+
 CDNSNameCache g_DNSCache;
 
 CCriticalSection CDNSNameCache::m_critical;
@@ -39,9 +46,58 @@ bool CDNSNameCache::Lookup(const std::string& strHostName, std::string& strIpAdd
     return true;
   }
 
-  // check if there's a custom entry or if it's already cached
-  if(g_DNSCache.GetCached(strHostName, strIpAddress))
-    return true;
+  {
+    CSingleLock lock(m_critical);
+    auto it = g_DNSCache.m_hosts.find(strHostName);
+    if (it != g_DNSCache.m_hosts.end())
+    {
+      CDNSName& entry = it->second;
+      unsigned int age = XbmcThreads::SystemClockMillis() - entry.m_resolvedTime;
+
+      // custom entries and fresh lookups are used as is, entries only noted alive weren't resolved yet
+      if (entry.m_resolvedTime == 0)
+      {
+        if (!entry.m_strIpAddress.empty())
+        {
+          strIpAddress = entry.m_strIpAddress;
+          return true;
+        }
+      }
+      else if (entry.m_strIpAddress.empty() && age < DNS_CACHE_NEGATIVE_TTL_MS)
+        return false;
+      else if (!entry.m_strIpAddress.empty() && age < DNS_CACHE_TTL_MS)
+      {
+        if (age >= DNS_CACHE_TTL_MS / 2 && !entry.m_refreshing)
+        {
+          entry.m_refreshing = true;
+          std::string hostName = strHostName;
+          CJobManager::GetInstance().Submit([hostName]() { Refresh(hostName); });
+        }
+        strIpAddress = entry.m_strIpAddress;
+        return true;
+      }
+    }
+  }
+
+  bool resolved = Resolve(strHostName, strIpAddress);
+
+  CSingleLock lock(m_critical);
+  CDNSName& entry = g_DNSCache.m_hosts[strHostName];
+  if (entry.m_resolvedTime != 0 || entry.m_strIpAddress.empty())
+  {
+    entry.m_strIpAddress = strIpAddress;
+    entry.m_resolvedTime = XbmcThreads::SystemClockMillis();
+    entry.m_refreshing = false;
+  }
+
+  if (!resolved)
+    CLog::Log(LOGERROR, "Unable to lookup host: '%s'", strHostName.c_str());
+  return resolved;
+}
+
+bool CDNSNameCache::Resolve(const std::string& strHostName, std::string& strIpAddress)
+{
+  strIpAddress.clear();
 
 #if !defined(TARGET_WINDOWS) && defined(HAS_FILESYSTEM_SMB)
   // perform netbios lookup (win32 is handling this via gethostbyname)
@@ -64,10 +120,7 @@ bool CDNSNameCache::Lookup(const std::string& strHostName, std::string& strIpAdd
   }
 
   if (!strIpAddress.empty())
-  {
-    g_DNSCache.Add(strHostName, strIpAddress);
     return true;
-  }
 #endif
 
   // perform dns lookup
@@ -79,41 +132,89 @@ bool CDNSNameCache::Lookup(const std::string& strHostName, std::string& strIpAdd
                                        (unsigned char)host->h_addr_list[0][1],
                                        (unsigned char)host->h_addr_list[0][2],
                                        (unsigned char)host->h_addr_list[0][3]);
-    g_DNSCache.Add(strHostName, strIpAddress);
     return true;
   }
 
-  CLog::Log(LOGERROR, "Unable to lookup host: '%s'", strHostName.c_str());
   return false;
 }
 
-bool CDNSNameCache::GetCached(const std::string& strHostName, std::string& strIpAddress)
+void CDNSNameCache::Refresh(const std::string& strHostName)
 {
+  std::string strIpAddress;
+  bool resolved = Resolve(strHostName, strIpAddress);
+
   CSingleLock lock(m_critical);
+  CDNSName& entry = g_DNSCache.m_hosts[strHostName];
+  entry.m_refreshing = false;
+  if (entry.m_resolvedTime == 0 && !entry.m_strIpAddress.empty())
+    return; // custom entry
 
-  // loop through all DNSname entries and see if strHostName is cached
-  for (int i = 0; i < (int)g_DNSCache.m_vecDNSNames.size(); ++i)
+  // keep the old address until it expires if the server didn't answer this time
+  if (resolved || entry.m_strIpAddress.empty())
   {
-    CDNSName& DNSname = g_DNSCache.m_vecDNSNames[i];
-    if ( DNSname.m_strHostName == strHostName )
-    {
-      strIpAddress = DNSname.m_strIpAddress;
-      return true;
-    }
+    entry.m_strIpAddress = strIpAddress;
+    entry.m_resolvedTime = XbmcThreads::SystemClockMillis();
   }
+}
 
-  // not cached
-  return false;
+void CDNSNameCache::Prefetch(const std::string& strHostName)
+{
+  if (strHostName.empty() || inet_addr(strHostName.c_str()) != INADDR_NONE)
+    return;
+
+  {
+    CSingleLock lock(m_critical);
+    CDNSName& entry = g_DNSCache.m_hosts[strHostName];
+    if (!entry.m_strIpAddress.empty() || entry.m_refreshing)
+      return;
+    entry.m_refreshing = true;
+  }
+
+  std::string hostName = strHostName;
+  CJobManager::GetInstance().Submit([hostName]() { Refresh(hostName); });
+}
+
+bool CDNSNameCache::GetCached(const std::string& strHostName, std::string& strIpAddress)
+{
+  CSingleLock lock(m_critical);
+
+  auto it = g_DNSCache.m_hosts.find(strHostName);
+  if (it == g_DNSCache.m_hosts.end() || it->second.m_strIpAddress.empty())
+    return false;
+
+  if (it->second.m_resolvedTime != 0 &&
+      XbmcThreads::SystemClockMillis() - it->second.m_resolvedTime >= DNS_CACHE_TTL_MS)
+    return false;
+
+  strIpAddress = it->second.m_strIpAddress;
+  return true;
 }
 
 void CDNSNameCache::Add(const std::string &strHostName, const std::string &strIpAddress)
 {
-  CDNSName dnsName;
+  CSingleLock lock(m_critical);
+  CDNSName& entry = g_DNSCache.m_hosts[strHostName];
+  entry.m_strIpAddress = strIpAddress;
+  entry.m_resolvedTime = 0;
+}
 
-  dnsName.m_strHostName = strHostName;
-  dnsName.m_strIpAddress  = strIpAddress;
+void CDNSNameCache::SetAlive(const std::string& strHostName)
+{
+  if (strHostName.empty())
+    return;
 
   CSingleLock lock(m_critical);
-  g_DNSCache.m_vecDNSNames.push_back(dnsName);
+  g_DNSCache.m_hosts[strHostName].m_aliveTime = XbmcThreads::SystemClockMillis();
+}
+
+bool CDNSNameCache::IsAlive(const std::string& strHostName, unsigned int maxAgeMs)
+{
+  CSingleLock lock(m_critical);
+
+  auto it = g_DNSCache.m_hosts.find(strHostName);
+  if (it == g_DNSCache.m_hosts.end() || it->second.m_aliveTime == 0)
+    return false;
+
+  return XbmcThreads::SystemClockMillis() - it->second.m_aliveTime < maxAgeMs;
 }
 
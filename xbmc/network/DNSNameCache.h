@@ -8,27 +8,49 @@
 
 #pragma once
 
+#include <map>
 #include <string>
-#include <vector>
 
 class CCriticalSection;
 
+/*!
+ \brief State of remote hosts shared by all protocols.
+
+ Keeps the resolved address of hosts and when any protocol last reached
+ them. Resolved addresses expire, they are refreshed in the background
+ once half of their lifetime passed so lookups of hosts in use don't wait
+ for name resolution. Failed lookups are remembered for a short time.
+ */
 class CDNSNameCache
 {
 public:
   class CDNSName
   {
   public:
-    std::string m_strHostName;
-    std::string m_strIpAddress;
+    std::string m_strIpAddress; // empty if the lookup failed
+    unsigned int m_resolvedTime = 0; // 0 for custom entries, which never expire
+    unsigned int m_aliveTime = 0; // last time the host was reached, 0 if never
+    bool m_refreshing = false;
   };
   CDNSNameCache(void);
   virtual ~CDNSNameCache(void);
   static bool Lookup(const std::string& strHostName, std::string& strIpAddress);
+  /*! \brief Add a custom entry */
   static void Add(const std::string& strHostName, const std::string& strIpAddress);
+  /*! \brief Look up a custom or already resolved entry without resolving the host */
+  static bool GetCached(const std::string& strHostName, std::string& strIpAddress);
+  /*! \brief Resolve a host in the background unless its address is known already */
+  static void Prefetch(const std::string& strHostName);
+
+  /*! \brief Note that a protocol reached the host, e.g. a share was opened on it */
+  static void SetAlive(const std::string& strHostName);
+  /*! \brief Whether any protocol reached the host within the last maxAgeMs */
+  static bool IsAlive(const std::string& strHostName, unsigned int maxAgeMs);
 
 protected:
-  static bool GetCached(const std::string& strHostName, std::string& strIpAddress);
+  static bool Resolve(const std::string& strHostName, std::string& strIpAddress);
+  static void Refresh(const std::string& strHostName);
+
   static CCriticalSection m_critical;
-  std::vector<CDNSName> m_vecDNSNames;
+  std::map<std::string, CDNSName> m_hosts;
 };
@@ -188,21 +188,18 @@ void CEventClient::ProcessEvents()
   }
 }
 
-bool CEventClient::GetNextAction(CEventAction &action)
+bool CEventClient::GetActions(std::queue<CEventAction>& actions)
 {
   CSingleLock lock(m_critSection);
-  if (!m_actionQueue.empty())
+  if (m_actionQueue.empty())
+    return false;
+
+  while (!m_actionQueue.empty())
   {
-    // grab the next action in line
-    action = m_actionQueue.front();
+    actions.push(std::move(m_actionQueue.front()));
     m_actionQueue.pop();
-    return true;
-  }
-  else
-  {
-    // we got nothing
-    return false;
   }
+  return true;
 }
 
 bool CEventClient::ProcessPacket(CEventPacket *packet)
@@ -246,6 +243,10 @@ bool CEventClient::ProcessPacket(CEventPacket *packet)
     valid = OnPacketACTION(packet);
     break;
 
+  case PT_BATCH:
+    valid = OnPacketBATCH(packet);
+    break;
+
   default:
     CLog::Log(LOGDEBUG, "ES: Got Unknown Packet");
     break;
@@ -654,6 +655,53 @@ bool CEventClient::OnPacketACTION(CEventPacket *packet)
   return true;
 }
 
+bool CEventClient::OnPacketBATCH(CEventPacket *packet)
+{
+  unsigned char *payload = (unsigned char *)packet->Payload();
+  int psize = (int)packet->PayloadSize();
+  unsigned short count;
+
+  if (!ParseUInt16(payload, psize, count))
+    return false;
+
+  for (unsigned short i = 0; i < count; i++)
+  {
+    unsigned short type;
+    unsigned short size;
+    if (!ParseUInt16(payload, psize, type) || !ParseUInt16(payload, psize, size) || size > psize)
+      return false;
+
+    // only input is batched, the queued button state already merges
+    // repeated axis amounts and the mouse keeps its last position
+    CEventPacket batched((PacketType)type, size, payload);
+    payload += size;
+    psize -= size;
+
+    if (!batched.IsValid())
+      return false;
+
+    switch (type)
+    {
+    case PT_BUTTON:
+      OnPacketBUTTON(&batched);
+      break;
+
+    case EVENTPACKET::PT_MOUSE:
+      OnPacketMOUSE(&batched);
+      break;
+
+    case PT_ACTION:
+      OnPacketACTION(&batched);
+      break;
+
+    default:
+      CLog::Log(LOGDEBUG, "ES: Packet type %d can't be batched", type);
+      break;
+    }
+  }
+  return true;
+}
+
 bool CEventClient::ParseString(unsigned char* &payload, int &psize, std::string& parsedVal)
 {
   if (psize <= 0)
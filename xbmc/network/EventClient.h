@@ -173,8 +173,8 @@ namespace EVENTCLIENT
     // process the queued up events (packets)
     void ProcessEvents();
 
-    // gets the next action in the action queue
-    bool GetNextAction(CEventAction& action);
+    // moves all queued actions to the end of actions
+    bool GetActions(std::queue<CEventAction>& actions);
 
     // deallocate all packets in the queues
     void FreePacketQueues();
@@ -196,6 +196,7 @@ namespace EVENTCLIENT
     virtual bool OnPacketNOTIFICATION(EVENTPACKET::CEventPacket *packet);
     virtual bool OnPacketLOG(EVENTPACKET::CEventPacket *packet);
     virtual bool OnPacketACTION(EVENTPACKET::CEventPacket *packet);
+    virtual bool OnPacketBATCH(EVENTPACKET::CEventPacket *packet);
     bool CheckButtonRepeat(unsigned int &next);
 
     // returns true if the client has received the HELO packet
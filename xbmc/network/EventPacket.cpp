@@ -16,6 +16,32 @@ using namespace EVENTPACKET;
 /************************************************************************/
 /* CEventPacket                                                         */
 /************************************************************************/
+CEventPacket::CEventPacket(PacketType type, unsigned int psize, const void* payload)
+{
+  m_bValid = false;
+  m_iSeq = 0;
+  m_iTotalPackets = 1;
+  m_pPayload = NULL;
+  m_iPayloadSize = 0;
+  m_iClientToken = 0;
+  m_cMajVer = 2;
+  m_cMinVer = 0;
+  m_eType = type;
+
+  if (psize)
+  {
+    m_pPayload = malloc(psize);
+    if (!m_pPayload)
+    {
+      CLog::Log(LOGERROR, "ES: Out of memory");
+      return;
+    }
+    memcpy(m_pPayload, payload, psize);
+    m_iPayloadSize = psize;
+  }
+  m_bValid = true;
+}
+
 bool CEventPacket::Parse(int datasize, const void *data)
 {
   unsigned char* buf = const_cast<unsigned char*>((const unsigned char *)data);
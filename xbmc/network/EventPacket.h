@@ -183,6 +183,18 @@ namespace EVENTPACKET
     /* %c - action type                                                     */
     /* %s - action message                                                  */
     /************************************************************************/
+    PT_BATCH         = 0x0B,
+    /************************************************************************/
+    /* Payload format                                                       */
+    /* %i - number of packets                                               */
+    /* for each packet:                                                     */
+    /*   %i - packet type (PT_BUTTON, PT_MOUSE or PT_ACTION only)           */
+    /*   %i - payload size                                                  */
+    /*   raw - payload of that packet type                                  */
+    /*                                                                      */
+    /* the packets are handled in order and as if sent one by one, mouse    */
+    /* moves and axis amounts of a button only keep their latest value      */
+    /************************************************************************/
     PT_DEBUG         = 0xFF,
     /************************************************************************/
     /* Payload format:                                                      */
@@ -222,6 +234,9 @@ namespace EVENTPACKET
       Parse(datasize, data);
     }
 
+    // packet carried by a PT_BATCH, the payload is copied
+    CEventPacket(PacketType type, unsigned int psize, const void* payload);
+
     virtual      ~CEventPacket() { free(m_pPayload); }
     virtual bool Parse(int datasize, const void *data);
     bool         IsValid() const { return m_bValid; }
@@ -194,13 +194,17 @@ void CEventServer::Run()
     try
     {
       // start listening until we timeout
-      if (listener.Listen(m_iListenTimeout))
+      // read everything that arrived before processing, a burst of
+      // packets is then handled in one go
+      int timeout = m_iListenTimeout;
+      while (listener.Listen(timeout))
       {
         CAddress addr;
         if ((packetSize = m_pSocket->Read(addr, PACKET_SIZE, (void *)m_pPacketBuffer)) > -1)
         {
           ProcessPacket(addr, packetSize);
         }
+        timeout = 0;
       }
     }
     catch (...)
@@ -314,44 +318,46 @@ void CEventServer::ProcessEvents()
   }
 }
 
-bool CEventServer::ExecuteNextAction()
+bool CEventServer::ExecuteActions()
 {
-  CSingleLock lock(m_critSection);
+  // take everything queued so a burst doesn't trickle in one action per frame
+  std::queue<CEventAction> actions;
+  {
+    CSingleLock lock(m_critSection);
+    for (auto& client : m_clients)
+      client.second->GetActions(actions);
+  }
 
-  CEventAction actionEvent;
-  std::map<unsigned long, CEventClient*>::iterator iter = m_clients.begin();
+  if (actions.empty())
+    return false;
 
-  while (iter != m_clients.end())
+  // no lock is held while executing, actions may stop the server
+  while (!actions.empty() && !g_application.m_bStop)
   {
-    if (iter->second->GetNextAction(actionEvent))
+    const CEventAction& actionEvent = actions.front();
+    switch(actionEvent.actionType)
     {
-      // Leave critical section before processing action
-      lock.Leave();
-      switch(actionEvent.actionType)
-      {
-      case AT_EXEC_BUILTIN:
-        CBuiltins::GetInstance().Execute(actionEvent.actionName);
-        break;
+    case AT_EXEC_BUILTIN:
+      CBuiltins::GetInstance().Execute(actionEvent.actionName);
+      break;
 
-      case AT_BUTTON:
-        {
-          unsigned int actionID;
-          CActionTranslator::TranslateString(actionEvent.actionName, actionID);
-          CAction action(actionID, 1.0f, 0.0f, actionEvent.actionName);
-          CGUIComponent* gui = CServiceBroker::GetGUI();
-          if (gui)
-            gui->GetAudioManager().PlayActionSound(action);
-
-          g_application.OnAction(action);
-        }
-        break;
+    case AT_BUTTON:
+      {
+        unsigned int actionID;
+        CActionTranslator::TranslateString(actionEvent.actionName, actionID);
+        CAction action(actionID, 1.0f, 0.0f, actionEvent.actionName);
+        CGUIComponent* gui = CServiceBroker::GetGUI();
+        if (gui)
+          gui->GetAudioManager().PlayActionSound(action);
+
+        g_application.OnAction(action);
       }
-      return true;
+      break;
     }
-    ++iter;
+    actions.pop();
   }
 
-  return false;
+  return true;
 }
 
 unsigned int CEventServer::GetButtonCode(std::string& strMapName, bool& isAxis, float& fAmount, bool &isJoystick)
@@ -52,7 +52,7 @@ namespace EVENTSERVER
 
     // get events
     unsigned int GetButtonCode(std::string& strMapName, bool& isAxis, float& amount, bool &isJoystick);
-    bool ExecuteNextAction();
+    bool ExecuteActions();
     bool GetMousePos(float &x, float &y);
     int GetNumberOfClients();
 
@@ -17,6 +17,7 @@
 #include "network/NetworkServices.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "threads/SingleLock.h"
 #include "utils/log.h"
 #ifdef TARGET_WINDOWS
 #include "platform/win32/WIN32Util.h"
@@ -213,6 +214,7 @@ bool CNetworkBase::IsConnected()
 
 void CNetworkBase::NetworkMessage(EMESSAGE message, int param)
 {
+  CSingleLock lock(m_servicesSection);
   switch( message )
   {
     case SERVICES_UP:
@@ -12,6 +12,7 @@
 #include <vector>
 
 #include "settings/lib/ISettingCallback.h"
+#include "threads/CriticalSection.h"
 
 #include "PlatformDefs.h"
 
@@ -80,7 +81,8 @@ public:
    // Get/set the nameserver(s)
    virtual std::vector<std::string> GetNameServers(void) = 0;
 
-   // callback from application controlled thread to handle any setup
+   // callback from application controlled thread to handle any setup, the
+   // services may also be brought up from a job at startup
    void NetworkMessage(EMESSAGE message, int param);
 
    static int ParseHex(char *str, unsigned char *addr);
@@ -110,6 +112,7 @@ public:
    static std::string GetMaskByPrefixLength(uint8_t prefixLength);
 
   std::unique_ptr<CNetworkServices> m_services;
+  CCriticalSection m_servicesSection;
 };
 
 #if defined(TARGET_ANDROID)
@@ -55,6 +55,7 @@
 #include "network/httprequesthandler/HTTPImageTransformationHandler.h"
 #include "network/httprequesthandler/HTTPVfsHandler.h"
 #include "network/httprequesthandler/HTTPJsonRpcHandler.h"
+#include "network/httprequesthandler/HTTPMetricsHandler.h"
 #ifdef HAS_WEB_INTERFACE
 #ifdef HAS_PYTHON
 #include "network/httprequesthandler/HTTPPythonHandler.h"
@@ -83,7 +84,8 @@ CNetworkServices::CNetworkServices()
   m_httpImageHandler(*new CHTTPImageHandler),
   m_httpImageTransformationHandler(*new CHTTPImageTransformationHandler),
   m_httpVfsHandler(*new CHTTPVfsHandler),
-  m_httpJsonRpcHandler(*new CHTTPJsonRpcHandler)
+  m_httpJsonRpcHandler(*new CHTTPJsonRpcHandler),
+  m_httpMetricsHandler(*new CHTTPMetricsHandler)
 #ifdef HAS_WEB_INTERFACE
 #ifdef HAS_PYTHON
   , m_httpPythonHandler(*new CHTTPPythonHandler)
@@ -98,6 +100,7 @@ CNetworkServices::CNetworkServices()
   m_webserver.RegisterRequestHandler(&m_httpImageTransformationHandler);
   m_webserver.RegisterRequestHandler(&m_httpVfsHandler);
   m_webserver.RegisterRequestHandler(&m_httpJsonRpcHandler);
+  m_webserver.RegisterRequestHandler(&m_httpMetricsHandler);
 #ifdef HAS_WEB_INTERFACE
 #ifdef HAS_PYTHON
   m_webserver.RegisterRequestHandler(&m_httpPythonHandler);
@@ -149,6 +152,8 @@ CNetworkServices::~CNetworkServices()
   delete &m_httpVfsHandler;
   m_webserver.UnregisterRequestHandler(&m_httpJsonRpcHandler);
   delete &m_httpJsonRpcHandler;
+  m_webserver.UnregisterRequestHandler(&m_httpMetricsHandler);
+  delete &m_httpMetricsHandler;
   CJSONRPC::Cleanup();
 #ifdef HAS_WEB_INTERFACE
 #ifdef HAS_PYTHON
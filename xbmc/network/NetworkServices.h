@@ -17,6 +17,7 @@ class CHTTPImageHandler;
 class CHTTPImageTransformationHandler;
 class CHTTPVfsHandler;
 class CHTTPJsonRpcHandler;
+class CHTTPMetricsHandler;
 #ifdef HAS_WEB_INTERFACE
 #ifdef HAS_PYTHON
 class CHTTPPythonHandler;
@@ -99,6 +100,7 @@ private:
   CHTTPImageTransformationHandler& m_httpImageTransformationHandler;
   CHTTPVfsHandler& m_httpVfsHandler;
   CHTTPJsonRpcHandler& m_httpJsonRpcHandler;
+  CHTTPMetricsHandler& m_httpMetricsHandler;
 #ifdef HAS_WEB_INTERFACE
 #ifdef HAS_PYTHON
   CHTTPPythonHandler& m_httpPythonHandler;
@@ -16,13 +16,19 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "interfaces/json-rpc/JSONRPC.h"
+#include "interfaces/json-rpc/PlayerOperations.h"
 #include "interfaces/AnnouncementManager.h"
 #include "utils/log.h"
 #include "utils/Variant.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #include "websocket/WebSocketManager.h"
 #include "Network.h"
 
+#include <algorithm>
+#include <map>
+#include <set>
+
 #if defined(TARGET_WINDOWS) || defined(HAVE_LIBBLUETOOTH)
 static const char     bt_service_name[] = "XBMC JSON-RPC";
 static const char     bt_service_desc[] = "Interface for XBMC remote control over bluetooth";
@@ -49,6 +55,8 @@ static const bdaddr_t bt_bdaddr_local = {{0, 0, 0, 0xff, 0xff, 0xff}};
 using namespace JSONRPC;
 
 #define RECEIVEBUFFER 1024
+// how often the changes of subscribed player properties are pushed
+#define PLAYER_PROPERTIES_INTERVAL_MS 250
 
 CTCPServer *CTCPServer::ServerInstance = NULL;
 
@@ -105,6 +113,12 @@ void CTCPServer::Process()
     struct timeval  to     = {1, 0};
     FD_ZERO(&rfds);
 
+    if (m_playerSubscribers)
+    {
+      to.tv_sec = 0;
+      to.tv_usec = PLAYER_PROPERTIES_INTERVAL_MS * 1000;
+    }
+
     for (auto& it : m_servers)
     {
       FD_SET(it, &rfds);
@@ -202,11 +216,103 @@ void CTCPServer::Process()
         }
       }
     }
+
+    if (XbmcThreads::SystemClockMillis() - m_lastPlayerPush >= PLAYER_PROPERTIES_INTERVAL_MS)
+    {
+      m_lastPlayerPush = XbmcThreads::SystemClockMillis();
+      PushPlayerProperties();
+    }
   }
 
   Deinitialize();
 }
 
+void CTCPServer::PushPlayerProperties()
+{
+  // the properties of all clients are retrieved at once
+  std::set<std::string> names;
+  for (auto client : m_connections)
+  {
+    CSingleLock lock(client->m_critSection);
+    names.insert(client->m_playerProperties.begin(), client->m_playerProperties.end());
+  }
+
+  m_playerSubscribers = !names.empty();
+  if (names.empty())
+  {
+    m_playerId = -1;
+    m_playerState.clear();
+    return;
+  }
+
+  CVariant players;
+  CPlayerOperations::GetActivePlayers("Player.GetActivePlayers", this, nullptr, CVariant(), players);
+
+  int playerId = players.empty() ? -1 : static_cast<int>(players[0]["playerid"].asInteger());
+  CVariant state(CVariant::VariantTypeObject);
+  if (playerId >= 0)
+  {
+    CVariant params;
+    params["playerid"] = playerId;
+    for (const auto& name : names)
+      params["properties"].push_back(name);
+
+    if (CPlayerOperations::GetProperties("Player.GetProperties", this, nullptr, params, state) != OK)
+      return;
+  }
+
+  CVariant changed(CVariant::VariantTypeObject);
+  for (const auto& name : names)
+  {
+    if (playerId != m_playerId || !m_playerState.isMember(name) || m_playerState[name] != state[name])
+      changed[name] = state[name];
+  }
+
+  m_playerId = playerId;
+  m_playerState = state;
+  if (playerId < 0)
+    return;
+
+  bool compact = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_jsonOutputCompact;
+
+  // clients subscribed to the same properties share one serialized notification
+  std::map<std::vector<std::string>, std::string> notifications[2];
+  for (auto client : m_connections)
+  {
+    std::vector<std::string> properties;
+    bool full;
+    {
+      CSingleLock lock(client->m_critSection);
+      if (client->m_playerProperties.empty() || (client->GetAnnouncementFlags() & ANNOUNCEMENT::Player) == 0)
+        continue;
+      properties = client->m_playerProperties;
+      full = !client->m_playerPropertiesSent;
+      client->m_playerPropertiesSent = true;
+    }
+
+    auto it = notifications[full].find(properties);
+    if (it == notifications[full].end())
+    {
+      CVariant data;
+      data["player"]["playerid"] = playerId;
+      data["property"] = CVariant(CVariant::VariantTypeObject);
+      for (const auto& property : properties)
+      {
+        if (full || changed.isMember(property))
+          data["property"][property] = state[property];
+      }
+
+      std::string str;
+      if (!data["property"].empty())
+        str = IJSONRPCAnnouncer::AnnouncementToJSONRPC(ANNOUNCEMENT::Player, "xbmc", "OnPropertyChanged", data, compact);
+      it = notifications[full].insert(std::make_pair(properties, str)).first;
+    }
+
+    if (!it->second.empty())
+      client->Send(it->second.c_str(), it->second.size());
+  }
+}
+
 bool CTCPServer::PrepareDownload(const char *path, CVariant &details, std::string &protocol)
 {
   return false;
@@ -493,6 +599,7 @@ CTCPServer::CTCPClient::CTCPClient()
   m_endBrackets = 0;
   m_beginChar = 0;
   m_endChar = 0;
+  m_playerPropertiesSent = false;
 
   m_addrlen = sizeof(m_cliaddr);
 }
@@ -524,6 +631,22 @@ bool CTCPServer::CTCPClient::SetAnnouncementFlags(int flags)
   return true;
 }
 
+bool CTCPServer::CTCPClient::SetPlayerProperties(const std::vector<std::string>& properties)
+{
+  CSingleLock lock(m_critSection);
+  m_playerProperties = properties;
+  std::sort(m_playerProperties.begin(), m_playerProperties.end());
+  m_playerProperties.erase(std::unique(m_playerProperties.begin(), m_playerProperties.end()), m_playerProperties.end());
+  m_playerPropertiesSent = false;
+  return true;
+}
+
+std::vector<std::string> CTCPServer::CTCPClient::GetPlayerProperties()
+{
+  CSingleLock lock(m_critSection);
+  return m_playerProperties;
+}
+
 void CTCPServer::CTCPClient::Send(const char *data, unsigned int size)
 {
   unsigned int sent = 0;
@@ -629,6 +752,8 @@ void CTCPServer::CTCPClient::Copy(const CTCPClient& client)
   m_beginChar         = client.m_beginChar;
   m_endChar           = client.m_endChar;
   m_buffer            = client.m_buffer;
+  m_playerProperties  = client.m_playerProperties;
+  m_playerPropertiesSent = client.m_playerPropertiesSent;
 }
 
 CTCPServer::CWebSocketClient::CWebSocketClient(CWebSocket *websocket)
@@ -13,16 +13,16 @@
 #include "interfaces/json-rpc/ITransportLayer.h"
 #include "threads/CriticalSection.h"
 #include "threads/Thread.h"
+#include "utils/Variant.h"
 #include "websocket/WebSocket.h"
 
+#include <string>
 #include <vector>
 
 #include <sys/socket.h>
 
 #include "PlatformDefs.h"
 
-class CVariant;
-
 namespace JSONRPC
 {
   class CTCPServer : public ITransportLayer, public JSONRPC::IJSONRPCAnnouncer, public CThread
@@ -45,6 +45,7 @@ namespace JSONRPC
     bool InitializeBlue();
     bool InitializeTCP();
     void Deinitialize();
+    void PushPlayerProperties();
 
     class CTCPClient : public IClient
     {
@@ -59,6 +60,8 @@ namespace JSONRPC
       int GetPermissionFlags() override;
       int GetAnnouncementFlags() override;
       bool SetAnnouncementFlags(int flags) override;
+      bool SetPlayerProperties(const std::vector<std::string>& properties) override;
+      std::vector<std::string> GetPlayerProperties() override;
 
       virtual void Send(const char *data, unsigned int size);
       virtual void PushBuffer(CTCPServer *host, const char *buffer, int length);
@@ -72,6 +75,9 @@ namespace JSONRPC
       socklen_t m_addrlen;
       CCriticalSection m_critSection;
 
+      std::vector<std::string> m_playerProperties;
+      bool m_playerPropertiesSent; // false until the client got all values of its properties
+
     protected:
       void Copy(const CTCPClient& client);
     private:
@@ -108,6 +114,12 @@ namespace JSONRPC
     bool m_nonlocal;
     void* m_sdpd;
 
+    // last values of the properties any client subscribed to, only the changes are pushed
+    int m_playerId = -1;
+    CVariant m_playerState;
+    bool m_playerSubscribers = false;
+    unsigned int m_lastPlayerPush = 0;
+
     static CTCPServer *ServerInstance;
   };
 }
@@ -518,6 +518,7 @@ bool CWakeOnAccess::WakeUpHost(const WakeUpEntry& server)
   if (PingResponseWaiter::Ping(server, 500)) // quick ping with short timeout to not block too long
   {
     CLog::Log(LOGNOTICE,"WakeOnAccess success exit, server already running");
+    CDNSNameCache::SetAlive(server.host);
     return true;
   }
 
@@ -555,6 +556,7 @@ bool CWakeOnAccess::WakeUpHost(const WakeUpEntry& server)
 
     CLog::Log(LOGNOTICE,"WakeOnAccess sequence completed, server started");
   }
+  CDNSNameCache::SetAlive(server.host);
   return true;
 }
 
@@ -572,7 +574,10 @@ bool CWakeOnAccess::FindOrTouchHostEntry(const std::string& hostName, bool upnpM
     {
       CDateTime now = CDateTime::GetCurrentDateTime();
 
-      if (now >= (upnp ? upnp->m_nextWake : server.nextWake))
+      // a protocol reached the host recently, no need to check it again
+      bool alive = !upnp && CDNSNameCache::IsAlive(server.host, server.timeout.GetSecondsTotal() * 1000);
+
+      if (!alive && now >= (upnp ? upnp->m_nextWake : server.nextWake))
       {
         result = server;
 
@@ -701,7 +706,11 @@ void CWakeOnAccess::QueueMACDiscoveryForAllRemotes()
   }
 
   for (const std::string& host : hosts)
+  {
+    // resolve in the background so browsing the sources doesn't wait for it
+    CDNSNameCache::Prefetch(host);
     QueueMACDiscoveryForHost(host);
+  }
 }
 
 void CWakeOnAccess::SaveMACDiscoveryResult(const std::string& host, const std::string& mac)
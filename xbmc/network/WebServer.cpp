@@ -14,10 +14,13 @@
 #include <utility>
 
 #if defined(TARGET_POSIX)
+#include <fcntl.h>
 #include <pthread.h>
+#include <unistd.h>
 #endif
 
 #include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
 #include "network/httprequesthandler/HTTPRequestHandlerUtils.h"
 #include "network/httprequesthandler/IHTTPRequestHandler.h"
 #include "settings/AdvancedSettings.h"
@@ -25,8 +28,10 @@
 #include "settings/SettingsComponent.h"
 #include "ServiceBroker.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #include "Util.h"
 #include "utils/FileUtils.h"
+#include "utils/JobManager.h"
 #include "utils/log.h"
 #include "utils/Mime.h"
 #include "utils/StringUtils.h"
@@ -35,6 +40,12 @@
 #include "XBDateTime.h"
 
 #define MAX_POST_BUFFER_SIZE 2048
+// handlers blocking a pooled thread for longer are logged
+#define SLOW_REQUEST_MS 1000
+// read ahead of remote files by a job, mhd asks for far smaller blocks
+#define ASYNC_READ_SIZE (256 * 1024)
+// largest block mhd asks the content reader callback for
+#define FILE_RESPONSE_BLOCK_SIZE (64 * 1024)
 
 #define PAGE_FILE_NOT_FOUND "<html><head><title>File not found</title></head><body>File not found</body></html>"
 #define NOT_SUPPORTED       "<html><head><title>Not Supported</title></head><body>The method you are trying to use is not supported by this server</body></html>"
@@ -43,7 +54,8 @@
 
 #define HEADER_NEWLINE        "\r\n"
 
-typedef struct {
+struct HttpFileDownloadContext
+{
   std::shared_ptr<XFILE::CFile> file;
   CHttpRanges ranges;
   size_t rangeCountTotal;
@@ -53,7 +65,16 @@ typedef struct {
   bool boundaryWritten;
   std::string contentType;
   uint64_t writePosition;
-} HttpFileDownloadContext;
+
+  // remote files served by the thread pool are read ahead by a job
+  const CWebServer* server = nullptr;
+  struct MHD_Connection* connection = nullptr;
+  bool asyncRead = false;
+  std::vector<char> readBuffer;
+  uint64_t readPosition = 0; // file position of readBuffer
+  size_t readOffset = 0;
+  bool readFailed = false;
+};
 
 CWebServer::CWebServer()
   : m_authenticationUsername("kodi"),
@@ -75,6 +96,27 @@ CWebServer::CWebServer()
 #endif
 }
 
+// files on a local filesystem are sent by mhd with sendfile() straight from the page cache
+static MHD_Response* create_local_file_response(const std::string& path, uint64_t size, uint64_t offset)
+{
+#if defined(TARGET_POSIX)
+  std::string localPath = CSpecialProtocol::TranslatePath(path);
+  if (localPath.empty() || URIUtils::IsURL(localPath))
+    return nullptr;
+
+  int fd = open(localPath.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0)
+    return nullptr;
+
+  MHD_Response* response = MHD_create_response_from_fd_at_offset64(size, fd, offset);
+  if (response == nullptr)
+    close(fd);
+  return response;
+#else
+  return nullptr;
+#endif
+}
+
 static MHD_Response* create_response(size_t size, const void* data, int free, int copy)
 {
   MHD_ResponseMemoryMode mode = MHD_RESPMEM_PERSISTENT;
@@ -158,9 +200,23 @@ int CWebServer::AnswerToConnection(void *cls, struct MHD_Connection *connection,
   HTTPRequest request = { webServer, connection, connectionHandler->fullUri, url, methodType, version };
 
   if (connectionHandler->isNew)
+  {
     webServer->LogRequest(request);
+    webServer->m_requests++;
+  }
+
+  unsigned int start = XbmcThreads::SystemClockMillis();
+  int ret = webServer->HandlePartialRequest(connection, connectionHandler, request, upload_data, upload_data_size, con_cls);
+  unsigned int duration = XbmcThreads::SystemClockMillis() - start;
 
-  return webServer->HandlePartialRequest(connection, connectionHandler, request, upload_data, upload_data_size, con_cls);
+  webServer->m_handlingTimeMs += duration;
+  unsigned int maxDuration = webServer->m_maxHandlingTimeMs;
+  while (duration > maxDuration && !webServer->m_maxHandlingTimeMs.compare_exchange_weak(maxDuration, duration))
+    ;
+  if (duration >= SLOW_REQUEST_MS)
+    CLog::Log(LOGDEBUG, LOGWEBSERVER, "CWebServer[%hu]: handling %s took %u ms", webServer->m_port, request.pathUrl.c_str(), duration);
+
+  return ret;
 }
 
 int CWebServer::HandlePartialRequest(struct MHD_Connection *connection, ConnectionHandler* connectionHandler, const HTTPRequest& request, const char *upload_data, size_t *upload_data_size, void **con_cls)
@@ -192,6 +248,22 @@ int CWebServer::HandlePartialRequest(struct MHD_Connection *connection, Connecti
         {
           bool cacheable = IsRequestCacheable(request);
 
+          // handle If-None-Match, it takes precedence over If-Modified-Since
+          std::string etag;
+          std::string ifNoneMatch = HTTPRequestHandlerUtils::GetRequestHeaderValue(connection, MHD_HEADER_KIND, MHD_HTTP_HEADER_IF_NONE_MATCH);
+          bool hasETag = handler->GetETag(etag) && !etag.empty();
+          if (cacheable && hasETag && !ifNoneMatch.empty() && IsETagMatching(ifNoneMatch, etag))
+          {
+            struct MHD_Response *response = create_response(0, nullptr, MHD_NO, MHD_NO);
+            if (response == nullptr)
+            {
+              CLog::Log(LOGERROR, "CWebServer[%hu]: failed to create a HTTP 304 response", m_port);
+              return MHD_NO;
+            }
+
+            return FinalizeRequest(handler, MHD_HTTP_NOT_MODIFIED, response);
+          }
+
           CDateTime lastModified;
           if (handler->GetLastModifiedDate(lastModified) && lastModified.IsValid())
           {
@@ -202,7 +274,7 @@ int CWebServer::HandlePartialRequest(struct MHD_Connection *connection, Connecti
             CDateTime ifModifiedSinceDate;
             CDateTime ifUnmodifiedSinceDate;
             // handle If-Modified-Since (but only if the response is cacheable)
-            if (cacheable &&
+            if (cacheable && (!hasETag || ifNoneMatch.empty()) &&
               ifModifiedSinceDate.SetFromRFC1123DateTime(ifModifiedSince) &&
               lastModified.GetAsUTCDateTime() <= ifModifiedSinceDate)
             {
@@ -365,6 +437,11 @@ int CWebServer::FinalizeRequest(const std::shared_ptr<IHTTPRequestHandler>& hand
   if (handler->GetLastModifiedDate(lastModified) && lastModified.IsValid())
     handler->AddResponseHeader(MHD_HTTP_HEADER_LAST_MODIFIED, lastModified.GetAsRFC1123DateTime());
 
+  // if the request handler has set an entity tag and it hasn't been set as a header, add it
+  std::string etag;
+  if (handler->GetETag(etag) && !etag.empty())
+    handler->AddResponseHeader(MHD_HTTP_HEADER_ETAG, etag);
+
   // check if the request handler has set Cache-Control and add it if not
   if (!handler->HasResponseHeader(MHD_HTTP_HEADER_CACHE_CONTROL))
   {
@@ -457,6 +534,23 @@ bool CWebServer::IsRequestCacheable(const HTTPRequest& request) const
   return true;
 }
 
+bool CWebServer::IsETagMatching(const std::string& ifNoneMatch, const std::string& etag)
+{
+  for (auto tag : StringUtils::Split(ifNoneMatch, ","))
+  {
+    tag = StringUtils::Trim(tag);
+
+    // If-None-Match uses the weak comparison
+    if (StringUtils::StartsWith(tag, "W/"))
+      tag.erase(0, 2);
+
+    if (tag == "*" || tag == etag)
+      return true;
+  }
+
+  return false;
+}
+
 bool CWebServer::IsRequestRanged(const HTTPRequest& request, const CDateTime &lastModified) const
 {
   // parse the Range header and store it in the request object
@@ -729,7 +823,9 @@ int CWebServer::CreateFileDownloadResponse(const std::shared_ptr<IHTTPRequestHan
   if (!CFileUtils::CheckFileAccessAllowed(filePath))
     return SendErrorResponse(request, MHD_HTTP_NOT_FOUND, request.method);
 
-  if (!file->Open(filePath, XFILE::READ_NO_CACHE))
+  // network sources are read ahead by the file cache
+  bool local = URIUtils::IsHD(filePath);
+  if (!file->Open(filePath, local ? XFILE::READ_NO_CACHE : XFILE::READ_CACHED))
   {
     CLog::Log(LOGERROR, "CWebServer[%hu]: Failed to open %s", m_port, filePath.c_str());
     return SendErrorResponse(request, MHD_HTTP_NOT_FOUND, request.method);
@@ -755,6 +851,10 @@ int CWebServer::CreateFileDownloadResponse(const std::shared_ptr<IHTTPRequestHan
     context->contentType = mimeType;
     context->boundaryWritten = false;
     context->writePosition = 0;
+    context->server = this;
+    context->connection = request.connection;
+    // a slow read would block one of the pooled threads serving all connections
+    context->asyncRead = m_threadPoolSize > 0 && !local;
 
     if (handler->IsRequestRanged())
     {
@@ -814,18 +914,26 @@ int CWebServer::CreateFileDownloadResponse(const std::shared_ptr<IHTTPRequestHan
     // set the initial write position
     context->ranges.GetFirstPosition(context->writePosition);
 
+    // a single range of a local file doesn't need to be copied through the callback
+    response = nullptr;
+    if (local && context->rangeCountTotal == 1)
+      response = create_local_file_response(filePath, totalLength, context->writePosition);
+
     // create the response object
-    response = MHD_create_response_from_callback(totalLength, 2048,
-                                                  &CWebServer::ContentReaderCallback,
-                                                  context.get(),
-                                                  &CWebServer::ContentReaderFreeCallback);
     if (response == nullptr)
     {
-      CLog::Log(LOGERROR, "CWebServer[%hu]: failed to create a HTTP response for %s to be filled from %s", m_port, request.pathUrl.c_str(), filePath.c_str());
-      return MHD_NO;
-    }
+      response = MHD_create_response_from_callback(totalLength, FILE_RESPONSE_BLOCK_SIZE,
+                                                    &CWebServer::ContentReaderCallback,
+                                                    context.get(),
+                                                    &CWebServer::ContentReaderFreeCallback);
+      if (response == nullptr)
+      {
+        CLog::Log(LOGERROR, "CWebServer[%hu]: failed to create a HTTP response for %s to be filled from %s", m_port, request.pathUrl.c_str(), filePath.c_str());
+        return MHD_NO;
+      }
 
-    context.release(); // ownership was passed to mhd
+      context.release(); // ownership was passed to mhd
+    }
 
     // add Content-Range header
     if (ranged)
@@ -965,6 +1073,24 @@ ssize_t CWebServer::ContentReaderCallback(void *cls, uint64_t pos, char *buf, si
   uint64_t maximum = (uint64_t)max;
   int written = 0;
 
+  // check if the current position is within this range
+  // if not, set it to the start position
+  if (context->writePosition < start || context->writePosition > end)
+    context->writePosition = start;
+
+  // without read ahead data for the current position suspend the connection until a job read it
+  bool readAhead = context->asyncRead && context->readOffset < context->readBuffer.size() &&
+                   context->readPosition + context->readOffset == context->writePosition;
+  if (context->asyncRead && !readAhead)
+  {
+    if (context->readFailed)
+      return -1;
+
+    uint64_t size = std::min<uint64_t>(ASYNC_READ_SIZE, end - context->writePosition + 1);
+    if (context->server->StartAsyncRead(context, context->writePosition, static_cast<size_t>(size)))
+      return 0;
+  }
+
   if (context->rangeCountTotal > 1 && !context->boundaryWritten)
   {
     // add a newline before any new multipart boundary
@@ -991,19 +1117,25 @@ ssize_t CWebServer::ContentReaderCallback(void *cls, uint64_t pos, char *buf, si
     context->boundaryWritten = true;
   }
 
-  // check if the current position is within this range
-  // if not, set it to the start position
-  if (context->writePosition < start || context->writePosition > end)
-    context->writePosition = start;
   // adjust the maximum number of read bytes
   maximum = std::min(maximum, end - context->writePosition + 1);
 
-  // seek to the position if necessary
-  if (context->file->GetPosition() < 0 || context->writePosition != static_cast<uint64_t>(context->file->GetPosition()))
-    context->file->Seek(context->writePosition);
+  ssize_t res;
+  if (readAhead)
+  {
+    res = static_cast<ssize_t>(std::min<uint64_t>(maximum, context->readBuffer.size() - context->readOffset));
+    memcpy(buf, context->readBuffer.data() + context->readOffset, res);
+    context->readOffset += res;
+  }
+  else
+  {
+    // seek to the position if necessary
+    if (context->file->GetPosition() < 0 || context->writePosition != static_cast<uint64_t>(context->file->GetPosition()))
+      context->file->Seek(context->writePosition);
 
-  // read data from the file
-  ssize_t res = context->file->Read(buf, static_cast<size_t>(maximum));
+    // read data from the file
+    res = context->file->Read(buf, static_cast<size_t>(maximum));
+  }
   if (res <= 0)
     return -1;
 
@@ -1026,6 +1158,43 @@ ssize_t CWebServer::ContentReaderCallback(void *cls, uint64_t pos, char *buf, si
   return written;
 }
 
+bool CWebServer::StartAsyncRead(HttpFileDownloadContext* context, uint64_t position, size_t size) const
+{
+  // Stop() waits for pending reads, a read counted after it checked would resume a stopped daemon
+  if (m_stopping)
+    return false;
+  m_pendingReads++;
+  if (m_stopping)
+  {
+    m_pendingReads--;
+    m_readsDone.Set();
+    return false;
+  }
+
+  MHD_suspend_connection(context->connection);
+
+  CJobManager::GetInstance().Submit([this, context, position, size]()
+  {
+    context->readBuffer.resize(size);
+    ssize_t read = -1;
+    if (context->file->Seek(position) == static_cast<int64_t>(position))
+      read = context->file->Read(context->readBuffer.data(), size);
+
+    context->readBuffer.resize(read > 0 ? read : 0);
+    context->readPosition = position;
+    context->readOffset = 0;
+    context->readFailed = read <= 0;
+
+    // the connection may be finished and its context freed as soon as it's resumed
+    MHD_resume_connection(context->connection);
+
+    m_pendingReads--;
+    m_readsDone.Set();
+  }, CJob::PRIORITY_HIGH);
+
+  return true;
+}
+
 void CWebServer::ContentReaderFreeCallback(void *cls)
 {
   HttpFileDownloadContext *context = (HttpFileDownloadContext *)cls;
@@ -1099,6 +1268,40 @@ bool CWebServer::LoadCert(std::string &skey, std::string &scert)
   return false;
 }
 
+unsigned int CWebServer::GetDaemonFlags() const
+{
+  unsigned int flags = MHD_USE_DEBUG; /* Print MHD error messages to log */
+
+  if (m_threadPoolSize == 0)
+  {
+    // one thread per connection
+    // WARNING: set MHD_OPTION_CONNECTION_TIMEOUT to something higher than 1
+    // otherwise on libmicrohttpd 0.4.4-1 it spins a busy loop
+    flags |= MHD_USE_THREAD_PER_CONNECTION;
+#if (MHD_VERSION >= 0x00095207)
+    flags |= MHD_USE_INTERNAL_POLLING_THREAD; /* MHD_USE_THREAD_PER_CONNECTION must be used only with MHD_USE_INTERNAL_POLLING_THREAD since 0.9.54 */
+#endif
+    return flags;
+  }
+
+  // a pool of threads waiting for the events of all connections, slow file reads suspend their connection
+#if (MHD_VERSION >= 0x00095207)
+  flags |= MHD_USE_INTERNAL_POLLING_THREAD | MHD_ALLOW_SUSPEND_RESUME;
+  if (MHD_is_feature_supported(MHD_FEATURE_EPOLL) == MHD_YES)
+    flags |= MHD_USE_EPOLL;
+  else if (MHD_is_feature_supported(MHD_FEATURE_POLL) == MHD_YES)
+    flags |= MHD_USE_POLL;
+#else
+  flags |= MHD_USE_SELECT_INTERNALLY | MHD_USE_SUSPEND_RESUME;
+  if (MHD_is_feature_supported(MHD_FEATURE_EPOLL) == MHD_YES)
+    flags |= MHD_USE_EPOLL_LINUX_ONLY;
+  else if (MHD_is_feature_supported(MHD_FEATURE_POLL) == MHD_YES)
+    flags |= MHD_USE_POLL;
+#endif
+
+  return flags;
+}
+
 struct MHD_Daemon* CWebServer::StartMHD(unsigned int flags, int port)
 {
   unsigned int timeout = 60 * 60 * 24;
@@ -1106,60 +1309,71 @@ struct MHD_Daemon* CWebServer::StartMHD(unsigned int flags, int port)
 
   MHD_set_panic_func(&panicHandlerForMHD, nullptr);
 
+  std::vector<MHD_OptionItem> options = {
+    { MHD_OPTION_CONNECTION_LIMIT, 512, nullptr },
+    { MHD_OPTION_CONNECTION_TIMEOUT, timeout, nullptr },
+    { MHD_OPTION_URI_LOG_CALLBACK, reinterpret_cast<intptr_t>(&CWebServer::UriRequestLogger), this },
+    { MHD_OPTION_EXTERNAL_LOGGER, reinterpret_cast<intptr_t>(&logFromMHD), nullptr },
+    { MHD_OPTION_THREAD_STACK_SIZE, static_cast<intptr_t>(m_thread_stacksize), nullptr },
+#if (MHD_VERSION >= 0x00095207)
+    { MHD_OPTION_NOTIFY_CONNECTION, reinterpret_cast<intptr_t>(&CWebServer::NotifyConnection), this },
+#endif
+  };
+
+  if (m_threadPoolSize > 0)
+    options.push_back({ MHD_OPTION_THREAD_POOL_SIZE, m_threadPoolSize, nullptr });
+
   if (CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_SERVICES_WEBSERVERSSL) &&
       MHD_is_feature_supported(MHD_FEATURE_SSL) == MHD_YES &&
       LoadCert(m_key, m_cert))
+  {
     // SSL enabled
-    return MHD_start_daemon(flags |
-                          // one thread per connection
-                          // WARNING: set MHD_OPTION_CONNECTION_TIMEOUT to something higher than 1
-                          // otherwise on libmicrohttpd 0.4.4-1 it spins a busy loop
-                          MHD_USE_THREAD_PER_CONNECTION
-#if (MHD_VERSION >= 0x00095207)
-                          | MHD_USE_INTERNAL_POLLING_THREAD /* MHD_USE_THREAD_PER_CONNECTION must be used only with MHD_USE_INTERNAL_POLLING_THREAD since 0.9.54 */
-#endif
-                          | MHD_USE_DEBUG /* Print MHD error messages to log */
-                          | MHD_USE_SSL
-                          ,
+    flags |= MHD_USE_SSL;
+    options.push_back({ MHD_OPTION_HTTPS_MEM_KEY, 0, const_cast<char*>(m_key.c_str()) });
+    options.push_back({ MHD_OPTION_HTTPS_MEM_CERT, 0, const_cast<char*>(m_cert.c_str()) });
+    options.push_back({ MHD_OPTION_HTTPS_PRIORITIES, 0, const_cast<char*>(ciphers) });
+  }
+
+  options.push_back({ MHD_OPTION_END, 0, nullptr });
+
+  return MHD_start_daemon(flags | GetDaemonFlags(),
                           port,
                           0,
                           0,
                           &CWebServer::AnswerToConnection,
                           this,
 
-                          MHD_OPTION_CONNECTION_LIMIT, 512,
-                          MHD_OPTION_CONNECTION_TIMEOUT, timeout,
-                          MHD_OPTION_URI_LOG_CALLBACK, &CWebServer::UriRequestLogger, this,
-                          MHD_OPTION_EXTERNAL_LOGGER, &logFromMHD, 0,
-                          MHD_OPTION_THREAD_STACK_SIZE, m_thread_stacksize,
-                          MHD_OPTION_HTTPS_MEM_KEY, m_key.c_str(),
-                          MHD_OPTION_HTTPS_MEM_CERT, m_cert.c_str(),
-                          MHD_OPTION_HTTPS_PRIORITIES, ciphers,
+                          MHD_OPTION_ARRAY, options.data(),
                           MHD_OPTION_END);
+}
 
-  // No SSL
-  return MHD_start_daemon(flags |
-                          // one thread per connection
-                          // WARNING: set MHD_OPTION_CONNECTION_TIMEOUT to something higher than 1
-                          // otherwise on libmicrohttpd 0.4.4-1 it spins a busy loop
-                          MHD_USE_THREAD_PER_CONNECTION
 #if (MHD_VERSION >= 0x00095207)
-                          | MHD_USE_INTERNAL_POLLING_THREAD /* MHD_USE_THREAD_PER_CONNECTION must be used only with MHD_USE_INTERNAL_POLLING_THREAD since 0.9.54 */
+void CWebServer::NotifyConnection(void *cls, struct MHD_Connection *connection,
+                                  void **socket_context, enum MHD_ConnectionNotificationCode toe)
+{
+  CWebServer *webServer = reinterpret_cast<CWebServer*>(cls);
+  if (webServer == nullptr)
+    return;
+
+  if (toe == MHD_CONNECTION_NOTIFY_STARTED)
+  {
+    unsigned int connections = ++webServer->m_connections;
+    unsigned int peak = webServer->m_peakConnections;
+    while (connections > peak && !webServer->m_peakConnections.compare_exchange_weak(peak, connections))
+      ;
+  }
+  else if (toe == MHD_CONNECTION_NOTIFY_CLOSED)
+    webServer->m_connections--;
+}
 #endif
-                          | MHD_USE_DEBUG /* Print MHD error messages to log */
-                          ,
-                          port,
-                          0,
-                          0,
-                          &CWebServer::AnswerToConnection,
-                          this,
 
-                          MHD_OPTION_CONNECTION_LIMIT, 512,
-                          MHD_OPTION_CONNECTION_TIMEOUT, timeout,
-                          MHD_OPTION_URI_LOG_CALLBACK, &CWebServer::UriRequestLogger, this,
-                          MHD_OPTION_EXTERNAL_LOGGER, &logFromMHD, 0,
-                          MHD_OPTION_THREAD_STACK_SIZE, m_thread_stacksize,
-                          MHD_OPTION_END);
+void CWebServer::LogStatistics() const
+{
+  uint64_t requests = m_requests;
+  CLog::Log(LOGNOTICE, "CWebServer[%hu]: served %" PRIu64 " requests, peak of %u connections, "
+            "handling took %" PRIu64 " ms on average and %u ms at most",
+            m_port, requests, m_peakConnections.load(),
+            requests > 0 ? m_handlingTimeMs / requests : 0, m_maxHandlingTimeMs.load());
 }
 
 bool CWebServer::Start(uint16_t port, const std::string &username, const std::string &password)
@@ -1167,6 +1381,14 @@ bool CWebServer::Start(uint16_t port, const std::string &username, const std::st
   SetCredentials(username, password);
   if (!m_running)
   {
+    m_threadPoolSize = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_webServerThreadPoolSize;
+    m_stopping = false;
+    m_connections = 0;
+    m_peakConnections = 0;
+    m_requests = 0;
+    m_handlingTimeMs = 0;
+    m_maxHandlingTimeMs = 0;
+
     int v6testSock;
     if ((v6testSock = socket(AF_INET6, SOCK_STREAM, 0)) >= 0)
     {
@@ -1179,7 +1401,10 @@ bool CWebServer::Start(uint16_t port, const std::string &username, const std::st
     if (m_running)
     {
       m_port = port;
-      CLog::Log(LOGNOTICE, "CWebServer[%hu]: Started", m_port);
+      if (m_threadPoolSize > 0)
+        CLog::Log(LOGNOTICE, "CWebServer[%hu]: Started with %u threads", m_port, m_threadPoolSize);
+      else
+        CLog::Log(LOGNOTICE, "CWebServer[%hu]: Started", m_port);
     }
     else
       CLog::Log(LOGERROR, "CWebServer[%hu]: Failed to start", port);
@@ -1193,13 +1418,22 @@ bool CWebServer::Stop()
   if (!m_running)
     return true;
 
+  // suspended connections have to be resumed before their daemon is stopped
+  m_stopping = true;
+  while (m_pendingReads > 0)
+    m_readsDone.WaitMSec(100);
+
   if (m_daemon_ip6 != nullptr)
     MHD_stop_daemon(m_daemon_ip6);
 
   if (m_daemon_ip4 != nullptr)
     MHD_stop_daemon(m_daemon_ip4);
 
+  m_daemon_ip6 = nullptr;
+  m_daemon_ip4 = nullptr;
+
   m_running = false;
+  LogStatistics();
   CLog::Log(LOGNOTICE, "CWebServer[%hu]: Stopped", m_port);
   m_port = 0;
 
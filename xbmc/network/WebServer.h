@@ -10,7 +10,9 @@
 
 #include "network/httprequesthandler/IHTTPRequestHandler.h"
 #include "threads/CriticalSection.h"
+#include "threads/Event.h"
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -20,6 +22,7 @@ namespace XFILE
 }
 class CDateTime;
 class CVariant;
+struct HttpFileDownloadContext;
 
 class CWebServer
 {
@@ -63,6 +66,10 @@ protected:
 
 private:
   struct MHD_Daemon* StartMHD(unsigned int flags, int port);
+  unsigned int GetDaemonFlags() const;
+
+  bool StartAsyncRead(HttpFileDownloadContext* context, uint64_t position, size_t size) const;
+  void LogStatistics() const;
 
   std::shared_ptr<IHTTPRequestHandler> FindRequestHandler(const HTTPRequest& request) const;
 
@@ -70,6 +77,7 @@ private:
   bool IsAuthenticated(const HTTPRequest& request) const;
 
   bool IsRequestCacheable(const HTTPRequest& request) const;
+  static bool IsETagMatching(const std::string& ifNoneMatch, const std::string& etag);
   bool IsRequestRanged(const HTTPRequest& request, const CDateTime &lastModified) const;
 
   void SetupPostDataProcessing(const HTTPRequest& request, ConnectionHandler *connectionHandler, std::shared_ptr<IHTTPRequestHandler> handler, void **con_cls) const;
@@ -100,6 +108,11 @@ private:
   static ssize_t ContentReaderCallback (void *cls, uint64_t pos, char *buf, size_t max);
   static void ContentReaderFreeCallback(void *cls);
 
+#if (MHD_VERSION >= 0x00095207)
+  static void NotifyConnection(void *cls, struct MHD_Connection *connection,
+                               void **socket_context, enum MHD_ConnectionNotificationCode toe);
+#endif
+
   static int AnswerToConnection (void *cls, struct MHD_Connection *connection,
                         const char *url, const char *method,
                         const char *version, const char *upload_data,
@@ -116,6 +129,7 @@ private:
   struct MHD_Daemon *m_daemon_ip4 = nullptr;
   bool m_running = false;
   size_t m_thread_stacksize = 0;
+  unsigned int m_threadPoolSize = 0;
   bool m_authenticationRequired = false;
   std::string m_authenticationUsername;
   std::string m_authenticationPassword;
@@ -123,4 +137,15 @@ private:
   std::string m_cert;
   mutable CCriticalSection m_critSection;
   std::vector<IHTTPRequestHandler *> m_requestHandlers;
+
+  // reads of remote files by jobs while their connection is suspended
+  std::atomic<bool> m_stopping{false};
+  mutable std::atomic<unsigned int> m_pendingReads{0};
+  mutable CEvent m_readsDone;
+
+  std::atomic<unsigned int> m_connections{0};
+  std::atomic<unsigned int> m_peakConnections{0};
+  std::atomic<uint64_t> m_requests{0};
+  std::atomic<uint64_t> m_handlingTimeMs{0};
+  std::atomic<unsigned int> m_maxHandlingTimeMs{0};
 };
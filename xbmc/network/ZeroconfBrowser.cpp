@@ -24,6 +24,7 @@
 #include "threads/CriticalSection.h"
 #include "threads/SingleLock.h"
 #include "threads/Atomics.h"
+#include "utils/JobManager.h"
 
 #if !defined(HAS_ZEROCONF)
 //dummy implementation used if no zeroconf is present
@@ -40,7 +41,8 @@ class CZeroconfBrowserDummy : public CZeroconfBrowser
 std::atomic_flag CZeroconfBrowser::sm_singleton_guard = ATOMIC_FLAG_INIT;
 CZeroconfBrowser* CZeroconfBrowser::smp_instance = 0;
 
-CZeroconfBrowser::CZeroconfBrowser():mp_crit_sec(new CCriticalSection)
+CZeroconfBrowser::CZeroconfBrowser():mp_crit_sec(new CCriticalSection),
+  mp_resolve_crit_sec(new CCriticalSection), mp_resolved_crit_sec(new CCriticalSection)
 {
 #ifdef HAS_FILESYSTEM_SMB
   AddServiceType("_smb._tcp.");
@@ -54,6 +56,8 @@ CZeroconfBrowser::CZeroconfBrowser():mp_crit_sec(new CCriticalSection)
 
 CZeroconfBrowser::~CZeroconfBrowser()
 {
+  delete mp_resolved_crit_sec;
+  delete mp_resolve_crit_sec;
   delete mp_crit_sec;
 }
 
@@ -75,6 +79,7 @@ void CZeroconfBrowser::Stop()
   for (const auto& it : m_services)
     RemoveServiceType(it);
   m_started = false;
+  ForgetResolvedServices();
 }
 
 bool CZeroconfBrowser::AddServiceType(const std::string& fcr_service_type /*const std::string& domain*/ )
@@ -118,13 +123,74 @@ std::vector<CZeroconfBrowser::ZeroconfService> CZeroconfBrowser::GetFoundService
 
 bool CZeroconfBrowser::ResolveService(ZeroconfService& fr_service, double f_timeout)
 {
-  CSingleLock lock(*mp_crit_sec);
-  if(m_started)
   {
-    return doResolveService(fr_service, f_timeout);
+    CSingleLock lock(*mp_crit_sec);
+    if(!m_started)
+    {
+      CLog::Log(LOGDEBUG, "CZeroconfBrowser::GetFoundServices asked for services without browser running");
+      return false;
+    }
+  }
+
+  const std::string path = ZeroconfService::toPath(fr_service);
+  if(GetResolvedService(path, fr_service))
+    return true;
+
+  CSingleLock resolveLock(*mp_resolve_crit_sec);
+  //it may have been resolved while waiting for the lock
+  if(GetResolvedService(path, fr_service))
+    return true;
+
+  if(!doResolveService(fr_service, f_timeout))
+    return false;
+
+  CSingleLock lock(*mp_resolved_crit_sec);
+  m_resolved_services[path] = fr_service;
+  return true;
+}
+
+bool CZeroconfBrowser::GetResolvedService(const std::string& path, ZeroconfService& fr_service)
+{
+  CSingleLock lock(*mp_resolved_crit_sec);
+  std::map<std::string, ZeroconfService>::const_iterator it = m_resolved_services.find(path);
+  if(it == m_resolved_services.end())
+    return false;
+  fr_service = it->second;
+  return true;
+}
+
+void CZeroconfBrowser::PrefetchServices(const std::vector<ZeroconfService>& services)
+{
+  std::vector<ZeroconfService> pending;
+  {
+    CSingleLock lock(*mp_resolved_crit_sec);
+    for (const auto& it : services)
+    {
+      if(m_resolved_services.find(ZeroconfService::toPath(it)) == m_resolved_services.end())
+        pending.push_back(it);
+    }
   }
-  CLog::Log(LOGDEBUG, "CZeroconfBrowser::GetFoundServices asked for services without browser running");
-  return false;
+  //one job at a time, it resolves what's still missing when the listing is refreshed
+  if(pending.empty() || m_prefetching.exchange(true))
+    return;
+
+  CJobManager::GetInstance().Submit([this, pending]() {
+    for (auto service : pending)
+      ResolveService(service);
+    m_prefetching = false;
+  }, CJob::PRIORITY_LOW);
+}
+
+void CZeroconfBrowser::ForgetResolvedService(const ZeroconfService& fcr_service)
+{
+  CSingleLock lock(*mp_resolved_crit_sec);
+  m_resolved_services.erase(ZeroconfService::toPath(fcr_service));
+}
+
+void CZeroconfBrowser::ForgetResolvedServices()
+{
+  CSingleLock lock(*mp_resolved_crit_sec);
+  m_resolved_services.clear();
 }
 
 CZeroconfBrowser*  CZeroconfBrowser::GetInstance()
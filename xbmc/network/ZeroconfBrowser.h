@@ -96,6 +96,8 @@ public:
   ///@}
 
   // resolves a ZeroconfService to ip + port
+  // services resolved before are answered from a cache, entries are dropped
+  // when the service is announced again or removed
   // @param fcr_service the service to resolve
   // @param f_timeout timeout in seconds for resolving
   //   the protocol part of CURL is the raw zeroconf service type
@@ -104,6 +106,10 @@ public:
   //         failed (async or not)
   bool ResolveService(ZeroconfService& fr_service, double f_timeout = 1.0);
 
+  // resolves the given services in the background, so opening them later
+  // is answered from the cache
+  void PrefetchServices(const std::vector<ZeroconfService>& services);
+
   // class methods
   // access to singleton; singleton gets created on call if not existent
   // if zeroconf is disabled (!HAS_ZEROCONF), this will return a dummy implementation that
@@ -141,7 +147,13 @@ protected:
   virtual std::vector<ZeroconfService> doGetFoundServices() = 0;
   virtual bool doResolveService(ZeroconfService& fr_service, double f_timeout) = 0;
 
+  // to be called by implementations when a service is announced or removed
+  void ForgetResolvedService(const ZeroconfService& fcr_service);
+  void ForgetResolvedServices();
+
 private:
+  bool GetResolvedService(const std::string& path, ZeroconfService& fr_service);
+
   struct ServiceInfo
   {
     std::string type;
@@ -153,6 +165,13 @@ private:
   tServices m_services;
   bool m_started = false;
 
+  //serializes resolving, so the cache and browsing aren't blocked meanwhile
+  CCriticalSection* mp_resolve_crit_sec;
+  //protects the cache of resolved services, keyed by ZeroconfService::toPath
+  CCriticalSection* mp_resolved_crit_sec;
+  std::map<std::string, ZeroconfService> m_resolved_services;
+  std::atomic<bool> m_prefetching{false};
+
   //protects singleton creation/destruction
   static std::atomic_flag sm_singleton_guard;
   static CZeroconfBrowser* smp_instance;
@@ -8,25 +8,40 @@
 
 #include "HTTPImageTransformationHandler.h"
 
+#include "TextureCache.h"
 #include "TextureCacheJob.h"
+#include "TextureDatabase.h"
 #include "URL.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
 #include "filesystem/ImageFile.h"
 #include "network/WebServer.h"
 #include "network/httprequesthandler/HTTPRequestHandlerUtils.h"
+#include "utils/Digest.h"
 #include "utils/Mime.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
+#include "utils/log.h"
 
 #include <map>
+#include <stdlib.h>
+
+using KODI::UTILITY::CDigest;
 
 #define TRANSFORMATION_OPTION_WIDTH             "width"
 #define TRANSFORMATION_OPTION_HEIGHT            "height"
 #define TRANSFORMATION_OPTION_SCALING_ALGORITHM "scaling_algorithm"
 
 static const std::string ImageBasePath = "/image/";
+static const std::string TransformedImagePath = "transform/";
 
 CHTTPImageTransformationHandler::CHTTPImageTransformationHandler()
   : m_url(),
+    m_imagePath(),
+    m_width(0),
+    m_height(0),
+    m_scalingAlgorithm(),
+    m_imageHash(),
     m_lastModified(),
     m_buffer(NULL),
     m_responseData()
@@ -35,6 +50,11 @@ CHTTPImageTransformationHandler::CHTTPImageTransformationHandler()
 CHTTPImageTransformationHandler::CHTTPImageTransformationHandler(const HTTPRequest &request)
   : IHTTPRequestHandler(request),
     m_url(),
+    m_imagePath(),
+    m_width(0),
+    m_height(0),
+    m_scalingAlgorithm(),
+    m_imageHash(),
     m_lastModified(),
     m_buffer(NULL),
     m_responseData()
@@ -64,6 +84,42 @@ CHTTPImageTransformationHandler::CHTTPImageTransformationHandler(const HTTPReque
   StringUtils::ToLower(ext);
   m_response.contentType = CMime::GetMimeType(ext);
 
+  // get the transformation options
+  std::map<std::string, std::string> options;
+  HTTPRequestHandlerUtils::GetRequestHeaderValues(m_request.connection, MHD_GET_ARGUMENT_KIND, options);
+
+  std::vector<std::string> urlOptions;
+  std::map<std::string, std::string>::const_iterator option = options.find(TRANSFORMATION_OPTION_WIDTH);
+  if (option != options.end())
+  {
+    urlOptions.push_back(TRANSFORMATION_OPTION_WIDTH "=" + option->second);
+    m_width = strtoul(option->second.c_str(), NULL, 10);
+  }
+
+  option = options.find(TRANSFORMATION_OPTION_HEIGHT);
+  if (option != options.end())
+  {
+    urlOptions.push_back(TRANSFORMATION_OPTION_HEIGHT "=" + option->second);
+    m_height = strtoul(option->second.c_str(), NULL, 10);
+  }
+
+  option = options.find(TRANSFORMATION_OPTION_SCALING_ALGORITHM);
+  if (option != options.end())
+  {
+    urlOptions.push_back(TRANSFORMATION_OPTION_SCALING_ALGORITHM "=" + option->second);
+    m_scalingAlgorithm = option->second;
+  }
+
+  m_imagePath = m_url;
+  if (!urlOptions.empty())
+  {
+    m_imagePath += "?";
+    m_imagePath += StringUtils::Join(urlOptions, "&");
+  }
+
+  // identifies the version of the source image the transformed image is made from
+  m_imageHash = CTextureCacheJob::GetImageHash(pathToUrl.GetHostName());
+
   //! @todo determine the maximum age
 
   // determine the last modified date
@@ -87,7 +143,7 @@ CHTTPImageTransformationHandler::CHTTPImageTransformationHandler(const HTTPReque
 CHTTPImageTransformationHandler::~CHTTPImageTransformationHandler()
 {
   m_responseData.clear();
-  delete m_buffer;
+  delete[] m_buffer;
   m_buffer = NULL;
 }
 
@@ -119,38 +175,20 @@ int CHTTPImageTransformationHandler::HandleRequest()
     return MHD_YES;
   }
 
-  // get the transformation options
-  std::map<std::string, std::string> options;
-  HTTPRequestHandlerUtils::GetRequestHeaderValues(m_request.connection, MHD_GET_ARGUMENT_KIND, options);
-
-  std::vector<std::string> urlOptions;
-  std::map<std::string, std::string>::const_iterator option = options.find(TRANSFORMATION_OPTION_WIDTH);
-  if (option != options.end())
-    urlOptions.push_back(TRANSFORMATION_OPTION_WIDTH "=" + option->second);
-
-  option = options.find(TRANSFORMATION_OPTION_HEIGHT);
-  if (option != options.end())
-    urlOptions.push_back(TRANSFORMATION_OPTION_HEIGHT "=" + option->second);
-
-  option = options.find(TRANSFORMATION_OPTION_SCALING_ALGORITHM);
-  if (option != options.end())
-    urlOptions.push_back(TRANSFORMATION_OPTION_SCALING_ALGORITHM "=" + option->second);
-
-  std::string imagePath = m_url;
-  if (!urlOptions.empty())
-  {
-    imagePath += "?";
-    imagePath += StringUtils::Join(urlOptions, "&");
-  }
-
-  // resize the image into the local buffer
+  // repeated requests for the same size are served from the transformed image cache
   size_t bufferSize;
-  if (!CTextureCacheJob::ResizeTexture(imagePath, m_buffer, bufferSize))
+  if (!LoadTransformedImage(bufferSize))
   {
-    m_response.status = MHD_HTTP_INTERNAL_SERVER_ERROR;
-    m_response.type = HTTPError;
+    // resize the image into the local buffer
+    if (!CTextureCacheJob::ResizeTexture(m_imagePath, m_buffer, bufferSize))
+    {
+      m_response.status = MHD_HTTP_INTERNAL_SERVER_ERROR;
+      m_response.type = HTTPError;
 
-    return MHD_YES;
+      return MHD_YES;
+    }
+
+    StoreTransformedImage(bufferSize);
   }
 
   // store the size of the image
@@ -177,3 +215,74 @@ bool CHTTPImageTransformationHandler::GetLastModifiedDate(CDateTime &lastModifie
   lastModified = m_lastModified;
   return true;
 }
+
+bool CHTTPImageTransformationHandler::GetETag(std::string &etag) const
+{
+  if (m_imageHash.empty())
+    return false;
+
+  etag = "\"" + CDigest::Calculate(CDigest::Type::MD5, m_imagePath + "|" + m_imageHash) + "\"";
+  return true;
+}
+
+bool CHTTPImageTransformationHandler::LoadTransformedImage(size_t &bufferSize)
+{
+  if (m_imageHash.empty())
+    return false;
+
+  CTextureDatabase db;
+  std::string cacheFile, hash;
+  if (!db.Open() || !db.GetTransformedImage(m_url, m_width, m_height, m_scalingAlgorithm, cacheFile, hash) ||
+      hash != m_imageHash)
+    return false;
+
+  XFILE::CFile file;
+  if (!file.Open(CTextureCache::GetCachedPath(cacheFile)))
+    return false;
+
+  const int64_t length = file.GetLength();
+  if (length <= 0)
+    return false;
+
+  m_buffer = new uint8_t[static_cast<size_t>(length)];
+  if (file.Read(m_buffer, static_cast<size_t>(length)) != length)
+  {
+    delete[] m_buffer;
+    m_buffer = NULL;
+    return false;
+  }
+
+  bufferSize = static_cast<size_t>(length);
+  return true;
+}
+
+void CHTTPImageTransformationHandler::StoreTransformedImage(size_t bufferSize) const
+{
+  // without a hash a changed source image would never be noticed
+  if (m_imageHash.empty())
+    return;
+
+  std::string ext = URIUtils::GetExtension(CURL(m_url).GetHostName());
+  StringUtils::ToLower(ext);
+  const std::string cacheFile = TransformedImagePath + CDigest::Calculate(CDigest::Type::MD5, m_imagePath) + ext;
+  const std::string cachePath = CTextureCache::GetCachedPath(cacheFile);
+
+  const std::string folder = CTextureCache::GetCachedPath(TransformedImagePath);
+  if (!XFILE::CDirectory::Exists(folder) && !XFILE::CDirectory::Create(folder))
+    return;
+
+  XFILE::CFile file;
+  if (!file.OpenForWrite(cachePath, true) ||
+      file.Write(m_buffer, bufferSize) != static_cast<ssize_t>(bufferSize))
+  {
+    CLog::Log(LOGWARNING, "CHTTPImageTransformationHandler: unable to write %s", cachePath.c_str());
+    file.Close();
+    XFILE::CFile::Delete(cachePath);
+    return;
+  }
+  file.Close();
+
+  CTextureDatabase db;
+  if (!db.Open() || !db.AddTransformedImage(m_url, m_width, m_height, m_scalingAlgorithm, cacheFile, m_imageHash))
+    XFILE::CFile::Delete(cachePath);
+}
@@ -28,6 +28,7 @@ public:
   bool CanHandleRanges() const override { return true; }
   bool CanBeCached() const override { return true; }
   bool GetLastModifiedDate(CDateTime &lastModified) const override;
+  bool GetETag(std::string &etag) const override;
 
   HttpResponseRanges GetResponseData() const override { return m_responseData; }
 
@@ -38,7 +39,15 @@ protected:
   explicit CHTTPImageTransformationHandler(const HTTPRequest &request);
 
 private:
+  bool LoadTransformedImage(size_t &bufferSize);
+  void StoreTransformedImage(size_t bufferSize) const;
+
   std::string m_url;
+  std::string m_imagePath;
+  unsigned int m_width;
+  unsigned int m_height;
+  std::string m_scalingAlgorithm;
+  std::string m_imageHash;
   CDateTime m_lastModified;
 
   uint8_t* m_buffer;
@@ -76,7 +76,10 @@ int CHTTPJsonRpcHandler::HandleRequest()
     m_responseData = JSONRPC::CJSONRPC::MethodCall(m_requestData, &m_transportLayer, &client);
 
     if (!jsonpCallback.empty())
-      m_responseData = jsonpCallback + "(" + m_responseData + ");";
+    {
+      m_responseData.insert(0, jsonpCallback + "(");
+      m_responseData.append(");");
+    }
   }
   else if (jsonpCallback.empty())
   {
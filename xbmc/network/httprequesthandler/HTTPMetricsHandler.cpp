@@ -0,0 +1,198 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "HTTPMetricsHandler.h"
+
+#include "Application.h"
+#include "GUIInfoManager.h"
+#include "ServiceBroker.h"
+#include "addons/Skin.h"
+#include "cores/DataCacheCore.h"
+#include "guilib/GUIComponent.h"
+#include "messaging/ApplicationMessenger.h"
+#include "network/WebServer.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "threads/LockStats.h"
+#include "utils/JobManager.h"
+#include "utils/Metrics.h"
+#include "utils/StringUtils.h"
+
+namespace
+{
+
+void WriteCounter(std::string& out, const char* name, const char* help, uint64_t value)
+{
+  CMetrics::WriteHeader(out, name, "counter", help);
+  CMetrics::WriteSample(out, name, "", value);
+}
+
+void WriteGauge(std::string& out, const char* name, const char* help, double value)
+{
+  CMetrics::WriteHeader(out, name, "gauge", help);
+  CMetrics::WriteSample(out, name, "", value);
+}
+
+void WritePlayer(std::string& out)
+{
+  CDataCacheCore& dataCache = CServiceBroker::GetDataCacheCore();
+
+  // the render counters start over with each playback
+  const SRenderTelemetryInfo telemetry = dataCache.GetRenderTelemetryInfo();
+  WriteCounter(out, "kodi_player_frames_rendered_total", "Video frames shown in the current playback",
+               telemetry.frames);
+  WriteCounter(out, "kodi_player_frames_skipped_total",
+               "Video frames dropped from the render queue because they were late", telemetry.skipped);
+  WriteCounter(out, "kodi_player_missed_vsyncs_total", "Vblanks missed while showing video frames",
+               telemetry.missedVsyncs);
+  WriteGauge(out, "kodi_player_decoder_latency_frames", "Frames the video decoder holds back",
+             dataCache.GetVideoDecoderLatency());
+  WriteGauge(out, "kodi_player_startup_seconds", "Time from opening the item until the first picture",
+             dataCache.GetStartupTime() / 1000.0);
+  WriteGauge(out, "kodi_player_cache_level_ratio", "Fill level of the read ahead cache of the input",
+             g_application.GetAppPlayer().IsPlaying() ? g_application.GetAppPlayer().GetCacheLevel() / 100.0 : 0.0);
+
+  const SDemuxPacketPoolInfo packets = dataCache.GetDemuxPacketPoolInfo();
+  WriteGauge(out, "kodi_demux_packet_pool_used_bytes", "Bytes of the demux packets in use",
+             static_cast<double>(packets.usedBytes));
+  WriteGauge(out, "kodi_demux_packet_pool_cached_bytes", "Bytes of the demux packets kept for reuse",
+             static_cast<double>(packets.cachedBytes));
+
+  WriteCounter(out, "kodi_audio_underruns_total", "Times the audio output ran dry",
+               dataCache.GetAudioXRuns());
+}
+
+void WriteJobs(std::string& out)
+{
+  const CJobManager::Statistics statistics = CJobManager::GetInstance().GetStatistics();
+  WriteGauge(out, "kodi_job_workers", "Worker threads of the job manager, busy or parked",
+             statistics.workers);
+
+  static const char* priorities[] = { "lowpausable", "low", "normal", "high", "dedicated" };
+  CMetrics::WriteHeader(out, "kodi_job_queue_depth", "gauge", "Jobs waiting for a worker by priority");
+  for (int priority = CJob::PRIORITY_LOW_PAUSABLE; priority <= CJob::PRIORITY_DEDICATED; priority++)
+    CMetrics::WriteSample(out, "kodi_job_queue_depth",
+                          StringUtils::Format("priority=\"%s\"", priorities[priority]),
+                          static_cast<uint64_t>(statistics.queued[priority]));
+
+  CMetrics::WriteHeader(out, "kodi_jobs_completed_total", "counter", "Jobs finished by type");
+  for (const auto& job : statistics.jobs)
+    CMetrics::WriteSample(out, "kodi_jobs_completed_total",
+                          StringUtils::Format("type=\"%s\"", CMetrics::EscapeLabel(job.first).c_str()),
+                          job.second.completed);
+
+  CMetrics::WriteHeader(out, "kodi_jobs_wait_seconds_total", "counter",
+                        "Time jobs waited for a worker by type");
+  for (const auto& job : statistics.jobs)
+    CMetrics::WriteSample(out, "kodi_jobs_wait_seconds_total",
+                          StringUtils::Format("type=\"%s\"", CMetrics::EscapeLabel(job.first).c_str()),
+                          job.second.waitTime / 1000.0);
+
+  CMetrics::WriteHeader(out, "kodi_jobs_run_seconds_total", "counter", "Time spent processing jobs by type");
+  for (const auto& job : statistics.jobs)
+    CMetrics::WriteSample(out, "kodi_jobs_run_seconds_total",
+                          StringUtils::Format("type=\"%s\"", CMetrics::EscapeLabel(job.first).c_str()),
+                          job.second.runTime / 1000.0);
+}
+
+void WriteMessenger(std::string& out)
+{
+  const KODI::MESSAGING::CApplicationMessenger::Statistics statistics =
+      KODI::MESSAGING::CApplicationMessenger::GetInstance().GetStatistics();
+  WriteGauge(out, "kodi_messenger_queue_depth", "Application messages waiting to be processed",
+             static_cast<double>(statistics.queued));
+  WriteCounter(out, "kodi_messenger_processed_total", "Application messages processed",
+               statistics.processed);
+  CMetrics::WriteHeader(out, "kodi_messenger_wait_seconds_total", "counter",
+                        "Time processed messages spent in the queues");
+  CMetrics::WriteSample(out, "kodi_messenger_wait_seconds_total", "", statistics.totalWait / 1000.0);
+}
+
+void WriteLocks(std::string& out)
+{
+  const std::vector<XbmcThreads::CLockStats::Report> report = XbmcThreads::CLockStats::GetReport();
+
+  CMetrics::WriteHeader(out, "kodi_lock_contentions_total", "counter", "Times threads waited for a lock");
+  for (const auto& lock : report)
+    CMetrics::WriteSample(out, "kodi_lock_contentions_total",
+                          StringUtils::Format("lock=\"%s\"", CMetrics::EscapeLabel(lock.name).c_str()),
+                          lock.contentions);
+
+  CMetrics::WriteHeader(out, "kodi_lock_wait_seconds_total", "counter", "Time threads waited for a lock");
+  for (const auto& lock : report)
+    CMetrics::WriteSample(out, "kodi_lock_wait_seconds_total",
+                          StringUtils::Format("lock=\"%s\"", CMetrics::EscapeLabel(lock.name).c_str()),
+                          lock.waitTime / 1000000.0);
+}
+
+void WriteLabels(std::string& out)
+{
+  CGUIComponent* gui = CServiceBroker::GetGUI();
+  const ADDON::SkinPtr skinInfo = g_SkinInfo;
+  if (!gui || !skinInfo)
+    return;
+
+  // only the most expensive ones, there are thousands of labels in a skin
+  const std::vector<CGUIInfoManager::LabelStatistics> statistics =
+      gui->GetInfoManager().GetLabelStatistics(25);
+  std::vector<std::string> labels;
+  for (const auto& label : statistics)
+    labels.push_back(StringUtils::Format("skin=\"%s\",label=\"%s\"",
+                                         CMetrics::EscapeLabel(skinInfo->ID()).c_str(),
+                                         CMetrics::EscapeLabel(label.name).c_str()));
+
+  CMetrics::WriteHeader(out, "kodi_gui_label_seconds_total", "counter",
+                        "Time spent evaluating the most expensive labels of the skin");
+  for (size_t i = 0; i < statistics.size(); i++)
+    CMetrics::WriteSample(out, "kodi_gui_label_seconds_total", labels[i], statistics[i].time / 1000000.0);
+
+  CMetrics::WriteHeader(out, "kodi_gui_label_evaluations_total", "counter",
+                        "Times the most expensive labels of the skin were evaluated");
+  for (size_t i = 0; i < statistics.size(); i++)
+    CMetrics::WriteSample(out, "kodi_gui_label_evaluations_total", labels[i], statistics[i].evaluations);
+
+  CMetrics::WriteHeader(out, "kodi_gui_label_cache_hits_total", "counter",
+                        "Times the most expensive labels of the skin were taken from the cache of the frame");
+  for (size_t i = 0; i < statistics.size(); i++)
+    CMetrics::WriteSample(out, "kodi_gui_label_cache_hits_total", labels[i], statistics[i].hits);
+}
+
+} // unnamed namespace
+
+bool CHTTPMetricsHandler::CanHandleRequest(const HTTPRequest &request) const
+{
+  return request.pathUrl.compare("/metrics") == 0 && request.method == GET &&
+         CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_webServerMetrics;
+}
+
+int CHTTPMetricsHandler::HandleRequest()
+{
+  WritePlayer(m_responseData);
+  WriteJobs(m_responseData);
+  WriteMessenger(m_responseData);
+  WriteLocks(m_responseData);
+  WriteLabels(m_responseData);
+  CMetrics::Export(m_responseData);
+
+  m_responseRange.SetData(m_responseData.c_str(), m_responseData.size());
+
+  m_response.type = HTTPMemoryDownloadNoFreeCopy;
+  m_response.status = MHD_HTTP_OK;
+  m_response.contentType = "text/plain; version=0.0.4";
+  m_response.totalLength = m_responseData.size();
+
+  return MHD_YES;
+}
+
+HttpResponseRanges CHTTPMetricsHandler::GetResponseData() const
+{
+  HttpResponseRanges ranges;
+  ranges.push_back(m_responseRange);
+
+  return ranges;
+}
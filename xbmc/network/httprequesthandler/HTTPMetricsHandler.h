@@ -0,0 +1,46 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "network/httprequesthandler/IHTTPRequestHandler.h"
+
+#include <string>
+
+/*!
+ * \brief Serves the counters of Kodi at /metrics in the Prometheus text format
+ *
+ * Only answers if enabled by <webserver><metrics> in advancedsettings.xml. Besides the
+ * metrics registered with CMetrics it samples the player, the job manager, the application
+ * messenger and the lock statistics on each request.
+ */
+class CHTTPMetricsHandler : public IHTTPRequestHandler
+{
+public:
+  CHTTPMetricsHandler() = default;
+  ~CHTTPMetricsHandler() override = default;
+
+  // implementations of IHTTPRequestHandler
+  IHTTPRequestHandler* Create(const HTTPRequest &request) const override { return new CHTTPMetricsHandler(request); }
+  bool CanHandleRequest(const HTTPRequest &request) const override;
+
+  int HandleRequest() override;
+
+  HttpResponseRanges GetResponseData() const override;
+
+  int GetPriority() const override { return 5; }
+
+protected:
+  explicit CHTTPMetricsHandler(const HTTPRequest &request)
+    : IHTTPRequestHandler(request)
+  { }
+
+private:
+  std::string m_responseData;
+  CHttpResponseRange m_responseRange;
+};
@@ -140,6 +140,13 @@ public:
   */
   virtual bool GetLastModifiedDate(CDateTime &lastModified) const { return false; }
 
+  /*!
+  * \brief Returns the entity tag (including the quotes) of the response data.
+  *
+  * \details This is only used if the response can be cached.
+  */
+  virtual bool GetETag(std::string &etag) const { return false; }
+
   /*!
    * \brief Returns the ranges with raw data belonging to the response.
    *
@@ -168,6 +168,9 @@ void DNSSD_API CZeroconfBrowserMDNS::ResolveCallback(DNSServiceRef
 /// adds the service to list of found services
 void CZeroconfBrowserMDNS::addDiscoveredService(DNSServiceRef browser, CZeroconfBrowser::ZeroconfService const& fcr_service)
 {
+  //a re-announced service may have moved
+  ForgetResolvedService(fcr_service);
+
   CSingleLock lock(m_data_guard);
   tDiscoveredServicesMap::iterator browserIt = m_discovered_services.find(browser);
   if(browserIt == m_discovered_services.end())
@@ -191,6 +194,8 @@ void CZeroconfBrowserMDNS::addDiscoveredService(DNSServiceRef browser, CZeroconf
 
 void CZeroconfBrowserMDNS::removeDiscoveredService(DNSServiceRef browser, CZeroconfBrowser::ZeroconfService const& fcr_service)
 {
+  ForgetResolvedService(fcr_service);
+
   CSingleLock lock(m_data_guard);
   tDiscoveredServicesMap::iterator browserIt = m_discovered_services.find(browser);
   //search this service
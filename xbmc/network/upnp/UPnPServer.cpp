@@ -53,6 +53,9 @@ namespace UPNP
 
 NPT_UInt32 CUPnPServer::m_MaxReturnedItems = 0;
 
+// fragments kept by the DIDL cache, about 1-2 KiB each
+#define UPNP_DIDL_CACHE_SIZE 10000
+
 const char* audio_containers[] = { "musicdb://genres/", "musicdb://artists/", "musicdb://albums/",
                                    "musicdb://songs/", "musicdb://recentlyaddedalbums/", "musicdb://years/",
                                    "musicdb://singles/" };
@@ -427,6 +430,10 @@ CUPnPServer::Announce(AnnouncementFlag flag, const char *sender, const char *mes
             m_scanning = true;
         }
         else if (!strcmp(message, "OnScanFinished") || !strcmp(message, "OnCleanFinished")) {
+            {
+                NPT_AutoLock lock(m_DidlMutex);
+                m_DidlCache.clear();
+            }
             OnScanCompleted(flag);
         }
     }
@@ -441,6 +448,8 @@ CUPnPServer::Announce(AnnouncementFlag flag, const char *sender, const char *mes
             item_type = data["type"].asString();
         }
 
+        InvalidateDidl(item_type, item_id);
+
         // we always update 'recently added' nodes along with the specific container,
         // as we don't differentiate 'updates' from 'adds' in RPC interface
         if (flag == VideoLibrary) {
@@ -643,6 +652,22 @@ CUPnPServer::OnBrowseDirectChildren(PLT_ActionReference&          action,
         return NPT_FAILURE;
     }
 
+    // flat library lists are paged by the database so only the requested
+    // items are ever loaded
+    NPT_String action_name = action->GetActionDesc().GetName();
+    if (GetLibraryPage(parent_id, starting_index, requested_count, items)) {
+        return BuildResponse(
+            action,
+            items,
+            filter,
+            starting_index,
+            requested_count,
+            sort_criteria,
+            context,
+            (action_name.Compare("Search", true)==0)?NULL:parent_id.GetChars(),
+            true);
+    }
+
     items.SetPath(std::string(parent_id));
 
     // guard against loading while saving to the same cache file
@@ -709,7 +734,6 @@ CUPnPServer::OnBrowseDirectChildren(PLT_ActionReference&          action,
     // Don't pass parent_id if action is Search not BrowseDirectChildren, as
     // we want the engine to determine the best parent id, not necessarily the one
     // passed
-    NPT_String action_name = action->GetActionDesc().GetName();
     return BuildResponse(
         action,
         items,
@@ -721,8 +745,89 @@ CUPnPServer::OnBrowseDirectChildren(PLT_ActionReference&          action,
         (action_name.Compare("Search", true)==0)?NULL:parent_id.GetChars());
 }
 
+/*----------------------------------------------------------------------
+|   CUPnPServer::GetLibraryPage
+|
+|   return true if the items of a library list from starting_index on were
+|   fetched, the total number of items in the list is set as the "total"
+|   property
++---------------------------------------------------------------------*/
+bool
+CUPnPServer::GetLibraryPage(const NPT_String& id,
+                            NPT_UInt32        starting_index,
+                            NPT_UInt32        requested_count,
+                            CFileItemList&    items)
+{
+    std::string path;
+    if (id == "musicdb://songs/" || id == "musicdb://albums/")
+        path = id.GetChars();
+    else if (id == "videodb://movies/titles/" || id == "library://video/movies/titles.xml/")
+        path = "videodb://movies/titles/";
+    else
+        return false;
+
+    // same order as the full listing
+    items.SetPath(path);
+    SortDescription sorting;
+    CGUIViewState* viewState = CGUIViewState::GetViewState(items.IsVideoDb() ? WINDOW_VIDEO_NAV : -1, items);
+    if (viewState) {
+        sorting = viewState->GetSortMethod();
+        delete viewState;
+    }
+
+    NPT_UInt32 max_count = (requested_count == 0)?m_MaxReturnedItems:std::min((unsigned long)requested_count, (unsigned long)m_MaxReturnedItems);
+    sorting.limitStart = starting_index;
+    sorting.limitEnd = starting_index + max_count;
+
+    bool result = false;
+    if (URIUtils::IsMusicDb(path)) {
+        CMusicDatabase db;
+        if (!db.Open())
+            return false;
+        if (path == "musicdb://songs/")
+            result = db.GetSongsByWhere(path, CDatabase::Filter(), items, sorting);
+        else
+            result = db.GetAlbumsByWhere(path, CDatabase::Filter(), items, sorting);
+    }
+    else {
+        CVideoDatabase db;
+        if (!db.Open())
+            return false;
+        result = db.GetMoviesByWhere(path, CDatabase::Filter(), items, sorting);
+    }
+
+    if (!result) {
+        items.Clear();
+        return false;
+    }
+
+    items.SetPath(path);
+    if (!items.HasProperty("total"))
+        items.SetProperty("total", (int)starting_index + items.Size());
+    return true;
+}
+
+/*----------------------------------------------------------------------
+|   CUPnPServer::InvalidateDidl
++---------------------------------------------------------------------*/
+void
+CUPnPServer::InvalidateDidl(const std::string& type, int id)
+{
+    NPT_AutoLock lock(m_DidlMutex);
+
+    // containers may show the changed item in their counts or artwork
+    for (auto it = m_DidlCache.begin(); it != m_DidlCache.end();) {
+        if (it->second.container || (it->second.id == id && it->second.type == type))
+            it = m_DidlCache.erase(it);
+        else
+            ++it;
+    }
+}
+
 /*----------------------------------------------------------------------
 |   CUPnPServer::BuildResponse
+|
+|   items is the page from starting_index on if paged
 +---------------------------------------------------------------------*/
 NPT_Result
 CUPnPServer::BuildResponse(PLT_ActionReference&          action,
@@ -732,7 +837,8 @@ CUPnPServer::BuildResponse(PLT_ActionReference&          action,
                            NPT_UInt32                    requested_count,
                            const char*                   sort_criteria,
                            const PLT_HttpRequestContext& context,
-                           const char*                   parent_id /* = NULL */)
+                           const char*                   parent_id /* = NULL */,
+                           bool                          paged /* = false */)
 {
     NPT_COMPILER_UNUSED(sort_criteria);
 
@@ -771,22 +877,59 @@ CUPnPServer::BuildResponse(PLT_ActionReference&          action,
     // won't return more than UPNP_MAX_RETURNED_ITEMS items at a time to keep things smooth
     // 0 requested means as many as possible
     NPT_UInt32 max_count  = (requested_count == 0)?m_MaxReturnedItems:std::min((unsigned long)requested_count, (unsigned long)m_MaxReturnedItems);
-    NPT_UInt32 stop_index = std::min((unsigned long)(starting_index + max_count), (unsigned long)items.Size()); // don't return more than we can
+    NPT_UInt32 first_index = paged ? 0 : starting_index;
+    NPT_UInt32 stop_index = std::min((unsigned long)(first_index + max_count), (unsigned long)items.Size()); // don't return more than we can
 
     NPT_Cardinal count = 0;
-    NPT_Cardinal total = items.Size();
+    NPT_Cardinal total = paged ? (NPT_Cardinal)items.GetProperty("total").asInteger() : items.Size();
     NPT_String didl = didl_header;
     PLT_MediaObjectReference object;
-    for (unsigned long i=starting_index; i<stop_index; ++i) {
-        object = Build(items[i], true, context, thumb_loader, parent_id);
-        if (object.IsNull()) {
-            // don't tell the client this item ever existed
-            --total;
-            continue;
-        }
 
+    // the DIDL of an item depends on the address it's requested on and on the client
+    std::string key_suffix = StringUtils::Format("|%s|%s|%s|%d",
+                                                 parent_id ? parent_id : "",
+                                                 filter ? filter : "",
+                                                 context.GetLocalAddress().ToString().GetChars(),
+                                                 (int)GetClientQuirks(&context));
+
+    for (unsigned long i=first_index; i<stop_index; ++i) {
+        std::string key = items[i]->GetPath() + key_suffix;
         NPT_String tmp;
-        NPT_CHECK(PLT_Didl::ToDidl(*object.AsPointer(), filter, tmp));
+        {
+            NPT_AutoLock lock(m_DidlMutex);
+            auto it = m_DidlCache.find(key);
+            if (it != m_DidlCache.end())
+                tmp = it->second.didl;
+        }
+
+        if (tmp.IsEmpty()) {
+            object = Build(items[i], true, context, thumb_loader, parent_id);
+            if (object.IsNull()) {
+                // don't tell the client this item ever existed
+                --total;
+                continue;
+            }
+
+            NPT_CHECK(PLT_Didl::ToDidl(*object.AsPointer(), filter, tmp));
+
+            CachedDidl cached;
+            cached.didl = tmp;
+            cached.id = -1;
+            cached.container = items[i]->m_bIsFolder;
+            if (items[i]->HasVideoInfoTag()) {
+                cached.id = items[i]->GetVideoInfoTag()->m_iDbId;
+                cached.type = items[i]->GetVideoInfoTag()->m_type;
+            }
+            else if (items[i]->HasMusicInfoTag()) {
+                cached.id = items[i]->GetMusicInfoTag()->GetDatabaseId();
+                cached.type = items[i]->GetMusicInfoTag()->GetType();
+            }
+
+            NPT_AutoLock lock(m_DidlMutex);
+            if (m_DidlCache.size() >= UPNP_DIDL_CACHE_SIZE)
+                m_DidlCache.clear();
+            m_DidlCache[key] = cached;
+        }
 
         // Neptunes string growing is dead slow for small additions
         if (didl.GetCapacity() < tmp.GetLength() + didl.GetLength()) {
@@ -112,7 +112,13 @@ private:
                              NPT_UInt32                    requested_count,
                              const char*                   sort_criteria,
                              const PLT_HttpRequestContext& context,
-                             const char*                   parent_id /* = NULL */);
+                             const char*                   parent_id /* = NULL */,
+                             bool                          paged = false);
+    bool GetLibraryPage(const NPT_String& id,
+                        NPT_UInt32        starting_index,
+                        NPT_UInt32        requested_count,
+                        CFileItemList&    items);
+    void InvalidateDidl(const std::string& type, int id);
 
     // class methods
     static bool SortItems(CFileItemList& items, const char* sort_criteria);
@@ -130,6 +136,17 @@ private:
     NPT_Map<NPT_String, NPT_String> m_FileMap;
 
     std::map<std::string, std::pair<bool, unsigned long> > m_UpdateIDs;
+
+    // DIDL of items already sent, dropped when the library announces changes
+    struct CachedDidl {
+        NPT_String  didl;
+        std::string type;
+        int         id;
+        bool        container;
+    };
+    NPT_Mutex m_DidlMutex;
+    std::map<std::string, CachedDidl> m_DidlCache;
+
     bool m_scanning;
 public:
     // class members
@@ -11,6 +11,7 @@
 #include "IEventScannerCallback.h"
 #include "threads/SingleLock.h"
 #include "threads/SystemClock.h"
+#include "utils/TimeUtils.h"
 #include "utils/log.h"
 
 #include <algorithm>
@@ -21,9 +22,10 @@ using namespace XbmcThreads;
 // Default event scan rate when no polling handles are held
 #define DEFAULT_SCAN_RATE_HZ  60
 
-// Timeout when a polling handle is held but doesn't trigger scan. This reduces
-// input latency when the game is running at < 1/4 speed.
-#define WATCHDOG_TIMEOUT_MS   80
+// Event scan rate while a polling handle is active. Input is sampled
+// independently of the frame timing of the handle's owner, which finds
+// fresh events when it polls instead of waiting for a scan.
+#define ACTIVE_SCAN_RATE_HZ   1000
 
 CEventScanner::CEventScanner(IEventScannerCallback &callback) :
   CThread("PeripEventScanner"),
@@ -81,6 +83,12 @@ void CEventScanner::HandleEvents(bool bWait)
 {
   if (bWait)
   {
+    // Events are recent enough if a scan finished within the active scan
+    // interval
+    const int64_t maxAge = CurrentHostFrequency() / ACTIVE_SCAN_RATE_HZ;
+    if (CurrentHostCounter() - m_lastScanTicks < maxAge)
+      return;
+
     CSingleLock lock(m_pollMutex);
 
     m_scanFinishedEvent.Reset();
@@ -139,6 +147,7 @@ void CEventScanner::Process()
         m_callback.ProcessEvents();
     }
 
+    m_lastScanTicks = CurrentHostCounter();
     m_scanFinishedEvent.Set();
 
     const double nowMs = static_cast<double>(SystemClockMillis());
@@ -170,5 +179,5 @@ double CEventScanner::GetScanIntervalMs() const
   if (!bHasActiveHandle)
     return 1000.0 / DEFAULT_SCAN_RATE_HZ;
   else
-    return WATCHDOG_TIMEOUT_MS;
+    return 1000.0 / ACTIVE_SCAN_RATE_HZ;
 }
@@ -15,7 +15,9 @@
 #include "threads/Event.h"
 #include "threads/Thread.h"
 
+#include <atomic>
 #include <set>
+#include <stdint.h>
 
 namespace PERIPHERALS
 {
@@ -24,8 +26,9 @@ namespace PERIPHERALS
   /*!
    * \brief Class to scan for peripheral events
    *
-   * By default, a rate of 60 Hz is used. A client can obtain control over when
-   * input is handled by registering for a polling handle.
+   * By default, a rate of 60 Hz is used. While a polling handle is active,
+   * events are scanned at 1 kHz and the handle's owner can wait for fresh
+   * events before consuming input.
    */
   class CEventScanner : public IEventPollCallback,
                         public IEventLockCallback,
@@ -70,6 +73,7 @@ namespace PERIPHERALS
     std::set<void*> m_activeLocks;
     CEvent m_scanEvent;
     CEvent m_scanFinishedEvent;
+    std::atomic<int64_t> m_lastScanTicks{0}; // Host counter at the end of the last scan
     mutable CCriticalSection m_handleMutex;
     CCriticalSection m_lockMutex;
     CCriticalSection m_pollMutex; // Prevent two poll handles from polling at once
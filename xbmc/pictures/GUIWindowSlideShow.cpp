@@ -14,11 +14,13 @@
 #include "utils/URIUtils.h"
 #include "URL.h"
 #include "guilib/GUIComponent.h"
+#include "guilib/GUITextureBudget.h"
 #include "guilib/TextureManager.h"
 #include "guilib/GUILabelControl.h"
 #include "input/Key.h"
 #include "GUIInfoManager.h"
 #include "filesystem/Directory.h"
+#include "filesystem/File.h"
 #include "GUIDialogPictureInfo.h"
 #include "GUIUserMessages.h"
 #include "guilib/GUIWindowManager.h"
@@ -37,9 +39,12 @@
 #include "pictures/GUIViewStatePictures.h"
 #include "pictures/PictureThumbLoader.h"
 #include "PlayListPlayer.h"
+#include "threads/SingleLock.h"
+#include "utils/JobManager.h"
 #ifdef TARGET_POSIX
 #include "platform/posix/XTimeUtils.h"
 #endif
+#include <map>
 #include <random>
 
 using namespace XFILE;
@@ -47,6 +52,8 @@ using namespace KODI::MESSAGING;
 
 #define MAX_ZOOM_FACTOR                     10
 #define MAX_PICTURE_SIZE             2048*2048
+// jpegs from this size on are shown at a reduced resolution first
+#define PREVIEW_MIN_FILESIZE       2*1024*1024
 
 #define IMMEDIATE_TRANSITION_TIME          1
 
@@ -63,12 +70,44 @@ using namespace KODI::MESSAGING;
 
 static float zoomamount[10] = { 1.0f, 1.2f, 1.5f, 2.0f, 2.8f, 4.0f, 6.0f, 9.0f, 13.5f, 20.0f };
 
+struct CBackgroundPicLoader::SPrefetchState
+{
+  CCriticalSection section;
+  std::map<std::string, std::unique_ptr<CBaseTexture>> textures;
+  std::set<std::string> pending;
+  std::set<std::string> wanted;
+  int maxWidth = 0;
+  int maxHeight = 0;
+  bool stopped = false;
+  CEvent done;
+};
+
+namespace
+{
+uint64_t GetTextureMemory(const CBaseTexture *texture)
+{
+  return static_cast<uint64_t>(texture->GetPitch()) * texture->GetRows();
+}
+
+void UpdateBudget(const CBaseTexture *texture, bool add)
+{
+  CGUIComponent *gui = CServiceBroker::GetGUI();
+  if (!gui)
+    return;
+  if (add)
+    gui->GetTextureBudget().Add(CGUITextureBudget::POOL_SLIDESHOW, GetTextureMemory(texture));
+  else
+    gui->GetTextureBudget().Remove(CGUITextureBudget::POOL_SLIDESHOW, GetTextureMemory(texture));
+}
+}
+
 CBackgroundPicLoader::CBackgroundPicLoader()
   : CThread("BgPicLoader")
   , m_iPic{0}
   , m_iSlideNumber{0}
   , m_maxWidth{0}
   , m_maxHeight{0}
+  , m_prefetch{std::make_shared<SPrefetchState>()}
   , m_isLoading{false}
   , m_pCallback{nullptr}
 {
@@ -77,6 +116,14 @@ CBackgroundPicLoader::CBackgroundPicLoader()
 CBackgroundPicLoader::~CBackgroundPicLoader()
 {
   StopThread();
+
+  // running decodes drop their textures once they see this
+  CSingleLock lock(m_prefetch->section);
+  m_prefetch->stopped = true;
+  for (const auto &texture : m_prefetch->textures)
+    UpdateBudget(texture.second.get(), false);
+  m_prefetch->textures.clear();
+  m_prefetch->wanted.clear();
 }
 
 void CBackgroundPicLoader::Create(CGUIWindowSlideShow *pCallback)
@@ -97,25 +144,35 @@ void CBackgroundPicLoader::Process()
       if (m_pCallback)
       {
         unsigned int start = XbmcThreads::SystemClockMillis();
-        CBaseTexture* texture = CTexture::LoadFromFile(m_strFileName, m_maxWidth, m_maxHeight);
-        totalTime += XbmcThreads::SystemClockMillis() - start;
-        count++;
-        // tell our parent
-        bool bFullSize = false;
-        if (texture)
+        CBaseTexture* texture = TakePrefetched(m_strFileName);
+        if (!texture && m_previewWidth > 0 && m_previewHeight > 0 &&
+            URIUtils::HasExtension(m_strFileName, ".jpg|.jpeg"))
         {
-          bFullSize = ((int)texture->GetWidth() < m_maxWidth) && ((int)texture->GetHeight() < m_maxHeight);
-          if (!bFullSize)
+          // read the file once, the reduced decode of a large jpeg takes a fraction of the full one
+          XFILE::auto_buffer buf;
+          if (XFILE::CFile().LoadFile(m_strFileName, buf) > 0)
           {
-            int iSize = texture->GetWidth() * texture->GetHeight() - MAX_PICTURE_SIZE;
-            if ((iSize + (int)texture->GetWidth() > 0) || (iSize + (int)texture->GetHeight() > 0))
-              bFullSize = true;
-            if (!bFullSize && texture->GetWidth() == CServiceBroker::GetRenderSystem()->GetMaxTextureSize())
-              bFullSize = true;
-            if (!bFullSize && texture->GetHeight() == CServiceBroker::GetRenderSystem()->GetMaxTextureSize())
-              bFullSize = true;
+            unsigned char *data = reinterpret_cast<unsigned char*>(buf.get());
+            if (buf.size() >= PREVIEW_MIN_FILESIZE)
+            {
+              CBaseTexture* preview = CBaseTexture::LoadFromFileInMemory(data, buf.size(), "image/jpeg", m_previewWidth, m_previewHeight);
+              if (preview)
+              {
+                CLog::Log(LOGDEBUG, "Showing a %ux%u preview of %s after %u ms", preview->GetWidth(), preview->GetHeight(),
+                          CURL::GetRedacted(m_strFileName).c_str(), XbmcThreads::SystemClockMillis() - start);
+                m_pCallback->OnLoadPic(m_iPic, m_iSlideNumber, m_strFileName, preview, false, true);
+              }
+            }
+            if (!m_bStop)
+              texture = CBaseTexture::LoadFromFileInMemory(data, buf.size(), "image/jpeg", m_maxWidth, m_maxHeight);
           }
         }
+        if (!texture)
+          texture = CTexture::LoadFromFile(m_strFileName, m_maxWidth, m_maxHeight);
+        totalTime += XbmcThreads::SystemClockMillis() - start;
+        count++;
+        // tell our parent
+        bool bFullSize = texture && IsFullSize(texture);
         m_pCallback->OnLoadPic(m_iPic, m_iSlideNumber, m_strFileName, texture, bFullSize);
         m_isLoading = false;
       }
@@ -126,17 +183,128 @@ void CBackgroundPicLoader::Process()
               count, totalTime, totalTime / count);
 }
 
-void CBackgroundPicLoader::LoadPic(int iPic, int iSlideNumber, const std::string &strFileName, const int maxWidth, const int maxHeight)
+bool CBackgroundPicLoader::IsFullSize(const CBaseTexture *texture) const
+{
+  bool bFullSize = ((int)texture->GetWidth() < m_maxWidth) && ((int)texture->GetHeight() < m_maxHeight);
+  if (!bFullSize)
+  {
+    int iSize = texture->GetWidth() * texture->GetHeight() - MAX_PICTURE_SIZE;
+    if ((iSize + (int)texture->GetWidth() > 0) || (iSize + (int)texture->GetHeight() > 0))
+      bFullSize = true;
+    if (!bFullSize && texture->GetWidth() == CServiceBroker::GetRenderSystem()->GetMaxTextureSize())
+      bFullSize = true;
+    if (!bFullSize && texture->GetHeight() == CServiceBroker::GetRenderSystem()->GetMaxTextureSize())
+      bFullSize = true;
+  }
+  return bFullSize;
+}
+
+void CBackgroundPicLoader::LoadPic(int iPic, int iSlideNumber, const std::string &strFileName, const int maxWidth, const int maxHeight,
+                                   const int previewWidth /* = 0 */, const int previewHeight /* = 0 */)
 {
   m_iPic = iPic;
   m_iSlideNumber = iSlideNumber;
   m_strFileName = strFileName;
   m_maxWidth = maxWidth;
   m_maxHeight = maxHeight;
+  m_previewWidth = previewWidth;
+  m_previewHeight = previewHeight;
   m_isLoading = true;
   m_loadPic.Set();
 }
 
+void CBackgroundPicLoader::Prefetch(const std::vector<std::string> &files, const int maxWidth, const int maxHeight)
+{
+  std::vector<std::string> start;
+  {
+    CSingleLock lock(m_prefetch->section);
+    // textures decoded for another size are of no use anymore
+    const bool resized = m_prefetch->maxWidth != maxWidth || m_prefetch->maxHeight != maxHeight;
+    m_prefetch->maxWidth = maxWidth;
+    m_prefetch->maxHeight = maxHeight;
+
+    std::set<std::string> wanted(files.begin(), files.end());
+    for (auto it = m_prefetch->textures.begin(); it != m_prefetch->textures.end();)
+    {
+      if (resized || !wanted.count(it->first))
+      {
+        UpdateBudget(it->second.get(), false);
+        it = m_prefetch->textures.erase(it);
+      }
+      else
+        ++it;
+    }
+    m_prefetch->wanted = wanted;
+
+    // don't push out what's on screen for pictures that may never be shown
+    CGUIComponent *gui = CServiceBroker::GetGUI();
+    if (gui && gui->GetTextureBudget().IsExceeded())
+      return;
+
+    for (const std::string &file : files)
+    {
+      if (!m_prefetch->textures.count(file) && m_prefetch->pending.insert(file).second)
+        start.push_back(file);
+    }
+  }
+
+  std::shared_ptr<SPrefetchState> state = m_prefetch;
+  for (const std::string &file : start)
+    CJobManager::GetInstance().Submit([state, file]() { PrefetchPic(state, file); }, CJob::PRIORITY_LOW);
+}
+
+void CBackgroundPicLoader::PrefetchPic(std::shared_ptr<SPrefetchState> state, const std::string &file)
+{
+  int maxWidth, maxHeight;
+  {
+    CSingleLock lock(state->section);
+    maxWidth = state->maxWidth;
+    maxHeight = state->maxHeight;
+    if (state->stopped || !state->wanted.count(file))
+    {
+      state->pending.erase(file);
+      state->done.Set();
+      return;
+    }
+  }
+
+  std::unique_ptr<CBaseTexture> texture(CTexture::LoadFromFile(file, maxWidth, maxHeight));
+
+  {
+    CSingleLock lock(state->section);
+    state->pending.erase(file);
+    if (texture && !state->stopped && state->wanted.count(file) &&
+        maxWidth == state->maxWidth && maxHeight == state->maxHeight)
+    {
+      UpdateBudget(texture.get(), true);
+      state->textures[file] = std::move(texture);
+    }
+  }
+  state->done.Set();
+}
+
+CBaseTexture *CBackgroundPicLoader::TakePrefetched(const std::string &file)
+{
+  CSingleLock lock(m_prefetch->section);
+  // a decode that is already running is quicker than starting over
+  while (m_prefetch->pending.count(file) && !m_bStop)
+  {
+    lock.Leave();
+    m_prefetch->done.WaitMSec(100);
+    lock.Enter();
+  }
+
+  auto it = m_prefetch->textures.find(file);
+  if (it == m_prefetch->textures.end() ||
+      m_prefetch->maxWidth != m_maxWidth || m_prefetch->maxHeight != m_maxHeight)
+    return nullptr;
+
+  CBaseTexture *texture = it->second.release();
+  m_prefetch->textures.erase(it);
+  UpdateBudget(texture, false);
+  return texture;
+}
+
 CGUIWindowSlideShow::CGUIWindowSlideShow(void)
     : CGUIDialog(WINDOW_SLIDESHOW, "SlideShow.xml")
 {
@@ -223,6 +391,9 @@ void CGUIWindowSlideShow::Reset()
   m_iCurrentPic = 0;
   m_iDirection = 1;
   m_iLastFailedNextSlide = -1;
+  m_iPreviewPic = -1;
+  m_iPrefetchSlide = -1;
+  m_iPrefetchNextSlide = -1;
   m_slides.clear();
   AnnouncePlaylistClear();
   m_Resolution = CServiceBroker::GetWinSystem()->GetGfxContext().GetVideoResolution();
@@ -462,6 +633,8 @@ void CGUIWindowSlideShow::Process(unsigned int currentTime, CDirtyRegionList &re
     return;
   }
 
+  UpdatePrefetch();
+
   if (!m_Image[m_iCurrentPic].IsLoaded() && !m_pBackgroundLoader->IsLoading())
   { // load first image
     CFileItemPtr item = m_slides.at(m_iCurrentSlide);
@@ -479,7 +652,9 @@ void CGUIWindowSlideShow::Process(unsigned int currentTime, CDirtyRegionList &re
       GetCheckedSize((float)res.iWidth * m_fZoom,
         (float)res.iHeight * m_fZoom,
         maxWidth, maxHeight);
-      m_pBackgroundLoader->LoadPic(m_iCurrentPic, m_iCurrentSlide, picturePath, maxWidth, maxHeight);
+      // nothing is on screen yet, show large pictures at a reduced resolution until they are decoded
+      m_pBackgroundLoader->LoadPic(m_iCurrentPic, m_iCurrentSlide, picturePath, maxWidth, maxHeight,
+                                   res.iWidth / 2, res.iHeight / 2);
       m_iLastFailedNextSlide = -1;
       m_bLoadNextPic = false;
     }
@@ -677,18 +852,50 @@ void CGUIWindowSlideShow::RenderEx()
 }
 
 int CGUIWindowSlideShow::GetNextSlide()
+{
+  return GetNextSlide(m_iCurrentSlide);
+}
+
+int CGUIWindowSlideShow::GetNextSlide(int iSlide) const
 {
   if (m_slides.size() <= 1)
-    return m_iCurrentSlide;
+    return iSlide;
   int step = m_iDirection >= 0 ? 1 : -1;
-  int nextSlide = (m_iCurrentSlide + step + m_slides.size()) % m_slides.size();
-  while (nextSlide != m_iCurrentSlide)
+  int nextSlide = (iSlide + step + m_slides.size()) % m_slides.size();
+  while (nextSlide != iSlide)
   {
     if (!m_slides.at(nextSlide)->HasProperty("unplayable"))
       return nextSlide;
     nextSlide = (nextSlide + step + m_slides.size()) % m_slides.size();
   }
-  return m_iCurrentSlide;
+  return iSlide;
+}
+
+void CGUIWindowSlideShow::UpdatePrefetch()
+{
+  if (m_iPrefetchSlide == m_iCurrentSlide && m_iPrefetchNextSlide == m_iNextSlide)
+    return;
+  m_iPrefetchSlide = m_iCurrentSlide;
+  m_iPrefetchNextSlide = m_iNextSlide;
+
+  // the next two slides, the background loader takes them from the pool once it gets to them
+  std::vector<std::string> files;
+  int slide = m_iNextSlide;
+  for (int i = 0; i < 2 && slide != m_iCurrentSlide; i++)
+  {
+    CFileItem *item = m_slides.at(slide).get();
+    const bool loaded = m_Image[1 - m_iCurrentPic].IsLoaded() && m_Image[1 - m_iCurrentPic].SlideNumber() == slide;
+    if (!item->IsVideo() && !loaded)
+      files.push_back(GetPicturePath(item));
+    slide = GetNextSlide(slide);
+  }
+
+  const RESOLUTION_INFO res = CServiceBroker::GetWinSystem()->GetGfxContext().GetResInfo();
+  int maxWidth, maxHeight;
+  GetCheckedSize((float)res.iWidth * m_fZoom,
+                 (float)res.iHeight * m_fZoom,
+                 maxWidth, maxHeight);
+  m_pBackgroundLoader->Prefetch(files, maxWidth, maxHeight);
 }
 
 EVENT_RESULT CGUIWindowSlideShow::OnMouseEvent(const CPoint &point, const CMouseEvent &event)
@@ -1135,8 +1342,12 @@ CSlideShowPic::DISPLAY_EFFECT CGUIWindowSlideShow::GetDisplayEffect(int iSlideNu
     return CSlideShowPic::EFFECT_NO_TIMEOUT;
 }
 
-void CGUIWindowSlideShow::OnLoadPic(int iPic, int iSlideNumber, const std::string &strFileName, CBaseTexture* pTexture, bool bFullSize)
+void CGUIWindowSlideShow::OnLoadPic(int iPic, int iSlideNumber, const std::string &strFileName, CBaseTexture* pTexture, bool bFullSize, bool bPreview /* = false */)
 {
+  const bool replacesPreview = !bPreview && m_iPreviewPic == iPic;
+  if (replacesPreview)
+    m_iPreviewPic = -1;
+
   if (pTexture)
   {
     // set the pic's texture + size etc.
@@ -1145,9 +1356,19 @@ void CGUIWindowSlideShow::OnLoadPic(int iPic, int iSlideNumber, const std::strin
       delete pTexture;
       return;
     }
+    if (replacesPreview && m_Image[iPic].IsLoaded() && m_Image[iPic].SlideNumber() == iSlideNumber)
+    { // swap in the full picture, the effect that is running carries on
+      CLog::Log(LOGDEBUG, "Finished background loading slot %d, %d, replacing the preview: %s", iPic, iSlideNumber, m_slides.at(iSlideNumber)->GetPath().c_str());
+      m_Image[iPic].UpdateTexture(pTexture);
+      m_Image[iPic].SetOriginalSize(pTexture->GetOriginalWidth(), pTexture->GetOriginalHeight(), bFullSize);
+      MarkDirtyRegion();
+      return;
+    }
     CLog::Log(LOGDEBUG, "Finished background loading slot %d, %d: %s", iPic, iSlideNumber, m_slides.at(iSlideNumber)->GetPath().c_str());
     m_Image[iPic].SetTexture(iSlideNumber, pTexture, GetDisplayEffect(iSlideNumber));
     m_Image[iPic].SetOriginalSize(pTexture->GetOriginalWidth(), pTexture->GetOriginalHeight(), bFullSize);
+    if (bPreview)
+      m_iPreviewPic = iPic;
 
     m_Image[iPic].m_bIsComic = false;
     if (URIUtils::IsInRAR(m_slides.at(m_iCurrentSlide)->GetPath()) || URIUtils::IsInZIP(m_slides.at(m_iCurrentSlide)->GetPath())) // move to top for cbr/cbz
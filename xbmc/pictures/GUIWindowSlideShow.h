@@ -16,6 +16,8 @@
 
 #include <memory>
 #include <set>
+#include <string>
+#include <vector>
 
 class CFileItemList;
 class CVariant;
@@ -29,18 +31,41 @@ public:
   ~CBackgroundPicLoader() override;
 
   void Create(CGUIWindowSlideShow *pCallback);
-  void LoadPic(int iPic, int iSlideNumber, const std::string &strFileName, const int maxWidth, const int maxHeight);
+
+  /*!
+   \brief Load a picture in the background
+   \param previewWidth, previewHeight size of a low resolution version of large jpegs that is handed
+   over first, while the full picture is still decoding. 0 to only hand over the full picture.
+   */
+  void LoadPic(int iPic, int iSlideNumber, const std::string &strFileName, const int maxWidth, const int maxHeight,
+               const int previewWidth = 0, const int previewHeight = 0);
   bool IsLoading() { return m_isLoading;};
   int SlideNumber() const { return m_iSlideNumber; }
   int Pic() const { return m_iPic; }
 
+  /*!
+   \brief Decode the pictures that are shown after the next one in a background pool
+   LoadPic takes the decoded textures, the ones no longer in the list are dropped.
+   \param files the pictures to decode
+   */
+  void Prefetch(const std::vector<std::string> &files, const int maxWidth, const int maxHeight);
+
 private:
+  struct SPrefetchState;
+
   void Process() override;
+  CBaseTexture *TakePrefetched(const std::string &file);
+  bool IsFullSize(const CBaseTexture *texture) const;
+  static void PrefetchPic(std::shared_ptr<SPrefetchState> state, const std::string &file);
+
   int m_iPic;
   int m_iSlideNumber;
   std::string m_strFileName;
   int m_maxWidth;
   int m_maxHeight;
+  int m_previewWidth = 0;
+  int m_previewHeight = 0;
+  std::shared_ptr<SPrefetchState> m_prefetch;
 
   CEvent m_loadPic;
   bool m_isLoading;
@@ -82,7 +107,7 @@ public:
                    const std::string &strExtensions="");
   void StartSlideShow();
   bool InSlideShow() const;
-  void OnLoadPic(int iPic, int iSlideNumber, const std::string &strFileName, CBaseTexture* pTexture, bool bFullSize);
+  void OnLoadPic(int iPic, int iSlideNumber, const std::string &strFileName, CBaseTexture* pTexture, bool bFullSize, bool bPreview = false);
   int NumSlides() const;
   int CurrentSlide() const;
   void Shuffle();
@@ -113,6 +138,8 @@ private:
   void GetCheckedSize(float width, float height, int &maxWidth, int &maxHeight);
   std::string GetPicturePath(CFileItem *item);
   int  GetNextSlide();
+  int  GetNextSlide(int iSlide) const;
+  void UpdatePrefetch();
 
   void AnnouncePlayerPlay(const CFileItemPtr& item);
   void AnnouncePlayerPause(const CFileItemPtr& item);
@@ -145,6 +172,9 @@ private:
   // background loader
   std::unique_ptr<CBackgroundPicLoader> m_pBackgroundLoader;
   int m_iLastFailedNextSlide;
+  int m_iPreviewPic = -1; ///< slot showing a low resolution version until the full picture is loaded
+  int m_iPrefetchSlide = -1;
+  int m_iPrefetchNextSlide = -1;
   bool m_bLoadNextPic;
   RESOLUTION m_Resolution;
   CPoint m_firstGesturePoint;
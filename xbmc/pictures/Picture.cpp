@@ -7,6 +7,9 @@
  */
 
 #include <algorithm>
+#include <list>
+#include <tuple>
+#include <vector>
 
 #include "Picture.h"
 #include "URL.h"
@@ -18,8 +21,13 @@
 #include "filesystem/File.h"
 #include "utils/log.h"
 #include "utils/URIUtils.h"
+#include "guilib/DDSImage.h"
+#include "guilib/PixelKernels.h"
 #include "guilib/Texture.h"
 #include "guilib/imagefactory.h"
+#include "rendering/RenderSystem.h"
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
 #if defined(TARGET_RASPBERRY_PI)
 #include "cores/omxplayer/OMXImage.h"
 #endif
@@ -30,6 +38,69 @@ extern "C" {
 
 using namespace XFILE;
 
+namespace
+{
+// the thumbnails of a library mostly come from images of a few sizes, the contexts are reused
+class CScaleContextPool
+{
+public:
+  typedef std::tuple<unsigned int, unsigned int, unsigned int, unsigned int, int> Key;
+
+  ~CScaleContextPool()
+  {
+    for (auto& context : m_contexts)
+      sws_freeContext(context.second);
+  }
+
+  SwsContext* Acquire(const Key& key)
+  {
+    {
+      CSingleLock lock(m_section);
+      for (auto it = m_contexts.begin(); it != m_contexts.end(); ++it)
+      {
+        if (it->first == key)
+        {
+          SwsContext* context = it->second;
+          m_contexts.erase(it);
+          return context;
+        }
+      }
+    }
+    return sws_getContext(std::get<0>(key), std::get<1>(key), AV_PIX_FMT_BGRA,
+                          std::get<2>(key), std::get<3>(key), AV_PIX_FMT_BGRA,
+                          std::get<4>(key), nullptr, nullptr, nullptr);
+  }
+
+  void Release(const Key& key, SwsContext* context)
+  {
+    SwsContext* expired = nullptr;
+    {
+      CSingleLock lock(m_section);
+      m_contexts.emplace_front(key, context);
+      if (m_contexts.size() > MAX_CONTEXTS)
+      {
+        expired = m_contexts.back().second;
+        m_contexts.pop_back();
+      }
+    }
+    if (expired)
+      sws_freeContext(expired);
+  }
+
+private:
+  static const size_t MAX_CONTEXTS = 8;
+
+  CCriticalSection m_section;
+  std::list<std::pair<Key, SwsContext*>> m_contexts; ///< idle contexts, most recently used first
+};
+
+CScaleContextPool& GetScaleContextPool()
+{
+  static CScaleContextPool pool;
+  return pool;
+}
+}
+
 bool CPicture::GetThumbnailFromSurface(const unsigned char* buffer, int width, int height, int stride, const std::string &thumbFile, uint8_t* &result, size_t& result_size)
 {
   unsigned char *thumb = NULL;
@@ -58,6 +129,25 @@ bool CPicture::GetThumbnailFromSurface(const unsigned char* buffer, int width, i
 bool CPicture::CreateThumbnailFromSurface(const unsigned char *buffer, int width, int height, int stride, const std::string &thumbFile)
 {
   CLog::Log(LOGDEBUG, "cached image '%s' size %dx%d", CURL::GetRedacted(thumbFile).c_str(), width, height);
+  if (URIUtils::HasExtension(thumbFile, ".dds"))
+  {
+    bool hasAlpha = false;
+    for (int y = 0; y < height && !hasAlpha; y++)
+    {
+      const unsigned char* alpha = buffer + y * stride + 3;
+      for (int x = 0; x < width && !hasAlpha; x++)
+        hasAlpha = alpha[x * 4] != 0xff;
+    }
+
+    CDDSImage image;
+    const unsigned int format = GetCompressedFormat(hasAlpha);
+    if (format != XB_FMT_UNKNOWN && image.Compress(width, height, stride, buffer, format) &&
+        image.WriteFile(thumbFile))
+      return true;
+
+    CLog::Log(LOGERROR, "Failed to CreateThumbnailFromSurface for %s", CURL::GetRedacted(thumbFile).c_str());
+    return false;
+  }
   if (URIUtils::HasExtension(thumbFile, ".jpg"))
   {
 #if defined(TARGET_RASPBERRY_PI)
@@ -86,6 +176,20 @@ bool CPicture::CreateThumbnailFromSurface(const unsigned char *buffer, int width
   return ret;
 }
 
+unsigned int CPicture::GetCompressedFormat(bool hasAlpha)
+{
+  CRenderSystemBase* renderSystem = CServiceBroker::GetRenderSystem();
+  if (!renderSystem)
+    return XB_FMT_UNKNOWN;
+
+  // DXT on desktops, ETC2 on GLES 3
+  if (renderSystem->SupportsTextureFormat(hasAlpha ? XB_FMT_DXT5 : XB_FMT_DXT1))
+    return hasAlpha ? XB_FMT_DXT5 : XB_FMT_DXT1;
+  if (renderSystem->SupportsTextureFormat(hasAlpha ? XB_FMT_ETC2_RGBA8 : XB_FMT_ETC2_RGB8))
+    return hasAlpha ? XB_FMT_ETC2_RGBA8 : XB_FMT_ETC2_RGB8;
+  return XB_FMT_UNKNOWN;
+}
+
 CThumbnailWriter::CThumbnailWriter(unsigned char* buffer, int width, int height, int stride, const std::string& thumbFile):
   m_thumbFile(thumbFile)
 {
@@ -259,6 +363,18 @@ bool CPicture::CacheTexture(uint8_t *pixels, uint32_t width, uint32_t height, ui
   return false;
 }
 
+void CPicture::GetMaxCacheSize(uint32_t &width, uint32_t &height)
+{
+  const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+
+  // the fanart res only applies to some images, see CacheTexture
+  const uint32_t max_height = std::max(advancedSettings->m_imageRes, advancedSettings->m_fanartRes);
+  const uint32_t max_width = max_height * 16/9;
+
+  width = width ? std::min(width, max_width) : max_width;
+  height = height ? std::min(height, max_height) : max_height;
+}
+
 bool CPicture::CreateTiledThumb(const std::vector<std::string> &files, const std::string &thumb)
 {
   if (!files.size())
@@ -335,9 +451,32 @@ bool CPicture::ScaleImage(uint8_t *in_pixels, unsigned int in_width, unsigned in
                           uint8_t *out_pixels, unsigned int out_width, unsigned int out_height, unsigned int out_pitch,
                           CPictureScalingAlgorithm::Algorithm scalingAlgorithm /* = CPictureScalingAlgorithm::NoAlgorithm */)
 {
-  struct SwsContext *context = sws_getContext(in_width, in_height, AV_PIX_FMT_BGRA,
-                                                         out_width, out_height, AV_PIX_FMT_BGRA,
-                                                         CPictureScalingAlgorithm::ToSwscale(scalingAlgorithm), NULL, NULL, NULL);
+  const int flags = CPictureScalingAlgorithm::ToSwscale(scalingAlgorithm);
+
+  // halve with a box filter while the image is at least twice the target size, the filters of
+  // swscale get wide and slow on large ratios and the result is about the same
+  std::vector<uint8_t> halved[2];
+  for (int i = 0; flags != SWS_POINT && in_width >= 2 * out_width && in_height >= 2 * out_height; i = 1 - i)
+  {
+    const unsigned int width = in_width / 2;
+    const unsigned int height = in_height / 2;
+    halved[i].resize(static_cast<size_t>(width) * height * 4);
+    CPixelKernels::Halve(in_pixels, in_width, in_height, in_pitch, halved[i].data(), width * 4);
+    in_pixels = halved[i].data();
+    in_width = width;
+    in_height = height;
+    in_pitch = width * 4;
+  }
+
+  if (in_width == out_width && in_height == out_height)
+  {
+    for (unsigned int y = 0; y < out_height; y++)
+      memcpy(out_pixels + y * out_pitch, in_pixels + y * in_pitch, out_width * 4);
+    return true;
+  }
+
+  const CScaleContextPool::Key key(in_width, in_height, out_width, out_height, flags);
+  struct SwsContext *context = GetScaleContextPool().Acquire(key);
 
   uint8_t *src[] = { in_pixels, 0, 0, 0 };
   int     srcStride[] = { (int)in_pitch, 0, 0, 0 };
@@ -347,7 +486,7 @@ bool CPicture::ScaleImage(uint8_t *in_pixels, unsigned int in_width, unsigned in
   if (context)
   {
     sws_scale(context, src, srcStride, 0, in_height, dst, dstStride);
-    sws_freeContext(context);
+    GetScaleContextPool().Release(key, context);
     return true;
   }
   return false;
@@ -22,6 +22,11 @@ public:
   static bool GetThumbnailFromSurface(const unsigned char* buffer, int width, int height, int stride, const std::string &thumbFile, uint8_t* &result, size_t& result_size);
   static bool CreateThumbnailFromSurface(const unsigned char* buffer, int width, int height, int stride, const std::string &thumbFile);
 
+  /*! \brief The block compressed format .dds thumbnails are written in
+   \return XB_FMT_UNKNOWN if the GPU supports none of the formats we can encode
+   */
+  static unsigned int GetCompressedFormat(bool hasAlpha);
+
   /*! \brief Create a tiled thumb of the given files
    \param files the files to create the thumb from
    \param thumb the filename of the thumb
@@ -48,6 +53,14 @@ public:
     uint32_t &dest_width, uint32_t &dest_height, const std::string &dest,
     CPictureScalingAlgorithm::Algorithm scalingAlgorithm = CPictureScalingAlgorithm::NoAlgorithm);
 
+  /*!
+   \brief Get the largest size CacheTexture keeps of an image of unknown size
+   Images that are decoded for caching never need more pixels than this.
+   \param width [in/out] maximum width as passed to CacheTexture, 0 for none - replaced with the bound
+   \param height [in/out] maximum height as passed to CacheTexture, 0 for none - replaced with the bound
+   */
+  static void GetMaxCacheSize(uint32_t &width, uint32_t &height);
+
 private:
   static void GetScale(unsigned int width, unsigned int height, unsigned int &out_width, unsigned int &out_height);
   static bool ScaleImage(uint8_t *in_pixels, unsigned int in_width, unsigned int in_height, unsigned int in_pitch,
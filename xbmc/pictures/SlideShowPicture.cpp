@@ -9,6 +9,8 @@
 #include "SlideShowPicture.h"
 #include "ServiceBroker.h"
 #include "windowing/GraphicContext.h"
+#include "guilib/GUIComponent.h"
+#include "guilib/GUITextureBudget.h"
 #include "guilib/Texture.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
@@ -70,6 +72,7 @@ void CSlideShowPic::Close()
     delete m_pImage;
     m_pImage = nullptr;
   }
+  UpdateImageMemory();
   m_bIsLoaded = false;
   m_bIsFinished = false;
   m_bDrawNextImage = false;
@@ -116,6 +119,7 @@ void CSlideShowPic::SetTexture_Internal(int iSlideNumber, CBaseTexture* pTexture
 
   m_bIsDirty = true;
   m_pImage = pTexture;
+  UpdateImageMemory();
   m_fWidth = (float)pTexture->GetWidth();
   m_fHeight = (float)pTexture->GetHeight();
   if (CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_SLIDESHOW_HIGHQUALITYDOWNSCALING))
@@ -258,11 +262,26 @@ void CSlideShowPic::UpdateTexture(CBaseTexture* pTexture)
     m_pImage = nullptr;
   }
   m_pImage = pTexture;
+  UpdateImageMemory();
   m_fWidth = (float)pTexture->GetWidth();
   m_fHeight = (float)pTexture->GetHeight();
+  if (CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_SLIDESHOW_HIGHQUALITYDOWNSCALING))
+    pTexture->SetMipmapping();
   m_bIsDirty = true;
 }
 
+void CSlideShowPic::UpdateImageMemory()
+{
+  CGUIComponent *gui = CServiceBroker::GetGUI();
+  if (!gui)
+    return;
+
+  CGUITextureBudget &budget = gui->GetTextureBudget();
+  budget.Remove(CGUITextureBudget::POOL_SLIDESHOW, m_imageMemory);
+  m_imageMemory = m_pImage ? static_cast<uint64_t>(m_pImage->GetPitch()) * m_pImage->GetRows() : 0;
+  budget.Add(CGUITextureBudget::POOL_SLIDESHOW, m_imageMemory);
+}
+
 static CRect GetRectangle(const float x[4], const float y[4])
 {
   CRect rect;
@@ -11,6 +11,7 @@
 #include "threads/CriticalSection.h"
 #include "guilib/DirtyRegion.h"
 #include "utils/Color.h"
+#include <stdint.h>
 #include <string>
 #ifdef HAS_DX
 #include "guilib/GUIShaderDX.h"
@@ -79,7 +80,9 @@ private:
   void SetTexture_Internal(int iSlideNumber, CBaseTexture* pTexture, DISPLAY_EFFECT dispEffect = EFFECT_RANDOM, TRANSITION_EFFECT transEffect = FADEIN_FADEOUT);
   void UpdateVertices(float cur_x[4], float cur_y[4], const float new_x[4], const float new_y[4], CDirtyRegionList &dirtyregions);
   void Render(float *x, float *y, CBaseTexture* pTexture, UTILS::Color color);
+  void UpdateImageMemory();
   CBaseTexture *m_pImage;
+  uint64_t m_imageMemory = 0; ///< size of m_pImage as reported to the texture budget
 
   int m_iOriginalWidth;
   int m_iOriginalHeight;
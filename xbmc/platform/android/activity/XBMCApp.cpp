@@ -77,6 +77,7 @@
 #include "input/mouse/MouseStat.h"
 #include "input/Key.h"
 #include "utils/log.h"
+#include "utils/MemoryPressure.h"
 #include "utils/TimeUtils.h"
 #include "platform/android/network/NetworkAndroid.h"
 #include "cores/VideoPlayer/VideoRenderers/RenderManager.h"
@@ -313,7 +314,8 @@ void CXBMCApp::onConfigurationChanged()
 void CXBMCApp::onLowMemory()
 {
   android_printf("%s: ", __PRETTY_FUNCTION__);
-  // can't do much as we don't want to close completely
+  // we don't want to close completely, drop what the caches hold instead
+  CMemoryPressureManager::GetInstance().Signal(MemoryPressure::CRITICAL);
 }
 
 void CXBMCApp::onCreateWindow(ANativeWindow* window)
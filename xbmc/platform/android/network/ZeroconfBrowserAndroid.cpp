@@ -148,6 +148,9 @@ bool CZeroconfBrowserAndroid::doResolveService(CZeroconfBrowser::ZeroconfService
 /// adds the service to list of found services
 void CZeroconfBrowserAndroid::addDiscoveredService(CZeroconfBrowserAndroidDiscover* browser, CZeroconfBrowser::ZeroconfService const& fcr_service)
 {
+  //a re-announced service may have moved
+  ForgetResolvedService(fcr_service);
+
   CSingleLock lock(m_data_guard);
   tDiscoveredServicesMap::iterator browserIt = m_discovered_services.find(browser);
   if(browserIt == m_discovered_services.end())
@@ -171,6 +174,8 @@ void CZeroconfBrowserAndroid::addDiscoveredService(CZeroconfBrowserAndroidDiscov
 
 void CZeroconfBrowserAndroid::removeDiscoveredService(CZeroconfBrowserAndroidDiscover* browser, CZeroconfBrowser::ZeroconfService const& fcr_service)
 {
+  ForgetResolvedService(fcr_service);
+
   CSingleLock lock(m_data_guard);
   tDiscoveredServicesMap::iterator browserIt = m_discovered_services.find(browser);
   //search this service
@@ -178,6 +178,9 @@ void CZeroconfBrowserDarwin::BrowserCallback(CFNetServiceBrowserRef browser, CFO
 void CZeroconfBrowserDarwin::
 addDiscoveredService(CFNetServiceBrowserRef browser, CFOptionFlags flags, CZeroconfBrowser::ZeroconfService const &fcr_service)
 {
+  //a re-announced service may have moved
+  ForgetResolvedService(fcr_service);
+
   CSingleLock lock(m_data_guard);
   tDiscoveredServicesMap::iterator browserIt = m_discovered_services.find(browser);
   if (browserIt == m_discovered_services.end())
@@ -202,6 +205,8 @@ addDiscoveredService(CFNetServiceBrowserRef browser, CFOptionFlags flags, CZeroc
 void CZeroconfBrowserDarwin::
 removeDiscoveredService(CFNetServiceBrowserRef browser, CFOptionFlags flags, CZeroconfBrowser::ZeroconfService const &fcr_service)
 {
+  ForgetResolvedService(fcr_service);
+
   CSingleLock lock(m_data_guard);
   tDiscoveredServicesMap::iterator browserIt = m_discovered_services.find(browser);
   assert(browserIt != m_discovered_services.end());
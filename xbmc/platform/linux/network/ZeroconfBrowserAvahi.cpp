@@ -200,6 +200,7 @@ void CZeroconfBrowserAvahi::clientCallback ( AvahiClient* fp_client, AvahiClient
         it.second = (AvahiServiceBrowser*)0;
       //clean the list of discovered services and update gui (if someone is interested)
       p_instance->m_discovered_services.clear();
+      p_instance->ForgetResolvedServices();
       CGUIMessage message ( GUI_MSG_NOTIFY_ALL, 0, 0, GUI_MSG_UPDATE_PATH );
       message.SetStringParam ( "zeroconf://" );
       CServiceBroker::GetGUI()->GetWindowManager().SendThreadMessage ( message );
@@ -241,6 +242,8 @@ void CZeroconfBrowserAvahi::browseCallback (
         info.interface = interface;
         info.protocol = protocol;
         p_instance->m_discovered_services.insert ( std::make_pair ( service, info ) );
+        //a re-announced service may have moved
+        p_instance->ForgetResolvedService ( service );
         //if this browser already sent the all for now message, we need to update the gui now
         if( p_instance->m_all_for_now_browsers.find(browser) != p_instance->m_all_for_now_browsers.end() )
           update_gui = true;
@@ -251,6 +254,7 @@ void CZeroconfBrowserAvahi::browseCallback (
         //remove the service
         ZeroconfService service(name, type, domain);
         p_instance->m_discovered_services.erase ( service );
+        p_instance->ForgetResolvedService ( service );
         CLog::Log ( LOGDEBUG, "CZeroconfBrowserAvahi::browseCallback REMOVE: service '%s' of type '%s' in domain '%s'\n", name, type, domain );
         //if this browser already sent the all for now message, we need to update the gui now
         if( p_instance->m_all_for_now_browsers.find(browser) != p_instance->m_all_for_now_browsers.end() )
@@ -17,17 +17,26 @@
 #include <assert.h>
 #include <errno.h>
 #include <limits.h>
+#include <string.h>
 #include <string>
 
 #include <fcntl.h>
 #include <sys/ioctl.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
 using namespace XFILE;
 
+namespace
+{
+// size of the mapped window, moved along with the read position
+const size_t MAP_WINDOW_SIZE = 16 * 1024 * 1024;
+}
+
 CPosixFile::~CPosixFile()
 {
+  Unmap();
   if (m_fd >= 0)
     close(m_fd);
 }
@@ -81,14 +90,106 @@ void CPosixFile::Close()
 {
   if (m_fd >= 0)
   {
+    Unmap();
     close(m_fd);
     m_fd = -1;
     m_filePos = -1;
     m_lastDropPos = -1;
     m_allowWrite = false;
+    m_useMap = false;
+  }
+}
+
+void CPosixFile::Unmap()
+{
+  if (m_map)
+  {
+    munmap(m_map, m_mapSize);
+    m_map = nullptr;
+    m_mapOffset = 0;
+    m_mapSize = 0;
   }
 }
 
+bool CPosixFile::MapWindow(int64_t position)
+{
+  // a file that is still being written (e.g. a recording) may have grown
+  if (position >= m_mapLength)
+  {
+    m_mapLength = GetLength();
+    if (position >= m_mapLength)
+      return false;
+  }
+
+  static const int64_t pageSize = sysconf(_SC_PAGESIZE);
+  const int64_t offset = position - position % pageSize;
+  const size_t size = static_cast<size_t>(std::min<int64_t>(MAP_WINDOW_SIZE, m_mapLength - offset));
+
+  // continuing right behind the previous window means we are playing, anything else is a seek
+  const bool sequential = m_map && offset <= m_mapOffset + static_cast<int64_t>(m_mapSize) &&
+                          offset >= m_mapOffset;
+  Unmap();
+
+  void* map = mmap(nullptr, size, PROT_READ, MAP_SHARED, m_fd, static_cast<off_t>(offset));
+  if (map == MAP_FAILED)
+  {
+    CLog::LogF(LOGDEBUG, "mmap failed with errno %d, falling back to read()", errno);
+    m_useMap = false;
+    return false;
+  }
+
+  m_map = static_cast<uint8_t*>(map);
+  m_mapOffset = offset;
+  m_mapSize = size;
+
+  // let the kernel read ahead the whole window while we play, after a seek (e.g. a demuxer
+  // probing the index at the end of a mkv) only fetch what is needed right now
+  if (sequential)
+  {
+    madvise(m_map, m_mapSize, MADV_SEQUENTIAL);
+    madvise(m_map, m_mapSize, MADV_WILLNEED);
+  }
+  else
+    madvise(m_map, m_mapSize, MADV_RANDOM);
+
+  return true;
+}
+
+ssize_t CPosixFile::ReadMapped(void* lpBuf, size_t uiBufSize)
+{
+  if (m_filePos < m_mapOffset || m_filePos >= m_mapOffset + static_cast<int64_t>(m_mapSize))
+  {
+    if (!MapWindow(m_filePos))
+      return -1;
+  }
+
+  const size_t offset = static_cast<size_t>(m_filePos - m_mapOffset);
+  const size_t size = std::min(uiBufSize, m_mapSize - offset);
+  memcpy(lpBuf, m_map + offset, size);
+  m_filePos += size;
+
+  return size;
+}
+
+void CPosixFile::DropCache()
+{
+#if defined(HAVE_POSIX_FADVISE)
+  // Drop the cache between then last drop and 16 MB behind where we
+  // are now, to make sure the file doesn't displace everything else.
+  // However, never throw out the first 16 MB of the file, as it might
+  // be the header etc., and never ask the OS to drop in chunks of
+  // less than 1 MB.
+  const int64_t end_drop = m_filePos - 16 * 1024 * 1024;
+  if (end_drop >= 17 * 1024 * 1024)
+  {
+    const int64_t start_drop = std::max<int64_t>(m_lastDropPos, 16 * 1024 * 1024);
+    if (end_drop - start_drop >= 1 * 1024 * 1024 &&
+        posix_fadvise(m_fd, start_drop, end_drop - start_drop, POSIX_FADV_DONTNEED) == 0)
+      m_lastDropPos = end_drop;
+  }
+#endif
+}
+
 
 ssize_t CPosixFile::Read(void* lpBuf, size_t uiBufSize)
 {
@@ -102,6 +203,19 @@ ssize_t CPosixFile::Read(void* lpBuf, size_t uiBufSize)
   if (uiBufSize > SSIZE_MAX)
     uiBufSize = SSIZE_MAX;
 
+  if (m_useMap && m_filePos >= 0)
+  {
+    const ssize_t res = ReadMapped(lpBuf, uiBufSize);
+    if (res >= 0)
+    {
+      DropCache();
+      return res;
+    }
+    // past the end or mapping failed, the descriptor has not followed the mapped reads
+    if (Seek(m_filePos, SEEK_SET) < 0)
+      return -1;
+  }
+
   const ssize_t res = read(m_fd, lpBuf, uiBufSize);
   if (res < 0)
   {
@@ -112,21 +226,7 @@ ssize_t CPosixFile::Read(void* lpBuf, size_t uiBufSize)
   if (m_filePos >= 0)
   {
     m_filePos += res; // if m_filePos was known - update it
-#if defined(HAVE_POSIX_FADVISE)
-    // Drop the cache between then last drop and 16 MB behind where we
-    // are now, to make sure the file doesn't displace everything else.
-    // However, never throw out the first 16 MB of the file, as it might
-    // be the header etc., and never ask the OS to drop in chunks of
-    // less than 1 MB.
-    const int64_t end_drop = m_filePos - 16 * 1024 * 1024;
-    if (end_drop >= 17 * 1024 * 1024)
-    {
-      const int64_t start_drop = std::max<int64_t>(m_lastDropPos, 16 * 1024 * 1024);
-      if (end_drop - start_drop >= 1 * 1024 * 1024 &&
-          posix_fadvise(m_fd, start_drop, end_drop - start_drop, POSIX_FADV_DONTNEED) == 0)
-        m_lastDropPos = end_drop;
-    }
-#endif
+    DropCache();
   }
 
   return res;
@@ -162,6 +262,13 @@ int64_t CPosixFile::Seek(int64_t iFilePosition, int iWhence /* = SEEK_SET*/)
   if (m_fd < 0)
     return -1;
 
+  // mapped reads don't move the descriptor, seek relative to our own position
+  if (m_useMap && iWhence == SEEK_CUR && m_filePos >= 0)
+  {
+    iFilePosition += m_filePos;
+    iWhence = SEEK_SET;
+  }
+
 #ifdef TARGET_ANDROID
   //! @todo properly support with detection in configure
   //! Android special case: Android doesn't substitute off64_t for off_t and similar functions
@@ -225,7 +332,31 @@ int CPosixFile::IoControl(EIoControl request, void* param)
   if (m_fd < 0)
     return -1;
 
-  if (request == IOCTRL_NATIVE)
+  if (request == IOCTRL_SET_MMAP)
+  {
+    if (!param)
+      return -1;
+
+    // only for read only regular files, a mapping can't follow writes and isn't possible for
+    // pipes or devices
+    struct stat64 st;
+    const bool enable = *static_cast<bool*>(param);
+    if (enable && (m_allowWrite || fstat64(m_fd, &st) != 0 || !S_ISREG(st.st_mode)))
+      return 0;
+
+    if (!enable && m_useMap)
+    {
+      Unmap();
+      if (GetPosition() >= 0)
+        Seek(m_filePos, SEEK_SET);
+    }
+    else if (enable)
+      m_mapLength = st.st_size;
+
+    m_useMap = enable;
+    return 1;
+  }
+  else if (request == IOCTRL_NATIVE)
   {
     if(!param)
       return -1;
@@ -38,10 +38,22 @@ namespace XFILE
     int Stat(struct __stat64* buffer) override;
 
   protected:
+    ssize_t ReadMapped(void* lpBuf, size_t uiBufSize);
+    bool MapWindow(int64_t position);
+    void Unmap();
+    void DropCache();
+
     int     m_fd = -1;
     int64_t m_filePos = -1;
     int64_t m_lastDropPos = -1;
     bool    m_allowWrite = false;
+
+    // memory mapped read mode, see IOCTRL_SET_MMAP
+    bool     m_useMap = false;
+    uint8_t* m_map = nullptr;
+    int64_t  m_mapOffset = 0;
+    size_t   m_mapSize = 0;
+    int64_t  m_mapLength = 0;
   };
 
 }
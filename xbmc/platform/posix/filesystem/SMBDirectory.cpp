@@ -24,6 +24,7 @@
 #include "ServiceBroker.h"
 #include "Util.h"
 #include "guilib/LocalizeStrings.h"
+#include "network/DNSNameCache.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
@@ -71,6 +72,8 @@ bool CSMBDirectory::GetDirectory(const CURL& url, CFileItemList &items)
   if (fd < 0)
     return false;
 
+  CDNSNameCache::SetAlive(url.GetHostName());
+
   URIUtils::AddSlashAtEnd(strRoot);
   URIUtils::AddSlashAtEnd(strAuth);
 
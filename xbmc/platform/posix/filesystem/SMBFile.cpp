@@ -18,17 +18,24 @@
 #include "Util.h"
 #include "commons/Exception.h"
 #include "filesystem/SpecialProtocol.h"
+#include "network/DNSNameCache.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/JobManager.h"
 #include "utils/StringUtils.h"
 #include "utils/TimeUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <libsmbclient.h>
 
+// the first block of a file and after a seek, also the alignment of all reads
+#define SMB_MIN_BLOCK_SIZE (64 * 1024)
+
 using namespace XFILE;
 
 void xb_smbc_log(const char* msg)
@@ -340,6 +347,8 @@ int64_t CSMBFile::GetPosition()
 {
   if (m_fd == -1)
     return -1;
+  if (m_readAheadSize > 0)
+    return m_position;
   CSingleLock lock(smb);
   return smbc_lseek(m_fd, 0, SEEK_CUR);
 }
@@ -397,6 +406,23 @@ bool CSMBFile::Open(const CURL& url)
     m_fd = -1;
     return false;
   }
+
+  const auto advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  m_readAheadSize = advancedSettings->m_sambaReadAheadSize;
+  std::string shareName = url.GetHostName() + "/" + url.GetShareName();
+  StringUtils::ToLower(shareName);
+  auto share = advancedSettings->m_sambaShareReadAheadSize.find(shareName);
+  if (share != advancedSettings->m_sambaShareReadAheadSize.end())
+    m_readAheadSize = share->second;
+  if (m_readAheadSize > 0)
+    m_readAheadSize = std::max(m_readAheadSize, static_cast<unsigned int>(SMB_MIN_BLOCK_SIZE));
+  m_blockSize = SMB_MIN_BLOCK_SIZE;
+  m_position = 0;
+  m_bytesTransferred = 0;
+  m_transferTimeMs = 0;
+
+  CDNSNameCache::SetAlive(url.GetHostName());
+
   // We've successfully opened the file!
   return true;
 }
@@ -524,6 +550,50 @@ ssize_t CSMBFile::Read(void *lpBuf, size_t uiBufSize)
   if (uiBufSize == 0 && lpBuf == NULL)
     return 0;
 
+  if (m_readAheadSize == 0)
+    return ReadDirect(lpBuf, uiBufSize);
+
+  if (m_position >= m_fileSize)
+    return 0;
+
+  if (!m_block.Contains(m_position))
+  {
+    WaitForReadAhead();
+
+    // many small requests take far longer than a few large ones, the blocks grow while reading on
+    bool sequential = !m_block.data.empty() && m_position == m_block.End();
+    if (sequential)
+      m_blockSize = std::min<size_t>(m_blockSize * 2, m_readAheadSize);
+    else
+    {
+      m_blockSize = SMB_MIN_BLOCK_SIZE;
+      m_bytesTransferred = 0;
+      m_transferTimeMs = 0;
+    }
+
+    if (m_nextBlock.Contains(m_position))
+      std::swap(m_block, m_nextBlock);
+    else if (!ReadBlockFromServer(m_block, m_position - m_position % SMB_MIN_BLOCK_SIZE, m_blockSize))
+      return -1;
+    m_nextBlock.data.clear();
+
+    if (!m_block.Contains(m_position))
+      return 0;
+  }
+
+  size_t size = static_cast<size_t>(std::min<int64_t>(uiBufSize, m_block.End() - m_position));
+  memcpy(lpBuf, m_block.data.data() + (m_position - m_block.position), size);
+  m_position += size;
+
+  // random access and small files stay with the first block
+  if (m_blockSize > SMB_MIN_BLOCK_SIZE)
+    StartReadAhead(m_block.End());
+
+  return size;
+}
+
+ssize_t CSMBFile::ReadDirect(void* lpBuf, size_t uiBufSize)
+{
   CSingleLock lock(smb); // Init not called since it has to be "inited" by now
   smb.SetActivityTime();
 
@@ -541,10 +611,103 @@ ssize_t CSMBFile::Read(void *lpBuf, size_t uiBufSize)
   return bytesRead;
 }
 
+bool CSMBFile::ReadBlockFromServer(ReadBlock& block, int64_t position, size_t size)
+{
+  size = static_cast<size_t>(std::max<int64_t>(0, std::min<int64_t>(size, m_fileSize - position)));
+  block.position = position;
+  block.data.resize(size);
+
+  CSingleLock lock(smb);
+  smb.SetActivityTime();
+
+  unsigned int start = XbmcThreads::SystemClockMillis();
+  if (smbc_lseek(m_fd, position, SEEK_SET) < 0)
+  {
+    CLog::Log(LOGERROR, "%s - Error( seek to %" PRId64 ", %d, %s )", __FUNCTION__, position, errno, strerror(errno));
+    block.data.clear();
+    return false;
+  }
+
+  // libsmbclient keeps several requests of a large read in flight
+  size_t done = 0;
+  while (done < size)
+  {
+    ssize_t bytesRead = smbc_read(m_fd, block.data.data() + done, size - done);
+    if (m_allowRetry && bytesRead < 0 && errno == EINVAL)
+    {
+      CLog::Log(LOGERROR, "%s - Error( %" PRIdS ", %d, %s ) - Retrying", __FUNCTION__, bytesRead, errno, strerror(errno));
+      bytesRead = smbc_read(m_fd, block.data.data() + done, size - done);
+    }
+
+    if (bytesRead < 0)
+    {
+      CLog::Log(LOGERROR, "%s - Error( %" PRIdS ", %d, %s )", __FUNCTION__, bytesRead, errno, strerror(errno));
+      block.data.clear();
+      return false;
+    }
+    if (bytesRead == 0)
+      break;
+    done += bytesRead;
+  }
+  block.data.resize(done);
+
+  m_bytesTransferred += done;
+  m_transferTimeMs += XbmcThreads::SystemClockMillis() - start;
+  return true;
+}
+
+void CSMBFile::StartReadAhead(int64_t position)
+{
+  if (position >= m_fileSize)
+    return;
+
+  CSingleLock lock(m_readAheadSection);
+  if (m_readAheadPending || (!m_nextBlock.data.empty() && m_nextBlock.position == position))
+    return;
+
+  m_readAheadPending = true;
+  size_t size = std::min<size_t>(m_blockSize * 2, m_readAheadSize);
+  CJobManager::GetInstance().Submit([this, position, size]()
+  {
+    ReadBlockFromServer(m_nextBlock, position, size);
+
+    CSingleLock lock(m_readAheadSection);
+    m_readAheadPending = false;
+    m_readAheadDone.Set();
+  }, CJob::PRIORITY_HIGH);
+}
+
+void CSMBFile::WaitForReadAhead()
+{
+  CSingleLock lock(m_readAheadSection);
+  while (m_readAheadPending)
+  {
+    CSingleExit exit(m_readAheadSection);
+    m_readAheadDone.Wait();
+  }
+}
+
 int64_t CSMBFile::Seek(int64_t iFilePosition, int iWhence)
 {
   if (m_fd == -1) return -1;
 
+  if (m_readAheadSize > 0)
+  {
+    int64_t pos = iFilePosition;
+    if (iWhence == SEEK_CUR)
+      pos += m_position;
+    else if (iWhence == SEEK_END)
+      pos += m_fileSize;
+    else if (iWhence != SEEK_SET)
+      return -1;
+
+    if (pos < 0)
+      return -1;
+
+    m_position = pos;
+    return pos;
+  }
+
   CSingleLock lock(smb); // Init not called since it has to be "inited" by now
   smb.SetActivityTime();
   int64_t pos = smbc_lseek(m_fd, iFilePosition, iWhence);
@@ -560,8 +723,16 @@ int64_t CSMBFile::Seek(int64_t iFilePosition, int iWhence)
 
 void CSMBFile::Close()
 {
+  WaitForReadAhead();
+  m_block.data.clear();
+  m_nextBlock.data.clear();
+  m_readAheadSize = 0;
+
   if (m_fd != -1)
   {
+    if (m_transferTimeMs > 0)
+      CLog::Log(LOGDEBUG, "CSMBFile::Close - read %" PRIu64 " bytes at %" PRIu64 " KiB/s",
+                m_bytesTransferred.load(), m_bytesTransferred * 1000 / m_transferTimeMs / 1024);
     CLog::Log(LOGDEBUG,"CSMBFile::Close closing fd %d", m_fd);
     CSingleLock lock(smb);
     smbc_close(m_fd);
@@ -669,6 +840,17 @@ int CSMBFile::IoControl(EIoControl request, void* param)
     return 0;
   }
 
+  if (request == IOCTRL_CACHE_STATUS && m_readAheadSize > 0)
+  {
+    SCacheStatus* status = static_cast<SCacheStatus*>(param);
+    status->forward = m_block.Contains(m_position) ? m_block.End() - m_position : 0;
+    status->maxrate = 0;
+    const uint64_t transferTimeMs = m_transferTimeMs;
+    status->currate = transferTimeMs > 0 ? static_cast<unsigned>(m_bytesTransferred * 1000 / transferTimeMs) : 0;
+    status->lowspeed = false;
+    return 0;
+  }
+
   return -1;
 }
 
@@ -18,6 +18,11 @@
 #include "URL.h"
 #include "filesystem/IFile.h"
 #include "threads/CriticalSection.h"
+#include "threads/Event.h"
+
+#include <atomic>
+#include <stdint.h>
+#include <vector>
 
 #define NT_STATUS_CONNECTION_REFUSED long(0xC0000000 | 0x0236)
 #define NT_STATUS_INVALID_HANDLE long(0xC0000000 | 0x0008)
@@ -85,5 +90,37 @@ protected:
   int64_t m_fileSize;
   int m_fd;
   bool m_allowRetry;
+
+private:
+  struct ReadBlock
+  {
+    int64_t position = 0;
+    std::vector<uint8_t> data;
+
+    bool Contains(int64_t pos) const
+    {
+      return pos >= position && pos < position + static_cast<int64_t>(data.size());
+    }
+    int64_t End() const { return position + data.size(); }
+  };
+
+  ssize_t ReadDirect(void* lpBuf, size_t uiBufSize);
+  bool ReadBlockFromServer(ReadBlock& block, int64_t position, size_t size);
+  void StartReadAhead(int64_t position);
+  void WaitForReadAhead();
+
+  // reads are done in aligned blocks which grow up to m_readAheadSize while the file is
+  // read sequentially, the next block is read by a job while the current one is consumed
+  unsigned int m_readAheadSize = 0;
+  size_t m_blockSize = 0;
+  int64_t m_position = 0;
+  ReadBlock m_block;
+  ReadBlock m_nextBlock;
+  bool m_readAheadPending = false;
+  CCriticalSection m_readAheadSection;
+  CEvent m_readAheadDone;
+
+  std::atomic<uint64_t> m_bytesTransferred{0};
+  std::atomic<uint64_t> m_transferTimeMs{0};
 };
 }
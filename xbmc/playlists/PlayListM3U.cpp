@@ -18,10 +18,75 @@
 #include "video/VideoInfoTag.h"
 
 #include <inttypes.h>
+#include <vector>
 
 using namespace PLAYLIST;
 using namespace XFILE;
 
+// IPTV playlists have tens of thousands of entries, read them in big blocks
+#define M3U_READ_BLOCK_SIZE (64 * 1024)
+
+namespace
+{
+
+/*!
+ * \brief Splits a file into lines without reading it line by line
+ *
+ * Files without a chunk size aren't buffered by CFile, so CFile::ReadString()
+ * would read and seek back for each line.
+ */
+class CLineReader
+{
+public:
+  explicit CLineReader(CFile& file) : m_file(file), m_buffer(M3U_READ_BLOCK_SIZE) {}
+
+  bool ReadLine(std::string& line)
+  {
+    line.clear();
+    while (true)
+    {
+      if (m_pos == m_size)
+      {
+        if (m_eof)
+          return !line.empty();
+
+        const ssize_t read = m_file.Read(m_buffer.data(), m_buffer.size());
+        if (read <= 0)
+        {
+          m_eof = true;
+          return !line.empty();
+        }
+        m_pos = 0;
+        m_size = static_cast<size_t>(read);
+      }
+
+      const char* start = m_buffer.data() + m_pos;
+      const char* end = m_buffer.data() + m_size;
+      const char* eol = start;
+      while (eol != end && *eol != '\n' && *eol != '\r')
+        eol++;
+
+      line.append(start, eol);
+      if (eol != end)
+      {
+        // a CR LF pair ends an empty line, which is skipped anyway
+        m_pos = eol - m_buffer.data() + 1;
+        return true;
+      }
+      m_pos = m_size;
+    }
+  }
+
+private:
+  CFile& m_file;
+  std::vector<char> m_buffer;
+  size_t m_pos = 0;
+  size_t m_size = 0;
+  bool m_eof = false;
+};
+
+} // unnamed namespace
+
 const char* CPlayListM3U::StartMarker = "#EXTCPlayListM3U::M3U";
 const char* CPlayListM3U::InfoMarker = "#EXTINF";
 const char* CPlayListM3U::ArtistMarker = "#EXTART";
@@ -59,7 +124,6 @@ CPlayListM3U::~CPlayListM3U(void) = default;
 
 bool CPlayListM3U::Load(const std::string& strFileName)
 {
-  char szLine[4096];
   std::string strLine;
   std::string strInfo;
   std::vector<std::pair<std::string, std::string> > properties;
@@ -80,9 +144,9 @@ bool CPlayListM3U::Load(const std::string& strFileName)
     return false;
   }
 
-  while (file.ReadString(szLine, 4095))
+  CLineReader reader(file);
+  while (reader.ReadLine(strLine))
   {
-    strLine = szLine;
     StringUtils::Trim(strLine);
 
     if (StringUtils::StartsWith(strLine, InfoMarker))
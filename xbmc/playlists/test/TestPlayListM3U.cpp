@@ -0,0 +1,38 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "FileItem.h"
+#include "playlists/PlayListM3U.h"
+#include "test/TestUtils.h"
+
+#include <gtest/gtest.h>
+
+using namespace PLAYLIST;
+
+
+TEST(TestPlayListM3U, Load)
+{
+  // CR LF line endings and no line break after the last entry
+  std::string filename = XBMC_REF_FILE_PATH("/xbmc/playlists/test/test.m3u");
+  CPlayListM3U playlist;
+
+  EXPECT_TRUE(playlist.Load(filename));
+
+  ASSERT_EQ(playlist.size(), 3);
+
+  EXPECT_STREQ(playlist[0]->GetLabel().c_str(), "First stream");
+  EXPECT_STREQ(playlist[0]->GetPath().c_str(), "http://example.com/stream_1.ts");
+  EXPECT_STREQ(playlist[0]->GetMimeType().c_str(), "");
+
+  EXPECT_STREQ(playlist[1]->GetLabel().c_str(), "Second stream");
+  EXPECT_STREQ(playlist[1]->GetPath().c_str(), "http://example.com/stream_2.ts");
+  EXPECT_STREQ(playlist[1]->GetMimeType().c_str(), "video/mp2t");
+
+  EXPECT_STREQ(playlist[2]->GetLabel().c_str(), "stream_3.ts");
+  EXPECT_STREQ(playlist[2]->GetPath().c_str(), "http://example.com/stream_3.ts");
+}
@@ -31,13 +31,16 @@
 #include "guilib/GUIWindowManager.h"
 #include "guilib/LocalizeStrings.h"
 #include "input/InputManager.h"
+#include "messaging/ApplicationMessenger.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "settings/lib/Setting.h"
 #include "settings/lib/SettingsManager.h"
 #if !defined(TARGET_WINDOWS) && defined(HAS_DVD_DRIVE)
 #include "storage/DetectDVDType.h"
 #endif
 #include "threads/SingleLock.h"
+#include "utils/auto_buffer.h"
 #include "utils/FileUtils.h"
 #include "utils/log.h"
 #include "utils/StringUtils.h"
@@ -73,9 +76,41 @@
 #define XML_PROFILE       "profile"
 
 using namespace XFILE;
+using namespace KODI::MESSAGING;
 
 static CProfile EmptyProfile;
 
+/*! \brief What the loaded skin depends on, a profile with the same state keeps the skin loaded
+ along with its fonts, textures and includes
+ */
+static std::string GetSkinState(const CSettings& settings)
+{
+  std::string state;
+  for (const std::string& id : { CSettings::SETTING_LOOKANDFEEL_SKIN,
+                                 CSettings::SETTING_LOOKANDFEEL_SKINTHEME,
+                                 CSettings::SETTING_LOOKANDFEEL_SKINCOLORS,
+                                 CSettings::SETTING_LOOKANDFEEL_FONT,
+                                 CSettings::SETTING_LOOKANDFEEL_SKINZOOM,
+                                 CSettings::SETTING_LOCALE_LANGUAGE })
+  {
+    const std::shared_ptr<CSetting> setting = settings.GetSetting(id);
+    if (setting)
+      state += setting->ToString();
+    state += '\n';
+  }
+
+  // the skin settings are stored with each profile
+  if (g_SkinInfo != nullptr)
+  {
+    CFile file;
+    XUTILS::auto_buffer buffer;
+    if (file.LoadFile(URIUtils::AddFileToFolder(g_SkinInfo->Profile(), "settings.xml"), buffer) > 0)
+      state.append(buffer.get(), buffer.size());
+  }
+
+  return state;
+}
+
 CProfileManager::CProfileManager() :
     m_usingLoginScreen(false),
     m_profileLoadedForLogin(false),
@@ -279,7 +314,7 @@ bool CProfileManager::LoadProfile(unsigned int index)
 
     UpdateCurrentProfileDate();
     Save();
-    FinalizeLoadProfile();
+    FinalizeLoadProfile(false);
 
     return true;
   }
@@ -301,6 +336,8 @@ bool CProfileManager::LoadProfile(unsigned int index)
   // @todo: why is m_settings not used here?
   const std::shared_ptr<CSettings> settings = CServiceBroker::GetSettingsComponent()->GetSettings();
 
+  const std::string skinState = GetSkinState(*settings);
+
   // unload any old settings
   settings->Unload();
 
@@ -317,7 +354,6 @@ bool CProfileManager::LoadProfile(unsigned int index)
 
   CreateProfileFolders();
 
-  CServiceBroker::GetDatabaseManager().Initialize();
   CServiceBroker::GetInputManager().LoadKeymaps();
 
   CServiceBroker::GetInputManager().SetMouseEnabled(settings->GetBool(CSettings::SETTING_INPUT_ENABLEMOUSE));
@@ -357,14 +393,18 @@ bool CProfileManager::LoadProfile(unsigned int index)
 
   lock.Leave();
 
+  // opening a database waits until it's updated, the ones not needed right away don't hold up
+  // the switch
+  CServiceBroker::GetDatabaseManager().InitializeInBackground();
+
   UpdateCurrentProfileDate();
   Save();
-  FinalizeLoadProfile();
+  FinalizeLoadProfile(GetSkinState(*settings) != skinState);
 
   return true;
 }
 
-void CProfileManager::FinalizeLoadProfile()
+void CProfileManager::FinalizeLoadProfile(bool reloadSkin)
 {
   CContextMenuManager &contextMenuManager = CServiceBroker::GetContextMenuManager();
   ADDON::CServiceAddonManager &serviceAddons = CServiceBroker::GetServiceAddons();
@@ -385,18 +425,23 @@ void CProfileManager::FinalizeLoadProfile()
 
   networkManager.NetworkMessage(CNetworkBase::SERVICES_UP, 1);
 
-  // reload the add-ons, or we will first load all add-ons from the master account without checking disabled status
-  addonManager.ReInit();
+  // reload the add-on states, or we will first load all add-ons from the master account without checking disabled status
+  addonManager.ReInitDatabase();
 
   // let CApplication know that we are logging into a new profile
   g_application.SetLoggingIn(true);
 
-  if (!g_application.LoadLanguage(true))
+  // also loads the strings of the add-ons enabled in this profile, weather and PVR are
+  // restarted below
+  if (!g_application.LoadLanguage(false))
   {
     CLog::Log(LOGFATAL, "Unable to load language for profile \"%s\"", GetCurrentProfile().getName().c_str());
     return;
   }
 
+  if (reloadSkin)
+    CApplicationMessenger::GetInstance().PostMsg(TMSG_EXECUTE_BUILT_IN, -1, -1, nullptr, "ReloadSkin");
+
   weatherManager.Refresh();
 
   JSONRPC::CJSONRPC::Initialize();
@@ -192,7 +192,10 @@ private:
   void SetCurrentProfileId(unsigned int profileId);
 
   void PrepareLoadProfile(unsigned int profileIndex);
-  void FinalizeLoadProfile();
+  /*!
+   \param reloadSkin false if the skin would look the same in the loaded profile
+   */
+  void FinalizeLoadProfile(bool reloadSkin);
 
   // Construction parameters
   std::shared_ptr<CSettings> m_settings;
@@ -350,6 +350,7 @@ int CPVRDatabase::Get(CPVRChannelGroup& results, bool bCompressDB)
                                                           static_cast<unsigned int>(m_pDS->fv("iClientSubChannelNumber").get_asInt())));
         results.m_sortedMembers.emplace_back(newMember);
         results.m_members.insert(std::make_pair(channel->StorageId(), newMember));
+        results.InvalidateMembersSnapshot();
 
         m_pDS->next();
         ++iReturn;
@@ -660,6 +661,7 @@ int CPVRDatabase::Get(CPVRChannelGroup& group, const CPVRChannelGroup& allGroup)
                                                             static_cast<unsigned int>(m_pDS->fv("iClientSubChannelNumber").get_asInt())));
           group.m_sortedMembers.emplace_back(newMember);
           group.m_members.insert(std::make_pair(channel->second->StorageId(), newMember));
+          group.InvalidateMembersSnapshot();
           ++iReturn;
         }
         else
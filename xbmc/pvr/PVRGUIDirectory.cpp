@@ -228,7 +228,6 @@ void GetSubDirectories(const CPVRRecordingsPath& recParentPath,
 bool CPVRGUIDirectory::GetRecordingsDirectory(CFileItemList& results) const
 {
   bool bGrouped = false;
-  const std::vector<std::shared_ptr<CPVRRecording>> recordings = CServiceBroker::GetPVRManager().Recordings()->GetAll();
 
   if (m_url.HasOption("view"))
   {
@@ -254,6 +253,8 @@ bool CPVRGUIDirectory::GetRecordingsDirectory(CFileItemList& results) const
     // Get the directory structure if in non-flatten mode
     // Deleted view is always flatten. So only for an active view
     const std::string strDirectory = recPath.GetUnescapedDirectoryPath();
+    const std::vector<std::shared_ptr<CPVRRecording>> recordings =
+      CServiceBroker::GetPVRManager().Recordings()->GetByDirectory(recPath.IsRadio(), recPath.IsDeleted(), strDirectory);
     if (!recPath.IsDeleted() && bGrouped)
       GetSubDirectories(recPath, recordings, results);
 
@@ -370,8 +371,8 @@ bool CPVRGUIDirectory::GetChannelsDirectory(CFileItemList& results) const
 
       if (group)
       {
-        const std::vector<PVRChannelGroupMember> groupMembers = group->GetMembers();
-        for (const auto& groupMember : groupMembers)
+        const std::shared_ptr<const PVR_CHANNEL_GROUP_SORTED_MEMBERS> groupMembers = group->GetSortedMembers();
+        for (const auto& groupMember : *groupMembers)
         {
           if (bShowHiddenChannels != groupMember.channel->IsHidden())
             continue;
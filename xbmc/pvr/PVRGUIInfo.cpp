@@ -11,6 +11,7 @@
 #include "Application.h"
 #include "GUIInfoManager.h"
 #include "ServiceBroker.h"
+#include "cores/DataCacheCore.h"
 #include "guilib/GUIComponent.h"
 #include "guilib/GUIWindowManager.h"
 #include "guilib/LocalizeStrings.h"
@@ -834,6 +835,14 @@ bool CPVRGUIInfo::GetPVRLabel(const CFileItem* item, const CGUIInfo& info, std::
     case PVR_ACTUAL_STREAM_PROVIDER:
       CharInfoProvider(strValue);
       return true;
+    case PVR_CHANNEL_ZAP_TIME:
+      if (CServiceBroker::GetPVRManager().IsPlayingTV() || CServiceBroker::GetPVRManager().IsPlayingRadio())
+      {
+        const int zapTime = CServiceBroker::GetDataCacheCore().GetStartupTime();
+        if (zapTime > 0)
+          strValue = StringUtils::Format("%d", zapTime);
+      }
+      return true;
     case PVR_BACKEND_NAME:
       CharInfoBackendName(strValue);
       return true;
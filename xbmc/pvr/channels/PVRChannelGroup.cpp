@@ -123,6 +123,7 @@ void CPVRChannelGroup::Unload(void)
   CSingleLock lock(m_critSection);
   m_sortedMembers.clear();
   m_members.clear();
+  InvalidateMembersSnapshot();
   m_failedClientsForChannels.clear();
   m_failedClientsForChannelGroupMembers.clear();
 }
@@ -172,6 +173,7 @@ bool CPVRChannelGroup::SetChannelNumber(const std::shared_ptr<CPVRChannel>& chan
         m_bChanged = true;
         bReturn = true;
         member.channelNumber = channelNumber;
+        InvalidateMembersSnapshot();
       }
       break;
     }
@@ -229,14 +231,20 @@ void CPVRChannelGroup::SortByClientChannelNumber(void)
 {
   CSingleLock lock(m_critSection);
   if (!PreventSortAndRenumber())
+  {
     sort(m_sortedMembers.begin(), m_sortedMembers.end(), sortByClientChannelNumber());
+    InvalidateMembersSnapshot();
+  }
 }
 
 void CPVRChannelGroup::SortByChannelNumber(void)
 {
   CSingleLock lock(m_critSection);
   if (!PreventSortAndRenumber())
+  {
     sort(m_sortedMembers.begin(), m_sortedMembers.end(), sortByChannelNumber());
+    InvalidateMembersSnapshot();
+  }
 }
 
 bool CPVRChannelGroup::UpdateClientPriorities()
@@ -267,9 +275,35 @@ bool CPVRChannelGroup::UpdateClientPriorities()
     member.iClientPriority = iNewPriority;
   }
 
+  if (bChanged)
+    InvalidateMembersSnapshot();
+
   return bChanged;
 }
 
+void CPVRChannelGroup::InvalidateMembersSnapshot()
+{
+  m_membersSnapshot.reset();
+}
+
+std::shared_ptr<const CPVRChannelGroup::MembersSnapshot> CPVRChannelGroup::GetMembersSnapshot() const
+{
+  CSingleLock lock(m_critSection);
+  if (!m_membersSnapshot)
+  {
+    const std::shared_ptr<MembersSnapshot> snapshot = std::make_shared<MembersSnapshot>();
+    snapshot->members = m_sortedMembers;
+    for (size_t i = 0; i < m_sortedMembers.size(); ++i)
+    {
+      const PVRChannelGroupMember& member = m_sortedMembers[i];
+      snapshot->channels.insert(std::make_pair(m_bUsingBackendChannelNumbers ? member.clientChannelNumber : member.channelNumber, member.channel));
+      snapshot->positions.insert(std::make_pair(member.channel->StorageId(), i));
+    }
+    m_membersSnapshot = snapshot;
+  }
+  return m_membersSnapshot;
+}
+
 /********** getters **********/
 PVRChannelGroupMember& CPVRChannelGroup::GetByUniqueID(const std::pair<int, int>& id)
 {
@@ -354,16 +388,9 @@ CPVRChannelNumber CPVRChannelGroup::GetClientChannelNumber(const std::shared_ptr
 
 std::shared_ptr<CPVRChannel> CPVRChannelGroup::GetByChannelNumber(const CPVRChannelNumber& channelNumber) const
 {
-  CSingleLock lock(m_critSection);
-
-  for (const auto& groupMember : m_sortedMembers)
-  {
-    CPVRChannelNumber activeChannelNumber = m_bUsingBackendChannelNumbers ? groupMember.clientChannelNumber : groupMember.channelNumber;
-    if (activeChannelNumber == channelNumber)
-      return groupMember.channel;
-  }
-
-  return {};
+  const std::shared_ptr<const MembersSnapshot> snapshot = GetMembersSnapshot();
+  const auto it = snapshot->channels.find(channelNumber);
+  return it != snapshot->channels.end() ? it->second : std::shared_ptr<CPVRChannel>();
 }
 
 std::shared_ptr<CPVRChannel> CPVRChannelGroup::GetNextChannel(const std::shared_ptr<CPVRChannel>& channel) const
@@ -372,20 +399,16 @@ std::shared_ptr<CPVRChannel> CPVRChannelGroup::GetNextChannel(const std::shared_
 
   if (channel)
   {
-    CSingleLock lock(m_critSection);
-    for (auto it = m_sortedMembers.cbegin(); !nextChannel && it != m_sortedMembers.cend(); ++it)
+    const std::shared_ptr<const MembersSnapshot> snapshot = GetMembersSnapshot();
+    const auto it = snapshot->positions.find(channel->StorageId());
+    if (it != snapshot->positions.end() && snapshot->members[it->second].channel == channel)
     {
-      if ((*it).channel == channel)
+      const size_t iSize = snapshot->members.size();
+      for (size_t i = 1; !nextChannel && i <= iSize; ++i)
       {
-        do
-        {
-          if ((++it) == m_sortedMembers.end())
-            it = m_sortedMembers.begin();
-          if ((*it).channel && !(*it).channel->IsHidden())
-            nextChannel = (*it).channel;
-        } while (!nextChannel && (*it).channel != channel);
-
-        break;
+        const std::shared_ptr<CPVRChannel>& candidate = snapshot->members[(it->second + i) % iSize].channel;
+        if (candidate && !candidate->IsHidden())
+          nextChannel = candidate;
       }
     }
   }
@@ -399,34 +422,36 @@ std::shared_ptr<CPVRChannel> CPVRChannelGroup::GetPreviousChannel(const std::sha
 
   if (channel)
   {
-    CSingleLock lock(m_critSection);
-    for (auto it = m_sortedMembers.rbegin(); !previousChannel && it != m_sortedMembers.rend(); ++it)
+    const std::shared_ptr<const MembersSnapshot> snapshot = GetMembersSnapshot();
+    const auto it = snapshot->positions.find(channel->StorageId());
+    if (it != snapshot->positions.end() && snapshot->members[it->second].channel == channel)
     {
-      if ((*it).channel == channel)
+      const size_t iSize = snapshot->members.size();
+      for (size_t i = 1; !previousChannel && i <= iSize; ++i)
       {
-        do
-        {
-          if ((++it) == m_sortedMembers.rend())
-            it = m_sortedMembers.rbegin();
-          if ((*it).channel && !(*it).channel->IsHidden())
-            previousChannel = (*it).channel;
-        } while (!previousChannel && (*it).channel != channel);
-
-        break;
+        const std::shared_ptr<CPVRChannel>& candidate = snapshot->members[(it->second + iSize - i) % iSize].channel;
+        if (candidate && !candidate->IsHidden())
+          previousChannel = candidate;
       }
     }
   }
   return previousChannel;
 }
 
+std::shared_ptr<const PVR_CHANNEL_GROUP_SORTED_MEMBERS> CPVRChannelGroup::GetSortedMembers() const
+{
+  const std::shared_ptr<const MembersSnapshot> snapshot = GetMembersSnapshot();
+  return std::shared_ptr<const PVR_CHANNEL_GROUP_SORTED_MEMBERS>(snapshot, &snapshot->members);
+}
+
 std::vector<PVRChannelGroupMember> CPVRChannelGroup::GetMembers(Include eFilter /* = Include::ALL */) const
 {
-  CSingleLock lock(m_critSection);
+  const std::shared_ptr<const MembersSnapshot> snapshot = GetMembersSnapshot();
   if (eFilter == Include::ALL)
-    return m_sortedMembers;
+    return snapshot->members;
 
   std::vector<PVRChannelGroupMember> members;
-  for (const auto& member : m_sortedMembers)
+  for (const auto& member : snapshot->members)
   {
     switch (eFilter)
     {
@@ -451,7 +476,7 @@ std::vector<PVRChannelGroupMember> CPVRChannelGroup::GetMembers(Include eFilter
 void CPVRChannelGroup::GetChannelNumbers(std::vector<std::string>& channelNumbers) const
 {
   CSingleLock lock(m_critSection);
-  for (const auto& member : m_sortedMembers)
+  for (const auto& member : GetMembersSnapshot()->members)
   {
     CPVRChannelNumber activeChannelNumber = m_bUsingBackendChannelNumbers ? member.clientChannelNumber : member.channelNumber;
     channelNumbers.emplace_back(activeChannelNumber.FormattedChannelNumber());
@@ -562,6 +587,7 @@ std::vector<std::shared_ptr<CPVRChannel>> CPVRChannelGroup::RemoveDeletedChannel
       m_members.erase(channel->StorageId());
       it = m_sortedMembers.erase(it);
       m_bChanged = true;
+      InvalidateMembersSnapshot();
     }
     else
     {
@@ -620,6 +646,7 @@ bool CPVRChannelGroup::RemoveFromGroup(const std::shared_ptr<CPVRChannel>& chann
       //! @todo notify observers
       m_members.erase((*it).channel->StorageId());
       it = m_sortedMembers.erase(it);
+      InvalidateMembersSnapshot();
       bReturn = true;
       m_bChanged = true;
       break;
@@ -660,6 +687,7 @@ bool CPVRChannelGroup::AddToGroup(const std::shared_ptr<CPVRChannel>& channel, c
       newMember.iOrder = iOrder;
       m_sortedMembers.push_back(newMember);
       m_members.insert(std::make_pair(realChannel.channel->StorageId(), newMember));
+      InvalidateMembersSnapshot();
       m_bChanged = true;
 
       SortAndRenumber();
@@ -775,6 +803,9 @@ bool CPVRChannelGroup::Renumber(void)
     }
   }
 
+  if (bReturn)
+    InvalidateMembersSnapshot();
+
   Sort();
 
   return bReturn;
@@ -839,6 +870,7 @@ void CPVRChannelGroup::OnSettingChanged(std::shared_ptr<const CSetting> setting)
     m_bUsingBackendChannelOrder = bUsingBackendChannelOrder;
     m_bUsingBackendChannelNumbers = bUsingBackendChannelNumbers;
     m_bStartGroupChannelNumbersFromOne = bStartGroupChannelNumbersFromOne;
+    InvalidateMembersSnapshot();
 
     /* check whether this channel group has to be renumbered */
     if (bChannelOrderChanged || bChannelNumbersChanged || bGroupChannelNumbersFromOneChanged)
@@ -875,7 +907,8 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVRChannelGroup::GetEPGAll(bool bI
   std::shared_ptr<CPVRChannel> channel;
   CSingleLock lock(m_critSection);
 
-  for (PVR_CHANNEL_GROUP_SORTED_MEMBERS::const_iterator it = m_sortedMembers.begin(); it != m_sortedMembers.end(); ++it)
+  const std::shared_ptr<const MembersSnapshot> snapshot = GetMembersSnapshot();
+  for (PVR_CHANNEL_GROUP_SORTED_MEMBERS::const_iterator it = snapshot->members.begin(); it != snapshot->members.end(); ++it)
   {
     channel = (*it).channel;
     if (!channel->IsHidden())
@@ -341,6 +341,13 @@ namespace PVR
      */
     std::vector<PVRChannelGroupMember> GetMembers(Include eFilter = Include::ALL) const;
 
+    /*!
+     * @brief Get the current members of this group without copying them. The list doesn't change
+     * once returned, changes of the group are applied to a new list.
+     * @return The group members, sorted by channel number.
+     */
+    std::shared_ptr<const PVR_CHANNEL_GROUP_SORTED_MEMBERS> GetSortedMembers() const;
+
     /*!
      * @brief Get the list of active channel numbers in a group.
      * @param channelNumbers The list to store the numbers in.
@@ -541,6 +548,11 @@ namespace PVR
      */
     bool UpdateClientPriorities();
 
+    /*!
+     * @brief Drop the members snapshot, to be called with the lock held after any change of m_sortedMembers.
+     */
+    void InvalidateMembersSnapshot();
+
     int              m_iGroupType = PVR_GROUP_TYPE_DEFAULT;                  /*!< The type of this group */
     int              m_iGroupId = INVALID_GROUP_ID; /*!< The ID of this group in the database */
     bool             m_bLoaded = false;                     /*!< True if this container is loaded, false otherwise */
@@ -553,7 +565,7 @@ namespace PVR
     int              m_iPosition = 0;                   /*!< the position of this group within the group list */
     PVR_CHANNEL_GROUP_SORTED_MEMBERS m_sortedMembers; /*!< members sorted by channel number */
     PVR_CHANNEL_GROUP_MEMBERS        m_members;       /*!< members with key clientid+uniqueid */
-    mutable CCriticalSection m_critSection;
+    mutable CCriticalSection m_critSection{"CPVRChannelGroup"};
     std::vector<int> m_failedClientsForChannels;
     std::vector<int> m_failedClientsForChannelGroupMembers;
     CEventSource<PVREvent> m_events;
@@ -561,9 +573,23 @@ namespace PVR
     bool m_bStartGroupChannelNumbersFromOne = false; /*!< true if we start group channel numbers from one when not using backend channel numbers, false otherwise */
 
   private:
+    struct MembersSnapshot
+    {
+      PVR_CHANNEL_GROUP_SORTED_MEMBERS members; /*!< members sorted by channel number */
+      std::map<CPVRChannelNumber, std::shared_ptr<CPVRChannel>> channels; /*!< first member per active channel number */
+      std::map<std::pair<int, int>, size_t> positions; /*!< index in members with key clientid+uniqueid */
+    };
+
+    /*!
+     * @brief Get the snapshot of the current members, created from m_sortedMembers if there is none.
+     * @return The snapshot.
+     */
+    std::shared_ptr<const MembersSnapshot> GetMembersSnapshot() const;
+
     CDateTime GetEPGDate(EpgDateType epgDateType) const;
 
     std::shared_ptr<CPVRChannelGroup> m_allChannelsGroup;
     CPVRChannelsPath m_path;
+    mutable std::shared_ptr<const MembersSnapshot> m_membersSnapshot;
   };
 }
@@ -97,6 +97,7 @@ std::shared_ptr<CPVRChannel> CPVRChannelGroupInternal::UpdateFromClient(const st
     channel->UpdatePath(GroupName());
     m_sortedMembers.push_back(newMember);
     m_members.insert(std::make_pair(channel->StorageId(), newMember));
+    InvalidateMembersSnapshot();
     m_bChanged = true;
 
     SortAndRenumber();
@@ -13,6 +13,7 @@
 #include "guilib/LocalizeStrings.h"
 #include "pvr/PVRManager.h"
 #include "pvr/epg/EpgChannelData.h"
+#include "pvr/epg/EpgContainer.h"
 #include "pvr/epg/EpgDatabase.h"
 #include "pvr/epg/EpgInfoTag.h"
 #include "settings/AdvancedSettings.h"
@@ -21,6 +22,7 @@
 #include "threads/SingleLock.h"
 #include "utils/log.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -72,6 +74,7 @@ void CPVREpg::Clear(void)
 {
   CSingleLock lock(m_critSection);
   m_tags.clear();
+  m_strChangesToken.clear(); // the next transfer has to be a full one
 }
 
 void CPVREpg::Cleanup(int iPastDays)
@@ -202,11 +205,24 @@ std::shared_ptr<CPVREpgInfoTag> CPVREpg::GetTagByBroadcastId(unsigned int iUniqu
 {
   if (iUniqueBroadcastId != EPG_TAG_INVALID_UID)
   {
-    CSingleLock lock(m_critSection);
-    for (const auto& infoTag : m_tags)
     {
-      if (infoTag.second->UniqueBroadcastID() == iUniqueBroadcastId)
-        return infoTag.second;
+      CSingleLock lock(m_critSection);
+      for (const auto& infoTag : m_tags)
+      {
+        if (infoTag.second->UniqueBroadcastID() == iUniqueBroadcastId)
+          return infoTag.second;
+      }
+    }
+
+    if (IsWindowed())
+    {
+      const std::shared_ptr<CPVREpgDatabase> database = GetDatabase();
+      if (database)
+      {
+        const std::shared_ptr<CPVREpgInfoTag> tag = database->GetByBroadcastId(*this, iUniqueBroadcastId);
+        if (tag)
+          return CompleteTag(tag);
+      }
     }
   }
   return std::shared_ptr<CPVREpgInfoTag>();
@@ -226,6 +242,20 @@ std::shared_ptr<CPVREpgInfoTag> CPVREpg::GetTagBetween(const CDateTime& beginTim
     }
   }
 
+  if (!tag && IsWindowed())
+  {
+    lock.Leave();
+    for (const auto& epgTag : GetTagsBetween(beginTime, endTime))
+    {
+      if (epgTag->StartAsUTC() >= beginTime && epgTag->EndAsUTC() <= endTime)
+      {
+        tag = epgTag;
+        break;
+      }
+    }
+    lock.Enter();
+  }
+
   if (!tag && bUpdateFromClient)
   {
     // not found locally; try to fetch from client
@@ -277,9 +307,16 @@ bool CPVREpg::Load(const std::shared_ptr<CPVREpgDatabase>& database)
     return bReturn;
   }
 
-  const std::vector<std::shared_ptr<CPVREpgInfoTag>> result = database->Get(*this);
+  const CDateTime now = CDateTime::GetUTCDateTime();
+  const bool bWindowed = IsWindowed();
+  const std::vector<std::shared_ptr<CPVREpgInfoTag>> result = bWindowed
+    ? database->Get(*this, now - GetWindow(), now + GetWindow())
+    : database->Get(*this);
 
   CSingleLock lock(m_critSection);
+  if (bWindowed)
+    m_windowCenter = now;
+
   if (result.empty())
   {
     CLog::LogFC(LOGDEBUG, LOGEPG, "No database entries found for table '%s'.", m_strName.c_str());
@@ -306,13 +343,104 @@ bool CPVREpg::Load(const std::shared_ptr<CPVREpgDatabase>& database)
   return bReturn;
 }
 
+bool CPVREpg::Refresh(const std::shared_ptr<CPVREpgDatabase>& database)
+{
+  if (!database)
+    return false;
+
+  CDateTime lastScan;
+  if (!database->GetLastEpgScanTime(EpgID(), &lastScan))
+    return true; // not updated yet
+
+  {
+    CSingleLock lock(m_critSection);
+    if (m_bLoaded && m_lastScanTime.IsValid() && lastScan <= m_lastScanTime)
+      return true;
+  }
+
+  const CDateTime now = CDateTime::GetUTCDateTime();
+  const bool bWindowed = IsWindowed();
+  const std::vector<std::shared_ptr<CPVREpgInfoTag>> result = bWindowed
+    ? database->Get(*this, now - GetWindow(), now + GetWindow())
+    : database->Get(*this);
+
+  CSingleLock lock(m_critSection);
+
+  // keep the tags that are still there, others hold on to them
+  std::map<CDateTime, std::shared_ptr<CPVREpgInfoTag>> tags;
+  for (const auto& entry : result)
+  {
+    const auto it = m_tags.find(entry->StartAsUTC());
+    if (it != m_tags.end())
+    {
+      it->second->Update(*entry);
+      tags.insert(*it);
+    }
+    else
+    {
+      entry->SetChannelData(m_channelData);
+      entry->SetEpgID(m_iEpgID);
+      tags.insert(std::make_pair(entry->StartAsUTC(), entry));
+    }
+  }
+  m_tags.swap(tags);
+
+  if (bWindowed)
+    m_windowCenter = now;
+  m_lastScanTime = lastScan;
+  m_bLoaded = true;
+
+  CLog::LogFC(LOGDEBUG, LOGEPG, "Reloaded table '%s' updated by another instance", m_strName.c_str());
+  m_events.Publish(PVREvent::Epg);
+  return true;
+}
+
 bool CPVREpg::UpdateEntries(const CPVREpg& epg, bool bStoreInDb /* = true */)
 {
+  // removed events that are only in the database, looked up before this table gets locked
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> storedTags;
+  if (bStoreInDb && !epg.m_removedBroadcastIds.empty() && IsWindowed())
+  {
+    const std::shared_ptr<CPVREpgDatabase> database = GetDatabase();
+    if (database)
+    {
+      for (unsigned int iBroadcastId : epg.m_removedBroadcastIds)
+      {
+        const std::shared_ptr<CPVREpgInfoTag> tag = database->GetByBroadcastId(*this, iBroadcastId);
+        if (tag)
+          storedTags.emplace_back(tag);
+      }
+    }
+  }
+
   CSingleLock lock(m_critSection);
   /* copy over tags */
   for (const auto& tag : epg.m_tags)
     UpdateEntry(tag.second, bStoreInDb);
 
+  /* drop the tags the client removed */
+  for (unsigned int iBroadcastId : epg.m_removedBroadcastIds)
+  {
+    const auto it = std::find_if(m_tags.cbegin(), m_tags.cend(),
+                                 [iBroadcastId](const std::pair<CDateTime, std::shared_ptr<CPVREpgInfoTag>>& tag)
+                                 {
+                                   return tag.second->UniqueBroadcastID() == iBroadcastId;
+                                 });
+    if (it == m_tags.cend())
+      continue;
+
+    if (bStoreInDb)
+      m_deletedTags.insert(std::make_pair(iBroadcastId, it->second));
+    m_changedTags.erase(iBroadcastId);
+    m_tags.erase(it);
+  }
+
+  for (const auto& tag : storedTags)
+  {
+    m_deletedTags.insert(std::make_pair(tag->UniqueBroadcastID(), tag));
+    m_changedTags.erase(tag->UniqueBroadcastID());
+  }
+
   FixOverlappingEvents(bStoreInDb);
 
   /* update the last scan time of this table */
@@ -332,6 +460,38 @@ bool CPVREpg::UpdateEntry(const EPG_TAG* data, int iClientId)
   return UpdateEntry(tag, CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_EPG_STOREEPGINDATABASE));
 }
 
+bool CPVREpg::UpdateEntries(const EPG_TAG* data, unsigned int iCount, int iClientId)
+{
+  if (!data && iCount > 0)
+    return false;
+
+  const bool bUpdateDatabase = CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_EPG_STOREEPGINDATABASE);
+
+  CSingleLock lock(m_critSection);
+  for (unsigned int i = 0; i < iCount; ++i)
+  {
+    const std::shared_ptr<CPVREpgInfoTag> tag = std::make_shared<CPVREpgInfoTag>(data[i], iClientId, m_channelData, m_iEpgID);
+    UpdateEntry(tag, bUpdateDatabase);
+  }
+
+  return true;
+}
+
+bool CPVREpg::UpdateEntry(const EPG_TAG* data, int iClientId, EPG_EVENT_STATE newState)
+{
+  if (!data)
+    return false;
+
+  if (newState == EPG_EVENT_DELETED)
+  {
+    CSingleLock lock(m_critSection);
+    m_removedBroadcastIds.emplace_back(data->iUniqueBroadcastId);
+    return true;
+  }
+
+  return UpdateEntry(data, iClientId);
+}
+
 bool CPVREpg::UpdateEntry(const std::shared_ptr<CPVREpgInfoTag>& tag, bool bUpdateDatabase)
 {
   std::shared_ptr<CPVREpgInfoTag> infoTag;
@@ -430,7 +590,10 @@ bool CPVREpg::Update(time_t start,
 
   /* clean up if needed */
   if (m_bLoaded)
+  {
     Cleanup(iPastDays);
+    MoveWindow(database);
+  }
 
   /* enforce advanced settings update interval override for channels with no EPG data */
   if (m_tags.empty() && !bUpdate && ChannelID() > 0)
@@ -464,6 +627,13 @@ bool CPVREpg::Update(time_t start,
 
 std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpg::GetTags() const
 {
+  if (IsWindowed())
+  {
+    const std::shared_ptr<CPVREpgDatabase> database = GetDatabase();
+    if (database)
+      return MergeTags(database->Get(*this), CDateTime(), CDateTime());
+  }
+
   std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
 
   CSingleLock lock(m_critSection);
@@ -473,6 +643,50 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpg::GetTags() const
   return tags;
 }
 
+std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpg::GetTagsBetween(const CDateTime& minEnd, const CDateTime& maxStart) const
+{
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> dbTags;
+  if (IsWindowed())
+  {
+    const std::shared_ptr<CPVREpgDatabase> database = GetDatabase();
+    if (database)
+      dbTags = database->Get(*this, minEnd, maxStart);
+  }
+
+  return MergeTags(dbTags, minEnd, maxStart);
+}
+
+std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpg::MergeTags(const std::vector<std::shared_ptr<CPVREpgInfoTag>>& dbTags,
+                                                                const CDateTime& minEnd,
+                                                                const CDateTime& maxStart) const
+{
+  std::map<CDateTime, std::shared_ptr<CPVREpgInfoTag>> merged;
+
+  CSingleLock lock(m_critSection);
+
+  // loaded tags may have changes that are not persisted yet, they win
+  for (const auto& tag : m_tags)
+  {
+    if ((!minEnd.IsValid() || tag.second->EndAsUTC() >= minEnd) &&
+        (!maxStart.IsValid() || tag.second->StartAsUTC() <= maxStart))
+      merged.insert(tag);
+  }
+
+  for (const auto& tag : dbTags)
+  {
+    if (merged.find(tag->StartAsUTC()) == merged.end() &&
+        m_deletedTags.find(tag->UniqueBroadcastID()) == m_deletedTags.end())
+      merged.insert(std::make_pair(tag->StartAsUTC(), CompleteTag(tag)));
+  }
+
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> tags;
+  tags.reserve(merged.size());
+  for (const auto& tag : merged)
+    tags.emplace_back(tag.second);
+
+  return tags;
+}
+
 bool CPVREpg::Persist(const std::shared_ptr<CPVREpgDatabase>& database)
 {
   if (!database)
@@ -521,15 +735,20 @@ bool CPVREpg::Persist(const std::shared_ptr<CPVREpgDatabase>& database)
   bool bRet = database->CommitInsertQueries();
 
   database->Unlock();
+
+  if (bRet)
+    Evict();
+
   return bRet;
 }
 
 CDateTime CPVREpg::GetFirstDate(void) const
 {
-  CDateTime first;
+  CDateTime first, last;
+  GetStoredDates(first, last);
 
   CSingleLock lock(m_critSection);
-  if (!m_tags.empty())
+  if (!m_tags.empty() && (!first.IsValid() || m_tags.begin()->second->StartAsUTC() < first))
     first = m_tags.begin()->second->StartAsUTC();
 
   return first;
@@ -537,15 +756,115 @@ CDateTime CPVREpg::GetFirstDate(void) const
 
 CDateTime CPVREpg::GetLastDate(void) const
 {
-  CDateTime last;
+  CDateTime first, last;
+  GetStoredDates(first, last);
 
   CSingleLock lock(m_critSection);
-  if (!m_tags.empty())
+  if (!m_tags.empty() && (!last.IsValid() || m_tags.rbegin()->second->StartAsUTC() > last))
     last = m_tags.rbegin()->second->StartAsUTC();
 
   return last;
 }
 
+void CPVREpg::GetStoredDates(CDateTime& first, CDateTime& last) const
+{
+  first.SetValid(false);
+  last.SetValid(false);
+
+  if (!IsWindowed())
+    return;
+
+  const std::shared_ptr<CPVREpgDatabase> database = GetDatabase();
+  if (!database || !database->GetStartTimeRange(*this, first, last))
+  {
+    first.SetValid(false);
+    last.SetValid(false);
+  }
+}
+
+bool CPVREpg::IsWindowed() const
+{
+  if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iEpgMemoryWindow <= 0 ||
+      !CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_EPG_STOREEPGINDATABASE))
+    return false;
+
+  CSingleLock lock(m_critSection);
+  return m_iEpgID > 0;
+}
+
+CDateTimeSpan CPVREpg::GetWindow()
+{
+  return CDateTimeSpan(0, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iEpgMemoryWindow, 0, 0);
+}
+
+std::shared_ptr<CPVREpgDatabase> CPVREpg::GetDatabase()
+{
+  return CServiceBroker::GetPVRManager().EpgContainer().GetEpgDatabase();
+}
+
+std::shared_ptr<CPVREpgInfoTag> CPVREpg::CompleteTag(const std::shared_ptr<CPVREpgInfoTag>& tag) const
+{
+  CSingleLock lock(m_critSection);
+  tag->SetChannelData(m_channelData);
+  tag->SetEpgID(m_iEpgID);
+  return tag;
+}
+
+void CPVREpg::MoveWindow(const std::shared_ptr<CPVREpgDatabase>& database)
+{
+  if (!database || !IsWindowed())
+    return;
+
+  const CDateTime now = CDateTime::GetUTCDateTime();
+  const CDateTimeSpan window = GetWindow();
+  {
+    // reloading is only worth it once a good part of the window passed
+    CSingleLock lock(m_critSection);
+    if (m_windowCenter.IsValid() &&
+        now - m_windowCenter < CDateTimeSpan(0, 0, 0, window.GetSecondsTotal() / 4))
+      return;
+  }
+
+  const std::vector<std::shared_ptr<CPVREpgInfoTag>> result = database->Get(*this, now - window, now + window);
+
+  CSingleLock lock(m_critSection);
+  for (const auto& tag : result)
+  {
+    if (m_tags.find(tag->StartAsUTC()) == m_tags.end() &&
+        m_deletedTags.find(tag->UniqueBroadcastID()) == m_deletedTags.end())
+      AddEntry(*tag);
+  }
+  m_windowCenter = now;
+
+  Evict();
+}
+
+void CPVREpg::Evict()
+{
+  if (!IsWindowed())
+    return;
+
+  const CDateTimeSpan window = GetWindow();
+
+  CSingleLock lock(m_critSection);
+  if (!m_windowCenter.IsValid())
+    return;
+
+  const CDateTime minEnd = m_windowCenter - window;
+  const CDateTime maxStart = m_windowCenter + window;
+  for (auto it = m_tags.begin(); it != m_tags.end();)
+  {
+    const std::shared_ptr<CPVREpgInfoTag>& tag = it->second;
+    // tags that are not persisted yet must stay
+    if ((tag->EndAsUTC() < minEnd || tag->StartAsUTC() > maxStart) &&
+        m_changedTags.find(tag->UniqueBroadcastID()) == m_changedTags.end() &&
+        it->first != m_nowActiveStart)
+      it = m_tags.erase(it);
+    else
+      ++it;
+  }
+}
+
 bool CPVREpg::FixOverlappingEvents(bool bUpdateDb /* = false */)
 {
   bool bReturn = true;
@@ -618,6 +937,13 @@ bool CPVREpg::UpdateFromScraper(time_t start, time_t end, bool bForceUpdate)
         // nothing to do. client will provide epg updates asynchronously
         return true;
       }
+      else if (client->GetClientCapabilities().SupportsEPGChanges())
+      {
+        CLog::LogFC(LOGDEBUG, LOGEPG, "Updating EPG for channel '%s' from client '%i' %s",
+                    m_channelData->ChannelName().c_str(), m_channelData->ClientId(),
+                    m_strChangesToken.empty() ? "completely" : "with the changes");
+        return (client->GetEPGChangesForChannel(m_channelData->UniqueClientChannelId(), this, start, end, m_strChangesToken) == PVR_ERROR_NO_ERROR);
+      }
       else
       {
         CLog::LogFC(LOGDEBUG, LOGEPG, "Updating EPG for channel '%s' from client '%i'",
@@ -692,9 +1018,18 @@ bool CPVREpg::LoadFromClients(time_t start, time_t end, bool bForceUpdate)
   bool bReturn = false;
 
   const std::shared_ptr<CPVREpg> tmpEpg = std::make_shared<CPVREpg>(m_iEpgID, m_strName, m_strScraperName, m_channelData);
+  {
+    CSingleLock lock(m_critSection);
+    tmpEpg->m_strChangesToken = m_strChangesToken;
+  }
+
   if (tmpEpg->UpdateFromScraper(start, end, bForceUpdate))
     bReturn = UpdateEntries(*tmpEpg, CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_EPG_STOREEPGINDATABASE));
 
+  // a failed transfer resets the token, the next one transfers everything again
+  CSingleLock lock(m_critSection);
+  m_strChangesToken = bReturn ? tmpEpg->m_strChangesToken : "";
+
   return bReturn;
 }
 
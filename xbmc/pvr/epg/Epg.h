@@ -54,12 +54,22 @@ namespace PVR
     virtual ~CPVREpg();
 
     /*!
-     * @brief Load all entries for this table from the given database.
+     * @brief Load all entries for this table from the given database. If advancedsettings
+     * limit the EPG memory window, only the entries around now are loaded, the others are
+     * read from the database when they are asked for.
      * @param database The database.
      * @return True if any entries were loaded, false otherwise.
      */
     bool Load(const std::shared_ptr<CPVREpgDatabase>& database);
 
+    /*!
+     * @brief Reload the entries of this table from the given database if another Kodi instance
+     * sharing the database updated them since they were loaded.
+     * @param database The database.
+     * @return True if the entries are up to date, false otherwise.
+     */
+    bool Refresh(const std::shared_ptr<CPVREpgDatabase>& database);
+
     /*!
      * @brief Get data for the channel associated with this EPG.
      * @return The data.
@@ -166,6 +176,24 @@ namespace PVR
      */
     bool UpdateEntry(const EPG_TAG* data, int iClientId);
 
+    /*!
+     * @brief Update a batch of entries in this EPG.
+     * @param data The tags to update.
+     * @param iCount The number of tags.
+     * @param iClientId The id of the pvr client these events belong to.
+     * @return True if they were updated successfully, false otherwise.
+     */
+    bool UpdateEntries(const EPG_TAG* data, unsigned int iCount, int iClientId);
+
+    /*!
+     * @brief Record a change of an entry transferred by a client, applied by UpdateEntries().
+     * @param data The tag that changed.
+     * @param iClientId The id of the pvr client this event belongs to.
+     * @param newState The change of the tag.
+     * @return True if it was recorded successfully, false otherwise.
+     */
+    bool UpdateEntry(const EPG_TAG* data, int iClientId, EPG_EVENT_STATE newState);
+
     /*!
      * @brief Update an entry in this EPG.
      * @param tag The tag to update.
@@ -201,6 +229,14 @@ namespace PVR
      */
     std::vector<std::shared_ptr<CPVREpgInfoTag>> GetTags() const;
 
+    /*!
+     * @brief Get the EPG tags that overlap the given time range.
+     * @param minEnd Only get tags ending at or after this time in UTC.
+     * @param maxStart Only get tags starting at or before this time in UTC.
+     * @return The tags.
+     */
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> GetTagsBetween(const CDateTime& minEnd, const CDateTime& maxStart) const;
+
     /*!
      * @brief Persist this table in the given database
      * @param database The database.
@@ -302,9 +338,58 @@ namespace PVR
      */
     void Cleanup(int iPastDays);
 
+    /*!
+     * @brief Whether only a window of the tags around now is kept in memory.
+     * @return True if tags outside the window are read from the database when needed.
+     */
+    bool IsWindowed() const;
+
+    /*!
+     * @brief The span before and after now whose tags are kept in memory.
+     */
+    static CDateTimeSpan GetWindow();
+
+    static std::shared_ptr<CPVREpgDatabase> GetDatabase();
+
+    /*!
+     * @brief Associate a tag read from the database with this table.
+     * @param tag The tag.
+     * @return The tag.
+     */
+    std::shared_ptr<CPVREpgInfoTag> CompleteTag(const std::shared_ptr<CPVREpgInfoTag>& tag) const;
+
+    /*!
+     * @brief Combine tags read from the database with the tags in memory.
+     * @param dbTags The tags read from the database.
+     * @param minEnd If valid, only tags in memory ending at or after this time are taken.
+     * @param maxStart If valid, only tags in memory starting at or before this time are taken.
+     * @return The tags sorted by start time.
+     */
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> MergeTags(const std::vector<std::shared_ptr<CPVREpgInfoTag>>& dbTags,
+                                                           const CDateTime& minEnd,
+                                                           const CDateTime& maxStart) const;
+
+    /*!
+     * @brief Get the first and the last start time of the tags in the database, if windowed.
+     */
+    void GetStoredDates(CDateTime& first, CDateTime& last) const;
+
+    /*!
+     * @brief Load the tags of the current window from the database, once the window moved far enough.
+     * @param database The database.
+     */
+    void MoveWindow(const std::shared_ptr<CPVREpgDatabase>& database);
+
+    /*!
+     * @brief Drop persisted tags outside of the window from memory.
+     */
+    void Evict();
+
     std::map<CDateTime, std::shared_ptr<CPVREpgInfoTag>> m_tags;
     std::map<int, std::shared_ptr<CPVREpgInfoTag>>       m_changedTags;
     std::map<int, std::shared_ptr<CPVREpgInfoTag>>       m_deletedTags;
+    std::vector<unsigned int>           m_removedBroadcastIds; /*!< the events a client removed, set while receiving changes */
+    std::string                         m_strChangesToken; /*!< the token of the client's last transfer of changes, empty if none */
     bool                                m_bChanged = false;        /*!< true if anything changed that needs to be persisted, false otherwise */
     bool                                m_bTagsChanged = false;    /*!< true when any tags are changed and not persisted, false otherwise */
     bool                                m_bLoaded = false;         /*!< true when the initial entries have been loaded */
@@ -314,6 +399,7 @@ namespace PVR
     std::string                         m_strScraperName;  /*!< the name of the scraper to use */
     mutable CDateTime                   m_nowActiveStart;  /*!< the start time of the tag that is currently active */
     CDateTime                           m_lastScanTime;    /*!< the last time the EPG has been updated */
+    CDateTime                           m_windowCenter;    /*!< the time the tags in memory were loaded around, if windowed */
     mutable CCriticalSection            m_critSection;     /*!< critical section for changes in this table */
     bool                                m_bUpdateLastScanTime = false;
 
@@ -20,9 +20,15 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
+#include "threads/IRunnable.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/StringUtils.h"
 #include "utils/log.h"
 
+#include <algorithm>
+#include <functional>
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -91,9 +97,45 @@ void CEpgTagStateChange::Deliver()
   epg->UpdateEntry(m_epgtag, m_state, epgContainer.UseDatabase());
 }
 
+class CEpgClientUpdate : public IRunnable
+{
+public:
+  CEpgClientUpdate(std::vector<std::shared_ptr<CPVREpg>> epgs,
+                   const std::function<bool(const std::shared_ptr<CPVREpg>&)>& update)
+  : m_epgs(std::move(epgs)), m_update(update) {}
+
+  // runs on each thread of the client, until all tables are done or the update got interrupted
+  void Run() override;
+
+private:
+  CCriticalSection m_critSection;
+  const std::vector<std::shared_ptr<CPVREpg>> m_epgs;
+  size_t m_next = 0;
+  const std::function<bool(const std::shared_ptr<CPVREpg>&)> m_update;
+};
+
+void CEpgClientUpdate::Run()
+{
+  while (true)
+  {
+    std::shared_ptr<CPVREpg> epg;
+    {
+      CSingleLock lock(m_critSection);
+      if (m_next >= m_epgs.size())
+        return;
+
+      epg = m_epgs[m_next++];
+    }
+
+    if (!m_update(epg))
+      return;
+  }
+}
+
 CPVREpgContainer::CPVREpgContainer(void) :
   CThread("EPGUpdater"),
   m_database(new CPVREpgDatabase),
+  m_strUpdaterId(StringUtils::CreateUUID()),
   m_settings({
     CSettings::SETTING_EPG_STOREEPGINDATABASE,
     CSettings::SETTING_EPG_EPGUPDATE,
@@ -104,10 +146,12 @@ CPVREpgContainer::CPVREpgContainer(void) :
 {
   m_bStop = true; // base class member
   m_updateEvent.Reset();
+  CMemoryPressureManager::GetInstance().Register(this, "epg", CMemoryPressureManager::PRIORITY_CACHE);
 }
 
 CPVREpgContainer::~CPVREpgContainer(void)
 {
+  CMemoryPressureManager::GetInstance().Unregister(this);
   Stop();
   Clear();
 }
@@ -576,6 +620,13 @@ bool CPVREpgContainer::RemoveOldEntries(void)
   return true;
 }
 
+void CPVREpgContainer::OnMemoryPressure(MemoryPressure level)
+{
+  // the tables are cleaned up on the update thread, they aren't locked against it
+  CSingleLock lock(m_critSection);
+  m_iLastEpgCleanup = 0;
+}
+
 bool CPVREpgContainer::DeleteEpg(const std::shared_ptr<CPVREpg>& epg, bool bDeleteFromDatabase /* = false */)
 {
   if (!epg || epg->EpgID() < 0)
@@ -607,6 +658,21 @@ bool CPVREpgContainer::UseDatabase() const
   return m_settings.GetBoolValue(CSettings::SETTING_EPG_STOREEPGINDATABASE);
 }
 
+bool CPVREpgContainer::IsEpgUpdater(const std::shared_ptr<CPVREpgDatabase>& database) const
+{
+  const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+  if (!database || advancedSettings->m_databaseEpg.type != "mysql")
+    return true;
+
+  // renewed with every update check, so another instance takes over a few checks after this one went away
+  const CDateTime expires = CDateTime::GetUTCDateTime() + CDateTimeSpan(0, 0, 0, 3 * advancedSettings->m_iEpgUpdateCheckInterval);
+  const bool bUpdater = database->AcquireUpdaterLease(m_strUpdaterId, expires);
+  if (!bUpdater)
+    CLog::LogFC(LOGDEBUG, LOGEPG, "Another instance updates the shared EPG database, reading its data");
+
+  return bUpdater;
+}
+
 bool CPVREpgContainer::InterruptUpdate(void) const
 {
   CSingleLock lock(m_critSection);
@@ -662,40 +728,87 @@ bool CPVREpgContainer::UpdateEPG(bool bOnlyPending /* = false */)
   if (bShowProgress && !bOnlyPending)
     progressHandler = new CPVRGUIProgressHandler(g_localizeStrings.Get(19004)); // Importing guide from clients
 
-  /* load or update all EPG tables */
+  /* load or update all EPG tables, the tables of each client in their own threads */
+  std::map<int, std::vector<std::shared_ptr<CPVREpg>>> clientEpgs;
+  size_t iTotal = 0;
+  {
+    CSingleLock lock(m_critSection);
+    for (const auto& epgEntry : m_epgIdToEpgMap)
+    {
+      if (!epgEntry.second)
+        continue;
+
+      const std::shared_ptr<CPVREpgChannelData> channelData = epgEntry.second->GetChannelData();
+      clientEpgs[channelData ? channelData->ClientId() : -1].emplace_back(epgEntry.second);
+      iTotal++;
+    }
+  }
+
+  CCriticalSection updateSection;
   unsigned int iCounter = 0;
   const std::shared_ptr<CPVREpgDatabase> database = UseDatabase() ? GetEpgDatabase() : nullptr;
-  for (const auto& epgEntry : m_epgIdToEpgMap)
+  const bool bUpdateFromClients = IsEpgUpdater(database);
+  const int iUpdateTime = m_settings.GetIntValue(CSettings::SETTING_EPG_EPGUPDATE) * 60;
+  const int iPastDays = m_settings.GetIntValue(CSettings::SETTING_EPG_PAST_DAYSTODISPLAY);
+
+  auto updateEpg = [&](const std::shared_ptr<CPVREpg>& epg)
   {
     if (InterruptUpdate())
     {
+      CSingleLock lock(updateSection);
       bInterrupted = true;
-      break;
+      return false;
     }
 
-    const std::shared_ptr<CPVREpg> epg = epgEntry.second;
-    if (!epg)
-      continue;
-
     if (bShowProgress && !bOnlyPending)
-      progressHandler->UpdateProgress(epg->Name(), ++iCounter, m_epgIdToEpgMap.size());
-
-    if ((!bOnlyPending || epg->UpdatePending()) &&
-        epg->Update(start,
-                    end,
-                    m_settings.GetIntValue(CSettings::SETTING_EPG_EPGUPDATE) * 60,
-                    m_settings.GetIntValue(CSettings::SETTING_EPG_PAST_DAYSTODISPLAY),
-                    database,
-                    bOnlyPending))
     {
+      CSingleLock lock(updateSection);
+      progressHandler->UpdateProgress(epg->Name(), ++iCounter, iTotal);
+    }
+
+    if (!bUpdateFromClients)
+    {
+      if (epg->Refresh(database))
+      {
+        CSingleLock lock(updateSection);
+        iUpdatedTables++;
+      }
+    }
+    else if ((!bOnlyPending || epg->UpdatePending()) &&
+             epg->Update(start, end, iUpdateTime, iPastDays, database, bOnlyPending))
+    {
+      // written while the other tables are still being transferred
+      if (database && epg->NeedsSave())
+        epg->Persist(database);
+
+      CSingleLock lock(updateSection);
       iUpdatedTables++;
     }
     else if (!epg->IsValid())
     {
+      CSingleLock lock(updateSection);
       invalidTables.push_back(epg);
     }
+    return true;
+  };
+
+  std::vector<std::unique_ptr<CEpgClientUpdate>> updates;
+  std::vector<std::unique_ptr<CThread>> threads;
+  for (auto& epgs : clientEpgs)
+  {
+    const size_t iThreads = std::min(epgs.second.size(), static_cast<size_t>(advancedSettings->m_iEpgClientUpdateThreads));
+    updates.emplace_back(new CEpgClientUpdate(std::move(epgs.second), updateEpg));
+    for (size_t i = 0; i < iThreads; i++)
+    {
+      threads.emplace_back(new CThread(updates.back().get(), "EPGUpdateWorker"));
+      threads.back()->Create();
+    }
   }
 
+  for (const auto& thread : threads)
+    thread->Join(XbmcThreads::EndTime::InfiniteValue);
+  threads.clear();
+
   if (bShowProgress && !bOnlyPending)
     progressHandler->DestroyProgress();
 
@@ -15,6 +15,7 @@
 #include "threads/Event.h"
 #include "threads/Thread.h"
 #include "utils/EventStream.h"
+#include "utils/MemoryPressure.h"
 
 #include <list>
 #include <map>
@@ -34,7 +35,7 @@ namespace PVR
 
   enum class PVREvent;
 
-  class CPVREpgContainer : private CThread
+  class CPVREpgContainer : private CThread, private IMemoryPressureHandler
   {
     friend class CPVREpgDatabase;
 
@@ -230,6 +231,11 @@ namespace PVR
      */
     bool RemoveOldEntries(void);
 
+    /*!
+     * @brief Let the update thread remove the old EPG entries with its next run.
+     */
+    void OnMemoryPressure(MemoryPressure level) override;
+
     /*!
      * @brief Load and update the EPG data.
      * @param bOnlyPending Only check and update EPG tables with pending manual updates
@@ -243,6 +249,14 @@ namespace PVR
      */
     bool InterruptUpdate(void) const;
 
+    /*!
+     * @brief Check whether this instance updates the EPG from the PVR clients. If the EPG database
+     * is shared with other Kodi instances, only one of them does, the others read its results.
+     * @param database The EPG database, nullptr if it isn't used.
+     * @return True if this instance updates the EPG, false otherwise.
+     */
+    bool IsEpgUpdater(const std::shared_ptr<CPVREpgDatabase>& database) const;
+
     /*!
      * @brief EPG update thread
      */
@@ -272,6 +286,7 @@ namespace PVR
     time_t m_iNextEpgUpdate = 0;               /*!< the time the EPG will be updated */
     time_t m_iNextEpgActiveTagCheck = 0;       /*!< the time the EPG will be checked for active tag updates */
     int m_iNextEpgId = 0;                      /*!< the next epg ID that will be given to a new table when the db isn't being used */
+    const std::string m_strUpdaterId;          /*!< identifies this instance among those sharing the EPG database */
 
     std::map<int, std::shared_ptr<CPVREpg>> m_epgIdToEpgMap; /*!< the EPGs in this container. maps epg ids to epgs */
     std::map<std::pair<int, int>, std::shared_ptr<CPVREpg>> m_channelUidToEpgMap; /*!< the EPGs in this container. maps channel uids to epgs */
@@ -103,6 +103,20 @@ void CPVREpgDatabase::CreateTables(void)
         "sLastScan varchar(20)"
       ")"
   );
+
+  CreateUpdaterTable();
+}
+
+void CPVREpgDatabase::CreateUpdaterTable()
+{
+  CLog::LogFC(LOGDEBUG, LOGEPG, "Creating table 'epgupdater'");
+  m_pDS->exec("CREATE TABLE epgupdater ("
+        "idUpdater integer primary key, "
+        "sOwner    varchar(64), "
+        "sExpires  varchar(20)"
+      ")"
+  );
+  m_pDS->exec("INSERT INTO epgupdater (idUpdater, sOwner, sExpires) VALUES (1, '', '')");
 }
 
 void CPVREpgDatabase::CreateAnalytics()
@@ -142,6 +156,11 @@ void CPVREpgDatabase::UpdateTables(int iVersion)
   {
     m_pDS->exec("ALTER TABLE epgtags ADD sSeriesLink varchar(255);");
   }
+
+  if (iVersion < 13)
+  {
+    CreateUpdaterTable();
+  }
 }
 
 bool CPVREpgDatabase::DeleteEpg(void)
@@ -231,60 +250,58 @@ std::vector<std::shared_ptr<CPVREpg>> CPVREpgDatabase::GetAll()
 
 std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::Get(const CPVREpg& epg)
 {
-  std::vector<std::shared_ptr<CPVREpgInfoTag>> result;
+  CSingleLock lock(m_critSection);
+  return GetEpgTags(PrepareSQL("SELECT * FROM epgtags WHERE idEpg = %u;", epg.EpgID()));
+}
 
+std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::Get(const CPVREpg& epg, const CDateTime& minEnd, const CDateTime& maxStart)
+{
+  time_t iMinEnd, iMaxStart;
+  minEnd.GetAsTime(iMinEnd);
+  maxStart.GetAsTime(iMaxStart);
+
+  CSingleLock lock(m_critSection);
+  return GetEpgTags(PrepareSQL("SELECT * FROM epgtags WHERE idEpg = %u AND iStartTime <= %u AND iEndTime >= %u;",
+                               epg.EpgID(), static_cast<unsigned int>(iMaxStart), static_cast<unsigned int>(iMinEnd)));
+}
+
+std::shared_ptr<CPVREpgInfoTag> CPVREpgDatabase::GetByBroadcastId(const CPVREpg& epg, unsigned int iUniqueBroadcastId)
+{
   CSingleLock lock(m_critSection);
-  std::string strQuery = PrepareSQL("SELECT * FROM epgtags WHERE idEpg = %u;", epg.EpgID());
+  const std::vector<std::shared_ptr<CPVREpgInfoTag>> result =
+    GetEpgTags(PrepareSQL("SELECT * FROM epgtags WHERE idEpg = %u AND iBroadcastUid = %u;", epg.EpgID(), iUniqueBroadcastId));
+  return result.empty() ? std::shared_ptr<CPVREpgInfoTag>() : result.front();
+}
+
+bool CPVREpgDatabase::GetStartTimeRange(const CPVREpg& epg, CDateTime& first, CDateTime& last)
+{
+  CSingleLock lock(m_critSection);
+  std::string strQuery = PrepareSQL("SELECT MIN(iStartTime), MAX(iStartTime) FROM epgtags WHERE idEpg = %u;", epg.EpgID());
+  if (!ResultQuery(strQuery))
+    return false;
+
+  bool bReturn = false;
+  if (!m_pDS->eof() && !m_pDS->fv(0).get_isNull())
+  {
+    first = CDateTime(static_cast<time_t>(m_pDS->fv(0).get_asInt()));
+    last = CDateTime(static_cast<time_t>(m_pDS->fv(1).get_asInt()));
+    bReturn = true;
+  }
+  m_pDS->close();
+  return bReturn;
+}
+
+std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::GetEpgTags(const std::string& strQuery)
+{
+  std::vector<std::shared_ptr<CPVREpgInfoTag>> result;
+
   if (ResultQuery(strQuery))
   {
     try
     {
       while (!m_pDS->eof())
       {
-        std::shared_ptr<CPVREpgInfoTag> newTag(new CPVREpgInfoTag());
-
-        time_t iStartTime, iEndTime, iFirstAired;
-        iStartTime = (time_t) m_pDS->fv("iStartTime").get_asInt();
-        CDateTime startTime(iStartTime);
-        newTag->m_startTime = startTime;
-
-        iEndTime = (time_t) m_pDS->fv("iEndTime").get_asInt();
-        CDateTime endTime(iEndTime);
-        newTag->m_endTime = endTime;
-
-        iFirstAired = (time_t) m_pDS->fv("iFirstAired").get_asInt();
-        CDateTime firstAired(iFirstAired);
-        newTag->m_firstAired = firstAired;
-
-        int iBroadcastUID = m_pDS->fv("iBroadcastUid").get_asInt();
-        // Compat: null value for broadcast uid changed from numerical -1 to 0 with PVR Addon API v4.0.0
-        newTag->m_iUniqueBroadcastID = iBroadcastUID == -1 ? EPG_TAG_INVALID_UID : iBroadcastUID;
-
-        newTag->m_iDatabaseID        = m_pDS->fv("idBroadcast").get_asInt();
-        newTag->m_strTitle           = m_pDS->fv("sTitle").get_asString().c_str();
-        newTag->m_strPlotOutline     = m_pDS->fv("sPlotOutline").get_asString().c_str();
-        newTag->m_strPlot            = m_pDS->fv("sPlot").get_asString().c_str();
-        newTag->m_strOriginalTitle   = m_pDS->fv("sOriginalTitle").get_asString().c_str();
-        newTag->m_cast               = newTag->Tokenize(m_pDS->fv("sCast").get_asString());
-        newTag->m_directors          = newTag->Tokenize(m_pDS->fv("sDirector").get_asString());
-        newTag->m_writers            = newTag->Tokenize(m_pDS->fv("sWriter").get_asString());
-        newTag->m_iYear              = m_pDS->fv("iYear").get_asInt();
-        newTag->m_strIMDBNumber      = m_pDS->fv("sIMDBNumber").get_asString().c_str();
-        newTag->m_iGenreType         = m_pDS->fv("iGenreType").get_asInt();
-        newTag->m_iGenreSubType      = m_pDS->fv("iGenreSubType").get_asInt();
-        newTag->m_genre              = newTag->Tokenize(m_pDS->fv("sGenre").get_asString());
-        newTag->m_iParentalRating    = m_pDS->fv("iParentalRating").get_asInt();
-        newTag->m_iStarRating        = m_pDS->fv("iStarRating").get_asInt();
-        newTag->m_iEpisodeNumber     = m_pDS->fv("iEpisodeId").get_asInt();
-        newTag->m_iEpisodePart       = m_pDS->fv("iEpisodePart").get_asInt();
-        newTag->m_strEpisodeName     = m_pDS->fv("sEpisodeName").get_asString().c_str();
-        newTag->m_iSeriesNumber      = m_pDS->fv("iSeriesId").get_asInt();
-        newTag->m_strIconPath        = m_pDS->fv("sIconPath").get_asString().c_str();
-        newTag->m_iFlags             = m_pDS->fv("iFlags").get_asInt();
-        newTag->m_strSeriesLink      = m_pDS->fv("sSeriesLink").get_asString().c_str();
-
-        result.emplace_back(newTag);
-
+        result.emplace_back(CreateEpgTag());
         m_pDS->next();
       }
       m_pDS->close();
@@ -297,6 +314,53 @@ std::vector<std::shared_ptr<CPVREpgInfoTag>> CPVREpgDatabase::Get(const CPVREpg&
   return result;
 }
 
+std::shared_ptr<CPVREpgInfoTag> CPVREpgDatabase::CreateEpgTag()
+{
+  std::shared_ptr<CPVREpgInfoTag> newTag(new CPVREpgInfoTag());
+
+  time_t iStartTime, iEndTime, iFirstAired;
+  iStartTime = (time_t) m_pDS->fv("iStartTime").get_asInt();
+  CDateTime startTime(iStartTime);
+  newTag->m_startTime = startTime;
+
+  iEndTime = (time_t) m_pDS->fv("iEndTime").get_asInt();
+  CDateTime endTime(iEndTime);
+  newTag->m_endTime = endTime;
+
+  iFirstAired = (time_t) m_pDS->fv("iFirstAired").get_asInt();
+  CDateTime firstAired(iFirstAired);
+  newTag->m_firstAired = firstAired;
+
+  int iBroadcastUID = m_pDS->fv("iBroadcastUid").get_asInt();
+  // Compat: null value for broadcast uid changed from numerical -1 to 0 with PVR Addon API v4.0.0
+  newTag->m_iUniqueBroadcastID = iBroadcastUID == -1 ? EPG_TAG_INVALID_UID : iBroadcastUID;
+
+  newTag->m_iDatabaseID        = m_pDS->fv("idBroadcast").get_asInt();
+  newTag->m_strTitle           = m_pDS->fv("sTitle").get_asString();
+  newTag->m_strPlotOutline     = m_pDS->fv("sPlotOutline").get_asString();
+  newTag->m_strPlot            = m_pDS->fv("sPlot").get_asString();
+  newTag->m_strOriginalTitle   = m_pDS->fv("sOriginalTitle").get_asString();
+  newTag->m_cast               = newTag->Tokenize(m_pDS->fv("sCast").get_asString());
+  newTag->m_directors          = newTag->Tokenize(m_pDS->fv("sDirector").get_asString());
+  newTag->m_writers            = newTag->Tokenize(m_pDS->fv("sWriter").get_asString());
+  newTag->m_iYear              = m_pDS->fv("iYear").get_asInt();
+  newTag->m_strIMDBNumber      = m_pDS->fv("sIMDBNumber").get_asString();
+  newTag->m_iGenreType         = m_pDS->fv("iGenreType").get_asInt();
+  newTag->m_iGenreSubType      = m_pDS->fv("iGenreSubType").get_asInt();
+  newTag->m_genre              = newTag->Tokenize(m_pDS->fv("sGenre").get_asString());
+  newTag->m_iParentalRating    = m_pDS->fv("iParentalRating").get_asInt();
+  newTag->m_iStarRating        = m_pDS->fv("iStarRating").get_asInt();
+  newTag->m_iEpisodeNumber     = m_pDS->fv("iEpisodeId").get_asInt();
+  newTag->m_iEpisodePart       = m_pDS->fv("iEpisodePart").get_asInt();
+  newTag->m_strEpisodeName     = m_pDS->fv("sEpisodeName").get_asString();
+  newTag->m_iSeriesNumber      = m_pDS->fv("iSeriesId").get_asInt();
+  newTag->m_strIconPath        = m_pDS->fv("sIconPath").get_asString();
+  newTag->m_iFlags             = m_pDS->fv("iFlags").get_asInt();
+  newTag->m_strSeriesLink      = m_pDS->fv("sSeriesLink").get_asString();
+
+  return newTag;
+}
+
 bool CPVREpgDatabase::GetLastEpgScanTime(int iEpgId, CDateTime* lastScan)
 {
   bool bReturn = false;
@@ -433,3 +497,18 @@ int CPVREpgDatabase::GetLastEPGId(void)
     return std::atoi(strValue.c_str());
   return 0;
 }
+
+bool CPVREpgDatabase::AcquireUpdaterLease(const std::string& strOwner, const CDateTime& expires)
+{
+  CSingleLock lock(m_critSection);
+
+  // a single statement, so of the instances asking at the same time only one gets it
+  const std::string strQuery = PrepareSQL("UPDATE epgupdater SET sOwner = '%s', sExpires = '%s' "
+                                          "WHERE idUpdater = 1 AND (sOwner = '%s' OR sExpires < '%s');",
+                                          strOwner.c_str(), expires.GetAsDBDateTime().c_str(),
+                                          strOwner.c_str(), CDateTime::GetUTCDateTime().GetAsDBDateTime().c_str());
+  if (!ExecuteQuery(strQuery))
+    return false;
+
+  return GetSingleValue("epgupdater", "sOwner", "idUpdater = 1") == strOwner;
+}
@@ -61,7 +61,7 @@ namespace PVR
      * @brief Get the minimal database version that is required to operate correctly.
      * @return The minimal database version.
      */
-    int GetSchemaVersion(void) const override { return 12; }
+    int GetSchemaVersion(void) const override { return 13; }
 
     /*!
      * @brief Get the default sqlite database filename.
@@ -112,6 +112,32 @@ namespace PVR
      */
     std::vector<std::shared_ptr<CPVREpgInfoTag>> Get(const CPVREpg& epg);
 
+    /*!
+     * @brief Get the EPG entries of a table that overlap the given time range.
+     * @param epg The EPG table to get the entries for.
+     * @param minEnd Only get entries ending at or after this time in UTC.
+     * @param maxStart Only get entries starting at or before this time in UTC.
+     * @return The entries.
+     */
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> Get(const CPVREpg& epg, const CDateTime& minEnd, const CDateTime& maxStart);
+
+    /*!
+     * @brief Get an EPG entry of a table by its unique broadcast id.
+     * @param epg The EPG table to get the entry for.
+     * @param iUniqueBroadcastId The uid to look up.
+     * @return The entry or NULL if it wasn't found.
+     */
+    std::shared_ptr<CPVREpgInfoTag> GetByBroadcastId(const CPVREpg& epg, unsigned int iUniqueBroadcastId);
+
+    /*!
+     * @brief Get the start times of the first and the last entry of a table.
+     * @param epg The EPG table.
+     * @param first The first start time in UTC.
+     * @param last The last start time in UTC.
+     * @return True if the table has entries, false otherwise.
+     */
+    bool GetStartTimeRange(const CPVREpg& epg, CDateTime& first, CDateTime& last);
+
     /*!
      * @brief Get the last stored EPG scan time.
      * @param iEpgId The table to update the time for. Use 0 for a global value.
@@ -150,6 +176,15 @@ namespace PVR
      */
     int GetLastEPGId(void);
 
+    /*!
+     * @brief Take or renew the right to update the EPG data in this database from the PVR clients.
+     * Of all Kodi instances sharing the database only one holds it at a time.
+     * @param strOwner The id of the instance asking.
+     * @param expires The time the right lapses, unless it gets renewed.
+     * @return True if the instance holds the right until expires, false if another one holds it.
+     */
+    bool AcquireUpdaterLease(const std::string& strOwner, const CDateTime& expires);
+
     //@}
 
   private:
@@ -163,6 +198,11 @@ namespace PVR
      */
     void CreateAnalytics() override;
 
+    /*!
+     * @brief Create the table holding which Kodi instance updates the EPG data.
+     */
+    void CreateUpdaterTable();
+
     /*!
      * @brief Update an old version of the database.
      * @param version The version to update the database from.
@@ -171,6 +211,19 @@ namespace PVR
 
     int GetMinSchemaVersion() const override { return 4; }
 
+    /*!
+     * @brief Get the EPG entries a query selects.
+     * @param strQuery The query, it must select all columns of epgtags.
+     * @return The entries.
+     */
+    std::vector<std::shared_ptr<CPVREpgInfoTag>> GetEpgTags(const std::string& strQuery);
+
+    /*!
+     * @brief Create an EPG entry from the current row of the dataset.
+     * @return The entry.
+     */
+    std::shared_ptr<CPVREpgInfoTag> CreateEpgTag();
+
     CCriticalSection m_critSection;
   };
 }
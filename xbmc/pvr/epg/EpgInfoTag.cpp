@@ -173,16 +173,16 @@ void CPVREpgInfoTag::Serialize(CVariant& value) const
   value["channeluid"] = m_channelData->UniqueClientChannelId();
   value["parentalrating"] = m_iParentalRating;
   value["rating"] = m_iStarRating;
-  value["title"] = m_strTitle;
-  value["plotoutline"] = m_strPlotOutline;
-  value["plot"] = m_strPlot;
-  value["originaltitle"] = m_strOriginalTitle;
+  value["title"] = m_strTitle.Get();
+  value["plotoutline"] = m_strPlotOutline.Get();
+  value["plot"] = m_strPlot.Get();
+  value["originaltitle"] = m_strOriginalTitle.Get();
   value["cast"] = DeTokenize(m_cast);
   value["director"] = DeTokenize(m_directors);
   value["writer"] = DeTokenize(m_writers);
   value["year"] = m_iYear;
-  value["imdbnumber"] = m_strIMDBNumber;
-  value["genre"] = m_genre;
+  value["imdbnumber"] = m_strIMDBNumber.Get();
+  value["genre"] = m_genre.Get();
   value["filenameandpath"] = m_strFileNameAndPath;
   value["starttime"] = m_startTime.IsValid() ? m_startTime.GetAsDBDateTime() : StringUtils::Empty;
   value["endtime"] = m_endTime.IsValid() ? m_endTime.GetAsDBDateTime() : StringUtils::Empty;
@@ -190,7 +190,7 @@ void CPVREpgInfoTag::Serialize(CVariant& value) const
   value["firstaired"] = m_firstAired.IsValid() ? m_firstAired.GetAsDBDate() : StringUtils::Empty;
   value["progress"] = Progress();
   value["progresspercentage"] = ProgressPercentage();
-  value["episodename"] = m_strEpisodeName;
+  value["episodename"] = m_strEpisodeName.Get();
   value["episodenum"] = m_iEpisodeNumber;
   value["episodepart"] = m_iEpisodePart;
   value["hastimer"] = false; // compat
@@ -200,7 +200,7 @@ void CPVREpgInfoTag::Serialize(CVariant& value) const
   value["isactive"] = IsActive();
   value["wasactive"] = WasActive();
   value["isseries"] = IsSeries();
-  value["serieslink"] = m_strSeriesLink;
+  value["serieslink"] = m_strSeriesLink.Get();
 }
 
 int CPVREpgInfoTag::ClientID() const
@@ -396,7 +396,7 @@ const std::string CPVREpgInfoTag::GetCastLabel() const
 {
   // Note: see CVideoInfoTag::GetCast for reference implementation.
   std::string strLabel;
-  for (const auto& castEntry : m_cast)
+  for (const auto& castEntry : m_cast.Get())
     strLabel += StringUtils::Format("%s\n", castEntry.c_str());
 
   return StringUtils::TrimRight(strLabel, "\n");
@@ -404,17 +404,17 @@ const std::string CPVREpgInfoTag::GetCastLabel() const
 
 const std::string CPVREpgInfoTag::GetDirectorsLabel() const
 {
-  return StringUtils::Join(m_directors, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
+  return StringUtils::Join(m_directors.Get(), CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
 }
 
 const std::string CPVREpgInfoTag::GetWritersLabel() const
 {
-  return StringUtils::Join(m_writers, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
+  return StringUtils::Join(m_writers.Get(), CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
 }
 
 const std::string CPVREpgInfoTag::GetGenresLabel() const
 {
-  return StringUtils::Join(m_genre, CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
+  return StringUtils::Join(m_genre.Get(), CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_videoItemSeparator);
 }
 
 int CPVREpgInfoTag::Year(void) const
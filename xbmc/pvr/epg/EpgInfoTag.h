@@ -12,6 +12,7 @@
 #include "threads/CriticalSection.h"
 #include "utils/ISerializable.h"
 #include "utils/ISortable.h"
+#include "utils/InternedString.h"
 
 #include <memory>
 #include <string>
@@ -320,6 +321,15 @@ namespace PVR
      */
     std::string EpisodeName() const;
 
+    /*!
+     * @brief Get the texts of this event as shared with all events having the same texts.
+     * @return The title, plot outline, plot or episode name.
+     */
+    CInternedString InternedTitle() const { return m_strTitle; }
+    CInternedString InternedPlotOutline() const { return m_strPlotOutline; }
+    CInternedString InternedPlot() const { return m_strPlot; }
+    CInternedString InternedEpisodeName() const { return m_strEpisodeName; }
+
     /*!
      * @brief Get the path to the icon for this event.
      * @return The path to the icon
@@ -437,24 +447,24 @@ namespace PVR
     int                      m_iEpisodeNumber = 0;  /*!< episode number */
     int                      m_iEpisodePart = 0;    /*!< episode part number */
     unsigned int m_iUniqueBroadcastID = 0;   /*!< unique broadcast ID */
-    std::string              m_strTitle;            /*!< title */
-    std::string              m_strPlotOutline;      /*!< plot outline */
-    std::string              m_strPlot;             /*!< plot */
-    std::string              m_strOriginalTitle;    /*!< original title */
-    std::vector<std::string> m_cast;                /*!< cast */
-    std::vector<std::string> m_directors;           /*!< director(s) */
-    std::vector<std::string> m_writers;             /*!< writer(s) */
+    CInternedString          m_strTitle;            /*!< title */
+    CInternedString          m_strPlotOutline;      /*!< plot outline */
+    CInternedString          m_strPlot;             /*!< plot */
+    CInternedString          m_strOriginalTitle;    /*!< original title */
+    CInternedStringList      m_cast;                /*!< cast */
+    CInternedStringList      m_directors;           /*!< director(s) */
+    CInternedStringList      m_writers;             /*!< writer(s) */
     int                      m_iYear = 0;           /*!< year */
-    std::string              m_strIMDBNumber;       /*!< imdb number */
-    std::vector<std::string> m_genre;               /*!< genre */
-    std::string              m_strEpisodeName;      /*!< episode name */
-    std::string              m_strIconPath;         /*!< the path to the icon */
+    CInternedString          m_strIMDBNumber;       /*!< imdb number */
+    CInternedStringList      m_genre;               /*!< genre */
+    CInternedString          m_strEpisodeName;      /*!< episode name */
+    CInternedString          m_strIconPath;         /*!< the path to the icon */
     std::string              m_strFileNameAndPath;  /*!< the filename and path */
     CDateTime                m_startTime;           /*!< event start time */
     CDateTime                m_endTime;             /*!< event end time */
     CDateTime                m_firstAired;          /*!< first airdate */
     unsigned int m_iFlags = 0; /*!< the flags applicable to this EPG entry */
-    std::string              m_strSeriesLink;       /*!< series link */
+    CInternedString          m_strSeriesLink;       /*!< series link */
 
     mutable CCriticalSection m_critSection;
     std::shared_ptr<CPVREpgChannelData> m_channelData;
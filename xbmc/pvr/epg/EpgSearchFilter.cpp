@@ -32,10 +32,13 @@ CPVREpgSearchFilter::CPVREpgSearchFilter(bool bRadio)
   Reset();
 }
 
+CPVREpgSearchFilter::~CPVREpgSearchFilter() = default;
+
 void CPVREpgSearchFilter::Reset()
 {
   m_strSearchTerm.clear();
   m_bIsCaseSensitive         = false;
+  ResetTextSearch();
   m_bSearchInDescription     = false;
   m_iGenreType               = EPG_SEARCH_UNSET;
   m_iGenreSubType            = EPG_SEARCH_UNSET;
@@ -106,6 +109,13 @@ void CPVREpgSearchFilter::SetSearchPhrase(const std::string& strSearchPhrase)
   m_strSearchTerm = "\"";
   m_strSearchTerm.append(strSearchPhrase);
   m_strSearchTerm.append("\"");
+  ResetTextSearch();
+}
+
+void CPVREpgSearchFilter::ResetTextSearch()
+{
+  m_textSearch.reset();
+  m_textMatches.clear();
 }
 
 bool CPVREpgSearchFilter::MatchSearchTerm(const std::shared_ptr<CPVREpgInfoTag>& tag) const
@@ -114,17 +124,30 @@ bool CPVREpgSearchFilter::MatchSearchTerm(const std::shared_ptr<CPVREpgInfoTag>&
 
   if (!m_strSearchTerm.empty())
   {
-    CTextSearch search(m_strSearchTerm, m_bIsCaseSensitive, SEARCH_DEFAULT_OR);
-    bReturn = !CServiceBroker::GetPVRManager().IsParentalLocked(tag);
+    bReturn = MatchText(tag->InternedTitle()) ||
+              MatchText(tag->InternedPlotOutline()) ||
+              (m_bSearchInDescription && MatchText(tag->InternedPlot()));
     if (bReturn)
-      bReturn = search.Search(tag->Title()) ||
-                search.Search(tag->PlotOutline()) ||
-                (m_bSearchInDescription && search.Search(tag->Plot()));
+      bReturn = !CServiceBroker::GetPVRManager().IsParentalLocked(tag);
   }
 
   return bReturn;
 }
 
+bool CPVREpgSearchFilter::MatchText(const CInternedString& text) const
+{
+  const auto it = m_textMatches.find(text);
+  if (it != m_textMatches.end())
+    return it->second;
+
+  if (!m_textSearch)
+    m_textSearch.reset(new CTextSearch(m_strSearchTerm, m_bIsCaseSensitive, SEARCH_DEFAULT_OR));
+
+  const bool bMatch = m_textSearch->Search(text);
+  m_textMatches.emplace(text, bMatch);
+  return bMatch;
+}
+
 bool CPVREpgSearchFilter::MatchBroadcastId(const std::shared_ptr<CPVREpgInfoTag>& tag) const
 {
   if (m_iUniqueBroadcastId != EPG_TAG_INVALID_UID)
@@ -135,17 +158,18 @@ bool CPVREpgSearchFilter::MatchBroadcastId(const std::shared_ptr<CPVREpgInfoTag>
 
 bool CPVREpgSearchFilter::FilterEntry(const std::shared_ptr<CPVREpgInfoTag>& tag) const
 {
+  // the checks of the tag's own data first, the ones looking up channels, timers and recordings last
   return (MatchGenre(tag) &&
       MatchBroadcastId(tag) &&
       MatchDuration(tag) &&
       MatchStartAndEndTimes(tag) &&
-      MatchSearchTerm(tag) &&
-      MatchTimers(tag) &&
-      MatchRecordings(tag)) &&
       MatchChannelType(tag) &&
+      MatchSearchTerm(tag) &&
       MatchChannelNumber(tag) &&
       MatchChannelGroup(tag) &&
-      MatchFreeToAir(tag);
+      MatchFreeToAir(tag) &&
+      MatchTimers(tag) &&
+      MatchRecordings(tag));
 }
 
 void CPVREpgSearchFilter::RemoveDuplicates(std::vector<std::shared_ptr<CPVREpgInfoTag>>& results)
@@ -10,11 +10,15 @@
 
 #include "XBDateTime.h"
 #include "pvr/channels/PVRChannelNumber.h"
+#include "utils/InternedString.h"
 
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
+class CTextSearch;
+
 namespace PVR
 {
   #define EPG_SEARCH_UNSET (-1)
@@ -33,6 +37,7 @@ namespace PVR
      * @param bRadio the type of channels to search - if true, 'radio'. 'tv', otherwise.
      */
     CPVREpgSearchFilter(bool bRadio);
+    ~CPVREpgSearchFilter();
 
     /*!
      * @brief Clear this filter.
@@ -59,11 +64,11 @@ namespace PVR
     bool IsRadio() const { return m_bIsRadio; }
 
     const std::string& GetSearchTerm() const { return m_strSearchTerm; }
-    void SetSearchTerm(const std::string& strSearchTerm) { m_strSearchTerm = strSearchTerm; }
+    void SetSearchTerm(const std::string& strSearchTerm) { m_strSearchTerm = strSearchTerm; ResetTextSearch(); }
     void SetSearchPhrase(const std::string& strSearchPhrase);
 
     bool IsCaseSensitive() const { return m_bIsCaseSensitive; }
-    void SetCaseSensitive(bool bIsCaseSensitive) { m_bIsCaseSensitive = bIsCaseSensitive; }
+    void SetCaseSensitive(bool bIsCaseSensitive) { m_bIsCaseSensitive = bIsCaseSensitive; ResetTextSearch(); }
 
     bool ShouldSearchInDescription() const { return m_bSearchInDescription; }
     void SetSearchInDescription(bool bSearchInDescription) {m_bSearchInDescription = bSearchInDescription; }
@@ -115,6 +120,8 @@ namespace PVR
     bool MatchDuration(const std::shared_ptr<CPVREpgInfoTag>& tag) const;
     bool MatchStartAndEndTimes(const std::shared_ptr<CPVREpgInfoTag>& tag) const;
     bool MatchSearchTerm(const std::shared_ptr<CPVREpgInfoTag>& tag) const;
+    bool MatchText(const CInternedString& text) const;
+    void ResetTextSearch();
     bool MatchChannelNumber(const std::shared_ptr<CPVREpgInfoTag>& tag) const;
     bool MatchChannelGroup(const std::shared_ptr<CPVREpgInfoTag>& tag) const;
     bool MatchBroadcastId(const std::shared_ptr<CPVREpgInfoTag>& tag) const;
@@ -143,5 +150,9 @@ namespace PVR
     bool          m_bIgnorePresentTimers;     /*!< True to ignore currently present timers (future recordings), false if not */
     bool          m_bIgnorePresentRecordings; /*!< True to ignore currently active recordings, false if not */
     unsigned int  m_iUniqueBroadcastId;       /*!< The broadcastid to search for */
+
+    /* the texts of a guide repeat a lot, each distinct text is searched once */
+    mutable std::unique_ptr<CTextSearch> m_textSearch;
+    mutable std::unordered_map<CInternedString, bool, CInternedString::IdentityHash> m_textMatches;
   };
 }
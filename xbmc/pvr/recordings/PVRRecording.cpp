@@ -363,8 +363,12 @@ void CPVRRecording::Update(const CPVRRecording& tag)
   m_iChannelUid       = tag.m_iChannelUid;
   m_bRadio            = tag.m_bRadio;
 
-  CVideoInfoTag::SetPlayCount(tag.GetLocalPlayCount());
-  CVideoInfoTag::SetResumePoint(tag.GetLocalResumePoint());
+  // keep what was read from the video database for clients that don't store it themselves
+  const std::shared_ptr<CPVRClient> client = CServiceBroker::GetPVRManager().GetClient(m_iClientId);
+  if (!m_bGotMetaData || (client && client->GetClientCapabilities().SupportsRecordingsPlayCount()))
+    CVideoInfoTag::SetPlayCount(tag.GetLocalPlayCount());
+  if (!m_bGotMetaData || (client && client->GetClientCapabilities().SupportsRecordingsLastPlayedPosition()))
+    CVideoInfoTag::SetResumePoint(tag.GetLocalResumePoint());
   SetDuration(tag.GetDuration());
 
   if (m_iGenreType == EPG_GENRE_USE_STRING || m_iGenreSubType == EPG_GENRE_USE_STRING)
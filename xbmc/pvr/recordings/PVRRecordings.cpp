@@ -15,16 +15,32 @@
 #include "pvr/recordings/PVRRecording.h"
 #include "pvr/recordings/PVRRecordingsPath.h"
 #include "threads/SingleLock.h"
+#include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/log.h"
 #include "video/VideoDatabase.h"
 
+#include <algorithm>
 #include <memory>
 #include <utility>
 #include <vector>
 
 using namespace PVR;
 
+namespace
+{
+
+std::string GetDirectoryKey(const std::string& strDirectory)
+{
+  std::string strKey = strDirectory;
+  StringUtils::TrimLeft(strKey, "/");
+  URIUtils::RemoveSlashAtEnd(strKey);
+  StringUtils::ToLower(strKey);
+  return strKey;
+}
+
+} // unnamed namespace
+
 CPVRRecordings::CPVRRecordings() = default;
 
 CPVRRecordings::~CPVRRecordings()
@@ -36,9 +52,70 @@ CPVRRecordings::~CPVRRecordings()
 void CPVRRecordings::UpdateFromClients(void)
 {
   CSingleLock lock(m_critSection);
-  Unload();
-  CServiceBroker::GetPVRManager().Clients()->GetRecordings(this, false);
-  CServiceBroker::GetPVRManager().Clients()->GetRecordings(this, true);
+
+  // existing recordings are updated in place, only new ones get their metadata from the database
+  std::vector<int> failedClients;
+  m_updatedRecordings.clear();
+  CServiceBroker::GetPVRManager().Clients()->GetRecordings(this, false, failedClients);
+  CServiceBroker::GetPVRManager().Clients()->GetRecordings(this, true, failedClients);
+
+  // keep the recordings of clients that failed to transfer them
+  for (auto it = m_recordings.begin(); it != m_recordings.end();)
+  {
+    if (m_updatedRecordings.find(it->first) == m_updatedRecordings.end() &&
+        std::find(failedClients.begin(), failedClients.end(), it->second->m_iClientId) == failedClients.end())
+    {
+      RemoveFromDirectories(it->second);
+      it = m_recordings.erase(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+  m_updatedRecordings.clear();
+
+  UpdateCounts();
+}
+
+void CPVRRecordings::UpdateCounts()
+{
+  m_bDeletedTVRecordings = false;
+  m_bDeletedRadioRecordings = false;
+  m_iTVRecordings = 0;
+  m_iRadioRecordings = 0;
+
+  for (const auto& recording : m_recordings)
+  {
+    if (recording.second->IsRadio())
+    {
+      ++m_iRadioRecordings;
+      m_bDeletedRadioRecordings |= recording.second->IsDeleted();
+    }
+    else
+    {
+      ++m_iTVRecordings;
+      m_bDeletedTVRecordings |= recording.second->IsDeleted();
+    }
+  }
+}
+
+void CPVRRecordings::AddToDirectories(const std::shared_ptr<CPVRRecording>& recording)
+{
+  m_directories.insert(std::make_pair(GetDirectoryKey(recording->m_strDirectory), recording));
+}
+
+void CPVRRecordings::RemoveFromDirectories(const std::shared_ptr<CPVRRecording>& recording)
+{
+  const auto range = m_directories.equal_range(GetDirectoryKey(recording->m_strDirectory));
+  for (auto it = range.first; it != range.second; ++it)
+  {
+    if (it->second == recording)
+    {
+      m_directories.erase(it);
+      break;
+    }
+  }
 }
 
 int CPVRRecordings::Load(void)
@@ -56,6 +133,7 @@ void CPVRRecordings::Unload()
   m_iTVRecordings = 0;
   m_iRadioRecordings = 0;
   m_recordings.clear();
+  m_directories.clear();
 }
 
 void CPVRRecordings::Update(void)
@@ -113,6 +191,21 @@ std::vector<std::shared_ptr<CPVRRecording>> CPVRRecordings::GetAll() const
   return recordings;
 }
 
+std::vector<std::shared_ptr<CPVRRecording>> CPVRRecordings::GetByDirectory(bool bRadio, bool bDeleted, const std::string& strDirectory) const
+{
+  std::vector<std::shared_ptr<CPVRRecording>> recordings;
+  const std::string strKey = GetDirectoryKey(strDirectory);
+
+  CSingleLock lock(m_critSection);
+  for (auto it = m_directories.lower_bound(strKey); it != m_directories.end() && StringUtils::StartsWith(it->first, strKey); ++it)
+  {
+    if (it->second->IsRadio() == bRadio && it->second->IsDeleted() == bDeleted)
+      recordings.emplace_back(it->second);
+  }
+
+  return recordings;
+}
+
 std::shared_ptr<CPVRRecording> CPVRRecordings::GetById(unsigned int iId) const
 {
   CSingleLock lock(m_critSection);
@@ -165,18 +258,21 @@ void CPVRRecordings::UpdateFromClient(const std::shared_ptr<CPVRRecording>& tag)
 {
   CSingleLock lock(m_critSection);
 
-  if (tag->IsDeleted())
-  {
-    if (tag->IsRadio())
-      m_bDeletedRadioRecordings = true;
-    else
-      m_bDeletedTVRecordings = true;
-  }
+  m_updatedRecordings.insert(CPVRRecordingUid(tag->m_iClientId, tag->m_strRecordingId));
 
   std::shared_ptr<CPVRRecording> newTag = GetById(tag->m_iClientId, tag->m_strRecordingId);
   if (newTag)
   {
-    newTag->Update(*tag);
+    if (newTag->m_strDirectory != tag->m_strDirectory)
+    {
+      RemoveFromDirectories(newTag);
+      newTag->Update(*tag);
+      AddToDirectories(newTag);
+    }
+    else
+    {
+      newTag->Update(*tag);
+    }
   }
   else
   {
@@ -185,10 +281,7 @@ void CPVRRecordings::UpdateFromClient(const std::shared_ptr<CPVRRecording>& tag)
     newTag->UpdateMetadata(GetVideoDatabase());
     newTag->m_iRecordingId = ++m_iLastId;
     m_recordings.insert(std::make_pair(CPVRRecordingUid(newTag->m_iClientId, newTag->m_strRecordingId), newTag));
-    if (newTag->IsRadio())
-      ++m_iRadioRecordings;
-    else
-      ++m_iTVRecordings;
+    AddToDirectories(newTag);
   }
 }
 
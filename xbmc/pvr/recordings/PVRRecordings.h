@@ -12,6 +12,7 @@
 
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -74,6 +75,15 @@ namespace PVR
      */
     std::vector<std::shared_ptr<CPVRRecording>> GetAll() const;
 
+    /*!
+     * @brief Get the recordings in a directory and in all directories below it.
+     * @param bRadio Whether to get radio or TV recordings.
+     * @param bDeleted Whether to get deleted or active recordings.
+     * @param strDirectory The directory. Directory names are compared case-insensitively.
+     * @return The recordings.
+     */
+    std::vector<std::shared_ptr<CPVRRecording>> GetByDirectory(bool bRadio, bool bDeleted, const std::string& strDirectory) const;
+
     std::shared_ptr<CPVRRecording> GetByPath(const std::string& path) const;
     std::shared_ptr<CPVRRecording> GetById(int iClientId, const std::string& strRecordingId) const;
     std::shared_ptr<CPVRRecording> GetById(unsigned int iId) const;
@@ -89,6 +99,8 @@ namespace PVR
     mutable CCriticalSection m_critSection;
     bool m_bIsUpdating = false;
     std::map<CPVRRecordingUid, std::shared_ptr<CPVRRecording>> m_recordings;
+    std::multimap<std::string, std::shared_ptr<CPVRRecording>> m_directories; /*!< recordings by lower case directory without leading and trailing slashes */
+    std::set<CPVRRecordingUid> m_updatedRecordings; /*!< recordings transferred by the clients during the current update */
     unsigned int m_iLastId = 0;
     std::unique_ptr<CVideoDatabase> m_database;
     bool m_bDeletedTVRecordings = false;
@@ -98,6 +110,14 @@ namespace PVR
 
     void UpdateFromClients(void);
 
+    /*!
+     * @brief Recount the recordings after they changed.
+     */
+    void UpdateCounts();
+
+    void AddToDirectories(const std::shared_ptr<CPVRRecording>& recording);
+    void RemoveFromDirectories(const std::shared_ptr<CPVRRecording>& recording);
+
     /*!
      * @brief Get/Open the video database.
      * @return A reference to the video database.
@@ -177,25 +177,33 @@ bool CPVRTimerRuleMatcher::MatchSearchText(const std::shared_ptr<CPVREpgInfoTag>
   if (m_timerRule->GetTimerType()->SupportsEpgFulltextMatch() &&
       m_timerRule->m_bFullTextEpgSearch)
   {
-    if (!m_textSearch)
-    {
-      m_textSearch.reset(new CRegExp(true /* case insensitive */));
-      m_textSearch->RegComp(m_timerRule->m_strEpgSearchString);
-    }
-    return m_textSearch->RegFind(epgTag->Title()) >= 0 ||
-           m_textSearch->RegFind(epgTag->EpisodeName()) >= 0 ||
-           m_textSearch->RegFind(epgTag->PlotOutline()) >= 0 ||
-           m_textSearch->RegFind(epgTag->Plot()) >= 0;
+    return MatchText(epgTag->InternedTitle()) ||
+           MatchText(epgTag->InternedEpisodeName()) ||
+           MatchText(epgTag->InternedPlotOutline()) ||
+           MatchText(epgTag->InternedPlot());
   }
   else if (m_timerRule->GetTimerType()->SupportsEpgTitleMatch())
   {
-    if (!m_textSearch)
-    {
-      m_textSearch.reset(new CRegExp(true /* case insensitive */));
-      m_textSearch->RegComp(m_timerRule->m_strEpgSearchString);
-    }
-    return m_textSearch->RegFind(epgTag->Title()) >= 0;
+    return MatchText(epgTag->InternedTitle());
   }
   else
     return true;
 }
+
+bool CPVRTimerRuleMatcher::MatchText(const CInternedString& text) const
+{
+  // the same titles and plots come up for many tags, each is matched once
+  const auto it = m_textMatches.find(text);
+  if (it != m_textMatches.end())
+    return it->second;
+
+  if (!m_textSearch)
+  {
+    m_textSearch.reset(new CRegExp(true /* case insensitive */));
+    m_textSearch->RegComp(m_timerRule->m_strEpgSearchString);
+  }
+
+  const bool bMatch = m_textSearch->RegFind(text) >= 0;
+  m_textMatches.emplace(text, bMatch);
+  return bMatch;
+}
@@ -9,8 +9,10 @@
 #pragma once
 
 #include "XBDateTime.h"
+#include "utils/InternedString.h"
 
 #include <memory>
+#include <unordered_map>
 
 class CRegExp;
 
@@ -39,9 +41,11 @@ namespace PVR
     bool MatchEnd(const std::shared_ptr<CPVREpgInfoTag>& epgTag) const;
     bool MatchDayOfWeek(const std::shared_ptr<CPVREpgInfoTag>& epgTag) const;
     bool MatchSearchText(const std::shared_ptr<CPVREpgInfoTag>& epgTag) const;
+    bool MatchText(const CInternedString& text) const;
 
     const std::shared_ptr<CPVRTimerInfoTag> m_timerRule;
     CDateTime m_start;
     mutable std::unique_ptr<CRegExp> m_textSearch;
+    mutable std::unordered_map<CInternedString, bool, CInternedString::IdentityHash> m_textMatches;
   };
 }
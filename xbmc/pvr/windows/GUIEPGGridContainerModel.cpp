@@ -148,7 +148,6 @@ void CGUIEPGGridContainerModel::Initialize(const std::unique_ptr<CFileItemList>&
 
   ////////////////////////////////////////////////////////////////////////
   // Create epg grid
-  const CDateTimeSpan blockDuration(0, 0, MINSPERBLOCK, 0);
   const CDateTimeSpan gridDuration(m_gridEnd - m_gridStart);
   m_blocks = (gridDuration.GetDays() * 24 * 60 + gridDuration.GetHours() * 60 + gridDuration.GetMinutes()) / MINSPERBLOCK;
   if (m_blocks >= MAXBLOCKS)
@@ -156,106 +155,119 @@ void CGUIEPGGridContainerModel::Initialize(const std::unique_ptr<CFileItemList>&
   else if (m_blocks < iBlocksPerPage)
     m_blocks = iBlocksPerPage;
 
-  m_gridIndex.reserve(m_channelItems.size());
-  const std::vector<GridItem> blocks(m_blocks);
+  // the rows of the grid are created when they are first accessed, see GetGridRow()
+  m_fBlockSize = fBlockSize;
+  m_gridIndex.resize(m_channelItems.size());
+}
 
-  for (size_t channel = 0; channel < m_channelItems.size(); ++channel)
-  {
-    m_gridIndex.emplace_back(blocks);
+std::vector<GridItem>& CGUIEPGGridContainerModel::GetGridRow(int iChannel) const
+{
+  // only the rows of channels that get shown are ever created, a guide of
+  // thousands of channels would otherwise allocate and fill every row of it up front
+  std::vector<GridItem>& row = m_gridIndex[iChannel];
+  if (row.empty() && m_blocks > 0)
+    CreateGridRow(iChannel, row);
 
-    CDateTime gridCursor(m_gridStart); //reset cursor for new channel
-    unsigned long progIdx = m_epgItemsPtr[channel].start;
-    unsigned long lastIdx = m_epgItemsPtr[channel].stop;
-    int iEpgId            = m_programmeItems[progIdx]->GetEPGInfoTag()->EpgID();
-    int itemSize          = 1; // size of the programme in blocks
-    int savedBlock        = 0;
-    CFileItemPtr item;
-    std::shared_ptr<CPVREpgInfoTag> tag;
+  return row;
+}
 
-    for (int block = 0; block < m_blocks; ++block)
-    {
-      while (progIdx <= lastIdx)
-      {
-        item = m_programmeItems[progIdx];
-        tag = item->GetEPGInfoTag();
+void CGUIEPGGridContainerModel::CreateGridRow(int channel, std::vector<GridItem>& row) const
+{
+  row.resize(m_blocks);
 
-        // Note: Start block of an event is start-time-based calculated block + 1,
-        //       unless start times matches exactly the begin of a block.
+  const CDateTimeSpan blockDuration(0, 0, MINSPERBLOCK, 0);
+  CDateTime gridCursor(m_gridStart);
+  unsigned long progIdx = m_epgItemsPtr[channel].start;
+  unsigned long lastIdx = m_epgItemsPtr[channel].stop;
+  int iEpgId            = m_programmeItems[progIdx]->GetEPGInfoTag()->EpgID();
+  int itemSize          = 1; // size of the programme in blocks
+  int savedBlock        = 0;
+  CFileItemPtr item;
+  std::shared_ptr<CPVREpgInfoTag> tag;
+
+  for (int block = 0; block < m_blocks; ++block)
+  {
+    while (progIdx <= lastIdx)
+    {
+      item = m_programmeItems[progIdx];
+      tag = item->GetEPGInfoTag();
 
-        if (tag->EpgID() != iEpgId || gridCursor < tag->StartAsUTC() || m_gridEnd <= tag->StartAsUTC())
-          break;
+      // Note: Start block of an event is start-time-based calculated block + 1,
+      //       unless start times matches exactly the begin of a block.
 
-        if (gridCursor < tag->EndAsUTC())
-        {
-          m_gridIndex[channel][block].item = item;
-          m_gridIndex[channel][block].progIndex = progIdx;
-          break;
-        }
+      if (tag->EpgID() != iEpgId || gridCursor < tag->StartAsUTC() || m_gridEnd <= tag->StartAsUTC())
+        break;
 
-        progIdx++;
+      if (gridCursor < tag->EndAsUTC())
+      {
+        row[block].item = item;
+        row[block].progIndex = progIdx;
+        break;
       }
 
-      gridCursor += blockDuration;
+      progIdx++;
+    }
 
-      if (block == 0)
-        continue;
+    gridCursor += blockDuration;
 
-      const CFileItemPtr prevItem(m_gridIndex[channel][block - 1].item);
-      const CFileItemPtr currItem(m_gridIndex[channel][block].item);
+    if (block == 0)
+      continue;
+
+    const CFileItemPtr prevItem(row[block - 1].item);
+    const CFileItemPtr currItem(row[block].item);
+
+    if (block == m_blocks - 1 || prevItem != currItem)
+    {
+      // special handling for last block.
+      int blockDelta = -1;
+      int sizeDelta = 0;
+      if (block == m_blocks - 1 && prevItem == currItem)
+      {
+        itemSize++;
+        blockDelta = 0;
+        sizeDelta = 1;
+      }
 
-      if (block == m_blocks - 1 || prevItem != currItem)
+      if (prevItem)
       {
-        // special handling for last block.
-        int blockDelta = -1;
-        int sizeDelta = 0;
-        if (block == m_blocks - 1 && prevItem == currItem)
+        row[savedBlock].item->SetProperty("GenreType", prevItem->GetEPGInfoTag()->GenreType());
+      }
+      else
+      {
+        const std::shared_ptr<CFileItem> gapItem = CreateGapItem(channel);
+        for (int i = block + blockDelta; i >= block - itemSize + sizeDelta; --i)
         {
-          itemSize++;
-          blockDelta = 0;
-          sizeDelta = 1;
+          row[i].item = gapItem;
         }
+      }
 
-        if (prevItem)
+      float fItemWidth = itemSize * m_fBlockSize;
+      row[savedBlock].originWidth = fItemWidth;
+      row[savedBlock].width = fItemWidth;
+
+      itemSize = 1;
+      savedBlock = block;
+
+      // special handling for last block.
+      if (block == m_blocks - 1 && prevItem != currItem)
+      {
+        if (currItem)
         {
-          m_gridIndex[channel][savedBlock].item->SetProperty("GenreType", prevItem->GetEPGInfoTag()->GenreType());
+          row[savedBlock].item->SetProperty("GenreType", currItem->GetEPGInfoTag()->GenreType());
         }
         else
         {
-          const std::shared_ptr<CFileItem> gapItem = CreateGapItem(channel);
-          for (int i = block + blockDelta; i >= block - itemSize + sizeDelta; --i)
-          {
-            m_gridIndex[channel][i].item = gapItem;
-          }
+          row[block].item = CreateGapItem(channel);
         }
 
-        float fItemWidth = itemSize * fBlockSize;
-        m_gridIndex[channel][savedBlock].originWidth = fItemWidth;
-        m_gridIndex[channel][savedBlock].width = fItemWidth;
-
-        itemSize = 1;
-        savedBlock = block;
-
-        // special handling for last block.
-        if (block == m_blocks - 1 && prevItem != currItem)
-        {
-          if (currItem)
-          {
-            m_gridIndex[channel][savedBlock].item->SetProperty("GenreType", currItem->GetEPGInfoTag()->GenreType());
-          }
-          else
-          {
-            m_gridIndex[channel][block].item = CreateGapItem(channel);
-          }
-
-          m_gridIndex[channel][savedBlock].originWidth = fBlockSize; // size always 1 block here
-          m_gridIndex[channel][savedBlock].width = fBlockSize;
-        }
-      }
-      else
-      {
-        itemSize++;
+        row[savedBlock].originWidth = m_fBlockSize; // size always 1 block here
+        row[savedBlock].width = m_fBlockSize;
       }
     }
+    else
+    {
+      itemSize++;
+    }
   }
 }
 
@@ -341,6 +353,9 @@ void CGUIEPGGridContainerModel::FreeChannelMemory(int keepStart, int keepEnd)
 
 void CGUIEPGGridContainerModel::FreeProgrammeMemory(int channel, int keepStart, int keepEnd)
 {
+  if (m_gridIndex[channel].empty())
+    return; // never shown
+
   if (keepStart < keepEnd)
   {
     // remove before keepStart and after keepEnd
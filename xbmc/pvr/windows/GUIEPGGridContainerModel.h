@@ -60,12 +60,12 @@ namespace PVR
 
     int GetBlockCount() const { return m_blocks; }
     bool HasGridItems() const { return !m_gridIndex.empty(); }
-    GridItem* GetGridItemPtr(int iChannel, int iBlock) { return& m_gridIndex[iChannel][iBlock]; }
-    std::shared_ptr<CFileItem> GetGridItem(int iChannel, int iBlock) const { return m_gridIndex[iChannel][iBlock].item; }
-    float GetGridItemWidth(int iChannel, int iBlock) const { return m_gridIndex[iChannel][iBlock].width; }
-    float GetGridItemOriginWidth(int iChannel, int iBlock) const { return m_gridIndex[iChannel][iBlock].originWidth; }
-    int GetGridItemIndex(int iChannel, int iBlock) const { return m_gridIndex[iChannel][iBlock].progIndex; }
-    void SetGridItemWidth(int iChannel, int iBlock, float fWidth) { m_gridIndex[iChannel][iBlock].width = fWidth; }
+    GridItem* GetGridItemPtr(int iChannel, int iBlock) { return& GetGridRow(iChannel)[iBlock]; }
+    std::shared_ptr<CFileItem> GetGridItem(int iChannel, int iBlock) const { return GetGridRow(iChannel)[iBlock].item; }
+    float GetGridItemWidth(int iChannel, int iBlock) const { return GetGridRow(iChannel)[iBlock].width; }
+    float GetGridItemOriginWidth(int iChannel, int iBlock) const { return GetGridRow(iChannel)[iBlock].originWidth; }
+    int GetGridItemIndex(int iChannel, int iBlock) const { return GetGridRow(iChannel)[iBlock].progIndex; }
+    void SetGridItemWidth(int iChannel, int iBlock, float fWidth) { GetGridRow(iChannel)[iBlock].width = fWidth; }
 
     bool IsZeroGridDuration() const { return (m_gridEnd - m_gridStart) == CDateTimeSpan(0, 0, 0, 0); }
     const CDateTime& GetGridStart() const { return m_gridStart; }
@@ -83,6 +83,8 @@ namespace PVR
   private:
     void FreeItemsMemory();
     std::shared_ptr<CFileItem> CreateGapItem(int iChannel) const;
+    std::vector<GridItem>& GetGridRow(int iChannel) const;
+    void CreateGridRow(int channel, std::vector<GridItem>& row) const;
 
     struct ItemsPtr
     {
@@ -97,8 +99,9 @@ namespace PVR
     std::vector<std::shared_ptr<CFileItem>> m_channelItems;
     std::vector<std::shared_ptr<CFileItem>> m_rulerItems;
     std::vector<ItemsPtr> m_epgItemsPtr;
-    std::vector<std::vector<GridItem> > m_gridIndex;
+    mutable std::vector<std::vector<GridItem> > m_gridIndex; // rows are created on first access, on the GUI thread
 
     int m_blocks = 0;
+    float m_fBlockSize = 0.0f;
   };
 }
@@ -12,6 +12,7 @@
 #include "guilib/GUIFontManager.h"
 #include "guilib/GUIImage.h"
 #include "guilib/GUILabelControl.h"
+#include "guilib/TextureFormats.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
 
@@ -41,6 +42,11 @@ bool CRenderSystemBase::SupportsNPOT(bool dxt) const
   return true;
 }
 
+bool CRenderSystemBase::SupportsTextureFormat(unsigned int format) const
+{
+  return (format & XB_FMT_COMPRESSED_MASK) == 0;
+}
+
 bool CRenderSystemBase::SupportsStereo(RENDER_STEREO_MODE mode) const
 {
   switch(mode)
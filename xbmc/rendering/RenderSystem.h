@@ -71,6 +71,11 @@ public:
   const std::string& GetRenderRenderer() const { return m_RenderRenderer; }
   const std::string& GetRenderVersionString() const { return m_RenderVersion; }
   virtual bool SupportsNPOT(bool dxt) const;
+  /*!
+   \brief Whether textures of a format can be uploaded as they are
+   \param format one of the XB_FMT_* formats, the compressed ones depend on the hardware
+   */
+  virtual bool SupportsTextureFormat(unsigned int format) const;
   virtual bool SupportsStereo(RENDER_STEREO_MODE mode) const;
   unsigned int GetMaxTextureSize() const { return m_maxTextureSize; }
   unsigned int GetMinDXTPitch() const { return m_minDXTPitch; }
@@ -24,6 +24,7 @@
 #include "guilib/D3DResource.h"
 #include "guilib/GUIShaderDX.h"
 #include "guilib/GUITextureD3D.h"
+#include "guilib/TextureFormats.h"
 #include "guilib/GUIWindowManager.h"
 #include "threads/SingleLock.h"
 #include "utils/MathUtils.h"
@@ -690,6 +691,22 @@ void CRenderSystemDX::CheckDeviceCaps()
     m_maxTextureSize = D3D11_REQ_TEXTURE2D_U_OR_V_DIMENSION >> 1;
 }
 
+bool CRenderSystemDX::SupportsTextureFormat(unsigned int format) const
+{
+  switch (format & XB_FMT_MASK)
+  {
+  case XB_FMT_DXT1:
+  case XB_FMT_DXT3:
+  case XB_FMT_DXT5:
+  case XB_FMT_DXT5_YCoCg:
+    return true;
+  case XB_FMT_BC7:
+    return IsFormatSupport(DXGI_FORMAT_BC7_UNORM, D3D11_FORMAT_SUPPORT_TEXTURE2D);
+  default:
+    return CRenderSystemBase::SupportsTextureFormat(format);
+  }
+}
+
 bool CRenderSystemDX::SupportsNPOT(bool dxt) const
 {
   // MSDN says:
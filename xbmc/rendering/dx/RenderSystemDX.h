@@ -55,6 +55,7 @@ public:
   bool SupportsStereo(RENDER_STEREO_MODE mode) const override;
   void Project(float &x, float &y, float &z) override;
   bool SupportsNPOT(bool dxt) const override;
+  bool SupportsTextureFormat(unsigned int format) const override;
 
   // IDeviceNotify overrides
   void OnDXDeviceLost() override;
@@ -15,12 +15,12 @@
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
 
+#include <cstring>
+
 using namespace Shaders;
 
 CGLShader::CGLShader(const char *shader, std::string prefix)
 {
-  m_proj = nullptr;
-  m_model  = nullptr;
   m_clipPossible = false;
 
   VertexShader()->LoadSource("gl_shader_vert.glsl");
@@ -29,8 +29,6 @@ CGLShader::CGLShader(const char *shader, std::string prefix)
 
 CGLShader::CGLShader(const char *vshader, const char *fshader, std::string prefix)
 {
-  m_proj = nullptr;
-  m_model  = nullptr;
   m_clipPossible = false;
 
   VertexShader()->LoadSource(vshader, prefix);
@@ -63,6 +61,8 @@ void CGLShader::OnCompiledAndLinked()
   glUniform4f(m_hUniCol, 1.0, 1.0, 1.0, 1.0);
 
   glUseProgram(0);
+
+  m_matricesValid = false;
 }
 
 bool CGLShader::OnEnabled()
@@ -71,13 +71,34 @@ bool CGLShader::OnEnabled()
 
   const GLfloat *projMatrix = glMatrixProject.Get();
   const GLfloat *modelMatrix = glMatrixModview.Get();
-  glUniformMatrix4fv(m_hProj,  1, GL_FALSE, projMatrix);
-  glUniformMatrix4fv(m_hModel, 1, GL_FALSE, modelMatrix);
+
+  // uniforms are part of the program, so they only need to be uploaded
+  // when the matrices changed since the program was enabled last
+  bool changed = false;
+  if (!m_matricesValid || memcmp(m_proj, projMatrix, sizeof(m_proj)) != 0)
+  {
+    glUniformMatrix4fv(m_hProj,  1, GL_FALSE, projMatrix);
+    memcpy(m_proj, projMatrix, sizeof(m_proj));
+    changed = true;
+  }
+  if (!m_matricesValid || memcmp(m_model, modelMatrix, sizeof(m_model)) != 0)
+  {
+    glUniformMatrix4fv(m_hModel, 1, GL_FALSE, modelMatrix);
+    memcpy(m_model, modelMatrix, sizeof(m_model));
+    changed = true;
+  }
+  m_matricesValid = true;
 
   const TransformMatrix &guiMatrix = CServiceBroker::GetWinSystem()->GetGfxContext().GetGUIMatrix();
   CRect viewPort; // absolute positions of corners
   CServiceBroker::GetRenderSystem()->GetViewPort(viewPort);
 
+  // the clip factors only depend on the matrices and the viewport
+  if (!changed && guiMatrix == m_guiMatrix && viewPort == m_viewPort)
+    return true;
+  m_guiMatrix = guiMatrix;
+  m_viewPort = viewPort;
+
   /* glScissor operates in window coordinates. In order that we can use it to
    * perform clipping, we must ensure that there is an independent linear
    * transformation from the coordinate system used by CGraphicContext::ClipRect
@@ -9,6 +9,8 @@
 #pragma once
 
 #include "guilib/Shader.h"
+#include "utils/Geometry.h"
+#include "utils/TransformMatrix.h"
 
 #include <string>
 
@@ -44,8 +46,12 @@ protected:
   GLint m_hCord0 = 0;
   GLint m_hCord1 = 0;
 
-  const GLfloat *m_proj = nullptr;
-  const GLfloat *m_model = nullptr;
+  // the state last uploaded to the program
+  bool m_matricesValid = false;
+  GLfloat m_proj[16];
+  GLfloat m_model[16];
+  TransformMatrix m_guiMatrix;
+  CRect m_viewPort;
 
   bool m_clipPossible = false;
   GLfloat m_clipXFactor;
@@ -8,6 +8,8 @@
 
 #include "RenderSystemGL.h"
 #include "filesystem/File.h"
+#include "guilib/GUIFontTTFGL.h"
+#include "guilib/TextureFormats.h"
 #include "rendering/MatrixGL.h"
 #include "windowing/GraphicContext.h"
 #include "settings/AdvancedSettings.h"
@@ -115,6 +117,8 @@ bool CRenderSystemGL::ResetRenderSystem(int width, int height)
   if (!m_bRenderCreated)
     return false;
 
+  CGUIFontTTFGL::DiscardBatch();
+
   m_width = width;
   m_height = height;
 
@@ -191,6 +195,8 @@ bool CRenderSystemGL::ResetRenderSystem(int width, int height)
 
 bool CRenderSystemGL::DestroyRenderSystem()
 {
+  CGUIFontTTFGL::DiscardBatch();
+
   if (m_vertexArray != GL_NONE)
   {
     glDeleteVertexArrays(1, &m_vertexArray);
@@ -224,6 +230,8 @@ bool CRenderSystemGL::EndRender()
   if (!m_bRenderCreated)
     return false;
 
+  CGUIFontTTFGL::FlushBatch();
+
   return true;
 }
 
@@ -236,6 +244,8 @@ bool CRenderSystemGL::ClearBuffers(UTILS::Color color)
   if(m_stereoMode == RENDER_STEREO_MODE_INTERLACED && m_stereoView == RENDER_STEREO_VIEW_RIGHT)
     return true;
 
+  CGUIFontTTFGL::FlushBatch();
+
   float r = GET_R(color) / 255.0f;
   float g = GET_G(color) / 255.0f;
   float b = GET_B(color) / 255.0f;
@@ -277,6 +287,28 @@ bool CRenderSystemGL::SupportsNPOT(bool dxt) const
   return true;
 }
 
+bool CRenderSystemGL::SupportsTextureFormat(unsigned int format) const
+{
+  switch (format & XB_FMT_MASK)
+  {
+  case XB_FMT_DXT1:
+  case XB_FMT_DXT3:
+  case XB_FMT_DXT5:
+  case XB_FMT_DXT5_YCoCg:
+    return IsExtSupported("GL_EXT_texture_compression_s3tc");
+  case XB_FMT_BC7:
+    return IsExtSupported("GL_ARB_texture_compression_bptc") ||
+           m_RenderVersionMajor > 4 || (m_RenderVersionMajor == 4 && m_RenderVersionMinor >= 2);
+  case XB_FMT_ETC2_RGB8:
+  case XB_FMT_ETC2_RGBA8:
+    return IsExtSupported("GL_ARB_ES3_compatibility");
+  case XB_FMT_ASTC_4x4:
+    return IsExtSupported("GL_KHR_texture_compression_astc_ldr");
+  default:
+    return CRenderSystemBase::SupportsTextureFormat(format);
+  }
+}
+
 void CRenderSystemGL::PresentRender(bool rendered, bool videoLayer)
 {
   SetVSync(true);
@@ -284,6 +316,8 @@ void CRenderSystemGL::PresentRender(bool rendered, bool videoLayer)
   if (!m_bRenderCreated)
     return;
 
+  CGUIFontTTFGL::FlushBatch();
+
   PresentRenderImpl(rendered);
 
   if (!rendered)
@@ -314,6 +348,8 @@ void CRenderSystemGL::CaptureStateBlock()
   if (!m_bRenderCreated)
     return;
 
+  CGUIFontTTFGL::FlushBatch();
+
   glMatrixProject.Push();
   glMatrixModview.Push();
   glMatrixTexture.Push();
@@ -434,6 +470,8 @@ void CRenderSystemGL::SetViewPort(const CRect& viewPort)
   if (!m_bRenderCreated)
     return;
 
+  CGUIFontTTFGL::FlushBatch();
+
   glScissor((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
   glViewport((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
   m_viewPort[0] = viewPort.x1;
@@ -537,6 +575,8 @@ static const GLubyte stipple_3d[] = {
 
 void CRenderSystemGL::SetStereoMode(RENDER_STEREO_MODE mode, RENDER_STEREO_VIEW view)
 {
+  CGUIFontTTFGL::FlushBatch();
+
   CRenderSystemBase::SetStereoMode(mode, view);
 
   glColorMask(GL_TRUE, GL_TRUE, GL_TRUE, GL_TRUE);
@@ -673,6 +713,14 @@ void CRenderSystemGL::InitialiseShaders()
     m_pShader[SM_MULTI_BLENDCOLOR].reset();
     CLog::Log(LOGERROR, "GUI Shader gl_shader_frag_multi_blendcolor.glsl - compile and link failed");
   }
+
+  m_pShader[SM_TEXTURE_PALETTE].reset(new CGLShader("gl_shader_frag_palette.glsl", defines));
+  if (!m_pShader[SM_TEXTURE_PALETTE]->CompileAndLink())
+  {
+    m_pShader[SM_TEXTURE_PALETTE]->Free();
+    m_pShader[SM_TEXTURE_PALETTE].reset();
+    CLog::Log(LOGERROR, "GUI Shader gl_shader_frag_palette.glsl - compile and link failed");
+  }
 }
 
 void CRenderSystemGL::ReleaseShaders()
@@ -704,10 +752,18 @@ void CRenderSystemGL::ReleaseShaders()
   if (m_pShader[SM_MULTI_BLENDCOLOR])
     m_pShader[SM_MULTI_BLENDCOLOR]->Free();
   m_pShader[SM_MULTI_BLENDCOLOR].reset();
+
+  if (m_pShader[SM_TEXTURE_PALETTE])
+    m_pShader[SM_TEXTURE_PALETTE]->Free();
+  m_pShader[SM_TEXTURE_PALETTE].reset();
 }
 
 void CRenderSystemGL::EnableShader(ESHADERMETHOD method)
 {
+  // anything but text can't be drawn before the text queued so far
+  if (method != SM_FONTS)
+    CGUIFontTTFGL::FlushBatch();
+
   m_method = method;
   if (m_pShader[m_method])
   {
@@ -26,6 +26,7 @@ enum ESHADERMETHOD
   SM_FONTS,
   SM_TEXTURE_NOBLEND,
   SM_MULTI_BLENDCOLOR,
+  SM_TEXTURE_PALETTE,
   SM_MAX
 };
 
@@ -63,6 +64,7 @@ public:
   void SetStereoMode(RENDER_STEREO_MODE mode, RENDER_STEREO_VIEW view) override;
   bool SupportsStereo(RENDER_STEREO_MODE mode) const override;
   bool SupportsNPOT(bool dxt) const override;
+  bool SupportsTextureFormat(unsigned int format) const override;
 
   void Project(float &x, float &y, float &z) override;
 
@@ -76,6 +78,7 @@ public:
   // shaders
   void EnableShader(ESHADERMETHOD method);
   void DisableShader();
+  bool IsShaderValid(ESHADERMETHOD method) const { return m_pShader[method] != nullptr; }
   GLint ShaderGetPos();
   GLint ShaderGetCol();
   GLint ShaderGetCoord0();
@@ -14,12 +14,12 @@
 #include "utils/log.h"
 #include "windowing/GraphicContext.h"
 
+#include <cstring>
+
 using namespace Shaders;
 
 CGLESShader::CGLESShader( const char *shader, std::string prefix)
 {
-  m_proj = nullptr;
-  m_model = nullptr;
   m_clipPossible = false;
 
   VertexShader()->LoadSource("gles_shader.vert");
@@ -28,8 +28,6 @@ CGLESShader::CGLESShader( const char *shader, std::string prefix)
 
 CGLESShader::CGLESShader(const char *vshader, const char *fshader, std::string prefix)
 {
-  m_proj = nullptr;
-  m_model  = nullptr;
   m_clipPossible = false;
 
   VertexShader()->LoadSource(vshader, prefix);
@@ -75,6 +73,8 @@ void CGLESShader::OnCompiledAndLinked()
   glUniformMatrix4fv(m_hCoord0Matrix,  1, GL_FALSE, identity);
 
   glUseProgram( 0 );
+
+  m_matricesValid = false;
 }
 
 bool CGLESShader::OnEnabled()
@@ -83,13 +83,38 @@ bool CGLESShader::OnEnabled()
 
   const GLfloat *projMatrix = glMatrixProject.Get();
   const GLfloat *modelMatrix = glMatrixModview.Get();
-  glUniformMatrix4fv(m_hProj,  1, GL_FALSE, projMatrix);
-  glUniformMatrix4fv(m_hModel, 1, GL_FALSE, modelMatrix);
+
+  // uniforms are part of the program, so they only need to be uploaded
+  // when the matrices changed since the program was enabled last
+  bool changed = false;
+  if (!m_matricesValid || memcmp(m_proj, projMatrix, sizeof(m_proj)) != 0)
+  {
+    glUniformMatrix4fv(m_hProj,  1, GL_FALSE, projMatrix);
+    memcpy(m_proj, projMatrix, sizeof(m_proj));
+    changed = true;
+  }
+  if (!m_matricesValid || memcmp(m_model, modelMatrix, sizeof(m_model)) != 0)
+  {
+    glUniformMatrix4fv(m_hModel, 1, GL_FALSE, modelMatrix);
+    memcpy(m_model, modelMatrix, sizeof(m_model));
+    changed = true;
+  }
+  m_matricesValid = true;
+
+  // renderers may have changed these
+  glUniform1f(m_hBrightness, 0.0f);
+  glUniform1f(m_hContrast, 1.0f);
 
   const TransformMatrix &guiMatrix = CServiceBroker::GetWinSystem()->GetGfxContext().GetGUIMatrix();
   CRect viewPort; // absolute positions of corners
   CServiceBroker::GetRenderSystem()->GetViewPort(viewPort);
 
+  // the clip factors only depend on the matrices and the viewport
+  if (!changed && guiMatrix == m_guiMatrix && viewPort == m_viewPort)
+    return true;
+  m_guiMatrix = guiMatrix;
+  m_viewPort = viewPort;
+
   /* glScissor operates in window coordinates. In order that we can use it to
    * perform clipping, we must ensure that there is an independent linear
    * transformation from the coordinate system used by CGraphicContext::ClipRect
@@ -164,9 +189,6 @@ bool CGLESShader::OnEnabled()
     m_clipYOffset = m_clipYOffset * yMult + (viewPort.y2 + viewPort.y1) / 2;
   }
 
-  glUniform1f(m_hBrightness, 0.0f);
-  glUniform1f(m_hContrast, 1.0f);
-
   return true;
 }
 
@@ -9,6 +9,8 @@
 #pragma once
 
 #include "guilib/Shader.h"
+#include "utils/Geometry.h"
+#include "utils/TransformMatrix.h"
 
 #include <string>
 
@@ -54,8 +56,12 @@ protected:
   GLint m_hContrast = 0;
   GLint m_hBrightness = 0;
 
-  const GLfloat *m_proj;
-  const GLfloat *m_model;
+  // the state last uploaded to the program
+  bool m_matricesValid = false;
+  GLfloat m_proj[16];
+  GLfloat m_model[16];
+  TransformMatrix m_guiMatrix;
+  CRect m_viewPort;
 
   bool m_clipPossible;
   GLfloat m_clipXFactor;
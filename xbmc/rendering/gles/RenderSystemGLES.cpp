@@ -7,6 +7,8 @@
  */
 
 #include "guilib/DirtyRegion.h"
+#include "guilib/GUIFontTTFGL.h"
+#include "guilib/TextureFormats.h"
 #include "windowing/GraphicContext.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/SettingsComponent.h"
@@ -107,6 +109,8 @@ bool CRenderSystemGLES::InitRenderSystem()
 
 bool CRenderSystemGLES::ResetRenderSystem(int width, int height)
 {
+  CGUIFontTTFGL::DiscardBatch();
+
   m_width = width;
   m_height = height;
 
@@ -140,6 +144,8 @@ bool CRenderSystemGLES::ResetRenderSystem(int width, int height)
 
 bool CRenderSystemGLES::DestroyRenderSystem()
 {
+  CGUIFontTTFGL::DiscardBatch();
+
   ResetScissors();
   CDirtyRegionList dirtyRegions;
   CDirtyRegion dirtyWindow(CServiceBroker::GetWinSystem()->GetGfxContext().GetViewWindow());
@@ -178,6 +184,8 @@ bool CRenderSystemGLES::EndRender()
   if (!m_bRenderCreated)
     return false;
 
+  CGUIFontTTFGL::FlushBatch();
+
   return true;
 }
 
@@ -186,6 +194,8 @@ bool CRenderSystemGLES::ClearBuffers(UTILS::Color color)
   if (!m_bRenderCreated)
     return false;
 
+  CGUIFontTTFGL::FlushBatch();
+
   float r = GET_R(color) / 255.0f;
   float g = GET_G(color) / 255.0f;
   float b = GET_B(color) / 255.0f;
@@ -217,6 +227,28 @@ bool CRenderSystemGLES::IsExtSupported(const char* extension) const
   }
 }
 
+bool CRenderSystemGLES::SupportsTextureFormat(unsigned int format) const
+{
+  switch (format & XB_FMT_MASK)
+  {
+  case XB_FMT_ETC2_RGB8:
+  case XB_FMT_ETC2_RGBA8:
+    // part of GLES 3.0 core
+    return m_RenderVersionMajor >= 3;
+  case XB_FMT_ASTC_4x4:
+    return IsExtSupported("GL_KHR_texture_compression_astc_ldr");
+  case XB_FMT_DXT1:
+  case XB_FMT_DXT3:
+  case XB_FMT_DXT5:
+  case XB_FMT_DXT5_YCoCg:
+    return IsExtSupported("GL_EXT_texture_compression_s3tc");
+  case XB_FMT_BC7:
+    return IsExtSupported("GL_EXT_texture_compression_bptc");
+  default:
+    return CRenderSystemBase::SupportsTextureFormat(format);
+  }
+}
+
 void CRenderSystemGLES::PresentRender(bool rendered, bool videoLayer)
 {
   SetVSync(true);
@@ -224,6 +256,8 @@ void CRenderSystemGLES::PresentRender(bool rendered, bool videoLayer)
   if (!m_bRenderCreated)
     return;
 
+  CGUIFontTTFGL::FlushBatch();
+
   PresentRenderImpl(rendered);
 
   // if video is rendered to a separate layer, we should not block this thread
@@ -254,6 +288,8 @@ void CRenderSystemGLES::CaptureStateBlock()
   if (!m_bRenderCreated)
     return;
 
+  CGUIFontTTFGL::FlushBatch();
+
   glMatrixProject.Push();
   glMatrixModview.Push();
   glMatrixTexture.Push();
@@ -331,6 +367,8 @@ void CRenderSystemGLES::SetViewPort(const CRect& viewPort)
   if (!m_bRenderCreated)
     return;
 
+  CGUIFontTTFGL::FlushBatch();
+
   glScissor((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
   glViewport((GLint) viewPort.x1, (GLint) (m_height - viewPort.y1 - viewPort.Height()), (GLsizei) viewPort.Width(), (GLsizei) viewPort.Height());
   m_viewPort[0] = viewPort.x1;
@@ -434,6 +472,14 @@ void CRenderSystemGLES::InitialiseShaders()
     CLog::Log(LOGERROR, "GUI Shader gles_shader_multi_blendcolor.frag - compile and link failed");
   }
 
+  m_pShader[SM_TEXTURE_PALETTE].reset(new CGLESShader("gles_shader_palette.frag", defines));
+  if (!m_pShader[SM_TEXTURE_PALETTE]->CompileAndLink())
+  {
+    m_pShader[SM_TEXTURE_PALETTE]->Free();
+    m_pShader[SM_TEXTURE_PALETTE].reset();
+    CLog::Log(LOGERROR, "GUI Shader gles_shader_palette.frag - compile and link failed");
+  }
+
   m_pShader[SM_TEXTURE_RGBA].reset(new CGLESShader("gles_shader_rgba.frag", defines));
   if (!m_pShader[SM_TEXTURE_RGBA]->CompileAndLink())
   {
@@ -524,10 +570,18 @@ void CRenderSystemGLES::ReleaseShaders()
   if (m_pShader[SM_TEXTURE_RGBA_BOB_OES])
     m_pShader[SM_TEXTURE_RGBA_BOB_OES]->Free();
   m_pShader[SM_TEXTURE_RGBA_BOB_OES].reset();
+
+  if (m_pShader[SM_TEXTURE_PALETTE])
+    m_pShader[SM_TEXTURE_PALETTE]->Free();
+  m_pShader[SM_TEXTURE_PALETTE].reset();
 }
 
 void CRenderSystemGLES::EnableGUIShader(ESHADERMETHOD method)
 {
+  // anything but text can't be drawn before the text queued so far
+  if (method != SM_FONTS)
+    CGUIFontTTFGL::FlushBatch();
+
   m_method = method;
   if (m_pShader[m_method])
   {
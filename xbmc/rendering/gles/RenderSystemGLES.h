@@ -29,6 +29,7 @@ enum ESHADERMETHOD
   SM_TEXTURE_RGBA_BLENDCOLOR,
   SM_TEXTURE_RGBA_BOB,
   SM_TEXTURE_RGBA_BOB_OES,
+  SM_TEXTURE_PALETTE,
   SM_MAX
 };
 
@@ -65,6 +66,7 @@ public:
   void SetCameraPosition(const CPoint &camera, int screenWidth, int screenHeight, float stereoFactor = 0.0f) override;
 
   bool SupportsStereo(RENDER_STEREO_MODE mode) const override;
+  bool SupportsTextureFormat(unsigned int format) const override;
 
   void Project(float &x, float &y, float &z) override;
 
@@ -74,6 +76,7 @@ public:
   void ReleaseShaders();
   void EnableGUIShader(ESHADERMETHOD method);
   void DisableGUIShader();
+  bool IsGUIShaderValid(ESHADERMETHOD method) const { return m_pShader[method] != nullptr; }
 
   GLint GUIShaderGetPos();
   GLint GUIShaderGetCol();
@@ -16,6 +16,7 @@
 #include "AppParamParser.h"
 #include "Application.h"
 #include "ServiceBroker.h"
+#include "URL.h"
 #include "filesystem/File.h"
 #include "filesystem/SpecialProtocol.h"
 #include "guilib/LocalizeStrings.h"
@@ -28,6 +29,7 @@
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "settings/SettingUtils.h"
+#include "threads/ThreadPolicy.h"
 #include "utils/LangCodeExpander.h"
 #include "utils/log.h"
 #include "utils/StringUtils.h"
@@ -88,7 +90,10 @@ void CAdvancedSettings::OnSettingChanged(std::shared_ptr<const CSetting> setting
   if (settingId == CSettings::SETTING_DEBUG_SHOWLOGINFO)
     SetDebugMode(std::static_pointer_cast<const CSettingBool>(setting)->GetValue());
   else if (settingId == CSettings::SETTING_DEBUG_EXTRALOGGING)
+  {
     m_extraLogEnabled = std::static_pointer_cast<const CSettingBool>(setting)->GetValue();
+    CLog::SetExtraLogLevels(m_extraLogEnabled ? m_extraLogLevels : 0);
+  }
   else if (settingId == CSettings::SETTING_DEBUG_SETEXTRALOGLEVEL)
     SetExtraLogLevel(CSettingUtils::GetList(std::static_pointer_cast<const CSettingList>(setting)));
 }
@@ -132,6 +137,8 @@ void CAdvancedSettings::Initialize()
   //default hold time of 25 ms, this allows a 20 hertz sine to pass undistorted
   m_limiterHold = 0.025f;
   m_limiterRelease = 0.1f;
+  m_audioRealtime = false;
+  m_audioDecodeCacheSize = 0;
 
   m_seekSteps = { 10, 30, 60, 180, 300, 600, 1800 };
 
@@ -171,6 +178,13 @@ void CAdvancedSettings::Initialize()
   m_videoFpsDetect = 1;
   m_maxTempo = 1.55f;
   m_videoPreferStereoStream = false;
+  m_videoLockFreePacketQueue = false;
+  m_videoZeroCopyDemux = false;
+  m_videoDecoderThreads = 0;
+  m_videoSliceThreadedCodecs.clear();
+  m_videoLowLatencyLiveDecode = false;
+  m_videoApplyFilmGrain = true;
+  m_videoPreOpenNextSeconds = 0;
 
   m_mediacodecForceSoftwareRendering = false;
 
@@ -276,10 +290,19 @@ void CAdvancedSettings::Initialize()
   m_fanartRes = 1080;
   m_imageRes = 720;
   m_imageScalingAlgorithm = CPictureScalingAlgorithm::Default;
+  m_imageCompression = false;
+  m_imageCacheFormat = "jpg";
+  m_imageCacheQuality = 80;
+  m_imagePrecacheThreads = 4;
+  m_imagePrecacheHostConnections = 2;
 
   m_sambaclienttimeout = 30;
   m_sambadoscodepage = "";
   m_sambastatfiles = true;
+  m_sambaReadAheadSize = 4 * 1024 * 1024;
+  m_sambaShareReadAheadSize.clear();
+
+  m_nfsReadAheadDepth = 4;
 
   m_bHTTPDirectoryStatFilesize = false;
 
@@ -292,6 +315,7 @@ void CAdvancedSettings::Initialize()
 
   m_bMusicLibraryAllItemsOnBottom = false;
   m_bMusicLibraryCleanOnUpdate = false;
+  m_bMusicLibraryAnalyseLoudness = false;
   m_bMusicLibraryArtistSortOnUpdate = false;
   m_iMusicLibraryRecentlyAddedItems = 25;
   m_strMusicLibraryAlbumFormat = "";
@@ -300,15 +324,26 @@ void CAdvancedSettings::Initialize()
   m_musicArtistSeparators = { ";", " feat. ", " ft. " };
   m_videoItemSeparator = " / ";
   m_iMusicLibraryDateAdded = 1; // prefer mtime over ctime and current time
+  m_iMusicLibraryWriteBatchSize = 50;
+  m_iMusicLibraryWriteBatchTime = 2000;
+  m_iMusicLibraryTagLoaderThreads = 4;
+  m_iMusicLibraryTagPrefetchSize = 256;
 
   m_bVideoLibraryAllItemsOnBottom = false;
   m_iVideoLibraryRecentlyAddedItems = 25;
   m_bVideoLibraryCleanOnUpdate = false;
   m_bVideoLibraryUseFastHash = true;
+  // scraping runs while the batch is open, keep it short so other writers don't wait long
+  m_iVideoLibraryWriteBatchSize = 10;
+  m_iVideoLibraryWriteBatchTime = 2000;
+  m_bVideoLibraryUseNavSummary = true;
   m_bVideoLibraryExportAutoThumbs = false;
   m_bVideoLibraryImportWatchedState = false;
   m_bVideoLibraryImportResumePoint = false;
   m_bVideoScannerIgnoreErrors = false;
+  m_iVideoScannerScraperThreads = 3;
+  m_iVideoScannerScraperInterval = 0;
+  m_iVideoScannerProbeThreads = 2;
   m_iVideoLibraryDateAdded = 1; // prefer mtime over ctime and current time
 
   m_videoEpisodeExtraArt = {};
@@ -340,6 +375,11 @@ void CAdvancedSettings::Initialize()
                                                       channel without EPG data every 2 hours and trigger an EPG update
                                                       for every channel with EPG data every 1 hour. */
   m_bEpgDisplayUpdatePopup = true; /* Display a progress popup while updating EPG data from clients */
+  m_iEpgMemoryWindow = 0; /* Only keep the EPG entries of the past and the next X hours in memory, the others are read
+                             from the database when needed. 0 keeps all entries in memory. Only applies if EPG data
+                             is stored in the database. */
+  m_iEpgClientUpdateThreads = 1; /* Number of EPG tables fetched at a time from each PVR client. The clients are
+                                    updated in parallel. */
   m_bEpgDisplayIncrementalUpdatePopup = false; /* Display a progress popup while doing incremental EPG updates, but
                                                   only if 'displayupdatepopup' is also enabled. */
 
@@ -398,26 +438,43 @@ void CAdvancedSettings::Initialize()
   m_iPVRNumericChannelSwitchTimeout = 2000;
   m_iPVRTimeshiftThreshold = 10;
   m_bPVRTimeshiftSimpleOSD = true;
+  m_bPVRFastZap = false;
+  m_iPVRTimeshiftBufferSize = 0;
 
   m_cacheMemSize = 1024 * 1024 * 20;
   m_cacheBufferMode = CACHE_BUFFER_MODE_INTERNET; // Default (buffer all internet streams/filesystems)
   // the following setting determines the readRate of a player data
   // as multiply of the default data read rate
   m_cacheReadFactor = 4.0f;
+  m_cacheRetainSize = 0;
+  m_cacheSegmentSize = 2 * 1024 * 1024;
+  m_cacheSegmentConcurrency = 1;
+  m_cacheMemoryMapLocal = false;
 
   m_addonPackageFolderSize = 200;
 
   m_jsonOutputCompact = true;
   m_jsonTcpPort = 9090;
 
+  m_webServerThreadPoolSize = 0;
+  m_webServerMetrics = false;
+
   m_enableMultimediaKeys = false;
 
   m_canWindowed = true;
   m_guiVisualizeDirtyRegions = false;
   m_guiAlgorithmDirtyRegions = 3;
   m_guiSmartRedraw = false;
+  m_guiFontBatching = true;
+  m_guiTextureBatching = true;
+  m_guiFontPrewarmCharacters = 2048;
+  m_guiSkinCache = true;
+  m_guiArtPrefetchMemory = 64;
+  m_guiIdleFps = 0;
+  m_guiTextureMemory = 0;
   m_airTunesPort = 36666;
   m_airPlayPort = 36667;
+  m_airTunesLatencyMs = 500;
 
   m_databaseMusic.Reset();
   m_databaseVideo.Reset();
@@ -571,6 +628,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
 
     XMLUtils::GetFloat(pElement, "limiterhold", m_limiterHold, 0.0f, 100.0f);
     XMLUtils::GetFloat(pElement, "limiterrelease", m_limiterRelease, 0.001f, 100.0f);
+    XMLUtils::GetBoolean(pElement, "realtime", m_audioRealtime);
+    XMLUtils::GetInt(pElement, "decodecachesize", m_audioDecodeCacheSize, 0, 1024 * 1024);
   }
 
   pElement = pRootElement->FirstChildElement("x11");
@@ -729,6 +788,20 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pElement, "fpsdetect", m_videoFpsDetect, 0, 2);
     XMLUtils::GetFloat(pElement, "maxtempo", m_maxTempo, 1.5, 2.1);
     XMLUtils::GetBoolean(pElement, "preferstereostream", m_videoPreferStereoStream);
+    XMLUtils::GetBoolean(pElement, "lockfreepacketqueue", m_videoLockFreePacketQueue);
+    XMLUtils::GetBoolean(pElement, "zerocopydemux", m_videoZeroCopyDemux);
+    XMLUtils::GetUInt(pElement, "decoderthreads", m_videoDecoderThreads, 0, 64);
+    XMLUtils::GetBoolean(pElement, "lowlatencylivedecode", m_videoLowLatencyLiveDecode);
+    XMLUtils::GetBoolean(pElement, "applyfilmgrain", m_videoApplyFilmGrain);
+    XMLUtils::GetUInt(pElement, "preopennextseconds", m_videoPreOpenNextSeconds, 0, 600);
+
+    std::string sliceThreadedCodecs;
+    if (XMLUtils::GetString(pElement, "slicethreadedcodecs", sliceThreadedCodecs))
+    {
+      m_videoSliceThreadedCodecs = StringUtils::Split(sliceThreadedCodecs, ',');
+      for (auto& codec : m_videoSliceThreadedCodecs)
+        StringUtils::Trim(codec);
+    }
 
     // Store global display latency settings
     TiXmlElement* pVideoLatency = pElement->FirstChildElement("latency");
@@ -775,10 +848,15 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetBoolean(pElement, "prioritiseapetags", m_prioritiseAPEv2tags);
     XMLUtils::GetBoolean(pElement, "allitemsonbottom", m_bMusicLibraryAllItemsOnBottom);
     XMLUtils::GetBoolean(pElement, "cleanonupdate", m_bMusicLibraryCleanOnUpdate);
+    XMLUtils::GetBoolean(pElement, "analyseloudness", m_bMusicLibraryAnalyseLoudness);
     XMLUtils::GetBoolean(pElement, "artistsortonupdate", m_bMusicLibraryArtistSortOnUpdate);
     XMLUtils::GetString(pElement, "albumformat", m_strMusicLibraryAlbumFormat);
     XMLUtils::GetString(pElement, "itemseparator", m_musicItemSeparator);
     XMLUtils::GetInt(pElement, "dateadded", m_iMusicLibraryDateAdded);
+    XMLUtils::GetInt(pElement, "writebatchsize", m_iMusicLibraryWriteBatchSize, 0, 1000);
+    XMLUtils::GetInt(pElement, "writebatchtime", m_iMusicLibraryWriteBatchTime, 0, 60000);
+    XMLUtils::GetInt(pElement, "tagloaderthreads", m_iMusicLibraryTagLoaderThreads, 1, 16);
+    XMLUtils::GetInt(pElement, "tagprefetchsize", m_iMusicLibraryTagPrefetchSize, 0, 4096);
     //Music artist name separators
     TiXmlElement* separators = pElement->FirstChildElement("artistseparators");
     if (separators)
@@ -804,6 +882,9 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pElement, "recentlyaddeditems", m_iVideoLibraryRecentlyAddedItems, 1, INT_MAX);
     XMLUtils::GetBoolean(pElement, "cleanonupdate", m_bVideoLibraryCleanOnUpdate);
     XMLUtils::GetBoolean(pElement, "usefasthash", m_bVideoLibraryUseFastHash);
+    XMLUtils::GetInt(pElement, "writebatchsize", m_iVideoLibraryWriteBatchSize, 0, 1000);
+    XMLUtils::GetInt(pElement, "writebatchtime", m_iVideoLibraryWriteBatchTime, 0, 60000);
+    XMLUtils::GetBoolean(pElement, "usenavsummary", m_bVideoLibraryUseNavSummary);
     XMLUtils::GetString(pElement, "itemseparator", m_videoItemSeparator);
     XMLUtils::GetBoolean(pElement, "exportautothumbs", m_bVideoLibraryExportAutoThumbs);
     XMLUtils::GetBoolean(pElement, "importwatchedstate", m_bVideoLibraryImportWatchedState);
@@ -822,6 +903,9 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
   if (pElement)
   {
     XMLUtils::GetBoolean(pElement, "ignoreerrors", m_bVideoScannerIgnoreErrors);
+    XMLUtils::GetInt(pElement, "scraperthreads", m_iVideoScannerScraperThreads, 1, 16);
+    XMLUtils::GetInt(pElement, "scraperinterval", m_iVideoScannerScraperInterval, 0, 60000);
+    XMLUtils::GetInt(pElement, "probethreads", m_iVideoScannerProbeThreads, 1, 8);
   }
 
   // Backward-compatibility of ExternalPlayer config
@@ -853,6 +937,10 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetUInt(pElement, "memorysize", m_cacheMemSize);
     XMLUtils::GetUInt(pElement, "buffermode", m_cacheBufferMode, 0, 4);
     XMLUtils::GetFloat(pElement, "readfactor", m_cacheReadFactor);
+    XMLUtils::GetUInt(pElement, "retainsize", m_cacheRetainSize);
+    XMLUtils::GetUInt(pElement, "segmentsize", m_cacheSegmentSize, 64 * 1024, 64 * 1024 * 1024);
+    XMLUtils::GetUInt(pElement, "segmentconcurrency", m_cacheSegmentConcurrency, 1, 16);
+    XMLUtils::GetBoolean(pElement, "mmaplocal", m_cacheMemoryMapLocal);
   }
 
   pElement = pRootElement->FirstChildElement("jsonrpc");
@@ -862,14 +950,42 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetUInt(pElement, "tcpport", m_jsonTcpPort);
   }
 
+  pElement = pRootElement->FirstChildElement("webserver");
+  if (pElement)
+  {
+    XMLUtils::GetUInt(pElement, "threadpoolsize", m_webServerThreadPoolSize, 0, 64);
+    XMLUtils::GetBoolean(pElement, "metrics", m_webServerMetrics);
+  }
+
   pElement = pRootElement->FirstChildElement("samba");
   if (pElement)
   {
     XMLUtils::GetString(pElement,  "doscodepage",   m_sambadoscodepage);
     XMLUtils::GetInt(pElement, "clienttimeout", m_sambaclienttimeout, 5, 100);
     XMLUtils::GetBoolean(pElement, "statfiles", m_sambastatfiles);
+    XMLUtils::GetUInt(pElement, "readaheadsize", m_sambaReadAheadSize, 0, 64 * 1024 * 1024);
+
+    const TiXmlElement* pShare = pElement->FirstChildElement("share");
+    while (pShare)
+    {
+      std::string path;
+      unsigned int readAheadSize = m_sambaReadAheadSize;
+      if (XMLUtils::GetString(pShare, "path", path) &&
+          XMLUtils::GetUInt(pShare, "readaheadsize", readAheadSize, 0, 64 * 1024 * 1024))
+      {
+        CURL url(path);
+        std::string shareName = url.GetHostName() + "/" + url.GetShareName();
+        StringUtils::ToLower(shareName);
+        m_sambaShareReadAheadSize[shareName] = readAheadSize;
+      }
+      pShare = pShare->NextSiblingElement("share");
+    }
   }
 
+  pElement = pRootElement->FirstChildElement("nfs");
+  if (pElement)
+    XMLUtils::GetUInt(pElement, "readaheaddepth", m_nfsReadAheadDepth, 1, 32);
+
   pElement = pRootElement->FirstChildElement("httpdirectory");
   if (pElement)
     XMLUtils::GetBoolean(pElement, "statfilesize", m_bHTTPDirectoryStatFilesize);
@@ -902,6 +1018,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
   //airtunes + airplay
   XMLUtils::GetInt(pRootElement,     "airtunesport", m_airTunesPort);
   XMLUtils::GetInt(pRootElement,     "airplayport", m_airPlayPort);
+  XMLUtils::GetInt(pRootElement,     "airtuneslatency", m_airTunesLatencyMs, 100, 5000);
 
   XMLUtils::GetBoolean(pRootElement, "handlemounting", m_handleMounting);
 
@@ -935,6 +1052,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pElement, "activetagcheckinterval", m_iEpgActiveTagCheckInterval);
     XMLUtils::GetInt(pElement, "retryinterruptedupdateinterval", m_iEpgRetryInterruptedUpdateInterval);
     XMLUtils::GetInt(pElement, "updateemptytagsinterval", m_iEpgUpdateEmptyTagsInterval);
+    XMLUtils::GetInt(pElement, "memorywindow", m_iEpgMemoryWindow, 0, 24 * 365);
+    XMLUtils::GetInt(pElement, "clientupdatethreads", m_iEpgClientUpdateThreads, 1, 16);
     XMLUtils::GetBoolean(pElement, "displayupdatepopup", m_bEpgDisplayUpdatePopup);
     XMLUtils::GetBoolean(pElement, "displayincrementalupdatepopup", m_bEpgDisplayIncrementalUpdatePopup);
   }
@@ -1073,6 +1192,18 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
   XMLUtils::GetUInt(pRootElement, "imageres", m_imageRes, 0, 9999);
   if (XMLUtils::GetString(pRootElement, "imagescalingalgorithm", tmp))
     m_imageScalingAlgorithm = CPictureScalingAlgorithm::FromString(tmp);
+  XMLUtils::GetBoolean(pRootElement, "imagecompression", m_imageCompression);
+  if (XMLUtils::GetString(pRootElement, "imagecacheformat", tmp))
+  {
+    StringUtils::ToLower(tmp);
+    if (tmp == "jpg" || tmp == "webp")
+      m_imageCacheFormat = tmp;
+    else
+      CLog::Log(LOGWARNING, "CAdvancedSettings: unsupported image cache format %s", tmp.c_str());
+  }
+  XMLUtils::GetInt(pRootElement, "imagecachequality", m_imageCacheQuality, 1, 100);
+  XMLUtils::GetInt(pRootElement, "imageprecachethreads", m_imagePrecacheThreads, 1, 32);
+  XMLUtils::GetInt(pRootElement, "imageprecachehostconnections", m_imagePrecacheHostConnections, 1, 16);
   XMLUtils::GetBoolean(pRootElement, "playlistasfolders", m_playlistAsFolders);
   XMLUtils::GetBoolean(pRootElement, "detectasudf", m_detectAsUdf);
 
@@ -1131,6 +1262,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetInt(pPVR, "numericchannelswitchtimeout", m_iPVRNumericChannelSwitchTimeout, 50, 60000);
     XMLUtils::GetInt(pPVR, "timeshiftthreshold", m_iPVRTimeshiftThreshold, 0, 60);
     XMLUtils::GetBoolean(pPVR, "timeshiftsimpleosd", m_bPVRTimeshiftSimpleOSD);
+    XMLUtils::GetBoolean(pPVR, "fastzap", m_bPVRFastZap);
+    XMLUtils::GetInt(pPVR, "timeshiftbuffersize", m_iPVRTimeshiftBufferSize, 0, 16384);
   }
 
   TiXmlElement* pDatabase = pRootElement->FirstChildElement("videodatabase");
@@ -1231,6 +1364,13 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetBoolean(pElement, "visualizedirtyregions", m_guiVisualizeDirtyRegions);
     XMLUtils::GetInt(pElement, "algorithmdirtyregions",     m_guiAlgorithmDirtyRegions);
     XMLUtils::GetBoolean(pElement, "smartredraw", m_guiSmartRedraw);
+    XMLUtils::GetBoolean(pElement, "fontbatching", m_guiFontBatching);
+    XMLUtils::GetBoolean(pElement, "texturebatching", m_guiTextureBatching);
+    XMLUtils::GetInt(pElement, "fontprewarmcharacters", m_guiFontPrewarmCharacters, 0, 65536);
+    XMLUtils::GetBoolean(pElement, "skincache", m_guiSkinCache);
+    XMLUtils::GetInt(pElement, "artprefetchmemory", m_guiArtPrefetchMemory, 0, 1024);
+    XMLUtils::GetInt(pElement, "idlefps", m_guiIdleFps, 0, 60);
+    XMLUtils::GetInt(pElement, "texturememory", m_guiTextureMemory, 0, 65536);
   }
 
   std::string seekSteps;
@@ -1245,12 +1385,45 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
 
   XMLUtils::GetBoolean(pRootElement, "opengldebugging", m_openGlDebugging);
 
+  TiXmlElement* pThreads = pRootElement->FirstChildElement("threads");
+  if (pThreads)
+  {
+    std::vector<XbmcThreads::ThreadPolicy> policies;
+    for (TiXmlElement* pThread = pThreads->FirstChildElement("thread"); pThread;
+         pThread = pThread->NextSiblingElement("thread"))
+    {
+      XbmcThreads::ThreadPolicy policy;
+      const char* role = pThread->Attribute("role");
+      if (!role || !*role)
+      {
+        CLog::Log(LOGERROR, "Missing role of thread policy");
+        continue;
+      }
+      policy.role = role;
+
+      const char* cores = pThread->Attribute("cores");
+      if (cores && !XbmcThreads::CThreadPolicies::ParseCores(cores, policy.cores))
+      {
+        CLog::Log(LOGERROR, "Invalid cores \"%s\" of thread policy %s", cores, role);
+        continue;
+      }
+      policy.hasPriority = pThread->QueryIntAttribute("priority", &policy.priority) == TIXML_SUCCESS;
+
+      CLog::Log(LOGDEBUG, "Thread policy %s: cores %s, priority %s", role, cores ? cores : "any",
+                policy.hasPriority ? StringUtils::Format("%d", policy.priority).c_str() : "default");
+      policies.push_back(std::move(policy));
+    }
+    XbmcThreads::CThreadPolicies::Set(std::move(policies));
+  }
+
   // load in the settings overrides
   CServiceBroker::GetSettingsComponent()->GetSettings()->LoadHidden(pRootElement);
 }
 
 void CAdvancedSettings::Clear()
 {
+  XbmcThreads::CThreadPolicies::Set({});
+
   m_videoCleanStringRegExps.clear();
   m_moviesExcludeFromScanRegExps.clear();
   m_tvshowExcludeFromScanRegExps.clear();
@@ -1468,6 +1641,7 @@ void CAdvancedSettings::SetExtraLogLevel(const std::vector<CVariant> &components
 
     m_extraLogLevels |= static_cast<int>(it->asInteger());
   }
+  CLog::SetExtraLogLevels(m_extraLogEnabled ? m_extraLogLevels : 0);
 }
 
 void CAdvancedSettings::SetExtraArtwork(const TiXmlElement* arttypes, std::vector<std::string>& artworkMap)
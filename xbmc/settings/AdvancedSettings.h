@@ -12,6 +12,7 @@
 #include "settings/lib/ISettingCallback.h"
 #include "settings/lib/ISettingsHandler.h"
 
+#include <map>
 #include <set>
 #include <string>
 #include <utility>
@@ -133,6 +134,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_VideoPlayerIgnoreDTSinWAV;
     float m_limiterHold;
     float m_limiterRelease;
+    bool m_audioRealtime; // feed the audio device from a realtime thread with locked buffers
+    int m_audioDecodeCacheSize; // MB of decoded music kept on disk by paplayer, 0 disables it
 
     bool  m_omlSync = false;
 
@@ -182,6 +185,13 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_mediacodecForceSoftwareRendering;
     float m_maxTempo;
     bool m_videoPreferStereoStream = false;
+    bool m_videoLockFreePacketQueue = false; ///< \brief pass demuxer packets to the decoders through a lock-free ring
+    bool m_videoZeroCopyDemux = false; ///< \brief reference ffmpeg packet buffers instead of copying the payload
+    unsigned int m_videoDecoderThreads = 0; ///< \brief thread budget of the software video decoders, 0 picks it from the cpu count
+    std::vector<std::string> m_videoSliceThreadedCodecs; ///< \brief ffmpeg decoders that use slice instead of frame threading
+    bool m_videoLowLatencyLiveDecode = false; ///< \brief prefer slice threading for live streams to avoid the frame threading delay
+    bool m_videoApplyFilmGrain = true; ///< \brief let the decoder synthesize AV1 film grain, it is expensive at 4K
+    unsigned int m_videoPreOpenNextSeconds = 0; ///< \brief open the next playlist item this many seconds before the end, 0 disables it
 
     std::string m_videoDefaultPlayer;
     float m_videoPlayCountMinimumPercent;
@@ -201,6 +211,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     //airtunes + airplay
     int m_airTunesPort;
     int m_airPlayPort;
+    int m_airTunesLatencyMs; //!< audio buffered for the player at most, older audio is dropped
 
     bool m_handleMounting;
 
@@ -232,10 +243,19 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     unsigned int m_fanartRes; ///< \brief the maximal resolution to cache fanart at (assumes 16x9)
     unsigned int m_imageRes;  ///< \brief the maximal resolution to cache images at (assumes 16x9)
     CPictureScalingAlgorithm::Algorithm m_imageScalingAlgorithm;
+    bool m_imageCompression; ///< \brief cache images as textures in a compressed format of the GPU
+    std::string m_imageCacheFormat; ///< \brief format of cached images, "jpg" for jpeg/png or "webp"
+    int m_imageCacheQuality; ///< \brief quality (1-100) of cached webp images
+    int m_imagePrecacheThreads; ///< \brief images cached at once when precaching the art of the library
+    int m_imagePrecacheHostConnections; ///< \brief images fetched at once from the same host when precaching
 
     int m_sambaclienttimeout;
     std::string m_sambadoscodepage;
     bool m_sambastatfiles;
+    unsigned int m_sambaReadAheadSize; ///< \brief largest block read from samba shares while reading sequentially, 0 reads what is asked for
+    std::map<std::string, unsigned int> m_sambaShareReadAheadSize; ///< \brief read ahead of single shares, by lower case "server/share"
+
+    unsigned int m_nfsReadAheadDepth; ///< \brief READ calls kept in flight while the file cache fills from nfs, 1 reads one chunk at a time
 
     bool m_bHTTPDirectoryStatFilesize;
 
@@ -248,8 +268,13 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
 
     int m_iMusicLibraryRecentlyAddedItems;
     int m_iMusicLibraryDateAdded;
+    int m_iMusicLibraryWriteBatchSize; //!< albums written per transaction during a scan, 0 commits each one
+    int m_iMusicLibraryWriteBatchTime; //!< ms after which a scan commits anyway
+    int m_iMusicLibraryTagLoaderThreads; //!< threads reading the tags of a folder during a scan
+    int m_iMusicLibraryTagPrefetchSize; //!< KB read at once from the start and the end of remote files for the tags, 0 disables
     bool m_bMusicLibraryAllItemsOnBottom;
     bool m_bMusicLibraryCleanOnUpdate;
+    bool m_bMusicLibraryAnalyseLoudness; //!< measure the replay gain of songs without one after a scan
     bool m_bMusicLibraryArtistSortOnUpdate;
     std::string m_strMusicLibraryAlbumFormat;
     bool m_prioritiseAPEv2tags;
@@ -262,6 +287,9 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int m_iVideoLibraryRecentlyAddedItems;
     bool m_bVideoLibraryCleanOnUpdate;
     bool m_bVideoLibraryUseFastHash;
+    int m_iVideoLibraryWriteBatchSize; //!< items written per transaction during a scan, 0 commits each one
+    int m_iVideoLibraryWriteBatchTime; //!< ms after which a scan commits anyway
+    bool m_bVideoLibraryUseNavSummary; //!< read genre, country, studio and tag nodes from the navsummary table
     bool m_bVideoLibraryExportAutoThumbs;
     bool m_bVideoLibraryImportWatchedState;
     bool m_bVideoLibraryImportResumePoint;
@@ -273,6 +301,9 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     std::vector<std::string> m_videoMusicVideoExtraArt;
 
     bool m_bVideoScannerIgnoreErrors;
+    int m_iVideoScannerScraperThreads; // lookups running at the same time per scraper addon
+    int m_iVideoScannerScraperInterval; // ms between two requests to the same scraper addon
+    int m_iVideoScannerProbeThreads; // stream detail probes running at the same time per server
     int m_iVideoLibraryDateAdded;
 
     std::set<std::string> m_vecTokens;
@@ -282,6 +313,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int m_iEpgActiveTagCheckInterval; // seconds
     int m_iEpgRetryInterruptedUpdateInterval; // seconds
     int m_iEpgUpdateEmptyTagsInterval; // seconds
+    int m_iEpgMemoryWindow; // hours
+    int m_iEpgClientUpdateThreads;
     bool m_bEpgDisplayUpdatePopup;
     bool m_bEpgDisplayIncrementalUpdatePopup;
 
@@ -333,6 +366,8 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     int m_iPVRNumericChannelSwitchTimeout; /*!< @brief time in msecs after that a channel switch occurs after entering a channel number, if confirmchannelswitch is disabled */
     int m_iPVRTimeshiftThreshold; /*!< @brief time diff between current playing time and timeshift buffer end, in seconds, before a playing stream is displayed as timeshifting. */
     bool m_bPVRTimeshiftSimpleOSD; /*!< @brief use simple timeshift OSD (with progress only for the playing event instead of progress for the whole ts buffer). */
+    bool m_bPVRFastZap; /*!< @brief start live tv channels with the stream parameters of the previous tune, start audio before the first video keyframe and show the first picture unsynced. */
+    int m_iPVRTimeshiftBufferSize; /*!< @brief size in MB of the disk buffer used to pause and rewind live tv of clients without timeshift support, 0 to disable. */
     DatabaseSettings m_databaseMusic; // advanced music database setup
     DatabaseSettings m_databaseVideo; // advanced video database setup
     DatabaseSettings m_databaseTV;    // advanced tv database setup
@@ -342,15 +377,29 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler
     bool m_guiVisualizeDirtyRegions;
     int  m_guiAlgorithmDirtyRegions;
     bool m_guiSmartRedraw;
+    bool m_guiFontBatching; ///< \brief draw the text of all fonts from a shared texture in as few calls as possible (GL/GLES)
+    bool m_guiTextureBatching; ///< \brief draw textures of the same state with a single call (GL/GLES)
+    int m_guiFontPrewarmCharacters; ///< \brief most frequent characters of the language rendered ahead on skin load, 0 disables
+    bool m_guiSkinCache; ///< \brief keep the window xml of the skin with resolved includes in special://temp/skincache
+    int m_guiArtPrefetchMemory; ///< \brief memory in MB for the art containers load ahead of scrolling, 0 disables it
+    int m_guiTextureMemory; ///< \brief budget in MB for the decoded textures of the GUI, 0 picks one from the physical memory
+    int m_guiIdleFps; ///< \brief frame rate of the GUI while there is no input and nothing is played, 0 disables the limit
     unsigned int m_addonPackageFolderSize;
 
     unsigned int m_cacheMemSize;
     unsigned int m_cacheBufferMode;
     float m_cacheReadFactor;
+    unsigned int m_cacheRetainSize; ///< \brief memory for already played ranges kept after a seek, 0 disables
+    unsigned int m_cacheSegmentSize; ///< \brief size of the range requests of the segmented read-ahead
+    unsigned int m_cacheSegmentConcurrency; ///< \brief number of parallel range requests, 1 disables segmented read-ahead
+    bool m_cacheMemoryMapLocal; ///< \brief read uncached local media through a memory mapped window
 
     bool m_jsonOutputCompact;
     unsigned int m_jsonTcpPort;
 
+    unsigned int m_webServerThreadPoolSize; ///< \brief threads serving all connections of the webserver, 0 for a thread per connection
+    bool m_webServerMetrics; ///< \brief serve performance counters at /metrics
+
     bool m_enableMultimediaKeys;
     std::vector<std::string> m_settingsFiles;
     void ParseSettingsFile(const std::string &file);
@@ -0,0 +1,281 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "SettingDefinitionsSnapshot.h"
+
+#include "filesystem/File.h"
+#include "utils/SystemInfo.h"
+#include "utils/XBMCTinyXML.h"
+#include "utils/auto_buffer.h"
+#include "utils/log.h"
+
+#include <cstring>
+#include <memory>
+
+#define SNAPSHOT_MAGIC "KSDS"
+#define SNAPSHOT_FORMAT_VERSION 1
+
+// node tags of the serialized documents
+#define NODE_ELEMENT 'E'
+#define NODE_TEXT 'T'
+#define NODE_CDATA 'C'
+
+using namespace XFILE;
+
+namespace
+{
+
+// a snapshot is only valid for the build that wrote it
+std::string GetBuildKey()
+{
+  return CSysInfo::GetVersion() + " " + CSysInfo::GetBuildDate();
+}
+
+void WriteInt(std::string& out, int64_t value)
+{
+  out.append(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+void WriteString(std::string& out, const char* value)
+{
+  const uint32_t length = static_cast<uint32_t>(strlen(value));
+  out.append(reinterpret_cast<const char*>(&length), sizeof(length));
+  out.append(value, length);
+}
+
+void WriteNode(std::string& out, const TiXmlNode* node)
+{
+  if (node->Type() == TiXmlNode::TINYXML_TEXT)
+  {
+    out.push_back(node->ToText()->CDATA() ? NODE_CDATA : NODE_TEXT);
+    WriteString(out, node->Value());
+    return;
+  }
+
+  const TiXmlElement* element = node->ToElement();
+  out.push_back(NODE_ELEMENT);
+  WriteString(out, element->Value());
+
+  uint32_t count = 0;
+  for (const TiXmlAttribute* attribute = element->FirstAttribute(); attribute; attribute = attribute->Next())
+    count++;
+  out.append(reinterpret_cast<const char*>(&count), sizeof(count));
+  for (const TiXmlAttribute* attribute = element->FirstAttribute(); attribute; attribute = attribute->Next())
+  {
+    WriteString(out, attribute->Name());
+    WriteString(out, attribute->Value());
+  }
+
+  // comments and declarations are of no use to the settings manager
+  count = 0;
+  for (const TiXmlNode* child = element->FirstChild(); child; child = child->NextSibling())
+  {
+    if (child->Type() == TiXmlNode::TINYXML_ELEMENT || child->Type() == TiXmlNode::TINYXML_TEXT)
+      count++;
+  }
+  out.append(reinterpret_cast<const char*>(&count), sizeof(count));
+  for (const TiXmlNode* child = element->FirstChild(); child; child = child->NextSibling())
+  {
+    if (child->Type() == TiXmlNode::TINYXML_ELEMENT || child->Type() == TiXmlNode::TINYXML_TEXT)
+      WriteNode(out, child);
+  }
+}
+
+class CReader
+{
+public:
+  CReader(const char* data, size_t size) : m_pos(data), m_end(data + size) { }
+
+  bool AtEnd() const { return m_pos == m_end; }
+
+  template<typename T>
+  bool Read(T& value)
+  {
+    if (static_cast<size_t>(m_end - m_pos) < sizeof(value))
+      return false;
+    memcpy(&value, m_pos, sizeof(value));
+    m_pos += sizeof(value);
+    return true;
+  }
+
+  bool ReadString(std::string& value)
+  {
+    uint32_t length;
+    if (!Read(length) || static_cast<size_t>(m_end - m_pos) < length)
+      return false;
+    value.assign(m_pos, length);
+    m_pos += length;
+    return true;
+  }
+
+private:
+  const char* m_pos;
+  const char* m_end;
+};
+
+TiXmlNode* ReadNode(CReader& reader)
+{
+  char tag;
+  std::string value;
+  if (!reader.Read(tag) || !reader.ReadString(value))
+    return nullptr;
+
+  if (tag == NODE_TEXT || tag == NODE_CDATA)
+  {
+    TiXmlText* text = new TiXmlText(value);
+    text->SetCDATA(tag == NODE_CDATA);
+    return text;
+  }
+  if (tag != NODE_ELEMENT)
+    return nullptr;
+
+  std::unique_ptr<TiXmlElement> element(new TiXmlElement(value));
+  uint32_t count;
+  if (!reader.Read(count))
+    return nullptr;
+  for (uint32_t i = 0; i < count; i++)
+  {
+    std::string name;
+    if (!reader.ReadString(name) || !reader.ReadString(value))
+      return nullptr;
+    element->SetAttribute(name, value);
+  }
+
+  if (!reader.Read(count))
+    return nullptr;
+  for (uint32_t i = 0; i < count; i++)
+  {
+    TiXmlNode* child = ReadNode(reader);
+    if (!child)
+      return nullptr;
+    element->LinkEndChild(child);
+  }
+
+  return element.release();
+}
+
+} // namespace
+
+CSettingDefinitionsSnapshot::CSettingDefinitionsSnapshot(const std::string& file)
+  : m_file(file)
+{
+}
+
+void CSettingDefinitionsSnapshot::Load()
+{
+  m_documents.clear();
+  m_changed = false;
+
+  if (!CFile::Exists(m_file))
+    return;
+
+  XUTILS::auto_buffer buffer;
+  CFile file;
+  if (file.LoadFile(m_file, buffer) <= 0)
+    return;
+
+  CReader reader(buffer.get(), buffer.size());
+  char magic[4];
+  int64_t version;
+  std::string buildKey;
+  if (!reader.Read(magic) || memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) != 0 ||
+      !reader.Read(version) || version != SNAPSHOT_FORMAT_VERSION ||
+      !reader.ReadString(buildKey) || buildKey != GetBuildKey())
+  {
+    CLog::Log(LOGDEBUG, "CSettingDefinitionsSnapshot: ignoring outdated %s", m_file.c_str());
+    return;
+  }
+
+  while (!reader.AtEnd())
+  {
+    std::string path;
+    Document document;
+    if (!reader.ReadString(path) || !reader.Read(document.size) || !reader.Read(document.mtime) ||
+        !reader.ReadString(document.data))
+    {
+      CLog::Log(LOGWARNING, "CSettingDefinitionsSnapshot: %s is truncated", m_file.c_str());
+      m_documents.clear();
+      return;
+    }
+    m_documents[path] = std::move(document);
+  }
+}
+
+void CSettingDefinitionsSnapshot::Save() const
+{
+  if (!m_changed)
+    return;
+
+  std::string data(SNAPSHOT_MAGIC);
+  WriteInt(data, SNAPSHOT_FORMAT_VERSION);
+  WriteString(data, GetBuildKey().c_str());
+  for (const auto& it : m_documents)
+  {
+    WriteString(data, it.first.c_str());
+    WriteInt(data, it.second.size);
+    WriteInt(data, it.second.mtime);
+    const uint32_t length = static_cast<uint32_t>(it.second.data.size());
+    data.append(reinterpret_cast<const char*>(&length), sizeof(length));
+    data.append(it.second.data);
+  }
+
+  CFile file;
+  if (!file.OpenForWrite(m_file, true) ||
+      file.Write(data.c_str(), data.size()) != static_cast<ssize_t>(data.size()))
+  {
+    CLog::Log(LOGWARNING, "CSettingDefinitionsSnapshot: unable to write %s", m_file.c_str());
+    file.Close();
+    CFile::Delete(m_file);
+  }
+}
+
+bool CSettingDefinitionsSnapshot::GetDocument(const std::string& path, CXBMCTinyXML& doc) const
+{
+  auto it = m_documents.find(path);
+  if (it == m_documents.end())
+    return false;
+
+  int64_t size, mtime;
+  if (!StatFile(path, size, mtime) || size != it->second.size || mtime != it->second.mtime)
+    return false;
+
+  CReader reader(it->second.data.c_str(), it->second.data.size());
+  TiXmlNode* root = ReadNode(reader);
+  if (!root || !reader.AtEnd())
+  {
+    delete root;
+    return false;
+  }
+
+  doc.Clear();
+  doc.LinkEndChild(root);
+  return true;
+}
+
+void CSettingDefinitionsSnapshot::AddDocument(const std::string& path, const TiXmlDocument& doc)
+{
+  const TiXmlElement* root = doc.RootElement();
+  Document document;
+  if (!root || !StatFile(path, document.size, document.mtime))
+    return;
+
+  WriteNode(document.data, root);
+  m_documents[path] = std::move(document);
+  m_changed = true;
+}
+
+bool CSettingDefinitionsSnapshot::StatFile(const std::string& path, int64_t& size, int64_t& mtime)
+{
+  struct __stat64 buffer;
+  if (CFile::Stat(path, &buffer) != 0)
+    return false;
+
+  size = buffer.st_size;
+  mtime = buffer.st_mtime;
+  return true;
+}
@@ -0,0 +1,59 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <map>
+#include <stdint.h>
+#include <string>
+
+class CXBMCTinyXML;
+class TiXmlDocument;
+
+/*!
+ \brief Binary copy of the parsed settings definition files.
+
+ Rebuilding the documents from the snapshot skips parsing the XML text of
+ the definitions on every start. A document is only taken from the snapshot
+ while the size and modification time of its file match, the whole snapshot
+ is dropped when it was written by a different build.
+ */
+class CSettingDefinitionsSnapshot
+{
+public:
+  explicit CSettingDefinitionsSnapshot(const std::string& file);
+
+  /*! \brief Read the snapshot file, a missing or outdated one is ignored */
+  void Load();
+
+  /*! \brief Write the snapshot file if documents were added since loading it */
+  void Save() const;
+
+  /*!
+   \brief Rebuild the document of the given definition file
+   \return false if the snapshot has no current copy of the file
+   */
+  bool GetDocument(const std::string& path, CXBMCTinyXML& doc) const;
+
+  /*! \brief Store the parsed document of the given definition file */
+  void AddDocument(const std::string& path, const TiXmlDocument& doc);
+
+private:
+  struct Document
+  {
+    int64_t size;
+    int64_t mtime;
+    std::string data;
+  };
+
+  static bool StatFile(const std::string& path, int64_t& size, int64_t& mtime);
+
+  std::string m_file;
+  std::map<std::string, Document> m_documents;
+  bool m_changed = false;
+};
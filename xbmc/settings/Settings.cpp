@@ -41,6 +41,7 @@
 #include "settings/MediaSourceSettings.h"
 #include "settings/SettingsComponent.h"
 #include "settings/SettingConditions.h"
+#include "settings/SettingDefinitionsSnapshot.h"
 #include "settings/SkinSettings.h"
 #include "settings/lib/SettingsManager.h"
 #include "threads/SingleLock.h"
@@ -56,6 +57,7 @@
 #include "DiscSettings.h"
 
 #define SETTINGS_XML_FOLDER "special://xbmc/system/settings/"
+#define SETTINGS_SNAPSHOT_FILE "special://temp/settingdefinitions.bin"
 
 using namespace KODI;
 using namespace XFILE;
@@ -333,6 +335,7 @@ const std::string CSettings::SETTING_VIDEOSCREEN_TESTPATTERN = "videoscreen.test
 const std::string CSettings::SETTING_VIDEOSCREEN_LIMITEDRANGE = "videoscreen.limitedrange";
 const std::string CSettings::SETTING_VIDEOSCREEN_FRAMEPACKING = "videoscreen.framepacking";
 const std::string CSettings::SETTING_AUDIOOUTPUT_AUDIODEVICE = "audiooutput.audiodevice";
+const std::string CSettings::SETTING_AUDIOOUTPUT_MUSICDEVICE = "audiooutput.musicdevice";
 const std::string CSettings::SETTING_AUDIOOUTPUT_CHANNELS = "audiooutput.channels";
 const std::string CSettings::SETTING_AUDIOOUTPUT_CONFIG = "audiooutput.config";
 const std::string CSettings::SETTING_AUDIOOUTPUT_SAMPLERATE = "audiooutput.samplerate";
@@ -496,65 +499,74 @@ bool CSettings::GetBool(const std::string& id) const
   return CSettingsBase::GetBool(id);
 }
 
-bool CSettings::Initialize(const std::string &file)
+bool CSettings::Initialize(const std::string &file, CSettingDefinitionsSnapshot &snapshot)
 {
   CXBMCTinyXML xmlDoc;
-  if (!xmlDoc.LoadFile(file.c_str()))
+  if (snapshot.GetDocument(file, xmlDoc))
+    CLog::Log(LOGDEBUG, "CSettings: loaded settings definition from snapshot of %s", file.c_str());
+  else
   {
-    CLog::Log(LOGERROR, "CSettings: error loading settings definition from %s, Line %d\n%s", file.c_str(), xmlDoc.ErrorRow(), xmlDoc.ErrorDesc());
-    return false;
-  }
+    if (!xmlDoc.LoadFile(file.c_str()))
+    {
+      CLog::Log(LOGERROR, "CSettings: error loading settings definition from %s, Line %d\n%s", file.c_str(), xmlDoc.ErrorRow(), xmlDoc.ErrorDesc());
+      return false;
+    }
 
-  CLog::Log(LOGDEBUG, "CSettings: loaded settings definition from %s", file.c_str());
+    CLog::Log(LOGDEBUG, "CSettings: loaded settings definition from %s", file.c_str());
+    snapshot.AddDocument(file, xmlDoc);
+  }
 
   return InitializeDefinitionsFromXml(xmlDoc);
 }
 
 bool CSettings::InitializeDefinitions()
 {
-  if (!Initialize(SETTINGS_XML_FOLDER "settings.xml"))
+  CSettingDefinitionsSnapshot snapshot(SETTINGS_SNAPSHOT_FILE);
+  snapshot.Load();
+
+  if (!Initialize(SETTINGS_XML_FOLDER "settings.xml", snapshot))
   {
     CLog::Log(LOGFATAL, "Unable to load settings definitions");
     return false;
   }
 #if defined(TARGET_WINDOWS)
-  if (CFile::Exists(SETTINGS_XML_FOLDER "windows.xml") && !Initialize(SETTINGS_XML_FOLDER "windows.xml"))
+  if (CFile::Exists(SETTINGS_XML_FOLDER "windows.xml") && !Initialize(SETTINGS_XML_FOLDER "windows.xml", snapshot))
     CLog::Log(LOGFATAL, "Unable to load windows-specific settings definitions");
 #if defined(TARGET_WINDOWS_DESKTOP)
-  if (CFile::Exists(SETTINGS_XML_FOLDER "win32.xml") && !Initialize(SETTINGS_XML_FOLDER "win32.xml"))
+  if (CFile::Exists(SETTINGS_XML_FOLDER "win32.xml") && !Initialize(SETTINGS_XML_FOLDER "win32.xml", snapshot))
     CLog::Log(LOGFATAL, "Unable to load win32-specific settings definitions");
 #elif defined(TARGET_WINDOWS_STORE)
-  if (CFile::Exists(SETTINGS_XML_FOLDER "win10.xml") && !Initialize(SETTINGS_XML_FOLDER "win10.xml"))
+  if (CFile::Exists(SETTINGS_XML_FOLDER "win10.xml") && !Initialize(SETTINGS_XML_FOLDER "win10.xml", snapshot))
     CLog::Log(LOGFATAL, "Unable to load win10-specific settings definitions");
 #endif
 #elif defined(TARGET_ANDROID)
-  if (CFile::Exists(SETTINGS_XML_FOLDER "android.xml") && !Initialize(SETTINGS_XML_FOLDER "android.xml"))
+  if (CFile::Exists(SETTINGS_XML_FOLDER "android.xml") && !Initialize(SETTINGS_XML_FOLDER "android.xml", snapshot))
     CLog::Log(LOGFATAL, "Unable to load android-specific settings definitions");
 #elif defined(TARGET_RASPBERRY_PI)
-  if (CFile::Exists(SETTINGS_XML_FOLDER "rbp.xml") && !Initialize(SETTINGS_XML_FOLDER "rbp.xml"))
+  if (CFile::Exists(SETTINGS_XML_FOLDER "rbp.xml") && !Initialize(SETTINGS_XML_FOLDER "rbp.xml", snapshot))
     CLog::Log(LOGFATAL, "Unable to load rbp-specific settings definitions");
-  if (g_RBP.RaspberryPiVersion() > 1 && CFile::Exists(SETTINGS_XML_FOLDER "rbp2.xml") && !Initialize(SETTINGS_XML_FOLDER "rbp2.xml"))
+  if (g_RBP.RaspberryPiVersion() > 1 && CFile::Exists(SETTINGS_XML_FOLDER "rbp2.xml") && !Initialize(SETTINGS_XML_FOLDER "rbp2.xml", snapshot))
     CLog::Log(LOGFATAL, "Unable to load rbp2-specific settings definitions");
 #elif defined(TARGET_FREEBSD)
-  if (CFile::Exists(SETTINGS_XML_FOLDER "freebsd.xml") && !Initialize(SETTINGS_XML_FOLDER "freebsd.xml"))
+  if (CFile::Exists(SETTINGS_XML_FOLDER "freebsd.xml") && !Initialize(SETTINGS_XML_FOLDER "freebsd.xml", snapshot))
     CLog::Log(LOGFATAL, "Unable to load freebsd-specific settings definitions");
 #elif defined(TARGET_LINUX)
-  if (CFile::Exists(SETTINGS_XML_FOLDER "linux.xml") && !Initialize(SETTINGS_XML_FOLDER "linux.xml"))
+  if (CFile::Exists(SETTINGS_XML_FOLDER "linux.xml") && !Initialize(SETTINGS_XML_FOLDER "linux.xml", snapshot))
     CLog::Log(LOGFATAL, "Unable to load linux-specific settings definitions");
 #elif defined(TARGET_DARWIN)
-  if (CFile::Exists(SETTINGS_XML_FOLDER "darwin.xml") && !Initialize(SETTINGS_XML_FOLDER "darwin.xml"))
+  if (CFile::Exists(SETTINGS_XML_FOLDER "darwin.xml") && !Initialize(SETTINGS_XML_FOLDER "darwin.xml", snapshot))
     CLog::Log(LOGFATAL, "Unable to load darwin-specific settings definitions");
 #if defined(TARGET_DARWIN_OSX)
-  if (CFile::Exists(SETTINGS_XML_FOLDER "darwin_osx.xml") && !Initialize(SETTINGS_XML_FOLDER "darwin_osx.xml"))
+  if (CFile::Exists(SETTINGS_XML_FOLDER "darwin_osx.xml") && !Initialize(SETTINGS_XML_FOLDER "darwin_osx.xml", snapshot))
     CLog::Log(LOGFATAL, "Unable to load osx-specific settings definitions");
 #elif defined(TARGET_DARWIN_IOS)
-  if (CFile::Exists(SETTINGS_XML_FOLDER "darwin_ios.xml") && !Initialize(SETTINGS_XML_FOLDER "darwin_ios.xml"))
+  if (CFile::Exists(SETTINGS_XML_FOLDER "darwin_ios.xml") && !Initialize(SETTINGS_XML_FOLDER "darwin_ios.xml", snapshot))
     CLog::Log(LOGFATAL, "Unable to load ios-specific settings definitions");
 #endif
 #endif
 
 #if defined(PLATFORM_SETTINGS_FILE)
-  if (CFile::Exists(SETTINGS_XML_FOLDER DEF_TO_STR_VALUE(PLATFORM_SETTINGS_FILE)) && !Initialize(SETTINGS_XML_FOLDER DEF_TO_STR_VALUE(PLATFORM_SETTINGS_FILE)))
+  if (CFile::Exists(SETTINGS_XML_FOLDER DEF_TO_STR_VALUE(PLATFORM_SETTINGS_FILE)) && !Initialize(SETTINGS_XML_FOLDER DEF_TO_STR_VALUE(PLATFORM_SETTINGS_FILE), snapshot))
     CLog::Log(LOGFATAL, "Unable to load platform-specific settings definitions (%s)", DEF_TO_STR_VALUE(PLATFORM_SETTINGS_FILE));
 #endif
 
@@ -563,9 +575,11 @@ bool CSettings::InitializeDefinitions()
   InitializeVisibility();
   InitializeDefaults();
 
-  if (CFile::Exists(SETTINGS_XML_FOLDER "appliance.xml") && !Initialize(SETTINGS_XML_FOLDER "appliance.xml"))
+  if (CFile::Exists(SETTINGS_XML_FOLDER "appliance.xml") && !Initialize(SETTINGS_XML_FOLDER "appliance.xml", snapshot))
     CLog::Log(LOGFATAL, "Unable to load appliance-specific settings definitions");
 
+  snapshot.Save();
+
   return true;
 }
 
@@ -838,6 +852,8 @@ void CSettings::InitializeISettingCallbacks()
 
   settingSet.clear();
   settingSet.insert(CSettings::SETTING_AUDIOOUTPUT_PASSTHROUGH);
+  settingSet.insert(CSettings::SETTING_AUDIOOUTPUT_AUDIODEVICE);
+  settingSet.insert(CSettings::SETTING_AUDIOOUTPUT_MUSICDEVICE);
   settingSet.insert(CSettings::SETTING_LOOKANDFEEL_SKIN);
   settingSet.insert(CSettings::SETTING_LOOKANDFEEL_SKINSETTINGS);
   settingSet.insert(CSettings::SETTING_LOOKANDFEEL_FONT);
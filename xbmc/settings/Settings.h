@@ -14,6 +14,7 @@
 
 #include <string>
 
+class CSettingDefinitionsSnapshot;
 class CSettingList;
 class TiXmlNode;
 
@@ -299,6 +300,7 @@ public:
   static const std::string SETTING_VIDEOSCREEN_LIMITEDRANGE;
   static const std::string SETTING_VIDEOSCREEN_FRAMEPACKING;
   static const std::string SETTING_AUDIOOUTPUT_AUDIODEVICE;
+  static const std::string SETTING_AUDIOOUTPUT_MUSICDEVICE;
   static const std::string SETTING_AUDIOOUTPUT_CHANNELS;
   static const std::string SETTING_AUDIOOUTPUT_CONFIG;
   static const std::string SETTING_AUDIOOUTPUT_SAMPLERATE;
@@ -463,6 +465,6 @@ private:
   CSettings(const CSettings&) = delete;
   CSettings const& operator=(CSettings const&) = delete;
 
-  bool Initialize(const std::string &file);
+  bool Initialize(const std::string &file, CSettingDefinitionsSnapshot &snapshot);
   bool Reset();
 };
@@ -18,6 +18,16 @@
 #include <algorithm>
 #include <utility>
 
+namespace
+{
+
+bool HasUpperCase(const std::string &str)
+{
+  return std::any_of(str.begin(), str.end(), [](char c) { return c >= 'A' && c <= 'Z'; });
+}
+
+} // namespace
+
 const uint32_t CSettingsManager::Version = 2;
 const uint32_t CSettingsManager::MinimumSupportedVersion = 0;
 
@@ -539,6 +549,16 @@ void* CSettingsManager::GetSettingOptionsFiller(SettingConstPtr setting)
   return fillerIt->second.filler;
 }
 
+const CSetting* CSettingsManager::LookupSetting(const std::string &id) const
+{
+  auto setting = FindSetting(id);
+  if (setting != m_settings.end() && setting->second.setting)
+    return setting->second.setting.get();
+
+  CLog::Log(LOGDEBUG, "CSettingsManager: requested setting (%s) was not found.", id.c_str());
+  return nullptr;
+}
+
 SettingPtr CSettingsManager::GetSetting(const std::string &id) const
 {
   CSharedLock lock(m_settingsCritical);
@@ -600,11 +620,11 @@ SettingDependencyMap CSettingsManager::GetDependencies(SettingConstPtr setting)
 bool CSettingsManager::GetBool(const std::string &id) const
 {
   CSharedLock lock(m_settingsCritical);
-  SettingPtr setting = GetSetting(id);
+  const CSetting* setting = LookupSetting(id);
   if (setting == nullptr || setting->GetType() != SettingType::Boolean)
     return false;
 
-  return std::static_pointer_cast<CSettingBool>(setting)->GetValue();
+  return static_cast<const CSettingBool*>(setting)->GetValue();
 }
 
 bool CSettingsManager::SetBool(const std::string &id, bool value)
@@ -630,11 +650,11 @@ bool CSettingsManager::ToggleBool(const std::string &id)
 int CSettingsManager::GetInt(const std::string &id) const
 {
   CSharedLock lock(m_settingsCritical);
-  SettingPtr setting = GetSetting(id);
+  const CSetting* setting = LookupSetting(id);
   if (setting == nullptr || setting->GetType() != SettingType::Integer)
     return 0;
 
-  return std::static_pointer_cast<CSettingInt>(setting)->GetValue();
+  return static_cast<const CSettingInt*>(setting)->GetValue();
 }
 
 bool CSettingsManager::SetInt(const std::string &id, int value)
@@ -650,11 +670,11 @@ bool CSettingsManager::SetInt(const std::string &id, int value)
 double CSettingsManager::GetNumber(const std::string &id) const
 {
   CSharedLock lock(m_settingsCritical);
-  SettingPtr setting = GetSetting(id);
+  const CSetting* setting = LookupSetting(id);
   if (setting == nullptr || setting->GetType() != SettingType::Number)
     return 0.0;
 
-  return std::static_pointer_cast<CSettingNumber>(setting)->GetValue();
+  return static_cast<const CSettingNumber*>(setting)->GetValue();
 }
 
 bool CSettingsManager::SetNumber(const std::string &id, double value)
@@ -670,11 +690,11 @@ bool CSettingsManager::SetNumber(const std::string &id, double value)
 std::string CSettingsManager::GetString(const std::string &id) const
 {
   CSharedLock lock(m_settingsCritical);
-  SettingPtr setting = GetSetting(id);
+  const CSetting* setting = LookupSetting(id);
   if (setting == nullptr || setting->GetType() != SettingType::String)
     return "";
 
-  return std::static_pointer_cast<CSettingString>(setting)->GetValue();
+  return static_cast<const CSettingString*>(setting)->GetValue();
 }
 
 bool CSettingsManager::SetString(const std::string &id, const std::string &value)
@@ -1341,16 +1361,25 @@ void CSettingsManager::ResolveSettingDependencies(const Setting& setting)
   }
 }
 
-CSettingsManager::SettingMap::const_iterator CSettingsManager::FindSetting(std::string settingId) const
+CSettingsManager::SettingMap::const_iterator CSettingsManager::FindSetting(const std::string &settingId) const
 {
-  StringUtils::ToLower(settingId);
-  return m_settings.find(settingId);
+  // ids are lower case almost always, which spares the copy
+  if (!HasUpperCase(settingId))
+    return m_settings.find(settingId);
+
+  std::string lowerId = settingId;
+  StringUtils::ToLower(lowerId);
+  return m_settings.find(lowerId);
 }
 
-CSettingsManager::SettingMap::iterator CSettingsManager::FindSetting(std::string settingId)
+CSettingsManager::SettingMap::iterator CSettingsManager::FindSetting(const std::string &settingId)
 {
-  StringUtils::ToLower(settingId);
-  return m_settings.find(settingId);
+  if (!HasUpperCase(settingId))
+    return m_settings.find(settingId);
+
+  std::string lowerId = settingId;
+  StringUtils::ToLower(lowerId);
+  return m_settings.find(lowerId);
 }
 
 std::pair<CSettingsManager::SettingMap::iterator, bool> CSettingsManager::InsertSetting(std::string settingId, const Setting& setting)
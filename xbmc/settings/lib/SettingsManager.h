@@ -513,8 +513,10 @@ private:
   void ResolveSettingDependencies(std::shared_ptr<CSetting> setting);
   void ResolveSettingDependencies(const Setting& setting);
 
-  SettingMap::const_iterator FindSetting(std::string settingId) const;
-  SettingMap::iterator FindSetting(std::string settingId);
+  SettingMap::const_iterator FindSetting(const std::string &settingId) const;
+  SettingMap::iterator FindSetting(const std::string &settingId);
+  /*! \brief Find a setting without sharing its ownership, the settings lock must be held */
+  const CSetting* LookupSetting(const std::string &id) const;
   std::pair<SettingMap::iterator, bool> InsertSetting(std::string settingId, const Setting& setting);
 
   bool m_initialized = false;
@@ -543,6 +545,6 @@ private:
   using SettingOptionsFillerMap = std::map<std::string, SettingOptionsFiller>;
   SettingOptionsFillerMap m_optionsFillers;
 
-  mutable CSharedSection m_critical;
-  mutable CSharedSection m_settingsCritical;
+  mutable CSharedSection m_critical{"CSettingsManager"};
+  mutable CSharedSection m_settingsCritical{"CSettingsManager settings"};
 };
@@ -0,0 +1,61 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/AudioEngine/Engines/ActiveAE/ActiveAEBuffer.h"
+
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+using namespace ActiveAE;
+
+namespace
+{
+AEAudioFormat GetFormat()
+{
+  AEAudioFormat format;
+  format.m_dataFormat = AE_FMT_FLOATP;
+  format.m_sampleRate = 48000;
+  format.m_channelLayout = AE_CH_LAYOUT_5_1;
+  format.m_frames = 1024;
+  format.m_frameSize = format.m_channelLayout.Count() * sizeof(float);
+  return format;
+}
+}
+
+static void BM_ActiveAEBufferPoolCreate(benchmark::State& state)
+{
+  const AEAudioFormat format = GetFormat();
+  for (auto _ : state)
+  {
+    CActiveAEBufferPool pool(format);
+    pool.Create(state.range(0));
+  }
+}
+BENCHMARK(BM_ActiveAEBufferPoolCreate)->Arg(100)->Arg(500);
+
+static void BM_ActiveAEBufferPoolGetReturn(benchmark::State& state)
+{
+  CActiveAEBufferPool pool(GetFormat());
+  pool.Create(500);
+
+  // buffers in flight between the stages of the engine
+  std::vector<CSampleBuffer*> buffers(state.range(0));
+  for (auto _ : state)
+  {
+    for (auto& buffer : buffers)
+      buffer = pool.GetFreeBuffer();
+    for (auto buffer : buffers)
+    {
+      if (buffer)
+        buffer->Return();
+    }
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_ActiveAEBufferPoolGetReturn)->Arg(1)->Arg(8);
@@ -0,0 +1,88 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/CharsetConverter.h"
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+const std::string ascii = "The Quick Brown Fox Jumps Over The Lazy Dog (1080p)";
+const std::string latin = u8"Amélie - Le Fabuleux Destin d'Amélie Poulain (Ça va, Noël)";
+const std::string cjk = u8"千と千尋の神隠し - となりのトトロ - 天空の城ラピュタ";
+}
+
+static void BM_CharsetConverterUtf8ToWAscii(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    std::wstring str;
+    g_charsetConverter.utf8ToW(ascii, str, false);
+    benchmark::DoNotOptimize(str);
+  }
+}
+BENCHMARK(BM_CharsetConverterUtf8ToWAscii);
+
+static void BM_CharsetConverterUtf8ToWLatin(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    std::wstring str;
+    g_charsetConverter.utf8ToW(latin, str, false);
+    benchmark::DoNotOptimize(str);
+  }
+}
+BENCHMARK(BM_CharsetConverterUtf8ToWLatin);
+
+static void BM_CharsetConverterUtf8ToWBidi(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    std::wstring str;
+    g_charsetConverter.utf8ToW(cjk, str, true);
+    benchmark::DoNotOptimize(str);
+  }
+}
+BENCHMARK(BM_CharsetConverterUtf8ToWBidi);
+
+static void BM_CharsetConverterUtf8ToUtf32(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    std::u32string str;
+    g_charsetConverter.utf8ToUtf32(cjk, str);
+    benchmark::DoNotOptimize(str);
+  }
+}
+BENCHMARK(BM_CharsetConverterUtf8ToUtf32);
+
+static void BM_CharsetConverterWToUTF8(benchmark::State& state)
+{
+  std::wstring wide;
+  g_charsetConverter.utf8ToW(latin, wide, false);
+  for (auto _ : state)
+  {
+    std::string str;
+    g_charsetConverter.wToUTF8(wide, str);
+    benchmark::DoNotOptimize(str);
+  }
+}
+BENCHMARK(BM_CharsetConverterWToUTF8);
+
+static void BM_CharsetConverterUtf8ToLatin1(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    std::string str;
+    g_charsetConverter.utf8To("ISO-8859-1", latin, str);
+    benchmark::DoNotOptimize(str);
+  }
+}
+BENCHMARK(BM_CharsetConverterUtf8ToLatin1);
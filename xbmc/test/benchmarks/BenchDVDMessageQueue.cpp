@@ -0,0 +1,58 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "cores/VideoPlayer/DVDDemuxers/DVDDemuxUtils.h"
+#include "cores/VideoPlayer/DVDMessageQueue.h"
+
+#include <benchmark/benchmark.h>
+
+#define PACKET_SIZE  (16 * 1024)
+
+static void BM_DVDMessageQueuePutGet(benchmark::State& state)
+{
+  CDVDMessageQueue queue("bench");
+  queue.Init();
+
+  // keep the queue about as full as the demuxer keeps it while playing
+  const int depth = state.range(0);
+  for (int i = 0; i < depth; i++)
+    queue.Put(new CDVDMsgDemuxerPacket(CDVDDemuxUtils::AllocateDemuxPacket(PACKET_SIZE)));
+
+  for (auto _ : state)
+  {
+    queue.Put(new CDVDMsgDemuxerPacket(CDVDDemuxUtils::AllocateDemuxPacket(PACKET_SIZE)));
+
+    CDVDMsg* msg = nullptr;
+    if (queue.Get(&msg, 0) == MSGQ_OK)
+      msg->Release();
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  queue.Flush();
+  queue.End();
+}
+BENCHMARK(BM_DVDMessageQueuePutGet)->Arg(0)->Arg(100);
+
+static void BM_DVDMessageQueuePutGetControl(benchmark::State& state)
+{
+  CDVDMessageQueue queue("bench");
+  queue.Init();
+
+  for (auto _ : state)
+  {
+    queue.Put(new CDVDMsgInt(CDVDMsg::PLAYER_SETSPEED, 1000), 1);
+
+    CDVDMsg* msg = nullptr;
+    if (queue.Get(&msg, 0) == MSGQ_OK)
+      msg->Release();
+  }
+  state.SetItemsProcessed(state.iterations());
+
+  queue.End();
+}
+BENCHMARK(BM_DVDMessageQueuePutGetControl);
@@ -0,0 +1,69 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/SortUtils.h"
+#include "utils/StringUtils.h"
+#include "utils/Variant.h"
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+SortItems GetItems(int count)
+{
+  static const char* const titles[] = { "The Matrix", "Alien", "A Beautiful Mind", "Blade Runner",
+                                        "Episode 10", "Episode 9", "Zodiac", "an Education" };
+  SortItems items;
+  items.reserve(count);
+  for (int i = 0; i < count; i++)
+  {
+    SortItemPtr item(new SortItem);
+    (*item)[FieldLabel] = StringUtils::Format("%s %d", titles[(i * 7) % 8], (i * 7919) % count);
+    (*item)[FieldYear] = 1950 + (i * 31) % 70;
+    items.push_back(item);
+  }
+  return items;
+}
+}
+
+static void BM_SortUtilsSortLabel(benchmark::State& state)
+{
+  const SortItems items = GetItems(state.range(0));
+
+  SortDescription sortDescription;
+  sortDescription.sortBy = SortByLabel;
+  sortDescription.sortAttributes = SortAttributeIgnoreArticle;
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    SortItems sorted(items);
+    state.ResumeTiming();
+    SortUtils::Sort(sortDescription, sorted);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SortUtilsSortLabel)->Arg(1000)->Arg(10000);
+
+static void BM_SortUtilsSortYearLimit(benchmark::State& state)
+{
+  const SortItems items = GetItems(state.range(0));
+
+  SortDescription sortDescription;
+  sortDescription.sortBy = SortByYear;
+  sortDescription.sortOrder = SortOrderDescending;
+  sortDescription.limitEnd = 50;
+  for (auto _ : state)
+  {
+    state.PauseTiming();
+    SortItems sorted(items);
+    state.ResumeTiming();
+    SortUtils::Sort(sortDescription, sorted);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SortUtilsSortYearLimit)->Arg(1000)->Arg(10000);
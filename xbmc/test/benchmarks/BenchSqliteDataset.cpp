@@ -0,0 +1,94 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "dbwrappers/sqlitedataset.h"
+#include "filesystem/SpecialProtocol.h"
+#include "utils/StringUtils.h"
+
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+// a reduced movie table of the video database, filled with count rows
+class CBenchDatabase
+{
+public:
+  explicit CBenchDatabase(int count)
+  {
+    m_db.setHostName(CSpecialProtocol::TranslatePath("special://temp/").c_str());
+    m_db.setDatabase("bench.db");
+    m_db.connect(true);
+
+    m_ds.reset(m_db.CreateDataset());
+    m_ds->exec("DROP TABLE IF EXISTS movie");
+    m_ds->exec("CREATE TABLE movie (idMovie INTEGER PRIMARY KEY, title TEXT, year INTEGER, rating REAL, idFile INTEGER)");
+    m_ds->exec("CREATE INDEX ix_movie_file ON movie (idFile)");
+
+    m_db.start_transaction();
+    for (int i = 0; i < count; i++)
+      m_ds->exec(m_db.prepare("INSERT INTO movie (title, year, rating, idFile) VALUES ('%s', %i, %f, %i)",
+                              StringUtils::Format("Movie title %d", i).c_str(), 1950 + i % 70, (i % 100) / 10.0, i));
+    m_db.commit_transaction();
+  }
+
+  ~CBenchDatabase()
+  {
+    m_ds.reset();
+    m_db.disconnect();
+  }
+
+  dbiplus::SqliteDatabase& Database() { return m_db; }
+  dbiplus::Dataset& Dataset() { return *m_ds; }
+
+private:
+  dbiplus::SqliteDatabase m_db;
+  std::unique_ptr<dbiplus::Dataset> m_ds;
+};
+}
+
+static void BM_SqliteDatasetQueryAll(benchmark::State& state)
+{
+  CBenchDatabase db(state.range(0));
+  dbiplus::Dataset& ds = db.Dataset();
+  for (auto _ : state)
+  {
+    int rows = 0;
+    if (ds.query("SELECT idMovie, title, year, rating FROM movie ORDER BY title"))
+    {
+      while (!ds.eof())
+      {
+        benchmark::DoNotOptimize(ds.fv(1).get_asString());
+        rows++;
+        ds.next();
+      }
+      ds.close();
+    }
+    benchmark::DoNotOptimize(rows);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_SqliteDatasetQueryAll)->Arg(1000)->Arg(10000);
+
+static void BM_SqliteDatasetQueryOne(benchmark::State& state)
+{
+  CBenchDatabase db(state.range(0));
+  dbiplus::Dataset& ds = db.Dataset();
+  int id = 0;
+  for (auto _ : state)
+  {
+    if (ds.query(db.Database().prepare("SELECT idMovie, title FROM movie WHERE idFile = %i", id)))
+    {
+      benchmark::DoNotOptimize(ds.fv(0).get_asInt());
+      ds.close();
+    }
+    id = (id + 7919) % state.range(0);
+  }
+}
+BENCHMARK(BM_SqliteDatasetQueryOne)->Arg(10000);
@@ -0,0 +1,80 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/StringUtils.h"
+
+#include <string>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+const std::string sentence = "The Quick Brown Fox Jumps Over The Lazy Dog, again and AGAIN / 1080p.x264-GROUP";
+}
+
+static void BM_StringUtilsToLower(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    std::string str(sentence);
+    StringUtils::ToLower(str);
+    benchmark::DoNotOptimize(str);
+  }
+}
+BENCHMARK(BM_StringUtilsToLower);
+
+static void BM_StringUtilsEqualsNoCase(benchmark::State& state)
+{
+  std::string other(sentence);
+  StringUtils::ToUpper(other);
+  for (auto _ : state)
+    benchmark::DoNotOptimize(StringUtils::EqualsNoCase(sentence, other));
+}
+BENCHMARK(BM_StringUtilsEqualsNoCase);
+
+static void BM_StringUtilsReplace(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    std::string str(sentence);
+    StringUtils::Replace(str, "again", "once more");
+    benchmark::DoNotOptimize(str);
+  }
+}
+BENCHMARK(BM_StringUtilsReplace);
+
+static void BM_StringUtilsSplitJoin(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    std::vector<std::string> words = StringUtils::Split(sentence, " ");
+    std::string str = StringUtils::Join(words, " / ");
+    benchmark::DoNotOptimize(str);
+  }
+}
+BENCHMARK(BM_StringUtilsSplitJoin);
+
+static void BM_StringUtilsFormat(benchmark::State& state)
+{
+  for (auto _ : state)
+  {
+    std::string str = StringUtils::Format("%s - S%02dE%02d - %s", "Show title", 3, 12, "Episode title");
+    benchmark::DoNotOptimize(str);
+  }
+}
+BENCHMARK(BM_StringUtilsFormat);
+
+static void BM_StringUtilsAlphaNumericCompare(benchmark::State& state)
+{
+  const std::wstring left = L"Episode 9 - Title";
+  const std::wstring right = L"Episode 10 - Title";
+  for (auto _ : state)
+    benchmark::DoNotOptimize(StringUtils::AlphaNumericCompare(left.c_str(), right.c_str()));
+}
+BENCHMARK(BM_StringUtilsAlphaNumericCompare);
@@ -0,0 +1,98 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/JSONVariantParser.h"
+#include "utils/JSONVariantWriter.h"
+#include "utils/StringUtils.h"
+#include "utils/Variant.h"
+
+#include <string>
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+// a result of VideoLibrary.GetMovies with the usual properties
+CVariant GetMovies(int count)
+{
+  CVariant result(CVariant::VariantTypeObject);
+  for (int i = 0; i < count; i++)
+  {
+    CVariant movie(CVariant::VariantTypeObject);
+    movie["movieid"] = i;
+    movie["label"] = StringUtils::Format("Movie title %d", i);
+    movie["year"] = 1950 + i % 70;
+    movie["rating"] = (i % 100) / 10.0;
+    movie["playcount"] = i % 3;
+    movie["file"] = StringUtils::Format("smb://server/movies/Movie title %d (%d)/movie.mkv", i, 1950 + i % 70);
+    movie["genre"].push_back("Drama");
+    movie["genre"].push_back("Thriller");
+    movie["art"]["poster"] = StringUtils::Format("image://smb%%3a%%2f%%2fserver%%2fmovies%%2f%d%%2fposter.jpg/", i);
+    movie["art"]["fanart"] = StringUtils::Format("image://smb%%3a%%2f%%2fserver%%2fmovies%%2f%d%%2ffanart.jpg/", i);
+    result["movies"].push_back(std::move(movie));
+  }
+  result["limits"]["start"] = 0;
+  result["limits"]["end"] = count;
+  result["limits"]["total"] = count;
+  return result;
+}
+}
+
+static void BM_VariantCopy(benchmark::State& state)
+{
+  const CVariant movies = GetMovies(state.range(0));
+  for (auto _ : state)
+  {
+    CVariant copy(movies);
+    benchmark::DoNotOptimize(copy);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_VariantCopy)->Arg(100)->Arg(2000);
+
+static void BM_JSONVariantWriter(benchmark::State& state)
+{
+  const CVariant movies = GetMovies(state.range(0));
+  for (auto _ : state)
+  {
+    std::string json;
+    CJSONVariantWriter::Write(movies, json, true);
+    benchmark::DoNotOptimize(json);
+  }
+  state.SetItemsProcessed(state.iterations() * state.range(0));
+}
+BENCHMARK(BM_JSONVariantWriter)->Arg(100)->Arg(2000);
+
+static void BM_JSONVariantParser(benchmark::State& state)
+{
+  std::string json;
+  CJSONVariantWriter::Write(GetMovies(state.range(0)), json, true);
+  for (auto _ : state)
+  {
+    CVariant parsed;
+    CJSONVariantParser::Parse(json, parsed);
+    benchmark::DoNotOptimize(parsed);
+  }
+  state.SetBytesProcessed(state.iterations() * json.size());
+}
+BENCHMARK(BM_JSONVariantParser)->Arg(100)->Arg(2000);
+
+static void BM_JSONVariantParserRequest(benchmark::State& state)
+{
+  const std::string json = "{\"jsonrpc\": \"2.0\", \"method\": \"VideoLibrary.GetMovies\", "
+                           "\"params\": {\"properties\": [\"title\", \"year\", \"rating\", \"art\"], "
+                           "\"limits\": {\"start\": 0, \"end\": 50}, "
+                           "\"sort\": {\"method\": \"label\", \"order\": \"ascending\"}}, \"id\": 1}";
+  for (auto _ : state)
+  {
+    CVariant parsed;
+    CJSONVariantParser::Parse(json, parsed);
+    benchmark::DoNotOptimize(parsed);
+  }
+}
+BENCHMARK(BM_JSONVariantParserRequest);
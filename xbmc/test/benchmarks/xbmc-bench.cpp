@@ -0,0 +1,30 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "test/TestBasicEnvironment.h"
+
+#include <cstdlib>
+#include <memory>
+
+#include <benchmark/benchmark.h>
+
+int main(int argc, char **argv)
+{
+  benchmark::Initialize(&argc, argv);
+  if (benchmark::ReportUnrecognizedArguments(argc, argv))
+    return EXIT_FAILURE;
+
+  // the same services and special paths as the test suite
+  std::unique_ptr<testing::Environment> environment(new TestBasicEnvironment());
+  environment->SetUp();
+
+  benchmark::RunSpecifiedBenchmarks();
+
+  environment->TearDown();
+  return EXIT_SUCCESS;
+}
@@ -9,6 +9,38 @@
 #pragma once
 
 #include "platform/RecursiveMutex.h"
+#include "threads/LockStats.h"
 #include "threads/Lockables.h"
 
-class CCriticalSection : public XbmcThreads::CountingLockable<XbmcThreads::CRecursiveMutex> {};
+class CCriticalSection : public XbmcThreads::CountingLockable<XbmcThreads::CRecursiveMutex>
+{
+public:
+  inline CCriticalSection() = default;
+
+  /**
+   * A critical section recording its contention, see XbmcThreads::CLockStats.
+   */
+  inline explicit CCriticalSection(const char* name) : m_stats(XbmcThreads::CLockStats::Register(name)) {}
+
+  inline void lock()
+  {
+    if (!m_stats)
+    {
+      CountingLockable::lock();
+      return;
+    }
+
+    if (!CountingLockable::try_lock())
+    {
+      auto start = std::chrono::steady_clock::now();
+      std::thread::id owner = m_owner;
+      CountingLockable::lock();
+      m_stats->Contended(start, owner);
+    }
+    m_owner = std::this_thread::get_id();
+  }
+
+private:
+  XbmcThreads::CLockStats::Entry* m_stats = nullptr;
+  std::atomic<std::thread::id> m_owner{std::thread::id()};
+};
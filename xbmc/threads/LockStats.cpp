@@ -0,0 +1,112 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "LockStats.h"
+
+#include "threads/SystemClock.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <inttypes.h>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+#define LOCKSTATS_LOG_INTERVAL_MS 60000
+#define LOCKSTATS_LOG_ENTRIES 20
+
+namespace
+{
+// not a CCriticalSection, those may be registering
+std::mutex& GetMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::map<std::string, std::unique_ptr<XbmcThreads::CLockStats::Entry>>& GetEntries()
+{
+  static std::map<std::string, std::unique_ptr<XbmcThreads::CLockStats::Entry>> entries;
+  return entries;
+}
+}
+
+namespace XbmcThreads
+{
+
+void CLockStats::Entry::Contended(std::chrono::steady_clock::time_point start, std::thread::id owner)
+{
+  uint64_t wait = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count();
+  contentions++;
+  waitTime += wait;
+  uint64_t max = maxWait;
+  while (wait > max && !maxWait.compare_exchange_weak(max, wait))
+    ;
+  holder = owner;
+}
+
+CLockStats::Entry* CLockStats::Register(const char* name)
+{
+  std::unique_lock<std::mutex> lock(GetMutex());
+  auto& entry = GetEntries()[name];
+  if (!entry)
+    entry.reset(new Entry(name));
+  return entry.get();
+}
+
+std::vector<CLockStats::Report> CLockStats::GetReport()
+{
+  std::vector<Report> report;
+  {
+    std::unique_lock<std::mutex> lock(GetMutex());
+    for (const auto& entry : GetEntries())
+    {
+      if (entry.second->contentions)
+        report.push_back({entry.first, entry.second->contentions, entry.second->waitTime,
+                          entry.second->maxWait, entry.second->holder});
+    }
+  }
+
+  std::sort(report.begin(), report.end(), [](const Report& a, const Report& b)
+  {
+    return a.waitTime > b.waitTime;
+  });
+  return report;
+}
+
+void CLockStats::Log()
+{
+  static unsigned int lastLog = 0;
+  static uint64_t lastContentions = 0;
+
+  unsigned int now = SystemClockMillis();
+  if (lastLog && now - lastLog < LOCKSTATS_LOG_INTERVAL_MS)
+    return;
+  lastLog = now;
+
+  std::vector<Report> report = GetReport();
+  uint64_t contentions = 0;
+  for (const auto& entry : report)
+    contentions += entry.contentions;
+  if (contentions == lastContentions)
+    return;
+  lastContentions = contentions;
+
+  CLog::Log(LOGDEBUG, "CLockStats - lock contention since startup:");
+  for (size_t i = 0; i < report.size() && i < LOCKSTATS_LOG_ENTRIES; ++i)
+  {
+    std::ostringstream holder;
+    holder << report[i].holder;
+    CLog::Log(LOGDEBUG, "CLockStats - %s: %" PRIu64 " waits, %" PRIu64 " ms total, %" PRIu64 " ms max, last holder thread %s",
+              report[i].name.c_str(), report[i].contentions, report[i].waitTime / 1000,
+              report[i].maxWait / 1000, holder.str().c_str());
+  }
+}
+
+}
@@ -0,0 +1,68 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace XbmcThreads
+{
+  /**
+   * Contention statistics of named locks (see CCriticalSection and CSharedSection).
+   *
+   * Locks created with a name record how often and how long threads had to wait
+   * for them, locks sharing a name share their statistics. Uncontended locking
+   * only costs a try_lock.
+   */
+  class CLockStats
+  {
+  public:
+    struct Entry
+    {
+      explicit Entry(const std::string& lockName) : name(lockName) {}
+
+      const std::string name;
+      std::atomic<uint64_t> contentions{0};
+      std::atomic<uint64_t> waitTime{0}; // us
+      std::atomic<uint64_t> maxWait{0}; // us
+      std::atomic<std::thread::id> holder{std::thread::id()}; // last thread that made others wait
+
+      void Contended(std::chrono::steady_clock::time_point start, std::thread::id owner);
+    };
+
+    struct Report
+    {
+      std::string name;
+      uint64_t contentions;
+      uint64_t waitTime; // us
+      uint64_t maxWait; // us
+      std::thread::id holder;
+    };
+
+    /**
+     * The statistics of the locks with the given name, entries live until exit.
+     */
+    static Entry* Register(const char* name);
+
+    /**
+     * All contended locks, the longest total wait first.
+     */
+    static std::vector<Report> GetReport();
+
+    /**
+     * Write the report to the debug log, at most once a minute and only if
+     * there was new contention since the last time.
+     */
+    static void Log();
+  };
+}
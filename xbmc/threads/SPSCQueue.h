@@ -0,0 +1,92 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+namespace XbmcThreads
+{
+  /**
+   * Bounded single-producer/single-consumer ring buffer.
+   *
+   * Push() must only ever be called from one thread at a time and Pop()/Front()/At()
+   * from one (other) thread at a time. Neither side takes a lock, the indices are
+   * published with acquire/release semantics. The capacity is rounded up to the
+   * next power of two.
+   */
+  template<typename T> class CSPSCQueue
+  {
+  public:
+    explicit CSPSCQueue(size_t capacity = 1024)
+    {
+      size_t size = 2;
+      while (size < capacity)
+        size <<= 1;
+      m_buffer.resize(size);
+      m_mask = size - 1;
+    }
+
+    CSPSCQueue(const CSPSCQueue&) = delete;
+    CSPSCQueue& operator=(const CSPSCQueue&) = delete;
+
+    /*! \brief producer side, returns false if the ring is full */
+    bool Push(const T& item)
+    {
+      const size_t write = m_write.load(std::memory_order_relaxed);
+      if (write - m_read.load(std::memory_order_acquire) > m_mask)
+        return false;
+
+      m_buffer[write & m_mask] = item;
+      // seq_cst so that a consumer announcing that it goes to sleep can't miss this item
+      m_write.store(write + 1, std::memory_order_seq_cst);
+      return true;
+    }
+
+    /*! \brief consumer side, returns false if the ring is empty */
+    bool Pop(T& item)
+    {
+      const size_t read = m_read.load(std::memory_order_relaxed);
+      if (read == m_write.load(std::memory_order_acquire))
+        return false;
+
+      item = m_buffer[read & m_mask];
+      m_buffer[read & m_mask] = T();
+      m_read.store(read + 1, std::memory_order_release);
+      return true;
+    }
+
+    /*! \brief consumer side, access the n-th oldest item. n must be below Size() */
+    const T& At(size_t n) const
+    {
+      return m_buffer[(m_read.load(std::memory_order_relaxed) + n) & m_mask];
+    }
+
+    /*! \brief consumer side, access the oldest item. The ring must not be empty */
+    const T& Front() const { return At(0); }
+
+    /*! \brief exact on the consumer side, a snapshot anywhere else */
+    size_t Size() const
+    {
+      return m_write.load(std::memory_order_acquire) - m_read.load(std::memory_order_acquire);
+    }
+
+    bool Empty() const { return Size() == 0; }
+    size_t Capacity() const { return m_mask + 1; }
+
+  private:
+    std::vector<T> m_buffer;
+    size_t m_mask;
+
+    // keep the indices on separate cache lines, they are written by different threads
+    alignas(64) std::atomic<size_t> m_write{0};
+    alignas(64) std::atomic<size_t> m_read{0};
+  };
+}
@@ -10,6 +10,7 @@
 
 #include "threads/Condition.h"
 #include "threads/Helpers.h"
+#include "threads/LockStats.h"
 #include "threads/SingleLock.h"
 
 /**
@@ -23,14 +24,51 @@ class CSharedSection
 
   unsigned int sharedCount = 0;
 
+  XbmcThreads::CLockStats::Entry* stats = nullptr;
+  std::atomic<std::thread::id> owner{std::thread::id()};
+
+  inline void lockExclusive() { CSingleLock l(sec); while (sharedCount) cond.wait(l); sec.lock(); }
+  inline void lockShared() { CSingleLock l(sec); sharedCount++; }
+
 public:
   inline CSharedSection() : cond(actualCv,XbmcThreads::InversePredicate<unsigned int&>(sharedCount)) {}
 
-  inline void lock() { CSingleLock l(sec); while (sharedCount) cond.wait(l); sec.lock(); }
+  /**
+   * A shared section recording its contention, see XbmcThreads::CLockStats.
+   * Waiting for shared access is only recorded while the section is held exclusively.
+   */
+  inline explicit CSharedSection(const char* name) : CSharedSection() { stats = XbmcThreads::CLockStats::Register(name); }
+
+  inline void lock()
+  {
+    if (!stats)
+      return lockExclusive();
+
+    if (!try_lock())
+    {
+      auto start = std::chrono::steady_clock::now();
+      std::thread::id holder = owner;
+      lockExclusive();
+      stats->Contended(start, holder);
+    }
+    owner = std::this_thread::get_id();
+  }
   inline bool try_lock() { return (sec.try_lock() ? ((sharedCount == 0) ? true : (sec.unlock(), false)) : false); }
   inline void unlock() { sec.unlock(); }
 
-  inline void lock_shared() { CSingleLock l(sec); sharedCount++; }
+  inline void lock_shared()
+  {
+    if (!stats)
+      return lockShared();
+
+    if (!try_lock_shared())
+    {
+      auto start = std::chrono::steady_clock::now();
+      std::thread::id holder = owner;
+      lockShared();
+      stats->Contended(start, holder);
+    }
+  }
   inline bool try_lock_shared() { return (sec.try_lock() ? sharedCount++, sec.unlock(), true : false); }
   inline void unlock_shared() { CSingleLock l(sec); sharedCount--; if (!sharedCount) { cond.notifyAll(); } }
 };
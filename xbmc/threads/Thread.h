@@ -42,6 +42,7 @@ public:
   bool IsRunning() const;
 
   bool IsCurrentThread() const;
+  const std::string& GetName() const { return m_ThreadName; }
   bool Join(unsigned int milliseconds);
 
   inline static const std::thread::id GetCurrentThreadId()
@@ -58,6 +59,9 @@ public:
   static std::uintptr_t GetCurrentThreadNativeHandle();
   static uint64_t GetCurrentThreadNativeId();
 
+  // Switch the calling thread to realtime scheduling, meant for threads that feed audio hardware
+  static bool SetCurrentThreadRealtime();
+
   // Get and set the thread's priority
   int GetPriority(void);
   bool SetPriority(const int iPriority);
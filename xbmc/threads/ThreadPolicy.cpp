@@ -0,0 +1,93 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "ThreadPolicy.h"
+
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+#include "utils/StringUtils.h"
+
+#include <algorithm>
+#include <stdlib.h>
+
+using namespace XbmcThreads;
+
+namespace
+{
+
+CCriticalSection& PolicySection()
+{
+  static CCriticalSection section;
+  return section;
+}
+
+std::vector<ThreadPolicy>& Policies()
+{
+  static std::vector<ThreadPolicy> policies;
+  return policies;
+}
+
+bool ParseCore(const std::string& str, int& core)
+{
+  std::string trimmed = str;
+  StringUtils::Trim(trimmed);
+  if (trimmed.empty() || !StringUtils::IsNaturalNumber(trimmed))
+    return false;
+  core = atoi(trimmed.c_str());
+  return true;
+}
+
+} // namespace
+
+void CThreadPolicies::Set(std::vector<ThreadPolicy> policies)
+{
+  CSingleLock lock(PolicySection());
+  Policies() = std::move(policies);
+}
+
+bool CThreadPolicies::Get(const std::string& threadName, ThreadPolicy& policy)
+{
+  CSingleLock lock(PolicySection());
+
+  const ThreadPolicy* match = nullptr;
+  for (const auto& candidate : Policies())
+  {
+    if (!StringUtils::StartsWith(threadName, candidate.role))
+      continue;
+    if (!match || candidate.role.size() > match->role.size())
+      match = &candidate;
+  }
+
+  if (!match)
+    return false;
+
+  policy = *match;
+  return true;
+}
+
+bool CThreadPolicies::ParseCores(const std::string& list, std::vector<int>& cores)
+{
+  cores.clear();
+  for (const auto& range : StringUtils::Split(list, ','))
+  {
+    std::vector<std::string> bounds = StringUtils::Split(range, '-');
+    int first, last;
+    if (bounds.size() == 1 && ParseCore(bounds[0], first))
+      last = first;
+    else if (bounds.size() != 2 || !ParseCore(bounds[0], first) || !ParseCore(bounds[1], last) ||
+             last < first)
+      return false;
+
+    for (int core = first; core <= last; core++)
+      cores.push_back(core);
+  }
+
+  std::sort(cores.begin(), cores.end());
+  cores.erase(std::unique(cores.begin(), cores.end()), cores.end());
+  return !cores.empty();
+}
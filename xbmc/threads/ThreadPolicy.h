@@ -0,0 +1,58 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+namespace XbmcThreads
+{
+  /**
+   * Where and how urgently threads of a role run.
+   *
+   * A role is matched against the thread name by prefix, so "JobWorker"
+   * covers all job workers and "VideoPlayer" the player as well as its
+   * audio and video threads. The longest matching role wins.
+   */
+  struct ThreadPolicy
+  {
+    std::string role;
+    std::vector<int> cores; // empty leaves the affinity alone
+    bool hasPriority = false;
+    int priority = 0; // relative, see CThread::SetPriority
+  };
+
+  /**
+   * The thread policies configured in advancedsettings.xml:
+   *
+   *   <threads>
+   *     <thread role="AESink" cores="4-5" priority="1"/>
+   *     <thread role="JobWorker" cores="0-3" priority="-1"/>
+   *   </threads>
+   *
+   * Policies are applied when a CThread starts, the priority of a policy
+   * also overrides what the thread asks for with SetPriority().
+   */
+  class CThreadPolicies
+  {
+  public:
+    static void Set(std::vector<ThreadPolicy> policies);
+
+    /**
+     * \return false if no policy applies to the thread
+     */
+    static bool Get(const std::string& threadName, ThreadPolicy& policy);
+
+    /**
+     * Parse a core list like "0-3,6".
+     * \return false if the list is malformed
+     */
+    static bool ParseCores(const std::string& list, std::vector<int>& cores);
+  };
+}
@@ -12,6 +12,7 @@
 #else
 #include <sys/syscall.h>
 #endif
+#include <sched.h>
 #include <sys/resource.h>
 #include <string.h>
 #ifdef TARGET_FREEBSD
@@ -20,8 +21,19 @@
 #endif
 
 #include <signal.h>
+#include "threads/ThreadPolicy.h"
 #include "utils/log.h"
 
+#if defined(TARGET_LINUX) && defined(HAS_DBUS)
+#include "platform/linux/DBusMessage.h"
+#include "platform/linux/DBusUtil.h"
+#endif
+
+// low end of the realtime range, that is what rtkit grants by default as well
+static const int REALTIME_PRIORITY = 10;
+// max time a realtime thread may run without blocking, rtkit requires this limit
+static const rlim_t REALTIME_MAX_RUNTIME_USEC = 200000;
+
 namespace XbmcThreads
 {
 // ==========================================================
@@ -128,6 +140,28 @@ void CThread::SetThreadInfo()
       CLog::Log(LOGERROR, "%s: error %s", __FUNCTION__, strerror(errno));
   }
 #endif
+
+  XbmcThreads::ThreadPolicy policy;
+  if (!XbmcThreads::CThreadPolicies::Get(m_ThreadName, policy))
+    return;
+
+#if defined(TARGET_LINUX) || defined(TARGET_ANDROID)
+  if (!policy.cores.empty())
+  {
+    cpu_set_t cpuset;
+    CPU_ZERO(&cpuset);
+    for (int core : policy.cores)
+    {
+      if (core < CPU_SETSIZE)
+        CPU_SET(core, &cpuset);
+    }
+    if (sched_setaffinity(m_lwpId, sizeof(cpuset), &cpuset) != 0)
+      CLog::Log(LOGERROR, "%s: unable to set affinity of %s: %s", __FUNCTION__, m_ThreadName.c_str(), strerror(errno));
+  }
+#endif
+
+  if (policy.hasPriority)
+    SetPriority(policy.priority);
 }
 
 std::uintptr_t CThread::GetCurrentThreadNativeHandle()
@@ -144,6 +178,53 @@ uint64_t CThread::GetCurrentThreadNativeId()
   return static_cast<uint64_t>(GetCurrentThreadPid_());
 }
 
+bool CThread::SetCurrentThreadRealtime()
+{
+  int priority = REALTIME_PRIORITY;
+#ifdef RLIMIT_RTPRIO
+  // without CAP_SYS_NICE the priority must not exceed the limit of the user
+  struct rlimit limit;
+  if (getrlimit(RLIMIT_RTPRIO, &limit) == 0 && limit.rlim_cur != RLIM_INFINITY)
+    priority = std::min(priority, static_cast<int>(limit.rlim_cur));
+#endif
+
+  int result = EPERM;
+  if (priority > 0)
+  {
+    struct sched_param param = {};
+    param.sched_priority = priority;
+    result = pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+    if (result == 0)
+    {
+      CLog::Log(LOGNOTICE, "%s: realtime priority %d", __FUNCTION__, priority);
+      return true;
+    }
+  }
+
+#if defined(TARGET_LINUX) && defined(HAS_DBUS)
+  // ask rtkit, that is how desktop systems hand out realtime to unprivileged users
+  struct rlimit rttime;
+  rttime.rlim_cur = rttime.rlim_max = REALTIME_MAX_RUNTIME_USEC;
+  setrlimit(RLIMIT_RTTIME, &rttime);
+
+  CDBusMessage message("org.freedesktop.RealtimeKit1", "/org/freedesktop/RealtimeKit1",
+                       "org.freedesktop.RealtimeKit1", "MakeThreadRealtime");
+  message.AppendArguments(static_cast<std::uint64_t>(GetCurrentThreadPid_()),
+                          static_cast<std::uint32_t>(REALTIME_PRIORITY));
+  CDBusError error;
+  if (message.SendSystem(error))
+  {
+    CLog::Log(LOGNOTICE, "%s: realtime priority %d granted by rtkit", __FUNCTION__, REALTIME_PRIORITY);
+    return true;
+  }
+  CLog::Log(LOGWARNING, "%s: rtkit refused realtime priority: %s", __FUNCTION__, error.Message().c_str());
+#else
+  CLog::Log(LOGWARNING, "%s: unable to set realtime priority: %s", __FUNCTION__, strerror(result));
+#endif
+
+  return false;
+}
+
 int CThread::GetMinPriority(void)
 {
   // one level lower than application
@@ -180,6 +261,9 @@ bool CThread::SetPriority(const int iPriority)
 
     // keep priority in bounds
     int prio = iPriority;
+    XbmcThreads::ThreadPolicy policy;
+    if (XbmcThreads::CThreadPolicies::Get(m_ThreadName, policy) && policy.hasPriority)
+      prio = policy.priority;
     if (prio >= GetMaxPriority())
       prio = userMaxPrio; // this is already the min of GetMaxPriority and what the user can set.
     if (prio < GetMinPriority())
@@ -6,12 +6,16 @@
  *  See LICENSES/README.md for more information.
  */
 
+#include "threads/ThreadPolicy.h"
 #include "utils/log.h"
 
 #include "platform/win32/WIN32Util.h"
 
 #include <process.h>
 #include <windows.h>
+#ifdef TARGET_WINDOWS_DESKTOP
+#include <avrt.h>
+#endif
 
 void CThread::SetThreadInfo()
 {
@@ -43,6 +47,25 @@ void CThread::SetThreadInfo()
   }
 
   CWIN32Util::SetThreadLocalLocale(true); // avoid crashing with setlocale(), see https://connect.microsoft.com/VisualStudio/feedback/details/794122
+
+  XbmcThreads::ThreadPolicy policy;
+  if (!XbmcThreads::CThreadPolicies::Get(m_ThreadName, policy))
+    return;
+
+  if (!policy.cores.empty())
+  {
+    DWORD_PTR mask = 0;
+    for (int core : policy.cores)
+    {
+      if (core < static_cast<int>(sizeof(mask) * 8))
+        mask |= static_cast<DWORD_PTR>(1) << core;
+    }
+    if (!mask || !SetThreadAffinityMask(m_lwpId, mask))
+      CLog::Log(LOGERROR, "%s: unable to set affinity of %s", __FUNCTION__, m_ThreadName.c_str());
+  }
+
+  if (policy.hasPriority)
+    SetPriority(policy.priority);
 }
 
 std::uintptr_t CThread::GetCurrentThreadNativeHandle()
@@ -55,6 +78,23 @@ uint64_t CThread::GetCurrentThreadNativeId()
   return static_cast<uint64_t>(::GetCurrentThreadId());
 }
 
+bool CThread::SetCurrentThreadRealtime()
+{
+#ifdef TARGET_WINDOWS_DESKTOP
+  // let the multimedia class scheduler boost the thread, the way pro audio applications do
+  DWORD taskIndex = 0;
+  if (AvSetMmThreadCharacteristicsW(L"Pro Audio", &taskIndex))
+  {
+    CLog::Log(LOGNOTICE, "%s: registered with MMCSS as Pro Audio", __FUNCTION__);
+    return true;
+  }
+  CLog::Log(LOGWARNING, "%s: unable to register with MMCSS, error %lu", __FUNCTION__, GetLastError());
+  return false;
+#else
+  return ::SetThreadPriority(::GetCurrentThread(), THREAD_PRIORITY_TIME_CRITICAL) == TRUE;
+#endif
+}
+
 int CThread::GetMinPriority(void)
 {
   return(THREAD_PRIORITY_IDLE);
@@ -74,9 +114,14 @@ bool CThread::SetPriority(const int iPriority)
 {
   bool bReturn = false;
 
+  int prio = iPriority;
+  XbmcThreads::ThreadPolicy policy;
+  if (XbmcThreads::CThreadPolicies::Get(m_ThreadName, policy) && policy.hasPriority)
+    prio = policy.priority;
+
   CSingleLock lock(m_CriticalSection);
   if (m_thread)
-    bReturn = SetThreadPriority(m_lwpId, iPriority) == TRUE;
+    bReturn = SetThreadPriority(m_lwpId, prio) == TRUE;
 
   return bReturn;
 }
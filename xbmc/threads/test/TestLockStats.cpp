@@ -0,0 +1,48 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/LockStats.h"
+#include "threads/SingleLock.h"
+
+#include <algorithm>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+uint64_t GetContentions(const std::string& name)
+{
+  std::vector<XbmcThreads::CLockStats::Report> report = XbmcThreads::CLockStats::GetReport();
+  auto it = std::find_if(report.begin(), report.end(),
+                         [&name](const XbmcThreads::CLockStats::Report& entry) { return entry.name == name; });
+  return it == report.end() ? 0 : it->contentions;
+}
+}
+
+TEST(TestLockStats, RecordsContention)
+{
+  CCriticalSection section("TestLockStats");
+  CEvent waiting;
+
+  CSingleLock lock(section);
+  std::thread thread([&section, &waiting]()
+  {
+    waiting.Set();
+    CSingleLock lock(section);
+  });
+
+  waiting.Wait();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  lock.Leave();
+  thread.join();
+
+  EXPECT_EQ(1u, GetContentions("TestLockStats"));
+}
@@ -0,0 +1,91 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "threads/IRunnable.h"
+#include "threads/SPSCQueue.h"
+#include "threads/test/TestHelpers.h"
+
+using namespace XbmcThreads;
+
+namespace
+{
+const int ITEMS = 100000;
+
+class producer : public IRunnable
+{
+  CSPSCQueue<int>& queue;
+public:
+  explicit producer(CSPSCQueue<int>& o) : queue(o) {}
+
+  void Run() override
+  {
+    for (int i = 1; i <= ITEMS; i++)
+    {
+      while (!queue.Push(i))
+        SleepMillis(0);
+    }
+  }
+};
+}
+
+TEST(TestSPSCQueue, Capacity)
+{
+  CSPSCQueue<int> queue(5);
+  EXPECT_EQ(8U, queue.Capacity());
+  EXPECT_TRUE(queue.Empty());
+}
+
+TEST(TestSPSCQueue, PushPop)
+{
+  CSPSCQueue<int> queue(4);
+  int value = 0;
+
+  EXPECT_FALSE(queue.Pop(value));
+
+  for (int i = 0; i < 4; i++)
+    EXPECT_TRUE(queue.Push(i));
+  EXPECT_FALSE(queue.Push(4));
+  EXPECT_EQ(4U, queue.Size());
+  EXPECT_EQ(0, queue.Front());
+  EXPECT_EQ(3, queue.At(3));
+
+  for (int i = 0; i < 4; i++)
+  {
+    EXPECT_TRUE(queue.Pop(value));
+    EXPECT_EQ(i, value);
+  }
+  EXPECT_TRUE(queue.Empty());
+
+  // wrap around
+  EXPECT_TRUE(queue.Push(42));
+  EXPECT_TRUE(queue.Pop(value));
+  EXPECT_EQ(42, value);
+}
+
+TEST(TestSPSCQueue, ProducerConsumer)
+{
+  CSPSCQueue<int> queue(64);
+  producer p(queue);
+  thread t(p);
+
+  int expected = 1;
+  int value = 0;
+  while (expected <= ITEMS)
+  {
+    if (queue.Pop(value))
+    {
+      ASSERT_EQ(expected, value);
+      expected++;
+    }
+    else
+      SleepMillis(0);
+  }
+
+  t.join();
+  EXPECT_TRUE(queue.Empty());
+}
@@ -0,0 +1,53 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "threads/ThreadPolicy.h"
+
+#include <gtest/gtest.h>
+
+using namespace XbmcThreads;
+
+TEST(TestThreadPolicy, ParseCores)
+{
+  std::vector<int> cores;
+  EXPECT_TRUE(CThreadPolicies::ParseCores("4-5", cores));
+  EXPECT_EQ(std::vector<int>({4, 5}), cores);
+
+  EXPECT_TRUE(CThreadPolicies::ParseCores("0-2, 6,1", cores));
+  EXPECT_EQ(std::vector<int>({0, 1, 2, 6}), cores);
+
+  EXPECT_FALSE(CThreadPolicies::ParseCores("", cores));
+  EXPECT_FALSE(CThreadPolicies::ParseCores("3-1", cores));
+  EXPECT_FALSE(CThreadPolicies::ParseCores("big", cores));
+}
+
+TEST(TestThreadPolicy, LongestRoleWins)
+{
+  ThreadPolicy player;
+  player.role = "VideoPlayer";
+  player.cores = {0, 1};
+  ThreadPolicy audio;
+  audio.role = "VideoPlayerAudio";
+  audio.cores = {4};
+  audio.hasPriority = true;
+  audio.priority = 1;
+  CThreadPolicies::Set({player, audio});
+
+  ThreadPolicy policy;
+  EXPECT_TRUE(CThreadPolicies::Get("VideoPlayerVideo", policy));
+  EXPECT_EQ("VideoPlayer", policy.role);
+  EXPECT_FALSE(policy.hasPriority);
+
+  EXPECT_TRUE(CThreadPolicies::Get("VideoPlayerAudio", policy));
+  EXPECT_EQ(std::vector<int>({4}), policy.cores);
+  EXPECT_EQ(1, policy.priority);
+
+  EXPECT_FALSE(CThreadPolicies::Get("JobWorker", policy));
+
+  CThreadPolicies::Set({});
+}
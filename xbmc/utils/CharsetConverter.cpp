@@ -18,6 +18,8 @@
 #include "utils/Utf8Utils.h"
 
 #include <algorithm>
+#include <cstring>
+#include <stdint.h>
 
 #include <fribidi.h>
 #include <iconv.h>
@@ -306,6 +308,109 @@ CConverterType CCharsetConverter::CInnerConverter::m_stdConversion[NumberOfStdCo
 
 CCriticalSection CCharsetConverter::CInnerConverter::m_critSectionFriBiDi;
 
+/* Decode UTF-8 to code points without going through iconv and its lock.
+   Returns false for anything but valid UTF-8, which is then left to iconv
+   and its handling of invalid chars. UTF-8-MAC input also composes
+   decomposed chars, so only plain ASCII is decoded here for it. */
+template<class OUTPUT>
+static bool decodeUtf8(const std::string& strSource, OUTPUT& strDest)
+{
+  const unsigned char* s = reinterpret_cast<const unsigned char*>(strSource.data());
+  const unsigned char* const end = s + strSource.size();
+
+  strDest.reserve(strSource.size());
+  while (s < end)
+  {
+    // runs of ASCII are checked 8 bytes at a time
+    uint64_t block;
+    if (end - s >= 8 && (std::memcpy(&block, s, 8), (block & UINT64_C(0x8080808080808080)) == 0))
+    {
+      strDest.append(s, s + 8);
+      s += 8;
+      continue;
+    }
+
+    uint32_t c = *s++;
+    if (c < 0x80)
+    {
+      strDest.push_back(c);
+      continue;
+    }
+#if defined(TARGET_DARWIN)
+    return false;
+#else
+    int extra;
+    uint32_t min;
+    if ((c & 0xE0) == 0xC0)
+    {
+      c &= 0x1F;
+      extra = 1;
+      min = 0x80;
+    }
+    else if ((c & 0xF0) == 0xE0)
+    {
+      c &= 0x0F;
+      extra = 2;
+      min = 0x800;
+    }
+    else if ((c & 0xF8) == 0xF0)
+    {
+      c &= 0x07;
+      extra = 3;
+      min = 0x10000;
+    }
+    else
+      return false;
+
+    if (end - s < extra)
+      return false;
+    for (int i = 0; i < extra; i++, s++)
+    {
+      if ((*s & 0xC0) != 0x80)
+        return false;
+      c = (c << 6) | (*s & 0x3F);
+    }
+
+    // overlong forms, surrogates and values beyond Unicode are invalid
+    if (c < min || (c >= 0xD800 && c <= 0xDFFF) || c > 0x10FFFF)
+      return false;
+    // wchar_t is UTF-16 on some platforms
+    if (sizeof(typename OUTPUT::value_type) < 4 && c > 0xFFFF)
+      return false;
+
+    strDest.push_back(static_cast<typename OUTPUT::value_type>(c));
+#endif
+  }
+
+  return true;
+}
+
+template<class INPUT,class OUTPUT>
+static bool fastConvert(StdConversionType convertType, const INPUT& strSource, OUTPUT& strDest)
+{
+  return false;
+}
+
+static bool fastConvert(StdConversionType convertType, const std::string& strSource, std::u32string& strDest)
+{
+  if (convertType != Utf8ToUtf32)
+    return false;
+  if (decodeUtf8(strSource, strDest))
+    return true;
+  strDest.clear();
+  return false;
+}
+
+static bool fastConvert(StdConversionType convertType, const std::string& strSource, std::wstring& strDest)
+{
+  if (convertType != Utf8toW)
+    return false;
+  if (decodeUtf8(strSource, strDest))
+    return true;
+  strDest.clear();
+  return false;
+}
+
 template<class INPUT,class OUTPUT>
 bool CCharsetConverter::CInnerConverter::stdConvert(StdConversionType convertType, const INPUT& strSource, OUTPUT& strDest, bool failOnInvalidChar /*= false*/)
 {
@@ -316,6 +421,9 @@ bool CCharsetConverter::CInnerConverter::stdConvert(StdConversionType convertTyp
   if (convertType < 0 || convertType >= NumberOfStdConversionTypes)
     return false;
 
+  if (fastConvert(convertType, strSource, strDest))
+    return true;
+
   CConverterType& convType = m_stdConversion[convertType];
   CSingleLock converterLock(convType);
 
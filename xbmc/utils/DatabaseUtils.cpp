@@ -10,6 +10,7 @@
 
 #include "dbwrappers/dataset.h"
 #include "music/MusicDatabase.h"
+#include "utils/SortUtils.h"
 #include "utils/StringUtils.h"
 #include "utils/Variant.h"
 #include "utils/log.h"
@@ -466,6 +467,41 @@ std::string DatabaseUtils::BuildLimitClause(int end, int start /* = 0 */)
   return sql.str();
 }
 
+std::string DatabaseUtils::BuildOrderByClause(const SortDescription &sorting, const MediaType &mediaType)
+{
+  const std::string order = sorting.sortOrder == SortOrderDescending ? " DESC" : " ASC";
+  const std::string id = GetField(FieldId, mediaType, DatabaseQueryPartOrderBy);
+
+  switch (sorting.sortBy)
+  {
+    case SortByDateAdded:
+    {
+      // sorted as "<dateadded> <id>"
+      const std::string dateAdded = GetField(FieldDateAdded, mediaType, DatabaseQueryPartOrderBy);
+      if (dateAdded.empty() || id.empty())
+        return "";
+      return " ORDER BY " + dateAdded + order + ", " + id + order;
+    }
+
+    case SortByLastPlayed:
+    {
+      // without the label the stable sort keeps ties in the order the rows were returned in
+      const std::string lastPlayed = GetField(FieldLastPlayed, mediaType, DatabaseQueryPartOrderBy);
+      if (!(sorting.sortAttributes & SortAttributeIgnoreLabel) || lastPlayed.empty() || id.empty())
+        return "";
+      return " ORDER BY " + lastPlayed + order + ", " + id + " ASC";
+    }
+
+    case SortByRandom:
+      return " ORDER BY " + GetField(FieldRandom, mediaType, DatabaseQueryPartOrderBy);
+
+    default:
+      break;
+  }
+
+  return "";
+}
+
 int DatabaseUtils::GetField(Field field, const MediaType &mediaType, bool asIndex)
 {
   if (field == FieldNone || mediaType == MediaTypeNone)
@@ -17,6 +17,7 @@
 #include <vector>
 
 class CVariant;
+struct SortDescription;
 
 namespace dbiplus
 {
@@ -162,6 +163,15 @@ public:
 
   static std::string BuildLimitClause(int end, int start = 0);
 
+  /*!
+   * \brief Build an ORDER BY clause that returns the rows in the order SortUtils would sort them
+   *
+   * Only sort methods whose in-memory order can be reproduced exactly by the database are
+   * supported, anything compared as a label (natural ordering, ignored articles) is not.
+   * \return the clause or an empty string if the sorting has to be done in memory
+   */
+  static std::string BuildOrderByClause(const SortDescription &sorting, const MediaType &mediaType);
+
 private:
   static int GetField(Field field, const MediaType &mediaType, bool asIndex);
 };
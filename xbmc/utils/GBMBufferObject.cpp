@@ -12,6 +12,7 @@
 #include "windowing/gbm/WinSystemGbmEGLContext.h"
 
 #include <gbm.h>
+#include <unistd.h>
 
 using namespace KODI::WINDOWING::GBM;
 
@@ -44,15 +45,34 @@ bool CGBMBufferObject::CreateBufferObject(int width, int height)
 
 void CGBMBufferObject::DestroyBufferObject()
 {
+  if (m_fd >= 0)
+  {
+    close(m_fd);
+    m_fd = -1;
+  }
+
   if (m_bo)
+  {
     gbm_bo_destroy(m_bo);
+    m_bo = nullptr;
+  }
 }
 
 uint8_t* CGBMBufferObject::GetMemory()
+{
+  return Map(GBM_BO_TRANSFER_WRITE);
+}
+
+uint8_t* CGBMBufferObject::GetMemoryReadWrite()
+{
+  return Map(GBM_BO_TRANSFER_READ_WRITE);
+}
+
+uint8_t* CGBMBufferObject::Map(uint32_t flags)
 {
   if (m_bo)
   {
-    m_map = static_cast<uint8_t*>(gbm_bo_map(m_bo, 0, 0, m_width, m_height, GBM_BO_TRANSFER_WRITE, &m_stride, &m_map_data));
+    m_map = static_cast<uint8_t*>(gbm_bo_map(m_bo, 0, 0, m_width, m_height, flags, &m_stride, &m_map_data));
     if (m_map)
       return m_map;
   }
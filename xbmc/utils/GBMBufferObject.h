@@ -24,12 +24,19 @@ public:
   bool CreateBufferObject(int width, int height) override;
   void DestroyBufferObject() override;
   uint8_t* GetMemory() override;
+  /*!
+   * \brief Map the buffer for reading too, e.g. for a decoder that reads back
+   *        its reference frames
+   */
+  uint8_t* GetMemoryReadWrite();
   void ReleaseMemory() override;
   int GetFd() override;
   int GetStride() override;
   uint64_t GetModifier();
 
 private:
+  uint8_t* Map(uint32_t flags);
+
   gbm_device *m_device = nullptr;
 
   int m_format = 0;
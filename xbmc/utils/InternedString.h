@@ -0,0 +1,140 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+struct StringListHash
+{
+  size_t operator()(const std::vector<std::string>& list) const
+  {
+    size_t hash = list.size();
+    for (const auto& str : list)
+      hash = hash * 31 + std::hash<std::string>()(str);
+    return hash;
+  }
+};
+
+/*!
+ \brief An immutable value shared by all holders of an equal value.
+
+ Equal values are stored once in a pool of their type and dropped from it
+ with their last holder, so many objects carrying the same text (titles,
+ genres and cast of a guide for example) hold a pointer each instead of a
+ copy. As equal values share their storage, comparing is comparing
+ pointers. An empty value takes no storage.
+ */
+template<typename T, typename Hash = std::hash<T>>
+class CInterned
+{
+public:
+  CInterned() = default;
+  CInterned(const T& value) : m_value(Intern(value)) {}
+
+  //! from anything a T can be made of, like a const char* for a string
+  template<typename U,
+           typename = typename std::enable_if<
+             !std::is_same<typename std::decay<U>::type, CInterned>::value &&
+             !std::is_same<typename std::decay<U>::type, T>::value &&
+             std::is_constructible<T, U>::value>::type>
+  CInterned(U&& value) : m_value(Intern(T(std::forward<U>(value)))) {}
+
+  const T& Get() const { return m_value ? *m_value : Empty(); }
+  operator const T&() const { return Get(); }
+  bool empty() const { return !m_value; }
+
+  bool operator==(const CInterned& other) const { return m_value == other.m_value; }
+  bool operator!=(const CInterned& other) const { return m_value != other.m_value; }
+
+  //! hashes which value is held, for maps keyed by interned values
+  struct IdentityHash
+  {
+    size_t operator()(const CInterned& value) const
+    {
+      return std::hash<const T*>()(value.m_value.get());
+    }
+  };
+
+private:
+  struct ValueHash
+  {
+    size_t operator()(const T* value) const { return Hash()(*value); }
+  };
+
+  struct ValueEqual
+  {
+    bool operator()(const T* a, const T* b) const { return *a == *b; }
+  };
+
+  struct Pool
+  {
+    CCriticalSection section;
+    std::unordered_map<const T*, std::weak_ptr<const T>, ValueHash, ValueEqual> values;
+  };
+
+  static Pool& GetPool()
+  {
+    // never destroyed, values may outlive static destruction
+    static Pool* pool = new Pool;
+    return *pool;
+  }
+
+  static const T& Empty()
+  {
+    static const T* empty = new T();
+    return *empty;
+  }
+
+  static std::shared_ptr<const T> Intern(const T& value)
+  {
+    if (value.empty())
+      return nullptr;
+
+    Pool& pool = GetPool();
+    CSingleLock lock(pool.section);
+
+    auto it = pool.values.find(&value);
+    if (it != pool.values.end())
+    {
+      std::shared_ptr<const T> shared = it->second.lock();
+      if (shared)
+        return shared;
+      // its last holder is gone, the deleter waits for the lock to drop it
+      pool.values.erase(it);
+    }
+
+    std::shared_ptr<const T> shared(new T(value), [](const T* stored)
+    {
+      Pool& pool = GetPool();
+      {
+        CSingleLock lock(pool.section);
+        auto it = pool.values.find(stored);
+        if (it != pool.values.end() && it->first == stored)
+          pool.values.erase(it);
+      }
+      delete stored;
+    });
+    pool.values.emplace(shared.get(), shared);
+    return shared;
+  }
+
+  std::shared_ptr<const T> m_value;
+};
+
+using CInternedString = CInterned<std::string>;
+using CInternedStringList = CInterned<std::vector<std::string>, StringListHash>;
@@ -40,7 +40,7 @@ private:
     return true;
   }
 
-  void PushObject(CVariant variant);
+  void PushObject(CVariant&& variant);
   void PopObject();
 
   CVariant& m_parsedObject;
@@ -65,7 +65,7 @@ CJSONVariantParserHandler::CJSONVariantParserHandler(CVariant& parsedObject)
 
 bool CJSONVariantParserHandler::Null()
 {
-  PushObject(CVariant::ConstNullVariant);
+  PushObject(CVariant(CVariant::ConstNullVariant));
   PopObject();
 
   return true;
@@ -120,7 +120,7 @@ bool CJSONVariantParserHandler::StartObject()
 
 bool CJSONVariantParserHandler::Key(const char* str, rapidjson::SizeType length, bool copy)
 {
-  m_key = std::string(str, 0, length);
+  m_key.assign(str, length);
 
   return true;
 }
@@ -146,25 +146,34 @@ bool CJSONVariantParserHandler::EndArray(rapidjson::SizeType elementCount)
   return true;
 }
 
-void CJSONVariantParserHandler::PushObject(CVariant variant)
+void CJSONVariantParserHandler::PushObject(CVariant&& variant)
 {
+  // values are moved into their parent, the tree is built in place
+  CVariant* pushed = nullptr;
   if (m_status == PARSE_STATUS::Object)
   {
-    (*m_parse[m_parse.size() - 1])[m_key] = variant;
-    m_parse.push_back(&(*m_parse[m_parse.size() - 1])[m_key]);
+    pushed = &(*m_parse.back())[m_key];
+    *pushed = std::move(variant);
   }
   else if (m_status == PARSE_STATUS::Array)
   {
-    CVariant *temp = m_parse[m_parse.size() - 1];
-    temp->push_back(variant);
-    m_parse.push_back(&(*temp)[temp->size() - 1]);
+    CVariant *temp = m_parse.back();
+    temp->push_back(std::move(variant));
+    pushed = &(*temp)[temp->size() - 1];
   }
   else if (m_parse.empty())
-    m_parse.push_back(new CVariant(variant));
+  {
+    m_parsedObject = std::move(variant);
+    pushed = &m_parsedObject;
+  }
+  else
+    return;
 
-  if (variant.isObject())
+  m_parse.push_back(pushed);
+
+  if (pushed->isObject())
     m_status = PARSE_STATUS::Object;
-  else if (variant.isArray())
+  else if (pushed->isArray())
     m_status = PARSE_STATUS::Array;
   else
     m_status = PARSE_STATUS::Variable;
@@ -172,12 +181,11 @@ void CJSONVariantParserHandler::PushObject(CVariant variant)
 
 void CJSONVariantParserHandler::PopObject()
 {
-  CVariant *variant = m_parse[m_parse.size() - 1];
   m_parse.pop_back();
 
   if (!m_parse.empty())
   {
-    variant = m_parse[m_parse.size() - 1];
+    const CVariant *variant = m_parse.back();
     if (variant->isObject())
       m_status = PARSE_STATUS::Object;
     else if (variant->isArray())
@@ -186,12 +194,7 @@ void CJSONVariantParserHandler::PopObject()
       m_status = PARSE_STATUS::Variable;
   }
   else
-  {
-    m_parsedObject = *variant;
-    delete variant;
-
     m_status = PARSE_STATUS::Variable;
-  }
 }
 
 bool CJSONVariantParser::Parse(const char* json, CVariant& data)
@@ -202,13 +205,15 @@ bool CJSONVariantParser::Parse(const char* json, CVariant& data)
   rapidjson::Reader reader;
   rapidjson::StringStream stringStream(json);
 
-  CJSONVariantParserHandler handler(data);
+  CVariant parsed;
+  CJSONVariantParserHandler handler(parsed);
   // use kParseIterativeFlag to eliminate possible stack overflow
   // from json parsing via reentrant calls
-  if (reader.Parse<rapidjson::kParseIterativeFlag>(stringStream, handler))
-    return true;
+  if (!reader.Parse<rapidjson::kParseIterativeFlag>(stringStream, handler))
+    return false;
 
-  return false;
+  data = std::move(parsed);
+  return true;
 }
 
 bool CJSONVariantParser::Parse(const std::string& json, CVariant& data)
@@ -11,11 +11,31 @@
 #include "utils/Variant.h"
 
 #include <rapidjson/prettywriter.h>
-#include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
 
-template<class TWriter>
-bool InternalWrite(TWriter& writer, const CVariant &value)
+namespace
+{
+// rapidjson output stream appending to a std::string, saves copying a StringBuffer
+class CStringStream
+{
+public:
+  typedef char Ch;
+
+  explicit CStringStream(std::string& output) : m_output(output) {}
+
+  void Put(Ch c) { m_output.push_back(c); }
+  void Flush() {}
+
+private:
+  std::string& m_output;
+};
+
+// a written value that isn't needed anymore is dropped right away
+void Release(const CVariant&) {}
+void Release(CVariant &value) { value = CVariant(); }
+
+template<class TWriter, class TVariant>
+bool InternalWrite(TWriter& writer, TVariant &value)
 {
   switch (value.type())
   {
@@ -38,10 +58,11 @@ bool InternalWrite(TWriter& writer, const CVariant &value)
     if (!writer.StartArray())
       return false;
 
-    for (CVariant::const_iterator_array itr = value.begin_array(); itr != value.end_array(); ++itr)
+    for (auto itr = value.begin_array(); itr != value.end_array(); ++itr)
     {
       if (!InternalWrite(writer, *itr))
         return false;
+      Release(*itr);
     }
 
     return writer.EndArray(value.size());
@@ -50,11 +71,12 @@ bool InternalWrite(TWriter& writer, const CVariant &value)
     if (!writer.StartObject())
       return false;
 
-    for (CVariant::const_iterator_map itr = value.begin_map(); itr != value.end_map(); ++itr)
+    for (auto itr = value.begin_map(); itr != value.end_map(); ++itr)
     {
       if (!writer.Key(itr->first.c_str()) ||
         !InternalWrite(writer, itr->second))
         return false;
+      Release(itr->second);
     }
 
     return writer.EndObject(value.size());
@@ -68,25 +90,38 @@ bool InternalWrite(TWriter& writer, const CVariant &value)
   return false;
 }
 
-bool CJSONVariantWriter::Write(const CVariant &value, std::string& output, bool compact)
+template<class TVariant>
+bool Write(TVariant &value, std::string& output, bool compact)
 {
-  rapidjson::StringBuffer stringBuffer;
+  std::string json;
+  CStringStream stream(json);
   if (compact)
   {
-    rapidjson::Writer<rapidjson::StringBuffer> writer(stringBuffer);
+    rapidjson::Writer<CStringStream> writer(stream);
 
     if (!InternalWrite(writer, value) || !writer.IsComplete())
       return false;
   }
   else
   {
-    rapidjson::PrettyWriter<rapidjson::StringBuffer> writer(stringBuffer);
+    rapidjson::PrettyWriter<CStringStream> writer(stream);
     writer.SetIndent('\t', 1);
 
     if (!InternalWrite(writer, value) || !writer.IsComplete())
       return false;
   }
 
-  output = stringBuffer.GetString();
+  output.swap(json);
   return true;
 }
+} // namespace
+
+bool CJSONVariantWriter::Write(const CVariant &value, std::string& output, bool compact)
+{
+  return ::Write(value, output, compact);
+}
+
+bool CJSONVariantWriter::Write(CVariant &&value, std::string& output, bool compact)
+{
+  return ::Write(value, output, compact);
+}
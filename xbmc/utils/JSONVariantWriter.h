@@ -18,4 +18,10 @@ public:
   CJSONVariantWriter() = delete;
 
   static bool Write(const CVariant &value, std::string& output, bool compact);
+  /*!
+   \brief Write a variant that isn't needed afterwards.
+   Every array item and object member is released as soon as it was written,
+   so a large variant and its JSON don't both have to be kept in memory in full.
+   */
+  static bool Write(CVariant &&value, std::string& output, bool compact);
 };
@@ -12,6 +12,7 @@
 #include <stdexcept>
 #include "threads/SingleLock.h"
 #include "utils/log.h"
+#include "utils/Tracer.h"
 #ifdef TARGET_POSIX
 #include "platform/posix/XTimeUtils.h"
 #endif
@@ -52,6 +53,8 @@ void CJobWorker::Process()
     bool success = false;
     try
     {
+      const char* type = job->GetType();
+      TRACE_SCOPE(*type ? type : "Job");
       success = job->DoWork();
     }
     catch (...)
@@ -159,6 +162,12 @@ bool CJobQueue::QueueEmpty() const
   return m_jobQueue.empty();
 }
 
+size_t CJobQueue::ProcessingCount() const
+{
+  CSingleLock lock(m_section);
+  return m_processing.size();
+}
+
 CJobManager &CJobManager::GetInstance()
 {
   static CJobManager sJobManager;
@@ -189,10 +198,15 @@ void CJobManager::CancelJobs()
   // clear any pending jobs
   for (unsigned int priority = CJob::PRIORITY_LOW_PAUSABLE; priority <= CJob::PRIORITY_DEDICATED; ++priority)
   {
-    for_each(m_jobQueue[priority].begin(), m_jobQueue[priority].end(), [](CWorkItem& wi) { wi.FreeJob(); });
+    for_each(m_jobQueue[priority].begin(), m_jobQueue[priority].end(), [this](CWorkItem& wi) { Unqueued(wi); wi.FreeJob(); });
     m_jobQueue[priority].clear();
   }
 
+  // and the ones waiting for them
+  for_each(m_waiting.begin(), m_waiting.end(), [this](CWorkItem& wi) { Unqueued(wi); wi.FreeJob(); });
+  m_waiting.clear();
+  m_dependents.clear();
+
   // cancel any callbacks on jobs still processing
   for_each(m_processing.begin(), m_processing.end(), [](CWorkItem& wi) { wi.Cancel(); });
 
@@ -221,11 +235,89 @@ unsigned int CJobManager::AddJob(CJob *job, IJobCallback *callback, CJob::PRIORI
   // create a work item for this job
   CWorkItem work(job, m_jobCounter, priority, callback);
   m_jobQueue[priority].push_back(work);
+  m_stats[job->GetType()].queued++;
 
   StartWorkers(priority);
   return work.m_id;
 }
 
+unsigned int CJobManager::AddJob(CJob *job, IJobCallback *callback, CJob::PRIORITY priority, const std::vector<unsigned int> &dependencies)
+{
+  CSingleLock lock(m_section);
+
+  if (!m_running)
+    return 0;
+
+  // increment the job counter, ensuring 0 (invalid job) is never hit
+  m_jobCounter++;
+  if (m_jobCounter == 0)
+    m_jobCounter++;
+
+  CWorkItem work(job, m_jobCounter, priority, callback);
+  for (unsigned int dependency : dependencies)
+  {
+    if (!IsPending(dependency))
+      continue;
+    m_dependents[dependency].push_back(work.m_id);
+    work.m_pending++;
+  }
+  m_stats[job->GetType()].queued++;
+
+  if (work.m_pending)
+    m_waiting.push_back(work);
+  else
+  {
+    m_jobQueue[priority].push_back(work);
+    StartWorkers(priority);
+  }
+  return work.m_id;
+}
+
+bool CJobManager::IsPending(unsigned int jobID) const
+{
+  for (unsigned int priority = CJob::PRIORITY_LOW_PAUSABLE; priority <= CJob::PRIORITY_DEDICATED; ++priority)
+  {
+    if (find(m_jobQueue[priority].begin(), m_jobQueue[priority].end(), jobID) != m_jobQueue[priority].end())
+      return true;
+  }
+  return find(m_processing.begin(), m_processing.end(), jobID) != m_processing.end() ||
+         find(m_waiting.begin(), m_waiting.end(), jobID) != m_waiting.end();
+}
+
+void CJobManager::ReleaseDependents(unsigned int jobID, bool success)
+{
+  std::map<unsigned int, std::vector<unsigned int>>::iterator it = m_dependents.find(jobID);
+  if (it == m_dependents.end())
+    return;
+
+  std::vector<unsigned int> dependents = std::move(it->second);
+  m_dependents.erase(it);
+
+  for (unsigned int dependent : dependents)
+  {
+    Processing::iterator i = find(m_waiting.begin(), m_waiting.end(), dependent);
+    if (i == m_waiting.end())
+      continue; // already cancelled by another job it depends on
+
+    if (!success)
+    {
+      CWorkItem work(*i);
+      m_waiting.erase(i);
+      Unqueued(work);
+      work.FreeJob();
+      ReleaseDependents(work.m_id, false);
+    }
+    else if (--i->m_pending == 0)
+    {
+      CWorkItem work(*i);
+      m_waiting.erase(i);
+      work.m_queued = XbmcThreads::SystemClockMillis();
+      m_jobQueue[work.m_priority].push_back(work);
+      StartWorkers(work.m_priority);
+    }
+  }
+}
+
 void CJobManager::CancelJob(unsigned int jobID)
 {
   CSingleLock lock(m_section);
@@ -236,15 +328,27 @@ void CJobManager::CancelJob(unsigned int jobID)
     JobQueue::iterator i = find(m_jobQueue[priority].begin(), m_jobQueue[priority].end(), jobID);
     if (i != m_jobQueue[priority].end())
     {
+      Unqueued(*i);
       delete i->m_job;
       m_jobQueue[priority].erase(i);
+      ReleaseDependents(jobID, false);
       return;
     }
   }
+  // or if it waits for other jobs
+  Processing::iterator w = find(m_waiting.begin(), m_waiting.end(), jobID);
+  if (w != m_waiting.end())
+  {
+    Unqueued(*w);
+    delete w->m_job;
+    m_waiting.erase(w);
+    ReleaseDependents(jobID, false);
+    return;
+  }
   // or if we're processing it
   Processing::iterator it = find(m_processing.begin(), m_processing.end(), jobID);
   if (it != m_processing.end())
-    it->m_callback = NULL; // job is in progress, so only thing to do is to remove callback
+    it->Cancel(); // job is in progress, so only thing to do is to remove callback, its dependents go when it completes
 }
 
 void CJobManager::StartWorkers(CJob::PRIORITY priority)
@@ -281,6 +385,12 @@ CJob *CJobManager::PopJob()
       CWorkItem job = m_jobQueue[priority].front();
       m_jobQueue[priority].pop_front();
 
+      job.m_started = XbmcThreads::SystemClockMillis();
+      JobStats &stats = m_stats[job.m_job->GetType()];
+      stats.queued--;
+      stats.processing++;
+      stats.waitTime += job.m_started - job.m_queued;
+
       // add to the processing vector
       m_processing.push_back(job);
       job.m_job->m_callback = this;
@@ -346,7 +456,9 @@ CJob *CJobManager::GetNextJob(const CJobWorker *worker)
     lock.Leave();
     bool newJob = m_jobEvent.WaitMSec(30000);
     lock.Enter();
-    if (!newJob)
+    // the workers that jobs other than dedicated ones can use stay parked,
+    // starting threads for every burst of jobs costs more than idle ones
+    if (!newJob && m_workers.size() > GetMaxWorkers(CJob::PRIORITY_HIGH))
       break;
   }
   // ensure no jobs have come in during the period after
@@ -399,7 +511,15 @@ void CJobManager::OnJobComplete(bool success, CJob *job)
     lock.Enter();
     Processing::iterator j = find(m_processing.begin(), m_processing.end(), job);
     if (j != m_processing.end())
+    {
+      JobStats &stats = m_stats[j->m_job->GetType()];
+      stats.processing--;
+      stats.completed++;
+      stats.runTime += XbmcThreads::SystemClockMillis() - j->m_started;
+      bool cancelled = j->m_cancelled;
       m_processing.erase(j);
+      ReleaseDependents(item.m_id, success && !cancelled);
+    }
     lock.Leave();
     item.FreeJob();
   }
@@ -414,6 +534,23 @@ void CJobManager::RemoveWorker(const CJobWorker *worker)
     m_workers.erase(i); // workers auto-delete
 }
 
+void CJobManager::Unqueued(const CWorkItem &item)
+{
+  m_stats[item.m_job->GetType()].queued--;
+}
+
+CJobManager::Statistics CJobManager::GetStatistics() const
+{
+  CSingleLock lock(m_section);
+
+  Statistics statistics;
+  statistics.workers = m_workers.size();
+  for (unsigned int priority = CJob::PRIORITY_LOW_PAUSABLE; priority <= CJob::PRIORITY_DEDICATED; ++priority)
+    statistics.queued[priority] = m_jobQueue[priority].size();
+  statistics.jobs = m_stats;
+  return statistics;
+}
+
 unsigned int CJobManager::GetMaxWorkers(CJob::PRIORITY priority)
 {
   static const unsigned int max_workers = 5;
@@ -10,8 +10,10 @@
 
 #include "Job.h"
 #include "threads/CriticalSection.h"
+#include "threads/SystemClock.h"
 #include "threads/Thread.h"
 
+#include <map>
 #include <queue>
 #include <string>
 #include <vector>
@@ -164,6 +166,12 @@ protected:
    */
   bool QueueEmpty() const;
 
+  /*!
+   \brief Returns the number of jobs currently being processed
+   NOTE: A job is still counted while its OnJobComplete is called
+   */
+  size_t ProcessingCount() const;
+
 private:
   void QueueNextJob();
 
@@ -200,6 +208,10 @@ class CJobManager final
       m_id = id;
       m_callback = callback;
       m_priority = priority;
+      m_queued = XbmcThreads::SystemClockMillis();
+      m_started = 0;
+      m_pending = 0;
+      m_cancelled = false;
     }
     bool operator==(unsigned int jobID) const
     {
@@ -217,14 +229,39 @@ class CJobManager final
     void Cancel()
     {
       m_callback = NULL;
+      m_cancelled = true;
     };
     CJob         *m_job;
     unsigned int  m_id;
     IJobCallback *m_callback;
     CJob::PRIORITY m_priority;
+    unsigned int  m_queued;  // ms, when the job was added
+    unsigned int  m_started; // ms, when a worker picked up the job
+    unsigned int  m_pending; // number of jobs this one still waits for
+    bool          m_cancelled;
   };
 
 public:
+  /*!
+   \brief Counters of the jobs of one type
+   \sa CJob::GetType()
+   */
+  struct JobStats
+  {
+    unsigned int queued = 0;     //!< jobs waiting for a worker
+    unsigned int processing = 0; //!< jobs being processed
+    uint64_t completed = 0;      //!< jobs finished, cancelled ones that were processing included
+    uint64_t waitTime = 0;       //!< ms between queueing and start, summed over all started jobs
+    uint64_t runTime = 0;        //!< ms of processing, summed over all completed jobs
+  };
+
+  struct Statistics
+  {
+    unsigned int workers = 0;                                //!< worker threads, busy or parked
+    unsigned int queued[CJob::PRIORITY_DEDICATED + 1] = {};  //!< jobs waiting per priority
+    std::map<std::string, JobStats> jobs;                    //!< counters by job type
+  };
+
   /*!
    \brief The only way through which the global instance of the CJobManager should be accessed.
    \return the global instance.
@@ -241,6 +278,33 @@ public:
    */
   unsigned int AddJob(CJob *job, IJobCallback *callback, CJob::PRIORITY priority = CJob::PRIORITY_LOW);
 
+  /*!
+   \brief Add a job to the threaded job manager that starts once other jobs completed.
+   The job is queued when all the jobs it depends on finished successfully, so a job can be
+   started after another one (A then B), after several ones (fan-in) and several jobs can wait
+   for the same one (fan-out). If one of them fails or is cancelled, the job is cancelled
+   as well, and in turn the jobs depending on it. Cancelled jobs that were waiting are deleted
+   without calling their callback, like jobs cancelled in the queue.
+   \param job a pointer to the job to add. The job should be subclassed from CJob
+   \param callback a pointer to an IJobCallback instance to receive job progress and completion notices.
+   \param priority the priority that this job should run at.
+   \param dependencies ids of the jobs to wait for, retrieved previously from AddJob(). Jobs that
+   are not queued, waiting or processing anymore count as finished successfully.
+   \return a unique identifier for this job, to be used with other interaction
+   \sa CJob, IJobCallback, CancelJob()
+   */
+  unsigned int AddJob(CJob *job, IJobCallback *callback, CJob::PRIORITY priority, const std::vector<unsigned int> &dependencies);
+
+  /*!
+   \brief Add a function f to this job manager for asynchronously execution once other jobs completed.
+   \sa AddJob(CJob *, IJobCallback *, CJob::PRIORITY, const std::vector<unsigned int> &)
+   */
+  template<typename F>
+  unsigned int SubmitAfter(const std::vector<unsigned int> &dependencies, F&& f, CJob::PRIORITY priority = CJob::PRIORITY_LOW)
+  {
+    return AddJob(new CLambdaJob<F>(std::forward<F>(f)), nullptr, priority, dependencies);
+  }
+
   /*!
    \brief Add a function f to this job manager for asynchronously execution.
    */
@@ -309,6 +373,12 @@ public:
    */
   bool IsProcessing(const CJob::PRIORITY &priority) const;
 
+  /*!
+   \brief Queue depths and counters by job type since start
+   \return the current statistics
+   */
+  Statistics GetStatistics() const;
+
 protected:
   friend class CJobWorker;
   friend class CJob;
@@ -355,6 +425,9 @@ private:
   void StartWorkers(CJob::PRIORITY priority);
   void RemoveWorker(const CJobWorker *worker);
   static unsigned int GetMaxWorkers(CJob::PRIORITY priority);
+  void Unqueued(const CWorkItem &item);
+  bool IsPending(unsigned int jobID) const;
+  void ReleaseDependents(unsigned int jobID, bool success);
 
   unsigned int m_jobCounter;
 
@@ -365,7 +438,10 @@ private:
   JobQueue   m_jobQueue[CJob::PRIORITY_DEDICATED + 1];
   bool       m_pauseJobs;
   Processing m_processing;
+  Processing m_waiting;  // jobs waiting for the jobs they depend on
+  std::map<unsigned int, std::vector<unsigned int>> m_dependents; // ids of the jobs waiting for a job
   Workers    m_workers;
+  std::map<std::string, JobStats> m_stats;
 
   mutable CCriticalSection m_section;
   CEvent           m_jobEvent;
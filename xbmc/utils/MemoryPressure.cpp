@@ -0,0 +1,190 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "MemoryPressure.h"
+
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/MemUtils.h"
+#include "utils/StringUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <cstdio>
+
+#define MEMORY_PRESSURE_SAMPLE_INTERVAL_MS 2000
+// the same pressure only trims again after the caches had time to fill up
+#define MEMORY_PRESSURE_TRIM_INTERVAL_MS 30000
+
+// free memory, in percent of the physical memory
+#define MEMORY_PRESSURE_MODERATE_FREE 10
+#define MEMORY_PRESSURE_CRITICAL_FREE 5
+
+// share of the last 10 s some or all tasks were stalled on memory, in percent
+#define MEMORY_PRESSURE_MODERATE_STALL 10.0
+#define MEMORY_PRESSURE_CRITICAL_STALL 5.0
+
+namespace
+{
+
+const char* GetLevelName(MemoryPressure level)
+{
+  switch (level)
+  {
+  case MemoryPressure::MODERATE:
+    return "moderate";
+  case MemoryPressure::CRITICAL:
+    return "critical";
+  default:
+    return "none";
+  }
+}
+
+MemoryPressure SampleFreeMemory()
+{
+  KODI::MEMORY::MemoryStatus status = {};
+  KODI::MEMORY::GetMemoryStatus(&status);
+  if (status.totalPhys == 0)
+    return MemoryPressure::NONE;
+
+  const uint64_t free = status.availPhys * 100 / status.totalPhys;
+  if (free < MEMORY_PRESSURE_CRITICAL_FREE)
+    return MemoryPressure::CRITICAL;
+  if (free < MEMORY_PRESSURE_MODERATE_FREE)
+    return MemoryPressure::MODERATE;
+  return MemoryPressure::NONE;
+}
+
+MemoryPressure SampleStalls()
+{
+#if defined(TARGET_LINUX)
+  FILE* file = fopen("/proc/pressure/memory", "r");
+  if (!file)
+    return MemoryPressure::NONE;
+
+  // some avg10=0.00 avg60=0.00 avg300=0.00 total=0
+  // full avg10=0.00 avg60=0.00 avg300=0.00 total=0
+  MemoryPressure level = MemoryPressure::NONE;
+  char line[256];
+  while (fgets(line, sizeof(line), file))
+  {
+    float avg10;
+    if (sscanf(line, "full avg10=%f", &avg10) == 1 && avg10 >= MEMORY_PRESSURE_CRITICAL_STALL)
+      level = MemoryPressure::CRITICAL;
+    else if (sscanf(line, "some avg10=%f", &avg10) == 1 && avg10 >= MEMORY_PRESSURE_MODERATE_STALL)
+      level = std::max(level, MemoryPressure::MODERATE);
+  }
+  fclose(file);
+  return level;
+#else
+  return MemoryPressure::NONE;
+#endif
+}
+
+} // unnamed namespace
+
+CMemoryPressureManager& CMemoryPressureManager::GetInstance()
+{
+  static CMemoryPressureManager manager;
+  return manager;
+}
+
+void CMemoryPressureManager::Register(IMemoryPressureHandler* handler, const std::string& name, int priority)
+{
+  CSingleLock lock(m_section);
+  auto it = std::upper_bound(m_handlers.begin(), m_handlers.end(), priority,
+                             [](int priority, const Handler& handler) { return priority < handler.priority; });
+  m_handlers.insert(it, {handler, name, priority});
+}
+
+void CMemoryPressureManager::Unregister(IMemoryPressureHandler* handler)
+{
+  CSingleLock lock(m_section);
+  m_handlers.erase(std::remove_if(m_handlers.begin(), m_handlers.end(),
+                                  [handler](const Handler& entry) { return entry.handler == handler; }),
+                   m_handlers.end());
+}
+
+void CMemoryPressureManager::Signal(MemoryPressure level)
+{
+  int current = m_signaled;
+  while (static_cast<int>(level) > current &&
+         !m_signaled.compare_exchange_weak(current, static_cast<int>(level)))
+    ;
+}
+
+MemoryPressure CMemoryPressureManager::Sample() const
+{
+  return std::max(SampleFreeMemory(), SampleStalls());
+}
+
+void CMemoryPressureManager::Process()
+{
+  const unsigned int now = XbmcThreads::SystemClockMillis();
+  const MemoryPressure signaled =
+      static_cast<MemoryPressure>(m_signaled.exchange(static_cast<int>(MemoryPressure::NONE)));
+  if (signaled == MemoryPressure::NONE && now - m_lastSample < MEMORY_PRESSURE_SAMPLE_INTERVAL_MS)
+    return;
+  m_lastSample = now;
+
+  const MemoryPressure level = std::max(Sample(), signaled);
+
+  CSingleLock lock(m_section);
+  if (level != m_level)
+    CLog::Log(LOGINFO, "CMemoryPressureManager - memory pressure changed from %s to %s",
+              GetLevelName(m_level), GetLevelName(level));
+  m_level = level;
+
+  if (level == MemoryPressure::NONE)
+    return;
+  if (m_trims > 0 && level <= m_lastTrimLevel && now - m_lastTrim < MEMORY_PRESSURE_TRIM_INTERVAL_MS)
+    return;
+
+  Trim(level);
+  m_lastTrimLevel = level;
+  m_lastTrim = now;
+  m_trims++;
+}
+
+void CMemoryPressureManager::Trim(MemoryPressure level)
+{
+  // handlers may unregister others while being called
+  const std::vector<Handler> handlers = m_handlers;
+
+  for (size_t i = 0; i < handlers.size();)
+  {
+    const int priority = handlers[i].priority;
+    for (; i < handlers.size() && handlers[i].priority == priority; i++)
+    {
+      const Handler& handler = handlers[i];
+      if (std::none_of(m_handlers.begin(), m_handlers.end(),
+                       [&handler](const Handler& entry) { return entry.handler == handler.handler; }))
+        continue;
+
+      CLog::Log(LOGDEBUG, "CMemoryPressureManager - %s pressure, trimming %s", GetLevelName(level),
+                handler.name.c_str());
+      handler.handler->OnMemoryPressure(level);
+    }
+
+    // moderate pressure only sheds what is needed, the stalls are averaged over 10 s and can't
+    // tell whether a priority freed enough
+    if (level == MemoryPressure::MODERATE && SampleFreeMemory() == MemoryPressure::NONE)
+      break;
+  }
+}
+
+std::string CMemoryPressureManager::GetStatus() const
+{
+  CSingleLock lock(m_section);
+  if (m_trims == 0)
+    return GetLevelName(m_level);
+
+  return StringUtils::Format("%s, %u trims, the last %u s ago (%s)", GetLevelName(m_level), m_trims,
+                             (XbmcThreads::SystemClockMillis() - m_lastTrim) / 1000,
+                             GetLevelName(m_lastTrimLevel));
+}
@@ -0,0 +1,101 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "threads/CriticalSection.h"
+
+#include <atomic>
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+enum class MemoryPressure
+{
+  NONE = 0,
+  MODERATE, //!< release what is cheap to get back, e.g. unused textures
+  CRITICAL, //!< release everything that can be rebuilt
+};
+
+class IMemoryPressureHandler
+{
+public:
+  virtual ~IMemoryPressureHandler() = default;
+
+  /*!
+   * \brief Release memory, called on the application thread
+   */
+  virtual void OnMemoryPressure(MemoryPressure level) = 0;
+};
+
+/*!
+ * \brief Lets caches shed memory before the system runs out of it.
+ *
+ * Caches register a handler with a priority. The pressure is sampled from the free memory and,
+ * on Linux, from the pressure stall information of the kernel. The platform can also signal it,
+ * e.g. Android when it is about to kill us. Under pressure the handlers are called on the
+ * application thread, the lowest priority first. For moderate pressure this stops as soon as
+ * enough memory is free again.
+ */
+class CMemoryPressureManager
+{
+public:
+  enum Priority
+  {
+    PRIORITY_CACHE = 0, //!< caches of data read from disk or network
+    PRIORITY_GUI = 10, //!< textures and fonts, reloading them stalls the GUI
+    PRIORITY_PLAYBACK = 20, //!< buffers of the playing media
+  };
+
+  static CMemoryPressureManager& GetInstance();
+
+  void Register(IMemoryPressureHandler* handler, const std::string& name, int priority);
+
+  /*!
+   * \brief Unregister a handler, waits for it to return if it is being called
+   */
+  void Unregister(IMemoryPressureHandler* handler);
+
+  /*!
+   * \brief Report pressure the platform noticed, handled with the next Process()
+   */
+  void Signal(MemoryPressure level);
+
+  /*!
+   * \brief Sample the memory and call the handlers if needed, must be called on the
+   * application thread
+   */
+  void Process();
+
+  /*!
+   * \brief One line about the current pressure and the last trim for the system info
+   */
+  std::string GetStatus() const;
+
+private:
+  CMemoryPressureManager() = default;
+
+  MemoryPressure Sample() const;
+  void Trim(MemoryPressure level);
+
+  struct Handler
+  {
+    IMemoryPressureHandler* handler;
+    std::string name;
+    int priority;
+  };
+
+  mutable CCriticalSection m_section;
+  std::vector<Handler> m_handlers; // sorted by priority
+  std::atomic<int> m_signaled{static_cast<int>(MemoryPressure::NONE)};
+  MemoryPressure m_level = MemoryPressure::NONE;
+  MemoryPressure m_lastTrimLevel = MemoryPressure::NONE;
+  unsigned int m_lastSample = 0;
+  unsigned int m_lastTrim = 0;
+  unsigned int m_trims = 0;
+};
@@ -0,0 +1,160 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "Metrics.h"
+
+#include "utils/StringUtils.h"
+
+#include <algorithm>
+#include <inttypes.h>
+#include <map>
+#include <memory>
+#include <mutex>
+
+constexpr std::array<uint64_t, 12> CMetrics::Histogram::BOUNDS;
+
+namespace
+{
+struct SMetric
+{
+  std::string help;
+  std::unique_ptr<CMetrics::Counter> counter;
+  std::unique_ptr<CMetrics::Histogram> histogram;
+};
+
+std::mutex& GetMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+std::map<std::string, SMetric>& GetMetrics()
+{
+  static std::map<std::string, SMetric> metrics;
+  return metrics;
+}
+
+std::string FormatSeconds(uint64_t us)
+{
+  return StringUtils::Format("%" PRIu64 ".%06" PRIu64, us / 1000000, us % 1000000);
+}
+}
+
+void CMetrics::Histogram::Observe(std::chrono::steady_clock::duration duration)
+{
+  const uint64_t us = std::chrono::duration_cast<std::chrono::microseconds>(duration).count();
+
+  size_t bucket = 0;
+  while (bucket < BOUNDS.size() && us > BOUNDS[bucket])
+    bucket++;
+
+  m_buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+  m_count.fetch_add(1, std::memory_order_relaxed);
+  m_sum.fetch_add(us, std::memory_order_relaxed);
+}
+
+CMetrics::Counter* CMetrics::RegisterCounter(const char* name, const char* help)
+{
+  std::unique_lock<std::mutex> lock(GetMutex());
+  SMetric& metric = GetMetrics()[name];
+  if (!metric.counter)
+  {
+    metric.help = help;
+    metric.counter.reset(new Counter);
+  }
+  return metric.counter.get();
+}
+
+CMetrics::Histogram* CMetrics::RegisterHistogram(const char* name, const char* help)
+{
+  std::unique_lock<std::mutex> lock(GetMutex());
+  SMetric& metric = GetMetrics()[std::string(name) + "_seconds"];
+  if (!metric.histogram)
+  {
+    metric.help = help;
+    metric.histogram.reset(new Histogram);
+  }
+  return metric.histogram.get();
+}
+
+void CMetrics::Export(std::string& out)
+{
+  std::unique_lock<std::mutex> lock(GetMutex());
+  for (const auto& it : GetMetrics())
+  {
+    const char* name = it.first.c_str();
+    const SMetric& metric = it.second;
+
+    if (metric.counter)
+    {
+      WriteHeader(out, name, "counter", metric.help.c_str());
+      WriteSample(out, name, "", metric.counter->Get());
+    }
+    else if (metric.histogram)
+    {
+      WriteHeader(out, name, "histogram", metric.help.c_str());
+
+      // the count is read first, buckets updated meanwhile may add up to a bit more and the
+      // total must not be less than any bucket
+      const Histogram& histogram = *metric.histogram;
+      const uint64_t count = histogram.m_count.load(std::memory_order_relaxed);
+      const std::string bucketName = it.first + "_bucket";
+      uint64_t cumulative = 0;
+      for (size_t i = 0; i < Histogram::BOUNDS.size(); i++)
+      {
+        cumulative += histogram.m_buckets[i].load(std::memory_order_relaxed);
+        out += StringUtils::Format("%s{le=\"%s\"} %" PRIu64 "\n", bucketName.c_str(),
+                                   FormatSeconds(Histogram::BOUNDS[i]).c_str(), cumulative);
+      }
+      cumulative = std::max(cumulative + histogram.m_buckets.back().load(std::memory_order_relaxed), count);
+      out += StringUtils::Format("%s{le=\"+Inf\"} %" PRIu64 "\n", bucketName.c_str(), cumulative);
+      out += StringUtils::Format("%s_sum %s\n", name,
+                                 FormatSeconds(histogram.m_sum.load(std::memory_order_relaxed)).c_str());
+      out += StringUtils::Format("%s_count %" PRIu64 "\n", name, cumulative);
+    }
+  }
+}
+
+void CMetrics::WriteHeader(std::string& out, const char* name, const char* type, const char* help)
+{
+  out += StringUtils::Format("# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+}
+
+void CMetrics::WriteSample(std::string& out, const char* name, const std::string& labels, uint64_t value)
+{
+  if (labels.empty())
+    out += StringUtils::Format("%s %" PRIu64 "\n", name, value);
+  else
+    out += StringUtils::Format("%s{%s} %" PRIu64 "\n", name, labels.c_str(), value);
+}
+
+void CMetrics::WriteSample(std::string& out, const char* name, const std::string& labels, double value)
+{
+  if (labels.empty())
+    out += StringUtils::Format("%s %g\n", name, value);
+  else
+    out += StringUtils::Format("%s{%s} %g\n", name, labels.c_str(), value);
+}
+
+std::string CMetrics::EscapeLabel(const std::string& value)
+{
+  std::string escaped;
+  escaped.reserve(value.size());
+  for (char c : value)
+  {
+    if (c == '\\' || c == '"')
+      escaped += '\\';
+    if (c == '\n')
+    {
+      escaped += "\\n";
+      continue;
+    }
+    escaped += c;
+  }
+  return escaped;
+}
@@ -0,0 +1,114 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <stdint.h>
+#include <string>
+
+/*!
+ \brief Counters and time histograms for monitoring Kodi from outside.
+
+ Code that wants to be monitored registers a named metric once and updates it
+ without locking from then on, metrics registered with the same name are shared
+ and live until exit. Export() writes all of them in the Prometheus text format,
+ the webserver serves them at /metrics if enabled in advancedsettings.xml.
+
+ Values other parts of Kodi keep anyway, like the job queues or the render
+ telemetry of the player, are sampled when exporting instead, see
+ CHTTPMetricsHandler.
+ */
+class CMetrics
+{
+public:
+  class Counter
+  {
+  public:
+    void Add(uint64_t value = 1) { m_value.fetch_add(value, std::memory_order_relaxed); }
+    uint64_t Get() const { return m_value.load(std::memory_order_relaxed); }
+
+  private:
+    std::atomic<uint64_t> m_value{0};
+  };
+
+  class Histogram
+  {
+  public:
+    //! upper bounds of the buckets in us, the last bucket takes everything above
+    static constexpr std::array<uint64_t, 12> BOUNDS = {{500, 1000, 2000, 5000, 10000, 20000, 50000,
+                                                         100000, 200000, 500000, 1000000, 5000000}};
+
+    void Observe(std::chrono::steady_clock::duration duration);
+    void ObserveSince(std::chrono::steady_clock::time_point start)
+    {
+      Observe(std::chrono::steady_clock::now() - start);
+    }
+
+  private:
+    friend class CMetrics;
+
+    std::array<std::atomic<uint64_t>, BOUNDS.size() + 1> m_buckets{};
+    std::atomic<uint64_t> m_count{0};
+    std::atomic<uint64_t> m_sum{0}; // us
+  };
+
+  /*!
+   \brief Time the enclosing scope into a histogram
+   */
+  class CScopedTimer
+  {
+  public:
+    explicit CScopedTimer(Histogram* histogram)
+      : m_histogram(histogram), m_start(std::chrono::steady_clock::now()) {}
+    ~CScopedTimer() { m_histogram->ObserveSince(m_start); }
+    CScopedTimer(const CScopedTimer&) = delete;
+    CScopedTimer& operator=(const CScopedTimer&) = delete;
+
+  private:
+    Histogram* m_histogram;
+    std::chrono::steady_clock::time_point m_start;
+  };
+
+  /*!
+   \param name Metric name, e.g. kodi_database_queries_total
+   \param help One line description exported with the metric
+   */
+  static Counter* RegisterCounter(const char* name, const char* help);
+
+  /*!
+   \param name Metric name without unit, "_seconds" is appended on export
+   \param help One line description exported with the metric
+   */
+  static Histogram* RegisterHistogram(const char* name, const char* help);
+
+  /*!
+   \brief Append all registered metrics
+   */
+  static void Export(std::string& out);
+
+  /*!
+   \brief Append the HELP and TYPE lines of a sampled metric
+   \param type "counter" or "gauge"
+   */
+  static void WriteHeader(std::string& out, const char* name, const char* type, const char* help);
+
+  /*!
+   \brief Append a sample of a metric
+   \param labels Label pairs without braces, e.g. priority="low", may be empty
+   */
+  static void WriteSample(std::string& out, const char* name, const std::string& labels, uint64_t value);
+  static void WriteSample(std::string& out, const char* name, const std::string& labels, double value);
+
+  /*!
+   \brief Escape a label value
+   */
+  static std::string EscapeLabel(const std::string& value);
+};
@@ -428,130 +428,94 @@ std::string ByLastUsed(SortAttribute attributes, const SortItem &values)
   return values.at(FieldLastUsed).asString();
 }
 
-bool preliminarySort(const SortItem &left, const SortItem &right, bool handleFolder, bool &result, std::wstring &labelLeft, std::wstring &labelRight)
+namespace
 {
-  // make sure both items have the necessary data to do the sorting
-  SortItem::const_iterator itLeftSort, itRightSort;
-  if ((itLeftSort = left.find(FieldSort)) == left.end())
-  {
-    result = false;
-    return true;
-  }
-  if ((itRightSort = right.find(FieldSort)) == right.end())
+// What the comparisons need of an item, extracted once instead of on every
+// comparison of the sort
+struct SortKey
+{
+  size_t index;
+  SortSpecial special;
+  bool hasFolder;
+  bool folder;
+  std::wstring label;
+};
+
+SortKey GetSortKey(const SortItem &item, size_t index)
+{
+  SortKey key;
+  key.index = index;
+  key.special = SortSpecialNone;
+  key.hasFolder = false;
+  key.folder = false;
+
+  SortItem::const_iterator it;
+  if ((it = item.find(FieldSortSpecial)) != item.end() && it->second.asInteger() <= (int64_t)SortSpecialOnBottom)
+    key.special = (SortSpecial)it->second.asInteger();
+  if ((it = item.find(FieldFolder)) != item.end())
   {
-    result = true;
-    return true;
+    key.hasFolder = true;
+    key.folder = it->second.asBoolean();
   }
+  if ((it = item.find(FieldSort)) != item.end())
+    key.label = it->second.asWideString();
 
-  // look at special sorting behaviour
-  SortItem::const_iterator itLeft, itRight;
-  SortSpecial leftSortSpecial = SortSpecialNone;
-  SortSpecial rightSortSpecial = SortSpecialNone;
-  if ((itLeft = left.find(FieldSortSpecial)) != left.end() && itLeft->second.asInteger() <= (int64_t)SortSpecialOnBottom)
-    leftSortSpecial = (SortSpecial)itLeft->second.asInteger();
-  if ((itRight = right.find(FieldSortSpecial)) != right.end() && itRight->second.asInteger() <= (int64_t)SortSpecialOnBottom)
-    rightSortSpecial = (SortSpecial)itRight->second.asInteger();
+  return key;
+}
 
+// Items with equal labels keep their previous order, as they would with a
+// stable sort. This makes the order total, so a partial sort of the first
+// items gives the same result as sorting all of them.
+bool SortKeyLess(const SortKey &left, const SortKey &right, bool descending, bool handleFolder)
+{
   // one has a special sort
-  if (leftSortSpecial != rightSortSpecial)
+  if (left.special != right.special)
   {
     // left should be sorted on top
     // or right should be sorted on bottom
     // => left is sorted above right
-    if (leftSortSpecial == SortSpecialOnTop ||
-        rightSortSpecial == SortSpecialOnBottom)
-    {
-      result = true;
-      return true;
-    }
-
-    // otherwise right is sorted above left
-    result = false;
-    return true;
+    return left.special == SortSpecialOnTop || right.special == SortSpecialOnBottom;
   }
+
   // both have either sort on top or sort on bottom -> leave as-is
-  else if (leftSortSpecial != SortSpecialNone && leftSortSpecial == rightSortSpecial)
+  if (left.special == SortSpecialNone)
   {
-    result = false;
-    return true;
-  }
+    if (handleFolder && left.hasFolder && right.hasFolder && left.folder != right.folder)
+      return left.folder;
 
-  if (handleFolder)
-  {
-    itLeft = left.find(FieldFolder);
-    itRight = right.find(FieldFolder);
-    if (itLeft != left.end() && itRight != right.end() &&
-        itLeft->second.asBoolean() != itRight->second.asBoolean())
-    {
-      result = itLeft->second.asBoolean();
-      return true;
-    }
+    int64_t result = StringUtils::AlphaNumericCompare(left.label.c_str(), right.label.c_str());
+    if (result != 0)
+      return descending ? result > 0 : result < 0;
   }
 
-  labelLeft = itLeftSort->second.asWideString();
-  labelRight = itRightSort->second.asWideString();
-
-  return false;
-}
-
-bool SorterAscending(const SortItem &left, const SortItem &right)
-{
-  bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, true, result, labelLeft, labelRight))
-    return result;
-
-  return StringUtils::AlphaNumericCompare(labelLeft.c_str(), labelRight.c_str()) < 0;
+  return left.index < right.index;
 }
 
-bool SorterDescending(const SortItem &left, const SortItem &right)
+void SortKeys(std::vector<SortKey> &keys, SortOrder sortOrder, SortAttribute attributes, int limitEnd)
 {
-  bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, true, result, labelLeft, labelRight))
-    return result;
-
-  return StringUtils::AlphaNumericCompare(labelLeft.c_str(), labelRight.c_str()) > 0;
-}
-
-bool SorterIgnoreFoldersAscending(const SortItem &left, const SortItem &right)
-{
-  bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, false, result, labelLeft, labelRight))
-    return result;
-
-  return StringUtils::AlphaNumericCompare(labelLeft.c_str(), labelRight.c_str()) < 0;
-}
-
-bool SorterIgnoreFoldersDescending(const SortItem &left, const SortItem &right)
-{
-  bool result;
-  std::wstring labelLeft, labelRight;
-  if (preliminarySort(left, right, false, result, labelLeft, labelRight))
-    return result;
-
-  return StringUtils::AlphaNumericCompare(labelLeft.c_str(), labelRight.c_str()) > 0;
-}
-
-bool SorterIndirectAscending(const SortItemPtr &left, const SortItemPtr &right)
-{
-  return SorterAscending(*left, *right);
-}
+  const bool descending = sortOrder == SortOrderDescending;
+  const bool handleFolder = (attributes & SortAttributeIgnoreFolders) == 0;
+  auto less = [descending, handleFolder](const SortKey &left, const SortKey &right)
+  {
+    return SortKeyLess(left, right, descending, handleFolder);
+  };
 
-bool SorterIndirectDescending(const SortItemPtr &left, const SortItemPtr &right)
-{
-  return SorterDescending(*left, *right);
+  // only the items up to the end of the limit are returned
+  if (limitEnd > 0 && (size_t)limitEnd < keys.size())
+    std::partial_sort(keys.begin(), keys.begin() + limitEnd, keys.end(), less);
+  else
+    std::sort(keys.begin(), keys.end(), less);
 }
 
-bool SorterIndirectIgnoreFoldersAscending(const SortItemPtr &left, const SortItemPtr &right)
+template<typename T>
+void ApplySortKeys(std::vector<T> &items, const std::vector<SortKey> &keys)
 {
-  return SorterIgnoreFoldersAscending(*left, *right);
+  std::vector<T> sorted;
+  sorted.reserve(items.size());
+  for (const SortKey &key : keys)
+    sorted.push_back(std::move(items[key.index]));
+  items.swap(sorted);
 }
-
-bool SorterIndirectIgnoreFoldersDescending(const SortItemPtr &left, const SortItemPtr &right)
-{
-  return SorterIgnoreFoldersDescending(*left, *right);
 }
 
 std::map<SortBy, SortUtils::SortPreparator> fillPreparators()
@@ -715,6 +679,8 @@ void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attribute
     if (preparator != NULL)
     {
       Fields sortingFields = GetFieldsForSorting(sortBy);
+      std::vector<SortKey> keys;
+      keys.reserve(items.size());
 
       // Prepare the string used for sorting and store it under FieldSort
       for (DatabaseResults::iterator item = items.begin(); item != items.end(); ++item)
@@ -729,10 +695,12 @@ void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attribute
         std::wstring sortLabel;
         g_charsetConverter.utf8ToW(preparator(attributes, *item), sortLabel, false);
         item->insert(std::pair<Field, CVariant>(FieldSort, CVariant(sortLabel)));
+        keys.push_back(GetSortKey(*item, keys.size()));
       }
 
       // Do the sorting
-      std::stable_sort(items.begin(), items.end(), getSorter(sortOrder, attributes));
+      SortKeys(keys, sortOrder, attributes, limitEnd);
+      ApplySortKeys(items, keys);
     }
   }
 
@@ -754,6 +722,8 @@ void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attribute
     if (preparator != NULL)
     {
       Fields sortingFields = GetFieldsForSorting(sortBy);
+      std::vector<SortKey> keys;
+      keys.reserve(items.size());
 
       // Prepare the string used for sorting and store it under FieldSort
       for (SortItems::iterator item = items.begin(); item != items.end(); ++item)
@@ -768,10 +738,12 @@ void SortUtils::Sort(SortBy sortBy, SortOrder sortOrder, SortAttribute attribute
         std::wstring sortLabel;
         g_charsetConverter.utf8ToW(preparator(attributes, **item), sortLabel, false);
         (*item)->insert(std::pair<Field, CVariant>(FieldSort, CVariant(sortLabel)));
+        keys.push_back(GetSortKey(**item, keys.size()));
       }
 
       // Do the sorting
-      std::stable_sort(items.begin(), items.end(), getSorterIndirect(sortOrder, attributes));
+      SortKeys(keys, sortOrder, attributes, limitEnd);
+      ApplySortKeys(items, keys);
     }
   }
 
@@ -824,22 +796,6 @@ const SortUtils::SortPreparator& SortUtils::getPreparator(SortBy sortBy)
   return m_preparators[SortByNone];
 }
 
-SortUtils::Sorter SortUtils::getSorter(SortOrder sortOrder, SortAttribute attributes)
-{
-  if (attributes & SortAttributeIgnoreFolders)
-    return sortOrder == SortOrderDescending ? SorterIgnoreFoldersDescending : SorterIgnoreFoldersAscending;
-
-  return sortOrder == SortOrderDescending ? SorterDescending : SorterAscending;
-}
-
-SortUtils::SorterIndirect SortUtils::getSorterIndirect(SortOrder sortOrder, SortAttribute attributes)
-{
-  if (attributes & SortAttributeIgnoreFolders)
-    return sortOrder == SortOrderDescending ? SorterIndirectIgnoreFoldersDescending : SorterIndirectIgnoreFoldersAscending;
-
-  return sortOrder == SortOrderDescending ? SorterIndirectDescending : SorterIndirectAscending;
-}
-
 const Fields& SortUtils::GetFieldsForSorting(SortBy sortBy)
 {
   std::map<SortBy, Fields>::const_iterator it = m_sortingFields.find(sortBy);
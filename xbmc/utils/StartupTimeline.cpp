@@ -0,0 +1,137 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "StartupTimeline.h"
+
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+#include "utils/StringUtils.h"
+#include "utils/Tracer.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+#if defined(TARGET_WINDOWS)
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+namespace
+{
+
+struct TimelineEntry
+{
+  const char* phase;
+  const char* step;
+  int64_t start;
+  int64_t end;
+  int64_t cpu;
+};
+
+// as close to the start of the process as static initialization gets
+const int64_t processStart = CTracer::Now();
+
+CCriticalSection timelineSection;
+std::vector<TimelineEntry> timeline;
+bool timelineDone = false;
+
+} // namespace
+
+CStartupTimeline::CPhase::CPhase(const char* name)
+  : m_name(name),
+    m_start(CTracer::Now()),
+    m_cpuStart(ThreadCpuTime())
+{
+}
+
+CStartupTimeline::CPhase::~CPhase()
+{
+  EndStep();
+  Record(m_name, nullptr, m_start, CTracer::Now(), ThreadCpuTime() - m_cpuStart);
+}
+
+void CStartupTimeline::CPhase::Step(const char* name)
+{
+  EndStep();
+  m_step = name;
+  m_stepStart = CTracer::Now();
+  m_stepCpuStart = ThreadCpuTime();
+}
+
+void CStartupTimeline::CPhase::EndStep()
+{
+  if (m_step)
+    Record(m_name, m_step, m_stepStart, CTracer::Now(), ThreadCpuTime() - m_stepCpuStart);
+  m_step = nullptr;
+}
+
+int64_t CStartupTimeline::ThreadCpuTime()
+{
+#if defined(TARGET_WINDOWS)
+  FILETIME creation, exit, kernel, user;
+  if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user))
+    return 0;
+
+  ULARGE_INTEGER kernelTime, userTime;
+  kernelTime.LowPart = kernel.dwLowDateTime;
+  kernelTime.HighPart = kernel.dwHighDateTime;
+  userTime.LowPart = user.dwLowDateTime;
+  userTime.HighPart = user.dwHighDateTime;
+  // 100 ns units
+  return static_cast<int64_t>(kernelTime.QuadPart + userTime.QuadPart) * 100;
+#else
+  struct timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0)
+    return 0;
+  return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+#endif
+}
+
+void CStartupTimeline::Record(const char* phase, const char* step, int64_t start, int64_t end, int64_t cpu)
+{
+  if (CTracer::IsEnabled())
+    CTracer::Record(step ? step : phase, start, end);
+
+  CSingleLock lock(timelineSection);
+  if (!timelineDone)
+    timeline.push_back({phase, step, start, end, cpu});
+}
+
+void CStartupTimeline::Log()
+{
+  std::vector<TimelineEntry> entries;
+  {
+    CSingleLock lock(timelineSection);
+    if (timelineDone)
+      return;
+    timelineDone = true;
+    entries.swap(timeline);
+  }
+
+  // phases are recorded after their steps
+  std::stable_sort(entries.begin(), entries.end(),
+                   [](const TimelineEntry& lhs, const TimelineEntry& rhs)
+                   {
+                     if (lhs.start != rhs.start)
+                       return lhs.start < rhs.start;
+                     return !lhs.step && rhs.step;
+                   });
+
+  CLog::Log(LOGNOTICE, "CStartupTimeline: UI ready %.1f ms after start",
+            (CTracer::Now() - processStart) / 1e6);
+  for (const auto& entry : entries)
+  {
+    std::string name = entry.step ? StringUtils::Format("  %s: %s", entry.phase, entry.step) : entry.phase;
+    CLog::Log(LOGNOTICE, "CStartupTimeline: %-48s at %8.1f ms, wall %8.1f ms, cpu %8.1f ms",
+              name.c_str(), (entry.start - processStart) / 1e6,
+              (entry.end - entry.start) / 1e6, entry.cpu / 1e6);
+  }
+}
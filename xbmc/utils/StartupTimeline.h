@@ -0,0 +1,57 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <stdint.h>
+
+/*!
+ \brief Wall and CPU time of the steps from process start to the home screen.
+
+ The steps are logged once the UI is ready, later phases aren't recorded.
+ While tracing, the steps are recorded as spans of the trace as well.
+ */
+class CStartupTimeline
+{
+public:
+  /*!
+   \brief Times a startup phase and its consecutive steps, a step lasts
+   until the next one starts or the phase ends.
+
+   Names must be string literals.
+   */
+  class CPhase
+  {
+  public:
+    explicit CPhase(const char* name);
+    ~CPhase();
+    CPhase(const CPhase&) = delete;
+    CPhase& operator=(const CPhase&) = delete;
+
+    void Step(const char* name);
+
+  private:
+    void EndStep();
+
+    const char* m_name;
+    int64_t m_start;
+    int64_t m_cpuStart;
+    const char* m_step = nullptr;
+    int64_t m_stepStart = 0;
+    int64_t m_stepCpuStart = 0;
+  };
+
+  /*! \brief Log the recorded phases and stop recording */
+  static void Log();
+
+  /*! \brief CPU time of the calling thread in nanoseconds */
+  static int64_t ThreadCpuTime();
+
+private:
+  static void Record(const char* phase, const char* step, int64_t start, int64_t end, int64_t cpu);
+};
@@ -325,9 +325,23 @@ wchar_t toupperUnicode(const wchar_t& c)
   return c;
 }
 
+// ASCII only case folding without a call into the C library per character,
+// which also lets the compiler vectorize the loops using them. Multi byte
+// UTF-8 sequences are left untouched, as ::tolower did for them.
+inline char toupperAscii(char c)
+{
+  return (c >= 'a' && c <= 'z') ? c - ('a' - 'A') : c;
+}
+
+inline char tolowerAscii(char c)
+{
+  return (c >= 'A' && c <= 'Z') ? c + ('a' - 'A') : c;
+}
+
 void StringUtils::ToUpper(std::string &str)
 {
-  std::transform(str.begin(), str.end(), str.begin(), ::toupper);
+  for (char &c : str)
+    c = toupperAscii(c);
 }
 
 void StringUtils::ToUpper(std::wstring &str)
@@ -337,7 +351,8 @@ void StringUtils::ToUpper(std::wstring &str)
 
 void StringUtils::ToLower(std::string &str)
 {
-  transform(str.begin(), str.end(), str.begin(), ::tolower);
+  for (char &c : str)
+    c = tolowerAscii(c);
 }
 
 void StringUtils::ToLower(std::wstring &str)
@@ -391,7 +406,7 @@ bool StringUtils::EqualsNoCase(const char *s1, const char *s2)
   {
     const char c1 = *s1++; // const local variable should help compiler to optimize
     c2 = *s2++;
-    if (c1 != c2 && ::tolower(c1) != ::tolower(c2)) // This includes the possibility that one of the characters is the null-terminator, which implies a string mismatch.
+    if (c1 != c2 && tolowerAscii(c1) != tolowerAscii(c2)) // This includes the possibility that one of the characters is the null-terminator, which implies a string mismatch.
       return false;
   } while (c2 != '\0'); // At this point, we know c1 == c2, so there's no need to test them both.
   return true;
@@ -409,8 +424,8 @@ int StringUtils::CompareNoCase(const char *s1, const char *s2)
   {
     const char c1 = *s1++; // const local variable should help compiler to optimize
     c2 = *s2++;
-    if (c1 != c2 && ::tolower(c1) != ::tolower(c2)) // This includes the possibility that one of the characters is the null-terminator, which implies a string mismatch.
-      return ::tolower(c1) - ::tolower(c2);
+    if (c1 != c2 && tolowerAscii(c1) != tolowerAscii(c2)) // This includes the possibility that one of the characters is the null-terminator, which implies a string mismatch.
+      return tolowerAscii(c1) - tolowerAscii(c2);
   } while (c2 != '\0'); // At this point, we know c1 == c2, so there's no need to test them both.
   return 0;
 }
@@ -543,15 +558,39 @@ int StringUtils::Replace(std::string &str, const std::string &oldStr, const std:
   if (oldStr.empty())
     return 0;
 
+  size_t index = str.find(oldStr);
+  if (index == std::string::npos)
+    return 0;
+
   int replacedChars = 0;
-  size_t index = 0;
 
-  while (index < str.size() && (index = str.find(oldStr, index)) != std::string::npos)
+  // same length replacements don't move the rest of the string
+  if (oldStr.size() == newStr.size())
   {
-    str.replace(index, oldStr.size(), newStr);
-    index += newStr.size();
+    while (index != std::string::npos)
+    {
+      str.replace(index, oldStr.size(), newStr);
+      index = str.find(oldStr, index + newStr.size());
+      replacedChars++;
+    }
+    return replacedChars;
+  }
+
+  // otherwise build the result in one pass instead of moving the tail of the
+  // string for every match
+  std::string result;
+  result.reserve(str.size());
+  size_t last = 0;
+  while (index != std::string::npos)
+  {
+    result.append(str, last, index - last);
+    result += newStr;
+    last = index + oldStr.size();
+    index = str.find(oldStr, last);
     replacedChars++;
   }
+  result.append(str, last, std::string::npos);
+  str.swap(result);
 
   return replacedChars;
 }
@@ -598,6 +637,8 @@ bool StringUtils::StartsWith(const char *s1, const char *s2)
 
 bool StringUtils::StartsWithNoCase(const std::string &str1, const std::string &str2)
 {
+  if (str1.size() < str2.size())
+    return false;
   return StartsWithNoCase(str1.c_str(), str2.c_str());
 }
 
@@ -610,7 +651,7 @@ bool StringUtils::StartsWithNoCase(const char *s1, const char *s2)
 {
   while (*s2 != '\0')
   {
-    if (::tolower(*s1) != ::tolower(*s2))
+    if (tolowerAscii(*s1) != tolowerAscii(*s2))
       return false;
     s1++;
     s2++;
@@ -641,7 +682,7 @@ bool StringUtils::EndsWithNoCase(const std::string &str1, const std::string &str
   const char *s2 = str2.c_str();
   while (*s2 != '\0')
   {
-    if (::tolower(*s1) != ::tolower(*s2))
+    if (tolowerAscii(*s1) != tolowerAscii(*s2))
       return false;
     s1++;
     s2++;
@@ -657,7 +698,7 @@ bool StringUtils::EndsWithNoCase(const std::string &str1, const char *s2)
   const char *s1 = str1.c_str() + str1.size() - len2;
   while (*s2 != '\0')
   {
-    if (::tolower(*s1) != ::tolower(*s2))
+    if (tolowerAscii(*s1) != tolowerAscii(*s2))
       return false;
     s1++;
     s2++;
@@ -128,11 +128,14 @@ public:
   static std::string Join(const CONTAINER &strings, const std::string& delimiter)
   {
     std::string result;
+    bool first = true;
     for (const auto& str : strings)
-      result += str + delimiter;
-
-    if (!result.empty())
-      result.erase(result.size() - delimiter.size());
+    {
+      if (!first)
+        result += delimiter;
+      result += str;
+      first = false;
+    }
     return result;
   }
 
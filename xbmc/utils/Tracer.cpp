@@ -0,0 +1,200 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "Tracer.h"
+
+#include "filesystem/File.h"
+#include "threads/CriticalSection.h"
+#include "threads/SingleLock.h"
+#include "threads/Thread.h"
+#include "utils/StringUtils.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cinttypes>
+#include <memory>
+#include <vector>
+
+// spans kept per thread, a busy thread covers a few seconds with it
+#define TRACE_EVENTS_PER_THREAD 32768
+// oldest slots of a full ring that may be overwritten while they are saved
+#define TRACE_SAVE_MARGIN 1024
+
+namespace
+{
+
+struct TraceEvent
+{
+  const char* name;
+  int64_t start;
+  int64_t end;
+};
+
+struct TraceBuffer
+{
+  std::string thread;
+  uint64_t tid;
+  std::vector<TraceEvent> events;
+  std::atomic<uint64_t> next{0};
+};
+
+CCriticalSection& BufferSection()
+{
+  static CCriticalSection section;
+  return section;
+}
+
+std::vector<std::shared_ptr<TraceBuffer>>& Buffers()
+{
+  static std::vector<std::shared_ptr<TraceBuffer>> buffers;
+  return buffers;
+}
+
+TraceBuffer& ThreadBuffer()
+{
+  thread_local std::shared_ptr<TraceBuffer> buffer;
+  if (!buffer)
+  {
+    buffer = std::make_shared<TraceBuffer>();
+    buffer->tid = CThread::GetCurrentThreadNativeId();
+    CThread* thread = CThread::GetCurrentThread();
+    if (thread)
+      buffer->thread = thread->GetName();
+    else
+      buffer->thread = StringUtils::Format("Thread %" PRIu64, buffer->tid);
+    buffer->events.resize(TRACE_EVENTS_PER_THREAD);
+
+    CSingleLock lock(BufferSection());
+    Buffers().push_back(buffer);
+  }
+  return *buffer;
+}
+
+std::string Escape(const std::string& str)
+{
+  std::string escaped;
+  for (char c : str)
+  {
+    if (c == '"' || c == '\\')
+      escaped += '\\';
+    if (static_cast<unsigned char>(c) >= 0x20)
+      escaped += c;
+  }
+  return escaped;
+}
+
+} // namespace
+
+constexpr const char* CTracer::DEFAULT_FILE;
+std::atomic<bool> CTracer::m_enabled{false};
+
+void CTracer::Start()
+{
+  m_enabled = false;
+  {
+    CSingleLock lock(BufferSection());
+
+    // the rings of exited threads are only referenced here
+    auto& buffers = Buffers();
+    buffers.erase(std::remove_if(buffers.begin(), buffers.end(),
+                                 [](const std::shared_ptr<TraceBuffer>& buffer)
+                                 {
+                                   return buffer.use_count() == 1;
+                                 }),
+                  buffers.end());
+    for (auto& buffer : buffers)
+      buffer->next = 0;
+  }
+  m_enabled = true;
+
+  CLog::Log(LOGNOTICE, "CTracer::Start - tracing");
+}
+
+void CTracer::Stop()
+{
+  m_enabled = false;
+
+  CLog::Log(LOGNOTICE, "CTracer::Stop - tracing stopped");
+}
+
+int64_t CTracer::Now()
+{
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void CTracer::Record(const char* name, int64_t start, int64_t end)
+{
+  TraceBuffer& buffer = ThreadBuffer();
+  uint64_t next = buffer.next.load(std::memory_order_relaxed);
+  buffer.events[next % TRACE_EVENTS_PER_THREAD] = {name, start, end};
+  buffer.next.store(next + 1, std::memory_order_release);
+}
+
+bool CTracer::Save(const std::string& file)
+{
+  std::vector<std::shared_ptr<TraceBuffer>> buffers;
+  {
+    CSingleLock lock(BufferSection());
+    buffers = Buffers();
+  }
+
+  int64_t base = -1;
+  std::vector<std::vector<TraceEvent>> events(buffers.size());
+  for (size_t i = 0; i < buffers.size(); i++)
+  {
+    uint64_t next = buffers[i]->next.load(std::memory_order_acquire);
+    uint64_t first = 0;
+    if (next > TRACE_EVENTS_PER_THREAD)
+      first = next - TRACE_EVENTS_PER_THREAD + TRACE_SAVE_MARGIN;
+
+    for (uint64_t n = first; n < next; n++)
+      events[i].push_back(buffers[i]->events[n % TRACE_EVENTS_PER_THREAD]);
+
+    for (const auto& event : events[i])
+    {
+      if (base < 0 || event.start < base)
+        base = event.start;
+    }
+  }
+
+  std::string json = "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+  bool first = true;
+  for (size_t i = 0; i < buffers.size(); i++)
+  {
+    if (events[i].empty())
+      continue;
+
+    if (!first)
+      json += ',';
+    first = false;
+    json += StringUtils::Format("{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%" PRIu64 ",\"args\":{\"name\":\"%s\"}}",
+                                buffers[i]->tid, Escape(buffers[i]->thread).c_str());
+
+    for (const auto& event : events[i])
+    {
+      // trace event times are microseconds
+      json += StringUtils::Format(",{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%" PRIu64 ",\"ts\":%.3f,\"dur\":%.3f}",
+                                  Escape(event.name).c_str(), buffers[i]->tid,
+                                  (event.start - base) / 1000.0, (event.end - event.start) / 1000.0);
+    }
+  }
+  json += "]}";
+
+  XFILE::CFile out;
+  if (!out.OpenForWrite(file, true) ||
+      out.Write(json.c_str(), json.size()) != static_cast<ssize_t>(json.size()))
+  {
+    CLog::Log(LOGERROR, "CTracer::Save - unable to write %s", file.c_str());
+    return false;
+  }
+
+  CLog::Log(LOGNOTICE, "CTracer::Save - saved trace to %s", file.c_str());
+  return true;
+}
@@ -0,0 +1,76 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <stdint.h>
+#include <string>
+
+/*!
+ \brief Records timed spans of all threads into a timeline.
+
+ Spans are kept in a ring per thread that only its thread writes to, so
+ recording takes no lock. While tracing is off a span costs a relaxed
+ load. Save() writes the timeline in the Chrome trace event format,
+ which chrome://tracing and the Perfetto UI open.
+
+ Span names must be string literals or otherwise outlive the trace.
+ */
+class CTracer
+{
+public:
+  static constexpr const char* DEFAULT_FILE = "special://temp/kodi.trace.json";
+
+  /*! \brief Drop what was recorded so far and start recording */
+  static void Start();
+  static void Stop();
+
+  static bool IsEnabled()
+  {
+    return m_enabled.load(std::memory_order_relaxed);
+  }
+
+  /*!
+   \brief Write the recorded spans to a file, recording goes on.
+   \return false if the file couldn't be written
+   */
+  static bool Save(const std::string& file);
+
+  /*! \brief Nanoseconds of a steady clock, the time base of spans */
+  static int64_t Now();
+
+  static void Record(const char* name, int64_t start, int64_t end);
+
+  class CScope
+  {
+  public:
+    explicit CScope(const char* name)
+      : m_name(IsEnabled() ? name : nullptr), m_start(m_name ? Now() : 0) {}
+    ~CScope()
+    {
+      if (m_name)
+        Record(m_name, m_start, Now());
+    }
+    CScope(const CScope&) = delete;
+    CScope& operator=(const CScope&) = delete;
+
+  private:
+    const char* m_name;
+    int64_t m_start;
+  };
+
+private:
+  static std::atomic<bool> m_enabled;
+};
+
+#define TRACE_CONCAT_(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_(a, b)
+
+/*! \brief Record a span from here to the end of the enclosing scope */
+#define TRACE_SCOPE(name) CTracer::CScope TRACE_CONCAT(traceScope, __LINE__)(name)
@@ -33,6 +33,28 @@
 using namespace PVR;
 using namespace XFILE;
 
+namespace
+{
+/*!
+ \brief Get the URL in the hostname of a path, only parsing paths of protocols that have one
+ Most paths checked are plain smb://, nfs:// or local paths, which don't need a CURL.
+ */
+bool GetParentInHostname(const std::string& strFile, std::string& parent)
+{
+  const size_t pos = strFile.find("://");
+  if (pos == std::string::npos)
+    return false;
+
+  CURL protocol;
+  protocol.SetProtocol(strFile.substr(0, pos));
+  if (!URIUtils::HasParentInHostname(protocol))
+    return false;
+
+  parent = CURL(strFile).GetHostName();
+  return true;
+}
+}
+
 const CAdvancedSettings* URIUtils::m_advancedSettings = nullptr;
 
 void URIUtils::RegisterAdvancedSettings(const CAdvancedSettings& advancedSettings)
@@ -853,26 +875,22 @@ bool URIUtils::IsSpecial(const std::string& strFile)
 
 bool URIUtils::IsPlugin(const std::string& strFile)
 {
-  CURL url(strFile);
-  return url.IsProtocol("plugin");
+  return IsProtocol(strFile, "plugin");
 }
 
 bool URIUtils::IsScript(const std::string& strFile)
 {
-  CURL url(strFile);
-  return url.IsProtocol("script");
+  return IsProtocol(strFile, "script");
 }
 
 bool URIUtils::IsAddonsPath(const std::string& strFile)
 {
-  CURL url(strFile);
-  return url.IsProtocol("addons");
+  return IsProtocol(strFile, "addons");
 }
 
 bool URIUtils::IsSourcesPath(const std::string& strPath)
 {
-  CURL url(strPath);
-  return url.IsProtocol("sources");
+  return IsProtocol(strPath, "sources");
 }
 
 bool URIUtils::IsCDDA(const std::string& strFile)
@@ -893,9 +911,9 @@ bool URIUtils::IsSmb(const std::string& strFile)
   if (IsSpecial(strFile))
     return IsSmb(CSpecialProtocol::TranslatePath(strFile));
 
-  CURL url(strFile);
-  if (HasParentInHostname(url))
-    return IsSmb(url.GetHostName());
+  std::string parent;
+  if (GetParentInHostname(strFile, parent))
+    return IsSmb(parent);
 
   return IsProtocol(strFile, "smb");
 }
@@ -913,9 +931,9 @@ bool URIUtils::IsFTP(const std::string& strFile)
   if (IsSpecial(strFile))
     return IsFTP(CSpecialProtocol::TranslatePath(strFile));
 
-  CURL url(strFile);
-  if (HasParentInHostname(url))
-    return IsFTP(url.GetHostName());
+  std::string parent;
+  if (GetParentInHostname(strFile, parent))
+    return IsFTP(parent);
 
   return IsProtocol(strFile, "ftp") ||
          IsProtocol(strFile, "ftps");
@@ -929,9 +947,9 @@ bool URIUtils::IsHTTP(const std::string& strFile)
   if (IsSpecial(strFile))
     return IsHTTP(CSpecialProtocol::TranslatePath(strFile));
 
-  CURL url(strFile);
-  if (HasParentInHostname(url))
-    return IsHTTP(url.GetHostName());
+  std::string parent;
+  if (GetParentInHostname(strFile, parent))
+    return IsHTTP(parent);
 
   return IsProtocol(strFile, "http") ||
          IsProtocol(strFile, "https");
@@ -993,9 +1011,9 @@ bool URIUtils::IsDAV(const std::string& strFile)
   if (IsSpecial(strFile))
     return IsDAV(CSpecialProtocol::TranslatePath(strFile));
 
-  CURL url(strFile);
-  if (HasParentInHostname(url))
-    return IsDAV(url.GetHostName());
+  std::string parent;
+  if (GetParentInHostname(strFile, parent))
+    return IsDAV(parent);
 
   return IsProtocol(strFile, "dav") ||
          IsProtocol(strFile, "davs");
@@ -1076,9 +1094,9 @@ bool URIUtils::IsNfs(const std::string& strFile)
   if (IsSpecial(strFile))
     return IsNfs(CSpecialProtocol::TranslatePath(strFile));
 
-  CURL url(strFile);
-  if (HasParentInHostname(url))
-    return IsNfs(url.GetHostName());
+  std::string parent;
+  if (GetParentInHostname(strFile, parent))
+    return IsNfs(parent);
 
   return IsProtocol(strFile, "nfs");
 }
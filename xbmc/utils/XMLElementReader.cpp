@@ -0,0 +1,186 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "XMLElementReader.h"
+
+#include "utils/StringUtils.h"
+
+#include <cstring>
+
+CXMLElementReader::CXMLElementReader(const std::string& xml)
+  : m_xml(xml)
+{
+  // each child is parsed as a document of its own, keep the encoding of the whole
+  if (StringUtils::StartsWith(m_xml, "<?xml"))
+  {
+    size_t end = m_xml.find("?>");
+    if (end != std::string::npos)
+      m_declaration = m_xml.substr(0, end + 2);
+  }
+
+  TagType type;
+  std::string name;
+  size_t start;
+  while (NextTag(type, name, start))
+  {
+    if (type == TagOther)
+      continue;
+    if (type == TagEnd)
+      break;
+
+    m_rootName = name;
+    m_valid = true;
+    m_done = (type == TagEmpty);
+    break;
+  }
+}
+
+bool CXMLElementReader::NextTag(TagType& type, std::string& name, size_t& start)
+{
+  start = m_xml.find('<', m_pos);
+  if (start == std::string::npos)
+    return false;
+
+  const char* tag = m_xml.c_str() + start;
+  size_t end;
+  if (strncmp(tag, "<!--", 4) == 0)
+  {
+    type = TagOther;
+    end = m_xml.find("-->", start + 4);
+    if (end != std::string::npos)
+      end += 3;
+  }
+  else if (strncmp(tag, "<![CDATA[", 9) == 0)
+  {
+    type = TagOther;
+    end = m_xml.find("]]>", start + 9);
+    if (end != std::string::npos)
+      end += 3;
+  }
+  else if (tag[1] == '?')
+  {
+    type = TagOther;
+    end = m_xml.find("?>", start + 2);
+    if (end != std::string::npos)
+      end += 2;
+  }
+  else if (tag[1] == '!')
+  {
+    type = TagOther;
+    end = m_xml.find('>', start + 2);
+    if (end != std::string::npos)
+      end += 1;
+  }
+  else
+  {
+    type = TagStart;
+    size_t nameStart = start + 1;
+    if (tag[1] == '/')
+    {
+      type = TagEnd;
+      nameStart++;
+    }
+
+    size_t nameEnd = m_xml.find_first_of(" \t\r\n/>", nameStart);
+    if (nameEnd == std::string::npos || nameEnd == nameStart)
+      return false;
+    name = m_xml.substr(nameStart, nameEnd - nameStart);
+
+    // attribute values may contain '>'
+    char quote = 0;
+    for (end = nameEnd; end < m_xml.size(); end++)
+    {
+      const char c = m_xml[end];
+      if (quote)
+      {
+        if (c == quote)
+          quote = 0;
+      }
+      else if (c == '"' || c == '\'')
+        quote = c;
+      else if (c == '>')
+        break;
+    }
+    if (end == m_xml.size())
+      return false;
+
+    if (type == TagStart && m_xml[end - 1] == '/')
+      type = TagEmpty;
+    end++;
+  }
+
+  if (end == std::string::npos)
+    return false;
+
+  m_pos = end;
+  return true;
+}
+
+bool CXMLElementReader::Next()
+{
+  m_doc.Clear();
+  m_name.clear();
+
+  if (!m_valid || m_done)
+    return false;
+
+  TagType type;
+  std::string name;
+  size_t start;
+  int depth = 0;
+  while (NextTag(type, name, start))
+  {
+    if (type == TagOther)
+      continue;
+
+    if (depth == 0)
+    {
+      if (type == TagEnd)
+      {
+        // end of the root element
+        m_done = true;
+        return false;
+      }
+
+      m_name = name;
+      m_elementStart = start;
+      if (type == TagEmpty)
+      {
+        m_elementEnd = m_pos;
+        return true;
+      }
+      depth = 1;
+      continue;
+    }
+
+    if (type == TagStart)
+      depth++;
+    else if (type == TagEnd && --depth == 0)
+    {
+      m_elementEnd = m_pos;
+      return true;
+    }
+  }
+
+  // the document ended inside the root element
+  m_valid = false;
+  m_name.clear();
+  return false;
+}
+
+TiXmlElement* CXMLElementReader::Parse()
+{
+  if (m_name.empty())
+    return nullptr;
+
+  m_doc.Clear();
+  if (!m_doc.Parse(m_declaration + m_xml.substr(m_elementStart, m_elementEnd - m_elementStart)))
+    return nullptr;
+
+  return m_doc.RootElement();
+}
@@ -0,0 +1,82 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "utils/XBMCTinyXML.h"
+
+#include <string>
+
+/*!
+ * \brief Reads the child elements of the root of a big XML document one at a time
+ *
+ * Instead of building the DOM of the whole document, only the child element
+ * read last is parsed, so the memory needed is bounded by the biggest child
+ * element. The markup is only tokenized as far as needed to find where each
+ * child element ends. Comments, CDATA sections, processing instructions and
+ * text between the child elements are skipped.
+ */
+class CXMLElementReader
+{
+public:
+  /*!
+   * \param xml The document, it has to outlive the reader
+   */
+  explicit CXMLElementReader(const std::string& xml);
+
+  /*!
+   * \brief Name of the root element, empty if the document has none
+   */
+  const std::string& GetRootName() const { return m_rootName; }
+
+  /*!
+   * \brief Move to the next child element of the root
+   *
+   * \return false at the end of the root element or if the document is malformed
+   */
+  bool Next();
+
+  /*!
+   * \brief Name of the current child element
+   */
+  const std::string& GetName() const { return m_name; }
+
+  /*!
+   * \brief Parse the current child element
+   *
+   * \return The element, valid until the next call of Next(), or nullptr on error
+   */
+  TiXmlElement* Parse();
+
+  /*!
+   * \brief Whether no malformed markup was found so far
+   */
+  bool IsValid() const { return m_valid; }
+
+private:
+  enum TagType
+  {
+    TagStart,
+    TagEnd,
+    TagEmpty,
+    TagOther
+  };
+
+  bool NextTag(TagType& type, std::string& name, size_t& start);
+
+  const std::string& m_xml;
+  std::string m_declaration;
+  std::string m_rootName;
+  std::string m_name;
+  size_t m_pos = 0;
+  size_t m_elementStart = 0;
+  size_t m_elementEnd = 0;
+  bool m_valid = false;
+  bool m_done = false;
+  CXBMCTinyXML m_doc;
+};
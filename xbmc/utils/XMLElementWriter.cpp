@@ -0,0 +1,90 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "XMLElementWriter.h"
+
+#include "utils/log.h"
+
+// the elements are collected up to this size, so remote files see few large writes
+#define WRITE_BUFFER_SIZE (256 * 1024)
+
+CXMLElementWriter::CXMLElementWriter()
+  : m_root("root")
+{
+}
+
+CXMLElementWriter::~CXMLElementWriter()
+{
+  if (m_open)
+    Close();
+}
+
+bool CXMLElementWriter::Open(const std::string& path, const std::string& rootName)
+{
+  if (m_open)
+    Close();
+
+  m_root.Clear();
+  m_root.SetValue(rootName);
+  m_buffer.clear();
+  m_failed = false;
+
+  if (!m_file.OpenForWrite(path, true))
+  {
+    CLog::Log(LOGERROR, "CXMLElementWriter::%s - unable to create %s", __FUNCTION__, path.c_str());
+    return false;
+  }
+  m_open = true;
+
+  m_buffer = "<?xml version=\"1.0\" encoding=\"UTF-8\" standalone=\"yes\" ?>\n<" + rootName + ">\n";
+  return true;
+}
+
+bool CXMLElementWriter::Flush()
+{
+  if (!m_open)
+    return false;
+
+  for (const TiXmlNode* child = m_root.FirstChild(); child; child = child->NextSibling())
+  {
+    TiXmlPrinter printer;
+    child->Accept(&printer);
+    m_buffer.append(printer.CStr(), printer.Size());
+  }
+  m_root.Clear();
+
+  return Write(false);
+}
+
+bool CXMLElementWriter::Close()
+{
+  if (!m_open)
+    return false;
+
+  Flush();
+  m_buffer += "</" + m_root.ValueStr() + ">\n";
+  Write(true);
+
+  m_file.Close();
+  m_open = false;
+  return !m_failed;
+}
+
+bool CXMLElementWriter::Write(bool force)
+{
+  if (m_buffer.size() < WRITE_BUFFER_SIZE && !force)
+    return !m_failed;
+
+  if (!m_failed && m_file.Write(m_buffer.c_str(), m_buffer.size()) != static_cast<ssize_t>(m_buffer.size()))
+  {
+    CLog::Log(LOGERROR, "CXMLElementWriter::%s - write failed", __FUNCTION__);
+    m_failed = true;
+  }
+  m_buffer.clear();
+  return !m_failed;
+}
@@ -0,0 +1,59 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "filesystem/File.h"
+#include "utils/XBMCTinyXML.h"
+
+#include <string>
+
+/*!
+ * \brief Writes a big XML document one child element of the root at a time
+ *
+ * The counterpart of CXMLElementReader. Child elements are added to the
+ * root returned by GetRoot() as usual and written out by Flush(), so only
+ * the elements added since the last flush are kept in memory.
+ */
+class CXMLElementWriter
+{
+public:
+  CXMLElementWriter();
+  ~CXMLElementWriter();
+
+  /*!
+   * \brief Create the file and write the declaration and the start of the root element
+   */
+  bool Open(const std::string& path, const std::string& rootName);
+
+  /*!
+   * \brief The root element, its children are written by the next Flush()
+   */
+  TiXmlNode* GetRoot() { return &m_root; }
+
+  /*!
+   * \brief Write the children of the root and remove them from it
+   */
+  bool Flush();
+
+  /*!
+   * \brief Write the remaining children and the end of the root element
+   *
+   * \return false if any write to the file failed
+   */
+  bool Close();
+
+private:
+  bool Write(bool force);
+
+  XFILE::CFile m_file;
+  TiXmlElement m_root;
+  std::string m_buffer;
+  bool m_open = false;
+  bool m_failed = false;
+};
@@ -8,14 +8,16 @@
 
 #include "log.h"
 #include "CompileInfo.h"
-#include "ServiceBroker.h"
-#include "settings/AdvancedSettings.h"
-#include "settings/SettingsComponent.h"
 #include "threads/CriticalSection.h"
 #include "threads/SingleLock.h"
 #include "threads/Thread.h"
 #include "utils/StringUtils.h"
 
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+
 #if defined(TARGET_POSIX)
 #include "platform/posix/utils/PosixInterfaceForCLog.h"
 typedef class CPosixInterfaceForCLog PlatformInterfaceForCLog;
@@ -32,12 +34,22 @@ static const char* const levelNames[] =
 static const char* const logLevelNames[] =
 { "LOG_LEVEL_NONE" /*-1*/, "LOG_LEVEL_NORMAL" /*0*/, "LOG_LEVEL_DEBUG" /*1*/, "LOG_LEVEL_DEBUG_FREEMEM" /*2*/ };
 
+// Lines waiting for the writer thread. Beyond this, lines are dropped
+// rather than blocking the logging thread on a slow disk.
+#define LOG_QUEUE_MAX_LINES 20000
+
 namespace
 {
 class CLogGlobals
 {
 public:
-  ~CLogGlobals() = default;
+  ~CLogGlobals() { StopWriter(); }
+
+  void StartWriter();
+  void StopWriter();
+  void Queue(std::string&& line);
+  void Flush();
+
   PlatformInterfaceForCLog m_platform;
   int         m_repeatCount = 0;
   int         m_repeatLogLevel = -1;
@@ -45,8 +57,120 @@ public:
   int         m_logLevel = LOG_LEVEL_DEBUG;
   int         m_extraLogLevels = 0;
   CCriticalSection critSec;
+
+private:
+  void Process();
+
+  // lines are formatted by the logging thread and written to the file by
+  // a writer thread, so slow storage doesn't stall the callers
+  std::thread m_writer;
+  std::mutex m_fileMutex;
+  std::mutex m_queueMutex;
+  std::condition_variable m_queueCond;
+  std::vector<std::string> m_queue;
+  unsigned int m_dropped = 0;
+  bool m_stop = false;
 };
 
+void CLogGlobals::StartWriter()
+{
+  if (m_writer.joinable())
+    return;
+
+  m_stop = false;
+  m_writer = std::thread(&CLogGlobals::Process, this);
+}
+
+void CLogGlobals::StopWriter()
+{
+  if (!m_writer.joinable())
+    return;
+
+  {
+    std::unique_lock<std::mutex> lock(m_queueMutex);
+    m_stop = true;
+  }
+  m_queueCond.notify_one();
+  m_writer.join();
+  Flush();
+}
+
+void CLogGlobals::Queue(std::string&& line)
+{
+  if (!m_writer.joinable())
+  {
+    std::unique_lock<std::mutex> lock(m_fileMutex);
+    m_platform.WriteStringToLog(line);
+    return;
+  }
+
+  bool wasEmpty;
+  {
+    std::unique_lock<std::mutex> lock(m_queueMutex);
+    if (m_queue.size() >= LOG_QUEUE_MAX_LINES)
+    {
+      m_dropped++;
+      return;
+    }
+    wasEmpty = m_queue.empty();
+    m_queue.emplace_back(std::move(line));
+  }
+  if (wasEmpty)
+    m_queueCond.notify_one();
+}
+
+void CLogGlobals::Flush()
+{
+  // holding the file lock while taking the queue keeps the lines in order
+  // when a caller flushes while the writer thread is busy
+  std::unique_lock<std::mutex> fileLock(m_fileMutex);
+
+  std::vector<std::string> lines;
+  unsigned int dropped;
+  {
+    std::unique_lock<std::mutex> lock(m_queueMutex);
+    lines.swap(m_queue);
+    dropped = m_dropped;
+    m_dropped = 0;
+  }
+
+  if (lines.empty() && dropped == 0)
+    return;
+
+  std::string data;
+  for (const std::string& line : lines)
+  {
+    if (!data.empty())
+      data += '\n';
+    data += line;
+  }
+  if (dropped)
+  {
+    if (!data.empty())
+      data += '\n';
+    data += StringUtils::Format("%u log lines were dropped, logging could not keep up.", dropped);
+  }
+
+  m_platform.WriteStringToLog(data);
+}
+
+void CLogGlobals::Process()
+{
+  std::unique_lock<std::mutex> lock(m_queueMutex);
+  while (!m_stop)
+  {
+    if (m_queue.empty() && m_dropped == 0)
+    {
+      m_queueCond.wait(lock);
+      continue;
+    }
+
+    lock.unlock();
+    Flush();
+    lock.lock();
+  }
+}
+
 static CLogGlobals g_logState;
 }
 
@@ -57,6 +181,7 @@ CLog::~CLog() = default;
 void CLog::Close()
 {
   CSingleLock waitLock(g_logState.critSec);
+  g_logState.StopWriter();
   g_logState.m_platform.CloseLogFile();
   g_logState.m_repeatLine.clear();
 }
@@ -88,12 +213,16 @@ void CLog::LogString(int logLevel, std::string&& logString)
     PrintDebugString(strData);
 
     WriteLogString(logLevel, strData);
+
+    // make sure the reason is on disk if this is followed by a crash
+    if (logLevel >= LOGSEVERE)
+      g_logState.Flush();
   }
 }
 
 void CLog::LogString(int logLevel, int component, std::string&& logString)
 {
-  if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->CanLogComponent(component) && IsLogLevelLogged(logLevel))
+  if (IsComponentLogged(component) && IsLogLevelLogged(logLevel))
     LogString(logLevel, std::move(logString));
 }
 
@@ -106,7 +235,11 @@ bool CLog::Init(const std::string& path)
 
   std::string appName = CCompileInfo::GetAppName();
   StringUtils::ToLower(appName);
-  return g_logState.m_platform.OpenLogFile(path + appName + ".log", path + appName + ".old.log");
+  if (!g_logState.m_platform.OpenLogFile(path + appName + ".log", path + appName + ".old.log"))
+    return false;
+
+  g_logState.StartWriter();
+  return true;
 }
 
 void CLog::MemDump(char *pData, int length)
@@ -163,6 +296,14 @@ void CLog::SetExtraLogLevels(int level)
   g_logState.m_extraLogLevels = level;
 }
 
+bool CLog::IsComponentLogged(int component)
+{
+  if (component <= 0)
+    return false;
+
+  return (g_logState.m_extraLogLevels & component) == component;
+}
+
 bool CLog::IsLogLevelLogged(int loglevel)
 {
   const int extras = (loglevel & ~LOGMASK);
@@ -209,5 +350,6 @@ bool CLog::WriteLogString(int logLevel, const std::string& logString)
                                   static_cast<uint64_t>(CThread::GetCurrentThreadNativeId()),
                                   levelNames[logLevel]) + strData;
 
-  return g_logState.m_platform.WriteStringToLog(strData);
+  g_logState.Queue(std::move(strData));
+  return true;
 }
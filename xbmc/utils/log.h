@@ -37,16 +37,16 @@ public:
 
   static void Log(int loglevel, int component, const char* format)
   {
-    if (IsLogLevelLogged(loglevel))
+    if (IsLogLevelLogged(loglevel) && IsComponentLogged(component))
       LogString(loglevel, component, format);
   }
 
   template<typename... Args>
   static void Log(int loglevel, int component, const char* format, Args&&... args)
   {
-    // We defer component checking to LogString to avoid having to drag in advancedsettings
-    // everywhere we want to log anything
-    if (IsLogLevelLogged(loglevel))
+    // Check the component before formatting, so disabled component logging
+    // is cheap enough for hot paths
+    if (IsLogLevelLogged(loglevel) && IsComponentLogged(component))
       LogString(loglevel, component, StringUtils::Format(format, std::forward<Args>(args)...));
   }
 
@@ -71,7 +71,7 @@ public:
 
   static void LogFunction(int loglevel, std::string functionName, int component, const char* format)
   {
-    if (IsLogLevelLogged(loglevel))
+    if (IsLogLevelLogged(loglevel) && IsComponentLogged(component))
       LogString(loglevel, component, functionName + ": " + format);
   }
 
@@ -79,9 +79,7 @@ public:
   static void LogFunction(
       int loglevel, std::string functionName, int component, const char* format, Args&&... args)
   {
-    // We defer component checking to LogString to avoid having to drag in advancedsettings
-    // everywhere we want to log anything
-    if (IsLogLevelLogged(loglevel))
+    if (IsLogLevelLogged(loglevel) && IsComponentLogged(component))
     {
       functionName.append(": ");
       LogString(loglevel, component,
@@ -95,8 +93,14 @@ public:
   static void PrintDebugString(const std::string& line); // universal interface for printing debug strings
   static void SetLogLevel(int level);
   static int  GetLogLevel();
+  /*!
+   * \brief Set the components whose extra logging is enabled
+   *
+   * \param level The enabled LOGxxx component masks, 0 if extra logging is off
+   */
   static void SetExtraLogLevels(int level);
   static bool IsLogLevelLogged(int loglevel);
+  static bool IsComponentLogged(int component);
 
 protected:
   static void LogString(int logLevel, std::string&& logString);
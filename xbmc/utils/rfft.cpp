@@ -14,7 +14,8 @@
 #include <math.h>
 
 RFFT::RFFT(int size, bool windowed) :
-  m_size(size), m_windowed(windowed)
+  m_size(size), m_windowed(windowed),
+  m_linput(size), m_rinput(size), m_loutput(size), m_routput(size)
 {
   m_cfg = kiss_fftr_alloc(m_size,0,nullptr,nullptr);
 }
@@ -30,9 +31,10 @@ RFFT::~RFFT()
 
 void RFFT::calc(const float* input, float* output)
 {
-  // temporary buffers
-  std::vector<kiss_fft_scalar> linput(m_size), rinput(m_size);
-  std::vector<kiss_fft_cpx> loutput(m_size), routput(m_size);
+  std::vector<kiss_fft_scalar>& linput = m_linput;
+  std::vector<kiss_fft_scalar>& rinput = m_rinput;
+  std::vector<kiss_fft_cpx>& loutput = m_loutput;
+  std::vector<kiss_fft_cpx>& routput = m_routput;
 
   for (size_t i=0;i<m_size;++i)
   {
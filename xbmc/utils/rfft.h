@@ -36,4 +36,6 @@ protected:
   size_t m_size;       //!< Size for a single channel.
   bool m_windowed;     //!< Whether or not a Hann window is applied.
   kiss_fftr_cfg m_cfg; //!< FFT plan
+  std::vector<kiss_fft_scalar> m_linput, m_rinput; //!< Time data per channel, reused across calls
+  std::vector<kiss_fft_cpx> m_loutput, m_routput;  //!< Frequency data per channel, reused across calls
 };
@@ -9,6 +9,7 @@
 #include "dbwrappers/qry_dat.h"
 #include "music/MusicDatabase.h"
 #include "utils/DatabaseUtils.h"
+#include "utils/SortUtils.h"
 #include "utils/StringUtils.h"
 #include "utils/Variant.h"
 #include "video/VideoDatabase.h"
@@ -1349,6 +1350,32 @@ TEST(TestDatabaseUtils, BuildLimitClause)
   EXPECT_STREQ(" LIMIT 100", a.c_str());
 }
 
+TEST(TestDatabaseUtils, BuildOrderByClause)
+{
+  SortDescription sorting;
+  EXPECT_TRUE(DatabaseUtils::BuildOrderByClause(sorting, MediaTypeMovie).empty());
+
+  sorting.sortBy = SortByDateAdded;
+  sorting.sortOrder = SortOrderDescending;
+  EXPECT_STREQ(" ORDER BY movie_view.dateAdded DESC, movie_view.idMovie DESC",
+               DatabaseUtils::BuildOrderByClause(sorting, MediaTypeMovie).c_str());
+  EXPECT_STREQ(" ORDER BY songview.dateAdded DESC, songview.idSong DESC",
+               DatabaseUtils::BuildOrderByClause(sorting, MediaTypeSong).c_str());
+
+  // ties are sorted by label
+  sorting.sortBy = SortByLastPlayed;
+  EXPECT_TRUE(DatabaseUtils::BuildOrderByClause(sorting, MediaTypeMovie).empty());
+  sorting.sortAttributes = SortAttributeIgnoreLabel;
+  EXPECT_STREQ(" ORDER BY movie_view.lastPlayed DESC, movie_view.idMovie ASC",
+               DatabaseUtils::BuildOrderByClause(sorting, MediaTypeMovie).c_str());
+
+  sorting.sortBy = SortByRandom;
+  EXPECT_STREQ(" ORDER BY RANDOM()", DatabaseUtils::BuildOrderByClause(sorting, MediaTypeSong).c_str());
+
+  sorting.sortBy = SortByTitle;
+  EXPECT_TRUE(DatabaseUtils::BuildOrderByClause(sorting, MediaTypeMovie).empty());
+}
+
 // class DatabaseUtils
 // {
 // public:
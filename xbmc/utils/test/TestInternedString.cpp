@@ -0,0 +1,67 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/InternedString.h"
+
+#include <gtest/gtest.h>
+
+TEST(TestInternedString, SharesEqualValues)
+{
+  CInternedString a(std::string("News"));
+  CInternedString b("News");
+  CInternedString c("Weather");
+
+  EXPECT_EQ(a, b);
+  EXPECT_NE(a, c);
+  EXPECT_EQ(&a.Get(), &b.Get());
+  EXPECT_EQ("News", a.Get());
+}
+
+TEST(TestInternedString, Empty)
+{
+  CInternedString a;
+  CInternedString b("");
+
+  EXPECT_TRUE(a.empty());
+  EXPECT_TRUE(b.empty());
+  EXPECT_EQ(a, b);
+  EXPECT_EQ("", a.Get());
+}
+
+TEST(TestInternedString, OutlivesFirstHolder)
+{
+  CInternedString b;
+  {
+    CInternedString a("Movie");
+    b = a;
+  }
+  CInternedString c("Movie");
+  EXPECT_EQ(b, c);
+  EXPECT_EQ("Movie", c.Get());
+}
+
+TEST(TestInternedString, StringList)
+{
+  CInternedStringList a(std::vector<std::string>{"Drama", "Crime"});
+  CInternedStringList b(std::vector<std::string>{"Drama", "Crime"});
+  CInternedStringList c(std::vector<std::string>{"Crime", "Drama"});
+
+  EXPECT_EQ(a, b);
+  EXPECT_NE(a, c);
+  ASSERT_EQ(2u, a.Get().size());
+  EXPECT_EQ("Drama", a.Get()[0]);
+}
+
+TEST(TestInternedString, IdentityHash)
+{
+  CInternedString a("News");
+  CInternedString b(std::string("News"));
+
+  EXPECT_EQ(CInternedString::IdentityHash()(a), CInternedString::IdentityHash()(b));
+  EXPECT_EQ(CInternedString::IdentityHash()(CInternedString()), CInternedString::IdentityHash()(CInternedString("")));
+}
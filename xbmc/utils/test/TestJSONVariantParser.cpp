@@ -187,3 +187,26 @@ TEST(TestJSONVariantParser, CanParseArray)
   ASSERT_TRUE(variant[0]["foo"].isString());
   ASSERT_STREQ("bar", variant[0]["foo"].asString().c_str());
 }
+
+TEST(TestJSONVariantParser, CanParseNested)
+{
+  CVariant variant;
+  ASSERT_TRUE(CJSONVariantParser::Parse("{ \"a\": [ [ 1, 2 ], { \"b\": [ \"c\" ] }, null ], \"d\": 3 }", variant));
+  ASSERT_TRUE(variant.isObject());
+  ASSERT_EQ(2U, variant.size());
+  ASSERT_TRUE(variant["a"].isArray());
+  ASSERT_EQ(3U, variant["a"].size());
+  ASSERT_EQ(2U, variant["a"][0].size());
+  ASSERT_EQ(2, variant["a"][0][1].asInteger());
+  ASSERT_STREQ("c", variant["a"][1]["b"][0].asString().c_str());
+  ASSERT_TRUE(variant["a"][2].isNull());
+  ASSERT_EQ(3, variant["d"].asInteger());
+}
+
+TEST(TestJSONVariantParser, KeepsDataOnError)
+{
+  CVariant variant("foo");
+  ASSERT_FALSE(CJSONVariantParser::Parse("{ \"a\": [ 1, ", variant));
+  ASSERT_TRUE(variant.isString());
+  ASSERT_STREQ("foo", variant.asString().c_str());
+}
@@ -149,3 +149,20 @@ TEST(TestJSONVariantWriter, CanWriteArray)
   ASSERT_TRUE(CJSONVariantWriter::Write(variant, str, false));
   ASSERT_STREQ("[\n\t{\n\t\t\"foo\": \"bar\"\n\t}\n]", str.c_str());
 }
+
+TEST(TestJSONVariantWriter, CanWriteTemporary)
+{
+  CVariant variant(CVariant::VariantTypeObject);
+  variant["foo"].push_back("bar");
+  variant["foo"].push_back(1);
+  variant["baz"]["sub-baz"] = true;
+  const CVariant copy(variant);
+
+  std::string expected;
+  ASSERT_TRUE(CJSONVariantWriter::Write(copy, expected, true));
+
+  std::string str;
+  ASSERT_TRUE(CJSONVariantWriter::Write(std::move(variant), str, true));
+  ASSERT_STREQ(expected.c_str(), str.c_str());
+  ASSERT_STREQ("{\"baz\":{\"sub-baz\":true},\"foo\":[\"bar\",1]}", str.c_str());
+}
@@ -108,6 +108,52 @@ TEST_F(TestJobManager, CancelJob)
   delete flags;
 }
 
+TEST_F(TestJobManager, AddJobWithDependency)
+{
+  Flags* first = new Flags();
+  Flags* second = new Flags();
+  unsigned int id = CJobManager::GetInstance().AddJob(new DummyJob(first), NULL);
+  CJobManager::GetInstance().AddJob(new ReallyDumbJob(second), NULL, CJob::PRIORITY_LOW, {id});
+
+  ASSERT_TRUE(poll([first]() -> bool { return first->started; }));
+
+  // the dependent job waits until the first one is done
+  EXPECT_FALSE(second->finished);
+  first->lingerAtWork = false;
+
+  ASSERT_TRUE(poll([second]() -> bool { return second->finished; }));
+  EXPECT_TRUE(first->finished);
+  delete first;
+  delete second;
+}
+
+TEST_F(TestJobManager, CancelJobWithDependent)
+{
+  Flags* first = new Flags();
+  Flags* second = new Flags();
+  Flags* third = new Flags();
+  const unsigned int queued = CJobManager::GetInstance().GetStatistics().jobs[""].queued;
+  unsigned int id = CJobManager::GetInstance().AddJob(new DummyJob(first), NULL);
+  unsigned int dependent = CJobManager::GetInstance().AddJob(new ReallyDumbJob(second), NULL, CJob::PRIORITY_LOW, {id});
+  CJobManager::GetInstance().AddJob(new ReallyDumbJob(third), NULL, CJob::PRIORITY_LOW, {dependent});
+
+  ASSERT_TRUE(poll([first]() -> bool { return first->started; }));
+
+  // cancelling a job drops everything that depends on it
+  CJobManager::GetInstance().CancelJob(id);
+  first->lingerAtWork = false;
+  ASSERT_TRUE(poll([first]() -> bool { return first->finished; }));
+
+  ASSERT_TRUE(poll([queued]() -> bool {
+    return CJobManager::GetInstance().GetStatistics().jobs[""].queued == queued;
+  }));
+  EXPECT_FALSE(second->finished);
+  EXPECT_FALSE(third->finished);
+  delete first;
+  delete second;
+  delete third;
+}
+
 namespace
 {
 struct JobControlPackage
@@ -215,3 +261,23 @@ TEST_F(TestJobManager, IsProcessing)
 
   job->FinishAndStopBlocking();
 }
+
+TEST_F(TestJobManager, Statistics)
+{
+  const CJobManager::JobStats before = CJobManager::GetInstance().GetStatistics().jobs["BroadcastingJob"];
+
+  JobControlPackage package;
+  BroadcastingJob *job (WaitForJobToStartProcessing(CJob::PRIORITY_LOW, package));
+
+  CJobManager::Statistics statistics = CJobManager::GetInstance().GetStatistics();
+  EXPECT_LE(1u, statistics.workers);
+  EXPECT_EQ(before.queued, statistics.jobs["BroadcastingJob"].queued);
+  EXPECT_EQ(before.processing + 1, statistics.jobs["BroadcastingJob"].processing);
+
+  job->FinishAndStopBlocking();
+
+  ASSERT_TRUE(poll([&before]() -> bool {
+    return CJobManager::GetInstance().GetStatistics().jobs["BroadcastingJob"].completed == before.completed + 1;
+  }));
+  EXPECT_EQ(before.processing, CJobManager::GetInstance().GetStatistics().jobs["BroadcastingJob"].processing);
+}
@@ -0,0 +1,60 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/MemoryPressure.h"
+
+#include <string>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+namespace
+{
+class CTestHandler : public IMemoryPressureHandler
+{
+public:
+  CTestHandler(std::vector<std::string>& calls, const std::string& name)
+    : m_calls(calls), m_name(name) {}
+
+  void OnMemoryPressure(MemoryPressure level) override
+  {
+    if (level == MemoryPressure::CRITICAL)
+      m_calls.push_back(m_name);
+  }
+
+private:
+  std::vector<std::string>& m_calls;
+  std::string m_name;
+};
+}
+
+TEST(TestMemoryPressure, SignaledPressureTrimsByPriority)
+{
+  std::vector<std::string> calls;
+  CTestHandler gui(calls, "gui");
+  CTestHandler cache(calls, "cache");
+  CTestHandler removed(calls, "removed");
+
+  CMemoryPressureManager& manager = CMemoryPressureManager::GetInstance();
+  manager.Register(&gui, "test gui", CMemoryPressureManager::PRIORITY_GUI);
+  manager.Register(&cache, "test cache", CMemoryPressureManager::PRIORITY_CACHE);
+  manager.Register(&removed, "test removed", CMemoryPressureManager::PRIORITY_CACHE);
+  manager.Unregister(&removed);
+
+  manager.Signal(MemoryPressure::MODERATE);
+  manager.Signal(MemoryPressure::CRITICAL);
+  manager.Process();
+
+  manager.Unregister(&gui);
+  manager.Unregister(&cache);
+
+  ASSERT_EQ(2u, calls.size());
+  EXPECT_EQ("cache", calls[0]);
+  EXPECT_EQ("gui", calls[1]);
+  EXPECT_EQ(0u, manager.GetStatus().find("critical, 1 trims"));
+}
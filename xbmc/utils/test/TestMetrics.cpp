@@ -0,0 +1,51 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "utils/Metrics.h"
+
+#include <chrono>
+
+#include <gtest/gtest.h>
+
+TEST(TestMetrics, ExportsCounters)
+{
+  CMetrics::Counter* counter = CMetrics::RegisterCounter("test_metrics_counter_total", "A test counter");
+  EXPECT_EQ(counter, CMetrics::RegisterCounter("test_metrics_counter_total", "Same name, same counter"));
+  counter->Add();
+  counter->Add(2);
+
+  std::string out;
+  CMetrics::Export(out);
+  EXPECT_NE(std::string::npos, out.find("# HELP test_metrics_counter_total A test counter\n"
+                                        "# TYPE test_metrics_counter_total counter\n"
+                                        "test_metrics_counter_total 3\n"));
+}
+
+TEST(TestMetrics, ExportsHistograms)
+{
+  CMetrics::Histogram* histogram = CMetrics::RegisterHistogram("test_metrics_time", "A test histogram");
+  histogram->Observe(std::chrono::microseconds(800));
+  histogram->Observe(std::chrono::milliseconds(3));
+  histogram->Observe(std::chrono::seconds(10));
+
+  std::string out;
+  CMetrics::Export(out);
+  EXPECT_NE(std::string::npos, out.find("# TYPE test_metrics_time_seconds histogram\n"));
+  EXPECT_NE(std::string::npos, out.find("test_metrics_time_seconds_bucket{le=\"0.000500\"} 0\n"));
+  EXPECT_NE(std::string::npos, out.find("test_metrics_time_seconds_bucket{le=\"0.001000\"} 1\n"));
+  EXPECT_NE(std::string::npos, out.find("test_metrics_time_seconds_bucket{le=\"0.005000\"} 2\n"));
+  EXPECT_NE(std::string::npos, out.find("test_metrics_time_seconds_bucket{le=\"5.000000\"} 2\n"));
+  EXPECT_NE(std::string::npos, out.find("test_metrics_time_seconds_bucket{le=\"+Inf\"} 3\n"));
+  EXPECT_NE(std::string::npos, out.find("test_metrics_time_seconds_sum 10.003800\n"));
+  EXPECT_NE(std::string::npos, out.find("test_metrics_time_seconds_count 3\n"));
+}
+
+TEST(TestMetrics, EscapesLabels)
+{
+  EXPECT_EQ("a\\\"b\\\\c\\nd", CMetrics::EscapeLabel("a\"b\\c\nd"));
+}
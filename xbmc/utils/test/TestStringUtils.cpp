@@ -80,6 +80,8 @@ TEST(TestStringUtils, EqualsNoCase)
 
   EXPECT_TRUE(StringUtils::EqualsNoCase(refstr, "TeSt"));
   EXPECT_TRUE(StringUtils::EqualsNoCase(refstr, "tEsT"));
+  EXPECT_FALSE(StringUtils::EqualsNoCase(refstr, "tEsTs"));
+  EXPECT_TRUE(StringUtils::EqualsNoCase("\xc3\x84TeSt", "\xc3\x84test"));
 }
 
 TEST(TestStringUtils, Left)
@@ -192,6 +194,13 @@ TEST(TestStringUtils, Replace)
 
   EXPECT_EQ(StringUtils::Replace(varstr, "s", "x"), 0);
   EXPECT_STREQ(refstr.c_str(), varstr.c_str());
+
+  varstr = "a-b-c";
+  EXPECT_EQ(StringUtils::Replace(varstr, "-", " - "), 2);
+  EXPECT_STREQ("a - b - c", varstr.c_str());
+
+  EXPECT_EQ(StringUtils::Replace(varstr, " - ", ""), 2);
+  EXPECT_STREQ("abc", varstr.c_str());
 }
 
 TEST(TestStringUtils, StartsWith)
@@ -237,6 +246,12 @@ TEST(TestStringUtils, Join)
   refstr = "a,b,c,de,,,fg,,";
   varstr = StringUtils::Join(strarray, ",");
   EXPECT_STREQ(refstr.c_str(), varstr.c_str());
+
+  strarray.clear();
+  strarray.emplace_back("");
+  strarray.emplace_back("");
+  varstr = StringUtils::Join(strarray, ", ");
+  EXPECT_STREQ(", ", varstr.c_str());
 }
 
 TEST(TestStringUtils, Split)
@@ -0,0 +1,57 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/File.h"
+#include "utils/Tracer.h"
+
+#include <gtest/gtest.h>
+
+namespace
+{
+
+std::string SaveTrace()
+{
+  const std::string file = "special://temp/testtracer.json";
+  EXPECT_TRUE(CTracer::Save(file));
+
+  XFILE::CFile in;
+  XFILE::auto_buffer buffer;
+  EXPECT_GT(in.LoadFile(file, buffer), 0);
+  in.Close();
+  XFILE::CFile::Delete(file);
+
+  return std::string(buffer.get(), buffer.size());
+}
+
+} // namespace
+
+TEST(TestTracer, RecordsSpans)
+{
+  CTracer::Start();
+  {
+    TRACE_SCOPE("TestTracer::Outer");
+    TRACE_SCOPE("TestTracer::Inner");
+  }
+  CTracer::Stop();
+
+  std::string trace = SaveTrace();
+  EXPECT_NE(std::string::npos, trace.find("\"traceEvents\""));
+  EXPECT_NE(std::string::npos, trace.find("\"name\":\"TestTracer::Outer\",\"ph\":\"X\""));
+  EXPECT_NE(std::string::npos, trace.find("\"name\":\"TestTracer::Inner\",\"ph\":\"X\""));
+}
+
+TEST(TestTracer, IgnoresSpansWhenStopped)
+{
+  CTracer::Start();
+  CTracer::Stop();
+  {
+    TRACE_SCOPE("TestTracer::Stopped");
+  }
+
+  EXPECT_EQ(std::string::npos, SaveTrace().find("TestTracer::Stopped"));
+}
@@ -389,6 +389,9 @@ TEST_F(TestURIUtils, IsSmb)
 {
   EXPECT_TRUE(URIUtils::IsSmb("smb://path/to/file"));
   EXPECT_TRUE(URIUtils::IsSmb("stack://smb://path/to/file"));
+  EXPECT_TRUE(URIUtils::IsSmb(URIUtils::CreateArchivePath("zip", CURL("smb://server/share/archive.zip"), "file").Get()));
+  EXPECT_FALSE(URIUtils::IsSmb(URIUtils::CreateArchivePath("zip", CURL("/path/to/archive.zip"), "file").Get()));
+  EXPECT_FALSE(URIUtils::IsSmb("/path/to/file"));
 }
 
 TEST_F(TestURIUtils, IsSpecial)
@@ -8,6 +8,8 @@
 
 #include "utils/Variant.h"
 
+#include <type_traits>
+
 #include <gtest/gtest.h>
 
 TEST(TestVariant, VariantTypeInteger)
@@ -332,3 +334,17 @@ TEST(TestVariant, isMember)
   EXPECT_TRUE(a.isMember("key1"));
   EXPECT_FALSE(a.isMember("key2"));
 }
+
+TEST(TestVariant, MoveArray)
+{
+  static_assert(std::is_nothrow_move_constructible<CVariant>::value,
+                "arrays of variants copy their items when they grow");
+
+  CVariant a;
+  a.push_back("string1");
+  CVariant b(std::move(a));
+
+  EXPECT_TRUE(a.isNull());
+  EXPECT_EQ(1U, b.size());
+  EXPECT_STREQ("string1", b[0].c_str());
+}
@@ -0,0 +1,63 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "filesystem/File.h"
+#include "test/TestUtils.h"
+#include "utils/XBMCTinyXML.h"
+#include "utils/XMLElementWriter.h"
+#include "utils/XMLUtils.h"
+
+#include <gtest/gtest.h>
+
+TEST(TestXMLElementWriter, WriteInParts)
+{
+  XFILE::CFile *file = XBMC_CREATETEMPFILE(".xml");
+  ASSERT_NE(nullptr, file);
+  file->Close();
+  const std::string path = XBMC_TEMPFILEPATH(file);
+
+  CXMLElementWriter writer;
+  ASSERT_TRUE(writer.Open(path, "videodb"));
+  XMLUtils::SetInt(writer.GetRoot(), "version", 1);
+  EXPECT_TRUE(writer.Flush());
+  EXPECT_EQ(nullptr, writer.GetRoot()->FirstChild());
+
+  for (int i = 0; i < 3; i++)
+  {
+    TiXmlElement movie("movie");
+    XMLUtils::SetString(&movie, "title", "A & B");
+    writer.GetRoot()->InsertEndChild(movie);
+    if (i == 0)
+    {
+      EXPECT_TRUE(writer.Flush());
+    }
+  }
+  EXPECT_TRUE(writer.Close());
+
+  CXBMCTinyXML doc;
+  ASSERT_TRUE(doc.LoadFile(path));
+  TiXmlElement *root = doc.RootElement();
+  ASSERT_NE(nullptr, root);
+  EXPECT_EQ("videodb", root->ValueStr());
+
+  int version = 0;
+  EXPECT_TRUE(XMLUtils::GetInt(root, "version", version));
+  EXPECT_EQ(1, version);
+
+  int movies = 0;
+  for (TiXmlElement *movie = root->FirstChildElement("movie"); movie; movie = movie->NextSiblingElement("movie"))
+  {
+    std::string title;
+    EXPECT_TRUE(XMLUtils::GetString(movie, "title", title));
+    EXPECT_EQ("A & B", title);
+    movies++;
+  }
+  EXPECT_EQ(3, movies);
+
+  EXPECT_TRUE(XBMC_DELETETEMPFILE(file));
+}
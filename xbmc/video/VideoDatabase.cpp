@@ -43,13 +43,18 @@
 #include "settings/Settings.h"
 #include "settings/SettingsComponent.h"
 #include "storage/MediaManager.h"
+#include "threads/Condition.h"
+#include "threads/SingleLock.h"
 #include "threads/SystemClock.h"
 #include "utils/FileUtils.h"
 #include "utils/GroupUtils.h"
+#include "utils/JobManager.h"
 #include "utils/LabelFormatter.h"
 #include "utils/StringUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/Variant.h"
+#include "utils/XMLElementReader.h"
+#include "utils/XMLElementWriter.h"
 #include "utils/XMLUtils.h"
 #include "utils/log.h"
 #include "video/VideoDbUrl.h"
@@ -57,8 +62,10 @@
 #include "video/windows/GUIWindowVideoBase.h"
 
 #include <algorithm>
+#include <atomic>
 #include <map>
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 
@@ -69,6 +76,59 @@ using namespace ADDON;
 using namespace KODI::MESSAGING;
 using namespace KODI::GUILIB;
 
+// sources whose files are checked at the same time while cleaning
+#define CLEAN_SOURCES_AT_ONCE 4
+// ids in a single statement while cleaning, keeps the statements of big
+// libraries below the length limits of the database servers
+#define CLEAN_IDS_PER_STATEMENT 1000
+
+namespace
+{
+// bumped on every art write so that art cached by the thumb loaders can be dropped
+std::atomic<unsigned int> artRevision{0};
+
+/*!
+ \brief The files of a source checked for existence by a job of the clean
+ */
+struct SCleanSourceCheck
+{
+  std::vector<std::string> paths;
+  std::vector<size_t> files; ///< index of each path in the files of the clean
+  std::vector<bool> exists;
+};
+
+/*!
+ \brief Progress of the jobs checking the sources of a clean
+ */
+struct SCleanCheckState
+{
+  CCriticalSection section;
+  XbmcThreads::ConditionVariable done;
+  size_t pending = 0;
+  size_t checked = 0;
+};
+
+std::vector<std::string> JoinIdsInBatches(const std::vector<std::string>& ids)
+{
+  std::vector<std::string> batches;
+  for (size_t i = 0; i < ids.size(); i += CLEAN_IDS_PER_STATEMENT)
+  {
+    const size_t end = std::min(ids.size(), i + CLEAN_IDS_PER_STATEMENT);
+    batches.push_back(StringUtils::Join(std::vector<std::string>(ids.begin() + i, ids.begin() + end), ","));
+  }
+  return batches;
+}
+
+std::vector<std::string> JoinIdsInBatches(const std::vector<int>& ids)
+{
+  std::vector<std::string> strIds;
+  strIds.reserve(ids.size());
+  for (int id : ids)
+    strIds.push_back(StringUtils::Format("%i", id));
+  return JoinIdsInBatches(strIds);
+}
+}
+
 //********************************************************************************************************************************
 CVideoDatabase::CVideoDatabase(void) = default;
 
@@ -193,6 +253,20 @@ void CVideoDatabase::CreateTables()
 
   CLog::Log(LOGINFO, "create uniqueid table");
   m_pDS->exec("CREATE TABLE uniqueid (uniqueid_id INTEGER PRIMARY KEY, media_id INTEGER, media_type TEXT, value TEXT, type TEXT)");
+
+  CreateChangeLogTable();
+
+  CLog::Log(LOGINFO, "create navsummary table");
+  m_pDS->exec("CREATE TABLE navsummary (item_type TEXT, item_id INTEGER, media_type TEXT, total INTEGER, watched INTEGER)");
+
+  CLog::Log(LOGINFO, "create pathfingerprint table");
+  m_pDS->exec("CREATE TABLE pathfingerprint (idPath INTEGER PRIMARY KEY, strFingerprint TEXT, strHash TEXT, strSubDirs TEXT)");
+
+  CLog::Log(LOGINFO, "create bluraytitles table");
+  m_pDS->exec("CREATE TABLE bluraytitles (strDiscId TEXT PRIMARY KEY, strTitles TEXT)");
+
+  CLog::Log(LOGINFO, "create keyframeindex table");
+  m_pDS->exec("CREATE TABLE keyframeindex (idFile INTEGER PRIMARY KEY, strIndex TEXT)");
 }
 
 void CVideoDatabase::CreateLinkIndex(const char *table)
@@ -264,6 +338,9 @@ void CVideoDatabase::CreateAnalytics()
   m_pDS->exec("CREATE INDEX ix_uniqueid1 ON uniqueid(media_id, media_type(20), type(20))");
   m_pDS->exec("CREATE INDEX ix_uniqueid2 ON uniqueid(media_type(20), value(20))");
 
+  m_pDS->exec("CREATE INDEX ix_changelog ON changelog(media_id, media_type(20))");
+  m_pDS->exec("CREATE UNIQUE INDEX ix_navsummary ON navsummary(item_type(20), media_type(20), item_id)");
+
   CreateLinkIndex("tag");
   CreateLinkIndex("actor");
   CreateForeignLinkIndex("director", "actor");
@@ -284,8 +361,8 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM art WHERE media_id=old.idMovie AND media_type='movie'; "
               "DELETE FROM tag_link WHERE media_id=old.idMovie AND media_type='movie'; "
               "DELETE FROM rating WHERE media_id=old.idMovie AND media_type='movie'; "
-              "DELETE FROM uniqueid WHERE media_id=old.idMovie AND media_type='movie'; "
-              "END");
+              "DELETE FROM uniqueid WHERE media_id=old.idMovie AND media_type='movie'; " +
+              GetChangeLogSQL(MediaTypeMovie, "SELECT old.idMovie AS media_id", "remove") + "END");
   m_pDS->exec("CREATE TRIGGER delete_tvshow AFTER DELETE ON tvshow FOR EACH ROW BEGIN "
               "DELETE FROM actor_link WHERE media_id=old.idShow AND media_type='tvshow'; "
               "DELETE FROM director_link WHERE media_id=old.idShow AND media_type='tvshow'; "
@@ -297,24 +374,24 @@ void CVideoDatabase::CreateAnalytics()
               "DELETE FROM art WHERE media_id=old.idShow AND media_type='tvshow'; "
               "DELETE FROM tag_link WHERE media_id=old.idShow AND media_type='tvshow'; "
               "DELETE FROM rating WHERE media_id=old.idShow AND media_type='tvshow'; "
-              "DELETE FROM uniqueid WHERE media_id=old.idShow AND media_type='tvshow'; "
-              "END");
+              "DELETE FROM uniqueid WHERE media_id=old.idShow AND media_type='tvshow'; " +
+              GetChangeLogSQL(MediaTypeTvShow, "SELECT old.idShow AS media_id", "remove") + "END");
   m_pDS->exec("CREATE TRIGGER delete_musicvideo AFTER DELETE ON musicvideo FOR EACH ROW BEGIN "
               "DELETE FROM actor_link WHERE media_id=old.idMVideo AND media_type='musicvideo'; "
               "DELETE FROM director_link WHERE media_id=old.idMVideo AND media_type='musicvideo'; "
               "DELETE FROM genre_link WHERE media_id=old.idMVideo AND media_type='musicvideo'; "
               "DELETE FROM studio_link WHERE media_id=old.idMVideo AND media_type='musicvideo'; "
               "DELETE FROM art WHERE media_id=old.idMVideo AND media_type='musicvideo'; "
-              "DELETE FROM tag_link WHERE media_id=old.idMVideo AND media_type='musicvideo'; "
-              "END");
+              "DELETE FROM tag_link WHERE media_id=old.idMVideo AND media_type='musicvideo'; " +
+              GetChangeLogSQL(MediaTypeMusicVideo, "SELECT old.idMVideo AS media_id", "remove") + "END");
   m_pDS->exec("CREATE TRIGGER delete_episode AFTER DELETE ON episode FOR EACH ROW BEGIN "
               "DELETE FROM actor_link WHERE media_id=old.idEpisode AND media_type='episode'; "
               "DELETE FROM director_link WHERE media_id=old.idEpisode AND media_type='episode'; "
               "DELETE FROM writer_link WHERE media_id=old.idEpisode AND media_type='episode'; "
               "DELETE FROM art WHERE media_id=old.idEpisode AND media_type='episode'; "
               "DELETE FROM rating WHERE media_id=old.idEpisode AND media_type='episode'; "
-              "DELETE FROM uniqueid WHERE media_id=old.idEpisode AND media_type='episode'; "
-              "END");
+              "DELETE FROM uniqueid WHERE media_id=old.idEpisode AND media_type='episode'; " +
+              GetChangeLogSQL(MediaTypeEpisode, "SELECT old.idEpisode AS media_id", "remove") + "END");
   m_pDS->exec("CREATE TRIGGER delete_season AFTER DELETE ON seasons FOR EACH ROW BEGIN "
               "DELETE FROM art WHERE media_id=old.idSeason AND media_type='season'; "
               "END");
@@ -326,14 +403,66 @@ void CVideoDatabase::CreateAnalytics()
               "END");
   m_pDS->exec("CREATE TRIGGER delete_tag AFTER DELETE ON tag_link FOR EACH ROW BEGIN "
               "DELETE FROM tag WHERE tag_id=old.tag_id AND tag_id NOT IN (SELECT DISTINCT tag_id FROM tag_link); "
+              "DELETE FROM navsummary WHERE item_type='tag' AND media_type=old.media_type; "
               "END");
   m_pDS->exec("CREATE TRIGGER delete_file AFTER DELETE ON files FOR EACH ROW BEGIN "
               "DELETE FROM bookmark WHERE idFile=old.idFile; "
               "DELETE FROM settings WHERE idFile=old.idFile; "
               "DELETE FROM stacktimes WHERE idFile=old.idFile; "
               "DELETE FROM streamdetails WHERE idFile=old.idFile; "
+              "DELETE FROM keyframeindex WHERE idFile=old.idFile; "
+              "DELETE FROM navsummary WHERE media_type IN ('movie', 'musicvideo'); "
+              "END");
+  m_pDS->exec("CREATE TRIGGER delete_path AFTER DELETE ON path FOR EACH ROW BEGIN "
+              "DELETE FROM pathfingerprint WHERE idPath=old.idPath; "
               "END");
 
+  // remote clients ask for the items changed since their last sync, see GetChanges()
+  const std::pair<const char*, const char*> changeLogTypes[] = {
+    { MediaTypeMovie, "idMovie" }, { MediaTypeTvShow, "idShow" },
+    { MediaTypeEpisode, "idEpisode" }, { MediaTypeMusicVideo, "idMVideo" } };
+  std::string updateFile;
+  for (const auto& type : changeLogTypes)
+  {
+    const std::string ids = PrepareSQL("SELECT new.%s AS media_id", type.second);
+    m_pDS->exec(PrepareSQL("CREATE TRIGGER changelog_insert_%s AFTER INSERT ON %s FOR EACH ROW BEGIN ", type.first, type.first) +
+                GetChangeLogSQL(type.first, ids, "update") + "END");
+    m_pDS->exec(PrepareSQL("CREATE TRIGGER changelog_update_%s AFTER UPDATE ON %s FOR EACH ROW BEGIN ", type.first, type.first) +
+                GetChangeLogSQL(type.first, ids, "update") + "END");
+    // play count and last played of the items
+    updateFile += GetChangeLogSQL(type.first, PrepareSQL("SELECT %s AS media_id FROM %s WHERE idFile=new.idFile", type.second, type.first), "update");
+  }
+
+  // the genre, country, studio and tag nodes are read from navsummary, see UpdateNavSummary().
+  // Changed links drop the summary of their type, it is rebuilt when the node is opened next.
+  // The watched counts follow the play counts directly.
+  const char* navSummaryTypes[] = { "genre", "country", "studio", "tag" };
+  const std::pair<const char*, const char*> navSummaryMediaTypes[] = {
+    { MediaTypeMovie, "idMovie" }, { MediaTypeMusicVideo, "idMVideo" } };
+  for (const auto& type : navSummaryTypes)
+  {
+    m_pDS->exec(PrepareSQL("CREATE TRIGGER navsummary_insert_%s AFTER INSERT ON %s_link FOR EACH ROW BEGIN "
+                           "DELETE FROM navsummary WHERE item_type='%s' AND media_type=new.media_type; "
+                           "END", type, type, type));
+    m_pDS->exec(PrepareSQL("CREATE TRIGGER navsummary_update_%s AFTER UPDATE ON %s_link FOR EACH ROW BEGIN "
+                           "DELETE FROM navsummary WHERE item_type='%s' AND media_type IN (old.media_type, new.media_type); "
+                           "END", type, type, type));
+    // tag_link has a delete trigger already
+    if (!StringUtils::EqualsNoCase(type, "tag"))
+      m_pDS->exec(PrepareSQL("CREATE TRIGGER navsummary_delete_%s AFTER DELETE ON %s_link FOR EACH ROW BEGIN "
+                             "DELETE FROM navsummary WHERE item_type='%s' AND media_type=old.media_type; "
+                             "END", type, type, type));
+
+    for (const auto& mediaType : navSummaryMediaTypes)
+      updateFile += PrepareSQL("UPDATE navsummary SET watched = watched + (CASE WHEN new.playCount IS NULL THEN -1 ELSE 1 END) "
+                               "WHERE (old.playCount IS NULL) <> (new.playCount IS NULL) AND item_type='%s' AND media_type='%s' "
+                               "AND item_id IN (SELECT %s_id FROM %s_link WHERE media_type='%s' AND media_id IN "
+                               "(SELECT %s FROM %s WHERE idFile=new.idFile)); ",
+                               type, mediaType.first, type, type, mediaType.first, mediaType.second, mediaType.first);
+  }
+
+  m_pDS->exec("CREATE TRIGGER update_file AFTER UPDATE ON files FOR EACH ROW BEGIN " + updateFile + "END");
+
   CreateViews();
 }
 
@@ -996,14 +1125,179 @@ bool CVideoDatabase::SetPathHash(const std::string &path, const std::string &has
     int idPath = AddPath(path);
     if (idPath < 0) return false;
 
+    // marks the path as scanned, a write batch stores it together with the items of the path
     std::string strSQL=PrepareSQL("update path set strHash='%s' where idPath=%ld", hash.c_str(), idPath);
-    m_pDS->exec(strSQL);
+    return ExecuteBatchMarker(strSQL);
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s (%s, %s) failed", __FUNCTION__, path.c_str(), hash.c_str());
+  }
+
+  return false;
+}
+
+bool CVideoDatabase::GetPathFingerprint(const std::string &path, std::string &fingerprint,
+                                        std::string &hash, std::vector<std::string> &subDirs)
+{
+  try
+  {
+    if (nullptr == m_pDB)
+      return false;
+    if (nullptr == m_pDS)
+      return false;
+
+    std::string strSQL = PrepareSQL("SELECT pathfingerprint.strFingerprint, pathfingerprint.strHash, pathfingerprint.strSubDirs "
+                                    "FROM pathfingerprint JOIN path ON path.idPath = pathfingerprint.idPath "
+                                    "WHERE path.strPath='%s'", path.c_str());
+    m_pDS->query(strSQL);
+    if (m_pDS->num_rows() == 0)
+    {
+      m_pDS->close();
+      return false;
+    }
+    fingerprint = m_pDS->fv(0).get_asString();
+    hash = m_pDS->fv(1).get_asString();
+    const std::string dirs = m_pDS->fv(2).get_asString();
+    subDirs.clear();
+    if (!dirs.empty())
+      subDirs = StringUtils::Split(dirs, "/");
+    m_pDS->close();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s (%s) failed", __FUNCTION__, path.c_str());
+  }
 
+  return false;
+}
+
+bool CVideoDatabase::GetBlurayTitles(const std::string &discId, std::string &titles)
+{
+  try
+  {
+    if (nullptr == m_pDB)
+      return false;
+    if (nullptr == m_pDS)
+      return false;
+
+    m_pDS->query(PrepareSQL("SELECT strTitles FROM bluraytitles WHERE strDiscId='%s'", discId.c_str()));
+    if (m_pDS->num_rows() == 0)
+    {
+      m_pDS->close();
+      return false;
+    }
+    titles = m_pDS->fv(0).get_asString();
+    m_pDS->close();
     return true;
   }
   catch (...)
   {
-    CLog::Log(LOGERROR, "%s (%s, %s) failed", __FUNCTION__, path.c_str(), hash.c_str());
+    CLog::Log(LOGERROR, "%s (%s) failed", __FUNCTION__, discId.c_str());
+  }
+
+  return false;
+}
+
+bool CVideoDatabase::SetBlurayTitles(const std::string &discId, const std::string &titles)
+{
+  try
+  {
+    if (nullptr == m_pDB)
+      return false;
+    if (nullptr == m_pDS)
+      return false;
+
+    return ExecuteQuery(PrepareSQL("REPLACE INTO bluraytitles (strDiscId, strTitles) VALUES ('%s', '%s')",
+                                   discId.c_str(), titles.c_str()));
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s (%s) failed", __FUNCTION__, discId.c_str());
+  }
+
+  return false;
+}
+
+bool CVideoDatabase::GetKeyframeIndex(const std::string &strFilenameAndPath, std::string &index)
+{
+  try
+  {
+    if (nullptr == m_pDB)
+      return false;
+    if (nullptr == m_pDS)
+      return false;
+
+    int idFile = GetFileId(strFilenameAndPath);
+    if (idFile < 0)
+      return false;
+
+    m_pDS->query(PrepareSQL("SELECT strIndex FROM keyframeindex WHERE idFile=%i", idFile));
+    if (m_pDS->num_rows() == 0)
+    {
+      m_pDS->close();
+      return false;
+    }
+    index = m_pDS->fv(0).get_asString();
+    m_pDS->close();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s (%s) failed", __FUNCTION__, CURL::GetRedacted(strFilenameAndPath).c_str());
+  }
+
+  return false;
+}
+
+bool CVideoDatabase::SetKeyframeIndex(const std::string &strFilenameAndPath, const std::string &index)
+{
+  try
+  {
+    if (nullptr == m_pDB)
+      return false;
+    if (nullptr == m_pDS)
+      return false;
+
+    int idFile = AddFile(strFilenameAndPath);
+    if (idFile < 0)
+      return false;
+
+    return ExecuteQuery(PrepareSQL("REPLACE INTO keyframeindex (idFile, strIndex) VALUES (%i, '%s')",
+                                   idFile, index.c_str()));
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s (%s) failed", __FUNCTION__, CURL::GetRedacted(strFilenameAndPath).c_str());
+  }
+
+  return false;
+}
+
+bool CVideoDatabase::SetPathFingerprint(const std::string &path, const std::string &fingerprint,
+                                        const std::string &hash, const std::vector<std::string> &subDirs)
+{
+  try
+  {
+    if (nullptr == m_pDB)
+      return false;
+    if (nullptr == m_pDS)
+      return false;
+
+    int idPath = AddPath(path);
+    if (idPath < 0)
+      return false;
+
+    if (fingerprint.empty())
+      return ExecuteQuery(PrepareSQL("DELETE FROM pathfingerprint WHERE idPath=%i", idPath));
+
+    return ExecuteQuery(PrepareSQL("REPLACE INTO pathfingerprint (idPath, strFingerprint, strHash, strSubDirs) VALUES (%i, '%s', '%s', '%s')",
+                                   idPath, fingerprint.c_str(), hash.c_str(), StringUtils::Join(subDirs, "/").c_str()));
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s (%s, %s) failed", __FUNCTION__, path.c_str(), fingerprint.c_str());
   }
 
   return false;
@@ -1474,14 +1768,15 @@ int CVideoDatabase::AddToTable(const std::string& table, const std::string& firs
     if (nullptr == m_pDS)
       return -1;
 
-    std::string strSQL = PrepareSQL("select %s from %s where %s like '%s'", firstField.c_str(), table.c_str(), secondField.c_str(), value.substr(0, 255).c_str());
-    m_pDS->query(strSQL);
+    const sql_params params{field_value(value.substr(0, 255).c_str())};
+    std::string strSQL = PrepareSQL("select %s from %s where %s like ?", firstField.c_str(), table.c_str(), secondField.c_str());
+    m_pDS->query(strSQL, params);
     if (m_pDS->num_rows() == 0)
     {
       m_pDS->close();
       // doesnt exists, add it
-      strSQL = PrepareSQL("insert into %s (%s, %s) values(NULL, '%s')", table.c_str(), firstField.c_str(), secondField.c_str(), value.substr(0, 255).c_str());
-      m_pDS->exec(strSQL);
+      strSQL = PrepareSQL("insert into %s (%s, %s) values(NULL, ?)", table.c_str(), firstField.c_str(), secondField.c_str());
+      m_pDS->exec(strSQL, params);
       int id = (int)m_pDS->lastinsertid();
       return id;
     }
@@ -1687,14 +1982,14 @@ int CVideoDatabase::AddActor(const std::string& name, const std::string& thumbUR
     std::string trimmedName = name.c_str();
     StringUtils::Trim(trimmedName);
 
-    std::string strSQL=PrepareSQL("select actor_id from actor where name like '%s'", trimmedName.substr(0, 255).c_str());
-    m_pDS->query(strSQL);
+    const std::string actorName = trimmedName.substr(0, 255);
+    m_pDS->query("select actor_id from actor where name like ?", {field_value(actorName.c_str())});
     if (m_pDS->num_rows() == 0)
     {
       m_pDS->close();
       // doesnt exists, add it
-      strSQL=PrepareSQL("insert into actor (actor_id, name, art_urls) values(NULL, '%s', '%s')", trimmedName.substr(0,255).c_str(), thumbURLs.c_str());
-      m_pDS->exec(strSQL);
+      m_pDS->exec("insert into actor (actor_id, name, art_urls) values(NULL, ?, ?)",
+                  {field_value(actorName.c_str()), field_value(thumbURLs.c_str())});
       idActor = (int)m_pDS->lastinsertid();
     }
     else
@@ -1704,8 +1999,8 @@ int CVideoDatabase::AddActor(const std::string& name, const std::string& thumbUR
       // update the thumb url's
       if (!thumbURLs.empty())
       {
-        strSQL=PrepareSQL("update actor set art_urls = '%s' where actor_id = %i", thumbURLs.c_str(), idActor);
-        m_pDS->exec(strSQL);
+        m_pDS->exec("update actor set art_urls = ? where actor_id = ?",
+                    {field_value(thumbURLs.c_str()), field_value(idActor)});
       }
     }
     // add artwork
@@ -1724,33 +2019,34 @@ int CVideoDatabase::AddActor(const std::string& name, const std::string& thumbUR
 
 void CVideoDatabase::AddLinkToActor(int mediaId, const char *mediaType, int actorId, const std::string &role, int order)
 {
-  std::string sql=PrepareSQL("SELECT 1 FROM actor_link WHERE actor_id=%i AND media_id=%i AND media_type='%s'", actorId, mediaId, mediaType);
-
-  if (GetSingleValue(sql).empty())
+  if (GetSingleValue("SELECT 1 FROM actor_link WHERE actor_id=? AND media_id=? AND media_type=?",
+                     {field_value(actorId), field_value(mediaId), field_value(mediaType)}).empty())
   { // doesnt exists, add it
-    sql = PrepareSQL("INSERT INTO actor_link (actor_id, media_id, media_type, role, cast_order) VALUES(%i,%i,'%s','%s',%i)", actorId, mediaId, mediaType, role.c_str(), order);
-    ExecuteQuery(sql);
+    ExecuteQuery("INSERT INTO actor_link (actor_id, media_id, media_type, role, cast_order) VALUES(?,?,?,?,?)",
+                 {field_value(actorId), field_value(mediaId), field_value(mediaType),
+                  field_value(role.c_str()), field_value(order)});
   }
 }
 
 void CVideoDatabase::AddToLinkTable(int mediaId, const std::string& mediaType, const std::string& table, int valueId, const char *foreignKey)
 {
   const char *key = foreignKey ? foreignKey : table.c_str();
-  std::string sql = PrepareSQL("SELECT 1 FROM %s_link WHERE %s_id=%i AND media_id=%i AND media_type='%s'", table.c_str(), key, valueId, mediaId, mediaType.c_str());
+  const sql_params params{field_value(valueId), field_value(mediaId), field_value(mediaType.c_str())};
+  std::string sql = PrepareSQL("SELECT 1 FROM %s_link WHERE %s_id=? AND media_id=? AND media_type=?", table.c_str(), key);
 
-  if (GetSingleValue(sql).empty())
+  if (GetSingleValue(sql, params).empty())
   { // doesnt exists, add it
-    sql = PrepareSQL("INSERT INTO %s_link (%s_id,media_id,media_type) VALUES(%i,%i,'%s')", table.c_str(), key, valueId, mediaId, mediaType.c_str());
-    ExecuteQuery(sql);
+    sql = PrepareSQL("INSERT INTO %s_link (%s_id,media_id,media_type) VALUES(?,?,?)", table.c_str(), key);
+    ExecuteQuery(sql, params);
   }
 }
 
 void CVideoDatabase::RemoveFromLinkTable(int mediaId, const std::string& mediaType, const std::string& table, int valueId, const char *foreignKey)
 {
   const char *key = foreignKey ? foreignKey : table.c_str();
-  std::string sql = PrepareSQL("DELETE FROM %s_link WHERE %s_id=%i AND media_id=%i AND media_type='%s'", table.c_str(), key, valueId, mediaId, mediaType.c_str());
+  std::string sql = PrepareSQL("DELETE FROM %s_link WHERE %s_id=? AND media_id=? AND media_type=?", table.c_str(), key);
 
-  ExecuteQuery(sql);
+  ExecuteQuery(sql, {field_value(valueId), field_value(mediaId), field_value(mediaType.c_str())});
 }
 
 void CVideoDatabase::AddLinksToItem(int mediaId, const std::string& mediaType, const std::string& field, const std::vector<std::string>& values)
@@ -4583,6 +4879,7 @@ void CVideoDatabase::SetArtForItem(int mediaId, const MediaType &mediaType, cons
       sql = PrepareSQL("INSERT INTO art(media_id, media_type, type, url) VALUES (%d, '%s', '%s', '%s')", mediaId, mediaType.c_str(), artType.c_str(), url.c_str());
       m_pDS->exec(sql);
     }
+    artRevision++;
   }
   catch (...)
   {
@@ -4616,6 +4913,43 @@ bool CVideoDatabase::GetArtForItem(int mediaId, const MediaType &mediaType, std:
   return false;
 }
 
+bool CVideoDatabase::GetArtForItems(const MediaType &mediaType, const std::vector<int> &mediaIds, std::map<int, std::map<std::string, std::string> > &art)
+{
+  try
+  {
+    if (nullptr == m_pDB)
+      return false;
+    if (nullptr == m_pDS2)
+      return false; // using dataset 2 as we're likely called in loops on dataset 1
+    if (mediaIds.empty())
+      return true;
+
+    std::string ids;
+    for (int id : mediaIds)
+    {
+      if (!ids.empty())
+        ids += ",";
+      ids += StringUtils::Format("%i", id);
+      art[id];
+    }
+
+    std::string sql = PrepareSQL("SELECT media_id,type,url FROM art WHERE media_type='%s' AND media_id IN (", mediaType.c_str()) + ids + ")";
+    m_pDS2->query(sql);
+    while (!m_pDS2->eof())
+    {
+      art[m_pDS2->fv(0).get_asInt()].insert(make_pair(m_pDS2->fv(1).get_asString(), m_pDS2->fv(2).get_asString()));
+      m_pDS2->next();
+    }
+    m_pDS2->close();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s(%s) failed", __FUNCTION__, mediaType.c_str());
+  }
+  return false;
+}
+
 std::string CVideoDatabase::GetArtForItem(int mediaId, const MediaType &mediaType, const std::string &artType)
 {
   std::string query = PrepareSQL("SELECT url FROM art WHERE media_id=%i AND media_type='%s' AND type='%s'", mediaId, mediaType.c_str(), artType.c_str());
@@ -4624,6 +4958,7 @@ std::string CVideoDatabase::GetArtForItem(int mediaId, const MediaType &mediaTyp
 
 bool CVideoDatabase::RemoveArtForItem(int mediaId, const MediaType &mediaType, const std::string &artType)
 {
+  artRevision++;
   return ExecuteQuery(PrepareSQL("DELETE FROM art WHERE media_id=%i AND media_type='%s' AND type='%s'", mediaId, mediaType.c_str(), artType.c_str()));
 }
 
@@ -4743,6 +5078,40 @@ bool CVideoDatabase::GetTvShowSeasonArt(int showId, std::map<int, std::map<std::
   return false;
 }
 
+unsigned int CVideoDatabase::GetArtRevision()
+{
+  return artRevision;
+}
+
+bool CVideoDatabase::GetArtURLs(std::vector<std::string> &urls)
+{
+  try
+  {
+    if (nullptr == m_pDB)
+      return false;
+    if (nullptr == m_pDS)
+      return false;
+
+    int numRows = RunQuery("SELECT DISTINCT url FROM art");
+    if (numRows <= 0)
+      return numRows == 0;
+
+    urls.reserve(urls.size() + numRows);
+    while (!m_pDS->eof())
+    {
+      urls.emplace_back(m_pDS->fv(0).get_asString());
+      m_pDS->next();
+    }
+    m_pDS->close();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed", __FUNCTION__);
+  }
+  return false;
+}
+
 bool CVideoDatabase::GetArtTypes(const MediaType &mediaType, std::vector<std::string> &artTypes)
 {
   try
@@ -5692,11 +6061,26 @@ void CVideoDatabase::UpdateTables(int iVersion)
     }
     m_pDS->close();
   }
+
+  if (iVersion < 117)
+    CreateChangeLogTable();
+
+  if (iVersion < 118)
+    m_pDS->exec("CREATE TABLE navsummary (item_type TEXT, item_id INTEGER, media_type TEXT, total INTEGER, watched INTEGER)");
+
+  if (iVersion < 119)
+    m_pDS->exec("CREATE TABLE pathfingerprint (idPath INTEGER PRIMARY KEY, strFingerprint TEXT, strHash TEXT, strSubDirs TEXT)");
+
+  if (iVersion < 120)
+    m_pDS->exec("CREATE TABLE bluraytitles (strDiscId TEXT PRIMARY KEY, strTitles TEXT)");
+
+  if (iVersion < 121)
+    m_pDS->exec("CREATE TABLE keyframeindex (idFile INTEGER PRIMARY KEY, strIndex TEXT)");
 }
 
 int CVideoDatabase::GetSchemaVersion() const
 {
-  return 116;
+  return 121;
 }
 
 bool CVideoDatabase::LookupByFolders(const std::string &path, bool shows)
@@ -6150,6 +6534,16 @@ bool CVideoDatabase::GetNavCommon(const std::string& strBaseDir, CFileItemList&
       extFilter.AppendJoin("JOIN path ON path.idPath = files.idPath");
       extFilter.AppendJoin(extraJoin);
     }
+    else if (!countOnly && UseNavSummary(strBaseDir, type, idContent, filter))
+    {
+      // same columns as the aggregate below, read from the summary
+      const std::string media_type = idContent == VIDEODB_CONTENT_MOVIES ? MediaTypeMovie : MediaTypeMusicVideo;
+      strSQL = "SELECT %s " + PrepareSQL("FROM %s ", type);
+      extFilter.fields = PrepareSQL("%s.%s_id, %s.name, navsummary.total, navsummary.watched", type, type, type);
+      extFilter.AppendJoin(PrepareSQL("JOIN navsummary ON navsummary.item_id = %s.%s_id AND navsummary.item_type='%s' AND navsummary.media_type='%s'",
+                                      type, type, type, media_type.c_str()));
+      extFilter.AppendWhere("navsummary.total > 0");
+    }
     else
     {
       std::string view, view_id, media_type, extraField, extraJoin;
@@ -6294,6 +6688,73 @@ bool CVideoDatabase::GetNavCommon(const std::string& strBaseDir, CFileItemList&
   return false;
 }
 
+bool CVideoDatabase::UseNavSummary(const std::string& strBaseDir, const char *type, int idContent, const Filter &filter)
+{
+  if (!CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bVideoLibraryUseNavSummary)
+    return false;
+
+  if (idContent != VIDEODB_CONTENT_MOVIES && idContent != VIDEODB_CONTENT_MUSICVIDEOS)
+    return false;
+
+  if (!StringUtils::EqualsNoCase(type, "genre") && !StringUtils::EqualsNoCase(type, "country") &&
+      !StringUtils::EqualsNoCase(type, "studio") && !StringUtils::EqualsNoCase(type, "tag"))
+    return false;
+
+  // the summary counts all items, it can't be used for filtered nodes
+  if (!filter.where.empty() || !filter.join.empty())
+    return false;
+
+  CVideoDbUrl videoUrl;
+  Filter urlFilter;
+  SortDescription sorting;
+  if (!videoUrl.FromString(strBaseDir) || !GetFilter(videoUrl, urlFilter, sorting) ||
+      !urlFilter.where.empty() || !urlFilter.join.empty())
+    return false;
+
+  return UpdateNavSummary(type, idContent == VIDEODB_CONTENT_MOVIES ? MediaTypeMovie : MediaTypeMusicVideo);
+}
+
+bool CVideoDatabase::UpdateNavSummary(const std::string &type, const std::string &mediaType)
+{
+  // the row with item_id -1 marks a complete summary, it goes together with the others
+  if (!GetSingleValue(PrepareSQL("SELECT total FROM navsummary WHERE item_type='%s' AND media_type='%s' AND item_id=-1",
+                                 type.c_str(), mediaType.c_str()), m_pDS).empty())
+    return true;
+
+  const std::string idColumn = mediaType == MediaTypeMovie ? "idMovie" : "idMVideo";
+  const unsigned int time = XbmcThreads::SystemClockMillis();
+
+  BeginTransaction();
+  try
+  {
+    m_pDS->exec(PrepareSQL("DELETE FROM navsummary WHERE item_type='%s' AND media_type='%s'", type.c_str(), mediaType.c_str()));
+    m_pDS->exec(PrepareSQL("INSERT INTO navsummary (item_type, item_id, media_type, total, watched) "
+                           "SELECT '%s', %s_link.%s_id, '%s', count(1), count(files.playCount) FROM %s_link "
+                           "JOIN %s_view ON %s_link.media_id = %s_view.%s AND %s_link.media_type='%s' "
+                           "JOIN files ON files.idFile = %s_view.idFile "
+                           "GROUP BY %s_link.%s_id",
+                           type.c_str(), type.c_str(), type.c_str(), mediaType.c_str(), type.c_str(),
+                           mediaType.c_str(), type.c_str(), mediaType.c_str(), idColumn.c_str(), type.c_str(), mediaType.c_str(),
+                           mediaType.c_str(),
+                           type.c_str(), type.c_str()));
+    m_pDS->exec(PrepareSQL("INSERT INTO navsummary (item_type, item_id, media_type, total, watched) VALUES ('%s', -1, '%s', 0, 0)",
+                           type.c_str(), mediaType.c_str()));
+    if (!CommitTransaction())
+      return false;
+
+    CLog::Log(LOGDEBUG, LOGDATABASE, "%s - rebuilt the %s summary of %ss in %u ms", __FUNCTION__,
+              type.c_str(), mediaType.c_str(), XbmcThreads::SystemClockMillis() - time);
+    return true;
+  }
+  catch (...)
+  {
+    // another client of a shared database may have rebuilt it meanwhile
+    CLog::Log(LOGERROR, "%s failed for the %s summary of %ss", __FUNCTION__, type.c_str(), mediaType.c_str());
+    RollbackTransaction();
+  }
+  return false;
+}
+
 bool CVideoDatabase::GetTagsNav(const std::string& strBaseDir, CFileItemList& items, int idContent /* = -1 */, const Filter &filter /* = Filter() */, bool countOnly /* = false */)
 {
   return GetNavCommon(strBaseDir, items, "tag", idContent, filter, countOnly);
@@ -7238,6 +7699,25 @@ bool CVideoDatabase::GetMoviesNav(const std::string& strBaseDir, CFileItemList&
   return GetMoviesByWhere(videoUrl.ToString(), filter, items, sortDescription, getDetails);
 }
 
+void CVideoDatabase::AddMovieItem(const CVideoDbUrl& videoUrl, const CVideoInfoTag& movie, CFileItemList& items)
+{
+  if (m_profileManager.GetMasterProfile().getLockMode() == LOCK_MODE_EVERYONE ||
+      g_passwordManager.bMasterUser                                   ||
+      g_passwordManager.IsDatabasePathUnlocked(movie.m_strPath, *CMediaSourceSettings::GetInstance().GetSources("video")))
+  {
+    CFileItemPtr pItem(new CFileItem(movie));
+
+    CVideoDbUrl itemUrl = videoUrl;
+    std::string path = StringUtils::Format("%i", movie.m_iDbId);
+    itemUrl.AppendPath(path);
+    pItem->SetPath(itemUrl.ToString());
+    pItem->SetDynPath(movie.m_strFileNameAndPath);
+
+    pItem->SetOverlayImage(CGUIListItem::ICON_OVERLAY_UNWATCHED,movie.GetPlayCount() > 0);
+    items.Add(pItem);
+  }
+}
+
 bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filter &filter, CFileItemList& items, const SortDescription &sortDescription /* = SortDescription() */, int getDetails /* = VideoDbDetailsNone */)
 {
   try
@@ -7264,17 +7744,57 @@ bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filte
     if (!CDatabase::BuildSQL(strSQLExtra, extFilter, strSQLExtra))
       return false;
 
+    // sort methods the database can reproduce exactly are ordered and paged by the query,
+    // everything else is sorted in memory further down
+    std::string orderBy;
+    if (sortDescription.sortBy != SortByNone && extFilter.group.empty() &&
+        extFilter.order.empty() && extFilter.limit.empty())
+      orderBy = DatabaseUtils::BuildOrderByClause(sortDescription, MediaTypeMovie);
+
     // Apply the limiting directly here if there's no special sorting but limiting
-    if (extFilter.limit.empty() &&
+    if (orderBy.empty() && extFilter.limit.empty() &&
         sorting.sortBy == SortByNone &&
        (sorting.limitStart > 0 || sorting.limitEnd > 0))
     {
       total = (int)strtol(GetSingleValue(PrepareSQL(strSQL, "COUNT(1)") + strSQLExtra, m_pDS).c_str(), NULL, 10);
       strSQLExtra += DatabaseUtils::BuildLimitClause(sorting.limitEnd, sorting.limitStart);
     }
+    else if (!orderBy.empty())
+    {
+      if (sortDescription.limitStart > 0 || sortDescription.limitEnd > 0)
+      {
+        total = (int)strtol(GetSingleValue(PrepareSQL(strSQL, "COUNT(1)") + strSQLExtra, m_pDS).c_str(), NULL, 10);
+        orderBy += DatabaseUtils::BuildLimitClause(sortDescription.limitEnd, sortDescription.limitStart);
+      }
+      strSQLExtra += orderBy;
+    }
 
     strSQL = PrepareSQL(strSQL, !extFilter.fields.empty() ? extFilter.fields.c_str() : "*") + strSQLExtra;
 
+    // if the rows come back in their final order they are read one by one instead of holding
+    // the whole result in memory. The details are fetched through m_pDS2.
+    if (sortDescription.sortBy == SortByNone || !orderBy.empty())
+    {
+      unsigned int time = XbmcThreads::SystemClockMillis();
+      if (!m_pDS->query_forward(strSQL))
+        return false;
+
+      int rows = 0;
+      while (!m_pDS->eof())
+      {
+        AddMovieItem(videoUrl, GetDetailsForMovie(m_pDS->get_sql_record(), getDetails), items);
+        rows++;
+        m_pDS->next();
+      }
+      m_pDS->close();
+      CLog::Log(LOGDEBUG, LOGDATABASE, "%s took %d ms for %d items query: %s", __FUNCTION__,
+                XbmcThreads::SystemClockMillis() - time, rows, strSQL.c_str());
+
+      if (rows > 0)
+        items.SetProperty("total", std::max(total, rows));
+      return true;
+    }
+
     int iRowsFound = RunQuery(strSQL);
     if (iRowsFound <= 0)
       return iRowsFound == 0;
@@ -7298,22 +7818,7 @@ bool CVideoDatabase::GetMoviesByWhere(const std::string& strBaseDir, const Filte
       unsigned int targetRow = (unsigned int)i.at(FieldRow).asInteger();
       const dbiplus::sql_record* const record = data.at(targetRow);
 
-      CVideoInfoTag movie = GetDetailsForMovie(record, getDetails);
-      if (m_profileManager.GetMasterProfile().getLockMode() == LOCK_MODE_EVERYONE ||
-          g_passwordManager.bMasterUser                                   ||
-          g_passwordManager.IsDatabasePathUnlocked(movie.m_strPath, *CMediaSourceSettings::GetInstance().GetSources("video")))
-      {
-        CFileItemPtr pItem(new CFileItem(movie));
-
-        CVideoDbUrl itemUrl = videoUrl;
-        std::string path = StringUtils::Format("%i", movie.m_iDbId);
-        itemUrl.AppendPath(path);
-        pItem->SetPath(itemUrl.ToString());
-        pItem->SetDynPath(movie.m_strFileNameAndPath);
-
-        pItem->SetOverlayImage(CGUIListItem::ICON_OVERLAY_UNWATCHED,movie.GetPlayCount() > 0);
-        items.Add(pItem);
-      }
+      AddMovieItem(videoUrl, GetDetailsForMovie(record, getDetails), items);
     }
 
     // cleanup
@@ -8931,8 +9436,6 @@ void CVideoDatabase::CleanDatabase(CGUIDialogProgressBarHandle* handle, const st
     CLog::Log(LOGNOTICE, "%s: Starting videodatabase cleanup ..", __FUNCTION__);
     CServiceBroker::GetAnnouncementManager()->Announce(ANNOUNCEMENT::VideoLibrary, "xbmc", "OnCleanStarted");
 
-    BeginTransaction();
-
     // find all the files
     std::string sql = "SELECT files.idFile, files.strFileName, path.strPath FROM files INNER JOIN path ON path.idPath=files.idPath";
     if (!paths.empty())
@@ -8944,7 +9447,12 @@ void CVideoDatabase::CleanDatabase(CGUIDialogProgressBarHandle* handle, const st
     }
 
     m_pDS2->query(sql);
-    if (m_pDS2->num_rows() == 0) return;
+    if (m_pDS2->num_rows() == 0)
+    {
+      m_pDS2->close();
+      CServiceBroker::GetAnnouncementManager()->Announce(ANNOUNCEMENT::VideoLibrary, "xbmc", "OnCleanFinished");
+      return;
+    }
 
     if (handle)
     {
@@ -8966,12 +9474,33 @@ void CVideoDatabase::CleanDatabase(CGUIDialogProgressBarHandle* handle, const st
       }
     }
 
-    std::string filesToTestForDelete;
     VECSOURCES videoSources(*CMediaSourceSettings::GetInstance().GetSources("video"));
     g_mediaManager.GetRemovableDrives(videoSources);
 
-    int total = m_pDS2->num_rows();
-    int current = 0;
+    const size_t total = m_pDS2->num_rows();
+    auto reportProgress = [&](size_t current)
+    {
+      if (handle == NULL && progress != NULL)
+      {
+        int percentage = current * 100 / total;
+        if (percentage > progress->GetPercentage())
+        {
+          progress->SetPercentage(percentage);
+          progress->Progress();
+        }
+        return !progress->IsCanceled();
+      }
+      else if (handle != NULL)
+        handle->SetPercentage(current * 100 / (float)total);
+      return true;
+    };
+
+    // the files of a folder are checked with a single listing of it, and
+    // the sources are checked at the same time instead of one after another
+    std::vector<std::string> fileIDs;
+    std::vector<bool> keepFiles;
+    std::map<int, std::shared_ptr<SCleanSourceCheck>> sourceChecks;
+    size_t checked = 0;
 
     while (!m_pDS2->eof())
     {
@@ -8988,49 +9517,106 @@ void CVideoDatabase::CleanDatabase(CGUIDialogProgressBarHandle* handle, const st
       if (URIUtils::IsInArchive(fullPath))
         fullPath = CURL(fullPath).GetHostName();
 
-      bool del = true;
+      fileIDs.push_back(m_pDS2->fv("files.idFile").get_asString());
+      keepFiles.push_back(false);
       if (URIUtils::IsPlugin(fullPath))
       {
         SScanSettings settings;
         bool foundDirectly = false;
         ScraperPtr scraper = GetScraperForPath(fullPath, settings, foundDirectly);
         if (scraper && CPluginDirectory::CheckExists(TranslateContent(scraper->Content()), fullPath))
-          del = false;
+          keepFiles.back() = true;
+        checked++;
       }
       else
       {
         // remove optical, non-existing files, files with no matching source
         bool bIsSource;
-        if (!URIUtils::IsOnDVD(fullPath) && CFile::Exists(fullPath, false) &&
-            CUtil::GetMatchingSource(fullPath, videoSources, bIsSource) >= 0)
-          del = false;
+        int source = -1;
+        if (!URIUtils::IsOnDVD(fullPath))
+          source = CUtil::GetMatchingSource(fullPath, videoSources, bIsSource);
+        if (source >= 0)
+        {
+          std::shared_ptr<SCleanSourceCheck>& check = sourceChecks[source];
+          if (!check)
+            check = std::make_shared<SCleanSourceCheck>();
+          check->paths.push_back(fullPath);
+          check->files.push_back(fileIDs.size() - 1);
+        }
+        else
+          checked++;
       }
-      if (del)
-        filesToTestForDelete += m_pDS2->fv("files.idFile").get_asString() + ",";
 
-      if (handle == NULL && progress != NULL)
+      if (!reportProgress(checked))
       {
-        int percentage = current * 100 / total;
-        if (percentage > progress->GetPercentage())
+        progress->Close();
+        m_pDS2->close();
+        CServiceBroker::GetAnnouncementManager()->Announce(ANNOUNCEMENT::VideoLibrary, "xbmc", "OnCleanFinished");
+        return;
+      }
+
+      m_pDS2->next();
+    }
+    m_pDS2->close();
+
+    {
+      // the jobs only share the state and their checks with the clean, so a
+      // cancelled clean doesn't have to wait for them
+      auto state = std::make_shared<SCleanCheckState>();
+      state->pending = sourceChecks.size();
+      CJobQueue checkQueue(false, CLEAN_SOURCES_AT_ONCE, CJob::PRIORITY_LOW);
+      for (const auto& sourceCheck : sourceChecks)
+      {
+        std::shared_ptr<SCleanSourceCheck> check = sourceCheck.second;
+        checkQueue.Submit([state, check]()
         {
-          progress->SetPercentage(percentage);
-          progress->Progress();
+          check->exists = CFile::ExistsBatch(check->paths, false);
+          CSingleLock lock(state->section);
+          state->checked += check->paths.size();
+          state->pending--;
+          state->done.notifyAll();
+        });
+      }
+
+      while (true)
+      {
+        size_t sourcesChecked;
+        {
+          CSingleLock lock(state->section);
+          if (state->pending > 0)
+            state->done.wait(lock, 100);
+          if (state->pending == 0)
+            break;
+          sourcesChecked = state->checked;
         }
-        if (progress->IsCanceled())
+
+        if (!reportProgress(checked + sourcesChecked))
         {
           progress->Close();
-          m_pDS2->close();
           CServiceBroker::GetAnnouncementManager()->Announce(ANNOUNCEMENT::VideoLibrary, "xbmc", "OnCleanFinished");
           return;
         }
       }
-      else if (handle != NULL)
-        handle->SetPercentage(current * 100 / (float)total);
+    }
 
-      m_pDS2->next();
-      current++;
+    for (const auto& sourceCheck : sourceChecks)
+    {
+      const SCleanSourceCheck& check = *sourceCheck.second;
+      for (size_t i = 0; i < check.files.size(); i++)
+      {
+        if (check.exists[i])
+          keepFiles[check.files[i]] = true;
+      }
     }
-    m_pDS2->close();
+
+    std::string filesToTestForDelete;
+    for (size_t i = 0; i < fileIDs.size(); i++)
+    {
+      if (!keepFiles[i])
+        filesToTestForDelete += fileIDs[i] + ",";
+    }
+
+    BeginTransaction();
 
     std::string filesToDelete;
 
@@ -9069,49 +9655,45 @@ void CVideoDatabase::CleanDatabase(CGUIDialogProgressBarHandle* handle, const st
 
     if (!filesToDelete.empty())
     {
-      filesToDelete = "(" + StringUtils::TrimRight(filesToDelete, ",") + ")";
+      const std::vector<std::string> fileBatches = JoinIdsInBatches(StringUtils::Split(StringUtils::TrimRight(filesToDelete, ","), ","));
 
       // Clean hashes of all paths that files are deleted from
       // Otherwise there is a mismatch between the path contents and the hash in the
       // database, leading to potentially missed items on re-scan (if deleted files are
       // later re-added to a source)
       CLog::LogF(LOGDEBUG, LOGDATABASE, "Cleaning path hashes");
-      m_pDS->query("SELECT DISTINCT strPath FROM path JOIN files ON files.idPath=path.idPath WHERE files.idFile IN " + filesToDelete);
-      int pathHashCount = m_pDS->num_rows();
-      while (!m_pDS->eof())
+      std::set<std::string> pathsToInvalidate;
+      for (const auto& batch : fileBatches)
       {
-        InvalidatePathHash(m_pDS->fv("strPath").get_asString());
-        m_pDS->next();
+        m_pDS->query("SELECT DISTINCT strPath FROM path JOIN files ON files.idPath=path.idPath WHERE files.idFile IN (" + batch + ")");
+        while (!m_pDS->eof())
+        {
+          pathsToInvalidate.insert(m_pDS->fv("strPath").get_asString());
+          m_pDS->next();
+        }
+        m_pDS->close();
       }
-      CLog::LogF(LOGDEBUG, LOGDATABASE, "Cleaned {} path hashes", pathHashCount);
+      for (const auto& pathToInvalidate : pathsToInvalidate)
+        InvalidatePathHash(pathToInvalidate);
+      CLog::LogF(LOGDEBUG, LOGDATABASE, "Cleaned {} path hashes", pathsToInvalidate.size());
 
       CLog::Log(LOGDEBUG, LOGDATABASE, "%s: Cleaning files table", __FUNCTION__);
-      sql = "DELETE FROM files WHERE idFile IN " + filesToDelete;
-      m_pDS->exec(sql);
+      for (const auto& batch : fileBatches)
+        m_pDS->exec("DELETE FROM files WHERE idFile IN (" + batch + ")");
     }
 
     if (!movieIDs.empty())
     {
-      std::string moviesToDelete;
-      for (const auto &i : movieIDs)
-        moviesToDelete += StringUtils::Format("%i,", i);
-      moviesToDelete = "(" + StringUtils::TrimRight(moviesToDelete, ",") + ")";
-
       CLog::Log(LOGDEBUG, LOGDATABASE, "%s: Cleaning movie table", __FUNCTION__);
-      sql = "DELETE FROM movie WHERE idMovie IN " + moviesToDelete;
-      m_pDS->exec(sql);
+      for (const auto& batch : JoinIdsInBatches(movieIDs))
+        m_pDS->exec("DELETE FROM movie WHERE idMovie IN (" + batch + ")");
     }
 
     if (!episodeIDs.empty())
     {
-      std::string episodesToDelete;
-      for (const auto &i : episodeIDs)
-        episodesToDelete += StringUtils::Format("%i,", i);
-      episodesToDelete = "(" + StringUtils::TrimRight(episodesToDelete, ",") + ")";
-
       CLog::Log(LOGDEBUG, LOGDATABASE, "%s: Cleaning episode table", __FUNCTION__);
-      sql = "DELETE FROM episode WHERE idEpisode IN " + episodesToDelete;
-      m_pDS->exec(sql);
+      for (const auto& batch : JoinIdsInBatches(episodeIDs))
+        m_pDS->exec("DELETE FROM episode WHERE idEpisode IN (" + batch + ")");
     }
 
     CLog::Log(LOGDEBUG, LOGDATABASE, "%s: Cleaning paths that don't exist and have content set...", __FUNCTION__);
@@ -9121,7 +9703,7 @@ void CVideoDatabase::CleanDatabase(CGUIDialogProgressBarHandle* handle, const st
                    "AND (strHash IS NULL OR strHash = '') "
                    "AND (exclude IS NULL OR exclude != 1))";
     m_pDS2->query(sql);
-    std::string strIds;
+    std::vector<std::string> pathIDs;
     while (!m_pDS2->eof())
     {
       auto pathsDeleteDecision = pathsDeleteDecisions.find(m_pDS2->fv(0).get_asInt());
@@ -9145,48 +9727,38 @@ void CVideoDatabase::CleanDatabase(CGUIDialogProgressBarHandle* handle, const st
            (pathsDeleteDecision == pathsDeleteDecisions.end() && !exists)) &&
           ((pathsDeleteDecisionByParent != pathsDeleteDecisions.end() && pathsDeleteDecisionByParent->second) ||
            (pathsDeleteDecisionByParent == pathsDeleteDecisions.end())))
-        strIds += m_pDS2->fv(0).get_asString() + ",";
+        pathIDs.push_back(m_pDS2->fv(0).get_asString());
 
       m_pDS2->next();
     }
     m_pDS2->close();
 
-    if (!strIds.empty())
+    if (!pathIDs.empty())
     {
-      sql = PrepareSQL("DELETE FROM path WHERE idPath IN (%s)", StringUtils::TrimRight(strIds, ",").c_str());
-      m_pDS->exec(sql);
+      for (const auto& batch : JoinIdsInBatches(pathIDs))
+        m_pDS->exec("DELETE FROM path WHERE idPath IN (" + batch + ")");
       sql = "DELETE FROM tvshowlinkpath WHERE NOT EXISTS (SELECT 1 FROM path WHERE path.idPath = tvshowlinkpath.idPath)";
       m_pDS->exec(sql);
     }
 
     CLog::Log(LOGDEBUG, LOGDATABASE, "%s: Cleaning tvshow table", __FUNCTION__);
 
-    std::string tvshowsToDelete;
     sql = "SELECT idShow FROM tvshow WHERE NOT EXISTS (SELECT 1 FROM tvshowlinkpath WHERE tvshowlinkpath.idShow = tvshow.idShow)";
     m_pDS->query(sql);
     while (!m_pDS->eof())
     {
       tvshowIDs.push_back(m_pDS->fv(0).get_asInt());
-      tvshowsToDelete += m_pDS->fv(0).get_asString() + ",";
       m_pDS->next();
     }
     m_pDS->close();
-    if (!tvshowsToDelete.empty())
-    {
-      sql = "DELETE FROM tvshow WHERE idShow IN (" + StringUtils::TrimRight(tvshowsToDelete, ",") + ")";
-      m_pDS->exec(sql);
-    }
+    for (const auto& batch : JoinIdsInBatches(tvshowIDs))
+      m_pDS->exec("DELETE FROM tvshow WHERE idShow IN (" + batch + ")");
 
     if (!musicVideoIDs.empty())
     {
-      std::string musicVideosToDelete;
-      for (const auto &i : musicVideoIDs)
-        musicVideosToDelete += StringUtils::Format("%i,", i);
-      musicVideosToDelete = "(" + StringUtils::TrimRight(musicVideosToDelete, ",") + ")";
-
       CLog::Log(LOGDEBUG, LOGDATABASE, "%s: Cleaning musicvideo table", __FUNCTION__);
-      sql = "DELETE FROM musicvideo WHERE idMVideo IN " + musicVideosToDelete;
-      m_pDS->exec(sql);
+      for (const auto& batch : JoinIdsInBatches(musicVideoIDs))
+        m_pDS->exec("DELETE FROM musicvideo WHERE idMVideo IN (" + batch + ")");
     }
 
     CLog::Log(LOGDEBUG, LOGDATABASE, "%s: Cleaning path table", __FUNCTION__);
@@ -9437,6 +10009,10 @@ void CVideoDatabase::ExportToXML(const std::string &path, bool singleFile /* = t
 {
   int iFailCount = 0;
   CGUIDialogProgress *progress=NULL;
+  // the art is copied in the background while the items are written, and the
+  // single file is written one item at a time instead of building it in memory
+  CTextureExportQueue artQueue;
+  CXMLElementWriter xmlWriter;
   try
   {
     if (nullptr == m_pDB)
@@ -9475,6 +10051,8 @@ void CVideoDatabase::ExportToXML(const std::string &path, bool singleFile /* = t
       CDirectory::Create(moviesDir);
       CDirectory::Create(musicvideosDir);
       CDirectory::Create(tvshowsDir);
+      if (!xmlWriter.Open(xmlFile, "videodb"))
+        return;
     }
 
     progress = CServiceBroker::GetGUI()->GetWindowManager().GetWindow<CGUIDialogProgress>(WINDOW_DIALOG_PROGRESS);
@@ -9506,8 +10084,7 @@ void CVideoDatabase::ExportToXML(const std::string &path, bool singleFile /* = t
       pMain = &xmlDoc;
     else
     {
-      TiXmlElement xmlMainElement("videodb");
-      pMain = xmlDoc.InsertEndChild(xmlMainElement);
+      pMain = xmlWriter.GetRoot();
       XMLUtils::SetInt(pMain,"version", GetExportVersion());
     }
 
@@ -9593,11 +10170,13 @@ void CVideoDatabase::ExportToXML(const std::string &path, bool singleFile /* = t
         for (const auto &i : artwork)
         {
           std::string savedThumb = item.GetLocalArt(i.first, false);
-          CTextureCache::GetInstance().Export(i.second, savedThumb, overwrite);
+          artQueue.Export(i.second, savedThumb, overwrite);
         }
         if (actorThumbs)
-          ExportActorThumbs(actorsDir, movie, !singleFile, overwrite);
+          ExportActorThumbs(artQueue, actorsDir, movie, !singleFile, overwrite);
       }
+      if (singleFile)
+        xmlWriter.Flush();
       m_pDS->next();
       current++;
     }
@@ -9682,9 +10261,11 @@ void CVideoDatabase::ExportToXML(const std::string &path, bool singleFile /* = t
         for (const auto &i : artwork)
         {
           std::string savedThumb = item.GetLocalArt(i.first, false);
-          CTextureCache::GetInstance().Export(i.second, savedThumb, overwrite);
+          artQueue.Export(i.second, savedThumb, overwrite);
         }
       }
+      if (singleFile)
+        xmlWriter.Flush();
       m_pDS->next();
       current++;
     }
@@ -9777,11 +10358,11 @@ void CVideoDatabase::ExportToXML(const std::string &path, bool singleFile /* = t
         for (const auto &i : artwork)
         {
           std::string savedThumb = item.GetLocalArt(i.first, true);
-          CTextureCache::GetInstance().Export(i.second, savedThumb, overwrite);
+          artQueue.Export(i.second, savedThumb, overwrite);
         }
 
         if (actorThumbs)
-          ExportActorThumbs(actorsDir, tvshow, !singleFile, overwrite);
+          ExportActorThumbs(artQueue, actorsDir, tvshow, !singleFile, overwrite);
 
         // export season thumbs
         for (const auto &i : seasonArt)
@@ -9797,7 +10378,7 @@ void CVideoDatabase::ExportToXML(const std::string &path, bool singleFile /* = t
           {
             std::string savedThumb(item.GetLocalArt(seasonThumb + "-" + j.first, true));
             if (!i.second.empty())
-              CTextureCache::GetInstance().Export(j.second, savedThumb, overwrite);
+              artQueue.Export(j.second, savedThumb, overwrite);
           }
         }
       }
@@ -9875,13 +10456,15 @@ void CVideoDatabase::ExportToXML(const std::string &path, bool singleFile /* = t
           for (const auto &i : artwork)
           {
             std::string savedThumb = item.GetLocalArt(i.first, false);
-            CTextureCache::GetInstance().Export(i.second, savedThumb, overwrite);
+            artQueue.Export(i.second, savedThumb, overwrite);
           }
           if (actorThumbs)
-            ExportActorThumbs(actorsDir, episode, !singleFile, overwrite);
+            ExportActorThumbs(artQueue, actorsDir, episode, !singleFile, overwrite);
         }
       }
       pDS->close();
+      if (singleFile)
+        xmlWriter.Flush();
       m_pDS->next();
       current++;
     }
@@ -9916,8 +10499,11 @@ void CVideoDatabase::ExportToXML(const std::string &path, bool singleFile /* = t
           XMLUtils::SetString(pPath,"scraperpath", info->ID());
         }
       }
-      xmlDoc.SaveFile(xmlFile);
+      if (!xmlWriter.Close())
+        iFailCount++;
     }
+    artQueue.Wait();
+
     CVariant data;
     if (singleFile)
     {
@@ -9941,7 +10527,7 @@ void CVideoDatabase::ExportToXML(const std::string &path, bool singleFile /* = t
     HELPERS::ShowOKDialogText(CVariant{647}, CVariant{StringUtils::Format(g_localizeStrings.Get(15011).c_str(), iFailCount)});
 }
 
-void CVideoDatabase::ExportActorThumbs(const std::string &strDir, const CVideoInfoTag &tag, bool singleFiles, bool overwrite /*=false*/)
+void CVideoDatabase::ExportActorThumbs(CTextureExportQueue &artQueue, const std::string &strDir, const CVideoInfoTag &tag, bool singleFiles, bool overwrite /*=false*/)
 {
   std::string strPath(strDir);
   if (singleFiles)
@@ -9961,7 +10547,7 @@ void CVideoDatabase::ExportActorThumbs(const std::string &strDir, const CVideoIn
     if (!i.thumb.empty())
     {
       std::string thumbFile(GetSafeFile(strPath, i.strName));
-      CTextureCache::GetInstance().Export(i.thumb, thumbFile, overwrite);
+      artQueue.Export(i.thumb, thumbFile, overwrite);
     }
   }
 }
@@ -9976,12 +10562,27 @@ void CVideoDatabase::ImportFromXML(const std::string &path)
     if (nullptr == m_pDS)
       return;
 
-    CXBMCTinyXML xmlDoc;
-    if (!xmlDoc.LoadFile(URIUtils::AddFileToFolder(path, "videodb.xml")))
+    std::string xml;
+    {
+      CFile file;
+      auto_buffer buffer;
+      if (file.LoadFile(URIUtils::AddFileToFolder(path, "videodb.xml"), buffer) <= 0)
+        return;
+      xml.assign(buffer.get(), buffer.size());
+    }
+
+    // the export of a big library is tens of MB, only one of its movies or
+    // TV shows is parsed at a time instead of the whole document
+    CXMLElementReader reader(xml);
+    if (reader.GetRootName().empty())
       return;
 
-    TiXmlElement *root = xmlDoc.RootElement();
-    if (!root) return;
+    auto isItem = [](const std::string& name)
+    {
+      return strnicmp(name.c_str(), MediaTypeMovie, 5) == 0 ||
+             strnicmp(name.c_str(), MediaTypeTvShow, 6) == 0 ||
+             strnicmp(name.c_str(), MediaTypeMusicVideo, 10) == 0;
+    };
 
     progress = CServiceBroker::GetGUI()->GetWindowManager().GetWindow<CGUIDialogProgress>(WINDOW_DIALOG_PROGRESS);
     if (progress)
@@ -9996,31 +10597,37 @@ void CVideoDatabase::ImportFromXML(const std::string &path)
     }
 
     int iVersion = 0;
-    XMLUtils::GetInt(root, "version", iVersion);
-
-    CLog::Log(LOGINFO, "%s: Starting import (export version = %i)", __FUNCTION__, iVersion);
-
-    TiXmlElement *movie = root->FirstChildElement();
     int current = 0;
     int total = 0;
-    // first count the number of items...
-    while (movie)
+    std::unique_ptr<TiXmlNode> paths;
+    // first count the number of items and get the version and paths
+    while (reader.Next())
     {
-      if (strnicmp(movie->Value(), MediaTypeMovie, 5)==0 ||
-          strnicmp(movie->Value(), MediaTypeTvShow, 6)==0 ||
-          strnicmp(movie->Value(), MediaTypeMusicVideo,10)==0 )
+      if (isItem(reader.GetName()))
         total++;
-      movie = movie->NextSiblingElement();
+      else if (reader.GetName() == "version")
+      {
+        TiXmlElement *version = reader.Parse();
+        if (version && version->GetText())
+          iVersion = atoi(version->GetText());
+      }
+      else if (reader.GetName() == "paths" && !paths)
+      {
+        TiXmlElement *element = reader.Parse();
+        if (element)
+          paths.reset(element->Clone());
+      }
     }
 
+    CLog::Log(LOGINFO, "%s: Starting import (export version = %i)", __FUNCTION__, iVersion);
+
     std::string actorsDir(URIUtils::AddFileToFolder(path, "actors"));
     std::string moviesDir(URIUtils::AddFileToFolder(path, "movies"));
     std::string musicvideosDir(URIUtils::AddFileToFolder(path, "musicvideos"));
     std::string tvshowsDir(URIUtils::AddFileToFolder(path, "tvshows"));
     CVideoInfoScanner scanner;
     // add paths first (so we have scraper settings available)
-    TiXmlElement *path = root->FirstChildElement("paths");
-    path = path->FirstChildElement();
+    TiXmlElement *path = paths ? paths->FirstChildElement() : nullptr;
     while (path)
     {
       std::string strPath;
@@ -10046,10 +10653,22 @@ void CVideoDatabase::ImportFromXML(const std::string &path)
       }
       path = path->NextSiblingElement();
     }
-    movie = root->FirstChildElement();
-    while (movie)
+    // the items are written by the scanner's connection, in a few large transactions
+    CVideoDatabase& db = scanner.GetDatabase();
+    if (!db.Open())
+      return;
+    const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+    db.BeginWriteBatch(advancedSettings->m_iVideoLibraryWriteBatchSize,
+                       advancedSettings->m_iVideoLibraryWriteBatchTime);
+
+    CXMLElementReader items(xml);
+    while (items.Next())
     {
       CVideoInfoTag info;
+      TiXmlElement *movie = isItem(items.GetName()) ? items.Parse() : nullptr;
+      if (!movie)
+        continue;
+
       if (strnicmp(movie->Value(), MediaTypeMovie, 5) == 0)
       {
         info.Load(movie);
@@ -10086,7 +10705,7 @@ void CVideoDatabase::ImportFromXML(const std::string &path)
         // what we desire.  It may make better sense to only delete (or even better, update) the show information
         info.Load(movie);
         URIUtils::AddSlashAtEnd(info.m_strPath);
-        DeleteTvShow(info.m_strPath);
+        db.DeleteTvShow(info.m_strPath);
         CFileItem showItem(info);
         bool useFolders = info.m_basePath.empty() ? LookupByFolders(showItem.GetPath(), true) : false;
         CFileItem artItem(showItem);
@@ -10101,8 +10720,8 @@ void CVideoDatabase::ImportFromXML(const std::string &path)
         scanner.GetSeasonThumbs(*artItem.GetVideoInfoTag(), seasonArt, CVideoThumbLoader::GetArtTypes(MediaTypeSeason), true);
         for (const auto &i : seasonArt)
         {
-          int seasonID = AddSeason(showID, i.first);
-          SetArtForItem(seasonID, MediaTypeSeason, i.second);
+          int seasonID = db.AddSeason(showID, i.first);
+          db.SetArtForItem(seasonID, MediaTypeSeason, i.second);
         }
         current++;
         // now load the episodes
@@ -10122,7 +10741,6 @@ void CVideoDatabase::ImportFromXML(const std::string &path)
           episode = episode->NextSiblingElement("episodedetails");
         }
       }
-      movie = movie->NextSiblingElement();
       if (progress && total)
       {
         progress->SetPercentage(current * 100 / total);
@@ -10130,11 +10748,15 @@ void CVideoDatabase::ImportFromXML(const std::string &path)
         progress->Progress();
         if (progress->IsCanceled())
         {
+          db.CommitWriteBatch();
+          db.Close();
           progress->Close();
           return;
         }
       }
     }
+    db.CommitWriteBatch();
+    db.Close();
   }
   catch (...)
   {
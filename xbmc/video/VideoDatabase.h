@@ -25,6 +25,7 @@ class CFileItemList;
 class CVideoSettings;
 class CGUIDialogProgress;
 class CGUIDialogProgressBarHandle;
+class CTextureExportQueue;
 
 namespace dbiplus
 {
@@ -666,6 +667,44 @@ public:
   // scanning hashes and paths scanned
   bool SetPathHash(const std::string &path, const std::string &hash);
   bool GetPathHash(const std::string &path, std::string &hash);
+
+  /*! \brief Get what the scanner saw when it listed a folder with subfolders the last time
+   \param path the folder.
+   \param fingerprint [out] the fast hash of the folder at that time.
+   \param hash [out] the hash of the files in the folder, empty if there were no files.
+   \param subDirs [out] the names of the subfolders.
+   \return true if the folder has a fingerprint, false otherwise.
+   */
+  bool GetPathFingerprint(const std::string &path, std::string &fingerprint, std::string &hash, std::vector<std::string> &subDirs);
+
+  /*! \brief Store what the scanner saw when it listed a folder, an empty fingerprint removes it
+   \sa GetPathFingerprint
+   */
+  bool SetPathFingerprint(const std::string &path, const std::string &fingerprint, const std::string &hash, const std::vector<std::string> &subDirs);
+
+  /*! \brief Get the relevant titles of a Blu-ray disc as they were found when it was opened before
+   \param discId the id of the disc.
+   \param titles [out] the titles, as serialized by CBlurayDirectory.
+   \return true if the titles of the disc are known, false otherwise.
+   */
+  bool GetBlurayTitles(const std::string &discId, std::string &titles);
+
+  /*! \brief Store the relevant titles of a Blu-ray disc
+   \sa GetBlurayTitles
+   */
+  bool SetBlurayTitles(const std::string &discId, const std::string &titles);
+
+  /*! \brief Get the keyframe index a demuxer built while the file was played before
+   \param strFilenameAndPath the path of the file.
+   \param index [out] the index, as serialized by CDemuxKeyframeIndex.
+   \return true if an index of the file is known, false otherwise.
+   */
+  bool GetKeyframeIndex(const std::string &strFilenameAndPath, std::string &index);
+
+  /*! \brief Store the keyframe index of a file
+   \sa GetKeyframeIndex
+   */
+  bool SetKeyframeIndex(const std::string &strFilenameAndPath, const std::string &index);
   bool GetPaths(std::set<std::string> &paths);
   bool GetPathsForTvShow(int idShow, std::set<int>& paths);
 
@@ -786,7 +825,7 @@ public:
   void UpdateFileDateAdded(int idFile, const std::string& strFileNameAndPath, const CDateTime& dateAdded = CDateTime());
 
   void ExportToXML(const std::string &path, bool singleFile = true, bool images=false, bool actorThumbs=false, bool overwrite=false);
-  void ExportActorThumbs(const std::string &path, const CVideoInfoTag& tag, bool singleFiles, bool overwrite=false);
+  void ExportActorThumbs(CTextureExportQueue &artQueue, const std::string &path, const CVideoInfoTag& tag, bool singleFiles, bool overwrite=false);
   void ImportFromXML(const std::string &path);
   void DumpToDummyFiles(const std::string &path);
   bool ImportArtFromXML(const TiXmlNode *node, std::map<std::string, std::string> &artwork);
@@ -840,6 +879,14 @@ public:
   void SetArtForItem(int mediaId, const MediaType &mediaType, const std::string &artType, const std::string &url);
   void SetArtForItem(int mediaId, const MediaType &mediaType, const std::map<std::string, std::string> &art);
   bool GetArtForItem(int mediaId, const MediaType &mediaType, std::map<std::string, std::string> &art);
+
+  /*! \brief Fetch the art of several items of the same media type with a single query.
+   \param mediaType the type of media of the items.
+   \param mediaIds the ids of the items.
+   \param art [out] the art of each item by id, items without art get an empty map.
+   \return true if the art was retrieved, false on error.
+   */
+  bool GetArtForItems(const MediaType &mediaType, const std::vector<int> &mediaIds, std::map<int, std::map<std::string, std::string> > &art);
   std::string GetArtForItem(int mediaId, const MediaType &mediaType, const std::string &artType);
   bool HasArtForItem(int mediaId, const MediaType &mediaType);
   bool RemoveArtForItem(int mediaId, const MediaType &mediaType, const std::string &artType);
@@ -849,6 +896,17 @@ public:
   bool GetTvShowSeasonArt(int mediaId, std::map<int, std::map<std::string, std::string> > &seasonArt);
   bool GetArtTypes(const MediaType &mediaType, std::vector<std::string> &artTypes);
 
+  /*! \brief Fetch the distinct urls of all art in the library.
+   \param urls [out] the urls of the art
+   \return true if the query succeeded, false otherwise.
+   */
+  bool GetArtURLs(std::vector<std::string> &urls);
+
+  /*! \brief Get a counter that changes whenever art of any item is set or removed in this process.
+   Art edited by other clients of a shared database isn't counted, see GetChangeRevision().
+   */
+  static unsigned int GetArtRevision();
+
   /*! \brief Fetch the distinct types of available-but-unassigned art held in the
   database for a specific media item.
   \param mediaId the id in the media table.
@@ -930,6 +988,10 @@ protected:
 
   void AddCast(int mediaId, const char *mediaType, const std::vector<SActorInfo> &cast);
 
+  /*! \brief Add a movie to the list unless its path is locked
+   */
+  void AddMovieItem(const CVideoDbUrl& videoUrl, const CVideoInfoTag& movie, CFileItemList& items);
+
   CVideoInfoTag GetDetailsForMovie(std::unique_ptr<dbiplus::Dataset> &pDS, int getDetails = VideoDbDetailsNone);
   CVideoInfoTag GetDetailsForMovie(const dbiplus::sql_record* const record, int getDetails = VideoDbDetailsNone);
   CVideoInfoTag GetDetailsForTvShow(std::unique_ptr<dbiplus::Dataset> &pDS, int getDetails = VideoDbDetailsNone, CFileItem* item = NULL);
@@ -942,6 +1004,7 @@ protected:
   CVideoInfoTag GetDetailsForMusicVideo(const dbiplus::sql_record* const record, int getDetails = VideoDbDetailsNone);
   bool GetPeopleNav(const std::string& strBaseDir, CFileItemList& items, const char *type, int idContent = -1, const Filter &filter = Filter(), bool countOnly = false);
   bool GetNavCommon(const std::string& strBaseDir, CFileItemList& items, const char *type, int idContent=-1, const Filter &filter = Filter(), bool countOnly = false);
+  bool UseNavSummary(const std::string& strBaseDir, const char *type, int idContent, const Filter &filter);
   void GetCast(int media_id, const std::string &media_type, std::vector<SActorInfo> &cast);
   void GetTags(int media_id, const std::string &media_type, std::vector<std::string> &tags);
   void GetRatings(int media_id, const std::string &media_type, RatingMap &ratings);
@@ -958,6 +1021,14 @@ private:
   void CreateLinkIndex(const char *table);
   void CreateForeignLinkIndex(const char *table, const char *foreignkey);
 
+  /*! \brief Rebuild the navsummary rows of a link type if a write dropped them.
+   The table holds the number of items and watched items per genre, country, studio and tag.
+   \param type the link type, e.g. "genre".
+   \param mediaType the media type of the items, movie or musicvideo.
+   \return true if the summary is complete and can be read, false otherwise.
+   */
+  bool UpdateNavSummary(const std::string &type, const std::string &mediaType);
+
   /*! \brief (Re)Create the generic database views for movies, tvshows,
      episodes and music videos
    */
@@ -0,0 +1,293 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "VideoInfoPrefetcher.h"
+
+#include "FileItem.h"
+#include "ServiceBroker.h"
+#include "URL.h"
+#include "VideoInfoDownloader.h"
+#include "addons/AddonManager.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
+#include "tags/VideoInfoTagLoaderFactory.h"
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/JobManager.h"
+#include "utils/log.h"
+
+#include <algorithm>
+#include <deque>
+#include <map>
+
+using namespace ADDON;
+
+namespace
+{
+// shared by all scans, a scraper addon is limited no matter how many scans use it
+struct SScraperLimit
+{
+  int workers = 0;
+  bool requested = false;
+  unsigned int nextRequest = 0;
+};
+
+CCriticalSection limitSection;
+std::map<std::string, SScraperLimit> limits;
+}
+
+namespace VIDEO
+{
+
+struct CVideoInfoPrefetcher::SItem
+{
+  enum STATUS
+  {
+    PENDING,
+    RUNNING,
+    DONE,
+    SKIPPED
+  };
+
+  explicit SItem(const CFileItem& fileItem) : item(fileItem), done(true) {}
+
+  CFileItem item;
+  STATUS status = PENDING;
+  CEvent done;
+  SResult result;
+};
+
+struct CVideoInfoPrefetcher::SState
+{
+  SState() : abortEvent(true) {}
+
+  ScraperPtr scraper;
+  std::string pathSettings;
+  bool dirNames = false;
+  bool useLocal = true;
+  unsigned int interval = 0;
+
+  CCriticalSection section;
+  std::deque<std::shared_ptr<SItem>> queue;
+  std::map<std::string, std::shared_ptr<SItem>> items;
+  bool aborted = false;
+  CEvent abortEvent;
+};
+
+CVideoInfoPrefetcher::CVideoInfoPrefetcher(const ScraperPtr& scraper, bool dirNames, bool useLocal)
+  : m_state(std::make_shared<SState>())
+{
+  m_state->scraper = scraper;
+  m_state->pathSettings = scraper->GetPathSettings();
+  m_state->dirNames = dirNames;
+  m_state->useLocal = useLocal;
+  m_state->interval = std::max(CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iVideoScannerScraperInterval, 0);
+}
+
+CVideoInfoPrefetcher::~CVideoInfoPrefetcher()
+{
+  Cancel();
+}
+
+void CVideoInfoPrefetcher::Add(const CFileItem& item)
+{
+  std::shared_ptr<SItem> entry = std::make_shared<SItem>(item);
+
+  CSingleLock lock(m_state->section);
+  if (m_state->items.insert(std::make_pair(item.GetPath(), entry)).second)
+    m_state->queue.push_back(entry);
+}
+
+bool CVideoInfoPrefetcher::Start()
+{
+  const int maxWorkers = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iVideoScannerScraperThreads;
+
+  int workers = 0;
+  {
+    CSingleLock lock(m_state->section);
+    CSingleLock limitLock(limitSection);
+    SScraperLimit& limit = limits[m_state->scraper->ID()];
+    workers = std::min(maxWorkers - limit.workers, static_cast<int>(m_state->queue.size()));
+    if (workers <= 0)
+      return false;
+    limit.workers += workers;
+  }
+
+  CLog::Log(LOGDEBUG, "CVideoInfoPrefetcher::Start - looking up %u items with %i workers using %s",
+            static_cast<unsigned int>(m_state->queue.size()), workers, m_state->scraper->ID().c_str());
+
+  std::shared_ptr<SState> state = m_state;
+  for (int i = 0; i < workers; ++i)
+    CJobManager::GetInstance().Submit([state]() { Process(state); }, CJob::PRIORITY_LOW);
+
+  return true;
+}
+
+bool CVideoInfoPrefetcher::Take(const std::string& path, SResult& result)
+{
+  std::shared_ptr<SItem> item;
+  {
+    CSingleLock lock(m_state->section);
+    auto it = m_state->items.find(path);
+    if (it == m_state->items.end())
+      return false;
+
+    item = it->second;
+    m_state->items.erase(it);
+
+    if (item->status == SItem::PENDING)
+    {
+      // cheaper to look it up right here than to wait for a worker to get to it
+      item->status = SItem::SKIPPED;
+      return false;
+    }
+  }
+
+  item->done.Wait();
+
+  CSingleLock lock(m_state->section);
+  if (item->status != SItem::DONE)
+    return false;
+
+  result = std::move(item->result);
+  return true;
+}
+
+void CVideoInfoPrefetcher::Cancel()
+{
+  CSingleLock lock(m_state->section);
+  m_state->aborted = true;
+  m_state->queue.clear();
+  m_state->abortEvent.Set();
+}
+
+void CVideoInfoPrefetcher::Process(std::shared_ptr<SState> state)
+{
+  // the parser of a scraper keeps its state while it runs, every worker needs its own instance
+  AddonPtr addon;
+  ScraperPtr scraper;
+  if (CServiceBroker::GetAddonMgr().GetAddon(state->scraper->ID(), addon, state->scraper->Type()))
+    scraper = std::dynamic_pointer_cast<CScraper>(addon);
+  if (scraper)
+    scraper->SetPathSettings(state->scraper->Content(), state->pathSettings);
+  else
+    CLog::Log(LOGERROR, "CVideoInfoPrefetcher::Process - unable to load scraper %s", state->scraper->ID().c_str());
+
+  while (scraper)
+  {
+    std::shared_ptr<SItem> item;
+    {
+      CSingleLock lock(state->section);
+      if (state->aborted || state->queue.empty())
+        break;
+      item = state->queue.front();
+      state->queue.pop_front();
+      if (item->status != SItem::PENDING)
+        continue;
+      item->status = SItem::RUNNING;
+    }
+
+    // space out the requests to the same scraper addon
+    unsigned int wait = 0;
+    if (state->interval > 0)
+    {
+      CSingleLock limitLock(limitSection);
+      SScraperLimit& limit = limits[state->scraper->ID()];
+      const unsigned int now = XbmcThreads::SystemClockMillis();
+      if (limit.requested && static_cast<int>(limit.nextRequest - now) > 0)
+        wait = limit.nextRequest - now;
+      limit.nextRequest = now + wait + state->interval;
+      limit.requested = true;
+    }
+
+    SItem::STATUS status = SItem::SKIPPED;
+    if (wait == 0 || !state->abortEvent.WaitMSec(wait))
+    {
+      Lookup(*state, scraper, *item);
+      status = SItem::DONE;
+    }
+
+    {
+      CSingleLock lock(state->section);
+      item->status = status;
+    }
+    item->done.Set();
+  }
+
+  // items nobody picked up stay pending, the scanner looks them up itself
+  CSingleLock limitLock(limitSection);
+  auto it = limits.find(state->scraper->ID());
+  if (it != limits.end() && --it->second.workers <= 0)
+    limits.erase(it);
+}
+
+void CVideoInfoPrefetcher::Lookup(const SState& state, const ScraperPtr& scraper, SItem& item)
+{
+  CFileItem& fileItem = item.item;
+  SResult& result = item.result;
+
+  std::unique_ptr<IVideoInfoTagLoader> loader;
+  if (state.useLocal)
+  {
+    loader.reset(CVideoInfoTagLoaderFactory::CreateLoader(fileItem, scraper, state.dirNames));
+    if (loader)
+    {
+      fileItem.GetVideoInfoTag()->Reset();
+      result.nfoResult = loader->Load(*fileItem.GetVideoInfoTag(), false);
+    }
+  }
+
+  result.details = *fileItem.GetVideoInfoTag();
+  if (result.nfoResult == CInfoScanner::FULL_NFO)
+    return;
+
+  CVideoInfoDownloader downloader(scraper);
+  if (result.nfoResult == CInfoScanner::URL_NFO || result.nfoResult == CInfoScanner::COMBINED_NFO)
+    result.url = loader->ScraperUrl();
+
+  if (!result.url.m_url.empty())
+    result.hasUrl = true;
+  else
+  {
+    std::string title = fileItem.GetMovieName(state.dirNames);
+    int year = -1; // hint that movie title was not found
+    if (result.nfoResult == CInfoScanner::TITLE_NFO)
+    {
+      title = result.details.GetTitle();
+      year = result.details.GetYear();
+    }
+
+    MOVIELIST movies;
+    result.findResult = downloader.FindMovie(title, year, movies);
+    if (result.findResult > 0 && !movies.empty())
+    {
+      result.url = movies[0];
+      result.hasUrl = true;
+    }
+  }
+
+  if (!result.hasUrl)
+    return;
+
+  CVideoInfoTag details;
+  result.hasDetails = downloader.GetDetails(result.url, details);
+  if (result.hasDetails)
+  {
+    if (loader && (result.nfoResult == CInfoScanner::COMBINED_NFO ||
+                   result.nfoResult == CInfoScanner::OVERRIDE_NFO))
+      loader->Load(details, true);
+    result.details = std::move(details);
+  }
+  else
+    CLog::Log(LOGDEBUG, "CVideoInfoPrefetcher::Lookup - no details for %s",
+              CURL::GetRedacted(fileItem.GetPath()).c_str());
+}
+
+}
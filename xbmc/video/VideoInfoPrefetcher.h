@@ -0,0 +1,75 @@
+/*
+ *  Copyright (C) 2005-2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "InfoScanner.h"
+#include "VideoInfoTag.h"
+#include "addons/Scraper.h"
+#include "utils/ScraperUrl.h"
+
+#include <memory>
+#include <string>
+
+class CFileItem;
+
+namespace VIDEO
+{
+  /*!
+   \brief Looks up movies and music videos ahead of the scanner.
+
+   The nfo files of the queued items are read and the scraper is asked for the details on job
+   threads, while the scanner keeps adding the items it already got to the database. Every worker
+   runs its own instance of the scraper addon as the instances aren't thread safe. The number of
+   workers per scraper addon is limited across all running scans, and requests to the same addon can
+   be spaced out to stay within the rate limits of the site behind it.
+   */
+  class CVideoInfoPrefetcher
+  {
+  public:
+    struct SResult
+    {
+      CInfoScanner::INFO_TYPE nfoResult = CInfoScanner::NO_NFO;
+      int findResult = 0; //!< as returned by CVideoInfoDownloader::FindMovie
+      bool hasUrl = false;
+      bool hasDetails = false;
+      CScraperUrl url;
+      CVideoInfoTag details;
+    };
+
+    CVideoInfoPrefetcher(const ADDON::ScraperPtr& scraper, bool dirNames, bool useLocal);
+    ~CVideoInfoPrefetcher();
+
+    /*! \brief Queue an item, must be called before Start() */
+    void Add(const CFileItem& item);
+
+    /*! \brief Start the workers
+     \return false if no worker could be started, e.g. because other scans use up the limit
+     */
+    bool Start();
+
+    /*! \brief Get the looked up information for an item
+     Waits for a lookup that is in progress. An item none of the workers picked up yet is dropped
+     from the queue, the caller has to look it up itself then.
+     \return true if the result was handed out
+     */
+    bool Take(const std::string& path, SResult& result);
+
+    /*! \brief Stop the workers after the lookups in progress */
+    void Cancel();
+
+  private:
+    struct SState;
+    struct SItem;
+
+    static void Process(std::shared_ptr<SState> state);
+    static void Lookup(const SState& state, const ADDON::ScraperPtr& scraper, SItem& item);
+
+    std::shared_ptr<SState> m_state;
+  };
+}
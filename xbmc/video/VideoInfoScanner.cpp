@@ -112,6 +112,11 @@ namespace VIDEO
       // result in unexpected behaviour.
       m_bCanInterrupt = false;
 
+      // write the items in groups, a path is only marked as scanned together with its items
+      const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+      m_database.BeginWriteBatch(advancedSettings->m_iVideoLibraryWriteBatchSize,
+                                 advancedSettings->m_iVideoLibraryWriteBatchTime);
+
       bool bCancelled = false;
       while (!bCancelled && !m_pathsToScan.empty())
       {
@@ -140,6 +145,8 @@ namespace VIDEO
           bCancelled = true;
       }
 
+      m_database.CommitWriteBatch();
+
       if (!bCancelled)
       {
         if (m_bClean)
@@ -155,11 +162,17 @@ namespace VIDEO
       CServiceBroker::GetGUI()->GetInfoManager().GetInfoProviders().GetLibraryInfoProvider().ResetLibraryBools();
       m_database.Close();
 
+      // probed once all items are written, the probes store their results themselves
+      if (!m_pathsToProbe.empty())
+        CVideoLibraryQueue::GetInstance().ProbeStreamDetails(m_pathsToProbe);
+      m_pathsToProbe.clear();
+
       tick = XbmcThreads::SystemClockMillis() - tick;
       CLog::Log(LOGNOTICE, "VideoInfoScanner: Finished scan. Scanning for video info took %s", StringUtils::SecondsToTimeString(tick / 1000).c_str());
     }
     catch (...)
     {
+      m_database.CommitWriteBatch();
       CLog::Log(LOGERROR, "VideoInfoScanner: Exception while scanning.");
     }
 
@@ -177,6 +190,7 @@ namespace VIDEO
     m_scanAll = scanAll;
     m_pathsToScan.clear();
     m_pathsToClean.clear();
+    m_pathsToProbe.clear();
 
     m_database.Open();
     if (strDirectory.empty())
@@ -203,6 +217,7 @@ namespace VIDEO
     }
     m_database.Close();
     m_bClean = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bVideoLibraryCleanOnUpdate;
+    m_episodeRegExpsCompiled = false;
 
     m_bRunning = true;
     Process();
@@ -281,10 +296,25 @@ namespace VIDEO
       if (CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bVideoLibraryUseFastHash && !URIUtils::IsPlugin(strDirectory))
         fastHash = GetFastHash(strDirectory, regexps);
 
+      std::string fingerprint, fingerprintHash;
+      std::vector<std::string> subDirs;
+      bool hasFingerprint = false;
+      bool unchangedEntries = false;
+      if (!fastHash.empty())
+        hasFingerprint = m_database.GetPathFingerprint(strDirectory, fingerprint, fingerprintHash, subDirs);
+
       if (m_database.GetPathHash(strDirectory, dbHash) && !fastHash.empty() && StringUtils::EqualsNoCase(fastHash, dbHash))
       { // fast hashes match - no need to process anything
         hash = fastHash;
       }
+      else if (hasFingerprint && StringUtils::EqualsNoCase(fingerprint, fastHash) &&
+               (fingerprintHash.empty() || StringUtils::EqualsNoCase(fingerprintHash, dbHash)))
+      { // entries of the folder didn't change since it was listed - only the subfolders need a look
+        hash = dbHash;
+        unchangedEntries = true;
+        for (const auto& subDir : subDirs)
+          items.Add(CFileItemPtr(new CFileItem(URIUtils::AddFileToFolder(strDirectory, subDir), true)));
+      }
       else
       { // need to fetch the folder
         CDirectory::GetDirectory(strDirectory, items, CServiceBroker::GetFileExtensionProvider().GetVideoExtensions(),
@@ -296,9 +326,17 @@ namespace VIDEO
           GetPathHash(items, hash);
         else
           hash = fastHash;
+
+        if (!fastHash.empty())
+          UpdatePathFingerprint(strDirectory, fastHash, hasFingerprint, items, hash);
       }
 
-      if (StringUtils::EqualsNoCase(hash, dbHash))
+      if (unchangedEntries)
+      {
+        CLog::Log(LOGDEBUG, "VideoInfoScanner: Skipping dir '%s' due to no change (fingerprint)", CURL::GetRedacted(strDirectory).c_str());
+        bSkip = true;
+      }
+      else if (StringUtils::EqualsNoCase(hash, dbHash))
       { // hash matches - skipping
         CLog::Log(LOGDEBUG, "VideoInfoScanner: Skipping dir '%s' due to no change%s", CURL::GetRedacted(strDirectory).c_str(), !fastHash.empty() ? " (fasthash)" : "");
         bSkip = true;
@@ -410,6 +448,15 @@ namespace VIDEO
 
     m_database.Open();
 
+    // the background scanner looks up the files of a folder ahead while it adds them
+    if (!pDlgProgress && !pURL && items.Size() > 1 &&
+        (content == CONTENT_MOVIES || content == CONTENT_MUSICVIDEOS))
+    {
+      ScraperPtr scraper = m_database.GetScraperForPath(items.GetPath());
+      if (scraper && scraper->Content() == content)
+        PrefetchVideoInfo(items, bDirNames, scraper, useLocal);
+    }
+
     bool FoundSomeInfo = false;
     std::vector<int> seenPaths;
     for (int i = 0; i < items.Size(); ++i)
@@ -498,10 +545,79 @@ namespace VIDEO
     if(pDlgProgress)
       pDlgProgress->ShowProgressBar(false);
 
+    m_prefetcher.reset();
     m_database.Close();
     return FoundSomeInfo;
   }
 
+  void CVideoInfoScanner::PrefetchVideoInfo(const CFileItemList& items, bool bDirNames, const ScraperPtr &scraper, bool useLocal)
+  {
+    std::unique_ptr<CVideoInfoPrefetcher> prefetcher(new CVideoInfoPrefetcher(scraper, bDirNames, useLocal));
+    bool queued = false;
+    for (int i = 0; i < items.Size(); ++i)
+    {
+      const CFileItemPtr pItem = items[i];
+      if (pItem->m_bIsFolder || !pItem->IsVideo() || pItem->IsNFO() ||
+         (pItem->IsPlayList() && !URIUtils::HasExtension(pItem->GetPath(), ".strm")))
+        continue;
+
+      if (CUtil::ExcludeFileOrFolder(pItem->GetPath(), CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_moviesExcludeFromScanRegExps))
+        continue;
+
+      if (scraper->Content() == CONTENT_MOVIES ? m_database.HasMovieInfo(pItem->GetPath())
+                                               : m_database.HasMusicVideoInfo(pItem->GetPath()))
+        continue;
+
+      prefetcher->Add(*pItem);
+      queued = true;
+    }
+
+    if (queued && prefetcher->Start())
+      m_prefetcher = std::move(prefetcher);
+  }
+
+  CInfoScanner::INFO_RET
+  CVideoInfoScanner::AddPrefetchedVideo(CFileItem *pItem,
+                                        bool bDirNames,
+                                        const ScraperPtr &scraper,
+                                        bool useLocal,
+                                        CVideoInfoPrefetcher::SResult &result)
+  {
+    if (result.nfoResult == CInfoScanner::FULL_NFO)
+    {
+      *pItem->GetVideoInfoTag() = result.details;
+      if (AddVideo(pItem, scraper->Content(), bDirNames, true) < 0)
+        return INFO_ERROR;
+      return INFO_ADDED;
+    }
+
+    if (!result.hasUrl)
+    {
+      if (result.findResult < 0 || (result.findResult == 0 && (m_bStop || !DownloadFailed(nullptr))))
+      { // scraper reported an error, or we had an error and user wants to cancel the scan
+        m_bStop = true;
+        return INFO_CANCELLED;
+      }
+      return INFO_NOT_FOUND;
+    }
+
+    CLog::Log(LOGDEBUG,
+              "VideoInfoScanner: Fetched url '%s' using %s scraper (content: '%s')",
+              result.url.m_url[0].m_url.c_str(), scraper->Name().c_str(),
+              TranslateContent(scraper->Content()).c_str());
+
+    if (!result.hasDetails)
+      return INFO_NOT_FOUND;
+
+    if (m_handle)
+      m_handle->SetText(result.details.m_strTitle);
+
+    *pItem->GetVideoInfoTag() = result.details;
+    if (AddVideo(pItem, scraper->Content(), bDirNames, useLocal) < 0)
+      return INFO_ERROR;
+    return INFO_ADDED;
+  }
+
   CInfoScanner::INFO_RET
   CVideoInfoScanner::RetrieveInfoForTvShow(CFileItem *pItem,
                                            bool bDirNames,
@@ -637,6 +753,10 @@ namespace VIDEO
     if (m_handle)
       m_handle->SetText(pItem->GetMovieName(bDirNames));
 
+    CVideoInfoPrefetcher::SResult prefetched;
+    if (m_prefetcher && m_prefetcher->Take(pItem->GetPath(), prefetched))
+      return AddPrefetchedVideo(pItem, bDirNames, info2, useLocal, prefetched);
+
     CInfoScanner::INFO_TYPE result = CInfoScanner::NO_NFO;
     CScraperUrl scrUrl;
     // handle .nfo files
@@ -716,6 +836,10 @@ namespace VIDEO
     if (m_handle)
       m_handle->SetText(pItem->GetMovieName(bDirNames));
 
+    CVideoInfoPrefetcher::SResult prefetched;
+    if (m_prefetcher && m_prefetcher->Take(pItem->GetPath(), prefetched))
+      return AddPrefetchedVideo(pItem, bDirNames, info2, useLocal, prefetched);
+
     CInfoScanner::INFO_TYPE result = CInfoScanner::NO_NFO;
     CScraperUrl scrUrl;
     // handle .nfo files
@@ -1089,9 +1213,33 @@ namespace VIDEO
     return false;
   }
 
+  void CVideoInfoScanner::CompileEpisodeRegExps()
+  {
+    const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+
+    // every file of a tv show folder is matched against these, so they are worth JIT compiling
+    m_episodeRegExps.clear();
+    for (const TVShowRegexp& expression : advancedSettings->m_tvshowEnumRegExps)
+    {
+      std::unique_ptr<CRegExp> reg(new CRegExp(true, CRegExp::autoUtf8));
+      if (!reg->RegComp(expression.regexp, CRegExp::StudyWithJitComp))
+        reg.reset();
+      m_episodeRegExps.push_back(std::move(reg));
+    }
+
+    m_multiPartRegExp.reset(new CRegExp(true, CRegExp::autoUtf8));
+    if (!m_multiPartRegExp->RegComp(advancedSettings->m_tvshowMultiPartEnumRegExp, CRegExp::StudyWithJitComp))
+      m_multiPartRegExp.reset();
+
+    m_episodeRegExpsCompiled = true;
+  }
+
   bool CVideoInfoScanner::EnumerateEpisodeItem(const CFileItem *item, EPISODELIST& episodeList)
   {
-    SETTINGS_TVSHOWLIST expression = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_tvshowEnumRegExps;
+    const std::shared_ptr<CAdvancedSettings> advancedSettings = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings();
+    const SETTINGS_TVSHOWLIST& expression = advancedSettings->m_tvshowEnumRegExps;
+    if (!m_episodeRegExpsCompiled || m_episodeRegExps.size() != expression.size())
+      CompileEpisodeRegExps();
 
     std::string strLabel;
 
@@ -1109,9 +1257,9 @@ namespace VIDEO
 
     for (unsigned int i=0;i<expression.size();++i)
     {
-      CRegExp reg(true, CRegExp::autoUtf8);
-      if (!reg.RegComp(expression[i].regexp))
+      if (!m_episodeRegExps[i])
         continue;
+      CRegExp& reg = *m_episodeRegExps[i];
 
       int regexppos, regexp2pos;
       //CLog::Log(LOGDEBUG,"running expression %s on %s",expression[i].regexp.c_str(),strLabel.c_str());
@@ -1178,10 +1326,10 @@ namespace VIDEO
       // add what we found by now
       episodeList.push_back(episode);
 
-      CRegExp reg2(true, CRegExp::autoUtf8);
       // check the remainder of the string for any further episodes.
-      if (!byDate && reg2.RegComp(CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_tvshowMultiPartEnumRegExp))
+      if (!byDate && m_multiPartRegExp)
       {
+        CRegExp& reg2 = *m_multiPartRegExp;
         int offset = 0;
 
         // we want "long circuit" OR below so that both offsets are evaluated
@@ -1394,8 +1542,13 @@ namespace VIDEO
       if ((CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_bVideoLibraryImportResumePoint || libraryImport) &&
           movieDetails.GetResumePoint().IsSet())
         m_database.AddBookMarkToFile(pItem->GetPath(), movieDetails.GetResumePoint(), CBookmark::RESUME);
+
+      if (!libraryImport && !pItem->IsPlugin() && !movieDetails.HasStreamDetails() &&
+          CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_MYVIDEOS_EXTRACTFLAGS))
+        m_pathsToProbe.push_back(pItem->GetPath());
     }
 
+    m_database.EndWriteBatchItem();
     m_database.Close();
 
     CFileItemPtr itemCopy = CFileItemPtr(new CFileItem(*pItem));
@@ -1869,6 +2022,47 @@ namespace VIDEO
     return "";
   }
 
+  void CVideoInfoScanner::UpdatePathFingerprint(const std::string &directory, const std::string &fingerprint,
+                                                bool hasFingerprint, const CFileItemList &items, const std::string &hash)
+  {
+    std::vector<std::string> subDirs;
+    bool hasFiles = false;
+    for (int i = 0; i < items.Size(); ++i)
+    {
+      const CFileItemPtr item = items[i];
+      if (!item->m_bIsFolder || item->IsPlayList())
+      {
+        hasFiles = true;
+        continue;
+      }
+      if (item->IsParentFolder())
+        continue;
+
+      std::string path = item->GetPath();
+      URIUtils::RemoveSlashAtEnd(path);
+      const std::string name = URIUtils::GetFileName(path);
+
+      // only folders that can be found again by their name, anything else needs a listing
+      if (!URIUtils::PathEquals(URIUtils::AddFileToFolder(directory, name), path, true) ||
+          name.find('/') != std::string::npos)
+      {
+        subDirs.clear();
+        break;
+      }
+      subDirs.push_back(name);
+    }
+
+    // folders without subfolders are covered by the fast hash alone
+    if (subDirs.empty())
+    {
+      if (hasFingerprint)
+        m_database.SetPathFingerprint(directory, "", "", subDirs);
+      return;
+    }
+
+    m_database.SetPathFingerprint(directory, fingerprint, hasFiles ? hash : "", subDirs);
+  }
+
   std::string CVideoInfoScanner::GetRecursiveFastHash(const std::string &directory,
       const std::vector<std::string> &excludes) const
   {
@@ -10,8 +10,10 @@
 
 #include "InfoScanner.h"
 #include "VideoDatabase.h"
+#include "VideoInfoPrefetcher.h"
 #include "addons/Scraper.h"
 
+#include <memory>
 #include <set>
 #include <string>
 #include <vector>
@@ -58,6 +60,10 @@ namespace VIDEO
      */
     long AddVideo(CFileItem *pItem, const CONTENT_TYPE &content, bool videoFolder = false, bool useLocal = true, const CVideoInfoTag *showInfo = NULL, bool libraryImport = false);
 
+    /*! \brief The database AddVideo() writes to, e.g. to group the writes of a library import.
+     */
+    CVideoDatabase& GetDatabase() { return m_database; }
+
     /*! \brief Retrieve information for a list of items and add them to the database.
      \param items list of items to retrieve info for.
      \param bDirNames whether we should use folder or file names for lookups.
@@ -110,6 +116,25 @@ namespace VIDEO
     INFO_RET RetrieveInfoForMusicVideo(CFileItem *pItem, bool bDirNames, ADDON::ScraperPtr &scraper, bool useLocal, CScraperUrl* pURL, CGUIDialogProgress* pDlgProgress);
     INFO_RET RetrieveInfoForEpisodes(CFileItem *item, long showID, const ADDON::ScraperPtr &scraper, bool useLocal, CGUIDialogProgress *progress = NULL);
 
+    /*! \brief Queue the movies or music videos of a folder for a lookup ahead of the scanner
+     Only used for background scans, the lookups can't show a progress dialog.
+     \param items list of items that are about to be retrieved.
+     \param bDirNames whether we should use folder or file names for lookups.
+     \param scraper scraper that handles the files of the folder.
+     \param useLocal should local data (.nfo) be used.
+     */
+    void PrefetchVideoInfo(const CFileItemList& items, bool bDirNames, const ADDON::ScraperPtr &scraper, bool useLocal);
+
+    /*! \brief Add an item the prefetcher looked up to the database
+     \param pItem item that was looked up.
+     \param bDirNames whether we should use folder or file names for lookups.
+     \param scraper scraper that handles the item.
+     \param useLocal should local data (art) be used.
+     \param result the information the prefetcher found.
+     \return the result of the lookup, as RetrieveInfoForMovie() would have returned it.
+     */
+    INFO_RET AddPrefetchedVideo(CFileItem *pItem, bool bDirNames, const ADDON::ScraperPtr &scraper, bool useLocal, CVideoInfoPrefetcher::SResult &result);
+
     /*! \brief Update the progress bar with the heading and line and check for cancellation
      \param progress CGUIDialogProgress bar
      \param heading string id of heading
@@ -199,6 +224,18 @@ namespace VIDEO
      */
     std::string GetRecursiveFastHash(const std::string &directory, const std::vector<std::string> &excludes) const;
 
+    /*! \brief Remember the subfolders of a folder that was just listed
+     As long as the fast hash of the folder stays the same, its entries didn't change. The next scan
+     can then go on with the subfolders without listing the folder again.
+     \param directory folder that was listed.
+     \param fingerprint fast hash of the folder.
+     \param hasFingerprint whether the database holds a fingerprint of the folder already.
+     \param items the entries of the folder.
+     \param hash hash of the entries, the files have to be scanned again when it changes.
+     \sa GetFastHash
+     */
+    void UpdatePathFingerprint(const std::string &directory, const std::string &fingerprint, bool hasFingerprint, const CFileItemList &items, const std::string &hash);
+
     /*! \brief Decide whether a folder listing could use the "fast" hash
      Fast hashing can be done whenever the folder contains no scannable subfolders, as the
      fast hash technique uses modified time to determine when folder content changes, which
@@ -225,12 +262,22 @@ namespace VIDEO
     bool EnumerateSeriesFolder(CFileItem* item, EPISODELIST& episodeList);
     bool ProcessItemByVideoInfoTag(const CFileItem *item, EPISODELIST &episodeList);
 
+    /*! \brief Compile the episode matching expressions of the advanced settings
+     They are compiled once per scan instead of once per file.
+     */
+    void CompileEpisodeRegExps();
+
     bool m_bStop;
     bool m_scanAll;
     std::string m_strStartDir;
     CVideoDatabase m_database;
     std::set<std::string> m_pathsToCount;
     std::set<int> m_pathsToClean;
+    std::vector<std::string> m_pathsToProbe;
+    std::unique_ptr<CVideoInfoPrefetcher> m_prefetcher;
+    bool m_episodeRegExpsCompiled = false;
+    std::vector<std::unique_ptr<CRegExp>> m_episodeRegExps; // null if an expression failed to compile
+    std::unique_ptr<CRegExp> m_multiPartRegExp;
   };
 }
 
@@ -10,10 +10,16 @@
 
 #include "GUIUserMessages.h"
 #include "ServiceBroker.h"
+#include "URL.h"
 #include "Util.h"
+#include "filesystem/StackDirectory.h"
 #include "guilib/GUIComponent.h"
 #include "guilib/GUIWindowManager.h"
+#include "settings/AdvancedSettings.h"
+#include "settings/SettingsComponent.h"
 #include "threads/SingleLock.h"
+#include "utils/URIUtils.h"
+#include "video/VideoThumbLoader.h"
 #include "video/jobs/VideoLibraryCleaningJob.h"
 #include "video/jobs/VideoLibraryJob.h"
 #include "video/jobs/VideoLibraryMarkWatchedJob.h"
@@ -23,6 +29,18 @@
 
 #include <utility>
 
+namespace
+{
+std::string GetProbeHost(const std::string& path)
+{
+  CURL url(URIUtils::IsStack(path) ? XFILE::CStackDirectory::GetFirstStackedFile(path) : path);
+  // files in archives are read from wherever the archive is
+  if (URIUtils::IsInArchive(url.Get()))
+    url = CURL(url.GetHostName());
+  return url.GetProtocol() + "://" + url.GetHostName();
+}
+}
+
 CVideoLibraryQueue::CVideoLibraryQueue()
   : CJobQueue(false, 1, CJob::PRIORITY_LOW),
     m_jobs()
@@ -197,11 +215,32 @@ void CVideoLibraryQueue::CancelJob(CVideoLibraryJob *job)
     jobsIt->second.erase(job);
 }
 
+void CVideoLibraryQueue::ProbeStreamDetails(const std::vector<std::string>& paths)
+{
+  const int jobsPerHost = CServiceBroker::GetSettingsComponent()->GetAdvancedSettings()->m_iVideoScannerProbeThreads;
+
+  CSingleLock lock(m_critical);
+  for (const auto& path : paths)
+  {
+    // a slow server only holds up the probes of its own files
+    std::unique_ptr<CJobQueue>& queue = m_probeQueues[GetProbeHost(path)];
+    if (!queue)
+      queue.reset(new CJobQueue(false, jobsPerHost, CJob::PRIORITY_LOW_PAUSABLE));
+
+    CFileItem item(path, false);
+    item.GetVideoInfoTag()->m_strFileNameAndPath = path;
+    queue->AddJob(new CThumbExtractor(item, path, false));
+  }
+}
+
 void CVideoLibraryQueue::CancelAllJobs()
 {
   CSingleLock lock(m_critical);
   CJobQueue::CancelJobs();
 
+  for (auto& queue : m_probeQueues)
+    queue.second->CancelJobs();
+
   // remove all scanning jobs
   m_jobs.clear();
 }
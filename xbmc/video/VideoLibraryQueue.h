@@ -13,7 +13,10 @@
 #include "utils/JobManager.h"
 
 #include <map>
+#include <memory>
 #include <set>
+#include <string>
+#include <vector>
 
 class CGUIDialogProgressBarHandle;
 class CVideoLibraryJob;
@@ -107,6 +110,13 @@ public:
    */
   void ResetResumePoint(const CFileItemPtr item);
 
+  /*!
+   \brief Queue the extraction of the stream details of files added to the library.
+   The files are probed in the background, a few at a time per server they are on, and the
+   details are stored in the database.
+   \param[in] paths Paths of the files to probe
+   */
+  void ProbeStreamDetails(const std::vector<std::string>& paths);
   /*!
    \brief Adds the given job to the queue.
 
@@ -148,6 +158,7 @@ private:
   typedef std::set<CVideoLibraryJob*> VideoLibraryJobs;
   typedef std::map<std::string, VideoLibraryJobs> VideoLibraryJobMap;
   VideoLibraryJobMap m_jobs;
+  std::map<std::string, std::unique_ptr<CJobQueue>> m_probeQueues;
   CCriticalSection m_critical;
 
   bool m_modal = false;
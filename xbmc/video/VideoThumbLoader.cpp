@@ -17,6 +17,7 @@
 #include "cores/VideoSettings.h"
 #include "filesystem/Directory.h"
 #include "filesystem/DirectoryCache.h"
+#include "filesystem/File.h"
 #include "filesystem/StackDirectory.h"
 #include "guilib/GUIComponent.h"
 #include "guilib/GUIWindowManager.h"
@@ -36,11 +37,20 @@
 
 #include <algorithm>
 #include <cstdlib>
+#include <set>
 #include <utility>
 
 using namespace XFILE;
 using namespace VIDEO;
 
+namespace
+{
+// items whose art is fetched with one query, a few screens of a list
+constexpr size_t PREFETCH_ITEMS = 200;
+// the art of large libraries isn't kept around after the list was left
+constexpr size_t MAX_CACHED_ITEMS = 10000;
+}
+
 CThumbExtractor::CThumbExtractor(const CFileItem& item,
                                  const std::string& listpath,
                                  bool thumb,
@@ -189,17 +199,77 @@ CVideoThumbLoader::~CVideoThumbLoader()
 void CVideoThumbLoader::OnLoaderStart()
 {
   m_videoDatabase->Open();
-  m_artCache.clear();
+
+  // art cached by earlier loads is kept as long as no item of the library changed, the
+  // changelog includes the writes of other clients of a shared database
+  const int changeRevision = m_videoDatabase->GetChangeRevision();
+  if (changeRevision < 0 || changeRevision != m_changeRevision || m_artCache.size() > MAX_CACHED_ITEMS)
+    m_artCache.clear();
+  m_changeRevision = changeRevision;
+
+  m_nextPrefetch = 0;
+  PrefetchLibraryArt();
   CThumbLoader::OnLoaderStart();
 }
 
 void CVideoThumbLoader::OnLoaderFinish()
 {
   m_videoDatabase->Close();
-  m_artCache.clear();
   CThumbLoader::OnLoaderFinish();
 }
 
+void CVideoThumbLoader::DropStaleArt()
+{
+  const unsigned int artRevision = CVideoDatabase::GetArtRevision();
+  if (artRevision != m_artRevision)
+  {
+    m_artCache.clear();
+    m_artRevision = artRevision;
+  }
+}
+
+void CVideoThumbLoader::PrefetchLibraryArt()
+{
+  DropStaleArt();
+
+  std::map<MediaType, std::set<int>> ids;
+  size_t count = 0;
+  auto add = [this, &ids, &count](const MediaType& type, int id)
+  {
+    if (id >= 0 && m_artCache.find(std::make_pair(type, id)) == m_artCache.end() &&
+        ids[type].insert(id).second)
+      count++;
+  };
+
+  for (; m_nextPrefetch < m_vecItems.size() && count < PREFETCH_ITEMS; ++m_nextPrefetch)
+  {
+    const CFileItemPtr& item = m_vecItems[m_nextPrefetch];
+    if (!item->HasVideoInfoTag() || item->GetProperty("libraryartfilled").asBoolean())
+      continue;
+
+    const CVideoInfoTag& tag = *item->GetVideoInfoTag();
+    if (tag.m_iDbId < 0 || tag.m_type.empty())
+      continue;
+
+    add(tag.m_type, tag.m_iDbId);
+    if (tag.m_type == MediaTypeEpisode || tag.m_type == MediaTypeSeason)
+      add(MediaTypeTvShow, tag.m_iIdShow);
+    if (tag.m_type == MediaTypeEpisode && tag.m_iSeason > -1)
+      add(MediaTypeSeason, tag.m_iIdSeason);
+    else if (tag.m_type == MediaTypeMovie)
+      add(MediaTypeVideoCollection, tag.m_set.id);
+  }
+
+  for (const auto& type : ids)
+  {
+    std::map<int, ArtMap> art;
+    if (!m_videoDatabase->GetArtForItems(type.first, std::vector<int>(type.second.begin(), type.second.end()), art))
+      continue;
+    for (auto& it : art)
+      m_artCache[std::make_pair(type.first, it.first)] = std::move(it.second);
+  }
+}
+
 static void SetupRarOptions(CFileItem& item, const std::string& path)
 {
   std::string path2(path);
@@ -509,7 +579,25 @@ bool CVideoThumbLoader::FillLibraryArt(CFileItem &item)
   {
     std::map<std::string, std::string> artwork;
     m_videoDatabase->Open();
-    if (m_videoDatabase->GetArtForItem(tag.m_iDbId, tag.m_type, artwork))
+    DropStaleArt();
+    const std::pair<MediaType, int> key = std::make_pair(tag.m_type, tag.m_iDbId);
+    auto cached = m_artCache.find(key);
+    if (cached == m_artCache.end() && m_nextPrefetch < m_vecItems.size())
+    {
+      PrefetchLibraryArt();
+      cached = m_artCache.find(key);
+    }
+
+    bool found = false;
+    if (cached != m_artCache.end())
+    {
+      artwork = cached->second;
+      found = !artwork.empty();
+    }
+    else
+      found = m_videoDatabase->GetArtForItem(tag.m_iDbId, tag.m_type, artwork);
+
+    if (found)
       SetArt(item, artwork);
     else if (tag.m_type == "actor" && !tag.m_artist.empty())
     { // we retrieve music video art from the music database (no backward compat)
@@ -610,25 +698,31 @@ std::string CVideoThumbLoader::GetLocalArt(const CFileItem &item, const std::str
     CDirectory::GetDirectory(item.GetPath(), items, "", DIR_FLAG_NO_FILE_DIRS | DIR_FLAG_READ_CACHE | DIR_FLAG_NO_FILE_INFO);
   }
 
-  std::string art;
+  std::vector<std::string> candidates;
   if (!type.empty())
   {
-    art = item.FindLocalArt(type + ".jpg", checkFolder);
-    if (art.empty())
-      art = item.FindLocalArt(type + ".png", checkFolder);
+    item.GetLocalArtCandidates(type + ".jpg", checkFolder, candidates);
+    item.GetLocalArtCandidates(type + ".png", checkFolder, candidates);
   }
-  if (art.empty() && (type.empty() || type == "thumb"))
+  if (type.empty() || type == "thumb")
   { // backward compatibility
-    art = item.FindLocalArt("", false);
-    if (art.empty() && (checkFolder || (item.m_bIsFolder && !item.IsFileFolder()) || item.IsOpticalMediaFile()))
-    { // try movie.tbn
-      art = item.FindLocalArt("movie.tbn", true);
-      if (art.empty()) // try folder.jpg
-        art = item.FindLocalArt("folder.jpg", true);
+    item.GetLocalArtCandidates("", false, candidates);
+    if (checkFolder || (item.m_bIsFolder && !item.IsFileFolder()) || item.IsOpticalMediaFile())
+    { // try movie.tbn, then folder.jpg
+      item.GetLocalArtCandidates("movie.tbn", true, candidates);
+      item.GetLocalArtCandidates("folder.jpg", true, candidates);
     }
   }
 
-  return art;
+  // on network filesystems the candidates of a folder are checked with one listing
+  const std::vector<bool> exists = CFile::ExistsBatch(candidates);
+  for (size_t i = 0; i < candidates.size(); i++)
+  {
+    if (exists[i])
+      return candidates[i];
+  }
+
+  return "";
 }
 
 std::string CVideoThumbLoader::GetEmbeddedThumbURL(const CFileItem &item)
@@ -135,4 +135,17 @@ protected:
   void DetectAndAddMissingItemData(CFileItem &item);
 
   const ArtMap& GetArtFromCache(const std::string &mediaType, const int id);
+
+  /*! \brief Fetch the art of the next library items of the list and their shows, seasons and sets
+   with one query per media type. The art stays cached between loads until the library or any art
+   changes.
+   */
+  void PrefetchLibraryArt();
+
+  /*! \brief Drop the cached art if art was set or removed since it was fetched */
+  void DropStaleArt();
+
+  size_t m_nextPrefetch = 0;
+  unsigned int m_artRevision = 0;
+  int m_changeRevision = -1;
 };
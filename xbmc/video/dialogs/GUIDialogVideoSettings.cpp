@@ -307,6 +307,7 @@ void CGUIDialogVideoSettings::InitializeSettings()
   entries.push_back(std::make_pair(20131, VS_INTERLACEMETHOD_RENDER_BLEND));
   entries.push_back(std::make_pair(20129, VS_INTERLACEMETHOD_RENDER_WEAVE));
   entries.push_back(std::make_pair(16021, VS_INTERLACEMETHOD_RENDER_BOB));
+  entries.push_back(std::make_pair(16337, VS_INTERLACEMETHOD_RENDER_BOB_EDI));
   entries.push_back(std::make_pair(16020, VS_INTERLACEMETHOD_DEINTERLACE));
   entries.push_back(std::make_pair(16036, VS_INTERLACEMETHOD_DEINTERLACE_HALF));
   entries.push_back(std::make_pair(16311, VS_INTERLACEMETHOD_VDPAU_TEMPORAL_SPATIAL));
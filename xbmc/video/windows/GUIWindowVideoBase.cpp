@@ -1275,7 +1275,7 @@ bool CGUIWindowVideoBase::Update(const std::string &strDirectory, bool updateFil
 
   // might already be running from GetGroupedItems
   if (!m_thumbLoader.IsLoading())
-    m_thumbLoader.Load(*m_vecItems);
+    m_thumbLoader.Load(*m_vecItems, m_viewControl.GetSelectedItem());
 
   return true;
 }
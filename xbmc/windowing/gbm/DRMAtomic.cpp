@@ -19,10 +19,25 @@
 
 #include <drm_fourcc.h>
 #include <drm_mode.h>
+#include <poll.h>
 #include <unistd.h>
 
 using namespace KODI::WINDOWING::GBM;
 
+// give up waiting for the page flip of a non-blocking commit after this many ms
+#define FLIP_TIMEOUT_MS 100
+
+namespace
+{
+
+void PageFlipHandler(int fd, unsigned int frame, unsigned int sec, unsigned int usec, void *data)
+{
+  bool *flipPending = static_cast<bool *>(data);
+  *flipPending = false;
+}
+
+} // unnamed namespace
+
 void CDRMAtomic::DrmAtomicCommit(int fb_id, int flags, bool rendered, bool videoLayer)
 {
   uint32_t blob_id;
@@ -63,13 +78,19 @@ void CDRMAtomic::DrmAtomicCommit(int fb_id, int flags, bool rendered, bool video
     AddProperty(m_gui_plane, "CRTC_W", m_mode->hdisplay);
     AddProperty(m_gui_plane, "CRTC_H", m_mode->vdisplay);
   }
-  else if (videoLayer && !CServiceBroker::GetGUI()->GetWindowManager().HasVisibleControls())
+  else if (videoLayer && !m_gui_plane_disabled && !CServiceBroker::GetGUI()->GetWindowManager().HasVisibleControls())
   {
     // disable gui plane when video layer is active and gui has no visible controls
     AddProperty(m_gui_plane, "FB_ID", 0);
     AddProperty(m_gui_plane, "CRTC_ID", 0);
   }
 
+  // Video frames on their own don't wait for the vblank, so the gui can be
+  // processed meanwhile. The next commit or video frame waits for the flip.
+  const bool nonBlocking = !rendered && videoLayer &&
+                           !(flags & DRM_MODE_ATOMIC_ALLOW_MODESET) &&
+                           drmModeAtomicGetCursor(m_req) > 0;
+
   auto ret = drmModeAtomicCommit(m_fd, m_req, flags | DRM_MODE_ATOMIC_TEST_ONLY, nullptr);
   if (ret < 0)
   {
@@ -77,11 +98,23 @@ void CDRMAtomic::DrmAtomicCommit(int fb_id, int flags, bool rendered, bool video
   }
   else if (ret == 0)
   {
-    ret = drmModeAtomicCommit(m_fd, m_req, flags, nullptr);
+    if (nonBlocking)
+      ret = drmModeAtomicCommit(m_fd, m_req, flags | DRM_MODE_ATOMIC_NONBLOCK | DRM_MODE_PAGE_FLIP_EVENT, &m_flip_pending);
+    else
+      ret = drmModeAtomicCommit(m_fd, m_req, flags, nullptr);
+
     if (ret < 0)
     {
       CLog::Log(LOGERROR, "CDRMAtomic::%s - atomic commit failed: %s", __FUNCTION__, strerror(errno));
     }
+    else
+    {
+      m_flip_pending = nonBlocking;
+      if (rendered)
+        m_gui_plane_disabled = false;
+      else if (videoLayer)
+        m_gui_plane_disabled = !CServiceBroker::GetGUI()->GetWindowManager().HasVisibleControls();
+    }
   }
 
   if (flags & DRM_MODE_ATOMIC_ALLOW_MODESET)
@@ -98,6 +131,8 @@ void CDRMAtomic::FlipPage(struct gbm_bo *bo, bool rendered, bool videoLayer)
 {
   struct drm_fb *drm_fb = nullptr;
 
+  WaitForFlip();
+
   if (rendered)
   {
     if (videoLayer)
@@ -156,6 +191,8 @@ bool CDRMAtomic::InitDrm()
 
 void CDRMAtomic::DestroyDrm()
 {
+  WaitForFlip();
+
   CDRMUtils::DestroyDrm();
 
   drmModeAtomicFree(m_req);
@@ -177,6 +214,40 @@ bool CDRMAtomic::SetActive(bool active)
   return true;
 }
 
+void CDRMAtomic::WaitForFlip()
+{
+  if (!m_flip_pending)
+    return;
+
+  struct pollfd drm_fds =
+  {
+    m_fd,
+    POLLIN,
+    0,
+  };
+
+  drmEventContext drm_evctx = {};
+  drm_evctx.version = 2;
+  drm_evctx.page_flip_handler = PageFlipHandler;
+
+  while (m_flip_pending)
+  {
+    auto ret = poll(&drm_fds, 1, FLIP_TIMEOUT_MS);
+    if (ret < 0 && errno == EINTR)
+      continue;
+
+    if (ret <= 0 || (drm_fds.revents & (POLLHUP | POLLERR)))
+    {
+      CLog::Log(LOGERROR, "CDRMAtomic::%s - no page flip event received", __FUNCTION__);
+      m_flip_pending = false;
+      break;
+    }
+
+    if (drm_fds.revents & POLLIN)
+      drmHandleEvent(m_fd, &drm_evctx);
+  }
+}
+
 bool CDRMAtomic::AddProperty(struct drm_object *object, const char *name, uint64_t value)
 {
   uint32_t property_id = this->GetPropertyId(object, name);
@@ -28,6 +28,7 @@ public:
   virtual bool InitDrm() override;
   virtual void DestroyDrm() override;
   virtual bool AddProperty(struct drm_object *object, const char *name, uint64_t value) override;
+  virtual void WaitForFlip() override;
 
 private:
   void DrmAtomicCommit(int fb_id, int flags, bool rendered, bool videoLayer);
@@ -35,6 +36,8 @@ private:
 
   bool m_need_modeset;
   bool m_active = true;
+  bool m_flip_pending = false;
+  bool m_gui_plane_disabled = false;
   drmModeAtomicReq *m_req = nullptr;
 };
 
@@ -0,0 +1,133 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#include "VideoSyncGbm.h"
+
+#include "DRMUtils.h"
+#include "ServiceBroker.h"
+#include "threads/Thread.h"
+#include "utils/TimeUtils.h"
+#include "utils/log.h"
+#include "windowing/GraphicContext.h"
+#include "windowing/WinSystem.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include <xf86drm.h>
+
+using namespace KODI::WINDOWING::GBM;
+
+bool CVideoSyncGbm::Setup(PUPDATECLOCK func)
+{
+  UpdateClock = func;
+  m_abort = false;
+
+  // old kernels stamp the vblanks with the wall clock
+  uint64_t monotonic = 0;
+  if (drmGetCap(m_DRM->GetFileDescriptor(), DRM_CAP_TIMESTAMP_MONOTONIC, &monotonic) != 0 || !monotonic)
+    m_timestampClock = CLOCK_REALTIME;
+  else
+    m_timestampClock = CLOCK_MONOTONIC;
+
+  unsigned int sequence;
+  int64_t time;
+  if (!WaitVBlank(sequence, time))
+    return false;
+
+  CServiceBroker::GetWinSystem()->Register(this);
+  CLog::Log(LOGDEBUG, "CVideoReferenceClock: setting up GBM");
+  return true;
+}
+
+void CVideoSyncGbm::Run(CEvent& stopEvent)
+{
+  CThread* thread = CThread::GetCurrentThread();
+  if (thread != nullptr)
+  {
+    /* This shouldn't be very busy and timing is important so increase priority */
+    thread->SetPriority(thread->GetPriority() + 1);
+  }
+
+  unsigned int lastSequence = 0;
+  bool first = true;
+
+  while (!stopEvent.Signaled() && !m_abort)
+  {
+    unsigned int sequence;
+    int64_t time;
+    if (!WaitVBlank(sequence, time))
+      break;
+
+    // vblanks may have been missed while this thread wasn't scheduled
+    const int vblanks = first ? 1 : static_cast<int>(sequence - lastSequence);
+    lastSequence = sequence;
+    first = false;
+
+    if (vblanks > 0)
+      UpdateClock(vblanks, time, m_refClock);
+  }
+}
+
+void CVideoSyncGbm::Cleanup()
+{
+  CLog::Log(LOGDEBUG, "CVideoReferenceClock: cleaning up GBM");
+  CServiceBroker::GetWinSystem()->Unregister(this);
+}
+
+float CVideoSyncGbm::GetFps()
+{
+  m_fps = CServiceBroker::GetWinSystem()->GetGfxContext().GetFPS();
+  CLog::Log(LOGDEBUG, "CVideoReferenceClock: fps: %.2f", m_fps);
+  return m_fps;
+}
+
+void CVideoSyncGbm::OnResetDisplay()
+{
+  m_abort = true;
+}
+
+void CVideoSyncGbm::RefreshChanged()
+{
+  if (m_fps != CServiceBroker::GetWinSystem()->GetGfxContext().GetFPS())
+    m_abort = true;
+}
+
+bool CVideoSyncGbm::WaitVBlank(unsigned int& sequence, int64_t& time)
+{
+  drmVBlank vbl = {};
+  vbl.request.type = DRM_VBLANK_RELATIVE;
+  vbl.request.sequence = 1;
+
+  const int crtcIndex = m_DRM->GetCrtcIndex();
+  if (crtcIndex > 1)
+    vbl.request.type = static_cast<drmVBlankSeqType>(vbl.request.type |
+                       ((crtcIndex << DRM_VBLANK_HIGH_CRTC_SHIFT) & DRM_VBLANK_HIGH_CRTC_MASK));
+  else if (crtcIndex == 1)
+    vbl.request.type = static_cast<drmVBlankSeqType>(vbl.request.type | DRM_VBLANK_SECONDARY);
+
+  if (drmWaitVBlank(m_DRM->GetFileDescriptor(), &vbl) != 0)
+  {
+    CLog::Log(LOGERROR, "CVideoSyncGbm::%s - drmWaitVBlank failed: %s", __FUNCTION__, strerror(errno));
+    return false;
+  }
+
+  // the timestamp is of another clock than the host counter, so only its age is used
+  struct timespec now;
+  clock_gettime(m_timestampClock, &now);
+  const int64_t hostNow = CurrentHostCounter();
+
+  int64_t age = (static_cast<int64_t>(now.tv_sec) - vbl.reply.tval_sec) * 1000000000LL +
+                static_cast<int64_t>(now.tv_nsec) - static_cast<int64_t>(vbl.reply.tval_usec) * 1000LL;
+  if (age < 0)
+    age = 0;
+
+  sequence = vbl.reply.sequence;
+  time = hostNow - age * CurrentHostFrequency() / 1000000000LL;
+  return true;
+}
@@ -0,0 +1,54 @@
+/*
+ *  Copyright (C) 2018 Team Kodi
+ *  This file is part of Kodi - https://kodi.tv
+ *
+ *  SPDX-License-Identifier: GPL-2.0-or-later
+ *  See LICENSES/README.md for more information.
+ */
+
+#pragma once
+
+#include "guilib/DispResource.h"
+#include "windowing/VideoSync.h"
+
+#include <atomic>
+#include <memory>
+#include <time.h>
+
+namespace KODI
+{
+namespace WINDOWING
+{
+namespace GBM
+{
+
+class CDRMUtils;
+
+/*!
+ * \brief Drives the reference clock with the vblank timestamps of the kernel
+ *
+ * The timestamps are taken by the driver when the vblank happens, so the
+ * latency of waking up the clock thread doesn't end up in the clock.
+ */
+class CVideoSyncGbm : public CVideoSync, IDispResource
+{
+public:
+  CVideoSyncGbm(void *clock, std::shared_ptr<CDRMUtils> drm) : CVideoSync(clock), m_DRM(drm) {};
+  bool Setup(PUPDATECLOCK func) override;
+  void Run(CEvent& stopEvent) override;
+  void Cleanup() override;
+  float GetFps() override;
+  void OnResetDisplay() override;
+  void RefreshChanged() override;
+
+private:
+  bool WaitVBlank(unsigned int& sequence, int64_t& time);
+
+  std::shared_ptr<CDRMUtils> m_DRM;
+  clockid_t m_timestampClock = CLOCK_MONOTONIC;
+  std::atomic<bool> m_abort{false};
+};
+
+}
+}
+}
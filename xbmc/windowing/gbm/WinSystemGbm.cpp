@@ -14,6 +14,7 @@
 #include "OffScreenModeSetting.h"
 #include "OptionalsReg.h"
 #include "ServiceBroker.h"
+#include "VideoSyncGbm.h"
 #include "messaging/ApplicationMessenger.h"
 #include "settings/DisplaySettings.h"
 #include "settings/Settings.h"
@@ -231,6 +232,12 @@ void CWinSystemGbm::FlipPage(bool rendered, bool videoLayer)
   }
 }
 
+std::unique_ptr<CVideoSync> CWinSystemGbm::GetVideoSync(void *clock)
+{
+  std::unique_ptr<CVideoSync> pVSync(new CVideoSyncGbm(clock, m_DRM));
+  return pVSync;
+}
+
 bool CWinSystemGbm::UseLimitedColor()
 {
   return CServiceBroker::GetSettingsComponent()->GetSettings()->GetBool(CSettings::SETTING_VIDEOSCREEN_LIMITEDRANGE);
@@ -59,6 +59,8 @@ public:
   struct gbm_device *GetGBMDevice() const { return m_GBM->GetDevice(); }
   std::shared_ptr<CDRMUtils> GetDrm() const { return m_DRM; }
 
+  std::unique_ptr<CVideoSync> GetVideoSync(void *clock) override;
+
 protected:
   void OnLostDevice();
 
@@ -73,7 +73,15 @@ void CVideoSyncWpPresentation::HandlePresentation(timespec tv, std::uint32_t ref
   }
   m_lastMsc = msc;
 
-  // FIXME use timespec instead of currenthostcounter()? Possibly difficult
-  // due to different clock base
-  UpdateClock(mscDiff, CurrentHostCounter(), m_refClock);
+  // tv is of the presentation clock instead of the host counter, so only its
+  // age is used to tell when the frame was presented
+  auto now = m_winSystem.GetPresentationClockTime();
+  const std::int64_t hostNow = CurrentHostCounter();
+  std::int64_t age = (static_cast<std::int64_t>(now.tv_sec) - tv.tv_sec) * 1000000000LL + now.tv_nsec - tv.tv_nsec;
+  if (age < 0)
+  {
+    age = 0;
+  }
+
+  UpdateClock(mscDiff, hostNow - age * CurrentHostFrequency() / 1000000000LL, m_refClock);
 }
@@ -87,6 +87,7 @@ public:
 
   using PresentationFeedbackHandler = std::function<void(timespec /* tv */, std::uint32_t /* refresh */, std::uint32_t /* sync output id */, float /* sync output fps */, std::uint64_t /* msc */)>;
   CSignalRegistration RegisterOnPresentationFeedback(PresentationFeedbackHandler handler);
+  timespec GetPresentationClockTime();
 
   // Like CWinSystemX11
   void GetConnectedOutputs(std::vector<std::string>* outputs);
@@ -177,8 +178,6 @@ private:
   void ProcessMessages();
   void AckConfigure(std::uint32_t serial);
 
-  timespec GetPresentationClockTime();
-
   // Globals
   // -------
   std::unique_ptr<CConnection> m_connection;
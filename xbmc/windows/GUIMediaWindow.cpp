@@ -117,6 +117,10 @@ CGUIMediaWindow::CGUIMediaWindow(int id, const char *xmlFile)
   m_iLastControl = -1;
   m_canFilterAdvanced = false;
 
+  // network folders show the listing of the last visit while they are listed
+  // again, the view is refreshed through GUI_MSG_UPDATE_PATH if it changed
+  m_rootDir.SetFlags(XFILE::DIR_FLAG_ALLOW_PROMPT | XFILE::DIR_FLAG_ALLOW_STALE);
+
   m_guiState.reset(CGUIViewState::GetViewState(GetID(), *m_vecItems));
 }
 
@@ -17,6 +17,7 @@
 #include "guilib/guiinfo/GUIInfoLabels.h"
 #include "pvr/PVRManager.h"
 #include "storage/MediaManager.h"
+#include "utils/MemoryPressure.h"
 #include "utils/StringUtils.h"
 #include "utils/SystemInfo.h"
 
@@ -164,6 +165,8 @@ void CGUIWindowSystemInfo::FrameMove()
     i++;  // empty line
     SetControlLabel(i++, "%s: %s", 22012, SYSTEM_TOTAL_MEMORY);
     SetControlLabel(i++, "%s: %s", 158, SYSTEM_FREE_MEMORY);
+    SET_CONTROL_LABEL(i++, StringUtils::Format("%s: %s", g_localizeStrings.Get(22025).c_str(),
+                                               CMemoryPressureManager::GetInstance().GetStatus().c_str()));
   }
 
   else if (m_section == CONTROL_BT_PVR)